@@ -0,0 +1,36 @@
+#pragma once
+
+#include "pbft/period_data.hpp"
+#include "test_util/samples.hpp"
+#include "test_util/test_util.hpp"
+
+namespace taraxa::benchmarks {
+
+/**
+ * @brief Creates period data with mock dag of test samples, a dag block with all transactions and cert votes of
+ *        previous period
+ */
+inline PeriodData makePeriodData(PbftPeriod period, size_t trxs_count, size_t votes_count) {
+  using namespace core_tests;
+  const auto pbft_block =
+      std::make_shared<PbftBlock>(blk_hash_t(1), blk_hash_t(2), blk_hash_t(3), blk_hash_t(4), period, addr_t(5),
+                                  secret_t::random(), std::vector<vote_hash_t>{});
+  std::vector<std::shared_ptr<PbftVote>> votes;
+  for (size_t i = 0; i < votes_count; ++i) {
+    votes.push_back(genDummyVote(PbftVoteTypes::cert_vote, period - 1, 1, 3, blk_hash_t(6)));
+  }
+
+  PeriodData period_data(pbft_block, votes);
+  period_data.dag_blocks = samples::createMockDag0(blk_hash_t(1));
+  period_data.transactions = samples::createSignedTrxSamples(1, trxs_count, secret_t::random());
+  vec_trx_t trx_hashes;
+  for (const auto& trx : period_data.transactions) {
+    trx_hashes.push_back(trx->getHash());
+  }
+  const auto& tip = period_data.dag_blocks.back();
+  period_data.dag_blocks.push_back(std::make_shared<DagBlock>(tip->getHash(), tip->getLevel() + 1, vec_blk_t{},
+                                                              std::move(trx_hashes), secret_t::random()));
+  return period_data;
+}
+
+}  // namespace taraxa::benchmarks
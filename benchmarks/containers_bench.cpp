@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include "common/util.hpp"
+#include "network/threadpool/priority_queue.hpp"
+#include "test_util/samples.hpp"
+
+namespace taraxa::benchmarks {
+
+using namespace core_tests;
+
+// Hashes of sample transactions, as cached by network to filter already known transactions
+std::vector<trx_hash_t> makeHashes(size_t count) {
+  std::vector<trx_hash_t> hashes;
+  hashes.reserve(count);
+  for (const auto& trx : samples::createSignedTrxSamples(1, count, secret_t::random())) {
+    hashes.push_back(trx->getHash());
+  }
+  return hashes;
+}
+
+void BM_ExpirationCacheInsert(benchmark::State& state) {
+  const auto hashes = makeHashes(state.range(0));
+  for (auto _ : state) {
+    // Cache is smaller than number of inserted keys, so expiration is part of the measurement
+    ExpirationCache<trx_hash_t> cache(hashes.size() / 2, hashes.size() / 20);
+    for (const auto& hash : hashes) {
+      benchmark::DoNotOptimize(cache.insert(hash));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * hashes.size());
+}
+BENCHMARK(BM_ExpirationCacheInsert)->Arg(10000);
+
+void BM_ExpirationCacheContains(benchmark::State& state) {
+  const auto hashes = makeHashes(state.range(0));
+  ExpirationCache<trx_hash_t> cache(hashes.size(), hashes.size() / 20);
+  // Half of the keys are cached, so both hits and misses are measured
+  for (size_t i = 0; i < hashes.size(); i += 2) {
+    cache.insert(hashes[i]);
+  }
+  for (auto _ : state) {
+    for (const auto& hash : hashes) {
+      benchmark::DoNotOptimize(cache.contains(hash));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * hashes.size());
+}
+BENCHMARK(BM_ExpirationCacheContains)->Arg(10000);
+
+void BM_PriorityQueuePushPop(benchmark::State& state) {
+  constexpr size_t kWorkersCount = 10;
+  constexpr tarcap::TarcapVersion kVersion = 1;
+  // Packets of all priorities, none of them is blocked while no packet is being processed
+  const std::vector<SubprotocolPacketType> types = {SubprotocolPacketType::kVotePacket,
+                                                    SubprotocolPacketType::kTransactionPacket,
+                                                    SubprotocolPacketType::kStatusPacket};
+  const auto packets_count = state.range(0);
+  const dev::p2p::NodeID node_id(1);
+
+  network::threadpool::PriorityQueue queue(kWorkersCount);
+  for (auto _ : state) {
+    for (int64_t i = 0; i < packets_count; ++i) {
+      queue.pushBack({kVersion, network::threadpool::PacketData(types[i % types.size()], node_id, bytes(100))});
+    }
+    while (auto packet = queue.pop()) {
+      benchmark::DoNotOptimize(packet);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * packets_count);
+}
+BENCHMARK(BM_PriorityQueuePushPop)->Arg(1000);
+
+}  // namespace taraxa::benchmarks
@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include "dag/dag.hpp"
+#include "test_util/samples.hpp"
+
+namespace taraxa::benchmarks {
+
+using namespace core_tests;
+
+struct DagFixture {
+  blk_hash_t genesis{1};
+  // Blocks in insertion order, pivot and tips of each block precede it
+  std::vector<std::tuple<blk_hash_t, blk_hash_t, std::vector<blk_hash_t>>> blocks;
+  std::map<uint64_t, std::unordered_set<blk_hash_t>> non_finalized_blks;
+  blk_hash_t anchor;
+
+  void add(const blk_hash_t& hash, const blk_hash_t& pivot, std::vector<blk_hash_t> tips, level_t level) {
+    blocks.emplace_back(hash, pivot, std::move(tips));
+    non_finalized_blks[level].insert(hash);
+    anchor = hash;
+  }
+
+  void fill(Dag& dag) const {
+    for (const auto& [hash, pivot, tips] : blocks) {
+      dag.addVEEs(hash, pivot, tips);
+    }
+  }
+};
+
+// Mock dag of test samples
+DagFixture mockDag() {
+  DagFixture fixture;
+  for (const auto& blk : samples::createMockDag1(fixture.genesis)) {
+    fixture.add(blk->getHash(), blk->getPivot(), blk->getTips(), blk->getLevel());
+  }
+  return fixture;
+}
+
+// Dag of `levels` levels, each with `width` blocks. Every block points to the previous level block with the same
+// index as pivot and to its neighbour as tip, so blocks of each level are tips of the next level
+DagFixture wideDag(size_t levels, size_t width) {
+  DagFixture fixture;
+  std::vector<blk_hash_t> previous(width, fixture.genesis);
+  uint64_t next_hash = 2;
+  for (level_t level = 1; level <= levels; ++level) {
+    std::vector<blk_hash_t> current;
+    for (size_t i = 0; i < width; ++i) {
+      current.emplace_back(next_hash++);
+      std::vector<blk_hash_t> tips;
+      if (width > 1 && previous[(i + 1) % width] != previous[i]) {
+        tips.push_back(previous[(i + 1) % width]);
+      }
+      fixture.add(current.back(), previous[i], std::move(tips), level);
+    }
+    previous = std::move(current);
+  }
+  return fixture;
+}
+
+void computeOrder(benchmark::State& state, const DagFixture& fixture) {
+  std::vector<blk_hash_t> ordered;
+  for (auto _ : state) {
+    // Order is cached per anchor, so every iteration orders a freshly built dag
+    state.PauseTiming();
+    Dag dag(fixture.genesis, addr_t());
+    fixture.fill(dag);
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(dag.computeOrder(fixture.anchor, ordered, fixture.non_finalized_blks));
+  }
+  state.SetItemsProcessed(state.iterations() * fixture.blocks.size());
+}
+
+void BM_DagComputeOrderMock(benchmark::State& state) { computeOrder(state, mockDag()); }
+BENCHMARK(BM_DagComputeOrderMock);
+
+void BM_DagComputeOrder(benchmark::State& state) { computeOrder(state, wideDag(state.range(0), state.range(1))); }
+BENCHMARK(BM_DagComputeOrder)->Args({10, 10})->Args({100, 10})->Args({100, 50});
+
+}  // namespace taraxa::benchmarks
@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+
+#include "bench_util.hpp"
+
+namespace taraxa::benchmarks {
+
+using namespace core_tests;
+
+constexpr PbftPeriod kPeriod = 100;
+
+void BM_PeriodDataEncode(benchmark::State& state) {
+  const auto period_data = makePeriodData(kPeriod, state.range(0), 20);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(period_data.rlp());
+  }
+  state.SetBytesProcessed(state.iterations() * period_data.rlp().size());
+}
+BENCHMARK(BM_PeriodDataEncode)->Arg(10)->Arg(1000);
+
+void BM_PeriodDataDecode(benchmark::State& state) {
+  const auto rlp = makePeriodData(kPeriod, state.range(0), 20).rlp();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(PeriodData(rlp));
+  }
+  state.SetBytesProcessed(state.iterations() * rlp.size());
+}
+BENCHMARK(BM_PeriodDataDecode)->Arg(10)->Arg(1000);
+
+void BM_DagBlockEncode(benchmark::State& state) {
+  const auto period_data = makePeriodData(kPeriod, state.range(0), 0);
+  const auto& dag_block = period_data.dag_blocks.back();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dag_block->rlp(true));
+  }
+}
+BENCHMARK(BM_DagBlockEncode)->Arg(10)->Arg(1000);
+
+void BM_DagBlockDecode(benchmark::State& state) {
+  const auto rlp = makePeriodData(kPeriod, state.range(0), 0).dag_blocks.back()->rlp(true);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(DagBlock(dev::RLP(rlp)));
+  }
+}
+BENCHMARK(BM_DagBlockDecode)->Arg(10)->Arg(1000);
+
+void BM_PbftVoteEncode(benchmark::State& state) {
+  const auto vote = genDummyVote(PbftVoteTypes::cert_vote, kPeriod, 1, 3, blk_hash_t(6));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vote->rlp());
+  }
+}
+BENCHMARK(BM_PbftVoteEncode);
+
+void BM_PbftVoteDecode(benchmark::State& state) {
+  const auto rlp = genDummyVote(PbftVoteTypes::cert_vote, kPeriod, 1, 3, blk_hash_t(6))->rlp();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(PbftVote(rlp));
+  }
+}
+BENCHMARK(BM_PbftVoteDecode);
+
+}  // namespace taraxa::benchmarks
@@ -0,0 +1,19 @@
+#include <benchmark/benchmark.h>
+
+#include "common/init.hpp"
+#include "logger/logger.hpp"
+
+int main(int argc, char** argv) {
+  taraxa::static_init();
+  auto logging = taraxa::logger::createDefaultLoggingConfig();
+  logging.verbosity = taraxa::logger::Verbosity::Error;
+  taraxa::logger::InitLogging(logging, taraxa::addr_t());
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
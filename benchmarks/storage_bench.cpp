@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <unistd.h>
+
+#include <filesystem>
+
+#include "bench_util.hpp"
+#include "storage/storage.hpp"
+
+namespace taraxa::benchmarks {
+
+namespace fs = std::filesystem;
+
+constexpr PbftPeriod kPeriodsCount = 100;
+
+// Database in a fresh temporary directory, removed together with the fixture
+class DbFixture {
+ public:
+  DbFixture() : path_(fs::temp_directory_path() / ("taraxa_storage_bench_" + std::to_string(::getpid()))) {
+    fs::remove_all(path_);
+    db_ = std::make_unique<DbStorage>(path_);
+  }
+  ~DbFixture() {
+    db_.reset();
+    fs::remove_all(path_);
+  }
+
+  DbStorage& db() { return *db_; }
+
+ private:
+  const fs::path path_;
+  std::unique_ptr<DbStorage> db_;
+};
+
+void BM_SavePeriodData(benchmark::State& state) {
+  DbFixture fixture;
+  std::vector<PeriodData> periods;
+  for (PbftPeriod period = 1; period <= kPeriodsCount; ++period) {
+    periods.push_back(makePeriodData(period, state.range(0), 20));
+  }
+  for (auto _ : state) {
+    for (const auto& period_data : periods) {
+      auto batch = DbStorage::createWriteBatch();
+      fixture.db().savePeriodData(period_data, batch);
+      fixture.db().commitWriteBatch(batch);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * periods.size());
+}
+BENCHMARK(BM_SavePeriodData)->Arg(10)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+void BM_GetPeriodData(benchmark::State& state) {
+  DbFixture fixture;
+  for (PbftPeriod period = 1; period <= kPeriodsCount; ++period) {
+    auto batch = DbStorage::createWriteBatch();
+    fixture.db().savePeriodData(makePeriodData(period, state.range(0), 20), batch);
+    fixture.db().commitWriteBatch(batch);
+  }
+  // Raw read is what syncing peers are served with, decoded read is what node itself uses
+  const bool decode = state.range(1);
+  for (auto _ : state) {
+    for (PbftPeriod period = 1; period <= kPeriodsCount; ++period) {
+      if (decode) {
+        benchmark::DoNotOptimize(fixture.db().getPeriodData(period));
+      } else {
+        benchmark::DoNotOptimize(fixture.db().getPeriodDataRaw(period));
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kPeriodsCount);
+}
+BENCHMARK(BM_GetPeriodData)->ArgsProduct({{10, 1000}, {0, 1}})->Unit(benchmark::kMillisecond);
+
+}  // namespace taraxa::benchmarks
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include "test_util/samples.hpp"
+#include "transaction/transaction_queue.hpp"
+
+namespace taraxa::benchmarks {
+
+using namespace core_tests;
+
+// Transactions of many senders, each sending a few transactions with consecutive nonces
+SharedTransactions makeTransactions(size_t count) {
+  constexpr size_t kTrxPerSender = 4;
+  SharedTransactions trxs;
+  trxs.reserve(count);
+  while (trxs.size() < count) {
+    auto sender_trxs = samples::createSignedTrxSamples(1, kTrxPerSender, secret_t::random());
+    trxs.insert(trxs.end(), sender_trxs.begin(), sender_trxs.end());
+  }
+  trxs.resize(count);
+  // Sender recovery and hashing are cached in transaction, so they are not part of measured time
+  for (const auto& trx : trxs) {
+    trx->getSender();
+    trx->getHash();
+  }
+  return trxs;
+}
+
+void BM_TransactionQueueInsert(benchmark::State& state) {
+  const auto trxs = makeTransactions(state.range(0));
+  for (auto _ : state) {
+    TransactionQueue queue(nullptr, trxs.size());
+    for (auto trx : trxs) {
+      benchmark::DoNotOptimize(queue.insert(std::move(trx), true, 1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * trxs.size());
+}
+BENCHMARK(BM_TransactionQueueInsert)->Arg(1000)->Arg(10000);
+
+void BM_TransactionQueueGetOrderedTransactions(benchmark::State& state) {
+  const auto trxs = makeTransactions(state.range(0));
+  TransactionQueue queue(nullptr, trxs.size());
+  for (auto trx : trxs) {
+    queue.insert(std::move(trx), true, 1);
+  }
+  const auto count = state.range(1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(queue.getOrderedTransactions(count));
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_TransactionQueueGetOrderedTransactions)->Args({10000, 100})->Args({10000, 1000});
+
+}  // namespace taraxa::benchmarks
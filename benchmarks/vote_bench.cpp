@@ -0,0 +1,45 @@
+#include <benchmark/benchmark.h>
+
+#include "common/vrf_wrapper.hpp"
+#include "vote/pbft_vote.hpp"
+
+namespace taraxa::benchmarks {
+
+// Votes of different voters for the same block, as validated while collecting cert votes of a period
+struct VotesFixture {
+  std::vector<bytes> votes_rlp;
+  std::vector<vrf_wrapper::vrf_pk_t> vrf_pks;
+
+  explicit VotesFixture(size_t count) {
+    const VrfPbftMsg msg(PbftVoteTypes::cert_vote, 100, 1, 3);
+    for (size_t i = 0; i < count; ++i) {
+      const auto [vrf_pk, vrf_sk] = vrf_wrapper::getVrfKeyPair();
+      votes_rlp.push_back(PbftVote(secret_t::random(), VrfPbftSortition(vrf_sk, msg), blk_hash_t(123)).rlp());
+      vrf_pks.push_back(vrf_pk);
+    }
+  }
+};
+
+/**
+ * Cryptographic part of VoteManager::validateVote: voter recovery from signature, vrf sortition proof verification and
+ * weight calculation. Stake and vrf key lookups of validateVote are reads from final chain, which are left out
+ */
+void BM_VoteValidate(benchmark::State& state) {
+  constexpr size_t kVotesCount = 32;
+  const VotesFixture fixture(kVotesCount);
+  size_t i = 0;
+  for (auto _ : state) {
+    // Recovered voter is cached in vote, so each iteration validates freshly decoded vote
+    state.PauseTiming();
+    const PbftVote vote(fixture.votes_rlp[i % kVotesCount]);
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(vote.verifyVote());
+    benchmark::DoNotOptimize(vote.verifyVrfSortition(fixture.vrf_pks[i % kVotesCount], true));
+    benchmark::DoNotOptimize(vote.calculateWeight(1, kVotesCount, kVotesCount));
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VoteValidate);
+
+}  // namespace taraxa::benchmarks
@@ -20,6 +20,7 @@ class TaraxaConan(ConanFile):
         self.requires("openssl/3.4.1")
         self.requires("cryptopp/8.9.0")
         self.requires("gtest/1.16.0")
+        self.requires("benchmark/1.9.1")
         self.requires("rocksdb/9.10.0")
         self.requires("prometheus-cpp/1.3.0")
         self.requires("jsoncpp/1.9.6")
@@ -68,6 +69,7 @@ class TaraxaConan(ConanFile):
         self.options["cppcheck"].have_rules = False
         self.options["rocksdb"].use_rtti = True
         self.options["rocksdb"].with_lz4 = True
+        self.options["rocksdb"].with_zstd = True
         # mpir is required by cppcheck and it causing gmp confict
         self.options["mpir"].enable_gmpcompat = False
         # Configure OpenSSL
@@ -65,15 +65,12 @@ bytes dev::fromHex(std::string const& _s, WhenError _throw) {
     else
       return bytes();
   }
-  for (unsigned i = s; i < _s.size(); i += 2) {
-    int h = fromHexChar(_s[i]);
-    int l = fromHexChar(_s[i + 1]);
-    if (h != -1 && l != -1)
-      ret.push_back((::byte)(h * 16 + l));
-    else if (_throw == WhenError::Throw)
-      BOOST_THROW_EXCEPTION(BadHexCharacter());
-    else
-      return bytes();
+  auto const pairs = (_s.size() - s) / 2;
+  auto const off = ret.size();
+  ret.resize(off + pairs);
+  if (!hexDecode(_s.data() + s, pairs, ret.data() + off)) {
+    if (_throw == WhenError::Throw) BOOST_THROW_EXCEPTION(BadHexCharacter());
+    return bytes();
   }
   return ret;
 }
@@ -8,6 +8,8 @@
 
 #include <algorithm>
 #include <cstring>
+#include <iterator>
+#include <memory>
 #include <string>
 #include <type_traits>
 #include <unordered_set>
@@ -24,18 +26,29 @@ enum class WhenError {
   Throw = 1,
 };
 
+/// Writes 2 * _size lowercase hex digits of _data to o_hex, vectorized where the CPU supports it.
+void hexEncode(byte const* _data, size_t _size, char* o_hex) noexcept;
+
+/// Reads _size bytes from 2 * _size hex digits of _hex, either case.
+/// @returns false if there is a non-hex character, o_data is then partially written.
+bool hexDecode(char const* _hex, size_t _size, byte* o_data) noexcept;
+
 template <class Iterator>
 std::string toHex(Iterator _it, Iterator _end, std::string const& _prefix) {
   typedef std::iterator_traits<Iterator> traits;
   static_assert(sizeof(typename traits::value_type) == 1, "toHex needs byte-sized element type");
 
-  static char const* hexdigits = "0123456789abcdef";
   size_t off = _prefix.size();
   std::string hex(std::distance(_it, _end) * 2 + off, '0');
   hex.replace(0, off, _prefix);
-  for (; _it != _end; _it++) {
-    hex[off++] = hexdigits[(*_it >> 4) & 0x0f];
-    hex[off++] = hexdigits[*_it & 0x0f];
+  if constexpr (std::contiguous_iterator<Iterator>) {
+    hexEncode(reinterpret_cast<byte const*>(std::to_address(_it)), std::distance(_it, _end), hex.data() + off);
+  } else {
+    static char const* hexdigits = "0123456789abcdef";
+    for (; _it != _end; _it++) {
+      hex[off++] = hexdigits[(*_it >> 4) & 0x0f];
+      hex[off++] = hexdigits[*_it & 0x0f];
+    }
   }
   return hex;
 }
@@ -0,0 +1,220 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2014-2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include <array>
+#include <cstdint>
+
+#include "CommonData.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define DEV_HEX_X86 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define DEV_HEX_NEON 1
+#endif
+
+namespace dev {
+namespace {
+
+constexpr char c_hexDigits[] = "0123456789abcdef";
+
+// Value of a hex digit, 0xff for other characters
+constexpr auto c_hexValues = [] {
+  std::array<uint8_t, 256> values{};
+  values.fill(0xff);
+  for (int i = 0; i < 10; ++i) values['0' + i] = i;
+  for (int i = 0; i < 6; ++i) values['a' + i] = values['A' + i] = 10 + i;
+  return values;
+}();
+
+void hexEncodeScalar(byte const* _data, size_t _size, char* o_hex) {
+  for (size_t i = 0; i < _size; ++i) {
+    *o_hex++ = c_hexDigits[_data[i] >> 4];
+    *o_hex++ = c_hexDigits[_data[i] & 0x0f];
+  }
+}
+
+bool hexDecodeScalar(char const* _hex, size_t _size, byte* o_data) {
+  for (size_t i = 0; i < _size; ++i) {
+    auto const h = c_hexValues[static_cast<uint8_t>(_hex[2 * i])];
+    auto const l = c_hexValues[static_cast<uint8_t>(_hex[2 * i + 1])];
+    if ((h | l) == 0xff) return false;
+    o_data[i] = static_cast<byte>(h << 4 | l);
+  }
+  return true;
+}
+
+#if DEV_HEX_X86
+
+bool hasAvx2() {
+  static bool const c_hasAvx2 = __builtin_cpu_supports("avx2");
+  return c_hasAvx2;
+}
+
+bool hasSsse3() {
+  static bool const c_hasSsse3 = __builtin_cpu_supports("ssse3");
+  return c_hasSsse3;
+}
+
+// Nibbles are mapped to digits by a table lookup, high and low digits are then interleaved
+__attribute__((target("ssse3"))) size_t hexEncodeSsse3(byte const* _data, size_t _size, char* o_hex) {
+  auto const digits = _mm_loadu_si128(reinterpret_cast<__m128i const*>(c_hexDigits));
+  auto const mask = _mm_set1_epi8(0x0f);
+  size_t i = 0;
+  for (; i + 16 <= _size; i += 16) {
+    auto const x = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_data + i));
+    auto const hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(x, 4), mask));
+    auto const lo = _mm_shuffle_epi8(digits, _mm_and_si128(x, mask));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(o_hex + 2 * i), _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(o_hex + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) size_t hexEncodeAvx2(byte const* _data, size_t _size, char* o_hex) {
+  auto const digits = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const*>(c_hexDigits)));
+  auto const mask = _mm256_set1_epi8(0x0f);
+  size_t i = 0;
+  for (; i + 32 <= _size; i += 32) {
+    auto const x = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(_data + i));
+    auto const hi = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(x, 4), mask));
+    auto const lo = _mm256_shuffle_epi8(digits, _mm256_and_si256(x, mask));
+    // Unpacking works within 128-bit lanes, lanes are reordered to get bytes 0..15 and 16..31
+    auto const a = _mm256_unpacklo_epi8(hi, lo);
+    auto const b = _mm256_unpackhi_epi8(hi, lo);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(o_hex + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(o_hex + 2 * i + 32), _mm256_permute2x128_si256(a, b, 0x31));
+  }
+  return i;
+}
+
+// Values of 16 hex digits, sets o_invalid lanes of characters that are not hex digits
+__attribute__((target("ssse3"))) inline __m128i hexValuesSsse3(__m128i _c, __m128i& o_invalid) {
+  auto const d = _mm_sub_epi8(_c, _mm_set1_epi8('0'));
+  auto const isDigit = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+  auto const l = _mm_sub_epi8(_mm_or_si128(_c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+  auto const isLetter = _mm_cmpeq_epi8(_mm_min_epu8(l, _mm_set1_epi8(5)), l);
+  o_invalid = _mm_or_si128(o_invalid, _mm_andnot_si128(_mm_or_si128(isDigit, isLetter), _mm_set1_epi8(-1)));
+  return _mm_or_si128(_mm_and_si128(isDigit, d), _mm_and_si128(isLetter, _mm_add_epi8(l, _mm_set1_epi8(10))));
+}
+
+__attribute__((target("ssse3"))) size_t hexDecodeSsse3(char const* _hex, size_t _size, byte* o_data) {
+  // Pairs of digit values are combined as high * 16 + low
+  auto const weights = _mm_set1_epi16(0x0110);
+  size_t i = 0;
+  for (; i + 16 <= _size; i += 16) {
+    auto invalid = _mm_setzero_si128();
+    auto const a = hexValuesSsse3(_mm_loadu_si128(reinterpret_cast<__m128i const*>(_hex + 2 * i)), invalid);
+    auto const b = hexValuesSsse3(_mm_loadu_si128(reinterpret_cast<__m128i const*>(_hex + 2 * i + 16)), invalid);
+    if (_mm_movemask_epi8(invalid)) return SIZE_MAX;
+    auto const bytes = _mm_packus_epi16(_mm_maddubs_epi16(a, weights), _mm_maddubs_epi16(b, weights));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(o_data + i), bytes);
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) inline __m256i hexValuesAvx2(__m256i _c, __m256i& o_invalid) {
+  auto const d = _mm256_sub_epi8(_c, _mm256_set1_epi8('0'));
+  auto const isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(9)), d);
+  auto const l = _mm256_sub_epi8(_mm256_or_si256(_c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+  auto const isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(l, _mm256_set1_epi8(5)), l);
+  o_invalid = _mm256_or_si256(o_invalid, _mm256_andnot_si256(_mm256_or_si256(isDigit, isLetter), _mm256_set1_epi8(-1)));
+  return _mm256_or_si256(_mm256_and_si256(isDigit, d),
+                         _mm256_and_si256(isLetter, _mm256_add_epi8(l, _mm256_set1_epi8(10))));
+}
+
+__attribute__((target("avx2"))) size_t hexDecodeAvx2(char const* _hex, size_t _size, byte* o_data) {
+  auto const weights = _mm256_set1_epi16(0x0110);
+  size_t i = 0;
+  for (; i + 32 <= _size; i += 32) {
+    auto invalid = _mm256_setzero_si256();
+    auto const a = hexValuesAvx2(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(_hex + 2 * i)), invalid);
+    auto const b = hexValuesAvx2(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(_hex + 2 * i + 32)), invalid);
+    if (_mm256_movemask_epi8(invalid)) return SIZE_MAX;
+    // Packing works within 128-bit lanes, 64-bit quarters are reordered back
+    auto const bytes = _mm256_packus_epi16(_mm256_maddubs_epi16(a, weights), _mm256_maddubs_epi16(b, weights));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(o_data + i), _mm256_permute4x64_epi64(bytes, 0xd8));
+  }
+  return i;
+}
+
+#elif DEV_HEX_NEON
+
+size_t hexEncodeNeon(byte const* _data, size_t _size, char* o_hex) {
+  auto const digits = vld1q_u8(reinterpret_cast<uint8_t const*>(c_hexDigits));
+  size_t i = 0;
+  for (; i + 16 <= _size; i += 16) {
+    auto const x = vld1q_u8(_data + i);
+    uint8x16x2_t hex;
+    hex.val[0] = vqtbl1q_u8(digits, vshrq_n_u8(x, 4));
+    hex.val[1] = vqtbl1q_u8(digits, vandq_u8(x, vdupq_n_u8(0x0f)));
+    // Interleaving store puts low digit after high one
+    vst2q_u8(reinterpret_cast<uint8_t*>(o_hex + 2 * i), hex);
+  }
+  return i;
+}
+
+inline uint8x16_t hexValuesNeon(uint8x16_t _c, uint8x16_t& o_valid) {
+  auto const d = vsubq_u8(_c, vdupq_n_u8('0'));
+  auto const isDigit = vcltq_u8(d, vdupq_n_u8(10));
+  auto const l = vsubq_u8(vorrq_u8(_c, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+  auto const isLetter = vcltq_u8(l, vdupq_n_u8(6));
+  o_valid = vandq_u8(o_valid, vorrq_u8(isDigit, isLetter));
+  return vbslq_u8(isDigit, d, vaddq_u8(l, vdupq_n_u8(10)));
+}
+
+size_t hexDecodeNeon(char const* _hex, size_t _size, byte* o_data) {
+  size_t i = 0;
+  for (; i + 16 <= _size; i += 16) {
+    // Deinterleaving load splits high and low digits
+    auto const hex = vld2q_u8(reinterpret_cast<uint8_t const*>(_hex + 2 * i));
+    auto valid = vdupq_n_u8(0xff);
+    auto const hi = hexValuesNeon(hex.val[0], valid);
+    auto const lo = hexValuesNeon(hex.val[1], valid);
+    if (vminvq_u8(valid) != 0xff) return SIZE_MAX;
+    vst1q_u8(o_data + i, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+  }
+  return i;
+}
+
+#endif
+
+}  // namespace
+
+void hexEncode(byte const* _data, size_t _size, char* o_hex) noexcept {
+  size_t done = 0;
+#if DEV_HEX_X86
+  if (hasAvx2()) {
+    done = hexEncodeAvx2(_data, _size, o_hex);
+  }
+  if (hasSsse3()) {
+    done += hexEncodeSsse3(_data + done, _size - done, o_hex + 2 * done);
+  }
+#elif DEV_HEX_NEON
+  done = hexEncodeNeon(_data, _size, o_hex);
+#endif
+  hexEncodeScalar(_data + done, _size - done, o_hex + 2 * done);
+}
+
+bool hexDecode(char const* _hex, size_t _size, byte* o_data) noexcept {
+  size_t done = 0;
+#if DEV_HEX_X86
+  if (hasAvx2()) {
+    done = hexDecodeAvx2(_hex, _size, o_data);
+    if (done == SIZE_MAX) return false;
+  }
+  if (hasSsse3()) {
+    auto const ssse3 = hexDecodeSsse3(_hex + 2 * done, _size - done, o_data + done);
+    if (ssse3 == SIZE_MAX) return false;
+    done += ssse3;
+  }
+#elif DEV_HEX_NEON
+  done = hexDecodeNeon(_hex, _size, o_data);
+  if (done == SIZE_MAX) return false;
+#endif
+  return hexDecodeScalar(_hex + 2 * done, _size - done, o_data + done);
+}
+
+}  // namespace dev
@@ -39,7 +39,10 @@ namespace dev {
 /// information that musl doesn't currently implement 'pthread_setname_np'
 /// https://marc.info/?l=musl&m=146171729013062&w=1
 ///
+// taraxa's logger/logger.hpp redefines it with a cheap level check
+#ifndef LOG
 #define LOG BOOST_LOG
+#endif
 
 enum Verbosity {
   VerbositySilent = -1,
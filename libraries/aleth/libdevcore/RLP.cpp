@@ -181,6 +181,10 @@ void RLPStream::noteAppended(size_t _itemCount) {
     else {
       auto p = m_listStack.back().second;
       m_listStack.pop_back();
+      if (p == c_prefixWritten) {
+        _itemCount = 1;
+        continue;
+      }
       size_t s = m_out.size() - p;  // list size
       auto brs = bytesRequired(s);
       unsigned encodeSize = s < c_rlpListImmLenCount ? 1 : (1 + brs);
@@ -213,6 +217,16 @@ RLPStream& RLPStream::appendList(size_t _items) {
   return *this;
 }
 
+RLPStream& RLPStream::appendList(size_t _items, size_t _payloadSize) {
+  if (!_items) return appendList(bytes());
+  if (_payloadSize < c_rlpListImmLenCount)
+    m_out.push_back((::byte)(_payloadSize + c_rlpListStart));
+  else
+    pushCount(_payloadSize, c_rlpListIndLenZero);
+  m_listStack.push_back(std::make_pair(_items, c_prefixWritten));
+  return *this;
+}
+
 RLPStream& RLPStream::appendList(bytesConstRef _rlp) {
   if (_rlp.size() < c_rlpListImmLenCount)
     m_out.push_back((::byte)(_rlp.size() + c_rlpListStart));
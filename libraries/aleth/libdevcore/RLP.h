@@ -8,6 +8,7 @@
 
 #include <array>
 #include <iosfwd>
+#include <limits>
 #include <type_traits>
 #include <vector>
 
@@ -600,6 +601,9 @@ class RLPStream {
 
   /// Appends a list.
   RLPStream& appendList(size_t _items);
+  /// Appends a list whose encoded items take exactly @a _payloadSize bytes. The
+  /// prefix is written right away, so finishing the list does not move its items.
+  RLPStream& appendList(size_t _items, size_t _payloadSize);
   RLPStream& appendList(bytesConstRef _rlp);
   RLPStream& appendList(bytes const& _rlp) { return appendList(&_rlp); }
   RLPStream& appendList(RLPStream const& _s) { return appendList(&_s.out()); }
@@ -658,7 +662,10 @@ class RLPStream {
   /// Our output byte stream.
   bytes m_out;
 
+  /// Items left and position of list prefix, lists created with known payload size
+  /// have their prefix written already.
   std::vector<std::pair<size_t, size_t>> m_listStack;
+  static constexpr size_t c_prefixWritten = std::numeric_limits<size_t>::max();
 };
 
 template <class _T>
@@ -670,6 +677,27 @@ void rlpListAux(RLPStream& _out, _T _t, _Ts... _ts) {
   rlpListAux(_out << _t, _ts...);
 }
 
+/// Encoded size of a list prefix for items taking @a _payloadSize bytes.
+inline size_t rlpListPrefixSize(size_t _payloadSize) {
+  return _payloadSize < c_rlpListImmLenCount ? 1 : 1 + bytesRequired(_payloadSize);
+}
+
+/// Encoded size of a list with items taking @a _payloadSize bytes.
+inline size_t rlpListSize(size_t _payloadSize) { return rlpListPrefixSize(_payloadSize) + _payloadSize; }
+
+/// Encoded size of a data item, as written by RLPStream::append(bytesConstRef).
+inline size_t rlpDataSize(bytesConstRef _s) {
+  if (_s.size() == 1 && _s[0] < c_rlpDataImmLenStart) return 1;
+  if (_s.size() < c_rlpDataImmLenCount) return 1 + _s.size();
+  return 1 + bytesRequired(_s.size()) + _s.size();
+}
+
+/// Encoded size of an unsigned integer, as written by RLPStream::append.
+template <class _T>
+size_t rlpIntSize(_T _i) {
+  return _i < c_rlpDataImmLenStart ? 1 : 1 + bytesRequired(_i);
+}
+
 /// Export a single item in RLP format, returning a byte array.
 template <class _T>
 bytes rlp(_T _t) {
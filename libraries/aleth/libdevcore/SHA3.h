@@ -24,6 +24,7 @@
 #pragma once
 
 #include <ethash/keccak.hpp>
+#include <span>
 #include <string>
 
 #include "FixedHash.h"
@@ -45,6 +46,11 @@ inline h256 sha3(bytesConstRef _input) noexcept {
   return ret;
 }
 
+/// Calculate SHA3-256 hashes of many inputs, o_outputs must have room for
+/// _inputs.size() hashes. Four inputs are hashed at once on CPUs with AVX2,
+/// others fall back to hashing them one by one.
+void sha3Batch(std::span<bytesConstRef const> _inputs, h256* o_outputs) noexcept;
+
 inline SecureFixedHash<32> sha3Secure(bytesConstRef _input) noexcept {
   SecureFixedHash<32> ret;
   sha3(_input, ret.writable().ref());
@@ -0,0 +1,157 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2014-2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include "SHA3.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define DEV_SHA3_BATCH_AVX2 1
+#endif
+
+namespace dev {
+namespace {
+
+#if DEV_SHA3_BATCH_AVX2
+
+constexpr size_t c_rateBytes = 136;
+constexpr size_t c_rateWords = c_rateBytes / 8;
+constexpr size_t c_lanes = 4;
+
+constexpr std::array<uint64_t, 24> c_roundConstants = {
+    0x0000000000000001, 0x0000000000008082, 0x800000000000808a, 0x8000000080008000, 0x000000000000808b,
+    0x0000000080000001, 0x8000000080008081, 0x8000000000008009, 0x000000000000008a, 0x0000000000000088,
+    0x0000000080008009, 0x000000008000000a, 0x000000008000808b, 0x800000000000008b, 0x8000000000008089,
+    0x8000000000008003, 0x8000000000008002, 0x8000000000000080, 0x000000000000800a, 0x800000008000000a,
+    0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008};
+
+// Rotation offsets of state words indexed by x + 5 * y
+constexpr std::array<int, 25> c_rotations = {0,  1,  62, 28, 27, 36, 44, 6,  55, 20, 3,  10, 43,
+                                             25, 39, 41, 45, 15, 21, 8,  18, 2,  61, 56, 14};
+
+__attribute__((target("avx2"))) inline __m256i rotl(__m256i _x, int _n) {
+  if (_n == 0) return _x;
+  return _mm256_or_si256(_mm256_sll_epi64(_x, _mm_cvtsi32_si128(_n)), _mm256_srl_epi64(_x, _mm_cvtsi32_si128(64 - _n)));
+}
+
+// Keccak-f[1600] of four independent states, lane i of every vector belongs to state i
+__attribute__((target("avx2"))) void keccakF1600x4(__m256i* _a) {
+  __m256i b[25];
+  __m256i c[5];
+  for (auto rc : c_roundConstants) {
+    // theta
+    for (int x = 0; x < 5; ++x) {
+      c[x] = _mm256_xor_si256(_mm256_xor_si256(_a[x], _a[x + 5]),
+                              _mm256_xor_si256(_mm256_xor_si256(_a[x + 10], _a[x + 15]), _a[x + 20]));
+    }
+    for (int x = 0; x < 5; ++x) {
+      auto const d = _mm256_xor_si256(c[(x + 4) % 5], rotl(c[(x + 1) % 5], 1));
+      for (int y = 0; y < 25; y += 5) _a[x + y] = _mm256_xor_si256(_a[x + y], d);
+    }
+    // rho and pi
+    for (int x = 0; x < 5; ++x) {
+      for (int y = 0; y < 5; ++y) {
+        b[y + 5 * ((2 * x + 3 * y) % 5)] = rotl(_a[x + 5 * y], c_rotations[x + 5 * y]);
+      }
+    }
+    // chi
+    for (int y = 0; y < 25; y += 5) {
+      for (int x = 0; x < 5; ++x) {
+        _a[x + y] = _mm256_xor_si256(b[x + y], _mm256_andnot_si256(b[(x + 1) % 5 + y], b[(x + 2) % 5 + y]));
+      }
+    }
+    // iota
+    _a[0] = _mm256_xor_si256(_a[0], _mm256_set1_epi64x(static_cast<long long>(rc)));
+  }
+}
+
+// Hashes up to four inputs, absorbing them in lockstep. Inputs of similar length waste the fewest permutations
+__attribute__((target("avx2"))) void sha3x4(bytesConstRef const* _inputs, size_t _count, h256* _outputs) {
+  __m256i a[25];
+  for (auto& w : a) w = _mm256_setzero_si256();
+
+  std::array<size_t, c_lanes> blocks{};
+  size_t maxBlocks = 0;
+  for (size_t l = 0; l < _count; ++l) {
+    // Padding takes at least one byte, so there is always a final partially filled block
+    blocks[l] = _inputs[l].size() / c_rateBytes + 1;
+    maxBlocks = std::max(maxBlocks, blocks[l]);
+  }
+
+  alignas(32) uint64_t words[c_lanes][c_rateWords];
+  for (size_t block = 0; block < maxBlocks; ++block) {
+    for (size_t l = 0; l < c_lanes; ++l) {
+      auto* laneWords = reinterpret_cast<byte*>(words[l]);
+      if (l >= _count || block >= blocks[l]) {
+        std::memset(laneWords, 0, c_rateBytes);
+      } else if (block + 1 < blocks[l]) {
+        std::memcpy(laneWords, _inputs[l].data() + block * c_rateBytes, c_rateBytes);
+      } else {
+        auto const tail = _inputs[l].size() - block * c_rateBytes;
+        std::memset(laneWords, 0, c_rateBytes);
+        std::memcpy(laneWords, _inputs[l].data() + block * c_rateBytes, tail);
+        laneWords[tail] ^= 0x01;
+        laneWords[c_rateBytes - 1] ^= 0x80;
+      }
+    }
+    for (size_t w = 0; w < c_rateWords; ++w) {
+      a[w] = _mm256_xor_si256(a[w], _mm256_set_epi64x(static_cast<long long>(words[3][w]),
+                                                      static_cast<long long>(words[2][w]),
+                                                      static_cast<long long>(words[1][w]),
+                                                      static_cast<long long>(words[0][w])));
+    }
+    keccakF1600x4(a);
+
+    // Lanes that absorbed their last block are squeezed now, their state is permuted further only as padding
+    alignas(32) uint64_t out[4][c_lanes];
+    bool squeezed = false;
+    for (size_t l = 0; l < _count; ++l) {
+      if (blocks[l] != block + 1) continue;
+      if (!squeezed) {
+        for (size_t w = 0; w < 4; ++w) _mm256_store_si256(reinterpret_cast<__m256i*>(out[w]), a[w]);
+        squeezed = true;
+      }
+      for (size_t w = 0; w < 4; ++w) std::memcpy(_outputs[l].data() + w * 8, &out[w][l], 8);
+    }
+  }
+}
+
+bool hasAvx2() {
+  static bool const c_hasAvx2 = __builtin_cpu_supports("avx2");
+  return c_hasAvx2;
+}
+
+#endif
+
+}  // namespace
+
+void sha3Batch(std::span<bytesConstRef const> _inputs, h256* o_outputs) noexcept {
+#if DEV_SHA3_BATCH_AVX2
+  if (_inputs.size() > 1 && hasAvx2()) {
+    // Inputs are grouped by length, so each group of four needs about the same number of permutations
+    std::vector<uint32_t> order(_inputs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](auto _l, auto _r) {
+      return _inputs[_l].size() / c_rateBytes < _inputs[_r].size() / c_rateBytes;
+    });
+    for (size_t i = 0; i < order.size(); i += c_lanes) {
+      auto const count = std::min(c_lanes, order.size() - i);
+      std::array<bytesConstRef, c_lanes> group;
+      std::array<h256, c_lanes> hashes;
+      for (size_t l = 0; l < count; ++l) group[l] = _inputs[order[i + l]];
+      sha3x4(group.data(), count, hashes.data());
+      for (size_t l = 0; l < count; ++l) o_outputs[order[i + l]] = hashes[l];
+    }
+    return;
+  }
+#endif
+  for (size_t i = 0; i < _inputs.size(); ++i) o_outputs[i] = sha3(_inputs[i]);
+}
+
+}  // namespace dev
@@ -13,6 +13,8 @@
 #include <secp256k1_recovery.h>
 #include <secp256k1_sha256.h>
 
+#include <thread>
+
 #include "AES.h"
 #include "CryptoPP.h"
 using namespace std;
@@ -188,6 +190,29 @@ Public dev::recover(Signature const& _sig, h256 const& _message) {
   return Public{&serializedPubkey[1], Public::ConstructFromPointer};
 }
 
+std::vector<Public> dev::recover(std::vector<std::pair<Signature, h256>> const& _batch, unsigned _threads) {
+  std::vector<Public> ret(_batch.size());
+  // Context is created once with precomputed tables and is only read here, so threads share it
+  auto const recoverRange = [&](size_t _begin, size_t _end) {
+    for (size_t i = _begin; i < _end; ++i) ret[i] = recover(_batch[i].first, _batch[i].second);
+  };
+
+  size_t const threads = std::max<size_t>(1, std::min<size_t>(_threads, _batch.size() / c_minRecoverBatchPerThread));
+  if (threads == 1) {
+    recoverRange(0, _batch.size());
+    return ret;
+  }
+
+  size_t const chunk = (_batch.size() + threads - 1) / threads;
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (size_t begin = chunk; begin < _batch.size(); begin += chunk)
+    workers.emplace_back(recoverRange, begin, std::min(begin + chunk, _batch.size()));
+  recoverRange(0, std::min(chunk, _batch.size()));
+  for (auto& w : workers) w.join();
+  return ret;
+}
+
 static const u256 c_secp256k1n(
     "11579208923731619542357098500868790785283756427907490438260516314151816149"
     "4337");
@@ -13,6 +13,8 @@
 #include <libdevcore/FixedHash.h>
 
 #include <mutex>
+#include <utility>
+#include <vector>
 
 namespace dev {
 
@@ -138,6 +140,15 @@ inline bytesSec decryptSymNoAuth(SecureFixedHash<32> const& _k, h128 const& _iv,
 /// Recovers Public key from signed message hash.
 Public recover(Signature const& _sig, h256 const& _hash);
 
+/// Minimal number of signatures recovered by a single thread in batch recovery.
+static const size_t c_minRecoverBatchPerThread = 16;
+
+/// Recovers Public keys of many signed message hashes. Results are in input order,
+/// empty Public stands for a signature that does not recover. Input is split
+/// between up to @a _threads threads, each getting at least c_minRecoverBatchPerThread
+/// signatures.
+std::vector<Public> recover(std::vector<std::pair<Signature, h256>> const& _batch, unsigned _threads = 1);
+
 /// Returns siganture of message hash.
 Signature sign(Secret const& _k, h256 const& _hash);
 
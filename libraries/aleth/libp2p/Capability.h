@@ -3,7 +3,11 @@
 // Licensed under the GNU General Public License, Version 3.
 #pragma once
 
+#include <chrono>
+
 #include "Common.h"
+#include "ReceiveBufferPool.h"
+#include "taraxa.hpp"
 
 namespace dev {
 namespace p2p {
@@ -33,11 +37,22 @@ class CapabilityFace {
   /// Called by the Host when the messaege is received from the peer
   /// @returns true if the message was interpreted, false if the message had not
   /// supported type.
-  virtual void interpretCapabilityPacket(std::weak_ptr<Session> session, unsigned packet_type, RLP const& payload) = 0;
+  /// payload points into buffer, capability keeps a reference to the buffer
+  /// instead of copying payload in case it is used after the call returns.
+  virtual void interpretCapabilityPacket(std::weak_ptr<Session> session, unsigned packet_type, RLP const& payload,
+                                         ReceiveBuffer const& buffer) = 0;
   /// Called by the Host when the peer is disconnected.
   /// Guaranteed to be called last after any interpretCapabilityPacket for this
   /// peer.
   virtual void onDisconnect(NodeID const& _nodeID) = 0;
+  /// Called by the Session when packet of supplied type is queued for sending.
+  virtual PacketPriority packetPriority(unsigned /*_packetType*/) const { return PacketPriority::Mid; }
+  /// Called by the Session before packet of supplied type, that is large enough to be compressed, is sent.
+  /// @returns false if packets of this type are not worth compressing (e.g. high-entropy signatures).
+  virtual bool compressPacket(unsigned /*_packetType*/) const { return true; }
+  /// Called by the Session after packet of supplied type was compressed, used to collect compression stats.
+  virtual void onPacketCompressed(unsigned /*_packetType*/, size_t /*_size*/, size_t /*_compressedSize*/,
+                                  std::chrono::microseconds /*_duration*/) {}
 };
 
 }  // namespace p2p
@@ -25,6 +25,7 @@ Host::Host(std::string _clientVersion, KeyPair const& kp, NetworkConfig _n, Tara
       session_ioc_(taraxa_conf.expected_parallelism),
       session_ioc_w_(ba::make_work_guard(session_ioc_)),
       strand_(ioc_),
+      crypto_tp_(std::max<uint>(1, taraxa_conf.crypto_threads)),
       m_tcp4Acceptor(session_ioc_),
       m_runTimer(ioc_),
       state_file_path_(std::move(state_file_path)),
@@ -35,6 +36,7 @@ Host::Host(std::string _clientVersion, KeyPair const& kp, NetworkConfig _n, Tara
       m_stretchPeers(taraxa_conf_.peer_stretch),
       m_listenPort(m_netConfig.listenPort),
       m_alias{kp},
+      m_ingressRateLimiter(taraxa_conf_.max_ingress_connections_per_ip, taraxa_conf_.ingress_connections_window),
       m_lastPing(chrono::steady_clock::time_point::min()),
       m_lastPeerLogMessage(chrono::steady_clock::time_point::min()) {
   assert(m_netConfig.listenPort);
@@ -42,7 +44,7 @@ Host::Host(std::string _clientVersion, KeyPair const& kp, NetworkConfig _n, Tara
   // try to open acceptor (todo: ipv6)
   Network::tcp4Listen(m_tcp4Acceptor, m_netConfig);
   m_tcpPublic = determinePublic();
-  RLPXHandshake::HostContext handshake_ctx{m_alias, {}, {}, {}, {}, {}};
+  RLPXHandshake::HostContext handshake_ctx{m_alias, {}, {}, {}, {}, {}, {}, {}, {}};
   handshake_ctx.port = m_listenPort;
   handshake_ctx.client_version = m_clientVersion;
   handshake_ctx.on_success = [this](auto const& id, auto const& rlp, auto frame_coder, auto socket) {
@@ -58,6 +60,9 @@ Host::Host(std::string _clientVersion, KeyPair const& kp, NetworkConfig _n, Tara
       }
     });
   };
+  handshake_ctx.crypto_executor = crypto_tp_.get_executor();
+  handshake_ctx.claim_remote = [this](auto const& handshake) { return claimHandshake(handshake); };
+  handshake_ctx.release_remote = [this](auto const& handshake) { releaseHandshake(handshake); };
   handshake_ctx_ = make_shared<decltype(handshake_ctx)>(std::move(handshake_ctx));
   auto restored_state = restore_state();
   auto const& enr = restored_state ? restored_state->enr
@@ -74,7 +79,7 @@ Host::Host(std::string _clientVersion, KeyPair const& kp, NetworkConfig _n, Tara
   m_nodeTable = make_unique<NodeTable>(
       ioc_, m_alias, NodeIPEndpoint(bi::make_address(listenAddress()), listenPort(), listenPort()),
       updateENR(enr, m_tcpPublic, listenPort()), m_netConfig.discovery, m_netConfig.allowLocalDiscovery,
-      taraxa_conf_.is_boot_node, taraxa_conf_.chain_id);
+      taraxa_conf_.is_boot_node, taraxa_conf_.chain_id, crypto_tp_.get_executor());
   m_nodeTable->setEventHandler(new NodeTableEventHandler([this](auto const&... args) { onNodeTableEvent(args...); }));
   if (restored_state) {
     for (auto const& node : restored_state->known_nodes) {
@@ -111,6 +116,10 @@ std::shared_ptr<Host> Host::make(std::string _clientVersion, CapabilitiesFactory
 }
 
 Host::~Host() {
+  // Crypto tasks post their results to io contexts and node table, no new ones start after stop
+  crypto_tp_.stop();
+  crypto_tp_.join();
+
   // shutdown acceptor from same executor
   ba::post(m_tcp4Acceptor.get_executor(), [this] {
     m_tcp4Acceptor.cancel();
@@ -301,7 +310,7 @@ void Host::startPeerSession(Public const& _id, RLP const& _hello, unique_ptr<RLP
                                    chrono::steady_clock::duration(),
                                    _hello[2].toSet<CapDesc>(),
                                },
-                               disconnect_reason);
+                               disconnect_reason, taraxa_conf_.link_emulation);
   if (!disconnect_reason) {
     m_sessions[_id] = session;
     LOG(m_logger) << "Peer connection successfully established with " << _id << "@" << _s->remoteEndpoint();
@@ -349,6 +358,24 @@ bool Host::isHandshaking(NodeID const& _id) const {
   return false;
 }
 
+bool Host::claimHandshake(RLPXHandshake const& _handshake) {
+  std::scoped_lock lock(handshaking_mutex_);
+  auto [it, inserted] =
+      handshaking_.emplace(_handshake.remote(), std::make_pair(&_handshake, _handshake.originated()));
+  if (inserted || it->second.first == &_handshake) {
+    return true;
+  }
+  // Both nodes connect to each other, both keep the connection originated by the node with lower id
+  return !_handshake.originated() && it->second.second && _handshake.remote() < id();
+}
+
+void Host::releaseHandshake(RLPXHandshake const& _handshake) {
+  std::scoped_lock lock(handshaking_mutex_);
+  if (auto it = handshaking_.find(_handshake.remote()); it != handshaking_.end() && it->second.first == &_handshake) {
+    handshaking_.erase(it);
+  }
+}
+
 bi::tcp::endpoint Host::determinePublic() const {
   // return listenIP (if public) > public > upnp > unspecified address.
 
@@ -411,6 +438,12 @@ void Host::runAcceptor() {
           return;
         }
         auto socket = make_shared<RLPXSocket>(std::move(_socket));
+        if (!m_ingressRateLimiter.allow(socket->remoteEndpoint().address())) {
+          cnetdetails << "Dropping incoming connect due to connections rate limit: " << socket->remoteEndpoint();
+          socket->close();
+          runAcceptor();
+          return;
+        }
         // Since a connecting peer might be a trusted node which should always connect allow up to max number of trusted
         // nodes above the limit
         if (peer_count_() > (peerSlots(Ingress) + m_netConfig.trustedNodes.size())) {
@@ -555,6 +588,15 @@ void Host::main_loop_body() {
   }
 
   peer_count_snapshot_ = peer_count_();
+  m_ingressRateLimiter.prune();
+  {
+    std::vector<std::pair<NodeID, chrono::steady_clock::duration>> peers_latency;
+    for (const auto& info : peerSessionInfos()) {
+      peers_latency.emplace_back(info.id, info.lastPing);
+    }
+    std::scoped_lock lock(peers_latency_mutex_);
+    peers_latency_snapshot_ = std::move(peers_latency);
+  }
 
   m_runTimer.expires_after(taraxa_conf_.main_loop_interval);
   m_runTimer.async_wait(ba::bind_executor(strand_, [this](...) { main_loop_body(); }));
@@ -11,12 +11,15 @@
 #include <chrono>
 #include <filesystem>
 #include <memory>
+#include <mutex>
 #include <set>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "Common.h"
 #include "ENR.h"
+#include "IpRateLimiter.h"
 #include "Network.h"
 #include "NodeTable.h"
 #include "Peer.h"
@@ -90,6 +93,11 @@ struct Host final : std::enable_shared_from_this<Host> {
   bool isRunning() { return !ioc_.stopped(); }
 
   uint64_t peer_count() const { return peer_count_snapshot_; }
+  /// Round trip times of the last pings of connected peers, refreshed by the main loop.
+  std::vector<std::pair<NodeID, std::chrono::steady_clock::duration>> peersLatency() const {
+    std::scoped_lock lock(peers_latency_mutex_);
+    return peers_latency_snapshot_;
+  }
   /// Get the port we're listening on currently.
   unsigned short listenPort() const { return m_listenPort; }
   /// Get our current node ID.
@@ -99,6 +107,9 @@ struct Host final : std::enable_shared_from_this<Host> {
 
   std::list<NodeEntry> getNodes() const { return m_nodeTable->snapshot(); }
 
+  /// Discovery packets counters and node table size.
+  NodeTable::Stats discoveryStats() const { return m_nodeTable->stats(); }
+
   void addNode(Node const& _node);
 
   void invalidateNode(NodeID const& _node);
@@ -121,6 +132,17 @@ struct Host final : std::enable_shared_from_this<Host> {
     });
   }
 
+  /// Sends payload shared by several peers without copying it, see Session::send.
+  void send(NodeID const& node_id, std::string capability_name, unsigned packet_type,
+            std::shared_ptr<const bytes> payload, std::function<void()>&& on_done = {}) {
+    ba::post(strand_, [=, this, capability_name = std::move(capability_name), payload = std::move(payload),
+                       on_done = std::move(on_done)]() mutable {
+      if (auto session = peerSession(node_id)) {
+        session->send(std::move(capability_name), packet_type, std::move(payload), std::move(on_done));
+      }
+    });
+  }
+
   /// Get the endpoint information.
   std::string enode() const {
     std::string address;
@@ -214,6 +236,13 @@ struct Host final : std::enable_shared_from_this<Host> {
 
   bool isHandshaking(NodeID const& _id) const;
 
+  /// Reserves remote node id of the handshake. Of two ingress handshakes with
+  /// the same node the first one wins, when both nodes connect to each other
+  /// the connection originated by the node with lower id is kept.
+  bool claimHandshake(RLPXHandshake const& _handshake);
+
+  void releaseHandshake(RLPXHandshake const& _handshake);
+
   /// Determines publicly advertised address.
   bi::tcp::endpoint determinePublic() const;
 
@@ -257,6 +286,9 @@ struct Host final : std::enable_shared_from_this<Host> {
   ba::executor_work_guard<ba::io_context::executor_type> session_ioc_w_;
 
   ba::io_context::strand strand_;
+  /// Runs ECIES handshakes and discovery signatures verification off the io
+  /// threads.
+  ba::thread_pool crypto_tp_;
   ///< Listening acceptor.
   /// Timer which, when network is running,
   /// calls run() every c_timerInterval ms.
@@ -287,6 +319,10 @@ struct Host final : std::enable_shared_from_this<Host> {
   /// because we flush zombie entries (null-weakptrs) as regular maintenance
   /// from a const method.
 
+  /// Limits ingress connections per remote IP address, used only by the
+  /// acceptor and main loop.
+  IpRateLimiter m_ingressRateLimiter;
+
   std::set<Peer*> m_pendingPeerConns;  /// Used only by connect(Peer&) to limit
   /// concurrently connecting to same node.
   /// See connect(shared_ptr<Peer>const&).
@@ -312,6 +348,14 @@ struct Host final : std::enable_shared_from_this<Host> {
   std::unique_ptr<NodeTable> m_nodeTable;  ///< Node table (uses kademlia-like discovery).
 
   std::atomic<uint64_t> peer_count_snapshot_ = 0;
+  /// Node ids with a handshake in progress, the handshake which reserved them
+  /// and its direction, so concurrent handshakes with the same node are dropped
+  /// early.
+  std::mutex handshaking_mutex_;
+  std::unordered_map<NodeID, std::pair<RLPXHandshake const*, bool>> handshaking_;
+
+  mutable std::mutex peers_latency_mutex_;
+  std::vector<std::pair<NodeID, std::chrono::steady_clock::duration>> peers_latency_snapshot_;
 
   // LOGGERS ARE THREAD SAFE
   mutable Logger m_logger{createLogger(VerbosityDebug, "net")};
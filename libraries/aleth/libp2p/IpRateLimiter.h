@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <map>
+
+#include "Common.h"
+
+namespace dev {
+namespace p2p {
+
+/**
+ * @brief Counts events per remote IP address in fixed time windows and rejects
+ * the ones over the limit. Used to bound handshakes and discovery packets a
+ * single address can make us process.
+ *
+ * Thread Safety
+ * Distinct Objects: Safe.
+ * Shared objects: Unsafe.
+ */
+class IpRateLimiter {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /// Limit of 0 disables limiting. Loopback addresses are never limited, all
+  /// nodes of a local network share them.
+  IpRateLimiter(unsigned _maxPerWindow, Clock::duration _window) : m_maxPerWindow(_maxPerWindow), m_window(_window) {}
+
+  /// Counts event from the address, returns false if the address already
+  /// reached the limit in the current window.
+  bool allow(bi::address const& _address, Clock::time_point _now = Clock::now()) {
+    if (!m_maxPerWindow || _address.is_loopback()) return true;
+    if (m_counters.size() >= c_maxTrackedAddresses) prune(_now);
+
+    auto& counter = m_counters[_address];
+    if (_now - counter.windowStart >= m_window) {
+      counter.windowStart = _now;
+      counter.count = 0;
+    }
+    if (counter.count >= m_maxPerWindow) return false;
+    ++counter.count;
+    return true;
+  }
+
+  /// Forgets addresses whose window is over, so memory is bounded by addresses
+  /// active in the last window.
+  void prune(Clock::time_point _now = Clock::now()) {
+    std::erase_if(m_counters, [&](auto const& _c) { return _now - _c.second.windowStart >= m_window; });
+  }
+
+  size_t size() const { return m_counters.size(); }
+
+ private:
+  /// Tracked addresses count at which expired ones are pruned on insert.
+  static constexpr size_t c_maxTrackedAddresses = 1 << 16;
+
+  struct Counter {
+    Clock::time_point windowStart;
+    unsigned count = 0;
+  };
+
+  unsigned const m_maxPerWindow;
+  Clock::duration const m_window;
+  std::map<bi::address, Counter> m_counters;
+};
+
+}  // namespace p2p
+}  // namespace dev
@@ -34,7 +34,8 @@ inline bool operator==(std::weak_ptr<NodeEntry> const& _weak, std::shared_ptr<No
 }
 
 NodeTable::NodeTable(ba::io_context& _io, KeyPair const& _alias, NodeIPEndpoint const& _endpoint, ENR const& _enr,
-                     bool _enabled, bool _allowLocalDiscovery, bool is_boot_node, uint32_t chain_id)
+                     bool _enabled, bool _allowLocalDiscovery, bool is_boot_node, uint32_t chain_id,
+                     ba::any_io_executor crypto_executor)
     : strand_(ba::make_strand(_io)),
       m_hostNodeID{_alias.pub()},
       m_hostNodeIDHash{sha3(m_hostNodeID)},
@@ -49,7 +50,8 @@ NodeTable::NodeTable(ba::io_context& _io, KeyPair const& _alias, NodeIPEndpoint
       m_timeoutsTimer{make_shared<ba::steady_timer>(_io)},
       m_endpointTrackingTimer{make_shared<ba::steady_timer>(_io)},
       is_boot_node_(is_boot_node),
-      chain_id_(chain_id) {
+      chain_id_(chain_id),
+      crypto_executor_(std::move(crypto_executor)) {
   if (is_boot_node_) {
     s_bucketSize = BOOT_NODE_BUCKET_SIZE;
   }
@@ -254,6 +256,42 @@ std::vector<std::shared_ptr<NodeEntry>> NodeTable::nearestNodeEntries(NodeID con
   return ret;
 }
 
+std::vector<Node> NodeTable::nearestNodes(NeighboursSnapshot const& _snapshot, NodeID const& _target) {
+  h256 const targetHash = sha3(_target);
+  std::vector<std::pair<int, Node const*>> byDistance;
+  byDistance.reserve(_snapshot.nodes.size());
+  for (auto const& [nodeIDHash, node] : _snapshot.nodes)
+    byDistance.emplace_back(distance(targetHash, nodeIDHash), &node);
+
+  auto const count = std::min<size_t>(byDistance.size(), NODE_BUCKET_SIZE);
+  std::partial_sort(byDistance.begin(), byDistance.begin() + count, byDistance.end(),
+                    [](auto const& _a, auto const& _b) { return _a.first < _b.first; });
+
+  std::vector<Node> ret;
+  ret.reserve(count);
+  for (size_t i = 0; i < count; ++i) ret.push_back(*byDistance[i].second);
+  return ret;
+}
+
+std::shared_ptr<NodeTable::NeighboursSnapshot const> NodeTable::neighboursSnapshot() {
+  auto const now = std::chrono::steady_clock::now();
+  if (m_neighboursSnapshot &&
+      (!m_neighboursSnapshotDirty || now - m_neighboursSnapshotTime < c_neighboursSnapshotIntervalMs))
+    return m_neighboursSnapshot;
+
+  auto snapshot = std::make_shared<NeighboursSnapshot>();
+  {
+    Guard l(x_state);
+    for (auto const& bucket : m_buckets)
+      for (auto const& nodeWeakPtr : bucket.nodes)
+        if (auto node = nodeWeakPtr.lock()) snapshot->nodes.emplace_back(node->nodeIDHash, node->node);
+  }
+  m_neighboursSnapshot = std::move(snapshot);
+  m_neighboursSnapshotTime = now;
+  m_neighboursSnapshotDirty = false;
+  return m_neighboursSnapshot;
+}
+
 void NodeTable::ping(Node const& _node, std::shared_ptr<NodeEntry> _replacementNodeEntry) {
   if (!m_socket->isOpen()) return;
 
@@ -322,6 +360,7 @@ void NodeTable::noteActiveNode(std::shared_ptr<NodeEntry> _nodeEntry) {
         // (i.e. to the end of the list)
         nodes.push_back(_nodeEntry);
         DEV_GUARDED(x_nodes) { m_allNodes.insert({_nodeEntry->id(), _nodeEntry}); }
+        m_neighboursSnapshotDirty = true;
         if (m_nodeEventHandler) m_nodeEventHandler->appendEvent(_nodeEntry->id(), NodeEntryAdded);
       } else {
         // if bucket is full, start eviction process for the least recently seen
@@ -334,6 +373,7 @@ void NodeTable::noteActiveNode(std::shared_ptr<NodeEntry> _nodeEntry) {
           nodes.pop_front();
           nodes.push_back(_nodeEntry);
           DEV_GUARDED(x_nodes) { m_allNodes.insert({_nodeEntry->id(), _nodeEntry}); }
+          m_neighboursSnapshotDirty = true;
           if (m_nodeEventHandler) m_nodeEventHandler->appendEvent(_nodeEntry->id(), NodeEntryAdded);
           return;
         }
@@ -360,6 +400,7 @@ void NodeTable::dropNode(std::shared_ptr<NodeEntry> _n) {
     NodeBucket& s = bucket_UNSAFE(_n.get());
     s.nodes.remove_if([_n](std::weak_ptr<NodeEntry> const& _bucketEntry) { return _bucketEntry == _n; });
   }
+  m_neighboursSnapshotDirty = true;
 
   DEV_GUARDED(x_nodes) { m_allNodes.erase(_n->id()); }
   DEV_GUARDED(x_ips) {
@@ -382,9 +423,33 @@ void NodeTable::onPacketReceived(UDPSocketFace*, bi::udp::endpoint const& _from,
       node_ip = m_ipMappings[_from];
     }
   }
-  try {
-    std::unique_ptr<DiscoveryDatagram> packet = DiscoveryDatagram::interpretUDP(node_ip, _packet);
+  m_packetsReceived.fetch_add(1, std::memory_order_relaxed);
+  if (!m_packetsRateLimiter.allow(node_ip.address())) {
+    m_packetsRateLimited.fetch_add(1, std::memory_order_relaxed);
+    LOG(m_logger) << "Dropping packet from " << node_ip << " due to packets rate limit";
+    return;
+  }
+  auto interpret = [this, node_ip, data = _packet.toBytes()] {
+    std::unique_ptr<DiscoveryDatagram> packet;
+    try {
+      packet = DiscoveryDatagram::interpretUDP(node_ip, &data);
+    } catch (std::exception const& _e) {
+      LOG(m_logger) << "Exception interpreting message from " << node_ip << ": " << _e.what();
+    } catch (...) {
+      LOG(m_logger) << "Exception interpreting message from " << node_ip;
+    }
     if (!packet) return;
+    ba::post(strand_,
+             [this, node_ip, packet = std::move(packet)]() mutable { handlePacket(node_ip, std::move(packet)); });
+  };
+  if (crypto_executor_)
+    ba::post(crypto_executor_, std::move(interpret));
+  else
+    interpret();
+}
+
+void NodeTable::handlePacket(bi::udp::endpoint const& node_ip, std::unique_ptr<DiscoveryDatagram> packet) {
+  try {
     if (packet->isExpired()) {
       LOG(m_logger) << "Expired " << packet->typeName() << " from " << packet->sourceid << "@" << node_ip;
       return;
@@ -465,8 +530,10 @@ std::shared_ptr<NodeEntry> NodeTable::handlePong(bi::udp::endpoint const& _from,
       sourceNodeEntry = it->second;
       sourceNodeEntry->lastPongReceivedTime = RLPXDatagramFace::secondsSinceEpoch();
 
-      if (sourceNodeEntry->endpoint() != _from)
+      if (sourceNodeEntry->endpoint() != _from) {
         sourceNodeEntry->node.set_endpoint(NodeIPEndpoint{_from.address(), _from.port(), nodeValidation.tcpPort});
+        m_neighboursSnapshotDirty = true;
+      }
     }
   }
 
@@ -549,8 +616,33 @@ std::shared_ptr<NodeEntry> NodeTable::handleFindNode(bi::udp::endpoint const& _f
   }
 
   auto const& in = dynamic_cast<FindNode const&>(_packet);
-  std::vector<std::shared_ptr<NodeEntry>> nearest = nearestNodeEntries(in.target);
+  m_findNodeAnswered.fetch_add(1, std::memory_order_relaxed);
   static unsigned constexpr nlimit = (NodeSocket::maxDatagramSize - 109) / 90;
+
+  // Boot node answers lots of FindNode requests, nearest nodes search over its
+  // big buckets and signing is done on crypto executor from the immutable
+  // snapshot, strand_ only sends the signed packets
+  if (is_boot_node_ && crypto_executor_) {
+    ba::post(crypto_executor_, [this, _from, sourceId = in.sourceid, target = in.target,
+                                snapshot = neighboursSnapshot()] {
+      auto const nearest = nearestNodes(*snapshot, target);
+      std::vector<Neighbours> packets;
+      for (unsigned offset = 0; offset < nearest.size(); offset += nlimit) {
+        auto& out = packets.emplace_back(_from);
+        for (auto i = offset; i < std::min<size_t>(nearest.size(), offset + nlimit); ++i)
+          out.neighbours.emplace_back(nearest[i]);
+        out.expiration = nextRequestExpirationTime();
+        LOG(m_logger) << out.typeName() << " to " << sourceId << "@" << _from;
+        out.sign(m_secret);
+      }
+      ba::post(strand_, [this, packets = std::move(packets)] {
+        for (auto const& out : packets) m_socket->send(out);
+      });
+    });
+    return sourceNodeEntry;
+  }
+
+  std::vector<std::shared_ptr<NodeEntry>> nearest = nearestNodeEntries(in.target);
   for (unsigned offset = 0; offset < nearest.size(); offset += nlimit) {
     Neighbours out(_from, nearest, offset, nlimit);
     out.expiration = nextRequestExpirationTime();
@@ -620,7 +712,10 @@ std::shared_ptr<NodeEntry> NodeTable::handlePingNode(bi::udp::endpoint const& _f
   if (sourceNodeEntry) {
     sourceNodeEntry->lastPongSentTime = RLPXDatagramFace::secondsSinceEpoch();
     // We should update entrypoint the one that node is reporting
-    sourceNodeEntry->node.external_udp_port = in.source.udpPort();
+    if (sourceNodeEntry->node.external_udp_port != in.source.udpPort()) {
+      sourceNodeEntry->node.external_udp_port = in.source.udpPort();
+      m_neighboursSnapshotDirty = true;
+    }
   }
 
   return sourceNodeEntry;
@@ -707,6 +802,8 @@ void NodeTable::doDiscovery() {
 
 void NodeTable::doHandleTimeouts() {
   runBackgroundTask(c_handleTimeoutsIntervalMs, m_timeoutsTimer, [this]() {
+    m_packetsRateLimiter.prune();
+
     std::vector<std::shared_ptr<NodeEntry>> nodesToActivate;
     for (auto it = m_sentPings.begin(); it != m_sentPings.end();) {
       if (std::chrono::steady_clock::now() > it->second.pingSentTime + m_requestTimeToLive) {
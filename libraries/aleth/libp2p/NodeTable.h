@@ -7,11 +7,13 @@
 #include <libp2p/UDP.h>
 
 #include <algorithm>
+#include <atomic>
 #include <boost/integer/static_log2.hpp>
 #include <cstdint>
 
 #include "ENR.h"
 #include "EndpointTracker.h"
+#include "IpRateLimiter.h"
 
 namespace dev {
 namespace p2p {
@@ -109,7 +111,8 @@ class NodeTable : UDPSocketEvents {
   /// Constructor requiring host for I/O, credentials, and IP Address, port to
   /// listen on and host ENR.
   NodeTable(ba::io_context& _io, KeyPair const& _alias, NodeIPEndpoint const& _endpoint, ENR const& _enr,
-            bool _enabled = true, bool _allowLocalDiscovery = false, bool is_boot_node = false, uint32_t chain_id = 0);
+            bool _enabled = true, bool _allowLocalDiscovery = false, bool is_boot_node = false, uint32_t chain_id = 0,
+            ba::any_io_executor crypto_executor = {});
 
   ~NodeTable() {
     if (m_socket->isOpen()) {
@@ -163,6 +166,19 @@ class NodeTable : UDPSocketEvents {
   /// Returns snapshot of table.
   std::list<NodeEntry> snapshot() const;
 
+  /// Discovery counters, packets counts are totals since start.
+  struct Stats {
+    uint64_t packetsReceived = 0;
+    uint64_t packetsRateLimited = 0;
+    uint64_t findNodeAnswered = 0;
+    unsigned nodesCount = 0;
+  };
+
+  Stats stats() const {
+    return {m_packetsReceived.load(std::memory_order_relaxed), m_packetsRateLimited.load(std::memory_order_relaxed),
+            m_findNodeAnswered.load(std::memory_order_relaxed), count()};
+  }
+
   /// Returns true if node id is in node table.
   bool haveNode(NodeID const& _id) {
     Guard l(x_nodes);
@@ -274,6 +290,20 @@ class NodeTable : UDPSocketEvents {
   /// Returns s_bucketSize nodes from node table which are closest to target.
   std::vector<std::shared_ptr<NodeEntry>> nearestNodeEntries(NodeID const& _target);
 
+  /// Immutable copy of the nodes in buckets, boot node answers FindNode from it
+  /// off strand_.
+  struct NeighboursSnapshot {
+    std::vector<std::pair<h256, Node>> nodes;  ///< Node id hash and node.
+  };
+
+  /// Returns NODE_BUCKET_SIZE nodes from the snapshot which are closest to
+  /// target.
+  static std::vector<Node> nearestNodes(NeighboursSnapshot const& _snapshot, NodeID const& _target);
+
+  /// Rebuilds neighbours snapshot if buckets changed and the snapshot is older
+  /// than c_neighboursSnapshotIntervalMs. Called only on strand_.
+  std::shared_ptr<NeighboursSnapshot const> neighboursSnapshot();
+
   /// Asynchronously drops _leastSeen node if it doesn't reply and adds
   /// _replacement node, otherwise _replacement is thrown away.
   void evict(NodeEntry const& _leastSeen, std::shared_ptr<NodeEntry> _replacement);
@@ -293,9 +323,12 @@ class NodeTable : UDPSocketEvents {
 
   /// General Network Events
 
-  /// Called by m_socket when packet is received.
+  /// Called by m_socket when packet is received. Verifies packet signature on
+  /// crypto executor and continues with handlePacket on strand_.
   void onPacketReceived(UDPSocketFace*, bi::udp::endpoint const& _from, bytesConstRef _packet) override;
 
+  void handlePacket(bi::udp::endpoint const& _from, std::unique_ptr<DiscoveryDatagram> _packet);
+
   std::shared_ptr<NodeEntry> handlePong(bi::udp::endpoint const& _from, DiscoveryDatagram const& _packet);
   std::shared_ptr<NodeEntry> handleNeighbours(bi::udp::endpoint const& _from, DiscoveryDatagram const& _packet);
   std::shared_ptr<NodeEntry> handleFindNode(bi::udp::endpoint const& _from, DiscoveryDatagram const& _packet);
@@ -386,6 +419,26 @@ class NodeTable : UDPSocketEvents {
 
   const bool is_boot_node_ = false;
   const uint32_t chain_id_ = 0;
+
+  /// Executor verifying packets signatures, empty to verify them on strand_.
+  ba::any_io_executor crypto_executor_;
+
+  /// Discovery packets accepted from single IP address per second.
+  static constexpr unsigned c_maxPacketsPerIp = 100;
+  /// Limits packets per IP address before their signatures are verified, used
+  /// only on strand_.
+  IpRateLimiter m_packetsRateLimiter{c_maxPacketsPerIp, std::chrono::seconds(1)};
+
+  /// How often boot node rebuilds neighbours snapshot while buckets change.
+  static constexpr std::chrono::milliseconds c_neighboursSnapshotIntervalMs{1000};
+  /// Used only on strand_, set whenever buckets change.
+  std::shared_ptr<NeighboursSnapshot const> m_neighboursSnapshot;
+  TimePoint m_neighboursSnapshotTime;
+  bool m_neighboursSnapshotDirty = true;
+
+  std::atomic<uint64_t> m_packetsReceived{0};
+  std::atomic<uint64_t> m_packetsRateLimited{0};
+  std::atomic<uint64_t> m_findNodeAnswered{0};
 };
 
 /**
@@ -45,6 +45,8 @@ class RLPXFrameCoderImpl {
   CryptoPP::Keccak_256 egressMac;   ///< State of MAC for egress ciphertext.
   CryptoPP::Keccak_256 ingressMac;  ///< State of MAC for ingress ciphertext.
 
+  bytes compressBuffer;  ///< Reused buffer for LZ4 output of egress frames.
+
  private:
   Mutex x_macEnc;  ///< Mutex.
 };
@@ -131,23 +133,26 @@ void RLPXFrameCoder::setup(bool _originated, h512 const& _remoteEphemeral, h256
 
 void RLPXFrameCoder::writeFrame(bytesConstRef _header, bytesConstRef _payload, bytes& o_bytes) {
   auto padding = (16 - (_payload.size() % 16)) % 16;
-  o_bytes = bytes(32 + _payload.size() + padding + h128::size);
+  // Frame is appended so that caller can reuse the buffer capacity and pack several frames into single write
+  const auto offset = o_bytes.size();
+  o_bytes.resize(offset + 32 + _payload.size() + padding + h128::size);
+  auto frame = o_bytes.data() + offset;
   // TODO: SECURITY check header values && header <= 16 bytes
-  bytesRef headerWithMac(o_bytes.data(), h256::size);
+  bytesRef headerWithMac(frame, h256::size);
   _header.copyTo(headerWithMac);
   m_impl->frameEnc.ProcessData(headerWithMac.data(), headerWithMac.data(), 16);
   updateEgressMACWithHeader(headerWithMac.cropped(0, 16));
   egressDigest().ref().copyTo(headerWithMac.cropped(h128::size, h128::size));
 
-  bytesRef packetRef(o_bytes.data() + 32, _payload.size());
-  m_impl->frameEnc.ProcessData(packetRef.data(), _payload.data(), _payload.size());
-  bytesRef paddingRef(o_bytes.data() + 32 + _payload.size(), padding);
+  // Payload is encrypted directly from the source into the output buffer, zeroed padding is encrypted in place
+  bytesRef packetWithPaddingRef(frame + 32, _payload.size() + padding);
+  m_impl->frameEnc.ProcessData(packetWithPaddingRef.data(), _payload.data(), _payload.size());
   if (padding) {
-    m_impl->frameEnc.ProcessData(paddingRef.data(), paddingRef.data(), padding);
+    m_impl->frameEnc.ProcessData(packetWithPaddingRef.data() + _payload.size(),
+                                 packetWithPaddingRef.data() + _payload.size(), padding);
   }
-  bytesRef packetWithPaddingRef(o_bytes.data() + 32, _payload.size() + padding);
   updateEgressMACWithFrame(packetWithPaddingRef);
-  bytesRef macRef(o_bytes.data() + 32 + _payload.size() + padding, h128::size);
+  bytesRef macRef(frame + 32 + _payload.size() + padding, h128::size);
   egressDigest().ref().copyTo(macRef);
 }
 
@@ -169,32 +174,34 @@ void RLPXFrameCoder::writeFrame(uint16_t _seqId, bytesConstRef _payload, bytes&
 
 void RLPXFrameCoder::LZ4compress(bytesConstRef payload, bytes& output) const {
   const uint32_t payload_size = LZ4_compressBound(payload.size());
-  output = bytes(payload_size);
+  output.resize(payload_size);
   const auto i = LZ4_compress_default(reinterpret_cast<const char*>(payload.data()),
                                       reinterpret_cast<char*>(output.data()), payload.size(), output.size());
   assert(i);
   output.resize(i);
 }
 
-void RLPXFrameCoder::writeCompressedFrame(uint16_t _seqId, bytesConstRef _payload, bytes& o_bytes) {
-  bytes data;
+uint32_t RLPXFrameCoder::writeCompressedFrame(uint16_t _seqId, bytesConstRef _payload, bytes& o_bytes) {
+  auto& data = m_impl->compressBuffer;
   RLPStream header;
   LZ4compress(_payload, data);
   uint32_t len = (uint32_t)data.size();
   header.appendRaw(bytes({::byte((len >> 16) & 0xff), ::byte((len >> 8) & 0xff), ::byte(len & 0xff)}));
   header.appendList(2) << static_cast<uint16_t>(ProtocolIdType::Compressed) << _seqId;
   writeFrame(&header.out(), &data, o_bytes);
+  return len;
 }
 
-void RLPXFrameCoder::writeCompressedFrame(uint16_t _seqId, uint32_t _totalSize, bytesConstRef _payload,
-                                          bytes& o_bytes) {
-  bytes data;
+uint32_t RLPXFrameCoder::writeCompressedFrame(uint16_t _seqId, uint32_t _totalSize, bytesConstRef _payload,
+                                              bytes& o_bytes) {
+  auto& data = m_impl->compressBuffer;
   RLPStream header;
   LZ4compress(_payload, data);
   uint32_t len = (uint32_t)data.size();
   header.appendRaw(bytes({::byte((len >> 16) & 0xff), ::byte((len >> 8) & 0xff), ::byte(len & 0xff)}));
   header.appendList(3) << static_cast<uint16_t>(ProtocolIdType::Compressed) << _seqId << _totalSize;
   writeFrame(&header.out(), &data, o_bytes);
+  return len;
 }
 
 bool RLPXFrameCoder::authAndDecryptHeader(bytesRef io) {
@@ -208,14 +215,13 @@ bool RLPXFrameCoder::authAndDecryptHeader(bytesRef io) {
 }
 
 uint32_t RLPXFrameCoder::decompressFrame(bytesRef payload, bytes& output) const {
-  bytes tmp(std::min(MAX_PACKET_SIZE,         // max packet size
-                     payload.size() * 255));  // max LZ4 compress ratio is 255
-  const auto i = LZ4_decompress_safe(reinterpret_cast<const char*>(payload.data()), reinterpret_cast<char*>(tmp.data()),
-                                     payload.size(), tmp.size());
+  output.resize(std::min(MAX_PACKET_SIZE,         // max packet size
+                         payload.size() * 255));  // max LZ4 compress ratio is 255
+  const auto i = LZ4_decompress_safe(reinterpret_cast<const char*>(payload.data()),
+                                     reinterpret_cast<char*>(output.data()), payload.size(), output.size());
   if (i <= 0) [[unlikely]]
     return i;
   output.resize(i);
-  output.insert(output.begin(), std::make_move_iterator(tmp.begin()), std::make_move_iterator(tmp.begin() + i));
   return i;
 }
 
@@ -68,7 +68,8 @@ class RLPXFrameCoder {
 
   ~RLPXFrameCoder();
 
-  /// Legacy. Encrypt _packet as ill-defined legacy RLPx frame.
+  /// Legacy. Encrypt _packet as ill-defined legacy RLPx frame. Frame is appended to o_bytes, as are frames of all
+  /// write methods.
   void writeSingleFramePacket(bytesConstRef _packet, bytes& o_bytes);
 
   /// Authenticate and decrypt header in-place.
@@ -88,14 +89,15 @@ class RLPXFrameCoder {
   void writeFrame(uint16_t _seqId, bytesConstRef _payload, bytes& o_bytes);
 
   void writeFrame(bytesConstRef _header, bytesConstRef _payload, bytes& o_bytes);
-  /// Compression
+  /// Compression, output must not alias payload
   uint32_t decompressFrame(bytesRef payload, bytes& output) const;
 
   void LZ4compress(bytesConstRef payload, bytes& output) const;
 
-  void writeCompressedFrame(uint16_t _seqId, bytesConstRef _payload, bytes& o_bytes);
+  /// @returns size of compressed payload
+  uint32_t writeCompressedFrame(uint16_t _seqId, bytesConstRef _payload, bytes& o_bytes);
 
-  void writeCompressedFrame(uint16_t _seqId, uint32_t _totalSize, bytesConstRef _payload, bytes& o_bytes);
+  uint32_t writeCompressedFrame(uint16_t _seqId, uint32_t _totalSize, bytesConstRef _payload, bytes& o_bytes);
   // Compression <--- end
 
   /// Update state of egress MAC with frame header.
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <netinet/tcp.h>
+
 #include "Common.h"
 
 namespace dev {
@@ -37,7 +39,23 @@ class RLPXSocket {
   }
   bi::tcp::socket& ref() { return m_socket; }
 
+  /**
+   * @brief Sends small frames without waiting for acks of previous ones and keeps only a little unsent data in the
+   *        kernel. Session orders packets by priority only before they are written to the socket, so with a deep kernel
+   *        buffer votes written after bulk sync data would wait until all of it is transmitted
+   */
+  void setLowLatency() {
+    boost::system::error_code ec;
+    m_socket.set_option(bi::tcp::no_delay(true), ec);
+#ifdef TCP_NOTSENT_LOWAT
+    m_socket.set_option(ba::detail::socket_option::integer<IPPROTO_TCP, TCP_NOTSENT_LOWAT>(c_notSentLowWatermark), ec);
+#endif
+  }
+
  private:
+  // Unsent bytes in the kernel buffer below which socket is writable again
+  static constexpr int c_notSentLowWatermark = 128 * 1024;
+
   bi::tcp::socket m_socket;
 };
 
@@ -42,31 +42,60 @@ RLPXHandshake::RLPXHandshake(std::shared_ptr<HostContext const> ctx, std::shared
   crypto::Nonce::get().ref().copyTo(m_nonce.ref());
 }
 
+void RLPXHandshake::start() {
+  if (m_originated && !claimRemote()) return;
+  transition();
+}
+
+bool RLPXHandshake::claimRemote() {
+  if (!host_ctx_->claim_remote || host_ctx_->claim_remote(*this)) {
+    m_remoteClaimed = true;
+    return true;
+  }
+  LOG(m_logger) << "Handshake with the node already in progress, dropping";
+  cancel();
+  return false;
+}
+
+void RLPXHandshake::releaseRemote() {
+  if (!m_remoteClaimed) return;
+  m_remoteClaimed = false;
+  if (host_ctx_->release_remote) host_ctx_->release_remote(*this);
+}
+
 void RLPXHandshake::writeAuth() {
   LOG(m_logger) << "auth to";
-  m_auth.resize(static_cast<size_t>(Signature::size) + static_cast<size_t>(h256::size) +
-                static_cast<size_t>(Public::size) + static_cast<size_t>(h256::size) + 1);
-  bytesRef sig(&m_auth[0], Signature::size);
-  bytesRef hepubk(&m_auth[Signature::size], h256::size);
-  bytesRef pubk(&m_auth[static_cast<size_t>(Signature::size) + static_cast<size_t>(h256::size)], Public::size);
-  bytesRef nonce(&m_auth[static_cast<size_t>(Signature::size) + static_cast<size_t>(h256::size) +
-                         static_cast<size_t>(Public::size)],
-                 h256::size);
-
-  // E(remote-pubk, S(ecdhe-random, ecdh-shared-secret^nonce) ||
-  // H(ecdhe-random-pubk) || pubk || nonce || 0x0)
-  Secret staticShared;
-  crypto::ecdh::agree(host_ctx_->key_pair.secret(), m_remote, staticShared);
-  sign(m_ecdheLocal.secret(), staticShared.makeInsecure() ^ m_nonce).ref().copyTo(sig);
-  sha3(m_ecdheLocal.pub().ref(), hepubk);
-  host_ctx_->key_pair.pub().ref().copyTo(pubk);
-  m_nonce.ref().copyTo(nonce);
-  m_auth[m_auth.size() - 1] = 0x0;
-  encryptECIES(m_remote, &m_auth, m_authCipher);
-
-  auto self(shared_from_this());
-  ba::async_write(m_socket->ref(), ba::buffer(m_authCipher),
-                  [this, self](boost::system::error_code ec, std::size_t) { transition(ec); });
+  runCrypto(
+      [this] {
+        bytes auth(static_cast<size_t>(Signature::size) + static_cast<size_t>(h256::size) +
+                   static_cast<size_t>(Public::size) + static_cast<size_t>(h256::size) + 1);
+        bytesRef sig(&auth[0], Signature::size);
+        bytesRef hepubk(&auth[Signature::size], h256::size);
+        bytesRef pubk(&auth[static_cast<size_t>(Signature::size) + static_cast<size_t>(h256::size)], Public::size);
+        bytesRef nonce(&auth[static_cast<size_t>(Signature::size) + static_cast<size_t>(h256::size) +
+                             static_cast<size_t>(Public::size)],
+                       h256::size);
+
+        // E(remote-pubk, S(ecdhe-random, ecdh-shared-secret^nonce) ||
+        // H(ecdhe-random-pubk) || pubk || nonce || 0x0)
+        Secret staticShared;
+        crypto::ecdh::agree(host_ctx_->key_pair.secret(), m_remote, staticShared);
+        sign(m_ecdheLocal.secret(), staticShared.makeInsecure() ^ m_nonce).ref().copyTo(sig);
+        sha3(m_ecdheLocal.pub().ref(), hepubk);
+        host_ctx_->key_pair.pub().ref().copyTo(pubk);
+        m_nonce.ref().copyTo(nonce);
+        auth[auth.size() - 1] = 0x0;
+        bytes authCipher;
+        encryptECIES(m_remote, &auth, authCipher);
+        return std::make_pair(std::move(auth), std::move(authCipher));
+      },
+      [this](std::pair<bytes, bytes> _auth) {
+        m_auth = std::move(_auth.first);
+        m_authCipher = std::move(_auth.second);
+        auto self(shared_from_this());
+        ba::async_write(m_socket->ref(), ba::buffer(m_authCipher),
+                        [this, self](boost::system::error_code ec, std::size_t) { transition(ec); });
+      });
 }
 
 void RLPXHandshake::writeAck() {
@@ -77,11 +106,18 @@ void RLPXHandshake::writeAck() {
   m_ecdheLocal.pub().ref().copyTo(epubk);
   m_nonce.ref().copyTo(nonce);
   m_ack[m_ack.size() - 1] = 0x0;
-  encryptECIES(m_remote, &m_ack, m_ackCipher);
-
-  auto self(shared_from_this());
-  ba::async_write(m_socket->ref(), ba::buffer(m_ackCipher),
-                  [this, self](boost::system::error_code ec, std::size_t) { transition(ec); });
+  runCrypto(
+      [this, ack = m_ack] {
+        bytes ackCipher;
+        encryptECIES(m_remote, &ack, ackCipher);
+        return ackCipher;
+      },
+      [this](bytes _ackCipher) {
+        m_ackCipher = std::move(_ackCipher);
+        auto self(shared_from_this());
+        ba::async_write(m_socket->ref(), ba::buffer(m_ackCipher),
+                        [this, self](boost::system::error_code ec, std::size_t) { transition(ec); });
+      });
 }
 
 void RLPXHandshake::writeAckEIP8() {
@@ -92,24 +128,40 @@ void RLPXHandshake::writeAckEIP8() {
   int padAmount(rand() % 100 + 100);
   m_ack.resize(m_ack.size() + padAmount, 0);
 
-  bytes prefix(2);
-  toBigEndian<uint16_t>(m_ack.size() + crypto::c_eciesOverhead, prefix);
-  encryptECIES(m_remote, bytesConstRef(&prefix), &m_ack, m_ackCipher);
-  m_ackCipher.insert(m_ackCipher.begin(), prefix.begin(), prefix.end());
-
-  auto self(shared_from_this());
-  ba::async_write(m_socket->ref(), ba::buffer(m_ackCipher),
-                  [this, self](boost::system::error_code ec, std::size_t) { transition(ec); });
+  runCrypto(
+      [this, ack = m_ack] {
+        bytes prefix(2);
+        toBigEndian<uint16_t>(ack.size() + crypto::c_eciesOverhead, prefix);
+        bytes ackCipher;
+        encryptECIES(m_remote, bytesConstRef(&prefix), &ack, ackCipher);
+        ackCipher.insert(ackCipher.begin(), prefix.begin(), prefix.end());
+        return ackCipher;
+      },
+      [this](bytes _ackCipher) {
+        m_ackCipher = std::move(_ackCipher);
+        auto self(shared_from_this());
+        ba::async_write(m_socket->ref(), ba::buffer(m_ackCipher),
+                        [this, self](boost::system::error_code ec, std::size_t) { transition(ec); });
+      });
 }
 
-void RLPXHandshake::setAuthValues(Signature const& _sig, Public const& _remotePubk, h256 const& _remoteNonce,
-                                  uint64_t _remoteVersion) {
-  _remotePubk.ref().copyTo(m_remote.ref());
-  _remoteNonce.ref().copyTo(m_remoteNonce.ref());
-  m_remoteVersion = _remoteVersion;
+RLPXHandshake::AuthValues RLPXHandshake::authValues(bytes _auth, Signature const& _sig, Public const& _remotePubk,
+                                                    h256 const& _remoteNonce, uint64_t _remoteVersion) const {
+  AuthValues values{std::move(_auth), _remotePubk, _remoteNonce, _remoteVersion, {}};
   Secret sharedSecret;
   crypto::ecdh::agree(host_ctx_->key_pair.secret(), _remotePubk, sharedSecret);
-  m_ecdheRemote = recover(_sig, sharedSecret.makeInsecure() ^ _remoteNonce);
+  values.ecdheRemote = recover(_sig, sharedSecret.makeInsecure() ^ _remoteNonce);
+  return values;
+}
+
+bool RLPXHandshake::setAuthValues(AuthValues&& _values) {
+  m_auth = std::move(_values.auth);
+  m_remote = _values.remote;
+  m_remoteNonce = _values.remoteNonce;
+  m_remoteVersion = _values.remoteVersion;
+  m_ecdheRemote = _values.ecdheRemote;
+  // Remote node id of ingress connection is known only now
+  return claimRemote();
 }
 
 void RLPXHandshake::readAuth() {
@@ -117,21 +169,31 @@ void RLPXHandshake::readAuth() {
   auto self(shared_from_this());
   ba::async_read(m_socket->ref(), ba::buffer(m_authCipher, c_authCipherSizeBytes),
                  [this, self](boost::system::error_code ec, std::size_t) {
-                   if (ec)
+                   if (ec) {
                      transition(ec);
-                   else if (decryptECIES(host_ctx_->key_pair.secret(), bytesConstRef(&m_authCipher), m_auth)) {
-                     LOG(m_logger) << "auth from";
-                     bytesConstRef data(&m_auth);
-                     Signature sig(data.cropped(0, Signature::size));
-                     Public pubk(data.cropped(static_cast<size_t>(Signature::size) + static_cast<size_t>(h256::size),
-                                              static_cast<size_t>(Public::size)));
-                     h256 nonce(data.cropped(static_cast<size_t>(Signature::size) + static_cast<size_t>(h256::size) +
-                                                 static_cast<size_t>(Public::size),
-                                             h256::size));
-                     setAuthValues(sig, pubk, nonce, 4);
-                     transition();
-                   } else
-                     readAuthEIP8();
+                     return;
+                   }
+                   runCrypto(
+                       [this]() -> std::optional<AuthValues> {
+                         bytes auth;
+                         if (!decryptECIES(host_ctx_->key_pair.secret(), bytesConstRef(&m_authCipher), auth)) {
+                           return {};
+                         }
+                         constexpr auto pubkOffset = static_cast<size_t>(Signature::size) + h256::size;
+                         bytesConstRef data(&auth);
+                         Signature sig(data.cropped(0, Signature::size));
+                         Public pubk(data.cropped(pubkOffset, Public::size));
+                         h256 nonce(data.cropped(pubkOffset + Public::size, h256::size));
+                         return authValues(std::move(auth), sig, pubk, nonce, 4);
+                       },
+                       [this](std::optional<AuthValues> _values) {
+                         if (!_values) {
+                           readAuthEIP8();
+                           return;
+                         }
+                         LOG(m_logger) << "auth from";
+                         if (setAuthValues(std::move(*_values))) transition();
+                       });
                  });
 }
 
@@ -143,21 +205,36 @@ void RLPXHandshake::readAuthEIP8() {
   auto rest = ba::buffer(ba::buffer(m_authCipher) + c_authCipherSizeBytes);
   auto self(shared_from_this());
   ba::async_read(m_socket->ref(), rest, [this, self](boost::system::error_code ec, std::size_t) {
-    bytesConstRef ct(&m_authCipher);
-    if (ec)
+    if (ec) {
       transition(ec);
-    else if (decryptECIES(host_ctx_->key_pair.secret(), ct.cropped(0, 2), ct.cropped(2), m_auth)) {
-      RLP rlp(m_auth, RLP::ThrowOnFail | RLP::FailIfTooSmall);
-      setAuthValues(rlp[0].toHash<Signature>(), rlp[1].toHash<Public>(), rlp[2].toHash<h256>(),
-                    rlp[3].toInt<uint64_t>());
-      m_nextState = AckAuthEIP8;
-      transition();
-    } else {
-      LOG(m_logger) << "EIP-8 auth decrypt failed";
-      m_nextState = Error;
-      m_failureReason = HandshakeFailureReason::FrameDecryptionFailure;
-      transition();
+      return;
     }
+    runCrypto(
+        [this]() -> std::optional<AuthValues> {
+          bytesConstRef ct(&m_authCipher);
+          bytes auth;
+          if (!decryptECIES(host_ctx_->key_pair.secret(), ct.cropped(0, 2), ct.cropped(2), auth)) {
+            return {};
+          }
+          RLP rlp(auth, RLP::ThrowOnFail | RLP::FailIfTooSmall);
+          auto const sig = rlp[0].toHash<Signature>();
+          auto const pubk = rlp[1].toHash<Public>();
+          auto const nonce = rlp[2].toHash<h256>();
+          auto const version = rlp[3].toInt<uint64_t>();
+          return authValues(std::move(auth), sig, pubk, nonce, version);
+        },
+        [this](std::optional<AuthValues> _values) {
+          if (!_values) {
+            LOG(m_logger) << "EIP-8 auth decrypt failed";
+            m_nextState = Error;
+            m_failureReason = HandshakeFailureReason::FrameDecryptionFailure;
+            transition();
+            return;
+          }
+          if (!setAuthValues(std::move(*_values))) return;
+          m_nextState = AckAuthEIP8;
+          transition();
+        });
   });
 }
 
@@ -166,16 +243,30 @@ void RLPXHandshake::readAck() {
   auto self(shared_from_this());
   ba::async_read(m_socket->ref(), ba::buffer(m_ackCipher, c_ackCipherSizeBytes),
                  [this, self](boost::system::error_code ec, std::size_t) {
-                   if (ec)
+                   if (ec) {
                      transition(ec);
-                   else if (decryptECIES(host_ctx_->key_pair.secret(), bytesConstRef(&m_ackCipher), m_ack)) {
-                     LOG(m_logger) << "ack from";
-                     bytesConstRef(&m_ack).cropped(0, Public::size).copyTo(m_ecdheRemote.ref());
-                     bytesConstRef(&m_ack).cropped(Public::size, h256::size).copyTo(m_remoteNonce.ref());
-                     m_remoteVersion = c_rlpxVersion;
-                     transition();
-                   } else
-                     readAckEIP8();
+                     return;
+                   }
+                   runCrypto(
+                       [this]() -> std::optional<bytes> {
+                         bytes ack;
+                         if (!decryptECIES(host_ctx_->key_pair.secret(), bytesConstRef(&m_ackCipher), ack)) {
+                           return {};
+                         }
+                         return ack;
+                       },
+                       [this](std::optional<bytes> _ack) {
+                         if (!_ack) {
+                           readAckEIP8();
+                           return;
+                         }
+                         LOG(m_logger) << "ack from";
+                         m_ack = std::move(*_ack);
+                         bytesConstRef(&m_ack).cropped(0, Public::size).copyTo(m_ecdheRemote.ref());
+                         bytesConstRef(&m_ack).cropped(Public::size, h256::size).copyTo(m_remoteNonce.ref());
+                         m_remoteVersion = c_rlpxVersion;
+                         transition();
+                       });
                  });
 }
 
@@ -187,26 +278,40 @@ void RLPXHandshake::readAckEIP8() {
   auto rest = ba::buffer(ba::buffer(m_ackCipher) + c_ackCipherSizeBytes);
   auto self(shared_from_this());
   ba::async_read(m_socket->ref(), rest, [this, self](boost::system::error_code ec, std::size_t) {
-    bytesConstRef ct(&m_ackCipher);
-    if (ec)
+    if (ec) {
       transition(ec);
-    else if (decryptECIES(host_ctx_->key_pair.secret(), ct.cropped(0, 2), ct.cropped(2), m_ack)) {
-      RLP rlp(m_ack, RLP::ThrowOnFail | RLP::FailIfTooSmall);
-      m_ecdheRemote = rlp[0].toHash<Public>();
-      m_remoteNonce = rlp[1].toHash<h256>();
-      m_remoteVersion = rlp[2].toInt<uint64_t>();
-      transition();
-    } else {
-      LOG(m_logger) << "EIP-8 ack decrypt failed";
-      m_failureReason = HandshakeFailureReason::FrameDecryptionFailure;
-      m_nextState = Error;
-      transition();
+      return;
     }
+    runCrypto(
+        [this]() -> std::optional<bytes> {
+          bytesConstRef ct(&m_ackCipher);
+          bytes ack;
+          if (!decryptECIES(host_ctx_->key_pair.secret(), ct.cropped(0, 2), ct.cropped(2), ack)) {
+            return {};
+          }
+          return ack;
+        },
+        [this](std::optional<bytes> _ack) {
+          if (!_ack) {
+            LOG(m_logger) << "EIP-8 ack decrypt failed";
+            m_failureReason = HandshakeFailureReason::FrameDecryptionFailure;
+            m_nextState = Error;
+            transition();
+            return;
+          }
+          m_ack = std::move(*_ack);
+          RLP rlp(m_ack, RLP::ThrowOnFail | RLP::FailIfTooSmall);
+          m_ecdheRemote = rlp[0].toHash<Public>();
+          m_remoteNonce = rlp[1].toHash<h256>();
+          m_remoteVersion = rlp[2].toInt<uint64_t>();
+          transition();
+        });
   });
 }
 
 void RLPXHandshake::cancel() {
   m_cancel = true;
+  releaseRemote();
   m_idleTimer.cancel();
   m_socket->close();
   m_io.reset();
@@ -281,6 +386,7 @@ void RLPXHandshake::transition(boost::system::error_code _ech) {
     s.append((unsigned)HelloPacket).appendList(5)
         << dev::p2p::c_protocolVersion << host_ctx_->client_version << host_ctx_->capability_descriptions
         << host_ctx_->port << host_ctx_->key_pair.pub();
+    m_handshakeOutBuffer.clear();
     m_io->writeSingleFramePacket(&s.out(), m_handshakeOutBuffer);
     ba::async_write(m_socket->ref(), ba::buffer(m_handshakeOutBuffer),
                     [this, self](boost::system::error_code ec, std::size_t) { transition(ec); });
@@ -409,6 +515,7 @@ void RLPXHandshake::transition(boost::system::error_code _ech) {
                     LOG(m_logger) << p2pPacketTypeToString(HelloPacket) << " verified. Starting session with";
                     try {
                       RLP rlp(frame.cropped(1), RLP::ThrowOnFail | RLP::FailIfTooSmall);
+                      releaseRemote();
                       host_ctx_->on_success(m_remote, rlp, std::move(m_io), m_socket);
                     } catch (std::exception const& _e) {
                       LOG(m_errorLogger) << "Handshake causing an exception: " << _e.what();
@@ -6,6 +6,7 @@
 #include <libdevcrypto/Common.h>
 
 #include <memory>
+#include <optional>
 
 #include "Common.h"
 #include "RLPXFrameCoder.h"
@@ -37,6 +38,14 @@ struct RLPXHandshake final : std::enable_shared_from_this<RLPXHandshake> {
     std::function<void(Public const&, RLP const&, std::unique_ptr<RLPXFrameCoder>, std::shared_ptr<RLPXSocket> const&)>
         on_success;
     std::function<void(NodeID const&, HandshakeFailureReason)> on_failure;
+    /// Executor for ECIES and signature operations, so they do not block
+    /// socket I/O. When empty they run on the socket executor.
+    ba::any_io_executor crypto_executor;
+    /// Reserves remote node id for the handshake, returns false if another
+    /// handshake with the same node should be used instead. Called from socket
+    /// executors, must be thread safe.
+    std::function<bool(RLPXHandshake const&)> claim_remote;
+    std::function<void(RLPXHandshake const&)> release_remote;
   };
   /// Setup incoming connection.
   RLPXHandshake(std::shared_ptr<HostContext const> ctx, std::shared_ptr<RLPXSocket> const& _socket);
@@ -44,14 +53,19 @@ struct RLPXHandshake final : std::enable_shared_from_this<RLPXHandshake> {
   /// Setup outbound connection.
   RLPXHandshake(std::shared_ptr<HostContext const> ctx, std::shared_ptr<RLPXSocket> const& _socket, NodeID _remote);
 
+  ~RLPXHandshake() { releaseRemote(); }
+
   /// Start handshake.
-  void start() { transition(); }
+  void start();
 
   /// Aborts the handshake.
   void cancel();
 
   NodeID remote() const { return m_remote; }
 
+  /// True if connection is outbound.
+  bool originated() const { return m_originated; }
+
  private:
   /// Timeout for a stage in the handshake to complete (the remote to respond to
   /// transition events). Enforced by m_idleTimer and refreshed by transition().
@@ -70,9 +84,61 @@ struct RLPXHandshake final : std::enable_shared_from_this<RLPXHandshake> {
   /// AckAuthEIP8.
   void readAuthEIP8();
 
-  /// Derives ephemeral secret from signature and sets members after Auth has
-  /// been decrypted.
-  void setAuthValues(Signature const& sig, Public const& remotePubk, h256 const& remoteNonce, uint64_t remoteVersion);
+  /// Values of decrypted Auth message.
+  struct AuthValues {
+    bytes auth;
+    Public remote;
+    h256 remoteNonce;
+    uint64_t remoteVersion = 0;
+    Public ecdheRemote;
+  };
+
+  /// Derives ephemeral secret from signature after Auth has been decrypted.
+  /// Runs on the crypto executor.
+  AuthValues authValues(bytes _auth, Signature const& sig, Public const& remotePubk, h256 const& remoteNonce,
+                        uint64_t remoteVersion) const;
+
+  /// Sets members from decrypted Auth message and reserves remote node id.
+  /// Returns false if handshake was canceled as a duplicate.
+  bool setAuthValues(AuthValues&& _values);
+
+  /// Reserves remote node id, cancels the handshake and returns false if
+  /// another handshake with the same node is in progress.
+  bool claimRemote();
+
+  /// Releases remote node id reserved by claimRemote.
+  void releaseRemote();
+
+  /// Runs _work on the crypto executor and _then with its result on the socket
+  /// executor, unless the handshake was canceled meanwhile. Exception thrown by
+  /// _work fails the handshake.
+  template <class Work, class Then>
+  void runCrypto(Work _work, Then _then) {
+    auto self(shared_from_this());
+    auto run = [this, self, work = std::move(_work), then = std::move(_then)]() mutable {
+      std::optional<decltype(work())> result;
+      try {
+        result.emplace(work());
+      } catch (std::exception const& _e) {
+        LOG(m_logger) << "Handshake crypto failed: " << _e.what();
+      }
+      auto resume = [this, self, result = std::move(result), then = std::move(then)]() mutable {
+        if (m_cancel) return;
+        if (!result) {
+          m_failureReason = HandshakeFailureReason::ProtocolError;
+          m_nextState = Error;
+          transition();
+          return;
+        }
+        then(std::move(*result));
+      };
+      ba::post(m_socket->ref().get_executor(), std::move(resume));
+    };
+    if (host_ctx_->crypto_executor)
+      ba::post(host_ctx_->crypto_executor, std::move(run));
+    else
+      run();
+  }
 
   /// Write Ack message to socket and transitions to WriteHello.
   void writeAck();
@@ -101,6 +167,7 @@ struct RLPXHandshake final : std::enable_shared_from_this<RLPXHandshake> {
 
   State m_nextState = New;  ///< Current or expected state of transition.
   bool m_cancel = false;    ///< Will be set to true if connection was canceled.
+  bool m_remoteClaimed = false;  ///< True if remote node id is reserved by this handshake.
 
   std::shared_ptr<HostContext const> host_ctx_;
 
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Common.h"
+
+namespace dev {
+namespace p2p {
+
+/// Buffer of a received packet, capability may keep a reference to it to use
+/// the packet after interpretCapabilityPacket returns instead of copying it.
+using ReceiveBuffer = std::shared_ptr<bytes>;
+
+/**
+ * @brief Pool of ingress frame buffers. Buffer goes back to the pool once its
+ * last reference is dropped, so sessions do not allocate a new buffer for every
+ * packet that was handed over to a capability.
+ *
+ * Thread Safety
+ * Distinct Objects: Safe.
+ * Shared objects: Safe.
+ */
+class ReceiveBufferPool : public std::enable_shared_from_this<ReceiveBufferPool> {
+ public:
+  /// Buffers over _maxPooledCapacity are freed instead of being pooled, so
+  /// small packets never pin memory of a large one received before.
+  static std::shared_ptr<ReceiveBufferPool> make(size_t _maxPooled, size_t _maxPooledCapacity) {
+    return std::shared_ptr<ReceiveBufferPool>(new ReceiveBufferPool(_maxPooled, _maxPooledCapacity));
+  }
+
+  /// Pool shared by all sessions of the process.
+  static std::shared_ptr<ReceiveBufferPool> const& shared() {
+    static auto const pool = make(c_defaultMaxPooled, c_defaultMaxPooledCapacity);
+    return pool;
+  }
+
+  /// @returns empty buffer, capacity of a reused one is kept.
+  ReceiveBuffer acquire() {
+    std::unique_ptr<bytes> buffer;
+    {
+      std::lock_guard lock(x_buffers);
+      if (!m_buffers.empty()) {
+        buffer = std::move(m_buffers.back());
+        m_buffers.pop_back();
+      }
+    }
+    if (!buffer) buffer = std::make_unique<bytes>();
+    return ReceiveBuffer(buffer.release(), [pool = weak_from_this()](bytes* _b) {
+      if (auto p = pool.lock()) {
+        p->release(std::unique_ptr<bytes>(_b));
+      } else {
+        delete _b;
+      }
+    });
+  }
+
+  size_t pooled() const {
+    std::lock_guard lock(x_buffers);
+    return m_buffers.size();
+  }
+
+ private:
+  static constexpr size_t c_defaultMaxPooled = 256;
+  static constexpr size_t c_defaultMaxPooledCapacity = 256 * 1024;
+
+  ReceiveBufferPool(size_t _maxPooled, size_t _maxPooledCapacity)
+      : m_maxPooled(_maxPooled), m_maxPooledCapacity(_maxPooledCapacity) {}
+
+  void release(std::unique_ptr<bytes> _buffer) {
+    if (_buffer->capacity() > m_maxPooledCapacity) return;
+    _buffer->clear();
+    std::lock_guard lock(x_buffers);
+    if (m_buffers.size() < m_maxPooled) m_buffers.push_back(std::move(_buffer));
+  }
+
+  size_t const m_maxPooled;
+  size_t const m_maxPooledCapacity;
+  mutable std::mutex x_buffers;
+  std::vector<std::unique_ptr<bytes>> m_buffers;
+};
+
+}  // namespace p2p
+}  // namespace dev
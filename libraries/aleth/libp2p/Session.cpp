@@ -8,6 +8,7 @@
 #include <libdevcore/Exceptions.h>
 #include <libp2p/Capability.h>
 
+#include <algorithm>
 #include <chrono>
 
 #include "RLPXFrameCoder.h"
@@ -15,17 +16,25 @@
 using namespace dev::p2p;
 
 static constexpr uint32_t MIN_COMPRESSION_SIZE = 500;
+// Max size of frames gathered from the write queue into single socket write
+static constexpr size_t MAX_GATHERED_WRITE_SIZE = 256 * 1024;
+// Output buffer capacity above which buffer is released instead of being reused for the next write
+static constexpr size_t MAX_RETAINED_OUT_BUFFER_SIZE = 1024 * 1024;
 
 Session::Session(SessionCapabilities caps, std::unique_ptr<RLPXFrameCoder> _io, std::shared_ptr<RLPXSocket> _s,
                  std::shared_ptr<Peer> _n, PeerSessionInfo _info,
-                 std::optional<DisconnectReason> immediate_disconnect_reason)
+                 std::optional<DisconnectReason> immediate_disconnect_reason, LinkEmulation _linkEmulation)
     : m_capabilities(std::move(caps)),
       m_io(std::move(_io)),
       m_socket(std::move(_s)),
+      m_linkEmulation(_linkEmulation),
+      m_latencyTimer(m_socket->ref().get_executor()),
+      m_bandwidthTimer(m_socket->ref().get_executor()),
       m_peer(std::move(_n)),
       m_info(std::move(_info)),
       m_ping(std::chrono::steady_clock::time_point::max()),
       immediate_disconnect_reason_(immediate_disconnect_reason) {
+  m_socket->setLowLatency();
   std::stringstream remoteInfoStream;
   remoteInfoStream << "(" << m_info.id << "@" << m_socket->remoteEndpoint() << ")";
   m_logSuffix = remoteInfoStream.str();
@@ -41,9 +50,10 @@ Session::Session(SessionCapabilities caps, std::unique_ptr<RLPXFrameCoder> _io,
 
 std::shared_ptr<Session> Session::make(SessionCapabilities caps, std::unique_ptr<RLPXFrameCoder> _io,
                                        std::shared_ptr<RLPXSocket> _s, std::shared_ptr<Peer> _n, PeerSessionInfo _info,
-                                       std::optional<DisconnectReason> immediate_disconnect_reason) {
+                                       std::optional<DisconnectReason> immediate_disconnect_reason,
+                                       LinkEmulation _linkEmulation) {
   std::shared_ptr<Session> ret(new Session(std::move(caps), std::move(_io), std::move(_s), std::move(_n),
-                                           std::move(_info), immediate_disconnect_reason));
+                                           std::move(_info), immediate_disconnect_reason, _linkEmulation));
   if (immediate_disconnect_reason) {
     ret->disconnect_(*immediate_disconnect_reason);
     return ret;
@@ -65,7 +75,7 @@ Session::~Session() {
   drop(ClientQuit);
 }
 
-void Session::readPacket(unsigned _packetType, RLP const& _r) {
+void Session::readPacket(unsigned _packetType, RLP const& _r, ReceiveBuffer const& _buffer) {
   if (muted_) {
     return;
   }
@@ -93,7 +103,7 @@ void Session::readPacket(unsigned _packetType, RLP const& _r) {
     disconnect_(BadProtocol);
     return;
   }
-  cap->ref->interpretCapabilityPacket(weak_from_this(), _packetType - cap->offset, _r);
+  cap->ref->interpretCapabilityPacket(weak_from_this(), _packetType - cap->offset, _r, _buffer);
 }
 
 void Session::interpretP2pPacket(P2pPacketType _t, RLP const& _r) {
@@ -167,52 +177,167 @@ void Session::send_(bytes _msg, std::function<void()> on_done) {
   if (!isConnected()) {
     return;
   }
-  m_writeQueue.emplace_back(SendRequest{std::move(_msg), std::move(on_done)});
-  if (m_writeQueue.size() == 1) {
+  // Capability decides per packet type whether compression pays off and how urgent the packet is, p2p packets are
+  // always small and sent with the highest priority
+  bool compress = true;
+  auto priority = PacketPriority::High;
+  if (auto cap = capabilityFor(_msg[0])) {
+    const auto packet_type = _msg[0] - cap->offset;
+    priority = std::min(cap->ref->packetPriority(packet_type), PacketPriority::Low);
+    if (_msg.size() >= MIN_COMPRESSION_SIZE) {
+      compress = cap->ref->compressPacket(packet_type);
+    }
+  }
+  SendRequest request{std::move(_msg), std::move(on_done), compress};
+  if (m_linkEmulation.latency.count()) [[unlikely]] {
+    m_delayedRequests.push_back(
+        DelayedRequest{std::chrono::steady_clock::now() + m_linkEmulation.latency, priority, std::move(request)});
+    if (m_delayedRequests.size() == 1) {
+      releaseDelayed();
+    }
+    return;
+  }
+  enqueue_(priority, std::move(request));
+}
+
+void Session::enqueue_(PacketPriority _priority, SendRequest&& _request) {
+  m_writeQueues[static_cast<size_t>(_priority)].push_back(std::move(_request));
+  if (!m_writing) {
     write();
   }
 }
 
-void Session::splitAndPack(uint16_t& sequence_id, uint32_t& sent_size) {
+void Session::releaseDelayed() {
+  auto const now = std::chrono::steady_clock::now();
+  while (!m_delayedRequests.empty() && m_delayedRequests.front().due <= now) {
+    auto& delayed = m_delayedRequests.front();
+    enqueue_(delayed.priority, std::move(delayed.request));
+    m_delayedRequests.pop_front();
+  }
+  if (m_delayedRequests.empty() || !isConnected()) {
+    return;
+  }
+  m_latencyTimer.expires_at(m_delayedRequests.front().due);
+  m_latencyTimer.async_wait([this, _ = shared_from_this()](boost::system::error_code ec) {
+    if (!ec) {
+      releaseDelayed();
+    }
+  });
+}
+
+void Session::splitAndPack(SendRequest& request, uint16_t& sequence_id, uint32_t& sent_size) {
+  const auto& payload = request.payload;
+  const auto compress = [&](auto&&... args) {
+    const auto start = std::chrono::steady_clock::now();
+    request.compressed_size += m_io->writeCompressedFrame(std::forward<decltype(args)>(args)..., m_out);
+    request.compression_duration +=
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+  };
+
   if (sequence_id) [[unlikely]] {
     // Sending last chunk
-    if (m_writeQueue[0].payload.size() < sent_size + RLPXFrameCoder::MAX_PACKET_SIZE) {
-      bytesConstRef data(m_writeQueue[0].payload.data() + sent_size, m_writeQueue[0].payload.size() - sent_size);
+    if (payload.size() < sent_size + RLPXFrameCoder::MAX_PACKET_SIZE) {
+      bytesConstRef data(payload.data() + sent_size, payload.size() - sent_size);
       if (data.size() < MIN_COMPRESSION_SIZE) {
         m_io->writeFrame(sequence_id, data, m_out);
       } else {
-        m_io->writeCompressedFrame(sequence_id, data, m_out);
+        compress(sequence_id, data);
       }
       sequence_id = 0;  // means we are finished
     } else {
-      m_io->writeCompressedFrame(
-          sequence_id, bytesConstRef(m_writeQueue[0].payload.data() + sent_size, RLPXFrameCoder::MAX_PACKET_SIZE),
-          m_out);
+      compress(sequence_id, bytesConstRef(payload.data() + sent_size, RLPXFrameCoder::MAX_PACKET_SIZE));
       sequence_id++;
       sent_size += RLPXFrameCoder::MAX_PACKET_SIZE;
     }
   } else [[likely]] {
     // Sending single chunk
-    if (m_writeQueue[0].payload.size() < RLPXFrameCoder::MAX_PACKET_SIZE) [[likely]] {
-      if (m_writeQueue[0].payload.size() < MIN_COMPRESSION_SIZE) [[likely]] {
-        m_io->writeSingleFramePacket(&m_writeQueue[0].payload, m_out);
+    if (payload.size() < RLPXFrameCoder::MAX_PACKET_SIZE) [[likely]] {
+      if (payload.size() < MIN_COMPRESSION_SIZE || !request.compress) [[likely]] {
+        m_io->writeSingleFramePacket(&payload, m_out);
       } else [[unlikely]] {
-        m_io->writeCompressedFrame(0, &m_writeQueue[0].payload, m_out);
+        compress(uint16_t{0}, bytesConstRef(&payload));
       }
     } else [[unlikely]] {
-      m_io->writeCompressedFrame(sequence_id, m_writeQueue[0].payload.size(),
-                                 bytesConstRef(m_writeQueue[0].payload.data(), RLPXFrameCoder::MAX_PACKET_SIZE), m_out);
+      // Multi-frame packets are always compressed as receiver expects total size only in compressed frame header
+      compress(sequence_id, static_cast<uint32_t>(payload.size()),
+               bytesConstRef(payload.data(), RLPXFrameCoder::MAX_PACKET_SIZE));
       sequence_id++;
       sent_size = RLPXFrameCoder::MAX_PACKET_SIZE;
     }
   }
+
+  if (!sequence_id && request.compressed_size) {
+    if (auto cap = capabilityFor(payload[0])) {
+      cap->ref->onPacketCompressed(payload[0] - cap->offset, payload.size(), request.compressed_size,
+                                   request.compression_duration);
+    }
+  }
+}
+
+void Session::write() {
+  // Output buffer is reused between writes, only an oversized one left by a huge packet is released
+  if (m_out.capacity() > MAX_RETAINED_OUT_BUFFER_SIZE) {
+    bytes().swap(m_out);
+  } else {
+    m_out.clear();
+  }
+  m_writing = true;
+
+  // Gather single frame packets in priority order so they all go out in one async_write. While multi-frame packet is
+  // being sent, they are interleaved between its chunks, so a huge sync packet does not delay votes.
+  for (auto& queue : m_writeQueues) {
+    while (!queue.empty() && m_out.size() < MAX_GATHERED_WRITE_SIZE) {
+      auto& request = queue.front();
+      if (request.payload.size() >= RLPXFrameCoder::MAX_PACKET_SIZE) [[unlikely]] {
+        // Only one multi-frame sequence can be sent at a time, it is started once nothing else is packed
+        if (m_multiFrameRequest || !m_out.empty()) {
+          break;
+        }
+        m_multiFrameRequest = std::move(request);
+        queue.pop_front();
+        break;
+      }
+      // Compressed frames are decoded as part of multi-frame sequence by the receiver, so interleaved packet must not
+      // be compressed
+      if (m_multiFrameRequest) [[unlikely]] {
+        request.compress = false;
+      }
+      uint16_t sequence_id = 0;
+      uint32_t sent_size = 0;
+      splitAndPack(request, sequence_id, sent_size);
+      m_sentRequests.push_back(std::move(request));
+      queue.pop_front();
+    }
+  }
+
+  // Next chunk of multi-frame packet
+  if (m_multiFrameRequest) [[unlikely]] {
+    splitAndPack(*m_multiFrameRequest, m_multiFrameSequenceId, m_multiFrameSentSize);
+    if (!m_multiFrameSequenceId) {
+      m_sentRequests.push_back(std::move(*m_multiFrameRequest));
+      m_multiFrameRequest.reset();
+      m_multiFrameSentSize = 0;
+    }
+  }
+
+  if (m_linkEmulation.bandwidth) [[unlikely]] {
+    // Buffer is written once it would have been transmitted at emulated bandwidth after the previous ones
+    auto const transmission = std::chrono::microseconds(m_out.size() * 1000000 / m_linkEmulation.bandwidth);
+    m_transmittedUntil = std::max(m_transmittedUntil, std::chrono::steady_clock::now()) + transmission;
+    m_bandwidthTimer.expires_at(m_transmittedUntil);
+    m_bandwidthTimer.async_wait([this, _ = shared_from_this()](boost::system::error_code ec) {
+      if (!ec) {
+        writeOut();
+      }
+    });
+    return;
+  }
+  writeOut();
 }
 
-void Session::write(uint16_t sequence_id, uint32_t sent_size) {
-  splitAndPack(sequence_id, sent_size);
+void Session::writeOut() {
   ba::async_write(m_socket->ref(), ba::buffer(m_out),
-                  [this, this_shared = shared_from_this(), sequence_id, sent_size](boost::system::error_code ec,
-                                                                                   std::size_t /*length*/) {
+                  [this, this_shared = shared_from_this()](boost::system::error_code ec, std::size_t /*length*/) {
                     // must check queue, as write callback can occur following
                     // dropped()
                     if (ec) [[unlikely]] {
@@ -220,18 +345,21 @@ void Session::write(uint16_t sequence_id, uint32_t sent_size) {
                       drop(TCPError);
                       return;
                     }
-                    if (!sequence_id) [[likely]] {
-                      if (m_writeQueue[0].on_done != nullptr) {
-                        m_writeQueue[0].on_done();
-                      }
-                      m_writeQueue.pop_front();
-                      if (m_writeQueue.empty()) {
-                        return;
+                    for (auto& request : m_sentRequests) {
+                      if (request.on_done != nullptr) {
+                        request.on_done();
                       }
-                      write();
-                    } else [[unlikely]] {
-                      write(sequence_id, sent_size);
                     }
+                    m_sentRequests.clear();
+
+                    const auto has_pending =
+                        m_multiFrameRequest ||
+                        std::any_of(m_writeQueues.begin(), m_writeQueues.end(), [](auto& q) { return !q.empty(); });
+                    if (!has_pending) {
+                      m_writing = false;
+                      return;
+                    }
+                    write();
                   });
 }
 
@@ -255,6 +383,8 @@ void Session::drop(DisconnectReason _reason) {
     } catch (...) {
     }
   }
+  m_latencyTimer.cancel();
+  m_bandwidthTimer.cancel();
   m_peer->m_lastDisconnect = _reason;
   m_dropped = true;
 }
@@ -277,14 +407,15 @@ void Session::doRead() {
   }
 
   auto self(shared_from_this());
-  m_data.resize(h256::size);
+  m_data = ownedBuffer(std::move(m_data));
+  m_data->resize(h256::size);
   ba::async_read(
-      m_socket->ref(), boost::asio::buffer(m_data, h256::size),
+      m_socket->ref(), boost::asio::buffer(*m_data, h256::size),
       [this, self](boost::system::error_code ec, std::size_t length) {
         if (!checkRead(h256::size, ec, length)) {
           return;
         }
-        if (!m_io->authAndDecryptHeader(bytesRef(m_data.data(), length))) {
+        if (!m_io->authAndDecryptHeader(bytesRef(m_data->data(), length))) {
           LOG(m_netLogger) << "Header decrypt failed";
           drop(BadProtocol);  // todo: better error
           return;
@@ -297,7 +428,7 @@ void Session::doRead() {
         uint16_t hSequenceId;
         uint32_t hTotalLength;
         try {
-          RLPXFrameInfo header(bytesConstRef(m_data.data(), length));
+          RLPXFrameInfo header(bytesConstRef(m_data->data(), length));
           hProtocolId = header.protocolId;
           hLength = header.length;
           hPadding = header.padding;
@@ -306,80 +437,90 @@ void Session::doRead() {
           hTotalLength = header.totalLength;
         } catch (std::exception const& _e) {
           LOG(m_netLogger) << "Exception decoding frame header RLP: " << _e.what() << " "
-                           << bytesConstRef(m_data.data(), h128::size).cropped(3);
+                           << bytesConstRef(m_data->data(), h128::size).cropped(3);
           drop(BadProtocol);
           return;
         }
 
         /// read padded frame and mac
         auto tlen = hLength + hPadding + h128::size;
-        m_data.resize(tlen);
+        m_data->resize(tlen);
         if (hMultiFrame && hSequenceId == 0) [[unlikely]] {
-          m_multiData.reserve(hTotalLength);
+          if (!m_multiData) {
+            m_multiData = ReceiveBufferPool::shared()->acquire();
+          }
+          m_multiData->reserve(hTotalLength);
         }
         ba::async_read(
-            m_socket->ref(), boost::asio::buffer(m_data, tlen),
+            m_socket->ref(), boost::asio::buffer(*m_data, tlen),
             [this, self, hLength, hProtocolId, tlen, hMultiFrame](boost::system::error_code ec, std::size_t length) {
               if (!checkRead(tlen, ec, length)) {
                 return;
               }
-              if (!m_io->authAndDecryptFrame(bytesRef(m_data.data(), tlen))) {
+              if (!m_io->authAndDecryptFrame(bytesRef(m_data->data(), tlen))) {
                 LOG(m_netLogger) << "Frame decrypt failed";
                 drop(BadProtocol);  // todo: better error
                 return;
               }
               auto packet_lenght = hLength;
               if (hProtocolId) {
-                packet_lenght = m_io->decompressFrame(bytesRef(m_data.data(), hLength), m_data);
+                // Decompressed frame gets its own buffer, which is then handed over to the capability as is
+                auto decompressed = ReceiveBufferPool::shared()->acquire();
+                packet_lenght = m_io->decompressFrame(bytesRef(m_data->data(), hLength), *decompressed);
                 if (packet_lenght <= 0) [[unlikely]] {
                   LOG(m_netLogger) << "Frame decompress failed";
                   drop(BadProtocol);
                   return;
                 }
+                m_data = std::move(decompressed);
               }
 
               if (hMultiFrame) [[unlikely]] {
-                m_multiData.insert(m_multiData.end(), std::make_move_iterator(m_data.begin()),
-                                   std::make_move_iterator(m_data.begin() + packet_lenght));
+                if (!m_multiData) {
+                  m_multiData = ReceiveBufferPool::shared()->acquire();
+                }
+                m_multiData->insert(m_multiData->end(), m_data->begin(), m_data->begin() + packet_lenght);
                 if (packet_lenght < RLPXFrameCoder::MAX_PACKET_SIZE) {
-                  bytesConstRef frame(m_multiData.data(), m_multiData.size());
-                  auto packetType =
-                      static_cast<P2pPacketType>(RLP(frame.cropped(0, 1), RLP::LaissezFaire).toInt<unsigned>());
-                  if (!checkPacket(frame)) {
-                    auto packet_type_str = capabilityPacketTypeToString(capabilityFor(packetType), packetType);
-                    LOG(m_netLogger) << "Received invalid packet. Packet type (possibly "
-                                        "corrupted): "
-                                     << packetType << " (" << packet_type_str << "). Frame Size: " << frame.size()
-                                     << ". Size encoded in RLP: "
-                                     << RLP(frame.cropped(1), RLP::LaissezFaire).actualSize()
-                                     << ". Message: " << toHex(frame) << std::endl;
-                    disconnect_(BadProtocol);
+                  // Capability may keep the buffer, next multi-frame packet is gathered into a new one
+                  auto multi_data = std::move(m_multiData);
+                  if (!deliverFrame(multi_data, bytesConstRef(multi_data.get()))) {
                     return;
                   }
-                  readPacket(packetType, RLP(frame.cropped(1)));
-                  m_multiData.clear();
                 }
               } else [[likely]] {
-                bytesConstRef frame(m_data.data(), packet_lenght);
-                auto packetType =
-                    static_cast<P2pPacketType>(RLP(frame.cropped(0, 1), RLP::LaissezFaire).toInt<unsigned>());
-                if (!checkPacket(frame)) {
-                  auto packet_type_str = capabilityPacketTypeToString(capabilityFor(packetType), packetType);
-                  LOG(m_netLogger) << "Received invalid packet. Packet type (possibly "
-                                      "corrupted): "
-                                   << packetType << " (" << packet_type_str << "). Frame Size: " << frame.size()
-                                   << ". Size encoded in RLP: " << RLP(frame.cropped(1), RLP::LaissezFaire).actualSize()
-                                   << ". Message: " << toHex(frame) << std::endl;
-                  disconnect_(BadProtocol);
+                if (!deliverFrame(m_data, bytesConstRef(m_data->data(), packet_lenght))) {
                   return;
                 }
-                readPacket(packetType, RLP(frame.cropped(1)));
               }
               doRead();
             });
       });
 }
 
+bool Session::deliverFrame(ReceiveBuffer const& _buffer, bytesConstRef _frame) {
+  auto packetType = static_cast<P2pPacketType>(RLP(_frame.cropped(0, 1), RLP::LaissezFaire).toInt<unsigned>());
+  if (!checkPacket(_frame)) {
+    auto packet_type_str = capabilityPacketTypeToString(capabilityFor(packetType), packetType);
+    LOG(m_netLogger) << "Received invalid packet. Packet type (possibly "
+                        "corrupted): "
+                     << packetType << " (" << packet_type_str << "). Frame Size: " << _frame.size()
+                     << ". Size encoded in RLP: " << RLP(_frame.cropped(1), RLP::LaissezFaire).actualSize()
+                     << ". Message: " << toHex(_frame) << std::endl;
+    disconnect_(BadProtocol);
+    return false;
+  }
+  readPacket(packetType, RLP(_frame.cropped(1)), _buffer);
+  return true;
+}
+
+ReceiveBuffer Session::ownedBuffer(ReceiveBuffer&& _buffer) {
+  // Buffer that is still referenced by a queued packet must not be overwritten by the next read
+  if (_buffer && _buffer.use_count() == 1) {
+    return std::move(_buffer);
+  }
+  return ReceiveBufferPool::shared()->acquire();
+}
+
 bool Session::checkRead(std::size_t expected, boost::system::error_code ec, std::size_t length) {
   if (ec && ec.category() != boost::asio::error::get_misc_category() && ec.value() != boost::asio::error::eof) {
     LOG(m_netLogger) << "Error reading: " << ec.message();
@@ -8,6 +8,8 @@
 #include <libdevcore/Guards.h>
 #include <libdevcore/RLP.h>
 
+#include <array>
+#include <chrono>
 #include <deque>
 #include <memory>
 #include <shared_mutex>
@@ -16,6 +18,7 @@
 #include "Common.h"
 #include "Peer.h"
 #include "RLPXSocket.h"
+#include "ReceiveBufferPool.h"
 #include "taraxa.hpp"
 
 namespace dev {
@@ -32,13 +35,14 @@ class RLPXFrameCoder;
 struct Session final : std::enable_shared_from_this<Session> {
  private:
   Session(SessionCapabilities caps, std::unique_ptr<RLPXFrameCoder> _io, std::shared_ptr<RLPXSocket> _s,
-          std::shared_ptr<Peer> _n, PeerSessionInfo _info,
-          std::optional<DisconnectReason> immediate_disconnect_reason = {});
+          std::shared_ptr<Peer> _n, PeerSessionInfo _info, std::optional<DisconnectReason> immediate_disconnect_reason,
+          LinkEmulation _linkEmulation);
 
  public:
   static std::shared_ptr<Session> make(SessionCapabilities caps, std::unique_ptr<RLPXFrameCoder> _io,
                                        std::shared_ptr<RLPXSocket> _s, std::shared_ptr<Peer> _n, PeerSessionInfo _info,
-                                       std::optional<DisconnectReason> immediate_disconnect_reason = {});
+                                       std::optional<DisconnectReason> immediate_disconnect_reason = {},
+                                       LinkEmulation _linkEmulation = {});
   ~Session();
 
   void disconnect(DisconnectReason _reason) {
@@ -50,14 +54,17 @@ struct Session final : std::enable_shared_from_this<Session> {
     ba::post(m_socket->ref().get_executor(),
              [=, this, _ = shared_from_this(), capability_name = std::move(capability_name),
               payload = std::move(payload), on_done = std::move(on_done)]() mutable {
-               auto cap_itr = m_capabilities.find(capability_name);
-               assert(cap_itr != m_capabilities.end());
-               auto header = packet_type + cap_itr->second.offset;
-               assert(header <= std::numeric_limits<byte>::max());
-               bytes msg(1 + payload.size());
-               msg[0] = header;
-               memmove(msg.data() + 1, payload.data(), payload.size());
-               send_(std::move(msg), std::move(on_done));
+               sendPayload_(capability_name, packet_type, &payload, std::move(on_done));
+             });
+  }
+
+  /// Payload is shared by all sessions it is broadcast to, so it is encoded only once.
+  void send(std::string capability_name, unsigned packet_type, std::shared_ptr<const bytes> payload,
+            std::function<void()>&& on_done = {}) {
+    ba::post(m_socket->ref().get_executor(),
+             [=, this, _ = shared_from_this(), capability_name = std::move(capability_name),
+              payload = std::move(payload), on_done = std::move(on_done)]() mutable {
+               sendPayload_(capability_name, packet_type, payload.get(), std::move(on_done));
              });
   }
 
@@ -87,6 +94,26 @@ struct Session final : std::enable_shared_from_this<Session> {
 
   void send_(bytes _msg, std::function<void()> on_done = {});
 
+  /// Prefixes capability payload with its packet header.
+  void sendPayload_(std::string const& _capabilityName, unsigned _packetType, bytes const* _payload,
+                    std::function<void()>&& _onDone) {
+    auto cap_itr = m_capabilities.find(_capabilityName);
+    assert(cap_itr != m_capabilities.end());
+    auto header = _packetType + cap_itr->second.offset;
+    assert(header <= std::numeric_limits<byte>::max());
+    bytes msg(1 + _payload->size());
+    msg[0] = header;
+    memmove(msg.data() + 1, _payload->data(), _payload->size());
+    send_(std::move(msg), std::move(_onDone));
+  }
+
+  struct SendRequest;
+  /// Queue packed request for writing, write is started if none is in progress.
+  void enqueue_(PacketPriority _priority, SendRequest&& _request);
+
+  /// Move requests whose emulated latency passed into write queues and wait for the next one.
+  void releaseDelayed();
+
   /// Drop the connection for the reason @a _r.
   void drop(DisconnectReason _r);
 
@@ -98,12 +125,22 @@ struct Session final : std::enable_shared_from_this<Session> {
 
   /// Perform a single round of the write operation. This could end up calling
   /// itself asynchronously.
-  void write(uint16_t sequence_id = 0, uint32_t sent_size = 0);
+  void write();
+
+  /// Write gathered m_out to the socket.
+  void writeOut();
 
-  void splitAndPack(uint16_t& sequence_id, uint32_t& sent_size);
+  /// Append frame(s) of payload to the output buffer, sequence_id stays non-zero until last chunk is packed.
+  void splitAndPack(SendRequest& request, uint16_t& sequence_id, uint32_t& sent_size);
 
-  /// Deliver RLPX packet to Session or PeerCapability for interpretation.
-  void readPacket(unsigned _t, RLP const& _r);
+  /// Deliver RLPX packet to Session or PeerCapability for interpretation, _r points into _buffer.
+  void readPacket(unsigned _t, RLP const& _r, ReceiveBuffer const& _buffer);
+
+  /// Check received frame and deliver it, frame is the packet type followed by its rlp.
+  bool deliverFrame(ReceiveBuffer const& _buffer, bytesConstRef _frame);
+
+  /// @returns _buffer if no one else references it, otherwise a new one from the pool.
+  static ReceiveBuffer ownedBuffer(ReceiveBuffer&& _buffer);
 
   struct UnknownP2PPacketType : std::runtime_error {
     using runtime_error::runtime_error;
@@ -129,11 +166,34 @@ struct Session final : std::enable_shared_from_this<Session> {
   struct SendRequest {
     bytes payload;
     std::function<void()> on_done;
+    bool compress = true;  ///< False if capability reported the packet type as not worth compressing.
+    size_t compressed_size = 0;
+    std::chrono::microseconds compression_duration{0};
+  };
+  struct DelayedRequest {
+    std::chrono::steady_clock::time_point due;
+    PacketPriority priority;
+    SendRequest request;
   };
-  std::deque<SendRequest> m_writeQueue;  ///< The write queue.
-  std::vector<byte> m_data;              ///< Buffer for ingress packet data.
-  std::vector<byte> m_multiData;         ///< Buffer for multipacket data.
-  bytes m_out;
+  LinkEmulation const m_linkEmulation;
+  /// Requests held back by emulated latency, due times are non-decreasing.
+  std::deque<DelayedRequest> m_delayedRequests;
+  ba::steady_timer m_latencyTimer;
+  /// Emulated bandwidth delays writes until previous ones would have been transmitted.
+  ba::steady_timer m_bandwidthTimer;
+  std::chrono::steady_clock::time_point m_transmittedUntil;
+  /// The write queues per priority.
+  std::array<std::deque<SendRequest>, PacketPrioritiesCount> m_writeQueues;
+  /// Requests completely packed into currently written m_out.
+  std::vector<SendRequest> m_sentRequests;
+  /// Packet which is being sent in multiple frames, its sequence id of the next frame and already packed size.
+  std::optional<SendRequest> m_multiFrameRequest;
+  uint16_t m_multiFrameSequenceId = 0;
+  uint32_t m_multiFrameSentSize = 0;
+  bool m_writing = false;         ///< True while async write is in progress.
+  ReceiveBuffer m_data;           ///< Buffer for ingress packet data.
+  ReceiveBuffer m_multiData;      ///< Buffer for multipacket data.
+  bytes m_out;                    ///< Reused buffer for egress frames of a single write.
 
   std::shared_ptr<Peer> m_peer;  ///< The Peer object.
   bool m_dropped = false;        ///< If true, we've already divested ourselves of this peer. We're
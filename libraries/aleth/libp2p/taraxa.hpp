@@ -4,6 +4,17 @@
 
 namespace dev::p2p {
 
+/**
+ * @brief Conditions of emulated link applied to egress of every session, lets local test networks behave like
+ * geographically distributed ones. Zero values disable the corresponding part.
+ */
+struct LinkEmulation {
+  // One way delay added to every packet
+  std::chrono::milliseconds latency{0};
+  // Egress bytes per second of a single session
+  uint64_t bandwidth = 0;
+};
+
 struct TaraxaNetworkConfig {
   unsigned ideal_peer_count = 11;
   unsigned peer_stretch = 7;
@@ -14,8 +25,20 @@ struct TaraxaNetworkConfig {
   std::chrono::seconds peer_healthcheck_timeout{1};
   std::chrono::milliseconds main_loop_interval{100};
   std::chrono::seconds log_active_peers_interval{30};
+  // Threads doing ECIES handshakes and discovery signatures verification
+  uint crypto_threads = 2;
+  // Ingress connections accepted from a single IP address per window, 0 disables the limit
+  unsigned max_ingress_connections_per_ip = 16;
+  std::chrono::seconds ingress_connections_window{10};
+  LinkEmulation link_emulation;
 };
 
+/**
+ * @brief Priority of outbound packet, packets of higher priority are sent first by the Session.
+ */
+enum class PacketPriority : unsigned { High = 0, Mid, Low };
+constexpr size_t PacketPrioritiesCount = 3;
+
 class CapabilityFace;
 
 struct Capability {
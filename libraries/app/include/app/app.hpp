@@ -7,6 +7,7 @@
 
 #include "cli/config.hpp"
 #include "common/app_base.hpp"
+#include "common/stage_timings.hpp"
 #include "common/thread_pool.hpp"
 #include "config/config.hpp"
 #include "key_manager/key_manager.hpp"
@@ -16,6 +17,9 @@
 namespace taraxa {
 
 class Plugin;
+namespace storage::migration {
+class Manager;
+}
 
 class App : public std::enable_shared_from_this<App>, public AppBase {
  public:
@@ -43,9 +47,19 @@ class App : public std::enable_shared_from_this<App>, public AppBase {
   std::shared_ptr<DagBlockProposer> getDagBlockProposer() const { return dag_block_proposer_; }
   std::shared_ptr<GasPricer> getGasPricer() const { return gas_pricer_; }
   std::shared_ptr<pillar_chain::PillarChainManager> getPillarChainManager() const { return pillar_chain_mgr_; }
+  std::map<std::string, uint64_t> getMemoryStats() const;
+  std::map<std::string, uint64_t> getRuntimeConfig() const;
+  void updateRuntimeConfig(const std::map<std::string, uint64_t>& values);
 
   void rebuildDb();
 
+  /**
+   * @brief Installs stage timings into components. Node installs ones observed into metrics in init, replaced by
+   *        taraxa-sync-benchmark. Call between init and start
+   * @param timings
+   */
+  void setStageTimings(std::shared_ptr<util::StageTimings> timings);
+
   void initialize(const std::filesystem::path& data_dir,
                   std::shared_ptr<boost::program_options::variables_map> options) const;
 
@@ -85,15 +99,28 @@ class App : public std::enable_shared_from_this<App>, public AppBase {
 
   bool isPluginEnabled(const std::string& name) const;
 
+  /**
+   * @brief Watches node config file and applies changes of logging config and of runtime settings, see
+   *        updateRuntimeConfig
+   */
   void scheduleLoggingConfigUpdate();
 
  private:
   std::shared_ptr<util::ThreadPool> subscription_pool_ = std::make_shared<util::ThreadPool>(1);
   util::ThreadPool config_update_executor_{1};
+  static constexpr uint64_t kConfigFileCheckIntervalMs = 10000;
+  // Serializes runtime config updates from rpc and from config file
+  std::mutex runtime_config_mutex_;
+  // Runtime settings as they were in config file when it was last applied, used only on config_update_executor_
+  std::map<std::string, uint64_t> file_runtime_config_;
+  // Periodically catches replica up with db of its primary node
+  std::unique_ptr<util::ThreadPool> replica_catch_up_executor_;
 
   // components
   std::shared_ptr<DbStorage> db_;
   std::shared_ptr<DbStorage> old_db_;
+  // Kept while online migrations run in background
+  std::shared_ptr<storage::migration::Manager> migration_manager_;
   std::shared_ptr<GasPricer> gas_pricer_;
   std::shared_ptr<DagManager> dag_mgr_;
   std::shared_ptr<TransactionManager> trx_mgr_;
@@ -106,12 +133,18 @@ class App : public std::enable_shared_from_this<App>, public AppBase {
   std::shared_ptr<KeyManager> key_manager_;
   std::shared_ptr<final_chain::FinalChain> final_chain_;
   std::shared_ptr<metrics::MetricsService> metrics_;
+  std::shared_ptr<util::StageTimings> stage_timings_;
 
   std::map<std::string, std::shared_ptr<Plugin>> active_plugins_;
   std::map<std::string, std::shared_ptr<Plugin>> available_plugins_;
 
   void close();
 
+  /**
+   * @brief Starts plugins of read only replica and follows its primary node instead of starting network and consensus
+   */
+  void startReplica();
+
   /**
    * @brief Method that is used to register metrics updaters.
    * So we don't need to pass metrics classes instances in other classes.
@@ -5,9 +5,16 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <boost/filesystem.hpp>
+#include <deque>
+#include <limits>
 #include <memory>
+#include <mutex>
 
+#include "common/allocator.hpp"
 #include "common/config_exception.hpp"
+#include "common/lock_profiler.hpp"
+#include "common/scheduler.hpp"
+#include "common/task_graph.hpp"
 #include "config/config_utils.hpp"
 #include "dag/dag.hpp"
 #include "dag/dag_block.hpp"
@@ -15,9 +22,16 @@
 #include "dag/dag_manager.hpp"
 #include "final_chain/final_chain.hpp"
 #include "key_manager/key_manager.hpp"
+#include "metrics/db_metrics.hpp"
+#include "metrics/lock_metrics.hpp"
+#include "metrics/memory_metrics.hpp"
 #include "metrics/metrics_service.hpp"
 #include "metrics/network_metrics.hpp"
+#include "metrics/network_threadpool_metrics.hpp"
 #include "metrics/pbft_metrics.hpp"
+#include "metrics/rocksdb_metrics.hpp"
+#include "metrics/scheduler_metrics.hpp"
+#include "metrics/startup_metrics.hpp"
 #include "metrics/transaction_queue_metrics.hpp"
 #include "pbft/pbft_manager.hpp"
 #include "pillar_chain/pillar_chain_manager.hpp"
@@ -30,6 +44,9 @@
 
 namespace taraxa {
 
+// Width of init dependency graph, more threads would stay idle
+constexpr size_t kInitThreads = 4;
+
 App::App() {}
 
 App::~App() { close(); }
@@ -55,6 +72,9 @@ bool App::isPluginEnabled(const std::string &name) const { return active_plugins
 
 void App::init(const cli::Config &cli_conf) {
   conf_ = cli_conf.getNodeConfiguration();
+  // Before any of the placed threads is started
+  util::setThreadsPlacement(conf_.threads_placement);
+  util::LockProfiler::setEnabled(conf_.lock_profiling);
 
   fs::create_directories(conf_.db_path);
   fs::create_directories(conf_.log_path);
@@ -85,40 +105,65 @@ void App::init(const cli::Config &cli_conf) {
     assert(false);
   }
   {
+    const DbStorage::ColumnsTuning columns_tuning{
+        .point_lookup_cache_size = size_t(conf_.db_config.db_point_lookup_cache_size) * 1024 * 1024,
+        .bloom_bits_per_key = conf_.db_config.db_bloom_bits_per_key,
+        .cold_bottommost_zstd = conf_.db_config.db_cold_columns_zstd,
+        .memory_budget = size_t(conf_.db_config.db_memory_budget) * 1024 * 1024,
+        .cold_path = conf_.db_config.db_cold_path,
+        .cold_hot_size = uint64_t(conf_.db_config.db_cold_path_hot_size) * 1024 * 1024,
+        .sync_consensus_writes = conf_.db_config.db_sync_consensus_writes,
+        .consensus_group_commit_window = std::chrono::microseconds(conf_.db_config.db_group_commit_window),
+        .in_memory = conf_.db_config.db_in_memory,
+        .secondary_path = conf_.db_config.db_replica_path,
+    };
     if (conf_.db_config.rebuild_db) {
       old_db_ = std::make_shared<DbStorage>(conf_.db_path, conf_.db_config.db_snapshot_each_n_pbft_block,
                                             conf_.db_config.db_max_open_files, conf_.db_config.db_max_snapshots,
-                                            conf_.db_config.db_revert_to_period, node_addr, true);
+                                            conf_.db_config.db_revert_to_period, node_addr, true, columns_tuning);
     }
     db_ = std::make_shared<DbStorage>(conf_.db_path,
                                       // Snapshots should be disabled while rebuilding
                                       conf_.db_config.rebuild_db ? 0 : conf_.db_config.db_snapshot_each_n_pbft_block,
                                       conf_.db_config.db_max_open_files, conf_.db_config.db_max_snapshots,
-                                      conf_.db_config.db_revert_to_period, node_addr, false);
+                                      conf_.db_config.db_revert_to_period, node_addr, false, columns_tuning);
 
-    if (db_->hasMajorVersionChanged()) {
+    if (conf_.db_config.isReplica()) {
+      // Replica only reads db of its primary, version and migrations are up to primary
+      if (db_->hasMajorVersionChanged() || db_->hasMinorVersionChanged()) {
+        throw std::runtime_error("Replica DB version differs from version of its primary node");
+      }
+    } else if (db_->hasMajorVersionChanged()) {
       LOG(log_si_) << "Major DB version has changed. Rebuilding Db";
       conf_.db_config.rebuild_db = true;
       db_ = nullptr;
       old_db_ = std::make_shared<DbStorage>(conf_.db_path, conf_.db_config.db_snapshot_each_n_pbft_block,
                                             conf_.db_config.db_max_open_files, conf_.db_config.db_max_snapshots,
-                                            conf_.db_config.db_revert_to_period, node_addr, true);
+                                            conf_.db_config.db_revert_to_period, node_addr, true, columns_tuning);
       db_ = std::make_shared<DbStorage>(conf_.db_path,
                                         0,  // Snapshots should be disabled while rebuilding
                                         conf_.db_config.db_max_open_files, conf_.db_config.db_max_snapshots,
-                                        conf_.db_config.db_revert_to_period, node_addr);
+                                        conf_.db_config.db_revert_to_period, node_addr, false, columns_tuning);
     }
 
+  }
+  if (!conf_.db_config.isReplica()) {
     db_->updateDbVersions();
+    if (!conf_.db_config.db_snapshots_backup_path.empty()) {
+      db_->setSnapshotsBackupPath(conf_.db_config.db_snapshots_backup_path);
+    }
 
-    auto migration_manager = storage::migration::Manager(db_);
-    migration_manager.registerMigration(std::make_shared<storage::migration::BlockStats>(db_, conf_));
+    migration_manager_ = std::make_shared<storage::migration::Manager>(db_);
+    migration_manager_->registerMigration(std::make_shared<storage::migration::BlockStats>(db_, conf_));
 
-    migration_manager.applyAll();
+    migration_manager_->applyAll();
 
     if (conf_.db_config.migrate_receipts_by_period) {
-      migration_manager.applyReceiptsByPeriod();
+      // Receipts are readable in both layouts, so node does not need to wait for the migration unless it only migrates
+      migration_manager_->applyReceiptsByPeriod(!conf_.db_config.migrate_only && !conf_.db_config.rebuild_db);
     }
+    // Background migrations run one after another, so receipts moved by the migration above are compacted as well
+    migration_manager_->applyCompactReceipts(!conf_.db_config.migrate_only && !conf_.db_config.rebuild_db);
     if (db_->getDagBlocksCount() == 0) {
       db_->setGenesisHash(conf_.genesis.genesisHash());
     }
@@ -127,19 +172,12 @@ void App::init(const cli::Config &cli_conf) {
 
   if (conf_.network.prometheus) {
     auto &config = *conf_.network.prometheus;
-    LOG(log_nf_) << "Prometheus: server started at " << config.address << ":" << config.listen_port
-                 << ". Polling interval is " << config.polling_interval_ms << "ms";
-    metrics_ =
-        std::make_shared<metrics::MetricsService>(config.address, config.listen_port, config.polling_interval_ms);
+    LOG(log_nf_) << "Prometheus: server started at " << config.address << ":" << config.listen_port;
+    metrics_ = std::make_shared<metrics::MetricsService>(config.address, config.listen_port);
   } else {
     LOG(log_nf_) << "Prometheus: config values aren't specified. Metrics collecting is disabled";
   }
 
-  final_chain_ = std::make_shared<final_chain::FinalChain>(db_, conf_, node_addr);
-  key_manager_ = std::make_shared<KeyManager>(final_chain_);
-  trx_mgr_ = std::make_shared<TransactionManager>(conf_, db_, final_chain_, node_addr);
-  gas_pricer_ = std::make_shared<GasPricer>(conf_.genesis, conf_.is_light_node, conf_.blocks_gas_pricer, trx_mgr_, db_);
-
   auto genesis_hash = conf_.genesis.genesisHash();
   auto genesis_hash_from_db = db_->getGenesisHash();
   if (!genesis_hash_from_db.has_value()) {
@@ -152,19 +190,78 @@ void App::init(const cli::Config &cli_conf) {
     std::terminate();
   }
 
-  pbft_chain_ = std::make_shared<PbftChain>(node_addr, db_);
-  dag_mgr_ = std::make_shared<DagManager>(conf_, node_addr, trx_mgr_, pbft_chain_, final_chain_, db_, key_manager_);
-  auto slashing_manager = std::make_shared<SlashingManager>(conf_, final_chain_, trx_mgr_, gas_pricer_);
-  vote_mgr_ = std::make_shared<VoteManager>(conf_, db_, pbft_chain_, final_chain_, key_manager_, slashing_manager);
-  pillar_chain_mgr_ = std::make_shared<pillar_chain::PillarChainManager>(conf_.genesis.state.hardforks.ficus_hf, db_,
-                                                                         final_chain_, key_manager_, node_addr);
-  pbft_mgr_ = std::make_shared<PbftManager>(conf_, db_, pbft_chain_, vote_mgr_, dag_mgr_, trx_mgr_, final_chain_,
-                                            pillar_chain_mgr_);
-  dag_block_proposer_ = std::make_shared<DagBlockProposer>(conf_, dag_mgr_, trx_mgr_, final_chain_, db_, key_manager_);
+  // Subsystems only read the already opened db while constructing, so the independent ones are built concurrently
+  std::shared_ptr<SlashingManager> slashing_manager;
+  util::TaskGraph init_graph;
+  init_graph.add("final_chain", {}, [&] {
+    final_chain_ = std::make_shared<final_chain::FinalChain>(db_, conf_, node_addr);
+    key_manager_ = std::make_shared<KeyManager>(final_chain_);
+  });
+  init_graph.add("pbft_chain", {}, [&] { pbft_chain_ = std::make_shared<PbftChain>(node_addr, db_); });
+  init_graph.add("transaction_manager", {"final_chain"}, [&] {
+    trx_mgr_ = std::make_shared<TransactionManager>(conf_, db_, final_chain_, node_addr);
+    gas_pricer_ =
+        std::make_shared<GasPricer>(conf_.genesis, conf_.is_light_node, conf_.blocks_gas_pricer, trx_mgr_, db_);
+  });
+  init_graph.add("pillar_chain", {"final_chain"}, [&] {
+    pillar_chain_mgr_ = std::make_shared<pillar_chain::PillarChainManager>(conf_.genesis.state.hardforks.ficus_hf, db_,
+                                                                           final_chain_, key_manager_, node_addr);
+  });
+  // Replica does not take part in consensus, DAG and votes are not available without networking
+  if (!conf_.db_config.isReplica()) {
+    init_graph.add("dag_manager", {"transaction_manager", "pbft_chain"}, [&] {
+      dag_mgr_ =
+          std::make_shared<DagManager>(conf_, node_addr, trx_mgr_, pbft_chain_, final_chain_, db_, key_manager_);
+    });
+    init_graph.add("vote_manager", {"transaction_manager", "pbft_chain"}, [&] {
+      slashing_manager = std::make_shared<SlashingManager>(conf_, final_chain_, trx_mgr_, gas_pricer_);
+      vote_mgr_ =
+          std::make_shared<VoteManager>(conf_, db_, pbft_chain_, final_chain_, key_manager_, slashing_manager);
+    });
+    init_graph.add("pbft_manager", {"dag_manager", "vote_manager", "pillar_chain"}, [&] {
+      pbft_mgr_ = std::make_shared<PbftManager>(conf_, db_, pbft_chain_, vote_mgr_, dag_mgr_, trx_mgr_, final_chain_,
+                                                pillar_chain_mgr_);
+    });
+    init_graph.add("dag_block_proposer", {"dag_manager"}, [&] {
+      dag_block_proposer_ =
+          std::make_shared<DagBlockProposer>(conf_, dag_mgr_, trx_mgr_, final_chain_, db_, key_manager_);
+    });
+  }
+
+  const auto init_durations = init_graph.run(kInitThreads);
+  std::shared_ptr<metrics::StartupMetrics> startup_metrics;
+  if (metrics_) {
+    startup_metrics = metrics_->getMetrics<metrics::StartupMetrics>();
+  }
+  for (const auto &[task, duration] : init_durations) {
+    const auto duration_ms = std::chrono::duration<double, std::milli>(duration).count();
+    LOG(log_nf_) << "Initialized " << task << " in " << duration_ms << " ms";
+    if (startup_metrics) {
+      startup_metrics->setInitTaskDuration(duration_ms, {{"task", task}});
+    }
+  }
+
+  if (!pillar_chain_mgr_->verifyStateCheckpoint()) {
+    throw std::runtime_error("Db state does not match the last finalized pillar block. Db snapshot is corrupted");
+  }
+
+  if (metrics_ && !conf_.db_config.isReplica()) {
+    // Stage timings are observed into histograms, accumulated totals are not used by node
+    setStageTimings(std::make_shared<util::StageTimings>(
+        [pbft_metrics = metrics_->getMetrics<metrics::PbftMetrics>()](std::string_view stage, auto duration) {
+          pbft_metrics->setStageDuration(std::chrono::duration<double, std::milli>(duration).count(),
+                                         {{"stage", std::string(stage)}});
+        }));
+  }
 
-  network_ = std::make_shared<Network>(conf_, genesis_hash, conf_.net_file_path().string(), db_, pbft_mgr_, pbft_chain_,
-                                       vote_mgr_, dag_mgr_, trx_mgr_, std::move(slashing_manager), pillar_chain_mgr_,
-                                       final_chain_);
+  if (!conf_.db_config.isReplica()) {
+    network_ = std::make_shared<Network>(conf_, genesis_hash, conf_.net_file_path().string(), db_, pbft_mgr_,
+                                         pbft_chain_, vote_mgr_, dag_mgr_, trx_mgr_, std::move(slashing_manager),
+                                         pillar_chain_mgr_, final_chain_);
+    if (metrics_) {
+      network_->getPacketsThreadPool()->setMetrics(metrics_->getMetrics<metrics::NetworkThreadpoolMetrics>());
+    }
+  }
   auto cli_options = cli_conf.getCliOptions();
   for (auto &plugin : active_plugins_) {
     plugin.second->init(cli_options);
@@ -183,7 +280,7 @@ void App::start() {
     final_chain_->block_finalized_.subscribe(
         [gas_pricer = as_weak(gas_pricer_)](const auto &res) {
           if (auto gp = gas_pricer.lock()) {
-            gp->update(res->trxs);
+            gp->update(res->trxs, res->final_chain_blk->number);
           }
         },
         subscription_pool_);
@@ -197,11 +294,29 @@ void App::start() {
         subscription_pool_);
   }
 
+  if (conf_.db_config.isReplica()) {
+    startReplica();
+    return;
+  }
+
   vote_mgr_->setNetwork(network_);
   pbft_mgr_->setNetwork(network_);
   dag_mgr_->setNetwork(network_);
   pillar_chain_mgr_->setNetwork(network_);
 
+  // Pbft state machine reacts to reached vote thresholds and finalized blocks without waiting for its next poll
+  // Waking up only notifies a condition variable, it is done inline without a thread pool hop
+  vote_mgr_->two_t_plus_one_voted_block_.subscribeInline([pbft_manager = as_weak(pbft_mgr_)](const auto &) {
+    if (auto pbft_mgr = pbft_manager.lock()) {
+      pbft_mgr->wakeUp();
+    }
+  });
+  final_chain_->block_finalized_.subscribeInline([pbft_manager = as_weak(pbft_mgr_)](const auto &) {
+    if (auto pbft_mgr = pbft_manager.lock()) {
+      pbft_mgr->wakeUp();
+    }
+  });
+
   if (conf_.db_config.rebuild_db) {
     rebuildDb();
     LOG(log_si_) << "Rebuild db completed successfully. Restart node without db_rebuild option";
@@ -220,7 +335,10 @@ void App::start() {
 
   network_->start();
   dag_block_proposer_->setNetwork(network_);
-  dag_block_proposer_->start();
+  // Follower does not take part in consensus, so it never proposes dag blocks
+  if (!conf_.network.follower) {
+    dag_block_proposer_->start();
+  }
 
   pbft_mgr_->start();
 
@@ -232,43 +350,164 @@ void App::start() {
   LOG(log_nf_) << "Node started ... ";
 }
 
+void App::startReplica() {
+  for (auto &plugin : active_plugins_) {
+    LOG(log_nf_) << "Starting plugin " << plugin.first;
+    plugin.second->start();
+  }
+
+  // Plugins are subscribed to finalized blocks already, so they observe every block finalized by primary from now on
+  const auto interval = std::max<uint64_t>(conf_.db_config.db_replica_catch_up_interval, 1);
+  replica_catch_up_executor_ = std::make_unique<util::ThreadPool>(1);
+  replica_catch_up_executor_->post_loop({interval}, [this] {
+    try {
+      final_chain_->catchUpWithPrimary();
+    } catch (const std::exception &e) {
+      LOG(log_er_) << "Replica failed to catch up with primary db: " << e.what();
+    }
+  });
+
+  if (metrics_) {
+    setupMetricsUpdaters();
+    metrics_->start();
+  }
+  started_ = true;
+  LOG(log_nf_) << "Replica started on db of primary node, last block " << final_chain_->lastBlockNumber();
+}
+
 void App::scheduleLoggingConfigUpdate() {
   // no file to check updates for (e.g. tests)
   if (conf_.json_file_name.empty()) {
     return;
   }
 
-  config_update_executor_.post([&]() {
-    while (started_ && !stopped_) {
-      auto path = std::filesystem::path(conf_.json_file_name);
-      if (path.empty()) {
-        std::cout << "FullNodeConfig: scheduleLoggingConfigUpdate: json_file_name is empty" << std::endl;
-        return;
-      }
-      auto update_time = std::filesystem::last_write_time(path);
+  // Running values come from the file at this point, rpc is not started yet
+  file_runtime_config_ = getRuntimeConfig();
+  // Checked periodically instead of in a loop on the executor thread, so it is not busy between file updates
+  config_update_executor_.post_loop({kConfigFileCheckIntervalMs}, [this]() {
+    if (!started_ || stopped_) {
+      return;
+    }
+    // Any failure is only reported, watcher keeps checking the file
+    try {
+      auto update_time = std::filesystem::last_write_time(std::filesystem::path(conf_.json_file_name));
       if (conf_.last_json_update_time >= update_time) {
-        continue;
+        return;
       }
       conf_.last_json_update_time = update_time;
+      Json::Value config;
       try {
-        auto config = getJsonFromFileOrString(conf_.json_file_name);
+        config = getJsonFromFileOrString(conf_.json_file_name);
         conf_.log_configs = conf_.loadLoggingConfigs(config["logging"]);
         conf_.InitLogging(conf_.getFirstWallet().node_addr);
       } catch (const ConfigException &e) {
         std::cerr << "FullNodeConfig: Failed to update logging config: " << e.what() << std::endl;
-        continue;
+        return;
       }
       std::cout << "FullNodeConfig: Updated logging config" << std::endl;
-      std::this_thread::sleep_for(std::chrono::minutes(1));
+
+      // Only settings whose value changed in the file since it was last applied are updated, so the ones changed by
+      // rpc are kept until they are changed in the file too
+      std::map<std::string, uint64_t> runtime_config;
+      for (const auto &[name, file_value] : file_runtime_config_) {
+        std::vector<std::string> path;
+        boost::algorithm::split(path, name, boost::is_any_of("."));
+        const Json::Value *json = &config;
+        for (const auto &key : path) {
+          json = &(*json)[key];
+        }
+        if (json->isUInt64() && json->asUInt64() != file_value) {
+          runtime_config[name] = json->asUInt64();
+        }
+      }
+      if (runtime_config.empty()) {
+        return;
+      }
+      try {
+        updateRuntimeConfig(runtime_config);
+      } catch (const ConfigException &e) {
+        std::cerr << "FullNodeConfig: Failed to update runtime config: " << e.what() << std::endl;
+        return;
+      }
+      for (const auto &[name, value] : runtime_config) {
+        file_runtime_config_[name] = value;
+      }
+    } catch (const std::exception &e) {
+      std::cerr << "FullNodeConfig: Failed to apply config file update: " << e.what() << std::endl;
+    } catch (...) {
+      std::cerr << "FullNodeConfig: Failed to apply config file update" << std::endl;
     }
   });
 }
 
 void App::setupMetricsUpdaters() {
-  auto network_metrics = metrics_->getMetrics<metrics::NetworkMetrics>();
-  network_metrics->setPeersCountUpdater([network = network_]() { return network->getPeerCount(); });
-  network_metrics->setDiscoveredPeersCountUpdater([network = network_]() { return network->getNodeCount(); });
-  network_metrics->setSyncingDurationUpdater([network = network_]() { return network->syncTimeSeconds(); });
+  // Network and consensus components are not created by replica
+  if (network_) {
+    auto network_metrics = metrics_->getMetrics<metrics::NetworkMetrics>();
+    network_metrics->setPeersCountUpdater([network = network_]() { return network->getPeerCount(); });
+    network_metrics->setDiscoveredPeersCountUpdater([network = network_]() { return network->getNodeCount(); });
+    network_metrics->setSyncingDurationUpdater([network = network_]() { return network->syncTimeSeconds(); });
+    network_metrics->setSyncUploadBytesUpdater(
+        [network = network_]() { return network->getUploadBandwidthManager()->sentBytes(); });
+    network_metrics->setSyncUploadThrottledPacketsUpdater(
+        [network = network_]() { return network->getUploadBandwidthManager()->throttledPacketsCount(); });
+    network_metrics->setSyncUploadThrottleDurationUpdater(
+        [network = network_]() { return network->getUploadBandwidthManager()->throttleDuration().count(); });
+    network_metrics->setPacketsCompressionUpdater([network = network_]() {
+      std::vector<metrics::NetworkMetrics::PacketCompression> ret;
+      for (const auto &stats : network->getPacketsCompressionStats()) {
+        ret.push_back({taraxa::network::convertPacketTypeToString(stats.packet_type),
+                       static_cast<double>(stats.compressed_size) / stats.size,
+                       static_cast<double>(stats.duration.count())});
+      }
+      return ret;
+    });
+  }
+
+  metrics_->getMetrics<metrics::SchedulerMetrics>()->setClassesStatsUpdater([]() {
+    std::vector<metrics::SchedulerMetrics::ClassStats> ret;
+    for (size_t i = 0; i < util::kTaskClassesCount; ++i) {
+      const auto task_class = static_cast<util::TaskClass>(i);
+      const auto stats = util::Scheduler::global().stats(task_class);
+      ret.push_back({util::toString(task_class), static_cast<double>(stats.queued),
+                     static_cast<double>(stats.running), stats.queue_latency_p50_us.value_or(0),
+                     stats.queue_latency_p99_us.value_or(0)});
+    }
+    return ret;
+  });
+
+  if (conf_.lock_profiling) {
+    metrics_->getMetrics<metrics::LockMetrics>()->setLocksStatsUpdater([]() {
+      std::vector<metrics::LockMetrics::LockStats> ret;
+      for (const auto &stats : util::LockProfiler::stats(0)) {
+        ret.push_back({stats.name, static_cast<double>(stats.wait.count), static_cast<double>(stats.contended),
+                       std::chrono::duration<double, std::milli>(stats.wait.total).count(),
+                       stats.wait.percentileUs(0.5), stats.wait.percentileUs(0.99), stats.hold.percentileUs(0.5),
+                       stats.hold.percentileUs(0.99)});
+      }
+      return ret;
+    });
+  }
+
+  if (network_) {
+    auto threadpool_metrics = metrics_->getMetrics<metrics::NetworkThreadpoolMetrics>();
+    threadpool_metrics->setQueuesStatsUpdater([packets_tp = network_->getPacketsThreadPool()]() {
+      const auto [hp_queue_size, mp_queue_size, lp_queue_size] = packets_tp->getQueueSize();
+      const auto [hp_blocked, mp_blocked, lp_blocked] = packets_tp->getBlockedPacketsCount();
+      const auto [hp_limit, mp_limit, lp_limit] = packets_tp->getWorkersLimits();
+      return std::vector<metrics::NetworkThreadpoolMetrics::QueueStats>{
+          {"high", static_cast<double>(hp_queue_size), static_cast<double>(hp_blocked), static_cast<double>(hp_limit)},
+          {"mid", static_cast<double>(mp_queue_size), static_cast<double>(mp_blocked), static_cast<double>(mp_limit)},
+          {"low", static_cast<double>(lp_queue_size), static_cast<double>(lp_blocked), static_cast<double>(lp_limit)},
+      };
+    });
+    threadpool_metrics->setActiveWorkersUpdater(
+        [packets_tp = network_->getPacketsThreadPool()]() { return packets_tp->getActiveWorkersCount(); });
+    threadpool_metrics->setBorrowedThreadsUpdater(
+        [packets_tp = network_->getPacketsThreadPool()]() { return packets_tp->getBorrowedThreadsCount(); });
+    threadpool_metrics->setDroppedStalePacketsUpdater(
+        [packets_tp = network_->getPacketsThreadPool()]() { return packets_tp->getDroppedStalePacketsCount(); });
+  }
 
   auto transaction_queue_metrics = metrics_->getMetrics<metrics::TransactionQueueMetrics>();
   transaction_queue_metrics->setTransactionsCountUpdater(
@@ -276,19 +515,145 @@ void App::setupMetricsUpdaters() {
   transaction_queue_metrics->setGasPriceUpdater(
       [gas_pricer = gas_pricer_]() { return gas_pricer->bid().convert_to<double>(); });
 
+  auto db_metrics = metrics_->getMetrics<metrics::DbMetrics>();
+  db_metrics->setBlockCacheUsageUpdater([db = db_]() { return db->blockCacheUsage(); });
+  db_metrics->setMemTablesUsageUpdater([db = db_]() { return db->memTablesUsage(); });
+  db_metrics->setMemoryBudgetUpdater([db = db_]() { return db->memoryBudget(); });
+  db_metrics->setTrxLocationCacheHitsUpdater(
+      [final_chain = final_chain_]() { return final_chain->transactionLocationCacheHits(); });
+  db_metrics->setTrxLocationCacheMissesUpdater(
+      [final_chain = final_chain_]() { return final_chain->transactionLocationCacheMisses(); });
+
+  auto rocksdb_metrics = metrics_->getMetrics<metrics::RocksDbMetrics>();
+  rocksdb_metrics->setDbStatsUpdater("db", [db = db_]() {
+    metrics::RocksDbMetrics::DbStats stats;
+    for (const auto &column : db->columnsProperties()) {
+      stats.columns.push_back({column.name, static_cast<double>(column.estimate_num_keys),
+                               static_cast<double>(column.mem_tables_size),
+                               static_cast<double>(column.pending_compaction_bytes),
+                               static_cast<double>(column.sst_files_size)});
+    }
+    for (const auto &[ticker, value] : db->statisticsTickers()) {
+      stats.tickers.emplace_back(ticker, static_cast<double>(value));
+    }
+    stats.write_amplification = db->writeAmplification();
+    return stats;
+  });
+  rocksdb_metrics->setDiskSizeUpdater("db", [db = db_]() { return DbStorage::directorySize(db->dbStoragePath()); });
+  // State db is opened by taraxa-evm, its rocksdb instance is not reachable from here
+  rocksdb_metrics->setDiskSizeUpdater("state_db",
+                                      [db = db_]() { return DbStorage::directorySize(db->stateDbStoragePath()); });
+
+  auto memory_metrics = metrics_->getMetrics<metrics::MemoryMetrics>();
+  memory_metrics->setMemoryStatsUpdater([this]() { return getMemoryStats(); });
+  memory_metrics->setAllocatorStatsUpdater([]() -> std::optional<metrics::MemoryMetrics::AllocatorStats> {
+    const auto stats = util::allocator::stats();
+    if (!stats) {
+      return {};
+    }
+    return metrics::MemoryMetrics::AllocatorStats{static_cast<double>(stats->allocated),
+                                                  static_cast<double>(stats->active),
+                                                  static_cast<double>(stats->resident), stats->fragmentation};
+  });
+
   auto pbft_metrics = metrics_->getMetrics<metrics::PbftMetrics>();
-  pbft_metrics->setPeriodUpdater([pbft_mgr = pbft_mgr_]() { return pbft_mgr->getPbftPeriod(); });
-  pbft_metrics->setRoundUpdater([pbft_mgr = pbft_mgr_]() { return pbft_mgr->getPbftRound(); });
-  pbft_metrics->setStepUpdater([pbft_mgr = pbft_mgr_]() { return pbft_mgr->getPbftStep(); });
-  pbft_metrics->setVotesCountUpdater(
-      [pbft_mgr = pbft_mgr_]() { return pbft_mgr->getCurrentNodeVotesCount().value_or(0); });
-  final_chain_->block_finalized_.subscribe(
+  if (pbft_mgr_) {
+    pbft_metrics->setPeriodUpdater([pbft_mgr = pbft_mgr_]() { return pbft_mgr->getPbftPeriod(); });
+    pbft_metrics->setRoundUpdater([pbft_mgr = pbft_mgr_]() { return pbft_mgr->getPbftRound(); });
+    pbft_metrics->setStepUpdater([pbft_mgr = pbft_mgr_]() { return pbft_mgr->getPbftStep(); });
+    pbft_metrics->setVotesCountUpdater(
+        [pbft_mgr = pbft_mgr_]() { return pbft_mgr->getCurrentNodeVotesCount().value_or(0); });
+  }
+  final_chain_->block_finalized_.subscribeInline(
       [pbft_metrics](const std::shared_ptr<final_chain::FinalizationResult> &res) {
         pbft_metrics->setBlockNumber(res->final_chain_blk->number);
         pbft_metrics->setBlockTransactionsCount(res->trxs.size());
         pbft_metrics->setBlockTimestamp(res->final_chain_blk->timestamp);
-      },
-      subscription_pool_);
+      });
+}
+
+std::map<std::string, uint64_t> App::getRuntimeConfig() const {
+  std::map<std::string, uint64_t> config;
+  // Network is not created by replica
+  if (network_) {
+    config["network.transaction_interval_ms"] = network_->getTransactionInterval();
+    config["network.sync_level_size"] = network_->getSyncLevelSize();
+    // Scaling adjusts number of workers by itself
+    if (!conf_.network.packets_processing_scaling) {
+      config["network.packets_processing_threads"] = network_->getPacketsThreadPool()->getActiveWorkersCount();
+    }
+  }
+  // Caches disabled by config are not used at all, so they can't be enabled at runtime
+  const auto caches = final_chain_->cachesSizes();
+  if (conf_.final_chain_storage_cache_size) {
+    config["final_chain_storage_cache_size"] = caches.storage;
+  }
+  if (conf_.final_chain_code_cache_size) {
+    config["final_chain_code_cache_size"] = caches.code;
+  }
+  if (conf_.final_chain_trx_location_cache_size) {
+    config["final_chain_trx_location_cache_size"] = caches.trx_location;
+  }
+  return config;
+}
+
+void App::updateRuntimeConfig(const std::map<std::string, uint64_t> &values) {
+  std::scoped_lock lock(runtime_config_mutex_);
+  const auto current = getRuntimeConfig();
+  for (const auto &[name, value] : values) {
+    if (!current.contains(name)) {
+      throw ConfigException(name + " can't be changed at runtime");
+    }
+    uint64_t min = 1;
+    uint64_t max = std::numeric_limits<uint32_t>::max();
+    if (name == "network.transaction_interval_ms" || name == "network.sync_level_size") {
+      max = std::numeric_limits<uint16_t>::max();
+    } else if (name == "network.packets_processing_threads") {
+      // Pool can't grow over the number of threads it was started with
+      min = 3;
+      max = conf_.network.packets_processing_threads;
+    }
+    if (value < min || value > max) {
+      throw ConfigException(name + " must be in range [" + std::to_string(min) + ", " + std::to_string(max) + "]");
+    }
+  }
+
+  auto caches = final_chain_->cachesSizes();
+  for (const auto &[name, value] : values) {
+    LOG(log_nf_) << "Runtime config " << name << ": " << current.at(name) << " -> " << value;
+    if (name == "network.transaction_interval_ms") {
+      network_->setTransactionInterval(value);
+    } else if (name == "network.sync_level_size") {
+      network_->setSyncLevelSize(value);
+    } else if (name == "network.packets_processing_threads") {
+      network_->getPacketsThreadPool()->setActiveWorkersCount(value);
+    } else if (name == "final_chain_storage_cache_size") {
+      caches.storage = value;
+    } else if (name == "final_chain_code_cache_size") {
+      caches.code = value;
+    } else if (name == "final_chain_trx_location_cache_size") {
+      caches.trx_location = value;
+    }
+  }
+  final_chain_->setCachesSizes(caches);
+}
+
+std::map<std::string, uint64_t> App::getMemoryStats() const {
+  std::map<std::string, uint64_t> stats{
+      {"transaction_pool", trx_mgr_->getTransactionPoolMemoryUsage()},
+      {"final_chain_caches", final_chain_->cachesMemoryUsage()},
+      {"rocksdb_block_cache", db_->blockCacheUsage()},
+      {"rocksdb_memtables", db_->memTablesUsage()},
+      {"rocksdb_table_readers", db_->tableReadersUsage()},
+  };
+  // Consensus components and network are not created by replica
+  if (!conf_.db_config.isReplica()) {
+    stats["verified_votes"] = vote_mgr_->getVerifiedVotesMemoryUsage();
+    stats["dag"] = dag_mgr_->memoryUsage();
+    stats["period_data_queue"] = pbft_mgr_->periodDataQueueMemoryUsage();
+    stats["peers_caches"] = network_->peersCachesMemoryUsage();
+  }
+  return stats;
 }
 
 void App::close() {
@@ -296,17 +661,33 @@ void App::close() {
     return;
   }
 
+  if (conf_.db_config.isReplica()) {
+    if (replica_catch_up_executor_) {
+      replica_catch_up_executor_->stop();
+    }
+    LOG(log_nf_) << "Replica stopped ... ";
+    return;
+  }
+
+  migration_manager_->stop();
   dag_block_proposer_->stop();
   pbft_mgr_->stop();
+  // Lets next start skip verification of state that was already verified
+  dag_mgr_->saveStartupSnapshot();
+  trx_mgr_->saveStartupSnapshot();
   LOG(log_nf_) << "Node stopped ... ";
 }
 
+void App::setStageTimings(std::shared_ptr<util::StageTimings> timings) {
+  stage_timings_ = timings;
+  pbft_mgr_->setStageTimings(timings);
+  vote_mgr_->setStageTimings(timings);
+  final_chain_->setStageTimings(std::move(timings));
+}
+
 void App::rebuildDb() {
   pbft_mgr_->initialState();
 
-  // Read pbft blocks one by one
-  PbftPeriod period = 1;
-  std::shared_ptr<PeriodData> period_data, next_period_data;
   std::atomic_bool stop_async = false;
 
   std::future<void> fut = std::async(std::launch::async, [this, &stop_async]() {
@@ -317,28 +698,63 @@ void App::rebuildDb() {
     }
   });
 
-  while (true) {
-    std::vector<std::shared_ptr<PbftVote>> cert_votes;
-    if (next_period_data != nullptr) {
-      period_data = next_period_data;
-    } else {
-      auto data = old_db_->getPeriodDataRaw(period);
-      if (data.size() == 0) break;
-      period_data = std::make_shared<PeriodData>(std::move(data));
+  // Periods are read from old db, decoded and their senders recovered by several tasks ahead of execution. Read ahead
+  // is bounded by number of periods and by sync queue memory budget, which is shared with already queued periods
+  const size_t max_read_ahead_periods = std::max<size_t>(4 * util::Scheduler::global().threadsCount(), 2);
+  const uint64_t max_read_ahead_bytes = uint64_t(conf_.network.sync_queue_max_mb) * 1024 * 1024;
+  const util::Executor read_executor(util::TaskClass::Execution);
+  using ReadPeriod = std::pair<std::shared_ptr<PeriodData>, size_t>;
+  auto read_ahead_bytes = std::make_shared<std::atomic<uint64_t>>(0);
+  std::deque<std::future<ReadPeriod>> read_ahead;
+  PbftPeriod next_read_period = 1;
+
+  auto pop_period = [&]() -> std::shared_ptr<PeriodData> {
+    // At least current and next period are read, cert votes of the current one are in the next one
+    while (read_ahead.size() < 2 ||
+           (read_ahead.size() < max_read_ahead_periods &&
+            (!max_read_ahead_bytes ||
+             *read_ahead_bytes + pbft_mgr_->periodDataQueueMemoryUsage() < max_read_ahead_bytes))) {
+      if (conf_.db_config.rebuild_db_period && next_read_period > conf_.db_config.rebuild_db_period + 1) {
+        break;
+      }
+      auto task = std::make_shared<std::packaged_task<ReadPeriod()>>(
+          [db = old_db_, period = next_read_period++, read_ahead_bytes]() -> ReadPeriod {
+            auto data = db->getPeriodDataRaw(period);
+            if (data.size() == 0) {
+              return {};
+            }
+            const auto size = data.size();
+            *read_ahead_bytes += size;
+            auto period_data = std::make_shared<PeriodData>(std::move(data));
+            for (auto &t : period_data->transactions) t->getSender();
+            return {std::move(period_data), size};
+          });
+      read_ahead.push_back(task->get_future());
+      read_executor.post([task] { (*task)(); });
     }
-    auto data = old_db_->getPeriodDataRaw(period + 1);
-    if (data.size() == 0) {
-      next_period_data = nullptr;
+    if (read_ahead.empty()) {
+      return nullptr;
+    }
+
+    util::StageTimings::Scope timing(stage_timings_, "decode");
+    auto [period_data, size] = read_ahead.front().get();
+    read_ahead.pop_front();
+    *read_ahead_bytes -= size;
+    return period_data;
+  };
+
+  PbftPeriod period = 1;
+  auto period_data = pop_period();
+  while (period_data) {
+    std::vector<std::shared_ptr<PbftVote>> cert_votes;
+    auto next_period_data = pop_period();
+    if (!next_period_data) {
       // Latest finalized block cert votes are saved in db as 2t+1 cert votes
       auto votes = old_db_->getAllTwoTPlusOneVotes();
       for (auto v : votes) {
         if (v->getType() == PbftVoteTypes::cert_vote) cert_votes.push_back(v);
       }
     } else {
-      next_period_data = std::make_shared<PeriodData>(std::move(data));
-      // More efficient to get sender(which is expensive) on this thread which is not as busy as the thread that
-      // pushes blocks to chain
-      for (auto &t : next_period_data->transactions) t->getSender();
       cert_votes = next_period_data->previous_block_cert_votes;
     }
 
@@ -362,6 +778,11 @@ void App::rebuildDb() {
     if (period % 10000 == 0) {
       LOG(log_si_) << "Rebuilding period: " << period;
     }
+    period_data = std::move(next_period_data);
+  }
+  // Reads scheduled past the last period are not used
+  for (auto &read : read_ahead) {
+    read.wait();
   }
   stop_async = true;
   fut.wait();
@@ -6,6 +6,7 @@
 
 #include "cli/config_updater.hpp"
 #include "cli/tools.hpp"
+#include "common/config_exception.hpp"
 #include "common/jsoncpp.hpp"
 #include "config/version.hpp"
 
@@ -213,6 +214,12 @@ void Config::parseCommandLine(int argc, const char* argv[], const std::string& a
     // Validate config values
     node_config_.validate();
 
+    // Replica opens data directory of its primary node, so nothing may modify it
+    if (node_config_.db_config.isReplica() &&
+        (cli_options_[DESTROY_DB].as<bool>() || cli_options_[REBUILD_DB].as<bool>() ||
+         cli_options_[MIGRATE_ONLY].as<bool>() || cli_options_[REVERT_TO_PERIOD].as<uint64_t>())) {
+      throw ConfigException("Replica can't be started with options that modify db");
+    }
     if (cli_options_[DESTROY_DB].as<bool>()) {
       fs::remove_all(node_config_.db_path);
     }
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace taraxa::util::allocator {
+
+/**
+ * @brief Heap stats of the allocator taraxad is linked with, selected by TARAXA_ALLOCATOR cmake option
+ *
+ * allocated is requested by the application, active is in pages holding its allocations and resident is backed by
+ * physical memory. Fragmentation is share of active bytes that are not allocated.
+ */
+struct Stats {
+  uint64_t allocated = 0;
+  uint64_t active = 0;
+  uint64_t resident = 0;
+  double fragmentation = 0;
+};
+
+/**
+ * @return name of the linked allocator: jemalloc, mimalloc or glibc
+ */
+std::string name();
+
+/**
+ * @return current stats, empty if allocator does not provide them
+ */
+std::optional<Stats> stats();
+
+/**
+ * @brief Returns unused dirty pages of all arenas to the OS
+ * @return false if allocator does not support purging
+ */
+bool purge();
+
+}  // namespace taraxa::util::allocator
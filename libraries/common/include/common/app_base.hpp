@@ -3,6 +3,7 @@
 #include <libdevcore/Address.h>
 #include <libdevcrypto/Common.h>
 
+#include <map>
 #include <memory>
 
 #include "config/config.hpp"
@@ -60,6 +61,23 @@ class AppBase {
 
   virtual std::shared_ptr<Plugin> getPlugin(const std::string &name) const = 0;
 
+  /**
+   * @brief Approximate memory used by major in-memory structures, in bytes per structure name
+   */
+  virtual std::map<std::string, uint64_t> getMemoryStats() const = 0;
+
+  /**
+   * @brief Current values of the settings that can be changed without restart, by their path in node config json
+   */
+  virtual std::map<std::string, uint64_t> getRuntimeConfig() const = 0;
+
+  /**
+   * @brief Applies new values of the settings listed by getRuntimeConfig to running components. Changes are not
+   * persisted, config file has to be updated too for them to survive restart
+   * @throws ConfigException if a setting can't be changed at runtime or its value is invalid, nothing is changed then
+   */
+  virtual void updateRuntimeConfig(const std::map<std::string, uint64_t> &values) = 0;
+
   bool isStarted() const { return started_; }
 
   virtual void start() = 0;
@@ -3,6 +3,9 @@
 #include <libdevcore/RLP.h>
 
 #include <optional>
+#include <vector>
+
+#include "common/slab_allocator.hpp"
 
 namespace taraxa::util {
 using dev::RLP;
@@ -20,6 +23,54 @@ struct RLPDecoderRef {
 template <typename... Params>
 void rlp_tuple(RLPEncoderRef encoding, Params const&... args);
 
+/**
+ * @brief Exact size of what rlp(encoding, target) writes, defined for types whose size is cheap to get. Lists of such
+ *        types are written with their prefix first, so items are not moved when the list is finished. Lists of lists
+ *        are not sized and take the regular path
+ */
+template <typename T>
+auto rlp_size(T const& target) -> std::enable_if_t<std::is_unsigned_v<T>, size_t> {
+  return dev::rlpIntSize(target);
+}
+
+template <unsigned N>
+size_t rlp_size(dev::FixedHash<N> const& target) {
+  return dev::rlpDataSize(target.ref());
+}
+
+inline size_t rlp_size(std::string const& target) { return dev::rlpDataSize(dev::bytesConstRef(target)); }
+
+inline size_t rlp_size(dev::bytes const& target) { return dev::rlpDataSize(&target); }
+
+template <typename T>
+auto rlp_size(T const& target) -> decltype(target.rlpSize(), size_t()) {
+  return target.rlpSize();
+}
+
+template <typename Param>
+auto rlp_size(std::shared_ptr<Param> const& target) -> decltype(rlp_size(*target), size_t()) {
+  return target ? rlp_size(*target) : 1;
+}
+
+template <typename Sequence>
+auto rlp_payload_size(Sequence const& target) -> decltype(rlp_size(*target.begin()), size_t()) {
+  size_t size = 0;
+  for (auto const& v : target) {
+    size += rlp_size(v);
+  }
+  return size;
+}
+
+template <typename Sequence>
+auto rlp_size(Sequence const& target) -> decltype(target.size(), rlp_payload_size(target), size_t()) {
+  return dev::rlpListSize(rlp_payload_size(target));
+}
+
+template <typename... Params>
+auto rlp_tuple_size(Params const&... args) -> decltype((rlp_size(args) + ...), size_t()) {
+  return dev::rlpListSize((rlp_size(args) + ...));
+}
+
 template <typename T>
 auto rlp(RLPEncoderRef encoding, T const& target) -> decltype(RLP().toInt<T>(), void()) {
   encoding.append(target);
@@ -65,7 +116,11 @@ void rlp(RLPEncoderRef encoding, std::pair<T1, T2> const& target) {
 template <typename Sequence>
 auto rlp(RLPEncoderRef encoding, Sequence const& target) -> decltype(target.size(), target.begin(), target.end(),
                                                                      void()) {
-  encoding.appendList(target.size());
+  if constexpr (requires { rlp_payload_size(target); }) {
+    encoding.appendList(target.size(), rlp_payload_size(target));
+  } else {
+    encoding.appendList(target.size());
+  }
   for (auto const& v : target) {
     rlp(encoding, v);
   }
@@ -83,7 +138,11 @@ template <typename... Params>
 void rlp_tuple(RLPEncoderRef encoding, Params const&... args) {
   constexpr auto num_elements = sizeof...(args);
   static_assert(0 < num_elements);
-  encoding.appendList(num_elements);
+  if constexpr (requires { (rlp_size(args) + ...); }) {
+    encoding.appendList(num_elements, (rlp_size(args) + ...));
+  } else {
+    encoding.appendList(num_elements);
+  }
   __enc_rlp_tuple_body__(encoding, args...);
 }
 
@@ -118,7 +177,7 @@ void rlp(RLPDecoderRef encoding, std::shared_ptr<Param>& target) {
   if (encoding.value.isNull() || encoding.value.isEmpty()) {
     target = nullptr;
   } else {
-    target = std::make_shared<Param>();
+    target = makeShared<Param>();
     rlp(encoding, *target);
   }
 }
@@ -182,6 +241,31 @@ void rlp_tuple(RLPDecoderRef encoding, Params&... args) {
   __dec_rlp_tuple_body__(it_begin, encoding.value.end(), encoding.strictness, args...);
 }
 
+/**
+ * @brief Offsets of all items of a rlp list, found in one pass. Unlike RLP::operator[], which scans from the last
+ *        accessed item and starts over for every new RLP object, any item is then reached in constant time. Data of
+ *        the list must outlive the index
+ */
+class RLPIndex {
+ public:
+  explicit RLPIndex(RLP const& list) {
+    for (auto const item : list) {
+      items_.push_back(item.data());
+    }
+  }
+
+  size_t size() const { return items_.size(); }
+
+  // Null item past the end, same as RLP::operator[]
+  RLP operator[](size_t i) const { return i < items_.size() ? RLP(items_[i]) : RLP(); }
+
+  // Encoded item without copying
+  dev::bytesConstRef data(size_t i) const { return i < items_.size() ? items_[i] : dev::bytesConstRef(); }
+
+ private:
+  std::vector<dev::bytesConstRef> items_;
+};
+
 template <typename T>
 T rlp_dec(RLPDecoderRef encoding) {
   T ret;
@@ -199,6 +283,9 @@ dev::bytes const& rlp_enc(RLPEncoderRef encoder_to_reuse, T const& obj) {
 template <typename T>
 dev::bytes rlp_enc(T const& obj) {
   dev::RLPStream s;
+  if constexpr (requires { rlp_size(obj); }) {
+    s.reserve(rlp_size(obj), 0);
+  }
   rlp(s, obj);
   return std::move(s.invalidate());
 }
@@ -2,8 +2,10 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
+#include <type_traits>
 
 #include "common/thread_pool.hpp"
 
@@ -17,30 +19,60 @@ struct EventSubscriber {
   using Handler = std::function<void(Payload const &)>;
 
  protected:
+  /**
+   * @brief Subscriber without execution context is inline, it is called synchronously on the emitting thread
+   */
+  struct Subscription {
+    std::shared_ptr<const Handler> handler;
+    std::shared_ptr<util::ThreadPool> execution_context;
+  };
+
   class State {
     friend struct EventSubscriber;
     friend struct EventEmitter<Payload>;
 
     uint64_t next_subscription_id_ = 0;
-    std::map<uint64_t, Handler> subs_;
+    std::map<uint64_t, Subscription> subs_;
+    size_t async_subs_count_ = 0;
     std::shared_mutex mu_;
   } mutable state_;
 
   EventSubscriber() = default;
 
- public:
-  auto subscribe(Handler &&handler, std::shared_ptr<util::ThreadPool> execution_context) const {
+  auto addSubscription(Handler &&handler, std::shared_ptr<util::ThreadPool> execution_context) const {
     std::unique_lock l(state_.mu_);
     auto subscription_id = ++state_.next_subscription_id_;
-    state_.subs_[subscription_id] = [exec = std::move(execution_context), h = std::move(handler)](auto const &payload) {
-      exec->post([&h, payload] { h(payload); });
-    };
+    if (execution_context) {
+      ++state_.async_subs_count_;
+    }
+    state_.subs_[subscription_id] = {std::make_shared<const Handler>(std::move(handler)), std::move(execution_context)};
     return subscription_id;
   }
 
+ public:
+  /**
+   * @brief Handler is posted to execution_context on every emit
+   */
+  auto subscribe(Handler &&handler, std::shared_ptr<util::ThreadPool> execution_context) const {
+    return addSubscription(std::move(handler), std::move(execution_context));
+  }
+
+  /**
+   * @brief Handler is called on the emitting thread before emit returns, so it must be cheap and never block
+   */
+  auto subscribeInline(Handler &&handler) const { return addSubscription(std::move(handler), nullptr); }
+
   auto unsubscribe(uint64_t subscription_id) const {
     std::unique_lock l(state_.mu_);
-    return state_.subs_.erase(subscription_id);
+    const auto it = state_.subs_.find(subscription_id);
+    if (it == state_.subs_.end()) {
+      return size_t(0);
+    }
+    if (it->second.execution_context) {
+      --state_.async_subs_count_;
+    }
+    state_.subs_.erase(it);
+    return size_t(1);
   }
 };
 
@@ -48,10 +80,22 @@ template <typename Payload>
 struct EventEmitter : virtual EventSubscriber<Payload> {
   using Subscriber = EventSubscriber<Payload>;
 
+  /**
+   * @brief Payload is copied at most once per emit into an immutable buffer shared by all asynchronous subscribers
+   */
   void emit(Payload const &payload) const {
     std::shared_lock l(Subscriber::state_.mu_);
+    std::shared_ptr<const std::decay_t<Payload>> shared_payload;
+    if (Subscriber::state_.async_subs_count_) {
+      shared_payload = std::make_shared<const std::decay_t<Payload>>(payload);
+    }
     for (auto const &[_, subscription] : Subscriber::state_.subs_) {
-      subscription(payload);
+      if (subscription.execution_context) {
+        subscription.execution_context->post(
+            [handler = subscription.handler, shared_payload] { (*handler)(*shared_payload); });
+      } else {
+        (*subscription.handler)(payload);
+      }
     }
   }
 };
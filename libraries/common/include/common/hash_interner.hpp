@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <unordered_set>
+#include <vector>
+
+#include "common/memory_usage.hpp"
+
+namespace taraxa::util {
+
+/**
+ * @brief Assigns dense 32-bit ids to hashes referenced by in-memory indices
+ *
+ * Secondary indices store and hash 4 byte ids instead of full hashes, the hash itself is stored once here. Ids are
+ * reference counted, every acquire must be paired with a release and id of a hash released by all its holders is
+ * reused for the next new hash, so ids stay dense and can index vectors.
+ *
+ * Not thread safe, meant to be a member of the structure that owns the indices and guards them with its own mutex.
+ */
+template <class Hash>
+class HashInterner {
+ public:
+  using Id = uint32_t;
+
+  HashInterner() : ids_(0, IdHasher{&entries_}, IdEqual{&entries_}) {}
+  HashInterner(const HashInterner &) = delete;
+  HashInterner(HashInterner &&) = delete;
+  HashInterner &operator=(const HashInterner &) = delete;
+  HashInterner &operator=(HashInterner &&) = delete;
+
+  /**
+   * @return id of the hash, new one if hash is not interned yet. Increments its reference count
+   */
+  Id acquire(const Hash &hash) {
+    if (auto it = ids_.find(hash); it != ids_.end()) {
+      ++entries_[*it].refs;
+      return *it;
+    }
+    Id id;
+    if (free_ids_.empty()) {
+      id = static_cast<Id>(entries_.size());
+      entries_.push_back({hash, 1});
+    } else {
+      id = free_ids_.back();
+      free_ids_.pop_back();
+      entries_[id] = {hash, 1};
+    }
+    ids_.insert(id);
+    return id;
+  }
+
+  /**
+   * @brief Decrements reference count of the id, once it drops to zero the id can be reused for another hash
+   */
+  void release(Id id) {
+    auto &entry = entries_[id];
+    assert(entry.refs > 0);
+    if (--entry.refs == 0) {
+      ids_.erase(id);
+      free_ids_.push_back(id);
+    }
+  }
+
+  /**
+   * @return id of the hash if it is interned, reference count is not changed
+   */
+  std::optional<Id> find(const Hash &hash) const {
+    if (auto it = ids_.find(hash); it != ids_.end()) {
+      return *it;
+    }
+    return {};
+  }
+
+  /**
+   * @return hash of a live id, reference is invalidated by the next acquire
+   */
+  const Hash &hash(Id id) const { return entries_[id].hash; }
+
+  /**
+   * @return number of live ids
+   */
+  size_t size() const { return ids_.size(); }
+
+  size_t memoryUsage() const {
+    return entries_.capacity() * sizeof(Entry) + free_ids_.capacity() * sizeof(Id) +
+           ids_.size() * (sizeof(Id) + kContainerNodeOverhead) + ids_.bucket_count() * sizeof(void *);
+  }
+
+ private:
+  struct Entry {
+    Hash hash;
+    uint32_t refs = 0;
+  };
+
+  // Set of ids hashed and compared by the hash they refer to, so hash can be looked up without storing it twice
+  struct IdHasher {
+    using is_transparent = void;
+    const std::vector<Entry> *entries;
+    size_t operator()(Id id) const { return std::hash<Hash>()((*entries)[id].hash); }
+    size_t operator()(const Hash &hash) const { return std::hash<Hash>()(hash); }
+  };
+  struct IdEqual {
+    using is_transparent = void;
+    const std::vector<Entry> *entries;
+    bool operator()(Id a, Id b) const { return a == b; }
+    bool operator()(Id a, const Hash &b) const { return (*entries)[a].hash == b; }
+    bool operator()(const Hash &a, Id b) const { return a == (*entries)[b].hash; }
+  };
+
+  std::vector<Entry> entries_;
+  std::vector<Id> free_ids_;
+  std::unordered_set<Id, IdHasher, IdEqual> ids_;
+};
+
+}  // namespace taraxa::util
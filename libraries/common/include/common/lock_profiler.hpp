@@ -0,0 +1,188 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace taraxa::util {
+
+/**
+ * @brief Wait and hold times of named locks
+ *
+ * Locks are wrapped by ProfiledMutex, which records into the profile of its name. Times are counted in power of two
+ * microseconds buckets with relaxed atomics, so recording never takes a lock. Call sites are recorded only for
+ * contended acquisitions. While profiling is disabled a lock operation costs one relaxed atomic load.
+ */
+class LockProfiler {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // Bucket 0 counts times under 1 us, bucket i times in [2^(i-1), 2^i) us, the last one counts everything above
+  static constexpr size_t kBuckets = 24;
+  // Distinct call sites kept per lock, contentions from other sites are counted as unknown site
+  static constexpr size_t kMaxCallSites = 64;
+
+  struct Histogram {
+    std::array<std::atomic<uint64_t>, kBuckets> buckets{};
+    std::atomic<uint64_t> total_ns{0};
+
+    void record(std::chrono::nanoseconds duration);
+  };
+
+  struct CallSite {
+    std::atomic<uintptr_t> address{0};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> wait_ns{0};
+  };
+
+  struct Profile {
+    explicit Profile(std::string_view name) : name(name) {}
+
+    void recordWait(std::chrono::nanoseconds duration, bool contended, const void* call_site);
+    void recordHold(std::chrono::nanoseconds duration) { hold.record(duration); }
+
+    const std::string name;
+    Histogram wait;
+    Histogram hold;
+    std::atomic<uint64_t> contended{0};
+    std::array<CallSite, kMaxCallSites + 1> call_sites{};
+  };
+
+  struct HistogramStats {
+    std::array<uint64_t, kBuckets> buckets{};
+    uint64_t count = 0;
+    std::chrono::nanoseconds total{0};
+
+    /**
+     * @return upper bound of the bucket holding the quantile in microseconds
+     */
+    double percentileUs(double quantile) const;
+  };
+
+  struct CallSiteStats {
+    // Symbol if available and module offset that can be resolved with addr2line
+    std::string location;
+    uint64_t count = 0;
+    std::chrono::nanoseconds wait{0};
+  };
+
+  struct LockStats {
+    std::string name;
+    uint64_t contended = 0;
+    HistogramStats wait;
+    // Only exclusive holds are measured, shared holds overlap
+    HistogramStats hold;
+    // Sorted by total wait, the most contending first
+    std::vector<CallSiteStats> call_sites;
+  };
+
+  static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+  static void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+  /**
+   * @return profile of the name, created on the first call. Profiles are never destroyed
+   */
+  static Profile& profile(std::string_view name);
+
+  /**
+   * @param max_call_sites number of the most contending call sites returned for each lock
+   * @return stats of all named locks in the order of their registration
+   */
+  static std::vector<LockStats> stats(size_t max_call_sites = 10);
+
+ private:
+  static inline std::atomic<bool> enabled_{false};
+};
+
+/**
+ * @brief Drop-in replacement of std::mutex or std::shared_mutex that records into lock profile of its name
+ *
+ * Works with std::unique_lock, std::shared_lock and std::scoped_lock. std::condition_variable_any has to be used
+ * instead of std::condition_variable.
+ */
+template <class Mutex>
+class ProfiledMutex {
+ public:
+  explicit ProfiledMutex(std::string_view name) : profile_(LockProfiler::profile(name)) {}
+
+  ProfiledMutex(const ProfiledMutex&) = delete;
+  ProfiledMutex& operator=(const ProfiledMutex&) = delete;
+
+  void lock() {
+    if (!LockProfiler::enabled()) {
+      mutex_.lock();
+      return;
+    }
+    profiledLock();
+  }
+
+  bool try_lock() {
+    if (!mutex_.try_lock()) {
+      return false;
+    }
+    if (LockProfiler::enabled()) {
+      hold_start_ = LockProfiler::Clock::now();
+    }
+    return true;
+  }
+
+  void unlock() {
+    // Hold is not recorded if profiling was enabled while the lock was held
+    if (hold_start_ != LockProfiler::Clock::time_point{}) {
+      profile_.recordHold(LockProfiler::Clock::now() - hold_start_);
+      hold_start_ = {};
+    }
+    mutex_.unlock();
+  }
+
+  void lock_shared() {
+    if (!LockProfiler::enabled()) {
+      mutex_.lock_shared();
+      return;
+    }
+    profiledLockShared();
+  }
+
+  bool try_lock_shared() { return mutex_.try_lock_shared(); }
+
+  void unlock_shared() { mutex_.unlock_shared(); }
+
+ private:
+  // Not inlined, so that return address points into the function that took the lock, lock() itself is inlined there
+  __attribute__((noinline)) void profiledLock() {
+    acquire(__builtin_return_address(0), [this] { return mutex_.try_lock(); }, [this] { mutex_.lock(); });
+    // Written and read only by the exclusive owner
+    hold_start_ = LockProfiler::Clock::now();
+  }
+
+  __attribute__((noinline)) void profiledLockShared() {
+    acquire(
+        __builtin_return_address(0), [this] { return mutex_.try_lock_shared(); }, [this] { mutex_.lock_shared(); });
+  }
+
+  template <class TryLock, class Lock>
+  void acquire(const void* call_site, TryLock&& try_lock, Lock&& lock) {
+    if (try_lock()) {
+      profile_.recordWait({}, false, call_site);
+      return;
+    }
+    const auto start = LockProfiler::Clock::now();
+    lock();
+    profile_.recordWait(LockProfiler::Clock::now() - start, true, call_site);
+  }
+
+  Mutex mutex_;
+  LockProfiler::Profile& profile_;
+  LockProfiler::Clock::time_point hold_start_;
+};
+
+using ProfiledExclusiveMutex = ProfiledMutex<std::mutex>;
+using ProfiledSharedMutex = ProfiledMutex<std::shared_mutex>;
+
+}  // namespace taraxa::util
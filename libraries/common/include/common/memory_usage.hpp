@@ -0,0 +1,28 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace taraxa::util {
+
+// Rough heap overhead of a single element in node based std containers: links, cached hash, allocator header
+constexpr size_t kContainerNodeOverhead = 32;
+
+/**
+ * @brief Approximate memory used by a structure
+ *
+ * Owner adds and subtracts estimated size of elements as they are inserted and erased, so reading it never scans
+ * the structure and is safe from any thread.
+ */
+class MemoryUsage {
+ public:
+  void add(size_t bytes) { bytes_.fetch_add(bytes, std::memory_order_relaxed); }
+  void sub(size_t bytes) { bytes_.fetch_sub(bytes, std::memory_order_relaxed); }
+  void reset() { bytes_.store(0, std::memory_order_relaxed); }
+  size_t bytes() const { return bytes_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<size_t> bytes_{0};
+};
+
+}  // namespace taraxa::util
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+namespace taraxa::util {
+
+/**
+ * @brief Value computed at most once on first access and read without locking afterwards
+ *
+ * Meant for derived fields like hashes and recovered senders that are read far more often than computed. The first
+ * reader computes the value while concurrent readers wait for it, every later read is a single acquire load. Copies
+ * take the value over only if it was already computed.
+ */
+template <class T>
+class OnceValue {
+ public:
+  OnceValue() = default;
+  ~OnceValue() = default;
+
+  OnceValue(const OnceValue &other) { copyFrom(other); }
+  OnceValue(OnceValue &&other) { copyFrom(other); }
+  OnceValue &operator=(const OnceValue &other) {
+    if (this != &other) {
+      copyFrom(other);
+    }
+    return *this;
+  }
+  OnceValue &operator=(OnceValue &&other) {
+    if (this != &other) {
+      copyFrom(other);
+    }
+    return *this;
+  }
+
+  /**
+   * @param init computes the value, called only by the first reader. If it throws, next reader calls it again
+   */
+  template <class Init>
+  const T &get(Init &&init) const {
+    if (state_.load(std::memory_order_acquire) != kReady) [[unlikely]] {
+      initialize(std::forward<Init>(init));
+    }
+    return value_;
+  }
+
+  /**
+   * @brief Sets value known upfront, e.g. at decode time. Value that is already computed is kept
+   */
+  void set(T value) const {
+    initialize([&value] { return std::move(value); });
+  }
+
+  bool isSet() const { return state_.load(std::memory_order_acquire) == kReady; }
+
+ private:
+  static constexpr uint8_t kEmpty = 0;
+  static constexpr uint8_t kInitializing = 1;
+  static constexpr uint8_t kReady = 2;
+
+  template <class Init>
+  void initialize(Init &&init) const {
+    auto state = state_.load(std::memory_order_acquire);
+    while (state != kReady) {
+      if (state == kEmpty && state_.compare_exchange_weak(state, kInitializing, std::memory_order_acquire)) {
+        try {
+          value_ = init();
+        } catch (...) {
+          state_.store(kEmpty, std::memory_order_release);
+          state_.notify_all();
+          throw;
+        }
+        state_.store(kReady, std::memory_order_release);
+        state_.notify_all();
+        return;
+      }
+      if (state == kInitializing) {
+        state_.wait(kInitializing, std::memory_order_acquire);
+        state = state_.load(std::memory_order_acquire);
+      }
+    }
+  }
+
+  void copyFrom(const OnceValue &other) {
+    if (other.isSet()) {
+      value_ = other.value_;
+      state_.store(kReady, std::memory_order_release);
+    } else {
+      value_ = T();
+      state_.store(kEmpty, std::memory_order_release);
+    }
+  }
+
+  mutable std::atomic<uint8_t> state_ = kEmpty;
+  mutable T value_{};
+};
+
+}  // namespace taraxa::util
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace taraxa::util {
+
+/**
+ * @brief Keeps the most recent samples in a ring buffer and answers percentile queries over them
+ *
+ * Samples are added from any thread, percentile copies the window, so it is meant for small windows queried rarely,
+ * e.g. once per consensus step.
+ */
+class RollingSamples {
+ public:
+  static constexpr size_t kDefaultCapacity = 1000;
+
+  explicit RollingSamples(size_t capacity = kDefaultCapacity) : kCapacity(std::max<size_t>(capacity, 1)) {
+    samples_.reserve(kCapacity);
+  }
+
+  void add(double sample) {
+    std::scoped_lock lock(mutex_);
+    if (samples_.size() < kCapacity) {
+      samples_.push_back(sample);
+    } else {
+      samples_[next_] = sample;
+    }
+    next_ = (next_ + 1) % kCapacity;
+  }
+
+  size_t size() const {
+    std::scoped_lock lock(mutex_);
+    return samples_.size();
+  }
+
+  /**
+   * @param percentile in range [0, 1]
+   * @return nearest rank percentile of the window, empty if there are less than min_samples samples
+   */
+  std::optional<double> percentile(double percentile, size_t min_samples = 1) const {
+    std::vector<double> samples;
+    {
+      std::scoped_lock lock(mutex_);
+      if (samples_.empty() || samples_.size() < min_samples) {
+        return {};
+      }
+      samples = samples_;
+    }
+    const auto rank = static_cast<size_t>(std::clamp(percentile, 0.0, 1.0) * static_cast<double>(samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+    return samples[rank];
+  }
+
+ private:
+  const size_t kCapacity;
+  mutable std::mutex mutex_;
+  std::vector<double> samples_;
+  size_t next_ = 0;
+};
+
+}  // namespace taraxa::util
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace taraxa::util {
+
+/**
+ * @brief Approximate set of recently inserted hashes with memory bounded by bytes instead of items count.
+ *
+ *        Each shard keeps a small exact ring of the most recent keys in front of a pair of bloom filters. New keys
+ *        go to the current filter, once it holds as many keys as it can at the requested false positive rate it
+ *        becomes the previous one and the oldest generation is dropped. contains() of a key that was never inserted
+ *        returns true with probability ~ false_positive_rate, which is acceptable for tracking of hashes known to
+ *        peers, it only means that item is not sent to peer that does not have it yet
+ *
+ * @note Key must be a hash (FixedHash) of at least 16 bytes, its bytes are used directly as hash functions input
+ */
+template <class Key, size_t kShardsCount = 16>
+class RotatingBloomFilter {
+  static_assert(kShardsCount > 0 && (kShardsCount & (kShardsCount - 1)) == 0, "Shards count must be power of two");
+
+ public:
+  /**
+   * @param max_bytes memory used by bloom filters of both generations
+   * @param false_positive_rate false positive rate of a single generation
+   * @param exact_recent_count number of the most recent keys that are tracked exactly
+   */
+  RotatingBloomFilter(size_t max_bytes, double false_positive_rate, size_t exact_recent_count)
+      : kWordsPerFilter(std::max<size_t>(1, max_bytes / (2 * kShardsCount * sizeof(uint64_t)))),
+        // Optimal number of hash functions for the rate is -log2(rate), capacity follows from it and filter size
+        kHashesCount(std::clamp<long>(std::lround(-std::log2(std::clamp(false_positive_rate, 1e-12, 0.5))), 1, 32)),
+        kGenerationCapacity(std::max<size_t>(1, kWordsPerFilter * 64 * std::log(2.0) / kHashesCount)),
+        kRecentCount(std::max<size_t>(1, exact_recent_count / kShardsCount)) {}
+
+  /**
+   * @return true if key was not contained before
+   */
+  bool insert(const Key &key) {
+    const auto [h1, h2] = hashes(key);
+    auto &shard = shards_[shardIndex(key)];
+    std::unique_lock lock(shard.mtx);
+    if (shard.contains(h1, h2, *this)) {
+      return false;
+    }
+    if (shard.current.empty()) {
+      shard.current.assign(kWordsPerFilter, 0);
+    }
+    if (shard.current_count >= kGenerationCapacity) {
+      std::swap(shard.current, shard.previous);
+      std::fill(shard.current.begin(), shard.current.end(), 0);
+      shard.current.resize(kWordsPerFilter, 0);
+      shard.current_count = 0;
+    }
+    for (uint32_t i = 0; i < kHashesCount; ++i) {
+      const auto bit = (h1 + i * h2) % (kWordsPerFilter * 64);
+      shard.current[bit / 64] |= uint64_t(1) << (bit % 64);
+    }
+    ++shard.current_count;
+
+    if (shard.recent.size() < kRecentCount) {
+      shard.recent.push_back(h1);
+    } else {
+      shard.recent[shard.recent_next] = h1;
+    }
+    shard.recent_next = (shard.recent_next + 1) % kRecentCount;
+    return true;
+  }
+
+  bool contains(const Key &key) const {
+    const auto [h1, h2] = hashes(key);
+    const auto &shard = shards_[shardIndex(key)];
+    std::shared_lock lock(shard.mtx);
+    return shard.contains(h1, h2, *this);
+  }
+
+  void clear() {
+    for (auto &shard : shards_) {
+      std::unique_lock lock(shard.mtx);
+      shard.current = {};
+      shard.previous = {};
+      shard.current_count = 0;
+      shard.recent = {};
+      shard.recent_next = 0;
+    }
+  }
+
+  /**
+   * @return number of bytes used by bloom filters and recent keys rings, filters are allocated on first insert
+   */
+  size_t memoryUsage() const {
+    size_t bytes = 0;
+    for (const auto &shard : shards_) {
+      std::shared_lock lock(shard.mtx);
+      bytes += (shard.current.capacity() + shard.previous.capacity() + shard.recent.capacity()) * sizeof(uint64_t);
+    }
+    return bytes;
+  }
+
+  /**
+   * @return number of keys a single generation holds before it is rotated
+   */
+  size_t generationCapacity() const { return kGenerationCapacity * kShardsCount; }
+
+ private:
+  struct Shard {
+    mutable std::shared_mutex mtx;
+    std::vector<uint64_t> current;
+    std::vector<uint64_t> previous;
+    size_t current_count = 0;
+    // Exact ring of the most recent keys, keys are identified by their first 8 bytes
+    std::vector<uint64_t> recent;
+    size_t recent_next = 0;
+
+    bool contains(uint64_t h1, uint64_t h2, const RotatingBloomFilter &filter) const {
+      if (std::find(recent.begin(), recent.end(), h1) != recent.end()) {
+        return true;
+      }
+      return filterContains(current, h1, h2, filter) || filterContains(previous, h1, h2, filter);
+    }
+
+    static bool filterContains(const std::vector<uint64_t> &bits, uint64_t h1, uint64_t h2,
+                               const RotatingBloomFilter &filter) {
+      if (bits.empty()) {
+        return false;
+      }
+      for (uint32_t i = 0; i < filter.kHashesCount; ++i) {
+        const auto bit = (h1 + i * h2) % (filter.kWordsPerFilter * 64);
+        if (!(bits[bit / 64] & (uint64_t(1) << (bit % 64)))) {
+          return false;
+        }
+      }
+      return true;
+    }
+  };
+
+  // Double hashing, keys are already uniformly distributed hashes
+  static std::pair<uint64_t, uint64_t> hashes(const Key &key) {
+    uint64_t h1, h2;
+    std::memcpy(&h1, key.data(), sizeof(h1));
+    std::memcpy(&h2, key.data() + sizeof(h1), sizeof(h2));
+    return {h1, h2 | 1};
+  }
+
+  static size_t shardIndex(const Key &key) { return key.data()[Key::size - 1] & (kShardsCount - 1); }
+
+  const size_t kWordsPerFilter;
+  const uint32_t kHashesCount;
+  const size_t kGenerationCapacity;
+  const size_t kRecentCount;
+  std::array<Shard, kShardsCount> shards_;
+};
+
+}  // namespace taraxa::util
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "common/rolling_samples.hpp"
+
+namespace taraxa::util {
+
+/**
+ * @brief Priority class of a scheduled task, lower value is picked first
+ */
+enum class TaskClass : uint8_t { Consensus = 0, Network, Execution, Rpc, Background };
+constexpr size_t kTaskClassesCount = 5;
+
+const char *toString(TaskClass task_class);
+
+/**
+ * @brief Node-wide pool of worker threads shared by components instead of each one owning its own thread pool
+ *
+ * No worker is bound to a class, an idle worker takes the oldest task of the highest priority class that is under its
+ * concurrency cap. Caps keep low priority classes from occupying all workers with long tasks, so consensus work does
+ * not wait behind them. Tasks must not block on futures of other tasks of the same capped class.
+ */
+class Scheduler {
+ public:
+  // Max number of concurrently running tasks per class, 0 means no limit
+  using Caps = std::array<size_t, kTaskClassesCount>;
+
+  /**
+   * @brief Stats of a single class, queue latency is time between post and start of the task
+   */
+  struct ClassStats {
+    size_t queued = 0;
+    size_t running = 0;
+    uint64_t executed = 0;
+    std::optional<double> queue_latency_p50_us;
+    std::optional<double> queue_latency_p99_us;
+  };
+
+  explicit Scheduler(size_t threads = std::thread::hardware_concurrency()) : Scheduler(threads, defaultCaps(threads)) {}
+  Scheduler(size_t threads, Caps caps);
+  ~Scheduler();
+
+  Scheduler(const Scheduler &) = delete;
+  Scheduler(Scheduler &&) = delete;
+  Scheduler &operator=(const Scheduler &) = delete;
+  Scheduler &operator=(Scheduler &&) = delete;
+
+  /**
+   * @return scheduler shared by the whole process, created on first use with a worker per core
+   */
+  static Scheduler &global();
+
+  /**
+   * @return caps for threads count: background tasks use up to a quarter and rpc up to half of the workers
+   */
+  static Caps defaultCaps(size_t threads);
+
+  std::future<void> post(TaskClass task_class, std::function<void()> task);
+
+  void setCap(TaskClass task_class, size_t cap);
+  ClassStats stats(TaskClass task_class) const;
+  size_t threadsCount() const { return workers_.size(); }
+
+ private:
+  struct Task {
+    std::packaged_task<void()> task;
+    std::chrono::steady_clock::time_point posted_at;
+  };
+
+  struct Class {
+    std::deque<Task> queue;
+    size_t running = 0;
+    size_t cap = 0;
+    uint64_t executed = 0;
+    RollingSamples queue_latency_us;
+  };
+
+  void work();
+  // Returns highest priority class with a task that can be started now, must be called with mutex_ locked
+  Class *pickClass();
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopped_ = false;
+  std::array<Class, kTaskClassesCount> classes_;
+  std::vector<std::thread> workers_;
+};
+
+/**
+ * @brief Posts tasks of a single class to a scheduler, drop-in replacement of ThreadPool for components that only post
+ */
+class Executor {
+ public:
+  explicit Executor(TaskClass task_class, Scheduler &scheduler = Scheduler::global())
+      : task_class_(task_class), scheduler_(&scheduler) {}
+
+  std::future<void> post(std::function<void()> task) const { return scheduler_->post(task_class_, std::move(task)); }
+
+ private:
+  TaskClass task_class_;
+  Scheduler *scheduler_;
+};
+
+}  // namespace taraxa::util
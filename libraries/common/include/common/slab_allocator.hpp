@@ -0,0 +1,242 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace taraxa::util {
+
+/**
+ * @brief Pool of equally sized blocks carved from large slabs, shared by all types with the same block size
+ *
+ * Every thread keeps a small cache of free blocks and exchanges whole batches of them with the global free list, so
+ * the mutex is taken once per kBlocksPerBatch allocations. Blocks freed on another thread than they were allocated on
+ * (objects decoded on network threads and dropped by consensus threads) travel back the same way.
+ *
+ * Slabs are never returned to the system, freed blocks are reused for the next objects of the same size. Pool is meant
+ * for the few object types that are allocated and freed all the time, not for one-off allocations.
+ */
+template <size_t BlockSize, size_t BlockAlign>
+class SlabPool {
+ public:
+  static constexpr size_t kBlockAlign = std::max(BlockAlign, alignof(void *));
+  static constexpr size_t kBlockSize =
+      (std::max(BlockSize, sizeof(void *)) + kBlockAlign - 1) / kBlockAlign * kBlockAlign;
+  static constexpr size_t kBlocksPerBatch = 64;
+  static constexpr size_t kBlocksPerSlab = std::max<size_t>(kBlocksPerBatch, (256 * 1024) / kBlockSize);
+
+  static void *allocate() {
+    auto &cache = localCache();
+    if (!cache.head) {
+      if (cache.released) {
+        return global().allocateOne();
+      }
+      refill(cache);
+    }
+    auto *block = cache.head;
+    cache.head = block->next;
+    --cache.size;
+    return block;
+  }
+
+  static void deallocate(void *ptr) noexcept {
+    auto &cache = localCache();
+    auto *block = static_cast<FreeBlock *>(ptr);
+    if (cache.released) {
+      global().push(block, block, 1);
+      return;
+    }
+    block->next = cache.head;
+    cache.head = block;
+    if (++cache.size >= 2 * kBlocksPerBatch) {
+      spill(cache);
+    }
+  }
+
+  /**
+   * @return number of slabs allocated by all threads, memory held by the pool is slabsCount() * kSlabBytes
+   */
+  static size_t slabsCount() {
+    auto &pool = global();
+    std::scoped_lock lock(pool.mutex);
+    return pool.slabs_count;
+  }
+
+  static constexpr size_t kSlabBytes = kBlocksPerSlab * kBlockSize;
+
+ private:
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  struct Batch {
+    FreeBlock *head;
+    size_t size;
+  };
+
+  struct Global {
+    std::mutex mutex;
+    std::vector<Batch> batches;
+    size_t slabs_count = 0;
+
+    void push(FreeBlock *head, FreeBlock *tail, size_t size) {
+      std::scoped_lock lock(mutex);
+      // Partial batches from exiting threads are merged into the last one, so batches stay close to full
+      if (!batches.empty() && batches.back().size + size <= kBlocksPerBatch) {
+        tail->next = batches.back().head;
+        batches.back() = {head, batches.back().size + size};
+        return;
+      }
+      tail->next = nullptr;
+      batches.push_back({head, size});
+    }
+
+    Batch pop() {
+      std::scoped_lock lock(mutex);
+      if (!batches.empty()) {
+        const auto batch = batches.back();
+        batches.pop_back();
+        return batch;
+      }
+      auto *slab = static_cast<std::byte *>(::operator new(kSlabBytes, std::align_val_t{kBlockAlign}));
+      ++slabs_count;
+      for (size_t i = 0; i < kBlocksPerSlab; ++i) {
+        reinterpret_cast<FreeBlock *>(slab + i * kBlockSize)->next =
+            i + 1 < kBlocksPerSlab ? reinterpret_cast<FreeBlock *>(slab + (i + 1) * kBlockSize) : nullptr;
+      }
+      return {reinterpret_cast<FreeBlock *>(slab), kBlocksPerSlab};
+    }
+
+    void *allocateOne() {
+      auto batch = pop();
+      if (batch.size > 1) {
+        push(batch.head->next, tailOf(batch.head->next), batch.size - 1);
+      }
+      return batch.head;
+    }
+  };
+
+  // Trivially destructible, so it stays usable by objects freed by thread_local destructors after the guard ran
+  struct LocalCache {
+    FreeBlock *head = nullptr;
+    size_t size = 0;
+    bool guarded = false;
+    bool released = false;
+  };
+
+  struct LocalCacheGuard {
+    ~LocalCacheGuard() {
+      auto &cache = localCache();
+      cache.released = true;
+      if (cache.head) {
+        global().push(cache.head, tailOf(cache.head), cache.size);
+        cache.head = nullptr;
+        cache.size = 0;
+      }
+    }
+  };
+
+  static Global &global() {
+    // Never destroyed, blocks can be freed by destructors of other static objects
+    static auto *pool = new Global;
+    return *pool;
+  }
+
+  static LocalCache &localCache() {
+    static thread_local LocalCache cache;
+    if (!cache.guarded) {
+      cache.guarded = true;
+      // Flushes the cache to the global list when the thread exits
+      static thread_local LocalCacheGuard guard;
+      (void)guard;
+    }
+    return cache;
+  }
+
+  static FreeBlock *tailOf(FreeBlock *head) {
+    while (head->next) {
+      head = head->next;
+    }
+    return head;
+  }
+
+  static void refill(LocalCache &cache) {
+    const auto batch = global().pop();
+    cache.head = batch.head;
+    cache.size = batch.size;
+  }
+
+  static void spill(LocalCache &cache) {
+    auto *head = cache.head;
+    auto *tail = head;
+    for (size_t i = 1; i < kBlocksPerBatch; ++i) {
+      tail = tail->next;
+    }
+    cache.head = tail->next;
+    cache.size -= kBlocksPerBatch;
+    global().push(head, tail, kBlocksPerBatch);
+  }
+};
+
+/**
+ * @brief Standard allocator of single objects from SlabPool, arrays fall back to the global operator new
+ *
+ * With std::allocate_shared the shared_ptr control block and the object are a single slab block.
+ */
+template <class T>
+class SlabAllocator {
+ public:
+  using value_type = T;
+
+  SlabAllocator() noexcept = default;
+  template <class U>
+  SlabAllocator(const SlabAllocator<U> &) noexcept {}
+
+  T *allocate(size_t n) {
+    if (n != 1) {
+      return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{alignof(T)}));
+    }
+    return static_cast<T *>(Pool::allocate());
+  }
+
+  void deallocate(T *ptr, size_t n) noexcept {
+    if (n != 1) {
+      ::operator delete(ptr, std::align_val_t{alignof(T)});
+      return;
+    }
+    Pool::deallocate(ptr);
+  }
+
+  template <class U>
+  bool operator==(const SlabAllocator<U> &) const noexcept {
+    return true;
+  }
+
+ private:
+  using Pool = SlabPool<sizeof(T), alignof(T)>;
+};
+
+/**
+ * @brief Types that are slab allocated by makeShared, specialized next to the type definition
+ */
+template <class T>
+struct SlabAllocated : std::false_type {};
+
+/**
+ * @brief make_shared that uses SlabAllocator for types marked as SlabAllocated
+ */
+template <class T, class... Args>
+std::shared_ptr<T> makeShared(Args &&...args) {
+  if constexpr (SlabAllocated<std::remove_cv_t<T>>::value) {
+    return std::allocate_shared<T>(SlabAllocator<std::remove_cv_t<T>>(), std::forward<Args>(args)...);
+  } else {
+    return std::make_shared<T>(std::forward<Args>(args)...);
+  }
+}
+
+}  // namespace taraxa::util
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace taraxa::util {
+
+/**
+ * @brief Accumulates wall time spent in named processing stages
+ *
+ * Components keep an optional pointer to it and time their stages with Scope, which does nothing while no timings
+ * are installed. Node installs it only with metrics enabled and observes each record into histograms.
+ */
+class StageTimings {
+ public:
+  using Observer = std::function<void(std::string_view stage, std::chrono::nanoseconds duration)>;
+
+  struct Stage {
+    std::string name;
+    std::chrono::nanoseconds total{0};
+    uint64_t count = 0;
+  };
+
+  /**
+   * @brief Records time from its construction till its destruction into the stage
+   */
+  class Scope {
+   public:
+    Scope(const std::shared_ptr<StageTimings>& timings, std::string_view stage)
+        : timings_(timings.get()), stage_(stage), start_(timings_ ? Clock::now() : Clock::time_point{}) {}
+    ~Scope() {
+      if (timings_) {
+        timings_->record(stage_, Clock::now() - start_);
+      }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    using Clock = std::chrono::steady_clock;
+
+    StageTimings* timings_;
+    const std::string_view stage_;
+    const Clock::time_point start_;
+  };
+
+  StageTimings() = default;
+  explicit StageTimings(Observer observer) : observer_(std::move(observer)) {}
+
+  void record(std::string_view stage, std::chrono::nanoseconds duration) {
+    if (observer_) {
+      observer_(stage, duration);
+    }
+    std::scoped_lock lock(mutex_);
+    // There are only few stages, linear search is faster than a map
+    for (auto& s : stages_) {
+      if (s.name == stage) {
+        s.total += duration;
+        s.count++;
+        return;
+      }
+    }
+    stages_.push_back({std::string(stage), duration, 1});
+  }
+
+  /**
+   * @return stages in the order they were first recorded
+   */
+  std::vector<Stage> stages() const {
+    std::scoped_lock lock(mutex_);
+    return stages_;
+  }
+
+ private:
+  const Observer observer_;
+  mutable std::mutex mutex_;
+  std::vector<Stage> stages_;
+};
+
+}  // namespace taraxa::util
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace taraxa::util {
+
+/**
+ * @brief Runs named tasks on a few threads, each task starting only after all of its dependencies finished
+ *
+ * Meant for one-shot work like node initialization, where independent parts may overlap. If a task throws, tasks not
+ * yet started are skipped and the first exception is rethrown from run().
+ */
+class TaskGraph {
+ public:
+  using Task = std::function<void()>;
+  using Durations = std::vector<std::pair<std::string, std::chrono::nanoseconds>>;
+
+  /**
+   * @param deps names of previously added tasks
+   */
+  void add(std::string name, std::vector<std::string> deps, Task task);
+
+  /**
+   * @return wall time of each task in completion order
+   */
+  Durations run(size_t threads);
+
+ private:
+  struct Node {
+    std::string name;
+    Task task;
+    std::vector<size_t> dependents;
+    size_t pending_deps = 0;
+  };
+
+  std::vector<Node> nodes_;
+};
+
+}  // namespace taraxa::util
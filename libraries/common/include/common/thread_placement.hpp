@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace taraxa::util {
+
+/**
+ * @brief Names of long running thread groups that can be pinned to CPU sets
+ */
+namespace thread_group {
+inline const std::string kPbft = "pbft";
+inline const std::string kFinalChain = "final_chain";
+inline const std::string kPackets = "packets";
+inline const std::string kScheduler = "scheduler";
+inline const std::vector<std::string> kAll = {kPbft, kFinalChain, kPackets, kScheduler};
+}  // namespace thread_group
+
+// CPU set per thread group name
+using ThreadsPlacement = std::map<std::string, std::vector<uint32_t>>;
+
+/**
+ * @brief Parses CPU list in the format used by taskset and cgroups, e.g. "0-3,8,10-11"
+ * @throws std::invalid_argument for malformed list
+ */
+std::vector<uint32_t> parseCpuList(const std::string &list);
+
+/**
+ * @brief Sets CPU sets of thread groups, applies only to threads started after the call
+ */
+void setThreadsPlacement(ThreadsPlacement placement);
+
+/**
+ * @brief Names current thread after its group, so groups are identifiable in profilers and top
+ *
+ * If group has CPU set configured, thread is pinned to it and memory it allocates from now on is taken from the NUMA
+ * node of the CPU it runs on, even if the process was started with another policy (e.g. numactl --interleave).
+ * Failures are ignored, placement is only an optimization.
+ */
+void placeCurrentThread(const std::string &group, std::optional<size_t> index = {});
+
+}  // namespace taraxa::util
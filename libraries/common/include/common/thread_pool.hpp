@@ -44,5 +44,7 @@ class ThreadPool : std::enable_shared_from_this<ThreadPool> {
     uint64_t period_ms = 0, delay_ms = period_ms;
   };
   void post_loop(Periodicity const &periodicity, std::function<void()> action);
+  // Period is read before every run, so it can be changed while the loop is running
+  void post_loop(std::function<uint64_t()> period_ms, std::function<void()> action);
 };
 }  // namespace taraxa::util
\ No newline at end of file
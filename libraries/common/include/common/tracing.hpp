@@ -0,0 +1,79 @@
+#pragma once
+
+#include <json/json.h>
+
+#include <atomic>
+#include <chrono>
+#include <string_view>
+
+namespace taraxa::util {
+
+/**
+ * @brief In-process tracer of scoped spans, exported in Chrome trace event format (chrome://tracing, Perfetto)
+ *
+ * Every thread records its spans into its own ring buffer holding the last kThreadBufferSize spans, so recording
+ * never contends with other threads. While tracing is stopped a span costs one relaxed atomic load.
+ */
+class Tracer {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr size_t kThreadBufferSize = 16384;
+
+  static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Drops previously recorded spans and starts recording
+   */
+  static void start();
+
+  /**
+   * @brief Stops recording, recorded spans are kept for export
+   */
+  static void stop();
+
+  /**
+   * @return recorded spans as Chrome trace json object
+   */
+  static Json::Value exportChromeTrace();
+
+  /**
+   * @param name must outlive the tracer, e.g. literal or result of intern()
+   */
+  static void record(const char* name, Clock::time_point start, Clock::time_point end);
+
+  /**
+   * @return name copy with static lifetime, meant for names known only at runtime (call it once, not per span)
+   */
+  static const char* intern(std::string_view name);
+
+ private:
+  static inline std::atomic<bool> enabled_{false};
+};
+
+/**
+ * @brief Records span from its construction till its destruction if tracing is enabled at construction
+ */
+class TraceSpan {
+ public:
+  explicit TraceSpan(const char* name)
+      : name_(name), start_(Tracer::enabled() ? Tracer::Clock::now() : Tracer::Clock::time_point{}) {}
+  ~TraceSpan() {
+    if (start_ != Tracer::Clock::time_point{}) {
+      Tracer::record(name_, start_, Tracer::Clock::now());
+    }
+  }
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+ private:
+  const char* name_;
+  const Tracer::Clock::time_point start_;
+};
+
+}  // namespace taraxa::util
+
+#define TRACE_SPAN_CONCAT_(a, b) a##b
+#define TRACE_SPAN_CONCAT(a, b) TRACE_SPAN_CONCAT_(a, b)
+#define TRACE_SPAN(name) const ::taraxa::util::TraceSpan TRACE_SPAN_CONCAT(trace_span_, __LINE__)(name)
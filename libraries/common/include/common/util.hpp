@@ -10,6 +10,9 @@
 #include <boost/iostreams/stream.hpp>
 #include <boost/iostreams/stream_buffer.hpp>
 #include <boost/thread.hpp>
+#include <algorithm>
+#include <array>
+#include <deque>
 #include <iostream>
 #include <list>
 #include <shared_mutex>
@@ -18,6 +21,7 @@
 #include <unordered_set>
 
 #include "char_traits.hpp"
+#include "memory_usage.hpp"
 
 namespace taraxa {
 
@@ -255,6 +259,14 @@ class ExpirationCache {
     return cache_.size();
   }
 
+  /**
+   * @return approximate number of bytes used by cached keys
+   */
+  std::size_t memoryUsage() const {
+    std::shared_lock lck(mtx_);
+    return cache_.size() * (sizeof(Key) + taraxa::util::kContainerNodeOverhead) + expiration_.size() * sizeof(Key);
+  }
+
   void clear() {
     std::unique_lock lck(mtx_);
     cache_.clear();
@@ -331,6 +343,212 @@ class ExpirationBlockNumberCache : public ExpirationCache<Key> {
   uint64_t last_block_number_ = 0;
 };
 
+/**
+ * @brief Drop-in replacement of ExpirationCache/ExpirationBlockNumberCache for hash keys with heavy concurrent access.
+ *        Keys are spread over independent shards with their own lock, so inserts of different hashes don't contend
+ *        on a single mutex. Shards store only 64-bit fingerprints of keys in an open addressing table, which keeps
+ *        memory per key small. Fingerprints may collide, so contains() can return false positive with negligible
+ *        probability (~size / 2^64), which is fine for tracking of known hashes
+ *
+ * @note max_size and delete_step are split evenly between shards, blocks_to_keep == 0 disables block number expiration
+ */
+template <class Key, size_t kShardsCount = 16>
+class ShardedExpirationCache {
+  static_assert(kShardsCount > 0 && kShardsCount <= 256 && (kShardsCount & (kShardsCount - 1)) == 0,
+                "Shards count must be power of two not bigger than 256");
+
+ public:
+  ShardedExpirationCache(uint32_t max_size, uint32_t delete_step, uint32_t blocks_to_keep = 0)
+      : kShardMaxSize(std::max<uint32_t>(1, (max_size + kShardsCount - 1) / kShardsCount)),
+        kShardDeleteStep(std::clamp<uint32_t>(delete_step / kShardsCount, 1, kShardMaxSize)),
+        kBlocksToKeep(blocks_to_keep) {}
+
+  /**
+   * @brief Inserts key into the cache. In case provided key is already in cache, only shared lock of its shard
+   *        is acquired and function returns false
+   *
+   * @param key
+   * @param block_number used for expiration only if blocks_to_keep was set
+   * @return true if actual insertion took place, otherwise false
+   */
+  bool insert(Key const &key, uint64_t block_number = 0) {
+    const auto fp = fingerprint(key);
+    auto &shard = shards_[shardIndex(fp)];
+    {
+      std::shared_lock lock(shard.mtx);
+      if (shard.find(fp)) {
+        return false;
+      }
+    }
+
+    // There must be double check if key is not already in cache due to possible race condition
+    std::unique_lock lock(shard.mtx);
+    if (!shard.insert(fp)) {
+      return false;
+    }
+
+    if (kBlocksToKeep && block_number > shard.last_block_number) {
+      shard.last_block_number = block_number;
+      while (!shard.expiration.empty() && block_number > kBlocksToKeep &&
+             shard.expiration.front().second < block_number - kBlocksToKeep) {
+        shard.erase(shard.expiration.front().first);
+        shard.expiration.pop_front();
+      }
+    }
+    shard.expiration.emplace_back(fp, block_number);
+    if (shard.size > kShardMaxSize) {
+      // Expiration queue can hold keys that were already erased, so keep going until the size is back in limit
+      for (uint32_t i = 0; !shard.expiration.empty() && (i < kShardDeleteStep || shard.size > kShardMaxSize); i++) {
+        shard.erase(shard.expiration.front().first);
+        shard.expiration.pop_front();
+      }
+    }
+
+    return true;
+  }
+
+  bool contains(Key const &key) const {
+    const auto fp = fingerprint(key);
+    const auto &shard = shards_[shardIndex(fp)];
+    std::shared_lock lock(shard.mtx);
+    return shard.find(fp);
+  }
+
+  std::size_t count(Key const &key) const { return contains(key) ? 1 : 0; }
+
+  void erase(Key const &key) {
+    const auto fp = fingerprint(key);
+    auto &shard = shards_[shardIndex(fp)];
+    std::unique_lock lock(shard.mtx);
+    shard.erase(fp);
+  }
+
+  std::size_t size() const {
+    std::size_t size = 0;
+    for (const auto &shard : shards_) {
+      std::shared_lock lock(shard.mtx);
+      size += shard.size;
+    }
+    return size;
+  }
+
+  /**
+   * @return approximate number of bytes used by shard tables and expiration queues
+   */
+  std::size_t memoryUsage() const {
+    std::size_t bytes = 0;
+    for (const auto &shard : shards_) {
+      std::shared_lock lock(shard.mtx);
+      bytes += shard.table.capacity() * sizeof(uint64_t) +
+               shard.expiration.size() * sizeof(std::pair<uint64_t, uint64_t>);
+    }
+    return bytes;
+  }
+
+  void clear() {
+    for (auto &shard : shards_) {
+      std::unique_lock lock(shard.mtx);
+      shard.table.clear();
+      shard.size = 0;
+      shard.expiration.clear();
+    }
+  }
+
+ private:
+  // Linear probing table of fingerprints, 0 marks empty slot. Grows lazily so idle peers don't cost memory
+  struct Shard {
+    mutable std::shared_mutex mtx;
+    std::vector<uint64_t> table;
+    std::size_t size = 0;
+    std::deque<std::pair<uint64_t, uint64_t>> expiration;  // <fingerprint, block_number>
+    uint64_t last_block_number = 0;
+
+    std::size_t mask() const { return table.size() - 1; }
+
+    bool find(uint64_t fp) const {
+      if (table.empty()) {
+        return false;
+      }
+      for (auto i = fp & mask(); table[i]; i = (i + 1) & mask()) {
+        if (table[i] == fp) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    bool insert(uint64_t fp) {
+      // Keep load factor under 1/2
+      if ((size + 1) * 2 > table.size()) {
+        rehash(std::max<std::size_t>(16, table.size() * 2));
+      }
+      auto i = fp & mask();
+      for (; table[i]; i = (i + 1) & mask()) {
+        if (table[i] == fp) {
+          return false;
+        }
+      }
+      table[i] = fp;
+      size++;
+      return true;
+    }
+
+    void erase(uint64_t fp) {
+      if (table.empty()) {
+        return;
+      }
+      auto i = fp & mask();
+      for (; table[i] != fp; i = (i + 1) & mask()) {
+        if (!table[i]) {
+          return;
+        }
+      }
+      // Backward shift deletion, moves following entries of the probe sequence so no tombstones are needed
+      for (auto j = (i + 1) & mask(); table[j]; j = (j + 1) & mask()) {
+        const auto home = table[j] & mask();
+        const bool stays = (i < j) ? (i < home && home <= j) : (i < home || home <= j);
+        if (!stays) {
+          table[i] = table[j];
+          i = j;
+        }
+      }
+      table[i] = 0;
+      size--;
+    }
+
+    void rehash(std::size_t capacity) {
+      std::vector<uint64_t> old_table(capacity, 0);
+      table.swap(old_table);
+      for (auto fp : old_table) {
+        if (fp) {
+          auto i = fp & mask();
+          while (table[i]) {
+            i = (i + 1) & mask();
+          }
+          table[i] = fp;
+        }
+      }
+    }
+  };
+
+  static uint64_t fingerprint(Key const &key) {
+    // splitmix64 finalizer, so both shard and slot bits are well distributed even for non-random keys
+    uint64_t x = std::hash<Key>{}(key);
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x ? x : 1;
+  }
+
+  // Top bits select shard, low bits select slot within shard
+  static std::size_t shardIndex(uint64_t fp) { return (fp >> 56) & (kShardsCount - 1); }
+
+  const uint32_t kShardMaxSize;
+  const uint32_t kShardDeleteStep;
+  const uint32_t kBlocksToKeep;
+  std::array<Shard, kShardsCount> shards_;
+};
+
 template <typename T>
 auto slice(std::vector<T> const &v, std::size_t from = -1, std::size_t to = -1) {
   auto b = v.begin();
@@ -347,7 +565,7 @@ auto getRlpBytes(T const &t) {
 template <class Key, class Value>
 class ExpirationCacheMap {
  public:
-  ExpirationCacheMap(uint32_t max_size, uint32_t delete_step) : kMaxSize(max_size), kDeleteStep(delete_step) {}
+  ExpirationCacheMap(uint32_t max_size, uint32_t delete_step) : max_size_(max_size), delete_step_(delete_step) {}
 
   /**
    * @brief Inserts <key,value> pair into the cache map. In case provided key is already in cache, only shared lock
@@ -374,7 +592,7 @@ class ExpirationCacheMap {
     }
 
     expiration_.push_back(key);
-    if (cache_.size() > kMaxSize) {
+    if (cache_.size() > max_size_) {
       eraseOldest();
     }
     return true;
@@ -413,8 +631,8 @@ class ExpirationCacheMap {
     cache_[key] = value;
     expiration_.push_back(key);
 
-    if (cache_.size() > kMaxSize) {
-      for (uint32_t i = 0; i < kDeleteStep; i++) {
+    if (cache_.size() > max_size_) {
+      for (uint32_t i = 0; i < delete_step_; i++) {
         cache_.erase(expiration_.front());
         expiration_.pop_front();
       }
@@ -438,8 +656,8 @@ class ExpirationCacheMap {
     }
     cache_[key] = value;
     expiration_.push_back(key);
-    if (cache_.size() > kMaxSize) {
-      for (uint32_t i = 0; i < kDeleteStep; i++) {
+    if (cache_.size() > max_size_) {
+      for (uint32_t i = 0; i < delete_step_; i++) {
         cache_.erase(expiration_.front());
         expiration_.pop_front();
       }
@@ -447,6 +665,24 @@ class ExpirationCacheMap {
     return ret;
   }
 
+  /**
+   * @brief Changes size limit of the running cache, oldest entries over the new limit are dropped right away
+   */
+  void setMaxSize(uint32_t max_size, uint32_t delete_step) {
+    std::unique_lock lck(mtx_);
+    max_size_ = max_size;
+    delete_step_ = delete_step;
+    while (cache_.size() > max_size_ && !expiration_.empty()) {
+      cache_.erase(expiration_.front());
+      expiration_.pop_front();
+    }
+  }
+
+  uint32_t maxSize() const {
+    std::shared_lock lck(mtx_);
+    return max_size_;
+  }
+
   std::unordered_map<Key, Value> getRawMap() {
     std::shared_lock lck(mtx_);
     return cache_;
@@ -458,8 +694,8 @@ class ExpirationCacheMap {
     if (it != cache_.end() && it->second == expected_value) {
       it->second = value;
       expiration_.push_back(key);
-      if (cache_.size() > kMaxSize) {
-        for (auto i = 0; i < kDeleteStep; i++) {
+      if (cache_.size() > max_size_) {
+        for (auto i = 0; i < delete_step_; i++) {
           cache_.erase(expiration_.front());
           expiration_.pop_front();
         }
@@ -471,7 +707,7 @@ class ExpirationCacheMap {
 
  protected:
   virtual void eraseOldest() {
-    for (uint32_t i = 0; i < kDeleteStep; i++) {
+    for (uint32_t i = 0; i < delete_step_; i++) {
       cache_.erase(expiration_.front());
       expiration_.pop_front();
     }
@@ -479,8 +715,9 @@ class ExpirationCacheMap {
 
   std::unordered_map<Key, Value> cache_;
   std::deque<Key> expiration_;
-  const uint32_t kMaxSize;
-  const uint32_t kDeleteStep;
+  // Guarded by mtx_, changed only by setMaxSize
+  uint32_t max_size_;
+  uint32_t delete_step_;
   mutable std::shared_mutex mtx_;
 };
 
@@ -0,0 +1,96 @@
+#include "common/allocator.hpp"
+
+#include <algorithm>
+
+#if defined(TARAXA_JEMALLOC)
+#include <jemalloc/jemalloc.h>
+#elif defined(TARAXA_MIMALLOC)
+#include <mimalloc.h>
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace taraxa::util::allocator {
+
+namespace {
+double fragmentation(uint64_t allocated, uint64_t active) {
+  return active ? static_cast<double>(active - std::min(allocated, active)) / static_cast<double>(active) : 0;
+}
+}  // namespace
+
+#if defined(TARAXA_JEMALLOC)
+
+std::string name() { return "jemalloc"; }
+
+std::optional<Stats> stats() {
+  // Stats are cached by jemalloc, epoch has to be advanced to refresh them
+  uint64_t epoch = 1;
+  size_t epoch_size = sizeof(epoch);
+  if (mallctl("epoch", &epoch, &epoch_size, &epoch, epoch_size)) {
+    return {};
+  }
+  Stats ret;
+  size_t value = 0;
+  size_t value_size = sizeof(value);
+  for (const auto& [key, field] : {std::pair{"stats.allocated", &Stats::allocated},
+                                   std::pair{"stats.active", &Stats::active},
+                                   std::pair{"stats.resident", &Stats::resident}}) {
+    if (mallctl(key, &value, &value_size, nullptr, 0)) {
+      return {};
+    }
+    ret.*field = value;
+  }
+  ret.fragmentation = fragmentation(ret.allocated, ret.active);
+  return ret;
+}
+
+bool purge() {
+  const auto key = "arena." + std::to_string(MALLCTL_ARENAS_ALL) + ".purge";
+  return mallctl(key.c_str(), nullptr, nullptr, nullptr, 0) == 0;
+}
+
+#elif defined(TARAXA_MIMALLOC)
+
+std::string name() { return "mimalloc"; }
+
+std::optional<Stats> stats() {
+  size_t elapsed_ms, user_ms, system_ms, current_rss, peak_rss, current_commit, peak_commit, page_faults;
+  mi_process_info(&elapsed_ms, &user_ms, &system_ms, &current_rss, &peak_rss, &current_commit, &peak_commit,
+                  &page_faults);
+  // Mimalloc does not expose application allocated bytes without its stats build, committed memory is reported
+  return Stats{current_commit, current_commit, current_rss, 0};
+}
+
+bool purge() {
+  mi_collect(true);
+  return true;
+}
+
+#elif defined(__GLIBC__)
+
+std::string name() { return "glibc"; }
+
+std::optional<Stats> stats() {
+  const auto info = mallinfo2();
+  // Glibc does not track resident pages, heap and mmapped chunks are reported as active and resident
+  const uint64_t active = info.arena + info.hblkhd;
+  const uint64_t allocated = info.uordblks + info.hblkhd;
+  return Stats{allocated, active, active, fragmentation(allocated, active)};
+}
+
+bool purge() {
+  malloc_trim(0);
+  return true;
+}
+
+#else
+
+std::string name() { return "system"; }
+
+std::optional<Stats> stats() { return {}; }
+
+bool purge() { return false; }
+
+#endif
+
+}  // namespace taraxa::util::allocator
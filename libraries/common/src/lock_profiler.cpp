@@ -0,0 +1,155 @@
+#include "common/lock_profiler.hpp"
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+
+namespace taraxa::util {
+
+namespace {
+
+struct Registry {
+  std::mutex mutex;
+  // Deque keeps references to profiles valid while new ones are added
+  std::deque<LockProfiler::Profile> profiles;
+};
+
+// Never destroyed so that locks of objects destroyed at exit can still record
+Registry& registry() {
+  static auto* registry = new Registry();
+  return *registry;
+}
+
+std::string callSiteLocation(uintptr_t address) {
+  Dl_info info{};
+  if (!dladdr(reinterpret_cast<void*>(address), &info) || !info.dli_fname) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "0x%lx", static_cast<unsigned long>(address));
+    return buf;
+  }
+
+  std::string module = info.dli_fname;
+  if (const auto slash = module.rfind('/'); slash != std::string::npos) {
+    module.erase(0, slash + 1);
+  }
+  char offset[32];
+  std::snprintf(offset, sizeof(offset), "+0x%lx",
+                static_cast<unsigned long>(address - reinterpret_cast<uintptr_t>(info.dli_fbase)));
+  auto location = module + offset;
+  // Symbols are available only for exported functions, module offset can be resolved with addr2line otherwise
+  if (info.dli_sname) {
+    int status = 0;
+    const std::unique_ptr<char, decltype(&std::free)> demangled(
+        abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status), &std::free);
+    location += " ";
+    location += status == 0 ? demangled.get() : info.dli_sname;
+  }
+  return location;
+}
+
+LockProfiler::HistogramStats histogramStats(const LockProfiler::Histogram& histogram) {
+  LockProfiler::HistogramStats stats;
+  for (size_t i = 0; i < LockProfiler::kBuckets; ++i) {
+    stats.buckets[i] = histogram.buckets[i].load(std::memory_order_relaxed);
+    stats.count += stats.buckets[i];
+  }
+  stats.total = std::chrono::nanoseconds(histogram.total_ns.load(std::memory_order_relaxed));
+  return stats;
+}
+
+}  // namespace
+
+void LockProfiler::Histogram::record(std::chrono::nanoseconds duration) {
+  const auto us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+  const auto bucket = std::min<size_t>(std::bit_width(us), kBuckets - 1);
+  buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  total_ns.fetch_add(duration.count(), std::memory_order_relaxed);
+}
+
+void LockProfiler::Profile::recordWait(std::chrono::nanoseconds duration, bool was_contended, const void* call_site) {
+  wait.record(duration);
+  if (!was_contended) {
+    return;
+  }
+  contended.fetch_add(1, std::memory_order_relaxed);
+
+  // Open addressing without removals, slot is claimed by the first site hashed into it. Last slot is the unknown site
+  const auto address = reinterpret_cast<uintptr_t>(call_site);
+  auto* site = &call_sites[kMaxCallSites];
+  for (size_t i = 0, pos = (address >> 2) % kMaxCallSites; i < kMaxCallSites; ++i, pos = (pos + 1) % kMaxCallSites) {
+    auto current = call_sites[pos].address.load(std::memory_order_acquire);
+    if (current == 0 && call_sites[pos].address.compare_exchange_strong(current, address, std::memory_order_acq_rel)) {
+      current = address;
+    }
+    if (current == address) {
+      site = &call_sites[pos];
+      break;
+    }
+  }
+  site->count.fetch_add(1, std::memory_order_relaxed);
+  site->wait_ns.fetch_add(duration.count(), std::memory_order_relaxed);
+}
+
+double LockProfiler::HistogramStats::percentileUs(double quantile) const {
+  if (!count) {
+    return 0;
+  }
+  const auto rank = static_cast<uint64_t>(quantile * static_cast<double>(count - 1)) + 1;
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i < kBuckets; ++i) {
+    cumulative += buckets[i];
+    if (cumulative >= rank) {
+      return static_cast<double>(uint64_t{1} << i);
+    }
+  }
+  return static_cast<double>(uint64_t{1} << (kBuckets - 1));
+}
+
+LockProfiler::Profile& LockProfiler::profile(std::string_view name) {
+  auto& reg = registry();
+  std::scoped_lock lock(reg.mutex);
+  // Several instances can share the name, e.g. slots of the same structure
+  for (auto& profile : reg.profiles) {
+    if (profile.name == name) {
+      return profile;
+    }
+  }
+  return reg.profiles.emplace_back(name);
+}
+
+std::vector<LockProfiler::LockStats> LockProfiler::stats(size_t max_call_sites) {
+  auto& reg = registry();
+  std::scoped_lock lock(reg.mutex);
+  std::vector<LockStats> ret;
+  ret.reserve(reg.profiles.size());
+  for (const auto& profile : reg.profiles) {
+    auto& stats = ret.emplace_back();
+    stats.name = profile.name;
+    stats.contended = profile.contended.load(std::memory_order_relaxed);
+    stats.wait = histogramStats(profile.wait);
+    stats.hold = histogramStats(profile.hold);
+    for (size_t i = 0; max_call_sites && i <= kMaxCallSites; ++i) {
+      const auto& site = profile.call_sites[i];
+      const auto count = site.count.load(std::memory_order_relaxed);
+      if (!count) {
+        continue;
+      }
+      stats.call_sites.push_back({i == kMaxCallSites ? "unknown" : callSiteLocation(site.address.load()), count,
+                                  std::chrono::nanoseconds(site.wait_ns.load(std::memory_order_relaxed))});
+    }
+    std::sort(stats.call_sites.begin(), stats.call_sites.end(),
+              [](const auto& a, const auto& b) { return a.wait > b.wait; });
+    if (stats.call_sites.size() > max_call_sites) {
+      stats.call_sites.resize(max_call_sites);
+    }
+  }
+  return ret;
+}
+
+}  // namespace taraxa::util
@@ -0,0 +1,127 @@
+#include "common/scheduler.hpp"
+
+#include <algorithm>
+
+#include "common/thread_placement.hpp"
+
+namespace taraxa::util {
+
+const char *toString(TaskClass task_class) {
+  switch (task_class) {
+    case TaskClass::Consensus:
+      return "consensus";
+    case TaskClass::Network:
+      return "network";
+    case TaskClass::Execution:
+      return "execution";
+    case TaskClass::Rpc:
+      return "rpc";
+    case TaskClass::Background:
+      return "background";
+  }
+  return "unknown";
+}
+
+Scheduler::Scheduler(size_t threads, Caps caps) {
+  for (size_t i = 0; i < kTaskClassesCount; ++i) {
+    classes_[i].cap = caps[i];
+  }
+  threads = std::max<size_t>(threads, 1);
+  workers_.reserve(threads);
+  for (size_t i = 0; i < threads; ++i) {
+    workers_.emplace_back([this, i] {
+      placeCurrentThread(thread_group::kScheduler, i);
+      work();
+    });
+  }
+}
+
+Scheduler::~Scheduler() {
+  {
+    std::unique_lock lock(mutex_);
+    stopped_ = true;
+  }
+  cv_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+Scheduler &Scheduler::global() {
+  static Scheduler scheduler;
+  return scheduler;
+}
+
+Scheduler::Caps Scheduler::defaultCaps(size_t threads) {
+  threads = std::max<size_t>(threads, 1);
+  Caps caps{};
+  caps[static_cast<size_t>(TaskClass::Rpc)] = std::max<size_t>(threads / 2, 1);
+  caps[static_cast<size_t>(TaskClass::Background)] = std::max<size_t>(threads / 4, 1);
+  return caps;
+}
+
+std::future<void> Scheduler::post(TaskClass task_class, std::function<void()> task) {
+  std::packaged_task<void()> packaged(std::move(task));
+  auto future = packaged.get_future();
+  {
+    std::unique_lock lock(mutex_);
+    classes_[static_cast<size_t>(task_class)].queue.push_back({std::move(packaged), std::chrono::steady_clock::now()});
+  }
+  cv_.notify_one();
+  return future;
+}
+
+void Scheduler::setCap(TaskClass task_class, size_t cap) {
+  {
+    std::unique_lock lock(mutex_);
+    classes_[static_cast<size_t>(task_class)].cap = cap;
+  }
+  cv_.notify_all();
+}
+
+Scheduler::ClassStats Scheduler::stats(TaskClass task_class) const {
+  std::unique_lock lock(mutex_);
+  const auto &c = classes_[static_cast<size_t>(task_class)];
+  return {c.queue.size(), c.running, c.executed, c.queue_latency_us.percentile(0.5),
+          c.queue_latency_us.percentile(0.99)};
+}
+
+Scheduler::Class *Scheduler::pickClass() {
+  for (auto &c : classes_) {
+    if (!c.queue.empty() && (!c.cap || c.running < c.cap)) {
+      return &c;
+    }
+  }
+  return nullptr;
+}
+
+void Scheduler::work() {
+  std::unique_lock lock(mutex_);
+  while (true) {
+    Class *c = nullptr;
+    cv_.wait(lock, [&] { return stopped_ || (c = pickClass()); });
+    if (stopped_) {
+      // Tasks left in queues are dropped, their futures report broken promise
+      return;
+    }
+    auto task = std::move(c->queue.front());
+    c->queue.pop_front();
+    ++c->running;
+    const auto now = std::chrono::steady_clock::now();
+    c->queue_latency_us.add(std::chrono::duration<double, std::micro>(now - task.posted_at).count());
+    lock.unlock();
+
+    // Exceptions are stored in the future by packaged_task
+    task.task();
+
+    lock.lock();
+    --c->running;
+    ++c->executed;
+    // Class might have been at its cap with more tasks waiting
+    if (!c->queue.empty()) {
+      cv_.notify_one();
+    }
+  }
+}
+
+}  // namespace taraxa::util
@@ -0,0 +1,98 @@
+#include "common/task_graph.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace taraxa::util {
+
+void TaskGraph::add(std::string name, std::vector<std::string> deps, Task task) {
+  std::vector<size_t> dep_indexes;
+  for (const auto& dep : deps) {
+    auto it = std::find_if(nodes_.begin(), nodes_.end(), [&](const Node& n) { return n.name == dep; });
+    if (it == nodes_.end()) {
+      throw std::invalid_argument("Task " + name + " depends on unknown task " + dep);
+    }
+    dep_indexes.push_back(it - nodes_.begin());
+  }
+  for (auto dep : dep_indexes) {
+    nodes_[dep].dependents.push_back(nodes_.size());
+  }
+  nodes_.push_back(Node{std::move(name), std::move(task), {}, dep_indexes.size()});
+}
+
+TaskGraph::Durations TaskGraph::run(size_t threads) {
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<size_t> ready;
+  size_t unfinished = nodes_.size();
+  size_t running = 0;
+  std::exception_ptr error;
+  Durations durations;
+
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    if (nodes_[i].pending_deps == 0) {
+      ready.push_back(i);
+    }
+  }
+
+  const auto worker = [&] {
+    std::unique_lock lock(mutex);
+    while (true) {
+      // Without ready or running tasks nothing can become ready anymore
+      cv.wait(lock, [&] { return !ready.empty() || unfinished == 0 || error || running == 0; });
+      if (ready.empty() || error) {
+        cv.notify_all();
+        return;
+      }
+      const auto index = ready.front();
+      ready.pop_front();
+      ++running;
+      lock.unlock();
+
+      const auto start = std::chrono::steady_clock::now();
+      std::exception_ptr task_error;
+      try {
+        nodes_[index].task();
+      } catch (...) {
+        task_error = std::current_exception();
+      }
+      const auto duration = std::chrono::steady_clock::now() - start;
+
+      lock.lock();
+      --running;
+      --unfinished;
+      if (task_error && !error) {
+        error = task_error;
+      }
+      durations.emplace_back(nodes_[index].name, duration);
+      for (auto dependent : nodes_[index].dependents) {
+        if (--nodes_[dependent].pending_deps == 0) {
+          ready.push_back(dependent);
+        }
+      }
+      cv.notify_all();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < std::max<size_t>(threads, 1); ++i) {
+    workers.emplace_back(worker);
+  }
+  worker();
+  for (auto& t : workers) {
+    t.join();
+  }
+  nodes_.clear();
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return durations;
+}
+
+}  // namespace taraxa::util
@@ -0,0 +1,99 @@
+#include "common/thread_placement.hpp"
+
+#include <pthread.h>
+
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace taraxa::util {
+
+namespace {
+std::shared_mutex placement_mutex;
+ThreadsPlacement threads_placement;
+}  // namespace
+
+std::vector<uint32_t> parseCpuList(const std::string &list) {
+  std::vector<uint32_t> cpus;
+  size_t pos = 0;
+  while (pos < list.size()) {
+    auto end = list.find(',', pos);
+    if (end == std::string::npos) {
+      end = list.size();
+    }
+    const auto range = list.substr(pos, end - pos);
+    const auto dash = range.find('-');
+    try {
+      size_t parsed = 0;
+      const auto first = std::stoul(range.substr(0, dash), &parsed);
+      if (parsed != (dash == std::string::npos ? range.size() : dash)) {
+        throw std::invalid_argument(range);
+      }
+      auto last = first;
+      if (dash != std::string::npos) {
+        last = std::stoul(range.substr(dash + 1), &parsed);
+        if (parsed != range.size() - dash - 1 || last < first) {
+          throw std::invalid_argument(range);
+        }
+      }
+      for (auto cpu = first; cpu <= last; ++cpu) {
+        cpus.push_back(cpu);
+      }
+    } catch (const std::logic_error &) {
+      throw std::invalid_argument("Invalid CPU list: " + list);
+    }
+    pos = end + 1;
+  }
+  if (cpus.empty()) {
+    throw std::invalid_argument("Empty CPU list");
+  }
+  return cpus;
+}
+
+void setThreadsPlacement(ThreadsPlacement placement) {
+  std::unique_lock lock(placement_mutex);
+  threads_placement = std::move(placement);
+}
+
+void placeCurrentThread(const std::string &group, std::optional<size_t> index) {
+  // Linux limits thread names to 15 characters
+  auto name = index ? group + "-" + std::to_string(*index) : group;
+  name.resize(std::min<size_t>(name.size(), 15));
+#if defined(__APPLE__)
+  pthread_setname_np(name.c_str());
+#else
+  pthread_setname_np(pthread_self(), name.c_str());
+#endif
+
+#ifdef __linux__
+  std::vector<uint32_t> cpus;
+  {
+    std::shared_lock lock(placement_mutex);
+    if (const auto it = threads_placement.find(group); it != threads_placement.end()) {
+      cpus = it->second;
+    }
+  }
+  if (cpus.empty()) {
+    return;
+  }
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const auto cpu : cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpu_set);
+    }
+  }
+  if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0) {
+    syscall(SYS_set_mempolicy, MPOL_LOCAL, nullptr, 0);
+  }
+#endif
+}
+
+}  // namespace taraxa::util
@@ -70,6 +70,14 @@ void ThreadPool::post_loop(Periodicity const &periodicity, std::function<void()>
   });
 }
 
+void ThreadPool::post_loop(std::function<uint64_t()> period_ms, std::function<void()> action) {
+  const auto delay_ms = period_ms();
+  post(delay_ms, [this, period_ms = std::move(period_ms), action = std::move(action)]() mutable {
+    action();
+    post_loop(std::move(period_ms), std::move(action));
+  });
+}
+
 ThreadPool::~ThreadPool() { stop(); }
 
 }  // namespace taraxa::util
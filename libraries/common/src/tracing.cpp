@@ -0,0 +1,136 @@
+#include "common/tracing.hpp"
+
+#include <pthread.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace taraxa::util {
+
+namespace {
+
+struct Span {
+  const char* name;
+  Tracer::Clock::time_point start;
+  Tracer::Clock::time_point end;
+};
+
+struct ThreadBuffer {
+  // Only contended while exporting, recording thread is the single writer
+  std::mutex mutex;
+  std::vector<Span> spans;
+  size_t next = 0;
+  uint64_t tid = 0;
+  std::string thread_name;
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  uint64_t next_tid = 1;
+  std::unordered_set<std::string> names;
+  const Tracer::Clock::time_point epoch = Tracer::Clock::now();
+};
+
+// Never destroyed so that spans recorded by threads still running at exit are safe
+Registry& registry() {
+  static auto* registry = new Registry();
+  return *registry;
+}
+
+ThreadBuffer& threadBuffer() {
+  thread_local const std::shared_ptr<ThreadBuffer> buffer = [] {
+    auto buffer = std::make_shared<ThreadBuffer>();
+    char name[64] = {};
+    if (pthread_getname_np(pthread_self(), name, sizeof(name)) == 0) {
+      buffer->thread_name = name;
+    }
+    auto& reg = registry();
+    std::scoped_lock lock(reg.mutex);
+    buffer->tid = reg.next_tid++;
+    reg.buffers.push_back(buffer);
+    return buffer;
+  }();
+  return *buffer;
+}
+
+}  // namespace
+
+void Tracer::start() {
+  auto& reg = registry();
+  {
+    std::scoped_lock lock(reg.mutex);
+    // Buffers of finished threads are owned only by the registry
+    std::erase_if(reg.buffers, [](const auto& buffer) { return buffer.use_count() == 1; });
+    for (auto& buffer : reg.buffers) {
+      std::scoped_lock buffer_lock(buffer->mutex);
+      buffer->spans.clear();
+      buffer->next = 0;
+    }
+  }
+  enabled_ = true;
+}
+
+void Tracer::stop() { enabled_ = false; }
+
+void Tracer::record(const char* name, Clock::time_point start, Clock::time_point end) {
+  auto& buffer = threadBuffer();
+  std::scoped_lock lock(buffer.mutex);
+  if (buffer.spans.size() < kThreadBufferSize) {
+    buffer.spans.push_back({name, start, end});
+  } else {
+    buffer.spans[buffer.next % kThreadBufferSize] = {name, start, end};
+  }
+  buffer.next++;
+}
+
+const char* Tracer::intern(std::string_view name) {
+  auto& reg = registry();
+  std::scoped_lock lock(reg.mutex);
+  return reg.names.emplace(name).first->c_str();
+}
+
+Json::Value Tracer::exportChromeTrace() {
+  auto& reg = registry();
+  const auto to_us = [](Clock::duration d) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()) / 1000;
+  };
+
+  Json::Value events(Json::arrayValue);
+  std::scoped_lock lock(reg.mutex);
+  for (auto& buffer : reg.buffers) {
+    std::scoped_lock buffer_lock(buffer->mutex);
+    if (buffer->spans.empty()) {
+      continue;
+    }
+    if (!buffer->thread_name.empty()) {
+      Json::Value meta(Json::objectValue);
+      meta["name"] = "thread_name";
+      meta["ph"] = "M";
+      meta["pid"] = 1;
+      meta["tid"] = Json::UInt64(buffer->tid);
+      meta["args"]["name"] = buffer->thread_name;
+      events.append(std::move(meta));
+    }
+    for (const auto& span : buffer->spans) {
+      Json::Value event(Json::objectValue);
+      event["name"] = span.name;
+      event["ph"] = "X";
+      event["pid"] = 1;
+      event["tid"] = Json::UInt64(buffer->tid);
+      event["ts"] = to_us(span.start - reg.epoch);
+      event["dur"] = to_us(span.end - span.start);
+      events.append(std::move(event));
+    }
+  }
+
+  Json::Value res(Json::objectValue);
+  res["traceEvents"] = std::move(events);
+  res["displayTimeUnit"] = "ms";
+  return res;
+}
+
+}  // namespace taraxa::util
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/thread_placement.hpp"
 #include "common/vrf_wrapper.hpp"
 #include "config/genesis.hpp"
 #include "config/network.hpp"
@@ -16,6 +17,35 @@ struct DBConfig {
   bool migrate_only = false;
   PbftPeriod rebuild_db_period = 0;
   bool migrate_receipts_by_period = false;
+  // Size of block cache shared by point lookup columns in MB, 0 = rocksdb default cache for every column.
+  // Ignored when db_memory_budget is set, its cache is used by all columns then
+  uint32_t db_point_lookup_cache_size = 0;
+  // Bloom filter bits per key for point lookup and prefixed columns, 0 = no filters
+  uint32_t db_bloom_bits_per_key = 10;
+  // Compress bottommost level of cold columns (period data, receipts, headers) with ZSTD
+  bool db_cold_columns_zstd = false;
+  // Memory budget for block cache and memtables of main DB in MB, 0 = no limit
+  uint32_t db_memory_budget = 0;
+  // Directory on cheaper volume for older data of period data, receipts and headers columns, empty = not used
+  std::string db_cold_path;
+  // Size in MB of every cold column kept on the main volume before older data is moved to db_cold_path
+  uint32_t db_cold_path_hot_size = 1024;
+  // Directory every db snapshot is copied to for off-host backup, only sst files new since previous one are copied
+  std::string db_snapshots_backup_path;
+  // Sync WAL after consensus state writes, concurrent ones share a single sync
+  bool db_sync_consensus_writes = false;
+  // Time in microseconds concurrent consensus writes are gathered for their common WAL sync
+  uint32_t db_group_commit_window = 0;
+  // Keep main DB in memory only, for tests and benchmarks. Its content is lost on restart
+  bool db_in_memory = false;
+  // Directory for files of read only replica. If set, main DB is opened as secondary instance of a node running on the
+  // same data directory and only RPC is served, without networking and consensus. State DB is not opened, so methods
+  // that read accounts, storage or execute calls fail on a replica
+  std::string db_replica_path;
+  // Interval in milliseconds the replica catches up with DB of its primary node
+  uint32_t db_replica_catch_up_interval = 500;
+
+  bool isReplica() const { return !db_replica_path.empty(); }
 };
 void dec_json(Json::Value const &json, DBConfig &db_config);
 
@@ -77,6 +107,20 @@ struct FullNodeConfig {
   uint32_t dag_expiry_limit = kDagExpiryLevelLimit;      // For unit tests only
   uint32_t max_levels_per_period = kMaxLevelsPerPeriod;  // For unit tests only
   uint32_t final_chain_cache_in_blocks = 5;
+  // Number of storage slots and contract codes kept in content addressed state caches, 0 disables the cache
+  uint32_t final_chain_storage_cache_size = 100000;
+  uint32_t final_chain_code_cache_size = 1000;
+  // Number of recently finalized transactions whose locations are kept in memory, 0 disables the cache
+  uint32_t final_chain_trx_location_cache_size = 100000;
+  // Notify subscribers about finalized period on a separate thread so that execution of the next period is not blocked
+  // by them. Period is always synced to disk before its state is committed
+  bool final_chain_pipelined_commit = false;
+  // Read accounts and codes touched by queued periods ahead of their execution to warm state db
+  bool final_chain_prefetch_state = false;
+  // Maintain address/topic0 logs index so eth_getLogs for specific addresses doesn't need to scan blooms
+  bool final_chain_logs_index = false;
+  // Shorten filter step wait for proposals to measured proposal vote arrival time, bounded by <lambda / 2, 2 * lambda>
+  bool adaptive_step_timing = false;
   uint64_t propose_dag_gas_limit = 0x1E0A6E0;
   uint64_t propose_pbft_gas_limit = 0x12C684C0;
 
@@ -89,6 +133,12 @@ struct FullNodeConfig {
   // Report malicious behaviour like double voting, etc... to slashing/jailing contract
   bool report_malicious_behaviour = false;
 
+  // CPU sets that named thread groups (pbft, final_chain, packets, scheduler) are pinned to
+  util::ThreadsPlacement threads_placement;
+
+  // Record wait and hold times of major named locks, exported as metrics and by debug_lockStats
+  bool lock_profiling = false;
+
   auto net_file_path() const { return data_path / "net"; }
 
   /**
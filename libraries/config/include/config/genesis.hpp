@@ -20,6 +20,22 @@ struct GasPriceConfig {
 Json::Value enc_json(GasPriceConfig const& obj);
 void dec_json(Json::Value const& json, GasPriceConfig& obj);
 
+/**
+ * @brief Hardfork dependent rules of a single block, resolved once instead of evaluating hardforks on every use
+ */
+struct HardforkRules {
+  uint64_t block_number = 0;
+  bool magnolia = false;
+  bool aspen_part_one = false;
+  bool aspen_part_two = false;
+  bool ficus = false;
+  bool cornus = false;
+  bool cacti = false;
+  uint32_t rewards_distribution_frequency = 1;
+  uint64_t dag_gas_limit = 0;
+  uint64_t pbft_gas_limit = 0;
+};
+
 struct GenesisConfig {
   uint64_t chain_id = 0;
   DagBlock dag_genesis_block;
@@ -35,6 +51,7 @@ struct GenesisConfig {
   blk_hash_t genesisHash() const;
   uint32_t calcBlocksPerYear(uint32_t lambda_ms, uint32_t delay_ms) const;
   std::pair<uint64_t, uint64_t> getGasLimits(uint64_t block_number) const;
+  HardforkRules getHardforkRules(uint64_t block_number) const;
 };
 
 Json::Value enc_json(GenesisConfig const& obj);
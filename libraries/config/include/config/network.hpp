@@ -2,6 +2,7 @@
 
 #include <json/json.h>
 
+#include <map>
 #include <string>
 
 #include "common/types.hpp"
@@ -12,9 +13,80 @@ namespace taraxa {
 struct PrometheusConfig {
   std::string address;
   uint16_t listen_port = 0;
-  uint16_t polling_interval_ms = 1000;
 };
 
+// What websocket session does with a new message when its write queue is full
+enum class WsQueueOverflowPolicy {
+  // Oldest queued message is dropped
+  DropOldest,
+  // Queued message of the same subscription is replaced by the new one, oldest message is dropped otherwise
+  Coalesce,
+  // Session is disconnected
+  Disconnect,
+};
+
+struct WsWriteQueueConfig {
+  // Maximal number of messages queued per websocket session
+  uint32_t limit{1024};
+  WsQueueOverflowPolicy overflow_policy{WsQueueOverflowPolicy::DropOldest};
+};
+
+void dec_json(const Json::Value &json, WsWriteQueueConfig &config);
+
+// permessage-deflate extension offered to websocket clients
+struct WsCompressionConfig {
+  bool enabled{true};
+  // Size of the LZ77 window, values above 14 crash indexers connected to the node
+  uint8_t max_window_bits{14};
+  // zlib compression level, 0 = no compression, 9 = best compression
+  uint8_t level{8};
+  // Messages smaller than this are not compressed, compression of short notifications costs more than it saves
+  uint32_t min_message_size{0};
+};
+
+void dec_json(const Json::Value &json, WsCompressionConfig &config);
+
+// Coalescing of pending transactions hashes sent to batched newPendingTransactions subscriptions
+struct WsTransactionsBatchConfig {
+  // Maximal time a hash waits for other hashes, 0 = every hash is sent in its own batch
+  uint32_t interval_ms{50};
+  // Maximal number of hashes in a single batch, full batch is sent right away
+  uint32_t max_size{1000};
+};
+
+void dec_json(const Json::Value &json, WsTransactionsBatchConfig &config);
+
+struct HttpKeepAliveConfig {
+  // How long is idle http connection kept open waiting for the next request, 0 = connection is closed after each
+  // request
+  uint32_t idle_timeout_ms{5000};
+  // Maximal number of requests served by single http connection, 0 = unlimited
+  uint32_t max_requests{1000};
+};
+
+void dec_json(const Json::Value &json, HttpKeepAliveConfig &config);
+
+struct JsonRpcBatchConfig {
+  // Maximal number of requests in single json-rpc batch, 0 = unlimited
+  uint32_t max_size{0};
+  // Deadline for processing of the whole json-rpc batch, requests not processed in time return error, 0 = unlimited
+  uint32_t deadline_ms{0};
+};
+
+void dec_json(const Json::Value &json, JsonRpcBatchConfig &config);
+
+// Offloading of expensive json-rpc methods from the rpc threads, so slow calls don't block cheap ones
+struct JsonRpcDispatchConfig {
+  // Number of threads processing expensive methods, 0 = all methods are processed on the rpc threads
+  uint32_t threads{0};
+  // Maximal number of expensive requests waiting for a thread, further requests are rejected, 0 = unlimited
+  uint32_t max_pending{0};
+  // Expensive methods mapped to max number of their concurrently processed requests (0 = unlimited), empty = defaults
+  std::map<std::string, uint32_t> expensive_methods;
+};
+
+void dec_json(const Json::Value &json, JsonRpcDispatchConfig &config);
+
 struct ConnectionConfig {
   std::optional<uint16_t> http_port;
   std::optional<uint16_t> ws_port;
@@ -23,6 +95,48 @@ struct ConnectionConfig {
   // Number of threads dedicated to the rpc calls processing, default = 5
   uint16_t threads_num{2};
 
+  // Number of threads scanning eth_getLogs ranges in parallel, 0 = logs are scanned on the rpc thread
+  uint16_t logs_query_threads_num{0};
+  // Maximal number of blocks in eth_getLogs range, 0 = unlimited
+  uint64_t logs_max_block_range{0};
+  // Maximal number of logs returned by eth_getLogs, 0 = unlimited
+  uint64_t logs_max_results{0};
+  // Number of threads running eth_estimateGas dry runs, 0 = estimations are processed on the rpc thread
+  uint16_t estimate_gas_threads_num{0};
+  // Number of threads running debug and trace replays, 0 = traces are processed on the rpc thread
+  uint16_t trace_threads_num{0};
+  // Maximal time of a single trace request in ms, 0 = unlimited
+  uint64_t trace_timeout_ms{0};
+  // Maximal gas of transactions traced by a single request, 0 = unlimited
+  uint64_t trace_gas_budget{0};
+
+  // Outbound messages queue of each websocket session
+  WsWriteQueueConfig ws_write_queue;
+
+  // Compression of websocket messages
+  WsCompressionConfig ws_compression;
+
+  // Batching of pending transactions notifications
+  WsTransactionsBatchConfig ws_transactions_batch;
+
+  // Reuse of http connections for multiple requests
+  HttpKeepAliveConfig http_keep_alive;
+
+  // Processing of json-rpc batch requests, which are split across rpc threads
+  JsonRpcBatchConfig batch;
+
+  // Dispatch of expensive json-rpc methods to dedicated threads
+  JsonRpcDispatchConfig dispatch;
+
+  // Maximal estimated cost of a graphql query (fields resolved over all returned objects), 0 = unlimited
+  uint64_t max_query_cost{0};
+
+  // Number of parsed and validated graphql queries kept for repeated and persisted queries, 0 = disabled
+  uint64_t query_cache_size{0};
+
+  // Memory budget in bytes for cached responses with finalized blocks, transactions and receipts, 0 = disabled
+  uint64_t response_cache_size{0};
+
   void validate() const;
 };
 
@@ -35,6 +149,10 @@ struct NodeConfig {
 };
 
 struct DdosProtectionConfig {
+  // Votes of accepted future periods, the current and the previous period have to fit into the fixed ring of verified
+  // votes periods (VerifiedVotes::kPeriodsRingSize)
+  static constexpr PbftPeriod kMaxVoteAcceptingPeriods = 13;
+
   // How many periods(of votes) into the future compared to the current state we accept
   PbftPeriod vote_accepting_periods{5};
   // How many rounds(of votes) into the future compared to the current state we accept
@@ -63,6 +181,45 @@ struct DdosProtectionConfig {
   void validate(uint32_t delegation_delay) const;
 };
 
+// Upload budget for serving sync packets to other peers, consensus packets are never throttled
+struct SyncUploadConfig {
+  // Max bytes per second of sync packets sent to single peer, 0 = unlimited
+  uint64_t peer_bytes_per_second{0};
+  // Max bytes per second of sync packets sent to all peers together, 0 = unlimited
+  uint64_t total_bytes_per_second{0};
+  // Bytes that can be sent at once above the rate, 0 = one second of the rate
+  uint64_t burst_bytes{0};
+};
+
+void dec_json(const Json::Value &json, SyncUploadConfig &config);
+
+// Follower node only executes finalized period data synced from trusted upstream nodes. It does not take part in
+// consensus, received votes, dag blocks and transactions are dropped
+struct FollowerConfig {
+  // Node ids of upstream nodes, period data is synced only from them. They should be listed in boot_nodes as well
+  std::unordered_set<dev::p2p::NodeID> upstream_nodes;
+  // Signatures and vrf proofs of cert votes synced from upstream nodes are not verified, only their weights are
+  // calculated
+  bool trust_upstream_votes = false;
+};
+
+void dec_json(const Json::Value &json, FollowerConfig &config);
+
+// Number of active packets processing workers is adjusted between min_threads and max_threads by the average time
+// packets waited in the queue and by cpu idle time
+struct PacketsProcessingScalingConfig {
+  uint16_t min_threads = 3;
+  uint16_t max_threads = 14;
+  uint32_t interval_ms = 1000;
+  // Workers are added while average queue wait is above grow_wait_ms and removed while it is below shrink_wait_ms
+  uint32_t grow_wait_ms = 50;
+  uint32_t shrink_wait_ms = 5;
+
+  void validate() const;
+};
+
+void dec_json(const Json::Value &json, PacketsProcessingScalingConfig &config);
+
 struct NetworkConfig {
   static constexpr uint16_t kBlacklistTimeoutDefaultInSeconds = 600;
 
@@ -74,14 +231,42 @@ struct NetworkConfig {
   uint16_t ideal_peer_count = 10;
   uint16_t max_peer_count = 50;
   uint16_t transaction_interval_ms = 100;
+  // Send transactions bodies only to sqrt(peers) and announce hashes to the rest, announced bodies are fetched on
+  // demand. All nodes of the network have to run a version that supports GetTransactionsPacket
+  bool transactions_announce_mode = false;
+  // Gossip dag blocks without transactions bodies, receiver requests the ones missing in its pool with
+  // GetDagBlockTransactionsPacket. All nodes of the network have to run a version that supports it
+  bool dag_block_compact_relay = false;
+  // Interval of transactions pool reconciliation with each peer, peers exchange sketches of their pools and transfer
+  // only the transactions missing on the other side. Only peers of the latest network version take part. 0 = disabled
+  uint32_t transactions_reconciliation_interval_ms = 0;
   uint16_t sync_level_size = 10;
+  // Max number of peers that pbft sync windows of sync_level_size periods are requested from concurrently
+  uint16_t sync_max_peers = 4;
+  // Approximate memory budget of synced period data waiting for execution, new sync windows are not requested while it
+  // is exceeded. 0 = unlimited
+  uint32_t sync_queue_max_mb = 512;
+  // Memory used to track transactions known to a single peer and false positive rate of the tracking in parts per
+  // million. False positive means that transaction is not sent to a peer that does not have it yet
+  uint32_t peer_known_transactions_kb = 1024;
+  uint32_t peer_known_transactions_fp_ppm = 100;
+  // Emulated link to every peer for experiments on local networks: one way latency in ms and egress bandwidth in KB/s,
+  // 0 = disabled
+  uint32_t emulated_latency_ms = 0;
+  uint32_t emulated_bandwidth_kbps = 0;
+  // File all incoming tarcap packets are recorded to for offline replay by taraxa-replay, empty = disabled
+  std::string packets_capture_path;
   uint16_t num_threads = std::max(uint(1), uint(std::thread::hardware_concurrency() / 2));
   uint16_t packets_processing_threads = 14;
+  // Adaptive number of packets processing workers, packets_processing_threads is used as the initial number
+  std::optional<PacketsProcessingScalingConfig> packets_processing_scaling;
   uint16_t peer_blacklist_timeout = kBlacklistTimeoutDefaultInSeconds;
   bool disable_peer_blacklist = false;
   uint16_t deep_syncing_threshold = 10;
   DdosProtectionConfig ddos_protection;
+  SyncUploadConfig sync_upload;
   std::unordered_set<dev::p2p::NodeID> trusted_nodes;
+  std::optional<FollowerConfig> follower;
 
   std::optional<ConnectionConfig> rpc;
   std::optional<ConnectionConfig> graphql;
@@ -2,6 +2,7 @@
 
 #include <json/json.h>
 
+#include <algorithm>
 #include <fstream>
 
 #include "common/config_exception.hpp"
@@ -15,6 +16,26 @@ void dec_json(Json::Value const &json, DBConfig &db_config) {
 
   db_config.db_max_snapshots = getConfigDataAsUInt(json, {"db_max_snapshots"}, true, db_config.db_max_snapshots);
   db_config.db_max_open_files = getConfigDataAsUInt(json, {"db_max_open_files"}, true, db_config.db_max_open_files);
+  db_config.db_point_lookup_cache_size =
+      getConfigDataAsUInt(json, {"db_point_lookup_cache_size"}, true, db_config.db_point_lookup_cache_size);
+  db_config.db_bloom_bits_per_key =
+      getConfigDataAsUInt(json, {"db_bloom_bits_per_key"}, true, db_config.db_bloom_bits_per_key);
+  db_config.db_cold_columns_zstd =
+      getConfigDataAsBoolean(json, {"db_cold_columns_zstd"}, true, db_config.db_cold_columns_zstd);
+  db_config.db_memory_budget = getConfigDataAsUInt(json, {"db_memory_budget"}, true, db_config.db_memory_budget);
+  db_config.db_cold_path = getConfigDataAsString(json, {"db_cold_path"}, true, db_config.db_cold_path);
+  db_config.db_cold_path_hot_size =
+      getConfigDataAsUInt(json, {"db_cold_path_hot_size"}, true, db_config.db_cold_path_hot_size);
+  db_config.db_snapshots_backup_path =
+      getConfigDataAsString(json, {"db_snapshots_backup_path"}, true, db_config.db_snapshots_backup_path);
+  db_config.db_sync_consensus_writes =
+      getConfigDataAsBoolean(json, {"db_sync_consensus_writes"}, true, db_config.db_sync_consensus_writes);
+  db_config.db_group_commit_window =
+      getConfigDataAsUInt(json, {"db_group_commit_window"}, true, db_config.db_group_commit_window);
+  db_config.db_in_memory = getConfigDataAsBoolean(json, {"db_in_memory"}, true, db_config.db_in_memory);
+  db_config.db_replica_path = getConfigDataAsString(json, {"db_replica_path"}, true, db_config.db_replica_path);
+  db_config.db_replica_catch_up_interval =
+      getConfigDataAsUInt(json, {"db_replica_catch_up_interval"}, true, db_config.db_replica_catch_up_interval);
 }
 
 std::vector<logger::Config> FullNodeConfig::loadLoggingConfigs(const Json::Value &logging) {
@@ -44,11 +65,20 @@ std::vector<logger::Config> FullNodeConfig::loadLoggingConfigs(const Json::Value
             channel.second = logger::stringToVerbosity(getConfigDataAsString(ch, {"verbosity"}));
           }
           logging.channels[channel.first] = channel.second;
+          if (auto rate_limit = getConfigDataAsUInt(ch, {"rate_limit"}, true, 0); rate_limit) {
+            logging.channel_rate_limits[channel.first] = rate_limit;
+          }
         }
         for (auto &o : item["outputs"]) {
           logger::Config::OutputConfig output;
           output.type = getConfigDataAsString(o, {"type"});
           output.format = getConfigDataAsString(o, {"format"});
+          output.async = getConfigDataAsBoolean(o, {"async"}, true, output.async);
+          if (const auto overflow = getConfigDataAsString(o, {"overflow"}, true, "drop"); overflow == "block") {
+            output.drop_on_overflow = false;
+          } else if (overflow != "drop") {
+            throw ConfigException("Unknown logging output overflow policy: " + overflow);
+          }
           if (output.type == "file") {
             output.target = log_path;
             output.file_name = (log_path / getConfigDataAsString(o, {"file_name"})).string();
@@ -72,6 +102,18 @@ void FullNodeConfig::overwriteConfigFromJson(const Json::Value &root) {
 
   final_chain_cache_in_blocks =
       getConfigDataAsUInt(root, {"final_chain_cache_in_blocks"}, true, final_chain_cache_in_blocks);
+  final_chain_storage_cache_size =
+      getConfigDataAsUInt(root, {"final_chain_storage_cache_size"}, true, final_chain_storage_cache_size);
+  final_chain_code_cache_size =
+      getConfigDataAsUInt(root, {"final_chain_code_cache_size"}, true, final_chain_code_cache_size);
+  final_chain_trx_location_cache_size = getConfigDataAsUInt(root, {"final_chain_trx_location_cache_size"}, true,
+                                                            final_chain_trx_location_cache_size);
+  final_chain_pipelined_commit =
+      getConfigDataAsBoolean(root, {"final_chain_pipelined_commit"}, true, final_chain_pipelined_commit);
+  final_chain_logs_index = getConfigDataAsBoolean(root, {"final_chain_logs_index"}, true, final_chain_logs_index);
+  adaptive_step_timing = getConfigDataAsBoolean(root, {"adaptive_step_timing"}, true, adaptive_step_timing);
+  final_chain_prefetch_state =
+      getConfigDataAsBoolean(root, {"final_chain_prefetch_state"}, true, final_chain_prefetch_state);
 
   // config values that limits transactions and blocks memory pools
   transactions_pool_size = getConfigDataAsUInt(root, {"transactions_pool_size"}, true, kDefaultTransactionPoolSize);
@@ -86,6 +128,18 @@ void FullNodeConfig::overwriteConfigFromJson(const Json::Value &root) {
 
   report_malicious_behaviour =
       getConfigDataAsUInt(root, {"report_malicious_behaviour"}, true, report_malicious_behaviour);
+
+  if (const auto &placement = root["threads_placement"]; placement.isObject()) {
+    for (const auto &group : placement.getMemberNames()) {
+      try {
+        threads_placement[group] = util::parseCpuList(placement[group].asString());
+      } catch (const std::invalid_argument &e) {
+        throw ConfigException("threads_placement." + group + ": " + e.what());
+      }
+    }
+  }
+
+  lock_profiling = getConfigDataAsBoolean(root, {"lock_profiling"}, true, lock_profiling);
 }
 
 FullNodeConfig::FullNodeConfig(const Json::Value &string_or_object, const std::vector<Json::Value> &wallets_jsons,
@@ -183,6 +237,21 @@ void FullNodeConfig::validate() const {
     throw ConfigException("transactions_pool_size cannot be smaller than " + std::to_string(kMinTransactionPoolSize));
   }
 
+  for (const auto &[group, _] : threads_placement) {
+    if (std::find(util::thread_group::kAll.begin(), util::thread_group::kAll.end(), group) ==
+        util::thread_group::kAll.end()) {
+      throw ConfigException("Unknown threads_placement group: " + group);
+    }
+  }
+
+  if (db_config.isReplica() && db_config.db_in_memory) {
+    throw ConfigException("db_replica_path can't be used with db_in_memory");
+  }
+  // GraphQL resolvers depend on dag and pbft managers, which are not created for a replica
+  if (db_config.isReplica() && network.graphql) {
+    throw ConfigException("GraphQL is not available on a read-only replica, remove network.graphql from config");
+  }
+
   // TODO: add validation of other config values
 }
 
@@ -214,13 +283,29 @@ std::ostream &operator<<(std::ostream &strm, const NetworkConfig &conf) {
   strm << "  public_ip: " << conf.public_ip << std::endl;
   strm << "  listen_port: " << conf.listen_port << std::endl;
   strm << "  transaction_interval_ms: " << conf.transaction_interval_ms << std::endl;
+  strm << "  transactions_announce_mode: " << conf.transactions_announce_mode << std::endl;
+  strm << "  dag_block_compact_relay: " << conf.dag_block_compact_relay << std::endl;
+  strm << "  transactions_reconciliation_interval_ms: " << conf.transactions_reconciliation_interval_ms << std::endl;
   strm << "  ideal_peer_count: " << conf.ideal_peer_count << std::endl;
   strm << "  max_peer_count: " << conf.max_peer_count << std::endl;
   strm << "  sync_level_size: " << conf.sync_level_size << std::endl;
+  strm << "  sync_queue_max_mb: " << conf.sync_queue_max_mb << std::endl;
+  strm << "  peer_known_transactions_kb: " << conf.peer_known_transactions_kb
+       << ", peer_known_transactions_fp_ppm: " << conf.peer_known_transactions_fp_ppm << std::endl;
   strm << "  num_threads: " << conf.num_threads << std::endl;
   strm << "  packets_processing_threads: " << conf.packets_processing_threads << std::endl;
+  if (conf.packets_processing_scaling) {
+    strm << "  packets_processing_scaling: min_threads: " << conf.packets_processing_scaling->min_threads
+         << ", max_threads: " << conf.packets_processing_scaling->max_threads
+         << ", interval_ms: " << conf.packets_processing_scaling->interval_ms
+         << ", grow_wait_ms: " << conf.packets_processing_scaling->grow_wait_ms
+         << ", shrink_wait_ms: " << conf.packets_processing_scaling->shrink_wait_ms << std::endl;
+  }
   strm << "  deep_syncing_threshold: " << conf.deep_syncing_threshold << std::endl;
   strm << conf.ddos_protection << std::endl;
+  strm << "  sync_upload: peer_bytes_per_second: " << conf.sync_upload.peer_bytes_per_second
+       << ", total_bytes_per_second: " << conf.sync_upload.total_bytes_per_second
+       << ", burst_bytes: " << conf.sync_upload.burst_bytes << std::endl;
 
   strm << "  --> boot nodes  ... " << std::endl;
   for (const auto &c : conf.boot_nodes) {
@@ -138,4 +138,21 @@ std::pair<uint64_t, uint64_t> GenesisConfig::getGasLimits(uint64_t block_number)
   return {dag.gas_limit, pbft.gas_limit};
 }
 
+HardforkRules GenesisConfig::getHardforkRules(uint64_t block_number) const {
+  const auto& hardforks = state.hardforks;
+  HardforkRules rules;
+  rules.block_number = block_number;
+  rules.magnolia = block_number >= hardforks.magnolia_hf.block_num;
+  rules.aspen_part_one = hardforks.isAspenHardforkPartOne(block_number);
+  rules.aspen_part_two = block_number >= hardforks.aspen_hf.block_num_part_two;
+  rules.ficus = hardforks.ficus_hf.isFicusHardfork(block_number);
+  rules.cornus = hardforks.isOnCornusHardfork(block_number);
+  rules.cacti = hardforks.isOnCactiHardfork(block_number);
+  rules.rewards_distribution_frequency = hardforks.getRewardsDistributionFrequency(block_number);
+  const auto [dag_gas_limit, pbft_gas_limit] = getGasLimits(block_number);
+  rules.dag_gas_limit = dag_gas_limit;
+  rules.pbft_gas_limit = pbft_gas_limit;
+  return rules;
+}
+
 }  // namespace taraxa
@@ -7,7 +7,102 @@ namespace taraxa {
 
 void dec_json(const Json::Value &json, PrometheusConfig &config) {
   config.listen_port = getConfigData(json, {"listen_port"}).asUInt();
-  config.polling_interval_ms = getConfigData(json, {"polling_interval_ms"}).asUInt();
+}
+
+void dec_json(const Json::Value &json, WsWriteQueueConfig &config) {
+  config.limit = getConfigDataAsUInt(json, {"limit"}, true, config.limit);
+
+  const auto policy = getConfigDataAsString(json, {"overflow_policy"}, true, "drop_oldest");
+  if (policy == "drop_oldest") {
+    config.overflow_policy = WsQueueOverflowPolicy::DropOldest;
+  } else if (policy == "coalesce") {
+    config.overflow_policy = WsQueueOverflowPolicy::Coalesce;
+  } else if (policy == "disconnect") {
+    config.overflow_policy = WsQueueOverflowPolicy::Disconnect;
+  } else {
+    throw ConfigException("Unknown ws_write_queue.overflow_policy: " + policy +
+                          ", expected one of drop_oldest, coalesce, disconnect");
+  }
+}
+
+void dec_json(const Json::Value &json, WsCompressionConfig &config) {
+  config.enabled = getConfigDataAsBoolean(json, {"enabled"}, true, config.enabled);
+  config.max_window_bits = getConfigDataAsUInt(json, {"max_window_bits"}, true, config.max_window_bits);
+  config.level = getConfigDataAsUInt(json, {"level"}, true, config.level);
+  config.min_message_size = getConfigDataAsUInt(json, {"min_message_size"}, true, config.min_message_size);
+}
+
+void dec_json(const Json::Value &json, WsTransactionsBatchConfig &config) {
+  config.interval_ms = getConfigDataAsUInt(json, {"interval_ms"}, true, config.interval_ms);
+  config.max_size = getConfigDataAsUInt(json, {"max_size"}, true, config.max_size);
+}
+
+void dec_json(const Json::Value &json, HttpKeepAliveConfig &config) {
+  config.idle_timeout_ms = getConfigDataAsUInt(json, {"idle_timeout_ms"}, true, config.idle_timeout_ms);
+  config.max_requests = getConfigDataAsUInt(json, {"max_requests"}, true, config.max_requests);
+}
+
+void dec_json(const Json::Value &json, JsonRpcBatchConfig &config) {
+  config.max_size = getConfigDataAsUInt(json, {"max_size"}, true, config.max_size);
+  config.deadline_ms = getConfigDataAsUInt(json, {"deadline_ms"}, true, config.deadline_ms);
+}
+
+void dec_json(const Json::Value &json, JsonRpcDispatchConfig &config) {
+  config.threads = getConfigDataAsUInt(json, {"threads"}, true, config.threads);
+  config.max_pending = getConfigDataAsUInt(json, {"max_pending"}, true, config.max_pending);
+  if (auto methods = getConfigData(json, {"expensive_methods"}, true); !methods.isNull()) {
+    if (!methods.isObject()) {
+      throw ConfigException("dispatch.expensive_methods must be an object of method names and concurrency limits");
+    }
+    for (const auto &method : methods.getMemberNames()) {
+      config.expensive_methods[method] = getConfigDataAsUInt(methods, {method});
+    }
+  }
+}
+
+void dec_json(const Json::Value &json, SyncUploadConfig &config) {
+  config.peer_bytes_per_second = getConfigDataAsUInt(json, {"peer_bytes_per_second"}, true, 0);
+  config.total_bytes_per_second = getConfigDataAsUInt(json, {"total_bytes_per_second"}, true, 0);
+  config.burst_bytes = getConfigDataAsUInt(json, {"burst_bytes"}, true, 0);
+}
+
+void dec_json(const Json::Value &json, FollowerConfig &config) {
+  for (const auto &item : getConfigData(json, {"upstream_nodes"})) {
+    config.upstream_nodes.insert(dev::p2p::NodeID(item.asString()));
+  }
+  config.trust_upstream_votes = getConfigDataAsBoolean(json, {"trust_upstream_votes"}, true, false);
+}
+
+void PacketsProcessingScalingConfig::validate() const {
+  // Same limits as for packets_processing_threads
+  constexpr uint16_t kMaxPacketsProcessingThreadsNum = 30;
+  if (min_threads < 3 || max_threads > kMaxPacketsProcessingThreadsNum || min_threads > max_threads) {
+    throw ConfigException(std::string("network.packets_processing_scaling threads must be in range [3, ") +
+                          std::to_string(kMaxPacketsProcessingThreadsNum) + "] and min_threads <= max_threads");
+  }
+
+  if (interval_ms == 0) {
+    throw ConfigException(std::string("network.packets_processing_scaling.interval_ms must be greater than zero"));
+  }
+
+  if (shrink_wait_ms >= grow_wait_ms) {
+    throw ConfigException(
+        std::string("network.packets_processing_scaling.shrink_wait_ms must be lower than grow_wait_ms"));
+  }
+}
+
+void dec_json(const Json::Value &json, PacketsProcessingScalingConfig &config) {
+  config.min_threads = getConfigDataAsUInt(json, {"min_threads"}, true, config.min_threads);
+  config.max_threads = getConfigDataAsUInt(json, {"max_threads"}, true, config.max_threads);
+  config.interval_ms = getConfigDataAsUInt(json, {"interval_ms"}, true, config.interval_ms);
+  config.grow_wait_ms = getConfigDataAsUInt(json, {"grow_wait_ms"}, true, config.grow_wait_ms);
+  config.shrink_wait_ms = getConfigDataAsUInt(json, {"shrink_wait_ms"}, true, config.shrink_wait_ms);
+
+  // Same as for packets_processing_threads, concurrency is limited to hardware concurrency
+  if (config.max_threads > std::thread::hardware_concurrency()) {
+    config.max_threads = std::max(std::thread::hardware_concurrency(), 3u);
+    config.min_threads = std::min(config.min_threads, config.max_threads);
+  }
 }
 
 void ConnectionConfig::validate() const {
@@ -20,6 +115,20 @@ void ConnectionConfig::validate() const {
   if (threads_num <= 0 || threads_num > MAX_RPC_THREADS_NUM) {
     throw ConfigException(std::string("threads_num must be in range (0, ") + std::to_string(MAX_RPC_THREADS_NUM) + "]");
   }
+
+  if (ws_write_queue.limit == 0) {
+    throw ConfigException("ws_write_queue.limit must be greater than 0");
+  }
+
+  if (ws_compression.max_window_bits < 9 || ws_compression.max_window_bits > 14) {
+    throw ConfigException("ws_compression.max_window_bits must be in range [9, 14]");
+  }
+  if (ws_compression.level > 9) {
+    throw ConfigException("ws_compression.level must be in range [0, 9]");
+  }
+  if (ws_transactions_batch.max_size == 0) {
+    throw ConfigException("ws_transactions_batch.max_size must be greater than 0");
+  }
 }
 
 void dec_json(const Json::Value &json, ConnectionConfig &config) {
@@ -37,9 +146,50 @@ void dec_json(const Json::Value &json, ConnectionConfig &config) {
   if (auto threads_num = getConfigData(json, {"threads_num"}, true); !threads_num.isNull()) {
     config.threads_num = threads_num.asUInt();
   }
+
+  config.logs_query_threads_num = getConfigDataAsUInt(json, {"logs_query_threads_num"}, true, 0);
+  config.logs_max_block_range = getConfigDataAsUInt(json, {"logs_max_block_range"}, true, 0);
+  config.logs_max_results = getConfigDataAsUInt(json, {"logs_max_results"}, true, 0);
+  config.estimate_gas_threads_num = getConfigDataAsUInt(json, {"estimate_gas_threads_num"}, true, 0);
+  config.trace_threads_num = getConfigDataAsUInt(json, {"trace_threads_num"}, true, 0);
+  config.trace_timeout_ms = getConfigDataAsUInt(json, {"trace_timeout_ms"}, true, 0);
+  config.trace_gas_budget = getConfigDataAsUInt(json, {"trace_gas_budget"}, true, 0);
+  config.response_cache_size = getConfigDataAsUInt(json, {"response_cache_size"}, true, 0);
+  config.max_query_cost = getConfigDataAsUInt(json, {"max_query_cost"}, true, 0);
+  config.query_cache_size = getConfigDataAsUInt(json, {"query_cache_size"}, true, 0);
+
+  if (auto ws_write_queue = getConfigData(json, {"ws_write_queue"}, true); !ws_write_queue.isNull()) {
+    dec_json(ws_write_queue, config.ws_write_queue);
+  }
+
+  if (auto ws_compression = getConfigData(json, {"ws_compression"}, true); !ws_compression.isNull()) {
+    dec_json(ws_compression, config.ws_compression);
+  }
+
+  if (auto batch = getConfigData(json, {"ws_transactions_batch"}, true); !batch.isNull()) {
+    dec_json(batch, config.ws_transactions_batch);
+  }
+
+  if (auto http_keep_alive = getConfigData(json, {"http_keep_alive"}, true); !http_keep_alive.isNull()) {
+    dec_json(http_keep_alive, config.http_keep_alive);
+  }
+
+  if (auto batch = getConfigData(json, {"batch"}, true); !batch.isNull()) {
+    dec_json(batch, config.batch);
+  }
+
+  if (auto dispatch = getConfigData(json, {"dispatch"}, true); !dispatch.isNull()) {
+    dec_json(dispatch, config.dispatch);
+  }
 }
 
 void DdosProtectionConfig::validate(uint32_t delegation_delay) const {
+  if (vote_accepting_periods == 0 || vote_accepting_periods > kMaxVoteAcceptingPeriods) {
+    throw ConfigException(std::string("network.ddos_protection.vote_accepting_periods(" +
+                                      std::to_string(vote_accepting_periods) + ") must be in range <1, " +
+                                      std::to_string(kMaxVoteAcceptingPeriods) + ">"));
+  }
+
   if (vote_accepting_periods > delegation_delay) {
     throw ConfigException(std::string("network.ddos_protection.vote_accepting_periods(" +
                                       std::to_string(vote_accepting_periods) + ") must be <= DPOS.delegation_delay(" +
@@ -91,6 +241,18 @@ void NetworkConfig::validate(uint32_t delegation_delay) const {
     throw ConfigException(std::string("network.sync_level_size cannot be 0"));
   }
 
+  if (sync_max_peers == 0) {
+    throw ConfigException(std::string("network.sync_max_peers cannot be 0"));
+  }
+
+  if (peer_known_transactions_kb == 0) {
+    throw ConfigException(std::string("network.peer_known_transactions_kb cannot be 0"));
+  }
+
+  if (peer_known_transactions_fp_ppm == 0 || peer_known_transactions_fp_ppm > 100000) {
+    throw ConfigException(std::string("network.peer_known_transactions_fp_ppm must be in range [1, 100000]"));
+  }
+
   // Max enabled number of threads for processing rpc requests
   constexpr uint16_t MAX_PACKETS_PROCESSING_THREADS_NUM = 30;
   if (packets_processing_threads < 3 || packets_processing_threads > MAX_PACKETS_PROCESSING_THREADS_NUM) {
@@ -98,10 +260,18 @@ void NetworkConfig::validate(uint32_t delegation_delay) const {
                           std::to_string(MAX_PACKETS_PROCESSING_THREADS_NUM) + "]");
   }
 
+  if (packets_processing_scaling) {
+    packets_processing_scaling->validate();
+  }
+
   if (transaction_interval_ms == 0) {
     throw ConfigException(std::string("network.transaction_interval_ms must be greater than zero"));
   }
 
+  if (follower && follower->upstream_nodes.empty()) {
+    throw ConfigException(std::string("network.follower.upstream_nodes cannot be empty"));
+  }
+
   // TODO validate that the boot node list doesn't contain self (although it's not critical)
   for (const auto &node : boot_nodes) {
     if (node.ip.empty()) {
@@ -126,6 +296,10 @@ void dec_json(const Json::Value &json, NetworkConfig &network) {
   network.public_ip = getConfigDataAsString(json, {"public_ip"}, true);
   network.listen_port = getConfigDataAsUInt(json, {"listen_port"});
   network.transaction_interval_ms = getConfigDataAsUInt(json, {"transaction_interval_ms"});
+  network.transactions_announce_mode = getConfigDataAsBoolean(json, {"transactions_announce_mode"}, true, false);
+  network.dag_block_compact_relay = getConfigDataAsBoolean(json, {"dag_block_compact_relay"}, true, false);
+  network.transactions_reconciliation_interval_ms =
+      getConfigDataAsUInt(json, {"transactions_reconciliation_interval_ms"}, true, 0);
   network.ideal_peer_count = getConfigDataAsUInt(json, {"ideal_peer_count"});
   Json::Value priority_nodes = json["priority_nodes"];
   if (!priority_nodes.isNull()) {
@@ -135,6 +309,17 @@ void dec_json(const Json::Value &json, NetworkConfig &network) {
   }
   network.max_peer_count = getConfigDataAsUInt(json, {"max_peer_count"});
   network.sync_level_size = getConfigDataAsUInt(json, {"sync_level_size"});
+  network.sync_max_peers = getConfigDataAsUInt(json, {"sync_max_peers"}, true, network.sync_max_peers);
+  network.sync_queue_max_mb = getConfigDataAsUInt(json, {"sync_queue_max_mb"}, true, network.sync_queue_max_mb);
+  network.emulated_latency_ms = getConfigDataAsUInt(json, {"emulated_latency_ms"}, true, network.emulated_latency_ms);
+  network.emulated_bandwidth_kbps =
+      getConfigDataAsUInt(json, {"emulated_bandwidth_kbps"}, true, network.emulated_bandwidth_kbps);
+  network.packets_capture_path =
+      getConfigDataAsString(json, {"packets_capture_path"}, true, network.packets_capture_path);
+  network.peer_known_transactions_kb =
+      getConfigDataAsUInt(json, {"peer_known_transactions_kb"}, true, network.peer_known_transactions_kb);
+  network.peer_known_transactions_fp_ppm =
+      getConfigDataAsUInt(json, {"peer_known_transactions_fp_ppm"}, true, network.peer_known_transactions_fp_ppm);
   network.packets_processing_threads = getConfigDataAsUInt(json, {"packets_processing_threads"});
 
   // Packets processing threads performance is heart by too many threads processing same data from multiple peers, limit
@@ -143,12 +328,22 @@ void dec_json(const Json::Value &json, NetworkConfig &network) {
     network.packets_processing_threads = std::max(std::thread::hardware_concurrency(), 3u);
   }
 
+  if (auto scaling_json = getConfigData(json, {"packets_processing_scaling"}, true); !scaling_json.isNull()) {
+    dec_json(scaling_json, network.packets_processing_scaling.emplace());
+  }
+
   network.peer_blacklist_timeout =
       getConfigDataAsUInt(json, {"peer_blacklist_timeout"}, true, NetworkConfig::kBlacklistTimeoutDefaultInSeconds);
   network.disable_peer_blacklist = getConfigDataAsBoolean(json, {"disable_peer_blacklist"}, true, false);
   network.deep_syncing_threshold =
       getConfigDataAsUInt(json, {"deep_syncing_threshold"}, true, network.deep_syncing_threshold);
   network.ddos_protection = dec_ddos_protection_config_json(getConfigData(json, {"ddos_protection"}));
+  if (auto sync_upload_json = getConfigData(json, {"sync_upload"}, true); !sync_upload_json.isNull()) {
+    dec_json(sync_upload_json, network.sync_upload);
+  }
+  if (auto follower_json = getConfigData(json, {"follower"}, true); !follower_json.isNull()) {
+    dec_json(follower_json, network.follower.emplace());
+  }
 
   for (const auto &item : json["boot_nodes"]) {
     network.boot_nodes.push_back(dec_json(item));
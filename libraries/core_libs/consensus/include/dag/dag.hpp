@@ -1,17 +1,14 @@
 #pragma once
 
-#include <boost/function.hpp>
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/breadth_first_search.hpp>
-#include <boost/graph/depth_first_search.hpp>
-#include <boost/graph/graph_traits.hpp>
-#include <boost/graph/graphviz.hpp>
-#include <boost/graph/labeled_graph.hpp>
-#include <boost/graph/properties.hpp>
-#include <boost/property_map/property_map.hpp>
-#include <boost/thread.hpp>
-#include <iostream>
+#include <boost/container/small_vector.hpp>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "common/types.hpp"
 #include "logger/logger.hpp"
@@ -25,67 +22,80 @@ class DagManager;
 class Network;
 
 /**
- * @brief Thread safe. Labelled graph.
+ * @brief Not thread safe, DagManager synchronizes access. Labelled graph.
+ *
+ * Blocks are interned to dense 32-bit vertex indices in insertion order, hashes and adjacency are stored in flat
+ * arrays indexed by vertex. Edges point from pivot/tips to the new block. Most blocks have only few children and pivot
+ * or tips, so adjacency is kept inline without separate heap allocation.
  */
 class Dag {
  public:
-  // properties
-  using vertex_property_t =
-      boost::property<boost::vertex_index_t, blk_hash_t, boost::property<boost::vertex_index1_t, uint64_t>>;
-  using edge_property_t = boost::property<boost::edge_index_t, uint64_t>;
-
-  // graph def
-  using adj_list_t =
-      boost::adjacency_list<boost::setS, boost::hash_setS, boost::directedS, vertex_property_t, edge_property_t>;
-  using graph_t = boost::labeled_graph<adj_list_t, blk_hash_t, boost::hash_mapS>;
-  using vertex_t = boost::graph_traits<graph_t>::vertex_descriptor;
-  using edge_t = boost::graph_traits<graph_t>::edge_descriptor;
-  using vertex_iter_t = boost::graph_traits<graph_t>::vertex_iterator;
-  using edge_iter_t = boost::graph_traits<graph_t>::edge_iterator;
-  using vertex_adj_iter_t = boost::graph_traits<graph_t>::adjacency_iterator;
-
-  // property_map
-  using vertex_index_map_const_t = boost::property_map<graph_t, boost::vertex_index_t>::const_type;
-  using vertex_index_map_t = boost::property_map<graph_t, boost::vertex_index_t>::type;
-
-  using vertex_period_map_const_t = boost::property_map<graph_t, boost::vertex_index1_t>::const_type;
-  using vertex_period_map_t = boost::property_map<graph_t, boost::vertex_index1_t>::type;
-
-  using edge_index_map_const_t = boost::property_map<graph_t, boost::edge_index_t>::const_type;
-  using edge_index_map_t = boost::property_map<graph_t, boost::edge_index_t>::type;
+  using vertex_t = uint32_t;
+  using adjacency_t = boost::container::small_vector<vertex_t, 4>;
+
+  static constexpr vertex_t kNullVertex = std::numeric_limits<vertex_t>::max();
 
   friend DagManager;
 
   explicit Dag(blk_hash_t const &dag_genesis_block_hash, addr_t node_addr);
   virtual ~Dag() = default;
 
-  Dag(const Dag &) = default;
-  Dag(Dag &&) = default;
-  Dag &operator=(const Dag &) = default;
-  Dag &operator=(Dag &&) = default;
+  Dag(const Dag &) = delete;
+  Dag(Dag &&) = delete;
+  Dag &operator=(const Dag &) = delete;
+  Dag &operator=(Dag &&) = delete;
 
   uint64_t getNumVertices() const;
   uint64_t getNumEdges() const;
   bool hasVertex(blk_hash_t const &v) const;
-  bool addVEEs(blk_hash_t const &new_vertex, blk_hash_t const &pivot, std::vector<blk_hash_t> const &tips);
+  virtual bool addVEEs(blk_hash_t const &new_vertex, blk_hash_t const &pivot, std::vector<blk_hash_t> const &tips);
 
   void getLeaves(std::vector<blk_hash_t> &tips) const;
   void drawGraph(std::string const &filename) const;
 
+  /**
+   * @brief Computes topological order of non finalized blocks that are ancestors of the anchor
+   *
+   * Order is cached per anchor until the graph is cleared. New blocks can not become ancestors of blocks already in
+   * the graph, so the order of an anchor changes only if an edge is added to an existing block, which drops the cache.
+   * Can be called concurrently with other const functions
+   */
   bool computeOrder(const blk_hash_t &anchor, std::vector<blk_hash_t> &ordered_period_vertices,
                     const std::map<uint64_t, std::unordered_set<blk_hash_t>> &non_finalized_blks);
 
-  void clear();
+  virtual void clear();
 
  protected:
   // Note: private functions does not lock
 
+  /**
+   * @return vertex index of the hash or kNullVertex if it is not part of the graph
+   */
+  vertex_t vertex(blk_hash_t const &v) const;
+
+  /**
+   * @brief Adds edge from -> to, duplicate edges are ignored
+   * @return true if edge was added
+   */
+  bool addEdge(vertex_t from, vertex_t to);
+
   // traverser API
   bool reachable(vertex_t const &from, vertex_t const &to) const;
 
   void collectLeafVertices(std::vector<vertex_t> &leaves) const;
 
-  graph_t graph_;
+  std::unordered_map<blk_hash_t, vertex_t> vertices_;
+  std::vector<blk_hash_t> hashes_;
+  // Out edges, block -> blocks that reference it as pivot or tip
+  std::vector<adjacency_t> children_;
+  // In edges, block -> its pivot and tips that are part of the graph
+  std::vector<adjacency_t> parents_;
+  uint64_t edges_count_ = 0;
+
+  // Limit of cached orders, there are only few anchor candidates within a period
+  static constexpr size_t kMaxCachedOrders = 16;
+  std::unordered_map<blk_hash_t, std::vector<blk_hash_t>> orders_cache_;
+  mutable std::mutex orders_cache_mutex_;
 
  protected:
   LOG_OBJECTS_DEFINE
@@ -100,53 +110,37 @@ class PivotTree : public Dag {
  public:
   friend DagManager;
   explicit PivotTree(blk_hash_t const &dag_genesis_block_hash, addr_t node_addr)
-      : Dag(dag_genesis_block_hash, node_addr) {}
+      : Dag(dag_genesis_block_hash, node_addr), weights_(hashes_.size(), 1) {}
   virtual ~PivotTree() = default;
 
-  PivotTree(const PivotTree &) = default;
-  PivotTree(PivotTree &&) = default;
-  PivotTree &operator=(const PivotTree &) = default;
-  PivotTree &operator=(PivotTree &&) = default;
+  PivotTree(const PivotTree &) = delete;
+  PivotTree(PivotTree &&) = delete;
+  PivotTree &operator=(const PivotTree &) = delete;
+  PivotTree &operator=(PivotTree &&) = delete;
 
-  using Dag::vertex_adj_iter_t;
-  using Dag::vertex_index_map_const_t;
   using Dag::vertex_t;
 
-  std::vector<blk_hash_t> getGhostPath(const blk_hash_t &vertex) const;
-};
-class DagBuffer;
-class KeyManager;
+  bool addVEEs(blk_hash_t const &new_vertex, blk_hash_t const &pivot, std::vector<blk_hash_t> const &tips) override;
+  void clear() override;
 
-// for graphviz
-template <class Property1>
-class vertex_label_writer {
- public:
-  vertex_label_writer(Property1 name) : name(name) {}
-  template <class Vertex>
-  void operator()(std::ostream &out, const Vertex &v) const {
-    out << "[label=\"" << name[v].toString().substr(0, 8) << " " << "\"]";
-  }
+  /**
+   * @brief Follows the heaviest child from the vertex, subtree weights are maintained on insert so the cost is
+   * proportional to the path length
+   */
+  std::vector<blk_hash_t> getGhostPath(const blk_hash_t &vertex) const;
 
  private:
-  Property1 name;
-};
-
-template <class Property>
-class edge_label_writer {
- public:
-  explicit edge_label_writer(Property weight) : weight(weight) {}
-  template <class Edge>
-  void operator()(std::ostream &out, const Edge &e) const {
-    if (weight[e] == 0) {
-      out << "[style=\"dashed\" dir=\"back\"]";
-    } else {
-      out << "[dir=\"back\"]";
-    }
-  }
+  /**
+   * @brief Adds delta to the weight of the vertex and all its ancestors, counted once per path
+   */
+  void addWeight(vertex_t from, size_t delta);
 
- private:
-  Property weight;
+  // Subtree weight of each vertex, 1 + sum of children weights
+  std::vector<size_t> weights_;
 };
+class DagBuffer;
+class KeyManager;
+
 /** @}*/
 
 }  // namespace taraxa
@@ -124,6 +124,14 @@ class DagBlockProposer {
   std::pair<SharedTransactions, std::vector<uint64_t>> getShardedTrxs(PbftPeriod proposal_period, uint64_t weight_limit,
                                                                       const uint16_t node_trx_shard) const;
 
+  /**
+   * @brief Adds tips of the latest frontier to the draft frontier, tips which would change the level are skipped
+   * @param draft frontier the VDF was computed for
+   * @param latest_frontier current frontier
+   * @param propose_level level of the new block
+   */
+  void patchDraftTips(DagFrontier& draft, const DagFrontier& latest_frontier, level_t propose_level) const;
+
   /**
    * @brief Gets current propose level for provided pivot and tips
    * @param pivot pivot block hash
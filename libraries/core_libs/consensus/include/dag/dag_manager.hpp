@@ -1,5 +1,10 @@
 #pragma once
 
+#include <atomic>
+
+#include "common/lock_profiler.hpp"
+#include "common/memory_usage.hpp"
+#include "common/scheduler.hpp"
 #include "common/thread_pool.hpp"
 #include "dag.hpp"
 #include "dag/dag_block.hpp"
@@ -27,6 +32,9 @@ struct DagConfig;
  * Once a pbft block is finalized setDagBlockOrder is invoked which removes all the finalized DAG blocks from in memory
  * DAG. DagManager class is thread safe in general with exception of function setDagBlockOrder. See details in function
  * descriptions.
+ *
+ * Writers modify the state under exclusive mutex_ and publish an immutable snapshot of frontier, anchors and non
+ * finalized blocks. Readers of these load the snapshot without locking, so they are not blocked by pbft finalization.
  */
 class DagManager : public std::enable_shared_from_this<DagManager> {
  public:
@@ -66,6 +74,12 @@ class DagManager : public std::enable_shared_from_this<DagManager> {
    */
   bool isDagBlockKnown(const blk_hash_t &hash) const;
 
+  /**
+   * @param hash
+   * @return true in case block is in the memory cache of seen blocks, db is not checked
+   */
+  bool isDagBlockSeen(const blk_hash_t &hash) const;
+
   /**
    * @brief Gets dag block from either local memory cache or db
    * @param hash Block hash
@@ -74,7 +88,8 @@ class DagManager : public std::enable_shared_from_this<DagManager> {
   std::shared_ptr<DagBlock> getDagBlock(const blk_hash_t &hash) const;
 
   /**
-   * @brief Verifies new DAG block
+   * @brief Verifies new DAG block. Cheap checks go first, VDF verification and transactions estimation run
+   * concurrently as the last ones
    * @param blk Block to verify
    * @param transactions Optional block transactions
    * @return verification result and all the transactions which are part of the block
@@ -83,6 +98,17 @@ class DagManager : public std::enable_shared_from_this<DagManager> {
       const std::shared_ptr<DagBlock> &blk,
       const std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> &trxs = {});
 
+  /**
+   * @brief Verifies DAG blocks in parallel. Verification does not depend on pivot and tips being in the DAG, so blocks
+   * of all levels can be verified at once and only adding them has to follow the level order
+   * @param blocks Blocks to verify
+   * @param transactions Optional blocks transactions
+   * @return verification results in the same order as blocks, see verifyBlock
+   */
+  std::vector<std::pair<VerifyBlockReturnType, SharedTransactions>> verifyBlocksBatch(
+      const std::vector<std::shared_ptr<DagBlock>> &blocks,
+      const std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> &trxs = {});
+
   /**
    * @brief Checks if block pivot and tips are in DAG
    * @param blk Block to check
@@ -151,13 +177,10 @@ class DagManager : public std::enable_shared_from_this<DagManager> {
   level_t getMaxLevel() const { return max_level_; }
 
   // DAG anchors
-  PbftPeriod getLatestPeriod() const {
-    std::shared_lock lock(mutex_);
-    return period_;
-  }
+  PbftPeriod getLatestPeriod() const { return snapshot_.load()->period; }
   std::pair<blk_hash_t, blk_hash_t> getAnchors() const {
-    std::shared_lock lock(mutex_);
-    return std::make_pair(old_anchor_, anchor_);
+    const auto snapshot = snapshot_.load();
+    return std::make_pair(snapshot->old_anchor, snapshot->anchor);
   }
 
   /**
@@ -181,11 +204,42 @@ class DagManager : public std::enable_shared_from_this<DagManager> {
 
   DagFrontier getDagFrontier();
 
+  /**
+   * @return current frontier together with its version, version changes every time frontier is updated
+   */
+  std::pair<DagFrontier, uint64_t> getDagFrontierWithVersion() const;
+
+  /**
+   * @brief Data of a frontier tip used by tips selection of proposed blocks
+   */
+  struct FrontierTip {
+    addr_t proposer;
+    uint64_t gas_estimation = 0;
+    level_t level = 0;
+  };
+  using FrontierTips = std::unordered_map<blk_hash_t, FrontierTip>;
+
+  /**
+   * @return tips of the current frontier, read without locking or db access
+   */
+  std::shared_ptr<const FrontierTips> getDagFrontierTips() const;
+
   /**
    * @return std::pair<size_t, size_t> -> first = number of levels, second = number of blocks
    */
   std::pair<size_t, size_t> getNonFinalizedBlocksSize() const;
 
+  /**
+   * @return approximate memory used by the non finalized DAG and recently seen blocks in bytes
+   */
+  size_t memoryUsage() const;
+
+  /**
+   * @brief Saves hashes of verified non finalized blocks, so that next start can skip their verification. Called on
+   *        clean shutdown
+   */
+  void saveStartupSnapshot() const;
+
   uint32_t getNonFinalizedBlocksMinDifficulty() const;
 
   util::event::Event<DagManager, std::shared_ptr<DagBlock>> const block_verified_{};
@@ -195,7 +249,7 @@ class DagManager : public std::enable_shared_from_this<DagManager> {
    *
    * @return mutex
    */
-  std::shared_mutex &getDagMutex() { return mutex_; }
+  util::ProfiledSharedMutex &getDagMutex() { return mutex_; }
 
   /**
    * @brief Retrieves sortition manager
@@ -241,16 +295,41 @@ class DagManager : public std::enable_shared_from_this<DagManager> {
 
  private:
   void recoverDag();
+  // Returns blocks verified before clean shutdown, empty if snapshot is missing or any period was finalized since
+  std::unordered_set<blk_hash_t> loadStartupSnapshot();
   void addToDag(blk_hash_t const &hash, blk_hash_t const &pivot, std::vector<blk_hash_t> const &tips, uint64_t level,
                 bool finalized = false);
   bool validateBlockNotExpired(const std::shared_ptr<DagBlock> &dag_block,
                                std::unordered_map<blk_hash_t, std::shared_ptr<DagBlock>> &expired_dag_blocks_to_remove);
-  void handleExpiredDagBlocksTransactions(const std::vector<trx_hash_t> &transactions_from_expired_dag_blocks) const;
+  void handleExpiredDagBlocksTransactions(std::unordered_set<trx_hash_t> &&transactions_from_expired_dag_blocks,
+                                          const std::vector<std::shared_ptr<DagBlock>> &non_expired_dag_blocks) const;
 
   std::pair<blk_hash_t, std::vector<blk_hash_t>> getFrontier() const;  // return pivot and tips
   void updateFrontier();
+
+  /**
+   * @brief Immutable state published for lock free readers, non finalized levels are shared between snapshots
+   */
+  struct Snapshot {
+    PbftPeriod period = 0;
+    blk_hash_t anchor;
+    blk_hash_t old_anchor;
+    DagFrontier frontier;
+    uint64_t frontier_version = 0;
+    std::shared_ptr<const FrontierTips> frontier_tips;
+    std::map<uint64_t, std::shared_ptr<const std::unordered_set<blk_hash_t>>> non_finalized_blks;
+    size_t non_finalized_blks_count = 0;
+    uint32_t non_finalized_blks_min_difficulty = UINT32_MAX;
+  };
+
+  /**
+   * @brief Publishes snapshot of the current state, must be called under exclusive mutex_ after every state change
+   * @param changed_level if set only this level of non finalized blocks changed since the last snapshot
+   */
+  void publishSnapshot(std::optional<uint64_t> changed_level = {});
+
   std::atomic<level_t> max_level_ = 0;
-  mutable std::shared_mutex mutex_;
+  mutable util::ProfiledSharedMutex mutex_{"dag_manager"};
   mutable std::shared_mutex order_dag_blocks_mutex_;
   std::shared_ptr<PivotTree> pivot_tree_;  // only contains pivot edges
   std::shared_ptr<Dag> total_dag_;         // contains both pivot and tips
@@ -265,6 +344,12 @@ class DagManager : public std::enable_shared_from_this<DagManager> {
   std::map<uint64_t, std::unordered_set<blk_hash_t>> non_finalized_blks_;
   uint32_t non_finalized_blks_min_difficulty_ = UINT32_MAX;
   DagFrontier frontier_;
+  uint64_t frontier_version_ = 0;
+  // Only tips that are new in the frontier are looked up when it is updated, others keep their data
+  std::shared_ptr<const FrontierTips> frontier_tips_ = std::make_shared<const FrontierTips>();
+  std::atomic<std::shared_ptr<const Snapshot>> snapshot_;
+  // Vertices of total_dag_ and pivot_tree_ and non finalized blocks index
+  util::MemoryUsage dag_memory_usage_;
   SortitionParamsManager sortition_params_manager_;
   const DagConfig &dag_config_;
   const std::shared_ptr<DagBlock> genesis_block_;
@@ -284,6 +369,19 @@ class DagManager : public std::enable_shared_from_this<DagManager> {
   const GenesisConfig kGenesis;
   const uint64_t kValidatorMaxVote;
 
+  /**
+   * @param concurrent_checks run transactions estimation on blocks_verification_executor_ during VDF verification
+   */
+  std::pair<VerifyBlockReturnType, SharedTransactions> verifyBlock(
+      const std::shared_ptr<DagBlock> &blk, const std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> &trxs,
+      bool concurrent_checks);
+
+  // Batches smaller than this are verified on the calling thread
+  static constexpr size_t kMinParallelBlocksVerifications = 4;
+  // Number of tasks a batch is split into
+  const uint32_t kBlocksVerificationTasksCount;
+  util::Executor blocks_verification_executor_{util::TaskClass::Consensus};
+
   LOG_OBJECTS_DEFINE
 };
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <config/config.hpp>
+#include <shared_mutex>
 
 #include "pbft/period_data.hpp"
 #include "storage/storage.hpp"
@@ -40,6 +41,13 @@ class SortitionParamsManager {
   SortitionParamsManager(const addr_t& node_addr, const FullNodeConfig& config, std::shared_ptr<DbStorage> db);
   SortitionParams getSortitionParams(std::optional<PbftPeriod> for_period = {}) const;
 
+  /**
+   * @brief Get params change which is active for the period, served from memory without touching db
+   * @param period
+   * @returns latest params change with change.period <= period, empty if there is none
+   */
+  std::optional<SortitionParamsChange> getParamsChangeForPeriod(PbftPeriod period) const;
+
   /**
    * Calculating DAG efficiency in passed PeriodData(PBFT)
    * DAG efficiency is count of unique transactions over all DAG blocks in a PBFT block divided by the count over all
@@ -78,6 +86,11 @@ class SortitionParamsManager {
   std::deque<uint16_t> dag_efficiencies_;
   uint32_t ignored_efficiency_counter_ = 0;
   std::deque<SortitionParamsChange> params_changes_;
+
+  // All params changes sorted by period, mirror of the sortition_params_change column
+  std::vector<SortitionParamsChange> params_changes_history_;
+  mutable std::shared_mutex params_changes_history_mutex_;
+
   SortitionParamsChange calculateChange(PbftPeriod period);
   EfficienciesMap getEfficienciesToUpperRange(uint16_t efficiency, int32_t threshold) const;
   int32_t getNewUpperRange(uint16_t efficiency) const;
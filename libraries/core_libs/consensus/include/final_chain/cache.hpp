@@ -1,13 +1,18 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <functional>
-#include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
 #include <unordered_map>
 #include <vector>
 
+#include "common/memory_usage.hpp"
+
 namespace taraxa {
 
 // TODO: could it be somehow prettier?
@@ -27,151 +32,243 @@ struct is_empty<std::vector<T>> {
 };
 }  // namespace
 
+// Both caches keep the last kBlocksToKeep blocks in a ring indexed by block_num % kBlocksToKeep. Slot is reused when a
+// newer block with the same index is added, so no ordered index of blocks has to be maintained and there is no global
+// lock. Concurrent misses for the same data wait for the first getter call instead of all hitting the db.
+static constexpr size_t kCacheFillStripes = 64;
+
 template <class Key, class Value>
 class MapByBlockCache {
  public:
   using GetterFn = std::function<Value(uint64_t, const Key &)>;
+  // Estimated memory used by single cached value, by default size of the value object itself
+  using SizeFn = std::function<size_t(const Value &)>;
   using ValueMap = std::unordered_map<Key, Value>;
-  using DataMap = std::map<uint64_t, ValueMap>;
 
   MapByBlockCache(const MapByBlockCache &) = delete;
   MapByBlockCache(MapByBlockCache &&) = delete;
   MapByBlockCache &operator=(const MapByBlockCache &) = delete;
   MapByBlockCache &operator=(MapByBlockCache &&) = delete;
 
-  MapByBlockCache(uint64_t blocks_to_save, GetterFn &&getter_fn)
-      : kBlocksToKeep(blocks_to_save), getter_fn_(std::move(getter_fn)) {}
+  MapByBlockCache(uint64_t blocks_to_save, GetterFn &&getter_fn, SizeFn &&size_fn = {})
+      : kBlocksToKeep(std::max<uint64_t>(blocks_to_save, 1)),
+        getter_fn_(std::move(getter_fn)),
+        size_fn_(std::move(size_fn)),
+        slots_(kBlocksToKeep) {}
 
   void append(uint64_t block_num, const Key &key, const Value &value) const {
-    std::unique_lock lock(mutex_);
-
-    auto blk_entry = data_by_block_.find(block_num);
-    if (blk_entry == data_by_block_.end()) {
-      blk_entry = data_by_block_.emplace(block_num, ValueMap()).first;
+    auto &slot = slots_[block_num % kBlocksToKeep];
+    std::unique_lock lock(slot.mutex);
+    if (slot.used && slot.block_num > block_num) {
+      // Slot was already reused by a newer block
+      return;
     }
-    blk_entry->second.emplace(key, value);
 
-    // Remove older element after we added one more
-    if (data_by_block_.size() > kBlocksToKeep) {
-      data_by_block_.erase(data_by_block_.begin());
+    if (!slot.used || slot.block_num != block_num) {
+      memory_usage_.sub(slot.bytes);
+      slot.values.clear();
+      slot.block_num = block_num;
+      slot.used = true;
+      slot.bytes = sizeof(ValueMap) + util::kContainerNodeOverhead;
+      memory_usage_.add(slot.bytes);
     }
+    if (slot.values.emplace(key, value).second) {
+      const auto size = entrySize(value);
+      slot.bytes += size;
+      memory_usage_.add(size);
+    }
+    lock.unlock();
+
+    updateLastBlockNum(block_num);
   }
 
   Value get(uint64_t blk_num, const Key &key) const {
-    {
-      std::shared_lock lock(mutex_);
-      auto blk_entry = data_by_block_.find(blk_num);
-      if (blk_entry != data_by_block_.end()) {
-        auto e = blk_entry->second.find(key);
-        if (e != blk_entry->second.end()) {
-          return e->second;
-        }
-      }
+    if (auto value = getFromCache(blk_num, key)) {
+      return std::move(*value);
+    }
+
+    // Not save old values in cache
+    if (isTooOld(blk_num)) {
+      return getter_fn_(blk_num, key);
+    }
+
+    std::scoped_lock fill_lock(fill_mutexes_[(std::hash<Key>{}(key) ^ blk_num) % kCacheFillStripes]);
+    // Could have been filled by another thread while waiting for the fill lock
+    if (auto value = getFromCache(blk_num, key)) {
+      return std::move(*value);
     }
 
     auto value = getter_fn_(blk_num, key);
     if (is_empty(value)) {
       return {};
     }
-    // Not save old values in cache
-    auto last_num = lastBlockNum();
-    if (last_num < kBlocksToKeep || blk_num >= last_num - kBlocksToKeep) {
-      append(blk_num, key, value);
-    }
+    append(blk_num, key, value);
     return value;
   }
 
-  uint64_t lastBlockNum() const {
-    std::shared_lock lock(mutex_);
-    if (data_by_block_.empty()) {
-      return 0;
+  uint64_t lastBlockNum() const { return last_block_num_.load(std::memory_order_acquire); }
+
+  /**
+   * @return approximate number of bytes used by cached entries
+   */
+  size_t memoryUsage() const { return memory_usage_.bytes(); }
+
+ protected:
+  struct Slot {
+    mutable std::shared_mutex mutex;
+    bool used = false;
+    uint64_t block_num = 0;
+    size_t bytes = 0;
+    ValueMap values;
+  };
+
+  std::optional<Value> getFromCache(uint64_t blk_num, const Key &key) const {
+    const auto &slot = slots_[blk_num % kBlocksToKeep];
+    std::shared_lock lock(slot.mutex);
+    if (!slot.used || slot.block_num != blk_num) {
+      return {};
     }
-    return data_by_block_.rbegin()->first;
+    if (auto e = slot.values.find(key); e != slot.values.end()) {
+      return e->second;
+    }
+    return {};
+  }
+
+  bool isTooOld(uint64_t blk_num) const { return blk_num + kBlocksToKeep <= lastBlockNum(); }
+
+  void updateLastBlockNum(uint64_t block_num) const {
+    auto last = last_block_num_.load(std::memory_order_relaxed);
+    while (last < block_num && !last_block_num_.compare_exchange_weak(last, block_num, std::memory_order_release)) {
+    }
+  }
+
+  size_t entrySize(const Value &value) const {
+    return sizeof(Key) + (size_fn_ ? size_fn_(value) : sizeof(Value)) + util::kContainerNodeOverhead;
   }
 
- protected:
   const uint64_t kBlocksToKeep;
   GetterFn getter_fn_;
+  SizeFn size_fn_;
 
   // cache is used from const methods in other class, so should be mutable
-  mutable std::shared_mutex mutex_;
-  mutable DataMap data_by_block_;
+  mutable std::vector<Slot> slots_;
+  mutable std::array<std::mutex, kCacheFillStripes> fill_mutexes_;
+  mutable std::atomic<uint64_t> last_block_num_{0};
+  mutable util::MemoryUsage memory_usage_;
 };
 
 template <class Value>
 class ValueByBlockCache {
  public:
   using GetterFn = std::function<Value(uint64_t)>;
-  using DataMap = std::map<uint64_t, Value>;
+  // Estimated memory used by single cached value, by default size of the value object itself
+  using SizeFn = std::function<size_t(const Value &)>;
 
   ValueByBlockCache(const ValueByBlockCache &) = delete;
   ValueByBlockCache(ValueByBlockCache &&) = delete;
   ValueByBlockCache &operator=(const ValueByBlockCache &) = delete;
   ValueByBlockCache &operator=(ValueByBlockCache &&) = delete;
 
-  ValueByBlockCache(uint64_t blocks_to_save, GetterFn &&getter_fn)
-      : kBlocksToKeep(blocks_to_save), getter_fn_(std::move(getter_fn)) {}
+  ValueByBlockCache(uint64_t blocks_to_save, GetterFn &&getter_fn, SizeFn &&size_fn = {})
+      : kBlocksToKeep(std::max<uint64_t>(blocks_to_save, 1)),
+        getter_fn_(std::move(getter_fn)),
+        size_fn_(std::move(size_fn)),
+        slots_(kBlocksToKeep) {}
 
   void append(uint64_t block_num, Value value) const {
-    std::unique_lock lock(mutex_);
-    data_by_block_.emplace(block_num, value);
+    const auto size = entrySize(value);
+    auto entry = std::make_shared<const Entry>(Entry{block_num, std::move(value), size});
+
+    // Slots are replaced only by newer blocks, readers always see a complete entry
+    auto &slot = slots_[block_num % kBlocksToKeep];
+    auto current = slot.load(std::memory_order_acquire);
+    do {
+      if (current && current->block_num >= block_num) {
+        return;
+      }
+    } while (!slot.compare_exchange_weak(current, entry, std::memory_order_acq_rel));
 
-    // Remove older element after we added one more
-    if (data_by_block_.size() > kBlocksToKeep) {
-      data_by_block_.erase(data_by_block_.begin());
+    memory_usage_.add(size);
+    if (current) {
+      memory_usage_.sub(current->size);
     }
+    updateLastBlockNum(block_num);
   }
 
   std::optional<Value> getFromCache(uint64_t block_num) const {
-    std::shared_lock lock(mutex_);
-    auto blk_entry = data_by_block_.find(block_num);
-    if (blk_entry != data_by_block_.end()) {
-      return blk_entry->second;
+    const auto entry = slots_[block_num % kBlocksToKeep].load(std::memory_order_acquire);
+    if (entry && entry->block_num == block_num) {
+      return entry->value;
     }
     return {};
   }
 
   Value get(uint64_t block_num) const {
-    auto blk_entry = getFromCache(block_num);
-    if (blk_entry) {
-      return *blk_entry;
+    if (auto blk_entry = getFromCache(block_num)) {
+      return std::move(*blk_entry);
+    }
+
+    // Not save old values in cache
+    if (isTooOld(block_num)) {
+      return getter_fn_(block_num);
+    }
+
+    std::scoped_lock fill_lock(fill_mutexes_[block_num % kCacheFillStripes]);
+    // Could have been filled by another thread while waiting for the fill lock
+    if (auto blk_entry = getFromCache(block_num)) {
+      return std::move(*blk_entry);
     }
 
     auto value = getter_fn_(block_num);
     if (is_empty(value)) {
       return {};
     }
-    // Not save old values in cache
-    auto last_num = lastBlockNum();
-    if (last_num < kBlocksToKeep || block_num >= last_num - kBlocksToKeep) {
-      append(block_num, value);
-    }
+    append(block_num, value);
     return value;
   }
 
   Value last() const {
-    std::shared_lock lock(mutex_);
-    if (data_by_block_.empty()) {
-      return {};
+    if (auto value = getFromCache(lastBlockNum())) {
+      return std::move(*value);
     }
-    return data_by_block_.rbegin()->second;
+    return {};
   }
 
-  uint64_t lastBlockNum() const {
-    std::shared_lock lock(mutex_);
-    if (data_by_block_.empty()) {
-      return 0;
+  uint64_t lastBlockNum() const { return last_block_num_.load(std::memory_order_acquire); }
+
+  /**
+   * @return approximate number of bytes used by cached entries
+   */
+  size_t memoryUsage() const { return memory_usage_.bytes(); }
+
+ protected:
+  struct Entry {
+    uint64_t block_num;
+    Value value;
+    size_t size;
+  };
+
+  bool isTooOld(uint64_t block_num) const { return block_num + kBlocksToKeep <= lastBlockNum(); }
+
+  void updateLastBlockNum(uint64_t block_num) const {
+    auto last = last_block_num_.load(std::memory_order_relaxed);
+    while (last < block_num && !last_block_num_.compare_exchange_weak(last, block_num, std::memory_order_release)) {
     }
-    return data_by_block_.rbegin()->first;
   }
 
- protected:
+  size_t entrySize(const Value &value) const {
+    return sizeof(uint64_t) + (size_fn_ ? size_fn_(value) : sizeof(Value)) + util::kContainerNodeOverhead;
+  }
+
   const uint64_t kBlocksToKeep;
   GetterFn getter_fn_;
+  SizeFn size_fn_;
 
   // cache is used from const methods in other class, so should be mutable
-  mutable std::shared_mutex mutex_;
-  mutable DataMap data_by_block_;
+  mutable std::vector<std::atomic<std::shared_ptr<const Entry>>> slots_;
+  mutable std::array<std::mutex, kCacheFillStripes> fill_mutexes_;
+  mutable std::atomic<uint64_t> last_block_num_{0};
+  mutable util::MemoryUsage memory_usage_;
 };
 
-}  // namespace taraxa
\ No newline at end of file
+}  // namespace taraxa
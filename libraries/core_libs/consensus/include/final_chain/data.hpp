@@ -85,6 +85,21 @@ struct FinalizationResult : NewBlock {
   TransactionReceipts trx_receipts;
 };
 
+/**
+ * @brief Block of pruned history as served by a peer, nothing in it is trusted until it matches a known block hash
+ */
+struct HistoricalBlock {
+  std::shared_ptr<PbftBlock> pbft_block;
+  // BlockHeaderData as stored in db
+  bytes header_data;
+  SharedTransactions transactions;
+  // Rlp of system transactions that are executed after the regular ones
+  std::vector<bytes> system_transactions;
+  TransactionReceipts receipts;
+
+  HAS_RLP_FIELDS
+};
+
 /** @} */
 
 }  // namespace taraxa::final_chain
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <future>
+#include <memory_resource>
 
 #include "common/event.hpp"
+#include "common/scheduler.hpp"
+#include "common/stage_timings.hpp"
 #include "common/types.hpp"
+#include "common/util.hpp"
 #include "config/config.hpp"
 #include "config/state_config.hpp"
 #include "final_chain/cache.hpp"
@@ -18,6 +24,46 @@ namespace taraxa::final_chain {
  * @{
  */
 
+/**
+ * @brief Eligible validators and their vote counts in DPOS contract for a single block
+ */
+struct DposValidatorsSnapshot {
+  EthBlockNumber blk_num;
+  // Sorted by address
+  std::vector<state_api::ValidatorVoteCount> validators;
+  uint64_t total_vote_count;
+
+  /**
+   * @param addr validator address
+   * @return eligible vote count of validator, 0 if validator is not eligible
+   */
+  uint64_t voteCount(const addr_t& addr) const;
+};
+
+/**
+ * @brief Single state read of a batch, see FinalChain::queryState
+ */
+struct StateQuery {
+  enum class Kind { Balance, Nonce, Code, Storage };
+
+  Kind kind = Kind::Balance;
+  addr_t address;
+  // Storage slot, used only by Storage queries
+  u256 slot;
+  // Latest block if empty, resolved once for the whole batch
+  std::optional<EthBlockNumber> blk_n;
+};
+
+/**
+ * @brief Result of StateQuery, only the field of query kind is set
+ */
+struct StateQueryResult {
+  // Balance or nonce
+  u256 value;
+  h256 storage;
+  bytes code;
+};
+
 /**
  * @brief main responsibility is blocks execution in EVM, getting data from EVM state
  *
@@ -43,8 +89,20 @@ class FinalChain {
 
   void stop();
 
+  /**
+   * @brief Used by replica opened on secondary db: applies new writes of primary to main db and emits
+   *        block_finalized_ for every block finalized by primary since the last call
+   */
+  void catchUpWithPrimary();
+
   EthBlockNumber delegationDelay() const;
 
+  /**
+   * @brief Set timings that execution stages are recorded into, must be called before any block is finalized
+   * @param timings
+   */
+  void setStageTimings(std::shared_ptr<util::StageTimings> timings);
+
   /**
    * @brief Method which finalizes a block and executes it in EVM
    *
@@ -73,6 +131,12 @@ class FinalChain {
    */
   EthBlockNumber lastBlockNumber() const;
 
+  /**
+   * @brief Hardfork rules of the last block, resolved once when the block is finalized
+   * @return rules, never nullptr
+   */
+  std::shared_ptr<const HardforkRules> lastBlockHardforkRules() const;
+
   /**
    * @brief Method to get block number by hash
    *
@@ -124,6 +188,13 @@ class FinalChain {
    */
   std::optional<TransactionLocation> transactionLocation(h256 const& trx_hash) const;
 
+  /**
+   * @brief Locations of recently finalized transactions are served from memory, these count lookups of them
+   * @return number of transaction locations found in the cache and number of lookups that had to read the db
+   */
+  uint64_t transactionLocationCacheHits() const { return trx_location_cache_hits_; }
+  uint64_t transactionLocationCacheMisses() const { return trx_location_cache_misses_; }
+
   /**
    * @brief Method to get transaction receipt by block number and position
    * @param blk_n block number
@@ -157,6 +228,32 @@ class FinalChain {
    */
   std::vector<EthBlockNumber> withBlockBloom(LogBloom const& b, EthBlockNumber from, EthBlockNumber to) const;
 
+  /**
+   * @brief Same as above, but matches all filter alternatives in a single pass over blooms index
+   * @param blooms alternatives, block matches if it matches any of them
+   * @return ordered blocks that match at least one of the blooms
+   */
+  std::vector<EthBlockNumber> withBlockBloom(const std::vector<LogBloom>& blooms, EthBlockNumber from,
+                                             EthBlockNumber to) const;
+
+  /**
+   * @brief Method to get first block that is covered by logs index
+   * @return first indexed block or nullopt if logs index is disabled
+   */
+  std::optional<EthBlockNumber> logsIndexFrom() const { return logs_index_from_; }
+
+  /**
+   * @brief Method used to search for transactions that emitted logs by address and optionally by first topic
+   * @param address log address
+   * @param topic0 first log topic, if nullopt logs with any topics are matched
+   * @param from EthBlockNumber block to start search
+   * @param to EthBlockNumber block to end search
+   * @return block numbers and positions of matching transactions in ascending order
+   */
+  std::vector<std::pair<EthBlockNumber, uint32_t>> withLogsIndex(const Address& address,
+                                                                 const std::optional<h256>& topic0,
+                                                                 EthBlockNumber from, EthBlockNumber to) const;
+
   /**
    * @brief Method to get account information
    * @see state_api::Account
@@ -182,6 +279,14 @@ class FinalChain {
    */
   bytes getCode(addr_t const& addr, std::optional<EthBlockNumber> blk_n = {}) const;
 
+  /**
+   * @brief Resolves several state reads together, e.g. balance, nonce and code of the same address. Queries without
+   * block are resolved against the same latest block, and every account is read only once per block
+   * @param queries
+   * @return results in the same order as queries
+   */
+  std::vector<StateQueryResult> queryState(const std::vector<StateQuery>& queries) const;
+
   /**
    * @brief Executes a new message call immediately without creating a transaction on the block chain. That means that
    * state would be reverted and not saved anywhere
@@ -191,6 +296,16 @@ class FinalChain {
    */
   state_api::ExecutionResult call(state_api::EVMTransaction const& trx, std::optional<EthBlockNumber> blk_n = {}) const;
 
+  /**
+   * @brief Executes multiple independent message calls against the state of the same block. Block header is resolved
+   * once for the whole batch
+   * @param trxs std::vector<state_api::EVMTransaction> transactions to execute
+   * @param blk_n EthBlockNumber number of block we are getting state from
+   * @return std::vector<state_api::ExecutionResult> results in the order of trxs
+   */
+  std::vector<state_api::ExecutionResult> callBatch(const std::vector<state_api::EVMTransaction>& trxs,
+                                                    std::optional<EthBlockNumber> blk_n = {}) const;
+
   /**
    * @brief Trace execution of a new message call immediately without creating a transactions on the block chain. That
    * means that state would be reverted and not saved anywhere
@@ -201,6 +316,13 @@ class FinalChain {
   std::string trace(std::vector<state_api::EVMTransaction> state_trxs, std::vector<state_api::EVMTransaction> trxs,
                     EthBlockNumber blk_n, std::optional<state_api::Tracing> params = {}) const;
 
+  /**
+   * @brief Same as trace, but serialized trace is forwarded to the sink in chunks instead of being returned as string
+   * @param sink receives consecutive chunks of the trace json
+   */
+  void trace(std::vector<state_api::EVMTransaction> state_trxs, std::vector<state_api::EVMTransaction> trxs,
+             EthBlockNumber blk_n, std::optional<state_api::Tracing> params, const state_api::TraceSink& sink) const;
+
   /**
    * @brief total count of eligible votes are in DPOS precompiled contract
    * @param blk_num EthBlockNumber number of block we are getting state from
@@ -232,12 +354,42 @@ class FinalChain {
    */
   vrf_wrapper::vrf_pk_t dposGetVrfKey(EthBlockNumber blk_n, const addr_t& addr) const;
 
+  /**
+   * @brief Get snapshot of eligible validators for recent finalized block
+   *
+   * Snapshot is created once the block is finalized, so dpos lookups for recent blocks don't have to go to the state.
+   * @param blk_num
+   * @return snapshot, nullptr if blk_num is not finalized yet or is too old to be kept
+   */
+  std::shared_ptr<const DposValidatorsSnapshot> dposValidatorsSnapshot(EthBlockNumber blk_num) const;
+
   /**
    * @brief Prune state db for all blocks older than blk_n
    * @param blk_n number of block we are getting state from
    */
   void prune(EthBlockNumber blk_n);
 
+  /**
+   * @brief Prune state db for all blocks older than blk_n and remember blk_n, headers older than it are left for
+   *        pruneBlockHeaders. Runs on executor thread, so it is serialized with finalization
+   * @param blk_n number of block we are getting state from
+   */
+  void pruneStateDb(EthBlockNumber blk_n);
+
+  /**
+   * @return block number state db was last pruned at
+   */
+  std::optional<EthBlockNumber> prunedStateBlock() const;
+
+  /**
+   * @brief Deletes headers of at most max_blocks blocks older than the block state db was pruned at. Progress is
+   *        persisted, so repeated calls continue where the previous one stopped, also after restart
+   * @param max_blocks
+   * @param write_opts
+   * @return number of deleted headers, 0 when there is nothing left to delete
+   */
+  size_t pruneBlockHeaders(size_t max_blocks, const rocksdb::WriteOptions& write_opts);
+
   /**
    * @brief Wait until next block is finalized
    */
@@ -271,6 +423,13 @@ class FinalChain {
    */
   h256 getBridgeRoot(EthBlockNumber blk_num) const;
 
+  /**
+   * @brief Reads accounts of senders and receivers and codes of called contracts, results are not used. It only
+   * brings state db data needed for execution of the transactions into memory
+   * @param transactions transactions of a period waiting for execution
+   */
+  void prefetchState(const SharedTransactions& transactions) const;
+
   /**
    * @param blk_num
    * @return bridge epoch
@@ -279,26 +438,125 @@ class FinalChain {
 
   // TODO move out of here:
   std::pair<val_t, bool> getBalance(addr_t const& addr) const;
-  std::shared_ptr<const FinalizationResult> finalize_(PeriodData&& new_blk,
-                                                      std::vector<h256>&& finalized_dag_blk_hashes,
-                                                      uint32_t blocks_per_year, std::shared_ptr<DagBlock>&& anchor);
+  std::shared_ptr<FinalizationResult> finalize_(PeriodData&& new_blk, std::vector<h256>&& finalized_dag_blk_hashes,
+                                                uint32_t blocks_per_year, std::shared_ptr<DagBlock>&& anchor);
 
   SharedTransactionReceipts blockReceipts(std::optional<EthBlockNumber> n = {}) const;
 
+  /**
+   * @brief Method to get receipts of multiple blocks. Cached blocks are served from cache, rest is read with a single
+   *        batched db lookup, so it is preferable to blockReceipts when scanning ranges of historical blocks
+   * @param blocks block numbers
+   * @return receipts in the same order as blocks, nullptr for blocks without receipts
+   */
+  std::vector<SharedTransactionReceipts> blocksReceipts(const std::vector<EthBlockNumber>& blocks) const;
+
+  /**
+   * @brief Called for each exported block, returning false stops the export
+   */
+  using ExportedBlockCallback = std::function<bool(const BlockHeader& header, const SharedTransactions& transactions,
+                                                   const TransactionReceipts& receipts)>;
+
+  /**
+   * @brief Reads range of blocks with their transactions and receipts directly from db with sequential iterators,
+   *        bypassing caches. Intended for bulk export of historical data
+   * @param from first block number
+   * @param to last block number, export stops earlier at the last finalized block
+   */
+  void exportBlocks(EthBlockNumber from, EthBlockNumber to, const ExportedBlockCallback& callback) const;
+
+  /**
+   * @brief Approximate memory used by block caches. Storage and code caches are estimated from their sizes
+   * @return size in bytes
+   */
+  size_t cachesMemoryUsage() const;
+
+  /**
+   * @brief Size limits of the caches that can be changed at runtime, in entries
+   */
+  struct CachesSizes {
+    uint32_t storage = 0;
+    uint32_t code = 0;
+    uint32_t trx_location = 0;
+  };
+  CachesSizes cachesSizes() const;
+
+  /**
+   * @brief Resizes running caches, shrunk caches drop their oldest entries right away. Caches disabled by config stay
+   * disabled and their sizes are ignored
+   * @param sizes new sizes, sizes of enabled caches must not be 0
+   */
+  void setCachesSizes(const CachesSizes& sizes);
+
+  /**
+   * @brief Fetches block from peers and passes every received one to verify until it accepts one
+   * @return true if a block was accepted
+   */
+  using HistoricalBlockFetcher =
+      std::function<bool(EthBlockNumber blk_n, const std::function<bool(const HistoricalBlock&)>& verify)>;
+
+  /**
+   * @brief Enables fetchHistoricalBlock. Headers, transactions and receipts of finalized blocks that are not in db are
+   *        fetched and kept in a bounded cache once they match hash of the block. Hash is known from the stored header
+   *        of the block or the next one, so history is fetched only as deep as headers are kept or blocks are fetched
+   *        one after another from the newest
+   * @param fetcher
+   * @param cache_size number of fetched blocks kept in memory
+   */
+  void setHistoricalBlockFetcher(HistoricalBlockFetcher fetcher, uint32_t cache_size);
+
+  struct VerifiedHistoricalBlock {
+    std::shared_ptr<const BlockHeader> header;
+    SharedTransactions transactions;
+    SharedTransactionReceipts receipts;
+  };
+
+  /**
+   * @brief Fetches finalized block whose history is pruned from db. Blocks the caller for network round trips, so other
+   *        getters never call it and read db only. It is meant for rpc methods that read a single block
+   * @return cached or fetched block, nullptr if block is in db, fetching is disabled or no peer served it
+   */
+  std::shared_ptr<const VerifiedHistoricalBlock> fetchHistoricalBlock(EthBlockNumber n) const;
+
  private:
+  std::shared_ptr<const VerifiedHistoricalBlock> verifyHistoricalBlock(EthBlockNumber n,
+                                                                       const HistoricalBlock& block) const;
+  /**
+   * @return hash of the block from its stored hash, or parent hash of the next stored or fetched header
+   */
+  std::optional<h256> knownBlockHash(EthBlockNumber n) const;
+
   const SharedTransactions getTransactions(std::optional<EthBlockNumber> n = {}) const;
   std::shared_ptr<TransactionHashes> getTransactionHashes(std::optional<EthBlockNumber> n = {}) const;
   SharedTransactionReceipts getBlockReceipts(std::optional<EthBlockNumber> n = {}) const;
   std::shared_ptr<const BlockHeader> getBlockHeader(EthBlockNumber n) const;
   std::optional<h256> getBlockHash(EthBlockNumber n) const;
   EthBlockNumber lastIfAbsent(const std::optional<EthBlockNumber>& client_blk_n) const;
-  static state_api::EVMTransaction toEvmTransaction(const SharedTransaction& trx);
-  static void appendEvmTransactions(std::vector<state_api::EVMTransaction>& evm_trxs, const SharedTransactions& trxs);
+  /**
+   * @brief Throws on replica, which has no state db
+   */
+  StateAPI& stateAPI() const;
   BlocksBlooms blockBlooms(const h256& chunk_id) const;
   static h256 blockBloomsChunkId(EthBlockNumber level, EthBlockNumber index);
-  std::vector<EthBlockNumber> withBlockBloom(const LogBloom& b, EthBlockNumber from, EthBlockNumber to,
-                                             EthBlockNumber level, EthBlockNumber index) const;
+  static bytes logsIndexKey(const Address& address, const std::optional<h256>& topic0, EthBlockNumber blk_n,
+                            uint32_t trx_pos);
+  /**
+   * @brief Blooms chunk of the index, chunks of already finalized ranges never change, so they are cached
+   */
+  std::shared_ptr<const BlocksBlooms> blockBlooms(EthBlockNumber level, EthBlockNumber index) const;
+  void withBlockBloom(const std::vector<const LogBloom*>& blooms, EthBlockNumber from, EthBlockNumber to,
+                      EthBlockNumber level, EthBlockNumber index, std::vector<EthBlockNumber>& ret) const;
   bool isNeedToFinalize(EthBlockNumber blk_num) const;
+  // Updates last block number together with its hardfork rules
+  void setLastBlockNumber(EthBlockNumber blk_n);
+
+  /**
+   * @brief Notifies subscribers about finalized block that is already durable. In pipelined mode it is executed on
+   * commit_thread_ while the next period is already being executed on executor_thread_
+   */
+  void commitFinalized(const std::shared_ptr<FinalizationResult>& result,
+                       const std::shared_ptr<std::promise<std::shared_ptr<const FinalizationResult>>>& promise);
+  void createSnapshotIfNeeded(EthBlockNumber blk_n);
 
   SharedTransaction makeBridgeFinalizationTransaction();
   std::vector<SharedTransaction> makeSystemTransactions(PbftPeriod blk_num);
@@ -307,22 +565,53 @@ class FinalChain {
   std::shared_ptr<BlockHeader> makeGenesisHeader(const h256& state_root) const;
 
   std::pair<h256, LogBloom> processReceipts(Batch& batch, EthBlockNumber blk_n, const TransactionReceipts& receipts);
+  h256 receiptsRoot(const TransactionReceipts& receipts, std::pmr::memory_resource* arena) const;
+  h256 transactionsRoot(const SharedTransactions& transactions, std::pmr::memory_resource* arena) const;
+  /**
+   * @param transactions_root root of transactions trie if it was already computed, e.g. concurrently with execution
+   */
   std::shared_ptr<BlockHeader> appendBlock(Batch& batch, const PbftBlock& pbft_blk, const h256& state_root,
                                            u256 total_reward, const SharedTransactions& transactions = {},
-                                           const TransactionReceipts& receipts = {});
+                                           const TransactionReceipts& receipts = {},
+                                           std::optional<h256> transactions_root = {});
   std::shared_ptr<BlockHeader> appendBlock(Batch& batch, std::shared_ptr<BlockHeader> header,
                                            const SharedTransactions& transactions = {},
-                                           const TransactionReceipts& receipts = {});
+                                           const TransactionReceipts& receipts = {},
+                                           std::optional<h256> transactions_root = {});
 
  private:
   std::shared_ptr<DbStorage> db_;
   const uint64_t kBlockGasLimit;
-  StateAPI state_api_;
+  // Not opened on replica, state db can't be shared with the primary node that has it open
+  std::unique_ptr<StateAPI> state_api_;
   const uint32_t kMaxLevelsPerPeriod;
   rewards::Stats rewards_;
 
   // It is not prepared to use more then 1 thread. Examine it if you want to change threads count
   boost::asio::thread_pool executor_thread_{1};
+  // Used only in pipelined mode. It must stay single threaded to keep the order of block_finalized_emitter_ events
+  boost::asio::thread_pool commit_thread_{1};
+  const bool kPipelinedCommit;
+  // Only one finalized period can wait for its notification while the next one is being executed
+  bool commit_in_progress_ = false;
+  // Used only when state prefetching is enabled, reads state touched by periods waiting on executor_thread_
+  boost::asio::thread_pool prefetch_thread_{1};
+  const bool kPrefetchState;
+  // Prefetching is skipped for new periods when it is this much behind, execution would reach them first anyway
+  const uint32_t kMaxPendingPrefetches = 4;
+  std::atomic<uint32_t> pending_prefetches_ = 0;
+  std::condition_variable commit_cv_;
+  std::mutex commit_mtx_;
+  // Set only in constructor when logs index is enabled
+  std::optional<EthBlockNumber> logs_index_from_;
+  std::shared_ptr<util::StageTimings> stage_timings_;
+  // Temporaries of a single appended block, used only by appendBlock which runs on executor_thread_ or in constructor.
+  // Initial buffer is kept across releases, so usual periods do not allocate for them at all
+  static constexpr size_t kPeriodArenaInitialSize = 1 << 20;
+  std::vector<std::byte> period_arena_buffer_ = std::vector<std::byte>(kPeriodArenaInitialSize);
+  std::pmr::monotonic_buffer_resource period_arena_{period_arena_buffer_.data(), period_arena_buffer_.size()};
+  // Hashes children of large branch nodes of transactions and receipts tries
+  util::Executor trie_executor_{util::TaskClass::Execution};
 
   std::atomic<uint64_t> num_executed_dag_blk_ = 0;
   std::atomic<uint64_t> num_executed_trx_ = 0;
@@ -334,6 +623,19 @@ class FinalChain {
   ValueByBlockCache<const SharedTransactions> transactions_cache_;
   ValueByBlockCache<std::shared_ptr<const TransactionHashes>> transaction_hashes_cache_;
   MapByBlockCache<addr_t, std::optional<const state_api::Account>> accounts_cache_;
+  // Storage values keyed by hash of (account storage root, slot) and codes keyed by code hash. Keys are content
+  // addresses, so entries stay valid across blocks until contract storage or code changes
+  ExpirationCacheMap<h256, h256> storage_cache_;
+  ExpirationCacheMap<h256, bytes> code_cache_;
+  // Blooms index chunks of complete ranges, 4KB each. Upper level chunks cover 256 blocks, so they are hit the most
+  static constexpr uint32_t kBloomsChunksCacheSize = 4096;
+  ExpirationCacheMap<h256, std::shared_ptr<const BlocksBlooms>> blooms_chunks_cache_;
+
+  // Number of recent blocks for which dpos validators snapshots are kept
+  static constexpr EthBlockNumber kDposSnapshotsCount = 16;
+  // Indexed by blk_num % kDposSnapshotsCount
+  mutable std::array<std::atomic<std::shared_ptr<const DposValidatorsSnapshot>>, kDposSnapshotsCount>
+      dpos_snapshots_;
 
   ValueByBlockCache<uint64_t> total_vote_count_cache_;
   MapByBlockCache<addr_t, uint64_t> dpos_vote_count_cache_;
@@ -341,10 +643,24 @@ class FinalChain {
 
   ValueByBlockCache<SharedTransactionReceipts> block_receipts_cache_;
 
+  // Locations of the most recently finalized transactions, filled on finalization
+  ExpirationCacheMap<trx_hash_t, TransactionLocation> trx_locations_cache_;
+  mutable std::atomic<uint64_t> trx_location_cache_hits_{0};
+  mutable std::atomic<uint64_t> trx_location_cache_misses_{0};
+
+  // Set only on light nodes, see setHistoricalBlockFetcher
+  HistoricalBlockFetcher historical_block_fetcher_;
+  mutable std::shared_mutex historical_block_fetcher_mutex_;
+  mutable ExpirationCacheMap<EthBlockNumber, std::shared_ptr<const VerifiedHistoricalBlock>> historical_blocks_cache_;
+  // Lookups that wait for peers block the calling rpc thread, misses over the limit are not fetched
+  static constexpr uint32_t kMaxHistoricalFetches = 4;
+  mutable std::atomic<uint32_t> historical_fetches_ = 0;
+
   std::condition_variable finalized_cv_;
   std::mutex finalized_mtx_;
 
   std::atomic<EthBlockNumber> last_block_number_;
+  std::atomic<std::shared_ptr<const HardforkRules>> last_block_hardfork_rules_;
 
   const FullNodeConfig& kConfig;
   LOG_OBJECTS_DEFINE
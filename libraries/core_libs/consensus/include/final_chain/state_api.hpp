@@ -3,9 +3,11 @@
 #include <taraxa-evm/taraxa-evm.h>
 
 #include <functional>
+#include <string_view>
 
 #include "final_chain/state_api_data.hpp"
 #include "rewards/block_stats.hpp"
+#include "transaction/transaction.hpp"
 
 namespace taraxa::state_api {
 
@@ -17,6 +19,11 @@ struct OptsDB;
  * @{
  */
 
+/**
+ * @brief Receives serialized trace json in consecutive chunks
+ */
+using TraceSink = std::function<void(std::string_view chunk)>;
+
 class StateAPI {
   std::function<h256(EthBlockNumber)> get_blk_hash_;
   taraxa_evm_GetBlockHash get_blk_hash_c_;
@@ -42,12 +49,19 @@ class StateAPI {
   h256 get_account_storage(EthBlockNumber blk_num, const addr_t& addr, const u256& key) const;
   bytes get_code_by_address(EthBlockNumber blk_num, const addr_t& addr) const;
   ExecutionResult dry_run_transaction(EthBlockNumber blk_num, const EVMBlock& blk, const EVMTransaction& trx) const;
-  bytes trace(EthBlockNumber blk_num, const EVMBlock& blk, const std::vector<EVMTransaction>& state_trxs,
-              const std::vector<EVMTransaction>& trxs, std::optional<Tracing> params = {}) const;
+  // Dry runs independent transactions against the same block state, results are in the order of trxs
+  std::vector<ExecutionResult> dry_run_transactions(EthBlockNumber blk_num, const EVMBlock& blk,
+                                                    const std::vector<EVMTransaction>& trxs) const;
+  // Trace is forwarded to sink straight from the taraxa-evm result buffer, without copying it into intermediate bytes
+  void trace(EthBlockNumber blk_num, const EVMBlock& blk, const std::vector<EVMTransaction>& state_trxs,
+             const std::vector<EVMTransaction>& trxs, std::optional<Tracing> params, const TraceSink& sink) const;
   StateDescriptor get_last_committed_state_descriptor() const;
 
   const TransactionsExecutionResult& execute_transactions(const EVMBlock& block,
                                                           const std::vector<EVMTransaction>& transactions);
+  // Same as above, but transactions are encoded straight from their fields without intermediate EVMTransaction copies.
+  // Results are owned by StateAPI and reused by the next call, so caller may move data (e.g. logs) out of them
+  TransactionsExecutionResult& execute_transactions(const EVMBlock& block, const SharedTransactions& transactions);
   const RewardsDistributionResult& distribute_rewards(const std::vector<rewards::BlockStats>& rewards_stats);
   void transition_state_commit();
 
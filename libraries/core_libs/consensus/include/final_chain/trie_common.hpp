@@ -1,9 +1,24 @@
 #pragma once
 
+#include <memory_resource>
+#include <span>
+
+#include "common/scheduler.hpp"
 #include "common/types.hpp"
 
 namespace taraxa::final_chain {
 
 h256 hash256(dev::BytesMap const& _s);
 
+/**
+ * @brief Root of trie keyed by rlp encoded positions of values, e.g. transactions or receipts trie of a block.
+ *        Same as hash256 of such map, but values are not copied and keys are generated already sorted into the arena.
+ *        With executor, children of branch nodes over kParallelTrieMinSize values are hashed concurrently on it
+ */
+h256 orderedTrieRoot(std::span<const dev::bytesConstRef> values,
+                     std::pmr::memory_resource* arena = std::pmr::get_default_resource(),
+                     const util::Executor* executor = nullptr);
+
+constexpr size_t kParallelTrieMinSize = 512;
+
 }  // namespace taraxa::final_chain
@@ -69,12 +69,18 @@ class PbftChain {
   std::string getJsonStr() const;
 
   /**
-   * @brief Get PBFT chain head block in JSON string
+   * @brief Get PBFT chain head in the RLP form it is stored in DB
+   * @return RLP of head hash, chain size, non empty chain size and last PBFT block hash
+   */
+  bytes getHeadRlp() const;
+
+  /**
+   * @brief Get PBFT chain head in the RLP form it is stored in DB after the block is pushed
    * @param block_hash last PBFT block hash
    * @param null_anchor if the PBFT block include an empty DAG anchor
-   * @return PBFT chain head block in string
+   * @return RLP of PBFT chain head
    */
-  std::string getJsonStrForBlock(blk_hash_t const& block_hash, bool null_anchor) const;
+  bytes getHeadRlpForBlock(blk_hash_t const& block_hash, bool null_anchor) const;
 
   /**
    * @brief Find a PBFT block in chain
@@ -98,6 +104,9 @@ class PbftChain {
   bool checkPbftBlockValidation(const std::shared_ptr<PbftBlock>& pbft_block) const;
 
  private:
+  static bytes headRlp(blk_hash_t const& head_hash, PbftPeriod size, PbftPeriod non_empty_size,
+                       blk_hash_t const& last_pbft_block_hash);
+
   mutable std::shared_mutex chain_head_access_;
 
   blk_hash_t head_hash_;             // PBFT head hash
@@ -2,6 +2,8 @@
 
 #include <thread>
 
+#include "common/scheduler.hpp"
+#include "common/stage_timings.hpp"
 #include "common/types.hpp"
 #include "config/config.hpp"
 #include "final_chain/final_chain.hpp"
@@ -99,6 +101,12 @@ class PbftManager {
    */
   void setNetwork(std::weak_ptr<Network> network);
 
+  /**
+   * @brief Set timings that consensus steps and syncing stages are recorded into, must be called before start
+   * @param timings
+   */
+  void setStageTimings(std::shared_ptr<util::StageTimings> timings);
+
   /**
    * @brief Start PBFT daemon
    */
@@ -109,6 +117,12 @@ class PbftManager {
    */
   void stop();
 
+  /**
+   * @brief Wakes PBFT daemon up on events that may let it move on, e.g. new 2t+1 voted block, finalized block or synced
+   *        period data. Steps timings are kept, only checks that would wait for the next poll are run right away
+   */
+  void wakeUp();
+
   /**
    * @brief Run PBFT daemon
    */
@@ -204,6 +218,12 @@ class PbftManager {
    */
   size_t periodDataQueueSize() const;
 
+  /**
+   * @brief Get approximate memory used by PBFT blocks syncing queue
+   * @return size in bytes
+   */
+  size_t periodDataQueueMemoryUsage() const;
+
   /**
    * @brief Returns true if queue is empty
    * @return
@@ -219,6 +239,16 @@ class PbftManager {
   void periodDataQueuePush(PeriodData &&period_data, dev::p2p::NodeID const &node_id,
                            std::vector<std::shared_ptr<PbftVote>> &&current_block_cert_votes);
 
+  /**
+   * @brief Recovers signatures of period data transactions, dag blocks and votes on sync thread pool so they are cached
+   * before the period is validated
+   * @param period_data synced period data
+   * @param current_block_cert_votes cert votes for PeriodData pbft block period
+   * @return future that is ready once all signatures were recovered
+   */
+  std::shared_future<void> preVerifyPeriodData(const PeriodData &period_data,
+                                               const std::vector<std::shared_ptr<PbftVote>> &current_block_cert_votes);
+
   /**
    * @brief Get last pbft block hash from queue or if queue empty, from chain
    * @return last block hash
@@ -257,7 +287,8 @@ class PbftManager {
   blk_hash_t getLastPbftBlockHash();
 
   /**
-   * @brief Push proposed block into the proposed_blocks_ in case it is not there yet
+   * @brief Push proposed block into the proposed_blocks_ in case it is not there yet. Proposals of the current period
+   * are validated right away on a worker, so consensus steps find them already validated
    *
    * @param proposed_block
    */
@@ -366,11 +397,23 @@ class PbftManager {
    */
   std::chrono::milliseconds elapsedTimeInMs(const time_point &start_time);
 
+  /**
+   * @brief Records time spent in the current step into stage timings, called when the step is left
+   */
+  void recordStepDuration_();
+
   /**
    * @brief Time to sleep for PBFT protocol
    */
   void sleep_();
 
+  /**
+   * @brief Waits for wakeUp() call or stop
+   * @param timeout
+   * @return true if woken up by wakeUp()
+   */
+  bool waitForEvent_(std::chrono::milliseconds timeout);
+
   /**
    * @brief Set PBFT filter state
    */
@@ -381,6 +424,13 @@ class PbftManager {
    */
   void setCertifyState_();
 
+  /**
+   * @brief Time to wait for proposals in filter step, protocol 2 * lambda unless adaptive step timing is enabled and
+   *        enough proposal vote arrivals were measured
+   * @return filter step time
+   */
+  std::chrono::milliseconds getFilterStepTime_() const;
+
   /**
    * @brief Set PBFT finish state
    */
@@ -508,10 +558,11 @@ class PbftManager {
    *        - node has all DAG blocks with correct ordering,
    *        - node has all reward votes
    *        - total gas estimation is not greater than gas limit
+   * @note Thread safe, it is called by pbft thread and by proposals validation workers
    * @param pbft_block PBFT block
-   * @return true if pbft block is valid, otherwise false
+   * @return dag blocks order and transactions of pbft block if it is valid, otherwise nullptr
    */
-  bool validatePbftBlock(const std::shared_ptr<PbftBlock> &pbft_block) const;
+  std::shared_ptr<const ValidatedBlockData> validatePbftBlock(const std::shared_ptr<PbftBlock> &pbft_block) const;
 
   /**
    * @brief Validates pbft block final chain hash.
@@ -539,6 +590,13 @@ class PbftManager {
   bool pushCertVotedPbftBlockIntoChain_(const std::shared_ptr<PbftBlock> &pbft_block,
                                         std::vector<std::shared_ptr<PbftVote>> &&current_round_cert_votes);
 
+  /**
+   * @brief Starts assembling transactions of the 2t+1 soft voted block in background, so that they are ready once the
+   * block gets cert voted
+   * @param pbft_block soft voted PBFT block, already validated
+   */
+  void preassemblePeriodData(const std::shared_ptr<PbftBlock> &pbft_block);
+
   /**
    * @brief Final chain executes a finalized PBFT block
    * @param period_data PBFT block, cert votes, DAG blocks, and transactions
@@ -576,14 +634,18 @@ class PbftManager {
   std::optional<std::pair<PeriodData, std::vector<std::shared_ptr<PbftVote>>>> processPeriodData();
 
   /**
-   * @brief Validates PBFT block cert votes
+   * @brief Validates PBFT block cert votes, votes that were already verified are replaced by their verified instances
+   * and not validated again, the rest is validated in parallel
    * @param pbft_block
    * @param cert_votes
+   * @param trusted_votes votes were synced from a trusted upstream node, their signatures and vrf proofs are not
+   * verified
    *
    * @return true if there is enough(2t+1) votes and all of them are valid, otherwise false
    */
   bool validatePbftBlockCertVotes(const std::shared_ptr<PbftBlock> pbft_block,
-                                  const std::vector<std::shared_ptr<PbftVote>> &cert_votes) const;
+                                  std::vector<std::shared_ptr<PbftVote>> &cert_votes,
+                                  bool trusted_votes = false) const;
 
   /**
    @brief Validates PBFT block pillar votes
@@ -623,8 +685,11 @@ class PbftManager {
   std::atomic<bool> stopped_ = true;
 
   // Multiple proposed pbft blocks could have same dag block anchor at same period so this cache improves retrieval of
-  // dag block order for specific anchor
-  mutable std::unordered_map<blk_hash_t, std::vector<std::shared_ptr<DagBlock>>> anchor_dag_block_order_cache_;
+  // dag block order for specific anchor. Guarded by anchor_dag_block_order_cache_mutex_
+  mutable std::unordered_map<blk_hash_t, std::shared_ptr<const ValidatedBlockData>> anchor_dag_block_order_cache_;
+  // Period of blocks whose anchors are cached
+  mutable PbftPeriod anchor_dag_block_order_cache_period_ = 0;
+  mutable std::mutex anchor_dag_block_order_cache_mutex_;
 
   std::unique_ptr<std::thread> daemon_;
   std::shared_ptr<DbStorage> db_;
@@ -632,19 +697,34 @@ class PbftManager {
   std::shared_ptr<VoteManager> vote_mgr_;
   std::shared_ptr<DagManager> dag_mgr_;
   std::weak_ptr<Network> network_;
+  std::shared_ptr<util::StageTimings> stage_timings_;
   std::shared_ptr<TransactionManager> trx_mgr_;
   std::shared_ptr<final_chain::FinalChain> final_chain_;
   std::shared_ptr<pillar_chain::PillarChainManager> pillar_chain_mgr_;
 
-  const uint32_t kSyncingThreadPoolSize;
-  std::shared_ptr<util::ThreadPool>
-      sync_thread_pool_;  // Thread pool used for transaction sender retrieval in syncing blocks
+  const uint32_t kSyncingTasksCount;
+  // Signatures pre-verification of syncing blocks
+  util::Executor sync_executor_{util::TaskClass::Network};
+  // Early validation of received proposed blocks
+  util::Executor proposals_validation_executor_{util::TaskClass::Consensus};
+  std::atomic<uint32_t> pending_proposals_validations_ = 0;
+
+  // Dag blocks and ordered transactions of the 2t+1 soft voted block, accessed only by pbft thread. Transactions are
+  // shared with the task assembling them, so replaced data is not freed before the task is done
+  struct PreassembledPeriodData {
+    std::shared_ptr<PbftBlock> pbft_block;
+    std::shared_ptr<const ValidatedBlockData> validated;
+    std::shared_ptr<SharedTransactions> transactions;
+    std::future<void> assembled;
+  };
+  std::optional<PreassembledPeriodData> preassembled_period_data_;
 
   const std::chrono::milliseconds kMaxExponentialLambda{60000};  // [ms], max lambda is 1 minute
 
   uint32_t rounds_count_dynamic_lambda_{0};  // rounds count per cacti_hf.lambda_change_interval blocks
   uint32_t dynamic_lambda_{0};               // [ms] - dynamic lambda that can be anywhere between <500ms, 1500ms>
   std::chrono::milliseconds current_round_lambda_{0};  // [ms] - current round lambda
+  std::chrono::milliseconds filter_step_time_{0};      // [ms] - filter step time of current round
 
   const uint32_t kBroadcastVotesLambdaTime = 20;
   const uint32_t kRebroadcastVotesLambdaTime = 60;
@@ -666,6 +746,7 @@ class PbftManager {
   time_point current_round_start_datetime_;
   time_point current_period_start_datetime_;
   time_point second_finish_step_start_datetime_;
+  time_point current_step_start_datetime_;
   std::chrono::milliseconds next_step_time_ms_{0};
 
   bool executed_pbft_block_ = false;
@@ -682,9 +763,14 @@ class PbftManager {
   const blk_hash_t dag_genesis_block_hash_;
 
   const GenesisConfig &kGenesisConfig;
+  const bool kAdaptiveStepTiming;
+  // Set if node only follows finalized chain of its upstream nodes
+  const std::optional<FollowerConfig> kFollowerConfig;
 
   std::condition_variable stop_cv_;
   std::mutex stop_mtx_;
+  // Set by wakeUp(), protected by stop_mtx_
+  bool woken_up_ = false;
 
   PeriodDataQueue sync_queue_;
 
@@ -3,7 +3,10 @@
 #include <libp2p/Host.h>
 
 #include <deque>
+#include <future>
 
+#include "common/lock_profiler.hpp"
+#include "common/memory_usage.hpp"
 #include "pbft/period_data.hpp"
 
 namespace taraxa {
@@ -27,13 +30,15 @@ class PeriodDataQueue {
    * @param node_id peer node ID
    * @param max_pbft_size maximum PBFT chain size
    * @param cert_votes cert votes
+   * @param pre_verification pending pre-verification of period_data and cert_votes, it must not touch them once ready
    * @return true if pushed
    */
   bool push(PeriodData &&period_data, const dev::p2p::NodeID &node_id, uint64_t max_pbft_size,
-            std::vector<std::shared_ptr<PbftVote>> &&cert_votes);
+            std::vector<std::shared_ptr<PbftVote>> &&cert_votes, std::shared_future<void> pre_verification = {});
 
   /**
    * @brief Pop the first block from syncing queue
+   * @note Waits for pre-verification of the block and of the votes for the block
    * @return the first block, votes for the block if they are available and peer node ID
    */
   std::tuple<PeriodData, std::vector<std::shared_ptr<PbftVote>>, dev::p2p::NodeID> pop();
@@ -61,6 +66,11 @@ class PeriodDataQueue {
    */
   uint64_t getPeriod() const;
 
+  /**
+   * @return approximate memory used by queued period data in bytes
+   */
+  size_t memoryUsage() const { return memory_usage_.bytes(); }
+
   /**
    * @brief Get last pbft block from queue
    * @return last block or nullptr if queue empty
@@ -74,12 +84,24 @@ class PeriodDataQueue {
   void cleanOldData(uint64_t period);
 
  private:
-  std::deque<std::pair<PeriodData, dev::p2p::NodeID>> queue_;
+  struct QueuedPeriodData {
+    PeriodData period_data;
+    dev::p2p::NodeID node_id;
+    // Pre-verification of period data, previous block cert votes included
+    std::shared_future<void> pre_verification;
+    size_t memory_usage = 0;
+  };
+
+  void popFront();
+
+  std::deque<QueuedPeriodData> queue_;
   // We need this variable as for small amount of time block is not part of queue but still being processed
   uint64_t period_{0};
-  mutable std::shared_mutex queue_access_;
+  mutable util::ProfiledSharedMutex queue_access_{"period_data_queue"};
   // Once fully synced, this will keep the cert votes for the last block in the chain
   std::vector<std::shared_ptr<PbftVote>> last_block_cert_votes_;
+  std::shared_future<void> last_block_cert_votes_pre_verification_;
+  util::MemoryUsage memory_usage_;
 };
 
 /** @}*/
@@ -9,9 +9,21 @@
 
 namespace taraxa {
 
+class DagBlock;
 class PbftBlock;
 class Vote;
 
+/**
+ * @brief Work done by validation of a proposed block that is reused once the block is pushed into chain
+ */
+struct ValidatedBlockData {
+  // Dag blocks ordered by the block anchor, empty for blocks with null anchor
+  std::vector<std::shared_ptr<DagBlock>> dag_blocks;
+  // Unique transactions of the dag blocks in order of their first appearance
+  std::vector<trx_hash_t> transactions;
+  blk_hash_t order_hash;
+};
+
 /**
  * @brief class ProposedBlocks holds proposed pbft blocks together with propose votes hashes per period & round
  */
@@ -28,11 +40,22 @@ class ProposedBlocks {
   bool pushProposedPbftBlock(const std::shared_ptr<PbftBlock>& proposed_block, bool save_to_db = true);
 
   /**
-   * @brief Mark block as valid - no need to validate it again
+   * @brief Mark block as valid - no need to validate it again. Block that was already cleaned up is ignored, block
+   * could be validated on another thread while its period was finalized
    *
    * @param proposed_block
+   * @param data validation results
+   */
+  void markBlockAsValid(const std::shared_ptr<PbftBlock>& proposed_block,
+                        std::shared_ptr<const ValidatedBlockData> data);
+
+  /**
+   * @param period
+   * @param block_hash
+   * @return validation results of a valid proposed block, nullptr if block was not validated yet
    */
-  void markBlockAsValid(const std::shared_ptr<PbftBlock>& proposed_block);
+  std::shared_ptr<const ValidatedBlockData> getValidatedBlockData(PbftPeriod period,
+                                                                  const blk_hash_t& block_hash) const;
 
   /**
    * @brief Get a proposed PBFT block based on specified period and block hash
@@ -71,8 +94,11 @@ class ProposedBlocks {
   std::map<PbftPeriod, std::vector<std::shared_ptr<PbftBlock>>> getProposedBlocks() const;
 
  private:
-  // <PBFT period, <block hash, [block, is_valid_flag]>>
-  std::map<PbftPeriod, std::unordered_map<blk_hash_t, std::pair<std::shared_ptr<PbftBlock>, bool>>> proposed_blocks_;
+  using Entry = std::pair<std::shared_ptr<PbftBlock>, std::shared_ptr<const ValidatedBlockData>>;
+  const Entry* find(PbftPeriod period, const blk_hash_t& block_hash) const;
+
+  // <PBFT period, <block hash, [block, validation results - nullptr if not validated yet]>>
+  std::map<PbftPeriod, std::unordered_map<blk_hash_t, Entry>> proposed_blocks_;
   mutable std::shared_mutex proposed_blocks_mutex_;
   std::shared_ptr<DbStorage> db_;
 };
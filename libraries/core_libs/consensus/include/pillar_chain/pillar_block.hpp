@@ -3,7 +3,9 @@
 #include <json/value.h>
 #include <libdevcore/RLP.h>
 
+#include <memory>
 #include <shared_mutex>
+#include <string>
 
 #include "common/encoding_rlp.hpp"
 #include "common/types.hpp"
@@ -152,6 +154,24 @@ struct PillarBlockData {
   const static size_t kRlpItemCount = 2;
 };
 
+/**
+ * @brief Finalized pillar block data serialized once for all rpc requests and subscriptions, finalized data never
+ * changes. Json variants are kept as values for jsonrpc handlers and as strings for responses written directly
+ */
+struct SerializedPillarBlockData {
+  explicit SerializedPillarBlockData(const PillarBlockData& data);
+
+  PbftPeriod period;
+  Json::Value json;
+  Json::Value json_with_signatures;
+  std::shared_ptr<const std::string> json_str;
+  std::shared_ptr<const std::string> json_with_signatures_str;
+  // Rlp of the pillar block
+  std::shared_ptr<const std::string> rlp;
+  // Rlp of PillarBlockData, pillar block with its votes
+  std::shared_ptr<const std::string> rlp_with_signatures;
+};
+
 struct CurrentPillarBlockDataDb {
   std::shared_ptr<pillar_chain::PillarBlock> pillar_block;
   std::vector<state_api::ValidatorVoteCount> vote_counts;
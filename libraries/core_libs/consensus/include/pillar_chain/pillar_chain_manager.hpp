@@ -3,6 +3,7 @@
 #include <memory>
 
 #include "common/event.hpp"
+#include "common/util.hpp"
 #include "final_chain/data.hpp"
 #include "logger/logger.hpp"
 #include "pillar_chain/pillar_block.hpp"
@@ -30,7 +31,7 @@ namespace taraxa::pillar_chain {
  */
 class PillarChainManager {
  private:
-  const util::event::EventEmitter<const PillarBlockData&> pillar_block_finalized_emitter_{};
+  const util::event::EventEmitter<std::shared_ptr<const SerializedPillarBlockData>> pillar_block_finalized_emitter_{};
 
  public:
   const decltype(pillar_block_finalized_emitter_)::Subscriber& pillar_block_finalized_ =
@@ -90,6 +91,12 @@ class PillarChainManager {
    */
   bool validatePillarVote(const std::shared_ptr<PillarVote> vote) const;
 
+  /**
+   * @param vote
+   * @return true if the same vote was already validated and added, e.g. received in gossip
+   */
+  bool isPillarVoteVerified(const std::shared_ptr<PillarVote>& vote) const;
+
   /**
    * @return true if block_hash is the latest finalized pillar block
    */
@@ -100,6 +107,32 @@ class PillarChainManager {
    */
   std::shared_ptr<PillarBlock> getLastFinalizedPillarBlock() const;
 
+  /**
+   * @param period pillar block period
+   * @return serialized finalized pillar block with its votes, nullptr if it is not finalized
+   */
+  std::shared_ptr<const SerializedPillarBlockData> getPillarBlockData(PbftPeriod period) const;
+
+  /**
+   * @brief Finalized pillar blocks from the first pillar block period at or after from, ending at the last finalized
+   * pillar block or at the first missing one
+   *
+   * @param from
+   * @param count max number of returned pillar blocks
+   * @return serialized pillar blocks ordered by period
+   */
+  std::vector<std::shared_ptr<const SerializedPillarBlockData>> getPillarBlocksData(PbftPeriod from,
+                                                                                    size_t count) const;
+
+  /**
+   * @brief Verifies local state against the last finalized pillar block, which serves as checkpoint signed by
+   *        validators. Meant for nodes bootstrapped from a copied db snapshot instead of syncing from genesis
+   *
+   * @return false if state root of the final chain block differs from the pillar block or the pillar block
+   *         is not certified by pillar votes stored in the next period data
+   */
+  bool verifyStateCheckpoint() const;
+
   /**
    * @brief Add a vote to the pillar votes map
    * @param vote vote
@@ -192,6 +225,10 @@ class PillarChainManager {
   // Protects last_finalized_pillar_block_ & current_pillar_block_
   mutable std::shared_mutex mutex_;
 
+  // Bridge relayers read the same recent pillar blocks all the time, a few hundred of them are kept serialized
+  static constexpr uint32_t kPillarBlocksDataCacheSize = 256;
+  mutable ExpirationCacheMap<PbftPeriod, std::shared_ptr<const SerializedPillarBlockData>> pillar_blocks_data_cache_;
+
   LOG_OBJECTS_DEFINE
 };
 
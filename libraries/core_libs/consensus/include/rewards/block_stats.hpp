@@ -26,6 +26,21 @@ class BlockStats {
   BlockStats(const PeriodData& block, uint32_t blocks_per_year, const std::vector<gas_t>& trxs_gas_used,
              uint64_t dpos_vote_count, uint32_t committee_size, const bool aspen_dag_rewards = false);
 
+  /**
+   * @brief Same as above, but without transactions fees, which are known only after block execution and are set
+   *        later with setTransactionsFees. Depends only on period data, so it can be run in parallel with execution
+   */
+  BlockStats(const PeriodData& block, uint32_t blocks_per_year, uint64_t dpos_vote_count, uint32_t committee_size,
+             const bool aspen_dag_rewards = false);
+
+  /**
+   * @brief Adds fees of rewarded transactions to their validators stats
+   *
+   * @param transactions collection with transactions included in the block
+   * @param trxs_gas_used collection with gas used by transactions, fees are zero if empty
+   */
+  void setTransactionsFees(const SharedTransactions& transactions, const std::vector<gas_t>& trxs_gas_used);
+
   /**
    * @return blocks per year
    */
@@ -57,16 +72,8 @@ class BlockStats {
   void processDagBlocksAspen(const PeriodData& block);
 
   /**
-   * @brief Prepare fee_by_trx_hash_ map with trx fee by trx hash
-   *
-   * @param transactions collection with transactions included in the block
-   * @param trxs_gas_used collection with gas used by transactions
-   */
-  void initFeeByTrxHash(const SharedTransactions& transactions, const std::vector<gas_t>& trxs_gas_used);
-
-  /**
-   * @brief In case unique trx_hash is provided, it is mapped to it's validator's address + validator's unique trxs
-   * count is incremented. If provided trx_hash was already processed, nothing happens
+   * @brief In case unique trx_hash is provided, it is mapped to it's validator's address, fee is added to validator
+   * once it is known. If provided trx_hash was already processed, nothing happens
    *
    * @param trx_hash
    * @param validator
@@ -103,8 +110,11 @@ class BlockStats {
   // and introduction of dynamic lambda
   uint32_t blocks_per_year_{0};
 
-  // Fee by trx : trx hash -> fee
-  std::unordered_map<trx_hash_t, u256> fee_by_trx_hash_;
+  // Not yet rewarded transactions of block : trx hash -> position in block, used only during processing
+  std::unordered_map<trx_hash_t, uint32_t> trx_position_by_hash_;
+
+  // Rewarded transactions : position in block -> validator, whose fee is added by setTransactionsFees
+  std::vector<std::pair<uint32_t, addr_t>> rewarded_transactions_;
 
   // Validator stats: validator -> ValidatorStats
   std::unordered_map<addr_t, ValidatorStats> validators_stats_;
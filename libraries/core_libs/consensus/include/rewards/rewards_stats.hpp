@@ -23,6 +23,22 @@ class Stats {
    */
   std::vector<BlockStats> processStats(const PeriodData& current_blk, uint32_t blocks_per_year,
                                        const std::vector<gas_t>& trxs_gas_used, Batch& write_batch);
+
+  /**
+   * @brief Same as above, but with block stats made by prepareBlockStats, so only transactions fees are added here
+   * @param block_stats stats of current_blk without transactions fees
+   */
+  std::vector<BlockStats> processStats(const PeriodData& current_blk, BlockStats&& block_stats,
+                                       const std::vector<gas_t>& trxs_gas_used, Batch& write_batch);
+
+  /**
+   * @brief makes block stats without transactions fees. Doesn't modify any state and doesn't depend on block
+   * execution, so it could be called in parallel with transactions execution
+   * @param current_blk block to process
+   * @param blocks_per_year - expected number of blocks generated per year based on pbft block dynamic lambda
+   * @return block statistics without transactions fees
+   */
+  BlockStats prepareBlockStats(const PeriodData& current_blk, uint32_t blocks_per_year) const;
   /**
    * @brief called on start of new rewards interval. clears blocks_stats_ collection
    * and removes all data saved in db column
@@ -35,15 +51,6 @@ class Stats {
    */
   void recoverFromDb(EthBlockNumber last_blk_num);
 
-  /*
-   * @brief gets all needed data and makes(processes) BlocksStats
-   * @param current_blk block to process
-   * @param blocks_per_year - expected number of blocks generated per year based on pbft block dynamic lambda
-   * @return block statistics needed for rewards distribution
-   */
-  BlockStats getBlockStats(const PeriodData& current_blk, uint32_t blocks_per_year,
-                           const std::vector<gas_t>& trxs_fees);
-
   const uint32_t kCommitteeSize;
   const HardforksConfig kHardforksConfig;
   std::shared_ptr<DbStorage> db_;
@@ -1,11 +1,12 @@
 #pragma once
 
+#include "common/scheduler.hpp"
 #include "final_chain/final_chain.hpp"
 #include "transaction/gas_pricer.hpp"
 #include "transaction/transaction_manager.hpp"
 
 namespace taraxa {
-class SlashingManager {
+class SlashingManager : public std::enable_shared_from_this<SlashingManager> {
  public:
   SlashingManager(const FullNodeConfig &config, std::shared_ptr<final_chain::FinalChain> final_chain,
                   std::shared_ptr<TransactionManager> trx_manager, std::shared_ptr<GasPricer> gas_pricer);
@@ -16,6 +17,15 @@ class SlashingManager {
 
   bool submitDoubleVotingProof(const std::shared_ptr<PbftVote> &vote_a, const std::shared_ptr<PbftVote> &vote_b);
 
+  /**
+   * @brief Submits double voting proof on background executor, so votes processing does not wait for proof
+   *        transaction to be created, signed and inserted into the pool
+   *
+   * @param vote_a
+   * @param vote_b
+   */
+  void postDoubleVotingProof(const std::shared_ptr<PbftVote> &vote_a, const std::shared_ptr<PbftVote> &vote_b);
+
  private:
   std::shared_ptr<final_chain::FinalChain> final_chain_;
   std::shared_ptr<TransactionManager> trx_manager_;
@@ -25,5 +35,7 @@ class SlashingManager {
   ExpirationCache<dev::h256> double_voting_proofs_;
 
   const FullNodeConfig &kConfig;
+
+  util::Executor proofs_executor_{util::TaskClass::Background};
 };
 }  // namespace taraxa
\ No newline at end of file
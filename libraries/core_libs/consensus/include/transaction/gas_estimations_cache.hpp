@@ -0,0 +1,49 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "common/types.hpp"
+#include "final_chain/state_api_data.hpp"
+#include "transaction/transaction.hpp"
+
+namespace taraxa {
+
+/** @addtogroup Transaction
+ * @{
+ */
+
+/**
+ * @brief Results of transactions dry runs keyed by transaction hash and proposal period. Shared by packing of proposed
+ * DAG blocks and verification of received ones, so a transaction included in several blocks with the same proposal
+ * period is run once
+ *
+ * Estimations of finalized transactions and of old proposal periods are dropped as periods are finalized. Size is
+ * bounded, the oldest proposal periods are evicted first as new blocks use the most recent ones
+ */
+class GasEstimationsCache {
+ public:
+  explicit GasEstimationsCache(size_t max_size);
+
+  std::optional<state_api::ExecutionResult> get(const trx_hash_t &trx_hash, PbftPeriod proposal_period) const;
+  void insert(const trx_hash_t &trx_hash, PbftPeriod proposal_period, state_api::ExecutionResult result);
+
+  /**
+   * @brief Drops estimations of finalized transactions and of proposal periods older than min_proposal_period
+   */
+  void periodFinalized(const SharedTransactions &finalized_trxs, PbftPeriod min_proposal_period);
+
+  size_t size() const;
+
+ private:
+  const size_t kMaxSize;
+  mutable std::shared_mutex mutex_;
+  std::map<PbftPeriod, std::unordered_map<trx_hash_t, state_api::ExecutionResult>> estimations_;
+  size_t size_ = 0;
+};
+
+/** @}*/
+
+}  // namespace taraxa
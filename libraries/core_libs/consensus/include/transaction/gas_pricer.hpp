@@ -1,6 +1,7 @@
 #pragma once
 
 #include <boost/circular_buffer.hpp>
+#include <set>
 #include <shared_mutex>
 
 #include "config/genesis.hpp"
@@ -17,8 +18,10 @@ class TransactionManager;
 
 /**
  * @brief Basic gas price calculator. We calculate the gas price based on the lowest price in last number_of_blocks
- * blocks. Then all of those values are sorted and current price is selected based on percentile
+ * blocks. Current price is selected from those values based on percentile
  *
+ * Window prices are split into two ordered sets around the percentile, so each update is O(log n). Window is persisted
+ * in final_chain_meta column, on start only periods finalized after it was saved are decoded
  */
 class GasPricer {
  public:
@@ -42,8 +45,9 @@ class GasPricer {
    * @brief updates gas price after each executed block
    *
    * @param trxs from latest block
+   * @param block_number of latest block, prices window is persisted if set and db was provided
    */
-  void update(const SharedTransactions &trxs);
+  void update(const SharedTransactions &trxs, EthBlockNumber block_number = 0);
 
  private:
   /**
@@ -53,6 +57,22 @@ class GasPricer {
    */
   void init(const std::shared_ptr<DbStorage> &db);
 
+  /**
+   * @brief adds price to the window, evicting the oldest one if window is full. Must be called with mutex_ locked
+   */
+  void addPrice(const u256 &price);
+
+  /**
+   * @brief moves prices between lower_prices_ and upper_prices_ so that percentile is the highest of lower_prices_
+   * and updates latest_price_. Must be called with mutex_ locked
+   */
+  void updateLatestPrice();
+
+  /**
+   * @return rlp of last block number and window prices from the oldest one. Must be called with mutex_ locked
+   */
+  bytes windowRlp(EthBlockNumber block_number) const;
+
   const uint64_t kPercentile;
   const u256 kMinimumPrice;
   const bool kIsLightNode;
@@ -60,10 +80,15 @@ class GasPricer {
   mutable std::shared_mutex mutex_;
   u256 latest_price_;
   boost::circular_buffer<u256> price_list_;
+  // Window prices up to and including the percentile one
+  std::multiset<u256> lower_prices_;
+  // Window prices above the percentile one
+  std::multiset<u256> upper_prices_;
 
   std::unique_ptr<std::thread> init_daemon_;
   const bool kBlocksGasPricer;
   std::shared_ptr<TransactionManager> trx_mgr_;
+  std::shared_ptr<DbStorage> db_;
 };
 
 /** @}*/
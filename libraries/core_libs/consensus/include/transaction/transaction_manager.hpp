@@ -3,11 +3,13 @@
 #include <cstddef>
 
 #include "common/event.hpp"
+#include "common/lock_profiler.hpp"
 #include "common/thread_pool.hpp"
 #include "common/util.hpp"
 #include "final_chain/final_chain.hpp"
 #include "logger/logger.hpp"
 #include "storage/storage.hpp"
+#include "transaction/gas_estimations_cache.hpp"
 #include "transaction/transaction.hpp"
 #include "transaction_queue.hpp"
 
@@ -57,13 +59,20 @@ class TransactionManager : public std::enable_shared_from_this<TransactionManage
                      std::shared_ptr<final_chain::FinalChain> final_chain, addr_t node_addr);
 
   /**
-   * @brief Estimates required gas value to execute transactions
+   * @brief Estimates required gas value to execute transactions, cached estimations are shared with packTrxs
    * @param trxs transactions
    * @param proposal_period proposal period
    * @return estimated gas value for transactions
    */
   uint64_t estimateTransactions(const SharedTransactions &trxs, PbftPeriod proposal_period);
 
+  /**
+   * @brief Recovers senders of transactions in parallel, result of recovery is cached in each transaction so later
+   *        getSender calls are cheap. Invalid signatures are not reported here, they are detected in verifyTransaction
+   * @param trxs transactions
+   */
+  void recoverSenders(const SharedTransactions &trxs);
+
   /**
    * @brief Estimates required gas value to execute transaction
    * @param trx transaction
@@ -72,6 +81,16 @@ class TransactionManager : public std::enable_shared_from_this<TransactionManage
    */
   state_api::ExecutionResult estimateTransactionGas(std::shared_ptr<Transaction> trx, PbftPeriod proposal_period);
 
+  /**
+   * @brief Estimates required gas value to execute each of the transactions. Transactions which are not cached are
+   *        dry run in batches on estimation thread pool against the state of the same block
+   * @param trxs transactions
+   * @param proposal_period proposal period
+   * @return estimations in the order of trxs
+   */
+  std::vector<state_api::ExecutionResult> estimateTransactionsGas(const SharedTransactions &trxs,
+                                                                  PbftPeriod proposal_period);
+
   /**
    * @brief Gets transactions from pool to include in the block with specified weight limit
    * @param proposal_period proposal period
@@ -86,6 +105,13 @@ class TransactionManager : public std::enable_shared_from_this<TransactionManage
    */
   std::vector<SharedTransactions> getAllPoolTrxs();
 
+  /**
+   * @brief Gets pool transactions inserted after the insertion sequence number grouped per account
+   * @param sequence last insertion sequence number already processed by the caller
+   * @return transactions and sequence number of the last insertion into the pool
+   */
+  std::pair<std::vector<SharedTransactions>, uint64_t> getPoolTrxsInsertedAfter(uint64_t sequence);
+
   /**
    * Saves transactions from dag block which was added to the DAG. Removes transactions from memory pool
    */
@@ -116,6 +142,20 @@ class TransactionManager : public std::enable_shared_from_this<TransactionManage
    */
   TransactionStatus insertValidatedTransaction(std::shared_ptr<Transaction> &&tx, bool insert_non_proposable = true);
 
+  /**
+   * @brief Inserts batch of verified transactions to transaction pool
+   *
+   * Sender accounts are read once per sender before transactions_mutex_ is taken, the lock is then taken once for
+   * the whole batch. Account state can change right after the insert anyway, so proposable flag computed before the
+   * lock is as good as one computed under it.
+   *
+   * @param txs transactions to be processed
+   * @param insert_non_proposable insert non proposable transactions
+   * @return status of each transaction in txs order
+   */
+  std::vector<TransactionStatus> insertValidatedTransactions(SharedTransactions &&txs,
+                                                             bool insert_non_proposable = true);
+
   /**
    * @param trx_hash transaction hash
    * @return Returns true if tx is known (was successfully verified and pushed into the tx pool), oth
@@ -124,6 +164,18 @@ class TransactionManager : public std::enable_shared_from_this<TransactionManage
 
   size_t getTransactionPoolSize() const;
 
+  /**
+   * @param sender
+   * @return nonce following the highest nonce transaction of the sender in the pool, nullopt if it has none. Does not
+   *         take transactions_mutex_
+   */
+  std::optional<trx_nonce_t> getPendingNonce(const addr_t &sender) const;
+
+  /**
+   * @return approximate memory used by transactions pool in bytes
+   */
+  size_t getTransactionPoolMemoryUsage() const;
+
   /**
    * @brief return true if transaction pool is full
    *
@@ -188,7 +240,8 @@ class TransactionManager : public std::enable_shared_from_this<TransactionManage
   /**
    * @brief Updates the status of transactions to finalized
    * IMPORTANT: This method is invoked on finalizing a pbft block, it needs to be protected with transactions_mutex_ but
-   * the mutex is locked from pbft manager for the entire pbft finalization process to make the finalization atomic
+   * the mutex is locked from pbft manager for the entire pbft finalization process to make the finalization atomic.
+   * Finalized transactions are removed from the memory pool asynchronously afterwards
    *
    * @param period_data period data
    * @return number of dag blocks finalized
@@ -216,7 +269,7 @@ class TransactionManager : public std::enable_shared_from_this<TransactionManage
    *
    * @return mutex
    */
-  std::shared_mutex &getTransactionsMutex() { return transactions_mutex_; }
+  util::ProfiledSharedMutex &getTransactionsMutex() { return transactions_mutex_; }
 
   /**
    * @brief Gets transactions from transactions pool
@@ -246,6 +299,11 @@ class TransactionManager : public std::enable_shared_from_this<TransactionManage
   std::shared_ptr<Transaction> getNonFinalizedTransaction(const trx_hash_t &hash) const;
   unsigned long getTransactionCount() const;
   void recoverNonfinalizedTransactions();
+  /**
+   * @brief Saves hashes and senders of non finalized transactions, so that next start can skip finalization check
+   *        and sender recovery for them. Called on clean shutdown
+   */
+  void saveStartupSnapshot() const;
   /**
    * @brief Verifies a transaction
    *
@@ -266,22 +324,33 @@ class TransactionManager : public std::enable_shared_from_this<TransactionManage
   // Guards updating transaction status
   // Transactions can be in one of three states:
   // 1. In transactions pool; 2. In non-finalized Dag block 3. Executed
-  mutable std::shared_mutex transactions_mutex_;
+  mutable util::ProfiledSharedMutex transactions_mutex_{"transaction_manager"};
   TransactionQueue transactions_pool_;
   std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> nonfinalized_transactions_in_dag_;
   std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> recently_finalized_transactions_;
   std::unordered_map<PbftPeriod, std::vector<trx_hash_t>> recently_finalized_transactions_per_period_;
-  ExpirationCacheMap<trx_hash_t, state_api::ExecutionResult> estimations_cache_;
+  GasEstimationsCache estimations_cache_;
   uint64_t trx_count_ = 0;
 
   const uint64_t kDagBlockGasLimit;
   const uint64_t kEstimateGasLimit = 200000;
   const uint64_t kRecentlyFinalizedTransactionsMax = 50000;
+  // Estimations of proposal periods this far behind the last finalized one are dropped
+  const PbftPeriod kEstimationsCachePeriods = 100;
+  // Batches smaller than this are recovered lazily on the calling thread
+  const size_t kMinParallelSenderRecovery = 16;
+  // Minimal number of transactions dry run in a single estimation task
+  const size_t kMinParallelEstimations = 8;
+  // Number of transactions estimated at once while packing transactions
+  const size_t kPackEstimationBatchSize = 64;
 
   std::shared_ptr<DbStorage> db_{nullptr};
   std::shared_ptr<final_chain::FinalChain> final_chain_{nullptr};
 
   util::ThreadPool estimation_thread_pool_;
+  const unsigned kSenderRecoveryThreads;
+  // Removes finalized transactions from the pool, single thread keeps the order of finalized blocks
+  util::ThreadPool pool_cleanup_thread_{1};
 
   LOG_OBJECTS_DEFINE
 
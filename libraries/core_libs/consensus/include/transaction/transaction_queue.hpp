@@ -1,6 +1,14 @@
 #pragma once
 
+#include <deque>
+#include <map>
+#include <optional>
+#include <set>
+#include <shared_mutex>
+#include <unordered_set>
+
 #include "common/constants.hpp"
+#include "common/hash_interner.hpp"
 #include "common/util.hpp"
 #include "transaction/transaction.hpp"
 
@@ -11,6 +19,7 @@ namespace taraxa {
  */
 
 enum class TransactionStatus;
+class DbStorage;
 namespace final_chain {
 class FinalChain;
 }
@@ -23,13 +32,18 @@ class FinalChain;
  * transactions. Non proposable transactions can expire if no DAG block that contains them is received within the
  * kNonProposableTransactionsPeriodExpiryLimit.
  *
+ * Pool memory is bounded by encoded transactions size: once proposable transactions go over kMaxDataSize lowest
+ * priority ones are evicted and once non proposable transactions go over their share of it they are spilled to the
+ * pool_spilled_transactions db column, only hash and expiry are kept in memory for them.
+ *
  * This is NOT thread safe class. It is proteced only by transactions_mutex_
  * in the TransactionsManager !!!
  *
  */
 class TransactionQueue {
  public:
-  TransactionQueue(std::shared_ptr<final_chain::FinalChain> final_chain, size_t max_size = kMinTransactionPoolSize);
+  TransactionQueue(std::shared_ptr<final_chain::FinalChain> final_chain, size_t max_size = kMinTransactionPoolSize,
+                   std::shared_ptr<DbStorage> db = nullptr);
 
   /**
    * @brief insert a transaction into the queue, sorted by priority
@@ -58,8 +72,8 @@ class TransactionQueue {
   std::shared_ptr<Transaction> get(const trx_hash_t& hash) const;
 
   /**
-   * @brief returns up to the number of requested transaction sorted by priority. This call actually sorts the
-   * transaction so it is expensive and should be used only when needed
+   * @brief returns up to the number of requested transaction sorted by priority. Account heads are kept ordered by gas
+   * price in account_heads_ so only the returned transactions are visited
    *
    * @param count
    * @return std::vector<std::shared_ptr<Transaction>>
@@ -73,6 +87,16 @@ class TransactionQueue {
    */
   std::vector<SharedTransactions> getAllTransactions() const;
 
+  /**
+   * @brief returns transactions inserted after the sequence number that are still in the queue, grouped by
+   * transactions author and ordered by nonce. If the insertion log no longer reaches back to the sequence all
+   * transactions are returned
+   *
+   * @param sequence last insertion sequence number already processed by the caller
+   * @return transactions and sequence number of the last insertion
+   */
+  std::pair<std::vector<SharedTransactions>, uint64_t> getTransactionsInsertedAfter(uint64_t sequence) const;
+
   /**
    * @brief returns true/false if the transaction is in the queue
    *
@@ -117,6 +141,14 @@ class TransactionQueue {
    */
   bool isTransactionKnown(const trx_hash_t& trx_hash) const;
 
+  /**
+   * @brief Returns nonce following the highest nonce proposable transaction of the sender in the queue
+   * This call is thread-safe
+   * @param sender
+   * @return next nonce, nullopt if there is no transaction of the sender in the queue
+   */
+  std::optional<trx_nonce_t> getPendingNonce(const addr_t& sender) const;
+
   /**
    * @brief Have transactions been recently dropped due to queue reaching max size
    * This call is thread-safe
@@ -134,6 +166,27 @@ class TransactionQueue {
    */
   bool nonProposableTransactionsOverTheLimit() const;
 
+  /**
+   * @brief Returns size of encoded transactions kept in memory
+   *
+   * @return size in bytes
+   */
+  size_t dataSize() const { return data_size_; }
+
+  /**
+   * @brief Returns approximate memory used by the queue, derived from tracked data size and element counts
+   *
+   * @return size in bytes
+   */
+  size_t memoryUsage() const;
+
+  /**
+   * @brief Returns number of non proposable transactions spilled to db
+   *
+   * @return size_t
+   */
+  size_t spilledTransactionsCount() const { return spilled_transactions_count_; }
+
   /**
    * @brief Returns minimum gas price needed for transaction to be included
    *  in the next proposed dag block
@@ -158,17 +211,63 @@ class TransactionQueue {
    */
   bool removeTransaction(const SharedTransaction& transaction, bool proposable);
 
+  /**
+   * @brief Non proposable transaction, body is nullptr if it was spilled to db
+   */
+  struct NonProposableTransaction {
+    uint64_t last_block_number = 0;
+    SharedTransaction transaction;
+  };
+  using NonProposableTransactions = std::unordered_map<trx_hash_t, NonProposableTransaction>;
+  using TrxId = util::HashInterner<trx_hash_t>::Id;
+
   /**
    * @brief remove transaction from non proposable transactions
    *
    * @param transaction
-   * @return true if removed
+   * @return iterator following the removed transaction
+   */
+  NonProposableTransactions::iterator removeTransaction(NonProposableTransactions::iterator transaction);
+
+  using AccountTransactions = std::map<val_t, std::shared_ptr<Transaction>>;
+
+  /**
+   * @brief removes account from account_heads_ and account_tails_, must be called before account transactions change
+   *
+   * @param account
+   * @param transactions account transactions ordered by nonce
+   */
+  void unindexAccount(const addr_t& account, const AccountTransactions& transactions);
+
+  /**
+   * @brief adds account to account_heads_ and account_tails_, must be called after account transactions changed
+   *
+   * @param account
+   * @param transactions account transactions ordered by nonce
    */
-  std::unordered_map<taraxa::trx_hash_t, std::pair<uint64_t, taraxa::SharedTransaction>>::iterator removeTransaction(
-      std::unordered_map<taraxa::trx_hash_t, std::pair<uint64_t, taraxa::SharedTransaction>>::iterator transaction);
+  void indexAccount(const addr_t& account, const AccountTransactions& transactions);
 
   // Transactions in the queue per account ordered by nonce
-  std::unordered_map<addr_t, std::map<val_t, std::shared_ptr<Transaction>>> account_nonce_transactions_;
+  std::unordered_map<addr_t, AccountTransactions> account_nonce_transactions_;
+
+  // Next nonce after the highest nonce transaction per account, maintained together with account heads and tails. It
+  // has its own lock, so it can be read without transactions_mutex_ of the TransactionsManager
+  std::unordered_map<addr_t, trx_nonce_t> pending_nonces_;
+  mutable std::shared_mutex pending_nonces_mutex_;
+
+  // Gas price of the lowest nonce transaction per account, highest gas price first
+  std::set<std::pair<val_t, addr_t>, std::greater<std::pair<val_t, addr_t>>> account_heads_;
+
+  // Dense ids of transactions hashes referenced by the secondary indices below, each index entry holds one reference
+  util::HashInterner<trx_hash_t> trx_ids_;
+
+  // Proposable transactions ids in insertion order with their insertion sequence number, removed transactions are
+  // skipped on read. Trimmed from the front once over kInsertionLogMaxSizeMultiplier * kMaxSize
+  std::deque<std::pair<uint64_t, TrxId>> insertion_log_;
+  uint64_t last_insertion_sequence_ = 0;
+
+  // Gas price of the highest nonce transaction per account, lowest gas price first. Used for overflow eviction
+  std::set<std::pair<val_t, addr_t>> account_tails_;
 
   // Transactions in the queue per trx hash
   std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> queue_transactions_;
@@ -178,14 +277,23 @@ class TransactionQueue {
 
   // Low nonce and insufficient balance transactions which should not be included in proposed dag blocks but it is
   // possible because of dag reordering that some dag block might arrive requiring these transactions.
-  std::unordered_map<trx_hash_t, std::pair<uint64_t, std::shared_ptr<Transaction>>> non_proposable_transactions_;
+  NonProposableTransactions non_proposable_transactions_;
+
+  // Non proposable transactions ids per block number they were inserted at, so expiry visits only expired ones
+  std::map<uint64_t, std::unordered_set<TrxId>> non_proposable_transactions_by_block_;
 
-  ExpirationCache<trx_hash_t> known_txs_;
+  // Number of non proposable transactions whose bodies are kept in pool_spilled_transactions db column
+  size_t spilled_transactions_count_ = 0;
+
+  // Size of data for non proposable transactions kept in memory
+  size_t non_proposable_data_size_ = 0;
+
+  ShardedExpirationCache<trx_hash_t> known_txs_;
 
   // Last time transactions were dropped due to queue reaching max size
   std::chrono::system_clock::time_point transaction_overflow_time_;
 
-  // Size of data for transactions in pool
+  // Size of encoded transactions kept in memory
   size_t data_size_ = 0;
 
   // If transactions are dropped within last kTransactionOverflowTimeLimit seconds, dag blocks with missing transactions
@@ -201,6 +309,12 @@ class TransactionQueue {
   // Maximum number of single account transactions in percentage of kMaxSize
   const size_t kSingleAccountTransactionsLimitPercentage = 5;
 
+  // Maximum insertion log size as multiple of kMaxSize
+  const size_t kInsertionLogMaxSizeMultiplier = 2;
+
+  // Maximum number of spilled non proposable transactions as multiple of kNonProposableTransactionsMaxSize
+  const size_t kSpilledTransactionsLimitMultiplier = 5;
+
   // Maximum number of non proposable transactions
   const size_t kNonProposableTransactionsMaxSize;
 
@@ -210,10 +324,16 @@ class TransactionQueue {
   // Maximum data size of transactions pool
   const size_t kMaxDataSize;
 
+  // Maximum data size of non proposable transactions kept in memory, over it they are spilled to db
+  const size_t kNonProposableMaxDataSize;
+
   // Maximum size of single account transactions
   const size_t kMaxSingleAccountTransactionsSize;
 
   std::shared_ptr<final_chain::FinalChain> final_chain_;
+
+  // Optional, without db non proposable transactions are never spilled
+  std::shared_ptr<DbStorage> db_;
 };
 
 /** @}*/
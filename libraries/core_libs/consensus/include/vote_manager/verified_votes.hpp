@@ -1,9 +1,17 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
 #include <shared_mutex>
 #include <unordered_map>
+#include <vector>
 
+#include "common/lock_profiler.hpp"
+#include "common/memory_usage.hpp"
 #include "common/types.hpp"
+#include "config/network.hpp"
 #include "logger/logger.hpp"
 
 namespace taraxa {
@@ -48,17 +56,57 @@ struct RoundVerifiedVotes {
 using RoundVerifiedVotesMap = std::map<PbftRound, RoundVerifiedVotes>;
 using PeriodVerifiedVotesMap = std::map<PbftPeriod, RoundVerifiedVotesMap>;
 
+/**
+ * @brief Verified votes storage
+ *
+ * Votes are kept in a ring of the last kPeriodsRingSize periods indexed by period % kPeriodsRingSize. Each period
+ * slot keeps its rounds behind its own lock and every round keeps its steps (densely indexed by step) behind a
+ * separate lock, so votes for different rounds are processed in parallel and the period lock is taken exclusively
+ * only when a new round is created.
+ */
 class VerifiedVotes {
  public:
+  // Votes are stored for periods from the last cleaned up one up to kPeriodsRingSize - 1 ahead. It has to be bigger
+  // than number of future periods for which votes are accepted (vote_accepting_periods) + 2
+  static constexpr size_t kPeriodsRingSize = DdosProtectionConfig::kMaxVoteAcceptingPeriods + 3;
+
   VerifiedVotes(addr_t node_addr) { LOG_OBJECTS_CREATE("VERIFIED_VOTES"); }
 
   uint64_t size() const;
   std::vector<std::shared_ptr<PbftVote>> votes() const;
 
+  /**
+   * @return approximate memory used by stored votes in bytes
+   */
+  size_t memoryUsage() const { return memory_usage_.bytes(); }
+
   std::optional<const RoundVerifiedVotesMap> getPeriodVotes(PbftPeriod period) const;
   std::optional<const RoundVerifiedVotes> getRoundVotes(PbftPeriod period, PbftRound round) const;
   std::optional<const StepVotes> getStepVotes(PbftPeriod period, PbftRound round, PbftStep step) const;
 
+  /**
+   * @param vote
+   * @return true if vote is already in verified votes
+   */
+  bool containsVote(const std::shared_ptr<PbftVote>& vote) const;
+
+  /**
+   * @param period
+   * @param round
+   * @param step
+   * @param voter
+   * @return votes of voter for specified period, round and step, if present
+   */
+  std::optional<std::pair<std::shared_ptr<PbftVote>, std::shared_ptr<PbftVote>>> getUniqueVoter(
+      PbftPeriod period, PbftRound round, PbftStep step, const addr_t& voter) const;
+
+  /**
+   * @param period
+   * @param round
+   * @return greatest step with t+1 next votes for specified period and round, 0 if there is none
+   */
+  PbftStep getNetworkTPlusOneStep(PbftPeriod period, PbftRound round) const;
+
   std::optional<VotedBlock> getTwoTPlusOneVotedBlock(PbftPeriod period, PbftRound round,
                                                      TwoTPlusOneVotedBlockType type) const;
   std::vector<std::shared_ptr<PbftVote>> getTwoTPlusOneVotedBlockVotes(PbftPeriod period, PbftRound round,
@@ -67,24 +115,51 @@ class VerifiedVotes {
 
   std::optional<std::shared_ptr<PbftVote>> insertUniqueVoter(const std::shared_ptr<PbftVote>& vote);
 
-  std::optional<VotesWithWeight> insertVotedValue(const std::shared_ptr<PbftVote>& vote);
+  /**
+   * @brief Inserts vote into its voted value
+   *
+   * @param vote
+   * @return accumulated weight of the voted value after insertion, empty if vote was not inserted
+   */
+  std::optional<uint64_t> insertVotedValue(const std::shared_ptr<PbftVote>& vote);
 
   void setNetworkTPlusOneStep(std::shared_ptr<PbftVote> vote);
   // Insert new 2t+1 voted block
   void insertTwoTPlusOneVotedBlock(TwoTPlusOneVotedBlockType type, std::shared_ptr<PbftVote> vote);
 
  private:
-  std::pair<bool, PeriodVerifiedVotesMap::iterator> get(PbftPeriod period);
-  std::pair<bool, PeriodVerifiedVotesMap::const_iterator> get(PbftPeriod period) const;
-  std::pair<bool, RoundVerifiedVotesMap::iterator> get(PbftPeriod period, PbftRound round);
-  std::pair<bool, RoundVerifiedVotesMap::const_iterator> get(PbftPeriod period, PbftRound round) const;
-  std::pair<bool, StepVotesMap::iterator> get(PbftPeriod period, PbftRound round, PbftStep step);
-  std::pair<bool, StepVotesMap::const_iterator> get(PbftPeriod period, PbftRound round, PbftStep step) const;
-
-  mutable std::shared_mutex verified_votes_access_;
-  PeriodVerifiedVotesMap verified_votes_;
+  // Steps up to this one are stored in a vector indexed by step, anything above falls back to a map
+  static constexpr PbftStep kDenseStepsCount = 64;
+
+  struct RoundVotes {
+    mutable std::shared_mutex mutex;
+    TwoTVotedBlockMap two_t_plus_one_voted_blocks;
+    std::vector<StepVotes> steps;
+    std::map<PbftStep, StepVotes> sparse_steps;
+    PbftStep network_t_plus_one_step{0};
+    uint64_t votes_count{0};
+
+    const StepVotes* findStep(PbftStep step) const;
+    StepVotes& step(PbftStep step);
+    RoundVerifiedVotes toRoundVerifiedVotes() const;
+  };
+
+  struct PeriodSlot {
+    mutable util::ProfiledSharedMutex mutex{"verified_votes"};
+    std::optional<PbftPeriod> period;
+    std::map<PbftRound, std::shared_ptr<RoundVotes>> rounds;
+  };
+
+  std::shared_ptr<RoundVotes> findRound(PbftPeriod period, PbftRound round) const;
+  std::shared_ptr<RoundVotes> getOrInsertRound(PbftPeriod period, PbftRound round);
+  void subRoundsMemoryUsage(const std::map<PbftRound, std::shared_ptr<RoundVotes>>& rounds);
+
+  std::array<PeriodSlot, kPeriodsRingSize> periods_;
+  // Votes with smaller period were cleaned up, 0 until the first cleanup
+  std::atomic<PbftPeriod> min_period_{0};
+  util::MemoryUsage memory_usage_;
 
   LOG_OBJECTS_DEFINE
 };
 
-}  // namespace taraxa
\ No newline at end of file
+}  // namespace taraxa
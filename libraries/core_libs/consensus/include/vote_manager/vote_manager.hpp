@@ -1,5 +1,17 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <set>
+#include <tuple>
+
+#include "common/event.hpp"
+#include "common/rolling_samples.hpp"
+#include "common/scheduler.hpp"
+#include "common/stage_timings.hpp"
+#include "common/thread_pool.hpp"
 #include "common/util.hpp"
 #include "common/vrf_wrapper.hpp"
 #include "final_chain/final_chain.hpp"
@@ -28,7 +40,14 @@ class TaraxaPeer;
  * @brief VoteManager class manage votes for PBFT consensus
  */
 class VoteManager {
+ protected:
+  util::event::EventEmitter<std::shared_ptr<PbftVote>> const two_t_plus_one_voted_block_emitter_{};
+
  public:
+  // Emitted with the vote that completed new 2t+1 voted block of any type, lets pbft state machine react right away
+  decltype(two_t_plus_one_voted_block_emitter_)::Subscriber const& two_t_plus_one_voted_block_ =
+      two_t_plus_one_voted_block_emitter_;
+
   VoteManager(const FullNodeConfig& config, std::shared_ptr<DbStorage> db, std::shared_ptr<PbftChain> pbft_chain,
               std::shared_ptr<final_chain::FinalChain> final_chain, std::shared_ptr<KeyManager> key_manager,
               std::shared_ptr<SlashingManager> slashing_manager);
@@ -59,6 +78,12 @@ class VoteManager {
    */
   bool voteInVerifiedMap(std::shared_ptr<PbftVote> const& vote) const;
 
+  /**
+   * @param vote
+   * @return verified instance of the same vote if it was already verified, e.g. received in gossip, otherwise nullptr
+   */
+  std::shared_ptr<PbftVote> getVerifiedVote(const std::shared_ptr<PbftVote>& vote) const;
+
   /**
    * @param vote
    * @return <true, nullptr> if vote is unique per round & step & voter, otherwise <false, existing vote>
@@ -77,6 +102,12 @@ class VoteManager {
    */
   uint64_t getVerifiedVotesSize() const;
 
+  /**
+   * @brief Get approximate memory used by verified votes
+   * @return size in bytes
+   */
+  size_t getVerifiedVotesMemoryUsage() const;
+
   /**
    * @brief Cleanup votes for specified PBFT period
    * @param pbft_period current PBFT period
@@ -189,6 +220,18 @@ class VoteManager {
    */
   std::pair<bool, std::string> validateVote(const std::shared_ptr<PbftVote>& vote, bool strict = true) const;
 
+  /**
+   * @brief Validates votes in parallel, total dpos votes count is retrieved only once per period. Only the first vote
+   * with the same hash is validated, the others are reported as invalid duplicates
+   *
+   * @param votes to be validated
+   * @param strict strict validation
+   * @param verify_signatures false if votes come from a trusted source, only their weights are calculated then
+   * @return validation results in the same order as votes, see validateVote
+   */
+  std::vector<std::pair<bool, std::string>> validateVotesBatch(const std::vector<std::shared_ptr<PbftVote>>& votes,
+                                                               bool strict = true, bool verify_signatures = true) const;
+
   /**
    * @brief Get 2t+1. 2t+1 is 2/3 of PBFT sortition threshold and plus 1 for a specific period
    * @param pbft_period pbft period
@@ -232,6 +275,27 @@ class VoteManager {
   std::vector<std::shared_ptr<PbftVote>> getTwoTPlusOneVotedBlockVotes(PbftPeriod period, PbftRound round,
                                                                        TwoTPlusOneVotedBlockType type) const;
 
+  /**
+   * @brief 2t+1 voted block votes together with their optimized votes bundle rlp
+   */
+  struct TwoTPlusOneVotesBundle {
+    std::vector<std::shared_ptr<PbftVote>> votes;
+    // Encoded by encodePbftVotesBundleRlp
+    std::shared_ptr<const dev::bytes> rlp;
+  };
+
+  /**
+   * Get 2t+1 voted block votes for specific period, round and type with their encoded bundle. Bundle is encoded once
+   * and shared by following calls until new votes are added to the voted block
+   *
+   * @param period
+   * @param round
+   * @param type
+   * @return nullptr if 2t+1 voted block votes were not found
+   */
+  std::shared_ptr<const TwoTPlusOneVotesBundle> getTwoTPlusOneVotesBundle(PbftPeriod period, PbftRound round,
+                                                                          TwoTPlusOneVotedBlockType type) const;
+
   /**
    * Get all step votes for specific period, round and step
    *
@@ -262,7 +326,44 @@ class VoteManager {
    */
   PbftStep getNetworkTplusOneNextVotingStep(PbftPeriod period, PbftRound round) const;
 
+  /**
+   * @brief Set timings that arrivals of current round votes are recorded into, must be called before start
+   * @param timings
+   */
+  void setStageTimings(std::shared_ptr<util::StageTimings> timings);
+
+  /**
+   * @brief Percentile of arrival times of recent current round votes of given type, measured from the local start of
+   *        the round
+   *
+   * @param type vote type
+   * @param percentile in range [0, 1]
+   * @return empty optional if there are not enough samples yet
+   */
+  std::optional<std::chrono::milliseconds> getVoteArrivalPercentile(PbftVoteTypes type, double percentile) const;
+
  private:
+  /**
+   * @brief Records arrival time of current round vote
+   * @param vote
+   */
+  void recordVoteArrival(const PbftVote& vote);
+
+  /**
+   * @brief Schedules vrf sortitions of all wallets for the first kPrecomputedVrfSteps steps of period & round to be
+   *        generated on vrf_precompute_thread_pool_, does nothing if they were already scheduled
+   * @param period
+   * @param round
+   */
+  void precomputeVrfSortitions(PbftPeriod period, PbftRound round);
+
+  /**
+   * @param wallet
+   * @param msg
+   * @return precomputed vrf sortition if available, otherwise newly generated one
+   */
+  VrfPbftSortition getVrfSortition(const WalletConfig& wallet, const VrfPbftMsg& msg) const;
+
   /**
    * @param vote
    * @return true if vote is valid potential reward vote
@@ -278,6 +379,19 @@ class VoteManager {
   uint64_t getPbftSortitionThreshold(uint64_t total_dpos_votes_count, PbftVoteTypes vote_type) const;
 
  private:
+  /**
+   * @brief Validates vote
+   *
+   * @param vote to be validated
+   * @param strict strict validation
+   * @param total_dpos_votes_count total dpos votes count for vote period - 1 if already known
+   * @param verify_signatures false if signature and vrf proof are not verified
+   * @return <true, ""> vote validation passed, otherwise <false, "err msg">
+   */
+  std::pair<bool, std::string> validateVote(const std::shared_ptr<PbftVote>& vote, bool strict,
+                                            std::optional<uint64_t> total_dpos_votes_count,
+                                            bool verify_signatures = true) const;
+
   const PbftConfig& kPbftConfig;
 
   std::shared_ptr<DbStorage> db_;
@@ -291,6 +405,13 @@ class VoteManager {
   std::atomic<PbftPeriod> current_pbft_period_{0};
   // Current pbft round based on pbft_manager
   std::atomic<PbftRound> current_pbft_round_{0};
+  // Local time when current pbft round was set
+  std::atomic<std::chrono::steady_clock::time_point> current_round_start_{std::chrono::steady_clock::now()};
+
+  // Arrival times of current round votes in milliseconds, indexed by vote type - 1
+  static constexpr size_t kMinVoteArrivalSamples = 50;
+  std::array<util::RollingSamples, 4> vote_arrivals_;
+  std::shared_ptr<util::StageTimings> stage_timings_;
 
   // Main storage for all verified votes
   VerifiedVotes verified_votes_;
@@ -302,6 +423,12 @@ class VoteManager {
   std::vector<vote_hash_t> extra_reward_votes_;
   mutable std::shared_mutex reward_votes_info_mutex_;
 
+  // Encoded 2t+1 votes bundles requested by peers - <period, round, type>
+  mutable std::map<std::tuple<PbftPeriod, PbftRound, TwoTPlusOneVotedBlockType>,
+                   std::shared_ptr<const TwoTPlusOneVotesBundle>>
+      two_t_plus_one_votes_bundles_;
+  mutable std::mutex two_t_plus_one_votes_bundles_mutex_;
+
   // Own votes generated during current period & round
   std::vector<std::shared_ptr<PbftVote>> own_verified_votes_;
 
@@ -315,6 +442,23 @@ class VoteManager {
   // It is used as protection against ddos attack so we do no validate/process vote more than once
   mutable ExpirationCache<vote_hash_t> already_validated_votes_;
 
+  // Batches smaller than this are validated on the calling thread
+  static constexpr size_t kMinParallelVotesValidations = 16;
+  // Number of tasks a batch is split into
+  const uint32_t kVotesValidationTasksCount;
+  util::Executor votes_validation_executor_{util::TaskClass::Consensus};
+
+  // Own vrf sortitions generated ahead for current and next rounds - <period, round, step, wallet address>
+  // Propose, filter, certify and both finish steps are precomputed, later steps of long rounds are generated on demand
+  static constexpr PbftStep kPrecomputedVrfSteps = 5;
+  const std::vector<WalletConfig>& kWallets;
+  std::map<std::tuple<PbftPeriod, PbftRound, PbftStep, addr_t>, VrfPbftSortition> precomputed_vrf_sortitions_;
+  std::set<std::pair<PbftPeriod, PbftRound>> precomputed_vrf_rounds_;
+  mutable std::shared_mutex precomputed_vrf_sortitions_mutex_;
+
+  // Must be destroyed before precomputed vrf sortitions it writes into
+  util::ThreadPool vrf_precompute_thread_pool_;
+
   LOG_OBJECTS_DEFINE
 };
 
@@ -4,14 +4,10 @@
 
 #include <algorithm>
 #include <fstream>
-#include <stack>
-#include <tuple>
-#include <unordered_set>
+#include <iostream>
 #include <utility>
 #include <vector>
 
-#include "dag/dag.hpp"
-
 namespace taraxa {
 
 Dag::Dag(blk_hash_t const &dag_genesis_block_hash, addr_t node_addr) {
@@ -21,39 +17,59 @@ Dag::Dag(blk_hash_t const &dag_genesis_block_hash, addr_t node_addr) {
   addVEEs(dag_genesis_block_hash, {}, tips);
 }
 
-uint64_t Dag::getNumVertices() const { return boost::num_vertices(graph_); }
-uint64_t Dag::getNumEdges() const { return boost::num_edges(graph_); }
+uint64_t Dag::getNumVertices() const { return hashes_.size(); }
+uint64_t Dag::getNumEdges() const { return edges_count_; }
+
+bool Dag::hasVertex(blk_hash_t const &v) const { return vertices_.contains(v); }
 
-bool Dag::hasVertex(blk_hash_t const &v) const { return graph_.vertex(v) != graph_.null_vertex(); }
+Dag::vertex_t Dag::vertex(blk_hash_t const &v) const {
+  const auto it = vertices_.find(v);
+  return it == vertices_.end() ? kNullVertex : it->second;
+}
 
 void Dag::getLeaves(std::vector<blk_hash_t> &tips) const {
-  vertex_index_map_const_t index_map = boost::get(boost::vertex_index, graph_);
   std::vector<vertex_t> leaves;
   collectLeafVertices(leaves);
   std::transform(leaves.begin(), leaves.end(), std::back_inserter(tips),
-                 [index_map](const vertex_t &leaf) { return index_map[leaf]; });
+                 [this](const vertex_t &leaf) { return hashes_[leaf]; });
+}
+
+bool Dag::addEdge(vertex_t from, vertex_t to) {
+  auto &children = children_[from];
+  if (std::find(children.begin(), children.end(), to) != children.end()) {
+    return false;
+  }
+  children.push_back(to);
+  parents_[to].push_back(from);
+  ++edges_count_;
+  return true;
 }
 
 bool Dag::addVEEs(blk_hash_t const &new_vertex, blk_hash_t const &pivot, std::vector<blk_hash_t> const &tips) {
   assert(!new_vertex.isZero());
 
-  // add vertex
-  vertex_t ret = add_vertex(new_vertex, graph_);
-  boost::get(boost::vertex_index, graph_)[ret] = new_vertex;
-  // TODO do we need this?
-  // edge_index_map_t weight_map = boost::get(boost::edge_index, graph_);
+  // add vertex, existing vertex is reused
+  auto [it, inserted] = vertices_.emplace(new_vertex, static_cast<vertex_t>(hashes_.size()));
+  const vertex_t ret = it->second;
+  if (inserted) {
+    assert(hashes_.size() < kNullVertex);
+    hashes_.push_back(new_vertex);
+    children_.emplace_back();
+    parents_.emplace_back();
+  } else {
+    // Edges to an existing block can make it an ancestor of anchors with cached order
+    std::unique_lock lock(orders_cache_mutex_);
+    orders_cache_.clear();
+  }
 
-  edge_t edge;
   bool res = true;
 
   // Note: add edges,
   // *** important
   // Add a new block, edges are pointing from pivot to new_vertex
   if (!pivot.isZero()) {
-    if (hasVertex(pivot)) {
-      std::tie(edge, res) = boost::add_edge_by_label(pivot, new_vertex, graph_);
-      // TODO do we need this?
-      // weight_map[edge] = 1;
+    if (const auto pivot_vertex = vertex(pivot); pivot_vertex != kNullVertex) {
+      res = addEdge(pivot_vertex, ret);
       if (!res) {
         LOG(log_wr_) << "Creating pivot edge \n" << pivot << "\n-->\n" << new_vertex << " \nunsuccessful!" << std::endl;
       }
@@ -61,10 +77,8 @@ bool Dag::addVEEs(blk_hash_t const &new_vertex, blk_hash_t const &pivot, std::ve
   }
   bool res2 = true;
   for (auto const &e : tips) {
-    if (hasVertex(e)) {
-      std::tie(edge, res2) = boost::add_edge_by_label(e, new_vertex, graph_);
-      // TODO do we need this?
-      // weight_map[edge] = 0;
+    if (const auto tip_vertex = vertex(e); tip_vertex != kNullVertex) {
+      res2 = addEdge(tip_vertex, ret);
       if (!res2) {
         LOG(log_wr_) << "Creating tip edge \n" << e << "\n-->\n" << new_vertex << " \nunsuccessful!" << std::endl;
       }
@@ -76,24 +90,37 @@ bool Dag::addVEEs(blk_hash_t const &new_vertex, blk_hash_t const &pivot, std::ve
 
 void Dag::drawGraph(std::string const &filename) const {
   std::ofstream outfile(filename.c_str());
-  auto index_map = boost::get(boost::vertex_index, graph_);
-  auto weight_map = boost::get(boost::edge_index, graph_);
-
-  boost::write_graphviz(outfile, graph_, vertex_label_writer(index_map), edge_label_writer(weight_map));
+  outfile << "digraph G {\n";
+  for (vertex_t v = 0; v < hashes_.size(); ++v) {
+    outfile << v << "[label=\"" << hashes_[v].toString().substr(0, 8) << " \"];\n";
+  }
+  for (vertex_t v = 0; v < children_.size(); ++v) {
+    for (const auto child : children_[v]) {
+      outfile << v << "->" << child << " [style=\"dashed\" dir=\"back\"];\n";
+    }
+  }
+  outfile << "}\n";
   std::cout << "Dot file " << filename << " generated!" << std::endl;
   std::cout << "Use \"dot -Tpdf <dot file> -o <pdf file>\" to generate pdf file" << std::endl;
 }
 
-void Dag::clear() { graph_ = graph_t(); }
+void Dag::clear() {
+  vertices_.clear();
+  hashes_.clear();
+  children_.clear();
+  parents_.clear();
+  edges_count_ = 0;
+  std::unique_lock lock(orders_cache_mutex_);
+  orders_cache_.clear();
+}
 
 void Dag::collectLeafVertices(std::vector<vertex_t> &leaves) const {
   leaves.clear();
-  vertex_iter_t s, e;
   // iterator all vertex
-  for (std::tie(s, e) = boost::vertices(graph_); s != e; ++s) {
+  for (vertex_t v = 0; v < children_.size(); ++v) {
     // if out-degree zero, leaf node
-    if (boost::out_degree(*s, graph_) == 0) {
-      leaves.emplace_back(*s);
+    if (children_[v].empty()) {
+      leaves.emplace_back(v);
     }
   }
   assert(leaves.size());
@@ -102,162 +129,178 @@ void Dag::collectLeafVertices(std::vector<vertex_t> &leaves) const {
 // only iterate through non finalized blocks
 bool Dag::computeOrder(const blk_hash_t &anchor, std::vector<blk_hash_t> &ordered_period_vertices,
                        const std::map<uint64_t, std::unordered_set<blk_hash_t>> &non_finalized_blks) {
-  vertex_t target = graph_.vertex(anchor);
+  const vertex_t target = vertex(anchor);
 
-  if (target == graph_.null_vertex()) {
+  if (target == kNullVertex) {
     LOG(log_wr_) << "Dag::ComputeOrder cannot find vertex (anchor) " << anchor << "\n";
     return false;
   }
   ordered_period_vertices.clear();
 
-  vertex_iter_t s, e;
-  vertex_index_map_t index_map = boost::get(boost::vertex_index, graph_);  // from vertex_descriptor to hash
-  std::map<blk_hash_t, vertex_t> epfriend;                                 // this is unordered epoch
-  epfriend[index_map[target]] = target;
+  {
+    std::unique_lock lock(orders_cache_mutex_);
+    if (const auto it = orders_cache_.find(anchor); it != orders_cache_.end()) {
+      ordered_period_vertices = it->second;
+      return true;
+    }
+  }
 
-  // Step 1: collect all epoch blks that can reach anchor
-  // Erase from recent_added_blks after mark epoch number if finalized
+  const auto hash_less = [this](vertex_t a, vertex_t b) { return hashes_[a] < hashes_[b]; };
+
+  // Step 1: collect all epoch blks that can reach anchor, these are ancestors of the anchor so they are collected
+  // with a single traversal of parents instead of a reachability check for each non finalized block
+  std::vector<bool> is_ancestor(hashes_.size(), false);
+  std::vector<vertex_t> st{target};
+  is_ancestor[target] = true;
+  while (!st.empty()) {
+    const auto v = st.back();
+    st.pop_back();
+    for (const auto parent : parents_[v]) {
+      if (!is_ancestor[parent]) {
+        is_ancestor[parent] = true;
+        st.push_back(parent);
+      }
+    }
+  }
 
+  std::vector<bool> in_epoch(hashes_.size(), false);  // this is unordered epoch
+  std::vector<vertex_t> epfriend{target};
+  in_epoch[target] = true;
   for (auto &l : non_finalized_blks) {
     for (auto &blk : l.second) {
-      auto v = graph_.vertex(blk);
-      if (reachable(v, target)) {
-        epfriend[index_map[v]] = v;
+      const auto v = vertex(blk);
+      if (v != kNullVertex && is_ancestor[v] && !in_epoch[v]) {
+        in_epoch[v] = true;
+        epfriend.push_back(v);
       }
     }
   }
+  std::sort(epfriend.begin(), epfriend.end(), hash_less);
+
   // Step2: compute topological order of epfriend
-  std::unordered_set<vertex_t> visited;
-  std::stack<std::pair<vertex_t, bool>> dfs;
-  vertex_adj_iter_t adj_s, adj_e;
+  ordered_period_vertices.reserve(epfriend.size());
+  std::vector<bool> visited(hashes_.size(), false);
+  std::vector<std::pair<vertex_t, bool>> dfs;
+  std::vector<vertex_t> neighbors;
 
-  for (auto const &vp : epfriend) {
-    auto const &v = vp.second;
-    if (visited.count(v)) {
+  for (auto const v : epfriend) {
+    if (visited[v]) {
       continue;
     }
-    dfs.push({v, false});
-    visited.insert(v);
+    dfs.push_back({v, false});
+    visited[v] = true;
     while (!dfs.empty()) {
-      auto cur = dfs.top();
-      dfs.pop();
+      auto cur = dfs.back();
+      dfs.pop_back();
       if (cur.second) {
-        ordered_period_vertices.emplace_back(index_map[cur.first]);
+        ordered_period_vertices.emplace_back(hashes_[cur.first]);
         continue;
       }
-      dfs.push({cur.first, true});
-      std::vector<std::pair<blk_hash_t, vertex_t>> neighbors;
+      dfs.push_back({cur.first, true});
+      neighbors.clear();
       // iterate through neighbors
-      for (std::tie(adj_s, adj_e) = boost::adjacent_vertices(cur.first, graph_); adj_s != adj_e; adj_s++) {
-        if (epfriend.find(index_map[*adj_s]) == epfriend.end()) {  // not in this epoch
+      for (const auto child : children_[cur.first]) {
+        if (!in_epoch[child]) {  // not in this epoch
           continue;
         }
-        if (visited.count(*adj_s)) {
+        if (visited[child]) {
           continue;
         }
-        neighbors.emplace_back(std::make_pair(index_map[*adj_s], *adj_s));
-        visited.insert(*adj_s);
+        neighbors.emplace_back(child);
+        visited[child] = true;
       }
       // make sure iterated nodes have deterministic order
-      std::sort(neighbors.begin(), neighbors.end());
-      for (auto const &n : neighbors) {
-        dfs.push({n.second, false});
+      std::sort(neighbors.begin(), neighbors.end(), hash_less);
+      for (auto const n : neighbors) {
+        dfs.push_back({n, false});
       }
     }
   }
   std::reverse(ordered_period_vertices.begin(), ordered_period_vertices.end());
+
+  std::unique_lock lock(orders_cache_mutex_);
+  if (orders_cache_.size() >= kMaxCachedOrders) {
+    orders_cache_.clear();
+  }
+  orders_cache_.emplace(anchor, ordered_period_vertices);
   return true;
 }
 
 // dfs
 bool Dag::reachable(vertex_t const &from, vertex_t const &to) const {
   if (from == to) return true;
-  vertex_t current = from;
-  vertex_t target = to;
-  std::stack<vertex_t> st;
-  std::set<vertex_t> visited;
-  st.push(current);
-  visited.insert(current);
+  std::vector<vertex_t> st{from};
+  std::vector<bool> visited(hashes_.size(), false);
+  visited[from] = true;
 
   while (!st.empty()) {
-    vertex_t t = st.top();
-    st.pop();
-    vertex_adj_iter_t s, e;
-    for (std::tie(s, e) = boost::adjacent_vertices(t, graph_); s != e; ++s) {
-      if (visited.count(*s)) continue;
-      if (*s == target) return true;
-      visited.insert(*s);
-      st.push(*s);
+    const auto t = st.back();
+    st.pop_back();
+    for (const auto child : children_[t]) {
+      if (visited[child]) continue;
+      if (child == to) return true;
+      visited[child] = true;
+      st.push_back(child);
     }
   }
   return false;
 }
 
-/**
- * Iterative version
- * Steps rounds
- * 1. post order traversal
- * 2. from leave, count weight and propagate up
- * 3. collect path
- */
+bool PivotTree::addVEEs(blk_hash_t const &new_vertex, blk_hash_t const &pivot, std::vector<blk_hash_t> const &tips) {
+  const auto existing_vertex = vertex(new_vertex);
+  const size_t parents_count = existing_vertex == kNullVertex ? 0 : parents_[existing_vertex].size();
 
-std::vector<blk_hash_t> PivotTree::getGhostPath(const blk_hash_t &vertex) const {
-  vertex_t root = graph_.vertex(vertex);
+  const auto res = Dag::addVEEs(new_vertex, pivot, tips);
 
-  if (root == graph_.null_vertex()) {
-    LOG(log_wr_) << "Cannot find vertex (getGhostPath) " << vertex << std::endl;
-    return {};
+  // New vertex has weight 1, the whole weight of the vertex is added to ancestors through every new parent edge
+  weights_.resize(hashes_.size(), 1);
+  const auto v = vertex(new_vertex);
+  for (size_t i = parents_count; i < parents_[v].size(); ++i) {
+    addWeight(parents_[v][i], weights_[v]);
   }
+  return res;
+}
 
-  std::vector<blk_hash_t> pivot_chain;
-  std::vector<vertex_t> post_order;
+void PivotTree::clear() {
+  Dag::clear();
+  weights_.clear();
+}
 
-  // first step: post order traversal
-  std::stack<vertex_t> st;
-  st.emplace(root);
-  vertex_t cur;
-  vertex_adj_iter_t s, e;
+void PivotTree::addWeight(vertex_t from, size_t delta) {
+  // Pivot tree vertices have a single parent, so this is a walk to the root
+  std::vector<vertex_t> st{from};
   while (!st.empty()) {
-    cur = st.top();
-    st.pop();
-    post_order.emplace_back(cur);
-    for (std::tie(s, e) = boost::adjacent_vertices(cur, graph_); s != e; s++) {
-      st.emplace(*s);
-    }
-  }
-  std::reverse(post_order.begin(), post_order.end());
-
-  // second step: compute weight based on step one
-  std::unordered_map<vertex_t, size_t> weight_map;
-  for (auto const &n : post_order) {
-    auto total_w = 0;
-    // get childrens
-    for (std::tie(s, e) = boost::adjacent_vertices(n, graph_); s != e; s++) {
-      if (weight_map.count(*s)) {  // bigger timestamp
-        total_w += weight_map[*s];
-      }
-    }
-    weight_map[n] = total_w + 1;
+    const auto v = st.back();
+    st.pop_back();
+    weights_[v] += delta;
+    st.insert(st.end(), parents_[v].begin(), parents_[v].end());
   }
+}
+
+std::vector<blk_hash_t> PivotTree::getGhostPath(const blk_hash_t &vertex) const {
+  vertex_t root = Dag::vertex(vertex);
 
-  vertex_index_map_const_t index_map = boost::get(boost::vertex_index, graph_);
+  if (root == kNullVertex) {
+    LOG(log_wr_) << "Cannot find vertex (getGhostPath) " << vertex << std::endl;
+    return {};
+  }
 
-  // third step: collect path
+  std::vector<blk_hash_t> pivot_chain;
+  // collect path
   while (1) {
-    pivot_chain.emplace_back(index_map[root]);
+    pivot_chain.emplace_back(hashes_[root]);
     size_t heavist = 0;
     vertex_t next = root;
 
-    for (std::tie(s, e) = boost::adjacent_vertices(root, graph_); s != e; s++) {
-      if (!weight_map.count(*s)) continue;  // bigger timestamp
-      size_t w = weight_map[*s];
+    for (const auto child : children_[root]) {
+      const size_t w = weights_[child];
       assert(w > 0);
       if (w > heavist) {
         heavist = w;
-        next = *s;
+        next = child;
       } else if (w == heavist) {
-        if (index_map[*s] < index_map[next]) {
-          next = *s;
+        if (hashes_[child] < hashes_[next]) {
+          next = child;
         }
       }
     }
@@ -1,5 +1,6 @@
 #include "dag/dag_block_proposer.hpp"
 
+#include <algorithm>
 #include <memory>
 
 #include "common/util.hpp"
@@ -26,9 +27,9 @@ DagBlockProposer::DagBlockProposer(const FullNodeConfig& config, std::shared_ptr
       db_(std::move(db)),
       nodes_dag_proposers_data_(),
       kDagProposeGasLimit(
-          std::min(config.propose_dag_gas_limit, config.genesis.getGasLimits(final_chain_->lastBlockNumber()).first)),
-      kPbftGasLimit(config.genesis.getGasLimits(final_chain_->lastBlockNumber()).second),
-      kDagGasLimit(config.genesis.getGasLimits(final_chain_->lastBlockNumber()).first),
+          std::min(config.propose_dag_gas_limit, final_chain_->lastBlockHardforkRules()->dag_gas_limit)),
+      kPbftGasLimit(final_chain_->lastBlockHardforkRules()->pbft_gas_limit),
+      kDagGasLimit(final_chain_->lastBlockHardforkRules()->dag_gas_limit),
       kHardforks(config.genesis.state.hardforks),
       kValidatorMaxVote(config.genesis.state.dpos.validator_maximum_stake /
                         config.genesis.state.dpos.vote_eligibility_balance_step) {
@@ -52,7 +53,7 @@ bool DagBlockProposer::proposeDagBlock(const std::shared_ptr<NodeDagProposerData
     return false;
   }
 
-  auto frontier = dag_mgr_->getDagFrontier();
+  auto [frontier, frontier_version] = dag_mgr_->getDagFrontierWithVersion();
   LOG(log_dg_) << "Get frontier with pivot: " << frontier.pivot << " tips: " << frontier.tips;
   assert(!frontier.pivot.isZero());
   const auto propose_level = getProposeLevel(frontier.pivot, frontier.tips) + 1;
@@ -147,9 +148,16 @@ bool DagBlockProposer::proposeDagBlock(const std::shared_ptr<NodeDagProposerData
     sync.set_value();
   });
 
+  // Frontier the draft was made with is tracked by its version, so levels are recomputed only when it changes
   std::future<void> result = sync.get_future();
+  auto checked_frontier_version = frontier_version;
   while (result.wait_for(std::chrono::milliseconds(100)) != std::future_status::ready) {
-    auto latest_frontier = dag_mgr_->getDagFrontier();
+    auto [latest_frontier, latest_frontier_version] = dag_mgr_->getDagFrontierWithVersion();
+    if (latest_frontier_version == checked_frontier_version) {
+      continue;
+    }
+    checked_frontier_version = latest_frontier_version;
+
     const auto latest_level = getProposeLevel(latest_frontier.pivot, latest_frontier.tips) + 1;
     if (latest_level > propose_level + 1 && vdf.getDifficulty() > sortition_params.vdf.difficulty_min) {
       cancellation_token = true;
@@ -181,6 +189,12 @@ bool DagBlockProposer::proposeDagBlock(const std::shared_ptr<NodeDagProposerData
   LOG(log_dg_) << node_dag_proposer_data->wallet.node_addr << " VDF computation time " << vdf.getComputationTime()
                << " difficulty " << vdf.getDifficulty();
 
+  // Frontier changed while VDF was computed, draft is patched with the new tips instead of being thrown away
+  if (auto [latest_frontier, latest_frontier_version] = dag_mgr_->getDagFrontierWithVersion();
+      latest_frontier_version != frontier_version) {
+    patchDraftTips(frontier, latest_frontier, propose_level);
+  }
+
   auto dag_block = createDagBlock(std::move(frontier), propose_level, transactions, std::move(estimations),
                                   std::move(vdf), node_dag_proposer_data->wallet.node_secret);
 
@@ -215,15 +229,17 @@ void DagBlockProposer::start() {
       while (!stopped_) {
         // Blocks are not proposed if we are behind the network and still syncing
         auto syncing = false;
-        auto packets_over_the_limit = false;
+        auto load = network::tarcap::LoadLevel::kNormal;
         if (auto net = network_.lock()) {
           syncing = net->pbft_syncing();
-          packets_over_the_limit = net->packetQueueOverLimit();
+          load = net->loadLevel();
         }
-        // Only sleep if block was not proposed or if we are syncing or if packets queue is over the limit, if block is
-        // proposed try to propose another block immediately
-        if (syncing || packets_over_the_limit || !proposeDagBlock(node_dag_proposer_data)) {
+        // Only sleep if block was not proposed or if we are syncing or if node is critically loaded, if block is
+        // proposed try to propose another block immediately. Under lower load interval between proposals is stretched
+        if (syncing || load == network::tarcap::LoadLevel::kCritical || !proposeDagBlock(node_dag_proposer_data)) {
           thisThreadSleepForMilliSeconds(min_proposal_delay);
+        } else if (load != network::tarcap::LoadLevel::kNormal) {
+          thisThreadSleepForMilliSeconds(min_proposal_delay << (2 * (static_cast<uint8_t>(load) - 1)));
         }
       }
     }));
@@ -279,6 +295,40 @@ std::pair<SharedTransactions, std::vector<uint64_t>> DagBlockProposer::getSharde
   return {sharded_trxs, sharded_estimations};
 }
 
+void DagBlockProposer::patchDraftTips(DagFrontier& draft, const DagFrontier& latest_frontier,
+                                      level_t propose_level) const {
+  std::unordered_set<blk_hash_t> draft_blocks(draft.tips.begin(), draft.tips.end());
+  draft_blocks.insert(draft.pivot);
+
+  size_t added_tips = 0;
+  for (const auto& tip : latest_frontier.tips) {
+    if (draft_blocks.contains(tip)) {
+      continue;
+    }
+    // Tip must not change the level, VRF and VDF difficulty are bound to it
+    const auto tip_block = dag_mgr_->getDagBlock(tip);
+    if (!tip_block || tip_block->getLevel() >= propose_level) {
+      continue;
+    }
+    draft.tips.push_back(tip);
+    draft_blocks.insert(tip);
+    added_tips++;
+  }
+
+  // Latest pivot can be referenced as a tip as well, draft pivot has to stay as it is part of VDF message
+  if (!draft_blocks.contains(latest_frontier.pivot)) {
+    if (const auto pivot_block = dag_mgr_->getDagBlock(latest_frontier.pivot);
+        pivot_block && pivot_block->getLevel() < propose_level) {
+      draft.tips.push_back(latest_frontier.pivot);
+      added_tips++;
+    }
+  }
+
+  if (added_tips) {
+    LOG(log_dg_) << "Draft with pivot " << draft.pivot << " patched with " << added_tips << " new tips";
+  }
+}
+
 level_t DagBlockProposer::getProposeLevel(blk_hash_t const& pivot, vec_blk_t const& tips) const {
   level_t max_level = 0;
   // get current level
@@ -301,56 +351,50 @@ level_t DagBlockProposer::getProposeLevel(blk_hash_t const& pivot, vec_blk_t con
 }
 
 vec_blk_t DagBlockProposer::selectDagBlockTips(const vec_blk_t& frontier_tips, uint64_t gas_limit) const {
-  // Prioritize higher level with unique proposer
-  uint64_t gas_estimation = 0;
-  std::unordered_set<addr_t> proposers, duplicate_proposers;
-  std::unordered_map<blk_hash_t, std::shared_ptr<DagBlock>> tips_blocks;
-  tips_blocks.reserve(frontier_tips.size());
-  vec_blk_t tips;
-  tips.reserve(kDagBlockMaxTips);
-
-  // Retrieve all the tips blocks and identify duplicate proposer tips
+  struct Candidate {
+    const blk_hash_t* hash;
+    DagManager::FrontierTip tip;
+    bool unique_proposer = true;
+  };
+
+  // Tips data is taken from the frontier index, only tips that are not part of the current frontier are looked up
+  const auto frontier_index = dag_mgr_->getDagFrontierTips();
+  std::vector<Candidate> candidates;
+  candidates.reserve(frontier_tips.size());
+  std::unordered_map<addr_t, uint32_t> proposers_tips_count;
   for (const auto& t : frontier_tips) {
-    auto tip_block = dag_mgr_->getDagBlock(t);
-    if (tip_block == nullptr) {
-      // This could happen if a tip block has expired, exclude this tip
-      LOG(log_nf_) << "selectDagBlockTips, Cannot find tip dag block " << tip_block;
+    if (auto it = frontier_index->find(t); it != frontier_index->end()) {
+      candidates.push_back({&t, it->second});
+    } else if (auto tip_block = dag_mgr_->getDagBlock(t)) {
+      candidates.push_back({&t, {tip_block->getSender(), tip_block->getGasEstimation(), tip_block->getLevel()}});
     } else {
-      tips_blocks.insert({t, tip_block});
-      if (!proposers.insert(tip_block->getSender()).second) {
-        duplicate_proposers.insert(tip_block->getSender());
-      }
+      // This could happen if a tip block has expired, exclude this tip
+      LOG(log_nf_) << "selectDagBlockTips, Cannot find tip dag block " << t;
+      continue;
     }
+    proposers_tips_count[candidates.back().tip.proposer]++;
   }
-
-  // Split tips by tips with unique or duplicate proposers
-  std::multimap<level_t, blk_hash_t, std::greater<level_t>> ordered_tips_with_unique_proposers,
-      ordered_tips_with_duplicate_proposers;
-  for (const auto& t : frontier_tips) {
-    const auto& tip_block = tips_blocks[t];
-    if (duplicate_proposers.contains(tip_block->getSender())) {
-      ordered_tips_with_duplicate_proposers.insert({tip_block->getLevel(), t});
-    } else {
-      ordered_tips_with_unique_proposers.insert({tip_block->getLevel(), t});
-    }
+  for (auto& candidate : candidates) {
+    candidate.unique_proposer = proposers_tips_count[candidate.tip.proposer] == 1;
   }
 
-  // First insert tips with unique proposers ordered by level
-  for (const auto& tip : ordered_tips_with_unique_proposers) {
-    gas_estimation += tips_blocks[tip.second]->getGasEstimation();
-    if (gas_estimation > gas_limit || tips.size() == kDagBlockMaxTips) {
-      return tips;
+  // Prioritize tips with unique proposer first and higher level second, equal tips keep their order
+  std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+    if (a.unique_proposer != b.unique_proposer) {
+      return a.unique_proposer;
     }
-    tips.push_back(tip.second);
-  }
+    return a.tip.level > b.tip.level;
+  });
 
-  // After inserting all unique proposers blocks, insert duplicates as well
-  for (const auto& tip : ordered_tips_with_duplicate_proposers) {
-    gas_estimation += tips_blocks[tip.second]->getGasEstimation();
+  uint64_t gas_estimation = 0;
+  vec_blk_t tips;
+  tips.reserve(std::min<size_t>(candidates.size(), kDagBlockMaxTips));
+  for (const auto& candidate : candidates) {
+    gas_estimation += candidate.tip.gas_estimation;
     if (gas_estimation > gas_limit || tips.size() == kDagBlockMaxTips) {
-      return tips;
+      break;
     }
-    tips.push_back(tip.second);
+    tips.push_back(*candidate.hash);
   }
   return tips;
 }
@@ -373,7 +417,7 @@ std::shared_ptr<DagBlock> DagBlockProposer::createDagBlock(DagFrontier&& frontie
     frontier.tips = selectDagBlockTips(frontier.tips, kPbftGasLimit - block_estimation);
   }
 
-  return std::make_shared<DagBlock>(frontier.pivot, std::move(level), std::move(frontier.tips), std::move(trx_hashes),
+  return util::makeShared<DagBlock>(frontier.pivot, std::move(level), std::move(frontier.tips), std::move(trx_hashes),
                                     block_estimation, std::move(vdf), node_secret);
 }
 
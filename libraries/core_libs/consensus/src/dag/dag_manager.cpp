@@ -3,11 +3,13 @@
 #include <libdevcore/CommonIO.h>
 
 #include <algorithm>
+#include <future>
 #include <tuple>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "common/tracing.hpp"
 #include "config/config.hpp"
 #include "dag/dag.hpp"
 #include "key_manager/key_manager.hpp"
@@ -37,8 +39,10 @@ DagManager::DagManager(const FullNodeConfig &config, addr_t node_addr, std::shar
       final_chain_(std::move(final_chain)),
       kGenesis(config.genesis),
       kValidatorMaxVote(config.genesis.state.dpos.validator_maximum_stake /
-                        config.genesis.state.dpos.vote_eligibility_balance_step) {
+                        config.genesis.state.dpos.vote_eligibility_balance_step),
+      kBlocksVerificationTasksCount(std::max(1u, std::thread::hardware_concurrency() / 2)) {
   LOG_OBJECTS_CREATE("DAGMGR");
+  publishSnapshot();
   if (auto ret = getLatestPivotAndTips(); ret) {
     frontier_.pivot = ret->first;
     for (const auto &t : ret->second) {
@@ -121,13 +125,55 @@ std::pair<bool, std::vector<blk_hash_t>> DagManager::pivotAndTipsAvailable(const
   return {true, missing_tips_or_pivot};
 }
 
-DagFrontier DagManager::getDagFrontier() {
-  std::shared_lock lock(mutex_);
-  return frontier_;
+DagFrontier DagManager::getDagFrontier() { return snapshot_.load()->frontier; }
+
+std::pair<DagFrontier, uint64_t> DagManager::getDagFrontierWithVersion() const {
+  const auto snapshot = snapshot_.load();
+  return {snapshot->frontier, snapshot->frontier_version};
+}
+
+std::shared_ptr<const DagManager::FrontierTips> DagManager::getDagFrontierTips() const {
+  return snapshot_.load()->frontier_tips;
+}
+
+void DagManager::publishSnapshot(std::optional<uint64_t> changed_level) {
+  auto snapshot = std::make_shared<Snapshot>();
+  snapshot->period = period_;
+  snapshot->anchor = anchor_;
+  snapshot->old_anchor = old_anchor_;
+  snapshot->frontier = frontier_;
+  snapshot->frontier_version = frontier_version_;
+  snapshot->frontier_tips = frontier_tips_;
+  snapshot->non_finalized_blks_min_difficulty = non_finalized_blks_min_difficulty_;
+
+  const auto previous = snapshot_.load();
+  if (changed_level.has_value() && previous) {
+    // Unchanged levels are shared with the previous snapshot
+    snapshot->non_finalized_blks = previous->non_finalized_blks;
+    snapshot->non_finalized_blks_count = previous->non_finalized_blks_count;
+    if (auto it = snapshot->non_finalized_blks.find(*changed_level); it != snapshot->non_finalized_blks.end()) {
+      snapshot->non_finalized_blks_count -= it->second->size();
+    }
+    if (auto it = non_finalized_blks_.find(*changed_level); it != non_finalized_blks_.end()) {
+      snapshot->non_finalized_blks[*changed_level] = std::make_shared<const std::unordered_set<blk_hash_t>>(it->second);
+      snapshot->non_finalized_blks_count += it->second.size();
+    } else {
+      snapshot->non_finalized_blks.erase(*changed_level);
+    }
+  } else {
+    for (const auto &level : non_finalized_blks_) {
+      snapshot->non_finalized_blks.emplace(level.first,
+                                           std::make_shared<const std::unordered_set<blk_hash_t>>(level.second));
+      snapshot->non_finalized_blks_count += level.second.size();
+    }
+  }
+
+  snapshot_.store(std::move(snapshot));
 }
 
 std::pair<bool, std::vector<blk_hash_t>> DagManager::addDagBlock(const std::shared_ptr<DagBlock> &blk,
                                                                  SharedTransactions &&trxs, bool proposed, bool save) {
+  TRACE_SPAN("DagManager::addDagBlock");
   auto blk_hash = blk->getHash();
 
   {
@@ -171,6 +217,7 @@ std::pair<bool, std::vector<blk_hash_t>> DagManager::addDagBlock(const std::shar
       }
 
       updateFrontier();
+      publishSnapshot(blk->getLevel());
     }
     if (save) {
       block_verified_.emit(blk);
@@ -194,6 +241,9 @@ void DagManager::addToDag(blk_hash_t const &hash, blk_hash_t const &pivot, std::
                           uint64_t level, bool finalized) {
   total_dag_->addVEEs(hash, pivot, tips);
   pivot_tree_->addVEEs(hash, pivot, {});
+  // Vertex with its hash index entry in both graphs, edges are stored as vertex ids in both directions
+  constexpr size_t kVertexMemoryUsage = 2 * (sizeof(blk_hash_t) + util::kContainerNodeOverhead + sizeof(uint64_t));
+  dag_memory_usage_.add(kVertexMemoryUsage + (tips.size() + 2) * 2 * sizeof(uint32_t));
 
   LOG(log_dg_) << " Insert block to DAG : " << hash;
   if (finalized) {
@@ -202,6 +252,8 @@ void DagManager::addToDag(blk_hash_t const &hash, blk_hash_t const &pivot, std::
 
   if (!non_finalized_blks_[level].insert(hash).second) {
     LOG(log_er_) << "Trying to insert duplicate block into the dag: " << hash;
+  } else {
+    dag_memory_usage_.add(sizeof(blk_hash_t) + util::kContainerNodeOverhead);
   }
 }
 
@@ -230,9 +282,19 @@ void DagManager::updateFrontier() {
   auto [p, ts] = getFrontier();
   frontier_.pivot = p;
   frontier_.tips.clear();
+  auto frontier_tips = std::make_shared<FrontierTips>();
+  frontier_tips->reserve(ts.size());
   for (auto const &t : ts) {
     frontier_.tips.push_back(t);
+    if (auto it = frontier_tips_->find(t); it != frontier_tips_->end()) {
+      frontier_tips->emplace(t, it->second);
+    } else if (auto tip_block = getDagBlock(t)) {
+      frontier_tips->emplace(t,
+                             FrontierTip{tip_block->getSender(), tip_block->getGasEstimation(), tip_block->getLevel()});
+    }
   }
+  frontier_tips_ = std::move(frontier_tips);
+  frontier_version_++;
 }
 
 std::vector<blk_hash_t> DagManager::getGhostPath(const blk_hash_t &source) const {
@@ -290,6 +352,7 @@ uint DagManager::setDagBlockOrder(blk_hash_t const &new_anchor, PbftPeriod perio
 
   if (new_anchor == kNullBlockHash) {
     period_ = period;
+    publishSnapshot(std::nullopt);
     LOG(log_nf_) << "Set new period " << period << " with kNullBlockHash anchor";
     return 0;
   }
@@ -323,6 +386,8 @@ uint DagManager::setDagBlockOrder(blk_hash_t const &new_anchor, PbftPeriod perio
   pivot_tree_->clear();
   auto non_finalized_blocks = std::move(non_finalized_blks_);
   non_finalized_blks_.clear();
+  // Both graphs and index are rebuilt from scratch below
+  dag_memory_usage_.reset();
 
   std::unordered_set<blk_hash_t> dag_order_set(dag_order.begin(), dag_order.end());
   assert(dag_order_set.count(new_anchor));
@@ -333,8 +398,12 @@ uint DagManager::setDagBlockOrder(blk_hash_t const &new_anchor, PbftPeriod perio
     dag_expiry_level_ = anchor_block_level - dag_expiry_limit_;
   }
 
+  // After a long stall many blocks expire at once, they are removed in one batch and their transactions are handled
+  // together once all blocks are processed
   std::unordered_map<blk_hash_t, std::shared_ptr<DagBlock>> expired_dag_blocks_to_remove;
-  std::vector<trx_hash_t> expired_dag_blocks_transactions;
+  std::unordered_set<trx_hash_t> expired_dag_blocks_transactions;
+  std::vector<std::shared_ptr<DagBlock>> non_expired_dag_blocks;
+  auto expired_dag_blocks_batch = db_->createWriteBatch();
 
   non_finalized_blks_min_difficulty_ = UINT32_MAX;
   for (auto &v : non_finalized_blocks) {
@@ -351,24 +420,29 @@ uint DagManager::setDagBlockOrder(blk_hash_t const &new_anchor, PbftPeriod perio
         if (non_finalized_blks_min_difficulty_ > dag_block->getDifficulty()) {
           non_finalized_blks_min_difficulty_ = dag_block->getDifficulty();
         }
+        non_expired_dag_blocks.push_back(std::move(dag_block));
       } else {
-        db_->removeDagBlock(blk_hash);
+        db_->removeDagBlockBatch(expired_dag_blocks_batch, blk_hash);
         seen_blocks_.erase(blk_hash);
-        const auto dag_trxs = dag_block->getTrxs();
-        std::copy(dag_trxs.begin(), dag_trxs.end(), std::back_inserter(expired_dag_blocks_transactions));
+        const auto &dag_trxs = dag_block->getTrxs();
+        expired_dag_blocks_transactions.insert(dag_trxs.begin(), dag_trxs.end());
       }
     }
   }
 
+  if (!expired_dag_blocks_to_remove.empty()) {
+    db_->commitWriteBatch(expired_dag_blocks_batch);
+  }
   // Remove any transactions from expired dag blocks if not already finalized or included in another dag block
-  if (expired_dag_blocks_transactions.size()) {
-    handleExpiredDagBlocksTransactions(expired_dag_blocks_transactions);
+  if (!expired_dag_blocks_transactions.empty()) {
+    handleExpiredDagBlocksTransactions(std::move(expired_dag_blocks_transactions), non_expired_dag_blocks);
   }
 
   old_anchor_ = anchor_;
   anchor_ = new_anchor;
   period_ = period;
   updateFrontier();
+  publishSnapshot(std::nullopt);
 
   LOG(log_nf_) << "Set new period " << period << " with anchor " << new_anchor;
 
@@ -376,26 +450,29 @@ uint DagManager::setDagBlockOrder(blk_hash_t const &new_anchor, PbftPeriod perio
 }
 
 void DagManager::handleExpiredDagBlocksTransactions(
-    const std::vector<trx_hash_t> &transactions_from_expired_dag_blocks) const {
-  std::unordered_set<trx_hash_t> transactions_from_expired_dag_blocks_to_remove;
-  // Only transactions that need to be moved to memory pool are the ones that are not yet finalized and are not part of
-  // another valid DAG block
-  auto trxs_finalized = db_->transactionsFinalized(transactions_from_expired_dag_blocks);
-  for (uint32_t i = 0; i < trxs_finalized.size(); i++) {
-    if (!trxs_finalized[i]) {
-      transactions_from_expired_dag_blocks_to_remove.emplace(transactions_from_expired_dag_blocks[i]);
+    std::unordered_set<trx_hash_t> &&transactions_from_expired_dag_blocks,
+    const std::vector<std::shared_ptr<DagBlock>> &non_expired_dag_blocks) const {
+  // Only transactions that need to be removed are the ones that are not part of another valid DAG block and are not
+  // yet finalized. Blocks left in DAG are already loaded, so db is queried only for transactions that are left
+  for (const auto &dag_block : non_expired_dag_blocks) {
+    for (const auto &trx : dag_block->getTrxs()) {
+      transactions_from_expired_dag_blocks.erase(trx);
+    }
+    if (transactions_from_expired_dag_blocks.empty()) {
+      return;
     }
   }
-  for (auto const &level : non_finalized_blks_) {
-    for (auto const &blk : level.second) {
-      auto dag_block = getDagBlock(blk);
-      for (auto const &trx : dag_block->getTrxs()) {
-        transactions_from_expired_dag_blocks_to_remove.erase(trx);
-      }
+
+  const std::vector<trx_hash_t> transactions(transactions_from_expired_dag_blocks.begin(),
+                                             transactions_from_expired_dag_blocks.end());
+  const auto trxs_finalized = db_->transactionsFinalized(transactions);
+  for (uint32_t i = 0; i < trxs_finalized.size(); i++) {
+    if (trxs_finalized[i]) {
+      transactions_from_expired_dag_blocks.erase(transactions[i]);
     }
   }
-  if (transactions_from_expired_dag_blocks_to_remove.size() > 0) {
-    trx_mgr_->removeNonFinalizedTransactions(std::move(transactions_from_expired_dag_blocks_to_remove));
+  if (!transactions_from_expired_dag_blocks.empty()) {
+    trx_mgr_->removeNonFinalizedTransactions(std::move(transactions_from_expired_dag_blocks));
   }
 }
 
@@ -458,44 +535,47 @@ void DagManager::recoverDag() {
     }
   }
 
+  const auto verified_blocks = loadStartupSnapshot();
   for (auto &lvl : db_->getNonfinalizedDagBlocks()) {
     for (auto &blk : lvl.second) {
       // These are some sanity checks that difficulty is correct and block is truly non-finalized.
-      // This is only done on startup
-      auto period = db_->getDagBlockPeriod(blk->getHash());
-      if (period != nullptr) {
-        LOG(log_er_) << "Nonfinalized Dag Block actually finalized in period " << period->first;
-        break;
-      } else {
-        auto propose_period = db_->getProposalPeriodForDagLevel(blk->getLevel());
-        if (!propose_period.has_value()) {
-          LOG(log_er_) << "No propose period for dag level " << blk->getLevel() << " found";
-          assert(false);
+      // This is only done on startup for blocks that were not verified before clean shutdown
+      if (!verified_blocks.contains(blk->getHash())) {
+        auto period = db_->getDagBlockPeriod(blk->getHash());
+        if (period != nullptr) {
+          LOG(log_er_) << "Nonfinalized Dag Block actually finalized in period " << period->first;
           break;
-        }
+        } else {
+          auto propose_period = db_->getProposalPeriodForDagLevel(blk->getLevel());
+          if (!propose_period.has_value()) {
+            LOG(log_er_) << "No propose period for dag level " << blk->getLevel() << " found";
+            assert(false);
+            break;
+          }
 
-        const auto pk = key_manager_->getVrfKey(*propose_period, blk->getSender());
-        if (!pk) {
-          LOG(log_er_) << "DAG block " << blk->getHash() << " with " << blk->getLevel()
-                       << " level is missing VRF key for sender " << blk->getSender();
-          break;
-        }
-        // Verify VDF solution
-        try {
-          uint64_t max_vote_count = 0;
-          const auto vote_count = final_chain_->dposEligibleVoteCount(*propose_period, blk->getSender());
-          if (*propose_period < kGenesis.state.hardforks.magnolia_hf.block_num) {
-            max_vote_count = final_chain_->dposEligibleTotalVoteCount(*propose_period);
-          } else {
-            max_vote_count = kValidatorMaxVote;
+          const auto pk = key_manager_->getVrfKey(*propose_period, blk->getSender());
+          if (!pk) {
+            LOG(log_er_) << "DAG block " << blk->getHash() << " with " << blk->getLevel()
+                         << " level is missing VRF key for sender " << blk->getSender();
+            break;
+          }
+          // Verify VDF solution
+          try {
+            uint64_t max_vote_count = 0;
+            const auto vote_count = final_chain_->dposEligibleVoteCount(*propose_period, blk->getSender());
+            if (*propose_period < kGenesis.state.hardforks.magnolia_hf.block_num) {
+              max_vote_count = final_chain_->dposEligibleTotalVoteCount(*propose_period);
+            } else {
+              max_vote_count = kValidatorMaxVote;
+            }
+            blk->verifyVdf(sortition_params_manager_.getSortitionParams(*propose_period),
+                           db_->getPeriodBlockHash(*propose_period), *pk, vote_count, max_vote_count);
+          } catch (vdf_sortition::VdfSortition::InvalidVdfSortition const &e) {
+            LOG(log_er_) << "DAG block " << blk->getHash() << " with " << blk->getLevel()
+                         << " level failed on VDF verification with pivot hash " << blk->getPivot() << " reason "
+                         << e.what();
+            break;
           }
-          blk->verifyVdf(sortition_params_manager_.getSortitionParams(*propose_period),
-                         db_->getPeriodBlockHash(*propose_period), *pk, vote_count, max_vote_count);
-        } catch (vdf_sortition::VdfSortition::InvalidVdfSortition const &e) {
-          LOG(log_er_) << "DAG block " << blk->getHash() << " with " << blk->getLevel()
-                       << " level failed on VDF verification with pivot hash " << blk->getPivot() << " reason "
-                       << e.what();
-          break;
         }
       }
 
@@ -515,12 +595,54 @@ void DagManager::recoverDag() {
   }
   trx_mgr_->recoverNonfinalizedTransactions();
   updateFrontier();
+  publishSnapshot(std::nullopt);
+}
+
+void DagManager::saveStartupSnapshot() const {
+  std::shared_lock lock(mutex_);
+  size_t count = 0;
+  for (const auto &level : non_finalized_blks_) {
+    count += level.second.size();
+  }
+  dev::RLPStream s(2);
+  s << period_;
+  s.appendList(count);
+  for (const auto &level : non_finalized_blks_) {
+    for (const auto &hash : level.second) {
+      s << hash;
+    }
+  }
+  db_->saveStartupSnapshot(StartupSnapshotKey::Dag, s.invalidate());
+}
+
+std::unordered_set<blk_hash_t> DagManager::loadStartupSnapshot() {
+  const auto data = db_->takeStartupSnapshot(StartupSnapshotKey::Dag);
+  if (data.empty()) {
+    return {};
+  }
+  const dev::RLP rlp(data);
+  if (const auto period = rlp[0].toInt<PbftPeriod>(); period != period_) {
+    LOG(log_nf_) << "DAG startup snapshot of period " << period << " is stale, period " << period_
+                 << " is finalized";
+    return {};
+  }
+  std::unordered_set<blk_hash_t> verified_blocks;
+  verified_blocks.reserve(rlp[1].itemCount());
+  for (const auto hash : rlp[1]) {
+    verified_blocks.insert(hash.toHash<blk_hash_t>());
+  }
+  LOG(log_nf_) << "Loaded DAG startup snapshot with " << verified_blocks.size() << " verified blocks";
+  return verified_blocks;
 }
 
 const std::pair<PbftPeriod, std::map<uint64_t, std::unordered_set<blk_hash_t>>> DagManager::getNonFinalizedBlocks()
     const {
-  std::shared_lock lock(mutex_);
-  return {period_, non_finalized_blks_};
+  const auto snapshot = snapshot_.load();
+  std::map<uint64_t, std::unordered_set<blk_hash_t>> non_finalized_blks;
+  for (const auto &level : snapshot->non_finalized_blks) {
+    non_finalized_blks.emplace(level.first, *level.second);
+  }
+  return {snapshot->period, std::move(non_finalized_blks)};
 }
 
 const std::tuple<PbftPeriod, std::vector<std::shared_ptr<DagBlock>>, SharedTransactions>
@@ -553,23 +675,60 @@ DagManager::getNonFinalizedBlocksWithTransactions(const std::unordered_set<blk_h
 }
 
 uint32_t DagManager::getNonFinalizedBlocksMinDifficulty() const {
-  std::shared_lock lock(mutex_);
-  return non_finalized_blks_min_difficulty_;
+  return snapshot_.load()->non_finalized_blks_min_difficulty;
+}
+
+size_t DagManager::memoryUsage() const {
+  // Seen blocks are evicted by the cache itself, so they are estimated by their count without their transactions
+  constexpr size_t kSeenBlockMemoryUsage = sizeof(DagBlock) + 2 * util::kContainerNodeOverhead + sizeof(blk_hash_t);
+  return dag_memory_usage_.bytes() + seen_blocks_.size() * kSeenBlockMemoryUsage;
 }
 
 std::pair<size_t, size_t> DagManager::getNonFinalizedBlocksSize() const {
-  std::shared_lock lock(mutex_);
+  const auto snapshot = snapshot_.load();
+  return {snapshot->non_finalized_blks.size(), snapshot->non_finalized_blks_count};
+}
+
+std::vector<std::pair<DagManager::VerifyBlockReturnType, SharedTransactions>> DagManager::verifyBlocksBatch(
+    const std::vector<std::shared_ptr<DagBlock>> &blocks,
+    const std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> &trxs) {
+  std::vector<std::pair<VerifyBlockReturnType, SharedTransactions>> results(blocks.size());
+
+  // Blocks verified on the pool do not post their checks to the same pool, waiting for them could exhaust it
+  const auto verify = [&](size_t begin, size_t end, bool concurrent_checks) {
+    for (size_t i = begin; i < end; i++) {
+      results[i] = verifyBlock(blocks[i], trxs, concurrent_checks);
+    }
+  };
 
-  size_t blocks_counter = 0;
-  for (auto it = non_finalized_blks_.begin(); it != non_finalized_blks_.end(); ++it) {
-    blocks_counter += it->second.size();
+  if (blocks.size() < kMinParallelBlocksVerifications) {
+    verify(0, blocks.size(), true);
+    return results;
   }
 
-  return {non_finalized_blks_.size(), blocks_counter};
+  const size_t chunk_size = (blocks.size() + kBlocksVerificationTasksCount - 1) / kBlocksVerificationTasksCount;
+  std::vector<std::future<void>> futures;
+  futures.reserve(kBlocksVerificationTasksCount);
+  for (size_t begin = 0; begin < blocks.size(); begin += chunk_size) {
+    futures.push_back(blocks_verification_executor_.post(
+        [&verify, begin, end = std::min(begin + chunk_size, blocks.size())] { verify(begin, end, false); }));
+  }
+  for (auto &future : futures) {
+    future.get();
+  }
+
+  return results;
 }
 
 std::pair<DagManager::VerifyBlockReturnType, SharedTransactions> DagManager::verifyBlock(
     const std::shared_ptr<DagBlock> &blk, const std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> &trxs) {
+  return verifyBlock(blk, trxs, true);
+}
+
+std::pair<DagManager::VerifyBlockReturnType, SharedTransactions> DagManager::verifyBlock(
+    const std::shared_ptr<DagBlock> &blk, const std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> &trxs,
+    bool concurrent_checks) {
+  // Checks are ordered by cost, so invalid blocks are rejected before VDF verification and transactions estimation
   const auto &block_hash = blk->getHash();
   vec_trx_t const &all_block_trx_hashes = blk->getTrxs();
   vec_trx_t trx_hashes_to_query;
@@ -591,6 +750,12 @@ std::pair<DagManager::VerifyBlockReturnType, SharedTransactions> DagManager::ver
     }
   }
 
+  if (blk->getLevel() < dag_expiry_level_) {
+    LOG(log_nf_) << "Dropping old block: " << blk->getHash() << ". Expiry level: " << dag_expiry_level_
+                 << ". Block level: " << blk->getLevel();
+    return {VerifyBlockReturnType::ExpiredBlock, {}};
+  }
+
   auto propose_period = db_->getProposalPeriodForDagLevel(blk->getLevel());
 
   // Verify DPOS
@@ -601,6 +766,15 @@ std::pair<DagManager::VerifyBlockReturnType, SharedTransactions> DagManager::ver
     return {VerifyBlockReturnType::AheadBlock, {}};
   }
 
+  const auto [dag_gas_limit, pbft_gas_limit] = kGenesis.getGasLimits(*propose_period);
+  const auto block_gas_estimation = blk->getGasEstimation();
+  if (block_gas_estimation > dag_gas_limit) {
+    LOG(log_er_) << "BlockTooBig. DAG block " << blk->getHash() << " gas_limit: " << dag_gas_limit
+                 << " block_gas_estimation " << block_gas_estimation << " current period "
+                 << final_chain_->lastBlockNumber();
+    return {VerifyBlockReturnType::BlockTooBig, {}};
+  }
+
   if (trxs.size() != 0) {
     for (auto const &tx_hash : all_block_trx_hashes) {
       auto trx_it = trxs.find(tx_hash);
@@ -628,13 +802,24 @@ std::pair<DagManager::VerifyBlockReturnType, SharedTransactions> DagManager::ver
     all_block_trxs.emplace_back(std::move(t));
   }
 
-  if (blk->getLevel() < dag_expiry_level_) {
-    LOG(log_nf_) << "Dropping old block: " << blk->getHash() << ". Expiry level: " << dag_expiry_level_
-                 << ". Block level: " << blk->getLevel();
-    return {VerifyBlockReturnType::ExpiredBlock, {}};
+  if ((blk->getTips().size() + 1) > pbft_gas_limit / dag_gas_limit) {
+    auto gas_estimation_with_tips = block_gas_estimation;
+    for (const auto &t : blk->getTips()) {
+      const auto tip_blk = getDagBlock(t);
+      if (tip_blk == nullptr) {
+        LOG(log_er_) << "DAG Block " << block_hash << " tip " << t << " not present";
+        return {VerifyBlockReturnType::MissingTip, {}};
+      }
+      gas_estimation_with_tips += tip_blk->getGasEstimation();
+    }
+    if (gas_estimation_with_tips > pbft_gas_limit) {
+      LOG(log_er_) << "BlockTooBig. DAG block " << blk->getHash() << " with tips has limit: " << pbft_gas_limit
+                   << " block_gas_estimation " << gas_estimation_with_tips << " current period "
+                   << final_chain_->lastBlockNumber();
+      return {VerifyBlockReturnType::BlockTooBig, {}};
+    }
   }
 
-  // Verify VDF solution
   const auto pk = key_manager_->getVrfKey(*propose_period, blk->getSender());
   if (!pk) {
     LOG(log_er_) << "DAG block " << blk->getHash() << " with " << blk->getLevel()
@@ -642,6 +827,34 @@ std::pair<DagManager::VerifyBlockReturnType, SharedTransactions> DagManager::ver
     return {VerifyBlockReturnType::FailedVdfVerification, {}};
   }
 
+  auto dag_block_sender = blk->getSender();
+  bool dpos_qualified;
+  try {
+    dpos_qualified = final_chain_->dposIsEligible(*propose_period, dag_block_sender);
+  } catch (state_api::ErrFutureBlock &c) {
+    LOG(log_er_) << "Verify proposal period " << *propose_period << " is too far ahead of DPOS. " << c.what();
+    return {VerifyBlockReturnType::FutureBlock, {}};
+  }
+  if (!dpos_qualified) {
+    LOG(log_er_) << "Invalid DAG block DPOS. DAG block " << blk << " is not eligible for DPOS at period "
+                 << *propose_period << " for sender " << dag_block_sender.toString() << " current period "
+                 << final_chain_->lastBlockNumber();
+    return {VerifyBlockReturnType::NotEligible, {}};
+  }
+
+  // Transactions estimation runs on the pool while VDF is verified here, failed VDF returns without waiting for it.
+  // Task holds its own copies, so it can outlive this call
+  std::future<uint64_t> total_block_weight;
+  if (concurrent_checks && !all_block_trxs.empty()) {
+    auto estimation = std::make_shared<std::packaged_task<uint64_t()>>(
+        [trx_mgr = trx_mgr_, trxs = all_block_trxs, period = *propose_period] {
+          return trx_mgr->estimateTransactions(trxs, period);
+        });
+    total_block_weight = estimation->get_future();
+    blocks_verification_executor_.post([estimation] { (*estimation)(); });
+  }
+
+  // Verify VDF solution
   try {
     const auto proposal_period_hash = db_->getPeriodBlockHash(*propose_period);
     uint64_t max_vote_count = 0;
@@ -660,54 +873,14 @@ std::pair<DagManager::VerifyBlockReturnType, SharedTransactions> DagManager::ver
     return {VerifyBlockReturnType::FailedVdfVerification, {}};
   }
 
-  auto dag_block_sender = blk->getSender();
-  bool dpos_qualified;
-  try {
-    dpos_qualified = final_chain_->dposIsEligible(*propose_period, dag_block_sender);
-  } catch (state_api::ErrFutureBlock &c) {
-    LOG(log_er_) << "Verify proposal period " << *propose_period << " is too far ahead of DPOS. " << c.what();
-    return {VerifyBlockReturnType::FutureBlock, {}};
-  }
-  if (!dpos_qualified) {
-    LOG(log_er_) << "Invalid DAG block DPOS. DAG block " << blk << " is not eligible for DPOS at period "
-                 << *propose_period << " for sender " << dag_block_sender.toString() << " current period "
-                 << final_chain_->lastBlockNumber();
-    return {VerifyBlockReturnType::NotEligible, {}};
-  }
-  {
-    const auto [dag_gas_limit, pbft_gas_limit] = kGenesis.getGasLimits(*propose_period);
-
-    auto block_gas_estimation = blk->getGasEstimation();
-    if (block_gas_estimation > dag_gas_limit) {
-      LOG(log_er_) << "BlockTooBig. DAG block " << blk->getHash() << " gas_limit: " << dag_gas_limit
-                   << " block_gas_estimation " << block_gas_estimation << " current period "
-                   << final_chain_->lastBlockNumber();
-      return {VerifyBlockReturnType::BlockTooBig, {}};
-    }
-    auto total_block_weight = trx_mgr_->estimateTransactions(all_block_trxs, *propose_period);
-    if (total_block_weight != block_gas_estimation) {
-      LOG(log_er_) << "Invalid block_gas_estimation. DAG block " << blk->getHash()
-                   << " block_gas_estimation: " << block_gas_estimation << " total_block_weight " << total_block_weight
-                   << " current period " << final_chain_->lastBlockNumber();
-      return {VerifyBlockReturnType::IncorrectTransactionsEstimation, {}};
-    }
-
-    if ((blk->getTips().size() + 1) > pbft_gas_limit / dag_gas_limit) {
-      for (const auto &t : blk->getTips()) {
-        const auto tip_blk = getDagBlock(t);
-        if (tip_blk == nullptr) {
-          LOG(log_er_) << "DAG Block " << block_hash << " tip " << t << " not present";
-          return {VerifyBlockReturnType::MissingTip, {}};
-        }
-        block_gas_estimation += tip_blk->getGasEstimation();
-      }
-      if (block_gas_estimation > pbft_gas_limit) {
-        LOG(log_er_) << "BlockTooBig. DAG block " << blk->getHash() << " with tips has limit: " << pbft_gas_limit
-                     << " block_gas_estimation " << block_gas_estimation << " current period "
-                     << final_chain_->lastBlockNumber();
-        return {VerifyBlockReturnType::BlockTooBig, {}};
-      }
-    }
+  const auto block_weight = total_block_weight.valid()
+                                ? total_block_weight.get()
+                                : trx_mgr_->estimateTransactions(all_block_trxs, *propose_period);
+  if (block_weight != block_gas_estimation) {
+    LOG(log_er_) << "Invalid block_gas_estimation. DAG block " << blk->getHash()
+                 << " block_gas_estimation: " << block_gas_estimation << " total_block_weight " << block_weight
+                 << " current period " << final_chain_->lastBlockNumber();
+    return {VerifyBlockReturnType::IncorrectTransactionsEstimation, {}};
   }
 
   LOG(log_dg_) << "Verified DAG block " << blk->getHash();
@@ -723,6 +896,8 @@ bool DagManager::isDagBlockKnown(const blk_hash_t &hash) const {
   return true;
 }
 
+bool DagManager::isDagBlockSeen(const blk_hash_t &hash) const { return seen_blocks_.count(hash); }
+
 std::shared_ptr<DagBlock> DagManager::getDagBlock(const blk_hash_t &hash) const {
   auto blk = seen_blocks_.get(hash);
   if (blk.second) {
@@ -1,6 +1,7 @@
 #include "dag/sortition_params_manager.hpp"
 
 #include <config/config.hpp>
+#include <limits>
 
 namespace taraxa {
 
@@ -45,6 +46,10 @@ SortitionParamsManager::SortitionParamsManager(const addr_t& node_addr, const Fu
     sortition_config_.vrf = params_changes_.back().vrf_params;
   }
 
+  // Whole history is small (one change per changing_interval), keep it in memory to serve VDF validation on sync
+  const auto all_changes = db_->getLastSortitionParams(std::numeric_limits<size_t>::max());
+  params_changes_history_.assign(all_changes.begin(), all_changes.end());
+
   auto period = params_changes_.back().period + 1;
   ignored_efficiency_counter_ = 0;
   while (true) {
@@ -71,7 +76,7 @@ SortitionParams SortitionParamsManager::getSortitionParams(std::optional<PbftPer
   }
 
   SortitionParams p = sortition_config_;
-  auto change = db_->getParamsChangeForPeriod(*period);
+  auto change = getParamsChangeForPeriod(*period);
   if (change.has_value()) {
     p.vrf = change->vrf_params;
   }
@@ -79,6 +84,17 @@ SortitionParams SortitionParamsManager::getSortitionParams(std::optional<PbftPer
   return p;
 }
 
+std::optional<SortitionParamsChange> SortitionParamsManager::getParamsChangeForPeriod(PbftPeriod period) const {
+  std::shared_lock lock(params_changes_history_mutex_);
+  auto it = std::upper_bound(params_changes_history_.begin(), params_changes_history_.end(), period,
+                             [](PbftPeriod p, const SortitionParamsChange& change) { return p < change.period; });
+  if (it == params_changes_history_.begin()) {
+    return {};
+  }
+
+  return *std::prev(it);
+}
+
 uint16_t SortitionParamsManager::calculateDagEfficiency(const PeriodData& block) const {
   size_t total_transactions_count = 0;
   for (const auto& dag_block : block.dag_blocks) {
@@ -119,6 +135,17 @@ void SortitionParamsManager::pbftBlockPushed(const PeriodData& block, Batch& bat
       const auto params_change = calculateChange(period);
       params_changes_.push_back(params_change);
       db_->saveSortitionParamsChange(period, params_change, batch);
+      {
+        std::unique_lock lock(params_changes_history_mutex_);
+        // Keep the history in period order; the same period is stored under the same db key and replaces the change
+        auto it = std::lower_bound(params_changes_history_.begin(), params_changes_history_.end(), period,
+                                   [](const SortitionParamsChange& change, PbftPeriod p) { return change.period < p; });
+        if (it != params_changes_history_.end() && it->period == period) {
+          *it = params_change;
+        } else {
+          params_changes_history_.insert(it, params_change);
+        }
+      }
       cleanup();
       ignored_efficiency_counter_ = 0;
     }
@@ -63,4 +63,6 @@ dev::bytes BlockHeader::ethereumRlp() const {
 RLP_FIELDS_DEFINE(BlockHeader, hash, parent_hash, author, state_root, transactions_root, receipts_root, log_bloom,
                   number, gas_limit, gas_used, timestamp, total_reward, extra_data)
 
+RLP_FIELDS_DEFINE(HistoricalBlock, pbft_block, header_data, transactions, system_transactions, receipts)
+
 }  // namespace taraxa::final_chain
\ No newline at end of file
@@ -2,9 +2,15 @@
 
 #include <libdevcore/RLP.h>
 
+#include <algorithm>
+#include <future>
+#include <map>
+#include <unordered_set>
 #include <utility>
 
 #include "common/encoding_solidity.hpp"
+#include "common/thread_placement.hpp"
+#include "common/tracing.hpp"
 #include "common/types.hpp"
 #include "common/util.hpp"
 #include "final_chain/state_api_data.hpp"
@@ -18,48 +24,97 @@ FinalChain::FinalChain(const std::shared_ptr<DbStorage>& db, const taraxa::FullN
                        const addr_t& node_addr)
     : db_(db),
       kBlockGasLimit(config.genesis.pbft.gas_limit),
-      state_api_([this](auto n) { return blockHash(n).value_or(ZeroHash()); },  //
-                 config.genesis.state, config.opts_final_chain,
-                 {
-                     db->stateDbStoragePath().string(),
-                 }),
+      state_api_(db->isSecondary() ? nullptr
+                                   : std::make_unique<StateAPI>(
+                                         [this](auto n) { return blockHash(n).value_or(ZeroHash()); },
+                                         config.genesis.state, config.opts_final_chain,
+                                         state_api::OptsDB{db->stateDbStoragePath().string()})),
       kMaxLevelsPerPeriod(config.max_levels_per_period),
       rewards_(
           config.genesis.pbft.committee_size, config.genesis.state.hardforks, db_,
           [this](EthBlockNumber n) { return dposEligibleTotalVoteCount(n); },
-          state_api_.get_last_committed_state_descriptor().blk_num),
-      block_headers_cache_(config.final_chain_cache_in_blocks, [this](uint64_t blk) { return getBlockHeader(blk); }),
+          // Replica does not distribute rewards, so stats of primary are not cleared
+          state_api_ ? state_api_->get_last_committed_state_descriptor().blk_num : 0),
+      kPipelinedCommit(config.final_chain_pipelined_commit),
+      kPrefetchState(config.final_chain_prefetch_state),
+      block_headers_cache_(
+          config.final_chain_cache_in_blocks, [this](uint64_t blk) { return getBlockHeader(blk); },
+          [](const std::shared_ptr<const BlockHeader>& header) { return sizeof(header) + sizeof(BlockHeader); }),
       block_hashes_cache_(config.final_chain_cache_in_blocks, [this](uint64_t blk) { return getBlockHash(blk); }),
-      transactions_cache_(config.final_chain_cache_in_blocks, [this](uint64_t blk) { return getTransactions(blk); }),
-      transaction_hashes_cache_(config.final_chain_cache_in_blocks,
-                                [this](uint64_t blk) { return getTransactionHashes(blk); }),
+      transactions_cache_(
+          config.final_chain_cache_in_blocks, [this](uint64_t blk) { return getTransactions(blk); },
+          [](const SharedTransactions& trxs) {
+            size_t size = sizeof(SharedTransactions);
+            for (const auto& trx : trxs) {
+              size += sizeof(SharedTransaction) + sizeof(Transaction) + trx->rlp().size();
+            }
+            return size;
+          }),
+      transaction_hashes_cache_(
+          config.final_chain_cache_in_blocks, [this](uint64_t blk) { return getTransactionHashes(blk); },
+          [](const std::shared_ptr<const TransactionHashes>& hashes) {
+            return sizeof(hashes) + (hashes ? sizeof(TransactionHashes) + hashes->size() * sizeof(trx_hash_t) : 0);
+          }),
       accounts_cache_(config.final_chain_cache_in_blocks,
-                      [this](uint64_t blk, const addr_t& addr) { return state_api_.get_account(blk, addr); }),
+                      [this](uint64_t blk, const addr_t& addr) { return stateAPI().get_account(blk, addr); }),
+      storage_cache_(config.final_chain_storage_cache_size, config.final_chain_storage_cache_size / 10 + 1),
+      code_cache_(config.final_chain_code_cache_size, config.final_chain_code_cache_size / 10 + 1),
+      blooms_chunks_cache_(kBloomsChunksCacheSize, kBloomsChunksCacheSize / 10 + 1),
       total_vote_count_cache_(config.final_chain_cache_in_blocks,
-                              [this](uint64_t blk) { return state_api_.dpos_eligible_total_vote_count(blk); }),
+                              [this](uint64_t blk) { return stateAPI().dpos_eligible_total_vote_count(blk); }),
       dpos_vote_count_cache_(
           config.final_chain_cache_in_blocks,
-          [this](uint64_t blk, const addr_t& addr) { return state_api_.dpos_eligible_vote_count(blk, addr); }),
+          [this](uint64_t blk, const addr_t& addr) { return stateAPI().dpos_eligible_vote_count(blk, addr); }),
       dpos_is_eligible_cache_(
           config.final_chain_cache_in_blocks,
-          [this](uint64_t blk, const addr_t& addr) { return state_api_.dpos_is_eligible(blk, addr); }),
-      block_receipts_cache_(config.final_chain_cache_in_blocks, [this](uint64_t blk) { return getBlockReceipts(blk); }),
+          [this](uint64_t blk, const addr_t& addr) { return stateAPI().dpos_is_eligible(blk, addr); }),
+      block_receipts_cache_(
+          config.final_chain_cache_in_blocks, [this](uint64_t blk) { return getBlockReceipts(blk); },
+          [](const SharedTransactionReceipts& receipts) {
+            size_t size = sizeof(SharedTransactionReceipts);
+            if (!receipts) {
+              return size;
+            }
+            for (const auto& receipt : *receipts) {
+              size += sizeof(TransactionReceipt);
+              for (const auto& log : receipt.logs) {
+                size += sizeof(LogEntry) + log.topics.size() * sizeof(h256) + log.data.size();
+              }
+            }
+            return size;
+          }),
+      trx_locations_cache_(config.final_chain_trx_location_cache_size,
+                           config.final_chain_trx_location_cache_size / 10 + 1),
+      historical_blocks_cache_(0, 1),
       kConfig(config) {
   LOG_OBJECTS_CREATE("EXECUTOR");
   num_executed_dag_blk_ = db_->getStatusField(taraxa::StatusDbField::ExecutedBlkCount);
   num_executed_trx_ = db_->getStatusField(taraxa::StatusDbField::ExecutedTrxCount);
-  auto state_db_descriptor = state_api_.get_last_committed_state_descriptor();
   auto last_blk_num = db_->lookup_int<EthBlockNumber>(DBMetaKeys::LAST_NUMBER, DbStorage::Columns::final_chain_meta);
-  // If we don't have genesis block in db then create and push it
-  if (!last_blk_num) [[unlikely]] {
+  const auto state_db_descriptor =
+      state_api_ ? state_api_->get_last_committed_state_descriptor() : state_api::StateDescriptor{};
+  if (db_->isSecondary()) {
+    if (!last_blk_num) {
+      throw std::runtime_error("Final chain of primary db is not initialized");
+    }
+    setLastBlockNumber(*last_blk_num);
+    block_headers_cache_.get(last_block_number_);
+  } else if (!last_blk_num) [[unlikely]] {
+    // If we don't have genesis block in db then create and push it
     auto batch = db_->createWriteBatch();
     auto header = makeGenesisHeader(state_db_descriptor.state_root);
     appendBlock(batch, header, {}, {});
 
     block_headers_cache_.append(header->number, header);
-    last_block_number_ = header->number;
+    setLastBlockNumber(header->number);
     db_->commitWriteBatch(batch);
   } else {
+    // State db can't be reverted, so it must never be ahead of the main db
+    if (*last_blk_num < state_db_descriptor.blk_num) [[unlikely]] {
+      throw std::runtime_error("State db block " + std::to_string(state_db_descriptor.blk_num) +
+                               " is ahead of final chain block " + std::to_string(*last_blk_num) +
+                               ". Use db_revert_to_period to recover from the snapshot");
+    }
     // We need to recover latest changes as there was shutdown inside finalize function
     if (*last_blk_num != state_db_descriptor.blk_num) [[unlikely]] {
       auto batch = db_->createWriteBatch();
@@ -80,7 +135,7 @@ FinalChain::FinalChain(const std::shared_ptr<DbStorage>& db, const taraxa::FullN
       db_->commitWriteBatch(batch);
       last_blk_num = state_db_descriptor.blk_num;
     }
-    last_block_number_ = *last_blk_num;
+    setLastBlockNumber(*last_blk_num);
 
     int64_t start = 0;
     if (*last_blk_num > 5) {
@@ -91,27 +146,151 @@ FinalChain::FinalChain(const std::shared_ptr<DbStorage>& db, const taraxa::FullN
     }
   }
 
+  // Logs index covers only blocks executed after it was enabled, older blocks are searched with blooms
+  if (db_->isSecondary()) {
+    // Index is maintained by primary
+    logs_index_from_ =
+        db_->lookup_int<EthBlockNumber>(DBMetaKeys::LOGS_INDEX_FROM, DbStorage::Columns::final_chain_meta);
+  } else if (config.final_chain_logs_index) {
+    logs_index_from_ =
+        db_->lookup_int<EthBlockNumber>(DBMetaKeys::LOGS_INDEX_FROM, DbStorage::Columns::final_chain_meta);
+    if (!logs_index_from_) {
+      logs_index_from_ = last_block_number_ + 1;
+      db_->insert(DbStorage::Columns::final_chain_meta, DBMetaKeys::LOGS_INDEX_FROM, *logs_index_from_);
+    }
+  } else {
+    // Index is not maintained anymore, so its start has to be reset once it is enabled again
+    db_->remove(DbStorage::Columns::final_chain_meta, DBMetaKeys::LOGS_INDEX_FROM);
+  }
+
   delegation_delay_ = config.genesis.state.dpos.delegation_delay;
+
+  for (auto* thread : {&executor_thread_, &commit_thread_, &prefetch_thread_}) {
+    boost::asio::post(*thread, [] { util::placeCurrentThread(util::thread_group::kFinalChain); });
+  }
 }
 
-void FinalChain::stop() { executor_thread_.join(); }
+void FinalChain::stop() {
+  executor_thread_.join();
+  commit_thread_.join();
+  prefetch_thread_.join();
+}
+
+void FinalChain::catchUpWithPrimary() {
+  db_->tryCatchUpWithPrimary();
+  const auto new_last_blk_num =
+      db_->lookup_int<EthBlockNumber>(DBMetaKeys::LAST_NUMBER, DbStorage::Columns::final_chain_meta).value_or(0);
+  if (new_last_blk_num <= last_block_number_) {
+    return;
+  }
+  num_executed_dag_blk_ = db_->getStatusField(taraxa::StatusDbField::ExecutedBlkCount);
+  num_executed_trx_ = db_->getStatusField(taraxa::StatusDbField::ExecutedTrxCount);
+  for (auto blk_n = last_block_number_ + 1; blk_n <= new_last_blk_num; ++blk_n) {
+    auto header = block_headers_cache_.get(blk_n);
+    const auto receipts = block_receipts_cache_.get(blk_n);
+    auto result = std::make_shared<FinalizationResult>(FinalizationResult{
+        {
+            header->author,
+            header->timestamp,
+            db_->getFinalizedDagBlockHashesByPeriod(blk_n),
+            db_->getPeriodBlockHash(blk_n),
+        },
+        header,
+        transactions(blk_n),
+        receipts ? *receipts : TransactionReceipts{},
+    });
+    setLastBlockNumber(blk_n);
+    block_finalized_emitter_.emit(result);
+  }
+}
 
 std::future<std::shared_ptr<const FinalizationResult>> FinalChain::finalize(
     PeriodData&& new_blk, std::vector<h256>&& finalized_dag_blk_hashes, uint32_t blocks_per_year,
     std::shared_ptr<DagBlock>&& anchor) {
+  if (kPrefetchState && !new_blk.transactions.empty() && pending_prefetches_ < kMaxPendingPrefetches) {
+    pending_prefetches_++;
+    boost::asio::post(prefetch_thread_, [this, transactions = new_blk.transactions]() {
+      prefetchState(transactions);
+      pending_prefetches_--;
+    });
+  }
+
   auto p = std::make_shared<std::promise<std::shared_ptr<const FinalizationResult>>>();
   boost::asio::post(executor_thread_,
                     [this, new_blk = std::move(new_blk), finalized_dag_blk_hashes = std::move(finalized_dag_blk_hashes),
                      anchor_block = std::move(anchor), blocks_per_year, p]() mutable {
-                      p->set_value(finalize_(std::move(new_blk), std::move(finalized_dag_blk_hashes), blocks_per_year,
-                                             std::move(anchor_block)));
-                      finalized_cv_.notify_one();
+                      auto result = finalize_(std::move(new_blk), std::move(finalized_dag_blk_hashes), blocks_per_year,
+                                              std::move(anchor_block));
+                      const auto blk_n = result->final_chain_blk->number;
+                      // Create dpos snapshot before anyone is notified, votes for the next period are checked against it
+                      {
+                        util::StageTimings::Scope timing(stage_timings_, "snapshot");
+                        dposValidatorsSnapshot(blk_n);
+                      }
+                      if (!kPipelinedCommit) {
+                        commitFinalized(result, p);
+                        util::StageTimings::Scope timing(stage_timings_, "snapshot");
+                        createSnapshotIfNeeded(blk_n);
+                        return;
+                      }
+
+                      // Wait for the previous period to be announced so there is at most one period in flight
+                      {
+                        std::unique_lock lock(commit_mtx_);
+                        commit_cv_.wait(lock, [this] { return !commit_in_progress_; });
+                        commit_in_progress_ = true;
+                      }
+                      boost::asio::post(commit_thread_, [this, result = std::move(result), p]() {
+                        commitFinalized(result, p);
+                        {
+                          std::unique_lock lock(commit_mtx_);
+                          commit_in_progress_ = false;
+                        }
+                        commit_cv_.notify_one();
+                      });
+                      // Snapshot has to be created on executor thread as state db must not change in the meantime
+                      util::StageTimings::Scope timing(stage_timings_, "snapshot");
+                      createSnapshotIfNeeded(blk_n);
                     });
   return p->get_future();
 }
 
+void FinalChain::commitFinalized(
+    const std::shared_ptr<FinalizationResult>& result,
+    const std::shared_ptr<std::promise<std::shared_ptr<const FinalizationResult>>>& promise) {
+  block_finalized_emitter_.emit(result);
+  LOG(log_nf_) << " successful finalize block " << result->hash << " with number " << result->final_chain_blk->number;
+  promise->set_value(result);
+  finalized_cv_.notify_one();
+}
+
+void FinalChain::prefetchState(const SharedTransactions& transactions) const {
+  const auto blk_num = lastBlockNumber();
+  std::unordered_set<addr_t> accounts;
+  accounts.reserve(transactions.size() * 2);
+  for (const auto& trx : transactions) {
+    accounts.insert(trx->getSender());
+    if (const auto& receiver = trx->getReceiver()) {
+      accounts.insert(*receiver);
+    }
+  }
+
+  try {
+    for (const auto& addr : accounts) {
+      if (const auto account = stateAPI().get_account(blk_num, addr); account && account->code_size) {
+        stateAPI().get_code_by_address(blk_num, addr);
+      }
+    }
+  } catch (const std::exception& e) {
+    // Prefetching is only an optimization, execution reads the same data again
+    LOG(log_dg_) << "State prefetch for block " << blk_num << " failed: " << e.what();
+  }
+}
+
 EthBlockNumber FinalChain::delegationDelay() const { return delegation_delay_; }
 
+void FinalChain::setStageTimings(std::shared_ptr<util::StageTimings> timings) { stage_timings_ = std::move(timings); }
+
 SharedTransaction FinalChain::makeBridgeFinalizationTransaction() {
   const static auto finalize_method = util::EncodingSolidity::packFunctionCall("finalizeEpoch()");
   auto account = getAccount(kTaraxaSystemAccount).value_or(state_api::ZeroAccount);
@@ -149,10 +328,10 @@ std::vector<SharedTransaction> FinalChain::makeSystemTransactions(PbftPeriod blk
   return system_transactions;
 }
 
-std::shared_ptr<const FinalizationResult> FinalChain::finalize_(PeriodData&& new_blk,
-                                                                std::vector<h256>&& finalized_dag_blk_hashes,
-                                                                uint32_t blocks_per_year,
-                                                                std::shared_ptr<DagBlock>&& anchor) {
+std::shared_ptr<FinalizationResult> FinalChain::finalize_(PeriodData&& new_blk,
+                                                          std::vector<h256>&& finalized_dag_blk_hashes,
+                                                          uint32_t blocks_per_year, std::shared_ptr<DagBlock>&& anchor) {
+  TRACE_SPAN("FinalChain::finalize");
   auto batch = db_->createWriteBatch();
 
   block_applying_emitter_.emit(blockHeader()->number + 1);
@@ -178,23 +357,33 @@ std::shared_ptr<const FinalizationResult> FinalChain::finalize_(PeriodData&& new
 
   auto all_transactions = new_blk.transactions;
   all_transactions.insert(all_transactions.end(), system_transactions.begin(), system_transactions.end());
-  std::vector<state_api::EVMTransaction> evm_trxs;
-  appendEvmTransactions(evm_trxs, all_transactions);
 
-  const auto& [exec_results] = state_api_.execute_transactions(
+  // Rewards stats depend only on period data and committed dpos state, except of fees that are added after execution.
+  // Future destructor waits for the task, so it never outlives new_blk even if execution throws
+  auto block_stats = std::async(std::launch::async,
+                                [&] { return rewards_.prepareBlockStats(new_blk, blocks_per_year); });
+  // Transactions are known before execution, so their trie is hashed meanwhile. Arena is used only by execution thread
+  auto transactions_root = std::async(std::launch::async, [&] {
+    return transactionsRoot(all_transactions, std::pmr::get_default_resource());
+  });
+
+  std::optional<util::StageTimings::Scope> timing(std::in_place, stage_timings_, "evm_execution");
+  auto& [exec_results] = stateAPI().execute_transactions(
       {new_blk.pbft_blk->getBeneficiary(), kBlockGasLimit, new_blk.pbft_blk->getTimestamp(), BlockHeader::difficulty()},
-      evm_trxs);
+      all_transactions);
+  timing.reset();
   TransactionReceipts receipts;
   receipts.reserve(exec_results.size());
   std::vector<gas_t> transactions_gas_used;
   transactions_gas_used.reserve(exec_results.size());
 
   gas_t cumulative_gas_used = 0;
-  for (const auto& r : exec_results) {
+  for (auto& r : exec_results) {
+    // Results buffer is reused by the next execution, so logs are moved out of it instead of copied
     LogEntries logs;
     logs.reserve(r.logs.size());
-    std::transform(r.logs.cbegin(), r.logs.cend(), std::back_inserter(logs),
-                   [](const auto& l) { return LogEntry{l.address, l.topics, l.data}; });
+    std::transform(r.logs.begin(), r.logs.end(), std::back_inserter(logs),
+                   [](auto& l) { return LogEntry{l.address, std::move(l.topics), std::move(l.data)}; });
     transactions_gas_used.push_back(r.gas_used);
     receipts.emplace_back(TransactionReceipt{
         r.code_err.empty() && r.consensus_err.empty(),
@@ -205,10 +394,13 @@ std::shared_ptr<const FinalizationResult> FinalChain::finalize_(PeriodData&& new
     });
   }
 
-  auto rewards_stats = rewards_.processStats(new_blk, blocks_per_year, transactions_gas_used, batch);
-  const auto& [state_root, total_reward] = state_api_.distribute_rewards(rewards_stats);
+  timing.emplace(stage_timings_, "rewards");
+  auto rewards_stats = rewards_.processStats(new_blk, block_stats.get(), transactions_gas_used, batch);
+  const auto& [state_root, total_reward] = stateAPI().distribute_rewards(rewards_stats);
+  timing.reset();
 
-  auto blk_header = appendBlock(batch, *new_blk.pbft_blk, state_root, total_reward, all_transactions, receipts);
+  auto blk_header = appendBlock(batch, *new_blk.pbft_blk, state_root, total_reward, all_transactions, receipts,
+                                transactions_root.get());
 
   // Update number of executed DAG blocks and transactions
   auto num_executed_dag_blk = num_executed_dag_blk_ + finalized_dag_blk_hashes.size();
@@ -253,68 +445,122 @@ std::shared_ptr<const FinalizationResult> FinalChain::finalize_(PeriodData&& new
   });
 
   // Please do not change order of these three lines :)
+  // Batch has to be synced before state commit in both modes. State db can't be reverted, so a state commit that
+  // survives a power loss while the main db WAL tail is lost would leave node unable to start
+  timing.emplace(stage_timings_, "db_commit");
   db_->commitWriteBatch(batch, db_->sync_write_);
-  state_api_.transition_state_commit();
+  stateAPI().transition_state_commit();
+  timing.reset();
   rewards_.clear(new_blk.pbft_blk->getPeriod());
 
   num_executed_dag_blk_ = num_executed_dag_blk;
   num_executed_trx_ = num_executed_trx;
   block_headers_cache_.append(blk_header->number, blk_header);
-  last_block_number_ = blk_header->number;
-  block_finalized_emitter_.emit(result);
-  LOG(log_nf_) << " successful finalize block " << result->hash << " with number " << blk_header->number;
-
-  // Creates snapshot if needed
-  if (db_->createSnapshot(blk_header->number)) {
-    state_api_.create_snapshot(blk_header->number);
+  setLastBlockNumber(blk_header->number);
+
+  // Recently finalized transactions are queried the most, so their receipts and locations are served from memory
+  block_receipts_cache_.append(blk_header->number, std::make_shared<TransactionReceipts>(result->trx_receipts));
+  if (kConfig.final_chain_trx_location_cache_size) {
+    const auto system_trxs_begin = new_blk.transactions.size();
+    for (uint32_t position = 0; position < result->trxs.size(); ++position) {
+      trx_locations_cache_.insert(result->trxs[position]->getHash(),
+                                  {blk_header->number, position, position >= system_trxs_begin});
+    }
   }
 
   return result;
 }
 
+void FinalChain::createSnapshotIfNeeded(EthBlockNumber blk_n) {
+  if (!db_->isSnapshotPeriod(blk_n)) {
+    return;
+  }
+  // State db snapshot goes first, main db checkpoint is taken in background and must not be behind it
+  stateAPI().create_snapshot(blk_n);
+  db_->createSnapshot(blk_n);
+}
+
 void FinalChain::prune(EthBlockNumber blk_n) {
+  constexpr size_t kHeadersPerBatch = 10000;
+  pruneStateDb(blk_n);
+  while (pruneBlockHeaders(kHeadersPerBatch, db_->async_write_)) {
+  }
+
+  db_->scheduleCompaction(DbStorage::Columns::final_chain_blk_by_number);
+  db_->scheduleCompaction(DbStorage::Columns::final_chain_blk_hash_by_number);
+  db_->scheduleCompaction(DbStorage::Columns::final_chain_blk_number_by_hash);
+}
+
+void FinalChain::pruneStateDb(EthBlockNumber blk_n) {
   LOG(log_nf_) << "Pruning data older than " << blk_n;
   auto last_block_to_keep = getBlockHeader(blk_n);
-  if (last_block_to_keep) {
-    auto block_to_keep = last_block_to_keep;
-    std::vector<dev::h256> state_root_to_keep;
-    while (block_to_keep) {
-      state_root_to_keep.push_back(block_to_keep->state_root);
-      block_to_keep = getBlockHeader(block_to_keep->number + 1);
-    }
-
-    auto state_db_promise = std::make_shared<std::promise<void>>();
-    // execute state_db prune in a separate thread.
-    // We could use executor_thread_ here because finalize won't be called during the pruning
-    auto last_block_number_to_keep = last_block_to_keep->number;
-    boost::asio::post(executor_thread_, [this, state_root_to_keep = std::move(state_root_to_keep),
-                                         last_block_number_to_keep, state_db_promise]() mutable {
-      state_api_.prune(state_root_to_keep, last_block_number_to_keep);
-      state_db_promise->set_value();
-    });
+  if (!last_block_to_keep) {
+    return;
+  }
+  auto block_to_keep = last_block_to_keep;
+  std::vector<dev::h256> state_root_to_keep;
+  while (block_to_keep) {
+    state_root_to_keep.push_back(block_to_keep->state_root);
+    block_to_keep = getBlockHeader(block_to_keep->number + 1);
+  }
 
-    auto block_to_prune = getBlockHeader(last_block_number_to_keep - 1);
-    auto batch = db_->createWriteBatch();
-    while (block_to_prune && block_to_prune->number > 0) {
-      db_->remove(batch, DbStorage::Columns::final_chain_blk_by_number, block_to_prune->number);
-      db_->remove(batch, DbStorage::Columns::final_chain_blk_hash_by_number, block_to_prune->number);
-      db_->remove(batch, DbStorage::Columns::final_chain_blk_number_by_hash, block_to_prune->hash);
-      block_to_prune = getBlockHeader(block_to_prune->number - 1);
-    }
-    db_->commitWriteBatch(batch);
+  // Executed on executor_thread_ so that it never runs concurrently with finalization
+  std::promise<void> state_db_promise;
+  boost::asio::post(executor_thread_, [&]() {
+    stateAPI().prune(state_root_to_keep, blk_n);
+    db_->insert(DbStorage::Columns::final_chain_meta, DBMetaKeys::PRUNED_STATE_BLOCK, blk_n);
+    state_db_promise.set_value();
+  });
+  state_db_promise.get_future().wait();
+}
 
-    db_->compactColumn(DbStorage::Columns::final_chain_blk_by_number);
-    db_->compactColumn(DbStorage::Columns::final_chain_blk_hash_by_number);
-    db_->compactColumn(DbStorage::Columns::final_chain_blk_number_by_hash);
+std::optional<EthBlockNumber> FinalChain::prunedStateBlock() const {
+  return db_->lookup_int<EthBlockNumber>(DBMetaKeys::PRUNED_STATE_BLOCK, DbStorage::Columns::final_chain_meta);
+}
+
+size_t FinalChain::pruneBlockHeaders(size_t max_blocks, const rocksdb::WriteOptions& write_opts) {
+  const auto pruned_state_block = prunedStateBlock();
+  if (!pruned_state_block) {
+    return 0;
+  }
+
+  auto from = db_->lookup_int<EthBlockNumber>(DBMetaKeys::PRUNED_HEADERS_FROM, DbStorage::Columns::final_chain_meta);
+  if (!from) {
+    // Headers were pruned from the newest to the oldest before progress was persisted. Kept headers form contiguous
+    // range, so find its first block. Genesis header is never pruned
+    EthBlockNumber lo = 1, hi = *pruned_state_block;
+    while (lo < hi) {
+      const auto mid = lo + (hi - lo) / 2;
+      if (getBlockHash(mid)) {
+        hi = mid;
+      } else {
+        lo = mid + 1;
+      }
+    }
+    from = lo;
+  }
+  const auto to = std::min<EthBlockNumber>(*pruned_state_block, *from + max_blocks);
+  if (*from >= to) {
+    return 0;
+  }
 
-    // wait for the state_db prune to finish
-    state_db_promise->get_future().wait();
+  auto batch = db_->createWriteBatch();
+  for (auto n = *from; n < to; ++n) {
+    if (const auto hash = getBlockHash(n)) {
+      db_->remove(batch, DbStorage::Columns::final_chain_blk_number_by_hash, *hash);
+    }
+    db_->remove(batch, DbStorage::Columns::final_chain_blk_by_number, n);
+    db_->remove(batch, DbStorage::Columns::final_chain_blk_hash_by_number, n);
   }
+  db_->insert(batch, DbStorage::Columns::final_chain_meta, DBMetaKeys::PRUNED_HEADERS_FROM, to);
+  db_->commitWriteBatch(batch, write_opts);
+  return to - *from;
 }
 
 std::shared_ptr<BlockHeader> FinalChain::appendBlock(Batch& batch, const PbftBlock& pbft_blk, const h256& state_root,
                                                      u256 total_reward, const SharedTransactions& transactions,
-                                                     const TransactionReceipts& receipts) {
+                                                     const TransactionReceipts& receipts,
+                                                     std::optional<h256> transactions_root) {
   auto header = std::make_shared<BlockHeader>();
   header->setFromPbft(pbft_blk);
 
@@ -329,35 +575,74 @@ std::shared_ptr<BlockHeader> FinalChain::appendBlock(Batch& batch, const PbftBlo
   header->total_reward = total_reward;
   header->gas_limit = kBlockGasLimit;
 
-  return appendBlock(batch, std::move(header), transactions, receipts);
+  return appendBlock(batch, std::move(header), transactions, receipts, transactions_root);
+}
+
+std::pair<h256, LogBloom> FinalChain::processReceipts(Batch& batch, EthBlockNumber blk_n,
+                                                     const TransactionReceipts& receipts) {
+  LogBloom log_bloom;
+  for (size_t trx_idx = 0; trx_idx < receipts.size(); ++trx_idx) {
+    const auto& receipt = receipts[trx_idx];
+    log_bloom |= receipt.bloom();
+
+    if (!logs_index_from_) {
+      continue;
+    }
+    for (const auto& log : receipt.logs) {
+      db_->insert(batch, DbStorage::Columns::final_chain_logs_index,
+                  logsIndexKey(log.address, std::nullopt, blk_n, trx_idx), bytes());
+      if (!log.topics.empty()) {
+        db_->insert(batch, DbStorage::Columns::final_chain_logs_index,
+                    logsIndexKey(log.address, log.topics.front(), blk_n, trx_idx), bytes());
+      }
+    }
+  }
+  db_->insert(batch, DbStorage::Columns::final_chain_receipt_by_period, blk_n, encodeCompactReceipts(receipts));
+
+  return {receiptsRoot(receipts, &period_arena_), log_bloom};
+}
+
+h256 FinalChain::receiptsRoot(const TransactionReceipts& receipts, std::pmr::memory_resource* arena) const {
+  // All receipts are encoded one after another into a single buffer, trie references them in place
+  dev::RLPStream receipts_rlp;
+  std::pmr::vector<size_t> receipts_ends(arena);
+  receipts_ends.reserve(receipts.size());
+  for (const auto& receipt : receipts) {
+    util::rlp(receipts_rlp, receipt);
+    receipts_ends.push_back(receipts_rlp.out().size());
+  }
+
+  std::pmr::vector<dev::bytesConstRef> receipts_refs(arena);
+  receipts_refs.reserve(receipts.size());
+  for (size_t i = 0, begin = 0; i < receipts_ends.size(); begin = receipts_ends[i++]) {
+    receipts_refs.emplace_back(receipts_rlp.out().data() + begin, receipts_ends[i] - begin);
+  }
+  return orderedTrieRoot(receipts_refs, arena, &trie_executor_);
+}
+
+h256 FinalChain::transactionsRoot(const SharedTransactions& transactions, std::pmr::memory_resource* arena) const {
+  std::pmr::vector<dev::bytesConstRef> trxs_refs(arena);
+  trxs_refs.reserve(transactions.size());
+  for (const auto& trx : transactions) {
+    trxs_refs.emplace_back(&trx->rlp());
+  }
+  return orderedTrieRoot(trxs_refs, arena, &trie_executor_);
 }
 
 std::shared_ptr<BlockHeader> FinalChain::appendBlock(Batch& batch, std::shared_ptr<BlockHeader> header,
                                                      const SharedTransactions& transactions,
-                                                     const TransactionReceipts& receipts) {
+                                                     const TransactionReceipts& receipts,
+                                                     std::optional<h256> transactions_root) {
   {
-    dev::BytesMap trxs_trie;
-    dev::BytesMap receipts_trie;
-    dev::RLPStream receipts_stream;
-    receipts_stream.appendList(receipts.size());
-    for (size_t trx_idx = 0; trx_idx < transactions.size(); ++trx_idx) {
-      const auto& trx = transactions[trx_idx];
-      auto i_rlp = util::rlp_enc(trx_idx);
-      trxs_trie[i_rlp] = trx->rlp();
-
-      const auto& receipt = receipts[trx_idx];
-      header->log_bloom |= receipt.bloom();
-
-      auto rlp = util::rlp_enc(receipt);
-      receipts_stream.appendRaw(rlp);
-      receipts_trie[i_rlp] = rlp;
-    }
-    db_->insert(batch, DbStorage::Columns::final_chain_receipt_by_period, header->number, receipts_stream.invalidate());
-
-    header->receipts_root = hash256(receipts_trie);
-    header->transactions_root = hash256(trxs_trie);
+    // Tries temporaries die together, arena is released at once instead of freeing each of them
+    const auto [receipts_root, log_bloom] = processReceipts(batch, header->number, receipts);
+    header->log_bloom |= log_bloom;
+    header->receipts_root = receipts_root;
+    header->transactions_root =
+        transactions_root ? *transactions_root : transactionsRoot(transactions, &period_arena_);
     header->hash = dev::sha3(header->ethereumRlp());
   }
+  period_arena_.release();
 
   auto data = header->serializeForDB();
   db_->insert(batch, DbStorage::Columns::final_chain_blk_by_number, header->number, data);
@@ -379,6 +664,16 @@ std::shared_ptr<BlockHeader> FinalChain::appendBlock(Batch& batch, std::shared_p
 
 EthBlockNumber FinalChain::lastBlockNumber() const { return last_block_number_; }
 
+std::shared_ptr<const HardforkRules> FinalChain::lastBlockHardforkRules() const {
+  return last_block_hardfork_rules_.load();
+}
+
+void FinalChain::setLastBlockNumber(EthBlockNumber blk_n) {
+  // Rules are stored first, so a reader that sees the new number also gets rules of at least that block
+  last_block_hardfork_rules_ = std::make_shared<const HardforkRules>(kConfig.genesis.getHardforkRules(blk_n));
+  last_block_number_ = blk_n;
+}
+
 std::optional<EthBlockNumber> FinalChain::blockNumber(const h256& h) const {
   return db_->lookup_int<EthBlockNumber>(h, DbStorage::Columns::final_chain_blk_number_by_hash);
 }
@@ -395,6 +690,11 @@ std::shared_ptr<const BlockHeader> FinalChain::blockHeader(std::optional<EthBloc
 }
 
 std::optional<TransactionLocation> FinalChain::transactionLocation(const h256& trx_hash) const {
+  if (auto [location, found] = trx_locations_cache_.get(trx_hash); found) {
+    trx_location_cache_hits_.fetch_add(1, std::memory_order_relaxed);
+    return location;
+  }
+  trx_location_cache_misses_.fetch_add(1, std::memory_order_relaxed);
   return db_->getTransactionLocation(trx_hash);
 }
 
@@ -407,9 +707,11 @@ std::optional<TransactionReceipt> FinalChain::transactionReceipt(EthBlockNumber
       auto trx = transactions->at(position);
       trx_hash = trx->getHash();
     }
+    // Old layout is consulted until receipts by period migration is applied
     auto receipt_raw = db_->lookup(trx_hash.value(), DbStorage::Columns::final_chain_receipt_by_trx_hash);
     if (receipt_raw.empty()) {
-      return {};
+      // Background migration may have moved the receipt in between the lookups
+      return db_->getTransactionReceipt(blk_n, position);
     }
     return util::rlp_dec<TransactionReceipt>(dev::RLP(receipt_raw));
   }
@@ -423,8 +725,56 @@ SharedTransactionReceipts FinalChain::blockReceipts(std::optional<EthBlockNumber
   return block_receipts_cache_.get(*n);
 }
 
+std::vector<SharedTransactionReceipts> FinalChain::blocksReceipts(const std::vector<EthBlockNumber>& blocks) const {
+  std::vector<SharedTransactionReceipts> ret(blocks.size());
+  std::vector<EthBlockNumber> to_query;
+  std::vector<size_t> to_query_idx;
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    if (auto receipts = block_receipts_cache_.getFromCache(blocks[i])) {
+      ret[i] = std::move(*receipts);
+      continue;
+    }
+    to_query.push_back(blocks[i]);
+    to_query_idx.push_back(i);
+  }
+  auto queried = db_->getBlocksReceipts(to_query);
+  for (size_t i = 0; i < queried.size(); ++i) {
+    ret[to_query_idx[i]] = std::move(queried[i]);
+  }
+  return ret;
+}
+
+void FinalChain::exportBlocks(EthBlockNumber from, EthBlockNumber to, const ExportedBlockCallback& callback) const {
+  db_->forEachFinalizedPeriod(from, to, [&](PbftPeriod period, const auto& raw_header, const auto& period_data,
+                                            const auto& raw_receipts) {
+    std::shared_ptr<const BlockHeader> header;
+    SharedTransactions transactions;
+    if (period == 0) {
+      header = makeGenesisHeader(raw_header.ToString());
+    } else {
+      // we should usually have a pbft block for a final chain block
+      if (period_data.empty()) {
+        return false;
+      }
+      header = std::make_shared<BlockHeader>(raw_header.ToString(), period_data.pbftBlock(), kBlockGasLimit);
+      transactions = db_->transactionsFromPeriodDataRlp(period, period_data.rlp());
+    }
+    TransactionReceipts receipts;
+    if (!raw_receipts.empty()) {
+      receipts = ReceiptsView(dev::bytesConstRef(reinterpret_cast<const ::byte*>(raw_receipts.data()),
+                                                 raw_receipts.size()))
+                     .decodeAll();
+    }
+    return callback(*header, transactions, receipts);
+  });
+}
+
 SharedTransactionReceipts FinalChain::getBlockReceipts(std::optional<EthBlockNumber> n) const {
-  return db_->getBlockReceipts(lastIfAbsent(n));
+  const auto blk_n = lastIfAbsent(n);
+  if (auto receipts = db_->getBlockReceipts(blk_n)) {
+    return receipts;
+  }
+  return {};
 }
 
 uint64_t FinalChain::transactionCount(std::optional<EthBlockNumber> n) const {
@@ -441,12 +791,20 @@ const SharedTransactions FinalChain::transactions(std::optional<EthBlockNumber>
 
 std::vector<EthBlockNumber> FinalChain::withBlockBloom(const LogBloom& b, EthBlockNumber from,
                                                        EthBlockNumber to) const {
+  return withBlockBloom(std::vector<LogBloom>{b}, from, to);
+}
+
+std::vector<EthBlockNumber> FinalChain::withBlockBloom(const std::vector<LogBloom>& blooms, EthBlockNumber from,
+                                                       EthBlockNumber to) const {
   std::vector<EthBlockNumber> ret;
+  std::vector<const LogBloom*> alternatives;
+  alternatives.reserve(blooms.size());
+  std::transform(blooms.begin(), blooms.end(), std::back_inserter(alternatives), [](const auto& b) { return &b; });
   // start from the top-level
   auto u = int_pow(c_bloomIndexSize, c_bloomIndexLevels);
   // run through each of the top-level blocks
   for (EthBlockNumber index = from / u; index <= (to + u - 1) / u; ++index) {
-    dev::operator+=(ret, withBlockBloom(b, from, to, c_bloomIndexLevels - 1, index));
+    withBlockBloom(alternatives, from, to, c_bloomIndexLevels - 1, index, ret);
   }
   return ret;
 }
@@ -458,15 +816,85 @@ std::optional<state_api::Account> FinalChain::getAccount(const addr_t& addr,
 
 void FinalChain::updateStateConfig(const state_api::Config& new_config) {
   delegation_delay_ = new_config.dpos.delegation_delay;
-  state_api_.update_state_config(new_config);
+  stateAPI().update_state_config(new_config);
 }
 
 h256 FinalChain::getAccountStorage(const addr_t& addr, const u256& key, std::optional<EthBlockNumber> blk_n) const {
-  return state_api_.get_account_storage(lastIfAbsent(blk_n), addr, key);
+  const auto blk_num = lastIfAbsent(blk_n);
+  if (!kConfig.final_chain_storage_cache_size) {
+    return stateAPI().get_account_storage(blk_num, addr, key);
+  }
+
+  // Storage root of the account is served by accounts_cache_, so hot contracts don't cross cgo boundary at all
+  const auto account = getAccount(addr, blk_num);
+  if (!account) {
+    return {};
+  }
+
+  dev::RLPStream key_rlp(2);
+  key_rlp << account->storage_root_hash << key;
+  const auto cache_key = dev::sha3(key_rlp.invalidate());
+  if (const auto [value, found] = storage_cache_.get(cache_key); found) {
+    return value;
+  }
+
+  auto value = stateAPI().get_account_storage(blk_num, addr, key);
+  storage_cache_.insert(cache_key, value);
+  return value;
 }
 
 bytes FinalChain::getCode(const addr_t& addr, std::optional<EthBlockNumber> blk_n) const {
-  return state_api_.get_code_by_address(lastIfAbsent(blk_n), addr);
+  const auto blk_num = lastIfAbsent(blk_n);
+  if (!kConfig.final_chain_code_cache_size) {
+    return stateAPI().get_code_by_address(blk_num, addr);
+  }
+
+  // Code hash is hash of the code itself, so it identifies code of every account including the ones without code
+  const auto account = getAccount(addr, blk_num);
+  if (!account) {
+    return {};
+  }
+
+  if (auto [code, found] = code_cache_.get(account->code_hash); found) {
+    return std::move(code);
+  }
+
+  auto code = stateAPI().get_code_by_address(blk_num, addr);
+  code_cache_.insert(account->code_hash, code);
+  return code;
+}
+
+std::vector<StateQueryResult> FinalChain::queryState(const std::vector<StateQuery>& queries) const {
+  const auto latest = lastBlockNumber();
+  std::map<std::pair<EthBlockNumber, addr_t>, std::optional<state_api::Account>> accounts;
+  const auto account = [&](EthBlockNumber blk_num, const addr_t& addr) -> const std::optional<state_api::Account>& {
+    auto it = accounts.find({blk_num, addr});
+    if (it == accounts.end()) {
+      it = accounts.emplace(std::make_pair(blk_num, addr), getAccount(addr, blk_num)).first;
+    }
+    return it->second;
+  };
+
+  std::vector<StateQueryResult> results(queries.size());
+  for (size_t i = 0; i < queries.size(); ++i) {
+    const auto& query = queries[i];
+    const auto blk_num = query.blk_n.value_or(latest);
+    switch (query.kind) {
+      case StateQuery::Kind::Balance:
+        results[i].value = account(blk_num, query.address).value_or(state_api::ZeroAccount).balance;
+        break;
+      case StateQuery::Kind::Nonce:
+        results[i].value = account(blk_num, query.address).value_or(state_api::ZeroAccount).nonce;
+        break;
+      case StateQuery::Kind::Code:
+        results[i].code = getCode(query.address, blk_num);
+        break;
+      case StateQuery::Kind::Storage:
+        results[i].storage = getAccountStorage(query.address, query.slot, blk_num);
+        break;
+    }
+  }
+  return results;
 }
 
 state_api::ExecutionResult FinalChain::call(const state_api::EVMTransaction& trx,
@@ -475,7 +903,7 @@ state_api::ExecutionResult FinalChain::call(const state_api::EVMTransaction& trx
   if (!blk_header) {
     throw std::runtime_error("Future block");
   }
-  return state_api_.dry_run_transaction(blk_header->number,
+  return stateAPI().dry_run_transaction(blk_header->number,
                                         {
                                             blk_header->author,
                                             blk_header->gas_limit,
@@ -485,49 +913,115 @@ state_api::ExecutionResult FinalChain::call(const state_api::EVMTransaction& trx
                                         trx);
 }
 
+std::vector<state_api::ExecutionResult> FinalChain::callBatch(const std::vector<state_api::EVMTransaction>& trxs,
+                                                              std::optional<EthBlockNumber> blk_n) const {
+  auto const blk_header = blockHeader(lastIfAbsent(blk_n));
+  if (!blk_header) {
+    throw std::runtime_error("Future block");
+  }
+  return stateAPI().dry_run_transactions(blk_header->number,
+                                         {
+                                             blk_header->author,
+                                             blk_header->gas_limit,
+                                             blk_header->timestamp,
+                                             BlockHeader::difficulty(),
+                                         },
+                                         trxs);
+}
+
 std::string FinalChain::trace(std::vector<state_api::EVMTransaction> state_trxs,
                               std::vector<state_api::EVMTransaction> trxs, EthBlockNumber blk_n,
                               std::optional<state_api::Tracing> params) const {
+  std::string result;
+  trace(std::move(state_trxs), std::move(trxs), blk_n, std::move(params),
+        [&result](std::string_view chunk) { result.append(chunk); });
+  return result;
+}
+
+void FinalChain::trace(std::vector<state_api::EVMTransaction> state_trxs, std::vector<state_api::EVMTransaction> trxs,
+                       EthBlockNumber blk_n, std::optional<state_api::Tracing> params,
+                       const state_api::TraceSink& sink) const {
   const auto blk_header = blockHeader(lastIfAbsent(blk_n));
   if (!blk_header) {
     throw std::runtime_error("Future block");
   }
-  return dev::asString(state_api_.trace(blk_header->number,
-                                        {
-                                            blk_header->author,
-                                            blk_header->gas_limit,
-                                            blk_header->timestamp,
-                                            BlockHeader::difficulty(),
-                                        },
-                                        state_trxs, trxs, params));
+  stateAPI().trace(blk_header->number,
+                   {
+                       blk_header->author,
+                       blk_header->gas_limit,
+                       blk_header->timestamp,
+                       BlockHeader::difficulty(),
+                   },
+                   state_trxs, trxs, params, sink);
+}
+
+uint64_t DposValidatorsSnapshot::voteCount(const addr_t& addr) const {
+  const auto it = std::lower_bound(validators.begin(), validators.end(), addr,
+                                   [](const state_api::ValidatorVoteCount& v, const addr_t& a) { return v.addr < a; });
+  if (it == validators.end() || it->addr != addr) {
+    return 0;
+  }
+  return it->vote_count;
+}
+
+std::shared_ptr<const DposValidatorsSnapshot> FinalChain::dposValidatorsSnapshot(EthBlockNumber blk_num) const {
+  auto& slot = dpos_snapshots_[blk_num % kDposSnapshotsCount];
+  if (auto snapshot = slot.load(); snapshot && snapshot->blk_num == blk_num) {
+    return snapshot;
+  }
+
+  // Future blocks are answered from the last state and old blocks would only evict recent snapshots
+  const auto last_blk_num = lastBlockNumber();
+  if (blk_num > last_blk_num || blk_num + kDposSnapshotsCount <= last_blk_num) {
+    return nullptr;
+  }
+
+  auto snapshot = std::make_shared<DposValidatorsSnapshot>();
+  snapshot->blk_num = blk_num;
+  snapshot->validators = stateAPI().dpos_validators_eligible_vote_counts(blk_num);
+  std::sort(snapshot->validators.begin(), snapshot->validators.end(),
+            [](const auto& a, const auto& b) { return a.addr < b.addr; });
+  snapshot->total_vote_count = stateAPI().dpos_eligible_total_vote_count(blk_num);
+  slot.store(snapshot);
+  return snapshot;
 }
 
 uint64_t FinalChain::dposEligibleTotalVoteCount(EthBlockNumber blk_num) const {
+  if (const auto snapshot = dposValidatorsSnapshot(blk_num)) {
+    return snapshot->total_vote_count;
+  }
   return total_vote_count_cache_.get(blk_num);
 }
 
 uint64_t FinalChain::dposEligibleVoteCount(EthBlockNumber blk_num, const addr_t& addr) const {
+  if (const auto snapshot = dposValidatorsSnapshot(blk_num)) {
+    return snapshot->voteCount(addr);
+  }
   return dpos_vote_count_cache_.get(blk_num, addr);
 }
 
 bool FinalChain::dposIsEligible(EthBlockNumber blk_num, const addr_t& addr) const {
+  // Validator is eligible when it has at least one eligible vote
+  if (const auto snapshot = dposValidatorsSnapshot(blk_num)) {
+    return snapshot->voteCount(addr) > 0;
+  }
   return dpos_is_eligible_cache_.get(blk_num, addr);
 }
 
 vrf_wrapper::vrf_pk_t FinalChain::dposGetVrfKey(EthBlockNumber blk_n, const addr_t& addr) const {
-  return state_api_.dpos_get_vrf_key(blk_n, addr);
+  return stateAPI().dpos_get_vrf_key(blk_n, addr);
 }
 
 std::vector<state_api::ValidatorStake> FinalChain::dposValidatorsTotalStakes(EthBlockNumber blk_num) const {
-  return state_api_.dpos_validators_total_stakes(blk_num);
+  return stateAPI().dpos_validators_total_stakes(blk_num);
 }
 
 uint256_t FinalChain::dposTotalAmountDelegated(EthBlockNumber blk_num) const {
-  return state_api_.dpos_total_amount_delegated(blk_num);
+  return stateAPI().dpos_total_amount_delegated(blk_num);
 }
 
 std::vector<state_api::ValidatorVoteCount> FinalChain::dposValidatorsEligibleVoteCounts(EthBlockNumber blk_num) const {
-  return state_api_.dpos_validators_eligible_vote_counts(blk_num);
+  return stateAPI().dpos_validators_eligible_vote_counts(blk_num);
 }
 
 void FinalChain::waitForFinalized() {
@@ -535,9 +1029,9 @@ void FinalChain::waitForFinalized() {
   finalized_cv_.wait_for(lck, std::chrono::milliseconds(10));
 }
 
-uint64_t FinalChain::dposYield(EthBlockNumber blk_num) const { return state_api_.dpos_yield(blk_num); }
+uint64_t FinalChain::dposYield(EthBlockNumber blk_num) const { return stateAPI().dpos_yield(blk_num); }
 
-u256 FinalChain::dposTotalSupply(EthBlockNumber blk_num) const { return state_api_.dpos_total_supply(blk_num); }
+u256 FinalChain::dposTotalSupply(EthBlockNumber blk_num) const { return stateAPI().dpos_total_supply(blk_num); }
 
 h256 FinalChain::getBridgeRoot(EthBlockNumber blk_num) const {
   const static auto get_bridge_root_method = util::EncodingSolidity::packFunctionCall("getBridgeRoot()");
@@ -565,7 +1059,8 @@ std::pair<val_t, bool> FinalChain::getBalance(addr_t const& addr) const {
 }
 
 std::shared_ptr<TransactionHashes> FinalChain::getTransactionHashes(std::optional<EthBlockNumber> n) const {
-  const auto& trxs = db_->getPeriodTransactions(lastIfAbsent(n));
+  const auto blk_n = lastIfAbsent(n);
+  auto trxs = db_->getPeriodTransactions(blk_n);
   auto ret = std::make_shared<TransactionHashes>();
   if (!trxs) {
     return ret;
@@ -577,7 +1072,8 @@ std::shared_ptr<TransactionHashes> FinalChain::getTransactionHashes(std::optiona
 }
 
 const SharedTransactions FinalChain::getTransactions(std::optional<EthBlockNumber> n) const {
-  if (auto trxs = db_->getPeriodTransactions(lastIfAbsent(n))) {
+  const auto blk_n = lastIfAbsent(n);
+  if (auto trxs = db_->getPeriodTransactions(blk_n)) {
     return *trxs;
   }
   return {};
@@ -605,12 +1101,10 @@ std::shared_ptr<const BlockHeader> FinalChain::getBlockHeader(EthBlockNumber n)
     if (n == 0) {
       return makeGenesisHeader(std::move(raw));
     }
-    auto pbft = db_->getPbftBlock(n);
-    // we should usually have a pbft block for a final chain block
-    if (!pbft) {
-      return {};
+    // we should usually have a pbft block for a final chain block, except of pruned history of light node
+    if (auto pbft = db_->getPbftBlock(n)) {
+      return std::make_shared<BlockHeader>(std::move(raw), *pbft, kBlockGasLimit);
     }
-    return std::make_shared<BlockHeader>(std::move(raw), *pbft, kBlockGasLimit);
   }
   return {};
 }
@@ -644,17 +1138,11 @@ EthBlockNumber FinalChain::lastIfAbsent(const std::optional<EthBlockNumber>& cli
   return client_blk_n ? *client_blk_n : lastBlockNumber();
 }
 
-state_api::EVMTransaction FinalChain::toEvmTransaction(const SharedTransaction& trx) {
-  return state_api::EVMTransaction{
-      trx->getSender(), trx->getGasPrice(), trx->getReceiver(), trx->getNonce(),
-      trx->getValue(),  trx->getGas(),      trx->getData(),
-  };
-}
-
-void FinalChain::appendEvmTransactions(std::vector<state_api::EVMTransaction>& evm_trxs,
-                                       const SharedTransactions& trxs) {
-  std::transform(trxs.cbegin(), trxs.cend(), std::back_inserter(evm_trxs),
-                 [](const auto& trx) { return toEvmTransaction(trx); });
+StateAPI& FinalChain::stateAPI() const {
+  if (!state_api_) [[unlikely]] {
+    throw std::runtime_error("State is not available on a read-only replica");
+  }
+  return *state_api_;
 }
 
 BlocksBlooms FinalChain::blockBlooms(const h256& chunk_id) const {
@@ -664,30 +1152,233 @@ BlocksBlooms FinalChain::blockBlooms(const h256& chunk_id) const {
   return {};
 }
 
+std::shared_ptr<const BlocksBlooms> FinalChain::blockBlooms(EthBlockNumber level, EthBlockNumber index) const {
+  const auto chunk_id = blockBloomsChunkId(level, index);
+  if (auto [blooms, found] = blooms_chunks_cache_.get(chunk_id); found) {
+    return blooms;
+  }
+  auto blooms = std::make_shared<const BlocksBlooms>(blockBlooms(chunk_id));
+  // Chunk is still altered by appended blocks until its whole range is finalized
+  if ((index + 1) * int_pow(c_bloomIndexSize, level + 1) <= lastBlockNumber()) {
+    blooms_chunks_cache_.insert(chunk_id, blooms);
+  }
+  return blooms;
+}
+
 h256 FinalChain::blockBloomsChunkId(EthBlockNumber level, EthBlockNumber index) { return h256(index * 0xff + level); }
 
-std::vector<EthBlockNumber> FinalChain::withBlockBloom(const LogBloom& b, EthBlockNumber from, EthBlockNumber to,
-                                                       EthBlockNumber level, EthBlockNumber index) const {
-  std::vector<EthBlockNumber> ret;
+bytes FinalChain::logsIndexKey(const Address& address, const std::optional<h256>& topic0, EthBlockNumber blk_n,
+                               uint32_t trx_pos) {
+  // Separate key spaces for address only and address + topic0 entries. Numbers are big endian so keys are ordered by
+  // block number and position within the same prefix
+  bytes key;
+  key.reserve(1 + Address::size + h256::size + sizeof(blk_n) + sizeof(trx_pos));
+  key.push_back(topic0 ? 1 : 0);
+  key.insert(key.end(), address.begin(), address.end());
+  if (topic0) {
+    key.insert(key.end(), topic0->begin(), topic0->end());
+  }
+  for (int shift = (sizeof(blk_n) - 1) * 8; shift >= 0; shift -= 8) {
+    key.push_back(static_cast<uint8_t>(blk_n >> shift));
+  }
+  for (int shift = (sizeof(trx_pos) - 1) * 8; shift >= 0; shift -= 8) {
+    key.push_back(static_cast<uint8_t>(trx_pos >> shift));
+  }
+  return key;
+}
+
+std::vector<std::pair<EthBlockNumber, uint32_t>> FinalChain::withLogsIndex(const Address& address,
+                                                                           const std::optional<h256>& topic0,
+                                                                           EthBlockNumber from,
+                                                                           EthBlockNumber to) const {
+  std::vector<std::pair<EthBlockNumber, uint32_t>> ret;
+  const auto start_key = logsIndexKey(address, topic0, from, 0);
+  const auto prefix_size = start_key.size() - sizeof(EthBlockNumber) - sizeof(uint32_t);
+  const auto prefix = rocksdb::Slice(reinterpret_cast<const char*>(start_key.data()), prefix_size);
+
+  auto it = db_->getColumnIterator(DbStorage::Columns::final_chain_logs_index);
+  for (it->Seek(DbStorage::toSlice(start_key)); it->Valid() && it->key().starts_with(prefix); it->Next()) {
+    const auto* pos = reinterpret_cast<const uint8_t*>(it->key().data()) + prefix_size;
+    EthBlockNumber blk_n = 0;
+    for (size_t i = 0; i < sizeof(blk_n); ++i) {
+      blk_n = (blk_n << 8) | *pos++;
+    }
+    if (blk_n > to) {
+      break;
+    }
+    uint32_t trx_pos = 0;
+    for (size_t i = 0; i < sizeof(trx_pos); ++i) {
+      trx_pos = (trx_pos << 8) | *pos++;
+    }
+    ret.emplace_back(blk_n, trx_pos);
+  }
+  return ret;
+}
+
+void FinalChain::withBlockBloom(const std::vector<const LogBloom*>& blooms, EthBlockNumber from, EthBlockNumber to,
+                                EthBlockNumber level, EthBlockNumber index, std::vector<EthBlockNumber>& ret) const {
   auto uCourse = int_pow(c_bloomIndexSize, level + 1);
   auto uFine = int_pow(c_bloomIndexSize, level);
   auto obegin = index == from / uCourse ? from / uFine % c_bloomIndexSize : 0;
   auto oend = index == to / uCourse ? (to / uFine) % c_bloomIndexSize + 1 : c_bloomIndexSize;
-  auto bb = blockBlooms(blockBloomsChunkId(level, index));
+  const auto bb = blockBlooms(level, index);
+  std::vector<const LogBloom*> matching;
+  matching.reserve(blooms.size());
   for (auto o = obegin; o < oend; ++o) {
-    if (bb[o].contains(b)) {
-      // This level has something like what we want.
-      if (level > 0) {
-        dev::operator+=(ret, withBlockBloom(b, from, to, level - 1, o + index * c_bloomIndexSize));
-      } else {
-        EthBlockNumber blockNumber = o + index * c_bloomIndexSize;
-        if (blockNumber >= from && blockNumber <= to) {
-          ret.push_back(blockNumber);
-        }
+    // Only alternatives that match this level are checked on the lower one
+    matching.clear();
+    std::copy_if(blooms.begin(), blooms.end(), std::back_inserter(matching),
+                 [&](const LogBloom* b) { return bloomContains((*bb)[o], *b); });
+    if (matching.empty()) {
+      continue;
+    }
+    // This level has something like what we want.
+    if (level > 0) {
+      withBlockBloom(matching, from, to, level - 1, o + index * c_bloomIndexSize, ret);
+    } else {
+      EthBlockNumber blockNumber = o + index * c_bloomIndexSize;
+      if (blockNumber >= from && blockNumber <= to) {
+        ret.push_back(blockNumber);
       }
     }
   }
-  return ret;
+}
+
+FinalChain::CachesSizes FinalChain::cachesSizes() const {
+  return {storage_cache_.maxSize(), code_cache_.maxSize(), trx_locations_cache_.maxSize()};
+}
+
+void FinalChain::setCachesSizes(const CachesSizes& sizes) {
+  // Same delete steps as set up by constructor
+  if (kConfig.final_chain_storage_cache_size) {
+    storage_cache_.setMaxSize(sizes.storage, sizes.storage / 10 + 1);
+  }
+  if (kConfig.final_chain_code_cache_size) {
+    code_cache_.setMaxSize(sizes.code, sizes.code / 10 + 1);
+  }
+  if (kConfig.final_chain_trx_location_cache_size) {
+    trx_locations_cache_.setMaxSize(sizes.trx_location, sizes.trx_location / 10 + 1);
+  }
+}
+
+void FinalChain::setHistoricalBlockFetcher(HistoricalBlockFetcher fetcher, uint32_t cache_size) {
+  std::unique_lock lock(historical_block_fetcher_mutex_);
+  historical_block_fetcher_ = std::move(fetcher);
+  historical_blocks_cache_.setMaxSize(cache_size, cache_size / 10 + 1);
+}
+
+std::shared_ptr<const FinalChain::VerifiedHistoricalBlock> FinalChain::fetchHistoricalBlock(EthBlockNumber n) const {
+  // Blocks after the last one are not finalized yet, they are not history
+  if (n == 0 || n > lastBlockNumber()) {
+    return {};
+  }
+  HistoricalBlockFetcher fetcher;
+  {
+    std::shared_lock lock(historical_block_fetcher_mutex_);
+    fetcher = historical_block_fetcher_;
+  }
+  if (!fetcher) {
+    return {};
+  }
+  if (auto [block, found] = historical_blocks_cache_.get(n); found) {
+    return block;
+  }
+  if (db_->exist(n, DbStorage::Columns::period_data)) {
+    return {};
+  }
+  if (historical_fetches_.fetch_add(1) >= kMaxHistoricalFetches) {
+    historical_fetches_.fetch_sub(1);
+    LOG(log_dg_) << "Too many historical blocks are being fetched, block " << n << " is not fetched";
+    return {};
+  }
+
+  std::shared_ptr<const VerifiedHistoricalBlock> verified;
+  fetcher(n, [&](const HistoricalBlock& block) {
+    verified = verifyHistoricalBlock(n, block);
+    return verified != nullptr;
+  });
+  historical_fetches_.fetch_sub(1);
+
+  if (verified) {
+    historical_blocks_cache_.insert(n, verified);
+  }
+  return verified;
+}
+
+std::optional<h256> FinalChain::knownBlockHash(EthBlockNumber n) const {
+  if (auto hash = getBlockHash(n)) {
+    return hash;
+  }
+  if (auto raw = db_->lookup(n + 1, DbStorage::Columns::final_chain_blk_by_number); !raw.empty()) {
+    return BlockHeader(std::move(raw)).parent_hash;
+  }
+  if (auto [next, found] = historical_blocks_cache_.get(n + 1); found) {
+    return next->header->parent_hash;
+  }
+  return {};
+}
+
+std::shared_ptr<const FinalChain::VerifiedHistoricalBlock> FinalChain::verifyHistoricalBlock(
+    EthBlockNumber n, const HistoricalBlock& block) const {
+  if (!block.pbft_block || block.pbft_block->getPeriod() != n) {
+    return {};
+  }
+  const auto hash = knownBlockHash(n);
+  if (!hash) {
+    LOG(log_dg_) << "Hash of historical block " << n << " is not known, it can't be verified";
+    return {};
+  }
+  if (const auto next_pbft = db_->getPbftBlock(n + 1);
+      next_pbft && next_pbft->getPrevBlockHash() != block.pbft_block->getBlockHash()) {
+    return {};
+  }
+
+  try {
+    // Stored header is preferred, pbft block fields are all that is needed from the peer then
+    auto raw = db_->lookup(n, DbStorage::Columns::final_chain_blk_by_number);
+    if (raw.empty()) {
+      raw.assign(block.header_data.begin(), block.header_data.end());
+    }
+    auto header = std::make_shared<BlockHeader>(std::move(raw), *block.pbft_block, kBlockGasLimit);
+    if (header->hash != *hash) {
+      return {};
+    }
+
+    // Roots cover system transactions too, but they are not returned with period transactions like from db
+    auto all_transactions = block.transactions;
+    for (const auto& system_trx : block.system_transactions) {
+      all_transactions.push_back(std::make_shared<SystemTransaction>(system_trx));
+    }
+    if (block.receipts.size() != all_transactions.size()) {
+      return {};
+    }
+    std::pmr::monotonic_buffer_resource arena;
+    if (transactionsRoot(all_transactions, &arena) != header->transactions_root ||
+        receiptsRoot(block.receipts, &arena) != header->receipts_root) {
+      return {};
+    }
+    return std::make_shared<VerifiedHistoricalBlock>(VerifiedHistoricalBlock{
+        std::move(header), block.transactions, std::make_shared<TransactionReceipts>(block.receipts)});
+  } catch (const std::exception& e) {
+    LOG(log_dg_) << "Invalid historical block " << n << ": " << e.what();
+    return {};
+  }
+}
+
+size_t FinalChain::cachesMemoryUsage() const {
+  constexpr auto kStorageEntrySize = 2 * sizeof(h256) + 2 * util::kContainerNodeOverhead;
+  // Contract codes are not scanned, an entry is approximated by an average sized contract
+  constexpr auto kCodeEntrySize = sizeof(h256) + sizeof(bytes) + 2 * util::kContainerNodeOverhead + 4096;
+  // Hash is stored both in the map and in the expiration queue
+  constexpr auto kTrxLocationEntrySize =
+      2 * sizeof(trx_hash_t) + sizeof(TransactionLocation) + util::kContainerNodeOverhead;
+  return block_headers_cache_.memoryUsage() + block_hashes_cache_.memoryUsage() + transactions_cache_.memoryUsage() +
+         transaction_hashes_cache_.memoryUsage() + accounts_cache_.memoryUsage() +
+         storage_cache_.size() * kStorageEntrySize + code_cache_.size() * kCodeEntrySize +
+         total_vote_count_cache_.memoryUsage() + dpos_vote_count_cache_.memoryUsage() +
+         dpos_is_eligible_cache_.memoryUsage() + block_receipts_cache_.memoryUsage() +
+         trx_locations_cache_.size() * kTrxLocationEntrySize +
+         blooms_chunks_cache_.size() * (sizeof(h256) + sizeof(BlocksBlooms) + 2 * util::kContainerNodeOverhead);
 }
 
 }  // namespace taraxa::final_chain
\ No newline at end of file
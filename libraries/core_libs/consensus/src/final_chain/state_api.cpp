@@ -4,6 +4,7 @@
 #include <libdevcore/CommonJS.h>
 
 #include <array>
+#include <exception>
 #include <string_view>
 
 #include "common/encoding_rlp.hpp"
@@ -13,6 +14,9 @@ static_assert(sizeof(char) == sizeof(uint8_t));
 
 namespace taraxa::state_api {
 
+// Size of chunks in which trace is forwarded to the sink
+constexpr size_t kTraceChunkSize = 64 * 1024;
+
 bytesConstRef map_bytes(const taraxa_evm_Bytes& b) { return {b.Data, b.Len}; }
 
 taraxa_evm_Bytes map_bytes(const bytes& b) { return {const_cast<uint8_t*>(b.data()), b.size()}; }
@@ -164,10 +168,48 @@ ExecutionResult StateAPI::dry_run_transaction(EthBlockNumber blk_num, const EVMB
                                                                                                 trx);
 }
 
-bytes StateAPI::trace(EthBlockNumber blk_num, const EVMBlock& blk, const std::vector<EVMTransaction>& state_trxs,
-                      const std::vector<EVMTransaction>& trxs, std::optional<Tracing> params) const {
-  return c_method_args_rlp<bytes, from_rlp, taraxa_evm_state_api_trace_transactions>(this_c_, blk_num, blk, state_trxs,
-                                                                                     trxs, params);
+std::vector<ExecutionResult> StateAPI::dry_run_transactions(EthBlockNumber blk_num, const EVMBlock& blk,
+                                                           const std::vector<EVMTransaction>& trxs) const {
+  std::vector<ExecutionResult> ret;
+  ret.reserve(trxs.size());
+  for (const auto& trx : trxs) {
+    ret.emplace_back(dry_run_transaction(blk_num, blk, trx));
+  }
+  return ret;
+}
+
+void StateAPI::trace(EthBlockNumber blk_num, const EVMBlock& blk, const std::vector<EVMTransaction>& state_trxs,
+                     const std::vector<EVMTransaction>& trxs, std::optional<Tracing> params,
+                     const TraceSink& sink) const {
+  struct Receiver {
+    const TraceSink& sink;
+    // Exceptions must not cross the cgo boundary, so they are rethrown after the call
+    std::exception_ptr error;
+  } receiver{sink, nullptr};
+  const taraxa_evm_BytesCallback trace_cb{
+      &receiver,
+      [](auto receiver_ptr, auto b) {
+        auto& receiver = *static_cast<Receiver*>(receiver_ptr);
+        try {
+          const auto trace = dev::RLP(map_bytes(b), 0).toBytesConstRef();
+          for (size_t pos = 0; pos < trace.size(); pos += kTraceChunkSize) {
+            const auto chunk = trace.cropped(pos, std::min(kTraceChunkSize, trace.size() - pos));
+            receiver.sink(std::string_view(reinterpret_cast<const char*>(chunk.data()), chunk.size()));
+          }
+        } catch (...) {
+          receiver.error = std::current_exception();
+        }
+      },
+  };
+
+  dev::RLPStream encoding;
+  util::rlp_tuple(encoding, blk_num, blk, state_trxs, trxs, params);
+  ErrorHandler err_h;
+  taraxa_evm_state_api_trace_transactions(this_c_, map_bytes(encoding.out()), trace_cb, err_h.cgo_part_);
+  err_h.check();
+  if (receiver.error) {
+    std::rethrow_exception(receiver.error);
+  }
 }
 
 StateDescriptor StateAPI::get_last_committed_state_descriptor() const {
@@ -188,6 +230,28 @@ const TransactionsExecutionResult& StateAPI::execute_transactions(const EVMBlock
   return result_buf_execution_result_;
 }
 
+TransactionsExecutionResult& StateAPI::execute_transactions(const EVMBlock& block,
+                                                            const SharedTransactions& transactions) {
+  result_buf_execution_result_.execution_results.clear();
+  rlp_enc_execution_result_.clear();
+
+  // Same encoding as rlp_tuple(block, std::vector<EVMTransaction>)
+  rlp_enc_execution_result_.appendList(2);
+  block.rlp(rlp_enc_execution_result_);
+  rlp_enc_execution_result_.appendList(transactions.size());
+  for (const auto& trx : transactions) {
+    util::rlp_tuple(rlp_enc_execution_result_, trx->getSender(), trx->getGasPrice(), trx->getReceiver(),
+                    trx->getNonce(), trx->getValue(), trx->getGas(), trx->getData());
+  }
+
+  ErrorHandler err_h;
+  taraxa_evm_state_api_execute_transactions(
+      this_c_, map_bytes(rlp_enc_execution_result_.out()),
+      decoder_cb_c<TransactionsExecutionResult, from_rlp>(result_buf_execution_result_), err_h.cgo_part_);
+  err_h.check();
+  return result_buf_execution_result_;
+}
+
 const RewardsDistributionResult& StateAPI::distribute_rewards(const std::vector<rewards::BlockStats>& rewards_stats) {
   // result_buf_rewards_distribution_;
   rlp_enc_rewards_distribution_.clear();
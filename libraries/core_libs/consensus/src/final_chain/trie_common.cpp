@@ -3,6 +3,14 @@
 #include <libdevcore/RLP.h>
 #include <libdevcore/SHA3.h>
 
+#include <array>
+#include <atomic>
+#include <exception>
+#include <map>
+#include <optional>
+
+#include "common/encoding_rlp.hpp"
+
 namespace taraxa::final_chain {
 using namespace ::dev;
 
@@ -20,7 +28,8 @@ using namespace ::dev;
  * [1,2,3,4,5,T]     0x312345
  * [1,2,3,4,T]       0x201234
  */
-std::string hexPrefixEncode(bytes const& _hexVector, bool _leaf, int _begin = 0, int _end = -1) {
+template <class Nibbles>
+std::string hexPrefixEncode(Nibbles const& _hexVector, bool _leaf, int _begin = 0, int _end = -1) {
   unsigned begin = _begin;
   unsigned end = _end < 0 ? _hexVector.size() + 1 + _end : _end;
   bool odd = ((end - begin) % 2) != 0;
@@ -36,11 +45,18 @@ std::string hexPrefixEncode(bytes const& _hexVector, bool _leaf, int _begin = 0,
   return ret;
 }
 
-void hash256aux(HexMap const& _s, HexMap::const_iterator _begin, HexMap::const_iterator _end, unsigned _preLen,
-                RLPStream& _rlp);
+// Map is HexMap or any other container of nibbles to values appendable to RLPStream, sorted by nibbles
+template <class Map>
+void hash256aux(Map const& _s, typename Map::const_iterator _begin, typename Map::const_iterator _end,
+                unsigned _preLen, RLPStream& _rlp, const util::Executor* _executor = nullptr);
 
-void hash256rlp(HexMap const& _s, HexMap::const_iterator _begin, HexMap::const_iterator _end, unsigned _preLen,
-                RLPStream& _rlp) {
+template <class Map>
+void hash256children(Map const& _s, typename Map::const_iterator _begin, typename Map::const_iterator _end,
+                     unsigned _preLen, RLPStream& _rlp, const util::Executor& _executor);
+
+template <class Map>
+void hash256rlp(Map const& _s, typename Map::const_iterator _begin, typename Map::const_iterator _end,
+                unsigned _preLen, RLPStream& _rlp, const util::Executor* _executor = nullptr) {
   if (_begin == _end) {
     _rlp << "";  // NULL
   } else if (std::next(_begin) == _end) {
@@ -61,7 +77,7 @@ void hash256rlp(HexMap const& _s, HexMap::const_iterator _begin, HexMap::const_i
     if (sharedPre > _preLen) {
       // if they all have the same next nibble, we also want a pair.
       _rlp.appendList(2) << hexPrefixEncode(_begin->first, false, _preLen, (int)sharedPre);
-      hash256aux(_s, _begin, _end, (unsigned)sharedPre, _rlp);
+      hash256aux(_s, _begin, _end, (unsigned)sharedPre, _rlp, _executor);
     } else {
       // otherwise enumerate all 16+1 entries.
       _rlp.appendList(17);
@@ -69,15 +85,36 @@ void hash256rlp(HexMap const& _s, HexMap::const_iterator _begin, HexMap::const_i
       if (_preLen == b->first.size()) {
         ++b;
       }
-      for (auto i = 0; i < 16; ++i) {
-        auto n = b;
-        for (; n != _end && n->first[_preLen] == i; ++n);
-        if (b == n) {
-          _rlp << "";
-        } else {
-          hash256aux(_s, b, n, _preLen + 1, _rlp);
+      if (_executor && size_t(std::distance(b, _end)) >= kParallelTrieMinSize) {
+        hash256children(_s, b, _end, _preLen, _rlp, *_executor);
+      } else {
+        // Children are encoded first, so the ones that are referenced by hash are hashed together
+        std::array<std::optional<RLPStream>, 16> children;
+        std::array<bytesConstRef, 16> to_hash;
+        size_t to_hash_count = 0;
+        for (auto i = 0; i < 16; ++i) {
+          auto n = b;
+          for (; n != _end && n->first[_preLen] == i; ++n);
+          if (b != n) {
+            hash256rlp(_s, b, n, _preLen + 1, children[i].emplace());
+            if (children[i]->out().size() >= 32) {
+              to_hash[to_hash_count++] = bytesConstRef(&children[i]->out());
+            }
+          }
+          b = n;
+        }
+        std::array<h256, 16> hashes;
+        sha3Batch({to_hash.data(), to_hash_count}, hashes.data());
+        for (size_t i = 0, hashed = 0; i < 16; ++i) {
+          if (!children[i]) {
+            _rlp << "";
+          } else if (children[i]->out().size() < 32) {
+            // RECURSIVE RLP
+            _rlp.appendRaw(children[i]->out());
+          } else {
+            _rlp << hashes[hashed++];
+          }
         }
-        b = n;
       }
       if (_preLen == _begin->first.size()) {
         _rlp << _begin->second;
@@ -88,10 +125,11 @@ void hash256rlp(HexMap const& _s, HexMap::const_iterator _begin, HexMap::const_i
   }
 }
 
-void hash256aux(HexMap const& _s, HexMap::const_iterator _begin, HexMap::const_iterator _end, unsigned _preLen,
-                RLPStream& _rlp) {
+template <class Map>
+void hash256aux(Map const& _s, typename Map::const_iterator _begin, typename Map::const_iterator _end,
+                unsigned _preLen, RLPStream& _rlp, const util::Executor* _executor) {
   RLPStream rlp;
-  hash256rlp(_s, _begin, _end, _preLen, rlp);
+  hash256rlp(_s, _begin, _end, _preLen, rlp, _executor);
   if (rlp.out().size() < 32) {
     // RECURSIVE RLP
     _rlp.appendRaw(rlp.out());
@@ -100,6 +138,66 @@ void hash256aux(HexMap const& _s, HexMap::const_iterator _begin, HexMap::const_i
   }
 }
 
+// Appends 16 children of a branch node, each of them is hashed either by a task posted to the executor or by the
+// calling thread, whichever claims it first. Caller waits only for children that are already being hashed by running
+// tasks, so it never waits for a task that did not start, even when all workers are busy
+template <class Map>
+void hash256children(Map const& _s, typename Map::const_iterator _begin, typename Map::const_iterator _end,
+                     unsigned _preLen, RLPStream& _rlp, const util::Executor& _executor) {
+  struct Child {
+    typename Map::const_iterator begin, end;
+    RLPStream rlp;
+    std::atomic_flag claimed;
+    std::atomic<bool> done = false;
+    std::exception_ptr error;
+  };
+  // Tasks that are not claimed may run after this function returned, so they own the state
+  auto children = std::make_shared<std::array<Child, 16>>();
+  for (auto i = 0; i < 16; ++i) {
+    auto& child = (*children)[i];
+    child.begin = _begin;
+    for (; _begin != _end && _begin->first[_preLen] == i; ++_begin);
+    child.end = _begin;
+  }
+
+  const auto hash_child = [&_s, _preLen, &_executor](Child& child) {
+    try {
+      hash256aux(_s, child.begin, child.end, _preLen + 1, child.rlp, &_executor);
+    } catch (...) {
+      child.error = std::current_exception();
+    }
+    child.done.store(true, std::memory_order_release);
+    child.done.notify_all();
+  };
+  for (auto& child : *children) {
+    if (std::distance(child.begin, child.end) > 1) {
+      _executor.post([children, &child, hash_child] {
+        if (!child.claimed.test_and_set(std::memory_order_acq_rel)) {
+          hash_child(child);
+        }
+      });
+    }
+  }
+  // Tasks are started in order they were posted, caller starts from the other end
+  for (auto it = children->rbegin(); it != children->rend(); ++it) {
+    if (it->begin != it->end && !it->claimed.test_and_set(std::memory_order_acq_rel)) {
+      hash_child(*it);
+    }
+  }
+
+  for (auto& child : *children) {
+    if (child.begin == child.end) {
+      _rlp << "";
+      continue;
+    }
+    child.done.wait(false, std::memory_order_acquire);
+    if (child.error) {
+      std::rethrow_exception(child.error);
+    }
+    _rlp.appendRaw(child.rlp.out());
+  }
+}
+
 h256 hash256(BytesMap const& _s) {
   if (_s.empty()) {
     static auto const empty_trie = sha3(RLPStream().append("").out());
@@ -113,4 +211,37 @@ h256 hash256(BytesMap const& _s) {
   return sha3(s.out());
 }
 
+h256 orderedTrieRoot(std::span<const dev::bytesConstRef> values, std::pmr::memory_resource* arena,
+                     const util::Executor* executor) {
+  if (values.empty()) {
+    return hash256({});
+  }
+  using Nibbles = std::pmr::vector<uint8_t>;
+  std::pmr::vector<std::pair<Nibbles, bytesConstRef>> hex_list(arena);
+  hex_list.reserve(values.size());
+  RLPStream key_rlp;
+  const auto append = [&](size_t i) {
+    const auto& key = util::rlp_enc(key_rlp, i);
+    Nibbles nibbles(arena);
+    nibbles.reserve(key.size() * 2);
+    for (const auto b : key) {
+      nibbles.push_back(b >> 4);
+      nibbles.push_back(b & 0x0f);
+    }
+    hex_list.emplace_back(std::move(nibbles), values[i]);
+  };
+  // Keys are generated in the order of their rlp: single byte 0x01..0x7f, then 0x80 for 0, then longer ones, which
+  // are prefixed by their length and so ordered by value
+  for (size_t i = 1; i < std::min<size_t>(values.size(), 0x80); ++i) {
+    append(i);
+  }
+  append(0);
+  for (size_t i = 0x80; i < values.size(); ++i) {
+    append(i);
+  }
+  RLPStream s;
+  hash256rlp(hex_list, hex_list.cbegin(), hex_list.cend(), 0, s, executor);
+  return sha3(s.out());
+}
+
 }  // namespace taraxa::final_chain
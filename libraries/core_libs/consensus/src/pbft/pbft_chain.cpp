@@ -1,6 +1,7 @@
 #include "pbft/pbft_chain.hpp"
 
 #include <libdevcore/CommonJS.h>
+#include <libdevcore/RLP.h>
 
 #include "pbft/pbft_manager.hpp"
 
@@ -13,21 +14,29 @@ PbftChain::PbftChain(addr_t node_addr, std::shared_ptr<DbStorage> db)
   LOG_OBJECTS_CREATE("PBFT_CHAIN");
 
   // Get PBFT head from DB
-  auto pbft_head_str = db_->getPbftHead(head_hash_);
-  if (pbft_head_str.empty()) {
+  const auto pbft_head = db_->getPbftHead(head_hash_);
+  if (pbft_head.empty()) {
     // Store PBFT HEAD to db
-    auto head_json_str = getJsonStr();
-    db_->savePbftHead(head_hash_, head_json_str);
-    LOG(log_nf_) << "Initialize PBFT chain head " << head_json_str;
+    db_->savePbftHead(head_hash_, getHeadRlp());
+    LOG(log_nf_) << "Initialize PBFT chain head " << getJsonStr();
     return;
   }
 
-  Json::Value doc;
-  istringstream(pbft_head_str) >> doc;
-  head_hash_ = blk_hash_t(doc["head_hash"].asString());
-  size_ = doc["size"].asUInt64();
-  non_empty_size_ = doc["non_empty_size"].asUInt64();
-  last_pbft_block_hash_ = blk_hash_t(doc["last_pbft_block_hash"].asString());
+  // Databases created before the binary encoding keep JSON head until the next block is pushed
+  if (pbft_head.front() == '{') {
+    Json::Value doc;
+    istringstream(std::string(pbft_head.begin(), pbft_head.end())) >> doc;
+    head_hash_ = blk_hash_t(doc["head_hash"].asString());
+    size_ = doc["size"].asUInt64();
+    non_empty_size_ = doc["non_empty_size"].asUInt64();
+    last_pbft_block_hash_ = blk_hash_t(doc["last_pbft_block_hash"].asString());
+  } else {
+    dev::RLP rlp(pbft_head);
+    head_hash_ = rlp[0].toHash<blk_hash_t>();
+    size_ = rlp[1].toInt<PbftPeriod>();
+    non_empty_size_ = rlp[2].toInt<PbftPeriod>();
+    last_pbft_block_hash_ = rlp[3].toHash<blk_hash_t>();
+  }
   // Retrieve last_non_null_pbft_dag_anchor_hash_ from chain
   if (last_pbft_block_hash_) {
     auto prev_pbft_block = getPbftBlockInChain(last_pbft_block_hash_);
@@ -119,18 +128,21 @@ std::string PbftChain::getJsonStr() const {
   return json.toStyledString();
 }
 
-std::string PbftChain::getJsonStrForBlock(blk_hash_t const& block_hash, bool null_anchor) const {
-  Json::Value json;
+bytes PbftChain::getHeadRlp() const {
   std::shared_lock lock(chain_head_access_);
-  json["head_hash"] = head_hash_.toString();
-  json["size"] = static_cast<Json::Value::UInt64>(size_) + 1;
-  auto non_empty_size = non_empty_size_;
-  if (!null_anchor) {
-    non_empty_size++;
-  }
-  json["non_empty_size"] = (Json::Value::UInt64)non_empty_size;
-  json["last_pbft_block_hash"] = block_hash.toString();
-  return json.toStyledString();
+  return headRlp(head_hash_, size_, non_empty_size_, last_pbft_block_hash_);
+}
+
+bytes PbftChain::getHeadRlpForBlock(blk_hash_t const& block_hash, bool null_anchor) const {
+  std::shared_lock lock(chain_head_access_);
+  return headRlp(head_hash_, size_ + 1, null_anchor ? non_empty_size_ : non_empty_size_ + 1, block_hash);
+}
+
+bytes PbftChain::headRlp(blk_hash_t const& head_hash, PbftPeriod size, PbftPeriod non_empty_size,
+                         blk_hash_t const& last_pbft_block_hash) {
+  dev::RLPStream s(4);
+  s << head_hash << size << non_empty_size << last_pbft_block_hash;
+  return s.invalidate();
 }
 
 std::ostream& operator<<(std::ostream& strm, PbftChain const& pbft_chain) {
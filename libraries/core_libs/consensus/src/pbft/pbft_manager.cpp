@@ -2,10 +2,15 @@
 
 #include <libdevcore/SHA3.h>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <future>
 #include <string>
+#include <utility>
 
+#include "common/thread_placement.hpp"
 #include "config/version.hpp"
 #include "dag/dag.hpp"
 #include "dag/dag_manager.hpp"
@@ -19,6 +24,21 @@ using namespace std::chrono_literals;
 
 constexpr std::chrono::milliseconds kPollingIntervalMs{100};
 constexpr PbftStep kMaxSteps{13};  // Need to be a odd number
+constexpr double kProposalArrivalPercentile = 0.95;
+
+// Steps 1-3 are propose, filter and certify, after them even steps are first finish and odd steps second finish
+static std::string_view stepStageName(PbftStep step) {
+  switch (step) {
+    case 1:
+      return "propose_step";
+    case 2:
+      return "filter_step";
+    case 3:
+      return "certify_step";
+    default:
+      return step % 2 ? "second_finish_step" : "first_finish_step";
+  }
+}
 
 PbftManager::PbftManager(const FullNodeConfig &conf, std::shared_ptr<DbStorage> db,
                          std::shared_ptr<PbftChain> pbft_chain, std::shared_ptr<VoteManager> vote_mgr,
@@ -32,12 +52,13 @@ PbftManager::PbftManager(const FullNodeConfig &conf, std::shared_ptr<DbStorage>
       trx_mgr_(std::move(trx_mgr)),
       final_chain_(std::move(final_chain)),
       pillar_chain_mgr_(std::move(pillar_chain_mgr)),
-      kSyncingThreadPoolSize(std::thread::hardware_concurrency() / 2),
-      sync_thread_pool_(std::make_shared<util::ThreadPool>(kSyncingThreadPoolSize)),
+      kSyncingTasksCount(std::thread::hardware_concurrency() / 2),
       rounds_count_dynamic_lambda_(0),
       dynamic_lambda_(conf.genesis.state.hardforks.cacti_hf.lambda_max),
       dag_genesis_block_hash_(conf.genesis.dag_genesis_block.getHash()),
       kGenesisConfig(conf.genesis),
+      kAdaptiveStepTiming(conf.adaptive_step_timing),
+      kFollowerConfig(conf.network.follower),
       proposed_blocks_(db_),
       eligible_wallets_(conf.wallets) {
   // Use first wallet as default node_addr
@@ -124,6 +145,8 @@ PbftManager::~PbftManager() { stop(); }
 
 void PbftManager::setNetwork(std::weak_ptr<Network> network) { network_ = std::move(network); }
 
+void PbftManager::setStageTimings(std::shared_ptr<util::StageTimings> timings) { stage_timings_ = std::move(timings); }
+
 void PbftManager::start() {
   if (bool b = true; !stopped_.compare_exchange_strong(b, !b)) {
     return;
@@ -144,11 +167,27 @@ void PbftManager::stop() {
   }
 
   daemon_->join();
+  // Proposals validations use pbft manager members
+  while (pending_proposals_validations_) {
+    std::this_thread::yield();
+  }
   final_chain_->stop();
 
   LOG(log_dg_) << "PBFT daemon terminated ...";
 }
 
+void PbftManager::wakeUp() {
+  std::unique_lock<std::mutex> lock(stop_mtx_);
+  woken_up_ = true;
+  stop_cv_.notify_all();
+}
+
+bool PbftManager::waitForEvent_(std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> lock(stop_mtx_);
+  stop_cv_.wait_for(lock, timeout, [this] { return woken_up_ || stopped_; });
+  return std::exchange(woken_up_, false);
+}
+
 /* When a node starts up it has to sync to the current phase (type of block
  * being generated) and step (within the block generation round)
  * Five step loop for block generation over three phases of blocks
@@ -157,7 +196,15 @@ void PbftManager::stop() {
  * users from which have received valid round p credentials
  */
 void PbftManager::run() {
+  util::placeCurrentThread(util::thread_group::kPbft);
   while (!stopped_) {
+    // Follower does not take part in consensus, it only executes period data synced from its upstream nodes
+    if (kFollowerConfig) {
+      pushSyncedPbftBlocksIntoChain();
+      waitForEvent_(kPollingIntervalMs);
+      continue;
+    }
+
     if (stateOperations_()) {
       continue;
     }
@@ -238,7 +285,8 @@ void PbftManager::waitForPeriodFinalization() {
     if (pbft_chain_->getPbftChainSize() <= final_chain_->lastBlockNumber() + final_chain_->delegationDelay()) {
       break;
     }
-    thisThreadSleepForMilliSeconds(kPollingIntervalMs.count());
+    // Woken up by finalized blocks
+    waitForEvent_(kPollingIntervalMs);
   } while (!stopped_);
 }
 
@@ -289,8 +337,10 @@ std::optional<uint64_t> PbftManager::getCurrentNodeVotesCount() const {
 }
 
 void PbftManager::setPbftStep(PbftStep pbft_step) {
+  recordStepDuration_();
   db_->savePbftMgrField(PbftMgrField::Step, pbft_step);
   step_ = pbft_step;
+  current_step_start_datetime_ = std::chrono::system_clock::now();
 
   // Increase lambda only for odd steps (second finish steps) after node reached kMaxSteps steps
   if (step_ >= kMaxSteps && step_ % 2) {
@@ -412,6 +462,11 @@ void PbftManager::resetPbftConsensus(PbftRound round) {
   // Cleanup saved broadcasted votes for current round
   current_round_broadcasted_votes_.clear();
 
+  recordStepDuration_();
+  if (stage_timings_ && current_round_start_datetime_ != time_point{}) {
+    stage_timings_->record("round", std::chrono::system_clock::now() - current_round_start_datetime_);
+  }
+
   // Reset broadcast counters
   broadcast_votes_counter_ = 1;
   rebroadcast_votes_counter_ = 1;
@@ -465,6 +520,14 @@ void PbftManager::resetPbftConsensus(PbftRound round) {
   vote_mgr_->setCurrentPbftPeriodAndRound(period, round);
 
   current_round_start_datetime_ = std::chrono::system_clock::now();
+  current_step_start_datetime_ = current_round_start_datetime_;
+}
+
+void PbftManager::recordStepDuration_() {
+  if (!stage_timings_ || current_step_start_datetime_ == time_point{}) {
+    return;
+  }
+  stage_timings_->record(stepStageName(step_), std::chrono::system_clock::now() - current_step_start_datetime_);
 }
 
 void PbftManager::adjustDynamicLambda(PbftPeriod finalized_period, PbftRound finalized_round, Batch &write_batch) {
@@ -529,8 +592,15 @@ void PbftManager::sleep_() {
     const auto [round, period] = getPbftRoundAndPeriod();
     LOG(log_tr_) << "Sleep " << time_to_sleep_for_ms.count() << " [ms] before going into the next step. Period "
                  << period << ", round " << round << ", step " << step_;
-    std::unique_lock<std::mutex> lock(stop_mtx_);
-    stop_cv_.wait_for(lock, time_to_sleep_for_ms);
+    if (!waitForEvent_(time_to_sleep_for_ms)) {
+      continue;
+    }
+
+    // Polling states check their 2t+1 votes right away. Other steps keep their timing and only state operations
+    // (synced blocks, 2t+1 cert voted block, round advance) are run before the step time
+    if (state_ == certify_state || state_ == finish_polling_state || stateOperations_()) {
+      return;
+    }
   }
 }
 
@@ -565,6 +635,8 @@ void PbftManager::initialState() {
   } else {
     current_round_lambda_ = std::chrono::milliseconds(kGenesisConfig.pbft.lambda_ms);
   }
+  // Node might be restarted in certify step, filter step time of the round is not known anymore
+  filter_step_time_ = 2 * current_round_lambda_;
 
   const auto now = std::chrono::system_clock::now();
 
@@ -624,6 +696,7 @@ void PbftManager::initialState() {
 
   current_round_start_datetime_ = now;
   current_period_start_datetime_ = now;
+  current_step_start_datetime_ = now;
   next_step_time_ms_ = std::chrono::milliseconds(0);
 
   // Set current period & round in vote manager
@@ -643,16 +716,33 @@ void PbftManager::initialState() {
                                                                : "no value");
 }
 
+std::chrono::milliseconds PbftManager::getFilterStepTime_() const {
+  const auto protocol_time = 2 * current_round_lambda_;
+  if (!kAdaptiveStepTiming) {
+    return protocol_time;
+  }
+
+  const auto proposal_arrival =
+      vote_mgr_->getVoteArrivalPercentile(PbftVoteTypes::propose_vote, kProposalArrivalPercentile);
+  if (!proposal_arrival.has_value()) {
+    return protocol_time;
+  }
+
+  // Leave the same margin as protocol time over the measured arrival, but never wait longer than protocol time
+  return std::clamp(2 * *proposal_arrival, current_round_lambda_ / 2, protocol_time);
+}
+
 void PbftManager::setFilterState_() {
   state_ = filter_state;
   setPbftStep(step_ + 1);
-  next_step_time_ms_ = 2 * current_round_lambda_;
+  filter_step_time_ = getFilterStepTime_();
+  next_step_time_ms_ = filter_step_time_;
 }
 
 void PbftManager::setCertifyState_() {
   state_ = certify_state;
   setPbftStep(step_ + 1);
-  next_step_time_ms_ = 2 * current_round_lambda_;
+  next_step_time_ms_ = filter_step_time_;
   printCertStepInfo_ = true;
 }
 
@@ -843,8 +933,8 @@ bool PbftManager::stateOperations_() {
   // consensus steps (propose, soft-vote, cert-vote, next-vote). Nodes that have no delegation should just
   // observe 2t+1 cert votes to move to the next period or 2t+1 next votes to move to the next round
 
-  // Check 2t+1 cert/next votes every kPollingIntervalMs
-  std::this_thread::sleep_for(std::chrono::milliseconds(kPollingIntervalMs));
+  // Check 2t+1 cert/next votes every kPollingIntervalMs or as soon as they are reached
+  waitForEvent_(kPollingIntervalMs);
   return true;
 }
 
@@ -861,12 +951,13 @@ std::shared_ptr<PbftBlock> PbftManager::getValidPbftProposedBlock(ProposedBlocks
 
   // Block is not validated yet
   if (!block_data->second) {
-    if (!validatePbftBlock(block)) {
+    auto validated = validatePbftBlock(block);
+    if (!validated) {
       LOG(log_er_) << "Proposed block " << block_hash << " failed validation, period " << period;
       return nullptr;
     }
 
-    proposed_blocks.markBlockAsValid(block);
+    proposed_blocks.markBlockAsValid(block, std::move(validated));
   }
 
   return block;
@@ -1177,7 +1268,7 @@ void PbftManager::certifyBlock_() {
   }
 
   // Should not happen, add log here for safety checking
-  if (elapsed_time_in_round < 2 * current_round_lambda_) {
+  if (elapsed_time_in_round < filter_step_time_) {
     LOG(log_er_) << "PBFT Reached step 3 too quickly after only " << elapsed_time_in_round.count() << " [ms] in period "
                  << period << ", round " << round;
     return;
@@ -1205,6 +1296,9 @@ void PbftManager::certifyBlock_() {
     return;
   }
 
+  // Block is likely to be finalized in this round, its transactions are assembled while cert votes are collected
+  preassemblePeriodData(soft_voted_block);
+
   // generate cert vote
   if (!genAndPlaceVote(PbftVoteTypes::cert_vote, soft_voted_block->getPeriod(), round, step_,
                        soft_voted_block->getBlockHash(), soft_voted_block)) {
@@ -1214,6 +1308,10 @@ void PbftManager::certifyBlock_() {
 
   cert_voted_block_for_round_ = soft_voted_block;
   db_->saveCertVotedBlockInRound(round, soft_voted_block);
+  if (stage_timings_) {
+    // Round starts with the proposal, so this is proposal to cert time of the block
+    stage_timings_->record("proposal_to_cert", elapsedTimeInMs(current_round_start_datetime_));
+  }
 }
 
 void PbftManager::firstFinish_() {
@@ -1420,7 +1518,29 @@ void PbftManager::processProposedBlock(const std::shared_ptr<PbftBlock> &propose
     return;
   }
 
-  proposed_blocks_.pushProposedPbftBlock(proposed_block);
+  if (!proposed_blocks_.pushProposedPbftBlock(proposed_block) || proposed_block->getPeriod() != getPbftPeriod()) {
+    return;
+  }
+
+  // Proposal is validated on a worker before it is needed by pbft thread. Validation failures are not stored, the
+  // reason could be missing dag blocks that arrive later, so the block is validated again once it is voted for
+  const auto &anchor_hash = proposed_block->getPivotDagBlockHash();
+  if (stopped_ || (anchor_hash != kNullBlockHash && !dag_mgr_->isDagBlockKnown(anchor_hash))) {
+    return;
+  }
+  pending_proposals_validations_++;
+  proposals_validation_executor_.post([this, proposed_block] {
+    try {
+      if (!stopped_ && proposed_block->getPeriod() == getPbftPeriod()) {
+        if (auto validated = validatePbftBlock(proposed_block)) {
+          proposed_blocks_.markBlockAsValid(proposed_block, std::move(validated));
+        }
+      }
+    } catch (const std::exception &e) {
+      LOG(log_er_) << "Validation of proposed block " << proposed_block->getBlockHash() << " failed: " << e.what();
+    }
+    pending_proposals_validations_--;
+  });
 }
 
 blk_hash_t PbftManager::calculateOrderHash(const std::vector<blk_hash_t> &dag_block_hashes) {
@@ -1755,31 +1875,32 @@ bool PbftManager::validatePillarDataInPeriodData(const PeriodData &period_data)
   return true;
 }
 
-bool PbftManager::validatePbftBlock(const std::shared_ptr<PbftBlock> &pbft_block) const {
+std::shared_ptr<const ValidatedBlockData> PbftManager::validatePbftBlock(
+    const std::shared_ptr<PbftBlock> &pbft_block) const {
   if (!pbft_block) {
     LOG(log_er_) << "Unable to validate pbft block - no block provided";
-    return false;
+    return nullptr;
   }
 
   // Validates pbft_block's previous block hash against pbft chain
   if (!pbft_chain_->checkPbftBlockValidation(pbft_block)) {
-    return false;
+    return nullptr;
   }
 
   auto const &pbft_block_hash = pbft_block->getBlockHash();
 
   if (validateFinalChainHash(pbft_block) != PbftStateRootValidation::Valid) {
-    return false;
+    return nullptr;
   }
 
   // Validates reward votes
   if (!vote_mgr_->checkRewardVotes(pbft_block, false).first) {
     LOG(log_er_) << "Failed verifying reward votes for proposed PBFT block " << pbft_block_hash;
-    return false;
+    return nullptr;
   }
 
   if (!validatePbftBlockExtraData(pbft_block)) {
-    return false;
+    return nullptr;
   }
 
   // Validate optional pillar block hash
@@ -1790,7 +1911,7 @@ bool PbftManager::validatePbftBlock(const std::shared_ptr<PbftBlock> &pbft_block
       // This should never happen
       LOG(log_er_) << "Unable to validate PBFT block " << pbft_block_hash << ", period " << block_period
                    << ". No current pillar block present in node";
-      return false;
+      return nullptr;
     }
 
     if (*pbft_block->getExtraData()->getPillarBlockHash() != current_pillar_block->getHash()) {
@@ -1798,24 +1919,33 @@ bool PbftManager::validatePbftBlock(const std::shared_ptr<PbftBlock> &pbft_block
                    << " contains pillar block hash " << *pbft_block->getExtraData()->getPillarBlockHash()
                    << ", which is different than the local current pillar block" << current_pillar_block->getHash()
                    << " with period " << current_pillar_block->getPeriod();
-      return false;
+      return nullptr;
     }
   }
 
   auto const &anchor_hash = pbft_block->getPivotDagBlockHash();
   if (anchor_hash == kNullBlockHash) {
-    return true;
+    return std::make_shared<const ValidatedBlockData>();
   }
 
-  auto dag_order_it = anchor_dag_block_order_cache_.find(anchor_hash);
-  if (dag_order_it != anchor_dag_block_order_cache_.end()) {
-    return true;
+  {
+    std::scoped_lock lock(anchor_dag_block_order_cache_mutex_);
+    if (auto dag_order_it = anchor_dag_block_order_cache_.find(anchor_hash);
+        anchor_dag_block_order_cache_period_ == block_period && dag_order_it != anchor_dag_block_order_cache_.end()) {
+      if (dag_order_it->second->order_hash != pbft_block->getOrderHash()) {
+        LOG(log_er_) << "Order hash incorrect. Pbft block: " << pbft_block_hash
+                     << ". Order hash: " << pbft_block->getOrderHash()
+                     << " . Calculated hash:" << dag_order_it->second->order_hash;
+        return nullptr;
+      }
+      return dag_order_it->second;
+    }
   }
 
   auto dag_blocks_order = dag_mgr_->getDagBlockOrder(anchor_hash, pbft_block->getPeriod());
   if (dag_blocks_order.empty()) {
     LOG(log_er_) << "Missing dag blocks for proposed PBFT block " << pbft_block_hash;
-    return false;
+    return nullptr;
   }
 
   auto calculated_order_hash = calculateOrderHash(dag_blocks_order);
@@ -1823,14 +1953,22 @@ bool PbftManager::validatePbftBlock(const std::shared_ptr<PbftBlock> &pbft_block
     LOG(log_er_) << "Order hash incorrect. Pbft block: " << pbft_block_hash
                  << ". Order hash: " << pbft_block->getOrderHash() << " . Calculated hash:" << calculated_order_hash
                  << ". Dag order: " << dag_blocks_order;
-    return false;
+    return nullptr;
   }
 
-  anchor_dag_block_order_cache_[anchor_hash].reserve(dag_blocks_order.size());
+  auto data = std::make_shared<ValidatedBlockData>();
+  data->order_hash = calculated_order_hash;
+  data->dag_blocks.reserve(dag_blocks_order.size());
+  std::unordered_set<trx_hash_t> trx_set;
   for (auto const &dag_blk_hash : dag_blocks_order) {
     auto dag_block = dag_mgr_->getDagBlock(dag_blk_hash);
     assert(dag_block);
-    anchor_dag_block_order_cache_[anchor_hash].emplace_back(std::move(dag_block));
+    for (const auto &trx_hash : dag_block->getTrxs()) {
+      if (trx_set.insert(trx_hash).second) {
+        data->transactions.emplace_back(trx_hash);
+      }
+    }
+    data->dag_blocks.emplace_back(std::move(dag_block));
   }
 
   auto last_pbft_block_hash = pbft_chain_->getLastPbftBlockHash();
@@ -1838,15 +1976,23 @@ bool PbftManager::validatePbftBlock(const std::shared_ptr<PbftBlock> &pbft_block
     auto prev_pbft_block = pbft_chain_->getPbftBlockInChain(last_pbft_block_hash);
     auto ghost = dag_mgr_->getGhostPath(prev_pbft_block.getPivotDagBlockHash());
     if (ghost.size() > 1 && anchor_hash != ghost[1]) {
-      if (!checkBlockWeight(anchor_dag_block_order_cache_[anchor_hash], block_period)) {
+      if (!checkBlockWeight(data->dag_blocks, block_period)) {
         LOG(log_er_) << "PBFT block " << pbft_block_hash << " weight exceeded max limit";
-        anchor_dag_block_order_cache_.erase(anchor_hash);
-        return false;
+        return nullptr;
       }
     }
   }
 
-  return true;
+  // Validation of a proposal could finish after its period was finalized, results of old periods are not cached
+  std::scoped_lock lock(anchor_dag_block_order_cache_mutex_);
+  if (anchor_dag_block_order_cache_period_ < block_period) {
+    anchor_dag_block_order_cache_.clear();
+    anchor_dag_block_order_cache_period_ = block_period;
+  }
+  if (anchor_dag_block_order_cache_period_ == block_period) {
+    anchor_dag_block_order_cache_.emplace(anchor_hash, data);
+  }
+  return data;
 }
 
 bool PbftManager::pushCertVotedPbftBlockIntoChain_(const std::shared_ptr<PbftBlock> &pbft_block,
@@ -1854,20 +2000,30 @@ bool PbftManager::pushCertVotedPbftBlockIntoChain_(const std::shared_ptr<PbftBlo
   PeriodData period_data;
   period_data.pbft_blk = pbft_block;
   if (pbft_block->getPivotDagBlockHash() != kNullBlockHash) {
-    auto dag_order_it = anchor_dag_block_order_cache_.find(pbft_block->getPivotDagBlockHash());
-    assert(dag_order_it != anchor_dag_block_order_cache_.end());
-    std::unordered_set<trx_hash_t> trx_set;
-    std::vector<trx_hash_t> transactions_to_query;
-    period_data.dag_blocks.reserve(dag_order_it->second.size());
-    for (const auto &dag_blk : dag_order_it->second) {
-      for (const auto &trx_hash : dag_blk->getTrxs()) {
-        if (trx_set.insert(trx_hash).second) {
-          transactions_to_query.emplace_back(trx_hash);
-        }
+    // Cert voted block was validated before, dag blocks order and transactions list are reused. If it was soft voted
+    // by this node, transactions were already fetched and ordered in background
+    auto validated = proposed_blocks_.getValidatedBlockData(pbft_block->getPeriod(), pbft_block->getBlockHash());
+    std::optional<SharedTransactions> transactions;
+    if (auto preassembled = std::exchange(preassembled_period_data_, std::nullopt);
+        preassembled && preassembled->pbft_block->getBlockHash() == pbft_block->getBlockHash()) {
+      try {
+        preassembled->assembled.get();
+        validated = preassembled->validated;
+        transactions = std::move(*preassembled->transactions);
+      } catch (const std::exception &e) {
+        LOG(log_er_) << "Assembling of period data for block " << pbft_block->getBlockHash() << " failed: " << e.what();
       }
-      period_data.dag_blocks.emplace_back(dag_blk);
     }
-    period_data.transactions = trx_mgr_->getNonfinalizedTrx(transactions_to_query);
+    if (!validated) {
+      validated = validatePbftBlock(pbft_block);
+    }
+    if (!validated) {
+      LOG(log_er_) << "Cert voted block " << pbft_block->getBlockHash() << " failed validation";
+      return false;
+    }
+    period_data.dag_blocks = validated->dag_blocks;
+    period_data.transactions =
+        transactions ? std::move(*transactions) : trx_mgr_->getNonfinalizedTrx(validated->transactions);
   }
 
   auto reward_votes = vote_mgr_->checkRewardVotes(period_data.pbft_blk, true);
@@ -1885,6 +2041,27 @@ bool PbftManager::pushCertVotedPbftBlockIntoChain_(const std::shared_ptr<PbftBlo
   return true;
 }
 
+void PbftManager::preassemblePeriodData(const std::shared_ptr<PbftBlock> &pbft_block) {
+  const auto &block_hash = pbft_block->getBlockHash();
+  if (pbft_block->getPivotDagBlockHash() == kNullBlockHash ||
+      (preassembled_period_data_ && preassembled_period_data_->pbft_block->getBlockHash() == block_hash)) {
+    return;
+  }
+  auto validated = proposed_blocks_.getValidatedBlockData(pbft_block->getPeriod(), block_hash);
+  if (!validated) {
+    return;
+  }
+
+  // Transactions of the block cannot be finalized before it is pushed, pushing is done by this thread
+  auto transactions = std::make_shared<SharedTransactions>();
+  auto assembled = proposals_validation_executor_.post([transactions, validated, trx_mgr = trx_mgr_] {
+    *transactions = trx_mgr->getNonfinalizedTrx(validated->transactions);
+    reorderTransactions(*transactions);
+  });
+  preassembled_period_data_ = PreassembledPeriodData{pbft_block, std::move(validated), std::move(transactions),
+                                                     std::move(assembled)};
+}
+
 void PbftManager::pushSyncedPbftBlocksIntoChain() {
   auto net = network_.lock();
   if (!net) {
@@ -1894,7 +2071,11 @@ void PbftManager::pushSyncedPbftBlocksIntoChain() {
 
   sync_queue_.cleanOldData(getPbftPeriod());
   while (periodDataQueueSize() > 0) {
-    auto period_data_opt = processPeriodData();
+    std::optional<std::pair<PeriodData, std::vector<std::shared_ptr<PbftVote>>>> period_data_opt;
+    {
+      util::StageTimings::Scope timing(stage_timings_, "verify");
+      period_data_opt = processPeriodData();
+    }
     if (!period_data_opt) continue;
 
     auto period_data = std::move(*period_data_opt);
@@ -2028,16 +2209,21 @@ bool PbftManager::pushPbftBlock_(PeriodData &&period_data, std::vector<std::shar
 
   // Update PBFT chain head block
   auto batch = db_->createWriteBatch();
-  db_->addPbftHeadToBatch(pbft_chain_->getHeadHash(), pbft_chain_->getJsonStrForBlock(pbft_block_hash, null_anchor),
+  db_->addPbftHeadToBatch(pbft_chain_->getHeadHash(), pbft_chain_->getHeadRlpForBlock(pbft_block_hash, null_anchor),
                           batch);
+  // Committed together with the block, so an extra consensus write is not needed after finalization is started
+  db_->addPbftMgrStatusToBatch(PbftMgrStatus::ExecutedBlock, true, batch);
 
   vec_blk_t dag_blocks_order;
-  dag_blocks_order.reserve(period_data.dag_blocks.size());
-  std::transform(period_data.dag_blocks.begin(), period_data.dag_blocks.end(), std::back_inserter(dag_blocks_order),
-                 [](const auto &dag_block) { return dag_block->getHash(); });
+  {
+    util::StageTimings::Scope timing(stage_timings_, "dag_ordering");
+    dag_blocks_order.reserve(period_data.dag_blocks.size());
+    std::transform(period_data.dag_blocks.begin(), period_data.dag_blocks.end(), std::back_inserter(dag_blocks_order),
+                   [](const auto &dag_block) { return dag_block->getHash(); });
 
-  // We need to reorder transactions before saving them
-  reorderTransactions(period_data.transactions);
+    // We need to reorder transactions before saving them
+    reorderTransactions(period_data.transactions);
+  }
 
   db_->savePeriodData(period_data, batch);
 
@@ -2057,11 +2243,17 @@ bool PbftManager::pushPbftBlock_(PeriodData &&period_data, std::vector<std::shar
     std::unique_lock trx_lock(trx_mgr_->getTransactionsMutex());
 
     // Commit DB
-    db_->commitWriteBatch(batch);
+    {
+      util::StageTimings::Scope timing(stage_timings_, "db_commit");
+      db_->commitWriteBatch(batch);
+    }
 
     // Set DAG blocks period
     auto const &anchor_hash = period_data.pbft_blk->getPivotDagBlockHash();
-    dag_mgr_->setDagBlockOrder(anchor_hash, block_pbft_period, dag_blocks_order);
+    {
+      util::StageTimings::Scope timing(stage_timings_, "dag_ordering");
+      dag_mgr_->setDagBlockOrder(anchor_hash, block_pbft_period, dag_blocks_order);
+    }
 
     trx_mgr_->updateFinalizedTransactionsStatus(period_data);
 
@@ -2070,7 +2262,11 @@ bool PbftManager::pushPbftBlock_(PeriodData &&period_data, std::vector<std::shar
   }
 
   // anchor_dag_block_order_cache_ is valid in one period, clear when period changes
-  anchor_dag_block_order_cache_.clear();
+  {
+    std::scoped_lock lock(anchor_dag_block_order_cache_mutex_);
+    anchor_dag_block_order_cache_.clear();
+    anchor_dag_block_order_cache_period_ = block_pbft_period + 1;
+  }
 
   LOG(log_nf_) << "Pushed new PBFT block " << pbft_block_hash << " into chain. Period: " << block_pbft_period
                << ", round: " << block_pbft_round;
@@ -2106,7 +2302,6 @@ bool PbftManager::pushPbftBlock_(PeriodData &&period_data, std::vector<std::shar
 
   finalize_(std::move(period_data), std::move(dag_blocks_order), blocks_per_year);
 
-  db_->savePbftMgrStatus(PbftMgrStatus::ExecutedBlock, true);
   executed_pbft_block_ = true;
 
   // Advance pbft consensus period
@@ -2236,7 +2431,9 @@ std::optional<std::pair<PeriodData, std::vector<std::shared_ptr<PbftVote>>>> Pbf
   }
 
   // Validate cert votes
-  if (!validatePbftBlockCertVotes(period_data.pbft_blk, cert_votes)) {
+  const bool trusted_votes = kFollowerConfig && kFollowerConfig->trust_upstream_votes &&
+                             kFollowerConfig->upstream_nodes.contains(node_id);
+  if (!validatePbftBlockCertVotes(period_data.pbft_blk, cert_votes, trusted_votes)) {
     LOG(log_er_) << "Synced PBFT block " << pbft_block_hash
                  << " doesn't have enough valid cert votes. Clear synced PBFT blocks!";
     sync_queue_.clear();
@@ -2294,18 +2491,19 @@ std::optional<std::pair<PeriodData, std::vector<std::shared_ptr<PbftVote>>>> Pbf
 }
 
 bool PbftManager::validatePbftBlockCertVotes(const std::shared_ptr<PbftBlock> pbft_block,
-                                             const std::vector<std::shared_ptr<PbftVote>> &cert_votes) const {
+                                             std::vector<std::shared_ptr<PbftVote>> &cert_votes,
+                                             bool trusted_votes) const {
+  if (cert_votes.empty()) {
+    LOG(log_er_) << "No cert votes provided! The synced PBFT block comes from a malicious player";
+    return false;
+  }
+
   // To speed up syncing/rebuilding full strict vote verification is done for all votes on every
   // full_vote_validation_interval and for a random vote for each block
   const uint32_t full_vote_validation_interval = 100;
   const uint32_t vote_to_validate = std::rand() % cert_votes.size();
   const bool strict_validation = (pbft_block->getPeriod() % full_vote_validation_interval == 0);
 
-  if (cert_votes.empty()) {
-    LOG(log_er_) << "No cert votes provided! The synced PBFT block comes from a malicious player";
-    return false;
-  }
-
   size_t votes_weight = 0;
   auto first_vote_round = cert_votes[0]->getRound();
   auto first_vote_period = cert_votes[0]->getPeriod();
@@ -2315,8 +2513,11 @@ bool PbftManager::validatePbftBlockCertVotes(const std::shared_ptr<PbftBlock> pb
     return false;
   }
 
+  // Votes already verified when they were received in gossip are not validated again
+  std::vector<std::shared_ptr<PbftVote>> strict_votes, non_strict_votes;
+  std::unordered_set<vote_hash_t> votes_hashes;
   for (uint32_t vote_counter = 0; vote_counter < cert_votes.size(); vote_counter++) {
-    const auto &v = cert_votes[vote_counter];
+    auto &v = cert_votes[vote_counter];
     // Any info is wrong that can determine the synced PBFT block comes from a malicious player
     if (v->getPeriod() != first_vote_period) {
       LOG(log_er_) << "Invalid cert vote " << v->getHash() << " period " << v->getPeriod() << ", PBFT block "
@@ -2348,18 +2549,47 @@ bool PbftManager::validatePbftBlockCertVotes(const std::shared_ptr<PbftBlock> pb
       return false;
     }
 
-    bool strict = strict_validation || (vote_counter == vote_to_validate);
-
-    if (const auto ret = vote_mgr_->validateVote(v, strict); !ret.first) {
-      LOG(log_er_) << "Cert vote " << v->getHash() << " validation failed. Err: " << ret.second << ", pbft block "
-                   << pbft_block->getBlockHash();
+    if (!votes_hashes.insert(v->getHash()).second) {
+      LOG(log_er_) << "Duplicate cert vote " << v->getHash() << ", PBFT block " << pbft_block->getBlockHash();
       return false;
     }
 
-    assert(v->getWeight());
-    votes_weight += *v->getWeight();
+    if (auto verified_vote = vote_mgr_->getVerifiedVote(v)) {
+      v = std::move(verified_vote);
+      assert(v->getWeight());
+      votes_weight += *v->getWeight();
+    } else if (strict_validation || (vote_counter == vote_to_validate)) {
+      strict_votes.push_back(v);
+    } else {
+      non_strict_votes.push_back(v);
+    }
+  }
 
-    vote_mgr_->addVerifiedVote(v);
+  const auto validate = [&](const std::vector<std::shared_ptr<PbftVote>> &votes_to_validate, bool strict) {
+    if (votes_to_validate.empty()) {
+      return true;
+    }
+    const auto results = vote_mgr_->validateVotesBatch(votes_to_validate, strict, !trusted_votes);
+    for (size_t i = 0; i < votes_to_validate.size(); i++) {
+      const auto &v = votes_to_validate[i];
+      if (!results[i].first) {
+        LOG(log_er_) << "Cert vote " << v->getHash() << " validation failed. Err: " << results[i].second
+                     << ", pbft block " << pbft_block->getBlockHash();
+        return false;
+      }
+    }
+    return true;
+  };
+  if (!validate(strict_votes, true) || !validate(non_strict_votes, false)) {
+    return false;
+  }
+
+  for (const auto *validated_votes : {&strict_votes, &non_strict_votes}) {
+    for (const auto &v : *validated_votes) {
+      assert(v->getWeight());
+      votes_weight += *v->getWeight();
+      vote_mgr_->addVerifiedVote(v);
+    }
   }
 
   const auto two_t_plus_one = vote_mgr_->getPbftTwoTPlusOne(first_vote_period - 1, PbftVoteTypes::cert_vote);
@@ -2411,7 +2641,8 @@ bool PbftManager::validatePbftBlockPillarVotes(const PeriodData &period_data) co
       return false;
     }
 
-    if (!pillar_chain_mgr_->validatePillarVote(vote)) {
+    // Votes received in gossip were already validated
+    if (!pillar_chain_mgr_->isPillarVoteVerified(vote) && !pillar_chain_mgr_->validatePillarVote(vote)) {
       LOG(log_er_) << "Invalid sync pillar vote " << vote->getHash();
       return false;
     }
@@ -2469,36 +2700,68 @@ bool PbftManager::periodDataQueueEmpty() const { return sync_queue_.empty(); }
 void PbftManager::periodDataQueuePush(PeriodData &&period_data, dev::p2p::NodeID const &node_id,
                                       std::vector<std::shared_ptr<PbftVote>> &&current_block_cert_votes) {
   const auto period = period_data.pbft_blk->getPeriod();
-
-  // Only do parallel transactions retrieve for blocks bigger than 100 transactions
-  auto trx_size = period_data.transactions.size();
-  if (trx_size > 100) {
-    auto chunk_size = trx_size / kSyncingThreadPoolSize;
-
-    std::vector<std::future<void>> futures;
-    futures.reserve(kSyncingThreadPoolSize);
-    // Launch tasks in parallel
-    for (uint32_t i = 0; i < kSyncingThreadPoolSize; ++i) {
-      futures.push_back(sync_thread_pool_->post([&period_data, i, chunk_size, trx_size]() {
-        const uint32_t start = i * chunk_size;
-        const uint32_t end = std::min((i + 1) * chunk_size, trx_size);
-        for (uint32_t j = start; j < end; j++) period_data.transactions[j]->getSender();
-      }));
-    }
-    for (uint32_t i = 0; i < kSyncingThreadPoolSize; ++i) {
-      futures[i].get();
-    }
-  }
+  auto pre_verification = preVerifyPeriodData(period_data, current_block_cert_votes);
 
   if (!sync_queue_.push(std::move(period_data), node_id, pbft_chain_->getPbftChainSize(),
-                        std::move(current_block_cert_votes))) {
+                        std::move(current_block_cert_votes), std::move(pre_verification))) {
     LOG(log_er_) << "Trying to push period data with " << period << " period, but current period is "
                  << sync_queue_.getPeriod();
+    return;
   }
+  wakeUp();
+}
+
+std::shared_future<void> PbftManager::preVerifyPeriodData(
+    const PeriodData &period_data, const std::vector<std::shared_ptr<PbftVote>> &current_block_cert_votes) {
+  // Signatures are recovered and cached in transactions, dag blocks and votes, while previous periods are validated
+  // and executed. Everything that depends on state (stake, vrf keys, sortition) is still validated sequentially
+  std::vector<std::shared_ptr<Vote>> votes;
+  votes.reserve(period_data.previous_block_cert_votes.size() + current_block_cert_votes.size() +
+                (period_data.pillar_votes_.has_value() ? period_data.pillar_votes_->size() : 0));
+  votes.insert(votes.end(), period_data.previous_block_cert_votes.begin(), period_data.previous_block_cert_votes.end());
+  votes.insert(votes.end(), current_block_cert_votes.begin(), current_block_cert_votes.end());
+  if (period_data.pillar_votes_.has_value()) {
+    votes.insert(votes.end(), period_data.pillar_votes_->begin(), period_data.pillar_votes_->end());
+  }
+
+  const auto trx_size = period_data.transactions.size();
+  const size_t tasks_count = std::max<size_t>(1, std::min<size_t>(kSyncingTasksCount, trx_size / 100));
+  const size_t chunk_size = (trx_size + tasks_count - 1) / tasks_count;
+
+  auto done = std::make_shared<std::promise<void>>();
+  auto pending_tasks = std::make_shared<std::atomic<size_t>>(tasks_count);
+  auto pre_verification = done->get_future().share();
+  for (size_t i = 0; i < tasks_count; ++i) {
+    SharedTransactions transactions(period_data.transactions.begin() + std::min(i * chunk_size, trx_size),
+                                    period_data.transactions.begin() + std::min((i + 1) * chunk_size, trx_size));
+    std::vector<std::shared_ptr<DagBlock>> dag_blocks;
+    std::vector<std::shared_ptr<Vote>> task_votes;
+    // Dag blocks and votes are recovered by the first task, there is only few of them compared to transactions
+    if (i == 0) {
+      dag_blocks = period_data.dag_blocks;
+      task_votes = std::move(votes);
+    }
+    sync_executor_.post([transactions = std::move(transactions), dag_blocks = std::move(dag_blocks),
+                         task_votes = std::move(task_votes), done, pending_tasks] {
+      Vote::recoverVoters(task_votes);
+      for (const auto &dag_block : dag_blocks) {
+        dag_block->getSender();
+      }
+      // Invalid signatures are reported when the period is validated
+      Transaction::recoverSenders(transactions);
+      if (pending_tasks->fetch_sub(1) == 1) {
+        done->set_value();
+      }
+    });
+  }
+
+  return pre_verification;
 }
 
 size_t PbftManager::periodDataQueueSize() const { return sync_queue_.size(); }
 
+size_t PbftManager::periodDataQueueMemoryUsage() const { return sync_queue_.memoryUsage(); }
+
 bool PbftManager::checkBlockWeight(const std::vector<std::shared_ptr<DagBlock>> &dag_blocks, PbftPeriod period) const {
   const u256 total_weight =
       std::accumulate(dag_blocks.begin(), dag_blocks.end(), u256(0),
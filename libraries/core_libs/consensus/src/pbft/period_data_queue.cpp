@@ -3,9 +3,25 @@
 #include "dag/dag_block.hpp"
 #include "pbft/pbft_chain.hpp"
 #include "transaction/transaction.hpp"
+#include "vote/pbft_vote.hpp"
 
 namespace taraxa {
 
+namespace {
+
+size_t periodDataMemoryUsage(const PeriodData &period_data) {
+  size_t usage = sizeof(PbftBlock) + period_data.previous_block_cert_votes.size() * sizeof(PbftVote);
+  for (const auto &dag_block : period_data.dag_blocks) {
+    usage += sizeof(DagBlock) + (dag_block->getTrxs().size() + dag_block->getTips().size()) * sizeof(trx_hash_t);
+  }
+  for (const auto &trx : period_data.transactions) {
+    usage += sizeof(Transaction) + trx->getData().size();
+  }
+  return usage;
+}
+
+}  // namespace
+
 uint64_t PeriodDataQueue::getPeriod() const {
   std::shared_lock lock(queue_access_);
   return period_;
@@ -30,11 +46,14 @@ void PeriodDataQueue::clear() {
   std::unique_lock lock(queue_access_);
   period_ = 0;
   queue_.clear();
+  memory_usage_.reset();
   last_block_cert_votes_.clear();
+  last_block_cert_votes_pre_verification_ = {};
 }
 
 bool PeriodDataQueue::push(PeriodData &&period_data, const dev::p2p::NodeID &node_id, uint64_t max_pbft_size,
-                           std::vector<std::shared_ptr<PbftVote>> &&cert_votes) {
+                           std::vector<std::shared_ptr<PbftVote>> &&cert_votes,
+                           std::shared_future<void> pre_verification) {
   const auto period = period_data.pbft_blk->getPeriod();
   std::unique_lock lock(queue_access_);
 
@@ -43,41 +62,66 @@ bool PeriodDataQueue::push(PeriodData &&period_data, const dev::p2p::NodeID &nod
   if (period != std::max(period_, max_pbft_size) + 1 && (queue_.empty() && period != max_pbft_size + 2)) {
     return false;
   }
-  if (max_pbft_size > period_ && !queue_.empty()) queue_.clear();
+  if (max_pbft_size > period_ && !queue_.empty()) {
+    queue_.clear();
+    memory_usage_.reset();
+  }
   period_ = period;
-  queue_.emplace_back(std::move(period_data), node_id);
+  const auto memory_usage = periodDataMemoryUsage(period_data);
+  memory_usage_.add(memory_usage);
+  queue_.push_back({std::move(period_data), node_id, pre_verification, memory_usage});
   last_block_cert_votes_ = std::move(cert_votes);
+  last_block_cert_votes_pre_verification_ = std::move(pre_verification);
   return true;
 }
 
 std::tuple<PeriodData, std::vector<std::shared_ptr<PbftVote>>, dev::p2p::NodeID> PeriodDataQueue::pop() {
   std::unique_lock lock(queue_access_);
   auto block = std::move(queue_.front());
-  queue_.pop_front();
-  if (queue_.size() > 0)
-    return {block.first, queue_.front().first.previous_block_cert_votes, block.second};
-  else {
+  popFront();
+  std::vector<std::shared_ptr<PbftVote>> cert_votes;
+  std::shared_future<void> cert_votes_pre_verification;
+  if (queue_.size() > 0) {
+    cert_votes = queue_.front().period_data.previous_block_cert_votes;
+    cert_votes_pre_verification = queue_.front().pre_verification;
+  } else {
     // if queue is empty set period to zero and move last_block_cert_votes_
     period_ = 0;
-    auto cert_votes = std::move(last_block_cert_votes_);
+    cert_votes = std::move(last_block_cert_votes_);
     last_block_cert_votes_.clear();
-    return {block.first, std::move(cert_votes), block.second};
+    cert_votes_pre_verification = std::move(last_block_cert_votes_pre_verification_);
+    last_block_cert_votes_pre_verification_ = {};
+  }
+  lock.unlock();
+
+  // Pre-verification only warms up cached signatures, its result is not needed, the block is fully validated after pop
+  if (block.pre_verification.valid()) {
+    block.pre_verification.wait();
+  }
+  if (cert_votes_pre_verification.valid()) {
+    cert_votes_pre_verification.wait();
   }
+  return {std::move(block.period_data), std::move(cert_votes), block.node_id};
 }
 
 std::shared_ptr<PbftBlock> PeriodDataQueue::lastPbftBlock() const {
   std::shared_lock lock(queue_access_);
   if (queue_.size() > 0) {
-    return queue_.back().first.pbft_blk;
+    return queue_.back().period_data.pbft_blk;
   }
   return nullptr;
 }
 
 void PeriodDataQueue::cleanOldData(uint64_t period) {
   std::unique_lock lock(queue_access_);
-  while (queue_.size() > 0 && queue_.front().first.pbft_blk->getPeriod() < period) {
-    queue_.pop_front();
+  while (queue_.size() > 0 && queue_.front().period_data.pbft_blk->getPeriod() < period) {
+    popFront();
   }
 }
 
+void PeriodDataQueue::popFront() {
+  memory_usage_.sub(queue_.front().memory_usage);
+  queue_.pop_front();
+}
+
 }  // namespace taraxa
\ No newline at end of file
@@ -19,35 +19,55 @@ bool ProposedBlocks::pushProposedPbftBlock(const std::shared_ptr<PbftBlock>& pro
   }
 
   // Add propose vote & block
-  return found_period_it->second.insert({proposed_block->getBlockHash(), {proposed_block, false}}).second;
+  return found_period_it->second.insert({proposed_block->getBlockHash(), {proposed_block, nullptr}}).second;
 }
 
-void ProposedBlocks::markBlockAsValid(const std::shared_ptr<PbftBlock>& proposed_block) {
+const ProposedBlocks::Entry* ProposedBlocks::find(PbftPeriod period, const blk_hash_t& block_hash) const {
+  auto found_period_it = proposed_blocks_.find(period);
+  if (found_period_it == proposed_blocks_.end()) {
+    return nullptr;
+  }
+
+  auto found_block_it = found_period_it->second.find(block_hash);
+  if (found_block_it == found_period_it->second.end()) {
+    return nullptr;
+  }
+
+  return &found_block_it->second;
+}
+
+void ProposedBlocks::markBlockAsValid(const std::shared_ptr<PbftBlock>& proposed_block,
+                                      std::shared_ptr<const ValidatedBlockData> data) {
+  assert(data);
   std::unique_lock lock(proposed_blocks_mutex_);
 
   const auto found_period_it = proposed_blocks_.find(proposed_block->getPeriod());
-  assert(found_period_it != proposed_blocks_.end());
+  if (found_period_it == proposed_blocks_.end()) {
+    return;
+  }
 
-  auto found_block_it = found_period_it->second.find(proposed_block->getBlockHash());
-  // Set validation flag to true
-  found_block_it->second.second = true;
+  if (auto found_block_it = found_period_it->second.find(proposed_block->getBlockHash());
+      found_block_it != found_period_it->second.end()) {
+    found_block_it->second.second = std::move(data);
+  }
+}
+
+std::shared_ptr<const ValidatedBlockData> ProposedBlocks::getValidatedBlockData(PbftPeriod period,
+                                                                                const blk_hash_t& block_hash) const {
+  std::shared_lock lock(proposed_blocks_mutex_);
+  const auto entry = find(period, block_hash);
+  return entry ? entry->second : nullptr;
 }
 
 std::optional<std::pair<std::shared_ptr<PbftBlock>, bool>> ProposedBlocks::getPbftProposedBlock(
     PbftPeriod period, const blk_hash_t& block_hash) const {
   std::shared_lock lock(proposed_blocks_mutex_);
-
-  auto found_period_it = proposed_blocks_.find(period);
-  if (found_period_it == proposed_blocks_.end()) {
-    return {};
-  }
-
-  auto found_block_it = found_period_it->second.find(block_hash);
-  if (found_block_it == found_period_it->second.end()) {
+  const auto entry = find(period, block_hash);
+  if (!entry) {
     return {};
   }
 
-  return found_block_it->second;
+  return std::make_pair(entry->first, entry->second != nullptr);
 }
 
 bool ProposedBlocks::isInProposedBlocks(PbftPeriod period, const blk_hash_t& block_hash) const {
@@ -5,6 +5,7 @@
 
 #include "common/encoding_rlp.hpp"
 #include "common/encoding_solidity.hpp"
+#include "common/jsoncpp.hpp"
 #include "vote/pillar_vote.hpp"
 #include "vote/votes_bundle_rlp.hpp"
 
@@ -181,6 +182,18 @@ Json::Value PillarBlockData::getJson(bool include_signatures) const {
   return res;
 }
 
+SerializedPillarBlockData::SerializedPillarBlockData(const PillarBlockData& data)
+    : period(data.block_->getPeriod()),
+      json(data.getJson(false)),
+      json_with_signatures(data.getJson(true)),
+      json_str(std::make_shared<const std::string>(util::to_string(json))),
+      json_with_signatures_str(std::make_shared<const std::string>(util::to_string(json_with_signatures))) {
+  const auto block_rlp = data.block_->getRlp();
+  rlp = std::make_shared<const std::string>(block_rlp.begin(), block_rlp.end());
+  const auto data_rlp = data.getRlp();
+  rlp_with_signatures = std::make_shared<const std::string>(data_rlp.begin(), data_rlp.end());
+}
+
 RLP_FIELDS_DEFINE(CurrentPillarBlockDataDb, pillar_block, vote_counts)
 
 }  // namespace taraxa::pillar_chain
@@ -24,7 +24,8 @@ PillarChainManager::PillarChainManager(const FicusHardforkConfig& ficus_hf_confi
       current_pillar_block_{},
       current_pillar_block_vote_counts_{},
       pillar_votes_{},
-      mutex_{} {
+      mutex_{},
+      pillar_blocks_data_cache_(kPillarBlocksDataCacheSize, kPillarBlocksDataCacheSize / 10 + 1) {
   LOG_OBJECTS_CREATE("PILLAR_CHAIN");
 
   if (const auto vote = db_->getOwnPillarBlockVote(); vote) {
@@ -185,7 +186,11 @@ std::vector<std::shared_ptr<PillarVote>> PillarChainManager::finalizePillarBlock
     // Erase votes that are no longer needed
     pillar_votes_.eraseVotes(last_finalized_pillar_block_->getPeriod() + 1);
   }
-  pillar_block_finalized_emitter_.emit(PillarBlockData{current_pillar_block, pillar_votes});
+  // Serialized once here, every rpc request and subscription of the new pillar block is served from the cache
+  auto pillar_block_data = std::make_shared<const SerializedPillarBlockData>(
+      PillarBlockData{current_pillar_block, pillar_votes});
+  pillar_blocks_data_cache_.insert(pillar_block_data->period, pillar_block_data);
+  pillar_block_finalized_emitter_.emit(pillar_block_data);
 
   return pillar_votes;
 }
@@ -206,6 +211,87 @@ std::shared_ptr<PillarBlock> PillarChainManager::getLastFinalizedPillarBlock() c
   return last_finalized_pillar_block_;
 }
 
+std::shared_ptr<const SerializedPillarBlockData> PillarChainManager::getPillarBlockData(PbftPeriod period) const {
+  if (!kFicusHfConfig.isPillarBlockPeriod(period)) {
+    return {};
+  }
+  if (auto [data, found] = pillar_blocks_data_cache_.get(period); found) {
+    return data;
+  }
+
+  auto pillar_block = db_->getPillarBlock(period);
+  if (!pillar_block) {
+    return {};
+  }
+  // Votes of pillar block are saved in the next period data
+  const auto pillar_votes = db_->getPeriodPillarVotes(period + 1);
+  if (pillar_votes.empty()) {
+    return {};
+  }
+
+  auto data = std::make_shared<const SerializedPillarBlockData>(PillarBlockData{std::move(pillar_block), pillar_votes});
+  pillar_blocks_data_cache_.insert(period, data);
+  return data;
+}
+
+std::vector<std::shared_ptr<const SerializedPillarBlockData>> PillarChainManager::getPillarBlocksData(
+    PbftPeriod from, size_t count) const {
+  std::vector<std::shared_ptr<const SerializedPillarBlockData>> ret;
+  const auto last_finalized = getLastFinalizedPillarBlock();
+  if (!last_finalized || !count || from > last_finalized->getPeriod()) {
+    return ret;
+  }
+
+  const auto interval = kFicusHfConfig.pillar_blocks_interval;
+  auto period = std::max(from, kFicusHfConfig.firstPillarBlockPeriod());
+  period = (period + interval - 1) / interval * interval;
+  for (; period <= last_finalized->getPeriod() && ret.size() < count; period += interval) {
+    auto data = getPillarBlockData(period);
+    if (!data) {
+      break;
+    }
+    ret.push_back(std::move(data));
+  }
+  return ret;
+}
+
+bool PillarChainManager::verifyStateCheckpoint() const {
+  const auto pillar_block = getLastFinalizedPillarBlock();
+  if (!pillar_block) {
+    return true;
+  }
+
+  const auto period = pillar_block->getPeriod();
+  const auto header = final_chain_->blockHeader(period);
+  if (!header) {
+    // Light node may have pruned the header already
+    LOG(log_wr_) << "Unable to verify state checkpoint, missing block header " << period;
+    return true;
+  }
+  if (header->state_root != pillar_block->getStateRoot()) {
+    LOG(log_er_) << "State root " << header->state_root << " of block " << period << " differs from pillar block "
+                 << pillar_block->getHash() << " state root " << pillar_block->getStateRoot();
+    return false;
+  }
+
+  const auto votes = db_->getPeriodPillarVotes(period + 1);
+  if (votes.empty()) {
+    LOG(log_er_) << "No pillar votes certify pillar block " << pillar_block->getHash() << ", period " << period;
+    return false;
+  }
+  for (const auto& vote : votes) {
+    if (vote->getBlockHash() != pillar_block->getHash()) {
+      LOG(log_er_) << "Pillar vote " << vote->getHash() << " is for block " << vote->getBlockHash()
+                   << " instead of pillar block " << pillar_block->getHash();
+      return false;
+    }
+  }
+
+  LOG(log_nf_) << "State checkpoint verified against pillar block " << pillar_block->getHash() << ", period "
+               << period;
+  return true;
+}
+
 std::shared_ptr<PillarBlock> PillarChainManager::getCurrentPillarBlock() const {
   std::shared_lock<std::shared_mutex> lock(mutex_);
   return current_pillar_block_;
@@ -274,6 +360,10 @@ bool PillarChainManager::validatePillarVote(const std::shared_ptr<PillarVote> vo
   return true;
 }
 
+bool PillarChainManager::isPillarVoteVerified(const std::shared_ptr<PillarVote>& vote) const {
+  return pillar_votes_.voteExists(vote);
+}
+
 uint64_t PillarChainManager::addVerifiedPillarVote(const std::shared_ptr<PillarVote>& vote) {
   uint64_t validator_vote_count = 0;
   try {
@@ -362,65 +452,50 @@ std::optional<uint64_t> PillarChainManager::getPillarConsensusThreshold(PbftPeri
 std::vector<PillarBlock::ValidatorVoteCountChange> PillarChainManager::getOrderedValidatorsVoteCountsChanges(
     const std::vector<state_api::ValidatorVoteCount>& current_vote_counts,
     const std::vector<state_api::ValidatorVoteCount>& previous_pillar_block_vote_counts) {
-  auto transformToMap = [](const std::vector<state_api::ValidatorVoteCount>& vote_counts) {
-    std::unordered_map<addr_t, state_api::ValidatorVoteCount> vote_counts_map;
-    for (auto&& vote_count : vote_counts) {
-      vote_counts_map.emplace(vote_count.addr, vote_count);
+  // Views ordered by validators addresses, vote counts from dpos contract are usually ordered already
+  auto orderedByAddress = [](const std::vector<state_api::ValidatorVoteCount>& vote_counts) {
+    std::vector<const state_api::ValidatorVoteCount*> ordered;
+    ordered.reserve(vote_counts.size());
+    for (const auto& vote_count : vote_counts) {
+      ordered.push_back(&vote_count);
     }
-
-    return vote_counts_map;
+    const auto less = [](const auto* a, const auto* b) { return a->addr < b->addr; };
+    if (!std::is_sorted(ordered.begin(), ordered.end(), less)) {
+      std::sort(ordered.begin(), ordered.end(), less);
+    }
+    return ordered;
   };
 
   assert(!previous_pillar_block_vote_counts.empty());
 
-  auto current_vote_counts_map = transformToMap(current_vote_counts);
-  auto previous_vote_counts_map = transformToMap(previous_pillar_block_vote_counts);
-
-  // First create ordered map so the changes are ordered by validator addresses
-  std::map<addr_t, PillarBlock::ValidatorVoteCountChange> changes_map;
-  for (auto& current_vote_count : current_vote_counts_map) {
-    auto previous_vote_count = previous_vote_counts_map.find(current_vote_count.first);
-
-    // Previous vote counts does not contain validator address from current vote counts -> new vote count(delegator)
-    if (previous_vote_count == previous_vote_counts_map.end()) {
-      changes_map.emplace(
-          current_vote_count.second.addr,
-          PillarBlock::ValidatorVoteCountChange(current_vote_count.second.addr,
-                                                static_cast<int32_t>(current_vote_count.second.vote_count)));
-      continue;
-    }
+  const auto current = orderedByAddress(current_vote_counts);
+  const auto previous = orderedByAddress(previous_pillar_block_vote_counts);
 
-    // Previous vote counts contains validator address from current vote counts -> substitute the vote counts
-    if (const auto vote_count_change =
-            static_cast<int64_t>(current_vote_count.second.vote_count - previous_vote_count->second.vote_count);
-        vote_count_change != 0) {
-      changes_map.emplace(current_vote_count.first,
-                          PillarBlock::ValidatorVoteCountChange(current_vote_count.first, vote_count_change));
+  // Single merge pass over both ordered lists, so the changes are ordered by validators addresses as well
+  std::vector<PillarBlock::ValidatorVoteCountChange> changes;
+  changes.reserve(std::max(current.size(), previous.size()));
+  size_t current_idx = 0, previous_idx = 0;
+  while (current_idx < current.size() || previous_idx < previous.size()) {
+    if (previous_idx == previous.size() ||
+        (current_idx < current.size() && current[current_idx]->addr < previous[previous_idx]->addr)) {
+      // Previous vote counts does not contain validator address from current vote counts -> new vote count(delegator)
+      const auto& vote_count = *current[current_idx++];
+      changes.emplace_back(vote_count.addr, static_cast<int32_t>(vote_count.vote_count));
+    } else if (current_idx == current.size() || previous[previous_idx]->addr < current[current_idx]->addr) {
+      // Delegator who undelegated all of the tokens between current and previous pillar block -> negative change
+      const auto& vote_count = *previous[previous_idx++];
+      changes.emplace_back(vote_count.addr, -static_cast<int32_t>(vote_count.vote_count));
+    } else {
+      // Both vote counts contain validator address -> substitute the vote counts
+      const auto& vote_count = *current[current_idx++];
+      const auto& previous_vote_count = *previous[previous_idx++];
+      if (const auto vote_count_change = static_cast<int64_t>(vote_count.vote_count - previous_vote_count.vote_count);
+          vote_count_change != 0) {
+        changes.emplace_back(vote_count.addr, vote_count_change);
+      }
     }
-
-    // Delete item from previous_vote_counts - based on left vote counts we know which delegators undelegated all tokens
-    previous_vote_counts_map.erase(previous_vote_count);
-  }
-
-  // All previous vote counts that were not deleted are delegators who undelegated all of their tokens between current
-  // and previous pillar block. Add these vote counts as negative numbers into changes
-  for (auto& previous_vote_count_left : previous_vote_counts_map) {
-    auto vote_count_change = changes_map
-                                 .emplace(previous_vote_count_left.second.addr,
-                                          PillarBlock::ValidatorVoteCountChange(
-                                              previous_vote_count_left.second.addr,
-                                              static_cast<int32_t>(previous_vote_count_left.second.vote_count)))
-                                 .first;
-    vote_count_change->second.vote_count_change_ *= -1;
   }
 
-  // Transform ordered map of changes to vector
-  std::vector<PillarBlock::ValidatorVoteCountChange> changes;
-  changes.reserve(changes_map.size());
-  std::transform(std::make_move_iterator(changes_map.begin()), std::make_move_iterator(changes_map.end()),
-                 std::back_inserter(changes),
-                 [](auto&& vote_count_change) { return std::move(vote_count_change.second); });
-
   return changes;
 }
 
@@ -8,39 +8,49 @@ namespace taraxa::rewards {
 
 BlockStats::BlockStats(const PeriodData& block, uint32_t blocks_per_year, const std::vector<gas_t>& trxs_gas_used,
                        uint64_t dpos_vote_count, uint32_t committee_size, const bool aspen_dag_reward)
+    : BlockStats(block, blocks_per_year, dpos_vote_count, committee_size, aspen_dag_reward) {
+  setTransactionsFees(block.transactions, trxs_gas_used);
+}
+
+BlockStats::BlockStats(const PeriodData& block, uint32_t blocks_per_year, uint64_t dpos_vote_count,
+                       uint32_t committee_size, const bool aspen_dag_reward)
     : block_author_(block.pbft_blk->getBeneficiary()),
       blocks_per_year_(blocks_per_year),
       max_votes_weight_(std::min<uint64_t>(committee_size, dpos_vote_count)) {
-  initFeeByTrxHash(block.transactions, trxs_gas_used);
+  trx_position_by_hash_.reserve(block.transactions.size());
+  for (uint32_t i = 0; i < block.transactions.size(); ++i) {
+    trx_position_by_hash_.emplace(block.transactions[i]->getHash(), i);
+  }
   processStats(block, aspen_dag_reward);
+  trx_position_by_hash_.clear();
 }
 
 uint32_t BlockStats::getBlocksPerYear() const { return blocks_per_year_; }
 
-void BlockStats::initFeeByTrxHash(const SharedTransactions& transactions, const std::vector<gas_t>& trxs_gas_used) {
+void BlockStats::setTransactionsFees(const SharedTransactions& transactions, const std::vector<gas_t>& trxs_gas_used) {
   // assert(transactions.size() == trxs_gas_used.size());
 
-  for (uint32_t i = 0; i < transactions.size(); ++i) {
-    const auto& trx = transactions[i];
-    uint64_t gas_used = 0;
-    // if its not empty then we will add this to validator stats and distribute it
-    if (!trxs_gas_used.empty()) {
-      gas_used = trxs_gas_used[i];
+  // if its not empty then we will add this to validator stats and distribute it
+  if (!trxs_gas_used.empty()) {
+    for (const auto& [position, validator] : rewarded_transactions_) {
+      validators_stats_[validator].fees_rewards_ += transactions[position]->getGasPrice() * trxs_gas_used[position];
     }
-    fee_by_trx_hash_.emplace(trx->getHash(), trx->getGasPrice() * gas_used);
   }
+  rewarded_transactions_.clear();
 }
 
 bool BlockStats::addTransaction(const trx_hash_t& trx_hash, const addr_t& validator) {
-  auto itr = fee_by_trx_hash_.find(trx_hash);
-  if (itr == fee_by_trx_hash_.end()) {
-    // No fee record found for transaction means that transaction was processed before
+  auto itr = trx_position_by_hash_.find(trx_hash);
+  if (itr == trx_position_by_hash_.end()) {
+    // No record found for transaction means that transaction was processed before
     return false;
   }
 
-  validators_stats_[validator].fees_rewards_ += itr->second;
+  // Stats entry is created even if transaction fee is zero
+  validators_stats_[validator];
+  rewarded_transactions_.emplace_back(itr->second, validator);
 
-  fee_by_trx_hash_.erase(itr);
+  trx_position_by_hash_.erase(itr);
 
   return true;
 }
@@ -72,7 +82,7 @@ std::set<trx_hash_t> toTrxHashesSet(const SharedTransactions& transactions) {
 
 void BlockStats::processStats(const PeriodData& block, const bool aspen_dag_rewards) {
   // total unique transactions count should be always equal to transactions count in block
-  assert(fee_by_trx_hash_.size() == block.transactions.size());
+  assert(trx_position_by_hash_.size() == block.transactions.size());
 
   validators_stats_.reserve(std::max(block.dag_blocks.size(), block.previous_block_cert_votes.size()));
   if (aspen_dag_rewards) {
@@ -31,7 +31,7 @@ void Stats::clear(uint64_t current_period) {
   }
 }
 
-BlockStats Stats::getBlockStats(const PeriodData& blk, uint32_t blocks_per_year, const std::vector<gas_t>& trxs_fees) {
+BlockStats Stats::prepareBlockStats(const PeriodData& blk, uint32_t blocks_per_year) const {
   uint64_t dpos_vote_count = kCommitteeSize;
 
   // Block zero
@@ -39,18 +39,26 @@ BlockStats Stats::getBlockStats(const PeriodData& blk, uint32_t blocks_per_year,
     dpos_vote_count = dpos_eligible_total_vote_count_(blk.previous_block_cert_votes[0]->getPeriod() - 1);
   }
   if (blk.pbft_blk->getPeriod() < kHardforksConfig.magnolia_hf.block_num) {
-    return BlockStats{blk, blocks_per_year, {}, dpos_vote_count, kCommitteeSize};
+    return BlockStats{blk, blocks_per_year, dpos_vote_count, kCommitteeSize};
   }
 
   const auto aspen_hf_part_one = kHardforksConfig.isAspenHardforkPartOne(blk.pbft_blk->getPeriod());
-  return BlockStats{blk, blocks_per_year, trxs_fees, dpos_vote_count, kCommitteeSize, aspen_hf_part_one};
+  return BlockStats{blk, blocks_per_year, dpos_vote_count, kCommitteeSize, aspen_hf_part_one};
 }
 
 std::vector<BlockStats> Stats::processStats(const PeriodData& current_blk, uint32_t blocks_per_year,
                                             const std::vector<gas_t>& trxs_gas_used, Batch& write_batch) {
+  return processStats(current_blk, prepareBlockStats(current_blk, blocks_per_year), trxs_gas_used, write_batch);
+}
+
+std::vector<BlockStats> Stats::processStats(const PeriodData& current_blk, BlockStats&& block_stats,
+                                            const std::vector<gas_t>& trxs_gas_used, Batch& write_batch) {
   const auto current_period = current_blk.pbft_blk->getPeriod();
   const auto frequency = kHardforksConfig.getRewardsDistributionFrequency(current_period);
-  auto block_stats = getBlockStats(current_blk, blocks_per_year, trxs_gas_used);
+  // Fees are not rewarded before magnolia hardfork
+  if (current_period >= kHardforksConfig.magnolia_hf.block_num) {
+    block_stats.setTransactionsFees(current_blk.transactions, trxs_gas_used);
+  }
 
   // Distribute rewards every block
   if (frequency == 1) {
@@ -72,4 +72,17 @@ bool SlashingManager::submitDoubleVotingProof(const std::shared_ptr<PbftVote> &v
 
   return false;
 }
+
+void SlashingManager::postDoubleVotingProof(const std::shared_ptr<PbftVote> &vote_a,
+                                            const std::shared_ptr<PbftVote> &vote_b) {
+  if (!kConfig.report_malicious_behaviour) {
+    return;
+  }
+
+  proofs_executor_.post([weak_this = weak_from_this(), vote_a, vote_b] {
+    if (const auto slashing_manager = weak_this.lock()) {
+      slashing_manager->submitDoubleVotingProof(vote_a, vote_b);
+    }
+  });
+}
 }  // namespace taraxa
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "transaction/gas_estimations_cache.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+namespace taraxa {
+
+GasEstimationsCache::GasEstimationsCache(size_t max_size) : kMaxSize(std::max<size_t>(max_size, 1)) {}
+
+std::optional<state_api::ExecutionResult> GasEstimationsCache::get(const trx_hash_t &trx_hash,
+                                                                   PbftPeriod proposal_period) const {
+  std::shared_lock lock(mutex_);
+  const auto period_it = estimations_.find(proposal_period);
+  if (period_it == estimations_.end()) {
+    return {};
+  }
+  const auto it = period_it->second.find(trx_hash);
+  if (it == period_it->second.end()) {
+    return {};
+  }
+  return it->second;
+}
+
+void GasEstimationsCache::insert(const trx_hash_t &trx_hash, PbftPeriod proposal_period,
+                                 state_api::ExecutionResult result) {
+  std::unique_lock lock(mutex_);
+  if (!estimations_[proposal_period].insert_or_assign(trx_hash, std::move(result)).second) {
+    return;
+  }
+  ++size_;
+  while (size_ > kMaxSize) {
+    auto &oldest = estimations_.begin()->second;
+    oldest.erase(oldest.begin());
+    --size_;
+    if (oldest.empty()) {
+      estimations_.erase(estimations_.begin());
+    }
+  }
+}
+
+void GasEstimationsCache::periodFinalized(const SharedTransactions &finalized_trxs, PbftPeriod min_proposal_period) {
+  std::unique_lock lock(mutex_);
+  while (!estimations_.empty() && estimations_.begin()->first < min_proposal_period) {
+    size_ -= estimations_.begin()->second.size();
+    estimations_.erase(estimations_.begin());
+  }
+  for (auto it = estimations_.begin(); it != estimations_.end();) {
+    for (const auto &trx : finalized_trxs) {
+      size_ -= it->second.erase(trx->getHash());
+    }
+    it = it->second.empty() ? estimations_.erase(it) : std::next(it);
+  }
+}
+
+size_t GasEstimationsCache::size() const {
+  std::shared_lock lock(mutex_);
+  return size_;
+}
+
+}  // namespace taraxa
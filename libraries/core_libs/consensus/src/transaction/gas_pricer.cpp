@@ -1,10 +1,23 @@
 #include "transaction/gas_pricer.hpp"
 
+#include <algorithm>
+
 #include "storage/storage.hpp"
 #include "transaction/transaction_manager.hpp"
 
 namespace taraxa {
 
+namespace {
+
+u256 minGasPrice(const SharedTransactions& trxs) {
+  if (trxs.empty()) return 0;
+  return (*std::min_element(trxs.begin(), trxs.end(),
+                            [](const auto& t1, const auto& t2) { return t1->getGasPrice() < t2->getGasPrice(); }))
+      ->getGasPrice();
+}
+
+}  // namespace
+
 GasPricer::GasPricer(const GenesisConfig& config, bool is_light_node, bool is_blocks_gas_pricer,
                      std::shared_ptr<TransactionManager> trx_mgr, std::shared_ptr<DbStorage> db)
     : kPercentile(config.gas_price.percentile),
@@ -13,10 +26,11 @@ GasPricer::GasPricer(const GenesisConfig& config, bool is_light_node, bool is_bl
       latest_price_(kMinimumPrice),
       price_list_(config.gas_price.blocks),
       kBlocksGasPricer(is_blocks_gas_pricer),
-      trx_mgr_(std::move(trx_mgr)) {
+      trx_mgr_(std::move(trx_mgr)),
+      db_(std::move(db)) {
   assert(kPercentile <= 100);
-  if (db) {
-    init_daemon_ = std::make_unique<std::thread>([this, db_ = std::move(db)]() { init(db_); });
+  if (db_) {
+    init_daemon_ = std::make_unique<std::thread>([this]() { init(db_); });
   }
 }
 
@@ -38,65 +52,127 @@ void GasPricer::init(const std::shared_ptr<DbStorage>& db) {
   const auto last_blk_num =
       db->lookup_int<EthBlockNumber>(DBMetaKeys::LAST_NUMBER, DbStorage::Columns::final_chain_meta);
   if (!last_blk_num || *last_blk_num == 0) return;
-  auto block_num = *last_blk_num;
 
+  // Window is read under the lock, so blocks finalized in the meantime are not added twice
   std::unique_lock lock(mutex_);
+  price_list_.clear();
+  lower_prices_.clear();
+  upper_prices_.clear();
+
+  EthBlockNumber window_blk_num = 0;
+  std::vector<u256> window_prices;
+  if (const auto window = db->lookup(DBMetaKeys::GAS_PRICES_WINDOW, DbStorage::Columns::final_chain_meta);
+      !window.empty()) {
+    const dev::RLP rlp(window);
+    window_blk_num = rlp[0].toInt<EthBlockNumber>();
+    window_prices = rlp[1].toVector<u256>();
+  }
 
-  while (price_list_.capacity() != price_list_.size() && block_num) {
-    auto trxs = db->getPeriodTransactions(block_num);
-    block_num--;
+  if (window_blk_num) {
+    // Only periods finalized after the window was saved need to be decoded
+    for (const auto& price : window_prices) {
+      addPrice(price);
+    }
+    for (auto block_num = window_blk_num + 1; block_num <= *last_blk_num; ++block_num) {
+      const auto trxs = db->getPeriodTransactions(block_num);
+      // Light node
+      if (!trxs) break;
+      if (const auto price = minGasPrice(*trxs)) {
+        addPrice(price);
+      }
+    }
+  } else {
+    // Walk back until the window is full, prices are collected from the newest one
+    auto block_num = *last_blk_num;
+    std::vector<u256> prices;
+    while (prices.size() < price_list_.capacity() && block_num) {
+      auto trxs = db->getPeriodTransactions(block_num);
+      block_num--;
+
+      assert(kIsLightNode || trxs);
+
+      // Light node
+      if (kIsLightNode && !trxs) {
+        break;
+      }
+
+      if (const auto price = minGasPrice(*trxs)) {
+        prices.push_back(price);
+      }
+    }
+    for (auto it = prices.rbegin(); it != prices.rend(); ++it) {
+      addPrice(*it);
+    }
+  }
 
-    assert(kIsLightNode || trxs);
+  updateLatestPrice();
+}
 
-    // Light node
-    if (kIsLightNode && !trxs) {
-      break;
-    }
+void GasPricer::update(const SharedTransactions& trxs, EthBlockNumber block_number) {
+  if (!kBlocksGasPricer || trxs.empty()) return;
 
-    // Empty block
-    if (!trxs->size()) {
-      continue;
+  if (const auto price = minGasPrice(trxs)) {
+    bytes window;
+    {
+      std::unique_lock lock(mutex_);
+      addPrice(price);
+      updateLatestPrice();
+      // Replica follows window saved by its primary
+      if (db_ && block_number && !db_->isSecondary()) {
+        window = windowRlp(block_number);
+      }
     }
-
-    if (const auto min_trx =
-            *std::min_element(trxs->begin(), trxs->end(),
-                              [](const auto& t1, const auto& t2) { return t1->getGasPrice() < t2->getGasPrice(); });
-        min_trx->getGasPrice()) {
-      price_list_.push_front(min_trx->getGasPrice());
+    if (!window.empty()) {
+      db_->insert(DbStorage::Columns::final_chain_meta, DBMetaKeys::GAS_PRICES_WINDOW, window);
     }
   }
+}
 
-  if (price_list_.empty()) return;
+void GasPricer::addPrice(const u256& price) {
+  if (!price_list_.capacity()) return;
 
-  std::vector<u256> sorted_prices;
-  sorted_prices.reserve(price_list_.size());
-  std::copy(price_list_.begin(), price_list_.end(), std::back_inserter(sorted_prices));
-  std::sort(sorted_prices.begin(), sorted_prices.end());
+  if (price_list_.full()) {
+    const auto& evicted = price_list_.front();
+    if (!lower_prices_.empty() && evicted <= *lower_prices_.rbegin()) {
+      lower_prices_.erase(lower_prices_.find(evicted));
+    } else {
+      upper_prices_.erase(upper_prices_.find(evicted));
+    }
+  }
+  price_list_.push_back(price);
 
-  if (auto new_price = sorted_prices[(sorted_prices.size() - 1) * kPercentile / 100]) {
-    latest_price_ = std::move(new_price);
+  if (lower_prices_.empty() || price <= *lower_prices_.rbegin()) {
+    lower_prices_.insert(price);
+  } else {
+    upper_prices_.insert(price);
   }
 }
 
-void GasPricer::update(const SharedTransactions& trxs) {
-  if (!kBlocksGasPricer || trxs.empty()) return;
+void GasPricer::updateLatestPrice() {
+  if (price_list_.empty()) return;
 
-  if (const auto min_trx =
-          *std::min_element(trxs.begin(), trxs.end(),
-                            [](const auto& t1, const auto& t2) { return t1->getGasPrice() < t2->getGasPrice(); });
-      min_trx->getGasPrice()) {
-    std::unique_lock lock(mutex_);
-    price_list_.push_back(min_trx->getGasPrice());
+  // Index of the percentile price in sorted window
+  const auto lower_size = (price_list_.size() - 1) * kPercentile / 100 + 1;
+  while (lower_prices_.size() > lower_size) {
+    upper_prices_.insert(lower_prices_.extract(std::prev(lower_prices_.end())));
+  }
+  while (lower_prices_.size() < lower_size) {
+    lower_prices_.insert(upper_prices_.extract(upper_prices_.begin()));
+  }
 
-    std::vector<u256> sorted_prices;
-    sorted_prices.reserve(price_list_.size());
-    std::copy(price_list_.begin(), price_list_.end(), std::back_inserter(sorted_prices));
-    std::sort(sorted_prices.begin(), sorted_prices.end());
+  if (const auto& new_price = *lower_prices_.rbegin()) {
+    latest_price_ = new_price;
+  }
+}
 
-    if (auto new_price = sorted_prices[(sorted_prices.size() - 1) * kPercentile / 100]) {
-      latest_price_ = std::move(new_price);
-    }
+bytes GasPricer::windowRlp(EthBlockNumber block_number) const {
+  dev::RLPStream s(2);
+  s << block_number;
+  s.appendList(price_list_.size());
+  for (const auto& price : price_list_) {
+    s << price;
   }
+  return s.invalidate();
 }
 
-}  // namespace taraxa
\ No newline at end of file
+}  // namespace taraxa
@@ -1,7 +1,9 @@
 #include "transaction/transaction_manager.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
@@ -12,15 +14,28 @@
 #include "transaction/transaction.hpp"
 
 namespace taraxa {
+
+namespace {
+
+state_api::EVMTransaction toEVMTransaction(const Transaction &trx) {
+  return state_api::EVMTransaction{
+      trx.getSender(), trx.getGasPrice(), trx.getReceiver(), trx.getNonce(),
+      trx.getValue(),  trx.getGas(),      trx.getData(),
+  };
+}
+
+}  // namespace
+
 TransactionManager::TransactionManager(const FullNodeConfig &conf, std::shared_ptr<DbStorage> db,
                                        std::shared_ptr<final_chain::FinalChain> final_chain, addr_t node_addr)
     : kConf(conf),
-      transactions_pool_(final_chain, kConf.transactions_pool_size),
-      estimations_cache_(kConf.transactions_pool_size / 10, kConf.transactions_pool_size / 100),
+      transactions_pool_(final_chain, kConf.transactions_pool_size, db),
+      estimations_cache_(kConf.transactions_pool_size / 10),
       kDagBlockGasLimit(kConf.genesis.dag.gas_limit),
       db_(std::move(db)),
       final_chain_(std::move(final_chain)),
-      estimation_thread_pool_(std::thread::hardware_concurrency() / 2) {
+      estimation_thread_pool_(std::thread::hardware_concurrency() / 2),
+      kSenderRecoveryThreads(std::max(1u, std::thread::hardware_concurrency() / 2)) {
   LOG_OBJECTS_CREATE("TRXMGR");
   {
     std::unique_lock transactions_lock(transactions_mutex_);
@@ -29,22 +44,19 @@ TransactionManager::TransactionManager(const FullNodeConfig &conf, std::shared_p
 }
 
 uint64_t TransactionManager::estimateTransactions(const SharedTransactions &trxs, PbftPeriod proposal_period) {
-  std::atomic<uint64_t> total_gas = 0;
-  std::vector<std::future<void>> futures;
-  futures.reserve(trxs.size());
-  for (const auto &trx : trxs) {
-    if (trx->getGas() <= kEstimateGasLimit) {
-      total_gas += trx->getGas();
-    } else {
-      futures.emplace_back(
-          estimation_thread_pool_.post([&]() { total_gas += estimateTransactionGas(trx, proposal_period).gas_used; }));
-    }
-  }
-  for (auto &future : futures) {
-    future.get();
+  uint64_t total_gas = 0;
+  for (const auto &estimation : estimateTransactionsGas(trxs, proposal_period)) {
+    total_gas += estimation.gas_used;
   }
+  return total_gas;
+}
 
-  return total_gas.load();
+void TransactionManager::recoverSenders(const SharedTransactions &trxs) {
+  if (trxs.size() < kMinParallelSenderRecovery) {
+    return;
+  }
+  // Invalid signature is cached as well and reported by verifyTransaction
+  Transaction::recoverSenders(trxs, kSenderRecoveryThreads);
 }
 
 state_api::ExecutionResult TransactionManager::estimateTransactionGas(std::shared_ptr<Transaction> trx,
@@ -55,24 +67,64 @@ state_api::ExecutionResult TransactionManager::estimateTransactionGas(std::share
     return result;
   }
 
-  dev::RLPStream hash_rlp(2);
-  hash_rlp << trx->getHash();
-  hash_rlp << proposal_period;
-  const auto hash = dev::sha3(hash_rlp.invalidate());
+  if (auto cached_estimation = estimations_cache_.get(trx->getHash(), proposal_period)) {
+    return std::move(*cached_estimation);
+  }
+
+  auto result = final_chain_->call(toEVMTransaction(*trx), proposal_period);
+  estimations_cache_.insert(trx->getHash(), proposal_period, result);
 
-  if (const auto [cached_estimation, found] = estimations_cache_.get(hash); found) {
-    return cached_estimation;
+  return result;
+}
+
+std::vector<state_api::ExecutionResult> TransactionManager::estimateTransactionsGas(const SharedTransactions &trxs,
+                                                                                    PbftPeriod proposal_period) {
+  std::vector<state_api::ExecutionResult> results(trxs.size());
+  // Indexes of transactions which need to be dry run
+  std::vector<size_t> to_estimate;
+  for (size_t i = 0; i < trxs.size(); ++i) {
+    if (trxs[i]->getGas() <= kEstimateGasLimit) {
+      results[i].gas_used = trxs[i]->getGas();
+      continue;
+    }
+
+    if (auto cached_estimation = estimations_cache_.get(trxs[i]->getHash(), proposal_period)) {
+      results[i] = std::move(*cached_estimation);
+    } else {
+      to_estimate.emplace_back(i);
+    }
   }
 
-  auto evm_trx = state_api::EVMTransaction{
-      trx->getSender(), trx->getGasPrice(), trx->getReceiver(), trx->getNonce(),
-      trx->getValue(),  trx->getGas(),      trx->getData(),
-  };
+  if (to_estimate.empty()) {
+    return results;
+  }
 
-  auto result = final_chain_->call(evm_trx, proposal_period);
-  estimations_cache_.insert(hash, result);
+  const size_t chunks_count = std::clamp<size_t>(to_estimate.size() / kMinParallelEstimations, 1,
+                                                 std::max<size_t>(1, estimation_thread_pool_.capacity()));
+  const size_t chunk_size = (to_estimate.size() + chunks_count - 1) / chunks_count;
+  std::vector<std::future<void>> futures;
+  futures.reserve(chunks_count);
+  for (size_t begin = 0; begin < to_estimate.size(); begin += chunk_size) {
+    const auto end = std::min(begin + chunk_size, to_estimate.size());
+    futures.emplace_back(estimation_thread_pool_.post([&, begin, end]() {
+      std::vector<state_api::EVMTransaction> evm_trxs;
+      evm_trxs.reserve(end - begin);
+      for (size_t i = begin; i < end; ++i) {
+        evm_trxs.emplace_back(toEVMTransaction(*trxs[to_estimate[i]]));
+      }
 
-  return result;
+      auto chunk_results = final_chain_->callBatch(evm_trxs, proposal_period);
+      for (size_t i = begin; i < end; ++i) {
+        estimations_cache_.insert(trxs[to_estimate[i]]->getHash(), proposal_period, chunk_results[i - begin]);
+        results[to_estimate[i]] = std::move(chunk_results[i - begin]);
+      }
+    }));
+  }
+  for (auto &future : futures) {
+    future.get();
+  }
+
+  return results;
 }
 
 std::pair<bool, std::string> TransactionManager::verifyTransaction(const std::shared_ptr<Transaction> &trx) const {
@@ -86,13 +138,13 @@ std::pair<bool, std::string> TransactionManager::verifyTransaction(const std::sh
             "chain_id mismatch " + std::to_string(trx->getChainID()) + " " + std::to_string(kConf.genesis.chain_id)};
   }
 
-  const int64_t block_num = final_chain_->lastBlockNumber();
+  const auto hardfork_rules = final_chain_->lastBlockHardforkRules();
   // Ensure the transaction doesn't exceed the current block limit gas.
   if (kConf.genesis.state.hardforks.soleirolia_hf.trx_max_gas_limit < trx->getGas()) {
     return {false, "invalid gas"};
   }
 
-  if (kConf.genesis.state.hardforks.isOnCornusHardfork(block_num)) {
+  if (hardfork_rules->cornus) {
     if (!trx->intrinsicGasCovered()) {
       return {false, "intrinsic gas too low"};
     }
@@ -142,61 +194,56 @@ std::pair<bool, std::string> TransactionManager::insertTransaction(const std::sh
 
 TransactionStatus TransactionManager::insertValidatedTransaction(std::shared_ptr<Transaction> &&tx,
                                                                  bool insert_non_proposable) {
-  const auto trx_hash = tx->getHash();
-
-  // This lock synchronizes inserting and removing transactions from transactions memory pool.
-  // It is very important to lock transaction pool checking to be
-  // protected from new DAG block and Period data transactions insertions.
-  std::unique_lock transactions_lock(transactions_mutex_);
-
-  if (nonfinalized_transactions_in_dag_.contains(trx_hash)) {
-    return TransactionStatus::Known;
-  }
-
-  if (recently_finalized_transactions_.contains(trx_hash)) {
-    return TransactionStatus::Known;
-  }
-
-  const auto account = final_chain_->getAccount(tx->getSender());
-  bool proposable = true;
+  SharedTransactions txs{std::move(tx)};
+  return insertValidatedTransactions(std::move(txs), insert_non_proposable).front();
+}
 
-  if (account.has_value()) {
-    // Ensure the transaction adheres to nonce ordering
-    if (account->nonce > tx->getNonce()) {
-      if (!insert_non_proposable) {
-        return TransactionStatus::Known;
-      }
-      proposable = false;
+std::vector<TransactionStatus> TransactionManager::insertValidatedTransactions(SharedTransactions &&txs,
+                                                                               bool insert_non_proposable) {
+  std::vector<TransactionStatus> statuses(txs.size(), TransactionStatus::Known);
+
+  // Stateless and account checks are done before the lock, single account lookup per sender
+  std::unordered_map<addr_t, std::optional<state_api::Account>> accounts;
+  std::vector<bool> proposable(txs.size(), true);
+  std::vector<bool> rejected(txs.size(), false);
+  for (size_t i = 0; i < txs.size(); ++i) {
+    const auto &tx = txs[i];
+    auto account_it = accounts.find(tx->getSender());
+    if (account_it == accounts.end()) {
+      account_it = accounts.emplace(tx->getSender(), final_chain_->getAccount(tx->getSender())).first;
     }
+    const auto &account = account_it->second;
 
-    // Transactor should have enough funds to cover the costs
+    // Ensure the transaction adheres to nonce ordering and transactor has enough funds to cover the costs
     // cost == V + GP * GL
-    if (account->balance < tx->getCost()) {
+    if (!account.has_value() || account->nonce > tx->getNonce() || account->balance < tx->getCost() ||
+        kConf.propose_dag_gas_limit < tx->getGas()) {
       if (!insert_non_proposable) {
-        return TransactionStatus::Known;
+        rejected[i] = true;
       }
-      proposable = false;
+      proposable[i] = false;
     }
-  } else {
-    if (!insert_non_proposable) {
-      return TransactionStatus::Known;
-    }
-    proposable = false;
   }
+  const auto last_block_number = final_chain_->lastBlockNumber();
 
-  if (kConf.propose_dag_gas_limit < tx->getGas()) {
-    if (!insert_non_proposable) {
-      return TransactionStatus::Known;
+  // This lock synchronizes inserting and removing transactions from transactions memory pool.
+  // It is very important to lock transaction pool checking to be
+  // protected from new DAG block and Period data transactions insertions.
+  std::unique_lock transactions_lock(transactions_mutex_);
+  for (size_t i = 0; i < txs.size(); ++i) {
+    const auto trx_hash = txs[i]->getHash();
+    if (rejected[i] || nonfinalized_transactions_in_dag_.contains(trx_hash) ||
+        recently_finalized_transactions_.contains(trx_hash)) {
+      continue;
     }
-    proposable = false;
-  }
 
-  const auto last_block_number = final_chain_->lastBlockNumber();
-  LOG(log_dg_) << "Transaction " << trx_hash << " inserted in trx pool";
-  if (proposable) {
-    transaction_added_.emit(trx_hash);
+    LOG(log_dg_) << "Transaction " << trx_hash << " inserted in trx pool";
+    if (proposable[i]) {
+      transaction_added_.emit(trx_hash);
+    }
+    statuses[i] = transactions_pool_.insert(std::move(txs[i]), proposable[i], last_block_number);
   }
-  return transactions_pool_.insert(std::move(tx), proposable, last_block_number);
+  return statuses;
 }
 
 unsigned long TransactionManager::getTransactionCount() const {
@@ -273,16 +320,36 @@ void TransactionManager::saveTransactionsFromDagBlock(SharedTransactions const &
 }
 
 void TransactionManager::recoverNonfinalizedTransactions() {
+  // Senders of transactions that were non finalized at clean shutdown, valid only if no block was finalized since
+  std::unordered_map<trx_hash_t, addr_t> known_senders;
+  if (const auto data = db_->takeStartupSnapshot(StartupSnapshotKey::Transactions);
+      final_chain_ && !data.empty()) {
+    const dev::RLP rlp(data);
+    if (rlp[0].toInt<EthBlockNumber>() == final_chain_->lastBlockNumber()) {
+      known_senders.reserve(rlp[1].itemCount());
+      for (const auto trx : rlp[1]) {
+        known_senders.emplace(trx[0].toHash<trx_hash_t>(), trx[1].toHash<addr_t>());
+      }
+    }
+  }
+
   std::unique_lock transactions_lock(transactions_mutex_);
   // On restart populate nonfinalized_transactions_in_dag_ structure from db
   auto trxs = db_->getAllNonfinalizedTransactions();
+  SharedTransactions trxs_to_check;
   vec_trx_t trx_hashes;
-  trx_hashes.reserve(trxs.size());
-  std::transform(trxs.begin(), trxs.end(), std::back_inserter(trx_hashes),
-                 [](std::shared_ptr<Transaction> const &t) { return t->getHash(); });
+  for (auto &trx : trxs) {
+    if (const auto sender = known_senders.find(trx->getHash()); sender != known_senders.end()) {
+      trx->restoreSender(sender->second);
+      nonfinalized_transactions_in_dag_.emplace(trx->getHash(), std::move(trx));
+    } else {
+      trx_hashes.push_back(trx->getHash());
+      trxs_to_check.push_back(std::move(trx));
+    }
+  }
   auto trx_finalized = db_->transactionsFinalized(trx_hashes);
   auto write_batch = db_->createWriteBatch();
-  for (uint64_t i = 0; i < trxs.size(); i++) {
+  for (uint64_t i = 0; i < trxs_to_check.size(); i++) {
     auto const &trx_hash = trx_hashes[i];
     if (trx_finalized[i]) {
       // TODO: This section where transactions are deleted is only to recover from a bug where non-finalized
@@ -291,18 +358,39 @@ void TransactionManager::recoverNonfinalizedTransactions() {
       db_->removeTransactionToBatch(trx_hash, write_batch);
     } else {
       // Cache sender now by calling getSender since getting sender later on proposing blocks can affect performance
-      trxs[i]->getSender();
-      nonfinalized_transactions_in_dag_.emplace(trx_hash, std::move(trxs[i]));
+      trxs_to_check[i]->getSender();
+      nonfinalized_transactions_in_dag_.emplace(trx_hash, std::move(trxs_to_check[i]));
     }
   }
   db_->commitWriteBatch(write_batch);
 }
 
+void TransactionManager::saveStartupSnapshot() const {
+  std::shared_lock transactions_lock(transactions_mutex_);
+  dev::RLPStream s(2);
+  s << final_chain_->lastBlockNumber();
+  s.appendList(nonfinalized_transactions_in_dag_.size());
+  for (const auto &[hash, trx] : nonfinalized_transactions_in_dag_) {
+    s.appendList(2);
+    s << hash << trx->getSender();
+  }
+  db_->saveStartupSnapshot(StartupSnapshotKey::Transactions, s.invalidate());
+}
+
+std::optional<trx_nonce_t> TransactionManager::getPendingNonce(const addr_t &sender) const {
+  return transactions_pool_.getPendingNonce(sender);
+}
+
 size_t TransactionManager::getTransactionPoolSize() const {
   std::shared_lock transactions_lock(transactions_mutex_);
   return transactions_pool_.size();
 }
 
+size_t TransactionManager::getTransactionPoolMemoryUsage() const {
+  std::shared_lock transactions_lock(transactions_mutex_);
+  return transactions_pool_.memoryUsage();
+}
+
 bool TransactionManager::nonProposableTransactionsOverTheLimit() const {
   std::shared_lock transactions_lock(transactions_mutex_);
   return transactions_pool_.nonProposableTransactionsOverTheLimit();
@@ -385,13 +473,22 @@ std::pair<SharedTransactions, std::vector<uint64_t>> TransactionManager::packTrx
   std::vector<uint64_t> estimations;
   SharedTransactions trxs_to_propose;
   uint64_t total_weight = 0;
+  // Estimations are done in batches ahead of the packing loop, transactions which end up skipped stay cached
+  std::vector<state_api::ExecutionResult> batch_estimations;
+  uint64_t batch_begin = 0;
   for (uint64_t i = 0; i < trxs.size(); i++) {
     // trx too big to fit, skip it
     if (total_weight + trxs[i]->getGas() > weight_limit) {
       continue;
     }
 
-    auto estimate = estimateTransactionGas(trxs[i], proposal_period);
+    if (i >= batch_begin + batch_estimations.size()) {
+      batch_begin = i;
+      const auto batch_end = std::min<uint64_t>(trxs.size(), i + kPackEstimationBatchSize);
+      batch_estimations =
+          estimateTransactionsGas(SharedTransactions(trxs.begin() + i, trxs.begin() + batch_end), proposal_period);
+    }
+    const auto &estimate = batch_estimations[i - batch_begin];
     if (estimate.gas_used < kMinTxGas) {
       LOG(log_er_) << "Transaction " << trxs[i]->getHash() << " has invalid estimation: " << estimate.gas_used;
       std::unique_lock transactions_lock(transactions_mutex_);
@@ -417,6 +514,11 @@ std::vector<SharedTransactions> TransactionManager::getAllPoolTrxs() {
   return transactions_pool_.getAllTransactions();
 }
 
+std::pair<std::vector<SharedTransactions>, uint64_t> TransactionManager::getPoolTrxsInsertedAfter(uint64_t sequence) {
+  std::shared_lock transactions_lock(transactions_mutex_);
+  return transactions_pool_.getTransactionsInsertedAfter(sequence);
+}
+
 void TransactionManager::initializeRecentlyFinalizedTransactions(const PeriodData &period_data) {
   std::unique_lock transactions_lock(transactions_mutex_);
   for (auto const &trx : period_data.transactions) {
@@ -454,9 +556,6 @@ void TransactionManager::updateFinalizedTransactionsStatus(PeriodData const &per
       } else {
         LOG(log_dg_) << "Transaction " << hash << " removed from nonfinalized transactions";
       }
-      if (transactions_pool_.erase(trx)) {
-        LOG(log_dg_) << "Transaction " << hash << " removed from transactions_pool_";
-      }
     }
     db_->saveStatusField(StatusDbField::TrxCount, trx_count_);
   }
@@ -464,9 +563,28 @@ void TransactionManager::updateFinalizedTransactionsStatus(PeriodData const &per
   // Sometimes transactions which nonce was skipped and will never be included in a block might remain in the
   // transaction pool, remove them each 100 block
   const uint32_t transaction_purge_interval = 100;
-  if (period_data.pbft_blk->getPeriod() % transaction_purge_interval == 0) {
-    transactions_pool_.purge();
-  }
+  const bool purge = period_data.pbft_blk->getPeriod() % transaction_purge_interval == 0;
+
+  // Pool cleanup is not needed to push the block, it runs on a single thread in order of finalization without holding
+  // the dag mutex. Finalized transactions are marked known above, so they can not get into the pool again meanwhile
+  const auto period = period_data.pbft_blk->getPeriod();
+  const auto min_proposal_period = period > kEstimationsCachePeriods ? period - kEstimationsCachePeriods : 0;
+  if (period_data.transactions.empty() && !purge) {
+    estimations_cache_.periodFinalized({}, min_proposal_period);
+    return;
+  }
+  pool_cleanup_thread_.post([this, transactions = period_data.transactions, purge, min_proposal_period] {
+    estimations_cache_.periodFinalized(transactions, min_proposal_period);
+    std::unique_lock transactions_lock(transactions_mutex_);
+    for (auto const &trx : transactions) {
+      if (transactions_pool_.erase(trx)) {
+        LOG(log_dg_) << "Transaction " << trx->getHash() << " removed from transactions_pool_";
+      }
+    }
+    if (purge) {
+      transactions_pool_.purge();
+    }
+  });
 }
 
 void TransactionManager::removeNonFinalizedTransactions(std::unordered_set<trx_hash_t> &&transactions) {
@@ -1,33 +1,70 @@
 #include "transaction/transaction_queue.hpp"
 
+#include "storage/storage.hpp"
 #include "transaction/transaction_manager.hpp"
 
 namespace taraxa {
 
-TransactionQueue::TransactionQueue(std::shared_ptr<final_chain::FinalChain> final_chain, size_t max_size)
+TransactionQueue::TransactionQueue(std::shared_ptr<final_chain::FinalChain> final_chain, size_t max_size,
+                                   std::shared_ptr<DbStorage> db)
     : known_txs_(max_size * 2, max_size / 5),
       kNonProposableTransactionsMaxSize(max_size * kNonProposableTransactionsLimitPercentage / 100),
       kMaxSize(max_size),
       kMaxDataSize(max_size * 1024),  // Data limit is max_size kB
+      kNonProposableMaxDataSize(kMaxDataSize * kNonProposableTransactionsLimitPercentage / 100),
       kMaxSingleAccountTransactionsSize(max_size * kSingleAccountTransactionsLimitPercentage / 100),
-      final_chain_(final_chain) {
+      final_chain_(final_chain),
+      db_(std::move(db)) {
   queue_transactions_.reserve(max_size);
+  if (db_) {
+    // Pool is not persisted, anything spilled by the previous run is stale
+    db_->deleteColumnData(DbStorage::Columns::pool_spilled_transactions);
+  }
 }
 
 size_t TransactionQueue::size() const { return queue_transactions_.size(); }
 
+size_t TransactionQueue::memoryUsage() const {
+  const auto in_memory_count = queue_transactions_.size() + non_proposable_transactions_.size() -
+                               spilled_transactions_count_;
+  return data_size_ + in_memory_count * sizeof(Transaction) +
+         queue_transactions_.size() * (sizeof(trx_hash_t) + sizeof(SharedTransaction) + util::kContainerNodeOverhead) +
+         non_proposable_transactions_.size() *
+             (sizeof(trx_hash_t) + sizeof(TrxId) + sizeof(NonProposableTransaction) +
+              2 * util::kContainerNodeOverhead) +
+         insertion_log_.size() * sizeof(decltype(insertion_log_)::value_type) + trx_ids_.memoryUsage() +
+         known_txs_.memoryUsage();
+}
+
 void TransactionQueue::addTransaction(const SharedTransaction &transaction, bool proposable,
                                       uint64_t last_block_number) {
   if (proposable) {
     if (queue_transactions_.emplace(transaction->getHash(), transaction).second) {
-      data_size_ += transaction->getData().size();
+      data_size_ += transaction->rlp().size();
       queue_transactions_gas_prices_[transaction->getGasPrice()] += transaction->getGas();
+      insertion_log_.emplace_back(++last_insertion_sequence_, trx_ids_.acquire(transaction->getHash()));
+      if (insertion_log_.size() > kMaxSize * kInsertionLogMaxSizeMultiplier) {
+        trx_ids_.release(insertion_log_.front().second);
+        insertion_log_.pop_front();
+      }
     }
   } else {
-    if (non_proposable_transactions_
-            .emplace(transaction->getHash(), std::pair<uint64_t, SharedTransaction>{last_block_number, transaction})
-            .second) {
-      data_size_ += transaction->getData().size();
+    const auto [it, inserted] = non_proposable_transactions_.emplace(
+        transaction->getHash(), NonProposableTransaction{last_block_number, transaction});
+    if (!inserted) {
+      return;
+    }
+    non_proposable_transactions_by_block_[last_block_number].insert(trx_ids_.acquire(it->first));
+    const auto trx_size = transaction->rlp().size();
+    const auto in_memory_count = non_proposable_transactions_.size() - spilled_transactions_count_;
+    if (db_ && (non_proposable_data_size_ + trx_size > kNonProposableMaxDataSize ||
+                in_memory_count > kNonProposableTransactionsMaxSize)) {
+      db_->savePoolSpilledTransaction(*transaction);
+      it->second.transaction = nullptr;
+      spilled_transactions_count_++;
+    } else {
+      data_size_ += trx_size;
+      non_proposable_data_size_ += trx_size;
     }
   }
 }
@@ -35,7 +72,7 @@ void TransactionQueue::addTransaction(const SharedTransaction &transaction, bool
 bool TransactionQueue::removeTransaction(const SharedTransaction &transaction, bool proposable) {
   if (proposable) {
     if (queue_transactions_.erase(transaction->getHash()) > 0) {
-      data_size_ -= transaction->getData().size();
+      data_size_ -= transaction->rlp().size();
       auto &gas_price_entry = queue_transactions_gas_prices_[transaction->getGasPrice()];
       gas_price_entry -= transaction->getGas();
       if (gas_price_entry == 0) {
@@ -44,18 +81,34 @@ bool TransactionQueue::removeTransaction(const SharedTransaction &transaction, b
       return true;
     }
   } else {
-    if (non_proposable_transactions_.erase(transaction->getHash()) > 0) {
-      data_size_ -= transaction->getData().size();
+    if (const auto it = non_proposable_transactions_.find(transaction->getHash());
+        it != non_proposable_transactions_.end()) {
+      removeTransaction(it);
       return true;
     }
   }
   return false;
 }
 
-std::unordered_map<taraxa::trx_hash_t, std::pair<uint64_t, taraxa::SharedTransaction>>::iterator
-TransactionQueue::removeTransaction(
-    std::unordered_map<taraxa::trx_hash_t, std::pair<uint64_t, taraxa::SharedTransaction>>::iterator it) {
-  data_size_ -= it->second.second->getData().size();
+TransactionQueue::NonProposableTransactions::iterator TransactionQueue::removeTransaction(
+    NonProposableTransactions::iterator it) {
+  if (it->second.transaction) {
+    const auto trx_size = it->second.transaction->rlp().size();
+    data_size_ -= trx_size;
+    non_proposable_data_size_ -= trx_size;
+  } else {
+    db_->removePoolSpilledTransaction(it->first);
+    spilled_transactions_count_--;
+  }
+  const auto id = *trx_ids_.find(it->first);
+  if (const auto block_it = non_proposable_transactions_by_block_.find(it->second.last_block_number);
+      block_it != non_proposable_transactions_by_block_.end()) {
+    block_it->second.erase(id);
+    if (block_it->second.empty()) {
+      non_proposable_transactions_by_block_.erase(block_it);
+    }
+  }
+  trx_ids_.release(id);
   return non_proposable_transactions_.erase(it);
 }
 
@@ -70,7 +123,10 @@ std::shared_ptr<Transaction> TransactionQueue::get(const trx_hash_t &hash) const
 
   if (const auto transaction = non_proposable_transactions_.find(hash);
       transaction != non_proposable_transactions_.end()) {
-    return transaction->second.second;
+    if (transaction->second.transaction) {
+      return transaction->second.transaction;
+    }
+    return db_->getPoolSpilledTransaction(hash);
   }
 
   return nullptr;
@@ -78,37 +134,40 @@ std::shared_ptr<Transaction> TransactionQueue::get(const trx_hash_t &hash) const
 
 SharedTransactions TransactionQueue::getOrderedTransactions(uint64_t count) const {
   SharedTransactions ret;
-  ret.reserve(count);
-
-  std::multimap<val_t, std::shared_ptr<Transaction>, std::greater<val_t>> head_transactions;
-  std::unordered_map<addr_t, std::pair<std::map<val_t, std::shared_ptr<Transaction>>::const_iterator,
-                                       std::map<val_t, std::shared_ptr<Transaction>>::const_iterator>>
-      iterators;
-
-  iterators.reserve(account_nonce_transactions_.size());
-  // For accounts with multiple transactions we will iterate one level at a time
-  for (const auto &account : account_nonce_transactions_) {
-    iterators.insert({account.first, {account.second.begin(), account.second.end()}});
+  ret.reserve(std::min<uint64_t>(count, size()));
+  if (count == 0) {
+    return ret;
   }
 
-  for (auto it = iterators.begin(); it != iterators.end(); it++) {
-    head_transactions.insert({it->second.first->second->getGasPrice(), it->second.first->second});
-    // Increase iterator for an account
-    it->second.first++;
-  }
-  while (!head_transactions.empty()) {
-    // Take transactions with highest gas and put it in ordered transactions
-    auto head_trx = head_transactions.begin();
-    ret.push_back(head_trx->second);
-    if (ret.size() == count) {
-      break;
+  // Next nonce transactions of accounts whose head was already taken, only these have to be ordered here
+  std::multimap<val_t, std::pair<AccountTransactions::const_iterator, AccountTransactions::const_iterator>,
+                std::greater<val_t>>
+      next_transactions;
+
+  auto take = [&](AccountTransactions::const_iterator it, AccountTransactions::const_iterator end) {
+    ret.push_back(it->second);
+    if (++it != end) {
+      next_transactions.insert({it->second->getGasPrice(), {it, end}});
     }
-    // If there is next nonce transaction of same account put it in head transactions
-    auto &it = iterators[head_trx->second->getSender()];
-    head_transactions.erase(head_trx);
-    if (it.first != it.second) {
-      head_transactions.insert({it.first->second->getGasPrice(), it.first->second});
-      it.first++;
+    return ret.size() == count;
+  };
+
+  auto head_it = account_heads_.begin();
+  while (head_it != account_heads_.end() || !next_transactions.empty()) {
+    // Prefer account heads on equal gas price as they were queued first
+    if (next_transactions.empty() ||
+        (head_it != account_heads_.end() && head_it->first >= next_transactions.begin()->first)) {
+      const auto &account_transactions = account_nonce_transactions_.at(head_it->second);
+      ++head_it;
+      if (take(account_transactions.begin(), account_transactions.end())) {
+        break;
+      }
+    } else {
+      const auto [it, end] = next_transactions.begin()->second;
+      next_transactions.erase(next_transactions.begin());
+      if (take(it, end)) {
+        break;
+      }
     }
   }
 
@@ -129,6 +188,43 @@ std::vector<SharedTransactions> TransactionQueue::getAllTransactions() const {
   return ret;
 }
 
+std::pair<std::vector<SharedTransactions>, uint64_t> TransactionQueue::getTransactionsInsertedAfter(
+    uint64_t sequence) const {
+  if (sequence >= last_insertion_sequence_) {
+    return {{}, last_insertion_sequence_};
+  }
+  // Insertions after the sequence were trimmed from the log
+  if (insertion_log_.empty() || insertion_log_.front().first > sequence + 1) {
+    return {getAllTransactions(), last_insertion_sequence_};
+  }
+
+  std::vector<SharedTransactions> ret;
+  std::unordered_map<addr_t, size_t> account_index;
+  // Sequence numbers in the log are consecutive
+  for (auto it = insertion_log_.begin() + (sequence + 1 - insertion_log_.front().first); it != insertion_log_.end();
+       ++it) {
+    const auto trx_it = queue_transactions_.find(trx_ids_.hash(it->second));
+    if (trx_it == queue_transactions_.end()) {
+      continue;
+    }
+    const auto &trx = trx_it->second;
+    const auto [index_it, inserted] = account_index.emplace(trx->getSender(), ret.size());
+    if (inserted) {
+      ret.emplace_back();
+    }
+    ret[index_it->second].push_back(trx);
+  }
+  for (auto &account_transactions : ret) {
+    std::sort(account_transactions.begin(), account_transactions.end(),
+              [](const auto &a, const auto &b) { return a->getNonce() < b->getNonce(); });
+    // Transaction removed and inserted again is in the log twice, only one transaction per nonce can be in the queue
+    account_transactions.erase(std::unique(account_transactions.begin(), account_transactions.end()),
+                               account_transactions.end());
+  }
+
+  return {std::move(ret), last_insertion_sequence_};
+}
+
 bool TransactionQueue::erase(const SharedTransaction &transaction) {
   // Find the hash
   const auto it = queue_transactions_.find(transaction->getHash());
@@ -142,9 +238,12 @@ bool TransactionQueue::erase(const SharedTransaction &transaction) {
   assert(nonce_it != account_it->second.end());
   assert(transaction->getHash() == nonce_it->second->getHash());
 
+  unindexAccount(account_it->first, account_it->second);
   account_it->second.erase(nonce_it);
   if (account_it->second.size() == 0) {
     account_nonce_transactions_.erase(account_it);
+  } else {
+    indexAccount(account_it->first, account_it->second);
   }
   return removeTransaction(transaction, true);
 }
@@ -158,15 +257,12 @@ TransactionStatus TransactionQueue::insert(std::shared_ptr<Transaction> &&transa
     return TransactionStatus::Known;
   }
 
-  if (data_size_ > kMaxDataSize) {
-    transaction_overflow_time_ = std::chrono::system_clock::now();
-    return TransactionStatus::Overflow;
-  }
-
   if (proposable) {
     const auto &account_it = account_nonce_transactions_.find(transaction->getSender());
     if (account_it == account_nonce_transactions_.end()) {
-      account_nonce_transactions_[transaction->getSender()][transaction->getNonce()] = transaction;
+      auto &account_transactions = account_nonce_transactions_[transaction->getSender()];
+      account_transactions[transaction->getNonce()] = transaction;
+      indexAccount(transaction->getSender(), account_transactions);
       addTransaction(transaction, proposable);
     } else {
       if (account_it->second.size() == kMaxSingleAccountTransactionsSize) {
@@ -175,7 +271,9 @@ TransactionStatus TransactionQueue::insert(std::shared_ptr<Transaction> &&transa
       }
       const auto &nonce_it = account_it->second.find(transaction->getNonce());
       if (nonce_it == account_it->second.end()) {
-        account_nonce_transactions_[transaction->getSender()][transaction->getNonce()] = transaction;
+        unindexAccount(account_it->first, account_it->second);
+        account_it->second[transaction->getNonce()] = transaction;
+        indexAccount(account_it->first, account_it->second);
         addTransaction(transaction, proposable);
       } else {
         // It should not be possible that transaction is already inside due to verification done before
@@ -184,10 +282,12 @@ TransactionStatus TransactionQueue::insert(std::shared_ptr<Transaction> &&transa
         if (transaction->getGasPrice() > nonce_it->second->getGasPrice()) {
           // Place same nonce transaction with lower gas price in non proposable transactions since it could be
           // possible that some dag block might contain it
+          unindexAccount(account_it->first, account_it->second);
           removeTransaction(nonce_it->second, true);
           addTransaction(nonce_it->second, false, last_block_number);
 
-          account_nonce_transactions_[transaction->getSender()][transaction->getNonce()] = transaction;
+          nonce_it->second = transaction;
+          indexAccount(account_it->first, account_it->second);
           addTransaction(transaction, proposable);
         } else {
           addTransaction(transaction, false, last_block_number);
@@ -196,16 +296,22 @@ TransactionStatus TransactionQueue::insert(std::shared_ptr<Transaction> &&transa
     }
 
     const auto queue_size = size();
-    // This check if priority_queue_ is not bigger than max size if so we delete 1% of transactions
-    if (queue_size > kMaxSize) [[unlikely]] {
-      auto ordered_transactions = getOrderedTransactions(queue_size);
-      uint32_t counter = 0;
-      for (auto it = ordered_transactions.rbegin(); it != ordered_transactions.rend(); it++) {
+    // Proposable transactions get the part of data limit not reserved for non proposable ones
+    auto proposable_data_over_limit = [this]() {
+      return data_size_ - non_proposable_data_size_ > kMaxDataSize - kNonProposableMaxDataSize;
+    };
+    // This check if priority_queue_ is not bigger than max size if so we delete 1% of transactions, if it is over the
+    // data limit we delete until it fits. Highest nonce transactions of accounts with the lowest gas price are evicted
+    // first so that no nonce gaps are created
+    if (queue_size > kMaxSize || proposable_data_over_limit()) [[unlikely]] {
+      const size_t min_evicted = queue_size > kMaxSize ? std::max<size_t>(queue_size / 100, 1) : 0;
+      size_t counter = 0;
+      while (!account_tails_.empty() && (counter < min_evicted || proposable_data_over_limit())) {
         transaction_overflow_time_ = std::chrono::system_clock::now();
-        erase(*it);
-        known_txs_.erase((*it)->getHash());
+        const auto evicted = account_nonce_transactions_.at(account_tails_.begin()->second).rbegin()->second;
+        erase(evicted);
+        known_txs_.erase(evicted->getHash());
         counter++;
-        if (counter >= queue_size / 100) break;
       }
       if (!queue_transactions_.contains(tx_hash)) {
         return TransactionStatus::Overflow;
@@ -213,7 +319,12 @@ TransactionStatus TransactionQueue::insert(std::shared_ptr<Transaction> &&transa
     }
     known_txs_.insert(tx_hash);
   } else {
-    if (non_proposable_transactions_.size() <= kNonProposableTransactionsMaxSize) {
+    const auto in_memory_count = non_proposable_transactions_.size() - spilled_transactions_count_;
+    const bool can_spill =
+        db_ && spilled_transactions_count_ < kNonProposableTransactionsMaxSize * kSpilledTransactionsLimitMultiplier;
+    const bool memory_available =
+        in_memory_count <= kNonProposableTransactionsMaxSize && (db_ || data_size_ <= kMaxDataSize);
+    if (memory_available || can_spill) {
       addTransaction(transaction, false, last_block_number);
       known_txs_.insert(tx_hash);
       return TransactionStatus::InsertedNonProposable;
@@ -226,12 +337,17 @@ TransactionStatus TransactionQueue::insert(std::shared_ptr<Transaction> &&transa
 }
 
 void TransactionQueue::blockFinalized(uint64_t block_number) {
-  for (auto it = non_proposable_transactions_.begin(); it != non_proposable_transactions_.end();) {
-    if (it->second.first + kNonProposableTransactionsPeriodExpiryLimit < block_number) {
-      known_txs_.erase(it->first);
-      it = removeTransaction(it);
-    } else {
-      ++it;
+  while (!non_proposable_transactions_by_block_.empty() &&
+         non_proposable_transactions_by_block_.begin()->first + kNonProposableTransactionsPeriodExpiryLimit <
+             block_number) {
+    // Bucket is detached first, so removeTransaction does not touch it
+    const auto expired = std::move(non_proposable_transactions_by_block_.begin()->second);
+    non_proposable_transactions_by_block_.erase(non_proposable_transactions_by_block_.begin());
+    for (const auto id : expired) {
+      // Copy, id is released by removeTransaction
+      const auto hash = trx_ids_.hash(id);
+      known_txs_.erase(hash);
+      removeTransaction(non_proposable_transactions_.find(hash));
     }
   }
 }
@@ -240,6 +356,7 @@ void TransactionQueue::purge() {
   for (auto account_it = account_nonce_transactions_.begin(); account_it != account_nonce_transactions_.end();) {
     const auto account = final_chain_->getAccount(account_it->first);
     if (account.has_value()) {
+      unindexAccount(account_it->first, account_it->second);
       for (auto nonce_it = account_it->second.begin(); nonce_it != account_it->second.end();) {
         if (nonce_it->first < account->nonce) {
           removeTransaction(nonce_it->second, true);
@@ -252,6 +369,7 @@ void TransactionQueue::purge() {
       if (account_it->second.size() == 0) {
         account_it = account_nonce_transactions_.erase(account_it);
       } else {
+        indexAccount(account_it->first, account_it->second);
         account_it++;
       }
     } else {
@@ -260,7 +378,40 @@ void TransactionQueue::purge() {
   }
 }
 
+void TransactionQueue::unindexAccount(const addr_t &account, const AccountTransactions &transactions) {
+  if (transactions.empty()) {
+    return;
+  }
+  account_heads_.erase({transactions.begin()->second->getGasPrice(), account});
+  account_tails_.erase({transactions.rbegin()->second->getGasPrice(), account});
+
+  std::unique_lock lock(pending_nonces_mutex_);
+  pending_nonces_.erase(account);
+}
+
+void TransactionQueue::indexAccount(const addr_t &account, const AccountTransactions &transactions) {
+  if (transactions.empty()) {
+    return;
+  }
+  account_heads_.insert({transactions.begin()->second->getGasPrice(), account});
+  account_tails_.insert({transactions.rbegin()->second->getGasPrice(), account});
+
+  std::unique_lock lock(pending_nonces_mutex_);
+  pending_nonces_[account] = transactions.rbegin()->first + 1;
+}
+
+std::optional<trx_nonce_t> TransactionQueue::getPendingNonce(const addr_t &sender) const {
+  std::shared_lock lock(pending_nonces_mutex_);
+  if (const auto it = pending_nonces_.find(sender); it != pending_nonces_.end()) {
+    return it->second;
+  }
+  return {};
+}
+
 bool TransactionQueue::nonProposableTransactionsOverTheLimit() const {
+  if (db_) {
+    return spilled_transactions_count_ >= kNonProposableTransactionsMaxSize * kSpilledTransactionsLimitMultiplier;
+  }
   return non_proposable_transactions_.size() >= kNonProposableTransactionsMaxSize;
 }
 
@@ -5,16 +5,107 @@
 
 namespace taraxa {
 
+// Vote itself plus its entries in voted value votes and unique voters maps
+constexpr size_t kVoteMemoryUsage = sizeof(PbftVote) + 2 * util::kContainerNodeOverhead + sizeof(vote_hash_t) +
+                                    sizeof(addr_t) + 3 * sizeof(std::shared_ptr<PbftVote>);
+
+const StepVotes* VerifiedVotes::RoundVotes::findStep(PbftStep step) const {
+  if (step < kDenseStepsCount) {
+    // Steps are created only together with first voted value
+    if (step < steps.size() && !steps[step].votes.empty()) {
+      return &steps[step];
+    }
+    return nullptr;
+  }
+
+  const auto found_step_it = sparse_steps.find(step);
+  if (found_step_it == sparse_steps.end()) {
+    return nullptr;
+  }
+  return &found_step_it->second;
+}
+
+StepVotes& VerifiedVotes::RoundVotes::step(PbftStep step) {
+  if (step < kDenseStepsCount) {
+    if (step >= steps.size()) {
+      steps.resize(step + 1);
+    }
+    return steps[step];
+  }
+
+  return sparse_steps[step];
+}
+
+RoundVerifiedVotes VerifiedVotes::RoundVotes::toRoundVerifiedVotes() const {
+  RoundVerifiedVotes round_votes;
+  round_votes.two_t_plus_one_voted_blocks_ = two_t_plus_one_voted_blocks;
+  round_votes.network_t_plus_one_step = network_t_plus_one_step;
+  for (PbftStep step = 0; step < steps.size(); step++) {
+    if (!steps[step].votes.empty()) {
+      round_votes.step_votes.emplace(step, steps[step]);
+    }
+  }
+  round_votes.step_votes.insert(sparse_steps.begin(), sparse_steps.end());
+  return round_votes;
+}
+
+std::shared_ptr<VerifiedVotes::RoundVotes> VerifiedVotes::findRound(PbftPeriod period, PbftRound round) const {
+  const auto& slot = periods_[period % kPeriodsRingSize];
+  std::shared_lock lock(slot.mutex);
+  if (slot.period != period) {
+    return nullptr;
+  }
+
+  const auto found_round_it = slot.rounds.find(round);
+  if (found_round_it == slot.rounds.end()) {
+    return nullptr;
+  }
+  return found_round_it->second;
+}
+
+std::shared_ptr<VerifiedVotes::RoundVotes> VerifiedVotes::getOrInsertRound(PbftPeriod period, PbftRound round) {
+  if (auto round_votes = findRound(period, round)) {
+    return round_votes;
+  }
+
+  // Period this far ahead would take the slot of a period that is still kept
+  if (const PbftPeriod min_period = min_period_; min_period && period >= min_period + kPeriodsRingSize) {
+    LOG(log_wr_) << "Unable to store votes for period " << period << ", it is too far ahead of kept period "
+                 << min_period;
+    return nullptr;
+  }
+
+  auto& slot = periods_[period % kPeriodsRingSize];
+  decltype(slot.rounds) evicted_rounds;
+  std::scoped_lock lock(slot.mutex);
+  if (slot.period != period) {
+    // Votes of a period that is still kept are never evicted, only votes stored for already cleaned up periods are
+    if (slot.period.has_value() && *slot.period >= min_period_) {
+      LOG(log_wr_) << "Unable to store votes for period " << period << ", its slot is occupied by period "
+                   << *slot.period;
+      return nullptr;
+    }
+
+    // Old rounds are destroyed after the lock is released
+    evicted_rounds.swap(slot.rounds);
+    subRoundsMemoryUsage(evicted_rounds);
+    slot.period = period;
+  }
+
+  auto& round_votes = slot.rounds[round];
+  if (!round_votes) {
+    round_votes = std::make_shared<RoundVotes>();
+  }
+  return round_votes;
+}
+
 uint64_t VerifiedVotes::size() const {
   uint64_t size = 0;
-  std::shared_lock lock(verified_votes_access_);
-  for (auto const& [_, period] : verified_votes_) {
-    for (auto const& [_, round] : period) {
-      for (auto const& [_, step] : round.step_votes) {
-        size += std::accumulate(step.votes.begin(), step.votes.end(), 0, [](uint64_t value, const auto& voted_value) {
-          return value + voted_value.second.votes.size();
-        });
-      }
+  for (const auto& slot : periods_) {
+    std::shared_lock lock(slot.mutex);
+    for (const auto& [_, round_votes] : slot.rounds) {
+      std::shared_lock round_lock(round_votes->mutex);
+      size += round_votes->votes_count;
     }
   }
   return size;
@@ -24,15 +115,23 @@ std::vector<std::shared_ptr<PbftVote>> VerifiedVotes::votes() const {
   std::vector<std::shared_ptr<PbftVote>> votes;
   votes.reserve(size());
 
-  std::shared_lock lock(verified_votes_access_);
-  for (const auto& [_, period_votes] : verified_votes_) {
-    for (const auto& [_, round_votes] : period_votes) {
-      for (const auto& [_, step_votes] : round_votes.step_votes) {
-        for (const auto& [_, voted_value] : step_votes.votes) {
-          for (const auto& [_, v] : voted_value.votes) {
-            votes.emplace_back(v);
-          }
-        }
+  auto add_step_votes = [&votes](const StepVotes& step_votes) {
+    for (const auto& [_, voted_value] : step_votes.votes) {
+      for (const auto& [_, v] : voted_value.votes) {
+        votes.emplace_back(v);
+      }
+    }
+  };
+
+  for (const auto& slot : periods_) {
+    std::shared_lock lock(slot.mutex);
+    for (const auto& [_, round_votes] : slot.rounds) {
+      std::shared_lock round_lock(round_votes->mutex);
+      for (const auto& step_votes : round_votes->steps) {
+        add_step_votes(step_votes);
+      }
+      for (const auto& [_, step_votes] : round_votes->sparse_steps) {
+        add_step_votes(step_votes);
       }
     }
   }
@@ -41,66 +140,107 @@ std::vector<std::shared_ptr<PbftVote>> VerifiedVotes::votes() const {
 }
 
 std::optional<const RoundVerifiedVotesMap> VerifiedVotes::getPeriodVotes(PbftPeriod period) const {
-  std::shared_lock lock(verified_votes_access_);
+  std::vector<std::pair<PbftRound, std::shared_ptr<RoundVotes>>> rounds;
+  {
+    const auto& slot = periods_[period % kPeriodsRingSize];
+    std::shared_lock lock(slot.mutex);
+    if (slot.period != period) {
+      return std::nullopt;
+    }
+    rounds.assign(slot.rounds.begin(), slot.rounds.end());
+  }
 
-  auto period_it = verified_votes_.find(period);
-  if (period_it != verified_votes_.end()) {
-    return period_it->second;
+  RoundVerifiedVotesMap period_votes;
+  for (const auto& [round, round_votes] : rounds) {
+    std::shared_lock lock(round_votes->mutex);
+    period_votes.emplace_hint(period_votes.end(), round, round_votes->toRoundVerifiedVotes());
   }
-  return std::nullopt;
+  return period_votes;
 }
 
 std::optional<const RoundVerifiedVotes> VerifiedVotes::getRoundVotes(PbftPeriod period, PbftRound round) const {
-  std::shared_lock lock(verified_votes_access_);
+  const auto round_votes = findRound(period, round);
+  if (!round_votes) {
+    return std::nullopt;
+  }
 
-  auto period_it = verified_votes_.find(period);
-  if (period_it == verified_votes_.end()) {
+  std::shared_lock lock(round_votes->mutex);
+  return round_votes->toRoundVerifiedVotes();
+}
+
+std::optional<const StepVotes> VerifiedVotes::getStepVotes(PbftPeriod period, PbftRound round, PbftStep step) const {
+  const auto round_votes = findRound(period, round);
+  if (!round_votes) {
     return std::nullopt;
   }
 
-  auto round_it = period_it->second.find(round);
-  if (round_it != period_it->second.end()) {
-    return round_it->second;
+  std::shared_lock lock(round_votes->mutex);
+  if (const auto step_votes = round_votes->findStep(step)) {
+    return *step_votes;
   }
   return std::nullopt;
 }
 
-std::optional<const StepVotes> VerifiedVotes::getStepVotes(PbftPeriod period, PbftRound round, PbftStep step) const {
-  std::shared_lock lock(verified_votes_access_);
+bool VerifiedVotes::containsVote(const std::shared_ptr<PbftVote>& vote) const {
+  const auto round_votes = findRound(vote->getPeriod(), vote->getRound());
+  if (!round_votes) {
+    return false;
+  }
+
+  std::shared_lock lock(round_votes->mutex);
+  const auto step_votes = round_votes->findStep(vote->getStep());
+  if (!step_votes) {
+    return false;
+  }
+
+  const auto found_voted_value_it = step_votes->votes.find(vote->getBlockHash());
+  if (found_voted_value_it == step_votes->votes.end()) {
+    return false;
+  }
+
+  return found_voted_value_it->second.votes.contains(vote->getHash());
+}
 
-  auto period_it = verified_votes_.find(period);
-  if (period_it == verified_votes_.end()) {
+std::optional<std::pair<std::shared_ptr<PbftVote>, std::shared_ptr<PbftVote>>> VerifiedVotes::getUniqueVoter(
+    PbftPeriod period, PbftRound round, PbftStep step, const addr_t& voter) const {
+  const auto round_votes = findRound(period, round);
+  if (!round_votes) {
     return std::nullopt;
   }
 
-  auto round_it = period_it->second.find(round);
-  if (round_it == period_it->second.end()) {
+  std::shared_lock lock(round_votes->mutex);
+  const auto step_votes = round_votes->findStep(step);
+  if (!step_votes) {
     return std::nullopt;
   }
 
-  auto step_it = round_it->second.step_votes.find(step);
-  if (step_it != round_it->second.step_votes.end()) {
-    return step_it->second;
+  const auto found_voter_it = step_votes->unique_voters.find(voter);
+  if (found_voter_it == step_votes->unique_voters.end()) {
+    return std::nullopt;
   }
-  return std::nullopt;
+  return found_voter_it->second;
 }
 
-std::optional<VotedBlock> VerifiedVotes::getTwoTPlusOneVotedBlock(PbftPeriod period, PbftRound round,
-                                                                  TwoTPlusOneVotedBlockType type) const {
-  std::shared_lock lock(verified_votes_access_);
-
-  const auto found_period_it = verified_votes_.find(period);
-  if (found_period_it == verified_votes_.end()) {
-    return {};
+PbftStep VerifiedVotes::getNetworkTPlusOneStep(PbftPeriod period, PbftRound round) const {
+  const auto round_votes = findRound(period, round);
+  if (!round_votes) {
+    return 0;
   }
 
-  const auto found_round_it = found_period_it->second.find(round);
-  if (found_round_it == found_period_it->second.end()) {
+  std::shared_lock lock(round_votes->mutex);
+  return round_votes->network_t_plus_one_step;
+}
+
+std::optional<VotedBlock> VerifiedVotes::getTwoTPlusOneVotedBlock(PbftPeriod period, PbftRound round,
+                                                                  TwoTPlusOneVotedBlockType type) const {
+  const auto round_votes = findRound(period, round);
+  if (!round_votes) {
     return {};
   }
 
-  const auto two_t_plus_one_voted_block_it = found_round_it->second.two_t_plus_one_voted_blocks_.find(type);
-  if (two_t_plus_one_voted_block_it == found_round_it->second.two_t_plus_one_voted_blocks_.end()) {
+  std::shared_lock lock(round_votes->mutex);
+  const auto two_t_plus_one_voted_block_it = round_votes->two_t_plus_one_voted_blocks.find(type);
+  if (two_t_plus_one_voted_block_it == round_votes->two_t_plus_one_voted_blocks.end()) {
     return {};
   }
 
@@ -109,18 +249,24 @@ std::optional<VotedBlock> VerifiedVotes::getTwoTPlusOneVotedBlock(PbftPeriod per
 
 std::vector<std::shared_ptr<PbftVote>> VerifiedVotes::getTwoTPlusOneVotedBlockVotes(
     PbftPeriod period, PbftRound round, TwoTPlusOneVotedBlockType type) const {
-  const auto voted = getTwoTPlusOneVotedBlock(period, round, type);
-  if (!voted) {
+  const auto round_votes = findRound(period, round);
+  if (!round_votes) {
+    return {};
+  }
+
+  std::shared_lock lock(round_votes->mutex);
+  const auto voted_it = round_votes->two_t_plus_one_voted_blocks.find(type);
+  if (voted_it == round_votes->two_t_plus_one_voted_blocks.end()) {
     return {};
   }
 
-  const auto step_votes = getStepVotes(period, round, voted->step);
+  const auto step_votes = round_votes->findStep(voted_it->second.step);
   if (!step_votes) {
     return {};
   }
 
   // Find verified votes for specified block_hash based on found 2t+1 voted block of type "type"
-  const auto found_verified_votes_it = step_votes->votes.find(voted->hash);
+  const auto found_verified_votes_it = step_votes->votes.find(voted_it->second.hash);
   if (found_verified_votes_it == step_votes->votes.end()) {
     assert(false);
     return {};
@@ -136,60 +282,41 @@ std::vector<std::shared_ptr<PbftVote>> VerifiedVotes::getTwoTPlusOneVotedBlockVo
 }
 
 void VerifiedVotes::setNetworkTPlusOneStep(std::shared_ptr<PbftVote> vote) {
-  std::scoped_lock lock(verified_votes_access_);
-
-  const auto found_period_it = verified_votes_.find(vote->getPeriod());
-  if (found_period_it == verified_votes_.end()) {
-    return;
-  }
-
-  const auto found_round_it = found_period_it->second.find(vote->getRound());
-  if (found_round_it == found_period_it->second.end()) {
+  const auto round_votes = findRound(vote->getPeriod(), vote->getRound());
+  if (!round_votes) {
     return;
   }
 
-  found_round_it->second.network_t_plus_one_step = vote->getStep();
+  std::scoped_lock lock(round_votes->mutex);
+  round_votes->network_t_plus_one_step = vote->getStep();
 }
 
 void VerifiedVotes::insertTwoTPlusOneVotedBlock(TwoTPlusOneVotedBlockType type, std::shared_ptr<PbftVote> vote) {
-  std::scoped_lock lock(verified_votes_access_);
-
-  const auto found_period_it = verified_votes_.find(vote->getPeriod());
-  if (found_period_it == verified_votes_.end()) {
-    std::cerr << "insertTwoTPlusOneVotedBlock: period " << vote->getPeriod() << ", round " << vote->getRound()
-              << std::endl;
-    return;
-  }
-
-  const auto found_round_it = found_period_it->second.find(vote->getRound());
-  if (found_round_it == found_period_it->second.end()) {
+  const auto round_votes = findRound(vote->getPeriod(), vote->getRound());
+  if (!round_votes) {
     std::cerr << "insertTwoTPlusOneVotedBlock: period " << vote->getPeriod() << ", round " << vote->getRound()
               << std::endl;
     return;
   }
 
-  found_round_it->second.two_t_plus_one_voted_blocks_.emplace(type, VotedBlock{vote->getBlockHash(), vote->getStep()});
+  std::scoped_lock lock(round_votes->mutex);
+  round_votes->two_t_plus_one_voted_blocks.emplace(type, VotedBlock{vote->getBlockHash(), vote->getStep()});
 }
 
 std::optional<std::shared_ptr<PbftVote>> VerifiedVotes::insertUniqueVoter(const std::shared_ptr<PbftVote>& vote) {
-  std::scoped_lock lock(verified_votes_access_);
-
-  const auto found_period_it = verified_votes_.find(vote->getPeriod());
-  if (found_period_it == verified_votes_.end()) {
-    return std::nullopt;
-  }
-
-  const auto found_round_it = found_period_it->second.find(vote->getRound());
-  if (found_round_it == found_period_it->second.end()) {
+  const auto round_votes = findRound(vote->getPeriod(), vote->getRound());
+  if (!round_votes) {
     return std::nullopt;
   }
 
-  const auto found_step_it = found_round_it->second.step_votes.find(vote->getStep());
-  if (found_step_it == found_round_it->second.step_votes.end()) {
+  std::scoped_lock lock(round_votes->mutex);
+  if (!round_votes->findStep(vote->getStep())) {
     return std::nullopt;
   }
+  auto& step_votes = round_votes->step(vote->getStep());
 
-  auto inserted_vote = found_step_it->second.unique_voters.insert({vote->getVoterAddr(), {vote, nullptr}});
+  // Honest voter path: single lookup, vote is copied into the map only if voter is new
+  auto inserted_vote = step_votes.unique_voters.try_emplace(vote->getVoterAddr(), vote, nullptr);
 
   // Vote was successfully inserted -> it is unique
   if (inserted_vote.second) {
@@ -243,52 +370,50 @@ std::optional<std::shared_ptr<PbftVote>> VerifiedVotes::insertUniqueVoter(const
   return std::nullopt;
 }
 
-std::optional<VotesWithWeight> VerifiedVotes::insertVotedValue(const std::shared_ptr<PbftVote>& vote) {
-  std::scoped_lock lock(verified_votes_access_);
-
-  auto found_period_it = verified_votes_.find(vote->getPeriod());
-  if (found_period_it == verified_votes_.end()) {
-    found_period_it = verified_votes_.insert({vote->getPeriod(), {}}).first;
-  }
-
-  auto found_round_it = found_period_it->second.find(vote->getRound());
-  if (found_round_it == found_period_it->second.end()) {
-    found_round_it = found_period_it->second.insert({vote->getRound(), {}}).first;
+std::optional<uint64_t> VerifiedVotes::insertVotedValue(const std::shared_ptr<PbftVote>& vote) {
+  const auto round_votes = getOrInsertRound(vote->getPeriod(), vote->getRound());
+  if (!round_votes) {
+    return {};
   }
 
-  auto found_step_it = found_round_it->second.step_votes.find(vote->getStep());
-  if (found_step_it == found_round_it->second.step_votes.end()) {
-    found_step_it = found_round_it->second.step_votes.insert({vote->getStep(), {}}).first;
-  }
+  std::scoped_lock lock(round_votes->mutex);
+  auto& step_votes = round_votes->step(vote->getStep());
 
-  auto found_voted_value_it = found_step_it->second.votes.find(vote->getBlockHash());
   // Add voted value
-  if (found_voted_value_it == found_step_it->second.votes.end()) {
-    found_voted_value_it = found_step_it->second.votes.insert({vote->getBlockHash(), {}}).first;
-  }
-
-  if (found_voted_value_it->second.votes.contains(vote->getHash())) {
+  auto& voted_value = step_votes.votes[vote->getBlockHash()];
+  if (!voted_value.votes.insert({vote->getHash(), vote}).second) {
     LOG(log_dg_) << "Vote " << vote->getHash() << " is in verified map already";
     return {};
   }
 
-  // Add vote hash
-  if (!found_voted_value_it->second.votes.insert({vote->getHash(), vote}).second) {
-    // This should never happen
-    LOG(log_dg_) << "Vote " << vote->getHash() << " is in verified map already (race condition)";
-    assert(false);
-    return {};
+  voted_value.weight += *vote->getWeight();
+  round_votes->votes_count++;
+  memory_usage_.add(kVoteMemoryUsage);
+  return voted_value.weight;
+}
+
+void VerifiedVotes::subRoundsMemoryUsage(const std::map<PbftRound, std::shared_ptr<RoundVotes>>& rounds) {
+  for (const auto& [_, round_votes] : rounds) {
+    std::shared_lock lock(round_votes->mutex);
+    memory_usage_.sub(round_votes->votes_count * kVoteMemoryUsage);
   }
-  found_voted_value_it->second.weight += *vote->getWeight();
-  return found_voted_value_it->second;
 }
 
 void VerifiedVotes::cleanupVotesByPeriod(PbftPeriod pbft_period) {
-  // Remove verified votes
-  std::scoped_lock lock(verified_votes_access_);
-  auto it = verified_votes_.begin();
-  while (it != verified_votes_.end() && it->first < pbft_period) {
-    it = verified_votes_.erase(it);
+  min_period_ = pbft_period;
+
+  // Remove verified votes, ring has fixed size so this does not depend on number of stored periods
+  for (auto& slot : periods_) {
+    decltype(slot.rounds) removed_rounds;
+    {
+      std::scoped_lock lock(slot.mutex);
+      if (!slot.period.has_value() || *slot.period >= pbft_period) {
+        continue;
+      }
+      removed_rounds.swap(slot.rounds);
+      slot.period.reset();
+    }
+    subRoundsMemoryUsage(removed_rounds);
   }
 }
 
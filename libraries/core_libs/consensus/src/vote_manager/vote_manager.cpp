@@ -3,11 +3,16 @@
 #include <libdevcore/SHA3.h>
 #include <libdevcrypto/Common.h>
 
+#include <algorithm>
+#include <future>
 #include <optional>
 #include <shared_mutex>
+#include <unordered_set>
 
+#include "common/tracing.hpp"
 #include "network/network.hpp"
 #include "pbft/pbft_manager.hpp"
+#include "vote/votes_bundle_rlp.hpp"
 
 namespace taraxa {
 
@@ -21,7 +26,10 @@ VoteManager::VoteManager(const FullNodeConfig& config, std::shared_ptr<DbStorage
       key_manager_(std::move(key_manager)),
       slashing_manager_(std::move(slashing_manager)),
       verified_votes_(dev::toAddress(config.getFirstWallet().node_secret)),
-      already_validated_votes_(1000000, 1000) {
+      already_validated_votes_(1000000, 1000),
+      kVotesValidationTasksCount(std::max(1u, std::thread::hardware_concurrency() / 2)),
+      kWallets(config.wallets),
+      vrf_precompute_thread_pool_(std::clamp<size_t>(kWallets.size(), 1, kVotesValidationTasksCount)) {
   // Use first wallet as default node_addr
   const auto& node_addr = dev::toAddress(config.getFirstWallet().node_secret);
   LOG_OBJECTS_CREATE("VOTE_MGR");
@@ -79,12 +87,28 @@ std::vector<std::shared_ptr<PbftVote>> VoteManager::getVerifiedVotes() const { r
 
 uint64_t VoteManager::getVerifiedVotesSize() const { return verified_votes_.size(); }
 
-void VoteManager::cleanupVotesByPeriod(PbftPeriod pbft_period) { verified_votes_.cleanupVotesByPeriod(pbft_period); }
+size_t VoteManager::getVerifiedVotesMemoryUsage() const { return verified_votes_.memoryUsage(); }
+
+void VoteManager::cleanupVotesByPeriod(PbftPeriod pbft_period) {
+  verified_votes_.cleanupVotesByPeriod(pbft_period);
+
+  std::scoped_lock lock(two_t_plus_one_votes_bundles_mutex_);
+  two_t_plus_one_votes_bundles_.erase(
+      two_t_plus_one_votes_bundles_.begin(),
+      two_t_plus_one_votes_bundles_.lower_bound({pbft_period, 0, TwoTPlusOneVotedBlockType::SoftVotedBlock}));
+}
 
 void VoteManager::setCurrentPbftPeriodAndRound(PbftPeriod pbft_period, PbftRound pbft_round) {
+  current_round_start_ = std::chrono::steady_clock::now();
   current_pbft_period_ = pbft_period;
   current_pbft_round_ = pbft_round;
 
+  // Current round is usually precomputed already, next round of the same period and first round of the next period
+  // are the possible upcoming ones
+  precomputeVrfSortitions(pbft_period, pbft_round);
+  precomputeVrfSortitions(pbft_period, pbft_round + 1);
+  precomputeVrfSortitions(pbft_period + 1, 1);
+
   auto round_votes = verified_votes_.getRoundVotes(pbft_period, pbft_round);
   if (!round_votes) {
     return;
@@ -130,15 +154,11 @@ void VoteManager::setCurrentPbftPeriodAndRound(PbftPeriod pbft_period, PbftRound
 }
 
 PbftStep VoteManager::getNetworkTplusOneNextVotingStep(PbftPeriod period, PbftRound round) const {
-  auto round_votes = verified_votes_.getRoundVotes(period, round);
-  if (!round_votes) {
-    return 0;
-  }
-
-  return round_votes->network_t_plus_one_step;
+  return verified_votes_.getNetworkTPlusOneStep(period, round);
 }
 
 bool VoteManager::addVerifiedVote(const std::shared_ptr<PbftVote>& vote) {
+  TRACE_SPAN("VoteManager::addVerifiedVote");
   assert(vote->getWeight().has_value());
   const auto hash = vote->getHash();
   const auto weight = *vote->getWeight();
@@ -153,7 +173,7 @@ bool VoteManager::addVerifiedVote(const std::shared_ptr<PbftVote>& vote) {
     if (auto existing_vote = verified_votes_.insertUniqueVoter(vote); existing_vote) {
       LOG(log_wr_) << "Non unique vote " << vote->getHash().abridged() << " (race condition)";
       // Create double voting proof
-      slashing_manager_->submitDoubleVotingProof(vote, *existing_vote);
+      slashing_manager_->postDoubleVotingProof(vote, *existing_vote);
       return false;
     }
 
@@ -167,14 +187,18 @@ bool VoteManager::addVerifiedVote(const std::shared_ptr<PbftVote>& vote) {
       }
     }
 
-    const auto votes_with_weight = verified_votes_.insertVotedValue(vote);
-    if (!votes_with_weight) {
+    const auto voted_value_weight = verified_votes_.insertVotedValue(vote);
+    if (!voted_value_weight) {
       return false;
     }
 
     LOG(log_nf_) << "Added verified vote: " << hash;
     LOG(log_dg_) << "Added verified vote: " << *vote;
 
+    if (vote->getPeriod() == current_pbft_period_ && vote->getRound() == current_pbft_round_) {
+      recordVoteArrival(*vote);
+    }
+
     if (is_valid_potential_reward_vote) {
       extra_reward_votes_.emplace_back(vote->getHash());
       db_->saveExtraRewardVote(vote);
@@ -187,17 +211,12 @@ bool VoteManager::addVerifiedVote(const std::shared_ptr<PbftVote>& vote) {
       return true;
     }
 
-    auto round_votes = verified_votes_.getRoundVotes(vote->getPeriod(), vote->getRound());
-    if (!round_votes) {
-      return true;
-    }
-
-    const auto total_weight = votes_with_weight->weight;
+    const auto total_weight = *voted_value_weight;
     // Calculate t+1
     const auto t_plus_one = ((*two_t_plus_one - 1) / 2) + 1;
     // Set network_t_plus_one_step - used for triggering exponential backoff
     if (vote->getType() == PbftVoteTypes::next_vote && total_weight >= t_plus_one &&
-        vote->getStep() > round_votes->network_t_plus_one_step) {
+        vote->getStep() > verified_votes_.getNetworkTPlusOneStep(vote->getPeriod(), vote->getRound())) {
       verified_votes_.setNetworkTPlusOneStep(vote);
       LOG(log_nf_) << "Set t+1 next voted block " << vote->getHash() << " for period " << vote->getPeriod()
                    << ", round " << vote->getRound() << ", step " << vote->getStep();
@@ -209,20 +228,19 @@ bool VoteManager::addVerifiedVote(const std::shared_ptr<PbftVote>& vote) {
     }
 
     // Function to save 2t+1 voted block + its votes
-    auto saveTwoTPlusOneVotesInDb = [this, &round_votes, &votes_with_weight](
-                                        TwoTPlusOneVotedBlockType two_plus_one_voted_block_type,
-                                        const std::shared_ptr<PbftVote> vote) {
-      auto found_two_t_plus_one_voted_block =
-          round_votes->two_t_plus_one_voted_blocks_.find(two_plus_one_voted_block_type);
+    auto saveTwoTPlusOneVotesInDb = [this](TwoTPlusOneVotedBlockType two_plus_one_voted_block_type,
+                                           const std::shared_ptr<PbftVote> vote) {
+      const auto found_two_t_plus_one_voted_block =
+          verified_votes_.getTwoTPlusOneVotedBlock(vote->getPeriod(), vote->getRound(), two_plus_one_voted_block_type);
 
       // 2t+1 votes block already set
-      if (found_two_t_plus_one_voted_block != round_votes->two_t_plus_one_voted_blocks_.end()) {
-        assert(found_two_t_plus_one_voted_block->second.hash == vote->getBlockHash());
+      if (found_two_t_plus_one_voted_block) {
+        assert(found_two_t_plus_one_voted_block->hash == vote->getBlockHash());
 
         // It is possible to have 2t+1 next votes for the same block in multiple steps
         if (two_plus_one_voted_block_type != TwoTPlusOneVotedBlockType::NextVotedBlock &&
             two_plus_one_voted_block_type != TwoTPlusOneVotedBlockType::NextVotedNullBlock) {
-          assert(found_two_t_plus_one_voted_block->second.step == vote->getStep());
+          assert(found_two_t_plus_one_voted_block->step == vote->getStep());
         }
 
         return;
@@ -230,18 +248,16 @@ bool VoteManager::addVerifiedVote(const std::shared_ptr<PbftVote>& vote) {
 
       // Insert new 2t+1 voted block
       verified_votes_.insertTwoTPlusOneVotedBlock(two_plus_one_voted_block_type, vote);
+      two_t_plus_one_voted_block_emitter_.emit(vote);
 
       // Save only current pbft period & round 2t+1 votes bundles into db
       // Cert votes are saved once the pbft block is pushed in the chain
       if (vote->getType() != PbftVoteTypes::cert_vote && vote->getPeriod() == current_pbft_period_ &&
           vote->getRound() == current_pbft_round_) {
-        std::vector<std::shared_ptr<PbftVote>> votes;
-        votes.reserve(votes_with_weight->votes.size());
-        for (const auto& tmp_vote : votes_with_weight->votes) {
-          votes.push_back(tmp_vote.second);
-        }
-
-        db_->replaceTwoTPlusOneVotes(two_plus_one_voted_block_type, votes);
+        db_->replaceTwoTPlusOneVotes(
+            two_plus_one_voted_block_type,
+            verified_votes_.getTwoTPlusOneVotedBlockVotes(vote->getPeriod(), vote->getRound(),
+                                                          two_plus_one_voted_block_type));
       }
     };
 
@@ -267,32 +283,118 @@ bool VoteManager::addVerifiedVote(const std::shared_ptr<PbftVote>& vote) {
   return true;
 }
 
-bool VoteManager::voteInVerifiedMap(const std::shared_ptr<PbftVote>& vote) const {
-  const auto step_votes_map = verified_votes_.getStepVotes(vote->getPeriod(), vote->getRound(), vote->getStep());
-  if (!step_votes_map) {
-    return false;
+void VoteManager::setStageTimings(std::shared_ptr<util::StageTimings> timings) { stage_timings_ = std::move(timings); }
+
+void VoteManager::recordVoteArrival(const PbftVote& vote) {
+  const auto type_index = static_cast<size_t>(vote.getType()) - 1;
+  if (type_index >= vote_arrivals_.size()) {
+    return;
   }
 
-  const auto found_voted_value_it = step_votes_map->votes.find(vote->getBlockHash());
-  if (found_voted_value_it == step_votes_map->votes.end()) {
-    return false;
+  const auto arrival = std::chrono::steady_clock::now() - current_round_start_.load();
+  vote_arrivals_[type_index].add(std::chrono::duration<double, std::milli>(arrival).count());
+  if (stage_timings_) {
+    static constexpr std::array<std::string_view, 4> kStages{"propose_vote_arrival", "soft_vote_arrival",
+                                                             "cert_vote_arrival", "next_vote_arrival"};
+    stage_timings_->record(kStages[type_index], arrival);
   }
+}
 
-  return found_voted_value_it->second.votes.find(vote->getHash()) != found_voted_value_it->second.votes.end();
+std::optional<std::chrono::milliseconds> VoteManager::getVoteArrivalPercentile(PbftVoteTypes type,
+                                                                              double percentile) const {
+  const auto type_index = static_cast<size_t>(type) - 1;
+  if (type_index >= vote_arrivals_.size()) {
+    return {};
+  }
+
+  const auto arrival = vote_arrivals_[type_index].percentile(percentile, kMinVoteArrivalSamples);
+  if (!arrival) {
+    return {};
+  }
+  return std::chrono::milliseconds(static_cast<int64_t>(*arrival));
 }
 
-std::pair<bool, std::shared_ptr<PbftVote>> VoteManager::isUniqueVote(const std::shared_ptr<PbftVote>& vote) const {
-  const auto step_votes_map = verified_votes_.getStepVotes(vote->getPeriod(), vote->getRound(), vote->getStep());
-  if (!step_votes_map) {
-    return {true, nullptr};
+void VoteManager::precomputeVrfSortitions(PbftPeriod period, PbftRound round) {
+  {
+    std::unique_lock lock(precomputed_vrf_sortitions_mutex_);
+    // Rounds before current one are not going to be voted in anymore
+    const auto current_round = std::make_pair(current_pbft_period_.load(), current_pbft_round_.load());
+    precomputed_vrf_sortitions_.erase(
+        precomputed_vrf_sortitions_.begin(),
+        precomputed_vrf_sortitions_.lower_bound({current_round.first, current_round.second, 0, addr_t{}}));
+    precomputed_vrf_rounds_.erase(precomputed_vrf_rounds_.begin(), precomputed_vrf_rounds_.lower_bound(current_round));
+
+    if (!precomputed_vrf_rounds_.emplace(period, round).second) {
+      return;
+    }
+  }
+
+  for (const auto& wallet : kWallets) {
+    vrf_precompute_thread_pool_.post([this, period, round, &wallet] {
+      static constexpr std::array<PbftVoteTypes, kPrecomputedVrfSteps> kStepsTypes{
+          PbftVoteTypes::propose_vote, PbftVoteTypes::soft_vote, PbftVoteTypes::cert_vote, PbftVoteTypes::next_vote,
+          PbftVoteTypes::next_vote};
+      for (PbftStep step = 1; step <= kPrecomputedVrfSteps; step++) {
+        {
+          // Round was already left, e.g. during syncing
+          std::shared_lock lock(precomputed_vrf_sortitions_mutex_);
+          if (!precomputed_vrf_rounds_.contains({period, round})) {
+            return;
+          }
+        }
+
+        VrfPbftSortition vrf_sortition(wallet.vrf_secret, {kStepsTypes[step - 1], period, round, step});
+
+        std::unique_lock lock(precomputed_vrf_sortitions_mutex_);
+        if (!precomputed_vrf_rounds_.contains({period, round})) {
+          return;
+        }
+        precomputed_vrf_sortitions_.emplace(std::make_tuple(period, round, step, wallet.node_addr),
+                                            std::move(vrf_sortition));
+      }
+    });
+  }
+}
+
+VrfPbftSortition VoteManager::getVrfSortition(const WalletConfig& wallet, const VrfPbftMsg& msg) const {
+  {
+    std::shared_lock lock(precomputed_vrf_sortitions_mutex_);
+    if (const auto it = precomputed_vrf_sortitions_.find({msg.period_, msg.round_, msg.step_, wallet.node_addr});
+        it != precomputed_vrf_sortitions_.end()) {
+      return it->second;
+    }
   }
 
-  const auto found_voter_it = step_votes_map->unique_voters.find(vote->getVoterAddr());
-  if (found_voter_it == step_votes_map->unique_voters.end()) {
+  return VrfPbftSortition(wallet.vrf_secret, msg);
+}
+
+bool VoteManager::voteInVerifiedMap(const std::shared_ptr<PbftVote>& vote) const {
+  return verified_votes_.containsVote(vote);
+}
+
+std::shared_ptr<PbftVote> VoteManager::getVerifiedVote(const std::shared_ptr<PbftVote>& vote) const {
+  const auto voter_votes =
+      verified_votes_.getUniqueVoter(vote->getPeriod(), vote->getRound(), vote->getStep(), vote->getVoterAddr());
+  if (!voter_votes) {
+    return nullptr;
+  }
+
+  for (const auto& verified_vote : {voter_votes->first, voter_votes->second}) {
+    if (verified_vote && verified_vote->getHash() == vote->getHash()) {
+      return verified_vote;
+    }
+  }
+  return nullptr;
+}
+
+std::pair<bool, std::shared_ptr<PbftVote>> VoteManager::isUniqueVote(const std::shared_ptr<PbftVote>& vote) const {
+  const auto voter_votes =
+      verified_votes_.getUniqueVoter(vote->getPeriod(), vote->getRound(), vote->getStep(), vote->getVoterAddr());
+  if (!voter_votes) {
     return {true, nullptr};
   }
 
-  if (found_voter_it->second.first->getHash() == vote->getHash()) {
+  if (voter_votes->first->getHash() == vote->getHash()) {
     return {true, nullptr};
   }
 
@@ -300,15 +402,14 @@ std::pair<bool, std::shared_ptr<PbftVote>> VoteManager::isUniqueVote(const std::
   // some other specific block hash at the same time -> 2 unique votes per round & step & voter
   if (vote->getType() == PbftVoteTypes::next_vote && vote->getStep() % 2) {
     // New second next vote
-    if (found_voter_it->second.second == nullptr) {
+    if (voter_votes->second == nullptr) {
       // One of the next votes == kNullBlockHash -> valid scenario
-      if (found_voter_it->second.first->getBlockHash() == kNullBlockHash && vote->getBlockHash() != kNullBlockHash) {
+      if (voter_votes->first->getBlockHash() == kNullBlockHash && vote->getBlockHash() != kNullBlockHash) {
         return {true, nullptr};
-      } else if (found_voter_it->second.first->getBlockHash() != kNullBlockHash &&
-                 vote->getBlockHash() == kNullBlockHash) {
+      } else if (voter_votes->first->getBlockHash() != kNullBlockHash && vote->getBlockHash() == kNullBlockHash) {
         return {true, nullptr};
       }
-    } else if (found_voter_it->second.second->getHash() == vote->getHash()) {
+    } else if (voter_votes->second->getHash() == vote->getHash()) {
       return {true, nullptr};
     }
   }
@@ -316,20 +417,20 @@ std::pair<bool, std::shared_ptr<PbftVote>> VoteManager::isUniqueVote(const std::
   std::stringstream err;
   err << "Non unique vote: " << ", new vote hash (voted value): " << vote->getHash().abridged() << " ("
       << vote->getBlockHash().abridged() << ")"
-      << ", orig. vote hash (voted value): " << found_voter_it->second.first->getHash().abridged() << " ("
-      << found_voter_it->second.first->getBlockHash().abridged() << ")";
-  if (found_voter_it->second.second != nullptr) {
-    err << ", orig. vote 2 hash (voted value): " << found_voter_it->second.second->getHash().abridged() << " ("
-        << found_voter_it->second.second->getBlockHash().abridged() << ")";
+      << ", orig. vote hash (voted value): " << voter_votes->first->getHash().abridged() << " ("
+      << voter_votes->first->getBlockHash().abridged() << ")";
+  if (voter_votes->second != nullptr) {
+    err << ", orig. vote 2 hash (voted value): " << voter_votes->second->getHash().abridged() << " ("
+        << voter_votes->second->getBlockHash().abridged() << ")";
   }
   err << ", round: " << vote->getRound() << ", step: " << vote->getStep() << ", voter: " << vote->getVoterAddr();
   LOG(log_er_) << err.str();
 
   // Return existing vote
-  if (found_voter_it->second.second && vote->getHash() != found_voter_it->second.second->getHash()) {
-    return {false, found_voter_it->second.second};
+  if (voter_votes->second && vote->getHash() != voter_votes->second->getHash()) {
+    return {false, voter_votes->second};
   }
-  return {false, found_voter_it->second.first};
+  return {false, voter_votes->first};
 }
 
 std::vector<std::shared_ptr<PbftVote>> VoteManager::getProposalVotes(PbftPeriod period, PbftRound round) const {
@@ -671,11 +772,76 @@ std::shared_ptr<PbftVote> VoteManager::generateVoteWithWeight(const taraxa::blk_
 std::shared_ptr<PbftVote> VoteManager::generateVote(const blk_hash_t& blockhash, PbftVoteTypes type, PbftPeriod period,
                                                     PbftRound round, PbftStep step, const WalletConfig& wallet) {
   // sortition proof
-  VrfPbftSortition vrf_sortition(wallet.vrf_secret, {type, period, round, step});
-  return std::make_shared<PbftVote>(wallet.node_secret, std::move(vrf_sortition), blockhash);
+  auto vrf_sortition = getVrfSortition(wallet, {type, period, round, step});
+  return util::makeShared<PbftVote>(wallet.node_secret, std::move(vrf_sortition), blockhash);
 }
 
 std::pair<bool, std::string> VoteManager::validateVote(const std::shared_ptr<PbftVote>& vote, bool strict) const {
+  return validateVote(vote, strict, std::nullopt);
+}
+
+std::vector<std::pair<bool, std::string>> VoteManager::validateVotesBatch(
+    const std::vector<std::shared_ptr<PbftVote>>& votes, bool strict, bool verify_signatures) const {
+  std::vector<std::pair<bool, std::string>> results(votes.size());
+
+  // Deduplicate before doing any crypto. Weight is set only on the first vote object with the same hash, so duplicates
+  // are reported as invalid
+  std::unordered_set<vote_hash_t> unique_votes_hashes;
+  std::vector<size_t> unique_votes;
+  unique_votes.reserve(votes.size());
+  for (size_t i = 0; i < votes.size(); i++) {
+    if (unique_votes_hashes.insert(votes[i]->getHash()).second) {
+      unique_votes.push_back(i);
+    } else {
+      results[i] = {false, "Duplicate vote " + votes[i]->getHash().abridged() + " in batch"};
+    }
+  }
+
+  // Total dpos votes count is the same for all votes from the same period
+  std::unordered_map<PbftPeriod, std::optional<uint64_t>> total_dpos_votes_counts;
+  for (const auto idx : unique_votes) {
+    const auto vote_period = votes[idx]->getPeriod();
+    if (total_dpos_votes_counts.contains(vote_period)) {
+      continue;
+    }
+    auto& total_dpos_votes_count = total_dpos_votes_counts[vote_period];
+    try {
+      total_dpos_votes_count = final_chain_->dposEligibleTotalVoteCount(vote_period - 1);
+    } catch (...) {
+      // Reported by validateVote of each vote from the period
+    }
+  }
+
+  const auto validate = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      const auto& vote = votes[unique_votes[i]];
+      results[unique_votes[i]] =
+          validateVote(vote, strict, total_dpos_votes_counts.at(vote->getPeriod()), verify_signatures);
+    }
+  };
+
+  if (unique_votes.size() < kMinParallelVotesValidations) {
+    validate(0, unique_votes.size());
+  } else {
+    const size_t chunk_size =
+        (unique_votes.size() + kVotesValidationTasksCount - 1) / kVotesValidationTasksCount;
+    std::vector<std::future<void>> futures;
+    futures.reserve(kVotesValidationTasksCount);
+    for (size_t begin = 0; begin < unique_votes.size(); begin += chunk_size) {
+      futures.push_back(votes_validation_executor_.post(
+          [&validate, begin, end = std::min(begin + chunk_size, unique_votes.size())] { validate(begin, end); }));
+    }
+    for (auto& future : futures) {
+      future.get();
+    }
+  }
+
+  return results;
+}
+
+std::pair<bool, std::string> VoteManager::validateVote(const std::shared_ptr<PbftVote>& vote, bool strict,
+                                                       std::optional<uint64_t> total_dpos_votes_count,
+                                                       bool verify_signatures) const {
   std::stringstream err_msg;
   const uint64_t vote_period = vote->getPeriod();
 
@@ -698,19 +864,21 @@ std::pair<bool, std::string> VoteManager::validateVote(const std::shared_ptr<Pbf
       return {false, err_msg.str()};
     }
 
-    if (!vote->verifyVote()) {
+    if (verify_signatures && !vote->verifyVote()) {
       err_msg << "Invalid vote " << vote->getHash() << ": invalid signature";
       return {false, err_msg.str()};
     }
 
-    if (!vote->verifyVrfSortition(*pk, strict)) {
+    if (verify_signatures && !vote->verifyVrfSortition(*pk, strict)) {
       err_msg << "Invalid vote " << vote->getHash() << ": invalid vrf proof";
       return {false, err_msg.str()};
     }
 
-    const uint64_t total_dpos_votes_count = final_chain_->dposEligibleTotalVoteCount(vote_period - 1);
-    const uint64_t pbft_sortition_threshold = getPbftSortitionThreshold(total_dpos_votes_count, vote->getType());
-    if (!vote->calculateWeight(voter_dpos_votes_count, total_dpos_votes_count, pbft_sortition_threshold)) {
+    if (!total_dpos_votes_count.has_value()) {
+      total_dpos_votes_count = final_chain_->dposEligibleTotalVoteCount(vote_period - 1);
+    }
+    const uint64_t pbft_sortition_threshold = getPbftSortitionThreshold(*total_dpos_votes_count, vote->getType());
+    if (!vote->calculateWeight(voter_dpos_votes_count, *total_dpos_votes_count, pbft_sortition_threshold)) {
       err_msg << "Invalid vote " << vote->getHash() << ": zero weight";
       return {false, err_msg.str()};
     }
@@ -767,7 +935,7 @@ bool VoteManager::voteAlreadyValidated(const vote_hash_t& vote_hash) const {
 
 bool VoteManager::genAndValidateVrfSortition(PbftPeriod pbft_period, PbftRound pbft_round,
                                              const WalletConfig& wallet) const {
-  VrfPbftSortition vrf_sortition(wallet.vrf_secret, {PbftVoteTypes::propose_vote, pbft_period, pbft_round, 1});
+  const auto vrf_sortition = getVrfSortition(wallet, {PbftVoteTypes::propose_vote, pbft_period, pbft_round, 1});
 
   try {
     const uint64_t voter_dpos_votes_count = final_chain_->dposEligibleVoteCount(pbft_period - 1, wallet.node_addr);
@@ -811,6 +979,24 @@ std::vector<std::shared_ptr<PbftVote>> VoteManager::getTwoTPlusOneVotedBlockVote
   return verified_votes_.getTwoTPlusOneVotedBlockVotes(period, round, type);
 }
 
+std::shared_ptr<const VoteManager::TwoTPlusOneVotesBundle> VoteManager::getTwoTPlusOneVotesBundle(
+    PbftPeriod period, PbftRound round, TwoTPlusOneVotedBlockType type) const {
+  auto votes = verified_votes_.getTwoTPlusOneVotedBlockVotes(period, round, type);
+  if (votes.empty()) {
+    return nullptr;
+  }
+
+  // Voted block of the type never changes and its votes are only added, so the same count means the same votes.
+  // Lock is held while encoding so that peers requesting the same bundle at once wait for a single encoding
+  std::scoped_lock lock(two_t_plus_one_votes_bundles_mutex_);
+  auto& bundle = two_t_plus_one_votes_bundles_[{period, round, type}];
+  if (!bundle || bundle->votes.size() != votes.size()) {
+    auto rlp = std::make_shared<const dev::bytes>(encodePbftVotesBundleRlp(votes));
+    bundle = std::make_shared<const TwoTPlusOneVotesBundle>(TwoTPlusOneVotesBundle{std::move(votes), std::move(rlp)});
+  }
+  return bundle;
+}
+
 StepVotes VoteManager::getStepVotes(PbftPeriod period, PbftRound round, PbftStep step) const {
   const auto step_votes = verified_votes_.getStepVotes(period, round, step);
   if (!step_votes) {
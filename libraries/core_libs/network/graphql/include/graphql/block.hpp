@@ -5,6 +5,7 @@
 
 #include "BlockObject.h"
 #include "final_chain/final_chain.hpp"
+#include "graphql/data_loader.hpp"
 #include "transaction/transaction_manager.hpp"
 
 namespace graphql::taraxa {
@@ -14,7 +15,8 @@ class Block {
                  std::shared_ptr<::taraxa::TransactionManager> trx_manager,
                  std::function<std::shared_ptr<object::Block>(::taraxa::EthBlockNumber)> get_block_by_num,
                  const ::taraxa::blk_hash_t& pbft_block_hash,
-                 std::shared_ptr<const ::taraxa::final_chain::BlockHeader> block_header) noexcept;
+                 std::shared_ptr<const ::taraxa::final_chain::BlockHeader> block_header,
+                 std::shared_ptr<const DataLoader> data_loader = nullptr) noexcept;
 
   response::Value getNumber() const noexcept;
   response::Value getHash() const noexcept;
@@ -46,11 +48,16 @@ class Block {
   response::Value getEstimateGas(CallData&& dataArg) const noexcept;
 
  private:
+  const std::vector<std::shared_ptr<::taraxa::Transaction>>& loadTransactions() const;
+  std::shared_ptr<object::Transaction> makeTransaction(uint32_t index) const;
+
   std::shared_ptr<::taraxa::final_chain::FinalChain> final_chain_;
   std::shared_ptr<::taraxa::TransactionManager> trx_manager_;
   std::function<std::shared_ptr<object::Block>(::taraxa::EthBlockNumber)> get_block_by_num_;
   const ::taraxa::blk_hash_t kPBftBlockHash;
   std::shared_ptr<const ::taraxa::final_chain::BlockHeader> block_header_;
+  // Set when block is resolved as part of a list, data is then read in batches for all blocks of the list
+  std::shared_ptr<const DataLoader> data_loader_;
   mutable std::vector<std::shared_ptr<::taraxa::Transaction>> transactions_;
 };
 
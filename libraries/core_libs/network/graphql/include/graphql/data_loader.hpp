@@ -0,0 +1,56 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "final_chain/final_chain.hpp"
+#include "storage/storage.hpp"
+
+namespace graphql::taraxa {
+
+/**
+ * @brief Per request loader of final chain data for a set of blocks resolved by a single query
+ *
+ * Keys are collected when list of blocks is resolved, then data of all blocks is read with batched db lookups on
+ * the first access by any of resolvers instead of separate lookups for each field of each block
+ */
+class DataLoader {
+ public:
+  DataLoader(std::shared_ptr<::taraxa::final_chain::FinalChain> final_chain, std::shared_ptr<::taraxa::DbStorage> db,
+             const std::vector<::taraxa::EthBlockNumber>& blocks);
+
+  bool contains(::taraxa::EthBlockNumber blk_n) const { return blocks_.contains(blk_n); }
+
+  /**
+   * @return header of the block, nullptr for blocks without data
+   */
+  std::shared_ptr<const ::taraxa::final_chain::BlockHeader> header(::taraxa::EthBlockNumber blk_n) const;
+  std::optional<::taraxa::blk_hash_t> pbftBlockHash(::taraxa::EthBlockNumber blk_n) const;
+  size_t transactionCount(::taraxa::EthBlockNumber blk_n) const;
+  const ::taraxa::SharedTransactions& transactions(::taraxa::EthBlockNumber blk_n) const;
+  std::optional<::taraxa::TransactionReceipt> receipt(::taraxa::EthBlockNumber blk_n, uint32_t position) const;
+
+ private:
+  struct BlockData {
+    std::shared_ptr<const ::taraxa::final_chain::BlockHeader> header;
+    ::taraxa::PeriodDataView period_data;
+    // Decoded from period data on first access
+    std::optional<::taraxa::SharedTransactions> transactions;
+    ::taraxa::SharedTransactionReceipts receipts;
+  };
+
+  const BlockData* get(::taraxa::EthBlockNumber blk_n) const;
+  void loadReceipts() const;
+
+  std::shared_ptr<::taraxa::final_chain::FinalChain> final_chain_;
+  std::shared_ptr<::taraxa::DbStorage> db_;
+  // Set of keys is fixed in constructor, only lazily loaded fields are modified later
+  mutable std::map<::taraxa::EthBlockNumber, BlockData> blocks_;
+  mutable std::mutex mutex_;
+  mutable bool receipts_loaded_ = false;
+};
+
+}  // namespace graphql::taraxa
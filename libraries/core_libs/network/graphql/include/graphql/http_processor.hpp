@@ -6,6 +6,7 @@
 #include "network/http_server.hpp"
 #include "network/network.hpp"
 #include "query.hpp"
+#include "query_cache.hpp"
 #include "subscription.hpp"
 #include "transaction/gas_pricer.hpp"
 namespace taraxa::net {
@@ -16,7 +17,8 @@ class GraphQlHttpProcessor final : public HttpProcessor {
                        std::shared_ptr<::taraxa::PbftManager> pbft_manager,
                        std::shared_ptr<::taraxa::TransactionManager> transaction_manager,
                        std::shared_ptr<::taraxa::DbStorage> db, std::shared_ptr<::taraxa::GasPricer> gas_pricer,
-                       std::weak_ptr<::taraxa::Network> network, uint64_t chain_id);
+                       std::weak_ptr<::taraxa::Network> network, uint64_t chain_id, uint64_t max_query_cost = 0,
+                       size_t query_cache_size = 0);
   Response process(const Request& request) override;
 
  private:
@@ -29,6 +31,10 @@ class GraphQlHttpProcessor final : public HttpProcessor {
   std::shared_ptr<graphql::taraxa::Mutation> mutation_;
   std::shared_ptr<graphql::taraxa::Subscription> subscription_;
   graphql::taraxa::Operations operations_;
+  // Queries with higher estimated cost are rejected before execution, 0 = unlimited
+  const uint64_t kMaxQueryCost;
+  // Parsed and validated documents of repeated and persisted queries, nullptr = disabled
+  std::unique_ptr<graphql::taraxa::QueryCache> query_cache_;
 };
 
 }  // namespace taraxa::net
\ No newline at end of file
@@ -35,10 +35,10 @@ class Query {
                                                               std::optional<bool>&& reverseArg) const;
   std::shared_ptr<object::CurrentState> getNodeState() const;
 
- private:
   // TODO: use pagination limit for all "list" queries
   static constexpr size_t kMaxPropagationLimit{100};
 
+ private:
   std::shared_ptr<::taraxa::final_chain::FinalChain> final_chain_;
   std::shared_ptr<::taraxa::DagManager> dag_manager_;
   std::shared_ptr<::taraxa::PbftManager> pbft_manager_;
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "graphqlservice/GraphQLParse.h"
+
+namespace graphql::taraxa {
+
+/**
+ * @brief LRU cache of parsed and validated query documents keyed by sha256 of the query text
+ *
+ * Key is the same hash that clients send as persisted query id (extensions.persistedQuery.sha256Hash), so hash-only
+ * requests are served from it. Parsed document is immutable and shared by copies of peg::ast, it is only read during
+ * execution. Only documents that passed validation are inserted, so cached copies skip validation as well.
+ */
+class QueryCache {
+ public:
+  explicit QueryCache(size_t max_entries) : kMaxEntries(max_entries) {}
+
+  /**
+   * @return lowercase hex sha256 of the query text
+   */
+  static std::string hash(std::string_view query);
+
+  std::optional<peg::ast> get(const std::string& hash);
+  void insert(const std::string& hash, const peg::ast& query);
+
+  uint64_t hits() const { return hits_; }
+  uint64_t misses() const { return misses_; }
+  size_t size() const;
+
+ private:
+  struct Entry {
+    std::string hash;
+    peg::ast query;
+  };
+
+  const size_t kMaxEntries;
+
+  mutable std::mutex mutex_;
+  // Most recently used entries are at the front
+  std::list<Entry> lru_;
+  std::unordered_map<std::string_view, std::list<Entry>::iterator> entries_;
+
+  std::atomic<uint64_t> hits_ = 0;
+  std::atomic<uint64_t> misses_ = 0;
+};
+
+}  // namespace graphql::taraxa
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+#include "graphqlservice/GraphQLParse.h"
+#include "graphqlservice/GraphQLResponse.h"
+
+namespace graphql::taraxa {
+
+/**
+ * @brief Static estimate of the number of fields a query resolves, computed from the parsed document before it is
+ * executed
+ *
+ * Every field costs 1 for each object it is resolved on. List fields multiply the cost of their selections by the
+ * number of items they return: requested range of blocks, count of dag blocks and kAssumedListSize for lists whose size
+ * is not known upfront (transactions, logs, ...). Estimate of all operations of the document is summed up
+ */
+class QueryCostEstimator {
+ public:
+  // Items of lists that don't have size in arguments, roughly transactions of a full block
+  static constexpr uint64_t kAssumedListSize = 100;
+
+  /**
+   * @param max_range maximal number of items returned by range queries
+   */
+  QueryCostEstimator(const peg::ast& query, const response::Value& variables, uint64_t max_range);
+
+  /**
+   * @return estimated cost, estimation stops once it exceeds limit
+   */
+  uint64_t estimate(uint64_t limit = UINT64_MAX);
+
+ private:
+  void selectionSet(const peg::ast_node& selection_set, uint64_t multiplier, uint32_t depth);
+  uint64_t listSize(std::string_view field, const peg::ast_node* arguments) const;
+  std::optional<int64_t> intArgument(const peg::ast_node* arguments, std::string_view name) const;
+
+  const peg::ast& query_;
+  const response::Value& variables_;
+  const uint64_t kMaxRange;
+  std::unordered_map<std::string_view, const peg::ast_node*> fragments_;
+  uint64_t cost_ = 0;
+  uint64_t limit_ = UINT64_MAX;
+};
+
+}  // namespace graphql::taraxa
@@ -6,6 +6,7 @@
 
 #include "TransactionObject.h"
 #include "final_chain/final_chain.hpp"
+#include "graphql/data_loader.hpp"
 #include "transaction/receipt.hpp"
 #include "transaction/transaction_manager.hpp"
 
@@ -17,6 +18,12 @@ class Transaction final : public std::enable_shared_from_this<Transaction> {
                        std::shared_ptr<::taraxa::TransactionManager> trx_manager,
                        std::function<std::shared_ptr<object::Block>(::taraxa::EthBlockNumber)>,
                        std::shared_ptr<::taraxa::Transaction> transaction) noexcept;
+  // Transaction of a block resolved with data loader, receipt is read in batch with receipts of other blocks
+  explicit Transaction(std::shared_ptr<::taraxa::final_chain::FinalChain> final_chain,
+                       std::shared_ptr<::taraxa::TransactionManager> trx_manager,
+                       std::function<std::shared_ptr<object::Block>(::taraxa::EthBlockNumber)>,
+                       std::shared_ptr<::taraxa::Transaction> transaction, ::taraxa::TransactionLocation location,
+                       std::shared_ptr<const DataLoader> data_loader) noexcept;
 
   response::Value getHash() const noexcept;
   response::Value getNonce() const noexcept;
@@ -38,6 +45,8 @@ class Transaction final : public std::enable_shared_from_this<Transaction> {
   response::Value getV() const noexcept;
 
  private:
+  bool loadReceipt() const;
+
   std::shared_ptr<::taraxa::final_chain::FinalChain> final_chain_;
   std::shared_ptr<::taraxa::TransactionManager> trx_manager_;
   std::function<std::shared_ptr<object::Block>(::taraxa::EthBlockNumber)> get_block_by_num_;
@@ -45,6 +54,7 @@ class Transaction final : public std::enable_shared_from_this<Transaction> {
   // Caching for performance
   mutable std::optional<::taraxa::TransactionReceipt> receipt_;
   ::taraxa::TransactionLocation location_;
+  std::shared_ptr<const DataLoader> data_loader_;
 };
 
 }  // namespace graphql::taraxa
\ No newline at end of file
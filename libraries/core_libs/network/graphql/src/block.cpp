@@ -15,12 +15,14 @@ Block::Block(std::shared_ptr<::taraxa::final_chain::FinalChain> final_chain,
              std::shared_ptr<::taraxa::TransactionManager> trx_manager,
              std::function<std::shared_ptr<object::Block>(::taraxa::EthBlockNumber)> get_block_by_num,
              const ::taraxa::blk_hash_t& pbft_block_hash,
-             std::shared_ptr<const ::taraxa::final_chain::BlockHeader> block_header) noexcept
+             std::shared_ptr<const ::taraxa::final_chain::BlockHeader> block_header,
+             std::shared_ptr<const DataLoader> data_loader) noexcept
     : final_chain_(std::move(final_chain)),
       trx_manager_(std::move(trx_manager)),
       get_block_by_num_(std::move(get_block_by_num)),
       kPBftBlockHash(pbft_block_hash),
-      block_header_(std::move(block_header)) {}
+      block_header_(std::move(block_header)),
+      data_loader_(std::move(data_loader)) {}
 
 response::Value Block::getNumber() const noexcept { return response::Value(static_cast<int>(block_header_->number)); }
 
@@ -29,7 +31,17 @@ response::Value Block::getHash() const noexcept { return response::Value(block_h
 response::Value Block::getPbftHash() const noexcept { return response::Value(kPBftBlockHash.toString()); }
 
 std::shared_ptr<object::Block> Block::getParent() const noexcept {
-  return get_block_by_num_(block_header_->number - 1);
+  const auto parent_number = block_header_->number - 1;
+  if (data_loader_ && data_loader_->contains(parent_number)) {
+    const auto header = data_loader_->header(parent_number);
+    const auto pbft_block_hash = data_loader_->pbftBlockHash(parent_number);
+    if (!header || !pbft_block_hash) {
+      return nullptr;
+    }
+    return std::make_shared<object::Block>(std::make_shared<Block>(final_chain_, trx_manager_, get_block_by_num_,
+                                                                   *pbft_block_hash, header, data_loader_));
+  }
+  return get_block_by_num_(parent_number);
 }
 
 response::Value Block::getNonce() const noexcept { return response::Value(block_header_->nonce().toString()); }
@@ -39,6 +51,9 @@ response::Value Block::getTransactionsRoot() const noexcept {
 }
 
 std::optional<int> Block::getTransactionCount() const noexcept {
+  if (data_loader_) {
+    return static_cast<int>(data_loader_->transactionCount(block_header_->number));
+  }
   if (!transactions_.size()) {
     return std::optional<int>(final_chain_->transactionCount(block_header_->number));
   } else {
@@ -93,30 +108,41 @@ std::shared_ptr<object::Block> Block::getOmmerAt(int&&) const noexcept { return
 
 response::Value Block::getOmmerHash() const noexcept { return response::Value(block_header_->unclesHash().toString()); }
 
-std::optional<std::vector<std::shared_ptr<object::Transaction>>> Block::getTransactions() const noexcept {
-  std::vector<std::shared_ptr<object::Transaction>> ret;
+const std::vector<std::shared_ptr<::taraxa::Transaction>>& Block::loadTransactions() const {
   if (!transactions_.size()) {
-    transactions_ = final_chain_->transactions(block_header_->number);
-    if (!transactions_.size()) return std::nullopt;
+    transactions_ = data_loader_ ? data_loader_->transactions(block_header_->number)
+                                 : final_chain_->transactions(block_header_->number);
   }
+  return transactions_;
+}
+
+std::shared_ptr<object::Transaction> Block::makeTransaction(uint32_t index) const {
+  if (data_loader_) {
+    // Location is known from the block, so it doesn't need to be looked up by hash
+    return std::make_shared<object::Transaction>(
+        std::make_shared<Transaction>(final_chain_, trx_manager_, get_block_by_num_, transactions_[index],
+                                      ::taraxa::TransactionLocation{block_header_->number, index}, data_loader_));
+  }
+  return std::make_shared<object::Transaction>(
+      std::make_shared<Transaction>(final_chain_, trx_manager_, get_block_by_num_, transactions_[index]));
+}
+
+std::optional<std::vector<std::shared_ptr<object::Transaction>>> Block::getTransactions() const noexcept {
+  std::vector<std::shared_ptr<object::Transaction>> ret;
+  if (!loadTransactions().size()) return std::nullopt;
   ret.reserve(transactions_.size());
-  for (auto& t : transactions_) {
-    ret.emplace_back(std::make_shared<object::Transaction>(
-        std::make_shared<Transaction>(final_chain_, trx_manager_, get_block_by_num_, t)));
+  for (uint32_t i = 0; i < transactions_.size(); ++i) {
+    ret.emplace_back(makeTransaction(i));
   }
   return ret;
 }
 
 std::shared_ptr<object::Transaction> Block::getTransactionAt(response::IntType&& index) const noexcept {
-  if (!transactions_.size()) {
-    transactions_ = final_chain_->transactions(block_header_->number);
-    if (!transactions_.size()) return nullptr;
-  }
+  if (!loadTransactions().size()) return nullptr;
   if (transactions_.size() < static_cast<size_t>(index)) {
     return nullptr;
   }
-  return std::make_shared<object::Transaction>(
-      std::make_shared<Transaction>(final_chain_, trx_manager_, get_block_by_num_, transactions_[index]));
+  return makeTransaction(index);
 }
 
 std::vector<std::shared_ptr<object::Log>> Block::getLogs(BlockFilterCriteria&&) const noexcept {
@@ -0,0 +1,89 @@
+#include "graphql/data_loader.hpp"
+
+namespace graphql::taraxa {
+
+DataLoader::DataLoader(std::shared_ptr<::taraxa::final_chain::FinalChain> final_chain,
+                       std::shared_ptr<::taraxa::DbStorage> db, const std::vector<::taraxa::EthBlockNumber>& blocks)
+    : final_chain_(std::move(final_chain)), db_(std::move(db)) {
+  auto periods_data = db_->getPeriodsDataViews(blocks);
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    auto& data = blocks_[blocks[i]];
+    data.header = final_chain_->blockHeader(blocks[i]);
+    data.period_data = std::move(periods_data[i]);
+  }
+}
+
+const DataLoader::BlockData* DataLoader::get(::taraxa::EthBlockNumber blk_n) const {
+  const auto it = blocks_.find(blk_n);
+  return it == blocks_.end() ? nullptr : &it->second;
+}
+
+std::shared_ptr<const ::taraxa::final_chain::BlockHeader> DataLoader::header(::taraxa::EthBlockNumber blk_n) const {
+  const auto data = get(blk_n);
+  return data ? data->header : nullptr;
+}
+
+std::optional<::taraxa::blk_hash_t> DataLoader::pbftBlockHash(::taraxa::EthBlockNumber blk_n) const {
+  // Genesis block has no pbft block
+  if (blk_n == 0) {
+    return ::taraxa::blk_hash_t();
+  }
+  const auto data = get(blk_n);
+  if (!data || data->period_data.empty()) {
+    return {};
+  }
+  return data->period_data.pbftBlock().getBlockHash();
+}
+
+size_t DataLoader::transactionCount(::taraxa::EthBlockNumber blk_n) const {
+  const auto data = get(blk_n);
+  if (!data || data->period_data.empty()) {
+    return 0;
+  }
+  return data->period_data.transactionsRlp().itemCount();
+}
+
+const ::taraxa::SharedTransactions& DataLoader::transactions(::taraxa::EthBlockNumber blk_n) const {
+  static const ::taraxa::SharedTransactions kEmpty;
+  const auto it = blocks_.find(blk_n);
+  if (it == blocks_.end()) {
+    return kEmpty;
+  }
+  auto& data = it->second;
+  std::scoped_lock lock(mutex_);
+  if (!data.transactions) {
+    data.transactions = data.period_data.empty() ? ::taraxa::SharedTransactions()
+                                                 : db_->transactionsFromPeriodDataRlp(blk_n, data.period_data.rlp());
+  }
+  return *data.transactions;
+}
+
+std::optional<::taraxa::TransactionReceipt> DataLoader::receipt(::taraxa::EthBlockNumber blk_n,
+                                                                uint32_t position) const {
+  loadReceipts();
+  const auto data = get(blk_n);
+  if (!data || !data->receipts || data->receipts->size() <= position) {
+    return {};
+  }
+  return data->receipts->at(position);
+}
+
+void DataLoader::loadReceipts() const {
+  std::scoped_lock lock(mutex_);
+  if (receipts_loaded_) {
+    return;
+  }
+  std::vector<::taraxa::EthBlockNumber> blocks;
+  blocks.reserve(blocks_.size());
+  for (const auto& [blk_n, _] : blocks_) {
+    blocks.push_back(blk_n);
+  }
+  auto receipts = final_chain_->blocksReceipts(blocks);
+  size_t i = 0;
+  for (auto& [_, data] : blocks_) {
+    data.receipts = std::move(receipts[i++]);
+  }
+  receipts_loaded_ = true;
+}
+
+}  // namespace graphql::taraxa
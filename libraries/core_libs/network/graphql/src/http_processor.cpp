@@ -2,6 +2,7 @@
 
 #include "common/jsoncpp.hpp"
 #include "common/util.hpp"
+#include "graphql/query_cost.hpp"
 #include "graphqlservice/GraphQLService.h"
 #include "graphqlservice/JSONResponse.h"
 
@@ -15,27 +16,34 @@ GraphQlHttpProcessor::GraphQlHttpProcessor(std::shared_ptr<::taraxa::final_chain
                                            std::shared_ptr<::taraxa::TransactionManager> transaction_manager,
                                            std::shared_ptr<::taraxa::DbStorage> db,
                                            std::shared_ptr<::taraxa::GasPricer> gas_pricer,
-                                           std::weak_ptr<::taraxa::Network> network, uint64_t chain_id)
+                                           std::weak_ptr<::taraxa::Network> network, uint64_t chain_id,
+                                           uint64_t max_query_cost, size_t query_cache_size)
     : HttpProcessor(),
       query_(std::make_shared<graphql::taraxa::Query>(std::move(final_chain), std::move(dag_manager),
                                                       std::move(pbft_manager), transaction_manager, std::move(db),
                                                       std::move(gas_pricer), std::move(network), chain_id)),
       mutation_(std::make_shared<graphql::taraxa::Mutation>(transaction_manager)),
       subscription_(std::make_shared<graphql::taraxa::Subscription>()),
-      operations_(query_, mutation_, subscription_) {}
+      operations_(query_, mutation_, subscription_),
+      kMaxQueryCost(max_query_cost),
+      query_cache_(query_cache_size ? std::make_unique<graphql::taraxa::QueryCache>(query_cache_size) : nullptr) {}
 
 HttpProcessor::Response GraphQlHttpProcessor::process(const Request& request) {
   try {
     const std::string& request_str = request.body();
 
-    peg::ast query_ast;
+    std::optional<peg::ast> query_ast;
+    // Query text, it is not sent in hash-only requests of persisted queries
+    std::optional<std::string> query_str;
+    // Hash of the query text, set only when cache is enabled
+    std::string query_hash;
     response::Value variables{response::Type::Map};
     std::string operation_name{""};
 
     // Differenciate content type: 'application/json' vs 'application/graphql'
     // according to https://graphql.org/learn/serving-over-http/
     if (request.count("Content-Type") && request["Content-Type"] == "application/graphql") {
-      query_ast = peg::parseString(request_str);
+      query_str = request_str;
     } else {  // default is "application/json"
 
       Json::Value json;
@@ -46,10 +54,24 @@ HttpProcessor::Response GraphQlHttpProcessor::process(const Request& request) {
       }
 
       const std::string query_key{service::strQuery};
-      if (!json.isMember(query_key)) {
+      if (json.isMember(query_key)) {
+        query_str = json[query_key].asString();
+      }
+
+      // Persisted query id as sent by apollo clients
+      if (const auto& persisted_hash = json["extensions"]["persistedQuery"]["sha256Hash"]; persisted_hash.isString()) {
+        if (!query_cache_) {
+          return createErrResponse("PersistedQueryNotSupported");
+        }
+        query_hash = persisted_hash.asString();
+        if (query_str && graphql::taraxa::QueryCache::hash(*query_str) != query_hash) {
+          return createErrResponse("provided sha does not match query");
+        }
+      }
+
+      if (!query_str && query_hash.empty()) {
         return createErrResponse("Invalid request json data: Missing \'query\' in graphql request");
       }
-      query_ast = peg::parseString(json[query_key].asString());
 
       // operationName field is optional
       if (json.isMember("operationName")) {
@@ -65,7 +87,35 @@ HttpProcessor::Response GraphQlHttpProcessor::process(const Request& request) {
       }
     }
 
-    auto result = operations_.resolve({query_ast, operation_name, std::move(variables), {}, nullptr}).get();
+    if (query_cache_) {
+      if (query_hash.empty()) {
+        query_hash = graphql::taraxa::QueryCache::hash(*query_str);
+      }
+      query_ast = query_cache_->get(query_hash);
+      if (!query_ast && !query_str) {
+        return createErrResponse("PersistedQueryNotFound");
+      }
+    }
+    const bool cached = query_ast.has_value();
+    if (!cached) {
+      query_ast = peg::parseString(*query_str);
+    }
+
+    if (kMaxQueryCost) {
+      // Cost depends on variables, so it is estimated also for cached documents
+      graphql::taraxa::QueryCostEstimator estimator(*query_ast, variables,
+                                                    graphql::taraxa::Query::kMaxPropagationLimit + 1);
+      if (estimator.estimate(kMaxQueryCost) > kMaxQueryCost) {
+        return createErrResponse("Query cost exceeds limit of " + std::to_string(kMaxQueryCost) +
+                                 ", request smaller ranges or fewer nested fields");
+      }
+    }
+
+    // Cached document is already validated, so resolve skips validation
+    auto result = operations_.resolve({*query_ast, operation_name, std::move(variables), {}, nullptr}).get();
+    if (query_cache_ && !cached) {
+      query_cache_->insert(query_hash, *query_ast);
+    }
     return createOkResponse(response::toJSON(std::move(result)));
 
   } catch (const Json::Exception& e) {
@@ -105,7 +155,6 @@ HttpProcessor::Response GraphQlHttpProcessor::createOkResponse(std::string&& res
   response.set("Content-Type", "application/json");
   response.set("Access-Control-Allow-Origin", "*");
   response.set("Access-Control-Allow-Headers", "Accept, Accept-Language, Content-Language, Content-Type");
-  response.set("Connection", "close");
   response.result(boost::beast::http::status::ok);
   response.body() = std::move(response_body);
   response.prepare_payload();
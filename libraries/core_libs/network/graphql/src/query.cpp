@@ -92,10 +92,24 @@ std::vector<std::shared_ptr<object::Block>> Query::getBlocks(response::Value&& f
     end_block_num = last_block_number;
   }
 
-  blocks.reserve(end_block_num - start_block_num);
-
+  std::vector<::taraxa::EthBlockNumber> block_numbers;
+  block_numbers.reserve(end_block_num - start_block_num + 1);
   for (int block_num = start_block_num; block_num <= end_block_num; block_num++) {
-    blocks.emplace_back(getBlock(response::Value(block_num), std::nullopt));
+    block_numbers.push_back(block_num);
+  }
+  // Shared by all blocks of the list, so their transactions and receipts are read in batches
+  const auto data_loader = std::make_shared<const DataLoader>(final_chain_, db_, block_numbers);
+
+  blocks.reserve(block_numbers.size());
+  for (const auto block_num : block_numbers) {
+    const auto block_header = data_loader->header(block_num);
+    const auto pbft_block_hash = data_loader->pbftBlockHash(block_num);
+    if (!block_header || !pbft_block_hash) {
+      blocks.emplace_back(nullptr);
+      continue;
+    }
+    blocks.emplace_back(std::make_shared<object::Block>(std::make_shared<Block>(
+        final_chain_, transaction_manager_, get_block_by_num_, *pbft_block_hash, block_header, data_loader)));
   }
 
   return blocks;
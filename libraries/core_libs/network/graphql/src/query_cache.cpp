@@ -0,0 +1,56 @@
+#include "graphql/query_cache.hpp"
+
+#include <cryptopp/sha.h>
+#include <libdevcore/CommonData.h>
+
+namespace graphql::taraxa {
+
+std::string QueryCache::hash(std::string_view query) {
+  dev::bytes digest(CryptoPP::SHA256::DIGESTSIZE);
+  CryptoPP::SHA256 ctx;
+  ctx.Update(reinterpret_cast<const CryptoPP::byte*>(query.data()), query.size());
+  ctx.Final(digest.data());
+  return dev::toHex(digest);
+}
+
+std::optional<peg::ast> QueryCache::get(const std::string& hash) {
+  std::unique_lock lock(mutex_);
+  const auto entry = entries_.find(hash);
+  if (entry == entries_.end()) {
+    lock.unlock();
+    ++misses_;
+    return {};
+  }
+  lru_.splice(lru_.begin(), lru_, entry->second);
+  auto query = entry->second->query;
+  lock.unlock();
+
+  ++hits_;
+  return query;
+}
+
+void QueryCache::insert(const std::string& hash, const peg::ast& query) {
+  if (!kMaxEntries || !query.validated) {
+    return;
+  }
+
+  std::scoped_lock lock(mutex_);
+  // Same query could be already inserted by another thread
+  if (entries_.contains(hash)) {
+    return;
+  }
+  while (lru_.size() >= kMaxEntries) {
+    entries_.erase(lru_.back().hash);
+    lru_.pop_back();
+  }
+  lru_.push_front({hash, query});
+  // Map key points to the string owned by list entry, which is not moved until erased
+  entries_.emplace(lru_.front().hash, lru_.begin());
+}
+
+size_t QueryCache::size() const {
+  std::scoped_lock lock(mutex_);
+  return lru_.size();
+}
+
+}  // namespace graphql::taraxa
@@ -0,0 +1,141 @@
+#include "graphql/query_cost.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+
+#include "graphqlservice/internal/Grammar.h"
+
+namespace graphql::taraxa {
+
+namespace {
+// Nested fragments can't be deeper than the query text, bound protects against fragment cycles of invalid queries
+constexpr uint32_t kMaxDepth = 64;
+
+uint64_t saturatingMul(uint64_t a, uint64_t b) { return b && a > UINT64_MAX / b ? UINT64_MAX : a * b; }
+
+template <class Rule>
+const peg::ast_node* firstChild(const peg::ast_node& node) {
+  for (const auto& child : node.children) {
+    if (child->is_type<Rule>()) {
+      return child.get();
+    }
+  }
+  return nullptr;
+}
+}  // namespace
+
+QueryCostEstimator::QueryCostEstimator(const peg::ast& query, const response::Value& variables, uint64_t max_range)
+    : query_(query), variables_(variables), kMaxRange(max_range) {
+  for (const auto& definition : query_.root->children) {
+    if (definition->is_type<peg::fragment_definition>()) {
+      if (const auto name = firstChild<peg::fragment_name>(*definition)) {
+        fragments_[name->string_view()] = definition.get();
+      }
+    }
+  }
+}
+
+uint64_t QueryCostEstimator::estimate(uint64_t limit) {
+  cost_ = 0;
+  limit_ = limit;
+  for (const auto& definition : query_.root->children) {
+    if (definition->is_type<peg::operation_definition>()) {
+      if (const auto selection_set = firstChild<peg::selection_set>(*definition)) {
+        selectionSet(*selection_set, 1, 0);
+      }
+    }
+  }
+  return cost_;
+}
+
+void QueryCostEstimator::selectionSet(const peg::ast_node& selection_set, uint64_t multiplier, uint32_t depth) {
+  if (cost_ > limit_) {
+    return;
+  }
+  if (depth > kMaxDepth) {
+    cost_ = UINT64_MAX;
+    return;
+  }
+
+  for (const auto& selection : selection_set.children) {
+    const peg::ast_node* nested = nullptr;
+    auto nested_multiplier = multiplier;
+    if (selection->is_type<peg::field>()) {
+      cost_ = std::min(UINT64_MAX - multiplier, cost_) + multiplier;
+      nested = firstChild<peg::selection_set>(*selection);
+      if (nested) {
+        const auto name = firstChild<peg::field_name>(*selection);
+        const auto size = listSize(name ? name->string_view() : "", firstChild<peg::arguments>(*selection));
+        nested_multiplier = saturatingMul(multiplier, size);
+      }
+    } else if (selection->is_type<peg::fragment_spread>()) {
+      if (const auto name = firstChild<peg::fragment_name>(*selection)) {
+        if (const auto it = fragments_.find(name->string_view()); it != fragments_.end()) {
+          nested = firstChild<peg::selection_set>(*it->second);
+        }
+      }
+    } else if (selection->is_type<peg::inline_fragment>()) {
+      nested = firstChild<peg::selection_set>(*selection);
+    }
+
+    if (nested) {
+      selectionSet(*nested, nested_multiplier, depth + 1);
+    }
+    if (cost_ > limit_) {
+      return;
+    }
+  }
+}
+
+uint64_t QueryCostEstimator::listSize(std::string_view field, const peg::ast_node* arguments) const {
+  if (field == "blocks") {
+    const auto from = intArgument(arguments, "from");
+    const auto to = intArgument(arguments, "to");
+    if (!from || !to) {
+      return kMaxRange;
+    }
+    return std::min<uint64_t>(kMaxRange, static_cast<uint64_t>(std::abs(*to - *from)) + 1);
+  }
+  if (field == "dagBlocks") {
+    const auto count = intArgument(arguments, "count");
+    return count ? std::clamp<uint64_t>(*count, 1, kMaxRange) : 1;
+  }
+  if (field == "transactions" || field == "logs" || field == "ommers" || field == "periodDagBlocks") {
+    return kAssumedListSize;
+  }
+  return 1;
+}
+
+std::optional<int64_t> QueryCostEstimator::intArgument(const peg::ast_node* arguments, std::string_view name) const {
+  if (!arguments) {
+    return {};
+  }
+  for (const auto& argument : arguments->children) {
+    if (argument->children.size() < 2 || argument->children.front()->string_view() != name) {
+      continue;
+    }
+    const auto& value = *argument->children.back();
+    if (value.is_type<peg::integer_value>()) {
+      const auto text = value.string_view();
+      int64_t result = 0;
+      if (std::from_chars(text.data(), text.data() + text.size(), result).ec == std::errc()) {
+        return result;
+      }
+      return {};
+    }
+    if (value.is_type<peg::variable_value>() && variables_.type() == response::Type::Map) {
+      // Variable value is written with leading '$'
+      const auto variable = value.string_view().substr(1);
+      for (const auto& [key, variable_value] : variables_.get<response::MapType>()) {
+        if (key == variable && variable_value.type() == response::Type::Int) {
+          return variable_value.get<response::IntType>();
+        }
+      }
+    }
+    return {};
+  }
+  return {};
+}
+
+}  // namespace graphql::taraxa
@@ -20,6 +20,28 @@ Transaction::Transaction(std::shared_ptr<::taraxa::final_chain::FinalChain> fina
       transaction_(std::move(transaction)),
       location_(*final_chain_->transactionLocation(transaction_->getHash())) {}
 
+Transaction::Transaction(std::shared_ptr<::taraxa::final_chain::FinalChain> final_chain,
+                         std::shared_ptr<::taraxa::TransactionManager> trx_manager,
+                         std::function<std::shared_ptr<object::Block>(::taraxa::EthBlockNumber)> get_block_by_num,
+                         std::shared_ptr<::taraxa::Transaction> transaction, ::taraxa::TransactionLocation location,
+                         std::shared_ptr<const DataLoader> data_loader) noexcept
+    : final_chain_(std::move(final_chain)),
+      trx_manager_(std::move(trx_manager)),
+      get_block_by_num_(std::move(get_block_by_num)),
+      transaction_(std::move(transaction)),
+      location_(location),
+      data_loader_(std::move(data_loader)) {}
+
+bool Transaction::loadReceipt() const {
+  if (!receipt_ && data_loader_) {
+    receipt_ = data_loader_->receipt(location_.period, location_.position);
+  }
+  if (!receipt_) {
+    receipt_ = final_chain_->transactionReceipt(location_.period, location_.position, transaction_->getHash());
+  }
+  return receipt_.has_value();
+}
+
 response::Value Transaction::getHash() const noexcept { return response::Value(transaction_->getHash().toString()); }
 
 response::Value Transaction::getNonce() const noexcept { return response::Value(transaction_->getNonce().str()); }
@@ -52,44 +74,29 @@ response::Value Transaction::getInputData() const noexcept {
 std::shared_ptr<object::Block> Transaction::getBlock() const { return get_block_by_num_(location_.period); }
 
 std::optional<response::Value> Transaction::getStatus() const noexcept {
-  if (!receipt_) {
-    receipt_ = final_chain_->transactionReceipt(location_.period, location_.position, transaction_->getHash());
-    if (!receipt_) return std::nullopt;
-  }
+  if (!loadReceipt()) return std::nullopt;
   return response::Value(static_cast<int>(receipt_->status_code));
 }
 
 std::optional<response::Value> Transaction::getGasUsed() const noexcept {
-  if (!receipt_) {
-    receipt_ = final_chain_->transactionReceipt(location_.period, location_.position, transaction_->getHash());
-    if (!receipt_) return std::nullopt;
-  }
+  if (!loadReceipt()) return std::nullopt;
   return response::Value(static_cast<int>(receipt_->gas_used));
 }
 
 std::optional<response::Value> Transaction::getCumulativeGasUsed() const noexcept {
-  if (!receipt_) {
-    receipt_ = final_chain_->transactionReceipt(location_.period, location_.position, transaction_->getHash());
-    if (!receipt_) return std::nullopt;
-  }
+  if (!loadReceipt()) return std::nullopt;
   return response::Value(static_cast<int>(receipt_->cumulative_gas_used));
 }
 
 std::shared_ptr<object::Account> Transaction::getCreatedContract(std::optional<response::Value>&&) const noexcept {
-  if (!receipt_) {
-    receipt_ = final_chain_->transactionReceipt(location_.period, location_.position, transaction_->getHash());
-    if (!receipt_) return nullptr;
-  }
+  if (!loadReceipt()) return nullptr;
   if (!receipt_->new_contract_address) return nullptr;
   return std::make_shared<object::Account>(std::make_shared<Account>(final_chain_, *receipt_->new_contract_address));
 }
 
 std::optional<std::vector<std::shared_ptr<object::Log>>> Transaction::getLogs() const noexcept {
   std::vector<std::shared_ptr<object::Log>> logs;
-  if (!receipt_) {
-    receipt_ = final_chain_->transactionReceipt(location_.period, location_.position, transaction_->getHash());
-    if (!receipt_) return std::nullopt;
-  }
+  if (!loadReceipt()) return std::nullopt;
 
   for (int i = 0; i < static_cast<int>(receipt_->logs.size()); ++i) {
     logs.push_back(std::make_shared<object::Log>(
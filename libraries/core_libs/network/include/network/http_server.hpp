@@ -3,8 +3,11 @@
 #include <atomic>
 #include <boost/asio.hpp>
 #include <boost/beast.hpp>
+#include <chrono>
+#include <functional>
 
 #include "common/types.hpp"
+#include "config/network.hpp"
 #include "logger/logger.hpp"
 #include "metrics/jsonrpc_metrics.hpp"
 
@@ -16,6 +19,15 @@ class HttpProcessor {
   using Response = boost::beast::http::response<boost::beast::http::string_body>;
 
   virtual Response process(const Request& request) = 0;
+
+  /**
+   * @brief Lets processor take over processing of request on another thread
+   * @param on_response called with response once request is processed, might be called from any thread
+   * @return false if request was not taken over and must be processed by process()
+   */
+  virtual bool processAsync(const Request& /*request*/, std::function<void(Response&&)> /*on_response*/) {
+    return false;
+  }
 };
 
 class HttpConnection;
@@ -24,7 +36,8 @@ class HttpHandler;
 class HttpServer : public std::enable_shared_from_this<HttpServer> {
  public:
   HttpServer(boost::asio::io_context& io, boost::asio::ip::tcp::endpoint ep, const addr_t& node_addr,
-             const std::shared_ptr<HttpProcessor>& request_processor, std::shared_ptr<metrics::JsonRpcMetrics> metrics);
+             const std::shared_ptr<HttpProcessor>& request_processor, std::shared_ptr<metrics::JsonRpcMetrics> metrics,
+             HttpKeepAliveConfig keep_alive_config = {});
 
   virtual ~HttpServer() { HttpServer::stop(); }
 
@@ -41,6 +54,7 @@ class HttpServer : public std::enable_shared_from_this<HttpServer> {
  protected:
   std::shared_ptr<HttpProcessor> request_processor_;
   std::shared_ptr<metrics::JsonRpcMetrics> metrics_;
+  const HttpKeepAliveConfig kKeepAliveConfig;
 
  private:
   std::atomic<bool> stopped_ = true;
@@ -68,9 +82,17 @@ class HttpConnection : public std::enable_shared_from_this<HttpConnection> {
   void read();
   void stop();
 
+ private:
+  void respond();
+  void write(const std::string& ip, std::chrono::steady_clock::time_point start_time);
+
  protected:
   std::shared_ptr<HttpServer> server_;
+  // Socket & timer share the same strand so idle timeout never races with pending read/write
   boost::asio::ip::tcp::socket socket_;
+  boost::asio::steady_timer idle_timer_;
+  // Number of requests served by this connection
+  uint32_t requests_count_ = 0;
   boost::beast::flat_buffer buffer_;
   boost::beast::http::request<boost::beast::http::string_body> request_;
   boost::beast::http::response<boost::beast::http::string_body> response_;
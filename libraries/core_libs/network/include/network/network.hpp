@@ -11,6 +11,7 @@
 
 #include "common/thread_pool.hpp"
 #include "config/config.hpp"
+#include "network/tarcap/shared_states/node_load.hpp"
 #include "network/tarcap/taraxa_capability.hpp"
 #include "network/tarcap/tarcap_version.hpp"
 #include "transaction/transaction.hpp"
@@ -22,6 +23,10 @@ class TimePeriodPacketsStats;
 class NodeStats;
 }  // namespace network::tarcap
 
+namespace final_chain {
+struct HistoricalBlock;
+}  // namespace final_chain
+
 class PacketHandler;
 
 class Network {
@@ -53,6 +58,11 @@ class Network {
   Json::Value getStatus();
   bool pbft_syncing();
   uint64_t syncTimeSeconds() const;
+  // returns approximate memory used by known items caches of all peers in bytes
+  size_t peersCachesMemoryUsage() const;
+  std::vector<network::tarcap::PacketsCompressionStats::PacketTypeStats> getPacketsCompressionStats() const;
+  const std::shared_ptr<network::tarcap::UploadBandwidthManager> &getUploadBandwidthManager() const;
+  const std::shared_ptr<network::threadpool::PacketsThreadPool> &getPacketsThreadPool() const;
   void setSyncStatePeriod(PbftPeriod period);
 
   void gossipDagBlock(const std::shared_ptr<DagBlock> &block, bool proposed, const SharedTransactions &trxs);
@@ -72,15 +82,45 @@ class Network {
   void requestPillarBlockVotesBundle(PbftPeriod period, const blk_hash_t &pillar_block_hash);
 
   /**
-   * @brief Get packets queue status
+   * @brief Fetches finalized block that was pruned locally from peers that still have it, random peers are asked one
+   *        after another until a response passes verification
+   *
+   * @param period
+   * @param verify returns true if the block is valid, invalid block from peer is not used
+   * @return true if a verified block was received
+   */
+  bool fetchHistoricalBlock(PbftPeriod period,
+                            const std::function<bool(const final_chain::HistoricalBlock &)> &verify);
+
+  /**
+   * @brief Node load graded from packets queue, synced periods queue, finalization lag and transactions pool, updated
+   *        periodically
    *
-   * @return true if packets queue is over the limit
+   * @return current load level
    */
-  bool packetQueueOverLimit() const;
+  network::tarcap::LoadLevel loadLevel() const;
+
+  /**
+   * @brief Interval of new transactions gossip, set from network.transaction_interval_ms and changeable at runtime
+   */
+  uint32_t getTransactionInterval() const;
+  void setTransactionInterval(uint32_t interval_ms);
+
+  /**
+   * @brief Periods requested from and sent to peers in a single sync window, set from network.sync_level_size and
+   *        changeable at runtime
+   */
+  uint16_t getSyncLevelSize() const;
+  void setSyncLevelSize(uint16_t sync_level_size);
+
+  /**
+   * @brief Feeds recorded packet to the latest tarcap version, used by packets replay
+   */
+  void replayPacket(network::tarcap::PacketsCapture::Record &&record);
 
   // METHODS USED IN TESTS ONLY
-  template <typename PacketHandlerType>
-  std::shared_ptr<PacketHandlerType> getSpecificHandler(network::SubprotocolPacketType packet_type) const;
+  template <network::SubprotocolPacketType kPacketType>
+  std::shared_ptr<network::tarcap::PacketHandlerInterfaceType<kPacketType>> getSpecificHandler() const;
 
   dev::p2p::NodeID getNodeId() const;
   std::shared_ptr<network::tarcap::TaraxaPeer> getPeer(dev::p2p::NodeID const &id) const;
@@ -94,8 +134,11 @@ class Network {
    *
    * @param config
    * @param trx_mgr
+   * @param pbft_chain
+   * @param final_chain
    */
-  void registerPeriodicEvents(std::shared_ptr<TransactionManager> trx_mgr);
+  void registerPeriodicEvents(std::shared_ptr<TransactionManager> trx_mgr, std::shared_ptr<PbftChain> pbft_chain,
+                              std::shared_ptr<final_chain::FinalChain> final_chain);
 
   void addBootNodes(bool initial = false);
 
@@ -106,6 +149,12 @@ class Network {
   // Packets stats per time period
   std::shared_ptr<network::tarcap::TimePeriodPacketsStats> all_packets_stats_;
 
+  // Packets compression stats per packet type
+  std::shared_ptr<network::tarcap::PacketsCompressionStats> compression_stats_;
+
+  // Upload budget of sync packets served to other peers
+  std::shared_ptr<network::tarcap::UploadBandwidthManager> upload_bandwidth_;
+
   // Node stats
   std::shared_ptr<network::tarcap::NodeStats> node_stats_;
 
@@ -115,6 +164,11 @@ class Network {
   // Pbft manager
   std::shared_ptr<PbftManager> pbft_mgr_;
 
+  // Load level that producers of new blocks and transactions adapt to
+  network::tarcap::NodeLoad node_load_;
+
+  std::atomic<uint32_t> transaction_interval_ms_;
+
   util::ThreadPool tp_;
   std::shared_ptr<dev::p2p::Host> host_;
 
@@ -132,9 +186,9 @@ class Network {
   LOG_OBJECTS_DEFINE
 };
 
-template <typename PacketHandlerType>
-std::shared_ptr<PacketHandlerType> Network::getSpecificHandler(network::SubprotocolPacketType packet_type) const {
-  return tarcaps_.begin()->second->getSpecificHandler<PacketHandlerType>(packet_type);
+template <network::SubprotocolPacketType kPacketType>
+std::shared_ptr<network::tarcap::PacketHandlerInterfaceType<kPacketType>> Network::getSpecificHandler() const {
+  return tarcaps_.begin()->second->getSpecificHandler<kPacketType>();
 }
 
 }  // namespace taraxa
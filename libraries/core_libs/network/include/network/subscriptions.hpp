@@ -2,17 +2,24 @@
 
 #include <json/json.h>
 
+#include <array>
+#include <chrono>
 #include <functional>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include "network/rpc/eth/LogFilter.hpp"
+#include "network/ws_message.hpp"
 
 enum class SubscriptionType {
   HEADS,
   DAG_BLOCKS,
   TRANSACTIONS,
+  TRANSACTIONS_BATCH,
   DAG_BLOCK_FINALIZED,
   PBFT_BLOCK_EXECUTED,
   PILLAR_BLOCK,
@@ -21,13 +28,64 @@ enum class SubscriptionType {
 
 namespace taraxa::net {
 
+/**
+ * @brief Encoding of subscription notifications, rlp notifications are sent as binary frames with RLP list of
+ * subscription id and payload
+ */
+enum class SubscriptionEncoding { Json, Rlp };
+
+/**
+ * @brief Notification payload shared by all websocket sessions. Payload is serialized at most once, on first use, and
+ * the serialized string is shared by messages of all sessions
+ */
+class SubscriptionPayload {
+ public:
+  using RlpEncoder = std::function<dev::bytes()>;
+
+  /**
+   * @param rlp_encoder encodes payload for rlp subscriptions, it is called at most once while payload is processed, so
+   * it can capture references to the notified data
+   */
+  explicit SubscriptionPayload(Json::Value json, RlpEncoder rlp_encoder = {})
+      : json_(std::move(json)), rlp_encoder_(std::move(rlp_encoder)) {}
+
+  /**
+   * @brief Payload that was serialized in advance, e.g. cached finalized data
+   * @param reduced payload of the same notification for subscriptions that did not ask for full data
+   */
+  SubscriptionPayload(Json::Value json, std::shared_ptr<const std::string> serialized,
+                      std::shared_ptr<const std::string> rlp,
+                      std::shared_ptr<const SubscriptionPayload> reduced = {});
+
+  const Json::Value& json() const { return json_; }
+  const std::shared_ptr<const std::string>& serialized() const;
+  // RLP encoded payload, nullptr if payload has no rlp encoding
+  const std::shared_ptr<const std::string>& rlp() const;
+  // Reduced payload or this payload if there is none
+  const SubscriptionPayload& reduced() const { return reduced_ ? *reduced_ : *this; }
+
+ private:
+  Json::Value json_;
+  RlpEncoder rlp_encoder_;
+  std::shared_ptr<const SubscriptionPayload> reduced_;
+  mutable std::once_flag serialized_flag_;
+  mutable std::shared_ptr<const std::string> serialized_;
+  mutable std::once_flag rlp_flag_;
+  mutable std::shared_ptr<const std::string> rlp_;
+};
+
+/**
+ * @brief Notification of rlp subscription, binary message with RLP list [subscription_id, payload]
+ */
+WsMessage makeRlpSubscriptionResponse(int id, std::shared_ptr<const std::string> payload);
+
 class Subscription {
  public:
   Subscription(int id) : id_(id) {}
   virtual ~Subscription() = default;
   virtual SubscriptionType getType() const = 0;
   int getId() const { return id_; }
-  virtual std::string processPayload(Json::Value payload) const = 0;
+  virtual WsMessage processPayload(const SubscriptionPayload& payload) const = 0;
 
  protected:
   int id_;
@@ -35,11 +93,15 @@ class Subscription {
 
 class HeadsSubscription : public Subscription {
  public:
-  explicit HeadsSubscription(int id) : Subscription(id) {}
+  explicit HeadsSubscription(int id, SubscriptionEncoding encoding = SubscriptionEncoding::Json)
+      : Subscription(id), encoding_(encoding) {}
   static constexpr SubscriptionType type = SubscriptionType::HEADS;
 
   SubscriptionType getType() const override { return type; }
-  std::string processPayload(Json::Value payload) const override;
+  WsMessage processPayload(const SubscriptionPayload& payload) const override;
+
+ private:
+  SubscriptionEncoding encoding_;
 };
 
 class DagBlocksSubscription : public Subscription {
@@ -47,7 +109,7 @@ class DagBlocksSubscription : public Subscription {
   explicit DagBlocksSubscription(int id, bool hash_only = false) : Subscription(id), full_data_(hash_only) {}
   static constexpr SubscriptionType type = SubscriptionType::DAG_BLOCKS;
   SubscriptionType getType() const override { return type; }
-  std::string processPayload(Json::Value payload) const override;
+  WsMessage processPayload(const SubscriptionPayload& payload) const override;
 
  private:
   bool full_data_ = false;
@@ -55,10 +117,39 @@ class DagBlocksSubscription : public Subscription {
 
 class TransactionsSubscription : public Subscription {
  public:
-  explicit TransactionsSubscription(int id) : Subscription(id) {}
+  explicit TransactionsSubscription(int id, SubscriptionEncoding encoding = SubscriptionEncoding::Json)
+      : Subscription(id), encoding_(encoding) {}
   static constexpr SubscriptionType type = SubscriptionType::TRANSACTIONS;
   SubscriptionType getType() const override { return type; }
-  std::string processPayload(Json::Value payload) const override;
+  WsMessage processPayload(const SubscriptionPayload& payload) const override;
+
+ private:
+  SubscriptionEncoding encoding_;
+};
+
+/**
+ * @brief Pending transactions coalesced by server into batches, every notification carries array of hashes. Number of
+ * hashes sent per second can be capped, hashes over the cap are dropped
+ */
+class TransactionsBatchSubscription : public Subscription {
+ public:
+  explicit TransactionsBatchSubscription(int id, uint32_t max_per_second = 0,
+                                         SubscriptionEncoding encoding = SubscriptionEncoding::Json)
+      : Subscription(id), kMaxPerSecond(max_per_second), encoding_(encoding), tokens_(max_per_second) {}
+  static constexpr SubscriptionType type = SubscriptionType::TRANSACTIONS_BATCH;
+  SubscriptionType getType() const override { return type; }
+  // Returns empty message if the whole batch is over the rate cap
+  WsMessage processPayload(const SubscriptionPayload& payload) const override;
+
+ private:
+  // Takes up to count hashes from the rate cap budget, returns number of hashes that can be sent
+  size_t take(size_t count) const;
+
+  const uint32_t kMaxPerSecond;
+  SubscriptionEncoding encoding_;
+  mutable std::mutex rate_mutex_;
+  mutable double tokens_;
+  mutable std::chrono::steady_clock::time_point refilled_at_ = std::chrono::steady_clock::now();
 };
 
 class DagBlockFinalizedSubscription : public Subscription {
@@ -66,7 +157,7 @@ class DagBlockFinalizedSubscription : public Subscription {
   explicit DagBlockFinalizedSubscription(int id) : Subscription(id) {}
   static constexpr SubscriptionType type = SubscriptionType::DAG_BLOCK_FINALIZED;
   SubscriptionType getType() const override { return type; }
-  std::string processPayload(Json::Value payload) const override;
+  WsMessage processPayload(const SubscriptionPayload& payload) const override;
 };
 
 class PbftBlockExecutedSubscription : public Subscription {
@@ -74,7 +165,7 @@ class PbftBlockExecutedSubscription : public Subscription {
   explicit PbftBlockExecutedSubscription(int id, bool full_block = false) : Subscription(id), full_block_(full_block) {}
   static constexpr SubscriptionType type = SubscriptionType::PBFT_BLOCK_EXECUTED;
   SubscriptionType getType() const override { return type; }
-  std::string processPayload(Json::Value payload) const override;
+  WsMessage processPayload(const SubscriptionPayload& payload) const override;
 
  private:
   bool full_block_ = false;
@@ -82,14 +173,16 @@ class PbftBlockExecutedSubscription : public Subscription {
 
 class PillarBlockSubscription : public Subscription {
  public:
-  explicit PillarBlockSubscription(int id, bool include_signatures = false)
-      : Subscription(id), include_signatures_(include_signatures) {}
+  explicit PillarBlockSubscription(int id, bool include_signatures = false,
+                                   SubscriptionEncoding encoding = SubscriptionEncoding::Json)
+      : Subscription(id), include_signatures_(include_signatures), encoding_(encoding) {}
   static constexpr SubscriptionType type = SubscriptionType::PILLAR_BLOCK;
   SubscriptionType getType() const override { return type; }
-  std::string processPayload(Json::Value payload) const override;
+  WsMessage processPayload(const SubscriptionPayload& payload) const override;
 
  private:
   bool include_signatures_ = false;
+  SubscriptionEncoding encoding_;
 };
 
 class LogsSubscription : public Subscription {
@@ -97,24 +190,59 @@ class LogsSubscription : public Subscription {
   explicit LogsSubscription(int id, rpc::eth::LogFilter&& filter) : Subscription(id), filter_(filter) {}
   static constexpr SubscriptionType type = SubscriptionType::LOGS;
   SubscriptionType getType() const override { return type; }
-  std::string processPayload(Json::Value payload) const override;
-  rpc::eth::LogFilter getFilter() const { return filter_; }
+  WsMessage processPayload(const SubscriptionPayload& payload) const override;
+  const rpc::eth::LogFilter& getFilter() const { return filter_; }
 
  private:
   rpc::eth::LogFilter filter_;
 };
 
+/**
+ * @brief Logs subscriptions of all websocket sessions indexed by address and topic. Index is built for a single block,
+ * every log is looked up once and serialized at most once, serialized log is shared by all matching subscriptions
+ */
+class LogsSubscriptionsIndex {
+ public:
+  using Send = std::function<void(WsMessage&&)>;
+
+  /**
+   * @brief Adds subscription to index
+   * @param subscription subscription
+   * @param send send function of the session subscription belongs to, has to outlive the index
+   */
+  void add(std::shared_ptr<const LogsSubscription> subscription, const Send& send);
+
+  bool empty() const { return subscriptions_count_ == 0; }
+
+  void process(const final_chain::BlockHeader& header, const TransactionHashes& trx_hashes,
+               const TransactionReceipts& receipts) const;
+
+ private:
+  struct Entry {
+    std::shared_ptr<const LogsSubscription> subscription;
+    const Send* send;
+  };
+
+  // Subscriptions filtering by addresses
+  std::unordered_map<addr_t, std::vector<Entry>> by_address_;
+  // Subscriptions without addresses keyed by the first topic position they filter and its allowed values
+  std::array<std::unordered_map<h256, std::vector<Entry>>, 4> by_topic_;
+  // Subscriptions matching every log
+  std::vector<Entry> any_;
+  size_t subscriptions_count_ = 0;
+};
+
 class Subscriptions {
  public:
-  Subscriptions(std::function<void(std::string&&)> send) : send_(send) {}
+  Subscriptions(std::function<void(WsMessage&&)> send) : send_(send) {}
   int addSubscription(std::shared_ptr<Subscription> subscription);
   bool removeSubscription(int id);
-  void process(SubscriptionType type, const Json::Value& payload);
-  void processLogs(const final_chain::BlockHeader& header, TransactionHashes trx_hashes,
-                   const TransactionReceipts& receipts);
+  void process(SubscriptionType type, const SubscriptionPayload& payload);
+  // Adds logs subscriptions to index shared by all sessions
+  void collectLogsSubscriptions(LogsSubscriptionsIndex& index);
 
  private:
-  std::function<void(std::string&&)> send_;
+  std::function<void(WsMessage&&)> send_;
   std::map<uint64_t, std::shared_ptr<Subscription>> subscriptions_;
   std::map<SubscriptionType, std::list<uint64_t>> subscriptions_by_type_;
   std::mutex subscriptions_mutex_;
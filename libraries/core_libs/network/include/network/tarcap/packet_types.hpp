@@ -33,6 +33,12 @@ enum SubprotocolPacketType : uint32_t {
   kGetPillarVotesBundlePacket,
   kPillarVotesBundlePacket,
   kPbftBlocksBundlePacket,
+  kGetTransactionsPacket,
+  kGetDagBlockTransactionsPacket,
+  kTransactionsSketchPacket,
+  kTransactionsReconciliationPacket,
+  kGetHistoricalBlockPacket,
+  kHistoricalBlockPacket,
 
   kPacketCount
 };
@@ -71,6 +77,18 @@ inline std::string convertPacketTypeToString(SubprotocolPacketType packet_type)
       return "PillarVotesBundlePacket";
     case kPbftBlocksBundlePacket:
       return "PbftBlocksBundlePacket";
+    case kGetTransactionsPacket:
+      return "GetTransactionsPacket";
+    case kGetDagBlockTransactionsPacket:
+      return "GetDagBlockTransactionsPacket";
+    case kTransactionsSketchPacket:
+      return "TransactionsSketchPacket";
+    case kTransactionsReconciliationPacket:
+      return "TransactionsReconciliationPacket";
+    case kGetHistoricalBlockPacket:
+      return "GetHistoricalBlockPacket";
+    case kHistoricalBlockPacket:
+      return "HistoricalBlockPacket";
     default:
       break;
   }
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "common/encoding_rlp.hpp"
+#include "common/types.hpp"
+
+namespace taraxa::network::tarcap {
+
+struct GetDagBlockTransactionsPacket {
+  blk_hash_t dag_block_hash;
+  std::vector<trx_hash_t> transactions_hashes;
+
+  RLP_FIELDS_DEFINE_INPLACE(dag_block_hash, transactions_hashes)
+};
+
+}  // namespace taraxa::network::tarcap
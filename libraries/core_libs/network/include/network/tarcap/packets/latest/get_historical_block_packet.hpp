@@ -0,0 +1,14 @@
+#pragma once
+
+#include "common/encoding_rlp.hpp"
+#include "common/types.hpp"
+
+namespace taraxa::network::tarcap {
+
+struct GetHistoricalBlockPacket {
+  PbftPeriod period;
+
+  RLP_FIELDS_DEFINE_INPLACE(period)
+};
+
+}  // namespace taraxa::network::tarcap
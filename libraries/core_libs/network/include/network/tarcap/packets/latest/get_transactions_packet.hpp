@@ -0,0 +1,14 @@
+#pragma once
+
+#include "common/encoding_rlp.hpp"
+#include "common/types.hpp"
+
+namespace taraxa::network::tarcap {
+
+struct GetTransactionsPacket {
+  std::vector<trx_hash_t> transactions_hashes;
+
+  RLP_FIELDS_DEFINE_INPLACE(transactions_hashes)
+};
+
+}  // namespace taraxa::network::tarcap
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "common/encoding_rlp.hpp"
+#include "final_chain/data.hpp"
+#include "pbft/pbft_block.hpp"
+
+namespace taraxa::network::tarcap {
+
+struct HistoricalBlockPacket {
+  PbftPeriod period;
+  // Empty if the peer doesn't have the block
+  std::optional<final_chain::HistoricalBlock> block;
+
+  RLP_FIELDS_DEFINE_INPLACE(period, block)
+};
+
+}  // namespace taraxa::network::tarcap
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "network/tarcap/packets_handlers/latest/common/exceptions.hpp"
+#include "pbft/pbft_block.hpp"
 #include "pbft/period_data.hpp"
 #include "vote/pbft_vote.hpp"
 #include "vote/votes_bundle_rlp.hpp"
@@ -14,9 +16,29 @@ struct PbftSyncPacket {
   RLP_FIELDS_DEFINE_INPLACE(last_block, period_data, current_block_cert_votes_bundle)
 };
 
+// Decodes only the pbft block of PbftSyncPacket, rest of the period data stays raw until the period is processed
+struct PbftSyncPacketHeader {
+  explicit PbftSyncPacketHeader(const dev::RLP& packet_rlp) {
+    if (const auto items_count = packet_rlp.itemCount(); items_count != kPacketItemsCount) {
+      throw InvalidRlpItemsCountException("PbftSyncPacket", items_count, kPacketItemsCount);
+    }
+    last_block = packet_rlp[0].toInt<bool>();
+    pbft_blk = std::make_shared<PbftBlock>(packet_rlp[1][0]);
+    pbft_chain_synced = !packet_rlp[2].isNull() && !packet_rlp[2].isEmpty();
+  }
+
+  static constexpr size_t kPacketItemsCount = 3;
+
+  bool last_block;
+  std::shared_ptr<PbftBlock> pbft_blk;
+  // Packet contains cert votes of the current block
+  bool pbft_chain_synced;
+};
+
+// Encodes period data rlp as it is stored in db, period_data must stay valid until the packet is encoded
 struct PbftSyncPacketRaw {
   bool last_block;
-  dev::bytes period_data;
+  dev::bytesConstRef period_data;
   std::optional<OptimizedPbftVotesBundle> current_block_cert_votes_bundle;
 
   void rlp(::taraxa::util::RLPEncoderRef encoding) const {
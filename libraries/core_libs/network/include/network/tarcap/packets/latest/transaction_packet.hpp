@@ -8,6 +8,9 @@ struct TransactionPacket {
   std::vector<std::shared_ptr<Transaction>> transactions;
   std::vector<trx_hash_t> extra_transactions_hashes;
 
+  // Packet with many transactions is encoded into a presized buffer
+  size_t rlpSize() const { return util::rlp_tuple_size(transactions, extra_transactions_hashes); }
+
   RLP_FIELDS_DEFINE_INPLACE(transactions, extra_transactions_hashes)
 };
 
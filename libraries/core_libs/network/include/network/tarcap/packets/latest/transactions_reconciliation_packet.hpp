@@ -0,0 +1,19 @@
+#pragma once
+
+#include "common/encoding_rlp.hpp"
+#include "common/types.hpp"
+
+namespace taraxa::network::tarcap {
+
+struct TransactionsReconciliationPacket {
+  // False if difference of pools was bigger than the sketch capacity
+  bool decoded;
+  // Number of transactions missing on both sides
+  uint32_t differences_count;
+  // Short ids of sketch sender transactions that are missing in the receiver pool
+  std::vector<uint64_t> requested_short_ids;
+
+  RLP_FIELDS_DEFINE_INPLACE(decoded, differences_count, requested_short_ids)
+};
+
+}  // namespace taraxa::network::tarcap
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "common/encoding_rlp.hpp"
+#include "common/types.hpp"
+
+namespace taraxa::network::tarcap {
+
+struct TransactionsSketchPacket {
+  // Serialized TransactionsSketch of the sender pool
+  dev::bytes sketch;
+
+  RLP_FIELDS_DEFINE_INPLACE(sketch)
+};
+
+}  // namespace taraxa::network::tarcap
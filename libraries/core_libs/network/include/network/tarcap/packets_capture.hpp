@@ -0,0 +1,71 @@
+#pragma once
+
+#include <libp2p/Common.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string_view>
+
+#include "network/tarcap/packet_types.hpp"
+
+namespace taraxa::network::tarcap {
+
+/**
+ * @brief Binary log of incoming tarcap packets, used to reproduce traffic of specific peers offline
+ *
+ * Log starts with kMagic, each record is: receive time in us since epoch (uint64), packet type (uint8), sender node id,
+ * rlp size (uint32) and raw packet rlp. Integers are stored in host byte order, the log is meant to be replayed on the
+ * same architecture it was recorded on.
+ */
+class PacketsCapture {
+ public:
+  struct Record {
+    std::chrono::microseconds time{0};
+    SubprotocolPacketType type = SubprotocolPacketType::kPacketCount;
+    dev::p2p::NodeID peer;
+    dev::bytes rlp;
+  };
+
+  static constexpr std::string_view kMagic = "TRXPCAP1";
+
+  /**
+   * @brief Opens log for appending, existing log is continued
+   */
+  explicit PacketsCapture(const std::filesystem::path& path);
+  ~PacketsCapture();
+
+  PacketsCapture(const PacketsCapture&) = delete;
+  PacketsCapture(PacketsCapture&&) = delete;
+  PacketsCapture& operator=(const PacketsCapture&) = delete;
+  PacketsCapture& operator=(PacketsCapture&&) = delete;
+
+  void record(SubprotocolPacketType type, const dev::p2p::NodeID& peer, dev::bytesConstRef rlp);
+
+  /**
+   * @brief Reads records of a log one by one
+   */
+  class Reader {
+   public:
+    /**
+     * @throw std::runtime_error in case file can not be opened or it is not a packets log
+     */
+    explicit Reader(const std::filesystem::path& path);
+
+    /**
+     * @return next record, empty at the end of the log or if the last record is truncated
+     */
+    std::optional<Record> next();
+
+   private:
+    std::ifstream in_;
+  };
+
+ private:
+  std::mutex mutex_;
+  std::ofstream out_;
+};
+
+}  // namespace taraxa::network::tarcap
@@ -1,12 +1,79 @@
 #pragma once
 
+#include <array>
 #include <memory>
-#include <unordered_map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 
 #include "network/tarcap/packets_handlers/latest/common/base_packet_handler.hpp"
 
 namespace taraxa::network::tarcap {
 
+class ISyncPacketHandler;
+class ITransactionPacketHandler;
+class IVotePacketHandler;
+class IPillarVotePacketHandler;
+class IGetPillarVotesBundlePacketHandler;
+class IDagBlockPacketHandler;
+class TransactionsReconciliationPacketHandler;
+class GetHistoricalBlockPacketHandler;
+
+/**
+ * @brief Handler interface that is accessible by packet type
+ *
+ * We support multiple taraxa capabilities, which can contain different versions of packet handlers, so only the
+ * interfaces shared by all versions and handlers registered only by the latest version are accessible. Packet types
+ * without an interface map to void
+ */
+template <SubprotocolPacketType kPacketType>
+struct PacketHandlerInterface {
+  using type = void;
+};
+template <>
+struct PacketHandlerInterface<SubprotocolPacketType::kStatusPacket> {
+  using type = ISyncPacketHandler;
+};
+template <>
+struct PacketHandlerInterface<SubprotocolPacketType::kPbftSyncPacket> {
+  using type = ISyncPacketHandler;
+};
+template <>
+struct PacketHandlerInterface<SubprotocolPacketType::kTransactionPacket> {
+  using type = ITransactionPacketHandler;
+};
+template <>
+struct PacketHandlerInterface<SubprotocolPacketType::kVotePacket> {
+  using type = IVotePacketHandler;
+};
+template <>
+struct PacketHandlerInterface<SubprotocolPacketType::kVotesBundlePacket> {
+  using type = IVotePacketHandler;
+};
+template <>
+struct PacketHandlerInterface<SubprotocolPacketType::kPillarVotePacket> {
+  using type = IPillarVotePacketHandler;
+};
+template <>
+struct PacketHandlerInterface<SubprotocolPacketType::kGetPillarVotesBundlePacket> {
+  using type = IGetPillarVotesBundlePacketHandler;
+};
+template <>
+struct PacketHandlerInterface<SubprotocolPacketType::kDagBlockPacket> {
+  using type = IDagBlockPacketHandler;
+};
+template <>
+struct PacketHandlerInterface<SubprotocolPacketType::kTransactionsReconciliationPacket> {
+  using type = TransactionsReconciliationPacketHandler;
+};
+template <>
+struct PacketHandlerInterface<SubprotocolPacketType::kGetHistoricalBlockPacket> {
+  using type = GetHistoricalBlockPacketHandler;
+};
+
+template <SubprotocolPacketType kPacketType>
+using PacketHandlerInterfaceType = typename PacketHandlerInterface<kPacketType>::type;
+
 /**
  * @brief Generic PacketsHandler that contains all specific packet handlers
  */
@@ -22,6 +89,16 @@ class PacketsHandler {
    */
   const std::shared_ptr<BasePacketHandler>& getSpecificHandler(SubprotocolPacketType packet_type) const;
 
+  /**
+   * @brief Typed packet handler. Whether registered handler implements the interface is known at its registration,
+   *        so no runtime cast is needed
+   *
+   * @tparam kPacketType
+   * @return handler interface of kPacketType
+   */
+  template <SubprotocolPacketType kPacketType>
+  std::shared_ptr<PacketHandlerInterfaceType<kPacketType>> getSpecificHandler() const;
+
   /**
    * @brief Registers packet handler
    *
@@ -33,15 +110,35 @@ class PacketsHandler {
   void registerHandler(Args&&... args);
 
  private:
-  // Map of all packets handlers, factory method selects specific packet handler for processing based on packet type
-  std::unordered_map<SubprotocolPacketType, std::shared_ptr<BasePacketHandler>> packets_handlers_;
+  // All packets handlers indexed by packet type, factory method selects specific packet handler for processing
+  std::array<std::shared_ptr<BasePacketHandler>, SubprotocolPacketType::kPacketCount> packets_handlers_;
+  // If registered handler implements interface of its packet type, test handlers might not
+  std::array<bool, SubprotocolPacketType::kPacketCount> implements_interface_{};
 };
 
+template <SubprotocolPacketType kPacketType>
+std::shared_ptr<PacketHandlerInterfaceType<kPacketType>> PacketsHandler::getSpecificHandler() const {
+  static_assert(!std::is_void_v<PacketHandlerInterfaceType<kPacketType>>,
+                "Only handlers with an interface shared by all tarcap versions are accessible");
+  const auto& handler = getSpecificHandler(kPacketType);
+  if (!implements_interface_[kPacketType]) {
+    assert(false);
+    throw std::runtime_error("Packet handler does not implement interface of packet type: " +
+                             std::to_string(kPacketType));
+  }
+  return std::static_pointer_cast<PacketHandlerInterfaceType<kPacketType>>(handler);
+}
+
 template <typename PacketHandlerType, typename... Args>
 void PacketsHandler::registerHandler(Args&&... args) {
-  assert(packets_handlers_.find(PacketHandlerType::kPacketType_) == packets_handlers_.end());
-  packets_handlers_.emplace(PacketHandlerType::kPacketType_,
-                            std::make_shared<PacketHandlerType>(std::forward<Args>(args)...));
+  constexpr auto kPacketType = PacketHandlerType::kPacketType_;
+  static_assert(kPacketType < SubprotocolPacketType::kPacketCount);
+  assert(!packets_handlers_[kPacketType]);
+  packets_handlers_[kPacketType] = std::make_shared<PacketHandlerType>(std::forward<Args>(args)...);
+  if constexpr (!std::is_void_v<PacketHandlerInterfaceType<kPacketType>>) {
+    // Interface can be just declared here, is_base_of needs only the handler to be complete
+    implements_interface_[kPacketType] = std::is_base_of_v<PacketHandlerInterfaceType<kPacketType>, PacketHandlerType>;
+  }
 }
 
 }  // namespace taraxa::network::tarcap
@@ -13,8 +13,12 @@ class IDagBlockPacketHandler : public ExtSyncingPacketHandler {
                          std::shared_ptr<DbStorage> db, const addr_t &node_addr, const std::string &logs_prefix);
 
   void onNewBlockVerified(const std::shared_ptr<DagBlock> &block, bool proposed, const SharedTransactions &trxs);
+  /**
+   * @param block_rlp rlp of the block with signature, encoded once by the caller for all peers
+   */
   virtual void sendBlockWithTransactions(const std::shared_ptr<TaraxaPeer> &peer,
-                                         const std::shared_ptr<DagBlock> &block, SharedTransactions &&trxs) = 0;
+                                         const std::shared_ptr<DagBlock> &block, const dev::bytes &block_rlp,
+                                         SharedTransactions &&trxs) = 0;
 
   // Note: Used only in tests
   void requestDagBlocks(std::shared_ptr<TaraxaPeer> peer);
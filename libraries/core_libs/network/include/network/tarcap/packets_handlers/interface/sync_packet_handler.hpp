@@ -19,13 +19,23 @@ class ISyncPacketHandler : public ExtSyncingPacketHandler {
   void startSyncingPbft();
 
   /**
-   * @brief Send sync request to the current syncing peer with specified request_period
+   * @brief Splits periods that are not requested yet into windows of sync_level_size and requests them concurrently
+   * from up to sync_max_peers peers whose chain covers the window. The last window is always requested from the
+   * syncing peer as it sends also cert votes of its latest block. Stalled windows are reassigned to other peers
    *
-   * @param request_period
-   *
-   * @return true if sync request was sent, otherwise false
+   * @return true if there is at least one window requested, otherwise false
+   */
+  virtual bool requestPbftSyncWindows();
+
+  /**
+   * @return true if synced periods waiting for execution exceed sync_queue_max_mb, new windows are not requested then
+   */
+  bool isSyncQueueOverMemoryBudget() const;
+
+  /**
+   * @return true if period data can be synced from the peer, follower syncs only from its upstream nodes
    */
-  virtual bool syncPeerPbft(PbftPeriod request_period);
+  bool isSyncSource(const TaraxaPeer& peer) const;
 
   void sendStatusToPeers();
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+
 #include "network/tarcap/packets_handlers/latest/common/packet_handler.hpp"
 #include "transaction/transaction.hpp"
 
@@ -7,17 +9,22 @@ namespace taraxa::network::tarcap {
 
 class ITransactionPacketHandler : public PacketHandler {
  public:
+  // Returns pool transactions grouped per account inserted after the sequence and the last insertion sequence
+  using PoolTransactionsGetter = std::function<std::pair<std::vector<SharedTransactions>, uint64_t>(uint64_t)>;
+
   ITransactionPacketHandler(const FullNodeConfig& conf, std::shared_ptr<PeersState> peers_state,
                             std::shared_ptr<TimePeriodPacketsStats> packets_stats, const addr_t& node_addr,
-                            const std::string& logs_prefix);
+                            const std::string& logs_prefix, bool announce_transactions = false);
 
   /**
    * @brief Sends batch of transactions to all connected peers
-   * @note This method is used as periodic event to broadcast transactions to the other peers in network
+   * @note This method is used as periodic event to broadcast transactions to the other peers in network. Every peer
+   * keeps a transactions send cursor so only transactions inserted into the pool since the last complete send to the
+   * peer are considered
    *
-   * @param transactions to be sent
+   * @param get_pool_transactions returns pool transactions inserted after a sequence
    */
-  void periodicSendTransactions(std::vector<SharedTransactions>&& transactions);
+  void periodicSendTransactions(const PoolTransactionsGetter& get_pool_transactions);
 
   /**
    * @brief Send transactions
@@ -38,7 +45,33 @@ class ITransactionPacketHandler : public PacketHandler {
   std::vector<std::pair<std::shared_ptr<TaraxaPeer>, std::pair<SharedTransactions, std::vector<trx_hash_t>>>>
   transactionsToSendToPeers(std::vector<SharedTransactions>&& transactions);
 
+ protected:
+  /**
+   * @brief keeps transactions bodies for sqrt(N) randomly selected peers and replaces them with hashes announcement for
+   * the rest
+   *
+   * @param peers_with_transactions_to_send selected transactions and hashes per peer
+   */
+  static void announceTransactionsHashes(
+      std::vector<std::pair<std::shared_ptr<TaraxaPeer>, std::pair<SharedTransactions, std::vector<trx_hash_t>>>>&
+          peers_with_transactions_to_send);
+
+  // Transactions bodies are pushed only to subset of peers, used only by versions with GetTransactionsPacket support
+  const bool kAnnounceTransactions;
+
  private:
+  /**
+   * @brief select which transactions and hashes to send to which peer and advance cursors of peers which got everything
+   *
+   * @param peers peers with the same transactions send cursor
+   * @param transactions grouped per account to be sent
+   * @param cursor sequence to which cursor of the peers is moved if all transactions are sent or known
+   * @return selected transactions and hashes to be sent per peer
+   */
+  std::vector<std::pair<std::shared_ptr<TaraxaPeer>, std::pair<SharedTransactions, std::vector<trx_hash_t>>>>
+  transactionsToSendToPeers(const std::vector<std::shared_ptr<TaraxaPeer>>& peers,
+                            const std::vector<SharedTransactions>& transactions, std::optional<uint64_t> cursor);
+
   /**
    * @brief select which transactions and hashes to send to peer
    *
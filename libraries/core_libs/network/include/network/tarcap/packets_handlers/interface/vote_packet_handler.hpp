@@ -49,6 +49,24 @@ class IVotePacketHandler : public ExtVotesPacketHandler {
    */
   virtual void sendPbftVotesBundle(const std::shared_ptr<TaraxaPeer>& peer,
                                    std::vector<std::shared_ptr<PbftVote>>&& votes);
+
+  /**
+   * @brief Sends 2t+1 votes bundle encoded by vote manager to specified peer, votes are not encoded again
+   * @param peer
+   * @param bundle
+   */
+  void sendPbftVotesBundle(const std::shared_ptr<TaraxaPeer>& peer, const VoteManager::TwoTPlusOneVotesBundle& bundle);
+
+ private:
+  /**
+   * @brief Encodes vote packet that can be sent to several peers
+   * @return encoded packet, nullptr if block is not the voted one
+   */
+  std::shared_ptr<const dev::bytes> encodePbftVotePacket(const std::shared_ptr<PbftVote>& vote,
+                                                         const std::shared_ptr<PbftBlock>& block);
+
+  void sendEncodedPbftVote(const std::shared_ptr<TaraxaPeer>& peer, const std::shared_ptr<PbftVote>& vote,
+                           const std::shared_ptr<PbftBlock>& block, std::shared_ptr<const dev::bytes> packet_rlp);
 };
 
 }  // namespace taraxa::network::tarcap
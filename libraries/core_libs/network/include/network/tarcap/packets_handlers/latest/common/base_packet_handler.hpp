@@ -1,5 +1,7 @@
 #pragma once
 
+#include <optional>
+
 #include "network/threadpool/packet_data.hpp"
 
 namespace taraxa::network::tarcap {
@@ -26,6 +28,17 @@ class BasePacketHandler {
    */
   // TODO: use unique_ptr for packet data for easier & quicker copying
   virtual void processPacket(const threadpool::PacketData& packet_data) = 0;
+
+  /**
+   * @brief Peeks consensus position of the packet without decoding it, called when packet is pushed into threadpool
+   *
+   * @param packet_data
+   * @return hint used to schedule the packet, nullopt for packets that are not consensus votes or malformed ones
+   */
+  virtual std::optional<threadpool::PacketData::ConsensusHint> peekConsensusHint(
+      const threadpool::PacketData& /*packet_data*/) const {
+    return {};
+  }
 };
 
 }  // namespace taraxa::network::tarcap
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "network/tarcap/transactions_sketch.hpp"
+#include "packet_handler.hpp"
+#include "transaction/transaction.hpp"
+
+namespace taraxa {
+class TransactionManager;
+}  // namespace taraxa
+
+namespace taraxa::network::tarcap {
+
+/**
+ * @brief Shared part of transactions pool reconciliation handlers
+ */
+class ExtTransactionsReconciliationPacketHandler : public PacketHandler {
+ public:
+  ExtTransactionsReconciliationPacketHandler(const FullNodeConfig& conf, std::shared_ptr<PeersState> peers_state,
+                                             std::shared_ptr<TimePeriodPacketsStats> packets_stats,
+                                             std::shared_ptr<TransactionManager> trx_mgr, const addr_t& node_addr,
+                                             const std::string& log_channel);
+
+  // Bounds of pools differences count sketches are sized for, the biggest sketch has kMaxCells
+  static constexpr uint32_t kMinReconciliationCapacity = 16;
+  static constexpr uint32_t kMaxReconciliationCapacity =
+      static_cast<uint32_t>(TransactionsSketch::kMaxCells / TransactionsSketch::kCellsPerDifference);
+
+ protected:
+  using PoolTransactions = std::vector<std::pair<uint64_t, std::shared_ptr<Transaction>>>;
+
+  /**
+   * @return pool transactions with their short ids
+   */
+  PoolTransactions getPoolTransactions() const;
+
+  static TransactionsSketch makeSketch(size_t cells_count, const PoolTransactions& pool);
+
+  /**
+   * @brief Sends transactions split into packets of kMaxTransactionsInPacket and marks them as known to peer
+   */
+  void sendTransactions(const std::shared_ptr<TaraxaPeer>& peer, SharedTransactions&& transactions);
+
+  static uint64_t nowMs();
+
+ protected:
+  std::shared_ptr<TransactionManager> trx_mgr_;
+};
+
+}  // namespace taraxa::network::tarcap
@@ -41,6 +41,26 @@ class ExtVotesPacketHandler : public PacketHandler {
   bool processVote(const std::shared_ptr<PbftVote>& vote, const std::shared_ptr<PbftBlock>& pbft_block,
                    const std::shared_ptr<TaraxaPeer>& peer, bool validate_max_round_step);
 
+  /**
+   * @brief Checks that vote was not processed yet and its period, round and step. Vote signature, vrf and stake are not
+   * validated
+   *
+   * @param vote
+   * @param peer
+   * @param validate_max_round_step
+   * @return true if vote should be validated, otherwise false
+   */
+  bool checkVoteBeforeValidation(const std::shared_ptr<PbftVote>& vote, const std::shared_ptr<TaraxaPeer>& peer,
+                                 bool validate_max_round_step);
+
+  /**
+   * @brief Checks that vote is unique per period, round, step and voter, submits double voting proof otherwise
+   *
+   * @param vote
+   * @throw MaliciousPeerException in case of double vote
+   */
+  void checkUniqueVote(const std::shared_ptr<PbftVote>& vote);
+
   /**
    * @brief Checks is vote is relevant for current pbft state in terms of period, round and type
    * @param vote
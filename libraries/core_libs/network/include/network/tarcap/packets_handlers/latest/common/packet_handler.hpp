@@ -63,8 +63,24 @@ class PacketHandler : public BasePacketHandler {
 
  protected:
   bool sealAndSend(const dev::p2p::NodeID& node_id, SubprotocolPacketType packet_type, dev::bytes&& rlp_bytes);
+
+  /**
+   * @brief Sends packet encoded once for several peers, buffer is shared by their sessions instead of being copied
+   */
+  bool sealAndSend(const dev::p2p::NodeID& node_id, SubprotocolPacketType packet_type,
+                   std::shared_ptr<const dev::bytes> rlp_bytes);
   void disconnect(const dev::p2p::NodeID& node_id, dev::p2p::DisconnectReason reason);
 
+ private:
+  /**
+   * @brief Checks that packet can be sent to the peer and throttles sync packets
+   * @return host to send packet with, nullptr if packet must not be sent
+   */
+  std::shared_ptr<dev::p2p::Host> prepareSend(const dev::p2p::NodeID& node_id, SubprotocolPacketType packet_type,
+                                              size_t packet_size);
+  std::function<void()> sentPacketStatsCallback(const dev::p2p::NodeID& node_id, SubprotocolPacketType packet_type,
+                                                size_t packet_size);
+
  protected:
   // Node config
   const FullNodeConfig& kConf;
@@ -74,6 +90,9 @@ class PacketHandler : public BasePacketHandler {
   // Shared packet stats
   std::shared_ptr<TimePeriodPacketsStats> packets_stats_;
 
+  // Name of processPacket trace spans
+  const char* const kTraceSpanName;
+
   // Declare logger instances
   LOG_OBJECTS_DEFINE
 };
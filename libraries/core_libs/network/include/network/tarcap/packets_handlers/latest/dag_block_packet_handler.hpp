@@ -16,10 +16,10 @@ class DagBlockPacketHandler : public IDagBlockPacketHandler {
                         std::shared_ptr<PbftSyncingState> pbft_syncing_state, std::shared_ptr<PbftChain> pbft_chain,
                         std::shared_ptr<PbftManager> pbft_mgr, std::shared_ptr<DagManager> dag_mgr,
                         std::shared_ptr<TransactionManager> trx_mgr, std::shared_ptr<DbStorage> db,
-                        const addr_t &node_addr, const std::string &logs_prefix = "");
+                        const addr_t &node_addr, const std::string &logs_prefix = "", bool compact_relay = false);
 
   void sendBlockWithTransactions(const std::shared_ptr<TaraxaPeer> &peer, const std::shared_ptr<DagBlock> &block,
-                                 SharedTransactions &&trxs) override;
+                                 const dev::bytes &block_rlp, SharedTransactions &&trxs) override;
 
   void onNewBlockReceived(std::shared_ptr<DagBlock> &&block, const std::shared_ptr<TaraxaPeer> &peer = nullptr,
                           const std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> &trxs = {});
@@ -30,8 +30,25 @@ class DagBlockPacketHandler : public IDagBlockPacketHandler {
  private:
   virtual void process(const threadpool::PacketData &packet_data, const std::shared_ptr<TaraxaPeer> &peer) override;
 
+  /**
+   * @brief Requests transactions of compactly relayed block that are not known locally, only once per block
+   *
+   * @param peer peer which sent the block
+   * @param block dag block
+   * @param trxs transactions received together with the block
+   * @return true if request was sent and block processing has to wait for the response
+   */
+  bool requestMissingTransactions(const std::shared_ptr<TaraxaPeer> &peer, const DagBlock &block,
+                                  const std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> &trxs);
+
  protected:
   std::shared_ptr<TransactionManager> trx_mgr_{nullptr};
+
+  // Blocks are gossiped without transactions bodies, missing ones are requested by receiver
+  const bool kCompactRelay;
+
+  // Dag blocks whose missing transactions were already requested
+  ExpirationCache<blk_hash_t> requested_blocks_transactions_{10000, 1000};
 };
 
 }  // namespace taraxa::network::tarcap
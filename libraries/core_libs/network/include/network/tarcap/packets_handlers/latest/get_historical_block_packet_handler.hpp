@@ -0,0 +1,51 @@
+#pragma once
+
+#include <future>
+
+#include "network/tarcap/packets/latest/get_historical_block_packet.hpp"
+#include "network/tarcap/packets_handlers/latest/common/packet_handler.hpp"
+#include "network/tarcap/shared_states/historical_blocks_requests.hpp"
+
+namespace taraxa {
+class DbStorage;
+}  // namespace taraxa
+
+namespace taraxa::network::tarcap {
+
+/**
+ * @brief Serves finalized blocks with their transactions and receipts to light nodes that pruned them and requests
+ * such blocks from peers
+ */
+class GetHistoricalBlockPacketHandler : public PacketHandler {
+ public:
+  GetHistoricalBlockPacketHandler(const FullNodeConfig& conf, std::shared_ptr<PeersState> peers_state,
+                                  std::shared_ptr<TimePeriodPacketsStats> packets_stats,
+                                  std::shared_ptr<HistoricalBlocksRequests> requests, std::shared_ptr<DbStorage> db,
+                                  const addr_t& node_addr, const std::string& logs_prefix = "");
+
+  /**
+   * @brief Requests block from the peer, the same pending request is not sent again
+   * @return future of the response, empty response if the peer doesn't have the block or the request failed
+   */
+  std::shared_future<HistoricalBlocksRequests::Response> requestHistoricalBlock(
+      PbftPeriod period, const std::shared_ptr<TaraxaPeer>& peer);
+
+  /**
+   * @brief Cancels request that was not answered in time, late response is then ignored
+   */
+  void cancelRequest(PbftPeriod period, const std::shared_ptr<TaraxaPeer>& peer);
+
+  // Packet type that is processed by this handler
+  static constexpr SubprotocolPacketType kPacketType_ = SubprotocolPacketType::kGetHistoricalBlockPacket;
+
+ private:
+  virtual void process(const threadpool::PacketData& packet_data, const std::shared_ptr<TaraxaPeer>& peer) override;
+
+  std::optional<final_chain::HistoricalBlock> getHistoricalBlock(PbftPeriod period) const;
+
+ protected:
+  std::shared_ptr<HistoricalBlocksRequests> requests_;
+  std::shared_ptr<DbStorage> db_;
+};
+
+}  // namespace taraxa::network::tarcap
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/packet_handler.hpp"
+#include "common/scheduler.hpp"
 #include "network/tarcap/packets/latest/get_pbft_sync_packet.hpp"
 
 namespace taraxa {
@@ -25,6 +26,9 @@ class GetPbftSyncPacketHandler : public PacketHandler {
   // Packet type that is processed by this handler
   static constexpr SubprotocolPacketType kPacketType_ = SubprotocolPacketType::kGetPbftSyncPacket;
 
+  // Number of periods read from db at once when serving sync
+  static constexpr PbftPeriod kPeriodsReadBatchSize = 4;
+
  private:
   virtual void process(const threadpool::PacketData& packet_data, const std::shared_ptr<TaraxaPeer>& peer) override;
 
@@ -37,6 +41,9 @@ class GetPbftSyncPacketHandler : public PacketHandler {
   std::shared_ptr<PbftChain> pbft_chain_;
   std::shared_ptr<VoteManager> vote_mgr_;
   std::shared_ptr<DbStorage> db_;
+
+  // Reads next batch of synced periods while the current one is being sent
+  const util::Executor read_ahead_executor_{util::TaskClass::Network};
 };
 
 }  // namespace taraxa::network::tarcap
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "network/tarcap/packets/latest/get_transactions_packet.hpp"
+#include "network/tarcap/packets_handlers/latest/common/packet_handler.hpp"
+
+namespace taraxa {
+class TransactionManager;
+}  // namespace taraxa
+
+namespace taraxa::network::tarcap {
+
+/**
+ * @brief Serves transactions bodies requested by peers that received only their hashes announcement
+ */
+class GetTransactionsPacketHandler : public PacketHandler {
+ public:
+  GetTransactionsPacketHandler(const FullNodeConfig& conf, std::shared_ptr<PeersState> peers_state,
+                               std::shared_ptr<TimePeriodPacketsStats> packets_stats,
+                               std::shared_ptr<TransactionManager> trx_mgr, const addr_t& node_addr,
+                               const std::string& logs_prefix = "");
+
+  // Packet type that is processed by this handler
+  static constexpr SubprotocolPacketType kPacketType_ = SubprotocolPacketType::kGetTransactionsPacket;
+
+ private:
+  virtual void process(const threadpool::PacketData& packet_data, const std::shared_ptr<TaraxaPeer>& peer) override;
+
+ protected:
+  std::shared_ptr<TransactionManager> trx_mgr_;
+};
+
+}  // namespace taraxa::network::tarcap
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "network/tarcap/packets/latest/historical_block_packet.hpp"
+#include "network/tarcap/packets_handlers/latest/common/packet_handler.hpp"
+#include "network/tarcap/shared_states/historical_blocks_requests.hpp"
+
+namespace taraxa::network::tarcap {
+
+/**
+ * @brief Passes blocks requested by GetHistoricalBlockPacketHandler to their waiting requests, they are verified by
+ * the requester against known block hashes
+ */
+class HistoricalBlockPacketHandler : public PacketHandler {
+ public:
+  HistoricalBlockPacketHandler(const FullNodeConfig& conf, std::shared_ptr<PeersState> peers_state,
+                               std::shared_ptr<TimePeriodPacketsStats> packets_stats,
+                               std::shared_ptr<HistoricalBlocksRequests> requests, const addr_t& node_addr,
+                               const std::string& logs_prefix = "");
+
+  // Packet type that is processed by this handler
+  static constexpr SubprotocolPacketType kPacketType_ = SubprotocolPacketType::kHistoricalBlockPacket;
+
+ private:
+  virtual void process(const threadpool::PacketData& packet_data, const std::shared_ptr<TaraxaPeer>& peer) override;
+
+ protected:
+  std::shared_ptr<HistoricalBlocksRequests> requests_;
+};
+
+}  // namespace taraxa::network::tarcap
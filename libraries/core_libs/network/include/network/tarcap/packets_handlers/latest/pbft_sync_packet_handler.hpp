@@ -1,5 +1,7 @@
 #pragma once
 
+#include <map>
+
 #include "common/thread_pool.hpp"
 #include "network/tarcap/packets/latest/pbft_sync_packet.hpp"
 #include "network/tarcap/packets_handlers/interface/sync_packet_handler.hpp"
@@ -29,10 +31,36 @@ class PbftSyncPacketHandler : public ISyncPacketHandler {
   void pbftSyncComplete();
   void delayedPbftSync(uint32_t counter);
 
+  /**
+   * @brief Validates period data that is next in order and pushes it into period data queue
+   *
+   * @return true if following periods can be processed, false if syncing was completed, stopped or peer was malicious
+   */
+  bool processPeriodData(PbftSyncPacket&& packet, const std::shared_ptr<TaraxaPeer>& peer);
+
+  /**
+   * @brief Disconnects malicious peer and requests its windows from other peers
+   */
+  void handleMaliciousSyncWindowPeer(const dev::p2p::NodeID& peer_id);
+
+  /**
+   * @brief Requests next sync windows or postpones it if syncing is too far ahead of processing
+   */
+  void continuePbftSync();
+
   static constexpr uint32_t kDelayedPbftSyncDelayMs = 10;
 
   std::shared_ptr<VoteManager> vote_mgr_;
   util::ThreadPool periodic_events_tp_;
+
+  struct BufferedPeriodData {
+    // Received PbftSyncPacket, its rlp is decoded only once the period is next in order
+    threadpool::PacketData packet;
+    std::shared_ptr<TaraxaPeer> peer;
+  };
+  // Periods received from windows ahead of the current syncing period, they are processed once previous periods are.
+  // Accessed only from process(), which is never executed concurrently for this packet type
+  std::map<PbftPeriod, BufferedPeriodData> buffered_period_data_;
 };
 
 }  // namespace taraxa::network::tarcap
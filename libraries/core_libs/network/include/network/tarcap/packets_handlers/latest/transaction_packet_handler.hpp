@@ -16,7 +16,7 @@ class TransactionPacketHandler : public ITransactionPacketHandler {
   TransactionPacketHandler(const FullNodeConfig& conf, std::shared_ptr<PeersState> peers_state,
                            std::shared_ptr<TimePeriodPacketsStats> packets_stats,
                            std::shared_ptr<TransactionManager> trx_mgr, const addr_t& node_addr,
-                           const std::string& logs_prefix = "");
+                           const std::string& logs_prefix = "", bool announce_transactions = false);
 
   /**
    * @brief Send transactions
@@ -34,6 +34,14 @@ class TransactionPacketHandler : public ITransactionPacketHandler {
  private:
   virtual void process(const threadpool::PacketData& packet_data, const std::shared_ptr<TaraxaPeer>& peer) override;
 
+  /**
+   * @brief Requests bodies of announced transactions that are not known yet and were not requested from the peer yet
+   *
+   * @param peer peer which announced the hashes
+   * @param hashes announced transactions hashes
+   */
+  void requestAnnouncedTransactions(const std::shared_ptr<TaraxaPeer>& peer, const std::vector<trx_hash_t>& hashes);
+
  protected:
   std::shared_ptr<TransactionManager> trx_mgr_;
 
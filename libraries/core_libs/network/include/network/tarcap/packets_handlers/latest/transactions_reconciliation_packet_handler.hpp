@@ -0,0 +1,39 @@
+#pragma once
+
+#include "network/tarcap/packets/latest/transactions_reconciliation_packet.hpp"
+#include "network/tarcap/packets_handlers/latest/common/ext_transactions_reconciliation_packet_handler.hpp"
+
+namespace taraxa::network::tarcap {
+
+/**
+ * @brief Sends sketches of the local pool to peers and serves transactions they requested after reconciliation
+ *
+ * Sketch that peer failed to decode is sent again with doubled capacity. Capacity of the next periodic sketch follows
+ * the last reconciled difference, so a few hundred bytes are exchanged while pools are close to each other.
+ */
+class TransactionsReconciliationPacketHandler : public ExtTransactionsReconciliationPacketHandler {
+ public:
+  TransactionsReconciliationPacketHandler(const FullNodeConfig& conf, std::shared_ptr<PeersState> peers_state,
+                                          std::shared_ptr<TimePeriodPacketsStats> packets_stats,
+                                          std::shared_ptr<TransactionManager> trx_mgr, const addr_t& node_addr,
+                                          const std::string& logs_prefix = "");
+
+  // Packet type that is processed by this handler
+  static constexpr SubprotocolPacketType kPacketType_ = SubprotocolPacketType::kTransactionsReconciliationPacket;
+
+  /**
+   * @brief Sends sketch of the pool to peers that were not reconciled within the interval, newly connected peers and
+   * peers with reset known caches are reconciled at once
+   * @note This method is used as periodic event
+   *
+   * @param interval_ms
+   */
+  void periodicSendSketches(uint64_t interval_ms);
+
+ private:
+  virtual void process(const threadpool::PacketData& packet_data, const std::shared_ptr<TaraxaPeer>& peer) override;
+
+  void sendSketch(const std::shared_ptr<TaraxaPeer>& peer, const PoolTransactions& pool);
+};
+
+}  // namespace taraxa::network::tarcap
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "network/tarcap/packets/latest/transactions_sketch_packet.hpp"
+#include "network/tarcap/packets_handlers/latest/common/ext_transactions_reconciliation_packet_handler.hpp"
+
+namespace taraxa::network::tarcap {
+
+/**
+ * @brief Reconciles local pool with the sketch of peer pool. Transactions the peer misses are sent to it, the ones
+ * only peer has are requested in TransactionsReconciliationPacket and the rest is marked as known to peer
+ */
+class TransactionsSketchPacketHandler : public ExtTransactionsReconciliationPacketHandler {
+ public:
+  TransactionsSketchPacketHandler(const FullNodeConfig& conf, std::shared_ptr<PeersState> peers_state,
+                                  std::shared_ptr<TimePeriodPacketsStats> packets_stats,
+                                  std::shared_ptr<TransactionManager> trx_mgr, const addr_t& node_addr,
+                                  const std::string& logs_prefix = "");
+
+  // Packet type that is processed by this handler
+  static constexpr SubprotocolPacketType kPacketType_ = SubprotocolPacketType::kTransactionsSketchPacket;
+
+  // Sketches of a peer received sooner after its successful reconciliation are dropped, every sketch costs a pass over
+  // the whole pool
+  static constexpr uint64_t kMinSketchIntervalMs = 200;
+
+ private:
+  virtual void process(const threadpool::PacketData& packet_data, const std::shared_ptr<TaraxaPeer>& peer) override;
+};
+
+}  // namespace taraxa::network::tarcap
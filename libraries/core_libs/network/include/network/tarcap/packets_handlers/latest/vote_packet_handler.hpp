@@ -16,6 +16,9 @@ class VotePacketHandler : public IVotePacketHandler {
   // Packet type that is processed by this handler
   static constexpr SubprotocolPacketType kPacketType_ = SubprotocolPacketType::kVotePacket;
 
+  std::optional<threadpool::PacketData::ConsensusHint> peekConsensusHint(
+      const threadpool::PacketData& packet_data) const override;
+
  private:
   virtual void process(const threadpool::PacketData& packet_data, const std::shared_ptr<TaraxaPeer>& peer) override;
 };
@@ -17,6 +17,9 @@ class VotesBundlePacketHandler : public IVotePacketHandler {
   // Packet type that is processed by this handler
   static constexpr SubprotocolPacketType kPacketType_ = SubprotocolPacketType::kVotesBundlePacket;
 
+  std::optional<threadpool::PacketData::ConsensusHint> peekConsensusHint(
+      const threadpool::PacketData& packet_data) const override;
+
  private:
   virtual void process(const threadpool::PacketData& packet_data, const std::shared_ptr<TaraxaPeer>& peer) override;
 };
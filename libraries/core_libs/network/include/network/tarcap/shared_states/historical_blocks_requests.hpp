@@ -0,0 +1,50 @@
+#pragma once
+
+#include <libp2p/Common.h>
+
+#include <future>
+#include <map>
+#include <mutex>
+#include <optional>
+
+#include "final_chain/data.hpp"
+
+namespace taraxa::network::tarcap {
+
+/**
+ * @brief Historical blocks requested from peers that wait for their responses
+ *
+ * Only responses to pending requests are accepted, the same block requested from the same peer concurrently is sent
+ * and waited for once.
+ */
+class HistoricalBlocksRequests {
+ public:
+  using Response = std::optional<final_chain::HistoricalBlock>;
+
+  /**
+   * @return future of the response and true if the request is new and has to be sent
+   */
+  std::pair<std::shared_future<Response>, bool> add(const dev::p2p::NodeID& peer, PbftPeriod period);
+
+  /**
+   * @brief Resolves pending request with the response
+   * @return false if the block was not requested from the peer or the request was already cancelled
+   */
+  bool complete(const dev::p2p::NodeID& peer, PbftPeriod period, Response&& response);
+
+  /**
+   * @brief Resolves pending request with empty response, e.g. when it timed out
+   */
+  void cancel(const dev::p2p::NodeID& peer, PbftPeriod period);
+
+ private:
+  struct PendingRequest {
+    std::promise<Response> promise;
+    std::shared_future<Response> future;
+  };
+
+  std::mutex mutex_;
+  std::map<std::pair<dev::p2p::NodeID, PbftPeriod>, PendingRequest> pending_;
+};
+
+}  // namespace taraxa::network::tarcap
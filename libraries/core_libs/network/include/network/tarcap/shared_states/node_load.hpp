@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace taraxa::network::tarcap {
+
+/**
+ * @brief Node-wide load level, producers of new work adapt to it gradually instead of stopping at a single limit
+ */
+enum class LoadLevel : uint8_t { kNormal = 0, kElevated, kHigh, kCritical };
+
+const char *toString(LoadLevel level);
+
+/**
+ * @brief Computes load level from the node processing backlogs, shared by all tarcap versions
+ *
+ * Every backlog is graded separately and the worst grade is the node level. Level rises immediately, but it drops by
+ * a single grade per update, so producers don't oscillate between full speed and stop once the backlog is drained.
+ */
+class NodeLoad {
+ public:
+  struct Sample {
+    size_t queued_packets = 0;
+    std::chrono::microseconds avg_packet_queue_wait{0};
+    size_t period_data_queue_bytes = 0;
+    // Pbft periods that were finalized but not executed yet
+    uint64_t finalization_lag = 0;
+    size_t transactions_pool_size = 0;
+  };
+
+  // Average time packets wait in the queue before processing
+  static constexpr std::chrono::milliseconds kElevatedPacketQueueWait{100};
+  static constexpr std::chrono::milliseconds kHighPacketQueueWait{500};
+  static constexpr std::chrono::milliseconds kCriticalPacketQueueWait{2000};
+  // Synced periods waiting for processing
+  static constexpr size_t kElevatedPeriodDataQueueBytes = 64 * 1024 * 1024;
+  static constexpr size_t kHighPeriodDataQueueBytes = 256 * 1024 * 1024;
+  static constexpr size_t kCriticalPeriodDataQueueBytes = 1024 * 1024 * 1024;
+  static constexpr uint64_t kElevatedFinalizationLag = 3;
+  static constexpr uint64_t kHighFinalizationLag = 10;
+  static constexpr uint64_t kCriticalFinalizationLag = 30;
+
+  /**
+   * @param max_packets_queue_size queued packets over this limit are critical load, 0 = queue size is not graded
+   * @param max_transactions_pool_size
+   */
+  NodeLoad(size_t max_packets_queue_size, size_t max_transactions_pool_size);
+
+  /**
+   * @return worst grade of the sample backlogs, not smoothed
+   */
+  LoadLevel grade(const Sample &sample) const;
+
+  /**
+   * @brief Updates level by the new sample, called periodically
+   *
+   * @return new level
+   */
+  LoadLevel update(const Sample &sample);
+
+  LoadLevel level() const { return level_.load(std::memory_order_relaxed); }
+
+ private:
+  const size_t kMaxPacketsQueueSize;
+  const size_t kMaxTransactionsPoolSize;
+
+  std::atomic<LoadLevel> level_{LoadLevel::kNormal};
+};
+
+}  // namespace taraxa::network::tarcap
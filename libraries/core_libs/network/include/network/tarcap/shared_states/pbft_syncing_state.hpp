@@ -1,8 +1,11 @@
 #pragma once
 
+#include <libp2p/Common.h>
+
 #include <atomic>
 #include <memory>
 #include <shared_mutex>
+#include <vector>
 
 #include "common/types.hpp"
 
@@ -16,7 +19,20 @@ class TaraxaPeer;
  */
 class PbftSyncingState {
  public:
-  PbftSyncingState(uint16_t deep_syncing_threshold);
+  /**
+   * @brief Range of periods requested from a single peer during pbft syncing. Peer sends periods in order, so only the
+   * next expected period is tracked
+   */
+  struct SyncWindow {
+    PbftPeriod from;
+    PbftPeriod to;
+    PbftPeriod next;
+    dev::p2p::NodeID peer_id;
+    // Time of the request or of the last period received within the window
+    std::chrono::steady_clock::time_point last_activity;
+  };
+
+  PbftSyncingState(uint16_t deep_syncing_threshold, uint16_t sync_level_size);
 
   /**
    * @brief Set pbft syncing
@@ -70,11 +86,54 @@ class PbftSyncingState {
    */
   bool isActivelySyncing() const;
 
+  /**
+   * @brief Register window requested from peer
+   */
+  void addSyncWindow(SyncWindow window);
+
+  /**
+   * @return windows that are currently requested, sorted by periods
+   */
+  std::vector<SyncWindow> syncWindows() const;
+
+  /**
+   * @brief Checks if period is the next one expected from the peer and moves its window forward. Window is finished
+   * once all its periods are received or peer sent the last block of its chain
+   *
+   * @param peer_id
+   * @param period
+   * @param last_chain_block true if peer sent its latest block together with its cert votes
+   * @return true if period was expected from the peer
+   */
+  bool acceptSyncWindowPeriod(const dev::p2p::NodeID& peer_id, PbftPeriod period, bool last_chain_block);
+
+  /**
+   * @brief Removes windows without any progress in kSyncWindowTimeout so they can be requested from other peers
+   *
+   * @return removed windows
+   */
+  std::vector<SyncWindow> takeStalledSyncWindows();
+
+  /**
+   * @brief Removes all windows requested from peer
+   */
+  void removePeerSyncWindows(const dev::p2p::NodeID& peer_id);
+
+  /**
+   * @return number of periods requested in a single sync window and sent in response to a single request, set from
+   * network.sync_level_size and changeable at runtime
+   */
+  PbftPeriod syncLevelSize() const { return sync_level_size_.load(std::memory_order_relaxed); }
+  void setSyncLevelSize(uint16_t sync_level_size) {
+    sync_level_size_.store(sync_level_size, std::memory_order_relaxed);
+  }
+
  private:
   std::atomic<bool> deep_pbft_syncing_{false};
   std::atomic<bool> pbft_syncing_{false};
 
   const uint16_t kDeepSyncingThreshold;
+  std::atomic<uint16_t> sync_level_size_;
 
   // Number of seconds needed for ongoing syncing to be declared as inactive
   static constexpr std::chrono::seconds kSyncingInactivityThreshold{60};
@@ -88,6 +147,13 @@ class PbftSyncingState {
   // Last syncing peer - it is not reset to null, it is only replaced when new syncing starts
   std::shared_ptr<TaraxaPeer> last_syncing_peer_;
   mutable std::shared_mutex peer_mutex_;
+
+  // Number of seconds after which window without any received period is requested from another peer
+  static constexpr std::chrono::seconds kSyncWindowTimeout{15};
+
+  // Windows requested from peers, sorted by periods
+  std::vector<SyncWindow> sync_windows_;
+  mutable std::shared_mutex sync_windows_mutex_;
 };
 
 }  // namespace taraxa::network::tarcap
@@ -5,6 +5,7 @@
 #include "libp2p/Common.h"
 #include "libp2p/Host.h"
 #include "network/tarcap/packet_types.hpp"
+#include "network/tarcap/shared_states/upload_bandwidth_manager.hpp"
 #include "network/tarcap/stats/time_period_packets_stats.hpp"
 #include "network/tarcap/taraxa_peer.hpp"
 
@@ -22,7 +23,8 @@ class PeersState {
  public:
   using PeersMap = std::unordered_map<dev::p2p::NodeID, std::shared_ptr<TaraxaPeer>>;
 
-  PeersState(std::weak_ptr<dev::p2p::Host> host, const FullNodeConfig& conf);
+  PeersState(std::weak_ptr<dev::p2p::Host> host, const FullNodeConfig& conf,
+             std::shared_ptr<UploadBandwidthManager> upload_bandwidth = nullptr);
 
   std::shared_ptr<TaraxaPeer> getPeer(const dev::p2p::NodeID& node_id) const;
   std::shared_ptr<TaraxaPeer> getPendingPeer(const dev::p2p::NodeID& node_id) const;
@@ -38,6 +40,11 @@ class PeersState {
                                                                           SubprotocolPacketType packet_type) const;
 
   PeersMap getAllPeers() const;
+
+  /**
+   * @return all peers ordered by TaraxaPeer::gossipScore, the best ones first
+   */
+  std::vector<std::shared_ptr<TaraxaPeer>> getPeersByGossipScore() const;
   std::vector<dev::p2p::NodeID> getAllPendingPeersIDs() const;
   size_t getPeersCount() const;
   std::shared_ptr<TaraxaPeer> addPendingPeer(const dev::p2p::NodeID& node_id, const std::string& address);
@@ -80,6 +87,8 @@ class PeersState {
 
  public:
   const std::weak_ptr<dev::p2p::Host> host_;
+  // Upload budget of sync packets, nullptr = unlimited
+  const std::shared_ptr<UploadBandwidthManager> upload_bandwidth_;
 
  private:
   mutable std::shared_mutex peers_mutex_;
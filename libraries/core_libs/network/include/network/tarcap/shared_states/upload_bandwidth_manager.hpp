@@ -0,0 +1,95 @@
+#pragma once
+
+#include <libp2p/Common.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include "config/network.hpp"
+#include "network/tarcap/packet_types.hpp"
+
+namespace taraxa::network::tarcap {
+
+/**
+ * @brief Token bucket limiting rate of sent bytes
+ */
+class TokenBucket {
+ public:
+  TokenBucket(uint64_t bytes_per_second, uint64_t burst_bytes);
+
+  /**
+   * @brief Takes bytes from the bucket, bucket goes into debt if there is not enough tokens
+   *
+   * @param bytes
+   * @param now
+   * @return time after which the debt is repaid, zero if there were enough tokens
+   */
+  std::chrono::microseconds consume(size_t bytes, std::chrono::steady_clock::time_point now);
+
+ private:
+  const double kBytesPerSecond;
+  const double kBurstBytes;
+
+  std::mutex mutex_;
+  double tokens_;
+  std::chrono::steady_clock::time_point last_refill_;
+};
+
+/**
+ * @brief Upload budget for sync packets served to other peers, shared by all tarcap versions
+ *
+ * Each peer has its own bucket and all of them share the total one. Sending thread is blocked until the packet fits
+ * into both budgets, so serving of sync requests slows down while consensus packets are sent without any limit.
+ */
+class UploadBandwidthManager {
+ public:
+  explicit UploadBandwidthManager(const SyncUploadConfig &config);
+
+  /**
+   * @param packet_type
+   * @return true if packet_type is limited by the upload budget
+   */
+  static bool isThrottled(SubprotocolPacketType packet_type);
+
+  /**
+   * @brief Takes packet size from the peer and total budgets
+   *
+   * @param node_id
+   * @param bytes
+   * @return time the sender has to wait before the packet is sent
+   */
+  std::chrono::microseconds reserve(const dev::p2p::NodeID &node_id, size_t bytes);
+
+  /**
+   * @brief Blocks caller until packet fits into the budget
+   *
+   * @param node_id
+   * @param bytes
+   */
+  void throttle(const dev::p2p::NodeID &node_id, size_t bytes);
+
+  void erasePeer(const dev::p2p::NodeID &node_id);
+
+  uint64_t sentBytes() const { return sent_bytes_; }
+  uint64_t throttledPacketsCount() const { return throttled_packets_count_; }
+  std::chrono::milliseconds throttleDuration() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::microseconds(throttle_duration_us_));
+  }
+
+ private:
+  const SyncUploadConfig kConfig;
+
+  std::optional<TokenBucket> total_bucket_;
+
+  std::mutex peers_buckets_mutex_;
+  std::unordered_map<dev::p2p::NodeID, std::shared_ptr<TokenBucket>> peers_buckets_;
+
+  std::atomic<uint64_t> sent_bytes_{0};
+  std::atomic<uint64_t> throttled_packets_count_{0};
+  std::atomic<uint64_t> throttle_duration_us_{0};
+};
+
+}  // namespace taraxa::network::tarcap
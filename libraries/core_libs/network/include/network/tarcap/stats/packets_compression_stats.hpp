@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include "network/tarcap/packet_types.hpp"
+
+namespace taraxa::network::tarcap {
+
+/**
+ * @brief Compression stats per packet type, used to skip compression of packet types that do not compress well
+ *
+ * Packet type is compressed until kMinSamples packets were observed. Afterwards it is compressed only if average
+ * compressed size is below kMaxCompressionRatio of original size. Types that are not compressed are still sampled
+ * every kResampleInterval packets so the decision adapts when payload of the type changes.
+ */
+class PacketsCompressionStats {
+ public:
+  struct PacketTypeStats {
+    SubprotocolPacketType packet_type;
+    uint64_t count;
+    uint64_t size;
+    uint64_t compressed_size;
+    std::chrono::microseconds duration;
+  };
+
+  /**
+   * @param packet_type
+   * @return true if packet of packet_type should be compressed
+   */
+  bool shouldCompress(SubprotocolPacketType packet_type);
+
+  /**
+   * @brief Adds compressed packet to the stats
+   *
+   * @param packet_type
+   * @param size original size
+   * @param compressed_size
+   * @param duration time spent compressing packet
+   */
+  void addCompressedPacket(SubprotocolPacketType packet_type, size_t size, size_t compressed_size,
+                           std::chrono::microseconds duration);
+
+  /**
+   * @return stats of packet types with at least one compressed packet
+   */
+  std::vector<PacketTypeStats> getStats() const;
+
+ private:
+  struct Stats {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> size{0};
+    std::atomic<uint64_t> compressed_size{0};
+    std::atomic<uint64_t> duration_us{0};
+    std::atomic<uint64_t> skipped{0};
+  };
+
+  static constexpr uint64_t kMinSamples = 16;
+  static constexpr double kMaxCompressionRatio = 0.9;
+  static constexpr uint64_t kResampleInterval = 64;
+
+  std::array<Stats, SubprotocolPacketType::kPacketCount> stats_;
+};
+
+}  // namespace taraxa::network::tarcap
@@ -2,16 +2,29 @@
 
 #include <json/json.h>
 
+#include <array>
+#include <atomic>
+#include <mutex>
+
 #include "max_stats.hpp"
-#include "packets_stats.hpp"
+#include "network/tarcap/packet_types.hpp"
+#include "packet_stats.hpp"
 
 namespace taraxa::network::tarcap {
 
 /**
  * @brief Stats for all packet types
+ *
+ * Packets are counted in per thread shards: each thread that adds packets owns one shard and is its only writer, so
+ * adding a packet is a few plain loads and stores without locks or read-modify-write atomics. Shards are merged only
+ * when stats are read. Threads over kShardsCount - 1 share the last shard under a mutex.
+ *
+ * Counters are never zeroed, reset only takes a snapshot that is subtracted from later reads.
  */
 class PacketsStats {
  public:
+  static constexpr size_t kShardsCount = 32;
+
   PacketsStats();
   PacketsStats(const PacketsStats &) = delete;
   PacketsStats &operator=(const PacketsStats &) = delete;
@@ -20,10 +33,8 @@ class PacketsStats {
 
   ~PacketsStats() = default;
 
-  using PerPacketStatsMap = std::unordered_map<std::string /*packet name*/, PacketStats>;
-
  public:
-  void addPacket(const std::string &packet_type, const PacketStats &packet);
+  void addPacket(SubprotocolPacketType packet_type, const PacketStats &packet);
 
   std::pair<std::chrono::system_clock::time_point, PacketStats> getAllPacketsStatsCopy() const;
   Json::Value getStatsJson() const;
@@ -34,15 +45,39 @@ class PacketsStats {
   void resetStats();
 
  private:
-  // Time point since which are the stats measured
-  std::chrono::system_clock::time_point start_time_;
+  using PerPacketStats = std::array<PacketStats, SubprotocolPacketType::kPacketCount>;
+
+  struct Counters {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> size{0};
+    std::atomic<uint64_t> processing_duration_us{0};
+    std::atomic<uint64_t> tp_wait_duration_us{0};
+  };
 
-  // Stats for all packets types combined
-  PacketStats all_packets_stats_;
+  // Aligned to cache line, so writers of different shards don't invalidate each other's lines
+  struct alignas(64) Shard {
+    std::array<Counters, SubprotocolPacketType::kPacketCount> per_packet;
+  };
 
-  // Stas per individual packet type
-  PerPacketStatsMap per_packet_stats_;
-  mutable std::shared_mutex mutex_;
+  /**
+   * @return sum of all shards minus the last reset snapshot, must be called with mutex_ locked
+   */
+  PerPacketStats mergeShards() const;
+
+  /**
+   * @return sum of all shards since the stats were created
+   */
+  PerPacketStats sumShards() const;
+
+  std::array<Shard, kShardsCount> shards_;
+  // Serializes writers of the shared shard
+  std::mutex shared_shard_mutex_;
+
+  // Time point since which are the stats measured
+  std::chrono::system_clock::time_point start_time_;
+  // Sum of all shards at the time of the last reset
+  PerPacketStats reset_snapshot_{};
+  mutable std::mutex mutex_;
 };
 
-}  // namespace taraxa::network::tarcap
\ No newline at end of file
+}  // namespace taraxa::network::tarcap
@@ -17,8 +17,8 @@ class TimePeriodPacketsStats {
  public:
   TimePeriodPacketsStats(std::chrono::milliseconds reset_time_period, const addr_t& node_addr = {});
 
-  void addReceivedPacket(const std::string& packet_type, const dev::p2p::NodeID& node, const PacketStats& packet);
-  void addSentPacket(const std::string& packet_type, const dev::p2p::NodeID& node, const PacketStats& packet);
+  void addReceivedPacket(SubprotocolPacketType packet_type, const dev::p2p::NodeID& node, const PacketStats& packet);
+  void addSentPacket(SubprotocolPacketType packet_type, const dev::p2p::NodeID& node, const PacketStats& packet);
 
   /**
    * @brief Logs both received as well as sent packets stats + updates max count/size and reset stats
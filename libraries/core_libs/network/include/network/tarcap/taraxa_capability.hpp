@@ -9,8 +9,10 @@
 
 #include "common/thread_pool.hpp"
 #include "config/config.hpp"
+#include "network/tarcap/packets_capture.hpp"
 #include "network/tarcap/packets_handler.hpp"
 #include "network/tarcap/shared_states/peers_state.hpp"
+#include "network/tarcap/stats/packets_compression_stats.hpp"
 #include "network/tarcap/tarcap_version.hpp"
 #include "network/threadpool/tarcap_thread_pool.hpp"
 #include "pbft/pbft_chain.hpp"
@@ -75,6 +77,8 @@ class TaraxaCapability final : public dev::p2p::CapabilityFace {
                    std::weak_ptr<dev::p2p::Host> host,
                    std::shared_ptr<network::threadpool::PacketsThreadPool> threadpool,
                    std::shared_ptr<TimePeriodPacketsStats> packets_stats,
+                   std::shared_ptr<PacketsCompressionStats> compression_stats,
+                   std::shared_ptr<UploadBandwidthManager> upload_bandwidth,
                    std::shared_ptr<PbftSyncingState> syncing_state, std::shared_ptr<DbStorage> db,
                    std::shared_ptr<PbftManager> pbft_mgr, std::shared_ptr<PbftChain> pbft_chain,
                    std::shared_ptr<VoteManager> vote_mgr, std::shared_ptr<DagManager> dag_mgr,
@@ -95,25 +99,57 @@ class TaraxaCapability final : public dev::p2p::CapabilityFace {
   unsigned messageCount() const override;
   void onConnect(std::weak_ptr<dev::p2p::Session> session, u256 const &) override;
   void onDisconnect(dev::p2p::NodeID const &_nodeID) override;
-  void interpretCapabilityPacket(std::weak_ptr<dev::p2p::Session> session, unsigned _id, dev::RLP const &_r) override;
+  void interpretCapabilityPacket(std::weak_ptr<dev::p2p::Session> session, unsigned _id, dev::RLP const &_r,
+                                 dev::p2p::ReceiveBuffer const &buffer) override;
   std::string packetTypeToString(unsigned _packetType) const override;
+  dev::p2p::PacketPriority packetPriority(unsigned _packetType) const override;
+  bool compressPacket(unsigned _packetType) const override;
+  void onPacketCompressed(unsigned _packetType, size_t _size, size_t _compressedSize,
+                          std::chrono::microseconds _duration) override;
 
   const std::shared_ptr<PeersState> &getPeersState();
 
   /**
-   * @brief templated getSpecificHandler method for getting specific packet handler based on packet_type
+   * @brief Records all incoming packets into capture, must be set before host starts processing network events
+   */
+  void setPacketsCapture(std::shared_ptr<PacketsCapture> capture);
+
+  /**
+   * @brief Pushes recorded packet into packets thread pool as if it was received from its peer. Peer that is not
+   *        connected is added to peers, so handlers process its packets
+   */
+  void replayPacket(PacketsCapture::Record &&record);
+
+  /**
+   * @brief templated getSpecificHandler method for getting specific packet handler interface based on packet_type
    *
-   * @tparam PacketHandlerType
+   * @tparam kPacketType
    *
-   * @return std::shared_ptr<PacketHandlerType>
+   * @return std::shared_ptr to handler interface of kPacketType
    */
-  template <typename PacketHandlerType>
-  std::shared_ptr<PacketHandlerType> getSpecificHandler(SubprotocolPacketType packet_type) const;
+  template <SubprotocolPacketType kPacketType>
+  std::shared_ptr<PacketHandlerInterfaceType<kPacketType>> getSpecificHandler() const {
+    return packets_handlers_->getSpecificHandler<kPacketType>();
+  }
 
  private:
   bool filterSyncIrrelevantPackets(SubprotocolPacketType packet_type) const;
   void handlePacketQueueOverLimit(std::shared_ptr<dev::p2p::Host> host, dev::p2p::NodeID node_id, size_t tp_queue_size);
 
+  /**
+   * @brief Cheap pre-filter of gossiped packets on the network thread. Hashes are extracted from rlp without full
+   *        decoding and checked against known-hash caches, so duplicates do not occupy packets queue
+   *
+   * @param packet_type
+   * @param packet_rlp
+   * @param buffer received buffer packet_rlp points into, packet that is not trimmed keeps it instead of a copy
+   * @param peer
+   * @return packet to be queued, empty optional in case packet contains only already known data
+   */
+  std::optional<threadpool::PacketData> preFilterPacket(SubprotocolPacketType packet_type, const dev::RLP &packet_rlp,
+                                                        const dev::p2p::ReceiveBuffer &buffer,
+                                                        const std::shared_ptr<TaraxaPeer> &peer) const;
+
  private:
   // Capability version
   TarcapVersion version_;
@@ -121,6 +157,9 @@ class TaraxaCapability final : public dev::p2p::CapabilityFace {
   // Packets stats per time period
   std::shared_ptr<TimePeriodPacketsStats> all_packets_stats_;
 
+  // Packets compression stats shared by all capability versions
+  std::shared_ptr<PacketsCompressionStats> compression_stats_;
+
   // Node config
   const FullNodeConfig &kConf;
 
@@ -136,6 +175,14 @@ class TaraxaCapability final : public dev::p2p::CapabilityFace {
   // Main Threadpool for processing packets
   std::shared_ptr<threadpool::PacketsThreadPool> thread_pool_;
 
+  // Log of incoming packets, nullptr if capture is disabled
+  std::shared_ptr<PacketsCapture> packets_capture_;
+
+  // Used by packets pre-filter to check known hashes
+  std::shared_ptr<VoteManager> vote_mgr_;
+  std::shared_ptr<DagManager> dag_mgr_;
+  std::shared_ptr<TransactionManager> trx_mgr_;
+
   // Last disconnect time and number of peers
   std::chrono::system_clock::time_point last_ddos_disconnect_time_ = {};
   std::chrono::system_clock::time_point queue_over_limit_start_time_ = {};
@@ -145,57 +192,4 @@ class TaraxaCapability final : public dev::p2p::CapabilityFace {
   LOG_OBJECTS_DEFINE
 };
 
-template <typename PacketHandlerType>
-std::shared_ptr<PacketHandlerType> TaraxaCapability::getSpecificHandler(SubprotocolPacketType packet_type) const {
-  // Note: Allow to manually cast only to known base classes types.
-  // We support multiple taraxa capabilities, which can contain different versions of packet handlers and casting
-  // directly to final classes types breaks the functionality...
-  switch (packet_type) {
-    case SubprotocolPacketType::kPbftSyncPacket:
-    case SubprotocolPacketType::kStatusPacket:
-      if (!std::is_same<ISyncPacketHandler, PacketHandlerType>::value) {
-        assert(false);
-      }
-      break;
-
-    case SubprotocolPacketType::kTransactionPacket:
-      if (!std::is_same<ITransactionPacketHandler, PacketHandlerType>::value) {
-        assert(false);
-      }
-      break;
-
-    case SubprotocolPacketType::kVotePacket:
-    case SubprotocolPacketType::kVotesBundlePacket:
-      if (!std::is_same<IVotePacketHandler, PacketHandlerType>::value) {
-        assert(false);
-      }
-      break;
-
-    case SubprotocolPacketType::kPillarVotePacket:
-      if (!std::is_same<IPillarVotePacketHandler, PacketHandlerType>::value) {
-        assert(false);
-      }
-      break;
-
-    case SubprotocolPacketType::kGetPillarVotesBundlePacket:
-      if (!std::is_same<IGetPillarVotesBundlePacketHandler, PacketHandlerType>::value) {
-        assert(false);
-      }
-      break;
-
-    case SubprotocolPacketType::kDagBlockPacket:
-      if (!std::is_same<IDagBlockPacketHandler, PacketHandlerType>::value) {
-        assert(false);
-      }
-      break;
-
-    default:
-      assert(false);
-      return nullptr;
-  }
-
-  auto handler = packets_handlers_->getSpecificHandler(packet_type);
-  return std::dynamic_pointer_cast<PacketHandlerType>(handler);
-}
-
 }  // namespace taraxa::network::tarcap
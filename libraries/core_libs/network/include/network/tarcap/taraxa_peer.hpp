@@ -5,6 +5,7 @@
 #include <atomic>
 #include <boost/noncopyable.hpp>
 
+#include "common/rotating_bloom_filter.hpp"
 #include "common/types.hpp"
 #include "common/util.hpp"
 #include "network/tarcap/stats/packets_stats.hpp"
@@ -14,7 +15,12 @@ namespace taraxa::network::tarcap {
 class TaraxaPeer : public boost::noncopyable {
  public:
   TaraxaPeer();
-  TaraxaPeer(const dev::p2p::NodeID& id, size_t transaction_pool_size, std::string address);
+  /**
+   * @param known_transactions_bytes memory used to track transactions known to peer
+   * @param known_transactions_fp_rate probability that unknown transaction is considered as known to peer
+   */
+  TaraxaPeer(const dev::p2p::NodeID& id, std::string address, size_t known_transactions_bytes,
+             double known_transactions_fp_rate);
 
   /**
    * @brief Mark dag block as known
@@ -36,6 +42,15 @@ class TaraxaPeer : public boost::noncopyable {
   bool markTransactionAsKnown(const trx_hash_t& hash);
   bool isTransactionKnown(const trx_hash_t& hash) const;
 
+  /**
+   * @brief Mark announced transaction as requested from this peer
+   *
+   * @param hash
+   * @return true in case transaction was not requested from this peer before, otherwise false (request is in flight or
+   * was already done)
+   */
+  bool markTransactionAsRequested(const trx_hash_t& hash);
+
   /**
    * @brief Mark pbft vote as known
    *
@@ -94,7 +109,7 @@ class TaraxaPeer : public boost::noncopyable {
    * @param packet_type
    * @param packet
    */
-  void addSentPacket(const std::string& packet_type, const PacketStats& packet);
+  void addSentPacket(SubprotocolPacketType packet_type, const PacketStats& packet);
 
   /**
    * @return AllPacketsStats - packets stats for packets received from peer
@@ -107,10 +122,27 @@ class TaraxaPeer : public boost::noncopyable {
   void resetPacketsStats();
 
   /**
-   * @brief Resets known caches - used for testing
+   * @brief Resets known caches, transactions pool is reconciled with peer again as soon as possible
    */
   void resetKnownCaches();
 
+  /**
+   * @return approximate memory used by known and requested items caches in bytes
+   */
+  size_t knownCachesMemoryUsage() const;
+
+  /**
+   * @brief Priority of the peer when gossiping votes, lower is sent first. It is ping round trip time reduced by 1ms
+   * for each vote the peer delivered first in recent periods (at most by half), so well connected peers that relay
+   * votes quickly go before peers with similar latency. Peers without measured latency go last
+   */
+  uint64_t gossipScore() const;
+
+  /**
+   * @brief Halves counters of useful data, called periodically so the score follows recent behaviour
+   */
+  void decayGossipStats();
+
  public:
   std::atomic<bool> syncing_ = false;
   std::atomic<uint64_t> dag_level_ = 0;
@@ -125,6 +157,21 @@ class TaraxaPeer : public boost::noncopyable {
   std::atomic_uint64_t peer_requested_dag_syncing_time_ = 0;
   std::atomic_bool peer_light_node = false;
   std::atomic<PbftPeriod> peer_light_node_history = 0;
+  // Transactions pool insertion sequence number up to which all pool transactions were sent or known to peer
+  std::atomic<uint64_t> transactions_send_cursor_ = 0;
+  // Last measured p2p ping round trip time, 0 if not measured yet
+  std::atomic<uint64_t> ping_rtt_us_ = 0;
+  // New valid votes this peer delivered before any other peer, decayed periodically
+  std::atomic<uint64_t> first_delivered_votes_ = 0;
+  // Transactions pool reconciliation: steady clock ms of the last sketch sent to peer, sketch is sent again once the
+  // interval elapsed, 0 = as soon as possible
+  std::atomic<uint64_t> last_sketch_sent_ms_ = 0;
+  // Steady clock ms of the last peer sketch that was reconciled
+  std::atomic<uint64_t> last_sketch_received_ms_ = 0;
+  // Number of pools differences the next sketch is sized for, follows the last reconciled difference
+  std::atomic<uint32_t> reconciliation_capacity_ = 0;
+  // Sketch was sent and reconciliation response is expected
+  std::atomic<bool> reconciliation_pending_ = false;
   std::string address_;
 
   // Mutex used to prevent race condition between dag syncing and gossiping
@@ -133,11 +180,15 @@ class TaraxaPeer : public boost::noncopyable {
  private:
   dev::p2p::NodeID id_;
 
-  ExpirationBlockNumberCache<blk_hash_t> known_dag_blocks_;
-  ExpirationBlockNumberCache<trx_hash_t> known_transactions_;
+  ShardedExpirationCache<blk_hash_t> known_dag_blocks_;
+  // Transactions are by far the most numerous known items, so they are tracked approximately with bounded memory
+  util::RotatingBloomFilter<trx_hash_t> known_transactions_;
+  static constexpr size_t kKnownTransactionsExactCount = 4096;
+  // Announced transactions requested from the peer
+  ExpirationCache<trx_hash_t> requested_transactions_;
   // PBFT
-  ExpirationBlockNumberCache<blk_hash_t> known_pbft_blocks_;
-  ExpirationBlockNumberCache<vote_hash_t> known_votes_;  // both pbft & pillar votes
+  ShardedExpirationCache<blk_hash_t> known_pbft_blocks_;
+  ShardedExpirationCache<vote_hash_t> known_votes_;  // both pbft & pillar votes
 
   std::atomic<uint64_t> timestamp_suspicious_packet_ = 0;
   std::atomic<uint64_t> suspicious_packet_count_ = 0;
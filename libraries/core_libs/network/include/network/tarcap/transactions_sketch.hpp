@@ -0,0 +1,89 @@
+#pragma once
+
+#include <libdevcore/Common.h>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "common/types.hpp"
+
+namespace taraxa::network::tarcap {
+
+/**
+ * @brief Invertible bloom lookup table of transactions short ids, used for pool reconciliation with peers
+ *
+ * Sketch of the local pool minus sketch of the peer pool contains only transactions that are in one of the pools, so it
+ * can be decoded into the exact difference if the difference is not bigger than the capacity the sketch was built for.
+ * Size of the sketch depends only on the capacity, not on the pools size.
+ *
+ * Short id is the first 8 bytes of transaction hash. Hash is already uniformly distributed, a collision only means
+ * that transaction is not reconciled and it is propagated by regular gossip.
+ */
+class TransactionsSketch {
+ public:
+  // Each id is stored in one cell of each of kHashesCount equally sized subtables
+  static constexpr size_t kHashesCount = 3;
+  // Serialized cell: count, ids xor and checksums xor
+  static constexpr size_t kCellSize = sizeof(int32_t) + sizeof(uint64_t) + sizeof(uint32_t);
+  // Differences decodable with high probability are ~ 1 / kCellsPerDifference of cells count
+  static constexpr double kCellsPerDifference = 2.0;
+  static constexpr size_t kMaxCells = 3 * 4096;
+
+  static uint64_t shortId(const trx_hash_t& hash);
+
+  /**
+   * @param capacity number of differences the sketch should be able to decode
+   * @return number of cells of the sketch
+   */
+  static size_t cellsCount(size_t capacity);
+
+  explicit TransactionsSketch(size_t cells_count);
+
+  /**
+   * @brief Decodes serialized sketch
+   * @throws std::invalid_argument if size is not a multiple of cells or is over kMaxCells
+   */
+  static TransactionsSketch fromBytes(const dev::bytes& bytes);
+  dev::bytes toBytes() const;
+
+  void add(uint64_t short_id);
+
+  /**
+   * @brief Subtracts other sketch of the same size, result represents symmetric difference of both sets
+   */
+  void subtract(const TransactionsSketch& other);
+
+  struct Difference {
+    // Ids that are only in this set
+    std::vector<uint64_t> local;
+    // Ids that are only in the subtracted set
+    std::vector<uint64_t> remote;
+  };
+
+  /**
+   * @return difference of a subtracted sketch, nullopt if difference is bigger than sketch can decode
+   */
+  std::optional<Difference> decode() const;
+
+  size_t cellsCount() const { return cells_.size(); }
+
+ private:
+  struct Cell {
+    int32_t count = 0;
+    uint64_t ids = 0;
+    uint32_t checksums = 0;
+
+    bool empty() const { return count == 0 && ids == 0 && checksums == 0; }
+    bool pure() const { return (count == 1 || count == -1) && checksum(ids) == checksums; }
+  };
+
+  static uint32_t checksum(uint64_t short_id);
+  size_t cellIndex(uint64_t short_id, size_t hash_index) const;
+  static void toggleCell(std::vector<Cell>& cells, size_t index, uint64_t short_id, int32_t count);
+  void toggle(std::vector<Cell>& cells, uint64_t short_id, int32_t count) const;
+
+  std::vector<Cell> cells_;
+};
+
+}  // namespace taraxa::network::tarcap
@@ -4,7 +4,9 @@
 #include <libp2p/Common.h>
 
 #include <chrono>
+#include <optional>
 
+#include "common/types.hpp"
 #include "network/tarcap/packet_types.hpp"
 
 namespace taraxa::network::threadpool {
@@ -14,7 +16,38 @@ class PacketData {
   using PacketId = uint64_t;
   enum PacketPriority : size_t { High = 0, Mid, Low, Count };
 
+  /**
+   * @brief Consensus position of vote packet peeked from its rlp, so scheduler can order and drop votes without
+   *        decoding them
+   */
+  struct ConsensusHint {
+    PbftPeriod period;
+    PbftRound round;
+    PbftStep step;
+
+    /**
+     * @return true if vote can still be used by consensus in the current period and round
+     */
+    bool isRelevant(PbftPeriod current_period, PbftRound current_round) const;
+
+    /**
+     * @return true if vote is for the current period and round
+     */
+    bool isCurrent(PbftPeriod current_period, PbftRound current_round) const {
+      return period == current_period && round == current_round;
+    }
+  };
+
   PacketData(SubprotocolPacketType type, const dev::p2p::NodeID& from_node_id, std::vector<unsigned char>&& bytes);
+
+  /**
+   * @brief Packet rlp points into received buffer, which is kept alive by the packet instead of being copied
+   *
+   * @param buffer
+   * @param rlp part of the buffer with packet rlp
+   */
+  PacketData(SubprotocolPacketType type, const dev::p2p::NodeID& from_node_id,
+             std::shared_ptr<const dev::bytes> buffer, dev::bytesConstRef rlp);
   ~PacketData() = default;
   PacketData(const PacketData&) = default;
   PacketData(PacketData&&) = default;
@@ -33,8 +66,8 @@ class PacketData {
    */
   static inline PacketPriority getPacketPriority(SubprotocolPacketType packet_type);
 
-  // Packet bytes had to be copied here as dev::RLP does not own vector of bytes, it only "points to" it
-  std::vector<unsigned char> rlp_bytes_;
+  // dev::RLP does not own bytes, it only "points to" them. Buffer is shared so copies of packet stay valid
+  std::shared_ptr<const dev::bytes> rlp_bytes_;
 
  public:
   PacketId id_{0};  // Unique packet id (counter)
@@ -45,6 +78,8 @@ class PacketData {
   PacketPriority priority_;
   dev::p2p::NodeID from_node_id_;
   dev::RLP rlp_;
+  // Set by packet handler when packet is pushed into the threadpool
+  std::optional<ConsensusHint> consensus_hint_;
 };
 
 }  // namespace taraxa::network::threadpool
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <libp2p/Common.h>
 
 #include <map>
+#include <unordered_set>
 
 #include "network/tarcap/packet_types.hpp"
 #include "network/threadpool/packet_data.hpp"
@@ -29,9 +30,6 @@ class PacketsBlockingMask {
   void markPacketAsPeerOrderBlocked(const PacketData& blocking_packet, SubprotocolPacketType packet_type_to_block);
   void markPacketAsPeerOrderUnblocked(const PacketData& blocking_packet, SubprotocolPacketType packet_type_to_unblock);
 
-  void setDagBlockLevelBeingProcessed(const PacketData& packet);
-  void unsetDagBlockLevelBeingProcessed(const PacketData& packet);
-
   void setDagBlockBeingProcessed(const PacketData& packet);
   void unsetDagBlockBeingProcessed(const PacketData& packet);
 
@@ -40,12 +38,10 @@ class PacketsBlockingMask {
  private:
   bool isPacketHardBlocked(const PacketData& packet_data) const;
   bool isPacketPeerOrderBlocked(const PacketData& packet_data) const;
-  bool isDagBlockPacketBlockedByLevel(const PacketData& packet_data) const;
+  bool isDagBlockPacketBlockedByDependencies(const PacketData& packet_data) const;
   bool isDagBlockPacketBlockedBySameDagBlock(const PacketData& packet_data) const;
   dev::RLP dagBlockFromDagPacket(const PacketData& packet_data) const;
 
-  std::optional<taraxa::level_t> getSmallestDagLevelBeingProcessed() const;
-
  private:
   // Packets types that are currently hard blocked for processing in another threads due to dependencies,
   // e.g. syncing packets must be processed synchronously one by one, etc...
@@ -62,22 +58,16 @@ class PacketsBlockingMask {
   std::unordered_map<SubprotocolPacketType, std::unordered_map<dev::p2p::NodeID, std::set<PacketData::PacketId>>>
       peer_order_blocked_packet_types_;
 
-  // This "blocking dependency" is specific just for DagBlockPacket. Ideally only dag blocks with the same level
-  // should be processed. In reality there are situation when node receives dag block with smaller level than the level
-  // of blocks that are already being processed. In such case these blocks with smaller levels can be processed
-  // concurrently with blocks that have higher level. All new dag blocks with higher level than the lowest level from
-  // all the blocks that currently being processed are blocked for processing In this map are saved pairs of <level,
-  // list>, where:
-  //    level - What dag level have blocks that are currently being processed
-  //    list - list of "DagBlockPacket" packets (of the same dag block level) that are currently being processed
-  //    concurrently
-  // Order of levels must be preserved, therefore using std::map
-  std::map<taraxa::level_t, std::unordered_set<PacketData::PacketId>> processing_dag_levels_;
-
   // This "blocking dependency" is specific just for DagBlockPacket. Multiple nodes can send same dag blocks
   // concurrently, to reduce perofrmance impact only one packet/block will be processsed and others will be waiting.
-  //  This map contains dag blocks that are currently processed with the associated packet id
-  std::map<taraxa::sig_t, PacketData::PacketId> processing_dag_blocks_;
+  // This map contains dag blocks (identified by signature) that are currently processed with their hashes
+  std::map<taraxa::sig_t, taraxa::blk_hash_t> processing_dag_blocks_;
+
+  // This "blocking dependency" is specific just for DagBlockPacket. Dag block can be processed only after its pivot
+  // and tips are processed, so only dag blocks whose pivot or some of the tips are currently being processed are
+  // blocked. Blocks that do not depend on each other (even with different levels) are processed concurrently.
+  // This set contains hashes of dag blocks that are currently processed
+  std::unordered_set<taraxa::blk_hash_t> processing_dag_blocks_hashes_;
 
   std::shared_ptr<PbftManager> pbft_mgr_;
 
@@ -11,6 +11,12 @@ namespace taraxa::network::threadpool {
 
 class PacketsQueue {
  public:
+  // Current period and round of consensus
+  using ConsensusPosition = std::pair<PbftPeriod, PbftRound>;
+
+  // Max number of deferred votes of other rounds scanned while looking for a vote of the current round
+  static constexpr size_t kMaxConsensusLookahead = 64;
+
   PacketsQueue() = default;
 
   /**
@@ -25,14 +31,19 @@ class PacketsQueue {
    *        blocking dependencies there might returned empty optional
    * @note If empty optional is returned too often, there might be some logical bug in terms of packet priority &
    *       existing dependencies
+   * @note If consensus position is provided, votes that are no longer relevant are dropped and votes of the current
+   *       round are returned before the other ones
    * @param blocked_packets_types_mask bit mask with all blocked packets for processing
+   * @param consensus_position current period and round of consensus
    *
    * @return std::optional<Task>
    */
-  std::optional<std::pair<tarcap::TarcapVersion, PacketData>> pop(const PacketsBlockingMask& packets_blocking_mask);
+  std::optional<std::pair<tarcap::TarcapVersion, PacketData>> pop(
+      const PacketsBlockingMask& packets_blocking_mask,
+      const std::optional<ConsensusPosition>& consensus_position = std::nullopt);
 
   /**
-   * @return false in case there is already kMaxWorkersCount_ workers processing packets from
+   * @return false in case there is already max_workers_count_ workers processing packets from
    *         this queue at the same time, otherwise true
    */
   bool maxWorkersCountReached() const;
@@ -44,6 +55,12 @@ class PacketsQueue {
    */
   void setMaxWorkersCount(size_t max_workers_count);
 
+  /**
+   * @note This method is thread-safe
+   * @return how many workers can process packets from this queue at the same time
+   */
+  size_t getMaxWorkersCount() const;
+
   /**
    * @brief Increment act_workers_count_ by 1
    */
@@ -72,17 +89,35 @@ class PacketsQueue {
    */
   size_t getActiveWorkersNum() const;
 
+  /**
+   * @note This method is thread-safe
+   * @return number of packets that were blocked during the last pop
+   */
+  size_t getBlockedPacketsCount() const;
+
+  /**
+   * @note This method is thread-safe
+   * @return number of votes dropped without processing as they were for already passed rounds
+   */
+  uint64_t getDroppedStalePacketsCount() const;
+
  private:
   std::list<std::pair<tarcap::TarcapVersion, PacketData>> packets_;
 
-  // How many workers can process packets from this queue at the same time
-  size_t kMaxWorkersCount_{0};
+  // How many workers can process packets from this queue at the same time, changed when workers are scaled
+  std::atomic<size_t> max_workers_count_{0};
 
   // How many workers are currently processing packets from this queue at the same time
   std::atomic<size_t> act_workers_count_{0};
 
   // How many packets are currently inside the queue
   std::atomic<size_t> act_packets_count_{0};
+
+  // How many packets were skipped as blocked during the last pop
+  std::atomic<size_t> blocked_packets_count_{0};
+
+  // How many votes were dropped as they were for already passed rounds
+  std::atomic<uint64_t> dropped_stale_packets_count_{0};
 };
 
 }  // namespace taraxa::network::threadpool
@@ -5,6 +5,7 @@
 #include <array>
 #include <utility>
 
+#include "common/lock_profiler.hpp"
 #include "logger/logger.hpp"
 #include "network/tarcap/tarcap_version.hpp"
 #include "network/threadpool/packets_blocking_mask.hpp"
@@ -55,9 +56,9 @@ class PriorityQueue {
    *
    * @param packet
    * @param queue_mutex_ must be locked if processing also blocking dependencies
-   * @param cond_var notify function is called if processing also blocking dependencies
+   * @return true if blocking dependencies were released and waiting workers should be notified, otherwise false
    */
-  void updateDependenciesFinish(const PacketData& packet, std::mutex& queue_mutex, std::condition_variable& cond_var);
+  bool updateDependenciesFinish(const PacketData& packet, util::ProfiledExclusiveMutex& queue_mutex);
 
   /**
    * @brief Returns specified priority queue actual size
@@ -67,6 +68,43 @@ class PriorityQueue {
    */
   size_t getPrirotityQueueSize(PacketData::PacketPriority priority) const;
 
+  /**
+   * @brief Returns number of packets in specified priority queue that were blocked during its last pop
+   *
+   * @param priority
+   * @return size_t
+   */
+  size_t getBlockedPacketsCount(PacketData::PacketPriority priority) const;
+
+  /**
+   * @brief Sets how many workers can process packets at the same time and splits them between priority queues
+   * @note queue mutex must be locked
+   *
+   * @param workers_count must be at least 3, so each priority queue has a reserved worker
+   */
+  void setMaxTotalWorkersCount(size_t workers_count);
+
+  /**
+   * @return how many workers can process packets from all the queues at the same time
+   */
+  size_t getMaxTotalWorkersCount() const;
+
+  /**
+   * @param priority
+   * @return how many workers can process packets from specified priority queue at the same time
+   */
+  size_t getMaxWorkersCount(PacketData::PacketPriority priority) const;
+
+  /**
+   * @return number of packets processed by threads borrowed from other priority queues
+   */
+  uint64_t getBorrowedThreadsCount() const;
+
+  /**
+   * @return number of votes dropped without processing as they were for already passed rounds
+   */
+  uint64_t getDroppedStalePacketsCount() const;
+
   /**
    * @param packet_type
    * @return true for non-blocking packet types, otherwise false
@@ -104,11 +142,17 @@ class PriorityQueue {
   // syncing packets must be processed synchronously one by one, etc...
   PacketsBlockingMask blocked_packets_mask_;
 
-  // How many workers can process packets from all the queues at the same time
-  const size_t MAX_TOTAL_WORKERS_COUNT;
+  // Provides current consensus round, so votes can be scheduled by it
+  std::shared_ptr<PbftManager> pbft_mgr_;
+
+  // How many workers can process packets from all the queues at the same time, changed when workers are scaled
+  std::atomic<size_t> max_total_workers_count_;
 
   // How many workers are currently processing packets from all the queues at the same time
   std::atomic<size_t> act_total_workers_count_;
+
+  // How many times thread was borrowed from other priority queues
+  std::atomic<uint64_t> borrowed_threads_count_{0};
 };
 
 }  // namespace taraxa::network::threadpool
@@ -1,13 +1,17 @@
 #pragma once
 
+#include <array>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
 #include <vector>
 
+#include "common/lock_profiler.hpp"
 #include "logger/logger.hpp"
 #include "network/tarcap/tarcap_version.hpp"
 #include "priority_queue.hpp"
+#include "workers_scaler.hpp"
 
 namespace taraxa::network::tarcap {
 class PacketsHandler;
@@ -17,6 +21,10 @@ namespace taraxa {
 class PbftManager;
 }
 
+namespace taraxa::metrics {
+class NetworkThreadpoolMetrics;
+}
+
 namespace taraxa::network::threadpool {
 
 /**
@@ -74,7 +82,77 @@ class PacketsThreadPool {
    */
   std::tuple<size_t, size_t, size_t> getQueueSize() const;
 
+  /**
+   * @brief Returns number of packets blocked by processing dependencies in all priority queues (thread-safe)
+   *
+   * @return std::tuple<size_t, size_t, size_t> - > std::tuple<HighPriorityQueue, MidPriorityQueue, LowPriorityQueue>
+   */
+  std::tuple<size_t, size_t, size_t> getBlockedPacketsCount() const;
+
+  /**
+   * @return number of packets processed by threads borrowed from other priority queues (thread-safe)
+   */
+  uint64_t getBorrowedThreadsCount() const;
+
+  /**
+   * @return number of votes dropped without processing as they were for already passed rounds (thread-safe)
+   */
+  uint64_t getDroppedStalePacketsCount() const;
+
+  /**
+   * @brief Enables adaptive number of active workers, must be called before startProcessing. Pool has to be created
+   *        with config.max_threads workers
+   *
+   * @param config
+   * @param initial_workers number of workers active until the first adjustment
+   */
+  void enableWorkersScaling(const PacketsProcessingScalingConfig& config, size_t initial_workers);
+
+  /**
+   * @brief Adjusts number of active workers by queue wait time measured since the previous call, no-op if scaling is
+   *        not enabled. Called periodically
+   */
+  void scaleWorkers();
+
+  /**
+   * @return moving average of the time packets waited in the queue before processing (thread-safe)
+   */
+  std::chrono::microseconds getAvgQueueWait() const;
+
+  /**
+   * @return number of workers that can process packets at the same time (thread-safe)
+   */
+  size_t getActiveWorkersCount() const;
+
+  /**
+   * @brief Changes number of active workers at runtime, it is not possible while workers scaling is enabled
+   *
+   * @param workers at least 3 and at most the number of workers the pool was created with
+   * @return false if workers are scaled automatically or the number is out of range
+   */
+  bool setActiveWorkersCount(size_t workers);
+
+  /**
+   * @brief Returns max number of workers per priority queue (thread-safe)
+   *
+   * @return std::tuple<size_t, size_t, size_t> - > std::tuple<HighPriorityQueue, MidPriorityQueue, LowPriorityQueue>
+   */
+  std::tuple<size_t, size_t, size_t> getWorkersLimits() const;
+
+  /**
+   * @brief Sets metrics that packets queue and processing times are observed into, must be called before
+   *        startProcessing
+   *
+   * @param metrics
+   */
+  void setMetrics(std::shared_ptr<metrics::NetworkThreadpoolMetrics> metrics);
+
  private:
+  /**
+   * @brief Sets number of workers allowed to process packets and wakes up the ones that were waiting for it
+   */
+  void applyActiveWorkersCount(size_t workers);
+
   // Declare logger instances
   LOG_OBJECTS_DEFINE
 
@@ -93,12 +171,35 @@ class PacketsThreadPool {
   // Queue of unprocessed packets
   PriorityQueue queue_;
 
-  // Queue mutex
-  std::mutex queue_mutex_;
+  // Queue mutex - guards queue_ and is used only by workers
+  util::ProfiledExclusiveMutex queue_mutex_{"packets_queue"};
+
+  // Newly pushed packets are staged here, so producers never wait for workers that scan queue_ under queue_mutex_.
+  // Workers move staged packets into queue_ in batches
+  std::vector<std::pair<tarcap::TarcapVersion, PacketData>> incoming_packets_;
+  std::array<std::atomic<size_t>, PacketData::PacketPriority::Count> incoming_packets_count_{};
 
-  // Queue condition variable
+  // Incremented on every push and every release of blocking dependencies, so a worker that found nothing to process
+  // can't miss a wake up that happened before it started waiting
+  uint64_t wake_up_seq_{0};
+
+  // Guards packets_count_, incoming_packets_ and wake_up_seq_
+  std::mutex incoming_mutex_;
+
+  // Workers waiting for new packets or released dependencies, used with incoming_mutex_
   std::condition_variable cond_var_;
 
+  std::shared_ptr<metrics::NetworkThreadpoolMetrics> metrics_;
+
+  // Decides number of active workers, nullptr if their number is fixed. Used only by scaleWorkers caller
+  std::unique_ptr<WorkersScaler> workers_scaler_;
+
+  // Sum of queue wait times and number of packets taken for processing since the last workers scaling
+  std::atomic<uint64_t> queue_wait_us_sum_{0};
+  std::atomic<uint64_t> queue_wait_count_{0};
+  // Exponential moving average of queue wait times, concurrent updates may be lost
+  std::atomic<uint64_t> avg_queue_wait_us_{0};
+
   // Vector of worker threads - should be initialized as the last member
   std::vector<std::thread> workers_;
 };
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <optional>
+
+#include "config/network.hpp"
+
+namespace taraxa::network::threadpool {
+
+/**
+ * @brief Decides how many packets processing workers should be active based on the average time packets waited in
+ *        the queue and cpu idle time
+ *
+ * Workers are added quickly while packets wait too long and cpu has idle time left, they are removed one by one
+ * while the queue is served without waiting.
+ */
+class WorkersScaler {
+ public:
+  // Workers are not added if cpu idle time is below this fraction, they would only compete for the cpu
+  static constexpr double kMinCpuIdleToGrow = 0.1;
+
+  struct Sample {
+    std::chrono::microseconds avg_queue_wait{0};
+    size_t queued_packets = 0;
+    // Fraction of cpu time that was idle, nullopt if it could not be measured
+    std::optional<double> cpu_idle;
+  };
+
+  WorkersScaler(const PacketsProcessingScalingConfig& config, size_t initial_workers);
+
+  /**
+   * @param sample measured since the previous adjustment
+   * @return number of workers that should be active
+   */
+  size_t adjust(const Sample& sample);
+
+  size_t workers() const { return workers_; }
+
+  /**
+   * @return fraction of cpu time that was idle since the previous call, nullopt on the first call or if /proc/stat
+   *         can't be read
+   */
+  std::optional<double> measureCpuIdle();
+
+ private:
+  const PacketsProcessingScalingConfig kConfig;
+  size_t workers_;
+
+  // Total and idle cpu time from the previous measurement in clock ticks
+  std::optional<std::array<uint64_t, 2>> prev_cpu_times_;
+};
+
+}  // namespace taraxa::network::threadpool
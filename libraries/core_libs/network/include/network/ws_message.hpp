@@ -0,0 +1,33 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+namespace taraxa::net {
+
+/**
+ * @brief Outbound websocket message
+ *
+ * Message is written as prefix + body + suffix. Body can be shared by many messages, so subscription notifications
+ * serialize their payload once and every session adds only its own envelope around it. Binary messages carry RLP
+ * encoded subscription notifications.
+ */
+struct WsMessage {
+  WsMessage() = default;
+  // Implicit on purpose, plain request responses are queued as they are
+  WsMessage(std::string&& message) : body(std::make_shared<const std::string>(std::move(message))) {}
+  WsMessage(std::string&& prefix, std::shared_ptr<const std::string> body, std::string&& suffix, int subscription_id)
+      : prefix(std::move(prefix)), body(std::move(body)), suffix(std::move(suffix)), subscription_id(subscription_id) {}
+
+  size_t size() const { return prefix.size() + (body ? body->size() : 0) + suffix.size(); }
+
+  std::string prefix;
+  std::shared_ptr<const std::string> body;
+  std::string suffix;
+  // Id of the subscription which produced the message, 0 for request responses
+  int subscription_id = 0;
+  // Sent as binary frame instead of text frame
+  bool binary = false;
+};
+
+}  // namespace taraxa::net
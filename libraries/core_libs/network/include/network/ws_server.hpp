@@ -1,5 +1,7 @@
 #pragma once
 
+#include <boost/asio/steady_timer.hpp>
+#include <mutex>
 #include <vector>
 
 #include "dag/dag_block.hpp"
@@ -14,7 +16,8 @@ namespace taraxa::net {
 class WsServer : public std::enable_shared_from_this<WsServer>, public jsonrpc::AbstractServerConnector {
  public:
   WsServer(boost::asio::io_context& ioc, tcp::endpoint endpoint, addr_t node_addr,
-           std::shared_ptr<metrics::JsonRpcMetrics> metrics);
+           std::shared_ptr<metrics::JsonRpcMetrics> metrics, WsWriteQueueConfig write_queue_config = {},
+           WsCompressionConfig compression_config = {}, WsTransactionsBatchConfig transactions_batch_config = {});
   virtual ~WsServer();
 
   WsServer(const WsServer&) = delete;
@@ -31,8 +34,12 @@ class WsServer : public std::enable_shared_from_this<WsServer>, public jsonrpc::
   void newDagBlockFinalized(const blk_hash_t& blk, uint64_t period);
   void newPbftBlockExecuted(const PbftBlock& blk, const std::vector<blk_hash_t>& finalized_dag_blk_hashes);
   void newPendingTransaction(const trx_hash_t& trx_hash);
-  void newPillarBlockData(const pillar_chain::PillarBlockData& pillar_block_data);
+  void newPillarBlockData(const std::shared_ptr<const pillar_chain::SerializedPillarBlockData>& data);
   uint32_t numberOfSessions();
+  // Number of messages waiting in write queues of all sessions
+  uint64_t queuedMessages() const { return queued_messages_; }
+  // Number of messages dropped or sessions disconnected due to full write queue
+  uint64_t droppedMessages() const { return dropped_messages_; }
 
   virtual std::shared_ptr<WsSession> createSession(tcp::socket&& socket) = 0;
 
@@ -42,15 +49,30 @@ class WsServer : public std::enable_shared_from_this<WsServer>, public jsonrpc::
  private:
   void do_accept();
   void on_accept(beast::error_code ec, tcp::socket socket);
+  void queuedMessagesChanged(int64_t diff);
+  void messageDropped();
+  // Adds hash to the batch of pending transactions, batch is sent once it is full or interval elapsed
+  void batchPendingTransaction(const trx_hash_t& trx_hash);
+  void flushTransactionsBatch();
+  void sendTransactionsBatch(const TransactionHashes& batch);
   LOG_OBJECTS_DEFINE
   boost::asio::io_context& ioc_;
   tcp::acceptor acceptor_;
   std::list<std::shared_ptr<WsSession>> sessions_;
   std::atomic<bool> stopped_ = false;
   boost::shared_mutex sessions_mtx_;
+  std::atomic<uint64_t> queued_messages_ = 0;
+  std::atomic<uint64_t> dropped_messages_ = 0;
+  std::mutex transactions_batch_mtx_;
+  TransactionHashes transactions_batch_;
+  boost::asio::steady_timer transactions_batch_timer_;
+  bool transactions_batch_timer_armed_ = false;
 
  protected:
   const addr_t node_addr_;
+  const WsWriteQueueConfig kWriteQueueConfig;
+  const WsCompressionConfig kCompressionConfig;
+  const WsTransactionsBatchConfig kTransactionsBatchConfig;
   std::shared_ptr<metrics::JsonRpcMetrics> metrics_;
   friend WsSession;
 };
@@ -8,10 +8,12 @@
 #include <boost/beast/core.hpp>
 #include <boost/beast/websocket.hpp>
 #include <cstdlib>
+#include <deque>
 #include <memory>
 #include <string>
 
 #include "common/types.hpp"
+#include "config/network.hpp"
 #include "final_chain/data.hpp"
 #include "logger/logger.hpp"
 #include "network/subscriptions.hpp"
@@ -26,13 +28,17 @@ class WsServer;
 class WsSession : public std::enable_shared_from_this<WsSession> {
  public:
   // Take ownership of the socket
-  explicit WsSession(tcp::socket&& socket, addr_t node_addr, std::shared_ptr<WsServer> ws_server)
+  explicit WsSession(tcp::socket&& socket, addr_t node_addr, std::shared_ptr<WsServer> ws_server,
+                     WsWriteQueueConfig write_queue_config = {}, WsCompressionConfig compression_config = {})
       : ws_(std::move(socket)),
         ws_server_(ws_server),
         subscriptions_(std::bind(&WsSession::do_write, this, std::placeholders::_1)),
+        kWriteQueueConfig(write_queue_config),
+        kCompressionConfig(compression_config),
         write_strand_(boost::asio::make_strand(ws_.get_executor())) {
     LOG_OBJECTS_CREATE("WS_SESSION");
   }
+  virtual ~WsSession();
 
   // Start the asynchronous operation
   void run();
@@ -41,14 +47,20 @@ class WsSession : public std::enable_shared_from_this<WsSession> {
 
   virtual std::string processRequest(const std::string_view& request) = 0;
 
-  void newEthBlock(const Json::Value& payload);
-  void newDagBlock(const Json::Value& blk);
-  void newDagBlockFinalized(const Json::Value& payload);
-  void newPbftBlockExecuted(const Json::Value& payload);
-  void newPendingTransaction(const Json::Value& payload);
-  void newPillarBlockData(const Json::Value& payload);
-  void newLogs(const final_chain::BlockHeader& header, TransactionHashes trx_hashes,
-               const TransactionReceipts& receipts);
+  /**
+   * @brief Lets session take over processing of request on another thread
+   * @return false if request must be processed on the session executor
+   */
+  virtual bool dispatchRequest(const std::string& /*request*/) { return false; }
+
+  void newEthBlock(const SubscriptionPayload& payload);
+  void newDagBlock(const SubscriptionPayload& blk);
+  void newDagBlockFinalized(const SubscriptionPayload& payload);
+  void newPbftBlockExecuted(const SubscriptionPayload& payload);
+  void newPendingTransaction(const SubscriptionPayload& payload);
+  void newPendingTransactionsBatch(const SubscriptionPayload& payload);
+  void newPillarBlockData(const SubscriptionPayload& payload);
+  void collectLogsSubscriptions(LogsSubscriptionsIndex& index);
 
   LOG_OBJECTS_DEFINE
  private:
@@ -57,11 +69,17 @@ class WsSession : public std::enable_shared_from_this<WsSession> {
   void on_accept(beast::error_code ec);
   void do_read();
   void on_read(beast::error_code ec, std::size_t bytes_transferred);
-  void write(std::string&& message);
+
+  // Write queue is accessed only from write_strand_
+  void enqueue(WsMessage&& message);
+  void write_front();
+  void on_write(beast::error_code ec, std::size_t bytes_transferred);
 
  protected:
   void handleRequest();
-  void do_write(std::string&& message);
+  // Processes request and writes its response, reports processing time to metrics
+  void processAndWrite(const std::string& request);
+  void do_write(WsMessage&& message);
 
   websocket::stream<beast::tcp_stream> ws_;
   std::atomic<int> subscription_id_ = 0;
@@ -69,7 +87,13 @@ class WsSession : public std::enable_shared_from_this<WsSession> {
   Subscriptions subscriptions_;
 
  private:
+  const WsWriteQueueConfig kWriteQueueConfig;
+  const WsCompressionConfig kCompressionConfig;
   boost::asio::strand<boost::asio::any_io_executor> write_strand_;
+  std::deque<WsMessage> write_queue_;
+  // Message being written by async_write, it is kept outside of write_queue_ so it is never dropped or coalesced
+  WsMessage writing_message_;
+  bool writing_ = false;
   beast::flat_buffer read_buffer_;
   std::atomic<bool> closed_ = false;
   std::string ip_;
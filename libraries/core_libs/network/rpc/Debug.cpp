@@ -3,8 +3,12 @@
 #include <libdevcore/CommonData.h>
 #include <libdevcore/CommonJS.h>
 
+#include "common/allocator.hpp"
+#include "common/config_exception.hpp"
 #include "common/jsoncpp.hpp"
+#include "common/lock_profiler.hpp"
 #include "common/rpc_utils.hpp"
+#include "common/tracing.hpp"
 #include "final_chain/state_api_data.hpp"
 #include "network/rpc/eth/data.hpp"
 #include "transaction/transaction.hpp"
@@ -17,26 +21,145 @@ using namespace taraxa;
 
 namespace taraxa::net {
 
+// Maximal number of traces waiting in the queue per trace thread, further requests are rejected
+constexpr uint64_t kTraceMaxPendingPerThread = 4;
+
+Debug::Debug(std::shared_ptr<taraxa::AppBase> app, uint64_t gas_limit, TraceExecutorConfig trace_config)
+    : app_(app), kGasLimit(gas_limit), kTraceConfig(trace_config) {
+  if (kTraceConfig.threads) {
+    trace_thread_pool_ = std::make_unique<util::ThreadPool>(kTraceConfig.threads);
+  }
+}
+
+void Debug::run_trace(std::vector<state_api::EVMTransaction> state_trxs, std::vector<state_api::EVMTransaction> trxs,
+                      EthBlockNumber blk_num, std::optional<state_api::Tracing> params,
+                      const std::function<void(std::string_view)>& sink) {
+  auto node = app_.lock();
+  if (!node) {
+    BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR));
+  }
+
+  if (kTraceConfig.gas_budget) {
+    uint64_t gas = 0;
+    for (const auto& trx : state_trxs) gas += trx.gas;
+    for (const auto& trx : trxs) gas += trx.gas;
+    if (gas > kTraceConfig.gas_budget) {
+      throw std::runtime_error("Trace exceeds gas budget");
+    }
+  }
+
+  auto final_chain = node->getFinalChain();
+  if (!trace_thread_pool_) {
+    final_chain->trace(std::move(state_trxs), std::move(trxs), blk_num, std::move(params), sink);
+    return;
+  }
+
+  if (trace_thread_pool_->num_pending_tasks() >= trace_thread_pool_->capacity() * kTraceMaxPendingPerThread) {
+    throw std::runtime_error("Too many pending traces");
+  }
+  if (!kTraceConfig.timeout_ms) {
+    // Waiting can't time out, so the task is done before sink goes out of scope
+    trace_thread_pool_->post([&] { final_chain->trace(std::move(state_trxs), std::move(trxs), blk_num, params, sink); })
+        .get();
+    return;
+  }
+  // Result is shared with the task, as it may outlive this call when waiting times out
+  auto result = std::make_shared<std::string>();
+  auto done = trace_thread_pool_->post([result, final_chain, state_trxs = std::move(state_trxs),
+                                        trxs = std::move(trxs), blk_num, params = std::move(params)]() mutable {
+    final_chain->trace(std::move(state_trxs), std::move(trxs), blk_num, std::move(params),
+                       [&result](std::string_view chunk) { result->append(chunk); });
+  });
+  if (done.wait_for(std::chrono::milliseconds(kTraceConfig.timeout_ms)) == std::future_status::timeout) {
+    throw std::runtime_error("Trace timed out");
+  }
+  done.get();
+  sink(*result);
+}
+
+Json::Value Debug::run_trace(std::vector<state_api::EVMTransaction> state_trxs,
+                             std::vector<state_api::EVMTransaction> trxs, EthBlockNumber blk_num,
+                             std::optional<state_api::Tracing> params) {
+  std::string trace;
+  run_trace(std::move(state_trxs), std::move(trxs), blk_num, std::move(params),
+            [&trace](std::string_view chunk) { trace.append(chunk); });
+  return util::readJsonFromString(trace);
+}
+
+void Debug::registerSerializedMethods(JsonRpcSerializedMethods& methods) {
+  using Result = JsonRpcSerializedMethods::Result;
+  // Trace json produced by taraxa-evm is forwarded into the response chunk by chunk
+  const auto write_trace = [this](JsonWriter& w, std::vector<state_api::EVMTransaction> state_trxs,
+                                  std::vector<state_api::EVMTransaction> trxs, EthBlockNumber blk_num,
+                                  std::optional<state_api::Tracing> params) {
+    bool empty = true;
+    w.raw({});
+    run_trace(std::move(state_trxs), std::move(trxs), blk_num, std::move(params), [&](std::string_view chunk) {
+      empty &= chunk.empty();
+      w.rawChunk(chunk);
+    });
+    if (empty) {
+      throw std::runtime_error("Empty trace");
+    }
+    return Result::Done;
+  };
+
+  methods.registerMethod("debug_traceTransaction", [this, write_trace](const Json::Value& params, JsonWriter& w) {
+    if (params.size() != 1 || !params[0].isString()) {
+      return Result::Fallback;
+    }
+    auto [state_trxs, trx, period] = get_transaction_with_state(params[0].asString());
+    return write_trace(w, {}, {std::move(trx)}, period, {});
+  });
+  methods.registerMethod("debug_traceCall", [this, write_trace](const Json::Value& params, JsonWriter& w) {
+    if (params.size() != 2 || !params[0].isObject() || !params[1].isString()) {
+      return Result::Fallback;
+    }
+    const auto block = parse_blk_num(params[1].asString());
+    return write_trace(w, {}, {to_eth_trx(params[0], block)}, block, {});
+  });
+  methods.registerMethod("trace_call", [this, write_trace](const Json::Value& params, JsonWriter& w) {
+    if (params.size() != 3 || !params[0].isObject() || !params[1].isArray() || !params[2].isString()) {
+      return Result::Fallback;
+    }
+    const auto block = parse_blk_num(params[2].asString());
+    return write_trace(w, {}, {to_eth_trx(params[0], block)}, block, parse_tracking_parms(params[1]));
+  });
+  methods.registerMethod("trace_replayTransaction", [this, write_trace](const Json::Value& params, JsonWriter& w) {
+    if (params.size() != 2 || !params[0].isString() || !params[1].isArray()) {
+      return Result::Fallback;
+    }
+    auto tracing = parse_tracking_parms(params[1]);
+    auto [state_trxs, trx, period] = get_transaction_with_state(params[0].asString());
+    return write_trace(w, std::move(state_trxs), {std::move(trx)}, period, std::move(tracing));
+  });
+  methods.registerMethod("trace_replayBlockTransactions", [this, write_trace](const Json::Value& params,
+                                                                              JsonWriter& w) {
+    if (params.size() != 2 || !params[0].isString() || !params[1].isArray()) {
+      return Result::Fallback;
+    }
+    const auto block = parse_blk_num(params[0].asString());
+    auto tracing = parse_tracking_parms(params[1]);
+    auto trxs = get_block_transactions(block);
+    if (!trxs) {
+      w.beginArray().endArray();
+      return Result::Done;
+    }
+    return write_trace(w, {}, std::move(*trxs), block, std::move(tracing));
+  });
+}
+
 Json::Value Debug::debug_traceCall(const Json::Value& call_params, const std::string& blk_num) {
-  Json::Value res;
   const auto block = parse_blk_num(blk_num);
   auto trx = to_eth_trx(call_params, block);
-  if (auto node = app_.lock()) {
-    return util::readJsonFromString(node->getFinalChain()->trace({}, {std::move(trx)}, block));
-  }
-  return res;
+  return run_trace({}, {std::move(trx)}, block, {});
 }
 
 Json::Value Debug::trace_call(const Json::Value& call_params, const Json::Value& trace_params,
                               const std::string& blk_num) {
-  Json::Value res;
   const auto block = parse_blk_num(blk_num);
   auto params = parse_tracking_parms(trace_params);
-  if (auto node = app_.lock()) {
-    return util::readJsonFromString(
-        node->getFinalChain()->trace({}, {to_eth_trx(call_params, block)}, block, std::move(params)));
-  }
-  return res;
+  return run_trace({}, {to_eth_trx(call_params, block)}, block, std::move(params));
 }
 
 std::tuple<std::vector<state_api::EVMTransaction>, state_api::EVMTransaction, uint64_t>
@@ -58,22 +181,14 @@ Debug::get_transaction_with_state(const std::string& transaction_hash) {
   return {to_eth_trxs(state_trxs), to_eth_trx(block_transactions[loc->position]), loc->period};
 }
 Json::Value Debug::debug_traceTransaction(const std::string& transaction_hash) {
-  Json::Value res;
   auto [state_trxs, trx, period] = get_transaction_with_state(transaction_hash);
-  if (auto node = app_.lock()) {
-    return util::readJsonFromString(node->getFinalChain()->trace({}, {trx}, period));
-  }
-  return res;
+  return run_trace({}, {trx}, period, {});
 }
 
 Json::Value Debug::trace_replayTransaction(const std::string& transaction_hash, const Json::Value& trace_params) {
-  Json::Value res;
   auto params = parse_tracking_parms(trace_params);
   auto [state_trxs, trx, period] = get_transaction_with_state(transaction_hash);
-  if (auto node = app_.lock()) {
-    return util::readJsonFromString(node->getFinalChain()->trace(state_trxs, {trx}, period, params));
-  }
-  return res;
+  return run_trace(std::move(state_trxs), {trx}, period, std::move(params));
 }
 
 bool only_transfers(const SharedTransactions& trxs) {
@@ -82,22 +197,27 @@ bool only_transfers(const SharedTransactions& trxs) {
   });
 }
 
+std::optional<std::vector<state_api::EVMTransaction>> Debug::get_block_transactions(EthBlockNumber blk_num) {
+  auto node = app_.lock();
+  if (!node) {
+    return {};
+  }
+  auto transactions = node->getDB()->getPeriodTransactions(blk_num);
+  if (!transactions.has_value() || transactions->empty() || only_transfers(*transactions)) {
+    return {};
+  }
+  return to_eth_trxs(*transactions);
+}
+
 Json::Value Debug::trace_replayBlockTransactions(const std::string& block_num, const Json::Value& trace_params) {
-  Json::Value res;
   const auto block = parse_blk_num(block_num);
   auto params = parse_tracking_parms(trace_params);
-  if (auto node = app_.lock()) {
-    auto transactions = node->getDB()->getPeriodTransactions(block);
-    if (!transactions.has_value() || transactions->empty()) {
-      return Json::Value(Json::arrayValue);
-    }
-    if (only_transfers(*transactions)) {
-      return Json::Value(Json::arrayValue);
-    }
-    std::vector<state_api::EVMTransaction> trxs = to_eth_trxs(*transactions);
-    return util::readJsonFromString(node->getFinalChain()->trace({}, std::move(trxs), block, std::move(params)));
+  auto trxs = get_block_transactions(block);
+  if (!trxs) {
+    return Json::Value(Json::arrayValue);
   }
-  return res;
+  // Whole block is traced in a single call, so its state is reconstructed once for all transactions
+  return run_trace({}, std::move(*trxs), block, std::move(params));
 }
 
 Json::Value Debug::debug_getPeriodTransactionsWithReceipts(const std::string& _period) {
@@ -240,6 +360,111 @@ Json::Value Debug::debug_dposTotalAmountDelegated(const std::string& _period) {
   }
 }
 
+bool Debug::debug_startTracing() {
+  util::Tracer::start();
+  return true;
+}
+
+Json::Value Debug::debug_stopTracing() {
+  util::Tracer::stop();
+  return util::Tracer::exportChromeTrace();
+}
+
+Json::Value Debug::debug_memoryStats() {
+  auto node = app_.lock();
+  if (!node) {
+    BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR));
+  }
+
+  Json::Value res(Json::objectValue);
+  for (const auto& [structure, bytes] : node->getMemoryStats()) {
+    res[structure] = Json::UInt64(bytes);
+  }
+  return res;
+}
+
+Json::Value Debug::debug_purgeAllocator() {
+  Json::Value res(Json::objectValue);
+  res["allocator"] = util::allocator::name();
+  res["purged"] = util::allocator::purge();
+  if (const auto stats = util::allocator::stats()) {
+    res["allocated"] = Json::UInt64(stats->allocated);
+    res["active"] = Json::UInt64(stats->active);
+    res["resident"] = Json::UInt64(stats->resident);
+    res["fragmentation"] = stats->fragmentation;
+  }
+  return res;
+}
+
+Json::Value Debug::debug_lockStats() {
+  const auto histogram_json = [](const util::LockProfiler::HistogramStats& histogram) {
+    Json::Value res(Json::objectValue);
+    res["count"] = Json::UInt64(histogram.count);
+    res["total_ms"] = std::chrono::duration<double, std::milli>(histogram.total).count();
+    res["p50_us"] = histogram.percentileUs(0.5);
+    res["p99_us"] = histogram.percentileUs(0.99);
+    // Bucket i counts times below 2^i us, the last one also everything above
+    res["buckets"] = Json::Value(Json::arrayValue);
+    for (const auto count : histogram.buckets) {
+      res["buckets"].append(Json::UInt64(count));
+    }
+    return res;
+  };
+
+  Json::Value res(Json::objectValue);
+  res["enabled"] = util::LockProfiler::enabled();
+  res["locks"] = Json::Value(Json::objectValue);
+  for (const auto& stats : util::LockProfiler::stats()) {
+    auto& lock = res["locks"][stats.name];
+    lock["contended"] = Json::UInt64(stats.contended);
+    lock["wait"] = histogram_json(stats.wait);
+    lock["hold"] = histogram_json(stats.hold);
+    lock["call_sites"] = Json::Value(Json::arrayValue);
+    for (const auto& site : stats.call_sites) {
+      Json::Value site_json(Json::objectValue);
+      site_json["location"] = site.location;
+      site_json["count"] = Json::UInt64(site.count);
+      site_json["wait_ms"] = std::chrono::duration<double, std::milli>(site.wait).count();
+      lock["call_sites"].append(std::move(site_json));
+    }
+  }
+  return res;
+}
+
+Json::Value Debug::debug_getRuntimeConfig() {
+  auto node = app_.lock();
+  if (!node) {
+    BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR));
+  }
+
+  Json::Value res(Json::objectValue);
+  for (const auto& [name, value] : node->getRuntimeConfig()) {
+    res[name] = Json::UInt64(value);
+  }
+  return res;
+}
+
+Json::Value Debug::debug_setRuntimeConfig(const Json::Value& param1) {
+  auto node = app_.lock();
+  if (!node) {
+    BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR));
+  }
+
+  std::map<std::string, uint64_t> values;
+  for (const auto& name : param1.getMemberNames()) {
+    if (!param1[name].isUInt64()) {
+      BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INVALID_PARAMS, name + " must be an unsigned integer"));
+    }
+    values[name] = param1[name].asUInt64();
+  }
+  try {
+    node->updateRuntimeConfig(values);
+  } catch (const ConfigException& e) {
+    BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INVALID_PARAMS, e.what()));
+  }
+  return debug_getRuntimeConfig();
+}
+
 state_api::Tracing Debug::parse_tracking_parms(const Json::Value& json) const {
   state_api::Tracing ret;
   if (!json.isArray() || json.empty()) {
@@ -292,6 +517,9 @@ state_api::EVMTransaction Debug::to_eth_trx(const Json::Value& json, EthBlockNum
   } else {
     trx.gas = kGasLimit;
   }
+  if (kTraceConfig.gas_budget) {
+    trx.gas = std::min(trx.gas, kTraceConfig.gas_budget);
+  }
 
   if (!json["gasPrice"].empty()) {
     trx.gas_price = jsToU256(json["gasPrice"].asString());
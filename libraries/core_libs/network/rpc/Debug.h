@@ -3,10 +3,15 @@
 
 #include <json/value.h>
 
+#include <functional>
 #include <memory>
+#include <optional>
+#include <string_view>
 
 #include "DebugFace.h"
 #include "common/app_base.hpp"
+#include "common/thread_pool.hpp"
+#include "network/rpc/jsonrpc_serialized_methods.hpp"
 
 namespace taraxa {
 struct Transaction;
@@ -34,9 +39,21 @@ class InvalidTracingParams : public std::exception {
   virtual const char* what() const noexcept { return "Invalid tracing params"; }
 };
 
+/**
+ * @brief Limits of the executor running debug_trace* and trace_* replays
+ */
+struct TraceExecutorConfig {
+  // Number of threads running traces, 0 = traces are processed on the rpc thread
+  uint32_t threads = 0;
+  // Maximal time rpc thread waits for the trace result in ms, 0 = unlimited
+  uint64_t timeout_ms = 0;
+  // Maximal sum of gas of the traced transactions, 0 = unlimited
+  uint64_t gas_budget = 0;
+};
+
 class Debug : public DebugFace {
  public:
-  explicit Debug(std::shared_ptr<taraxa::AppBase> app, uint64_t gas_limit) : app_(app), kGasLimit(gas_limit) {}
+  explicit Debug(std::shared_ptr<taraxa::AppBase> app, uint64_t gas_limit, TraceExecutorConfig trace_config = {});
   virtual RPCModules implementedModules() const override { return RPCModules{RPCModule{"debug", "1.0"}}; }
 
   virtual Json::Value debug_traceTransaction(const std::string& param1) override;
@@ -50,6 +67,16 @@ class Debug : public DebugFace {
   virtual Json::Value trace_replayBlockTransactions(const std::string& param1, const Json::Value& param2) override;
   virtual Json::Value debug_dposValidatorTotalStakes(const std::string& param1) override;
   virtual Json::Value debug_dposTotalAmountDelegated(const std::string& param1) override;
+  virtual bool debug_startTracing() override;
+  virtual Json::Value debug_stopTracing() override;
+  virtual Json::Value debug_memoryStats() override;
+  virtual Json::Value debug_purgeAllocator() override;
+  virtual Json::Value debug_lockStats() override;
+  virtual Json::Value debug_getRuntimeConfig() override;
+  virtual Json::Value debug_setRuntimeConfig(const Json::Value& param1) override;
+
+  // Registers fast path of traces, which forwards trace json into response without parsing it
+  void registerSerializedMethods(JsonRpcSerializedMethods& methods);
 
  private:
   state_api::EVMTransaction to_eth_trx(std::shared_ptr<Transaction> t) const;
@@ -60,9 +87,18 @@ class Debug : public DebugFace {
   Address to_address(const std::string& s) const;
   std::tuple<std::vector<state_api::EVMTransaction>, state_api::EVMTransaction, uint64_t> get_transaction_with_state(
       const std::string& transaction_hash);
+  void run_trace(std::vector<state_api::EVMTransaction> state_trxs, std::vector<state_api::EVMTransaction> trxs,
+                 EthBlockNumber blk_num, std::optional<state_api::Tracing> params,
+                 const std::function<void(std::string_view)>& sink);
+  Json::Value run_trace(std::vector<state_api::EVMTransaction> state_trxs, std::vector<state_api::EVMTransaction> trxs,
+                        EthBlockNumber blk_num, std::optional<state_api::Tracing> params);
+  std::optional<std::vector<state_api::EVMTransaction>> get_block_transactions(EthBlockNumber blk_num);
 
   std::weak_ptr<taraxa::AppBase> app_;
   const uint64_t kGasLimit = ((uint64_t)1 << 53) - 1;
+  const TraceExecutorConfig kTraceConfig;
+  // Traces are heavy and run isolated from the rpc threads, so they can't stall other calls
+  std::unique_ptr<util::ThreadPool> trace_thread_pool_;
 };
 
 }  // namespace taraxa::net
\ No newline at end of file
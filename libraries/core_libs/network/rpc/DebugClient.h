@@ -112,6 +112,69 @@ class DebugClient : public jsonrpc::Client {
     else
       throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
   }
+  bool debug_startTracing() throw(jsonrpc::JsonRpcException) {
+    Json::Value p;
+    p = Json::nullValue;
+    Json::Value result = this->CallMethod("debug_startTracing", p);
+    if (result.isBool())
+      return result.asBool();
+    else
+      throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+  }
+  Json::Value debug_stopTracing() throw(jsonrpc::JsonRpcException) {
+    Json::Value p;
+    p = Json::nullValue;
+    Json::Value result = this->CallMethod("debug_stopTracing", p);
+    if (result.isObject())
+      return result;
+    else
+      throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+  }
+  Json::Value debug_memoryStats() throw(jsonrpc::JsonRpcException) {
+    Json::Value p;
+    p = Json::nullValue;
+    Json::Value result = this->CallMethod("debug_memoryStats", p);
+    if (result.isObject())
+      return result;
+    else
+      throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+  }
+  Json::Value debug_purgeAllocator() throw(jsonrpc::JsonRpcException) {
+    Json::Value p;
+    p = Json::nullValue;
+    Json::Value result = this->CallMethod("debug_purgeAllocator", p);
+    if (result.isObject())
+      return result;
+    else
+      throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+  }
+  Json::Value debug_lockStats() throw(jsonrpc::JsonRpcException) {
+    Json::Value p;
+    p = Json::nullValue;
+    Json::Value result = this->CallMethod("debug_lockStats", p);
+    if (result.isObject())
+      return result;
+    else
+      throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+  }
+  Json::Value debug_getRuntimeConfig() throw(jsonrpc::JsonRpcException) {
+    Json::Value p;
+    p = Json::nullValue;
+    Json::Value result = this->CallMethod("debug_getRuntimeConfig", p);
+    if (result.isObject())
+      return result;
+    else
+      throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+  }
+  Json::Value debug_setRuntimeConfig(const Json::Value& param1) throw(jsonrpc::JsonRpcException) {
+    Json::Value p;
+    p.append(param1);
+    Json::Value result = this->CallMethod("debug_setRuntimeConfig", p);
+    if (result.isObject())
+      return result;
+    else
+      throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+  }
 };
 
 }  // namespace net
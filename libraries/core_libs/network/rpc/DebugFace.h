@@ -46,6 +46,27 @@ class DebugFace : public ServerInterface<DebugFace> {
     this->bindAndAddMethod(jsonrpc::Procedure("debug_dposTotalAmountDelegated", jsonrpc::PARAMS_BY_POSITION,
                                               jsonrpc::JSON_ARRAY, "param1", jsonrpc::JSON_STRING, NULL),
                            &taraxa::net::DebugFace::debug_dposTotalAmountDelegatedI);
+    this->bindAndAddMethod(
+        jsonrpc::Procedure("debug_startTracing", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_BOOLEAN, NULL),
+        &taraxa::net::DebugFace::debug_startTracingI);
+    this->bindAndAddMethod(
+        jsonrpc::Procedure("debug_stopTracing", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, NULL),
+        &taraxa::net::DebugFace::debug_stopTracingI);
+    this->bindAndAddMethod(
+        jsonrpc::Procedure("debug_memoryStats", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, NULL),
+        &taraxa::net::DebugFace::debug_memoryStatsI);
+    this->bindAndAddMethod(
+        jsonrpc::Procedure("debug_purgeAllocator", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, NULL),
+        &taraxa::net::DebugFace::debug_purgeAllocatorI);
+    this->bindAndAddMethod(
+        jsonrpc::Procedure("debug_lockStats", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, NULL),
+        &taraxa::net::DebugFace::debug_lockStatsI);
+    this->bindAndAddMethod(
+        jsonrpc::Procedure("debug_getRuntimeConfig", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, NULL),
+        &taraxa::net::DebugFace::debug_getRuntimeConfigI);
+    this->bindAndAddMethod(jsonrpc::Procedure("debug_setRuntimeConfig", jsonrpc::PARAMS_BY_POSITION,
+                                              jsonrpc::JSON_OBJECT, "param1", jsonrpc::JSON_OBJECT, NULL),
+                           &taraxa::net::DebugFace::debug_setRuntimeConfigI);
   }
 
   inline virtual void debug_traceTransactionI(const Json::Value& request, Json::Value& response) {
@@ -78,6 +99,33 @@ class DebugFace : public ServerInterface<DebugFace> {
   inline virtual void debug_dposTotalAmountDelegatedI(const Json::Value& request, Json::Value& response) {
     response = this->debug_dposTotalAmountDelegated(request[0u].asString());
   }
+  inline virtual void debug_startTracingI(const Json::Value& request, Json::Value& response) {
+    (void)request;
+    response = this->debug_startTracing();
+  }
+  inline virtual void debug_stopTracingI(const Json::Value& request, Json::Value& response) {
+    (void)request;
+    response = this->debug_stopTracing();
+  }
+  inline virtual void debug_memoryStatsI(const Json::Value& request, Json::Value& response) {
+    (void)request;
+    response = this->debug_memoryStats();
+  }
+  inline virtual void debug_purgeAllocatorI(const Json::Value& request, Json::Value& response) {
+    (void)request;
+    response = this->debug_purgeAllocator();
+  }
+  inline virtual void debug_lockStatsI(const Json::Value& request, Json::Value& response) {
+    (void)request;
+    response = this->debug_lockStats();
+  }
+  inline virtual void debug_getRuntimeConfigI(const Json::Value& request, Json::Value& response) {
+    (void)request;
+    response = this->debug_getRuntimeConfig();
+  }
+  inline virtual void debug_setRuntimeConfigI(const Json::Value& request, Json::Value& response) {
+    response = this->debug_setRuntimeConfig(request[0u]);
+  }
 
   virtual Json::Value debug_traceTransaction(const std::string& param1) = 0;
   virtual Json::Value debug_traceCall(const Json::Value& param1, const std::string& param2) = 0;
@@ -89,6 +137,13 @@ class DebugFace : public ServerInterface<DebugFace> {
   virtual Json::Value trace_replayBlockTransactions(const std::string& param1, const Json::Value& param2) = 0;
   virtual Json::Value debug_dposValidatorTotalStakes(const std::string& param1) = 0;
   virtual Json::Value debug_dposTotalAmountDelegated(const std::string& param1) = 0;
+  virtual bool debug_startTracing() = 0;
+  virtual Json::Value debug_stopTracing() = 0;
+  virtual Json::Value debug_memoryStats() = 0;
+  virtual Json::Value debug_purgeAllocator() = 0;
+  virtual Json::Value debug_lockStats() = 0;
+  virtual Json::Value debug_getRuntimeConfig() = 0;
+  virtual Json::Value debug_setRuntimeConfig(const Json::Value& param1) = 0;
 };
 
 }  // namespace net
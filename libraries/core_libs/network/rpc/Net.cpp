@@ -25,14 +25,17 @@ std::string Net::net_version() {
 
 std::string Net::net_peerCount() {
   if (auto app = app_.lock()) {
-    return toJS(app->getNetwork()->getPeerCount());
+    // Read-only replica has no network
+    auto network = app->getNetwork();
+    return toJS(network ? network->getPeerCount() : 0);
   }
   BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR));
 }
 
 bool Net::net_listening() {
   if (auto app = app_.lock()) {
-    return app->getNetwork()->isStarted();
+    auto network = app->getNetwork();
+    return network && network->isStarted();
   }
   BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR));
 }
@@ -6,9 +6,13 @@
 #include <libdevcore/CommonJS.h>
 #include <libp2p/Common.h>
 
+#include <algorithm>
+
 #include "config/version.hpp"
 #include "dag/dag_manager.hpp"
+#include "network/rpc/eth/data.hpp"
 #include "pbft/pbft_manager.hpp"
+#include "pillar_chain/pillar_chain_manager.hpp"
 #include "transaction/transaction_manager.hpp"
 
 using namespace std;
@@ -34,7 +38,9 @@ Json::Value Taraxa::taraxa_getVersion() { return version; }
 string Taraxa::taraxa_dagBlockLevel() {
   try {
     auto app = tryGetApp();
-    return toJS(app->getDagManager()->getMaxLevel());
+    // Read-only replica has no dag manager, only finalized blocks from db are known to it
+    if (auto dag_mgr = app->getDagManager()) return toJS(dag_mgr->getMaxLevel());
+    return toJS(app->getDB()->getLastBlocksLevel());
   } catch (...) {
     BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INVALID_PARAMS));
   }
@@ -43,7 +49,8 @@ string Taraxa::taraxa_dagBlockLevel() {
 string Taraxa::taraxa_dagBlockPeriod() {
   try {
     auto app = tryGetApp();
-    return toJS(app->getDagManager()->getLatestPeriod());
+    if (auto dag_mgr = app->getDagManager()) return toJS(dag_mgr->getLatestPeriod());
+    return toJS(app->getFinalChain()->lastBlockNumber());
   } catch (...) {
     BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INVALID_PARAMS));
   }
@@ -59,12 +66,13 @@ std::shared_ptr<AppBase> Taraxa::tryGetApp() {
 Json::Value Taraxa::taraxa_getDagBlockByHash(const string& _blockHash, bool _includeTransactions) {
   try {
     auto app = tryGetApp();
-    auto block = app->getDagManager()->getDagBlock(blk_hash_t(_blockHash));
+    const blk_hash_t hash(_blockHash);
+    auto dag_mgr = app->getDagManager();
+    auto block = dag_mgr ? dag_mgr->getDagBlock(hash) : app->getDB()->getDagBlock(hash);
     if (block) {
       auto block_json = block->getJson();
-      auto period = app->getPbftManager()->getDagBlockPeriod(block->getHash());
-      if (period.first) {
-        block_json["period"] = toJS(period.second);
+      if (auto period = app->getDB()->getDagBlockPeriod(block->getHash())) {
+        block_json["period"] = toJS(period->first);
       } else {
         block_json["period"] = "-0x1";
       }
@@ -170,9 +178,8 @@ Json::Value Taraxa::taraxa_getDagBlockByLevel(const string& _blockLevel, bool _i
     auto res = Json::Value(Json::arrayValue);
     for (auto const& b : blocks) {
       auto block_json = b->getJson();
-      auto period = app->getPbftManager()->getDagBlockPeriod(b->getHash());
-      if (period.first) {
-        block_json["period"] = toJS(period.second);
+      if (auto period = app->getDB()->getDagBlockPeriod(b->getHash())) {
+        block_json["period"] = toJS(period->first);
       } else {
         block_json["period"] = "-0x1";
       }
@@ -238,22 +245,11 @@ Json::Value Taraxa::taraxa_getPillarBlockData(const std::string& pillar_block_pe
       BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR));
     }
 
-    const auto pbft_period = dev::jsToInt(pillar_block_period);
-    if (!app->getConfig().genesis.state.hardforks.ficus_hf.isPillarBlockPeriod(pbft_period)) {
-      return {};
-    }
-
-    const auto pillar_block = app->getDB()->getPillarBlock(pbft_period);
-    if (!pillar_block) {
+    const auto data = app->getPillarChainManager()->getPillarBlockData(dev::jsToInt(pillar_block_period));
+    if (!data) {
       return {};
     }
-
-    const auto& pillar_votes = app->getDB()->getPeriodPillarVotes(pbft_period + 1);
-    if (pillar_votes.empty()) {
-      return {};
-    }
-
-    return pillar_chain::PillarBlockData{pillar_block, pillar_votes}.getJson(include_signatures);
+    return include_signatures ? data->json_with_signatures : data->json;
   } catch (...) {
     BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INVALID_PARAMS));
   }
@@ -274,4 +270,141 @@ std::string Taraxa::taraxa_getPeriodLambda(const std::string& period) {
   }
 }
 
-}  // namespace taraxa::net
\ No newline at end of file
+std::optional<std::pair<EthBlockNumber, EthBlockNumber>> Taraxa::exportRange(const std::string& from,
+                                                                            const std::string& to) {
+  const auto last_block_number = tryGetApp()->getFinalChain()->lastBlockNumber();
+  const EthBlockNumber range_from = dev::jsToInt(from);
+  const EthBlockNumber range_to = dev::jsToInt(to);
+  if (range_from > range_to || range_from > last_block_number) {
+    return {};
+  }
+  return std::make_pair(range_from, std::min({range_to, range_from + kMaxExportedBlocks - 1, last_block_number}));
+}
+
+Json::Value Taraxa::taraxa_exportBlocks(const std::string& from, const std::string& to) {
+  std::optional<std::pair<EthBlockNumber, EthBlockNumber>> range;
+  try {
+    range = exportRange(from, to);
+  } catch (...) {
+    BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INVALID_PARAMS));
+  }
+
+  Json::Value res(Json::arrayValue);
+  if (!range) {
+    return res;
+  }
+  tryGetApp()->getFinalChain()->exportBlocks(
+      range->first, range->second,
+      [&res](const BlockHeader& header, const SharedTransactions& transactions, const TransactionReceipts& receipts) {
+        Json::Value block_json = rpc::eth::toJson(header);
+        auto& transactions_json = block_json["transactions"] = Json::Value(Json::arrayValue);
+        Json::Value receipts_json(Json::arrayValue);
+        for (uint32_t i = 0; i < transactions.size(); ++i) {
+          const auto& trx = transactions[i];
+          const rpc::eth::ExtendedTransactionLocation loc{{{header.number, i}, header.hash}, trx->getHash()};
+          transactions_json.append(rpc::eth::toJson(*trx, loc));
+          if (i < receipts.size()) {
+            receipts_json.append(
+                rpc::eth::toJson(rpc::eth::LocalisedTransactionReceipt{receipts[i], loc, trx->getSender(),
+                                                                       trx->getReceiver()}));
+          }
+        }
+        Json::Value exported(Json::objectValue);
+        exported["block"] = std::move(block_json);
+        exported["receipts"] = std::move(receipts_json);
+        res.append(std::move(exported));
+        return true;
+      });
+  return res;
+}
+
+std::vector<std::shared_ptr<const pillar_chain::SerializedPillarBlockData>> Taraxa::pillarBlocksData(
+    const std::string& from, const std::string& count) {
+  const auto blocks_count = std::min<size_t>(dev::jsToInt(count), kMaxPillarBlocksData);
+  return tryGetApp()->getPillarChainManager()->getPillarBlocksData(dev::jsToInt(from), blocks_count);
+}
+
+Json::Value Taraxa::taraxa_getPillarBlocksData(const std::string& from, const std::string& count,
+                                               bool include_signatures) {
+  std::vector<std::shared_ptr<const pillar_chain::SerializedPillarBlockData>> blocks_data;
+  try {
+    blocks_data = pillarBlocksData(from, count);
+  } catch (...) {
+    BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INVALID_PARAMS));
+  }
+
+  Json::Value res(Json::arrayValue);
+  for (const auto& data : blocks_data) {
+    res.append(include_signatures ? data->json_with_signatures : data->json);
+  }
+  return res;
+}
+
+void Taraxa::registerSerializedMethods(JsonRpcSerializedMethods& methods) {
+  using Result = JsonRpcSerializedMethods::Result;
+  // Finalized pillar blocks are written from json serialized when they were finalized
+  methods.registerMethod("taraxa_getPillarBlockData", [this](const Json::Value& params, JsonWriter& w) {
+    if (params.size() != 2 || !params[0].isString() || !params[1].isBool()) {
+      return Result::Fallback;
+    }
+    const auto data = tryGetApp()->getPillarChainManager()->getPillarBlockData(dev::jsToInt(params[0].asString()));
+    if (!data) {
+      // Pillar block can still be finalized later
+      w.null();
+      return Result::Done;
+    }
+    w.raw(params[1].asBool() ? *data->json_with_signatures_str : *data->json_str);
+    return Result::Final;
+  });
+  methods.registerMethod("taraxa_getPillarBlocksData", [this](const Json::Value& params, JsonWriter& w) {
+    if (params.size() != 3 || !params[0].isString() || !params[1].isString() || !params[2].isBool()) {
+      return Result::Fallback;
+    }
+    const auto include_signatures = params[2].asBool();
+    w.beginArray();
+    for (const auto& data : pillarBlocksData(params[0].asString(), params[1].asString())) {
+      w.raw(include_signatures ? *data->json_with_signatures_str : *data->json_str);
+    }
+    w.endArray();
+    // Range end is limited by the last finalized pillar block
+    return Result::Done;
+  });
+  methods.registerMethod("taraxa_exportBlocks", [this](const Json::Value& params, JsonWriter& w) {
+    if (params.size() != 2 || !params[0].isString() || !params[1].isString()) {
+      return Result::Fallback;
+    }
+    const auto range = exportRange(params[0].asString(), params[1].asString());
+    w.beginArray();
+    if (range) {
+      tryGetApp()->getFinalChain()->exportBlocks(
+          range->first, range->second,
+          [&w](const BlockHeader& header, const SharedTransactions& transactions, const TransactionReceipts& receipts) {
+            const auto location = [&](uint32_t i) {
+              return rpc::eth::ExtendedTransactionLocation{{{header.number, i}, header.hash},
+                                                           transactions[i]->getHash()};
+            };
+            w.beginObject().key("block");
+            rpc::eth::write(w, header, [&] {
+              w.beginArray();
+              for (uint32_t i = 0; i < transactions.size(); ++i) {
+                rpc::eth::write(w, *transactions[i], location(i));
+              }
+              w.endArray();
+            });
+            w.key("receipts").beginArray();
+            for (uint32_t i = 0; i < transactions.size() && i < receipts.size(); ++i) {
+              const auto& trx = transactions[i];
+              rpc::eth::write(w, rpc::eth::LocalisedTransactionReceipt{receipts[i], location(i), trx->getSender(),
+                                                                      trx->getReceiver()});
+            }
+            w.endArray().endObject();
+            return true;
+          });
+    }
+    w.endArray();
+    // Blocks in range are final, but range end can still be limited by the last block
+    return Result::Done;
+  });
+}
+
+}  // namespace taraxa::net
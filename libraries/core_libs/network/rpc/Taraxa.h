@@ -5,10 +5,16 @@
 #include <libdevcore/Common.h>
 
 #include <memory>
+#include <optional>
 
 #include "TaraxaFace.h"
 #include "common/app_base.hpp"
 #include "libweb3jsonrpc/ModularServer.h"
+#include "network/rpc/jsonrpc_serialized_methods.hpp"
+
+namespace taraxa::pillar_chain {
+struct SerializedPillarBlockData;
+}  // namespace taraxa::pillar_chain
 
 namespace taraxa::net {
 
@@ -34,14 +40,30 @@ class Taraxa : public TaraxaFace {
   virtual Json::Value taraxa_getPillarBlockData(const std::string& pillar_block_period,
                                                 bool include_signatures) override;
   virtual std::string taraxa_getPeriodLambda(const std::string& period) override;
+  virtual Json::Value taraxa_exportBlocks(const std::string& from, const std::string& to) override;
+  virtual Json::Value taraxa_getPillarBlocksData(const std::string& from, const std::string& count,
+                                                 bool include_signatures) override;
+
+  // Registers fast paths of blocks export and pillar blocks data, which write results directly into response
+  void registerSerializedMethods(JsonRpcSerializedMethods& methods);
 
  protected:
   std::weak_ptr<taraxa::AppBase> app_;
 
  private:
+  // Maximal number of blocks exported by single call, consumers page through longer ranges
+  static constexpr EthBlockNumber kMaxExportedBlocks = 1000;
+  // Maximal number of pillar blocks returned by single call, relayers page through longer backfills
+  static constexpr size_t kMaxPillarBlocksData = 100;
+
   Json::Value version;
 
   std::shared_ptr<taraxa::AppBase> tryGetApp();
+  // Range of exported blocks limited by kMaxExportedBlocks and last block, empty optional if there is nothing to export
+  std::optional<std::pair<EthBlockNumber, EthBlockNumber>> exportRange(const std::string& from, const std::string& to);
+  // Finalized pillar blocks from period, count is limited by kMaxPillarBlocksData
+  std::vector<std::shared_ptr<const pillar_chain::SerializedPillarBlockData>> pillarBlocksData(
+      const std::string& from, const std::string& count);
 };
 
 }  // namespace taraxa::net
@@ -156,6 +156,31 @@ class TaraxaClient : public jsonrpc::Client {
     else
       throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
   }
+
+  Json::Value taraxa_exportBlocks(const std::string& param1,
+                                  const std::string& param2) throw(jsonrpc::JsonRpcException) {
+    Json::Value p;
+    p.append(param1);
+    p.append(param2);
+    Json::Value result = this->CallMethod("taraxa_exportBlocks", p);
+    if (result.isArray())
+      return result;
+    else
+      throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+  }
+
+  Json::Value taraxa_getPillarBlocksData(const std::string& param1, const std::string& param2,
+                                         bool param3) throw(jsonrpc::JsonRpcException) {
+    Json::Value p;
+    p.append(param1);
+    p.append(param2);
+    p.append(param3);
+    Json::Value result = this->CallMethod("taraxa_getPillarBlocksData", p);
+    if (result.isArray())
+      return result;
+    else
+      throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+  }
 };
 
 }  // namespace net
@@ -62,6 +62,13 @@ class TaraxaFace : public ServerInterface<TaraxaFace> {
     this->bindAndAddMethod(jsonrpc::Procedure("taraxa_getPeriodLambda", jsonrpc::PARAMS_BY_POSITION,
                                               jsonrpc::JSON_STRING, "param1", jsonrpc::JSON_STRING, NULL),
                            &taraxa::net::TaraxaFace::taraxa_getPeriodLambdaI);
+    this->bindAndAddMethod(jsonrpc::Procedure("taraxa_exportBlocks", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_ARRAY,
+                                              "param1", jsonrpc::JSON_STRING, "param2", jsonrpc::JSON_STRING, NULL),
+                           &taraxa::net::TaraxaFace::taraxa_exportBlocksI);
+    this->bindAndAddMethod(
+        jsonrpc::Procedure("taraxa_getPillarBlocksData", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_ARRAY, "param1",
+                           jsonrpc::JSON_STRING, "param2", jsonrpc::JSON_STRING, "param3", jsonrpc::JSON_BOOLEAN, NULL),
+        &taraxa::net::TaraxaFace::taraxa_getPillarBlocksDataI);
   }
 
   inline virtual void taraxa_protocolVersionI(const Json::Value &request, Json::Value &response) {
@@ -120,6 +127,13 @@ class TaraxaFace : public ServerInterface<TaraxaFace> {
     (void)request;
     response = this->taraxa_getPeriodLambda(request[0u].asString());
   }
+  inline virtual void taraxa_exportBlocksI(const Json::Value &request, Json::Value &response) {
+    response = this->taraxa_exportBlocks(request[0u].asString(), request[1u].asString());
+  }
+  inline virtual void taraxa_getPillarBlocksDataI(const Json::Value &request, Json::Value &response) {
+    response =
+        this->taraxa_getPillarBlocksData(request[0u].asString(), request[1u].asString(), request[2u].asBool());
+  }
 
   virtual std::string taraxa_protocolVersion() = 0;
   virtual Json::Value taraxa_getVersion() = 0;
@@ -136,6 +150,9 @@ class TaraxaFace : public ServerInterface<TaraxaFace> {
   virtual std::string taraxa_totalSupply(const std::string &param1) = 0;
   virtual Json::Value taraxa_getPillarBlockData(const std::string &param1, bool param2) = 0;
   virtual std::string taraxa_getPeriodLambda(const std::string &param1) = 0;
+  virtual Json::Value taraxa_exportBlocks(const std::string &param1, const std::string &param2) = 0;
+  virtual Json::Value taraxa_getPillarBlocksData(const std::string &param1, const std::string &param2,
+                                                 bool param3) = 0;
 };
 
 }  // namespace net
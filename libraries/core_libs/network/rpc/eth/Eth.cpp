@@ -3,12 +3,14 @@
 #include <json/json.h>
 #include <libdevcore/CommonData.h>
 #include <libdevcore/CommonJS.h>
+#include <libdevcore/RLP.h>
 
 #include <stdexcept>
 
 #include "LogFilter.hpp"
 #include "common/rpc_utils.hpp"
 #include "common/types.hpp"
+#include "common/util.hpp"
 using namespace std;
 using namespace dev;
 using namespace taraxa::final_chain;
@@ -101,6 +103,104 @@ Json::Value toJson(const SyncStatus& obj) {
   return res;
 }
 
+// Keys are written in alphabetical order, same as jsoncpp orders them
+void write(JsonWriter& w, const BlockHeader& obj, const std::function<void()>& write_transactions) {
+  w.beginObject();
+  w.key("author").hex(obj.author);
+  w.key("difficulty").hex(uint64_t(0));
+  w.key("extraData").hex(obj.extra_data);
+  w.key("gasLimit").hex(obj.gas_limit);
+  w.key("gasUsed").hex(obj.gas_used);
+  w.key("hash").hex(obj.hash);
+  w.key("logsBloom").hex(obj.log_bloom);
+  w.key("miner").hex(obj.author);
+  w.key("mixHash").hex(BlockHeader::mixHash());
+  w.key("nonce").hex(BlockHeader::nonce());
+  w.key("number").hex(obj.number);
+  w.key("parentHash").hex(obj.parent_hash);
+  w.key("receiptsRoot").hex(obj.receipts_root);
+  w.key("sha3Uncles").hex(BlockHeader::unclesHash());
+  w.key("size").hex(obj.size);
+  w.key("stateRoot").hex(obj.state_root);
+  w.key("timestamp").hex(obj.timestamp);
+  w.key("totalDifficulty").hex(uint64_t(0));
+  w.key("totalReward").hex(obj.total_reward);
+  if (write_transactions) {
+    w.key("transactions");
+    write_transactions();
+  }
+  w.key("transactionsRoot").hex(obj.transactions_root);
+  w.key("uncles").beginArray().endArray();
+  w.endObject();
+}
+
+void write(JsonWriter& w, const Transaction& trx, const optional<TransactionLocationWithBlockHash>& loc) {
+  const auto& vrs = trx.getVRS();
+  w.beginObject();
+  w.key("blockHash");
+  loc ? w.hex(loc->blk_h) : w.null();
+  w.key("blockNumber");
+  loc ? w.hex(loc->period) : w.null();
+  w.key("chainId").hex(trx.getChainID());
+  w.key("from").hex(trx.getSender());
+  w.key("gas").hex(trx.getGas());
+  w.key("gasPrice").hex(trx.getGasPrice());
+  w.key("hash").hex(trx.getHash());
+  w.key("input").hex(trx.getData());
+  w.key("nonce").hex(trx.getNonce());
+  w.key("r").hex(u256(vrs.r));
+  w.key("s").hex(u256(vrs.s));
+  w.key("sig").hex(sig_t(vrs));
+  if (const auto& to = trx.getReceiver()) {
+    w.key("to").hex(*to);
+  }
+  w.key("transactionIndex");
+  loc ? w.hex(loc->position) : w.null();
+  w.key("v").hexByte(vrs.v);
+  w.key("value").hex(trx.getValue());
+  w.endObject();
+}
+
+void write(JsonWriter& w, const LocalisedLogEntry& lle) {
+  w.beginObject();
+  w.key("address").hex(lle.le.address);
+  w.key("blockHash").hex(lle.trx_loc.blk_h);
+  w.key("blockNumber").hex(lle.trx_loc.period);
+  w.key("data").hex(lle.le.data);
+  w.key("logIndex").hex(lle.position_in_receipt);
+  w.key("removed").value(false);
+  w.key("topics").beginArray();
+  for (const auto& t : lle.le.topics) {
+    w.hex(t);
+  }
+  w.endArray();
+  w.key("transactionHash").hex(lle.trx_loc.trx_hash);
+  w.key("transactionIndex").hex(lle.trx_loc.position);
+  w.endObject();
+}
+
+void write(JsonWriter& w, const LocalisedTransactionReceipt& ltr) {
+  w.beginObject();
+  w.key("blockHash").hex(ltr.trx_loc.blk_h);
+  w.key("blockNumber").hex(ltr.trx_loc.period);
+  w.key("contractAddress").hex(ltr.r.new_contract_address);
+  w.key("cumulativeGasUsed").hex(ltr.r.cumulative_gas_used);
+  w.key("from").hex(ltr.trx_from);
+  w.key("gasUsed").hex(ltr.r.gas_used);
+  w.key("logs").beginArray();
+  uint log_i = 0;
+  for (const auto& le : ltr.r.logs) {
+    write(w, LocalisedLogEntry{le, ltr.trx_loc, log_i++});
+  }
+  w.endArray();
+  w.key("logsBloom").hex(ltr.r.bloom());
+  w.key("status").hexByte(ltr.r.status_code);
+  w.key("to").hex(ltr.trx_to);
+  w.key("transactionHash").hex(ltr.trx_loc.trx_hash);
+  w.key("transactionIndex").hex(ltr.trx_loc.position);
+  w.endObject();
+}
+
 DEV_SIMPLE_EXCEPTION(InvalidAddress);
 Address toAddress(const std::string& s) {
   try {
@@ -113,10 +213,27 @@ Address toAddress(const std::string& s) {
 }
 
 class EthImpl : public Eth, EthParams {
+  static constexpr size_t kEstimateGasCacheSize = 10000;
+  // Binary search is stopped after this many dry runs, even if the precision is not reached yet
+  static constexpr uint32_t kEstimateGasMaxIterations = 16;
+  // Estimations are rejected when estimate gas pool has more pending tasks per thread
+  static constexpr uint64_t kEstimateGasMaxPendingPerThread = 4;
+
   Watches watches_;
+  std::unique_ptr<util::ThreadPool> logs_thread_pool_;
+  std::unique_ptr<util::ThreadPool> estimate_gas_thread_pool_;
+  // Estimations keyed by hash of call params and state root of the block
+  StatusTable<h256, gas_t> estimate_gas_cache_{kEstimateGasCacheSize};
 
  public:
-  EthImpl(EthParams&& prerequisites) : EthParams(std::move(prerequisites)), watches_(watches_cfg) {}
+  EthImpl(EthParams&& prerequisites) : EthParams(std::move(prerequisites)), watches_(watches_cfg) {
+    if (logs_query_threads) {
+      logs_thread_pool_ = std::make_unique<util::ThreadPool>(logs_query_threads);
+    }
+    if (estimate_gas_threads) {
+      estimate_gas_thread_pool_ = std::make_unique<util::ThreadPool>(estimate_gas_threads);
+    }
+  }
 
   virtual RPCModules implementedModules() const override { return RPCModules{RPCModule{"eth", "1.0"}}; }
 
@@ -176,43 +293,37 @@ class EthImpl : public Eth, EthParams {
     }
     prepare_transaction_for_call(t, blk_n);
 
-    auto is_enough_gas = [&](gas_t gas) -> bool {
-      t.gas = gas;
-      auto res = call(blk_n, t);
-      if (!res.consensus_err.empty()) {
-        throw std::runtime_error(res.consensus_err);
+    // Same call on the same state always needs the same amount of gas
+    std::optional<h256> cache_key;
+    if (const auto header = final_chain->blockHeader(blk_n)) {
+      cache_key = estimate_gas_cache_key(t, header->state_root);
+      if (const auto [gas, found] = estimate_gas_cache_.get(*cache_key); found) {
+        return toJS(gas);
       }
-      if (!res.code_err.empty()) {
-        return false;
-      }
-      return true;
-    };
-    // couldn't be lower than execution gas_used. So we should start with this value
-    auto call_result = call(blk_n, t);
-    if (!call_result.consensus_err.empty() || !call_result.code_err.empty()) {
-      throw std::runtime_error(call_result.consensus_err.empty() ? call_result.code_err : call_result.consensus_err);
-    }
-    gas_t low = call_result.gas_used;
-    gas_t hi = *t.gas;
-    if (low > hi) {
-      throw std::runtime_error("out of gas");
     }
-    // precision is 5%(1/20) of higher gas_used value
-    while (hi - low > hi / 20) {
-      auto mid = low + ((hi - low) / 2);
 
-      if (is_enough_gas(mid)) {
-        hi = mid;
-      } else {
-        low = mid;
+    gas_t gas = 0;
+    if (estimate_gas_thread_pool_) {
+      if (estimate_gas_thread_pool_->num_pending_tasks() >=
+          estimate_gas_thread_pool_->capacity() * kEstimateGasMaxPendingPerThread) {
+        throw std::runtime_error("Too many pending gas estimations");
       }
+      estimate_gas_thread_pool_->post([&] { gas = estimate_gas(blk_n, t); }).get();
+    } else {
+      gas = estimate_gas(blk_n, t);
     }
-    return toJS(hi);
+
+    if (cache_key) {
+      estimate_gas_cache_.insert(*cache_key, gas);
+    }
+    return toJS(gas);
   }
 
   string eth_getTransactionCount(const string& _address, const Json::Value& _json) override {
     const auto block_number = get_block_number_from_json(_json);
-    return toJS(transaction_count(block_number, toAddress(_address)));
+    const auto addr = toAddress(_address);
+    const auto nonce = transaction_count(block_number, addr);
+    return toJS(is_pending_blk_num(_json) ? pending_transaction_count(nonce, addr) : nonce);
   }
 
   Json::Value eth_getBlockTransactionCountByHash(const string& _blockHash) override {
@@ -228,7 +339,7 @@ class EthImpl : public Eth, EthParams {
   Json::Value eth_getUncleCountByBlockNumber(const string&) override { return toJS(0); }
 
   string eth_sendRawTransaction(const string& _rlp) override {
-    auto trx = std::make_shared<Transaction>(jsToBytes(_rlp, OnFailed::Throw), true);
+    auto trx = util::makeShared<Transaction>(jsToBytes(_rlp, OnFailed::Throw), true);
     send_trx(trx);
     return toJS(trx->getHash());
   }
@@ -264,16 +375,17 @@ class EthImpl : public Eth, EthParams {
 
   Json::Value eth_getBlockReceipts(const Json::Value& _blockNumber) override {
     auto blk_n = get_block_number_from_json(_blockNumber);
-    auto block_hash = final_chain->blockHash(blk_n);
+    const auto pruned = final_chain->fetchHistoricalBlock(blk_n);
+    auto block_hash = pruned ? optional<h256>(pruned->header->hash) : final_chain->blockHash(blk_n);
     if (!block_hash) {
       return Json::Value(Json::arrayValue);
     }
-    auto transactions = final_chain->transactions(blk_n);
+    auto transactions = pruned ? pruned->transactions : final_chain->transactions(blk_n);
     if (transactions.empty()) {
       return Json::Value(Json::arrayValue);
     }
 
-    auto receipts = final_chain->blockReceipts(blk_n);
+    auto receipts = pruned ? pruned->receipts : final_chain->blockReceipts(blk_n);
     return util::transformToJsonParallel(
         transactions, [this, &receipts, blk_n, &block_hash](const auto& trx, auto index) {
           if (!receipts) {
@@ -298,7 +410,7 @@ class EthImpl : public Eth, EthParams {
   Json::Value eth_getUncleByBlockNumberAndIndex(const string&, const string&) override { return Json::Value(); }
 
   string eth_newFilter(const Json::Value& _json) override {
-    return toJS(watches_.logs_.install_watch(parse_log_filter(_json)));
+    return toJS(watches_.install_logs_watch(parse_log_filter(_json)));
   }
 
   string eth_newBlockFilter() override { return toJS(watches_.new_blocks_.install_watch()); }
@@ -319,14 +431,12 @@ class EthImpl : public Eth, EthParams {
 
   Json::Value eth_getFilterLogs(const string& _filterId) override {
     if (auto filter = watches_.logs_.get_watch_params(jsToInt(_filterId))) {
-      return toJsonArray(filter->match_all(*final_chain));
+      return getLogs(*filter);
     }
     return Json::Value(Json::arrayValue);
   }
 
-  Json::Value eth_getLogs(const Json::Value& _json) override {
-    return toJsonArray(parse_log_filter(_json).match_all(*final_chain));
-  }
+  Json::Value eth_getLogs(const Json::Value& _json) override { return getLogs(parse_log_filter(_json)); }
 
   Json::Value eth_syncing() override {
     auto status = syncing_probe();
@@ -341,15 +451,183 @@ class EthImpl : public Eth, EthParams {
     ExtendedTransactionLocation trx_loc{{{blk_header.number}, blk_header.hash}};
     for (; trx_loc.position < trxs.size(); ++trx_loc.position) {
       trx_loc.trx_hash = trxs[trx_loc.position]->getHash();
-      using LogsInput = typename decltype(watches_.logs_)::InputType;
-      watches_.logs_.process_update(LogsInput(trx_loc, receipts[trx_loc.position]));
+      watches_.process_logs(trx_loc, receipts[trx_loc.position]);
     }
   }
 
   void note_pending_transaction(const h256& trx_hash) override { watches_.new_transactions_.process_update(trx_hash); }
 
+  void registerSerializedMethods(JsonRpcSerializedMethods& methods) override {
+    using Result = JsonRpcSerializedMethods::Result;
+    // Tiny frequently polled methods, jsonrpccpp params validation and dispatch would be most of their cost
+    methods.registerMethod("eth_blockNumber", [this](const Json::Value& params, JsonWriter& w) {
+      if (!params.empty()) {
+        return Result::Fallback;
+      }
+      w.hex(final_chain->lastBlockNumber());
+      return Result::Done;
+    });
+    methods.registerMethod("eth_chainId", [this](const Json::Value& params, JsonWriter& w) {
+      if (!params.empty()) {
+        return Result::Fallback;
+      }
+      if (chain_id) {
+        w.hex(chain_id);
+      } else {
+        w.null();
+      }
+      return Result::Final;
+    });
+    methods.registerMethod("eth_gasPrice", [this](const Json::Value& params, JsonWriter& w) {
+      if (!params.empty()) {
+        return Result::Fallback;
+      }
+      w.hex(gas_pricer());
+      return Result::Done;
+    });
+    methods.registerMethod("eth_getBlockByHash", [this](const Json::Value& params, JsonWriter& w) {
+      if (params.size() != 2 || !params[0].isString() || !params[1].isBool()) {
+        return Result::Fallback;
+      }
+      if (auto blk_n = final_chain->blockNumber(jsToFixed<32>(params[0].asString())); blk_n) {
+        return write_block_by_number(w, *blk_n, params[1].asBool()) ? Result::Final : Result::Done;
+      }
+      w.null();
+      return Result::Done;
+    });
+    methods.registerMethod("eth_getBlockByNumber", [this](const Json::Value& params, JsonWriter& w) {
+      if (params.size() != 2 || !params[0].isString() || !params[1].isBool()) {
+        return Result::Fallback;
+      }
+      const auto blk_num_str = params[0].asString();
+      const auto found = write_block_by_number(w, parse_blk_num(blk_num_str), params[1].asBool());
+      return found && is_explicit_blk_num(blk_num_str) ? Result::Final : Result::Done;
+    });
+    methods.registerMethod("eth_getTransactionByHash", [this](const Json::Value& params, JsonWriter& w) {
+      if (params.size() != 1 || !params[0].isString()) {
+        return Result::Fallback;
+      }
+      if (const auto lt = get_transaction(jsToFixed<32>(params[0].asString()))) {
+        write(w, *lt->trx, lt->trx_loc);
+        return Result::Final;
+      }
+      w.null();
+      return Result::Done;
+    });
+    methods.registerMethod("eth_getTransactionReceipt", [this](const Json::Value& params, JsonWriter& w) {
+      if (params.size() != 1 || !params[0].isString()) {
+        return Result::Fallback;
+      }
+      if (const auto ltr = get_transaction_receipt(jsToFixed<32>(params[0].asString()))) {
+        write(w, *ltr);
+        return Result::Final;
+      }
+      w.null();
+      return Result::Done;
+    });
+    methods.registerMethod("eth_getBlockReceipts", [this](const Json::Value& params, JsonWriter& w) {
+      if (params.size() != 1 || !params[0].isString()) {
+        return Result::Fallback;
+      }
+      const auto blk_num_str = params[0].asString();
+      const auto blk_n = parse_blk_num(blk_num_str);
+      const auto pruned = final_chain->fetchHistoricalBlock(blk_n);
+      const auto block_hash = pruned ? optional<h256>(pruned->header->hash) : final_chain->blockHash(blk_n);
+      w.beginArray();
+      if (block_hash) {
+        const auto receipts = pruned ? pruned->receipts : final_chain->blockReceipts(blk_n);
+        const auto transactions = pruned ? pruned->transactions : final_chain->transactions(blk_n);
+        for (uint32_t index = 0; index < transactions.size(); ++index) {
+          const auto& trx = transactions[index];
+          write(w, LocalisedTransactionReceipt{
+                       receipts ? receipts->at(index)
+                                : final_chain->transactionReceipt(blk_n, index, trx->getHash()).value(),
+                       ExtendedTransactionLocation{{{blk_n, index}, *block_hash}, trx->getHash()},
+                       trx->getSender(),
+                       trx->getReceiver(),
+                   });
+        }
+      }
+      w.endArray();
+      return block_hash && is_explicit_blk_num(blk_num_str) ? Result::Final : Result::Done;
+    });
+    methods.registerMethod("eth_getLogs", [this](const Json::Value& params, JsonWriter& w) {
+      if (params.size() != 1 || !params[0].isObject()) {
+        return Result::Fallback;
+      }
+      const auto filter = parse_log_filter(params[0]);
+      w.beginArray();
+      filter.match_all(
+          *final_chain, [&w](const LocalisedLogEntry& lle) { write(w, lle); }, logs_thread_pool_.get(),
+          logs_query_limits);
+      w.endArray();
+      return Result::Done;
+    });
+    // State reads of json-rpc batch are resolved together, requests for latest block see the same state
+    methods.registerGroup({"eth_getBalance", "eth_getTransactionCount", "eth_getCode", "eth_getStorageAt"},
+                          [this](const vector<JsonRpcSerializedMethods::GroupRequest>& requests,
+                                 vector<optional<string>>& results) { query_state(requests, results); });
+  }
+
+  void query_state(const vector<JsonRpcSerializedMethods::GroupRequest>& requests, vector<optional<string>>& results) {
+    const auto latest = final_chain->lastBlockNumber();
+    vector<StateQuery> queries;
+    vector<size_t> indexes;
+    // Nonce queries for pending block also count sender transactions in the pool
+    vector<bool> pending_nonces;
+    for (size_t i = 0; i < requests.size(); ++i) {
+      const auto& [method, params] = requests[i];
+      const auto is_storage = method == "eth_getStorageAt";
+      const Json::ArrayIndex params_count = is_storage ? 3 : 2;
+      if (params.size() != params_count || !params[0].isString() || (is_storage && !params[1].isString())) {
+        continue;
+      }
+
+      // Invalid params are reported by regular handler
+      try {
+        StateQuery query;
+        query.address = toAddress(params[0].asString());
+        query.blk_n = get_block_number_from_json(params[params_count - 1], latest);
+        if (method == "eth_getBalance") {
+          query.kind = StateQuery::Kind::Balance;
+        } else if (method == "eth_getTransactionCount") {
+          query.kind = StateQuery::Kind::Nonce;
+        } else if (method == "eth_getCode") {
+          query.kind = StateQuery::Kind::Code;
+        } else {
+          query.kind = StateQuery::Kind::Storage;
+          query.slot = jsToU256(params[1].asString());
+        }
+        pending_nonces.push_back(query.kind == StateQuery::Kind::Nonce && is_pending_blk_num(params[params_count - 1]));
+        queries.push_back(std::move(query));
+        indexes.push_back(i);
+      } catch (...) {
+      }
+    }
+
+    const auto state = final_chain->queryState(queries);
+    for (size_t i = 0; i < queries.size(); ++i) {
+      JsonWriter w(results[indexes[i]].emplace());
+      switch (queries[i].kind) {
+        case StateQuery::Kind::Balance:
+          w.hex(state[i].value);
+          break;
+        case StateQuery::Kind::Nonce:
+          w.hex(pending_nonces[i] ? pending_transaction_count(state[i].value, queries[i].address) : state[i].value);
+          break;
+        case StateQuery::Kind::Code:
+          w.hex(state[i].code);
+          break;
+        case StateQuery::Kind::Storage:
+          w.hex(state[i].storage);
+          break;
+      }
+    }
+  }
+
   Json::Value get_block_by_number(EthBlockNumber blk_n, bool include_transactions) {
-    auto blk_header = final_chain->blockHeader(blk_n);
+    const auto pruned = final_chain->fetchHistoricalBlock(blk_n);
+    auto blk_header = pruned ? pruned->header : final_chain->blockHeader(blk_n);
     if (!blk_header) {
       return Json::Value();
     }
@@ -359,10 +637,14 @@ class EthImpl : public Eth, EthParams {
       ExtendedTransactionLocation loc;
       loc.period = blk_header->number;
       loc.blk_h = blk_header->hash;
-      for (const auto& t : final_chain->transactions(blk_n)) {
+      for (const auto& t : pruned ? pruned->transactions : final_chain->transactions(blk_n)) {
         trxs_json.append(toJson(*t, loc));
         ++loc.position;
       }
+    } else if (pruned) {
+      for (const auto& t : pruned->transactions) {
+        trxs_json.append(toJS(t->getHash()));
+      }
     } else {
       auto hashes = final_chain->transactionHashes(blk_n);
       trxs_json = toJsonArray(*hashes);
@@ -370,6 +652,38 @@ class EthImpl : public Eth, EthParams {
     return ret;
   }
 
+  // Returns false in case block doesn't exist yet
+  bool write_block_by_number(JsonWriter& w, EthBlockNumber blk_n, bool include_transactions) {
+    const auto pruned = final_chain->fetchHistoricalBlock(blk_n);
+    auto blk_header = pruned ? pruned->header : final_chain->blockHeader(blk_n);
+    if (!blk_header) {
+      w.null();
+      return false;
+    }
+    write(w, *blk_header, [&] {
+      w.beginArray();
+      if (include_transactions) {
+        TransactionLocationWithBlockHash loc;
+        loc.period = blk_header->number;
+        loc.blk_h = blk_header->hash;
+        for (const auto& t : pruned ? pruned->transactions : final_chain->transactions(blk_n)) {
+          write(w, *t, loc);
+          ++loc.position;
+        }
+      } else if (pruned) {
+        for (const auto& t : pruned->transactions) {
+          w.hex(t->getHash());
+        }
+      } else {
+        for (const auto& hash : *final_chain->transactionHashes(blk_n)) {
+          w.hex(hash);
+        }
+      }
+      w.endArray();
+    });
+    return true;
+  }
+
   optional<LocalisedTransaction> get_transaction(const h256& h) const {
     auto trx = get_trx(h);
     if (!trx) {
@@ -386,7 +700,8 @@ class EthImpl : public Eth, EthParams {
   }
 
   optional<LocalisedTransaction> get_transaction(EthBlockNumber blk_n, uint32_t trx_pos) const {
-    const auto& trxs = final_chain->transactions(blk_n);
+    const auto pruned = final_chain->fetchHistoricalBlock(blk_n);
+    const auto trxs = pruned ? pruned->transactions : final_chain->transactions(blk_n);
     if (trxs.size() <= trx_pos) {
       return {};
     }
@@ -394,7 +709,7 @@ class EthImpl : public Eth, EthParams {
         trxs[trx_pos],
         TransactionLocationWithBlockHash{
             {blk_n, trx_pos},
-            *final_chain->blockHash(blk_n),
+            pruned ? pruned->header->hash : *final_chain->blockHash(blk_n),
         },
     };
   }
@@ -435,6 +750,14 @@ class EthImpl : public Eth, EthParams {
     return final_chain->getAccount(addr, n).value_or(ZeroAccount).nonce;
   }
 
+  // Nonce of the pending block includes sender transactions that are already in the pool
+  trx_nonce_t pending_transaction_count(const trx_nonce_t& state_nonce, const Address& addr) {
+    if (const auto pending_nonce = get_pending_nonce(addr); pending_nonce && *pending_nonce > state_nonce) {
+      return *pending_nonce;
+    }
+    return state_nonce;
+  }
+
   state_api::ExecutionResult call(EthBlockNumber blk_n, const TransactionSkeleton& trx) {
     const auto result = final_chain->call(
         {
@@ -451,6 +774,60 @@ class EthImpl : public Eth, EthParams {
     return result;
   }
 
+  gas_t estimate_gas(EthBlockNumber blk_n, TransactionSkeleton t) {
+    auto is_enough_gas = [&](gas_t gas) -> bool {
+      t.gas = gas;
+      auto res = call(blk_n, t);
+      if (!res.consensus_err.empty()) {
+        throw std::runtime_error(res.consensus_err);
+      }
+      if (!res.code_err.empty()) {
+        return false;
+      }
+      return true;
+    };
+    // couldn't be lower than execution gas_used. So we should start with this value
+    auto call_result = call(blk_n, t);
+    if (!call_result.consensus_err.empty() || !call_result.code_err.empty()) {
+      throw std::runtime_error(call_result.consensus_err.empty() ? call_result.code_err : call_result.consensus_err);
+    }
+    gas_t low = call_result.gas_used;
+    gas_t hi = *t.gas;
+    if (low > hi) {
+      throw std::runtime_error("out of gas");
+    }
+    // Refunds are not reported by execution, so seed covers only gas withheld from nested calls (1/64 of gas left).
+    // It is enough for most calls and puts the search within precision after a single extra dry run, otherwise the
+    // upper bound is searched by doubling the seed instead of halving gas limit of the call
+    uint32_t iterations = 0;
+    for (gas_t probe = low + low / 63 + 1; probe < hi && iterations < kEstimateGasMaxIterations; ++iterations) {
+      if (is_enough_gas(probe)) {
+        hi = probe;
+        break;
+      }
+      low = probe;
+      probe = std::min(hi, probe * 2);
+    }
+    // precision is 5%(1/20) of higher gas_used value
+    for (; iterations < kEstimateGasMaxIterations && hi - low > hi / 20; ++iterations) {
+      auto mid = low + ((hi - low) / 2);
+
+      if (is_enough_gas(mid)) {
+        hi = mid;
+      } else {
+        low = mid;
+      }
+    }
+    return hi;
+  }
+
+  static h256 estimate_gas_cache_key(const TransactionSkeleton& t, const h256& state_root) {
+    RLPStream s(8);
+    s << t.from << (t.to ? t.to->asBytes() : bytes()) << sha3(t.data) << t.value << *t.nonce << *t.gas
+      << *t.gas_price << state_root;
+    return sha3(s.out());
+  }
+
   // this should be used only in eth_call and eth_estimateGas
   void prepare_transaction_for_call(TransactionSkeleton& t, EthBlockNumber blk_n) {
     if (!t.from) {
@@ -508,15 +885,30 @@ class EthImpl : public Eth, EthParams {
     return blk_num_str == "earliest" ? get_earliest_block() : jsToInt(blk_num_str);
   }
 
-  EthBlockNumber parse_blk_num(const string& blk_num_str) {
+  static bool is_pending_blk_num(const Json::Value& json) {
+    const auto& blk_num = json.isObject() ? json["blockNumber"] : json;
+    return blk_num.isString() && blk_num.asString() == "pending";
+  }
+
+  // Block tags are resolved to different blocks over time, earliest block changes with history pruning
+  static bool is_explicit_blk_num(const string& blk_num_str) {
+    return blk_num_str != "latest" && blk_num_str != "pending" && blk_num_str != "safe" &&
+           blk_num_str != "finalized" && blk_num_str != "earliest";
+  }
+
+  // latest is used instead of last block number if provided, so several requests can see the same state
+  EthBlockNumber parse_blk_num(const string& blk_num_str, optional<EthBlockNumber> latest = {}) {
     auto ret = parse_blk_num_specific(blk_num_str);
-    return ret ? *ret : final_chain->lastBlockNumber();
+    if (ret) {
+      return *ret;
+    }
+    return latest ? *latest : final_chain->lastBlockNumber();
   }
 
-  EthBlockNumber get_block_number_from_json(const Json::Value& json) {
+  EthBlockNumber get_block_number_from_json(const Json::Value& json, optional<EthBlockNumber> latest = {}) {
     if (json.isObject()) {
       if (!json["blockNumber"].empty()) {
-        return parse_blk_num(json["blockNumber"].asString());
+        return parse_blk_num(json["blockNumber"].asString(), latest);
       }
       if (!json["blockHash"].empty()) {
         if (auto ret = final_chain->blockNumber(jsToFixed<32>(json["blockHash"].asString()))) {
@@ -525,7 +917,15 @@ class EthImpl : public Eth, EthParams {
         throw std::runtime_error("Resource not found");
       }
     }
-    return parse_blk_num(json.asString());
+    return parse_blk_num(json.asString(), latest);
+  }
+
+  Json::Value getLogs(const LogFilter& filter) {
+    Json::Value res(Json::arrayValue);
+    filter.match_all(
+        *final_chain, [&res](const LocalisedLogEntry& lle) { res.append(toJson(lle)); }, logs_thread_pool_.get(),
+        logs_query_limits);
+    return res;
   }
 
   LogFilter parse_log_filter(const Json::Value& json) {
@@ -5,6 +5,7 @@
 #include "data.hpp"
 #include "final_chain/final_chain.hpp"
 #include "network/rpc/EthFace.h"
+#include "network/rpc/jsonrpc_serialized_methods.hpp"
 #include "watches.hpp"
 
 namespace taraxa::net::rpc::eth {
@@ -16,10 +17,19 @@ struct EthParams {
   std::shared_ptr<final_chain::FinalChain> final_chain;
   std::function<std::shared_ptr<Transaction>(const h256&)> get_trx;
   std::function<void(const std::shared_ptr<Transaction>& trx)> send_trx;
+  // Next nonce of the sender including its transactions in the pool, used for "pending" transactions count
+  std::function<std::optional<trx_nonce_t>(const Address&)> get_pending_nonce = [](const Address&) {
+    return std::nullopt;
+  };
   std::function<u256()> gas_pricer = [] { return u256(0); };
   std::function<uint64_t()> get_earliest_block = [] { return uint64_t(0); };
   std::function<std::optional<SyncStatus>()> syncing_probe = [] { return std::nullopt; };
   WatchesConfig watches_cfg;
+  // Number of threads scanning log ranges in parallel, 0 - logs queries are processed on the rpc thread
+  uint32_t logs_query_threads = 0;
+  LogsQueryLimits logs_query_limits;
+  // Number of threads running eth_estimateGas dry runs, 0 - estimations are processed on the rpc thread
+  uint32_t estimate_gas_threads = 0;
 };
 
 struct Eth : virtual ::taraxa::net::EthFace {
@@ -36,6 +46,8 @@ struct Eth : virtual ::taraxa::net::EthFace {
   virtual void note_block_executed(const final_chain::BlockHeader&, const SharedTransactions&,
                                    const TransactionReceipts&) = 0;
   virtual void note_pending_transaction(const h256& trx_hash) = 0;
+  // Registers fast path of hot methods that write their results directly into response
+  virtual void registerSerializedMethods(JsonRpcSerializedMethods& methods) = 0;
 };
 
 std::shared_ptr<Eth> NewEth(EthParams&&);
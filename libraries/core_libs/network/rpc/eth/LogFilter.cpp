@@ -2,6 +2,10 @@
 
 #include <jsonrpccpp/common/exception.h>
 
+#include <deque>
+#include <numeric>
+#include <set>
+
 #include "Eth.h"
 
 namespace taraxa::net::rpc::eth {
@@ -9,6 +13,12 @@ namespace taraxa::net::rpc::eth {
 LogFilter::LogFilter(EthBlockNumber from_block, std::optional<EthBlockNumber> to_block, AddressSet addresses,
                      LogFilter::Topics topics)
     : from_block_(from_block), to_block_(to_block), addresses_(std::move(addresses)), topics_(std::move(topics)) {
+  std::transform(addresses_.begin(), addresses_.end(), std::back_inserter(addresses_blooms_),
+                 [](const auto& a) { return LogBloom().shiftBloom<3>(sha3(a)); });
+  for (size_t i = 0; i < topics_.size(); ++i) {
+    std::transform(topics_[i].begin(), topics_[i].end(), std::back_inserter(topics_blooms_[i]),
+                   [](const auto& t) { return LogBloom().shiftBloom<3>(sha3(t)); });
+  }
   if (!addresses_.empty()) {
     return;
   }
@@ -56,27 +66,12 @@ std::vector<LogBloom> LogFilter::bloomPossibilities() const {
 }
 
 bool LogFilter::matches(LogBloom b) const {
-  if (!addresses_.empty()) {
-    if (std::none_of(addresses_.cbegin(), addresses_.cend(), [&b](const auto& i) {
-          if (b.containsBloom<3>(sha3(i))) {
-            return true;
-          }
-          return false;
-        })) {
-      return false;
-    }
+  const auto contained = [&b](const LogBloom& part) { return bloomContains(b, part); };
+  if (!addresses_blooms_.empty() && std::none_of(addresses_blooms_.cbegin(), addresses_blooms_.cend(), contained)) {
+    return false;
   }
-  for (const auto& t : topics_) {
-    if (t.empty()) {
-      continue;
-    }
-
-    if (std::none_of(t.cbegin(), t.cend(), [&b](const auto& i) {
-          if (b.containsBloom<3>(sha3(i))) {
-            return true;
-          }
-          return false;
-        })) {
+  for (const auto& t : topics_blooms_) {
+    if (!t.empty() && std::none_of(t.cbegin(), t.cend(), contained)) {
       return false;
     }
   }
@@ -88,23 +83,24 @@ void LogFilter::match_one(const TransactionReceipt& r, const std::function<void(
     return;
   }
   for (size_t log_i = 0; log_i < r.logs.size(); ++log_i) {
-    const auto& e = r.logs[log_i];
-    if (!addresses_.empty() && !addresses_.count(e.address)) {
-      continue;
-    }
-    auto ok = true;
-    for (size_t i = 0; i < topics_.size(); ++i) {
-      if (!topics_[i].empty() && (e.topics.size() < i || !topics_[i].count(e.topics[i]))) {
-        ok = false;
-        break;
-      }
-    }
-    if (ok) {
+    if (matches(r.logs[log_i])) {
       cb(log_i);
     }
   }
 }
 
+bool LogFilter::matches(const LogEntry& e) const {
+  if (!addresses_.empty() && !addresses_.count(e.address)) {
+    return false;
+  }
+  for (size_t i = 0; i < topics_.size(); ++i) {
+    if (!topics_[i].empty() && (e.topics.size() <= i || !topics_[i].count(e.topics[i]))) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool LogFilter::blk_number_matches(EthBlockNumber blk_n) const {
   return from_block_ <= blk_n && (!to_block_ || blk_n <= *to_block_);
 }
@@ -124,25 +120,38 @@ void LogFilter::match_one(const ExtendedTransactionLocation& trx_loc, const Tran
   }
 }
 
-std::vector<LocalisedLogEntry> LogFilter::match_all(const final_chain::FinalChain& final_chain) const {
+std::vector<LocalisedLogEntry> LogFilter::match_range(const final_chain::FinalChain& final_chain,
+                                                     const std::vector<LogBloom>& blooms, EthBlockNumber from,
+                                                     EthBlockNumber to) const {
+  std::vector<EthBlockNumber> blocks;
+  if (is_range_only_) {
+    blocks.resize(to - from + 1);
+    std::iota(blocks.begin(), blocks.end(), from);
+  } else {
+    // All alternatives are matched in a single pass, so each blooms chunk is loaded once
+    blocks = final_chain.withBlockBloom(blooms, from, to);
+  }
+
   std::vector<LocalisedLogEntry> ret;
-  auto action = [&, this](EthBlockNumber blk_n) {
+  // Candidate blocks receipts are read with a single batched lookup
+  const auto receipts = final_chain.blocksReceipts(blocks);
+  for (size_t blk_i = 0; blk_i < blocks.size(); ++blk_i) {
+    const auto blk_n = blocks[blk_i];
     ExtendedTransactionLocation trx_loc{{{blk_n}, *final_chain.blockHash(blk_n)}};
-    auto block_receipts = final_chain.blockReceipts(blk_n);
+    const auto& block_receipts = receipts[blk_i];
     if (block_receipts && block_receipts->size()) {
-      std::vector<std::pair<uint64_t, LocalisedLogEntry>> ret_block;
+      std::shared_ptr<const TransactionHashes> hashes;
       for (uint32_t i = 0; i < block_receipts->size(); i++) {
-        match_one(trx_loc, (*block_receipts)[i], [&](const auto& lle) { ret_block.push_back({i, lle}); });
-        ++trx_loc.position;
-      }
-      if (ret_block.size() > 0) {
-        for (auto& r : ret_block) {
-          auto transaction = final_chain.transaction(trx_loc.period, r.first);
-          if (transaction) {
-            r.second.trx_loc.trx_hash = transaction->getHash();
-            ret.push_back(r.second);
+        match_one(trx_loc, (*block_receipts)[i], [&](const auto& lle) {
+          if (!hashes) {
+            hashes = final_chain.transactionHashes(blk_n);
           }
-        }
+          if (hashes && i < hashes->size()) {
+            ret.push_back(lle);
+            ret.back().trx_loc.trx_hash = (*hashes)[i];
+          }
+        });
+        ++trx_loc.position;
       }
     } else {
       auto hashes = final_chain.transactionHashes(trx_loc.period);
@@ -153,30 +162,158 @@ std::vector<LocalisedLogEntry> LogFilter::match_all(const final_chain::FinalChai
         ++trx_loc.position;
       }
     }
-  };
+  }
+  return ret;
+}
+
+std::vector<LocalisedLogEntry> LogFilter::match_indexed(const final_chain::FinalChain& final_chain,
+                                                       EthBlockNumber from, EthBlockNumber to) const {
+  std::set<std::pair<EthBlockNumber, uint32_t>> locations;
+  for (const auto& address : addresses_) {
+    if (topics_[0].empty()) {
+      for (const auto& loc : final_chain.withLogsIndex(address, std::nullopt, from, to)) {
+        locations.insert(loc);
+      }
+      continue;
+    }
+    for (const auto& topic : topics_[0]) {
+      for (const auto& loc : final_chain.withLogsIndex(address, topic, from, to)) {
+        locations.insert(loc);
+      }
+    }
+  }
+
+  std::vector<EthBlockNumber> blocks;
+  for (const auto& [blk_n, _] : locations) {
+    if (blocks.empty() || blocks.back() != blk_n) {
+      blocks.push_back(blk_n);
+    }
+  }
+  const auto receipts = final_chain.blocksReceipts(blocks);
+
+  std::vector<LocalisedLogEntry> ret;
+  auto loc_it = locations.begin();
+  for (size_t blk_i = 0; blk_i < blocks.size(); ++blk_i) {
+    const auto blk_n = blocks[blk_i];
+    const auto& block_receipts = receipts[blk_i];
+    const auto hashes = final_chain.transactionHashes(blk_n);
+    ExtendedTransactionLocation trx_loc{{{blk_n}, *final_chain.blockHash(blk_n)}};
+    for (; loc_it != locations.end() && loc_it->first == blk_n; ++loc_it) {
+      const auto position = loc_it->second;
+      if (!block_receipts || !hashes || position >= block_receipts->size() || position >= hashes->size()) {
+        continue;
+      }
+      trx_loc.position = position;
+      trx_loc.trx_hash = (*hashes)[position];
+      match_one(trx_loc, (*block_receipts)[position], [&](const auto& lle) { ret.push_back(lle); });
+    }
+  }
+  return ret;
+}
+
+std::vector<LocalisedLogEntry> LogFilter::match_all(const final_chain::FinalChain& final_chain) const {
+  std::vector<LocalisedLogEntry> ret;
+  match_all(final_chain, [&ret](const LocalisedLogEntry& lle) { ret.push_back(lle); });
+  return ret;
+}
+
+void LogFilter::match_all(const final_chain::FinalChain& final_chain, const OnLog& cb, util::ThreadPool* pool,
+                          const LogsQueryLimits& limits) const {
   // to_block can't be greater than the last executed block number
   const auto last_block_number = final_chain.lastBlockNumber();
   auto to_blk_n = to_block_ ? *to_block_ : last_block_number;
   if (to_blk_n > last_block_number) {
     to_blk_n = last_block_number;
   }
+  if (from_block_ > to_blk_n) {
+    return;
+  }
+  if (limits.max_block_range && to_blk_n - from_block_ >= limits.max_block_range) {
+    BOOST_THROW_EXCEPTION(
+        jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_RPC_INVALID_PARAMS,
+                                  "block range is over the limit of " + std::to_string(limits.max_block_range)));
+  }
 
-  if (is_range_only_) {
-    for (auto blk_n = from_block_; blk_n <= to_blk_n; ++blk_n) {
-      action(blk_n);
-    }
-    return ret;
+  // Part of the range covered by logs index is looked up directly, blooms are used only for blocks before it
+  std::optional<EthBlockNumber> indexed_from;
+  if (const auto logs_index_from = final_chain.logsIndexFrom();
+      !addresses_.empty() && logs_index_from && *logs_index_from <= to_blk_n) {
+    indexed_from = std::max(*logs_index_from, from_block_);
   }
-  std::set<EthBlockNumber> matchingBlocks;
-  for (const auto& bloom : bloomPossibilities()) {
-    for (auto blk_n : final_chain.withBlockBloom(bloom, from_block_, to_blk_n)) {
-      matchingBlocks.insert(blk_n);
+  const auto scan_to = indexed_from ? *indexed_from - 1 : to_blk_n;
+  const bool has_scan_range = !indexed_from || *indexed_from > from_block_;
+
+  const auto blooms = is_range_only_ ? std::vector<LogBloom>{} : bloomPossibilities();
+  // Chunks are aligned with top level of blooms index, so each chunk reads only its own part of it
+  constexpr EthBlockNumber kChunkSize = final_chain::c_bloomIndexSize * final_chain::c_bloomIndexSize;
+  static_assert(final_chain::c_bloomIndexLevels == 2);
+  uint64_t results_count = 0;
+  auto consume = [&](std::vector<LocalisedLogEntry>&& logs) {
+    results_count += logs.size();
+    if (limits.max_results && results_count > limits.max_results) {
+      BOOST_THROW_EXCEPTION(
+          jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_RPC_INVALID_PARAMS,
+                                    "query returned more than " + std::to_string(limits.max_results) + " results"));
+    }
+    for (const auto& lle : logs) {
+      cb(lle);
+    }
+  };
+
+  auto chunk_begin = from_block_;
+  auto next_chunk = [&]() {
+    const auto begin = chunk_begin;
+    const auto end = std::min(scan_to, (begin / kChunkSize + 1) * kChunkSize - 1);
+    chunk_begin = end + 1;
+    return std::make_pair(begin, end);
+  };
+
+  if (!pool) {
+    while (has_scan_range && chunk_begin <= scan_to) {
+      const auto [begin, end] = next_chunk();
+      consume(match_range(final_chain, blooms, begin, end));
+    }
+    if (indexed_from) {
+      consume(match_indexed(final_chain, *indexed_from, to_blk_n));
     }
+    return;
   }
-  for (auto blk_n : matchingBlocks) {
-    action(blk_n);
+
+  // Keep limited number of chunks in flight, so results are streamed to cb and limits are checked before the whole
+  // range is scanned
+  using ChunkResult = std::pair<std::shared_ptr<std::vector<LocalisedLogEntry>>, std::future<void>>;
+  std::deque<ChunkResult> in_flight;
+  const auto max_in_flight = pool->capacity() * 2;
+  auto schedule = [&]() {
+    while (has_scan_range && in_flight.size() < max_in_flight && chunk_begin <= scan_to) {
+      const auto [begin, end] = next_chunk();
+      auto result = std::make_shared<std::vector<LocalisedLogEntry>>();
+      auto future = pool->post([this, &final_chain, &blooms, result, begin, end]() {
+        *result = match_range(final_chain, blooms, begin, end);
+      });
+      in_flight.emplace_back(std::move(result), std::move(future));
+    }
+  };
+
+  try {
+    schedule();
+    while (!in_flight.empty()) {
+      auto [result, future] = std::move(in_flight.front());
+      in_flight.pop_front();
+      future.get();
+      consume(std::move(*result));
+      schedule();
+    }
+    if (indexed_from) {
+      consume(match_indexed(final_chain, *indexed_from, to_blk_n));
+    }
+  } catch (...) {
+    // Tasks reference local state, wait for them before propagating the error
+    for (auto& chunk : in_flight) {
+      chunk.second.wait();
+    }
+    throw;
   }
-  return ret;
 }
 
 AddressSet parse_addresses(const Json::Value& json) {
@@ -1,18 +1,30 @@
 #pragma once
 
+#include "common/thread_pool.hpp"
 #include "data.hpp"
 #include "final_chain/final_chain.hpp"
 
 namespace taraxa::net::rpc::eth {
 
+struct LogsQueryLimits {
+  // Maximal number of blocks in the queried range, 0 means unlimited
+  uint64_t max_block_range = 0;
+  // Maximal number of logs returned by a single query, 0 means unlimited
+  uint64_t max_results = 0;
+};
+
 struct LogFilter {
   using Topics = std::array<std::unordered_set<h256>, 4>;
+  using OnLog = std::function<void(const LocalisedLogEntry&)>;
 
  private:
   EthBlockNumber from_block_;
   std::optional<EthBlockNumber> to_block_;
   AddressSet addresses_;
   Topics topics_;
+  // Bloom bits of each address and topic, so receipts blooms are matched without hashing them again
+  std::vector<LogBloom> addresses_blooms_;
+  std::array<std::vector<LogBloom>, 4> topics_blooms_;
   bool is_range_only_ = false;
 
  public:
@@ -20,11 +32,34 @@ struct LogFilter {
             LogFilter::Topics topics);
   std::vector<LogBloom> bloomPossibilities() const;
   bool matches(LogBloom b) const;
+  // Exact address and topics check of a single log
+  bool matches(const LogEntry& e) const;
+  const AddressSet& addresses() const { return addresses_; }
+  const Topics& topics() const { return topics_; }
   void match_one(const TransactionReceipt& r, const std::function<void(size_t)>& cb) const;
   bool blk_number_matches(EthBlockNumber blk_n) const;
   void match_one(const ExtendedTransactionLocation& trx_loc, const TransactionReceipt& r,
                  const std::function<void(const LocalisedLogEntry&)>& cb) const;
   std::vector<LocalisedLogEntry> match_all(const final_chain::FinalChain& final_chain) const;
+
+  /**
+   * @brief Finds all logs matching the filter. Range is split into chunks of top level bloom index size, chunks are
+   *        scanned on pool (or on the calling thread if pool is nullptr) and matched logs are passed to cb in blocks
+   *        order as soon as all preceding chunks are processed
+   * @param final_chain final chain
+   * @param cb callback called for each matching log
+   * @param pool thread pool used to scan chunks in parallel
+   * @param limits query limits, JsonRpcException is thrown if they are exceeded
+   */
+  void match_all(const final_chain::FinalChain& final_chain, const OnLog& cb, util::ThreadPool* pool = nullptr,
+                 const LogsQueryLimits& limits = {}) const;
+
+ private:
+  std::vector<LocalisedLogEntry> match_range(const final_chain::FinalChain& final_chain,
+                                             const std::vector<LogBloom>& blooms, EthBlockNumber from,
+                                             EthBlockNumber to) const;
+  std::vector<LocalisedLogEntry> match_indexed(const final_chain::FinalChain& final_chain, EthBlockNumber from,
+                                               EthBlockNumber to) const;
 };
 
 AddressSet parse_addresses(const Json::Value& json);
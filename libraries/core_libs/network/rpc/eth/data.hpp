@@ -1,6 +1,9 @@
 #pragma once
 
+#include <functional>
+
 #include "final_chain/data.hpp"
+#include "network/rpc/json_writer.hpp"
 
 namespace taraxa::net::rpc::eth {
 
@@ -60,6 +63,12 @@ Json::Value toJson(const LocalisedLogEntry& lle);
 Json::Value toJson(const LocalisedTransactionReceipt& ltr);
 Json::Value toJson(const SyncStatus& obj);
 
+// Streaming counterparts of toJson for the hot rpc responses, output is the same as stringified toJson result
+void write(JsonWriter& w, const final_chain::BlockHeader& obj, const std::function<void()>& write_transactions = {});
+void write(JsonWriter& w, const Transaction& trx, const std::optional<TransactionLocationWithBlockHash>& loc);
+void write(JsonWriter& w, const LocalisedLogEntry& lle);
+void write(JsonWriter& w, const LocalisedTransactionReceipt& ltr);
+
 template <typename T>
 Json::Value toJson(const T& t) {
   return toJS(t);
@@ -38,6 +38,78 @@ Watches::Watches(WatchesConfig const& _cfg)
         }
       }) {}
 
+void LogWatchesIndex::add(WatchID watch_id, const LogFilter& filter) {
+  std::unique_lock l(mu_);
+  if (filter.addresses().empty()) {
+    any_address_.insert(watch_id);
+  } else {
+    for (const auto& address : filter.addresses()) {
+      by_address_[address].insert(watch_id);
+    }
+  }
+  filters_.insert_or_assign(watch_id, filter);
+}
+
+void LogWatchesIndex::remove(WatchID watch_id) {
+  std::unique_lock l(mu_);
+  auto filter = filters_.find(watch_id);
+  if (filter == filters_.end()) {
+    return;
+  }
+  any_address_.erase(watch_id);
+  for (const auto& address : filter->second.addresses()) {
+    if (auto watches = by_address_.find(address); watches != by_address_.end()) {
+      watches->second.erase(watch_id);
+      if (watches->second.empty()) {
+        by_address_.erase(watches);
+      }
+    }
+  }
+  filters_.erase(filter);
+}
+
+std::vector<std::pair<WatchID, LocalisedLogEntry>> LogWatchesIndex::match(const ExtendedTransactionLocation& trx_loc,
+                                                                          const TransactionReceipt& receipt) const {
+  std::vector<std::pair<WatchID, LocalisedLogEntry>> ret;
+  std::shared_lock l(mu_);
+  if (filters_.empty()) {
+    return ret;
+  }
+  const auto match_log = [&](WatchID watch_id, size_t log_i) {
+    const auto& filter = filters_.at(watch_id);
+    if (filter.blk_number_matches(trx_loc.period) && filter.matches(receipt.logs[log_i])) {
+      ret.emplace_back(watch_id, LocalisedLogEntry{receipt.logs[log_i], trx_loc, log_i});
+    }
+  };
+  for (size_t log_i = 0; log_i < receipt.logs.size(); ++log_i) {
+    if (auto watches = by_address_.find(receipt.logs[log_i].address); watches != by_address_.end()) {
+      for (auto watch_id : watches->second) {
+        match_log(watch_id, log_i);
+      }
+    }
+    for (auto watch_id : any_address_) {
+      match_log(watch_id, log_i);
+    }
+  }
+  return ret;
+}
+
+WatchID Watches::install_logs_watch(LogFilter&& filter) {
+  const auto watch_id = logs_.install_watch(LogFilter(filter));
+  logs_index_.add(watch_id, filter);
+  return watch_id;
+}
+
+void Watches::process_logs(const ExtendedTransactionLocation& trx_loc, const TransactionReceipt& receipt) {
+  // Updates are pushed after the index lock is released, watches uninstalling takes locks in the opposite order
+  for (const auto& [watch_id, log] : logs_index_.match(trx_loc, receipt)) {
+    if (!logs_.push_update(watch_id, log)) {
+      // Watch was uninstalled concurrently with its installation
+      logs_index_.remove(watch_id);
+    }
+  }
+}
+
 Watches::~Watches() {
   destructor_called_ = true;
   watch_cleaner_wait_cv_.notify_all();
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <queue>
+#include <shared_mutex>
+#include <unordered_set>
 
 #include "LogFilter.hpp"
+#include "common/default_construct_copyable_movable.hpp"
 #include "common/global_const.hpp"
 #include "data.hpp"
 
@@ -45,6 +50,8 @@ class WatchGroup {
   using Updater = std::function<void(Params const&,     //
                                      InputType const&,  //
                                      std::function<void(OutputType const&)> const& /*do_update*/)>;
+  // Called for every uninstalled watch, after the watch is already removed from the group
+  using OnUninstall = std::function<void(WatchID, Params const&)>;
 
   struct Watch {
     Params params;
@@ -54,15 +61,25 @@ class WatchGroup {
   };
 
  private:
+  // Watches are sharded by id, so installing, polling and uninstalling watches do not contend on a single mutex
+  static constexpr size_t kShardsCount = 16;
+  struct Shard {
+    std::unordered_map<WatchID, Watch> watches;
+    std::shared_mutex mu;
+  };
+
   WatchGroupConfig cfg_;
   Updater updater_;
-  mutable std::unordered_map<WatchID, Watch> watches_;
-  mutable std::shared_mutex watches_mu_;
-  mutable WatchID watch_id_seq_ = 0;
+  OnUninstall on_uninstall_;
+  mutable std::array<Shard, kShardsCount> shards_;
+  mutable std::atomic<size_t> watches_count_ = 0;
+  mutable std::atomic<WatchID> watch_id_seq_ = 0;
+
+  Shard& shard(WatchID watch_id) const { return shards_[(watch_id >> watch_id_type_mask_bits()) % kShardsCount]; }
 
  public:
-  explicit WatchGroup(WatchesConfig const& cfg = {}, Updater&& updater = {})
-      : cfg_(cfg[type]), updater_(std::move(updater)) {
+  explicit WatchGroup(WatchesConfig const& cfg = {}, Updater&& updater = {}, OnUninstall&& on_uninstall = {})
+      : cfg_(cfg[type]), updater_(std::move(updater)), on_uninstall_(std::move(on_uninstall)) {
     assert(cfg_.idle_timeout.count() != 0);
     if constexpr (std::is_same_v<InputType, OutputType>) {
       if (!updater_) {
@@ -74,62 +91,106 @@ class WatchGroup {
   }
 
   WatchID install_watch(Params&& params = {}) const {
-    std::unique_lock l(watches_mu_);
-    if (cfg_.max_watches && watches_.size() == cfg_.max_watches) {
+    if (auto count = watches_count_.fetch_add(1); cfg_.max_watches && count >= cfg_.max_watches) {
+      watches_count_.fetch_sub(1);
       throw WatchLimitExceeded();
     }
     auto id = ((++watch_id_seq_) << watch_id_type_mask_bits()) + type;
-    watches_.insert_or_assign(id, Watch{std::move(params), std::chrono::high_resolution_clock::now()});
+    auto& s = shard(id);
+    std::unique_lock l(s.mu);
+    s.watches.insert_or_assign(id, Watch{std::move(params), std::chrono::high_resolution_clock::now()});
     return id;
   }
 
   bool uninstall_watch(WatchID watch_id) const {
-    std::unique_lock l(watches_mu_);
-    return watches_.erase(watch_id);
+    auto& s = shard(watch_id);
+    std::unique_lock l(s.mu);
+    auto entry = s.watches.find(watch_id);
+    if (entry == s.watches.end()) {
+      return false;
+    }
+    auto params = std::move(entry->second.params);
+    s.watches.erase(entry);
+    watches_count_.fetch_sub(1);
+    l.unlock();
+    if (on_uninstall_) {
+      on_uninstall_(watch_id, params);
+    }
+    return true;
   }
 
   void uninstall_stale_watches() const {
-    std::unique_lock l(watches_mu_);
-    bool did_uninstall = false;
-    for (auto it = watches_.begin(); it != watches_.end();) {
-      if (cfg_.idle_timeout <=
-          duration_cast<std::chrono::seconds>(std::chrono::high_resolution_clock::now() - it->second.last_touched)) {
-        it = watches_.erase(it);
-        did_uninstall = true;
-      } else {
-        it++;
+    for (auto& s : shards_) {
+      std::vector<std::pair<WatchID, Params>> uninstalled;
+      {
+        std::unique_lock l(s.mu);
+        const auto now = std::chrono::high_resolution_clock::now();
+        for (auto it = s.watches.begin(); it != s.watches.end();) {
+          if (cfg_.idle_timeout <= duration_cast<std::chrono::seconds>(now - it->second.last_touched)) {
+            uninstalled.emplace_back(it->first, std::move(it->second.params));
+            it = s.watches.erase(it);
+          } else {
+            it++;
+          }
+        }
+        if (auto num_buckets = s.watches.bucket_count(); !uninstalled.empty() && (1 << 10) < num_buckets) {
+          if (size_t desired_num_buckets = 1 << uint(ceil(log2(s.watches.size())));
+              desired_num_buckets != num_buckets) {
+            s.watches.rehash(desired_num_buckets);
+          }
+        }
       }
-    }
-    if (auto num_buckets = watches_.bucket_count(); did_uninstall && (1 << 10) < num_buckets) {
-      if (size_t desired_num_buckets = 1 << uint(ceil(log2(watches_.size()))); desired_num_buckets != num_buckets) {
-        watches_.rehash(desired_num_buckets);
+      watches_count_.fetch_sub(uninstalled.size());
+      if (on_uninstall_) {
+        for (const auto& [watch_id, params] : uninstalled) {
+          on_uninstall_(watch_id, params);
+        }
       }
     }
   }
 
   std::optional<Params> get_watch_params(WatchID watch_id) const {
-    std::shared_lock l(watches_mu_);
-    if (auto entry = watches_.find(watch_id); entry != watches_.end()) {
+    auto& s = shard(watch_id);
+    std::shared_lock l(s.mu);
+    if (auto entry = s.watches.find(watch_id); entry != s.watches.end()) {
       return entry->second.params;
     }
     return {};
   }
 
   void process_update(InputType const& obj_in) const {
-    std::shared_lock l(watches_mu_);
-    for (auto& entry : watches_) {
-      auto& watch = entry.second;
-      updater_(watch.params, obj_in, [&](auto const& obj_out) {
-        std::unique_lock l(watch.mu.val);
-        watch.updates.push_back(obj_out);
-      });
+    for (auto& s : shards_) {
+      std::shared_lock l(s.mu);
+      for (auto& entry : s.watches) {
+        auto& watch = entry.second;
+        updater_(watch.params, obj_in, [&](auto const& obj_out) {
+          std::unique_lock l(watch.mu.val);
+          watch.updates.push_back(obj_out);
+        });
+      }
     }
   }
 
+  /**
+   * @brief Adds update to a single watch, used when interested watches are already known
+   * @return false if watch is not installed
+   */
+  bool push_update(WatchID watch_id, OutputType const& obj_out) const {
+    auto& s = shard(watch_id);
+    std::shared_lock l(s.mu);
+    if (auto entry = s.watches.find(watch_id); entry != s.watches.end()) {
+      std::unique_lock l1(entry->second.mu.val);
+      entry->second.updates.push_back(obj_out);
+      return true;
+    }
+    return false;
+  }
+
   auto poll(WatchID watch_id) const {
     std::vector<OutputType> ret;
-    std::shared_lock l(watches_mu_);
-    if (auto entry = watches_.find(watch_id); entry != watches_.end()) {
+    auto& s = shard(watch_id);
+    std::shared_lock l(s.mu);
+    if (auto entry = s.watches.find(watch_id); entry != s.watches.end()) {
       auto& watch = entry->second;
       std::unique_lock l1(watch.mu.val);
       swap(ret, watch.updates);
@@ -139,22 +200,56 @@ class WatchGroup {
   }
 };
 
+/**
+ * @brief Installed log filters indexed by address, so each log of a receipt is matched only against filters that can
+ * be interested in it instead of evaluating every installed filter
+ */
+class LogWatchesIndex {
+ public:
+  void add(WatchID watch_id, const LogFilter& filter);
+  void remove(WatchID watch_id);
+
+  /**
+   * @brief Matches all logs of the receipt once against interested filters
+   * @return pairs of watch id and matched log
+   */
+  std::vector<std::pair<WatchID, LocalisedLogEntry>> match(const ExtendedTransactionLocation& trx_loc,
+                                                           const TransactionReceipt& receipt) const;
+
+ private:
+  mutable std::shared_mutex mu_;
+  std::unordered_map<WatchID, LogFilter> filters_;
+  std::unordered_map<Address, std::unordered_set<WatchID>> by_address_;
+  // Filters without addresses, they are checked for every log
+  std::unordered_set<WatchID> any_address_;
+};
+
 class Watches {
  public:
   WatchesConfig const cfg_;
 
+ private:
+  LogWatchesIndex logs_index_;
+
+ public:
   WatchGroup<WatchType::new_blocks, h256> const new_blocks_{cfg_};
   WatchGroup<WatchType::new_transactions, h256> const new_transactions_{cfg_};
-  WatchGroup<WatchType::logs,  //
-             std::pair<ExtendedTransactionLocation const&, TransactionReceipt const&>, LocalisedLogEntry,
-             LogFilter> const logs_{
+  WatchGroup<WatchType::logs, LocalisedLogEntry, LocalisedLogEntry, LogFilter> const logs_{
       cfg_,
-      [](auto const& log_filter, auto const& input, auto const& do_update) {
-        auto const& [trx_loc, receipt] = input;
-        log_filter.match_one(trx_loc, receipt, do_update);
-      },
+      {},
+      [this](WatchID watch_id, auto const&) { logs_index_.remove(watch_id); },
   };
 
+  /**
+   * @brief Installs logs watch and adds its filter to the shared index
+   */
+  WatchID install_logs_watch(LogFilter&& filter);
+
+  /**
+   * @brief Matches receipt logs against all installed logs watches at once and adds updates to interested watches
+   */
+  void process_logs(const ExtendedTransactionLocation& trx_loc, const TransactionReceipt& receipt);
+
   template <typename Visitor>
   auto visit(WatchType type, Visitor&& visitor) {
     switch (type) {
@@ -0,0 +1,173 @@
+#include "network/rpc/json_writer.hpp"
+
+#include <charconv>
+#include <limits>
+
+namespace taraxa::net {
+
+namespace {
+constexpr char kHexChars[] = "0123456789abcdef";
+}
+
+void JsonWriter::separate() {
+  if (after_key_) {
+    after_key_ = false;
+    return;
+  }
+  if (!has_elements_.empty()) {
+    if (has_elements_.back()) {
+      out_ += ',';
+    }
+    has_elements_.back() = true;
+  }
+}
+
+JsonWriter& JsonWriter::beginObject() {
+  separate();
+  out_ += '{';
+  has_elements_.push_back(false);
+  return *this;
+}
+
+JsonWriter& JsonWriter::endObject() {
+  out_ += '}';
+  has_elements_.pop_back();
+  return *this;
+}
+
+JsonWriter& JsonWriter::beginArray() {
+  separate();
+  out_ += '[';
+  has_elements_.push_back(false);
+  return *this;
+}
+
+JsonWriter& JsonWriter::endArray() {
+  out_ += ']';
+  has_elements_.pop_back();
+  return *this;
+}
+
+JsonWriter& JsonWriter::key(std::string_view name) {
+  // Keys are always plain identifiers, no escaping needed
+  separate();
+  out_ += '"';
+  out_ += name;
+  out_ += "\":";
+  after_key_ = true;
+  return *this;
+}
+
+JsonWriter& JsonWriter::null() {
+  separate();
+  out_ += "null";
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(bool value) {
+  separate();
+  out_ += value ? "true" : "false";
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(std::string_view value) {
+  separate();
+  out_ += '"';
+  for (const char c : value) {
+    switch (c) {
+      case '"':
+        out_ += "\\\"";
+        break;
+      case '\\':
+        out_ += "\\\\";
+        break;
+      case '\n':
+        out_ += "\\n";
+        break;
+      case '\r':
+        out_ += "\\r";
+        break;
+      case '\t':
+        out_ += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out_ += "\\u00";
+          out_ += kHexChars[(c >> 4) & 0xf];
+          out_ += kHexChars[c & 0xf];
+        } else {
+          out_ += c;
+        }
+    }
+  }
+  out_ += '"';
+  return *this;
+}
+
+JsonWriter& JsonWriter::raw(std::string_view json) {
+  separate();
+  out_ += json;
+  return *this;
+}
+
+JsonWriter& JsonWriter::rawChunk(std::string_view chunk) {
+  out_ += chunk;
+  return *this;
+}
+
+JsonWriter& JsonWriter::hex(uint64_t value) {
+  separate();
+  char buffer[16];
+  const auto result = std::to_chars(std::begin(buffer), std::end(buffer), value, 16);
+  out_ += "\"0x";
+  out_.append(buffer, result.ptr);
+  out_ += '"';
+  return *this;
+}
+
+JsonWriter& JsonWriter::hex(const u256& value) {
+  if (value <= std::numeric_limits<uint64_t>::max()) {
+    return hex(static_cast<uint64_t>(value));
+  }
+
+  separate();
+  out_ += "\"0x";
+  bool leading = true;
+  for (int shift = 252; shift >= 0; shift -= 4) {
+    const auto nibble = static_cast<unsigned>((value >> shift) & 0xf);
+    if (leading && !nibble) {
+      continue;
+    }
+    leading = false;
+    out_ += kHexChars[nibble];
+  }
+  out_ += '"';
+  return *this;
+}
+
+JsonWriter& JsonWriter::hexByte(uint8_t value) {
+  separate();
+  out_ += "\"0x";
+  out_ += std::to_string(value);
+  out_ += '"';
+  return *this;
+}
+
+JsonWriter& JsonWriter::hex(const bytes& value) {
+  separate();
+  appendHexData(value.data(), value.size());
+  return *this;
+}
+
+void JsonWriter::appendHexData(const uint8_t* data, size_t size) {
+  const auto start = out_.size();
+  out_.resize(start + size * 2 + 4);
+  auto* it = out_.data() + start;
+  *it++ = '"';
+  *it++ = '0';
+  *it++ = 'x';
+  dev::hexEncode(data, size, it);
+  it[size * 2] = '"';
+}
+
+}  // namespace taraxa::net
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <libdevcore/FixedHash.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/types.hpp"
+
+namespace taraxa::net {
+
+/**
+ * @brief Streaming json writer, values are appended directly into string buffer without building Json::Value tree
+ *
+ * Values are formatted the same way as dev::toJS formats them, so output of writer can replace Json::Value based
+ * serialization of rpc responses. Keys are written in the order they are provided, callers keep them sorted to match
+ * jsoncpp output.
+ */
+class JsonWriter {
+ public:
+  explicit JsonWriter(std::string& out) : out_(out) {}
+
+  JsonWriter& beginObject();
+  JsonWriter& endObject();
+  JsonWriter& beginArray();
+  JsonWriter& endArray();
+  JsonWriter& key(std::string_view name);
+
+  JsonWriter& null();
+  JsonWriter& value(bool value);
+  // Escaped string, non-ascii characters are written as they are
+  JsonWriter& value(std::string_view value);
+  JsonWriter& value(const char* value) { return this->value(std::string_view(value)); }
+  // Already serialized json value
+  JsonWriter& raw(std::string_view json);
+  // Continuation of raw value which is written in several chunks, appended without separator
+  JsonWriter& rawChunk(std::string_view chunk);
+
+  // Compact hex numbers, e.g. 0x0, 0x1a
+  JsonWriter& hex(uint64_t value);
+  JsonWriter& hex(const u256& value);
+  // Same as dev::toJS(byte), which prints decimal digits with 0x prefix
+  JsonWriter& hexByte(uint8_t value);
+  // Full length hex data, e.g. 0x, 0x00ab
+  JsonWriter& hex(const bytes& value);
+  template <unsigned N>
+  JsonWriter& hex(const dev::FixedHash<N>& value) {
+    separate();
+    appendHexData(value.data(), N);
+    return *this;
+  }
+  template <typename T>
+  JsonWriter& hex(const std::optional<T>& value) {
+    return value ? hex(*value) : null();
+  }
+
+ private:
+  void separate();
+  void appendHexData(const uint8_t* data, size_t size);
+
+  std::string& out_;
+  // Flag per each opened object/array if it already contains some element
+  std::vector<bool> has_elements_;
+  bool after_key_ = false;
+};
+
+}  // namespace taraxa::net
@@ -0,0 +1,110 @@
+#include "network/rpc/jsonrpc_dispatcher.hpp"
+
+#include <chrono>
+#include <vector>
+
+#include "common/jsoncpp.hpp"
+
+namespace taraxa::net {
+
+// Methods which read ranges of blocks or execute evm, used when config doesn't list expensive methods
+const std::vector<std::string> kDefaultExpensiveMethods = {
+    "eth_call",
+    "eth_estimateGas",
+    "eth_getLogs",
+    "eth_getFilterLogs",
+    "eth_getBlockReceipts",
+    "debug_traceTransaction",
+    "debug_traceCall",
+    "debug_getPeriodTransactionsWithReceipts",
+    "debug_getPeriodDagBlocks",
+    "trace_call",
+    "trace_replayTransaction",
+    "trace_replayBlockTransactions",
+    "taraxa_exportBlocks",
+};
+
+JsonRpcDispatcher::JsonRpcDispatcher(const JsonRpcDispatchConfig& config,
+                                     std::shared_ptr<metrics::JsonRpcMetrics> metrics)
+    : kMaxPending(config.max_pending), metrics_(std::move(metrics)), thread_pool_(config.threads) {
+  if (config.expensive_methods.empty()) {
+    for (const auto& method : kDefaultExpensiveMethods) {
+      methods_[method];
+    }
+  }
+  for (const auto& [method, limit] : config.expensive_methods) {
+    methods_[method].limit = limit;
+  }
+}
+
+std::optional<std::string> JsonRpcDispatcher::classify(std::string_view request) const {
+  const auto first_char = request.find_first_not_of(" \t\r\n");
+  if (first_char == std::string_view::npos || request[first_char] != '{') {
+    return {};
+  }
+
+  constexpr std::string_view method_key = "\"method\"";
+  auto pos = request.find(method_key);
+  if (pos == std::string_view::npos) {
+    return {};
+  }
+  pos = request.find_first_not_of(" \t\r\n:", pos + method_key.size());
+  if (pos == std::string_view::npos || request[pos] != '"') {
+    return {};
+  }
+  const auto end = request.find('"', ++pos);
+  if (end == std::string_view::npos) {
+    return {};
+  }
+  std::string method(request.substr(pos, end - pos));
+  if (!methods_.contains(method)) {
+    return {};
+  }
+  return method;
+}
+
+bool JsonRpcDispatcher::post(const std::string& method, std::function<void()> task) {
+  auto& state = methods_.at(method);
+  if ((kMaxPending && pending_ >= kMaxPending) || (state.limit && state.in_flight >= state.limit)) {
+    ++rejected_;
+    return false;
+  }
+
+  ++state.in_flight;
+  ++pending_;
+  thread_pool_.post([this, &state, method, task = std::move(task), queued_at = std::chrono::steady_clock::now()] {
+    --pending_;
+    ++running_;
+    if (metrics_) {
+      const auto queue_time = std::chrono::steady_clock::now() - queued_at;
+      metrics_->setDispatchQueueTime(std::chrono::duration_cast<std::chrono::microseconds>(queue_time).count(),
+                                     {{"method", method}});
+    }
+    try {
+      task();
+    } catch (...) {
+      // Tasks report their errors in responses, nothing should get here
+    }
+    --state.in_flight;
+    --running_;
+  });
+  return true;
+}
+
+std::string JsonRpcDispatcher::rejectedResponse(std::string_view request, const std::string& method) {
+  Json::Value response(Json::objectValue);
+  response["jsonrpc"] = "2.0";
+  response["id"] = Json::nullValue;
+  try {
+    if (const auto request_json = util::parse_json(request); request_json.isObject()) {
+      response["id"] = request_json.get("id", Json::nullValue);
+    }
+  } catch (const Json::Exception&) {
+  }
+  auto& error = response["error"] = Json::Value(Json::objectValue);
+  error["code"] = kRejectedErrorCode;
+  error["message"] = "Too many pending " + method + " requests";
+  return util::to_string(response);
+}
+
+}  // namespace taraxa::net
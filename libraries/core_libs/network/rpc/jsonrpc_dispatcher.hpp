@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "common/thread_pool.hpp"
+#include "config/network.hpp"
+#include "metrics/jsonrpc_metrics.hpp"
+
+namespace taraxa::net {
+
+/**
+ * @brief Offloads expensive json-rpc methods from the rpc (io) threads to dedicated threads
+ *
+ * Cheap methods are still served inline by the rpc thread which received them. Expensive ones are queued for the
+ * dispatch threads, with limit on the number of waiting requests and on the number of concurrently processed requests
+ * of each method. Requests over the limits are rejected right away instead of occupying a thread. Shared by http and
+ * websocket servers.
+ */
+class JsonRpcDispatcher {
+ public:
+  // Error code of requests rejected due to dispatch limits, "Limit exceeded" of EIP-1474
+  static constexpr int kRejectedErrorCode = -32005;
+
+  JsonRpcDispatcher(const JsonRpcDispatchConfig& config, std::shared_ptr<metrics::JsonRpcMetrics> metrics);
+
+  /**
+   * @param request serialized json-rpc request
+   * @return name of the called method if it is expensive, empty optional if request should be served inline
+   *
+   * Method is found by string search instead of json parsing, batch requests are always served inline as they are
+   * split across rpc threads anyway
+   */
+  std::optional<std::string> classify(std::string_view request) const;
+
+  /**
+   * @brief Queues processing of request of the expensive method
+   * @return false if request was rejected due to dispatch limits
+   */
+  bool post(const std::string& method, std::function<void()> task);
+
+  /**
+   * @return json-rpc error response for rejected request
+   */
+  static std::string rejectedResponse(std::string_view request, const std::string& method);
+
+  uint64_t pending() const { return pending_; }
+  uint64_t running() const { return running_; }
+  uint64_t rejected() const { return rejected_; }
+
+ private:
+  struct MethodState {
+    // Max number of concurrently processed requests, 0 = unlimited
+    uint32_t limit = 0;
+    // Number of queued and running requests
+    std::atomic<uint32_t> in_flight = 0;
+  };
+
+  const uint32_t kMaxPending;
+  // Set of methods is fixed after construction, so map itself is accessed without lock
+  std::unordered_map<std::string, MethodState> methods_;
+  std::shared_ptr<metrics::JsonRpcMetrics> metrics_;
+  std::atomic<uint64_t> pending_ = 0;
+  std::atomic<uint64_t> running_ = 0;
+  std::atomic<uint64_t> rejected_ = 0;
+  util::ThreadPool thread_pool_;
+};
+
+}  // namespace taraxa::net
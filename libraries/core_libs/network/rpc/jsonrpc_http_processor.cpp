@@ -1,10 +1,45 @@
-
 #include "jsonrpc_http_processor.hpp"
 
+#include <condition_variable>
+#include <mutex>
+
 #include "common/jsoncpp.hpp"
 #include "common/util.hpp"
 namespace taraxa::net {
 
+namespace {
+
+bool isBatchRequest(const std::string &body) {
+  const auto first_char = body.find_first_not_of(" \t\r\n");
+  return first_char != std::string::npos && body[first_char] == '[';
+}
+
+Json::Value errorResponse(const Json::Value &request, int code, const std::string &message) {
+  Json::Value res_json(Json::objectValue);
+  res_json["jsonrpc"] = "2.0";
+  if (request.isObject() && request.isMember("id") &&  // this conditional was taken from jsonrpccpp sources
+      (request["id"].isNull() || request["id"].isIntegral() || request["id"].isString())) {
+    res_json["id"] = request["id"];
+  } else {
+    res_json["id"] = Json::nullValue;
+  }
+  auto &res_json_error = res_json["error"] = Json::Value(Json::objectValue);
+  res_json_error["code"] = code;
+  res_json_error["message"] = message;
+  return res_json;
+}
+
+void setCommonHeaders(HttpProcessor::Response &response) {
+  response.set("Access-Control-Allow-Origin", "*");
+  response.set("Access-Control-Allow-Headers", "Accept, Accept-Language, Content-Language, Content-Type");
+  response.prepare_payload();
+}
+
+}  // namespace
+
+JsonRpcHttpProcessor::JsonRpcHttpProcessor(util::ThreadPool &thread_pool, JsonRpcBatchConfig batch_config)
+    : thread_pool_(thread_pool), kBatchConfig(std::move(batch_config)) {}
+
 HttpProcessor::Response JsonRpcHttpProcessor::process(const Request &request) {
   Response response;
   std::optional<JsonRpcHttpProcessor::Error> err;
@@ -17,39 +52,183 @@ HttpProcessor::Response JsonRpcHttpProcessor::process(const Request &request) {
     response.set("Content-Type", "application/json");
     response.result(boost::beast::http::status::ok);
     try {
-      handler->HandleRequest(request.body(), response.body());
+      // Invalid json is left to the handler, which responds with proper parse error
+      std::optional<Json::Value> request_json;
+      if (serialized_methods_ || isBatchRequest(request.body())) {
+        try {
+          request_json = util::parse_json(request.body());
+        } catch (const Json::Exception &) {
+        }
+      }
+
+      std::optional<std::string> serialized_response;
+      if (request_json && request_json->isArray() && kBatchConfig.max_size &&
+          request_json->size() > kBatchConfig.max_size) {
+        err.emplace();
+        err->code = jsonrpc::Errors::ERROR_RPC_INVALID_REQUEST;
+        err->message << "Batch size " << request_json->size() << " exceeds max allowed size "
+                     << kBatchConfig.max_size;
+      } else if (request_json && request_json->isArray() && request_json->size() > 1) {
+        response.body() = processBatch(*request_json);
+      } else if (request_json && serialized_methods_ &&
+                 (serialized_response = serialized_methods_->handle(*request_json))) {
+        response.body() = std::move(*serialized_response);
+      } else {
+        handler->HandleRequest(request.body(), response.body());
+      }
     } catch (std::exception const &e) {
       err.emplace();
       err->message << e.what();
     }
     if (err) {
       auto const &err_msg = err->message.str();
-      Json::Value res_json(Json::objectValue);
-      res_json["jsonrpc"] = "2.0";
-      auto req_json = util::parse_json(request.body());
-      if (req_json.isObject() && req_json.isMember("id") &&  // this conditional was taken from jsonrpccpp sources
-          (req_json["id"].isNull() || req_json["id"].isIntegral() || req_json["id"].isString())) {
-        res_json["id"] = req_json["id"];
-      } else {
-        res_json["id"] = Json::nullValue;
+      Json::Value req_json;
+      try {
+        req_json = util::parse_json(request.body());
+      } catch (const Json::Exception &) {
       }
-      auto &res_json_error = res_json["error"] = Json::Value(Json::objectValue);
-      res_json_error["code"] = err->code;
-      res_json_error["message"] = err_msg;
+      auto res_json = errorResponse(req_json, err->code, err_msg);
       if (!err->data.empty()) {
-        res_json_error["data"] = err->data;
+        res_json["error"]["data"] = err->data;
       }
       response.body() = util::to_string(res_json);
     }
   } else {
     response.result(boost::beast::http::status::method_not_allowed);
   }
-  response.set("Access-Control-Allow-Origin", "*");
-  response.set("Access-Control-Allow-Headers", "Accept, Accept-Language, Content-Language, Content-Type");
-  response.set("Connection", "close");
-  response.prepare_payload();
+  setCommonHeaders(response);
 
   return response;
 }
 
-}  // namespace taraxa::net
\ No newline at end of file
+bool JsonRpcHttpProcessor::processAsync(const Request &request, std::function<void(Response &&)> on_response) {
+  if (!dispatcher_ || request.method() != boost::beast::http::verb::post) {
+    return false;
+  }
+  auto method = dispatcher_->classify(request.body());
+  if (!method) {
+    return false;
+  }
+
+  // Request is owned by connection, which is kept alive until response is written
+  const auto posted = dispatcher_->post(*method, [this, &request, on_response] { on_response(process(request)); });
+  if (!posted) {
+    Response response;
+    response.set("Content-Type", "application/json");
+    response.result(boost::beast::http::status::ok);
+    response.body() = JsonRpcDispatcher::rejectedResponse(request.body(), *method);
+    setCommonHeaders(response);
+    on_response(std::move(response));
+  }
+  return true;
+}
+
+std::string JsonRpcHttpProcessor::processBatch(const Json::Value &batch) {
+  struct BatchState {
+    std::vector<Json::Value> requests;
+    std::vector<std::string> responses;
+    std::vector<bool> processed;
+    // Responses of requests served together by group methods, written before processing starts
+    std::vector<std::optional<std::string>> grouped;
+    std::atomic<size_t> next_request = 0;
+    size_t finished_count = 0;
+    bool expired = false;
+    std::mutex mutex;
+    std::condition_variable cv;
+  };
+
+  // State is shared with helper tasks, which might still run after deadline expired and this function returned
+  auto state = std::make_shared<BatchState>();
+  state->requests.assign(batch.begin(), batch.end());
+  state->responses.resize(state->requests.size());
+  state->processed.resize(state->requests.size(), false);
+  if (serialized_methods_) {
+    state->grouped = serialized_methods_->handleGroups(state->requests);
+  } else {
+    state->grouped.resize(state->requests.size());
+  }
+
+  std::optional<std::chrono::steady_clock::time_point> deadline;
+  if (kBatchConfig.deadline_ms) {
+    deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(kBatchConfig.deadline_ms);
+  }
+
+  // Requests are claimed one by one by both the calling thread and helper tasks. Calling thread never waits for
+  // requests that were not claimed yet, so batch cannot deadlock even if all rpc threads are busy processing batches
+  auto process_requests = [state, deadline, handler = GetHandler(), serialized_methods = serialized_methods_]() {
+    for (size_t i = state->next_request++; i < state->requests.size(); i = state->next_request++) {
+      // Each request is claimed by a single thread, so its grouped response can be taken without lock
+      std::optional<std::string> response = std::move(state->grouped[i]);
+      if (!response && (!deadline || std::chrono::steady_clock::now() < *deadline)) {
+        try {
+          if (serialized_methods) {
+            response = serialized_methods->handle(state->requests[i]);
+          }
+          if (!response) {
+            response.emplace();
+            handler->HandleRequest(util::to_string(state->requests[i]), *response);
+          }
+        } catch (std::exception const &e) {
+          response = util::to_string(
+              errorResponse(state->requests[i], jsonrpc::Errors::ERROR_RPC_INTERNAL_ERROR, e.what()));
+        }
+      }
+
+      {
+        std::unique_lock lock(state->mutex);
+        if (response && !state->expired) {
+          state->responses[i] = std::move(*response);
+          state->processed[i] = true;
+        }
+        state->finished_count++;
+      }
+      state->cv.notify_all();
+    }
+  };
+
+  const auto helpers_count = std::min<size_t>(thread_pool_.capacity(), state->requests.size()) - 1;
+  for (size_t i = 0; i < helpers_count; i++) {
+    thread_pool_.post(process_requests);
+  }
+  process_requests();
+
+  std::unique_lock lock(state->mutex);
+  const auto all_finished = [&state] { return state->finished_count == state->requests.size(); };
+  if (deadline) {
+    state->cv.wait_until(lock, *deadline, all_finished);
+  } else {
+    state->cv.wait(lock, all_finished);
+  }
+  state->expired = true;
+
+  // Responses are reassembled in the order of requests, notifications have no response
+  std::string result = "[";
+  for (size_t i = 0; i < state->requests.size(); i++) {
+    const auto &request = state->requests[i];
+    if (request.isObject() && !request.isMember("id")) {
+      continue;
+    }
+
+    std::string response;
+    if (state->processed[i]) {
+      response = std::move(state->responses[i]);
+    } else {
+      response =
+          util::to_string(errorResponse(request, jsonrpc::Errors::ERROR_RPC_INTERNAL_ERROR, "Batch deadline exceeded"));
+    }
+    if (response.empty()) {
+      continue;
+    }
+    if (result.size() > 1) {
+      result += ',';
+    }
+    result += response;
+  }
+
+  if (result.size() == 1) {
+    return {};
+  }
+  return result + "]";
+}
+
+}  // namespace taraxa::net
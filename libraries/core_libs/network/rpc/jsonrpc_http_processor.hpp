@@ -4,7 +4,10 @@
 #include <jsonrpccpp/common/exception.h>
 #include <jsonrpccpp/server/abstractserverconnector.h>
 
+#include "common/thread_pool.hpp"
 #include "network/http_server.hpp"
+#include "network/rpc/jsonrpc_dispatcher.hpp"
+#include "network/rpc/jsonrpc_serialized_methods.hpp"
 
 namespace taraxa::net {
 
@@ -16,10 +19,40 @@ class JsonRpcHttpProcessor final : public HttpProcessor, public jsonrpc::Abstrac
     Json::Value data{Json::objectValue};
   };
 
+  /**
+   * @param thread_pool rpc thread pool, requests of json-rpc batch are split across its threads
+   * @param batch_config
+   */
+  JsonRpcHttpProcessor(util::ThreadPool& thread_pool, JsonRpcBatchConfig batch_config);
+
   Response process(const Request& request) override;
+  // Requests of expensive methods are processed by dispatcher threads
+  bool processAsync(const Request& request, std::function<void(Response&&)> on_response) override;
+
+  // Must be set before http server is started
+  void setSerializedMethods(std::shared_ptr<const JsonRpcSerializedMethods> methods) {
+    serialized_methods_ = std::move(methods);
+  }
+  // Must be set before http server is started
+  void setDispatcher(std::shared_ptr<JsonRpcDispatcher> dispatcher) { dispatcher_ = std::move(dispatcher); }
 
   bool StartListening() override { return true; }
   bool StopListening() override { return true; }
+
+ private:
+  /**
+   * @brief Processes requests of json-rpc batch in parallel and reassembles their responses in original order
+   *
+   * @param batch
+   * @return batch response
+   */
+  std::string processBatch(const Json::Value& batch);
+
+  // Unsafe reference, thread pool is owned by rpc plugin and outlives processor
+  util::ThreadPool& thread_pool_;
+  const JsonRpcBatchConfig kBatchConfig;
+  std::shared_ptr<const JsonRpcSerializedMethods> serialized_methods_;
+  std::shared_ptr<JsonRpcDispatcher> dispatcher_;
 };
 
-}  // namespace taraxa::net
\ No newline at end of file
+}  // namespace taraxa::net
@@ -0,0 +1,56 @@
+#include "network/rpc/jsonrpc_response_cache.hpp"
+
+namespace taraxa::net {
+
+std::string JsonRpcResponseCache::makeKey(const std::string& method, const std::string& params) {
+  std::string key;
+  key.reserve(method.size() + params.size() + 1);
+  key.append(method).append(1, ' ').append(params);
+  return key;
+}
+
+std::shared_ptr<const std::string> JsonRpcResponseCache::get(const std::string& key) {
+  std::unique_lock lock(mutex_);
+  const auto entry = entries_.find(key);
+  if (entry == entries_.end()) {
+    lock.unlock();
+    ++misses_;
+    return {};
+  }
+  lru_.splice(lru_.begin(), lru_, entry->second);
+  auto result = entry->second->result;
+  lock.unlock();
+
+  ++hits_;
+  return result;
+}
+
+void JsonRpcResponseCache::insert(const std::string& key, std::string result) {
+  Entry entry{key, std::make_shared<const std::string>(std::move(result))};
+  const auto size = entrySize(entry);
+  if (size > kMaxBytes) {
+    return;
+  }
+
+  std::scoped_lock lock(mutex_);
+  // Same result could be already inserted by another thread
+  if (entries_.contains(key)) {
+    return;
+  }
+  while (bytes_ + size > kMaxBytes) {
+    bytes_ -= entrySize(lru_.back());
+    entries_.erase(lru_.back().key);
+    lru_.pop_back();
+  }
+  lru_.push_front(std::move(entry));
+  // Map key points to the string owned by list entry, which is not moved until erased
+  entries_.emplace(lru_.front().key, lru_.begin());
+  bytes_ += size;
+}
+
+size_t JsonRpcResponseCache::bytes() const {
+  std::scoped_lock lock(mutex_);
+  return bytes_;
+}
+
+}  // namespace taraxa::net
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace taraxa::net {
+
+/**
+ * @brief LRU cache of serialized json-rpc results limited by total size of cached strings
+ *
+ * Only results which can never change (finalized blocks, transactions and receipts) are stored, so entries are never
+ * invalidated and are only evicted when budget is exceeded. Cache is shared by all rpc servers.
+ */
+class JsonRpcResponseCache {
+ public:
+  explicit JsonRpcResponseCache(size_t max_bytes) : kMaxBytes(max_bytes) {}
+
+  /**
+   * @param method json-rpc method name
+   * @param params request params
+   * @return key of the cached result, params are stringified by jsoncpp so objects keys are always sorted
+   */
+  static std::string makeKey(const std::string& method, const std::string& params);
+
+  std::shared_ptr<const std::string> get(const std::string& key);
+  void insert(const std::string& key, std::string result);
+
+  uint64_t hits() const { return hits_; }
+  uint64_t misses() const { return misses_; }
+  size_t bytes() const;
+
+ private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<const std::string> result;
+  };
+
+  // Key and result are both accounted in budget
+  static size_t entrySize(const Entry& entry) { return entry.key.size() + entry.result->size(); }
+
+  const size_t kMaxBytes;
+
+  mutable std::mutex mutex_;
+  // Most recently used entries are at the front
+  std::list<Entry> lru_;
+  std::unordered_map<std::string_view, std::list<Entry>::iterator> entries_;
+  size_t bytes_ = 0;
+
+  std::atomic<uint64_t> hits_ = 0;
+  std::atomic<uint64_t> misses_ = 0;
+};
+
+}  // namespace taraxa::net
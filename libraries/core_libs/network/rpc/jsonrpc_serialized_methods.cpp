@@ -0,0 +1,139 @@
+#include "network/rpc/jsonrpc_serialized_methods.hpp"
+
+#include "common/jsoncpp.hpp"
+
+namespace taraxa::net {
+
+void JsonRpcSerializedMethods::registerMethod(const std::string& name, Method method) {
+  methods_.emplace(name, std::move(method));
+}
+
+void JsonRpcSerializedMethods::registerGroup(const std::vector<std::string>& names, GroupMethod group) {
+  for (const auto& name : names) {
+    group_by_method_.emplace(name, groups_.size());
+  }
+  groups_.push_back(std::move(group));
+}
+
+namespace {
+
+// Only valid requests with id are served, notifications and invalid requests are left to the regular handler so it
+// reports errors the usual way
+bool isServedRequest(const Json::Value& request) {
+  if (!request.isObject() || request.get("jsonrpc", "") != "2.0" || !request["method"].isString()) {
+    return false;
+  }
+  const auto& id = request["id"];
+  return id.isIntegral() || id.isString();
+}
+
+std::string_view methodName(const Json::Value& request) {
+  const char* begin = nullptr;
+  const char* end = nullptr;
+  request["method"].getString(&begin, &end);
+  return {begin, static_cast<size_t>(end - begin)};
+}
+
+}  // namespace
+
+std::optional<std::string> JsonRpcSerializedMethods::handle(const Json::Value& request) const {
+  if (!isServedRequest(request)) {
+    return {};
+  }
+  const auto& id = request["id"];
+  const auto method = methods_.find(methodName(request));
+  if (method == methods_.end()) {
+    return {};
+  }
+
+  const auto params = request.get("params", Json::Value(Json::arrayValue));
+  std::string cache_key;
+  std::shared_ptr<const std::string> cached;
+  if (cache_) {
+    cache_key = JsonRpcResponseCache::makeKey(method->first, util::to_string(params));
+    cached = cache_->get(cache_key);
+  }
+
+  // Buffer keeps its capacity between requests processed by the same thread
+  thread_local std::string buffer;
+  buffer.clear();
+
+  JsonWriter writer(buffer);
+  writer.beginObject().key("id").raw(util::to_string(id)).key("jsonrpc").value("2.0").key("result");
+  if (cached) {
+    writer.raw(*cached);
+  } else {
+    const auto result_begin = buffer.size();
+    try {
+      const auto result = method->second(params, writer);
+      if (result == Result::Fallback) {
+        return {};
+      }
+      if (result == Result::Final && cache_) {
+        cache_->insert(cache_key, buffer.substr(result_begin));
+      }
+    } catch (...) {
+      // Errors are reported by the regular handler
+      return {};
+    }
+  }
+  writer.endObject();
+
+  return buffer;
+}
+
+std::vector<std::optional<std::string>> JsonRpcSerializedMethods::handleGroups(
+    const std::vector<Json::Value>& requests) const {
+  std::vector<std::optional<std::string>> responses(requests.size());
+  if (groups_.empty()) {
+    return responses;
+  }
+
+  // Methods names and params are kept alive here, GroupRequest only references them
+  std::vector<std::string> methods(requests.size());
+  std::vector<Json::Value> params(requests.size());
+  std::vector<std::vector<size_t>> indexes_by_group(groups_.size());
+  for (size_t i = 0; i < requests.size(); ++i) {
+    if (!isServedRequest(requests[i])) {
+      continue;
+    }
+    methods[i] = requests[i]["method"].asString();
+    if (const auto group = group_by_method_.find(methods[i]); group != group_by_method_.end()) {
+      params[i] = requests[i].get("params", Json::Value(Json::arrayValue));
+      indexes_by_group[group->second].push_back(i);
+    }
+  }
+
+  for (size_t group = 0; group < groups_.size(); ++group) {
+    const auto& indexes = indexes_by_group[group];
+    if (indexes.empty()) {
+      continue;
+    }
+
+    std::vector<GroupRequest> group_requests;
+    group_requests.reserve(indexes.size());
+    for (const auto i : indexes) {
+      group_requests.push_back({methods[i], params[i]});
+    }
+    std::vector<std::optional<std::string>> results(indexes.size());
+    try {
+      groups_[group](group_requests, results);
+    } catch (...) {
+      // Whole group is left to the regular handler, which reports errors the usual way
+      continue;
+    }
+
+    for (size_t j = 0; j < indexes.size(); ++j) {
+      if (!results[j]) {
+        continue;
+      }
+      auto& response = responses[indexes[j]].emplace();
+      JsonWriter writer(response);
+      writer.beginObject().key("id").raw(util::to_string(requests[indexes[j]]["id"])).key("jsonrpc").value("2.0");
+      writer.key("result").raw(*results[j]).endObject();
+    }
+  }
+  return responses;
+}
+
+}  // namespace taraxa::net
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <json/json.h>
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "network/rpc/json_writer.hpp"
+#include "network/rpc/jsonrpc_response_cache.hpp"
+
+namespace taraxa::net {
+
+/**
+ * @brief Fast path for hot json-rpc methods, which write their results directly into response string instead of
+ *        building Json::Value tree that is then stringified by jsonrpccpp
+ *
+ * Both http and websocket servers try this fast path first and use regular jsonrpccpp handler for all other requests
+ */
+class JsonRpcSerializedMethods {
+ public:
+  enum class Result {
+    // Params are not supported by fast path and request should be processed by regular handler
+    Fallback,
+    Done,
+    // Result can never change, so it can be cached
+    Final,
+  };
+
+  /**
+   * @brief Writes result of the method for provided params
+   */
+  using Method = std::function<Result(const Json::Value& params, JsonWriter& writer)>;
+
+  void registerMethod(const std::string& name, Method method);
+
+  /**
+   * @brief Request of json-rpc batch served by group method
+   */
+  struct GroupRequest {
+    const std::string& method;
+    const Json::Value& params;
+  };
+
+  /**
+   * @brief Resolves requests of several methods of json-rpc batch together, e.g. state reads against the same state.
+   *        Writes serialized result of every request into results, requests left empty are processed one by one
+   */
+  using GroupMethod =
+      std::function<void(const std::vector<GroupRequest>& requests, std::vector<std::optional<std::string>>& results)>;
+
+  void registerGroup(const std::vector<std::string>& names, GroupMethod group);
+
+  /**
+   * @brief Enables caching of final results
+   */
+  void setResponseCache(std::shared_ptr<JsonRpcResponseCache> cache) { cache_ = std::move(cache); }
+
+  /**
+   * @param request parsed json-rpc request
+   * @return serialized response, empty optional in case request must be processed by regular jsonrpc handler
+   */
+  std::optional<std::string> handle(const Json::Value& request) const;
+
+  /**
+   * @param requests parsed json-rpc batch
+   * @return serialized responses of requests served by group methods, in the same order as requests
+   */
+  std::vector<std::optional<std::string>> handleGroups(const std::vector<Json::Value>& requests) const;
+
+ private:
+  // Methods are looked up by name view into parsed request, so no string is allocated per request
+  struct MethodNameHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view name) const { return std::hash<std::string_view>()(name); }
+  };
+  template <class T>
+  using MethodsMap = std::unordered_map<std::string, T, MethodNameHash, std::equal_to<>>;
+
+  MethodsMap<Method> methods_;
+  std::vector<GroupMethod> groups_;
+  // Index into groups_
+  MethodsMap<size_t> group_by_method_;
+  std::shared_ptr<JsonRpcResponseCache> cache_;
+};
+
+}  // namespace taraxa::net
@@ -16,6 +16,23 @@
 
 namespace taraxa::net {
 
+namespace {
+// Encoding requested by subscribe options {"encoding": "json" | "rlp"}
+SubscriptionEncoding parseEncoding(const Json::Value &options) {
+  if (!options.isObject() || !options.isMember("encoding")) {
+    return SubscriptionEncoding::Json;
+  }
+  const auto encoding = options["encoding"].asString();
+  if (encoding == "json") {
+    return SubscriptionEncoding::Json;
+  }
+  if (encoding == "rlp") {
+    return SubscriptionEncoding::Rlp;
+  }
+  throw std::runtime_error("Unknown subscription encoding: " + encoding);
+}
+}  // namespace
+
 std::string JsonRpcWsSession::processRequest(const std::string_view &req_str) {
   Json::Value req;
   try {
@@ -49,10 +66,41 @@ std::string JsonRpcWsSession::processRequest(const std::string_view &req_str) {
   }
 }
 
+bool JsonRpcWsSession::dispatchRequest(const std::string &request) {
+  auto ws_server = ws_server_.lock();
+  if (!ws_server) {
+    return false;
+  }
+  // Sessions of JsonRpcWsServer are created only by JsonRpcWsServer
+  const auto &dispatcher = static_cast<JsonRpcWsServer &>(*ws_server).getDispatcher();
+  if (!dispatcher) {
+    return false;
+  }
+  auto method = dispatcher->classify(request);
+  if (!method) {
+    return false;
+  }
+
+  const auto posted = dispatcher->post(
+      *method, [self = std::static_pointer_cast<JsonRpcWsSession>(shared_from_this()), request] {
+        self->processAndWrite(request);
+      });
+  if (!posted) {
+    do_write(JsonRpcDispatcher::rejectedResponse(request, *method));
+  }
+  return true;
+}
+
 std::string JsonRpcWsSession::handleRequest(const Json::Value &req) {
   std::string response;
   auto ws_server = ws_server_.lock();
   if (ws_server) {
+    // Sessions of JsonRpcWsServer are created only by JsonRpcWsServer
+    if (const auto &serialized_methods = static_cast<JsonRpcWsServer &>(*ws_server).getSerializedMethods()) {
+      if (auto serialized_response = serialized_methods->handle(req)) {
+        return std::move(*serialized_response);
+      }
+    }
     auto handler = ws_server->GetHandler();
     if (handler != NULL) {
       handler->HandleRequest(util::to_string(req), response);
@@ -76,9 +124,16 @@ std::string JsonRpcWsSession::handleSubscription(const Json::Value &req) {
 
   if (params.size() > 0) {
     if (params[0].asString() == "newHeads") {
-      subscriptions_.addSubscription(std::make_shared<HeadsSubscription>(subscription_id));
+      subscriptions_.addSubscription(std::make_shared<HeadsSubscription>(subscription_id, parseEncoding(options)));
     } else if (params[0].asString() == "newPendingTransactions") {
-      subscriptions_.addSubscription(std::make_shared<TransactionsSubscription>(subscription_id));
+      // {"batch": true} subscribes to hashes coalesced by server, optionally capped by "max_per_second"
+      if (options.isObject() && options.get("batch", false).asBool()) {
+        subscriptions_.addSubscription(std::make_shared<TransactionsBatchSubscription>(
+            subscription_id, options.get("max_per_second", 0).asUInt(), parseEncoding(options)));
+      } else {
+        subscriptions_.addSubscription(
+            std::make_shared<TransactionsSubscription>(subscription_id, parseEncoding(options)));
+      }
     } else if (params[0].asString() == "newDagBlocks") {
       subscriptions_.addSubscription(std::make_shared<DagBlocksSubscription>(subscription_id, options.asBool()));
     } else if (params[0].asString() == "newDagBlocksFinalized") {
@@ -87,7 +142,11 @@ std::string JsonRpcWsSession::handleSubscription(const Json::Value &req) {
       subscriptions_.addSubscription(
           std::make_shared<PbftBlockExecutedSubscription>(subscription_id, options.asBool()));
     } else if (params[0].asString() == "newPillarBlockData") {
-      subscriptions_.addSubscription(std::make_shared<PillarBlockSubscription>(subscription_id, options.asBool()));
+      // Options are either include signatures flag or {"signatures": bool, "encoding": "json" | "rlp"}
+      const auto include_signatures =
+          options.isObject() ? options.get("signatures", false).asBool() : options.asBool();
+      subscriptions_.addSubscription(
+          std::make_shared<PillarBlockSubscription>(subscription_id, include_signatures, parseEncoding(options)));
     } else if (params[0].asString() == "logs") {
       auto filter =
           rpc::eth::LogFilter(0, std::nullopt, rpc::eth::parse_addresses(options), rpc::eth::parse_topics(options));
@@ -118,7 +177,8 @@ std::string JsonRpcWsSession::handleUnsubscription(const Json::Value &req) {
 }
 
 std::shared_ptr<WsSession> JsonRpcWsServer::createSession(tcp::socket &&socket) {
-  return std::make_shared<JsonRpcWsSession>(std::move(socket), node_addr_, shared_from_this());
+  return std::make_shared<JsonRpcWsSession>(std::move(socket), node_addr_, shared_from_this(), kWriteQueueConfig,
+                                            kCompressionConfig);
 }
 
 }  // namespace taraxa::net
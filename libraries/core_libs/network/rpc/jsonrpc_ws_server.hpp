@@ -1,5 +1,7 @@
 #pragma once
 
+#include "network/rpc/jsonrpc_dispatcher.hpp"
+#include "network/rpc/jsonrpc_serialized_methods.hpp"
 #include "network/ws_server.hpp"
 
 namespace taraxa::net {
@@ -8,6 +10,8 @@ class JsonRpcWsSession final : public WsSession {
  public:
   using WsSession::WsSession;
   std::string processRequest(const std::string_view& request) override;
+  // Requests of expensive methods are processed by dispatcher threads
+  bool dispatchRequest(const std::string& request) override;
 
  private:
   std::string handleRequest(const Json::Value& req);
@@ -19,6 +23,20 @@ class JsonRpcWsServer final : public WsServer {
  public:
   using WsServer::WsServer;
   std::shared_ptr<WsSession> createSession(tcp::socket&& socket) override;
+
+  // Must be set before server is started
+  void setSerializedMethods(std::shared_ptr<const JsonRpcSerializedMethods> methods) {
+    serialized_methods_ = std::move(methods);
+  }
+  const std::shared_ptr<const JsonRpcSerializedMethods>& getSerializedMethods() const { return serialized_methods_; }
+
+  // Must be set before server is started
+  void setDispatcher(std::shared_ptr<JsonRpcDispatcher> dispatcher) { dispatcher_ = std::move(dispatcher); }
+  const std::shared_ptr<JsonRpcDispatcher>& getDispatcher() const { return dispatcher_; }
+
+ private:
+  std::shared_ptr<const JsonRpcSerializedMethods> serialized_methods_;
+  std::shared_ptr<JsonRpcDispatcher> dispatcher_;
 };
 
 }  // namespace taraxa::net
\ No newline at end of file
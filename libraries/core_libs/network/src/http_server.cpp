@@ -4,8 +4,13 @@ namespace taraxa::net {
 
 HttpServer::HttpServer(boost::asio::io_context &io, boost::asio::ip::tcp::endpoint ep, const addr_t &node_addr,
                        const std::shared_ptr<HttpProcessor> &request_processor,
-                       std::shared_ptr<metrics::JsonRpcMetrics> metrics)
-    : request_processor_(request_processor), metrics_(metrics), io_context_(io), acceptor_(io), ep_(std::move(ep)) {
+                       std::shared_ptr<metrics::JsonRpcMetrics> metrics, HttpKeepAliveConfig keep_alive_config)
+    : request_processor_(request_processor),
+      metrics_(metrics),
+      kKeepAliveConfig(std::move(keep_alive_config)),
+      io_context_(io),
+      acceptor_(io),
+      ep_(std::move(ep)) {
   LOG_OBJECTS_CREATE("HTTP");
   LOG(log_si_) << "Taraxa HttpServer started at port: " << ep_.port();
 }
@@ -77,7 +82,9 @@ std::shared_ptr<HttpConnection> HttpConnection::getShared() {
 }
 
 HttpConnection::HttpConnection(const std::shared_ptr<HttpServer> &http_server)
-    : server_(http_server), socket_(http_server->getIoContext()) {}
+    : server_(http_server),
+      socket_(boost::asio::make_strand(http_server->getIoContext())),
+      idle_timer_(socket_.get_executor()) {}
 
 void HttpConnection::stop() {
   if (socket_.is_open()) {
@@ -91,38 +98,87 @@ void HttpConnection::stop() {
 }
 
 void HttpConnection::read() {
+  // Requests pipelined by client that were already received stay in buffer_, so they are read from there one by one
+  request_ = {};
+
+  if (server_->kKeepAliveConfig.idle_timeout_ms) {
+    idle_timer_.expires_after(std::chrono::milliseconds(server_->kKeepAliveConfig.idle_timeout_ms));
+    idle_timer_.async_wait([this, this_sp = getShared()](boost::system::error_code const &ec) {
+      if (!ec) {
+        LOG(server_->log_dg_) << "HttpConnection idle timeout expired";
+        stop();
+      }
+    });
+  }
+
   boost::beast::http::async_read(
       socket_, buffer_, request_, [this, this_sp = getShared()](boost::system::error_code const &ec, size_t) {
-        if (ec) {
+        idle_timer_.cancel();
+        if (ec == boost::beast::http::error::end_of_stream || ec == boost::asio::error::operation_aborted) {
+          // Client closed kept alive connection or it was closed due to idle timeout
+          stop();
+        } else if (ec) {
           LOG(server_->log_er_) << "Error! HttpConnection connection read fail ... " << ec.message() << std::endl;
           stop();
         } else {
-          std::string ip = request_["X-Real-IP"];
-          if (ip.empty()) {
-            try {
-              auto endpoint = socket_.remote_endpoint();
-              ip = endpoint.address().to_string();
-            } catch (...) {
-              ip = "Unknown";
-            }
-          }
-
-          assert(server_->request_processor_);
-          LOG(server_->log_dg_) << "Received: " << request_;
-
-          auto start_time = std::chrono::steady_clock::now();
-          response_ = server_->request_processor_->process(request_);
-          auto end_time = std::chrono::steady_clock::now();
-          auto processing_time = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
-
-          if (server_->metrics_) {
-            server_->metrics_->report(request_.body(), ip, "HTTP", processing_time.count());
-          }
-
-          boost::beast::http::async_write(
-              socket_, response_,
-              [this_sp = getShared()](auto const & /*ec*/, auto /*bytes_transferred*/) { this_sp->stop(); });
+          respond();
+        }
+      });
+}
+
+void HttpConnection::respond() {
+  std::string ip = request_["X-Real-IP"];
+  if (ip.empty()) {
+    try {
+      auto endpoint = socket_.remote_endpoint();
+      ip = endpoint.address().to_string();
+    } catch (...) {
+      ip = "Unknown";
+    }
+  }
+
+  assert(server_->request_processor_);
+  LOG(server_->log_dg_) << "Received: " << request_;
+
+  auto start_time = std::chrono::steady_clock::now();
+  // Once processed asynchronously, response is written from the socket executor again
+  const auto taken_over = server_->request_processor_->processAsync(
+      request_, [this, this_sp = getShared(), ip, start_time](HttpProcessor::Response &&response) {
+        boost::asio::post(socket_.get_executor(),
+                          [this, this_sp, ip, start_time, response = std::move(response)]() mutable {
+                            response_ = std::move(response);
+                            write(ip, start_time);
+                          });
+      });
+  if (!taken_over) {
+    response_ = server_->request_processor_->process(request_);
+    write(ip, start_time);
+  }
+}
+
+void HttpConnection::write(const std::string &ip, std::chrono::steady_clock::time_point start_time) {
+  auto end_time = std::chrono::steady_clock::now();
+  auto processing_time = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+
+  if (server_->metrics_) {
+    server_->metrics_->report(request_.body(), ip, "HTTP", processing_time.count());
+  }
+
+  // Connection is kept alive only if client asked for it (default for HTTP/1.1) and it has not served max requests yet
+  requests_count_++;
+  const auto &keep_alive_config = server_->kKeepAliveConfig;
+  const bool keep_alive = keep_alive_config.idle_timeout_ms && request_.keep_alive() &&
+                          (!keep_alive_config.max_requests || requests_count_ < keep_alive_config.max_requests);
+  response_.version(request_.version());
+  response_.keep_alive(keep_alive);
+
+  boost::beast::http::async_write(
+      socket_, response_, [this, this_sp = getShared(), keep_alive](auto const &ec, auto /*bytes_transferred*/) {
+        if (ec || !keep_alive) {
+          stop();
+          return;
         }
+        read();
       });
 }
 
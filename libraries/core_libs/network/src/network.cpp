@@ -5,22 +5,35 @@
 #include <libp2p/Network.h>
 
 #include <boost/tokenizer.hpp>
+#include <random>
 
 #include "config/version.hpp"
+#include "final_chain/final_chain.hpp"
 #include "network/tarcap/packets_handlers/interface/dag_block_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/interface/get_pillar_votes_bundle_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/interface/pillar_vote_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/interface/sync_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/interface/transaction_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/interface/vote_packet_handler.hpp"
+#include "network/tarcap/packets_handlers/latest/get_historical_block_packet_handler.hpp"
+#include "network/tarcap/packets_handlers/latest/transactions_reconciliation_packet_handler.hpp"
 #include "network/tarcap/shared_states/pbft_syncing_state.hpp"
 #include "network/tarcap/stats/node_stats.hpp"
 #include "network/tarcap/stats/time_period_packets_stats.hpp"
 #include "network/tarcap/taraxa_capability.hpp"
+#include "pbft/pbft_chain.hpp"
 #include "pbft/pbft_manager.hpp"
 
 namespace taraxa {
 
+// Load level is sampled often enough for the proposer to react within a few proposals
+constexpr uint64_t kNodeLoadUpdateIntervalMs = 500;
+// Newly connected peers wait at most this long for transactions pool reconciliation
+constexpr uint64_t kReconciliationCheckIntervalMs = 1000;
+// Historical block is served from db by a single packet, slower peer is skipped
+constexpr std::chrono::milliseconds kHistoricalBlockTimeout{2000};
+constexpr size_t kHistoricalBlockMaxPeers = 3;
+
 Network::Network(const FullNodeConfig &config, const h256 &genesis_hash, const std::filesystem::path &network_file_path,
                  std::shared_ptr<DbStorage> db, std::shared_ptr<PbftManager> pbft_mgr,
                  std::shared_ptr<PbftChain> pbft_chain, std::shared_ptr<VoteManager> vote_mgr,
@@ -30,17 +43,29 @@ Network::Network(const FullNodeConfig &config, const h256 &genesis_hash, const s
                  std::shared_ptr<final_chain::FinalChain> final_chain)
     : kConf(config),
       all_packets_stats_(nullptr),
+      compression_stats_(std::make_shared<network::tarcap::PacketsCompressionStats>()),
+      upload_bandwidth_(std::make_shared<network::tarcap::UploadBandwidthManager>(config.network.sync_upload)),
       node_stats_(nullptr),
-      pbft_syncing_state_(std::make_shared<network::tarcap::PbftSyncingState>(config.network.deep_syncing_threshold)),
+      pbft_syncing_state_(std::make_shared<network::tarcap::PbftSyncingState>(config.network.deep_syncing_threshold,
+                                                                               config.network.sync_level_size)),
       pbft_mgr_(pbft_mgr),
+      node_load_(config.network.ddos_protection.max_packets_queue_size, config.transactions_pool_size),
+      transaction_interval_ms_(config.network.transaction_interval_ms),
       tp_(config.network.num_threads, false),
-      packets_tp_(std::make_shared<network::threadpool::PacketsThreadPool>(config.network.packets_processing_threads,
-                                                                           pbft_mgr, kConf.getFirstWallet().node_addr)),
+      packets_tp_(std::make_shared<network::threadpool::PacketsThreadPool>(
+          config.network.packets_processing_scaling ? config.network.packets_processing_scaling->max_threads
+                                                    : config.network.packets_processing_threads,
+          pbft_mgr, kConf.getFirstWallet().node_addr)),
       periodic_events_tp_(kPeriodicEventsThreadCount, false) {
   auto const &node_addr = kConf.getFirstWallet().node_addr;
   LOG_OBJECTS_CREATE("NETWORK");
   LOG(log_nf_) << "Read Network Config: " << std::endl << config.network << std::endl;
 
+  if (config.network.packets_processing_scaling) {
+    packets_tp_->enableWorkersScaling(*config.network.packets_processing_scaling,
+                                      config.network.packets_processing_threads);
+  }
+
   all_packets_stats_ = std::make_shared<network::tarcap::TimePeriodPacketsStats>(
       kConf.network.ddos_protection.packets_stats_time_period_ms, node_addr);
 
@@ -57,6 +82,11 @@ Network::Network(const FullNodeConfig &config, const h256 &genesis_hash, const s
   net_conf.publicIPAddress = config.network.public_ip;
   net_conf.pin = false;
   net_conf.trustedNodes = config.network.trusted_nodes;
+  if (config.network.follower) {
+    // Connections to upstream nodes are kept even if peers limit is reached
+    net_conf.trustedNodes.insert(config.network.follower->upstream_nodes.begin(),
+                                 config.network.follower->upstream_nodes.end());
+  }
 
   dev::p2p::TaraxaNetworkConfig taraxa_net_conf;
   taraxa_net_conf.ideal_peer_count = config.network.ideal_peer_count;
@@ -65,6 +95,8 @@ Network::Network(const FullNodeConfig &config, const h256 &genesis_hash, const s
   taraxa_net_conf.peer_stretch = config.network.max_peer_count / config.network.ideal_peer_count;
   taraxa_net_conf.chain_id = config.genesis.chain_id;
   taraxa_net_conf.expected_parallelism = tp_.capacity();
+  taraxa_net_conf.link_emulation.latency = std::chrono::milliseconds(config.network.emulated_latency_ms);
+  taraxa_net_conf.link_emulation.bandwidth = uint64_t(config.network.emulated_bandwidth_kbps) * 1024;
 
   const std::string net_version = "TaraxaNode";
 
@@ -76,16 +108,17 @@ Network::Network(const FullNodeConfig &config, const h256 &genesis_hash, const s
 
     // Register latest version of taraxa capability
     auto latest_tarcap = std::make_shared<network::tarcap::TaraxaCapability>(
-        TARAXA_NET_VERSION, config, genesis_hash, host, packets_tp_, all_packets_stats_, pbft_syncing_state_, db,
-        pbft_mgr, pbft_chain, vote_mgr, dag_mgr, trx_mgr, slashing_manager, pillar_chain_mgr, final_chain);
+        TARAXA_NET_VERSION, config, genesis_hash, host, packets_tp_, all_packets_stats_, compression_stats_,
+        upload_bandwidth_, pbft_syncing_state_, db, pbft_mgr, pbft_chain, vote_mgr, dag_mgr, trx_mgr, slashing_manager,
+        pillar_chain_mgr, final_chain);
     capabilities.emplace_back(latest_tarcap);
 
     // Register previous (v5) version of taraxa capability
     assert(TARAXA_NET_VERSION - 1 == 5);
     auto v5_tarcap = std::make_shared<network::tarcap::TaraxaCapability>(
-        TARAXA_NET_VERSION - 1, config, genesis_hash, host, packets_tp_, all_packets_stats_, pbft_syncing_state_, db,
-        pbft_mgr, pbft_chain, vote_mgr, dag_mgr, trx_mgr, slashing_manager, pillar_chain_mgr, final_chain,
-        network::tarcap::TaraxaCapability::kInitV5VersionHandlers);
+        TARAXA_NET_VERSION - 1, config, genesis_hash, host, packets_tp_, all_packets_stats_, compression_stats_,
+        upload_bandwidth_, pbft_syncing_state_, db, pbft_mgr, pbft_chain, vote_mgr, dag_mgr, trx_mgr, slashing_manager,
+        pillar_chain_mgr, final_chain, network::tarcap::TaraxaCapability::kInitV5VersionHandlers);
     capabilities.emplace_back(v5_tarcap);
 
     return capabilities;
@@ -98,11 +131,18 @@ Network::Network(const FullNodeConfig &config, const h256 &genesis_hash, const s
     auto tarcap = std::static_pointer_cast<network::tarcap::TaraxaCapability>(cap.second.ref);
     tarcaps_[tarcap_version] = std::move(tarcap);
   }
+  if (!config.network.packets_capture_path.empty()) {
+    // Shared by all versions, so packets of every peer end up in a single log
+    const auto capture = std::make_shared<network::tarcap::PacketsCapture>(config.network.packets_capture_path);
+    for (const auto &tarcap : tarcaps_) {
+      tarcap.second->setPacketsCapture(capture);
+    }
+  }
 
   addBootNodes(true);
 
   // Register periodic events. Must be called after full init of tarcaps
-  registerPeriodicEvents(trx_mgr);
+  registerPeriodicEvents(trx_mgr, pbft_chain, final_chain);
 
   for (uint i = 0; i < tp_.capacity(); ++i) {
     tp_.post_loop({100 + i * 20}, [this] { while (0 < host_->do_work()); });
@@ -128,10 +168,25 @@ void Network::start() {
 
 bool Network::isStarted() { return tp_.is_running(); }
 
-bool Network::packetQueueOverLimit() const {
-  auto [hp_queue_size, mp_queue_size, lp_queue_size] = packets_tp_->getQueueSize();
-  auto total_size = hp_queue_size + mp_queue_size + lp_queue_size;
-  return total_size > kConf.network.ddos_protection.max_packets_queue_size;
+network::tarcap::LoadLevel Network::loadLevel() const { return node_load_.level(); }
+
+uint32_t Network::getTransactionInterval() const { return transaction_interval_ms_; }
+
+void Network::setTransactionInterval(uint32_t interval_ms) {
+  assert(interval_ms);
+  // Next run of the gossip loop is already scheduled with the previous interval
+  transaction_interval_ms_ = interval_ms;
+}
+
+uint16_t Network::getSyncLevelSize() const { return static_cast<uint16_t>(pbft_syncing_state_->syncLevelSize()); }
+
+void Network::setSyncLevelSize(uint16_t sync_level_size) {
+  assert(sync_level_size);
+  pbft_syncing_state_->setSyncLevelSize(sync_level_size);
+}
+
+void Network::replayPacket(network::tarcap::PacketsCapture::Record &&record) {
+  tarcaps_.begin()->second->replayPacket(std::move(record));
 }
 
 std::list<dev::p2p::NodeEntry> Network::getAllNodes() const { return host_->getNodes(); }
@@ -153,14 +208,38 @@ Json::Value Network::getStatus() {
 
 bool Network::pbft_syncing() { return pbft_syncing_state_->isPbftSyncing(); }
 
+size_t Network::peersCachesMemoryUsage() const {
+  size_t bytes = 0;
+  for (const auto &tarcap : tarcaps_) {
+    for (const auto &peer : tarcap.second->getPeersState()->getAllPeers()) {
+      bytes += peer.second->knownCachesMemoryUsage();
+    }
+  }
+  return bytes;
+}
+
 uint64_t Network::syncTimeSeconds() const {
   // TODO: this should be probably part of syncing_state, not node_stats
   return node_stats_->syncTimeSeconds();
 }
 
+std::vector<network::tarcap::PacketsCompressionStats::PacketTypeStats> Network::getPacketsCompressionStats() const {
+  return compression_stats_->getStats();
+}
+
+const std::shared_ptr<network::tarcap::UploadBandwidthManager> &Network::getUploadBandwidthManager() const {
+  return upload_bandwidth_;
+}
+
+const std::shared_ptr<network::threadpool::PacketsThreadPool> &Network::getPacketsThreadPool() const {
+  return packets_tp_;
+}
+
 void Network::setSyncStatePeriod(PbftPeriod period) { pbft_syncing_state_->setSyncStatePeriod(period); }
 
-void Network::registerPeriodicEvents(std::shared_ptr<TransactionManager> trx_mgr) {
+void Network::registerPeriodicEvents(std::shared_ptr<TransactionManager> trx_mgr,
+                                     std::shared_ptr<PbftChain> pbft_chain,
+                                     std::shared_ptr<final_chain::FinalChain> final_chain) {
   auto getAllPeers = [this]() {
     std::vector<std::shared_ptr<network::tarcap::TaraxaPeer>> all_peers;
     for (auto &tarcap : tarcaps_) {
@@ -172,26 +251,91 @@ void Network::registerPeriodicEvents(std::shared_ptr<TransactionManager> trx_mgr
     return all_peers;
   };
 
-  // Send new transactions
-  auto sendTxs = [this, trx_mgr = trx_mgr]() {
-    for (auto &tarcap : tarcaps_) {
-      auto tx_packet_handler = tarcap.second->getSpecificHandler<network::tarcap::ITransactionPacketHandler>(
-          network::SubprotocolPacketType::kTransactionPacket);
-      tx_packet_handler->periodicSendTransactions(trx_mgr->getAllPoolTrxs());
+  // Handlers live as long as their tarcaps, so periodic tasks hold them directly
+  std::vector<std::shared_ptr<network::tarcap::ITransactionPacketHandler>> tx_packet_handlers;
+  std::vector<std::shared_ptr<network::tarcap::ISyncPacketHandler>> status_packet_handlers;
+  for (auto &tarcap : tarcaps_) {
+    tx_packet_handlers.push_back(
+        tarcap.second->getSpecificHandler<network::SubprotocolPacketType::kTransactionPacket>());
+    status_packet_handlers.push_back(
+        tarcap.second->getSpecificHandler<network::SubprotocolPacketType::kStatusPacket>());
+  }
+
+  // Update node load level
+  auto updateNodeLoad = [this, trx_mgr, pbft_chain = std::move(pbft_chain), final_chain = std::move(final_chain)]() {
+    network::tarcap::NodeLoad::Sample sample;
+    const auto [hp_queue_size, mp_queue_size, lp_queue_size] = packets_tp_->getQueueSize();
+    sample.queued_packets = hp_queue_size + mp_queue_size + lp_queue_size;
+    sample.avg_packet_queue_wait = packets_tp_->getAvgQueueWait();
+    sample.period_data_queue_bytes = pbft_mgr_->periodDataQueueMemoryUsage();
+    const auto finalized_period = pbft_chain->getPbftChainSize();
+    const auto executed_period = final_chain->lastBlockNumber();
+    sample.finalization_lag = finalized_period > executed_period ? finalized_period - executed_period : 0;
+    sample.transactions_pool_size = trx_mgr->getTransactionPoolSize();
+
+    const auto prev_level = node_load_.level();
+    if (const auto level = node_load_.update(sample); level != prev_level) {
+      LOG(log_nf_) << "Node load " << network::tarcap::toString(prev_level) << " -> "
+                   << network::tarcap::toString(level) << ", queued packets: " << sample.queued_packets
+                   << ", avg packet queue wait: " << sample.avg_packet_queue_wait.count()
+                   << " us, period data queue: " << sample.period_data_queue_bytes
+                   << " bytes, finalization lag: " << sample.finalization_lag
+                   << ", transactions pool: " << sample.transactions_pool_size;
     }
   };
-  periodic_events_tp_.post_loop({kConf.network.transaction_interval_ms}, sendTxs);
+  periodic_events_tp_.post_loop({kNodeLoadUpdateIntervalMs}, updateNodeLoad);
+
+  // Send new transactions, under load they are sent less often in bigger batches
+  auto sendTxs = [this, tx_packet_handlers = std::move(tx_packet_handlers), trx_mgr = trx_mgr,
+                  round = uint64_t{0}]() mutable {
+    const auto skipped_rounds_mask = (uint64_t{1} << static_cast<uint8_t>(loadLevel())) - 1;
+    if (round++ & skipped_rounds_mask) {
+      return;
+    }
+    for (const auto &tx_packet_handler : tx_packet_handlers) {
+      tx_packet_handler->periodicSendTransactions(
+          [&trx_mgr](uint64_t sequence) { return trx_mgr->getPoolTrxsInsertedAfter(sequence); });
+    }
+  };
+  periodic_events_tp_.post_loop([this] { return transaction_interval_ms_.load(); }, sendTxs);
+
+  // Reconcile transactions pools, peers are checked more often than the interval so new peers are reconciled soon
+  if (const auto interval_ms = kConf.network.transactions_reconciliation_interval_ms) {
+    // Only peers of the latest version support reconciliation
+    using network::SubprotocolPacketType;
+    auto reconciliation_handler =
+        tarcaps_.begin()->second->getSpecificHandler<SubprotocolPacketType::kTransactionsReconciliationPacket>();
+    auto sendSketches = [handler = std::move(reconciliation_handler), interval_ms]() {
+      handler->periodicSendSketches(interval_ms);
+    };
+    periodic_events_tp_.post_loop({std::min<uint64_t>(interval_ms, kReconciliationCheckIntervalMs)}, sendSketches);
+  }
 
   // Send status packet
-  auto sendStatus = [this]() {
-    for (auto &tarcap : tarcaps_) {
-      auto status_packet_handler = tarcap.second->getSpecificHandler<network::tarcap::ISyncPacketHandler>(
-          network::SubprotocolPacketType::kStatusPacket);
+  auto sendStatus = [status_packet_handlers = std::move(status_packet_handlers)]() {
+    for (const auto &status_packet_handler : status_packet_handlers) {
       status_packet_handler->sendStatusToPeers();
     }
   };
   periodic_events_tp_.post_loop({4000}, sendStatus);
 
+  // Update peers latencies measured by p2p pings, they are used to order votes gossip
+  auto updatePeersLatency = [this]() {
+    for (const auto &[id, latency] : host_->peersLatency()) {
+      if (auto peer = getPeer(id)) {
+        peer->ping_rtt_us_ = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+        peer->decayGossipStats();
+      }
+    }
+  };
+  periodic_events_tp_.post_loop({10000}, updatePeersLatency);
+
+  // Adjust number of packets processing workers to the load
+  if (kConf.network.packets_processing_scaling) {
+    periodic_events_tp_.post_loop({kConf.network.packets_processing_scaling->interval_ms},
+                                  [packets_tp = packets_tp_]() { packets_tp->scaleWorkers(); });
+  }
+
   // Check nodes connections and refresh boot nodes
   auto checkNodesConnections = [this]() {
     // If node count drops to zero add boot nodes again and retry
@@ -286,34 +430,30 @@ void Network::addBootNodes(bool initial) {
 
 void Network::gossipDagBlock(const std::shared_ptr<DagBlock> &block, bool proposed, const SharedTransactions &trxs) {
   for (const auto &tarcap : tarcaps_) {
-    auto dag_block_packet_handler = tarcap.second->getSpecificHandler<network::tarcap::IDagBlockPacketHandler>(
-        network::SubprotocolPacketType::kDagBlockPacket);
-    dag_block_packet_handler->onNewBlockVerified(block, proposed, trxs);
+    tarcap.second->getSpecificHandler<network::SubprotocolPacketType::kDagBlockPacket>()->onNewBlockVerified(
+        block, proposed, trxs);
   }
 }
 
 void Network::gossipVote(const std::shared_ptr<PbftVote> &vote, const std::shared_ptr<PbftBlock> &block,
                          bool rebroadcast) {
   for (const auto &tarcap : tarcaps_) {
-    auto vote_packet_handler = tarcap.second->getSpecificHandler<network::tarcap::IVotePacketHandler>(
-        network::SubprotocolPacketType::kVotePacket);
-    vote_packet_handler->onNewPbftVote(vote, block, rebroadcast);
+    tarcap.second->getSpecificHandler<network::SubprotocolPacketType::kVotePacket>()->onNewPbftVote(vote, block,
+                                                                                                   rebroadcast);
   }
 }
 
 void Network::gossipVotesBundle(const std::vector<std::shared_ptr<PbftVote>> &votes, bool rebroadcast) {
   for (const auto &tarcap : tarcaps_) {
-    tarcap.second
-        ->getSpecificHandler<network::tarcap::IVotePacketHandler>(network::SubprotocolPacketType::kVotesBundlePacket)
-        ->onNewPbftVotesBundle(votes, rebroadcast);
+    tarcap.second->getSpecificHandler<network::SubprotocolPacketType::kVotesBundlePacket>()->onNewPbftVotesBundle(
+        votes, rebroadcast);
   }
 }
 
 void Network::gossipPillarBlockVote(const std::shared_ptr<PillarVote> &vote, bool rebroadcast) {
   for (const auto &tarcap : tarcaps_) {
-    auto pillar_vote_packet_handler = tarcap.second->getSpecificHandler<network::tarcap::IPillarVotePacketHandler>(
-        network::SubprotocolPacketType::kPillarVotePacket);
-    pillar_vote_packet_handler->onNewPillarVote(vote, rebroadcast);
+    tarcap.second->getSpecificHandler<network::SubprotocolPacketType::kPillarVotePacket>()->onNewPillarVote(
+        vote, rebroadcast);
   }
 }
 
@@ -364,12 +504,46 @@ void Network::requestPillarBlockVotesBundle(taraxa::PbftPeriod period, const tar
     }
 
     auto get_pillar_votes_bundle_packet_handler =
-        tarcap.second->getSpecificHandler<network::tarcap::IGetPillarVotesBundlePacketHandler>(
-            network::SubprotocolPacketType::kGetPillarVotesBundlePacket);
+        tarcap.second->getSpecificHandler<network::SubprotocolPacketType::kGetPillarVotesBundlePacket>();
     get_pillar_votes_bundle_packet_handler->requestPillarVotesBundle(period, pillar_block_hash, peer);
   }
 }
 
+bool Network::fetchHistoricalBlock(PbftPeriod period,
+                                   const std::function<bool(const final_chain::HistoricalBlock &)> &verify) {
+  // Only peers of the latest version serve historical blocks
+  const auto &tarcap = tarcaps_.begin()->second;
+  std::vector<std::shared_ptr<network::tarcap::TaraxaPeer>> peers;
+  for (const auto &[id, peer] : tarcap->getPeersState()->getAllPeers()) {
+    if (peer->pbft_chain_size_ < period) {
+      continue;
+    }
+    // Light peer still has the block if it is within its kept history
+    if (peer->peer_light_node && period + peer->peer_light_node_history <= peer->pbft_chain_size_) {
+      continue;
+    }
+    peers.push_back(peer);
+  }
+  std::shuffle(peers.begin(), peers.end(), std::mt19937{std::random_device{}()});
+  if (peers.size() > kHistoricalBlockMaxPeers) {
+    peers.resize(kHistoricalBlockMaxPeers);
+  }
+
+  auto handler = tarcap->getSpecificHandler<network::SubprotocolPacketType::kGetHistoricalBlockPacket>();
+  for (const auto &peer : peers) {
+    auto response = handler->requestHistoricalBlock(period, peer);
+    if (response.wait_for(kHistoricalBlockTimeout) != std::future_status::ready) {
+      handler->cancelRequest(period, peer);
+      continue;
+    }
+    if (const auto &block = response.get(); block && verify(*block)) {
+      return true;
+    }
+    LOG(log_dg_) << "Historical block " << period << " not served by peer " << peer->getId();
+  }
+  return false;
+}
+
 // METHODS USED IN TESTS ONLY
 // Note: for functions use in tests all data are fetched only from the tarcap with the highest version,
 //       other functions must use all tarcaps
@@ -1,8 +1,11 @@
 #include "network/subscriptions.hpp"
 
 #include <libdevcore/CommonJS.h>
+#include <libdevcore/RLP.h>
 
+#include <algorithm>
 #include <mutex>
+#include <optional>
 
 #include "common/jsoncpp.hpp"
 
@@ -28,80 +31,225 @@ bool Subscriptions::removeSubscription(int id) {
   return true;
 }
 
-void Subscriptions::process(SubscriptionType type, const Json::Value& payload) {
+SubscriptionPayload::SubscriptionPayload(Json::Value json, std::shared_ptr<const std::string> serialized,
+                                         std::shared_ptr<const std::string> rlp,
+                                         std::shared_ptr<const SubscriptionPayload> reduced)
+    : json_(std::move(json)), reduced_(std::move(reduced)) {
+  std::call_once(serialized_flag_, [&] { serialized_ = std::move(serialized); });
+  std::call_once(rlp_flag_, [&] { rlp_ = std::move(rlp); });
+}
+
+const std::shared_ptr<const std::string>& SubscriptionPayload::serialized() const {
+  std::call_once(serialized_flag_, [this] { serialized_ = std::make_shared<const std::string>(util::to_string(json_)); });
+  return serialized_;
+}
+
+const std::shared_ptr<const std::string>& SubscriptionPayload::rlp() const {
+  std::call_once(rlp_flag_, [this] {
+    if (rlp_encoder_) {
+      const auto encoded = rlp_encoder_();
+      rlp_ = std::make_shared<const std::string>(encoded.begin(), encoded.end());
+    }
+  });
+  return rlp_;
+}
+
+void Subscriptions::process(SubscriptionType type, const SubscriptionPayload& payload) {
   for (auto id : subscriptions_by_type_[type]) {
-    send_(subscriptions_[id]->processPayload(payload));
+    if (auto message = subscriptions_[id]->processPayload(payload); message.size()) {
+      send_(std::move(message));
+    }
   }
 }
-void Subscriptions::processLogs(const final_chain::BlockHeader& header, TransactionHashes trx_hashes,
-                                const TransactionReceipts& receipts) {
+void Subscriptions::collectLogsSubscriptions(LogsSubscriptionsIndex& index) {
+  std::lock_guard<std::mutex> lock(subscriptions_mutex_);
   for (auto id : subscriptions_by_type_[SubscriptionType::LOGS]) {
-    auto sub = std::dynamic_pointer_cast<LogsSubscription>(subscriptions_[id]);
-    if (!sub) {
-      continue;
+    if (auto sub = std::dynamic_pointer_cast<const LogsSubscription>(subscriptions_[id])) {
+      index.add(std::move(sub), send_);
     }
+  }
+}
 
-    auto filter = sub->getFilter();
-    if (!filter.matches(header.log_bloom)) {
+void LogsSubscriptionsIndex::add(std::shared_ptr<const LogsSubscription> subscription, const Send& send) {
+  const auto& filter = subscription->getFilter();
+  subscriptions_count_++;
+  if (!filter.addresses().empty()) {
+    for (const auto& address : filter.addresses()) {
+      by_address_[address].push_back({subscription, &send});
+    }
+    return;
+  }
+
+  const auto& topics = filter.topics();
+  for (size_t i = 0; i < topics.size(); ++i) {
+    if (topics[i].empty()) {
       continue;
     }
+    for (const auto& topic : topics[i]) {
+      by_topic_[i][topic].push_back({subscription, &send});
+    }
+    return;
+  }
+
+  any_.push_back({std::move(subscription), &send});
+}
+
+void LogsSubscriptionsIndex::process(const final_chain::BlockHeader& header, const TransactionHashes& trx_hashes,
+                                     const TransactionReceipts& receipts) const {
+  if (empty()) {
+    return;
+  }
 
-    uint32_t idx = 0;
-    for (const auto& receipt : receipts) {
-      rpc::eth::ExtendedTransactionLocation loc{{{header.number, idx}, header.hash}, trx_hashes[idx]};
-      filter.match_one(loc, receipt,
-                       [&](const rpc::eth::LocalisedLogEntry& le) { send_(sub->processPayload(toJson(le))); });
+  for (uint32_t idx = 0; idx < receipts.size(); ++idx) {
+    const rpc::eth::ExtendedTransactionLocation loc{{{header.number, idx}, header.hash}, trx_hashes[idx]};
+    const auto& logs = receipts[idx].logs;
+    for (size_t log_i = 0; log_i < logs.size(); ++log_i) {
+      const auto& log = logs[log_i];
+      std::optional<SubscriptionPayload> payload;
+      auto notify = [&](const std::vector<Entry>& entries) {
+        for (const auto& entry : entries) {
+          const auto& filter = entry.subscription->getFilter();
+          if (!filter.blk_number_matches(header.number) || !filter.matches(log)) {
+            continue;
+          }
+          if (!payload) {
+            payload.emplace(toJson(rpc::eth::LocalisedLogEntry{log, loc, log_i}));
+          }
+          (*entry.send)(entry.subscription->processPayload(*payload));
+        }
+      };
+
+      // Every subscription is stored under keys that can't both match a single log, so each is notified at most once
+      if (const auto it = by_address_.find(log.address); it != by_address_.end()) {
+        notify(it->second);
+      }
+      for (size_t i = 0; i < std::min(log.topics.size(), by_topic_.size()); ++i) {
+        if (const auto it = by_topic_[i].find(log.topics[i]); it != by_topic_[i].end()) {
+          notify(it->second);
+        }
+      }
+      notify(any_);
     }
   }
 }
 
-std::string makeEthSubscriptionResponse(int id, const Json::Value& payload) {
-  Json::Value params;
-  params["result"] = payload;
-  params["subscription"] = dev::toJS(id);
-  Json::Value res;
-  res["jsonrpc"] = "2.0";
-  res["method"] = "eth_subscription";
-  res["params"] = params;
+// Envelope is the same as util::to_string of {"jsonrpc", "method", "params": {"result", "subscription"}} object
+WsMessage makeEthSubscriptionResponse(int id, std::shared_ptr<const std::string> payload) {
+  return WsMessage(R"({"jsonrpc":"2.0","method":"eth_subscription","params":{"result":)", std::move(payload),
+                   R"(,"subscription":")" + dev::toJS(id) + R"("}})", id);
+}
+
+WsMessage makeEthSubscriptionResponse(int id, const Json::Value& payload) {
+  return makeEthSubscriptionResponse(id, std::make_shared<const std::string>(util::to_string(payload)));
+}
+
+WsMessage makeRlpSubscriptionResponse(int id, std::shared_ptr<const std::string> payload) {
+  const auto id_rlp = dev::rlp(id);
+  // List prefix is written by hand, so the shared payload does not have to be copied into a stream
+  const auto payload_size = id_rlp.size() + payload->size();
+  std::string prefix;
+  if (payload_size < dev::c_rlpListImmLenCount) {
+    prefix.push_back(static_cast<char>(dev::c_rlpListStart + payload_size));
+  } else {
+    const auto size_bytes = dev::toCompactBigEndian(payload_size);
+    prefix.push_back(static_cast<char>(dev::c_rlpListIndLenZero + size_bytes.size()));
+    prefix.append(size_bytes.begin(), size_bytes.end());
+  }
+  prefix.append(id_rlp.begin(), id_rlp.end());
 
-  return util::to_string(res);
+  WsMessage message(std::move(prefix), std::move(payload), {}, id);
+  message.binary = true;
+  return message;
 }
 
-std::string HeadsSubscription::processPayload(Json::Value payload) const {
-  return makeEthSubscriptionResponse(id_, payload);
+WsMessage HeadsSubscription::processPayload(const SubscriptionPayload& payload) const {
+  if (encoding_ == SubscriptionEncoding::Rlp && payload.rlp()) {
+    return makeRlpSubscriptionResponse(id_, payload.rlp());
+  }
+  return makeEthSubscriptionResponse(id_, payload.serialized());
 }
 
-std::string DagBlocksSubscription::processPayload(Json::Value payload) const {
+WsMessage DagBlocksSubscription::processPayload(const SubscriptionPayload& payload) const {
   if (!full_data_) {
-    payload = payload["hash"];
+    return makeEthSubscriptionResponse(id_, payload.json()["hash"]);
+  }
+  return makeEthSubscriptionResponse(id_, payload.serialized());
+}
+
+WsMessage TransactionsSubscription::processPayload(const SubscriptionPayload& payload) const {
+  if (encoding_ == SubscriptionEncoding::Rlp && payload.rlp()) {
+    return makeRlpSubscriptionResponse(id_, payload.rlp());
+  }
+  return makeEthSubscriptionResponse(id_, payload.serialized());
+}
+
+size_t TransactionsBatchSubscription::take(size_t count) const {
+  if (!kMaxPerSecond) {
+    return count;
   }
-  return makeEthSubscriptionResponse(id_, payload);
+  std::lock_guard lock(rate_mutex_);
+  const auto now = std::chrono::steady_clock::now();
+  const std::chrono::duration<double> elapsed = now - refilled_at_;
+  tokens_ = std::min<double>(kMaxPerSecond, tokens_ + elapsed.count() * kMaxPerSecond);
+  refilled_at_ = now;
+  const auto taken = std::min<size_t>(count, tokens_);
+  tokens_ -= taken;
+  return taken;
 }
 
-std::string TransactionsSubscription::processPayload(Json::Value payload) const {
-  return makeEthSubscriptionResponse(id_, payload);
+WsMessage TransactionsBatchSubscription::processPayload(const SubscriptionPayload& payload) const {
+  const auto& hashes = payload.json();
+  const auto count = take(hashes.size());
+  if (!count) {
+    return {};
+  }
+
+  const bool rlp = encoding_ == SubscriptionEncoding::Rlp && payload.rlp();
+  if (count == hashes.size()) {
+    if (rlp) {
+      return makeRlpSubscriptionResponse(id_, payload.rlp());
+    }
+    return makeEthSubscriptionResponse(id_, payload.serialized());
+  }
+
+  // Batch was cut by the rate cap, this session gets its own shorter copy
+  if (rlp) {
+    dev::RLPStream encoding(count);
+    for (Json::ArrayIndex i = 0; i < count; ++i) {
+      encoding << trx_hash_t(hashes[i].asString());
+    }
+    const auto& out = encoding.out();
+    return makeRlpSubscriptionResponse(id_, std::make_shared<const std::string>(out.begin(), out.end()));
+  }
+  Json::Value cut(Json::arrayValue);
+  for (Json::ArrayIndex i = 0; i < count; ++i) {
+    cut.append(hashes[i]);
+  }
+  return makeEthSubscriptionResponse(id_, cut);
 }
 
-std::string DagBlockFinalizedSubscription::processPayload(Json::Value payload) const {
-  return makeEthSubscriptionResponse(id_, payload);
+WsMessage DagBlockFinalizedSubscription::processPayload(const SubscriptionPayload& payload) const {
+  return makeEthSubscriptionResponse(id_, payload.serialized());
 }
 
-std::string PbftBlockExecutedSubscription::processPayload(Json::Value payload) const {
+WsMessage PbftBlockExecutedSubscription::processPayload(const SubscriptionPayload& payload) const {
   if (!full_block_) {
-    payload = payload["block_hash"];
+    return makeEthSubscriptionResponse(id_, payload.json()["block_hash"]);
   }
-  return makeEthSubscriptionResponse(id_, payload);
+  return makeEthSubscriptionResponse(id_, payload.serialized());
 }
 
-std::string PillarBlockSubscription::processPayload(Json::Value payload) const {
-  if (!include_signatures_) {
-    payload.removeMember("signatures");
+WsMessage PillarBlockSubscription::processPayload(const SubscriptionPayload& payload) const {
+  // Pillar blocks are notified with payload without signatures as reduced one, both serialized when finalized
+  const auto& data = include_signatures_ ? payload : payload.reduced();
+  if (encoding_ == SubscriptionEncoding::Rlp && data.rlp()) {
+    return makeRlpSubscriptionResponse(id_, data.rlp());
   }
-  return makeEthSubscriptionResponse(id_, payload);
+  return makeEthSubscriptionResponse(id_, data.serialized());
 }
 
-std::string LogsSubscription::processPayload(Json::Value payload) const {
-  return makeEthSubscriptionResponse(id_, payload);
+WsMessage LogsSubscription::processPayload(const SubscriptionPayload& payload) const {
+  return makeEthSubscriptionResponse(id_, payload.serialized());
 }
 
-}  // namespace taraxa::net
\ No newline at end of file
+}  // namespace taraxa::net
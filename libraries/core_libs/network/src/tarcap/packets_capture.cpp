@@ -0,0 +1,77 @@
+#include "network/tarcap/packets_capture.hpp"
+
+#include <stdexcept>
+
+namespace taraxa::network::tarcap {
+
+namespace {
+
+template <class T>
+void writeValue(std::ofstream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <class T>
+bool readValue(std::ifstream& in, T& value) {
+  return bool(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+}  // namespace
+
+PacketsCapture::PacketsCapture(const std::filesystem::path& path) {
+  const bool is_new = !std::filesystem::exists(path) || std::filesystem::file_size(path) == 0;
+  out_.open(path, std::ios::binary | std::ios::app);
+  if (!out_) {
+    throw std::runtime_error("Unable to open packets capture file " + path.string());
+  }
+  if (is_new) {
+    out_.write(kMagic.data(), kMagic.size());
+  }
+}
+
+PacketsCapture::~PacketsCapture() {
+  std::scoped_lock lock(mutex_);
+  out_.flush();
+}
+
+void PacketsCapture::record(SubprotocolPacketType type, const dev::p2p::NodeID& peer, dev::bytesConstRef rlp) {
+  const uint64_t time_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                               std::chrono::system_clock::now().time_since_epoch())
+                               .count();
+  const auto packet_type = static_cast<uint8_t>(type);
+  const auto size = static_cast<uint32_t>(rlp.size());
+
+  std::scoped_lock lock(mutex_);
+  writeValue(out_, time_us);
+  writeValue(out_, packet_type);
+  out_.write(reinterpret_cast<const char*>(peer.data()), dev::p2p::NodeID::size);
+  writeValue(out_, size);
+  out_.write(reinterpret_cast<const char*>(rlp.data()), size);
+}
+
+PacketsCapture::Reader::Reader(const std::filesystem::path& path) : in_(path, std::ios::binary) {
+  std::string magic(kMagic.size(), '\0');
+  if (!in_ || !in_.read(magic.data(), magic.size()) || magic != kMagic) {
+    throw std::runtime_error(path.string() + " is not a packets capture file");
+  }
+}
+
+std::optional<PacketsCapture::Record> PacketsCapture::Reader::next() {
+  Record record;
+  uint64_t time_us = 0;
+  uint8_t packet_type = 0;
+  uint32_t size = 0;
+  if (!readValue(in_, time_us) || !readValue(in_, packet_type) ||
+      !in_.read(reinterpret_cast<char*>(record.peer.data()), dev::p2p::NodeID::size) || !readValue(in_, size)) {
+    return {};
+  }
+  record.rlp.resize(size);
+  if (!in_.read(reinterpret_cast<char*>(record.rlp.data()), size)) {
+    return {};
+  }
+  record.time = std::chrono::microseconds(time_us);
+  record.type = static_cast<SubprotocolPacketType>(packet_type);
+  return record;
+}
+
+}  // namespace taraxa::network::tarcap
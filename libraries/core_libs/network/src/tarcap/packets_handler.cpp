@@ -3,15 +3,13 @@
 namespace taraxa::network::tarcap {
 
 const std::shared_ptr<BasePacketHandler>& PacketsHandler::getSpecificHandler(SubprotocolPacketType packet_type) const {
-  auto selected_handler = packets_handlers_.find(packet_type);
-
-  if (selected_handler == packets_handlers_.end()) {
+  if (packet_type >= SubprotocolPacketType::kPacketCount || !packets_handlers_[packet_type]) {
     assert(false);
 
     throw std::runtime_error("No registered packet handler for packet type: " + std::to_string(packet_type));
   }
 
-  return selected_handler->second;
+  return packets_handlers_[packet_type];
 }
 
-}  // namespace taraxa::network::tarcap
\ No newline at end of file
+}  // namespace taraxa::network::tarcap
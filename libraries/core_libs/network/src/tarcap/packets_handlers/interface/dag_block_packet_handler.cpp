@@ -37,6 +37,9 @@ void IDagBlockPacketHandler::onNewBlockVerified(const std::shared_ptr<DagBlock>
     return;
   }
 
+  // Block part of the packet is the same for all peers, only the transactions differ
+  const auto block_rlp = block->rlp(true);
+
   std::string peer_and_transactions_to_log;
   uint32_t start_with = rand() % peers_to_send_count;
   for (uint32_t i = 0; i < peers_to_send_count; i++) {
@@ -60,7 +63,7 @@ void IDagBlockPacketHandler::onNewBlockVerified(const std::shared_ptr<DagBlock>
       peer_and_transactions_to_log += trx_hash.abridged();
     }
 
-    sendBlockWithTransactions(peer, block, std::move(transactions_to_send));
+    sendBlockWithTransactions(peer, block, block_rlp, std::move(transactions_to_send));
   }
 
   LOG(log_dg_) << "Send DagBlock " << block->getHash() << " to peers: " << peer_and_transactions_to_log;
@@ -1,5 +1,7 @@
 #include "network/tarcap/packets_handlers/interface/sync_packet_handler.hpp"
 
+#include <unordered_set>
+
 #include "config/version.hpp"
 #include "network/tarcap/packets/latest/get_pbft_sync_packet.hpp"
 #include "network/tarcap/packets/latest/status_packet.hpp"
@@ -23,7 +25,8 @@ void ISyncPacketHandler::startSyncingPbft() {
     return;
   }
 
-  std::shared_ptr<TaraxaPeer> peer = peers_state_->getMaxChainPeer(pbft_mgr_);
+  std::shared_ptr<TaraxaPeer> peer = peers_state_->getMaxChainPeer(
+      pbft_mgr_, [this](const std::shared_ptr<TaraxaPeer>& candidate) { return isSyncSource(*candidate); });
   if (!peer) {
     LOG(this->log_nf_) << "Restarting syncing PBFT not possible since no connected peers";
     return;
@@ -40,7 +43,7 @@ void ISyncPacketHandler::startSyncingPbft() {
     LOG(this->log_si_) << "Restarting syncing PBFT from peer " << peer_id << ", peer PBFT chain size "
                        << peer_pbft_chain_size << ", own PBFT chain synced at period " << pbft_sync_period;
 
-    if (syncPeerPbft(pbft_sync_period + 1)) {
+    if (requestPbftSyncWindows()) {
       // Disable snapshots only if are syncing from scratch
       if (pbft_syncing_state_->isDeepPbftSyncing()) {
         db_->disableSnapshots();
@@ -56,22 +59,97 @@ void ISyncPacketHandler::startSyncingPbft() {
   }
 }
 
-bool ISyncPacketHandler::syncPeerPbft(PbftPeriod request_period) {
+bool ISyncPacketHandler::requestPbftSyncWindows() {
   const auto syncing_peer = pbft_syncing_state_->syncingPeer();
   if (!syncing_peer) {
     LOG(this->log_er_) << "Unable to send GetPbftSyncPacket. No syncing peer set.";
     return false;
   }
 
-  if (request_period > syncing_peer->pbft_chain_size_) {
-    LOG(this->log_wr_) << "Invalid syncPeerPbft argument. Node " << syncing_peer->getId() << " chain size "
-                       << syncing_peer->pbft_chain_size_ << ", requested period " << request_period;
-    return false;
+  // Peers that did not deliver their window in time are not asked again in this round
+  std::unordered_set<dev::p2p::NodeID> busy_peers;
+  for (const auto& window : pbft_syncing_state_->takeStalledSyncWindows()) {
+    LOG(this->log_wr_) << "Pbft sync window " << window.from << " - " << window.to << " stalled at period "
+                       << window.next << " from peer " << window.peer_id << ", requesting it from another peer";
+    busy_peers.insert(window.peer_id);
+  }
+
+  auto windows = pbft_syncing_state_->syncWindows();
+  for (const auto& window : windows) {
+    busy_peers.insert(window.peer_id);
   }
 
-  LOG(this->log_nf_) << "Send GetPbftSyncPacket with period " << request_period << " to node " << syncing_peer->getId();
-  return this->sealAndSend(syncing_peer->getId(), SubprotocolPacketType::kGetPbftSyncPacket,
-                           encodePacketRlp(GetPbftSyncPacket{request_period}));
+  const PbftPeriod sync_level_size = pbft_syncing_state_->syncLevelSize();
+  const PbftPeriod syncing_peer_chain_size = syncing_peer->pbft_chain_size_;
+  // Do not request windows too far ahead of the processing
+  const PbftPeriod max_period = pbft_chain_->getPbftChainSize() + 10 * sync_level_size;
+  const auto all_peers = peers_state_->getAllPeers();
+
+  auto it = windows.begin();
+  PbftPeriod from = pbft_mgr_->pbftSyncingPeriod() + 1;
+  while (windows.size() < kConf.network.sync_max_peers && from <= syncing_peer_chain_size) {
+    // Skip ranges that are already requested
+    if (it != windows.end() && it->from <= from) {
+      from = std::max(from, it->to + 1);
+      ++it;
+      continue;
+    }
+    if (!windows.empty() && (from > max_period || isSyncQueueOverMemoryBudget())) {
+      break;
+    }
+
+    PbftPeriod to = from + sync_level_size - 1;
+    if (it != windows.end()) {
+      to = std::min(to, it->from - 1);
+    }
+
+    std::shared_ptr<TaraxaPeer> peer;
+    if (to >= syncing_peer_chain_size) {
+      // Last window is requested only from the syncing peer as it sends also cert votes of its latest block
+      if (!busy_peers.contains(syncing_peer->getId())) {
+        peer = syncing_peer;
+      }
+    } else if (!busy_peers.contains(syncing_peer->getId())) {
+      peer = syncing_peer;
+    } else {
+      for (const auto& [peer_id, candidate] : all_peers) {
+        // Peer chain must be longer than window so the window does not end with the peer's latest block
+        if (busy_peers.contains(peer_id) || !isSyncSource(*candidate) || candidate->pbft_chain_size_ <= to ||
+            (candidate->peer_light_node && candidate->pbft_chain_size_ >= from + candidate->peer_light_node_history)) {
+          continue;
+        }
+        peer = candidate;
+        break;
+      }
+    }
+    if (!peer) {
+      break;
+    }
+
+    LOG(this->log_nf_) << "Send GetPbftSyncPacket with period " << from << " - " << to << " to node "
+                       << peer->getId();
+    busy_peers.insert(peer->getId());
+    if (!this->sealAndSend(peer->getId(), SubprotocolPacketType::kGetPbftSyncPacket,
+                           encodePacketRlp(GetPbftSyncPacket{from}))) {
+      continue;
+    }
+
+    PbftSyncingState::SyncWindow window{from, to, from, peer->getId(), std::chrono::steady_clock::now()};
+    pbft_syncing_state_->addSyncWindow(window);
+    it = std::next(windows.insert(it, std::move(window)));
+    from = to + 1;
+  }
+
+  return !windows.empty();
+}
+
+bool ISyncPacketHandler::isSyncQueueOverMemoryBudget() const {
+  const uint64_t max_bytes = uint64_t(kConf.network.sync_queue_max_mb) * 1024 * 1024;
+  return max_bytes && pbft_mgr_->periodDataQueueMemoryUsage() >= max_bytes;
+}
+
+bool ISyncPacketHandler::isSyncSource(const TaraxaPeer& peer) const {
+  return !kConf.network.follower || kConf.network.follower->upstream_nodes.contains(peer.getId());
 }
 
 void ISyncPacketHandler::sendStatusToPeers() {
@@ -1,15 +1,40 @@
 #include "network/tarcap/packets_handlers/interface/transaction_packet_handler.hpp"
 
+#include <cmath>
+#include <random>
+
 namespace taraxa::network::tarcap {
 
 ITransactionPacketHandler::ITransactionPacketHandler(const FullNodeConfig &conf,
                                                      std::shared_ptr<PeersState> peers_state,
                                                      std::shared_ptr<TimePeriodPacketsStats> packets_stats,
-                                                     const addr_t &node_addr, const std::string &logs_prefix)
-    : PacketHandler(conf, std::move(peers_state), std::move(packets_stats), node_addr, logs_prefix) {}
+                                                     const addr_t &node_addr, const std::string &logs_prefix,
+                                                     bool announce_transactions)
+    : PacketHandler(conf, std::move(peers_state), std::move(packets_stats), node_addr, logs_prefix),
+      kAnnounceTransactions(announce_transactions) {}
+
+void ITransactionPacketHandler::periodicSendTransactions(const PoolTransactionsGetter &get_pool_transactions) {
+  // Peers are grouped by cursor so that pool is queried once per distinct cursor, usually all peers share the same one
+  std::map<uint64_t, std::vector<std::shared_ptr<TaraxaPeer>>> peers_per_cursor;
+  for (const auto &peer : peers_state_->getAllPeers()) {
+    if (peer.second->syncing_) {
+      continue;
+    }
+    peers_per_cursor[peer.second->transactions_send_cursor_].push_back(peer.second);
+  }
+
+  std::vector<std::pair<std::shared_ptr<TaraxaPeer>, std::pair<SharedTransactions, std::vector<trx_hash_t>>>>
+      peers_with_transactions_to_send;
+  for (const auto &[cursor, peers] : peers_per_cursor) {
+    auto [transactions, last_sequence] = get_pool_transactions(cursor);
+    auto selected = transactionsToSendToPeers(peers, transactions, last_sequence);
+    std::move(selected.begin(), selected.end(), std::back_inserter(peers_with_transactions_to_send));
+  }
+
+  if (kAnnounceTransactions) {
+    announceTransactionsHashes(peers_with_transactions_to_send);
+  }
 
-void ITransactionPacketHandler::periodicSendTransactions(std::vector<SharedTransactions> &&transactions) {
-  auto peers_with_transactions_to_send = transactionsToSendToPeers(std::move(transactions));
   const auto peers_to_send_count = peers_with_transactions_to_send.size();
   if (peers_to_send_count > 0) {
     // Sending it in same order favours some peers over others, always start with a different position
@@ -21,31 +46,83 @@ void ITransactionPacketHandler::periodicSendTransactions(std::vector<SharedTrans
   }
 }
 
+void ITransactionPacketHandler::announceTransactionsHashes(
+    std::vector<std::pair<std::shared_ptr<TaraxaPeer>, std::pair<SharedTransactions, std::vector<trx_hash_t>>>>
+        &peers_with_transactions_to_send) {
+  const auto peers_count = peers_with_transactions_to_send.size();
+  const auto bodies_peers_count = static_cast<size_t>(std::ceil(std::sqrt(peers_count)));
+  if (bodies_peers_count >= peers_count) {
+    return;
+  }
+
+  // Peers which get bodies are the first bodies_peers_count after shuffle
+  thread_local std::mt19937_64 rng{std::random_device{}()};
+  std::shuffle(peers_with_transactions_to_send.begin(), peers_with_transactions_to_send.end(), rng);
+  for (size_t i = bodies_peers_count; i < peers_count; i++) {
+    auto &[bodies, hashes] = peers_with_transactions_to_send[i].second;
+    // Bodies precede hashes in nonce order so their hashes go first
+    std::vector<trx_hash_t> announced;
+    announced.reserve(std::min<size_t>(bodies.size() + hashes.size(), kMaxHashesInPacket));
+    for (const auto &trx : bodies) {
+      announced.push_back(trx->getHash());
+    }
+    for (const auto &hash : hashes) {
+      if (announced.size() == kMaxHashesInPacket) {
+        break;
+      }
+      announced.push_back(hash);
+    }
+    bodies.clear();
+    hashes = std::move(announced);
+  }
+}
+
 std::vector<std::pair<std::shared_ptr<TaraxaPeer>, std::pair<SharedTransactions, std::vector<trx_hash_t>>>>
 ITransactionPacketHandler::transactionsToSendToPeers(std::vector<SharedTransactions> &&transactions) {
+  std::vector<std::shared_ptr<TaraxaPeer>> peers;
+  for (const auto &peer : peers_state_->getAllPeers()) {
+    if (!peer.second->syncing_) {
+      peers.push_back(peer.second);
+    }
+  }
+
+  return transactionsToSendToPeers(peers, transactions, {});
+}
+
+std::vector<std::pair<std::shared_ptr<TaraxaPeer>, std::pair<SharedTransactions, std::vector<trx_hash_t>>>>
+ITransactionPacketHandler::transactionsToSendToPeers(const std::vector<std::shared_ptr<TaraxaPeer>> &peers,
+                                                     const std::vector<SharedTransactions> &transactions,
+                                                     std::optional<uint64_t> cursor) {
   // Main goal of the algorithm below is to send different transactions and hashes to different peers but still follow
   // nonce ordering for single account and not send higher nonces without sending low nonces first
   const auto accounts_size = transactions.size();
   if (!accounts_size) {
+    if (cursor.has_value()) {
+      for (const auto &peer : peers) {
+        peer->transactions_send_cursor_ = *cursor;
+      }
+    }
     return {};
   }
   std::vector<std::pair<std::shared_ptr<TaraxaPeer>, std::pair<SharedTransactions, std::vector<trx_hash_t>>>>
       peers_with_transactions_to_send;
-  auto peers = peers_state_->getAllPeers();
 
   // account_index keeps current account index so that different peers will receive
   // transactions from different accounts
   uint32_t account_index = 0;
   for (const auto &peer : peers) {
-    if (peer.second->syncing_) {
-      continue;
-    }
-
     std::pair<SharedTransactions, std::vector<trx_hash_t>> peer_transactions;
-    std::tie(account_index, peer_transactions) = transactionsToSendToPeer(peer.second, transactions, account_index);
+    std::tie(account_index, peer_transactions) = transactionsToSendToPeer(peer, transactions, account_index);
+
+    // Cursor moves only if every transaction since it was sent in full or is already known, otherwise the same
+    // transactions are considered again on the next send
+    if (cursor.has_value() && peer_transactions.first.size() < kMaxTransactionsInPacket &&
+        peer_transactions.second.empty()) {
+      peer->transactions_send_cursor_ = *cursor;
+    }
 
     if (peer_transactions.first.size() > 0) {
-      peers_with_transactions_to_send.push_back({peer.second, std::move(peer_transactions)});
+      peers_with_transactions_to_send.push_back({peer, std::move(peer_transactions)});
     }
   }
 
@@ -16,64 +16,102 @@ IVotePacketHandler::IVotePacketHandler(const FullNodeConfig &conf, std::shared_p
 
 void IVotePacketHandler::onNewPbftVote(const std::shared_ptr<PbftVote> &vote, const std::shared_ptr<PbftBlock> &block,
                                        bool rebroadcast) {
-  for (const auto &peer : peers_state_->getAllPeers()) {
-    if (peer.second->syncing_) {
-      LOG(log_dg_) << " PBFT vote " << vote->getHash() << " not sent to " << peer.first << " peer syncing";
+  // Peers get one of two packets, with or without the block, each of them is encoded only once
+  std::shared_ptr<const dev::bytes> vote_rlp, vote_with_block_rlp;
+
+  // Lowest latency peers are served first, so the vote reaches the rest of the network through them sooner
+  for (const auto &peer : peers_state_->getPeersByGossipScore()) {
+    if (peer->syncing_) {
+      LOG(log_dg_) << " PBFT vote " << vote->getHash() << " not sent to " << peer->getId() << " peer syncing";
       continue;
     }
 
-    if (!rebroadcast && peer.second->isPbftVoteKnown(vote->getHash())) {
+    if (!rebroadcast && peer->isPbftVoteKnown(vote->getHash())) {
       continue;
     }
 
     // Send also block in case it is not known for the pear or rebroadcast == true
-    if (rebroadcast || !peer.second->isPbftBlockKnown(vote->getBlockHash())) {
-      sendPbftVote(peer.second, vote, block);
-    } else {
-      sendPbftVote(peer.second, vote, nullptr);
+    const std::shared_ptr<PbftBlock> peer_block =
+        (rebroadcast || !peer->isPbftBlockKnown(vote->getBlockHash())) ? block : nullptr;
+    auto &packet_rlp = peer_block ? vote_with_block_rlp : vote_rlp;
+    if (!packet_rlp) {
+      packet_rlp = encodePbftVotePacket(vote, peer_block);
+      if (!packet_rlp) {
+        return;
+      }
     }
+    sendEncodedPbftVote(peer, vote, peer_block, packet_rlp);
   }
 }
 
 void IVotePacketHandler::onNewPbftVotesBundle(const std::vector<std::shared_ptr<PbftVote>> &votes, bool rebroadcast,
                                               const std::optional<dev::p2p::NodeID> &exclude_node) {
-  for (const auto &peer : peers_state_->getAllPeers()) {
-    if (peer.second->syncing_) {
+  // Peers that know none of the votes get the same packet, it is encoded only once for all of them
+  std::shared_ptr<const dev::bytes> all_votes_rlp;
+
+  for (const auto &peer : peers_state_->getPeersByGossipScore()) {
+    if (peer->syncing_) {
       continue;
     }
 
-    if (exclude_node.has_value() && *exclude_node == peer.first) {
+    if (exclude_node.has_value() && *exclude_node == peer->getId()) {
       continue;
     }
 
     std::vector<std::shared_ptr<PbftVote>> peer_votes;
     for (const auto &vote : votes) {
-      if (!rebroadcast && peer.second->isPbftVoteKnown(vote->getHash())) {
+      if (!rebroadcast && peer->isPbftVoteKnown(vote->getHash())) {
         continue;
       }
 
       peer_votes.push_back(vote);
     }
 
-    sendPbftVotesBundle(peer.second, std::move(peer_votes));
+    if (!peer_votes.empty() && peer_votes.size() == votes.size() && votes.size() <= kMaxVotesInBundleRlp) {
+      if (!all_votes_rlp) {
+        all_votes_rlp = std::make_shared<const dev::bytes>(
+            encodePacketRlp(VotesBundlePacket{OptimizedPbftVotesBundle{.votes = votes}}));
+      }
+      if (sealAndSend(peer->getId(), SubprotocolPacketType::kVotesBundlePacket, all_votes_rlp)) {
+        LOG(log_dg_) << " Votes bundle with " << votes.size() << " votes sent to " << peer->getId();
+        for (const auto &vote : votes) {
+          peer->markPbftVoteAsKnown(vote->getHash());
+        }
+      }
+      continue;
+    }
+
+    sendPbftVotesBundle(peer, std::move(peer_votes));
   }
 }
 
-void IVotePacketHandler::sendPbftVote(const std::shared_ptr<TaraxaPeer> &peer, const std::shared_ptr<PbftVote> &vote,
-                                      const std::shared_ptr<PbftBlock> &block) {
+std::shared_ptr<const dev::bytes> IVotePacketHandler::encodePbftVotePacket(const std::shared_ptr<PbftVote> &vote,
+                                                                           const std::shared_ptr<PbftBlock> &block) {
   if (block && block->getBlockHash() != vote->getBlockHash()) {
     LOG(log_er_) << "Vote " << vote->getHash().abridged() << " voted block " << vote->getBlockHash().abridged()
                  << " != actual block " << block->getBlockHash().abridged();
-    return;
+    return nullptr;
   }
 
   std::optional<VotePacket::OptionalData> optional_packet_data;
   if (block) {
     optional_packet_data = VotePacket::OptionalData{block, pbft_chain_->getPbftChainSize()};
   }
+  return std::make_shared<const dev::bytes>(encodePacketRlp(VotePacket(vote, std::move(optional_packet_data))));
+}
+
+void IVotePacketHandler::sendPbftVote(const std::shared_ptr<TaraxaPeer> &peer, const std::shared_ptr<PbftVote> &vote,
+                                      const std::shared_ptr<PbftBlock> &block) {
+  if (auto packet_rlp = encodePbftVotePacket(vote, block)) {
+    sendEncodedPbftVote(peer, vote, block, std::move(packet_rlp));
+  }
+}
 
-  if (sealAndSend(peer->getId(), SubprotocolPacketType::kVotePacket,
-                  encodePacketRlp(VotePacket(vote, std::move(optional_packet_data))))) {
+void IVotePacketHandler::sendEncodedPbftVote(const std::shared_ptr<TaraxaPeer> &peer,
+                                             const std::shared_ptr<PbftVote> &vote,
+                                             const std::shared_ptr<PbftBlock> &block,
+                                             std::shared_ptr<const dev::bytes> packet_rlp) {
+  if (sealAndSend(peer->getId(), SubprotocolPacketType::kVotePacket, std::move(packet_rlp))) {
     peer->markPbftVoteAsKnown(vote->getHash());
     if (block) {
       peer->markPbftBlockAsKnown(block->getBlockHash());
@@ -85,6 +123,25 @@ void IVotePacketHandler::sendPbftVote(const std::shared_ptr<TaraxaPeer> &peer, c
   }
 }
 
+void IVotePacketHandler::sendPbftVotesBundle(const std::shared_ptr<TaraxaPeer> &peer,
+                                             const VoteManager::TwoTPlusOneVotesBundle &bundle) {
+  // Bundles bigger than single packet allows are split and encoded per packet
+  if (bundle.votes.size() > kMaxVotesInBundleRlp) {
+    sendPbftVotesBundle(peer, std::vector<std::shared_ptr<PbftVote>>(bundle.votes));
+    return;
+  }
+
+  // Votes bundle packet is a list with the bundle as the only item
+  dev::RLPStream packet_rlp(1);
+  packet_rlp.appendRaw(*bundle.rlp);
+  if (sealAndSend(peer->getId(), SubprotocolPacketType::kVotesBundlePacket, packet_rlp.invalidate())) {
+    LOG(log_dg_) << " Votes bundle with " << bundle.votes.size() << " votes sent to " << peer->getId();
+    for (const auto &vote : bundle.votes) {
+      peer->markPbftVoteAsKnown(vote->getHash());
+    }
+  }
+}
+
 void IVotePacketHandler::sendPbftVotesBundle(const std::shared_ptr<TaraxaPeer> &peer,
                                              std::vector<std::shared_ptr<PbftVote>> &&votes) {
   if (votes.empty()) {
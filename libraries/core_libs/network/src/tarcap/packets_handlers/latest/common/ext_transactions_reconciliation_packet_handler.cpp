@@ -0,0 +1,57 @@
+#include "network/tarcap/packets_handlers/latest/common/ext_transactions_reconciliation_packet_handler.hpp"
+
+#include "network/tarcap/packets/latest/transaction_packet.hpp"
+#include "transaction/transaction_manager.hpp"
+
+namespace taraxa::network::tarcap {
+
+ExtTransactionsReconciliationPacketHandler::ExtTransactionsReconciliationPacketHandler(
+    const FullNodeConfig &conf, std::shared_ptr<PeersState> peers_state,
+    std::shared_ptr<TimePeriodPacketsStats> packets_stats, std::shared_ptr<TransactionManager> trx_mgr,
+    const addr_t &node_addr, const std::string &log_channel)
+    : PacketHandler(conf, std::move(peers_state), std::move(packets_stats), node_addr, log_channel),
+      trx_mgr_(std::move(trx_mgr)) {}
+
+ExtTransactionsReconciliationPacketHandler::PoolTransactions
+ExtTransactionsReconciliationPacketHandler::getPoolTransactions() const {
+  PoolTransactions pool;
+  for (auto &account_trxs : trx_mgr_->getAllPoolTrxs()) {
+    for (auto &trx : account_trxs) {
+      const auto short_id = TransactionsSketch::shortId(trx->getHash());
+      pool.emplace_back(short_id, std::move(trx));
+    }
+  }
+  return pool;
+}
+
+TransactionsSketch ExtTransactionsReconciliationPacketHandler::makeSketch(size_t cells_count,
+                                                                          const PoolTransactions &pool) {
+  TransactionsSketch sketch(cells_count);
+  for (const auto &trx : pool) {
+    sketch.add(trx.first);
+  }
+  return sketch;
+}
+
+void ExtTransactionsReconciliationPacketHandler::sendTransactions(const std::shared_ptr<TaraxaPeer> &peer,
+                                                                  SharedTransactions &&transactions) {
+  for (size_t start = 0; start < transactions.size(); start += kMaxTransactionsInPacket) {
+    const auto end = std::min<size_t>(start + kMaxTransactionsInPacket, transactions.size());
+    TransactionPacket packet{.transactions = SharedTransactions(transactions.begin() + start,
+                                                                transactions.begin() + end),
+                             .extra_transactions_hashes = {}};
+    if (!sealAndSend(peer->getId(), SubprotocolPacketType::kTransactionPacket, encodePacketRlp(packet))) {
+      return;
+    }
+    for (const auto &trx : packet.transactions) {
+      peer->markTransactionAsKnown(trx->getHash());
+    }
+  }
+}
+
+uint64_t ExtTransactionsReconciliationPacketHandler::nowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace taraxa::network::tarcap
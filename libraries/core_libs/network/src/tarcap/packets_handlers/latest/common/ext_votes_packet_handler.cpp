@@ -31,25 +31,11 @@ bool ExtVotesPacketHandler::processVote(const std::shared_ptr<PbftVote> &vote,
     throw MaliciousPeerException("Received vote's voted value != received pbft block");
   }
 
-  if (vote_mgr_->voteInVerifiedMap(vote)) {
-    LOG(this->log_dg_) << "Vote " << vote->getHash() << " already inserted in verified queue";
+  if (!checkVoteBeforeValidation(vote, peer, validate_max_round_step)) {
     return false;
   }
 
-  // Validate vote's period, round and step min/max values
-  if (const auto vote_valid = validateVotePeriodRoundStep(vote, peer, validate_max_round_step); !vote_valid.first) {
-    LOG(this->log_wr_) << "Vote period/round/step " << vote->getHash()
-                       << " validation failed. Err: " << vote_valid.second;
-    return false;
-  }
-
-  // Check if vote is unique per period, round & step & voter -> each address can generate just 1 vote
-  // (for a value that isn't NBH) per period, round & step
-  if (auto vote_valid = vote_mgr_->isUniqueVote(vote); !vote_valid.first) {
-    // Create double voting proof
-    slashing_manager_->submitDoubleVotingProof(vote, vote_valid.second);
-    throw MaliciousPeerException("Received double vote", vote->getVoter());
-  }
+  checkUniqueVote(vote);
 
   // Validate vote's signature, vrf, etc...
   if (const auto vote_valid = vote_mgr_->validateVote(vote); !vote_valid.first) {
@@ -61,6 +47,8 @@ bool ExtVotesPacketHandler::processVote(const std::shared_ptr<PbftVote> &vote,
     LOG(this->log_dg_) << "Vote " << vote->getHash() << " already inserted in verified queue(race condition)";
     return false;
   }
+  // Peer was the first one to deliver the vote
+  peer->first_delivered_votes_++;
 
   if (pbft_block) {
     pbft_mgr_->processProposedBlock(pbft_block);
@@ -69,6 +57,34 @@ bool ExtVotesPacketHandler::processVote(const std::shared_ptr<PbftVote> &vote,
   return true;
 }
 
+bool ExtVotesPacketHandler::checkVoteBeforeValidation(const std::shared_ptr<PbftVote> &vote,
+                                                      const std::shared_ptr<TaraxaPeer> &peer,
+                                                      bool validate_max_round_step) {
+  if (vote_mgr_->voteInVerifiedMap(vote)) {
+    LOG(this->log_dg_) << "Vote " << vote->getHash() << " already inserted in verified queue";
+    return false;
+  }
+
+  // Validate vote's period, round and step min/max values
+  if (const auto vote_valid = validateVotePeriodRoundStep(vote, peer, validate_max_round_step); !vote_valid.first) {
+    LOG(this->log_wr_) << "Vote period/round/step " << vote->getHash()
+                       << " validation failed. Err: " << vote_valid.second;
+    return false;
+  }
+
+  return true;
+}
+
+void ExtVotesPacketHandler::checkUniqueVote(const std::shared_ptr<PbftVote> &vote) {
+  // Check if vote is unique per period, round & step & voter -> each address can generate just 1 vote
+  // (for a value that isn't NBH) per period, round & step
+  if (auto vote_valid = vote_mgr_->isUniqueVote(vote); !vote_valid.first) {
+    // Create double voting proof
+    slashing_manager_->postDoubleVotingProof(vote, vote_valid.second);
+    throw MaliciousPeerException("Received double vote", vote->getVoter());
+  }
+}
+
 std::pair<bool, std::string> ExtVotesPacketHandler::validateVotePeriodRoundStep(const std::shared_ptr<PbftVote> &vote,
                                                                                 const std::shared_ptr<TaraxaPeer> &peer,
                                                                                 bool validate_max_round_step) {
@@ -88,9 +104,7 @@ std::pair<bool, std::string> ExtVotesPacketHandler::validateVotePeriodRoundStep(
   if (vote->getPeriod() < current_pbft_period - 1 ||
       (vote->getPeriod() == current_pbft_period - 1 && vote->getType() != PbftVoteTypes::cert_vote)) {
     return {false, "Invalid period(too small): " + genErrMsg(vote)};
-  } else if (this->kConf.network.ddos_protection.vote_accepting_periods &&
-             vote->getPeriod() - 1 > current_pbft_period + this->kConf.network.ddos_protection.vote_accepting_periods) {
-    // skip this check if kConf.network.ddos_protection.vote_accepting_periods == 0
+  } else if (vote->getPeriod() - 1 > current_pbft_period + this->kConf.network.ddos_protection.vote_accepting_periods) {
     // vote->getPeriod() - 1 is here because votes are validated against vote_period - 1 in dpos contract
     // Do not request round sync too often here
     if (vote->getVoter() == peer->getId() &&
@@ -170,20 +184,8 @@ bool ExtVotesPacketHandler::validateVoteAndBlock(const std::shared_ptr<PbftVote>
 
 bool ExtVotesPacketHandler::isPbftRelevantVote(const std::shared_ptr<PbftVote> &vote) const {
   const auto [current_pbft_round, current_pbft_period] = pbft_mgr_->getPbftRoundAndPeriod();
-
-  if (vote->getPeriod() >= current_pbft_period && vote->getRound() >= current_pbft_round) {
-    // Standard current or future vote
-    return true;
-  } else if (vote->getPeriod() == current_pbft_period && vote->getRound() == (current_pbft_round - 1) &&
-             vote->getType() == PbftVoteTypes::next_vote) {
-    // Previous round next vote
-    return true;
-  } else if (vote->getPeriod() == current_pbft_period - 1 && vote->getType() == PbftVoteTypes::cert_vote) {
-    // Previous period cert vote - potential reward vote
-    return true;
-  }
-
-  return false;
+  const threadpool::PacketData::ConsensusHint hint{vote->getPeriod(), vote->getRound(), vote->getStep()};
+  return hint.isRelevant(current_pbft_period, current_pbft_round);
 }
 
 void ExtVotesPacketHandler::requestPbftNextVotesAtPeriodRound(const dev::p2p::NodeID &peerID, PbftPeriod pbft_period,
@@ -1,5 +1,7 @@
 #include "network/tarcap/packets_handlers/latest/common/packet_handler.hpp"
 
+#include "common/tracing.hpp"
+
 #include "network/tarcap/packets_handlers/latest/common/exceptions.hpp"
 #include "network/tarcap/stats/time_period_packets_stats.hpp"
 
@@ -8,10 +10,14 @@ namespace taraxa::network::tarcap {
 PacketHandler::PacketHandler(const FullNodeConfig& conf, std::shared_ptr<PeersState> peers_state,
                              std::shared_ptr<TimePeriodPacketsStats> packets_stats, const addr_t& node_addr,
                              const std::string& log_channel_name)
-    : kConf(conf), peers_state_(std::move(peers_state)), packets_stats_(std::move(packets_stats)) {
+    : kConf(conf),
+      peers_state_(std::move(peers_state)),
+      packets_stats_(std::move(packets_stats)),
+      kTraceSpanName(util::Tracer::intern(log_channel_name)) {
   LOG_OBJECTS_CREATE(log_channel_name);
 }
 void PacketHandler::processPacket(const threadpool::PacketData& packet_data) {
+  TRACE_SPAN(kTraceSpanName);
   try {
     const auto begin = std::chrono::steady_clock::now();
 
@@ -33,10 +39,10 @@ void PacketHandler::processPacket(const threadpool::PacketData& packet_data) {
                                                                                   packet_data.receive_time_);
 
     PacketStats packet_stats{1 /* count */, packet_data.rlp_.data().size(), processing_duration, tp_wait_duration};
-    peer.first->addSentPacket(packet_data.type_str_, packet_stats);
+    peer.first->addSentPacket(packet_data.type_, packet_stats);
 
     if (kConf.network.ddos_protection.log_packets_stats) {
-      packets_stats_->addReceivedPacket(packet_data.type_str_, packet_data.from_node_id_, packet_stats);
+      packets_stats_->addReceivedPacket(packet_data.type_, packet_data.from_node_id_, packet_stats);
     }
 
   } catch (const MaliciousPeerException& e) {
@@ -78,37 +84,67 @@ void PacketHandler::handle_caught_exception(std::string_view exception_msg, cons
   disconnect(peer, disconnect_reason);
 }
 
-bool PacketHandler::sealAndSend(const dev::p2p::NodeID& node_id, SubprotocolPacketType packet_type,
-                                dev::bytes&& rlp_bytes) {
+std::shared_ptr<dev::p2p::Host> PacketHandler::prepareSend(const dev::p2p::NodeID& node_id,
+                                                           SubprotocolPacketType packet_type, size_t packet_size) {
   auto host = peers_state_->host_.lock();
   if (!host) {
     LOG(log_er_) << "sealAndSend failed to obtain host";
-    return false;
+    return nullptr;
   }
 
   if (const auto peer = peers_state_->getPacketSenderPeer(node_id, packet_type); !peer.first) [[unlikely]] {
     LOG(log_wr_) << "Unable to send packet. Reason: " << peer.second;
     host->disconnect(node_id, dev::p2p::UserReason);
-    return false;
+    return nullptr;
+  }
+
+  // Serving sync to other peers must not saturate the uplink needed for consensus packets
+  if (peers_state_->upload_bandwidth_ && UploadBandwidthManager::isThrottled(packet_type)) {
+    peers_state_->upload_bandwidth_->throttle(node_id, packet_size);
   }
+  return host;
+}
 
+std::function<void()> PacketHandler::sentPacketStatsCallback(const dev::p2p::NodeID& node_id,
+                                                             SubprotocolPacketType packet_type, size_t packet_size) {
   const auto begin = std::chrono::steady_clock::now();
+  return [begin, node_id, packet_size, packet_type, this]() {
+    if (!kConf.network.ddos_protection.log_packets_stats) {
+      return;
+    }
+
+    PacketStats packet_stats{
+        1 /* count */, packet_size,
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin),
+        std::chrono::microseconds{0}};
+
+    packets_stats_->addSentPacket(packet_type, node_id, packet_stats);
+  };
+}
+
+bool PacketHandler::sealAndSend(const dev::p2p::NodeID& node_id, SubprotocolPacketType packet_type,
+                                dev::bytes&& rlp_bytes) {
   const size_t packet_size = rlp_bytes.size();
+  const auto host = prepareSend(node_id, packet_type, packet_size);
+  if (!host) {
+    return false;
+  }
 
   host->send(node_id, TARAXA_CAPABILITY_NAME, packet_type, std::move(rlp_bytes),
-             [begin, node_id, packet_size, packet_type, this]() {
-               if (!kConf.network.ddos_protection.log_packets_stats) {
-                 return;
-               }
-
-               PacketStats packet_stats{
-                   1 /* count */, packet_size,
-                   std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin),
-                   std::chrono::microseconds{0}};
+             sentPacketStatsCallback(node_id, packet_type, packet_size));
+  return true;
+}
 
-               packets_stats_->addSentPacket(convertPacketTypeToString(packet_type), node_id, packet_stats);
-             });
+bool PacketHandler::sealAndSend(const dev::p2p::NodeID& node_id, SubprotocolPacketType packet_type,
+                                std::shared_ptr<const dev::bytes> rlp_bytes) {
+  const size_t packet_size = rlp_bytes->size();
+  const auto host = prepareSend(node_id, packet_type, packet_size);
+  if (!host) {
+    return false;
+  }
 
+  host->send(node_id, TARAXA_CAPABILITY_NAME, packet_type, std::move(rlp_bytes),
+             sentPacketStatsCallback(node_id, packet_type, packet_size));
   return true;
 }
 
@@ -1,6 +1,7 @@
 #include "network/tarcap/packets_handlers/latest/dag_block_packet_handler.hpp"
 
 #include "dag/dag_manager.hpp"
+#include "network/tarcap/packets/latest/get_dag_block_transactions_packet.hpp"
 #include "network/tarcap/packets_handlers/latest/transaction_packet_handler.hpp"
 #include "network/tarcap/shared_states/pbft_syncing_state.hpp"
 #include "transaction/transaction_manager.hpp"
@@ -13,11 +14,13 @@ DagBlockPacketHandler::DagBlockPacketHandler(const FullNodeConfig &conf, std::sh
                                              std::shared_ptr<PbftChain> pbft_chain,
                                              std::shared_ptr<PbftManager> pbft_mgr, std::shared_ptr<DagManager> dag_mgr,
                                              std::shared_ptr<TransactionManager> trx_mgr, std::shared_ptr<DbStorage> db,
-                                             const addr_t &node_addr, const std::string &logs_prefix)
+                                             const addr_t &node_addr, const std::string &logs_prefix,
+                                             bool compact_relay)
     : IDagBlockPacketHandler(conf, std::move(peers_state), std::move(packets_stats), std::move(pbft_syncing_state),
                              std::move(pbft_chain), std::move(pbft_mgr), std::move(dag_mgr), std::move(db), node_addr,
                              logs_prefix + "DAG_BLOCK_PH"),
-      trx_mgr_(std::move(trx_mgr)) {}
+      trx_mgr_(std::move(trx_mgr)),
+      kCompactRelay(compact_relay) {}
 
 void DagBlockPacketHandler::process(const threadpool::PacketData &packet_data,
                                     const std::shared_ptr<TaraxaPeer> &peer) {
@@ -46,18 +49,51 @@ void DagBlockPacketHandler::process(const threadpool::PacketData &packet_data,
   for (const auto &tx : packet.transactions) {
     txs_map.emplace(tx->getHash(), tx);
   }
+  trx_mgr_->recoverSenders(packet.transactions);
+
+  if (kCompactRelay && requestMissingTransactions(peer, *packet.dag_block, txs_map)) {
+    return;
+  }
 
   onNewBlockReceived(std::move(packet.dag_block), peer, txs_map);
 }
 
+bool DagBlockPacketHandler::requestMissingTransactions(
+    const std::shared_ptr<TaraxaPeer> &peer, const DagBlock &block,
+    const std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> &trxs) {
+  GetDagBlockTransactionsPacket request{.dag_block_hash = block.getHash(), .transactions_hashes = {}};
+  for (const auto &trx_hash : block.getTrxs()) {
+    if (!trxs.contains(trx_hash) && !trx_mgr_->isTransactionKnown(trx_hash)) {
+      request.transactions_hashes.push_back(trx_hash);
+    }
+  }
+
+  // Response is DagBlockPacket with the requested transactions, if something is still missing after it the block is
+  // processed as usual
+  if (request.transactions_hashes.empty() || !requested_blocks_transactions_.insert(request.dag_block_hash)) {
+    return false;
+  }
+
+  LOG(log_dg_) << "Requesting " << request.transactions_hashes.size() << " missing transactions of dag block "
+               << request.dag_block_hash << " from " << peer->getId();
+  return sealAndSend(peer->getId(), SubprotocolPacketType::kGetDagBlockTransactionsPacket, encodePacketRlp(request));
+}
+
 void DagBlockPacketHandler::sendBlockWithTransactions(const std::shared_ptr<TaraxaPeer> &peer,
                                                       const std::shared_ptr<DagBlock> &block,
-                                                      SharedTransactions &&trxs) {
+                                                      const dev::bytes &block_rlp, SharedTransactions &&trxs) {
   // This lock prevents race condition between syncing and gossiping dag blocks
   std::unique_lock lock(peer->mutex_for_sending_dag_blocks_);
 
-  DagBlockPacket dag_block_packet{.transactions = std::move(trxs), .dag_block = block};
-  if (!sealAndSend(peer->getId(), SubprotocolPacketType::kDagBlockPacket, encodePacketRlp(dag_block_packet))) {
+  if (kCompactRelay) {
+    // Receiver requests bodies it does not have, most of them are already in its pool
+    trxs.clear();
+  }
+  // Same encoding as DagBlockPacket, block rlp is appended as is instead of being encoded again for every peer
+  dev::RLPStream packet_rlp(2);
+  util::rlp(packet_rlp, trxs);
+  packet_rlp.appendRaw(block_rlp);
+  if (!sealAndSend(peer->getId(), SubprotocolPacketType::kDagBlockPacket, packet_rlp.invalidate())) {
     LOG(log_wr_) << "Sending DagBlock " << block->getHash() << " failed to " << peer->getId();
     return;
   }
@@ -1,6 +1,7 @@
 #include "network/tarcap/packets_handlers/latest/dag_sync_packet_handler.hpp"
 
 #include "dag/dag.hpp"
+#include "dag/dag_manager.hpp"
 #include "network/tarcap/packets_handlers/latest/common/ext_syncing_packet_handler.hpp"
 #include "network/tarcap/shared_states/pbft_syncing_state.hpp"
 #include "transaction/transaction.hpp"
@@ -48,6 +49,8 @@ void DagSyncPacketHandler::process(const threadpool::PacketData& packet_data, co
   std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> transactions_map;
   transactions_to_log.reserve(packet.transactions.size());
   transactions_map.reserve(packet.transactions.size());
+  // Senders are recovered in parallel, verification below then only hits the cache
+  trx_mgr_->recoverSenders(packet.transactions);
   for (auto& trx : packet.transactions) {
     const auto tx_hash = trx->getHash();
     peer->markTransactionAsKnown(tx_hash);
@@ -67,7 +70,9 @@ void DagSyncPacketHandler::process(const threadpool::PacketData& packet_data, co
   }
 
   std::vector<blk_hash_t> dag_blocks_to_log;
+  std::vector<std::shared_ptr<DagBlock>> unknown_blocks;
   dag_blocks_to_log.reserve(packet.dag_blocks.size());
+  unknown_blocks.reserve(packet.dag_blocks.size());
   for (auto& block : packet.dag_blocks) {
     dag_blocks_to_log.push_back(block->getHash());
     peer->markDagBlockAsKnown(block->getHash());
@@ -76,8 +81,15 @@ void DagSyncPacketHandler::process(const threadpool::PacketData& packet_data, co
       LOG(log_tr_) << "Received known DagBlock " << block->getHash() << "from: " << peer->getId();
       continue;
     }
+    unknown_blocks.push_back(block);
+  }
 
-    auto verified = dag_mgr_->verifyBlock(block, transactions_map);
+  // Verification does not need pivot and tips in the DAG, so all blocks are verified in parallel and only adding them
+  // follows the order of levels in which they were sent
+  auto verified_blocks = dag_mgr_->verifyBlocksBatch(unknown_blocks, transactions_map);
+  for (size_t i = 0; i < unknown_blocks.size(); i++) {
+    const auto& block = unknown_blocks[i];
+    auto& verified = verified_blocks[i];
     if (verified.first != DagManager::VerifyBlockReturnType::Verified) {
       std::ostringstream err_msg;
       err_msg << "DagBlock " << block->getHash() << " failed verification with error code "
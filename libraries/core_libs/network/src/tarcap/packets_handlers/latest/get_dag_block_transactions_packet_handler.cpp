@@ -0,0 +1,63 @@
+#include "network/tarcap/packets_handlers/latest/get_dag_block_transactions_packet_handler.hpp"
+
+#include "dag/dag_manager.hpp"
+#include "network/tarcap/packets/latest/dag_block_packet.hpp"
+#include "transaction/transaction_manager.hpp"
+
+namespace taraxa::network::tarcap {
+
+GetDagBlockTransactionsPacketHandler::GetDagBlockTransactionsPacketHandler(
+    const FullNodeConfig &conf, std::shared_ptr<PeersState> peers_state,
+    std::shared_ptr<TimePeriodPacketsStats> packets_stats, std::shared_ptr<DagManager> dag_mgr,
+    std::shared_ptr<TransactionManager> trx_mgr, const addr_t &node_addr, const std::string &logs_prefix)
+    : PacketHandler(conf, std::move(peers_state), std::move(packets_stats), node_addr,
+                    logs_prefix + "GET_DAG_BLOCK_TRANSACTIONS_PH"),
+      dag_mgr_(std::move(dag_mgr)),
+      trx_mgr_(std::move(trx_mgr)) {}
+
+void GetDagBlockTransactionsPacketHandler::process(const threadpool::PacketData &packet_data,
+                                                   const std::shared_ptr<TaraxaPeer> &peer) {
+  // Decode packet rlp into packet object
+  const auto packet = decodePacketRlp<GetDagBlockTransactionsPacket>(packet_data.rlp_);
+
+  auto block = dag_mgr_->getDagBlock(packet.dag_block_hash);
+  if (!block) {
+    LOG(log_dg_) << "Requested transactions of unknown dag block " << packet.dag_block_hash << " from "
+                 << peer->getId();
+    return;
+  }
+
+  const auto &block_trxs = block->getTrxs();
+  if (packet.transactions_hashes.size() > block_trxs.size()) {
+    throw InvalidRlpItemsCountException("GetDagBlockTransactionsPacket:hashes", packet.transactions_hashes.size(),
+                                        block_trxs.size());
+  }
+
+  const std::unordered_set<trx_hash_t> block_trxs_set(block_trxs.begin(), block_trxs.end());
+  SharedTransactions transactions;
+  transactions.reserve(packet.transactions_hashes.size());
+  for (const auto &hash : packet.transactions_hashes) {
+    if (!block_trxs_set.contains(hash)) {
+      std::ostringstream err_msg;
+      err_msg << "Requested transaction " << hash << " is not part of dag block " << packet.dag_block_hash;
+      throw MaliciousPeerException(err_msg.str());
+    }
+    if (auto trx = trx_mgr_->getTransaction(hash)) {
+      transactions.push_back(std::move(trx));
+    }
+  }
+
+  LOG(log_tr_) << "Sending " << transactions.size() << " transactions of dag block " << packet.dag_block_hash
+               << " to " << peer->getId();
+
+  // This lock prevents race condition between syncing and gossiping dag blocks
+  std::unique_lock lock(peer->mutex_for_sending_dag_blocks_);
+  DagBlockPacket response{.transactions = std::move(transactions), .dag_block = std::move(block)};
+  if (sealAndSend(peer->getId(), SubprotocolPacketType::kDagBlockPacket, encodePacketRlp(response))) {
+    for (const auto &trx : response.transactions) {
+      peer->markTransactionAsKnown(trx->getHash());
+    }
+  }
+}
+
+}  // namespace taraxa::network::tarcap
@@ -0,0 +1,74 @@
+#include "network/tarcap/packets_handlers/latest/get_historical_block_packet_handler.hpp"
+
+#include "network/tarcap/packets/latest/historical_block_packet.hpp"
+#include "storage/storage.hpp"
+
+namespace taraxa::network::tarcap {
+
+GetHistoricalBlockPacketHandler::GetHistoricalBlockPacketHandler(
+    const FullNodeConfig &conf, std::shared_ptr<PeersState> peers_state,
+    std::shared_ptr<TimePeriodPacketsStats> packets_stats, std::shared_ptr<HistoricalBlocksRequests> requests,
+    std::shared_ptr<DbStorage> db, const addr_t &node_addr, const std::string &logs_prefix)
+    : PacketHandler(conf, std::move(peers_state), std::move(packets_stats), node_addr,
+                    logs_prefix + "GET_HISTORICAL_BLOCK_PH"),
+      requests_(std::move(requests)),
+      db_(std::move(db)) {}
+
+void GetHistoricalBlockPacketHandler::process(const threadpool::PacketData &packet_data,
+                                              const std::shared_ptr<TaraxaPeer> &peer) {
+  // Decode packet rlp into packet object
+  const auto packet = decodePacketRlp<GetHistoricalBlockPacket>(packet_data.rlp_);
+
+  // Missing block is answered too, so the requester moves to another peer at once instead of waiting for timeout
+  HistoricalBlockPacket response{packet.period, getHistoricalBlock(packet.period)};
+  LOG(log_dg_) << "Historical block " << packet.period << " requested by " << peer->getId()
+               << (response.block ? " sent" : " not found");
+  sealAndSend(peer->getId(), SubprotocolPacketType::kHistoricalBlockPacket, encodePacketRlp(response));
+}
+
+std::optional<final_chain::HistoricalBlock> GetHistoricalBlockPacketHandler::getHistoricalBlock(
+    PbftPeriod period) const {
+  auto pbft_block = db_->getPbftBlock(period);
+  if (!pbft_block) {
+    return {};
+  }
+  auto header_data = db_->lookup(period, DbStorage::Columns::final_chain_blk_by_number);
+  auto receipts = db_->getBlockReceipts(period);
+  auto transactions = db_->getPeriodTransactions(period);
+  // Light nodes serve only what they didn't prune yet
+  if (header_data.empty() || !receipts || !transactions) {
+    return {};
+  }
+
+  final_chain::HistoricalBlock block;
+  block.pbft_block = std::make_shared<PbftBlock>(std::move(*pbft_block));
+  block.header_data.assign(header_data.begin(), header_data.end());
+  block.transactions = std::move(*transactions);
+  for (const auto &trx : db_->getPeriodSystemTransactions(period)) {
+    block.system_transactions.push_back(trx->rlp());
+  }
+  block.receipts = std::move(*receipts);
+  return block;
+}
+
+std::shared_future<HistoricalBlocksRequests::Response> GetHistoricalBlockPacketHandler::requestHistoricalBlock(
+    PbftPeriod period, const std::shared_ptr<TaraxaPeer> &peer) {
+  auto [future, needs_send] = requests_->add(peer->getId(), period);
+  if (!needs_send) {
+    return future;
+  }
+  if (sealAndSend(peer->getId(), SubprotocolPacketType::kGetHistoricalBlockPacket,
+                  encodePacketRlp(GetHistoricalBlockPacket{period}))) {
+    LOG(log_dg_) << "Requested historical block " << period << " from peer " << peer->getId();
+  } else {
+    LOG(log_dg_) << "Unable to send historical block " << period << " request to peer " << peer->getId();
+    requests_->cancel(peer->getId(), period);
+  }
+  return future;
+}
+
+void GetHistoricalBlockPacketHandler::cancelRequest(PbftPeriod period, const std::shared_ptr<TaraxaPeer> &peer) {
+  requests_->cancel(peer->getId(), period);
+}
+
+}  // namespace taraxa::network::tarcap
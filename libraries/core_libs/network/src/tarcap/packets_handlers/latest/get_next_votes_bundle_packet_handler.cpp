@@ -30,14 +30,15 @@ void GetNextVotesBundlePacketHandler::process(const threadpool::PacketData &pack
     return;
   }
 
+  // Bundles are encoded once and shared by all peers requesting them
   auto next_votes =
-      vote_mgr_->getTwoTPlusOneVotedBlockVotes(pbft_period, pbft_round - 1, TwoTPlusOneVotedBlockType::NextVotedBlock);
-  auto next_null_votes = vote_mgr_->getTwoTPlusOneVotedBlockVotes(pbft_period, pbft_round - 1,
-                                                                  TwoTPlusOneVotedBlockType::NextVotedNullBlock);
+      vote_mgr_->getTwoTPlusOneVotesBundle(pbft_period, pbft_round - 1, TwoTPlusOneVotedBlockType::NextVotedBlock);
+  auto next_null_votes =
+      vote_mgr_->getTwoTPlusOneVotesBundle(pbft_period, pbft_round - 1, TwoTPlusOneVotedBlockType::NextVotedNullBlock);
 
   // In edge case this could theoretically happen due to race condition when we moved to the next period or round
   // right before calling getAllTwoTPlusOneNextVotes with specific period & round
-  if (next_votes.empty() && next_null_votes.empty()) {
+  if (!next_votes && !next_null_votes) {
     // Try to get period & round values again
     const auto [tmp_pbft_round, tmp_pbft_period] = pbft_mgr_->getPbftRoundAndPeriod();
     // No changes in period & round or new round == 1
@@ -52,24 +53,25 @@ void GetNextVotesBundlePacketHandler::process(const threadpool::PacketData &pack
       return;
     }
 
-    next_votes = vote_mgr_->getTwoTPlusOneVotedBlockVotes(pbft_period, pbft_round - 1,
-                                                          TwoTPlusOneVotedBlockType::NextVotedBlock);
-    next_null_votes = vote_mgr_->getTwoTPlusOneVotedBlockVotes(pbft_period, pbft_round - 1,
-                                                               TwoTPlusOneVotedBlockType::NextVotedNullBlock);
-    if (next_votes.empty() && next_null_votes.empty()) {
+    next_votes =
+        vote_mgr_->getTwoTPlusOneVotesBundle(pbft_period, pbft_round - 1, TwoTPlusOneVotedBlockType::NextVotedBlock);
+    next_null_votes = vote_mgr_->getTwoTPlusOneVotesBundle(pbft_period, pbft_round - 1,
+                                                           TwoTPlusOneVotedBlockType::NextVotedNullBlock);
+    if (!next_votes && !next_null_votes) {
       LOG(log_er_) << "No next votes returned for period " << tmp_pbft_period << ", round " << tmp_pbft_round - 1;
       return;
     }
   }
 
-  if (!next_votes.empty()) {
-    LOG(log_nf_) << "Send next votes bundle with " << next_votes.size() << " votes to " << peer->getId();
-    sendPbftVotesBundle(peer, std::move(next_votes));
+  if (next_votes) {
+    LOG(log_nf_) << "Send next votes bundle with " << next_votes->votes.size() << " votes to " << peer->getId();
+    sendPbftVotesBundle(peer, *next_votes);
   }
 
-  if (!next_null_votes.empty()) {
-    LOG(log_nf_) << "Send next null votes bundle with " << next_null_votes.size() << " votes to " << peer->getId();
-    sendPbftVotesBundle(peer, std::move(next_null_votes));
+  if (next_null_votes) {
+    LOG(log_nf_) << "Send next null votes bundle with " << next_null_votes->votes.size() << " votes to "
+                 << peer->getId();
+    sendPbftVotesBundle(peer, *next_null_votes);
   }
 }
 
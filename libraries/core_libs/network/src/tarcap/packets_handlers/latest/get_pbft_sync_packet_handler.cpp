@@ -1,5 +1,7 @@
 #include "network/tarcap/packets_handlers/latest/get_pbft_sync_packet_handler.hpp"
 
+#include <future>
+
 #include "network/tarcap/packets/latest/pbft_blocks_bundle_packet.hpp"
 #include "network/tarcap/packets/latest/pbft_sync_packet.hpp"
 #include "network/tarcap/packets_handlers/latest/pbft_blocks_bundle_packet_handler.hpp"
@@ -55,11 +57,12 @@ void GetPbftSyncPacketHandler::process(const threadpool::PacketData &packet_data
   size_t blocks_to_transfer = 0;
   auto pbft_chain_synced = false;
   const auto total_period_data_size = my_chain_size - packet.height_to_sync + 1;
-  if (total_period_data_size <= kConf.network.sync_level_size) {
+  const auto sync_level_size = pbft_syncing_state_->syncLevelSize();
+  if (total_period_data_size <= sync_level_size) {
     blocks_to_transfer = total_period_data_size;
     pbft_chain_synced = true;
   } else {
-    blocks_to_transfer = kConf.network.sync_level_size;
+    blocks_to_transfer = sync_level_size;
   }
   LOG(log_tr_) << "Will send " << blocks_to_transfer << " PBFT blocks to " << peer->getId();
 
@@ -96,36 +99,63 @@ void GetPbftSyncPacketHandler::sendPbftBlocks(const std::shared_ptr<TaraxaPeer>
   LOG(log_tr_) << "sendPbftBlocks: peer want to sync from pbft chain height " << from_period << ", will send at most "
                << blocks_to_transfer << " pbft blocks to " << peer_id;
 
-  for (auto block_period = from_period; block_period < from_period + blocks_to_transfer; block_period++) {
-    bool last_block = (block_period == from_period + blocks_to_transfer - 1);
-    auto period_data = db_->getPeriodDataRaw(block_period);
-    if (period_data.empty()) {
-      // This can happen when switching from light node to full node setting
-      LOG(log_er_) << "DB corrupted. Cannot find period " << block_period << " PBFT block in db";
-      return;
+  const PbftPeriod end_period = from_period + blocks_to_transfer;
+  auto read_batch = [db = db_, end_period](PbftPeriod batch_start) {
+    std::vector<PbftPeriod> periods;
+    for (auto period = batch_start; period < std::min(batch_start + kPeriodsReadBatchSize, end_period); period++) {
+      periods.push_back(period);
+    }
+    return db->getPeriodsDataViews(periods);
+  };
+
+  // Periods are read in batches with a single MultiGet, the next batch is read while the current one is being sent
+  auto batch = read_batch(from_period);
+  for (auto batch_start = from_period; batch_start < end_period; batch_start += kPeriodsReadBatchSize) {
+    std::future<std::vector<PeriodDataView>> next_batch;
+    if (const auto next_batch_start = batch_start + kPeriodsReadBatchSize; next_batch_start < end_period) {
+      auto task = std::make_shared<std::packaged_task<std::vector<PeriodDataView>()>>(
+          [read_batch, next_batch_start] { return read_batch(next_batch_start); });
+      next_batch = task->get_future();
+      read_ahead_executor_.post([task] { (*task)(); });
     }
 
-    std::shared_ptr<PbftSyncPacketRaw> pbft_sync_packet;
+    for (size_t i = 0; i < batch.size(); i++) {
+      const auto block_period = batch_start + i;
+      bool last_block = (block_period == end_period - 1);
+      // Period data stays pinned in db and its raw rlp is forwarded without copying or re-encoding
+      const auto &period_data = batch[i];
+      if (period_data.empty()) {
+        // This can happen when switching from light node to full node setting
+        LOG(log_er_) << "DB corrupted. Cannot find period " << block_period << " PBFT block in db";
+        return;
+      }
 
-    if (pbft_chain_synced && last_block) {
-      // Latest finalized block cert votes are saved in db as reward votes for new blocks
-      auto reward_votes = vote_mgr_->getRewardVotes();
-      assert(!reward_votes.empty());
-      // It is possible that the node pushed another block to the chain in the meantime
-      if (reward_votes[0]->getPeriod() == block_period) {
-        pbft_sync_packet = std::make_shared<PbftSyncPacketRaw>(last_block, std::move(period_data),
-                                                               OptimizedPbftVotesBundle{std::move(reward_votes)});
+      std::shared_ptr<PbftSyncPacketRaw> pbft_sync_packet;
+
+      if (pbft_chain_synced && last_block) {
+        // Latest finalized block cert votes are saved in db as reward votes for new blocks
+        auto reward_votes = vote_mgr_->getRewardVotes();
+        assert(!reward_votes.empty());
+        // It is possible that the node pushed another block to the chain in the meantime
+        if (reward_votes[0]->getPeriod() == block_period) {
+          pbft_sync_packet = std::make_shared<PbftSyncPacketRaw>(last_block, period_data.raw(),
+                                                                 OptimizedPbftVotesBundle{std::move(reward_votes)});
+        } else {
+          pbft_sync_packet = std::make_shared<PbftSyncPacketRaw>(last_block, period_data.raw());
+        }
       } else {
-        pbft_sync_packet = std::make_shared<PbftSyncPacketRaw>(last_block, std::move(period_data));
+        pbft_sync_packet = std::make_shared<PbftSyncPacketRaw>(last_block, period_data.raw());
+      }
+
+      LOG(log_dg_) << "Sending PbftSyncPacket period " << block_period << " to " << peer_id;
+      sealAndSend(peer_id, SubprotocolPacketType::kPbftSyncPacket, encodePacketRlp(pbft_sync_packet));
+      if (pbft_chain_synced && last_block) {
+        peer->syncing_ = false;
       }
-    } else {
-      pbft_sync_packet = std::make_shared<PbftSyncPacketRaw>(last_block, std::move(period_data));
     }
 
-    LOG(log_dg_) << "Sending PbftSyncPacket period " << block_period << " to " << peer_id;
-    sealAndSend(peer_id, SubprotocolPacketType::kPbftSyncPacket, encodePacketRlp(pbft_sync_packet));
-    if (pbft_chain_synced && last_block) {
-      peer->syncing_ = false;
+    if (next_batch.valid()) {
+      batch = next_batch.get();
     }
   }
 }
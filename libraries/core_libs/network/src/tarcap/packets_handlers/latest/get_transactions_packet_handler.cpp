@@ -0,0 +1,43 @@
+#include "network/tarcap/packets_handlers/latest/get_transactions_packet_handler.hpp"
+
+#include "network/tarcap/packets/latest/transaction_packet.hpp"
+#include "transaction/transaction_manager.hpp"
+
+namespace taraxa::network::tarcap {
+
+GetTransactionsPacketHandler::GetTransactionsPacketHandler(const FullNodeConfig &conf,
+                                                           std::shared_ptr<PeersState> peers_state,
+                                                           std::shared_ptr<TimePeriodPacketsStats> packets_stats,
+                                                           std::shared_ptr<TransactionManager> trx_mgr,
+                                                           const addr_t &node_addr, const std::string &logs_prefix)
+    : PacketHandler(conf, std::move(peers_state), std::move(packets_stats), node_addr,
+                    logs_prefix + "GET_TRANSACTIONS_PH"),
+      trx_mgr_(std::move(trx_mgr)) {}
+
+void GetTransactionsPacketHandler::process(const threadpool::PacketData &packet_data,
+                                           const std::shared_ptr<TaraxaPeer> &peer) {
+  // Decode packet rlp into packet object
+  const auto packet = decodePacketRlp<GetTransactionsPacket>(packet_data.rlp_);
+
+  if (packet.transactions_hashes.size() > kMaxTransactionsInPacket) {
+    throw InvalidRlpItemsCountException("GetTransactionsPacket:hashes", packet.transactions_hashes.size(),
+                                        kMaxTransactionsInPacket);
+  }
+
+  // Only pool transactions are served, anything else was already included in dag and is propagated with dag blocks
+  auto [transactions, missing] = trx_mgr_->getPoolTransactions(packet.transactions_hashes);
+  LOG(log_tr_) << "Received GetTransactionsPacket with " << packet.transactions_hashes.size() << " hashes, "
+               << missing.size() << " not in pool, from: " << peer->getId();
+  if (transactions.empty()) {
+    return;
+  }
+
+  TransactionPacket response{.transactions = std::move(transactions), .extra_transactions_hashes = {}};
+  if (sealAndSend(peer->getId(), SubprotocolPacketType::kTransactionPacket, encodePacketRlp(response))) {
+    for (const auto &trx : response.transactions) {
+      peer->markTransactionAsKnown(trx->getHash());
+    }
+  }
+}
+
+}  // namespace taraxa::network::tarcap
@@ -0,0 +1,25 @@
+#include "network/tarcap/packets_handlers/latest/historical_block_packet_handler.hpp"
+
+namespace taraxa::network::tarcap {
+
+HistoricalBlockPacketHandler::HistoricalBlockPacketHandler(const FullNodeConfig &conf,
+                                                           std::shared_ptr<PeersState> peers_state,
+                                                           std::shared_ptr<TimePeriodPacketsStats> packets_stats,
+                                                           std::shared_ptr<HistoricalBlocksRequests> requests,
+                                                           const addr_t &node_addr, const std::string &logs_prefix)
+    : PacketHandler(conf, std::move(peers_state), std::move(packets_stats), node_addr,
+                    logs_prefix + "HISTORICAL_BLOCK_PH"),
+      requests_(std::move(requests)) {}
+
+void HistoricalBlockPacketHandler::process(const threadpool::PacketData &packet_data,
+                                           const std::shared_ptr<TaraxaPeer> &peer) {
+  // Decode packet rlp into packet object
+  auto packet = decodePacketRlp<HistoricalBlockPacket>(packet_data.rlp_);
+
+  // Response can be late after the request timed out, it is not malicious then
+  if (!requests_->complete(peer->getId(), packet.period, std::move(packet.block))) {
+    LOG(log_dg_) << "Received not requested historical block " << packet.period << " from " << peer->getId();
+  }
+}
+
+}  // namespace taraxa::network::tarcap
@@ -24,8 +24,8 @@ PbftSyncPacketHandler::PbftSyncPacketHandler(const FullNodeConfig &conf, std::sh
 
 void PbftSyncPacketHandler::process(const threadpool::PacketData &packet_data,
                                     const std::shared_ptr<TaraxaPeer> &peer) {
-  // Decode packet rlp into packet object
-  auto packet = decodePacketRlp<PbftSyncPacket>(packet_data.rlp_);
+  // Decode only pbft block, the rest of the period data is decoded once the period is next in order
+  const PbftSyncPacketHeader packet_header(packet_data.rlp_);
 
   // Note: no need to consider possible race conditions due to concurrent processing as it is
   // disabled on priority_queue blocking dependencies level
@@ -36,16 +36,75 @@ void PbftSyncPacketHandler::process(const threadpool::PacketData &packet_data,
     return;
   }
 
-  if (syncing_peer->getId() != peer->getId()) {
-    LOG(log_wr_) << "PbftSyncPacket received from unexpected peer " << peer->getId().abridged()
-                 << " current syncing peer " << syncing_peer->getId().abridged();
+  // pbft_chain_synced is the flag to indicate own PBFT chain has synced with the peer's PBFT chain
+  const bool pbft_chain_synced = packet_header.pbft_chain_synced;
+  const auto pbft_blk_hash = packet_header.pbft_blk->getBlockHash();
+  const auto pbft_block_period = packet_header.pbft_blk->getPeriod();
+
+  if (!pbft_syncing_state_->acceptSyncWindowPeriod(peer->getId(), pbft_block_period, pbft_chain_synced)) {
+    LOG(log_wr_) << "PbftSyncPacket with period " << pbft_block_period << " received from unexpected peer "
+                 << peer->getId().abridged() << " current syncing peer " << syncing_peer->getId().abridged();
     return;
   }
 
-  // Process received pbft blocks
-  // pbft_chain_synced is the flag to indicate own PBFT chain has synced with the peer's PBFT chain
+  LOG(log_dg_) << "PbftSyncPacket received. Period: " << pbft_block_period << " from " << peer->getId();
+
+  peer->markPbftBlockAsKnown(pbft_blk_hash);
+  // Update peer's pbft period if outdated
+  if (peer->pbft_chain_size_ < pbft_block_period) {
+    peer->pbft_chain_size_ = pbft_block_period;
+  }
+
+  // Reset last sync packet received time
+  pbft_syncing_state_->setLastSyncPacketTime();
+
+  if (pbft_block_period > pbft_mgr_->pbftSyncingPeriod() + 1 && !pbft_chain_->findPbftBlockInChain(pbft_blk_hash)) {
+    // Period of a window ahead, it can be validated only after all previous periods are processed. It is kept as raw
+    // rlp so buffered periods do not hold decoded dag blocks and transactions
+    LOG(log_tr_) << "Buffering pbft block " << pbft_blk_hash << ", period " << pbft_block_period;
+    buffered_period_data_.insert_or_assign(pbft_block_period, BufferedPeriodData{packet_data, peer});
+  } else if (!processPeriodData(decodePacketRlp<PbftSyncPacket>(packet_data.rlp_), peer)) {
+    return;
+  }
+
+  // Process buffered periods that are next in order
+  while (!buffered_period_data_.empty()) {
+    const auto expected_period = pbft_mgr_->pbftSyncingPeriod() + 1;
+    auto first = buffered_period_data_.begin();
+    if (first->first > expected_period) {
+      break;
+    }
+
+    const auto buffered_period = first->first;
+    auto buffered = std::move(first->second);
+    buffered_period_data_.erase(first);
+    if (buffered_period < expected_period) {
+      continue;
+    }
+
+    // Packet was received earlier so decoding errors have to be attributed to the peer which sent it
+    PbftSyncPacket buffered_packet;
+    try {
+      buffered_packet = decodePacketRlp<PbftSyncPacket>(buffered.packet.rlp_);
+    } catch (const std::exception &e) {
+      LOG(log_er_) << "Unable to decode buffered PbftSyncPacket with period " << buffered_period << " from peer "
+                   << buffered.peer->getId().abridged() << ": " << e.what();
+      handleMaliciousSyncWindowPeer(buffered.peer->getId());
+      return;
+    }
+
+    if (!processPeriodData(std::move(buffered_packet), buffered.peer)) {
+      return;
+    }
+  }
+
+  continuePbftSync();
+}
+
+bool PbftSyncPacketHandler::processPeriodData(PbftSyncPacket &&packet, const std::shared_ptr<TaraxaPeer> &peer) {
   const bool pbft_chain_synced = packet.current_block_cert_votes_bundle.has_value();
   const auto pbft_blk_hash = packet.period_data.pbft_blk->getBlockHash();
+  const auto pbft_block_period = packet.period_data.pbft_blk->getPeriod();
 
   std::string received_dag_blocks_str;  // This is just log related stuff
   for (auto const &block : packet.period_data.dag_blocks) {
@@ -55,17 +114,8 @@ void PbftSyncPacketHandler::process(const threadpool::PacketData &packet_data,
     }
   }
 
-  const auto pbft_block_period = packet.period_data.pbft_blk->getPeriod();
-  LOG(log_dg_) << "PbftSyncPacket received. Period: " << pbft_block_period
-               << ", dag Blocks: " << received_dag_blocks_str << " from " << peer->getId();
-
-  peer->markPbftBlockAsKnown(pbft_blk_hash);
-  // Update peer's pbft period if outdated
-  if (peer->pbft_chain_size_ < pbft_block_period) {
-    peer->pbft_chain_size_ = pbft_block_period;
-  }
-
-  LOG(log_tr_) << "Processing pbft block: " << pbft_blk_hash;
+  LOG(log_tr_) << "Processing pbft block: " << pbft_blk_hash << ", period: " << pbft_block_period
+               << ", dag blocks: " << received_dag_blocks_str;
 
   if (pbft_chain_->findPbftBlockInChain(pbft_blk_hash)) {
     LOG(log_wr_) << "PBFT block " << pbft_blk_hash << ", period: " << packet.period_data.pbft_blk->getPeriod()
@@ -75,12 +125,12 @@ void PbftSyncPacketHandler::process(const threadpool::PacketData &packet_data,
       // This can happen if we just got synced and block was cert voted
       if (pbft_chain_synced && pbft_block_period == pbft_mgr_->pbftSyncingPeriod()) {
         pbftSyncComplete();
-        return;
+        return false;
       }
 
       LOG(log_er_) << "Block " << pbft_blk_hash << " period unexpected: " << pbft_block_period
                    << ". Expected period: " << pbft_mgr_->pbftSyncingPeriod() + 1;
-      return;
+      return false;
     }
 
     // Check cert vote matches if final synced block
@@ -89,8 +139,8 @@ void PbftSyncPacketHandler::process(const threadpool::PacketData &packet_data,
         if (vote->getBlockHash() != pbft_blk_hash) {
           LOG(log_er_) << "Invalid cert votes block hash " << vote->getBlockHash() << " instead of " << pbft_blk_hash
                        << " from peer " << peer->getId().abridged() << " received, stop syncing.";
-          peers_state_->handleMaliciousSyncPeer(peer->getId());
-          return;
+          handleMaliciousSyncWindowPeer(peer->getId());
+          return false;
         }
       }
     }
@@ -102,14 +152,14 @@ void PbftSyncPacketHandler::process(const threadpool::PacketData &packet_data,
       if (vote->getBlockHash() != last_pbft_block_hash) {
         LOG(log_er_) << "Invalid cert votes block hash " << vote->getBlockHash() << " instead of "
                      << last_pbft_block_hash << " from peer " << peer->getId().abridged() << " received, stop syncing.";
-        peers_state_->handleMaliciousSyncPeer(peer->getId());
-        return;
+        handleMaliciousSyncWindowPeer(peer->getId());
+        return false;
       }
     }
 
     if (!pbft_mgr_->validatePillarDataInPeriodData(packet.period_data)) {
-      peers_state_->handleMaliciousSyncPeer(peer->getId());
-      return;
+      handleMaliciousSyncWindowPeer(peer->getId());
+      return false;
     }
 
     auto order_hash = PbftManager::calculateOrderHash(packet.period_data.dag_blocks);
@@ -129,8 +179,8 @@ void PbftSyncPacketHandler::process(const threadpool::PacketData &packet_data,
                      << " received " << packet.period_data.pbft_blk->getOrderHash() << "; Dag order: " << blk_order
                      << "; Trx order: " << trx_order << "; from " << peer->getId().abridged() << ", stop syncing.";
       }
-      peers_state_->handleMaliciousSyncPeer(peer->getId());
-      return;
+      handleMaliciousSyncWindowPeer(peer->getId());
+      return false;
     }
 
     // This is special case when queue is empty and we can not say for sure that all votes that are part of this block
@@ -141,8 +191,8 @@ void PbftSyncPacketHandler::process(const threadpool::PacketData &packet_data,
           LOG(log_er_) << "Invalid reward votes in block " << packet.period_data.pbft_blk->getBlockHash()
                        << " from peer " << peer->getId().abridged()
                        << " received, stop syncing. Validation failed. Err: " << vote_is_valid.second;
-          peers_state_->handleMaliciousSyncPeer(peer->getId());
-          return;
+          handleMaliciousSyncWindowPeer(peer->getId());
+          return false;
         }
 
         vote_mgr_->addVerifiedVote(v);
@@ -156,13 +206,13 @@ void PbftSyncPacketHandler::process(const threadpool::PacketData &packet_data,
         // in that case we are probably fully synced
         if (pbft_block_period <= vote_mgr_->getRewardVotesPbftBlockPeriod()) {
           pbft_syncing_state_->setPbftSyncing(false);
-          return;
+          return false;
         }
 
         LOG(log_er_) << "Invalid reward votes in block " << packet.period_data.pbft_blk->getBlockHash() << " from peer "
                      << peer->getId().abridged() << " received, stop syncing.";
-        peers_state_->handleMaliciousSyncPeer(peer->getId());
-        return;
+        handleMaliciousSyncWindowPeer(peer->getId());
+        return false;
       }
     }
 
@@ -176,34 +226,45 @@ void PbftSyncPacketHandler::process(const threadpool::PacketData &packet_data,
     pbft_mgr_->periodDataQueuePush(std::move(packet.period_data), peer->getId(), std::move(current_block_cert_votes));
   }
 
-  auto pbft_sync_period = pbft_mgr_->pbftSyncingPeriod();
-
-  // Reset last sync packet received time
-  pbft_syncing_state_->setLastSyncPacketTime();
-
   if (pbft_chain_synced) {
     pbftSyncComplete();
+    return false;
+  }
+  return true;
+}
+
+void PbftSyncPacketHandler::handleMaliciousSyncWindowPeer(const dev::p2p::NodeID &peer_id) {
+  peers_state_->handleMaliciousSyncPeer(peer_id);
+  pbft_syncing_state_->removePeerSyncWindows(peer_id);
+  std::erase_if(buffered_period_data_, [&peer_id](const auto &it) { return it.second.peer->getId() == peer_id; });
+
+  // Syncing continues with other peers unless it was the syncing peer, which restarts syncing after disconnect
+  if (const auto syncing_peer = pbft_syncing_state_->syncingPeer(); syncing_peer && syncing_peer->getId() != peer_id) {
+    continuePbftSync();
+  }
+}
+
+void PbftSyncPacketHandler::continuePbftSync() {
+  if (!pbft_syncing_state_->isPbftSyncing()) {
     return;
   }
 
-  if (packet.last_block) {
-    // If current sync period is actually bigger than the block we just received we are probably synced
-    if (pbft_sync_period > pbft_block_period) {
-      pbft_syncing_state_->setPbftSyncing(false);
-      return;
-    }
-    if (pbft_syncing_state_->isPbftSyncing()) {
-      if (pbft_sync_period > pbft_chain_->getPbftChainSize() + (10 * kConf.network.sync_level_size)) {
-        LOG(log_tr_) << "Syncing pbft blocks too fast than processing. Has synced period " << pbft_sync_period
-                     << ", PBFT chain size " << pbft_chain_->getPbftChainSize();
-        periodic_events_tp_.post(kDelayedPbftSyncDelayMs, [this] { delayedPbftSync(1); });
-      } else {
-        if (!syncPeerPbft(pbft_sync_period + 1)) {
-          pbft_syncing_state_->setPbftSyncing(false);
-          return;
-        }
-      }
+  auto pbft_sync_period = pbft_mgr_->pbftSyncingPeriod();
+  if (pbft_sync_period > pbft_chain_->getPbftChainSize() + (10 * pbft_syncing_state_->syncLevelSize()) ||
+      isSyncQueueOverMemoryBudget()) {
+    // Windows that are still requested will continue the syncing once they are received, otherwise requests are
+    // resumed once the queue is drained by pushing synced blocks into chain
+    if (pbft_syncing_state_->syncWindows().empty()) {
+      LOG(log_tr_) << "Syncing pbft blocks too fast than processing. Has synced period " << pbft_sync_period
+                   << ", PBFT chain size " << pbft_chain_->getPbftChainSize() << ", sync queue memory usage "
+                   << pbft_mgr_->periodDataQueueMemoryUsage();
+      periodic_events_tp_.post(kDelayedPbftSyncDelayMs, [this] { delayedPbftSync(1); });
     }
+    return;
+  }
+
+  if (!requestPbftSyncWindows()) {
+    pbft_syncing_state_->setPbftSyncing(false);
   }
 }
 
@@ -247,12 +308,14 @@ void PbftSyncPacketHandler::delayedPbftSync(uint32_t counter) {
   }
 
   if (pbft_syncing_state_->isPbftSyncing()) {
-    if (pbft_sync_period > pbft_chain_->getPbftChainSize() + (10 * kConf.network.sync_level_size)) {
+    if (pbft_sync_period > pbft_chain_->getPbftChainSize() + (10 * pbft_syncing_state_->syncLevelSize()) ||
+        isSyncQueueOverMemoryBudget()) {
       LOG(log_tr_) << "Syncing pbft blocks faster than processing " << pbft_sync_period << " "
-                   << pbft_chain_->getPbftChainSize();
+                   << pbft_chain_->getPbftChainSize() << ", sync queue memory usage "
+                   << pbft_mgr_->periodDataQueueMemoryUsage();
       periodic_events_tp_.post(kDelayedPbftSyncDelayMs, [this, counter] { delayedPbftSync(counter + 1); });
     } else {
-      if (!syncPeerPbft(pbft_sync_period + 1)) {
+      if (!requestPbftSyncWindows()) {
         pbft_syncing_state_->setPbftSyncing(false);
       }
     }
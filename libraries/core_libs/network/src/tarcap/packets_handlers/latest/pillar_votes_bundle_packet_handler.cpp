@@ -33,7 +33,17 @@ void PillarVotesBundlePacketHandler::process(const threadpool::PacketData &packe
               << " < ficus hardfork block num";
       throw MaliciousPeerException(err_msg.str());
     }
+  }
+
+  // Signers of all relevant votes are recovered in one batch, validation of single votes then uses the cached signers
+  std::vector<std::shared_ptr<PillarVote>> relevant_votes;
+  relevant_votes.reserve(packet.pillar_votes_bundle.pillar_votes.size());
+  std::copy_if(packet.pillar_votes_bundle.pillar_votes.begin(), packet.pillar_votes_bundle.pillar_votes.end(),
+               std::back_inserter(relevant_votes),
+               [this](const auto &pillar_vote) { return pillar_chain_manager_->isRelevantPillarVote(pillar_vote); });
+  Vote::recoverVoters(relevant_votes);
 
+  for (const auto &pillar_vote : relevant_votes) {
     processPillarVote(pillar_vote, peer);
   }
 }
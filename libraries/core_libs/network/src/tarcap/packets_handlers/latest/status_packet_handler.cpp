@@ -106,7 +106,8 @@ void StatusPacketHandler::process(const threadpool::PacketData& packet_data, con
       if (pbft_synced_period < selected_peer->pbft_chain_size_) {
         LOG(log_nf_) << "Restart PBFT chain syncing. Own synced PBFT at period " << pbft_synced_period
                      << ", peer PBFT chain size " << selected_peer->pbft_chain_size_;
-        if (pbft_synced_period + 1 < selected_peer->pbft_chain_size_) {
+        // Follower gets new blocks only by syncing, so it does not wait for votes of the last block
+        if (pbft_synced_period + 1 < selected_peer->pbft_chain_size_ || kConf.network.follower) {
           startSyncingPbft();
         } else {
           // If we are behind by only one block wait for two status messages before syncing because nodes are not always
@@ -115,13 +116,17 @@ void StatusPacketHandler::process(const threadpool::PacketData& packet_data, con
             startSyncingPbft();
           }
         }
-      } else if (pbft_synced_period == selected_peer->pbft_chain_size_ && !selected_peer->peer_dag_synced_) {
-        // if not syncing and the peer period is matching our period request any pending dag blocks
+      } else if (pbft_synced_period == selected_peer->pbft_chain_size_ && !selected_peer->peer_dag_synced_ &&
+                 !kConf.network.follower) {
+        // if not syncing and the peer period is matching our period request any pending dag blocks, follower does
+        // not need them
         requestPendingDagBlocks(selected_peer);
       }
 
       const auto [pbft_current_round, pbft_current_period] = pbft_mgr_->getPbftRoundAndPeriod();
-      if (pbft_current_period == selected_peer->pbft_period_ && pbft_current_round < selected_peer->pbft_round_) {
+      // Follower does not take part in consensus rounds
+      if (pbft_current_period == selected_peer->pbft_period_ && pbft_current_round < selected_peer->pbft_round_ &&
+          !kConf.network.follower) {
         // TODO: this functionality is implemented in requestPbftNextVotesAtPeriodRound in ExtVotesPacketHandler
         const auto get_next_votes_packet =
             GetNextVotesBundlePacket{.peer_pbft_period = pbft_current_period, .peer_pbft_round = pbft_current_round};
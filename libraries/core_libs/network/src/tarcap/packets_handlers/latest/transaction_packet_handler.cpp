@@ -1,5 +1,6 @@
 #include "network/tarcap/packets_handlers/latest/transaction_packet_handler.hpp"
 
+#include "network/tarcap/packets/latest/get_transactions_packet.hpp"
 #include "network/tarcap/packets/latest/transaction_packet.hpp"
 #include "transaction/transaction.hpp"
 #include "transaction/transaction_manager.hpp"
@@ -9,9 +10,9 @@ namespace taraxa::network::tarcap {
 TransactionPacketHandler::TransactionPacketHandler(const FullNodeConfig &conf, std::shared_ptr<PeersState> peers_state,
                                                    std::shared_ptr<TimePeriodPacketsStats> packets_stats,
                                                    std::shared_ptr<TransactionManager> trx_mgr, const addr_t &node_addr,
-                                                   const std::string &logs_prefix)
+                                                   const std::string &logs_prefix, bool announce_transactions)
     : ITransactionPacketHandler(conf, std::move(peers_state), std::move(packets_stats), node_addr,
-                                logs_prefix + "TRANSACTION_PH"),
+                                logs_prefix + "TRANSACTION_PH", announce_transactions),
       trx_mgr_(std::move(trx_mgr)) {}
 
 inline void TransactionPacketHandler::process(const threadpool::PacketData &packet_data,
@@ -34,9 +35,25 @@ inline void TransactionPacketHandler::process(const threadpool::PacketData &pack
   for (const auto &extra_tx_hash : packet.extra_transactions_hashes) {
     peer->markTransactionAsKnown(extra_tx_hash);
   }
+  if (kAnnounceTransactions) {
+    requestAnnouncedTransactions(peer, packet.extra_transactions_hashes);
+  }
+
+  // Recover senders of unknown transactions in parallel before they are verified one by one
+  SharedTransactions unknown_txs;
+  unknown_txs.reserve(packet.transactions.size());
+  for (const auto &transaction : packet.transactions) {
+    if (!trx_mgr_->isTransactionKnown(transaction->getHash())) {
+      unknown_txs.push_back(transaction);
+    }
+  }
+  trx_mgr_->recoverSenders(unknown_txs);
 
   size_t unseen_txs_count = 0;
   size_t data_size = 0;
+  // Verified transactions are inserted as one batch, so pool lock is taken once per packet
+  SharedTransactions verified_txs;
+  verified_txs.reserve(unknown_txs.size());
   for (auto &transaction : packet.transactions) {
     const auto tx_hash = transaction->getHash();
     data_size += transaction->getData().size();
@@ -57,16 +74,24 @@ inline void TransactionPacketHandler::process(const threadpool::PacketData &pack
     }
 
     received_trx_count_++;
+    verified_txs.push_back(std::move(transaction));
+  }
 
-    const auto status = trx_mgr_->insertValidatedTransaction(std::move(transaction));
-    if (status == TransactionStatus::Inserted) {
+  std::vector<trx_hash_t> verified_hashes;
+  verified_hashes.reserve(verified_txs.size());
+  for (const auto &transaction : verified_txs) {
+    verified_hashes.push_back(transaction->getHash());
+  }
+  const auto statuses = trx_mgr_->insertValidatedTransactions(std::move(verified_txs));
+  for (size_t i = 0; i < statuses.size(); ++i) {
+    if (statuses[i] == TransactionStatus::Inserted) {
       unique_received_trx_count_++;
     }
-    if (status == TransactionStatus::Overflow) {
+    if (statuses[i] == TransactionStatus::Overflow) {
       // Raise exception in trx pool is over the limit and this peer already has too many suspicious packets
       if (peer->reportSuspiciousPacket() && trx_mgr_->nonProposableTransactionsOverTheLimit()) {
         std::ostringstream err_msg;
-        err_msg << "Suspicious packets over the limit on DagBlock transaction " << tx_hash << " validation: " << reason;
+        err_msg << "Suspicious packets over the limit on DagBlock transaction " << verified_hashes[i] << " validation";
         throw MaliciousPeerException(err_msg.str());
       }
     }
@@ -86,6 +111,31 @@ inline void TransactionPacketHandler::process(const threadpool::PacketData &pack
   }
 }
 
+void TransactionPacketHandler::requestAnnouncedTransactions(const std::shared_ptr<TaraxaPeer> &peer,
+                                                            const std::vector<trx_hash_t> &hashes) {
+  GetTransactionsPacket request;
+  auto send_request = [&]() {
+    if (request.transactions_hashes.empty()) {
+      return;
+    }
+    LOG(log_tr_) << "Requesting " << request.transactions_hashes.size() << " announced transactions from "
+                 << peer->getId();
+    sealAndSend(peer->getId(), SubprotocolPacketType::kGetTransactionsPacket, encodePacketRlp(request));
+    request.transactions_hashes.clear();
+  };
+
+  for (const auto &hash : hashes) {
+    if (trx_mgr_->isTransactionKnown(hash) || !peer->markTransactionAsRequested(hash)) {
+      continue;
+    }
+    request.transactions_hashes.push_back(hash);
+    if (request.transactions_hashes.size() == kMaxTransactionsInPacket) {
+      send_request();
+    }
+  }
+  send_request();
+}
+
 void TransactionPacketHandler::sendTransactions(std::shared_ptr<TaraxaPeer> peer,
                                                 std::pair<SharedTransactions, std::vector<trx_hash_t>> &&transactions) {
   if (!peer) return;
@@ -0,0 +1,96 @@
+#include "network/tarcap/packets_handlers/latest/transactions_reconciliation_packet_handler.hpp"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "network/tarcap/packets/latest/transactions_sketch_packet.hpp"
+#include "network/tarcap/shared_states/peers_state.hpp"
+
+namespace taraxa::network::tarcap {
+
+TransactionsReconciliationPacketHandler::TransactionsReconciliationPacketHandler(
+    const FullNodeConfig &conf, std::shared_ptr<PeersState> peers_state,
+    std::shared_ptr<TimePeriodPacketsStats> packets_stats, std::shared_ptr<TransactionManager> trx_mgr,
+    const addr_t &node_addr, const std::string &logs_prefix)
+    : ExtTransactionsReconciliationPacketHandler(conf, std::move(peers_state), std::move(packets_stats),
+                                                 std::move(trx_mgr), node_addr,
+                                                 logs_prefix + "TRANSACTIONS_RECONCILIATION_PH") {}
+
+void TransactionsReconciliationPacketHandler::periodicSendSketches(uint64_t interval_ms) {
+  const auto now = nowMs();
+  std::vector<std::shared_ptr<TaraxaPeer>> peers;
+  for (const auto &peer : peers_state_->getAllPeers()) {
+    // Pool of syncing peer is not relevant
+    if (!peer.second->syncing_ && now >= peer.second->last_sketch_sent_ms_ + interval_ms) {
+      peers.push_back(peer.second);
+    }
+  }
+  if (peers.empty()) {
+    return;
+  }
+
+  const auto pool = getPoolTransactions();
+  for (const auto &peer : peers) {
+    sendSketch(peer, pool);
+  }
+}
+
+void TransactionsReconciliationPacketHandler::sendSketch(const std::shared_ptr<TaraxaPeer> &peer,
+                                                         const PoolTransactions &pool) {
+  const auto capacity = std::clamp(peer->reconciliation_capacity_.load(), kMinReconciliationCapacity,
+                                   kMaxReconciliationCapacity);
+  TransactionsSketchPacket packet{.sketch = makeSketch(TransactionsSketch::cellsCount(capacity), pool).toBytes()};
+  peer->last_sketch_sent_ms_ = nowMs();
+  peer->reconciliation_pending_ = true;
+  if (!sealAndSend(peer->getId(), SubprotocolPacketType::kTransactionsSketchPacket, encodePacketRlp(packet))) {
+    peer->reconciliation_pending_ = false;
+  }
+}
+
+void TransactionsReconciliationPacketHandler::process(const threadpool::PacketData &packet_data,
+                                                      const std::shared_ptr<TaraxaPeer> &peer) {
+  // Decode packet rlp into packet object
+  const auto packet = decodePacketRlp<TransactionsReconciliationPacket>(packet_data.rlp_);
+
+  // Transactions are served only for the sketch that was sent
+  if (!peer->reconciliation_pending_.exchange(false)) {
+    LOG(log_dg_) << "Drop unexpected transactions reconciliation from " << peer->getId();
+    return;
+  }
+
+  const auto capacity = std::max(peer->reconciliation_capacity_.load(), kMinReconciliationCapacity);
+  if (!packet.decoded) {
+    if (capacity >= kMaxReconciliationCapacity) {
+      // Pools are too different, they converge by regular gossip until the next interval
+      LOG(log_dg_) << "Pool difference with " << peer->getId() << " is over the maximal sketch capacity";
+      peer->reconciliation_capacity_ = kMinReconciliationCapacity;
+      return;
+    }
+    peer->reconciliation_capacity_ = std::min(2 * capacity, kMaxReconciliationCapacity);
+    sendSketch(peer, getPoolTransactions());
+    return;
+  }
+
+  if (packet.requested_short_ids.size() > packet.differences_count ||
+      packet.requested_short_ids.size() > TransactionsSketch::kMaxCells) {
+    throw InvalidRlpItemsCountException("TransactionsReconciliationPacket:requested_short_ids",
+                                        packet.requested_short_ids.size(),
+                                        std::min<size_t>(packet.differences_count, TransactionsSketch::kMaxCells));
+  }
+  peer->reconciliation_capacity_ = packet.differences_count;
+
+  const std::unordered_set<uint64_t> requested(packet.requested_short_ids.begin(), packet.requested_short_ids.end());
+  SharedTransactions transactions;
+  if (!requested.empty()) {
+    for (auto &trx : getPoolTransactions()) {
+      if (requested.contains(trx.first)) {
+        transactions.push_back(std::move(trx.second));
+      }
+    }
+  }
+  LOG(log_tr_) << "Pool reconciled by " << peer->getId() << ", " << packet.differences_count
+               << " differences, sending " << transactions.size() << " requested transactions";
+  sendTransactions(peer, std::move(transactions));
+}
+
+}  // namespace taraxa::network::tarcap
@@ -0,0 +1,74 @@
+#include "network/tarcap/packets_handlers/latest/transactions_sketch_packet_handler.hpp"
+
+#include <optional>
+#include <unordered_set>
+
+#include "network/tarcap/packets/latest/transactions_reconciliation_packet.hpp"
+
+namespace taraxa::network::tarcap {
+
+TransactionsSketchPacketHandler::TransactionsSketchPacketHandler(const FullNodeConfig &conf,
+                                                                 std::shared_ptr<PeersState> peers_state,
+                                                                 std::shared_ptr<TimePeriodPacketsStats> packets_stats,
+                                                                 std::shared_ptr<TransactionManager> trx_mgr,
+                                                                 const addr_t &node_addr,
+                                                                 const std::string &logs_prefix)
+    : ExtTransactionsReconciliationPacketHandler(conf, std::move(peers_state), std::move(packets_stats),
+                                                 std::move(trx_mgr), node_addr,
+                                                 logs_prefix + "TRANSACTIONS_SKETCH_PH") {}
+
+void TransactionsSketchPacketHandler::process(const threadpool::PacketData &packet_data,
+                                              const std::shared_ptr<TaraxaPeer> &peer) {
+  // Decode packet rlp into packet object
+  const auto packet = decodePacketRlp<TransactionsSketchPacket>(packet_data.rlp_);
+
+  // Retries with bigger sketch follow failed decoding immediately, so only successful reconciliations are limited
+  const auto now = nowMs();
+  if (now < peer->last_sketch_received_ms_ + kMinSketchIntervalMs) {
+    LOG(log_dg_) << "Drop transactions sketch received too early from " << peer->getId();
+    return;
+  }
+
+  std::optional<TransactionsSketch> peer_sketch;
+  try {
+    peer_sketch = TransactionsSketch::fromBytes(packet.sketch);
+  } catch (const std::invalid_argument &e) {
+    throw MaliciousPeerException(e.what());
+  }
+
+  auto pool = getPoolTransactions();
+  auto sketch = makeSketch(peer_sketch->cellsCount(), pool);
+  sketch.subtract(*peer_sketch);
+  const auto difference = sketch.decode();
+  if (!difference) {
+    LOG(log_dg_) << "Pool difference with " << peer->getId() << " is over sketch of "
+                 << peer_sketch->cellsCount() << " cells";
+    TransactionsReconciliationPacket response{.decoded = false, .differences_count = 0, .requested_short_ids = {}};
+    sealAndSend(peer->getId(), SubprotocolPacketType::kTransactionsReconciliationPacket, encodePacketRlp(response));
+    return;
+  }
+
+  peer->last_sketch_received_ms_ = now;
+
+  // Everything else in the pool is known to the peer, so it is not sent by regular gossip
+  const std::unordered_set<uint64_t> missing_on_peer(difference->local.begin(), difference->local.end());
+  SharedTransactions transactions;
+  for (auto &trx : pool) {
+    if (missing_on_peer.contains(trx.first)) {
+      transactions.push_back(std::move(trx.second));
+    } else {
+      peer->markTransactionAsKnown(trx.second->getHash());
+    }
+  }
+
+  LOG(log_tr_) << "Reconciled pool with " << peer->getId() << ", sending " << transactions.size()
+               << " transactions, requesting " << difference->remote.size();
+  TransactionsReconciliationPacket response{
+      .decoded = true,
+      .differences_count = static_cast<uint32_t>(difference->local.size() + difference->remote.size()),
+      .requested_short_ids = difference->remote};
+  sealAndSend(peer->getId(), SubprotocolPacketType::kTransactionsReconciliationPacket, encodePacketRlp(response));
+  sendTransactions(peer, std::move(transactions));
+}
+
+}  // namespace taraxa::network::tarcap
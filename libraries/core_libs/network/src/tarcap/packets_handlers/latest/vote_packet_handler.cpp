@@ -16,6 +16,19 @@ VotePacketHandler::VotePacketHandler(const FullNodeConfig &conf, std::shared_ptr
                          std::move(pbft_chain), std::move(vote_mgr), std::move(slashing_manager), node_addr,
                          logs_prefix + "PBFT_VOTE_PH") {}
 
+std::optional<threadpool::PacketData::ConsensusHint> VotePacketHandler::peekConsensusHint(
+    const threadpool::PacketData &packet_data) const {
+  // Packet is [vote, optional data], vote is [block hash, vrf sortition [period, round, step, proof], signature, ...]
+  try {
+    const dev::RLP vrf_rlp(packet_data.rlp_[0][1].toBytesConstRef());
+    return threadpool::PacketData::ConsensusHint{vrf_rlp[0].toInt<PbftPeriod>(), vrf_rlp[1].toInt<PbftRound>(),
+                                                 vrf_rlp[2].toInt<PbftStep>()};
+  } catch (const dev::RLPException &) {
+    // Malformed packet is reported by process
+    return {};
+  }
+}
+
 void VotePacketHandler::process(const threadpool::PacketData &packet_data, const std::shared_ptr<TaraxaPeer> &peer) {
   // Decode packet rlp into packet object
   auto packet = decodePacketRlp<VotePacket>(packet_data.rlp_);
@@ -17,6 +17,19 @@ VotesBundlePacketHandler::VotesBundlePacketHandler(const FullNodeConfig &conf, s
                          std::move(pbft_chain), std::move(vote_mgr), std::move(slashing_manager), node_addr,
                          logs_prefix + "VOTES_BUNDLE_PH") {}
 
+std::optional<threadpool::PacketData::ConsensusHint> VotesBundlePacketHandler::peekConsensusHint(
+    const threadpool::PacketData &packet_data) const {
+  // Packet is [bundle], bundle is [block hash, period, round, step, votes]
+  try {
+    const auto bundle_rlp = packet_data.rlp_[0];
+    return threadpool::PacketData::ConsensusHint{bundle_rlp[1].toInt<PbftPeriod>(), bundle_rlp[2].toInt<PbftRound>(),
+                                                 bundle_rlp[3].toInt<PbftStep>()};
+  } catch (const dev::RLPException &) {
+    // Malformed packet is reported by process
+    return {};
+  }
+}
+
 void VotesBundlePacketHandler::process(const threadpool::PacketData &packet_data,
                                        const std::shared_ptr<TaraxaPeer> &peer) {
   // Decode packet rlp into packet object
@@ -56,7 +69,8 @@ void VotesBundlePacketHandler::process(const threadpool::PacketData &packet_data
     check_max_round_step = false;
   }
 
-  size_t processed_votes_count = 0;
+  std::vector<std::shared_ptr<PbftVote>> votes_to_validate;
+  votes_to_validate.reserve(packet.votes_bundle.votes.size());
   for (const auto &vote : packet.votes_bundle.votes) {
     peer->markPbftVoteAsKnown(vote->getHash());
 
@@ -70,7 +84,29 @@ void VotesBundlePacketHandler::process(const threadpool::PacketData &packet_data
                  << vote->getRound() << ", step " << vote->getStep() << ", voter " << vote->getVoterAddr()
                  << " as part of votes bundle";
 
-    if (!processVote(vote, nullptr, peer, check_max_round_step)) {
+    if (!checkVoteBeforeValidation(vote, peer, check_max_round_step)) {
+      continue;
+    }
+
+    votes_to_validate.push_back(vote);
+  }
+
+  // Signatures and vrf proofs of the whole bundle are validated in parallel, voters uniqueness needs recovered voters
+  // so it is checked afterwards
+  const auto validation_results = vote_mgr_->validateVotesBatch(votes_to_validate);
+
+  size_t processed_votes_count = 0;
+  for (size_t i = 0; i < votes_to_validate.size(); i++) {
+    const auto &vote = votes_to_validate[i];
+    if (!validation_results[i].first) {
+      LOG(log_wr_) << "Vote " << vote->getHash() << " validation failed. Err: " << validation_results[i].second;
+      continue;
+    }
+
+    checkUniqueVote(vote);
+
+    if (!vote_mgr_->addVerifiedVote(vote)) {
+      LOG(log_dg_) << "Vote " << vote->getHash() << " already inserted in verified queue(race condition)";
       continue;
     }
 
@@ -38,11 +38,12 @@ void GetPbftSyncPacketHandler::process(const threadpool::PacketData& packet_data
   size_t blocks_to_transfer = 0;
   auto pbft_chain_synced = false;
   const auto total_period_data_size = my_chain_size - packet.height_to_sync + 1;
-  if (total_period_data_size <= kConf.network.sync_level_size) {
+  const auto sync_level_size = pbft_syncing_state_->syncLevelSize();
+  if (total_period_data_size <= sync_level_size) {
     blocks_to_transfer = total_period_data_size;
     pbft_chain_synced = true;
   } else {
-    blocks_to_transfer = kConf.network.sync_level_size;
+    blocks_to_transfer = sync_level_size;
   }
   LOG(log_tr_) << "Will send " << blocks_to_transfer << " PBFT blocks to " << peer->getId();
 
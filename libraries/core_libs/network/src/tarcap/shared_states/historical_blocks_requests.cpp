@@ -0,0 +1,31 @@
+#include "network/tarcap/shared_states/historical_blocks_requests.hpp"
+
+namespace taraxa::network::tarcap {
+
+std::pair<std::shared_future<HistoricalBlocksRequests::Response>, bool> HistoricalBlocksRequests::add(
+    const dev::p2p::NodeID& peer, PbftPeriod period) {
+  std::scoped_lock lock(mutex_);
+  auto [it, inserted] = pending_.try_emplace({peer, period});
+  if (inserted) {
+    it->second.future = it->second.promise.get_future().share();
+  }
+  return {it->second.future, inserted};
+}
+
+bool HistoricalBlocksRequests::complete(const dev::p2p::NodeID& peer, PbftPeriod period, Response&& response) {
+  std::unique_lock lock(mutex_);
+  auto it = pending_.find({peer, period});
+  if (it == pending_.end()) {
+    return false;
+  }
+  auto promise = std::move(it->second.promise);
+  pending_.erase(it);
+  lock.unlock();
+
+  promise.set_value(std::move(response));
+  return true;
+}
+
+void HistoricalBlocksRequests::cancel(const dev::p2p::NodeID& peer, PbftPeriod period) { complete(peer, period, {}); }
+
+}  // namespace taraxa::network::tarcap
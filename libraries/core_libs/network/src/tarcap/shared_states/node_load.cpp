@@ -0,0 +1,73 @@
+#include "network/tarcap/shared_states/node_load.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace taraxa::network::tarcap {
+
+namespace {
+
+template <class T>
+LoadLevel gradeBy(T value, T elevated, T high, T critical) {
+  if (value >= critical) {
+    return LoadLevel::kCritical;
+  }
+  if (value >= high) {
+    return LoadLevel::kHigh;
+  }
+  if (value >= elevated) {
+    return LoadLevel::kElevated;
+  }
+  return LoadLevel::kNormal;
+}
+
+}  // namespace
+
+const char *toString(LoadLevel level) {
+  switch (level) {
+    case LoadLevel::kNormal:
+      return "normal";
+    case LoadLevel::kElevated:
+      return "elevated";
+    case LoadLevel::kHigh:
+      return "high";
+    case LoadLevel::kCritical:
+      return "critical";
+  }
+  return "unknown";
+}
+
+NodeLoad::NodeLoad(size_t max_packets_queue_size, size_t max_transactions_pool_size)
+    : kMaxPacketsQueueSize(max_packets_queue_size), kMaxTransactionsPoolSize(max_transactions_pool_size) {}
+
+LoadLevel NodeLoad::grade(const Sample &sample) const {
+  auto level = std::max(
+      {gradeBy(sample.avg_packet_queue_wait, std::chrono::microseconds(kElevatedPacketQueueWait),
+               std::chrono::microseconds(kHighPacketQueueWait), std::chrono::microseconds(kCriticalPacketQueueWait)),
+       gradeBy(sample.period_data_queue_bytes, kElevatedPeriodDataQueueBytes, kHighPeriodDataQueueBytes,
+               kCriticalPeriodDataQueueBytes),
+       gradeBy(sample.finalization_lag, kElevatedFinalizationLag, kHighFinalizationLag, kCriticalFinalizationLag)});
+  // Queue over the limit was the only overload signal before, so it stays critical
+  if (kMaxPacketsQueueSize) {
+    level = std::max(level, gradeBy(sample.queued_packets, kMaxPacketsQueueSize / 4, kMaxPacketsQueueSize / 2,
+                                    kMaxPacketsQueueSize + 1));
+  }
+  // Full pool rejects new transactions by itself, so it is never critical
+  if (kMaxTransactionsPoolSize) {
+    const auto pool_percentage = sample.transactions_pool_size * 100 / kMaxTransactionsPoolSize;
+    level = std::max(level, gradeBy<size_t>(pool_percentage, 50, 80, SIZE_MAX));
+  }
+  return level;
+}
+
+LoadLevel NodeLoad::update(const Sample &sample) {
+  const auto current = level();
+  auto next = grade(sample);
+  if (next < current) {
+    next = static_cast<LoadLevel>(static_cast<uint8_t>(current) - 1);
+  }
+  level_.store(next, std::memory_order_relaxed);
+  return next;
+}
+
+}  // namespace taraxa::network::tarcap
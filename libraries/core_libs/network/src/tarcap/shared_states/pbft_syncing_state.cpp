@@ -1,11 +1,14 @@
 #include "network/tarcap/shared_states/pbft_syncing_state.hpp"
 
+#include <algorithm>
+
 #include "network/tarcap/packet_types.hpp"
 #include "network/tarcap/shared_states/peers_state.hpp"
 
 namespace taraxa::network::tarcap {
 
-PbftSyncingState::PbftSyncingState(uint16_t deep_syncing_threshold) : kDeepSyncingThreshold(deep_syncing_threshold) {}
+PbftSyncingState::PbftSyncingState(uint16_t deep_syncing_threshold, uint16_t sync_level_size)
+    : kDeepSyncingThreshold(deep_syncing_threshold), sync_level_size_(sync_level_size) {}
 
 std::shared_ptr<TaraxaPeer> PbftSyncingState::syncingPeer() const {
   std::shared_lock lock(peer_mutex_);
@@ -34,6 +37,11 @@ bool PbftSyncingState::setPbftSyncing(bool syncing, PbftPeriod current_period,
   if (pbft_syncing_ && syncing) {
     return false;
   }
+  {
+    // Windows requested in previous syncing are not valid anymore
+    std::unique_lock windows_lock(sync_windows_mutex_);
+    sync_windows_.clear();
+  }
   {
     std::unique_lock lock(peer_mutex_);
     pbft_syncing_ = syncing;
@@ -69,6 +77,55 @@ bool PbftSyncingState::isActivelySyncing() const {
 
 bool PbftSyncingState::isDeepPbftSyncing() const { return deep_pbft_syncing_; }
 
+void PbftSyncingState::addSyncWindow(SyncWindow window) {
+  std::unique_lock lock(sync_windows_mutex_);
+  const auto it = std::upper_bound(sync_windows_.begin(), sync_windows_.end(), window.from,
+                                   [](PbftPeriod from, const SyncWindow& w) { return from < w.from; });
+  sync_windows_.insert(it, std::move(window));
+}
+
+std::vector<PbftSyncingState::SyncWindow> PbftSyncingState::syncWindows() const {
+  std::shared_lock lock(sync_windows_mutex_);
+  return sync_windows_;
+}
+
+bool PbftSyncingState::acceptSyncWindowPeriod(const dev::p2p::NodeID& peer_id, PbftPeriod period,
+                                              bool last_chain_block) {
+  std::unique_lock lock(sync_windows_mutex_);
+  const auto it = std::find_if(sync_windows_.begin(), sync_windows_.end(), [&](const SyncWindow& w) {
+    return w.peer_id == peer_id && w.next == period;
+  });
+  if (it == sync_windows_.end()) {
+    return false;
+  }
+
+  it->next++;
+  it->last_activity = std::chrono::steady_clock::now();
+  if (it->next > it->to || last_chain_block) {
+    sync_windows_.erase(it);
+  }
+  return true;
+}
+
+std::vector<PbftSyncingState::SyncWindow> PbftSyncingState::takeStalledSyncWindows() {
+  std::vector<SyncWindow> stalled;
+  const auto now = std::chrono::steady_clock::now();
+  std::unique_lock lock(sync_windows_mutex_);
+  std::erase_if(sync_windows_, [&](const SyncWindow& w) {
+    if (now - w.last_activity < kSyncWindowTimeout) {
+      return false;
+    }
+    stalled.push_back(w);
+    return true;
+  });
+  return stalled;
+}
+
+void PbftSyncingState::removePeerSyncWindows(const dev::p2p::NodeID& peer_id) {
+  std::unique_lock lock(sync_windows_mutex_);
+  std::erase_if(sync_windows_, [&](const SyncWindow& w) { return w.peer_id == peer_id; });
+}
+
 bool PbftSyncingState::isPbftSyncing() {
   if (!isActivelySyncing()) {
     setPbftSyncing(false);
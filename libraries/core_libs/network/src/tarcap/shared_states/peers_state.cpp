@@ -1,11 +1,15 @@
 #include "network/tarcap/shared_states/peers_state.hpp"
 
+#include <algorithm>
+#include <iterator>
+
 #include "pbft/pbft_manager.hpp"
 
 namespace taraxa::network::tarcap {
 
-PeersState::PeersState(std::weak_ptr<dev::p2p::Host> host, const FullNodeConfig& conf)
-    : host_(std::move(host)), kConf(conf) {}
+PeersState::PeersState(std::weak_ptr<dev::p2p::Host> host, const FullNodeConfig& conf,
+                       std::shared_ptr<UploadBandwidthManager> upload_bandwidth)
+    : host_(std::move(host)), upload_bandwidth_(std::move(upload_bandwidth)), kConf(conf) {}
 
 std::shared_ptr<TaraxaPeer> PeersState::getPeer(const dev::p2p::NodeID& node_id) const {
   std::shared_lock lock(peers_mutex_);
@@ -73,10 +77,29 @@ PeersState::PeersMap PeersState::getAllPeers() const {
   return peers_;
 }
 
+std::vector<std::shared_ptr<TaraxaPeer>> PeersState::getPeersByGossipScore() const {
+  std::vector<std::pair<uint64_t, std::shared_ptr<TaraxaPeer>>> scored;
+  {
+    std::shared_lock lock(peers_mutex_);
+    scored.reserve(peers_.size());
+    for (const auto& peer : peers_) {
+      scored.emplace_back(peer.second->gossipScore(), peer.second);
+    }
+  }
+  std::sort(scored.begin(), scored.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  std::vector<std::shared_ptr<TaraxaPeer>> ret;
+  ret.reserve(scored.size());
+  std::transform(std::make_move_iterator(scored.begin()), std::make_move_iterator(scored.end()),
+                 std::back_inserter(ret), [](auto&& p) { return std::move(p.second); });
+  return ret;
+}
+
 std::shared_ptr<TaraxaPeer> PeersState::addPendingPeer(const dev::p2p::NodeID& node_id, const std::string& address) {
   std::unique_lock lock(peers_mutex_);
-  auto ret =
-      pending_peers_.emplace(node_id, std::make_shared<TaraxaPeer>(node_id, kConf.transactions_pool_size, address));
+  auto ret = pending_peers_.emplace(
+      node_id, std::make_shared<TaraxaPeer>(node_id, address, size_t(kConf.network.peer_known_transactions_kb) * 1024,
+                                            kConf.network.peer_known_transactions_fp_ppm / 1e6));
   if (!ret.second) {
     // LOG(log_er_) << "Peer " << node_id.abridged() << " is already in pending peers list";
   }
@@ -94,6 +117,9 @@ void PeersState::erasePeer(dev::p2p::NodeID const& node_id) {
   std::unique_lock lock(peers_mutex_);
   pending_peers_.erase(node_id);
   peers_.erase(node_id);
+  if (upload_bandwidth_) {
+    upload_bandwidth_->erasePeer(node_id);
+  }
 }
 
 std::shared_ptr<TaraxaPeer> PeersState::setPeerAsReadyToSendMessages(dev::p2p::NodeID const& node_id,
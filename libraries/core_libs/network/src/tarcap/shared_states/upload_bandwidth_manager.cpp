@@ -0,0 +1,86 @@
+#include "network/tarcap/shared_states/upload_bandwidth_manager.hpp"
+
+#include <thread>
+
+namespace taraxa::network::tarcap {
+
+TokenBucket::TokenBucket(uint64_t bytes_per_second, uint64_t burst_bytes)
+    : kBytesPerSecond(bytes_per_second),
+      kBurstBytes(burst_bytes ? burst_bytes : bytes_per_second),
+      tokens_(kBurstBytes),
+      last_refill_(std::chrono::steady_clock::now()) {}
+
+std::chrono::microseconds TokenBucket::consume(size_t bytes, std::chrono::steady_clock::time_point now) {
+  std::scoped_lock lock(mutex_);
+  if (now > last_refill_) {
+    const auto elapsed = std::chrono::duration<double>(now - last_refill_).count();
+    tokens_ = std::min(kBurstBytes, tokens_ + elapsed * kBytesPerSecond);
+    last_refill_ = now;
+  }
+
+  tokens_ -= bytes;
+  if (tokens_ >= 0) {
+    return std::chrono::microseconds{0};
+  }
+  return std::chrono::microseconds(static_cast<uint64_t>(-tokens_ * 1'000'000 / kBytesPerSecond));
+}
+
+UploadBandwidthManager::UploadBandwidthManager(const SyncUploadConfig &config) : kConfig(config) {
+  if (kConfig.total_bytes_per_second) {
+    total_bucket_.emplace(kConfig.total_bytes_per_second, kConfig.burst_bytes);
+  }
+}
+
+bool UploadBandwidthManager::isThrottled(SubprotocolPacketType packet_type) {
+  switch (packet_type) {
+    case SubprotocolPacketType::kPbftSyncPacket:
+    case SubprotocolPacketType::kDagSyncPacket:
+    case SubprotocolPacketType::kHistoricalBlockPacket:
+      return true;
+    default:
+      return false;
+  }
+}
+
+std::chrono::microseconds UploadBandwidthManager::reserve(const dev::p2p::NodeID &node_id, size_t bytes) {
+  sent_bytes_ += bytes;
+  const auto now = std::chrono::steady_clock::now();
+  std::chrono::microseconds wait{0};
+
+  if (kConfig.peer_bytes_per_second) {
+    std::shared_ptr<TokenBucket> peer_bucket;
+    {
+      std::scoped_lock lock(peers_buckets_mutex_);
+      auto &bucket = peers_buckets_[node_id];
+      if (!bucket) {
+        bucket = std::make_shared<TokenBucket>(kConfig.peer_bytes_per_second, kConfig.burst_bytes);
+      }
+      peer_bucket = bucket;
+    }
+    wait = peer_bucket->consume(bytes, now);
+  }
+
+  if (total_bucket_) {
+    wait = std::max(wait, total_bucket_->consume(bytes, now));
+  }
+
+  return wait;
+}
+
+void UploadBandwidthManager::throttle(const dev::p2p::NodeID &node_id, size_t bytes) {
+  const auto wait = reserve(node_id, bytes);
+  if (wait.count() == 0) {
+    return;
+  }
+
+  throttled_packets_count_++;
+  throttle_duration_us_ += wait.count();
+  std::this_thread::sleep_for(wait);
+}
+
+void UploadBandwidthManager::erasePeer(const dev::p2p::NodeID &node_id) {
+  std::scoped_lock lock(peers_buckets_mutex_);
+  peers_buckets_.erase(node_id);
+}
+
+}  // namespace taraxa::network::tarcap
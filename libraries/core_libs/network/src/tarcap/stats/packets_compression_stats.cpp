@@ -0,0 +1,52 @@
+#include "network/tarcap/stats/packets_compression_stats.hpp"
+
+namespace taraxa::network::tarcap {
+
+bool PacketsCompressionStats::shouldCompress(SubprotocolPacketType packet_type) {
+  if (packet_type >= SubprotocolPacketType::kPacketCount) {
+    return true;
+  }
+
+  auto& stats = stats_[packet_type];
+  const auto size = stats.size.load(std::memory_order_relaxed);
+  if (stats.count.load(std::memory_order_relaxed) < kMinSamples || size == 0) {
+    return true;
+  }
+
+  const auto ratio = static_cast<double>(stats.compressed_size.load(std::memory_order_relaxed)) / size;
+  if (ratio < kMaxCompressionRatio) {
+    return true;
+  }
+
+  return stats.skipped.fetch_add(1, std::memory_order_relaxed) % kResampleInterval == 0;
+}
+
+void PacketsCompressionStats::addCompressedPacket(SubprotocolPacketType packet_type, size_t size,
+                                                  size_t compressed_size, std::chrono::microseconds duration) {
+  if (packet_type >= SubprotocolPacketType::kPacketCount) {
+    return;
+  }
+
+  auto& stats = stats_[packet_type];
+  stats.count.fetch_add(1, std::memory_order_relaxed);
+  stats.size.fetch_add(size, std::memory_order_relaxed);
+  stats.compressed_size.fetch_add(compressed_size, std::memory_order_relaxed);
+  stats.duration_us.fetch_add(duration.count(), std::memory_order_relaxed);
+}
+
+std::vector<PacketsCompressionStats::PacketTypeStats> PacketsCompressionStats::getStats() const {
+  std::vector<PacketTypeStats> ret;
+  for (size_t type = 0; type < stats_.size(); type++) {
+    const auto& stats = stats_[type];
+    const auto count = stats.count.load(std::memory_order_relaxed);
+    if (!count) {
+      continue;
+    }
+    ret.push_back({static_cast<SubprotocolPacketType>(type), count, stats.size.load(std::memory_order_relaxed),
+                   stats.compressed_size.load(std::memory_order_relaxed),
+                   std::chrono::microseconds(stats.duration_us.load(std::memory_order_relaxed))});
+  }
+  return ret;
+}
+
+}  // namespace taraxa::network::tarcap
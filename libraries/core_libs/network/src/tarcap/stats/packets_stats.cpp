@@ -1,34 +1,154 @@
 #include "network/tarcap/stats/packets_stats.hpp"
 
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
 namespace taraxa::network::tarcap {
 
+namespace {
+
+constexpr size_t kSharedShard = PacketsStats::kShardsCount - 1;
+
+/**
+ * @brief Shard index of the calling thread, the same in all PacketsStats instances. Index of an exited thread is
+ *        reused by the next new thread, so short-lived threads don't end up in the shared shard
+ */
+class ShardSlot {
+ public:
+  ShardSlot() : index_(acquire()) {}
+  ~ShardSlot() { release(index_); }
+
+  size_t index() const { return index_; }
+
+ private:
+  struct FreeSlots {
+    std::mutex mutex;
+    std::vector<size_t> indexes;
+    size_t next = 0;
+  };
+
+  static FreeSlots &freeSlots() {
+    // Never destroyed, slots are released by thread_local destructors
+    static auto *slots = new FreeSlots;
+    return *slots;
+  }
+
+  static size_t acquire() {
+    auto &slots = freeSlots();
+    std::scoped_lock lock(slots.mutex);
+    if (!slots.indexes.empty()) {
+      const auto index = slots.indexes.back();
+      slots.indexes.pop_back();
+      return index;
+    }
+    return slots.next < kSharedShard ? slots.next++ : kSharedShard;
+  }
+
+  static void release(size_t index) {
+    if (index == kSharedShard) {
+      return;
+    }
+    auto &slots = freeSlots();
+    std::scoped_lock lock(slots.mutex);
+    slots.indexes.push_back(index);
+  }
+
+  const size_t index_;
+};
+
+size_t shardIndex() {
+  static thread_local const ShardSlot slot;
+  return slot.index();
+}
+
+// Only the owner thread of the shard writes its counters, so plain load and store are enough
+void addCounter(std::atomic<uint64_t> &counter, uint64_t value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+void addStats(PacketStats &to, const PacketStats &from) {
+  to.count_ += from.count_;
+  to.size_ += from.size_;
+  to.processing_duration_ += from.processing_duration_;
+  to.tp_wait_duration_ += from.tp_wait_duration_;
+}
+
+std::string timePointToString(std::chrono::system_clock::time_point time_point) {
+  std::time_t time_tt = std::chrono::system_clock::to_time_t(time_point);
+  std::tm time_tm = *std::localtime(&time_tt);
+  std::stringstream time_point_str;
+  time_point_str << std::put_time(&time_tm, "%Y-%m-%d_%H:%M:%S");
+  return time_point_str.str();
+}
+
+}  // namespace
+
 PacketsStats::PacketsStats() : start_time_(std::chrono::system_clock::now()) {}
 
-void PacketsStats::addPacket(const std::string &packet_type, const PacketStats &packet) {
-  std::scoped_lock<std::shared_mutex> lock(mutex_);
-  auto &packet_stats = per_packet_stats_[packet_type];
+void PacketsStats::addPacket(SubprotocolPacketType packet_type, const PacketStats &packet) {
+  if (packet_type >= SubprotocolPacketType::kPacketCount) {
+    return;
+  }
 
-  packet_stats.count_++;
-  packet_stats.size_ += packet.size_;
-  packet_stats.processing_duration_ += packet.processing_duration_;
-  packet_stats.tp_wait_duration_ += packet.tp_wait_duration_;
+  const auto index = shardIndex();
+  auto add = [&packet](Counters &counters) {
+    addCounter(counters.count, 1);
+    addCounter(counters.size, packet.size_);
+    addCounter(counters.processing_duration_us, packet.processing_duration_.count());
+    addCounter(counters.tp_wait_duration_us, packet.tp_wait_duration_.count());
+  };
+
+  auto &counters = shards_[index].per_packet[packet_type];
+  if (index == kSharedShard) {
+    std::scoped_lock lock(shared_shard_mutex_);
+    add(counters);
+  } else {
+    add(counters);
+  }
+}
+
+PacketsStats::PerPacketStats PacketsStats::sumShards() const {
+  PerPacketStats sum{};
+  for (const auto &shard : shards_) {
+    for (size_t type = 0; type < sum.size(); ++type) {
+      const auto &counters = shard.per_packet[type];
+      sum[type].count_ += counters.count.load(std::memory_order_relaxed);
+      sum[type].size_ += counters.size.load(std::memory_order_relaxed);
+      sum[type].processing_duration_ +=
+          std::chrono::microseconds(counters.processing_duration_us.load(std::memory_order_relaxed));
+      sum[type].tp_wait_duration_ +=
+          std::chrono::microseconds(counters.tp_wait_duration_us.load(std::memory_order_relaxed));
+    }
+  }
+  return sum;
+}
 
-  all_packets_stats_.count_++;
-  all_packets_stats_.size_ += packet.size_;
-  all_packets_stats_.processing_duration_ += packet.processing_duration_;
-  all_packets_stats_.tp_wait_duration_ += packet.tp_wait_duration_;
+PacketsStats::PerPacketStats PacketsStats::mergeShards() const {
+  // Counters only grow and snapshot was read before under the same mutex, so differences are never negative
+  auto merged = sumShards();
+  for (size_t type = 0; type < merged.size(); ++type) {
+    merged[type].count_ -= reset_snapshot_[type].count_;
+    merged[type].size_ -= reset_snapshot_[type].size_;
+    merged[type].processing_duration_ -= reset_snapshot_[type].processing_duration_;
+    merged[type].tp_wait_duration_ -= reset_snapshot_[type].tp_wait_duration_;
+  }
+  return merged;
 }
 
 std::pair<std::chrono::system_clock::time_point, PacketStats> PacketsStats::getAllPacketsStatsCopy() const {
-  std::shared_lock<std::shared_mutex> lock(mutex_);
-  return {start_time_, all_packets_stats_};
+  std::scoped_lock lock(mutex_);
+  PacketStats all_packets_stats;
+  for (const auto &packet_stats : mergeShards()) {
+    addStats(all_packets_stats, packet_stats);
+  }
+  return {start_time_, all_packets_stats};
 }
 
 void PacketsStats::resetStats() {
-  std::shared_lock<std::shared_mutex> lock(mutex_);
-
-  all_packets_stats_ = PacketStats{};
-  per_packet_stats_.clear();
+  std::scoped_lock lock(mutex_);
+  reset_snapshot_ = sumShards();
   start_time_ = std::chrono::system_clock::now();
 }
 
@@ -37,35 +157,32 @@ Json::Value PacketsStats::getStatsJson() const {
 
   Json::Value ret;
   auto &packets_stats_json = ret["packets"] = Json::Value(Json::arrayValue);
+  ret["end_time"] = timePointToString(end_time);
 
-  std::time_t end_time_tt = std::chrono::system_clock::to_time_t(end_time);
-  std::tm end_time_tm = *std::localtime(&end_time_tt);
-  std::stringstream end_time_point_str;
-  end_time_point_str << std::put_time(&end_time_tm, "%Y-%m-%d_%H:%M:%S");
-  ret["end_time"] = end_time_point_str.str();
-
-  std::stringstream start_time_point_str;
-
-  std::shared_lock<std::shared_mutex> lock(mutex_);
-
-  std::time_t start_time_tt = std::chrono::system_clock::to_time_t(start_time_);
-  std::tm start_time_tm = *std::localtime(&start_time_tt);
-  start_time_point_str << std::put_time(&start_time_tm, "%Y-%m-%d_%H:%M:%S");
-  ret["start_time"] = start_time_point_str.str();
-
+  std::scoped_lock lock(mutex_);
+  ret["start_time"] = timePointToString(start_time_);
   ret["duration_ms"] = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time_).count();
 
-  Json::Value packet_json = all_packets_stats_.getStatsJson();
+  const auto per_packet_stats = mergeShards();
+  PacketStats all_packets_stats;
+  for (const auto &packet_stats : per_packet_stats) {
+    addStats(all_packets_stats, packet_stats);
+  }
+
+  Json::Value packet_json = all_packets_stats.getStatsJson();
   packet_json["type"] = "ALL_PACKETS_COMBINED";
   packets_stats_json.append(std::move(packet_json));
 
-  for (auto &single_packet_stats : per_packet_stats_) {
-    packet_json = single_packet_stats.second.getStatsJson();
-    packet_json["type"] = single_packet_stats.first;
+  for (size_t type = 0; type < per_packet_stats.size(); ++type) {
+    if (!per_packet_stats[type].count_) {
+      continue;
+    }
+    packet_json = per_packet_stats[type].getStatsJson();
+    packet_json["type"] = convertPacketTypeToString(static_cast<SubprotocolPacketType>(type));
     packets_stats_json.append(std::move(packet_json));
   }
 
   return ret;
 }
 
-}  // namespace taraxa::network::tarcap
\ No newline at end of file
+}  // namespace taraxa::network::tarcap
@@ -12,16 +12,16 @@ TimePeriodPacketsStats::TimePeriodPacketsStats(std::chrono::milliseconds reset_t
   LOG_OBJECTS_CREATE("NETPER");
 }
 
-void TimePeriodPacketsStats::addReceivedPacket(const std::string& packet_type, const dev::p2p::NodeID& node,
+void TimePeriodPacketsStats::addReceivedPacket(SubprotocolPacketType packet_type, const dev::p2p::NodeID& node,
                                                const PacketStats& packet) {
   received_packets_stats_.addPacket(packet_type, packet);
-  LOG(log_tr_) << "Received packet: " << packet.getStatsJsonStr(packet_type, node);
+  LOG(log_tr_) << "Received packet: " << packet.getStatsJsonStr(convertPacketTypeToString(packet_type), node);
 }
 
-void TimePeriodPacketsStats::addSentPacket(const std::string& packet_type, const dev::p2p::NodeID& node,
+void TimePeriodPacketsStats::addSentPacket(SubprotocolPacketType packet_type, const dev::p2p::NodeID& node,
                                            const PacketStats& packet) {
   sent_packets_stats_.addPacket(packet_type, packet);
-  LOG(log_tr_) << "Sent packet: " << packet.getStatsJsonStr(packet_type, node);
+  LOG(log_tr_) << "Sent packet: " << packet.getStatsJsonStr(convertPacketTypeToString(packet_type), node);
 }
 
 std::pair<bool, std::chrono::milliseconds> TimePeriodPacketsStats::validMaxStatsTimePeriod(
@@ -7,16 +7,22 @@
 #include "network/tarcap/packets_handlers/interface/sync_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/latest/dag_block_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/latest/dag_sync_packet_handler.hpp"
+#include "network/tarcap/packets_handlers/latest/get_dag_block_transactions_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/latest/get_dag_sync_packet_handler.hpp"
+#include "network/tarcap/packets_handlers/latest/get_historical_block_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/latest/get_next_votes_bundle_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/latest/get_pbft_sync_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/latest/get_pillar_votes_bundle_packet_handler.hpp"
+#include "network/tarcap/packets_handlers/latest/get_transactions_packet_handler.hpp"
+#include "network/tarcap/packets_handlers/latest/historical_block_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/latest/pbft_blocks_bundle_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/latest/pbft_sync_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/latest/pillar_vote_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/latest/pillar_votes_bundle_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/latest/status_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/latest/transaction_packet_handler.hpp"
+#include "network/tarcap/packets_handlers/latest/transactions_reconciliation_packet_handler.hpp"
+#include "network/tarcap/packets_handlers/latest/transactions_sketch_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/latest/vote_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/latest/votes_bundle_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/v4/get_pbft_sync_packet_handler.hpp"
@@ -32,7 +38,9 @@ namespace taraxa::network::tarcap {
 TaraxaCapability::TaraxaCapability(
     TarcapVersion version, const FullNodeConfig &conf, const h256 &genesis_hash, std::weak_ptr<dev::p2p::Host> host,
     std::shared_ptr<network::threadpool::PacketsThreadPool> threadpool,
-    std::shared_ptr<TimePeriodPacketsStats> packets_stats, std::shared_ptr<PbftSyncingState> syncing_state,
+    std::shared_ptr<TimePeriodPacketsStats> packets_stats,
+    std::shared_ptr<PacketsCompressionStats> compression_stats,
+    std::shared_ptr<UploadBandwidthManager> upload_bandwidth, std::shared_ptr<PbftSyncingState> syncing_state,
     std::shared_ptr<DbStorage> db, std::shared_ptr<PbftManager> pbft_mgr, std::shared_ptr<PbftChain> pbft_chain,
     std::shared_ptr<VoteManager> vote_mgr, std::shared_ptr<DagManager> dag_mgr,
     std::shared_ptr<TransactionManager> trx_mgr, std::shared_ptr<SlashingManager> slashing_manager,
@@ -40,18 +48,22 @@ TaraxaCapability::TaraxaCapability(
     std::shared_ptr<final_chain::FinalChain> final_chain, InitPacketsHandlers init_packets_handlers)
     : version_(version),
       all_packets_stats_(std::move(packets_stats)),
+      compression_stats_(std::move(compression_stats)),
       kConf(conf),
       peers_state_(nullptr),
       pbft_syncing_state_(std::move(syncing_state)),
       packets_handlers_(std::make_shared<PacketsHandler>()),
-      thread_pool_(std::move(threadpool)) {
+      thread_pool_(std::move(threadpool)),
+      vote_mgr_(vote_mgr),
+      dag_mgr_(dag_mgr),
+      trx_mgr_(trx_mgr) {
   // const std::string logs_prefix = "V" + std::to_string(version) + "_";
   const std::string logs_prefix = "";
   const auto &node_addr = kConf.getFirstWallet().node_addr;
 
   LOG_OBJECTS_CREATE(logs_prefix + "TARCAP");
 
-  peers_state_ = std::make_shared<PeersState>(host, kConf);
+  peers_state_ = std::make_shared<PeersState>(host, kConf, std::move(upload_bandwidth));
   packets_handlers_ = init_packets_handlers(logs_prefix, conf, genesis_hash, peers_state_, pbft_syncing_state_,
                                             all_packets_stats_, db, pbft_mgr, pbft_chain, vote_mgr, dag_mgr, trx_mgr,
                                             slashing_manager, pillar_chain_mgr, final_chain, version, node_addr);
@@ -91,20 +103,22 @@ void TaraxaCapability::onConnect(std::weak_ptr<dev::p2p::Session> session, u256
   peers_state_->addPendingPeer(node_id, session_p->info().host + ":" + std::to_string(session_p->info().port));
   LOG(log_nf_) << "Node " << node_id << " connected";
 
-  auto status_packet_handler = getSpecificHandler<ISyncPacketHandler>(network::SubprotocolPacketType::kStatusPacket);
+  auto status_packet_handler = getSpecificHandler<network::SubprotocolPacketType::kStatusPacket>();
   status_packet_handler->sendStatus(node_id, true);
 }
 
 void TaraxaCapability::onDisconnect(dev::p2p::NodeID const &_nodeID) {
   LOG(log_nf_) << "Node " << _nodeID << " disconnected";
   peers_state_->erasePeer(_nodeID);
+  // Windows requested from the peer are requested again from other peers
+  pbft_syncing_state_->removePeerSyncWindows(_nodeID);
 
   const auto syncing_peer = pbft_syncing_state_->syncingPeer();
   if (pbft_syncing_state_->isPbftSyncing() && syncing_peer && syncing_peer->getId() == _nodeID) {
     pbft_syncing_state_->setPbftSyncing(false);
     if (peers_state_->getPeersCount() > 0) {
       LOG(log_dg_) << "Restart PBFT/DAG syncing due to syncing peer disconnect.";
-      getSpecificHandler<ISyncPacketHandler>(network::SubprotocolPacketType::kPbftSyncPacket)->startSyncingPbft();
+      getSpecificHandler<network::SubprotocolPacketType::kPbftSyncPacket>()->startSyncingPbft();
     } else {
       LOG(log_dg_) << "Stop PBFT/DAG syncing due to syncing peer disconnect and no other peers available.";
     }
@@ -115,8 +129,35 @@ std::string TaraxaCapability::packetTypeToString(unsigned _packetType) const {
   return convertPacketTypeToString(static_cast<SubprotocolPacketType>(_packetType));
 }
 
+dev::p2p::PacketPriority TaraxaCapability::packetPriority(unsigned _packetType) const {
+  // Consensus packets first, then blocks, then transactions and (large) sync packets
+  const auto packet_type = static_cast<SubprotocolPacketType>(_packetType);
+  if (packet_type < SubprotocolPacketType::kMidPriorityPackets || packet_type == SubprotocolPacketType::kStatusPacket) {
+    return dev::p2p::PacketPriority::High;
+  }
+  if (packet_type < SubprotocolPacketType::kLowPriorityPackets &&
+      packet_type != SubprotocolPacketType::kTransactionPacket) {
+    return dev::p2p::PacketPriority::Mid;
+  }
+  if (packet_type == SubprotocolPacketType::kPillarVotePacket ||
+      packet_type == SubprotocolPacketType::kPbftBlocksBundlePacket) {
+    return dev::p2p::PacketPriority::Mid;
+  }
+  return dev::p2p::PacketPriority::Low;
+}
+
+bool TaraxaCapability::compressPacket(unsigned _packetType) const {
+  return compression_stats_->shouldCompress(static_cast<SubprotocolPacketType>(_packetType));
+}
+
+void TaraxaCapability::onPacketCompressed(unsigned _packetType, size_t _size, size_t _compressedSize,
+                                          std::chrono::microseconds _duration) {
+  compression_stats_->addCompressedPacket(static_cast<SubprotocolPacketType>(_packetType), _size, _compressedSize,
+                                          _duration);
+}
+
 void TaraxaCapability::interpretCapabilityPacket(std::weak_ptr<dev::p2p::Session> session, unsigned _id,
-                                                 dev::RLP const &_r) {
+                                                 dev::RLP const &_r, dev::p2p::ReceiveBuffer const &buffer) {
   const auto session_p = session.lock();
   if (!session_p) {
     LOG(log_er_) << "Unable to obtain session ptr !";
@@ -132,6 +173,9 @@ void TaraxaCapability::interpretCapabilityPacket(std::weak_ptr<dev::p2p::Session
   }
 
   const SubprotocolPacketType packet_type = static_cast<SubprotocolPacketType>(_id);
+  if (packets_capture_) [[unlikely]] {
+    packets_capture_->record(packet_type, node_id, _r.data());
+  }
 
   // Drop any packet (except StatusPacket) that comes before the connection between nodes is initialized by sending
   // and received initial status packet
@@ -147,6 +191,12 @@ void TaraxaCapability::interpretCapabilityPacket(std::weak_ptr<dev::p2p::Session
     return;
   }
 
+  // Follower does not take part in consensus nor gossip, it only syncs finalized period data
+  if (kConf.network.follower && filterSyncIrrelevantPackets(packet_type)) [[unlikely]] {
+    LOG(log_tr_) << "Ignored " << convertPacketTypeToString(packet_type) << " because node is a follower";
+    return;
+  }
+
   const auto [hp_queue_size, mp_queue_size, lp_queue_size] = thread_pool_->getQueueSize();
   const size_t tp_queue_size = hp_queue_size + mp_queue_size + lp_queue_size;
 
@@ -184,9 +234,115 @@ void TaraxaCapability::interpretCapabilityPacket(std::weak_ptr<dev::p2p::Session
     last_disconnect_number_of_peers_ = 0;
   }
 
-  // TODO: we are making a copy here for each packet bytes(toBytes()), which is pretty significant. Check why RLP does
-  //       not support move semantics so we can take advantage of it...
-  thread_pool_->push({version(), threadpool::PacketData(packet_type, node_id, _r.data().toBytes())});
+  auto packet_data = preFilterPacket(packet_type, _r, buffer, peer.first);
+  if (!packet_data.has_value()) {
+    LOG(log_tr_) << "Dropped " << convertPacketTypeToString(packet_type) << " from " << node_id
+                 << " before queueing, it contains only known data";
+    return;
+  }
+
+  thread_pool_->push({version(), std::move(*packet_data)});
+}
+
+std::optional<threadpool::PacketData> TaraxaCapability::preFilterPacket(SubprotocolPacketType packet_type,
+                                                                        const dev::RLP &packet_rlp,
+                                                                        const dev::p2p::ReceiveBuffer &buffer,
+                                                                        const std::shared_ptr<TaraxaPeer> &peer) const {
+  // Only hashes that are calculated from the exact rlp bytes are checked here. In case peer sent non-canonical rlp, the
+  // hash does not match any known hash and packet is queued & validated by its handler as usual. Malformed packets are
+  // also left to the handlers, which report them properly
+  try {
+    switch (packet_type) {
+      case SubprotocolPacketType::kVotePacket: {
+        // [vote, optional_data = [pbft_block, peer_chain_size]]
+        if (!packet_rlp.isList() || packet_rlp.itemCount() != 2 || !packet_rlp[0].isList()) {
+          break;
+        }
+
+        if (!vote_mgr_->voteAlreadyValidated(dev::sha3(packet_rlp[0].data()))) {
+          break;
+        }
+
+        // Keep peer's chain size up to date as handler would do
+        if (const auto optional_data = packet_rlp[1]; optional_data.isList() && optional_data.itemCount() == 2) {
+          if (const auto peer_chain_size = optional_data[1].toInt<PbftPeriod>();
+              peer_chain_size > peer->pbft_chain_size_) {
+            peer->pbft_chain_size_ = peer_chain_size;
+          }
+        }
+        return {};
+      }
+
+      case SubprotocolPacketType::kDagBlockPacket: {
+        // [transactions, dag_block]
+        if (!packet_rlp.isList() || packet_rlp.itemCount() != 2 || !packet_rlp[0].isList() || !packet_rlp[1].isList()) {
+          break;
+        }
+
+        const auto dag_block_rlp = packet_rlp[1];
+        const blk_hash_t dag_block_hash = dev::sha3(dag_block_rlp.data());
+        if (!dag_mgr_->isDagBlockSeen(dag_block_hash)) {
+          break;
+        }
+
+        for (const auto &tx_rlp : packet_rlp[0]) {
+          peer->markTransactionAsKnown(dev::sha3(tx_rlp.data()));
+        }
+        peer->markDagBlockAsKnown(dag_block_hash);
+        if (const auto dag_level = DagBlock::extract_dag_level_from_rlp(dag_block_rlp); dag_level > peer->dag_level_) {
+          peer->dag_level_ = dag_level;
+        }
+        return {};
+      }
+
+      case SubprotocolPacketType::kTransactionPacket: {
+        // [transactions, extra_transactions_hashes]
+        if (!packet_rlp.isList() || packet_rlp.itemCount() != 2 || !packet_rlp[0].isList() || !packet_rlp[1].isList()) {
+          break;
+        }
+
+        std::vector<dev::bytesConstRef> unknown_txs;
+        unknown_txs.reserve(packet_rlp[0].itemCount());
+        for (const auto &tx_rlp : packet_rlp[0]) {
+          const trx_hash_t tx_hash = dev::sha3(tx_rlp.data());
+          if (trx_mgr_->isTransactionKnown(tx_hash)) {
+            peer->markTransactionAsKnown(tx_hash);
+          } else {
+            unknown_txs.push_back(tx_rlp.data());
+          }
+        }
+
+        if (unknown_txs.size() == packet_rlp[0].itemCount()) {
+          break;
+        }
+
+        // Extra hashes must be still processed by handler
+        if (unknown_txs.empty() && packet_rlp[1].itemCount() == 0) {
+          return {};
+        }
+
+        // Trim known transactions from packet
+        dev::RLPStream s(2);
+        s.appendList(unknown_txs.size());
+        for (const auto &tx_rlp : unknown_txs) {
+          s.appendRaw(tx_rlp);
+        }
+        s.appendRaw(packet_rlp[1].data());
+        return threadpool::PacketData(packet_type, peer->getId(), s.invalidate());
+      }
+
+      default:
+        break;
+    }
+  } catch (const dev::RLPException &e) {
+    LOG(log_dg_) << "Unable to pre-filter " << convertPacketTypeToString(packet_type) << ": " << e.what();
+  }
+
+  if (!buffer) {
+    return threadpool::PacketData(packet_type, peer->getId(), packet_rlp.data().toBytes());
+  }
+  // Packet keeps the received buffer, it is not copied
+  return threadpool::PacketData(packet_type, peer->getId(), buffer, packet_rlp.data());
 }
 
 void TaraxaCapability::handlePacketQueueOverLimit(std::shared_ptr<dev::p2p::Host> host, dev::p2p::NodeID node_id,
@@ -241,6 +397,18 @@ inline bool TaraxaCapability::filterSyncIrrelevantPackets(SubprotocolPacketType
 
 const std::shared_ptr<PeersState> &TaraxaCapability::getPeersState() { return peers_state_; }
 
+void TaraxaCapability::setPacketsCapture(std::shared_ptr<PacketsCapture> capture) {
+  packets_capture_ = std::move(capture);
+}
+
+void TaraxaCapability::replayPacket(PacketsCapture::Record &&record) {
+  if (!peers_state_->getPeer(record.peer)) {
+    auto peer = peers_state_->addPendingPeer(record.peer, "replay");
+    peers_state_->setPeerAsReadyToSendMessages(record.peer, std::move(peer));
+  }
+  thread_pool_->push({version(), threadpool::PacketData(record.type, record.peer, std::move(record.rlp))});
+}
+
 const TaraxaCapability::InitPacketsHandlers TaraxaCapability::kInitLatestVersionHandlers =
     [](const std::string &logs_prefix, const FullNodeConfig &config, const h256 &genesis_hash,
        const std::shared_ptr<PeersState> &peers_state, const std::shared_ptr<PbftSyncingState> &pbft_syncing_state,
@@ -262,10 +430,11 @@ const TaraxaCapability::InitPacketsHandlers TaraxaCapability::kInitLatestVersion
       // Standard packets with mid processing priority
       packets_handlers->registerHandler<DagBlockPacketHandler>(config, peers_state, packets_stats, pbft_syncing_state,
                                                                pbft_chain, pbft_mgr, dag_mgr, trx_mgr, db, node_addr,
-                                                               logs_prefix);
+                                                               logs_prefix, config.network.dag_block_compact_relay);
 
       packets_handlers->registerHandler<TransactionPacketHandler>(config, peers_state, packets_stats, trx_mgr,
-                                                                  node_addr, logs_prefix);
+                                                                  node_addr, logs_prefix,
+                                                                  config.network.transactions_announce_mode);
 
       // Non critical packets with low processing priority
       packets_handlers->registerHandler<StatusPacketHandler>(config, peers_state, packets_stats, pbft_syncing_state,
@@ -293,6 +462,20 @@ const TaraxaCapability::InitPacketsHandlers TaraxaCapability::kInitLatestVersion
                                                                         pillar_chain_mgr, node_addr, logs_prefix);
       packets_handlers->registerHandler<PbftBlocksBundlePacketHandler>(
           config, peers_state, packets_stats, pbft_mgr, final_chain, pbft_syncing_state, node_addr, logs_prefix);
+      packets_handlers->registerHandler<GetTransactionsPacketHandler>(config, peers_state, packets_stats, trx_mgr,
+                                                                      node_addr, logs_prefix);
+      packets_handlers->registerHandler<GetDagBlockTransactionsPacketHandler>(config, peers_state, packets_stats,
+                                                                              dag_mgr, trx_mgr, node_addr, logs_prefix);
+      packets_handlers->registerHandler<TransactionsSketchPacketHandler>(config, peers_state, packets_stats, trx_mgr,
+                                                                         node_addr, logs_prefix);
+      packets_handlers->registerHandler<TransactionsReconciliationPacketHandler>(
+          config, peers_state, packets_stats, trx_mgr, node_addr, logs_prefix);
+      auto historical_blocks_requests = std::make_shared<HistoricalBlocksRequests>();
+      packets_handlers->registerHandler<GetHistoricalBlockPacketHandler>(
+          config, peers_state, packets_stats, historical_blocks_requests, db, node_addr, logs_prefix);
+      packets_handlers->registerHandler<HistoricalBlockPacketHandler>(config, peers_state, packets_stats,
+                                                                      historical_blocks_requests, node_addr,
+                                                                      logs_prefix);
       return packets_handlers;
     };
 
@@ -1,18 +1,24 @@
 #include "network/tarcap/taraxa_peer.hpp"
 
+#include <algorithm>
+#include <limits>
+
 namespace taraxa::network::tarcap {
 
 TaraxaPeer::TaraxaPeer()
     : known_dag_blocks_(10000, 1000, 10),
-      known_transactions_(100000, 10000, 10),
+      known_transactions_(1024 * 1024, 1e-4, kKnownTransactionsExactCount),
+      requested_transactions_(10000, 1000),
       known_pbft_blocks_(10000, 1000, 10),
       known_votes_(10000, 1000, 10) {}
 
-TaraxaPeer::TaraxaPeer(const dev::p2p::NodeID& id, size_t transaction_pool_size, std::string address)
+TaraxaPeer::TaraxaPeer(const dev::p2p::NodeID& id, std::string address, size_t known_transactions_bytes,
+                       double known_transactions_fp_rate)
     : address_(address),
       id_(id),
       known_dag_blocks_(10000, 1000, 10),
-      known_transactions_(transaction_pool_size * 1.2, transaction_pool_size / 10, 10),
+      known_transactions_(known_transactions_bytes, known_transactions_fp_rate, kKnownTransactionsExactCount),
+      requested_transactions_(10000, 1000),
       known_pbft_blocks_(10000, 1000, 10),
       known_votes_(10000, 1000, 10) {}
 
@@ -22,12 +28,12 @@ bool TaraxaPeer::markDagBlockAsKnown(const blk_hash_t& hash) {
 
 bool TaraxaPeer::isDagBlockKnown(const blk_hash_t& hash) const { return known_dag_blocks_.contains(hash); }
 
-bool TaraxaPeer::markTransactionAsKnown(const trx_hash_t& hash) {
-  return known_transactions_.insert(hash, pbft_chain_size_);
-}
+bool TaraxaPeer::markTransactionAsKnown(const trx_hash_t& hash) { return known_transactions_.insert(hash); }
 
 bool TaraxaPeer::isTransactionKnown(const trx_hash_t& hash) const { return known_transactions_.contains(hash); }
 
+bool TaraxaPeer::markTransactionAsRequested(const trx_hash_t& hash) { return requested_transactions_.insert(hash); }
+
 bool TaraxaPeer::markPbftVoteAsKnown(const vote_hash_t& hash) { return known_votes_.insert(hash, pbft_chain_size_); }
 
 bool TaraxaPeer::isPbftVoteKnown(const vote_hash_t& hash) const { return known_votes_.contains(hash); }
@@ -71,7 +77,7 @@ bool TaraxaPeer::requestDagSyncingAllowed() const {
           peer_requested_dag_syncing_time_) > kDagSyncingLimit;
 }
 
-void TaraxaPeer::addSentPacket(const std::string& packet_type, const PacketStats& packet) {
+void TaraxaPeer::addSentPacket(SubprotocolPacketType packet_type, const PacketStats& packet) {
   sent_packets_stats_.addPacket(packet_type, packet);
 }
 
@@ -86,6 +92,22 @@ void TaraxaPeer::resetKnownCaches() {
   known_dag_blocks_.clear();
   known_votes_.clear();
   known_pbft_blocks_.clear();
+  last_sketch_sent_ms_ = 0;
+}
+
+uint64_t TaraxaPeer::gossipScore() const {
+  const uint64_t rtt = ping_rtt_us_;
+  if (!rtt) {
+    return std::numeric_limits<uint64_t>::max();
+  }
+  return rtt - std::min<uint64_t>(rtt / 2, first_delivered_votes_ * 1000);
+}
+
+void TaraxaPeer::decayGossipStats() { first_delivered_votes_ = first_delivered_votes_ / 2; }
+
+size_t TaraxaPeer::knownCachesMemoryUsage() const {
+  return known_dag_blocks_.memoryUsage() + known_transactions_.memoryUsage() + requested_transactions_.memoryUsage() +
+         known_pbft_blocks_.memoryUsage() + known_votes_.memoryUsage();
 }
 
 }  // namespace taraxa::network::tarcap
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "network/tarcap/transactions_sketch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace taraxa::network::tarcap {
+
+namespace {
+
+// splitmix64 finalizer, different seeds give independent hash functions of the id
+uint64_t mix(uint64_t value, uint64_t seed) {
+  value += seed * 0x9e3779b97f4a7c15ULL;
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+  return value ^ (value >> 31);
+}
+
+template <class T>
+void writeLe(uint8_t* out, T value) {
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    out[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+template <class T>
+T readLe(const uint8_t* in) {
+  T value = 0;
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    value |= static_cast<T>(in[i]) << (8 * i);
+  }
+  return value;
+}
+
+}  // namespace
+
+uint64_t TransactionsSketch::shortId(const trx_hash_t& hash) {
+  uint64_t short_id;
+  std::memcpy(&short_id, hash.data(), sizeof(short_id));
+  return short_id;
+}
+
+size_t TransactionsSketch::cellsCount(size_t capacity) {
+  const auto cells = static_cast<size_t>(std::ceil(static_cast<double>(capacity) * kCellsPerDifference));
+  // Rounded up to whole subtables, empty sketch still has one cell in each of them
+  return std::min(kMaxCells, std::max<size_t>(1, (cells + kHashesCount - 1) / kHashesCount) * kHashesCount);
+}
+
+TransactionsSketch::TransactionsSketch(size_t cells_count) : cells_(cells_count) {
+  if (cells_count == 0 || cells_count % kHashesCount || cells_count > kMaxCells) {
+    throw std::invalid_argument("Invalid transactions sketch cells count " + std::to_string(cells_count));
+  }
+}
+
+TransactionsSketch TransactionsSketch::fromBytes(const dev::bytes& bytes) {
+  if (bytes.size() % kCellSize) {
+    throw std::invalid_argument("Invalid transactions sketch size " + std::to_string(bytes.size()));
+  }
+  TransactionsSketch sketch(bytes.size() / kCellSize);
+  auto* in = bytes.data();
+  for (auto& cell : sketch.cells_) {
+    cell.count = static_cast<int32_t>(readLe<uint32_t>(in));
+    cell.ids = readLe<uint64_t>(in + sizeof(uint32_t));
+    cell.checksums = readLe<uint32_t>(in + sizeof(uint32_t) + sizeof(uint64_t));
+    in += kCellSize;
+  }
+  return sketch;
+}
+
+dev::bytes TransactionsSketch::toBytes() const {
+  dev::bytes bytes(cells_.size() * kCellSize);
+  auto* out = bytes.data();
+  for (const auto& cell : cells_) {
+    writeLe(out, static_cast<uint32_t>(cell.count));
+    writeLe(out + sizeof(uint32_t), cell.ids);
+    writeLe(out + sizeof(uint32_t) + sizeof(uint64_t), cell.checksums);
+    out += kCellSize;
+  }
+  return bytes;
+}
+
+void TransactionsSketch::add(uint64_t short_id) { toggle(cells_, short_id, 1); }
+
+void TransactionsSketch::subtract(const TransactionsSketch& other) {
+  if (other.cells_.size() != cells_.size()) {
+    throw std::invalid_argument("Transactions sketches of different sizes can't be subtracted");
+  }
+  for (size_t i = 0; i < cells_.size(); ++i) {
+    cells_[i].count -= other.cells_[i].count;
+    cells_[i].ids ^= other.cells_[i].ids;
+    cells_[i].checksums ^= other.cells_[i].checksums;
+  }
+}
+
+std::optional<TransactionsSketch::Difference> TransactionsSketch::decode() const {
+  auto cells = cells_;
+  Difference difference;
+  std::vector<size_t> pure;
+  for (size_t i = 0; i < cells.size(); ++i) {
+    if (cells[i].pure()) {
+      pure.push_back(i);
+    }
+  }
+
+  // Every peeled id empties at least one cell, more peels mean that a checksum collided and cells are inconsistent
+  for (size_t peeled = 0; !pure.empty() && peeled <= cells.size();) {
+    const auto index = pure.back();
+    pure.pop_back();
+    if (!cells[index].pure()) {
+      continue;
+    }
+    const auto short_id = cells[index].ids;
+    const auto count = cells[index].count;
+    (count > 0 ? difference.local : difference.remote).push_back(short_id);
+    ++peeled;
+    for (size_t h = 0; h < kHashesCount; ++h) {
+      const auto cell_index = cellIndex(short_id, h);
+      toggleCell(cells, cell_index, short_id, -count);
+      if (cells[cell_index].pure()) {
+        pure.push_back(cell_index);
+      }
+    }
+  }
+
+  for (const auto& cell : cells) {
+    if (!cell.empty()) {
+      return {};
+    }
+  }
+  return difference;
+}
+
+uint32_t TransactionsSketch::checksum(uint64_t short_id) {
+  return static_cast<uint32_t>(mix(short_id, kHashesCount));
+}
+
+size_t TransactionsSketch::cellIndex(uint64_t short_id, size_t hash_index) const {
+  const auto subtable_size = cells_.size() / kHashesCount;
+  return hash_index * subtable_size + mix(short_id, hash_index) % subtable_size;
+}
+
+void TransactionsSketch::toggleCell(std::vector<Cell>& cells, size_t index, uint64_t short_id, int32_t count) {
+  cells[index].count += count;
+  cells[index].ids ^= short_id;
+  cells[index].checksums ^= checksum(short_id);
+}
+
+void TransactionsSketch::toggle(std::vector<Cell>& cells, uint64_t short_id, int32_t count) const {
+  for (size_t h = 0; h < kHashesCount; ++h) {
+    toggleCell(cells, cellIndex(short_id, h), short_id, count);
+  }
+}
+
+}  // namespace taraxa::network::tarcap
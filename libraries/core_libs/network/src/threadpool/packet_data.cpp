@@ -4,13 +4,23 @@ namespace taraxa::network::threadpool {
 
 PacketData::PacketData(SubprotocolPacketType type, const dev::p2p::NodeID& from_node_id,
                        std::vector<unsigned char>&& bytes)
-    : rlp_bytes_(std::move(bytes)),
+    : rlp_bytes_(std::make_shared<const dev::bytes>(std::move(bytes))),
       receive_time_(std::chrono::steady_clock::now()),
       type_(type),
       type_str_(convertPacketTypeToString(static_cast<SubprotocolPacketType>(type_))),
       priority_(getPacketPriority(type)),
       from_node_id_(from_node_id),
-      rlp_(dev::RLP(rlp_bytes_)) {}
+      rlp_(dev::RLP(*rlp_bytes_)) {}
+
+PacketData::PacketData(SubprotocolPacketType type, const dev::p2p::NodeID& from_node_id,
+                       std::shared_ptr<const dev::bytes> buffer, dev::bytesConstRef rlp)
+    : rlp_bytes_(std::move(buffer)),
+      receive_time_(std::chrono::steady_clock::now()),
+      type_(type),
+      type_str_(convertPacketTypeToString(static_cast<SubprotocolPacketType>(type_))),
+      priority_(getPacketPriority(type)),
+      from_node_id_(from_node_id),
+      rlp_(rlp) {}
 
 /**
  * @param packet_type
@@ -30,6 +40,22 @@ PacketData::PacketPriority PacketData::getPacketPriority(SubprotocolPacketType p
   assert(false);
 }
 
+bool PacketData::ConsensusHint::isRelevant(PbftPeriod current_period, PbftRound current_round) const {
+  // Steps map to vote types: 3 - cert vote, 4 and above - next vote
+  if (period >= current_period && round >= current_round) {
+    // Standard current or future vote
+    return true;
+  } else if (period == current_period && round == (current_round - 1) && step >= 4) {
+    // Previous round next vote
+    return true;
+  } else if (period == current_period - 1 && step == 3) {
+    // Previous period cert vote - potential reward vote
+    return true;
+  }
+
+  return false;
+}
+
 Json::Value PacketData::getPacketDataJson() const {
   Json::Value ret;
 
@@ -71,14 +71,6 @@ void PacketsBlockingMask::markPacketAsPeerOrderUnblocked(const PacketData& block
   // to keep it always in memory (even with 0 size) rather than deleting and creating it
 }
 
-std::optional<taraxa::level_t> PacketsBlockingMask::getSmallestDagLevelBeingProcessed() const {
-  if (!processing_dag_levels_.empty()) {
-    return {processing_dag_levels_.begin()->first};
-  }
-
-  return {};
-}
-
 dev::RLP PacketsBlockingMask::dagBlockFromDagPacket(const PacketData& packet_data) const {
   if (packet_data.rlp_.itemCount() == kRequiredDagPacketSizeV2) {
     return packet_data.rlp_;
@@ -91,14 +83,19 @@ dev::RLP PacketsBlockingMask::dagBlockFromDagPacket(const PacketData& packet_dat
 }
 
 void PacketsBlockingMask::setDagBlockBeingProcessed(const PacketData& packet) {
-  // Signature is used as id for the dag block since it is cheaper to get signature than to calculate hash at this point
-  // and signature should be unique per dag block
-  sig_t sig = DagBlock::extract_signature_from_rlp(dagBlockFromDagPacket(packet));
+  const auto dag_block_rlp = dagBlockFromDagPacket(packet);
+
+  // Signature is used as id for the dag block since it is cheaper to get signature than to calculate hash when checking
+  // if packet is blocked and signature should be unique per dag block. Hash is calculated only once here so blocks
+  // depending on this one can be found by their pivot & tips
+  sig_t sig = DagBlock::extract_signature_from_rlp(dag_block_rlp);
+  blk_hash_t hash = dev::sha3(dag_block_rlp.data());
 
   // If blocking is working correctly it should not be possible that we already are processing the same block
   assert(processing_dag_blocks_.find(sig) == processing_dag_blocks_.end());
 
-  processing_dag_blocks_.emplace(std::move(sig), packet.id_);
+  processing_dag_blocks_hashes_.insert(hash);
+  processing_dag_blocks_.emplace(std::move(sig), std::move(hash));
 }
 
 void PacketsBlockingMask::unsetDagBlockBeingProcessed(const PacketData& packet) {
@@ -108,49 +105,10 @@ void PacketsBlockingMask::unsetDagBlockBeingProcessed(const PacketData& packet)
   const auto processing_dag_block = processing_dag_blocks_.find(sig);
   assert(processing_dag_block != processing_dag_blocks_.end());
 
+  processing_dag_blocks_hashes_.erase(processing_dag_block->second);
   processing_dag_blocks_.erase(processing_dag_block);
 }
 
-void PacketsBlockingMask::setDagBlockLevelBeingProcessed(const PacketData& packet) {
-  level_t dag_level = DagBlock::extract_dag_level_from_rlp(dagBlockFromDagPacket(packet));
-
-  // Only new dag blocks with smaller or equal level than the smallest level from all blocks currently being processed
-  // are allowed
-  if (const auto smallest_processing_dag_level = getSmallestDagLevelBeingProcessed();
-      smallest_processing_dag_level.has_value()) {
-    assert(dag_level <= *smallest_processing_dag_level);
-  }
-
-  auto& processing_dag_level = processing_dag_levels_[dag_level];
-
-  // If this assert is triggered, it means we are trying to insert blocking packet id that is already inserted, which
-  // should never happen as packets id's are supposed to be unique
-  bool packet_id_inserted = processing_dag_level.insert(packet.id_).second;
-  assert(packet_id_inserted);
-}
-
-void PacketsBlockingMask::unsetDagBlockLevelBeingProcessed(const PacketData& packet) {
-  level_t dag_block_level = DagBlock::extract_dag_level_from_rlp(dagBlockFromDagPacket(packet));
-
-  // There must be existing dag level inside processing_dag_levels_
-  const auto processing_dag_level = processing_dag_levels_.find(dag_block_level);
-  assert(processing_dag_level != processing_dag_levels_.end());
-
-  // There must be existing specific packet_id inside processing_dag_level
-  const auto found_blocking_packet = processing_dag_level->second.find(packet.id_);
-  assert(found_blocking_packet != processing_dag_level->second.end());
-
-  // Delete only blocking packet id if there is currently multiple NewDagBlock packets with the same dag level
-  // being processed
-  if (processing_dag_level->second.size() > 1) {
-    processing_dag_level->second.erase(found_blocking_packet);
-    return;
-  }
-
-  // Delete whole processing_dag_level once the last NewDagBlock packet with the same dag level is processed
-  processing_dag_levels_.erase(processing_dag_level);
-}
-
 bool PacketsBlockingMask::isPacketHardBlocked(const PacketData& packet_data) const {
   // There is no peers_time block for packet_data.type_ packet type
   return hard_blocked_packet_types_.count(packet_data.type_);
@@ -161,18 +119,22 @@ bool PacketsBlockingMask::isDagBlockPacketBlockedBySameDagBlock(const PacketData
   return processing_dag_blocks_.find(sig) != processing_dag_blocks_.end();
 }
 
-bool PacketsBlockingMask::isDagBlockPacketBlockedByLevel(const PacketData& packet_data) const {
-  const auto smallest_processing_dag_level = getSmallestDagLevelBeingProcessed();
-
-  if (!smallest_processing_dag_level.has_value()) {
+bool PacketsBlockingMask::isDagBlockPacketBlockedByDependencies(const PacketData& packet_data) const {
+  if (processing_dag_blocks_hashes_.empty()) {
     return false;
   }
 
-  level_t dag_level = DagBlock::extract_dag_level_from_rlp(dagBlockFromDagPacket(packet_data));
-  if (dag_level > *smallest_processing_dag_level) {
+  const auto dag_block_rlp = dagBlockFromDagPacket(packet_data);
+  if (processing_dag_blocks_hashes_.contains(DagBlock::extract_pivot_from_rlp(dag_block_rlp))) {
     return true;
   }
 
+  for (const auto& tip : DagBlock::extract_tips_from_rlp(dag_block_rlp)) {
+    if (processing_dag_blocks_hashes_.contains(tip)) {
+      return true;
+    }
+  }
+
   return false;
 }
 
@@ -209,9 +171,9 @@ bool PacketsBlockingMask::isPacketBlocked(const PacketData& packet_data) const {
   }
 
   // Custom blocks for specific packet types...
-  // Check if DagBlockPacket is blocked by processing some dag blocks with <= dag level
+  // Check if DagBlockPacket is blocked by processing of the same dag block or of its pivot/tips
   if (packet_data.type_ == SubprotocolPacketType::kDagBlockPacket) {
-    if (isDagBlockPacketBlockedByLevel(packet_data) || isDagBlockPacketBlockedBySameDagBlock(packet_data)) {
+    if (isDagBlockPacketBlockedBySameDagBlock(packet_data) || isDagBlockPacketBlockedByDependencies(packet_data)) {
       return true;
     }
   } else if (packet_data.type_ == SubprotocolPacketType::kPbftBlocksBundlePacket) {
@@ -3,7 +3,7 @@
 namespace taraxa::network::threadpool {
 
 bool PacketsQueue::maxWorkersCountReached() const {
-  if (act_workers_count_ >= kMaxWorkersCount_) {
+  if (act_workers_count_ >= max_workers_count_) {
     return true;
   }
 
@@ -16,26 +16,59 @@ void PacketsQueue::pushBack(std::pair<tarcap::TarcapVersion, PacketData>&& packe
 }
 
 std::optional<std::pair<tarcap::TarcapVersion, PacketData>> PacketsQueue::pop(
-    const PacketsBlockingMask& packets_blocking_mask) {
-  for (auto packet_it = packets_.begin(); packet_it != packets_.end(); ++packet_it) {
+    const PacketsBlockingMask& packets_blocking_mask, const std::optional<ConsensusPosition>& consensus_position) {
+  size_t blocked_packets_count = 0;
+  size_t deferred_packets_count = 0;
+  auto selected_packet_it = packets_.end();
+  for (auto packet_it = packets_.begin(); packet_it != packets_.end();) {
+    const auto& hint = packet_it->second.consensus_hint_;
+    if (hint && consensus_position && !hint->isRelevant(consensus_position->first, consensus_position->second)) {
+      // Vote would be dropped by its handler anyway, so it is dropped before being decoded
+      packet_it = packets_.erase(packet_it);
+      assert(act_packets_count_);
+      act_packets_count_--;
+      dropped_stale_packets_count_++;
+      continue;
+    }
+
     // Packet type is currently blocked for processing
     if (packets_blocking_mask.isPacketBlocked(packet_it->second)) {
+      blocked_packets_count++;
+      ++packet_it;
       continue;
     }
 
-    std::optional<std::pair<tarcap::TarcapVersion, PacketData>> ret = std::move(*packet_it);
-    packets_.erase(packet_it);
-
-    assert(act_packets_count_);
-    act_packets_count_--;
+    // Packets without hint keep the receive order, votes of other rounds are deferred behind votes of the current one
+    if (!hint || !consensus_position || hint->isCurrent(consensus_position->first, consensus_position->second)) {
+      selected_packet_it = packet_it;
+      break;
+    }
+    if (selected_packet_it == packets_.end()) {
+      selected_packet_it = packet_it;
+    }
+    if (++deferred_packets_count >= kMaxConsensusLookahead) {
+      break;
+    }
+    ++packet_it;
+  }
+  blocked_packets_count_ = blocked_packets_count;
 
-    return ret;
+  if (selected_packet_it == packets_.end()) {
+    return {};
   }
 
-  return {};
+  std::optional<std::pair<tarcap::TarcapVersion, PacketData>> ret = std::move(*selected_packet_it);
+  packets_.erase(selected_packet_it);
+
+  assert(act_packets_count_);
+  act_packets_count_--;
+
+  return ret;
 }
 
-void PacketsQueue::setMaxWorkersCount(size_t max_workers_count) { kMaxWorkersCount_ = max_workers_count; }
+void PacketsQueue::setMaxWorkersCount(size_t max_workers_count) { max_workers_count_ = max_workers_count; }
+
+size_t PacketsQueue::getMaxWorkersCount() const { return max_workers_count_; }
 
 void PacketsQueue::incrementActWorkersCount() { act_workers_count_++; }
 
@@ -51,4 +84,8 @@ size_t PacketsQueue::size() const { return act_packets_count_; }
 
 size_t PacketsQueue::getActiveWorkersNum() const { return act_workers_count_; }
 
+size_t PacketsQueue::getBlockedPacketsCount() const { return blocked_packets_count_; }
+
+uint64_t PacketsQueue::getDroppedStalePacketsCount() const { return dropped_stale_packets_count_; }
+
 }  // namespace taraxa::network::threadpool
\ No newline at end of file
@@ -6,33 +6,45 @@ namespace taraxa::network::threadpool {
 
 PriorityQueue::PriorityQueue(size_t tp_workers_count, const std::shared_ptr<PbftManager>& pbft_mgr,
                              const addr_t& node_addr)
-    : blocked_packets_mask_(pbft_mgr), MAX_TOTAL_WORKERS_COUNT(tp_workers_count), act_total_workers_count_(0) {
+    : blocked_packets_mask_(pbft_mgr), pbft_mgr_(pbft_mgr), max_total_workers_count_(0), act_total_workers_count_(0) {
   assert(packets_queues_.size() == PacketData::PacketPriority::Count);
-  // tp_workers_count value should be validated (>=3) after it is read from config
-  assert(tp_workers_count >= 3);
 
   LOG_OBJECTS_CREATE("PRIORITY_QUEUE");
 
-  // high priority packets(consensus - votes) max concurrent workers - 40% of tp_workers_count
-  // mid priority packets(dag/pbft blocks, txs) max concurrent workers - 40% of tp_workers_count
-  // low priority packets(syncing, status, ...) max concurrent workers - 30% of tp_workers_count
-  size_t high_priority_queue_workers = std::max(1, static_cast<int>(MAX_TOTAL_WORKERS_COUNT * 4 / 10));
-  size_t mid_priority_queue_workers = std::max(1, static_cast<int>(MAX_TOTAL_WORKERS_COUNT * 4 / 10));
-  size_t low_priority_queue_workers = std::max(1, static_cast<int>(MAX_TOTAL_WORKERS_COUNT * 3 / 10));
+  setMaxTotalWorkersCount(tp_workers_count);
+}
+
+void PriorityQueue::setMaxTotalWorkersCount(size_t workers_count) {
+  // workers_count value should be validated (>=3) after it is read from config
+  assert(workers_count >= 3);
+
+  // high priority packets(consensus - votes) max concurrent workers - 40% of workers_count
+  // mid priority packets(dag/pbft blocks, txs) max concurrent workers - 40% of workers_count
+  // low priority packets(syncing, status, ...) max concurrent workers - 30% of workers_count
+  size_t high_priority_queue_workers = std::max(1, static_cast<int>(workers_count * 4 / 10));
+  size_t mid_priority_queue_workers = std::max(1, static_cast<int>(workers_count * 4 / 10));
+  size_t low_priority_queue_workers = std::max(1, static_cast<int>(workers_count * 3 / 10));
 
   // It should not be possible to get into a situation when there is not at least 1 free thread for low priority queue
-  assert(high_priority_queue_workers + mid_priority_queue_workers < MAX_TOTAL_WORKERS_COUNT);
+  assert(high_priority_queue_workers + mid_priority_queue_workers < workers_count);
 
+  max_total_workers_count_ = workers_count;
   packets_queues_[PacketData::PacketPriority::High].setMaxWorkersCount(high_priority_queue_workers);
   packets_queues_[PacketData::PacketPriority::Mid].setMaxWorkersCount(mid_priority_queue_workers);
   packets_queues_[PacketData::PacketPriority::Low].setMaxWorkersCount(low_priority_queue_workers);
 
-  LOG(log_nf_) << "Priority queues initialized accordingly: " << "total num of workers = " << MAX_TOTAL_WORKERS_COUNT
+  LOG(log_nf_) << "Priority queues initialized accordingly: " << "total num of workers = " << workers_count
                << ", High priority packets max num of workers = " << high_priority_queue_workers
                << ", Mid priority packets max num of workers = " << mid_priority_queue_workers
                << ", Low priority packets max num of workers = " << low_priority_queue_workers;
 }
 
+size_t PriorityQueue::getMaxTotalWorkersCount() const { return max_total_workers_count_; }
+
+size_t PriorityQueue::getMaxWorkersCount(PacketData::PacketPriority priority) const {
+  return packets_queues_[priority].getMaxWorkersCount();
+}
+
 void PriorityQueue::pushBack(std::pair<tarcap::TarcapVersion, PacketData>&& packet) {
   const auto priority = packet.second.priority_;
   packets_queues_[priority].pushBack(std::move(packet));
@@ -50,12 +62,12 @@ bool PriorityQueue::canBorrowThread() {
     reserved_threads_num++;
   }
 
-  return act_total_workers_count_ < (MAX_TOTAL_WORKERS_COUNT - reserved_threads_num);
+  return act_total_workers_count_ < (max_total_workers_count_ - reserved_threads_num);
 }
 
 std::optional<std::pair<tarcap::TarcapVersion, PacketData>> PriorityQueue::pop() {
-  if (act_total_workers_count_ >= MAX_TOTAL_WORKERS_COUNT) {
-    LOG(log_dg_) << "MAX_TOTAL_WORKERS_COUNT(" << MAX_TOTAL_WORKERS_COUNT << ") reached, unable to pop data.";
+  if (act_total_workers_count_ >= max_total_workers_count_) {
+    LOG(log_dg_) << "Max total workers count(" << max_total_workers_count_ << ") reached, unable to pop data.";
     return {};
   }
 
@@ -65,10 +77,17 @@ std::optional<std::pair<tarcap::TarcapVersion, PacketData>> PriorityQueue::pop()
   // scenarios... For example:
   //
   // High priority queue reached it's max workers limit, other queues have inside many blocked packets that cannot be
-  // currently processed concurrently and MAX_TOTAL_WORKERS_COUNT is not reached yet. In such case some threads might
+  // currently processed concurrently and max total workers count is not reached yet. In such case some threads might
   // be unused. In such cases priority queues max workers limits can and should be ignored
   bool try_borrow_thread = false;
 
+  // Consensus position is read once, so all queues are scanned against the same round
+  std::optional<PacketsQueue::ConsensusPosition> consensus_position;
+  if (pbft_mgr_) {
+    const auto [round, period] = pbft_mgr_->getPbftRoundAndPeriod();
+    consensus_position = {period, round};
+  }
+
   // Get first packet to be processed. Queues are ordered by priority
   // starting with highest priority and ending with lowest priority
   for (auto& queue : packets_queues_) {
@@ -81,7 +100,7 @@ std::optional<std::pair<tarcap::TarcapVersion, PacketData>> PriorityQueue::pop()
       continue;
     }
 
-    if (auto packet = queue.pop(blocked_packets_mask_); packet.has_value()) {
+    if (auto packet = queue.pop(blocked_packets_mask_, consensus_position); packet.has_value()) {
       return packet;
     }
 
@@ -105,8 +124,9 @@ std::optional<std::pair<tarcap::TarcapVersion, PacketData>> PriorityQueue::pop()
       continue;
     }
 
-    if (auto packet = queue.pop(blocked_packets_mask_); packet.has_value()) {
+    if (auto packet = queue.pop(blocked_packets_mask_, consensus_position); packet.has_value()) {
       LOG(log_dg_) << "Thread for packet processing borrowed";
+      borrowed_threads_count_++;
       return packet;
     }
 
@@ -123,26 +143,28 @@ bool PriorityQueue::empty() const {
 }
 
 void PriorityQueue::updateDependenciesStart(const PacketData& packet) {
-  assert(act_total_workers_count_ < MAX_TOTAL_WORKERS_COUNT);
+  assert(act_total_workers_count_ < max_total_workers_count_);
   act_total_workers_count_++;
 
   packets_queues_[packet.priority_].incrementActWorkersCount();
   updateBlockingDependencies(packet);
 }
 
-void PriorityQueue::updateDependenciesFinish(const PacketData& packet, std::mutex& queue_mutex,
-                                             std::condition_variable& cond_var) {
+bool PriorityQueue::updateDependenciesFinish(const PacketData& packet, util::ProfiledExclusiveMutex& queue_mutex) {
   assert(act_total_workers_count_ > 0);
 
+  bool dependencies_released = false;
   if (!isNonBlockingPacket(packet.type_)) {
     // Note: every blocking packet must lock queue_mutex !!!
-    std::unique_lock<std::mutex> lock(queue_mutex);
+    std::unique_lock lock(queue_mutex);
     updateBlockingDependencies(packet, true);
-    cond_var.notify_all();
+    dependencies_released = true;
   }
 
   act_total_workers_count_--;
   packets_queues_[packet.priority_].decrementActWorkersCount();
+
+  return dependencies_released;
 }
 
 bool PriorityQueue::isNonBlockingPacket(SubprotocolPacketType packet_type) const {
@@ -153,6 +175,12 @@ bool PriorityQueue::isNonBlockingPacket(SubprotocolPacketType packet_type) const
     case SubprotocolPacketType::kVotesBundlePacket:
     case SubprotocolPacketType::kStatusPacket:
     case SubprotocolPacketType::kPillarVotePacket:
+    case SubprotocolPacketType::kGetTransactionsPacket:
+    case SubprotocolPacketType::kGetDagBlockTransactionsPacket:
+    case SubprotocolPacketType::kTransactionsSketchPacket:
+    case SubprotocolPacketType::kTransactionsReconciliationPacket:
+    case SubprotocolPacketType::kGetHistoricalBlockPacket:
+    case SubprotocolPacketType::kHistoricalBlockPacket:
       return true;
   }
 
@@ -216,10 +244,8 @@ bool PriorityQueue::updateBlockingDependencies(const PacketData& packet, bool un
 
     case SubprotocolPacketType::kDagBlockPacket: {
       if (!unblock_processing) {
-        blocked_packets_mask_.setDagBlockLevelBeingProcessed(packet);
         blocked_packets_mask_.setDagBlockBeingProcessed(packet);
       } else {
-        blocked_packets_mask_.unsetDagBlockLevelBeingProcessed(packet);
         blocked_packets_mask_.unsetDagBlockBeingProcessed(packet);
       }
       break;
@@ -236,4 +262,18 @@ size_t PriorityQueue::getPrirotityQueueSize(PacketData::PacketPriority priority)
   return packets_queues_[priority].size();
 }
 
+size_t PriorityQueue::getBlockedPacketsCount(PacketData::PacketPriority priority) const {
+  return packets_queues_[priority].getBlockedPacketsCount();
+}
+
+uint64_t PriorityQueue::getBorrowedThreadsCount() const { return borrowed_threads_count_; }
+
+uint64_t PriorityQueue::getDroppedStalePacketsCount() const {
+  uint64_t count = 0;
+  for (const auto& queue : packets_queues_) {
+    count += queue.getDroppedStalePacketsCount();
+  }
+  return count;
+}
+
 }  // namespace taraxa::network::threadpool
@@ -1,10 +1,15 @@
 #include "network/threadpool/tarcap_thread_pool.hpp"
 
+#include "common/thread_placement.hpp"
+#include "metrics/network_threadpool_metrics.hpp"
 #include "network/tarcap/packets_handler.hpp"
 #include "pbft/pbft_manager.hpp"
 
 namespace taraxa::network::threadpool {
 
+// Wait time of every processed packet moves the queue wait average by 1 / kQueueWaitAvgWeight of the difference
+constexpr uint64_t kQueueWaitAvgWeight = 16;
+
 PacketsThreadPool::PacketsThreadPool(size_t workers_num, const std::shared_ptr<PbftManager>& pbft_mgr,
                                      const addr_t& node_addr)
     : workers_num_(workers_num),
@@ -12,7 +17,8 @@ PacketsThreadPool::PacketsThreadPool(size_t workers_num, const std::shared_ptr<P
       stopProcessing_(false),
       packets_count_(0),
       queue_(workers_num, pbft_mgr, node_addr),
-      queue_mutex_(),
+      incoming_packets_(),
+      incoming_mutex_(),
       cond_var_(),
       workers_() {
   LOG_OBJECTS_CREATE("TARCAP_TP");
@@ -39,19 +45,32 @@ std::optional<uint64_t> PacketsThreadPool::push(std::pair<tarcap::TarcapVersion,
     return {};
   }
 
+  // Handlers are set before processing starts, so they can be read by producers without a lock
+  if (const auto packets_handler = packets_handlers_.find(packet_data.first);
+      packets_handler != packets_handlers_.end()) {
+    try {
+      const auto& handler = packets_handler->second->getSpecificHandler(packet_data.second.type_);
+      packet_data.second.consensus_hint_ = handler->peekConsensusHint(packet_data.second);
+    } catch (...) {
+      // Unsupported packet is reported by the worker that processes it
+    }
+  }
+
   std::string packet_type_str = packet_data.second.type_str_;
   uint64_t packet_unique_id;
   {
-    // Put packet into the priority queue
-    std::scoped_lock lock(queue_mutex_);
+    // Stage packet, it is moved into the priority queue by workers
+    std::scoped_lock lock(incoming_mutex_);
 
     // Create packet unique id
     packet_unique_id = packets_count_++;
     packet_data.second.id_ = packet_unique_id;
 
-    queue_.pushBack(std::move(packet_data));
-    cond_var_.notify_one();
+    incoming_packets_count_[packet_data.second.priority_]++;
+    incoming_packets_.push_back(std::move(packet_data));
+    wake_up_seq_++;
   }
+  cond_var_.notify_one();
 
   LOG(log_dg_) << "New packet pushed: " << packet_type_str << ", id(" << packet_unique_id << ")";
   return {packet_unique_id};
@@ -72,7 +91,10 @@ void PacketsThreadPool::startProcessing() {
 }
 
 void PacketsThreadPool::stopProcessing() {
-  stopProcessing_ = true;
+  {
+    std::scoped_lock lock(incoming_mutex_);
+    stopProcessing_ = true;
+  }
   cond_var_.notify_all();
 }
 
@@ -80,11 +102,13 @@ void PacketsThreadPool::stopProcessing() {
  * @brief Threadpool sycnchronized processing function, which calls user-defined custom processing function
  **/
 void PacketsThreadPool::processPacket(size_t worker_id) {
+  util::placeCurrentThread(util::thread_group::kPackets, worker_id);
   LOG(log_dg_) << "Worker (" << worker_id << ") started";
-  std::unique_lock<std::mutex> lock(queue_mutex_, std::defer_lock);
+  std::unique_lock lock(queue_mutex_, std::defer_lock);
 
   // Packet to be processed
   std::optional<std::pair<tarcap::TarcapVersion, PacketData>> packet;
+  std::vector<std::pair<tarcap::TarcapVersion, PacketData>> incoming_packets;
 
   while (stopProcessing_ == false) {
     lock.lock();
@@ -93,13 +117,36 @@ void PacketsThreadPool::processPacket(size_t worker_id) {
     // It can happen that queue is not empty but all of the packets in it are currently blocked, e.g.
     // there are only 2 syncing packets and syncing packets must be processed synchronously 1 by 1. In such case queue
     // is not empty but it would return empty optional as the second syncing packet is blocked by the first one
-    while (!(packet = queue_.pop())) {
+    while (true) {
+      uint64_t wake_up_seq;
+      {
+        std::scoped_lock incoming_lock(incoming_mutex_);
+        incoming_packets.swap(incoming_packets_);
+        wake_up_seq = wake_up_seq_;
+      }
+      for (auto& incoming_packet : incoming_packets) {
+        const auto priority = incoming_packet.second.priority_;
+        queue_.pushBack(std::move(incoming_packet));
+        incoming_packets_count_[priority]--;
+      }
+      incoming_packets.clear();
+
+      if ((packet = queue_.pop())) {
+        break;
+      }
+
       if (stopProcessing_) {
         LOG(log_dg_) << "Worker (" << worker_id << "): finished";
         return;
       }
 
-      cond_var_.wait(lock);
+      // Producers don't need queue_mutex_, so it is released while waiting for new packets or released dependencies
+      lock.unlock();
+      {
+        std::unique_lock incoming_lock(incoming_mutex_);
+        cond_var_.wait(incoming_lock, [&] { return wake_up_seq_ != wake_up_seq || stopProcessing_; });
+      }
+      lock.lock();
     }
 
     LOG(log_dg_) << "Worker (" << worker_id << ") process packet: " << packet->second.type_str_
@@ -108,6 +155,19 @@ void PacketsThreadPool::processPacket(size_t worker_id) {
     queue_.updateDependenciesStart(packet->second);
     lock.unlock();
 
+    const auto processing_start = std::chrono::steady_clock::now();
+    const auto queue_time_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(processing_start - packet->second.receive_time_).count();
+    queue_wait_us_sum_.fetch_add(queue_time_us, std::memory_order_relaxed);
+    queue_wait_count_.fetch_add(1, std::memory_order_relaxed);
+    const auto avg_queue_wait_us = avg_queue_wait_us_.load(std::memory_order_relaxed);
+    avg_queue_wait_us_.store(avg_queue_wait_us - avg_queue_wait_us / kQueueWaitAvgWeight +
+                                 static_cast<uint64_t>(queue_time_us) / kQueueWaitAvgWeight,
+                             std::memory_order_relaxed);
+    if (metrics_) {
+      metrics_->setPacketQueueTime(queue_time_us, {{"packet_type", packet->second.type_str_}});
+    }
+
     try {
       // Get packets handler based on tarcap version
       const auto packets_handler = packets_handlers_.find(packet->first);
@@ -134,8 +194,21 @@ void PacketsThreadPool::processPacket(size_t worker_id) {
                    << " processing unknown exception caught";
     }
 
+    if (metrics_) {
+      metrics_->setPacketProcessingTime(std::chrono::duration_cast<std::chrono::microseconds>(
+                                            std::chrono::steady_clock::now() - processing_start)
+                                            .count(),
+                                        {{"packet_type", packet->second.type_str_}});
+    }
+
     // Once packet handler is done with processing, update priority queue dependencies
-    queue_.updateDependenciesFinish(packet->second, queue_mutex_, cond_var_);
+    if (queue_.updateDependenciesFinish(packet->second, queue_mutex_)) {
+      {
+        std::scoped_lock incoming_lock(incoming_mutex_);
+        wake_up_seq_++;
+      }
+      cond_var_.notify_all();
+    }
   }
 }
 
@@ -148,9 +221,102 @@ void PacketsThreadPool::setPacketsHandlers(tarcap::TarcapVersion tarcap_version,
 }
 
 std::tuple<size_t, size_t, size_t> PacketsThreadPool::getQueueSize() const {
-  return {queue_.getPrirotityQueueSize(PacketData::PacketPriority::High),
-          queue_.getPrirotityQueueSize(PacketData::PacketPriority::Mid),
-          queue_.getPrirotityQueueSize(PacketData::PacketPriority::Low)};
+  return {queue_.getPrirotityQueueSize(PacketData::PacketPriority::High) +
+              incoming_packets_count_[PacketData::PacketPriority::High],
+          queue_.getPrirotityQueueSize(PacketData::PacketPriority::Mid) +
+              incoming_packets_count_[PacketData::PacketPriority::Mid],
+          queue_.getPrirotityQueueSize(PacketData::PacketPriority::Low) +
+              incoming_packets_count_[PacketData::PacketPriority::Low]};
+}
+
+std::tuple<size_t, size_t, size_t> PacketsThreadPool::getBlockedPacketsCount() const {
+  return {queue_.getBlockedPacketsCount(PacketData::PacketPriority::High),
+          queue_.getBlockedPacketsCount(PacketData::PacketPriority::Mid),
+          queue_.getBlockedPacketsCount(PacketData::PacketPriority::Low)};
+}
+
+uint64_t PacketsThreadPool::getBorrowedThreadsCount() const { return queue_.getBorrowedThreadsCount(); }
+
+uint64_t PacketsThreadPool::getDroppedStalePacketsCount() const { return queue_.getDroppedStalePacketsCount(); }
+
+void PacketsThreadPool::enableWorkersScaling(const PacketsProcessingScalingConfig& config, size_t initial_workers) {
+  assert(workers_.empty());
+  assert(workers_num_ >= config.max_threads);
+
+  workers_scaler_ = std::make_unique<WorkersScaler>(config, initial_workers);
+  // Measures cpu times the first adjustment is compared to
+  workers_scaler_->measureCpuIdle();
+
+  std::scoped_lock lock(queue_mutex_);
+  queue_.setMaxTotalWorkersCount(workers_scaler_->workers());
+}
+
+void PacketsThreadPool::scaleWorkers() {
+  if (!workers_scaler_) {
+    return;
+  }
+
+  WorkersScaler::Sample sample;
+  const auto wait_count = queue_wait_count_.exchange(0, std::memory_order_relaxed);
+  const auto wait_us_sum = queue_wait_us_sum_.exchange(0, std::memory_order_relaxed);
+  const auto [hp_queue_size, mp_queue_size, lp_queue_size] = getQueueSize();
+  sample.queued_packets = hp_queue_size + mp_queue_size + lp_queue_size;
+  if (wait_count) {
+    sample.avg_queue_wait = std::chrono::microseconds(wait_us_sum / wait_count);
+  } else if (sample.queued_packets) {
+    // Nothing was taken for processing although packets are waiting, all workers are stuck on long packets
+    sample.avg_queue_wait = std::chrono::microseconds::max();
+  }
+  sample.cpu_idle = workers_scaler_->measureCpuIdle();
+
+  const auto prev_workers = workers_scaler_->workers();
+  const auto workers = workers_scaler_->adjust(sample);
+  if (workers == prev_workers) {
+    return;
+  }
+
+  LOG(log_nf_) << "Packets processing workers scaled " << prev_workers << " -> " << workers
+               << ", avg queue wait: " << sample.avg_queue_wait.count() << " us, queued packets: "
+               << sample.queued_packets << ", cpu idle: " << (sample.cpu_idle ? *sample.cpu_idle : -1);
+  applyActiveWorkersCount(workers);
+}
+
+bool PacketsThreadPool::setActiveWorkersCount(size_t workers) {
+  if (workers_scaler_ || workers < 3 || workers > workers_num_) {
+    return false;
+  }
+  LOG(log_nf_) << "Packets processing workers set " << getActiveWorkersCount() << " -> " << workers;
+  applyActiveWorkersCount(workers);
+  return true;
+}
+
+void PacketsThreadPool::applyActiveWorkersCount(size_t workers) {
+  {
+    std::scoped_lock lock(queue_mutex_);
+    queue_.setMaxTotalWorkersCount(workers);
+  }
+  // Workers that were not allowed to take packets so far have to check the queue again
+  {
+    std::scoped_lock incoming_lock(incoming_mutex_);
+    wake_up_seq_++;
+  }
+  cond_var_.notify_all();
+}
+
+std::chrono::microseconds PacketsThreadPool::getAvgQueueWait() const {
+  return std::chrono::microseconds(avg_queue_wait_us_.load(std::memory_order_relaxed));
+}
+
+size_t PacketsThreadPool::getActiveWorkersCount() const { return queue_.getMaxTotalWorkersCount(); }
+
+std::tuple<size_t, size_t, size_t> PacketsThreadPool::getWorkersLimits() const {
+  return {queue_.getMaxWorkersCount(PacketData::PacketPriority::High),
+          queue_.getMaxWorkersCount(PacketData::PacketPriority::Mid),
+          queue_.getMaxWorkersCount(PacketData::PacketPriority::Low)};
+}
+
+void PacketsThreadPool::setMetrics(std::shared_ptr<metrics::NetworkThreadpoolMetrics> metrics) {
+  metrics_ = std::move(metrics);
 }
 
-}  // namespace taraxa::network::threadpool
\ No newline at end of file
+}  // namespace taraxa::network::threadpool
@@ -0,0 +1,48 @@
+#include "network/threadpool/workers_scaler.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <utility>
+
+namespace taraxa::network::threadpool {
+
+WorkersScaler::WorkersScaler(const PacketsProcessingScalingConfig& config, size_t initial_workers)
+    : kConfig(config), workers_(std::clamp<size_t>(initial_workers, config.min_threads, config.max_threads)) {}
+
+size_t WorkersScaler::adjust(const Sample& sample) {
+  const auto can_grow = !sample.cpu_idle || *sample.cpu_idle >= kMinCpuIdleToGrow;
+  if (sample.avg_queue_wait > std::chrono::milliseconds(kConfig.grow_wait_ms) && can_grow) {
+    workers_ = std::min<size_t>(workers_ + std::max<size_t>(1, workers_ / 4), kConfig.max_threads);
+  } else if (sample.avg_queue_wait < std::chrono::milliseconds(kConfig.shrink_wait_ms) &&
+             sample.queued_packets < workers_) {
+    workers_ = std::max<size_t>(workers_ - 1, kConfig.min_threads);
+  }
+  return workers_;
+}
+
+std::optional<double> WorkersScaler::measureCpuIdle() {
+  // First line of /proc/stat: cpu user nice system idle iowait irq softirq steal ...
+  std::ifstream stat("/proc/stat");
+  std::string cpu;
+  if (!(stat >> cpu) || cpu != "cpu") {
+    return {};
+  }
+  uint64_t total = 0, idle = 0, value = 0;
+  for (size_t i = 0; i < 8 && stat >> value; ++i) {
+    total += value;
+    // idle and iowait
+    if (i == 3 || i == 4) {
+      idle += value;
+    }
+  }
+
+  const std::array<uint64_t, 2> cpu_times{total, idle};
+  const auto prev_cpu_times = std::exchange(prev_cpu_times_, cpu_times);
+  if (!prev_cpu_times || total <= (*prev_cpu_times)[0]) {
+    return {};
+  }
+  return static_cast<double>(idle - (*prev_cpu_times)[1]) / static_cast<double>(total - (*prev_cpu_times)[0]);
+}
+
+}  // namespace taraxa::network::threadpool
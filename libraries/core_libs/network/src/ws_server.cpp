@@ -4,6 +4,8 @@
 #include <json/writer.h>
 #include <libdevcore/CommonJS.h>
 
+#include <algorithm>
+#include <array>
 #include <boost/beast/websocket/rfc6455.hpp>
 
 #include "network/rpc/eth/data.hpp"
@@ -12,12 +14,26 @@
 namespace taraxa::net {
 namespace http = beast::http;
 
+WsSession::~WsSession() {
+  if (const auto queued = write_queue_.size() + (writing_ ? 1 : 0); queued) {
+    if (auto ws_server = ws_server_.lock()) ws_server->queuedMessagesChanged(-static_cast<int64_t>(queued));
+  }
+}
+
 void WsSession::run() {
   // Set suggested timeout settings for the websocket
   ws_.set_option(websocket::stream_base::timeout::suggested(beast::role_type::server));
 
-  // Enable permessage deflate for compression - DONT INCREASE ABOVE 14 it crashes node while running with indexer
-  ws_.set_option(websocket::permessage_deflate{true, true, 14, 14});
+  if (kCompressionConfig.enabled) {
+    websocket::permessage_deflate deflate;
+    deflate.server_enable = true;
+    deflate.client_enable = true;
+    deflate.server_max_window_bits = kCompressionConfig.max_window_bits;
+    deflate.client_max_window_bits = kCompressionConfig.max_window_bits;
+    deflate.compLevel = kCompressionConfig.level;
+    deflate.msg_size_threshold = kCompressionConfig.min_message_size;
+    ws_.set_option(deflate);
+  }
 
   // Set a decorator to change the Server of the handshake
   ws_.set_option(websocket::stream_base::decorator([](websocket::response_type &res) {
@@ -96,26 +112,36 @@ void WsSession::handleRequest() {
     return;
   }
 
+  if (dispatchRequest(request)) {
+    return;
+  }
+
   LOG(log_tr_) << "Before executor.post ";
   boost::asio::post(executor, [self = shared_from_this(), request = std::move(request)]() mutable {
-    auto ws_server = self->ws_server_.lock();
-    if (ws_server && ws_server->metrics_) {
-      auto start_time = std::chrono::steady_clock::now();
-      self->do_write(self->processRequest(request));
-      auto end_time = std::chrono::steady_clock::now();
-      auto processing_time = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
-      ws_server->metrics_->report(request, self->ip_, "WebSocket", processing_time.count());
-    } else {
-      self->do_write(self->processRequest(request));
-    }
+    self->processAndWrite(request);
   });
   LOG(log_tr_) << "After executor.post ";
 }
 
-void WsSession::do_write(std::string &&message) {
+void WsSession::processAndWrite(const std::string &request) {
+  auto ws_server = ws_server_.lock();
+  if (ws_server && ws_server->metrics_) {
+    auto start_time = std::chrono::steady_clock::now();
+    do_write(processRequest(request));
+    auto end_time = std::chrono::steady_clock::now();
+    auto processing_time = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+    ws_server->metrics_->report(request, ip_, "WebSocket", processing_time.count());
+  } else {
+    do_write(processRequest(request));
+  }
+}
+
+void WsSession::do_write(WsMessage &&message) {
   if (is_closed()) return;
 
-  LOG(log_tr_) << "WS WRITE " << message.c_str();
+  if (message.body) {
+    LOG(log_tr_) << "WS WRITE " << message.prefix << *message.body << message.suffix;
+  }
 
   if (const auto executor = ws_.get_executor(); !executor) {
     LOG(log_tr_) << "Executor missing - WS closed";
@@ -123,22 +149,77 @@ void WsSession::do_write(std::string &&message) {
     return;
   }
 
-  LOG(log_tr_) << "Before async_write";
   boost::asio::post(write_strand_, [self = shared_from_this(), message = std::move(message)]() mutable {
-    self->write(std::move(message));
+    self->enqueue(std::move(message));
   });
-  LOG(log_tr_) << "After async_write";
 }
 
-void WsSession::write(std::string &&message) {
+void WsSession::enqueue(WsMessage &&message) {
   if (is_closed()) return;
 
-  try {
-    ws_.text(true);  // as we are using text msg here
-    ws_.write(boost::asio::buffer(std::move(message)));
-  } catch (const boost::system::system_error &e) {
-    // LOG(log_nf_) << "WS closed in on_write " << e.what();
-    return close(is_normal(e.code()));
+  auto ws_server = ws_server_.lock();
+  if (write_queue_.size() >= kWriteQueueConfig.limit) {
+    if (ws_server) ws_server->messageDropped();
+
+    switch (kWriteQueueConfig.overflow_policy) {
+      case WsQueueOverflowPolicy::Disconnect:
+        LOG(log_nf_) << "WS write queue of " << ip_ << " is full, disconnecting";
+        return close(false);
+      case WsQueueOverflowPolicy::Coalesce:
+        if (message.subscription_id) {
+          const auto same_subscription =
+              std::find_if(write_queue_.begin(), write_queue_.end(), [&](const WsMessage &queued) {
+                return queued.subscription_id == message.subscription_id;
+              });
+          if (same_subscription != write_queue_.end()) {
+            *same_subscription = std::move(message);
+            return;
+          }
+        }
+        [[fallthrough]];
+      case WsQueueOverflowPolicy::DropOldest:
+        write_queue_.pop_front();
+        if (ws_server) ws_server->queuedMessagesChanged(-1);
+        break;
+    }
+  }
+
+  write_queue_.push_back(std::move(message));
+  if (ws_server) ws_server->queuedMessagesChanged(1);
+
+  if (!writing_) {
+    write_front();
+  }
+}
+
+void WsSession::write_front() {
+  writing_message_ = std::move(write_queue_.front());
+  write_queue_.pop_front();
+  std::array<boost::asio::const_buffer, 3> buffers{
+      boost::asio::buffer(writing_message_.prefix),
+      writing_message_.body ? boost::asio::buffer(*writing_message_.body) : boost::asio::const_buffer(),
+      boost::asio::buffer(writing_message_.suffix),
+  };
+
+  writing_ = true;
+  ws_.binary(writing_message_.binary);
+  ws_.async_write(buffers, boost::asio::bind_executor(
+                               write_strand_, beast::bind_front_handler(&WsSession::on_write, shared_from_this())));
+}
+
+void WsSession::on_write(beast::error_code ec, std::size_t bytes_transferred) {
+  boost::ignore_unused(bytes_transferred);
+  writing_ = false;
+  writing_message_ = {};
+  if (auto ws_server = ws_server_.lock()) ws_server->queuedMessagesChanged(-1);
+
+  if (ec) {
+    LOG(log_nf_) << "WS closed in on_write " << ec;
+    return close(is_normal(ec));
+  }
+
+  if (!write_queue_.empty() && !is_closed()) {
+    write_front();
   }
 }
 
@@ -164,35 +245,48 @@ bool WsSession::is_normal(const beast::error_code &ec) {
 
 bool WsSession::is_closed() const { return closed_ || !ws_.is_open(); }
 
-void WsSession::newEthBlock(const Json::Value &payload) { subscriptions_.process(SubscriptionType::HEADS, payload); }
-void WsSession::newDagBlock(const Json::Value &payload) {
+void WsSession::newEthBlock(const SubscriptionPayload &payload) {
+  subscriptions_.process(SubscriptionType::HEADS, payload);
+}
+void WsSession::newDagBlock(const SubscriptionPayload &payload) {
   subscriptions_.process(SubscriptionType::DAG_BLOCKS, payload);
 }
 
-void WsSession::newDagBlockFinalized(const Json::Value &payload) {
+void WsSession::newDagBlockFinalized(const SubscriptionPayload &payload) {
   subscriptions_.process(SubscriptionType::DAG_BLOCK_FINALIZED, payload);
 }
 
-void WsSession::newPbftBlockExecuted(const Json::Value &payload) {
+void WsSession::newPbftBlockExecuted(const SubscriptionPayload &payload) {
   subscriptions_.process(SubscriptionType::PBFT_BLOCK_EXECUTED, payload);
 }
 
-void WsSession::newPillarBlockData(const Json::Value &payload) {
+void WsSession::newPillarBlockData(const SubscriptionPayload &payload) {
   subscriptions_.process(SubscriptionType::PILLAR_BLOCK, payload);
 }
 
-void WsSession::newPendingTransaction(const Json::Value &payload) {
+void WsSession::newPendingTransaction(const SubscriptionPayload &payload) {
   subscriptions_.process(SubscriptionType::TRANSACTIONS, payload);
 }
 
-void WsSession::newLogs(const final_chain::BlockHeader &header, TransactionHashes trx_hashes,
-                        const TransactionReceipts &receipts) {
-  subscriptions_.processLogs(header, trx_hashes, receipts);
+void WsSession::newPendingTransactionsBatch(const SubscriptionPayload &payload) {
+  subscriptions_.process(SubscriptionType::TRANSACTIONS_BATCH, payload);
+}
+
+void WsSession::collectLogsSubscriptions(LogsSubscriptionsIndex &index) {
+  subscriptions_.collectLogsSubscriptions(index);
 }
 
 WsServer::WsServer(boost::asio::io_context &ioc, tcp::endpoint endpoint, addr_t node_addr,
-                   std::shared_ptr<metrics::JsonRpcMetrics> metrics)
-    : ioc_(ioc), acceptor_(ioc), node_addr_(std::move(node_addr)), metrics_(metrics) {
+                   std::shared_ptr<metrics::JsonRpcMetrics> metrics, WsWriteQueueConfig write_queue_config,
+                   WsCompressionConfig compression_config, WsTransactionsBatchConfig transactions_batch_config)
+    : ioc_(ioc),
+      acceptor_(ioc),
+      transactions_batch_timer_(ioc),
+      node_addr_(std::move(node_addr)),
+      kWriteQueueConfig(write_queue_config),
+      kCompressionConfig(compression_config),
+      kTransactionsBatchConfig(transactions_batch_config),
+      metrics_(metrics) {
   LOG_OBJECTS_CREATE("WS_SERVER");
   beast::error_code ec;
 
@@ -275,8 +369,14 @@ void WsServer::newEthBlock(const ::taraxa::final_chain::BlockHeader &header, con
   boost::shared_lock<boost::shared_mutex> lock(sessions_mtx_);
   if (sessions_.empty()) return;
 
-  auto payload = rpc::eth::toJson(header);
-  payload["transactions"] = rpc::eth::toJsonArray(trx_hashes);
+  auto json = rpc::eth::toJson(header);
+  json["transactions"] = rpc::eth::toJsonArray(trx_hashes);
+  const SubscriptionPayload payload(std::move(json), [&] {
+    dev::RLPStream encoding(2);
+    header.ethereumRlp(encoding);
+    encoding << trx_hashes;
+    return encoding.invalidate();
+  });
 
   for (auto const &session : sessions_) {
     if (!session->is_closed()) {
@@ -290,18 +390,20 @@ void WsServer::newLogs(const ::taraxa::final_chain::BlockHeader &header, Transac
   boost::shared_lock<boost::shared_mutex> lock(sessions_mtx_);
   if (sessions_.empty()) return;
 
+  LogsSubscriptionsIndex index;
   for (auto const &session : sessions_) {
     if (!session->is_closed()) {
-      session->newLogs(header, trx_hashes, receipts);
+      session->collectLogsSubscriptions(index);
     }
   }
+  index.process(header, trx_hashes, receipts);
 }
 
 void WsServer::newDagBlock(const std::shared_ptr<DagBlock> &blk) {
   boost::shared_lock<boost::shared_mutex> lock(sessions_mtx_);
   if (sessions_.empty()) return;
 
-  auto payload = blk->getJson();
+  const SubscriptionPayload payload(blk->getJson());
   for (auto const &session : sessions_) {
     if (!session->is_closed()) session->newDagBlock(payload);
   }
@@ -311,9 +413,10 @@ void WsServer::newDagBlockFinalized(const blk_hash_t &hash, uint64_t period) {
   boost::shared_lock<boost::shared_mutex> lock(sessions_mtx_);
   if (sessions_.empty()) return;
 
-  Json::Value payload;
-  payload["block"] = dev::toJS(hash);
-  payload["period"] = dev::toJS(period);
+  Json::Value json;
+  json["block"] = dev::toJS(hash);
+  json["period"] = dev::toJS(period);
+  const SubscriptionPayload payload(std::move(json));
 
   for (auto const &session : sessions_) {
     if (!session->is_closed()) session->newDagBlockFinalized(payload);
@@ -325,7 +428,7 @@ void WsServer::newPbftBlockExecuted(const PbftBlock &pbft_blk,
   boost::shared_lock<boost::shared_mutex> lock(sessions_mtx_);
   if (sessions_.empty()) return;
 
-  auto payload = PbftBlock::toJson(pbft_blk, finalized_dag_blk_hashes);
+  const SubscriptionPayload payload(PbftBlock::toJson(pbft_blk, finalized_dag_blk_hashes));
 
   for (auto const &session : sessions_) {
     if (!session->is_closed()) session->newPbftBlockExecuted(payload);
@@ -335,24 +438,81 @@ void WsServer::newPendingTransaction(const trx_hash_t &trx_hash) {
   boost::shared_lock<boost::shared_mutex> lock(sessions_mtx_);
   if (sessions_.empty()) return;
 
-  auto payload = dev::toJS(trx_hash);
+  const SubscriptionPayload payload(dev::toJS(trx_hash), [&] { return dev::rlp(trx_hash); });
 
   for (auto const &session : sessions_) {
     if (!session->is_closed()) session->newPendingTransaction(payload);
   }
+  lock.unlock();
+
+  batchPendingTransaction(trx_hash);
+}
+
+void WsServer::batchPendingTransaction(const trx_hash_t &trx_hash) {
+  std::unique_lock lock(transactions_batch_mtx_);
+  transactions_batch_.push_back(trx_hash);
+  if (!kTransactionsBatchConfig.interval_ms || transactions_batch_.size() >= kTransactionsBatchConfig.max_size) {
+    auto batch = std::move(transactions_batch_);
+    transactions_batch_ = {};
+    lock.unlock();
+    return sendTransactionsBatch(batch);
+  }
+
+  if (!transactions_batch_timer_armed_) {
+    transactions_batch_timer_armed_ = true;
+    transactions_batch_timer_.expires_after(std::chrono::milliseconds(kTransactionsBatchConfig.interval_ms));
+    transactions_batch_timer_.async_wait([weak = weak_from_this()](const beast::error_code &ec) {
+      if (ec) return;
+      if (auto self = weak.lock()) self->flushTransactionsBatch();
+    });
+  }
 }
 
-void WsServer::newPillarBlockData(const pillar_chain::PillarBlockData &pillar_block_data) {
+void WsServer::flushTransactionsBatch() {
+  TransactionHashes batch;
+  {
+    std::lock_guard lock(transactions_batch_mtx_);
+    transactions_batch_timer_armed_ = false;
+    batch.swap(transactions_batch_);
+  }
+  sendTransactionsBatch(batch);
+}
+
+void WsServer::sendTransactionsBatch(const TransactionHashes &batch) {
+  if (batch.empty()) return;
+
+  boost::shared_lock<boost::shared_mutex> lock(sessions_mtx_);
+  // Single notification for the whole batch, serialized once and shared by all sessions
+  const SubscriptionPayload payload(rpc::eth::toJsonArray(batch), [&] { return dev::rlp(batch); });
+  for (auto const &session : sessions_) {
+    if (!session->is_closed()) session->newPendingTransactionsBatch(payload);
+  }
+}
+
+void WsServer::newPillarBlockData(const std::shared_ptr<const pillar_chain::SerializedPillarBlockData> &data) {
   boost::shared_lock<boost::shared_mutex> lock(sessions_mtx_);
   if (sessions_.empty()) return;
 
-  auto payload = pillar_block_data.getJson(true);
+  // Both variants were serialized when the pillar block was finalized, sessions only share them
+  auto without_signatures = std::make_shared<const SubscriptionPayload>(data->json, data->json_str, data->rlp);
+  const SubscriptionPayload payload(data->json_with_signatures, data->json_with_signatures_str,
+                                    data->rlp_with_signatures, std::move(without_signatures));
 
   for (auto const &session : sessions_) {
     if (!session->is_closed()) session->newPillarBlockData(payload);
   }
 }
 
+void WsServer::queuedMessagesChanged(int64_t diff) {
+  const auto queued = queued_messages_.fetch_add(diff) + diff;
+  if (metrics_) metrics_->setWsWriteQueueSize(queued);
+}
+
+void WsServer::messageDropped() {
+  const auto dropped = dropped_messages_.fetch_add(1) + 1;
+  if (metrics_) metrics_->setWsDroppedMessages(dropped);
+}
+
 uint32_t WsServer::numberOfSessions() {
   boost::shared_lock<boost::shared_mutex> lock(sessions_mtx_);
   return sessions_.size();
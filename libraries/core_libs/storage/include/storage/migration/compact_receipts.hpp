@@ -0,0 +1,20 @@
+#pragma once
+#include <libdevcore/Common.h>
+
+#include "storage/migration/migration_base.hpp"
+
+namespace taraxa::storage::migration {
+/**
+ * @brief Rewrites receipts of periods stored as plain rlp to the compact encoding
+ */
+class CompactReceipts : public migration::Base {
+ public:
+  CompactReceipts(std::shared_ptr<DbStorage> db);
+  std::string id() override;
+  uint32_t dbVersion() override;
+  bool isOnline() override { return true; }
+
+ protected:
+  void migrate(logger::Logger& log) override;
+};
+}  // namespace taraxa::storage::migration
@@ -1,4 +1,6 @@
 #pragma once
+#include <atomic>
+
 #include "storage/storage.hpp"
 
 namespace taraxa::storage::migration {
@@ -12,9 +14,22 @@ class Base {
 
   bool isApplied() { return db_->lookup_int<bool>(id(), DbStorage::Columns::migrations).has_value(); }
 
+  /**
+   * @brief Online migration may be applied in background while node is running. It has to commit its progress in
+   *        batches, resume from it after restart and readers have to handle both old and new layout until it is applied
+   */
+  virtual bool isOnline() { return false; }
+
+  /**
+   * @brief Asks online migration to return after the batch it is processing, it is not marked applied then
+   */
+  void requestStop() { stop_requested_ = true; }
+
   void apply(logger::Logger& log) {
     migrate(log);
-    setApplied();
+    if (!stop_requested_) {
+      setApplied();
+    }
     db_->commitWriteBatch(batch_);
   }
 
@@ -26,5 +41,6 @@ class Base {
 
   std::shared_ptr<DbStorage> db_;
   Batch batch_;
+  std::atomic<bool> stop_requested_ = false;
 };
 }  // namespace taraxa::storage::migration
\ No newline at end of file
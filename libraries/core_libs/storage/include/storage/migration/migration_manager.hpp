@@ -1,4 +1,5 @@
 #pragma once
+#include "common/thread_pool.hpp"
 #include "storage/migration/migration_base.hpp"
 
 namespace taraxa::storage::migration {
@@ -12,14 +13,32 @@ class Manager {
 
   void registerMigration(std::shared_ptr<migration::Base> migration) { migrations_.push_back(std::move(migration)); }
 
+  ~Manager();
+
   void applyAll();
 
-  void applyReceiptsByPeriod();
+  /**
+   * @param in_background online migration runs on a background thread, node stays available meanwhile
+   */
+  void applyReceiptsByPeriod(bool in_background = false);
+
+  /**
+   * @param in_background online migration runs on a background thread, node stays available meanwhile
+   */
+  void applyCompactReceipts(bool in_background = false);
+
+  /**
+   * @brief Stops background migrations after their current batch, they continue from there on next start
+   */
+  void stop();
 
  private:
   void applyMigration(std::shared_ptr<migration::Base> m);
+  void applyInBackground(std::shared_ptr<migration::Base> m);
   std::shared_ptr<DbStorage> db_;
   std::vector<std::shared_ptr<migration::Base>> migrations_;
+  std::vector<std::shared_ptr<migration::Base>> background_migrations_;
+  util::ThreadPool background_pool_{1, false};
   LOG_OBJECTS_DEFINE
 };
 }  // namespace taraxa::storage::migration
\ No newline at end of file
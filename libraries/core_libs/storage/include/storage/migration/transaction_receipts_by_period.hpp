@@ -9,6 +9,7 @@ class TransactionReceiptsByPeriod : public migration::Base {
   TransactionReceiptsByPeriod(std::shared_ptr<DbStorage> db);
   std::string id() override;
   uint32_t dbVersion() override;
+  bool isOnline() override { return true; }
 
  protected:
   void migrate(logger::Logger& log) override;
@@ -1,10 +1,16 @@
 #pragma once
 
+#include <rocksdb/cache.h>
 #include <rocksdb/db.h>
+#include <rocksdb/env.h>
 #include <rocksdb/options.h>
 #include <rocksdb/slice.h>
+#include <rocksdb/statistics.h>
 #include <rocksdb/write_batch.h>
+#include <rocksdb/write_buffer_manager.h>
 
+#include <boost/asio/thread_pool.hpp>
+#include <condition_variable>
 #include <filesystem>
 #include <functional>
 #include <regex>
@@ -50,7 +56,10 @@ enum PbftMgrStatus : uint8_t {
   NextVotedNullBlockHash,
 };
 
-enum class DBMetaKeys { LAST_NUMBER = 1 };
+// Parts of in-memory state saved on clean shutdown to speed up the next startup
+enum class StartupSnapshotKey : uint8_t { Dag = 0, Transactions };
+
+enum class DBMetaKeys { LAST_NUMBER = 1, LOGS_INDEX_FROM, PRUNED_STATE_BLOCK, PRUNED_HEADERS_FROM, GAS_PRICES_WINDOW };
 
 class DbException : public std::exception {
  public:
@@ -72,19 +81,75 @@ using Batch = rocksdb::WriteBatch;
 using Slice = rocksdb::Slice;
 using OnEntry = std::function<void(Slice const&, Slice const&)>;
 
+/**
+ * @brief Read-only view of period data as stored in db. Value stays pinned in rocksdb block cache or memtable
+ * instead of being copied and only RLP items that are accessed get decoded
+ */
+class PeriodDataView {
+ public:
+  PeriodDataView() = default;
+  explicit PeriodDataView(rocksdb::PinnableSlice&& data) : data_(std::move(data)) {}
+
+  bool empty() const { return data_.empty(); }
+  dev::bytesConstRef raw() const { return {reinterpret_cast<::byte const*>(data_.data()), data_.size()}; }
+  dev::RLP rlp() const { return dev::RLP(raw()); }
+
+  PbftBlock pbftBlock() const;
+  blk_hash_t prevBlockHash() const;
+  std::vector<std::shared_ptr<PbftVote>> certVotes() const;
+  dev::RLP dagBlocksRlp() const;
+  dev::RLP transactionsRlp() const;
+  std::vector<std::shared_ptr<PillarVote>> pillarVotes() const;
+
+  // Hashes computed directly from stored rlp items, no block or transaction is decoded and no signature recovered
+  blk_hash_t pbftBlockHash() const;
+  std::vector<blk_hash_t> dagBlocksHashes() const;
+  std::vector<trx_hash_t> transactionsHashes() const;
+
+ private:
+  rocksdb::PinnableSlice data_;
+};
+
 class DbStorage : public std::enable_shared_from_this<DbStorage> {
  public:
+  // Access pattern of the column, used to tune its rocksdb options
+  enum class ColumnProfile {
+    Default,
+    // Mostly random point lookups by hash, gets bloom filters and shared block cache
+    PointLookup,
+    // Large append only data that is rarely read, gets bigger blocks and optionally ZSTD at the bottommost level
+    Cold,
+    // Keys share fixed size prefix that is used for range scans, gets prefix extractor and prefix bloom filters
+    Prefixed,
+  };
+
   class Column {
     std::string const name_;
 
    public:
     size_t const ordinal_;
     const rocksdb::Comparator* comparator_;
-
-    Column(std::string name, size_t ordinal, const rocksdb::Comparator* comparator)
-        : name_(std::move(name)), ordinal_(ordinal), comparator_(comparator) {}
-
-    Column(std::string name, size_t ordinal) : name_(std::move(name)), ordinal_(ordinal), comparator_(nullptr) {}
+    const ColumnProfile profile_;
+    // Size of the fixed key prefix, used only for ColumnProfile::Prefixed
+    const size_t prefix_size_;
+
+    Column(std::string name, size_t ordinal, const rocksdb::Comparator* comparator,
+           ColumnProfile profile = ColumnProfile::Default)
+        : name_(std::move(name)), ordinal_(ordinal), comparator_(comparator), profile_(profile), prefix_size_(0) {}
+
+    Column(std::string name, size_t ordinal, ColumnProfile profile, size_t prefix_size = 0)
+        : name_(std::move(name)),
+          ordinal_(ordinal),
+          comparator_(nullptr),
+          profile_(profile),
+          prefix_size_(prefix_size) {}
+
+    Column(std::string name, size_t ordinal)
+        : name_(std::move(name)),
+          ordinal_(ordinal),
+          comparator_(nullptr),
+          profile_(ColumnProfile::Default),
+          prefix_size_(0) {}
 
     auto const& name() const { return ordinal_ ? name_ : rocksdb::kDefaultColumnFamilyName; }
   };
@@ -104,12 +169,12 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
     // migrations
     COLUMN(migrations);
     // Contains full data for an executed PBFT block including PBFT block, cert votes, dag blocks and transactions
-    COLUMN_W_COMP(period_data, getIntComparator<PbftPeriod>());
+    COLUMN_W_COMP(period_data, getIntComparator<PbftPeriod>(), ColumnProfile::Cold);
     COLUMN(genesis);
-    COLUMN(dag_blocks);
+    COLUMN_W_COMP(dag_blocks, ColumnProfile::PointLookup);
     COLUMN_W_COMP(dag_blocks_level, getIntComparator<uint64_t>());
-    COLUMN(transactions);
-    COLUMN(trx_period);
+    COLUMN_W_COMP(transactions, ColumnProfile::PointLookup);
+    COLUMN_W_COMP(trx_period, ColumnProfile::PointLookup);
     COLUMN(status);
     COLUMN(pbft_mgr_round_step);
     COLUMN(pbft_mgr_status);
@@ -120,14 +185,14 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
     COLUMN(latest_round_two_t_plus_one_votes);  // 2t+1 votes bundles of any type for the latest round
     COLUMN(extra_reward_votes);                 // extra reward votes on top of 2t+1 cert votes bundle from
                                                 // latest_round_two_t_plus_one_votes
-    COLUMN(pbft_block_period);
-    COLUMN(dag_block_period);
+    COLUMN_W_COMP(pbft_block_period, ColumnProfile::PointLookup);
+    COLUMN_W_COMP(dag_block_period, ColumnProfile::PointLookup);
     COLUMN_W_COMP(proposal_period_levels_map, getIntComparator<uint64_t>());
     COLUMN(final_chain_meta);
-    COLUMN(final_chain_blk_by_number);
+    COLUMN_W_COMP(final_chain_blk_by_number, ColumnProfile::Cold);
     COLUMN(final_chain_blk_hash_by_number);
-    COLUMN(final_chain_blk_number_by_hash);
-    COLUMN(final_chain_receipt_by_trx_hash);
+    COLUMN_W_COMP(final_chain_blk_number_by_hash, ColumnProfile::PointLookup);
+    COLUMN_W_COMP(final_chain_receipt_by_trx_hash, ColumnProfile::PointLookup);
     COLUMN(final_chain_log_blooms_index);
     COLUMN_W_COMP(sortition_params_change, getIntComparator<PbftPeriod>());
 
@@ -144,11 +209,20 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
     // system transactions hashes by period
     COLUMN(period_system_transactions);
     // final chain receipts by period
-    COLUMN_W_COMP(final_chain_receipt_by_period, getIntComparator<PbftPeriod>());
+    COLUMN_W_COMP(final_chain_receipt_by_period, getIntComparator<PbftPeriod>(), ColumnProfile::Cold);
     // Dynamic lambda used in specific period (only saved if it changed compared to the previous period)
     COLUMN_W_COMP(period_lambda, getIntComparator<PbftPeriod>());
     // Rounds count (per N blocks) used to determine dynamic lambda
     COLUMN(rounds_count_dynamic_lambda);
+    // Optional logs index: address [+ topic0] + block number + transaction position -> empty value
+    // Prefix is key type + address
+    COLUMN_W_COMP(final_chain_logs_index, ColumnProfile::Prefixed, 1 + addr_t::size);
+    // Low priority transactions pool transactions spilled out of memory, cleared on every start
+    COLUMN_W_COMP(pool_spilled_transactions, ColumnProfile::PointLookup);
+    // State saved on clean shutdown, consumed by the next start
+    COLUMN(startup_snapshot);
+    // Senders of period transactions recovered on finalization, concatenated addresses in period data order
+    COLUMN_W_COMP(period_trx_senders, getIntComparator<PbftPeriod>(), ColumnProfile::Cold);
 
 #undef COLUMN
 #undef COLUMN_W_COMP
@@ -156,8 +230,47 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
 
   auto handle(Column const& col) const { return handles_[col.ordinal_]; }
 
+  struct ColumnsTuning {
+    // Size of the block cache shared by point lookup columns in bytes, 0 - rocksdb default cache for every column.
+    // Ignored when memory_budget is set
+    size_t point_lookup_cache_size = 0;
+    // Bloom filter bits per key for point lookup and prefixed columns, 0 - no filters
+    uint32_t bloom_bits_per_key = 10;
+    // Compress bottommost level of cold columns with ZSTD
+    bool cold_bottommost_zstd = false;
+    // Memory budget for block cache and memtables of all columns in bytes, 0 - no limit
+    size_t memory_budget = 0;
+    // Directory on cheaper volume for older data of cold columns, empty - everything stays in db directory
+    fs::path cold_path;
+    // Bytes of every cold column kept in db directory before its older levels are placed into cold_path
+    uint64_t cold_hot_size = 0;
+    // Sync WAL after consensus state writes (own votes, pbft round state, proposed blocks), false - they are buffered
+    bool sync_consensus_writes = false;
+    // Time the first of concurrent consensus writes waits for others before their common WAL sync
+    std::chrono::microseconds consensus_group_commit_window{0};
+    // Keep main db in memory (rocksdb MemEnv) for tests and benchmarks, nothing is written to disk and snapshots are
+    // disabled. State db is not affected
+    bool in_memory = false;
+    // Open db as read only secondary instance of a primary one opened on the same path, its info log is kept here.
+    // Secondary sees writes of primary only after tryCatchUpWithPrimary
+    fs::path secondary_path;
+  };
+
   void DeleteRange(const Column& col, uint64_t begin, uint64_t end);
   void CompactRange(const Column& col, uint64_t begin, uint64_t end);
+  /**
+   * @brief Deletes [begin, end) of int keyed column with single range tombstone and compacts the range in background
+   */
+  void pruneRange(const Column& col, uint64_t begin, uint64_t end);
+  /**
+   * @brief Compacts [begin, end) of int keyed column in background, ranges requested before the previous compaction of
+   *        the column started are merged into it
+   */
+  void scheduleCompaction(const Column& col, uint64_t begin, uint64_t end);
+  /**
+   * @brief Compacts whole column in background, meant for columns pruned by point deletes
+   */
+  void scheduleCompaction(const Column& col);
   rocksdb::ReadOptions read_options_;
 
   rocksdb::WriteOptions async_write_;
@@ -169,6 +282,8 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
   fs::path state_db_path_;
   const std::string kDbDir = "db";
   const std::string kStateDbDir = "state_db";
+  // Backs db_ when in_memory is set, so it has to outlive it
+  std::unique_ptr<rocksdb::Env> mem_env_;
   std::unique_ptr<rocksdb::DB> db_;
   std::vector<rocksdb::ColumnFamilyHandle*> handles_;
   std::mutex dag_blocks_mutex_;
@@ -178,18 +293,45 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
   std::atomic<bool> snapshots_enabled_ = true;
   const uint32_t kDbSnapshotsMaxCount = 0;
   std::set<PbftPeriod> snapshots_;
+  // Guards snapshots_ accessed by finalization and by snapshot_thread_
+  std::mutex snapshots_mutex_;
+  fs::path snapshots_backup_path_;
+  // Creates checkpoints off the finalization thread, joined before db is closed
+  boost::asio::thread_pool snapshot_thread_{1};
+  // Column ordinal -> range waiting for compaction, nullopt stands for whole column
+  std::map<size_t, std::optional<std::pair<uint64_t, uint64_t>>> pending_compactions_;
+  std::mutex compactions_mutex_;
+  boost::asio::thread_pool compaction_thread_{1};
   uint64_t earliest_block_number_ = 0;
+  // Group commit of consensus writes, writes requested and covered by finished WAL sync are counted
+  std::mutex group_sync_mutex_;
+  std::condition_variable group_sync_cv_;
+  uint64_t group_sync_requested_ = 0;
+  uint64_t group_sync_done_ = 0;
+  bool group_sync_running_ = false;
+
+  const ColumnsTuning kColumnsTuning;
+  std::shared_ptr<rocksdb::Cache> point_lookup_cache_;
+  // Block cache shared by all columns, memtables are charged to it through write buffer manager
+  std::shared_ptr<rocksdb::Cache> shared_cache_;
+  std::shared_ptr<rocksdb::WriteBufferManager> write_buffer_manager_;
+  // Tickers only, histograms and timers are not collected as they are not cheap
+  std::shared_ptr<rocksdb::Statistics> statistics_;
 
   uint32_t kMajorVersion_;
   bool major_version_changed_ = false;
   bool minor_version_changed_ = false;
 
+  void createCheckpoint(PbftPeriod period);
+  void compactPending(size_t ordinal);
+  void backupSnapshot(PbftPeriod period);
+
   LOG_OBJECTS_DEFINE
 
  public:
   explicit DbStorage(fs::path const& base_path, uint32_t db_snapshot_each_n_pbft_block = 0, uint32_t max_open_files = 0,
                      uint32_t db_max_snapshots = 0, PbftPeriod db_revert_to_period = 0, addr_t node_addr = addr_t(),
-                     bool rebuild = false);
+                     bool rebuild = false, const ColumnsTuning& columns_tuning = {});
   ~DbStorage();
 
   DbStorage(const DbStorage&) = delete;
@@ -200,12 +342,79 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
   auto const& path() const { return path_; }
   auto dbStoragePath() const { return db_path_; }
   auto stateDbStoragePath() const { return state_db_path_; }
+  bool isSecondary() const { return !kColumnsTuning.secondary_path.empty(); }
+  /**
+   * @brief Applies changes written by primary since the last call, must be called only on secondary db
+   */
+  void tryCatchUpWithPrimary();
+  /**
+   * @brief Memory used by block caches in bytes
+   */
+  size_t blockCacheUsage() const;
+  /**
+   * @brief Memory used by memtables in bytes
+   */
+  size_t memTablesUsage() const;
+  /**
+   * @brief Memory used by index and filter blocks of open sst files that are not charged to block cache, in bytes
+   */
+  size_t tableReadersUsage() const;
+  size_t memoryBudget() const { return kColumnsTuning.memory_budget; }
+
+  struct ColumnProperties {
+    std::string name;
+    uint64_t estimate_num_keys = 0;
+    uint64_t mem_tables_size = 0;
+    uint64_t pending_compaction_bytes = 0;
+    uint64_t sst_files_size = 0;
+  };
+  /**
+   * @brief Reads rocksdb properties of all columns, estimate-num-keys, cur-size-all-mem-tables,
+   *        estimate-pending-compaction-bytes and total-sst-files-size
+   */
+  std::vector<ColumnProperties> columnsProperties() const;
+  /**
+   * @brief Cumulative values of rocksdb statistics tickers that indicate cache efficiency, stalls and amount of
+   *        flushed and compacted data
+   */
+  std::vector<std::pair<std::string, uint64_t>> statisticsTickers() const;
+  /**
+   * @brief Bytes written by flushes and compactions per byte written into db, 0 if nothing was written yet
+   */
+  double writeAmplification() const;
+  /**
+   * @brief Size of all files in the directory, meant for state db which is opened by taraxa-evm
+   */
+  static uint64_t directorySize(const fs::path& dir);
   static Batch createWriteBatch();
   void commitWriteBatch(Batch& write_batch, const rocksdb::WriteOptions& opts);
   void commitWriteBatch(Batch& write_batch) { commitWriteBatch(write_batch, async_write_); }
+  /**
+   * @brief Syncs WAL to the disk, after this call all previously committed async writes are durable
+   */
+  void syncWal();
+  /**
+   * @brief Commits consensus state batch with durability configured by sync_consensus_writes. Concurrent callers share
+   *        single WAL sync, the first one becomes leader and syncs for all writes committed before it started
+   */
+  void commitConsensusWriteBatch(Batch& write_batch);
 
   void rebuildColumns(const rocksdb::Options& options);
+  /**
+   * @brief Creates rocksdb options for the column based on its profile and columns tuning
+   */
+  rocksdb::ColumnFamilyOptions columnOptions(const Column& col) const;
+  fs::path coldColumnPath(const Column& col) const;
+  bool isSnapshotPeriod(PbftPeriod period);
+  /**
+   * @brief Schedules checkpoint of main db and returns immediately, state db snapshot of the period must exist already
+   * @return false if no snapshot is created on this period
+   */
   bool createSnapshot(PbftPeriod period);
+  /**
+   * @brief Copies every created snapshot under path, sst files already backed up by previous snapshots are only linked
+   */
+  void setSnapshotsBackupPath(const fs::path& path);
   void deleteSnapshot(PbftPeriod period);
   void recoverToPeriod(PbftPeriod period);
   void loadSnapshots();
@@ -234,6 +443,9 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
   // Period data
   void savePeriodData(const PeriodData& period_data, Batch& write_batch);
   dev::bytes getPeriodDataRaw(PbftPeriod period) const;
+  PeriodDataView getPeriodDataView(PbftPeriod period) const;
+  // Reads data of multiple periods with a single MultiGet call, empty views for missing periods
+  std::vector<PeriodDataView> getPeriodsDataViews(const std::vector<PbftPeriod>& periods) const;
   std::optional<PeriodData> getPeriodData(PbftPeriod period) const;
   std::optional<PbftBlock> getPbftBlock(PbftPeriod period) const;
   std::vector<std::shared_ptr<PbftVote>> getPeriodCertVotes(PbftPeriod period) const;
@@ -277,15 +489,42 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
   bool transactionFinalized(trx_hash_t const& hash);
   std::vector<bool> transactionsInDb(std::vector<trx_hash_t> const& trx_hashes);
   std::vector<bool> transactionsFinalized(std::vector<trx_hash_t> const& trx_hashes);
+  // Non-finalized transaction body is put once when its dag block is saved and removed when it is finalized into
+  // period data or dropped, it must not be added again before it is removed
   void addTransactionToBatch(Transaction const& trx, Batch& write_batch);
   void removeTransactionToBatch(trx_hash_t const& trx, Batch& write_batch);
 
+  // Transactions pool spilled transactions
+  void savePoolSpilledTransaction(const Transaction& trx);
+  std::shared_ptr<Transaction> getPoolSpilledTransaction(const trx_hash_t& hash) const;
+  void removePoolSpilledTransaction(const trx_hash_t& hash);
+
   void addTransactionLocationToBatch(Batch& write_batch, trx_hash_t const& trx, PbftPeriod period, uint32_t position,
                                      bool is_system = false);
   std::optional<TransactionLocation> getTransactionLocation(trx_hash_t const& hash) const;
   std::unordered_map<trx_hash_t, PbftPeriod> getAllTransactionPeriod();
   uint64_t getTransactionCount(PbftPeriod period) const;
   SharedTransactionReceipts getBlockReceipts(PbftPeriod period) const;
+  /**
+   * @brief Gets receipts of multiple blocks with a single MultiGet call
+   * @param periods periods to get receipts for
+   * @return receipts in the same order as periods, nullptr for periods without receipts
+   */
+  std::vector<SharedTransactionReceipts> getBlocksReceipts(const std::vector<PbftPeriod>& periods) const;
+
+  /**
+   * @brief Called for each finalized period with raw final chain header, period data and receipts, empty slices are
+   *        passed for missing data. Returning false stops the iteration
+   */
+  using FinalizedPeriodCallback = std::function<bool(PbftPeriod period, const Slice& header,
+                                                     const PeriodDataView& period_data, const Slice& receipts)>;
+
+  /**
+   * @brief Iterates finalized periods in range in order. Period data and receipts are read with sequential iterators
+   *        and headers with batched lookups, so long ranges are read close to disk speed. Iteration stops at the first
+   *        period without final chain header
+   */
+  void forEachFinalizedPeriod(PbftPeriod from, PbftPeriod to, const FinalizedPeriodCallback& callback) const;
   std::optional<TransactionReceipt> getTransactionReceipt(EthBlockNumber blk_n, uint64_t position) const;
 
   /**
@@ -327,9 +566,9 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
   std::vector<std::shared_ptr<PbftBlock>> getProposedPbftBlocks();
 
   // pbft_blocks (head)
-  std::string getPbftHead(blk_hash_t const& hash);
-  void savePbftHead(blk_hash_t const& hash, std::string const& pbft_chain_head_str);
-  void addPbftHeadToBatch(taraxa::blk_hash_t const& head_hash, std::string const& head_str, Batch& write_batch);
+  bytes getPbftHead(blk_hash_t const& hash);
+  void savePbftHead(blk_hash_t const& hash, bytes const& pbft_chain_head);
+  void addPbftHeadToBatch(taraxa::blk_hash_t const& head_hash, bytes const& head, Batch& write_batch);
 
   // status
   uint64_t getStatusField(StatusDbField const& field);
@@ -394,6 +633,14 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
   void saveRoundsCountDynamicLambda(uint32_t rounds_count, Batch& write_batch);
   uint32_t getRoundsCountDynamicLambda();
 
+  // Startup snapshot
+  void saveStartupSnapshot(StartupSnapshotKey key, const bytes& data);
+  /**
+   * @brief Reads snapshot and removes it from db, so that it is never used after a crash that followed the restart
+   * @return snapshot data, empty if there is none
+   */
+  bytes takeStartupSnapshot(StartupSnapshotKey key);
+
   // Blocks rewards stats
   std::unordered_map<PbftPeriod, rewards::BlockStats> getBlocksRewardsStats() const;
   void saveBlockRewardsStats(uint64_t period, const rewards::BlockStats& stats, Batch& write_batch);
@@ -464,6 +711,42 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
     return value;
   }
 
+  /**
+   * @brief Looks up multiple keys of a single column with one batched MultiGet call. Values are pinned in the block
+   * cache or memtable instead of being copied, rocksdb sorts the keys with the column comparator before reading
+   * @return values in the order of keys, empty slice for missing keys
+   */
+  template <typename K>
+  std::vector<rocksdb::PinnableSlice> multiGet(Column const& column, std::vector<K> const& keys) const {
+    std::vector<rocksdb::PinnableSlice> values(keys.size());
+    if (keys.empty()) {
+      return values;
+    }
+    const auto& slices = toSlices(keys);
+    std::vector<rocksdb::Status> statuses(keys.size());
+    db_->MultiGet(read_options_, handle(column), keys.size(), slices.data(), values.data(), statuses.data(),
+                  /*sorted_input=*/false);
+    for (size_t i = 0; i < statuses.size(); ++i) {
+      if (statuses[i].IsNotFound()) {
+        values[i].Reset();
+        continue;
+      }
+      checkStatus(statuses[i]);
+    }
+    return values;
+  }
+
+  template <typename K>
+  std::vector<std::string> multiLookup(std::vector<K> const& keys, Column const& column) const {
+    const auto slices = multiGet(column, keys);
+    std::vector<std::string> values;
+    values.reserve(slices.size());
+    for (const auto& slice : slices) {
+      values.emplace_back(slice.ToString());
+    }
+    return values;
+  }
+
   template <typename Int, typename K>
   auto lookup_int(K const& key, Column const& column) -> std::enable_if_t<std::is_integral_v<Int>, std::optional<Int>> {
     auto str = lookup(key, column);
@@ -520,6 +803,15 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
     checkStatus(batch.Delete(handle(col), toSlice(k)));
   }
 
+  /**
+   * @brief Removes key that was put at most once since it was last removed. Unlike a tombstone the single delete is
+   * dropped together with the put when they meet in flush or compaction, so short lived keys cost no extra writes
+   */
+  template <typename K>
+  void singleRemove(Batch& batch, Column const& col, K const& k) {
+    checkStatus(batch.SingleDelete(handle(col), toSlice(k)));
+  }
+
   template <typename K>
   void remove(Batch& batch, Column const& col, std::unordered_set<K> const& keys) {
     for (auto const& k : keys) {
@@ -0,0 +1,57 @@
+#include "storage/migration/compact_receipts.hpp"
+
+#include <rocksdb/db.h>
+
+#include "storage/storage.hpp"
+#include "transaction/receipt.hpp"
+
+namespace taraxa::storage::migration {
+
+CompactReceipts::CompactReceipts(std::shared_ptr<DbStorage> db) : migration::Base(db) {}
+
+std::string CompactReceipts::id() { return "CompactReceipts"; }
+
+uint32_t CompactReceipts::dbVersion() { return 1; }
+
+void CompactReceipts::migrate(logger::Logger& log) {
+  const auto col = DbStorage::Columns::final_chain_receipt_by_period;
+  // Last rewritten period is committed together with each batch, next start continues after it
+  constexpr size_t kPeriodsPerBatch = 1000;
+  const auto progress_key = id() + "_progress";
+
+  auto it = db_->getColumnIterator(col);
+  if (const auto progress = db_->lookup_int<PbftPeriod>(progress_key, DbStorage::Columns::migrations)) {
+    LOG(log) << "Continuing from period " << *progress;
+    it->Seek(DbStorage::toSlice(*progress));
+  } else {
+    it->SeekToFirst();
+  }
+
+  size_t batch_periods = 0;
+  for (; it->Valid() && !stop_requested_; it->Next()) {
+    PbftPeriod period;
+    memcpy(&period, it->key().data(), sizeof(PbftPeriod));
+    const dev::bytesConstRef raw(reinterpret_cast<const ::byte*>(it->value().data()), it->value().size());
+    // Periods finalized after the node was updated are compact already
+    if (raw.empty() || ReceiptsView::isCompact(raw)) {
+      continue;
+    }
+    if (period % 10000 == 0) {
+      LOG(log) << "Migrating period " << period;
+    }
+    db_->insert(batch_, col, period, encodeCompactReceipts(ReceiptsView(raw).decodeAll()));
+    if (++batch_periods == kPeriodsPerBatch) {
+      db_->insert(batch_, DbStorage::Columns::migrations, progress_key, period);
+      db_->commitWriteBatch(batch_);
+      batch_periods = 0;
+    }
+  }
+  db_->commitWriteBatch(batch_);
+  if (stop_requested_) {
+    return;
+  }
+  db_->remove(DbStorage::Columns::migrations, progress_key);
+  db_->compactColumn(col);
+}
+
+}  // namespace taraxa::storage::migration
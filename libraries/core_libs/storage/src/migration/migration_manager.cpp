@@ -1,5 +1,6 @@
 #include "storage/migration/migration_manager.hpp"
 
+#include "storage/migration/compact_receipts.hpp"
 #include "storage/migration/transaction_receipts_by_period.hpp"
 
 namespace taraxa::storage::migration {
@@ -21,15 +22,63 @@ void Manager::applyMigration(std::shared_ptr<migration::Base> m) {
 
   LOG(log_si_) << "Applying migration " << m->id();
   m->apply(log_si_);
-  LOG(log_si_) << "Migration applied " << m->id();
+  if (m->isApplied()) {
+    LOG(log_si_) << "Migration applied " << m->id();
+  } else {
+    LOG(log_si_) << "Migration " << m->id() << " stopped, it continues from its last batch on next start";
+  }
 }
 
+Manager::~Manager() { stop(); }
+
 void Manager::applyAll() {
   for (const auto& m : migrations_) {
     applyMigration(m);
   }
 }
 
-void Manager::applyReceiptsByPeriod() { applyMigration(std::make_shared<TransactionReceiptsByPeriod>(db_)); }
+void Manager::applyReceiptsByPeriod(bool in_background) {
+  auto migration = std::make_shared<TransactionReceiptsByPeriod>(db_);
+  if (in_background) {
+    applyInBackground(std::move(migration));
+  } else {
+    applyMigration(std::move(migration));
+  }
+}
+
+void Manager::applyCompactReceipts(bool in_background) {
+  auto migration = std::make_shared<CompactReceipts>(db_);
+  if (in_background) {
+    applyInBackground(std::move(migration));
+  } else {
+    applyMigration(std::move(migration));
+  }
+}
+
+void Manager::applyInBackground(std::shared_ptr<migration::Base> m) {
+  if (!m->isOnline()) {
+    applyMigration(std::move(m));
+    return;
+  }
+
+  background_migrations_.push_back(m);
+  background_pool_.start();
+  background_pool_.post([this, m = std::move(m)]() {
+    try {
+      applyMigration(m);
+    } catch (const std::exception& e) {
+      LOG(log_er_) << "Background migration " << m->id() << " failed: " << e.what();
+    }
+  });
+}
+
+void Manager::stop() {
+  for (const auto& m : background_migrations_) {
+    m->requestStop();
+  }
+  // Waits for the batches in progress
+  background_pool_.stop();
+  background_migrations_.clear();
+}
 
 }  // namespace taraxa::storage::migration
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <rocksdb/options.h>
 #include <rocksdb/utilities/write_batch_with_index.h>
 
+#include <algorithm>
 #include <chrono>
 
 #include "common/thread_pool.hpp"
@@ -21,8 +22,8 @@ uint32_t TransactionReceiptsByPeriod::dbVersion() { return 1; }
 void TransactionReceiptsByPeriod::migrate(logger::Logger& log) {
   auto orig_col = DbStorage::Columns::final_chain_receipt_by_trx_hash;
   auto target_col = DbStorage::Columns::final_chain_receipt_by_period;
-  db_->read_options_.async_io = true;
-  db_->read_options_.verify_checksums = false;
+  // Committed batches are the progress, next start continues below the smallest migrated period
+  constexpr size_t kPeriodsPerBatch = 1000;
   auto it = db_->getColumnIterator(DbStorage::Columns::period_data);
   {
     auto target_it = db_->getColumnIterator(target_col);
@@ -45,10 +46,10 @@ void TransactionReceiptsByPeriod::migrate(logger::Logger& log) {
       it->Prev();
     }
   }
-  // const size_t batch_size = 50 * 1024 * 1024;  // 50MB
-  // Get and save data in new format for all blocks
-  util::ThreadPool pool(std::thread::hardware_concurrency());
-  for (; it->Valid(); it->Prev()) {
+  // Get and save data in new format for all blocks, half of the cores are left to the node running meanwhile
+  util::ThreadPool pool(std::max(1u, std::thread::hardware_concurrency() / 2));
+  size_t batch_periods = 0;
+  for (; it->Valid() && !stop_requested_; it->Prev()) {
     uint64_t period;
     memcpy(&period, it->key().data(), sizeof(uint64_t));
     if (period % 10000 == 0) {
@@ -88,8 +89,15 @@ void TransactionReceiptsByPeriod::migrate(logger::Logger& log) {
     }
 
     db_->insert(batch_, target_col, period, receipts_rlp.invalidate());
+    if (++batch_periods == kPeriodsPerBatch) {
+      db_->commitWriteBatch(batch_);
+      batch_periods = 0;
+    }
   }
   db_->commitWriteBatch(batch_);
+  if (stop_requested_) {
+    return;
+  }
   db_->compactColumn(target_col);
 }
 
@@ -6,16 +6,23 @@
 #include <boost/algorithm/string/split.hpp>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <regex>
+#include <thread>
 
 #include "common/thread_pool.hpp"
+#include "common/tracing.hpp"
 #include "config/version.hpp"
 #include "dag/dag_block_bundle_rlp.hpp"
 #include "dag/sortition_params_manager.hpp"
 #include "final_chain/data.hpp"
 #include "pillar_chain/pillar_block.hpp"
+#include "rocksdb/filter_policy.h"
+#include "rocksdb/slice_transform.h"
+#include "rocksdb/table.h"
 #include "rocksdb/utilities/checkpoint.h"
+#include "rocksdb/utilities/table_properties_collectors.h"
 #include "transaction/system_transaction.hpp"
 #include "vote/pbft_vote.hpp"
 #include "vote/votes_bundle_rlp.hpp"
@@ -30,12 +37,22 @@ static constexpr uint16_t TRANSACTIONS_POS_IN_PERIOD_DATA = 3;
 static constexpr uint16_t PILLAR_VOTES_POS_IN_PERIOD_DATA = 4;
 static constexpr uint16_t PREV_BLOCK_HASH_POS_IN_PBFT_BLOCK = 0;
 
+// Senders saved in period_trx_senders are trusted, periods finalized before the column existed fall back to recovery
+static void restoreTransactionSender(const Transaction& trx, std::string_view senders, uint32_t position) {
+  if (senders.size() >= (position + 1) * addr_t::size) {
+    trx.restoreSender(addr_t(reinterpret_cast<const ::byte*>(senders.data()) + position * addr_t::size,
+                             addr_t::ConstructFromPointer));
+  }
+}
+
 DbStorage::DbStorage(const fs::path& path, uint32_t db_snapshot_each_n_pbft_block, uint32_t max_open_files,
-                     uint32_t db_max_snapshots, PbftPeriod db_revert_to_period, addr_t node_addr, bool rebuild)
+                     uint32_t db_max_snapshots, PbftPeriod db_revert_to_period, addr_t node_addr, bool rebuild,
+                     const ColumnsTuning& columns_tuning)
     : path_(path),
       handles_(Columns::all.size()),
       kDbSnapshotsEachNblock(db_snapshot_each_n_pbft_block),
-      kDbSnapshotsMaxCount(db_max_snapshots) {
+      kDbSnapshotsMaxCount(db_max_snapshots),
+      kColumnsTuning(columns_tuning) {
   db_path_ = (path / kDbDir);
   state_db_path_ = (path / kStateDbDir);
   async_write_.sync = false;
@@ -50,15 +67,60 @@ DbStorage::DbStorage(const fs::path& path, uint32_t db_snapshot_each_n_pbft_bloc
     backup_state_db_path += (backup_label + timestamp);
     fs::rename(db_path_, backup_db_path);
     fs::rename(state_db_path_, backup_state_db_path);
+    if (!kColumnsTuning.cold_path.empty() && fs::exists(kColumnsTuning.cold_path / kDbDir)) {
+      fs::rename(kColumnsTuning.cold_path / kDbDir, kColumnsTuning.cold_path / backup_db_path.filename());
+    }
     db_path_ = backup_db_path;
     state_db_path_ = backup_state_db_path;
   }
   LOG_OBJECTS_CREATE("DBS");
 
-  fs::create_directories(db_path_);
-  removeTempFiles();
+  if (kColumnsTuning.memory_budget) {
+    shared_cache_ = rocksdb::NewLRUCache(kColumnsTuning.memory_budget);
+    // Memtables may take up to a quarter of the budget, their memory is reserved in the shared cache
+    write_buffer_manager_ = std::make_shared<rocksdb::WriteBufferManager>(kColumnsTuning.memory_budget / 4,
+                                                                          shared_cache_, /*allow_stall=*/true);
+    // Every column has to be charged to the budget, so point lookup columns use the shared cache as well
+    if (kColumnsTuning.point_lookup_cache_size) {
+      LOG(log_wr_) << "db_point_lookup_cache_size is ignored, point lookup columns use db_memory_budget cache";
+    }
+  } else if (kColumnsTuning.point_lookup_cache_size) {
+    point_lookup_cache_ = rocksdb::NewLRUCache(kColumnsTuning.point_lookup_cache_size);
+  }
+
+  if (kColumnsTuning.in_memory) {
+    mem_env_.reset(rocksdb::NewMemEnv(rocksdb::Env::Default()));
+    if (kDbSnapshotsEachNblock) {
+      LOG(log_wr_) << "DB snapshots are disabled, they are not supported with in memory db";
+      snapshots_enabled_ = false;
+    }
+  } else if (isSecondary()) {
+    // Secondary must not touch files of its primary
+    fs::create_directories(kColumnsTuning.secondary_path / kDbDir);
+    snapshots_enabled_ = false;
+  } else {
+    fs::create_directories(db_path_);
+    removeTempFiles();
+  }
+  if (!kColumnsTuning.cold_path.empty() && !mem_env_ && !isSecondary()) {
+    for (const auto& col : Columns::all) {
+      if (col.profile_ == ColumnProfile::Cold) {
+        fs::create_directories(coldColumnPath(col));
+      }
+    }
+    if (kDbSnapshotsEachNblock) {
+      // Checkpoint holds files of both paths in one directory, but its MANIFEST still places older files in cold path
+      LOG(log_wr_) << "DB snapshots are disabled, they are not supported with cold path";
+      snapshots_enabled_ = false;
+    }
+  }
+
+  statistics_ = rocksdb::CreateDBStatistics();
+  statistics_->set_stats_level(rocksdb::StatsLevel::kExceptHistogramOrTimers);
 
   rocksdb::Options options;
+  options.env = mem_env_ ? mem_env_.get() : rocksdb::Env::Default();
+  options.statistics = statistics_;
   options.create_missing_column_families = true;
   options.create_if_missing = true;
   options.compression = rocksdb::CompressionType::kLZ4Compression;
@@ -71,29 +133,42 @@ DbStorage::DbStorage(const fs::path& path, uint32_t db_snapshot_each_n_pbft_bloc
   // aleth default 256 (state_db is using another 128)
   options.max_open_files = (max_open_files) ? max_open_files : 256;
   options.max_total_wal_size = 1024 * 1024 * 1024;
+  if (write_buffer_manager_) {
+    // Replaces db_write_buffer_size limit
+    options.write_buffer_manager = write_buffer_manager_;
+  }
 
   std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
   descriptors.reserve(Columns::all.size());
-  std::transform(Columns::all.begin(), Columns::all.end(), std::back_inserter(descriptors), [](const Column& col) {
-    auto options = rocksdb::ColumnFamilyOptions();
-    if (col.comparator_) options.comparator = col.comparator_;
-    return rocksdb::ColumnFamilyDescriptor(col.name(), options);
-  });
+  std::transform(Columns::all.begin(), Columns::all.end(), std::back_inserter(descriptors),
+                 [this](const Column& col) { return rocksdb::ColumnFamilyDescriptor(col.name(), columnOptions(col)); });
 
-  rebuildColumns(options);
+  rocksdb::DB* db = nullptr;
+  if (isSecondary()) {
+    // Primary may delete files at any time, secondary keeps all of them open so it can still read them
+    options.max_open_files = -1;
+    checkStatus(rocksdb::DB::OpenAsSecondary(options, db_path_.string(),
+                                             (kColumnsTuning.secondary_path / kDbDir).string(), descriptors,
+                                             &handles_, &db));
+  } else {
+    rebuildColumns(options);
 
-  // Iterate over the db folders and populate snapshot set
-  loadSnapshots();
+    // Iterate over the db folders and populate snapshot set
+    if (!mem_env_) {
+      loadSnapshots();
+    }
 
-  // Revert to period if needed
-  if (db_revert_to_period) {
-    recoverToPeriod(db_revert_to_period);
+    // Revert to period if needed
+    if (db_revert_to_period) {
+      recoverToPeriod(db_revert_to_period);
+    }
+    checkStatus(rocksdb::DB::Open(options, db_path_.string(), descriptors, &handles_, &db));
   }
-  rocksdb::DB* db = nullptr;
-  checkStatus(rocksdb::DB::Open(options, db_path_.string(), descriptors, &handles_, &db));
   assert(db);
   db_.reset(db);
-  db_->EnableFileDeletions();
+  if (!isSecondary()) {
+    db_->EnableFileDeletions();
+  }
   dag_blocks_count_.store(getStatusField(StatusDbField::DagBlkCount));
   dag_edge_count_.store(getStatusField(StatusDbField::DagEdgeCount));
 
@@ -106,6 +181,160 @@ DbStorage::DbStorage(const fs::path& path, uint32_t db_snapshot_each_n_pbft_bloc
   }
 }
 
+fs::path DbStorage::coldColumnPath(const Column& col) const {
+  // Named after db directory, so that db renamed for rebuild keeps its cold files
+  return kColumnsTuning.cold_path / db_path_.filename() / col.name();
+}
+
+// A quarter of consecutive entries being deletions marks sst file for compaction
+constexpr size_t kDeletionsWindow = 10000;
+constexpr size_t kDeletionsTrigger = 2500;
+
+rocksdb::ColumnFamilyOptions DbStorage::columnOptions(const Column& col) const {
+  rocksdb::ColumnFamilyOptions options;
+  if (col.comparator_) {
+    options.comparator = col.comparator_;
+  }
+  if (col.profile_ == ColumnProfile::Default && !shared_cache_) {
+    return options;
+  }
+
+  rocksdb::BlockBasedTableOptions table_options;
+  if (shared_cache_) {
+    table_options.block_cache = shared_cache_;
+    // Keep index and filter blocks inside of the budget as well
+    table_options.cache_index_and_filter_blocks = true;
+    table_options.pin_l0_filter_and_index_blocks_in_cache = true;
+  }
+  switch (col.profile_) {
+    case ColumnProfile::PointLookup:
+      if (kColumnsTuning.bloom_bits_per_key) {
+        table_options.filter_policy.reset(rocksdb::NewBloomFilterPolicy(kColumnsTuning.bloom_bits_per_key));
+      }
+      if (point_lookup_cache_) {
+        table_options.block_cache = point_lookup_cache_;
+      }
+      // Keys are hashes, so there is nothing to gain from scanning neighbouring keys
+      options.optimize_filters_for_hits = true;
+      // Hash keyed columns are pruned by point deletes, files dense with their tombstones are compacted right away
+      options.table_properties_collector_factories.emplace_back(
+          rocksdb::NewCompactOnDeletionCollectorFactory(kDeletionsWindow, kDeletionsTrigger));
+      break;
+    case ColumnProfile::Cold:
+      // Bigger blocks mean smaller index and better compression ratio, reads are rare anyway
+      table_options.block_size = 64 * 1024;
+      if (kColumnsTuning.cold_bottommost_zstd) {
+        options.bottommost_compression = rocksdb::CompressionType::kZSTD;
+      }
+      if (!kColumnsTuning.cold_path.empty() && !mem_env_) {
+        // Rocksdb keeps newer levels in the first path until its target size is reached, older levels that hold old
+        // periods go to the cold path. Reads are routed by rocksdb itself
+        options.cf_paths = {{db_path_.string(), kColumnsTuning.cold_hot_size},
+                            {coldColumnPath(col).string(), std::numeric_limits<uint64_t>::max()}};
+      }
+      break;
+    case ColumnProfile::Prefixed:
+      assert(col.prefix_size_);
+      options.prefix_extractor.reset(rocksdb::NewFixedPrefixTransform(col.prefix_size_));
+      options.memtable_prefix_bloom_size_ratio = 0.1;
+      if (kColumnsTuning.bloom_bits_per_key) {
+        table_options.filter_policy.reset(rocksdb::NewBloomFilterPolicy(kColumnsTuning.bloom_bits_per_key));
+        table_options.whole_key_filtering = false;
+      }
+      break;
+    case ColumnProfile::Default:
+      break;
+  }
+  options.table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_options));
+  return options;
+}
+
+size_t DbStorage::blockCacheUsage() const {
+  size_t usage = 0;
+  if (shared_cache_) {
+    usage += shared_cache_->GetUsage();
+  }
+  if (point_lookup_cache_) {
+    usage += point_lookup_cache_->GetUsage();
+  }
+  if (!shared_cache_ && !point_lookup_cache_) {
+    uint64_t value = 0;
+    db_->GetAggregatedIntProperty(rocksdb::DB::Properties::kBlockCacheUsage, &value);
+    usage = value;
+  }
+  return usage;
+}
+
+size_t DbStorage::memTablesUsage() const {
+  if (write_buffer_manager_) {
+    return write_buffer_manager_->memory_usage();
+  }
+  uint64_t value = 0;
+  db_->GetAggregatedIntProperty(rocksdb::DB::Properties::kCurSizeAllMemTables, &value);
+  return value;
+}
+
+size_t DbStorage::tableReadersUsage() const {
+  uint64_t value = 0;
+  db_->GetAggregatedIntProperty(rocksdb::DB::Properties::kEstimateTableReadersMem, &value);
+  return value;
+}
+
+std::vector<DbStorage::ColumnProperties> DbStorage::columnsProperties() const {
+  std::vector<ColumnProperties> res;
+  res.reserve(handles_.size());
+  for (auto* handle : handles_) {
+    ColumnProperties props{handle->GetName()};
+    db_->GetIntProperty(handle, rocksdb::DB::Properties::kEstimateNumKeys, &props.estimate_num_keys);
+    db_->GetIntProperty(handle, rocksdb::DB::Properties::kCurSizeAllMemTables, &props.mem_tables_size);
+    db_->GetIntProperty(handle, rocksdb::DB::Properties::kEstimatePendingCompactionBytes,
+                        &props.pending_compaction_bytes);
+    db_->GetIntProperty(handle, rocksdb::DB::Properties::kTotalSstFilesSize, &props.sst_files_size);
+    res.push_back(std::move(props));
+  }
+  return res;
+}
+
+std::vector<std::pair<std::string, uint64_t>> DbStorage::statisticsTickers() const {
+  static const std::vector<rocksdb::Tickers> kTickers = {
+      rocksdb::BLOCK_CACHE_HIT,    rocksdb::BLOCK_CACHE_MISS,   rocksdb::BLOOM_FILTER_USEFUL,
+      rocksdb::MEMTABLE_HIT,       rocksdb::MEMTABLE_MISS,      rocksdb::STALL_MICROS,
+      rocksdb::BYTES_WRITTEN,      rocksdb::BYTES_READ,         rocksdb::WAL_FILE_BYTES,
+      rocksdb::FLUSH_WRITE_BYTES,  rocksdb::COMPACT_READ_BYTES, rocksdb::COMPACT_WRITE_BYTES,
+      rocksdb::NUMBER_KEYS_WRITTEN, rocksdb::NO_FILE_OPENS,
+  };
+  static const std::map<rocksdb::Tickers, std::string> kNames(rocksdb::TickersNameMap.begin(),
+                                                              rocksdb::TickersNameMap.end());
+
+  std::vector<std::pair<std::string, uint64_t>> res;
+  res.reserve(kTickers.size());
+  for (auto ticker : kTickers) {
+    res.emplace_back(kNames.at(ticker), statistics_->getTickerCount(ticker));
+  }
+  return res;
+}
+
+double DbStorage::writeAmplification() const {
+  const auto written = statistics_->getTickerCount(rocksdb::BYTES_WRITTEN);
+  if (!written) {
+    return 0;
+  }
+  const auto flushed_and_compacted = statistics_->getTickerCount(rocksdb::FLUSH_WRITE_BYTES) +
+                                     statistics_->getTickerCount(rocksdb::COMPACT_WRITE_BYTES);
+  return static_cast<double>(flushed_and_compacted) / static_cast<double>(written);
+}
+
+uint64_t DbStorage::directorySize(const fs::path& dir) {
+  uint64_t size = 0;
+  std::error_code ec;
+  for (fs::recursive_directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+    if (it->is_regular_file(ec)) {
+      size += it->file_size(ec);
+    }
+  }
+  return size;
+}
+
 void DbStorage::removeTempFiles() const {
   const std::regex filePattern("LOG\\.old\\.\\d+");
   removeFilesWithPattern(db_path_, filePattern);
@@ -219,11 +448,7 @@ void DbStorage::deleteColumnData(const Column& c) {
   checkStatus(db_->DropColumnFamily(handle(c)));
   db_->DestroyColumnFamilyHandle(handle(c));
 
-  auto options = rocksdb::ColumnFamilyOptions();
-  if (c.comparator_) {
-    options.comparator = c.comparator_;
-  }
-  checkStatus(db_->CreateColumnFamily(options, c.name(), &handles_[c.ordinal_]));
+  checkStatus(db_->CreateColumnFamily(columnOptions(c), c.name(), &handles_[c.ordinal_]));
 }
 
 void DbStorage::rebuildColumns(const rocksdb::Options& options) {
@@ -239,15 +464,17 @@ void DbStorage::rebuildColumns(const rocksdb::Options& options) {
   descriptors.reserve(column_families.size());
   std::vector<rocksdb::ColumnFamilyHandle*> handles;
   handles.reserve(column_families.size());
-  std::transform(column_families.begin(), column_families.end(), std::back_inserter(descriptors), [](const auto& name) {
-    const auto it = std::find_if(Columns::all.begin(), Columns::all.end(), [&name](const Column& col) {
-      // "-copy" is there, so we will removed unsuccessful migrations
-      return col.name() == name || col.name() + "-copy" == name;
-    });
-    auto options = rocksdb::ColumnFamilyOptions();
-    if (it != Columns::all.end() && it->comparator_) options.comparator = it->comparator_;
-    return rocksdb::ColumnFamilyDescriptor(name, options);
-  });
+  std::transform(column_families.begin(), column_families.end(), std::back_inserter(descriptors),
+                 [this](const auto& name) {
+                   const auto it = std::find_if(Columns::all.begin(), Columns::all.end(), [&name](const Column& col) {
+                     // "-copy" is there, so we will removed unsuccessful migrations
+                     return col.name() == name || col.name() + "-copy" == name;
+                   });
+                   if (it != Columns::all.end()) {
+                     return rocksdb::ColumnFamilyDescriptor(name, columnOptions(*it));
+                   }
+                   return rocksdb::ColumnFamilyDescriptor(name, rocksdb::ColumnFamilyOptions());
+                 });
   rocksdb::DB* db_ptr = nullptr;
   checkStatus(rocksdb::DB::Open(options, db_path_.string(), descriptors, &handles, &db_ptr));
   assert(db_ptr);
@@ -309,29 +536,57 @@ void DbStorage::loadSnapshots() {
   }
 }
 
-bool DbStorage::createSnapshot(PbftPeriod period) {
+bool DbStorage::isSnapshotPeriod(PbftPeriod period) {
   // Only creates snapshot each kDbSnapshotsEachNblock periods
-  if (!snapshots_enabled_ || kDbSnapshotsEachNblock <= 0 || period % kDbSnapshotsEachNblock != 0 ||
-      snapshots_.find(period) != snapshots_.end()) {
+  if (!snapshots_enabled_ || kDbSnapshotsEachNblock <= 0 || period % kDbSnapshotsEachNblock != 0) {
     return false;
   }
+  std::scoped_lock lock(snapshots_mutex_);
+  return snapshots_.find(period) == snapshots_.end();
+}
 
-  LOG(log_nf_) << "Creating DB snapshot on period: " << period;
-
-  // Create rocksdb checkpoint/snapshot
-  rocksdb::Checkpoint* checkpoint;
-  auto status = rocksdb::Checkpoint::Create(db_.get(), &checkpoint);
-  // Scope is to delete checkpoint object as soon as we don't need it anymore
+bool DbStorage::createSnapshot(PbftPeriod period) {
+  if (!isSnapshotPeriod(period)) {
+    return false;
+  }
   {
-    checkStatus(status);
+    std::scoped_lock lock(snapshots_mutex_);
+    snapshots_.insert(period);
+  }
+
+  LOG(log_nf_) << "Scheduling DB snapshot on period: " << period;
+  // Checkpoint may already contain some of the following periods. That is fine as FinalChain reverts main db to the
+  // block of state db when it is opened, only the state db must never be ahead of it
+  boost::asio::post(snapshot_thread_, [this, period] { createCheckpoint(period); });
+  return true;
+}
+
+void DbStorage::setSnapshotsBackupPath(const fs::path& path) {
+  fs::create_directories(path);
+  snapshots_backup_path_ = path;
+}
+
+void DbStorage::createCheckpoint(PbftPeriod period) {
+  try {
+    rocksdb::Checkpoint* checkpoint;
+    checkStatus(rocksdb::Checkpoint::Create(db_.get(), &checkpoint));
+    const std::unique_ptr<rocksdb::Checkpoint> checkpoint_owner(checkpoint);
     auto snapshot_path = db_path_;
     snapshot_path += std::to_string(period);
-    status = checkpoint->CreateCheckpoint(snapshot_path.string());
+    // Sst files are hard linked, only memtables are flushed and small metadata files are copied
+    uint64_t sequence_number = 0;
+    checkStatus(checkpoint->CreateCheckpoint(snapshot_path.string(), 0, &sequence_number));
+    LOG(log_nf_) << "Created DB snapshot on period " << period << " at sequence number " << sequence_number;
+
+    if (!snapshots_backup_path_.empty()) {
+      backupSnapshot(period);
+    }
+  } catch (const std::exception& e) {
+    LOG(log_er_) << "Creating DB snapshot on period " << period << " failed: " << e.what();
   }
-  checkStatus(status);
-  snapshots_.insert(period);
 
   // Delete any snapshot over kDbSnapshotsMaxCount
+  std::scoped_lock lock(snapshots_mutex_);
   if (kDbSnapshotsMaxCount && snapshots_.size() > kDbSnapshotsMaxCount) {
     while (snapshots_.size() > kDbSnapshotsMaxCount) {
       auto snapshot = snapshots_.begin();
@@ -339,7 +594,63 @@ bool DbStorage::createSnapshot(PbftPeriod period) {
       snapshots_.erase(snapshot);
     }
   }
-  return true;
+}
+
+void DbStorage::backupSnapshot(PbftPeriod period) {
+  for (const auto& dir : {kDbDir, kStateDbDir}) {
+    const auto name = dir + std::to_string(period);
+    const auto src = path_ / name;
+    if (!fs::exists(src)) {
+      continue;
+    }
+    // Sst files never change, so a file backed up for a previous snapshot is shared by linking it from the pool.
+    // Its size is part of the pooled name to tell apart files of a recreated db that reuse the same number
+    const auto pool = snapshots_backup_path_ / (dir + "_sst");
+    const auto dst = snapshots_backup_path_ / name;
+    auto tmp = dst;
+    tmp += ".tmp";
+    fs::remove_all(tmp);
+    fs::create_directories(tmp);
+    fs::create_directories(pool);
+
+    uint64_t copied_bytes = 0, linked_bytes = 0;
+    for (const auto& entry : fs::recursive_directory_iterator(src)) {
+      const auto relative = entry.path().lexically_relative(src);
+      if (entry.is_directory()) {
+        fs::create_directories(tmp / relative);
+        continue;
+      }
+      if (entry.path().extension() != ".sst") {
+        fs::copy_file(entry.path(), tmp / relative);
+        continue;
+      }
+      auto pooled_name = relative.string();
+      std::replace(pooled_name.begin(), pooled_name.end(), '/', '_');
+      const auto size = entry.file_size();
+      const auto pooled = pool / (std::to_string(size) + "_" + pooled_name);
+      if (fs::exists(pooled)) {
+        linked_bytes += size;
+      } else {
+        auto pooled_tmp = pooled;
+        pooled_tmp += ".tmp";
+        fs::copy_file(entry.path(), pooled_tmp, fs::copy_options::overwrite_existing);
+        fs::rename(pooled_tmp, pooled);
+        copied_bytes += size;
+      }
+      fs::create_hard_link(pooled, tmp / relative);
+    }
+    fs::remove_all(dst);
+    fs::rename(tmp, dst);
+    LOG(log_nf_) << "Backed up " << name << " to " << dst << ", copied " << copied_bytes << " bytes, reused "
+                 << linked_bytes << " bytes";
+
+    // Pooled files linked only from the pool belong to backups removed by operator
+    for (const auto& entry : fs::directory_iterator(pool)) {
+      if (entry.is_regular_file() && entry.hard_link_count() == 1) {
+        fs::remove(entry.path());
+      }
+    }
+  }
 }
 
 void DbStorage::recoverToPeriod(PbftPeriod period) {
@@ -409,6 +720,11 @@ std::optional<h256> DbStorage::getGenesisHash() {
 }
 
 DbStorage::~DbStorage() {
+  // Pending checkpoints are finished, they are taken from the open db
+  snapshot_thread_.join();
+  // Compactions are only an optimization, so they are aborted instead
+  db_->DisableManualCompaction();
+  compaction_thread_.join();
   for (auto cf : handles_) {
     if (cf->GetName() != "default") {
       checkStatus(db_->DestroyColumnFamilyHandle(cf));
@@ -417,6 +733,11 @@ DbStorage::~DbStorage() {
   checkStatus(db_->Close());
 }
 
+void DbStorage::tryCatchUpWithPrimary() {
+  assert(isSecondary());
+  checkStatus(db_->TryCatchUpWithPrimary());
+}
+
 uint32_t DbStorage::getMajorVersion() const { return kMajorVersion_; }
 
 std::unique_ptr<rocksdb::Iterator> DbStorage::getColumnIterator(const Column& c) {
@@ -439,11 +760,54 @@ void DbStorage::checkStatus(rocksdb::Status const& status) {
 Batch DbStorage::createWriteBatch() { return Batch(); }
 
 void DbStorage::commitWriteBatch(Batch& write_batch, rocksdb::WriteOptions const& opts) {
+  TRACE_SPAN("DbStorage::commitWriteBatch");
   auto status = db_->Write(opts, write_batch.GetWriteBatch());
   checkStatus(status);
   write_batch.Clear();
 }
 
+void DbStorage::syncWal() { checkStatus(db_->SyncWAL()); }
+
+void DbStorage::commitConsensusWriteBatch(Batch& write_batch) {
+  commitWriteBatch(write_batch, async_write_);
+  if (!kColumnsTuning.sync_consensus_writes) {
+    return;
+  }
+
+  std::unique_lock lock(group_sync_mutex_);
+  const auto ticket = ++group_sync_requested_;
+  while (group_sync_done_ < ticket) {
+    if (group_sync_running_) {
+      group_sync_cv_.wait(lock);
+      continue;
+    }
+    group_sync_running_ = true;
+    if (kColumnsTuning.consensus_group_commit_window.count()) {
+      lock.unlock();
+      std::this_thread::sleep_for(kColumnsTuning.consensus_group_commit_window);
+      lock.lock();
+    }
+    // Every write that got its ticket so far was already committed, sync covers it
+    const auto covered = group_sync_requested_;
+    lock.unlock();
+    std::exception_ptr error;
+    try {
+      syncWal();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    lock.lock();
+    group_sync_running_ = false;
+    if (!error) {
+      group_sync_done_ = std::max(group_sync_done_, covered);
+    }
+    group_sync_cv_.notify_all();
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
 void DbStorage::DeleteRange(const Column& col, uint64_t begin, uint64_t end) {
   checkStatus(db_->DeleteRange(async_write_, handle(col), toSlice(begin), toSlice(end)));
 }
@@ -454,18 +818,75 @@ void DbStorage::CompactRange(const Column& col, uint64_t begin, uint64_t end) {
   checkStatus(db_->CompactRange({}, handle(col), &begin_slice, &end_slice));
 }
 
+void DbStorage::pruneRange(const Column& col, uint64_t begin, uint64_t end) {
+  if (begin >= end) {
+    return;
+  }
+  DeleteRange(col, begin, end);
+  scheduleCompaction(col, begin, end);
+}
+
+void DbStorage::scheduleCompaction(const Column& col, uint64_t begin, uint64_t end) {
+  // Int keys are ordered only with int comparator, otherwise the range is not contiguous
+  assert(col.comparator_);
+  std::scoped_lock lock(compactions_mutex_);
+  const auto [it, inserted] = pending_compactions_.try_emplace(col.ordinal_, std::make_pair(begin, end));
+  if (!inserted) {
+    if (auto& range = it->second) {
+      range->first = std::min(range->first, begin);
+      range->second = std::max(range->second, end);
+    }
+    return;
+  }
+  boost::asio::post(compaction_thread_, [this, ordinal = col.ordinal_] { compactPending(ordinal); });
+}
+
+void DbStorage::scheduleCompaction(const Column& col) {
+  std::scoped_lock lock(compactions_mutex_);
+  const auto [it, inserted] = pending_compactions_.try_emplace(col.ordinal_, std::nullopt);
+  if (!inserted) {
+    it->second = std::nullopt;
+    return;
+  }
+  boost::asio::post(compaction_thread_, [this, ordinal = col.ordinal_] { compactPending(ordinal); });
+}
+
+void DbStorage::compactPending(size_t ordinal) {
+  std::optional<std::pair<uint64_t, uint64_t>> range;
+  {
+    std::scoped_lock lock(compactions_mutex_);
+    auto it = pending_compactions_.find(ordinal);
+    range = it->second;
+    pending_compactions_.erase(it);
+  }
+
+  // Does not block automatic compactions meanwhile
+  rocksdb::CompactRangeOptions options;
+  options.exclusive_manual_compaction = false;
+  rocksdb::Status status;
+  if (range) {
+    const auto begin = toSlice(range->first);
+    const auto end = toSlice(range->second);
+    status = db_->CompactRange(options, handles_[ordinal], &begin, &end);
+  } else {
+    status = db_->CompactRange(options, handles_[ordinal], nullptr, nullptr);
+  }
+  // Manual compactions are aborted when db is closing
+  if (!status.ok() && !status.IsIncomplete()) {
+    LOG(log_er_) << "Compaction of column " << Columns::all[ordinal].name() << " failed: " << status.ToString();
+  }
+}
+
 std::shared_ptr<DagBlock> DbStorage::getDagBlock(blk_hash_t const& hash) {
   auto block_data = asBytes(lookup(toSlice(hash.asBytes()), Columns::dag_blocks));
   if (block_data.size() > 0) {
-    return std::make_shared<DagBlock>(block_data);
+    return util::makeShared<DagBlock>(block_data);
   }
   auto data = getDagBlockPeriod(hash);
   if (data) {
-    auto period_data = getPeriodDataRaw(data->first);
-    if (period_data.size() > 0) {
-      auto period_data_rlp = dev::RLP(period_data);
-      auto dag_blocks_data = period_data_rlp[DAG_BLOCKS_POS_IN_PERIOD_DATA];
-      return decodeDAGBlockBundleRlp(data->second, dag_blocks_data);
+    const auto period_data = getPeriodDataView(data->first);
+    if (!period_data.empty()) {
+      return decodeDAGBlockBundleRlp(data->second, period_data.dagBlocksRlp());
     }
   }
   return nullptr;
@@ -514,7 +935,7 @@ std::map<level_t, std::vector<std::shared_ptr<DagBlock>>> DbStorage::getNonfinal
   std::map<level_t, std::vector<std::shared_ptr<DagBlock>>> res;
   auto i = std::unique_ptr<rocksdb::Iterator>(db_->NewIterator(read_options_, handle(Columns::dag_blocks)));
   for (i->SeekToFirst(); i->Valid(); i->Next()) {
-    auto block = std::make_shared<DagBlock>(asBytes(i->value().ToString()));
+    auto block = util::makeShared<DagBlock>(asBytes(i->value().ToString()));
     res[block->getLevel()].emplace_back(std::move(block));
   }
   return res;
@@ -524,7 +945,7 @@ SharedTransactions DbStorage::getAllNonfinalizedTransactions() {
   SharedTransactions res;
   auto i = std::unique_ptr<rocksdb::Iterator>(db_->NewIterator(read_options_, handle(Columns::transactions)));
   for (i->SeekToFirst(); i->Valid(); i->Next()) {
-    res.emplace_back(std::make_shared<Transaction>(asBytes(i->value().ToString())));
+    res.emplace_back(util::makeShared<Transaction>(asBytes(i->value().ToString())));
   }
   return res;
 }
@@ -629,26 +1050,100 @@ void DbStorage::savePeriodData(const PeriodData& period_data, Batch& write_batch
 
   // Remove transactions from non finalized column in db and add dag_block_period in DB
   uint32_t trx_pos = 0;
+  dev::bytes senders;
+  senders.reserve(period_data.transactions.size() * addr_t::size);
+  bool senders_valid = true;
   for (auto const& trx : period_data.transactions) {
     removeTransactionToBatch(trx->getHash(), write_batch);
     addTransactionLocationToBatch(write_batch, trx->getHash(), period_data.pbft_blk->getPeriod(), trx_pos);
     trx_pos++;
+    try {
+      const auto& sender = trx->getSender();
+      senders.insert(senders.end(), sender.begin(), sender.end());
+    } catch (const Transaction::InvalidSignature&) {
+      // Finalized transactions are verified, if some is not its period keeps recovering senders on read
+      senders_valid = false;
+    }
   }
 
   insert(write_batch, Columns::period_data, toSlice(period), toSlice(period_data.rlp()));
+  if (senders_valid && !senders.empty()) {
+    insert(write_batch, Columns::period_trx_senders, toSlice(period), toSlice(senders));
+  }
 }
 
 dev::bytes DbStorage::getPeriodDataRaw(PbftPeriod period) const {
-  return asBytes(lookup(toSlice(period), Columns::period_data));
+  const auto period_data = getPeriodDataView(period);
+  return period_data.raw().toBytes();
+}
+
+PeriodDataView DbStorage::getPeriodDataView(PbftPeriod period) const {
+  rocksdb::PinnableSlice value;
+  auto status = db_->Get(read_options_, handle(Columns::period_data), toSlice(period), &value);
+  if (status.IsNotFound()) {
+    return {};
+  }
+  checkStatus(status);
+  return PeriodDataView(std::move(value));
+}
+
+std::vector<PeriodDataView> DbStorage::getPeriodsDataViews(const std::vector<PbftPeriod>& periods) const {
+  std::vector<PeriodDataView> ret;
+  ret.reserve(periods.size());
+  for (auto& slice : multiGet(Columns::period_data, periods)) {
+    ret.emplace_back(std::move(slice));
+  }
+  return ret;
+}
+
+PbftBlock PeriodDataView::pbftBlock() const { return PbftBlock(rlp()[PBFT_BLOCK_POS_IN_PERIOD_DATA]); }
+
+blk_hash_t PeriodDataView::prevBlockHash() const {
+  return rlp()[PBFT_BLOCK_POS_IN_PERIOD_DATA][PREV_BLOCK_HASH_POS_IN_PBFT_BLOCK].toHash<blk_hash_t>();
+}
+
+std::vector<std::shared_ptr<PbftVote>> PeriodDataView::certVotes() const {
+  auto votes_rlp = rlp()[CERT_VOTES_POS_IN_PERIOD_DATA];
+  if (votes_rlp.itemCount() == 0) {
+    return {};
+  }
+  return decodePbftVotesBundleRlp(votes_rlp);
+}
+
+dev::RLP PeriodDataView::dagBlocksRlp() const { return rlp()[DAG_BLOCKS_POS_IN_PERIOD_DATA]; }
+
+dev::RLP PeriodDataView::transactionsRlp() const { return rlp()[TRANSACTIONS_POS_IN_PERIOD_DATA]; }
+
+std::vector<std::shared_ptr<PillarVote>> PeriodDataView::pillarVotes() const {
+  const auto period_data_rlp = rlp();
+  // This could potentially happen if pillar votes are requested for period that does not contain them
+  if (period_data_rlp.itemCount() <= PILLAR_VOTES_POS_IN_PERIOD_DATA) {
+    return {};
+  }
+  return decodePillarVotesBundleRlp(period_data_rlp[PILLAR_VOTES_POS_IN_PERIOD_DATA]);
+}
+
+blk_hash_t PeriodDataView::pbftBlockHash() const { return dev::sha3(rlp()[PBFT_BLOCK_POS_IN_PERIOD_DATA].data()); }
+
+std::vector<blk_hash_t> PeriodDataView::dagBlocksHashes() const { return decodeDAGBlocksBundleHashes(dagBlocksRlp()); }
+
+std::vector<trx_hash_t> PeriodDataView::transactionsHashes() const {
+  const auto trxs_rlp = transactionsRlp();
+  std::vector<trx_hash_t> ret;
+  ret.reserve(trxs_rlp.itemCount());
+  for (const auto trx_rlp : trxs_rlp) {
+    ret.push_back(dev::sha3(trx_rlp.data()));
+  }
+  return ret;
 }
 
 std::optional<PeriodData> DbStorage::getPeriodData(PbftPeriod period) const {
-  auto period_data_bytes = getPeriodDataRaw(period);
-  if (period_data_bytes.empty()) {
+  const auto period_data = getPeriodDataView(period);
+  if (period_data.empty()) {
     return {};
   }
 
-  return PeriodData{std::move(period_data_bytes)};
+  return PeriodData{period_data.rlp()};
 }
 
 void DbStorage::savePillarBlock(const std::shared_ptr<pillar_chain::PillarBlock>& pillar_block) {
@@ -675,7 +1170,9 @@ std::shared_ptr<pillar_chain::PillarBlock> DbStorage::getLatestPillarBlock() con
 }
 
 void DbStorage::saveOwnPillarBlockVote(const std::shared_ptr<PillarVote>& vote) {
-  insert(Columns::current_pillar_block_own_vote, 0, util::rlp_enc(vote));
+  auto batch = createWriteBatch();
+  insert(batch, Columns::current_pillar_block_own_vote, 0, util::rlp_enc(vote));
+  commitConsensusWriteBatch(batch);
 }
 
 std::shared_ptr<PillarVote> DbStorage::getOwnPillarBlockVote() const {
@@ -723,10 +1220,9 @@ std::optional<TransactionLocation> DbStorage::getTransactionLocation(trx_hash_t
 
 std::vector<bool> DbStorage::transactionsFinalized(std::vector<trx_hash_t> const& trx_hashes) {
   std::vector<bool> result(trx_hashes.size(), false);
-  for (size_t i = 0; i < trx_hashes.size(); ++i) {
-    if (exist(toSlice(trx_hashes[i].asBytes()), Columns::trx_period)) {
-      result[i] = true;
-    }
+  const auto locations = multiGet(Columns::trx_period, trx_hashes);
+  for (size_t i = 0; i < locations.size(); ++i) {
+    result[i] = !locations[i].empty();
   }
   return result;
 }
@@ -745,7 +1241,9 @@ std::unordered_map<trx_hash_t, PbftPeriod> DbStorage::getAllTransactionPeriod()
 
 // Proposed pbft blocks
 void DbStorage::saveProposedPbftBlock(const std::shared_ptr<PbftBlock>& block) {
-  insert(Columns::proposed_pbft_blocks, block->getBlockHash().asBytes(), block->rlp(true));
+  auto batch = createWriteBatch();
+  insert(batch, Columns::proposed_pbft_blocks, block->getBlockHash().asBytes(), block->rlp(true));
+  commitConsensusWriteBatch(batch);
 }
 
 void DbStorage::removeProposedPbftBlock(const blk_hash_t& block_hash, Batch& write_batch) {
@@ -762,11 +1260,10 @@ std::vector<std::shared_ptr<PbftBlock>> DbStorage::getProposedPbftBlocks() {
 }
 
 std::optional<PbftBlock> DbStorage::getPbftBlock(PbftPeriod period) const {
-  auto period_data = getPeriodDataRaw(period);
+  const auto period_data = getPeriodDataView(period);
   // DB is corrupted if status point to missing or incorrect transaction
-  if (period_data.size() > 0) {
-    auto period_data_rlp = dev::RLP(period_data);
-    return std::optional<PbftBlock>(period_data_rlp[PBFT_BLOCK_POS_IN_PERIOD_DATA]);
+  if (!period_data.empty()) {
+    return period_data.pbftBlock();
   }
   return {};
 }
@@ -782,7 +1279,7 @@ blk_hash_t DbStorage::getPeriodBlockHash(PbftPeriod period) const {
 std::shared_ptr<Transaction> DbStorage::getTransaction(trx_hash_t const& hash) const {
   auto data = asBytes(lookup(toSlice(hash.asBytes()), Columns::transactions));
   if (data.size() > 0) {
-    return std::make_shared<Transaction>(std::move(data));
+    return util::makeShared<Transaction>(std::move(data));
   }
   auto location = getTransactionLocation(hash);
   if (location && !location->is_system) {
@@ -795,20 +1292,19 @@ std::shared_ptr<Transaction> DbStorage::getTransaction(trx_hash_t const& hash) c
 }
 
 std::shared_ptr<Transaction> DbStorage::getTransaction(PbftPeriod period, uint32_t position) const {
-  auto period_data = getPeriodDataRaw(period);
-  if (period_data.size() > 0) {
-    auto period_data_rlp = dev::RLP(period_data);
-    auto transaction_data = period_data_rlp[TRANSACTIONS_POS_IN_PERIOD_DATA];
-    return std::make_shared<Transaction>(transaction_data[position]);
+  const auto period_data = getPeriodDataView(period);
+  if (!period_data.empty()) {
+    auto trx = util::makeShared<Transaction>(period_data.transactionsRlp()[position]);
+    restoreTransactionSender(*trx, lookup(toSlice(period), Columns::period_trx_senders), position);
+    return trx;
   }
   return nullptr;
 }
 
 uint64_t DbStorage::getTransactionCount(PbftPeriod period) const {
-  auto period_data = getPeriodDataRaw(period);
-  if (period_data.size()) {
-    auto period_data_rlp = dev::RLP(period_data);
-    return period_data_rlp[TRANSACTIONS_POS_IN_PERIOD_DATA].itemCount();
+  const auto period_data = getPeriodDataView(period);
+  if (!period_data.empty()) {
+    return period_data.transactionsRlp().itemCount();
   }
   return 0;
 }
@@ -818,21 +1314,34 @@ SharedTransactions DbStorage::getFinalizedTransactions(std::vector<trx_hash_t> c
   // Map of period to position of transactions within a period
   std::map<PbftPeriod, std::set<uint32_t>> period_map;
   trxs.reserve(trx_hashes.size());
-  for (auto const& tx_hash : trx_hashes) {
-    auto trx_period = getTransactionLocation(tx_hash);
-    if (trx_period.has_value()) {
-      period_map[trx_period->period].insert(trx_period->position);
+  for (const auto& location_data : multiGet(Columns::trx_period, trx_hashes)) {
+    if (location_data.empty()) {
+      continue;
     }
-  }
-  for (auto it : period_map) {
-    const auto period_data = getPeriodDataRaw(it.first);
-    if (!period_data.size()) {
+    const auto location = TransactionLocation::fromRlp(sliceToRlp(location_data));
+    period_map[location.period].insert(location.position);
+  }
+
+  std::vector<PbftPeriod> periods;
+  periods.reserve(period_map.size());
+  for (const auto& it : period_map) {
+    periods.push_back(it.first);
+  }
+  const auto periods_data = multiGet(Columns::period_data, periods);
+  const auto periods_senders = multiGet(Columns::period_trx_senders, periods);
+  size_t i = 0;
+  for (const auto& it : period_map) {
+    const auto& senders = periods_senders[i];
+    const auto& period_data = periods_data[i++];
+    if (period_data.empty()) {
       assert(false);
+      continue;
     }
 
-    auto const transactions_rlp = dev::RLP(period_data)[TRANSACTIONS_POS_IN_PERIOD_DATA];
+    auto const transactions_rlp = sliceToRlp(period_data)[TRANSACTIONS_POS_IN_PERIOD_DATA];
     for (auto pos : it.second) {
-      trxs.emplace_back(std::make_shared<Transaction>(transactions_rlp[pos]));
+      const auto& trx = trxs.emplace_back(util::makeShared<Transaction>(transactions_rlp[pos]));
+      restoreTransactionSender(*trx, senders.ToStringView(), pos);
     }
   }
 
@@ -882,24 +1391,20 @@ SharedTransactions DbStorage::getPeriodSystemTransactions(PbftPeriod period) con
 }
 
 std::vector<std::shared_ptr<PbftVote>> DbStorage::getPeriodCertVotes(PbftPeriod period) const {
-  auto period_data = getPeriodDataRaw(period);
+  const auto period_data = getPeriodDataView(period);
   if (period_data.empty()) {
     return {};
   }
-
-  auto period_data_rlp = dev::RLP(period_data);
-  auto votes_rlp = period_data_rlp[CERT_VOTES_POS_IN_PERIOD_DATA];
-  if (votes_rlp.itemCount() == 0) {
-    return {};
-  }
-  return decodePbftVotesBundleRlp(votes_rlp);
+  return period_data.certVotes();
 }
 
 SharedTransactions DbStorage::transactionsFromPeriodDataRlp(PbftPeriod period, const dev::RLP& period_data_rlp) const {
   SharedTransactions ret;
   ret.reserve(period_data_rlp[TRANSACTIONS_POS_IN_PERIOD_DATA].size());
+  const auto senders = lookup(toSlice(period), Columns::period_trx_senders);
   for (auto&& transaction_data : period_data_rlp[TRANSACTIONS_POS_IN_PERIOD_DATA]) {
-    ret.emplace_back(std::make_shared<Transaction>(std::move(transaction_data)));
+    const auto& trx = ret.emplace_back(util::makeShared<Transaction>(std::move(transaction_data)));
+    restoreTransactionSender(*trx, senders, ret.size() - 1);
   }
   auto period_system_transactions = getPeriodSystemTransactions(period);
   ret.insert(ret.end(), period_system_transactions.begin(), period_system_transactions.end());
@@ -907,12 +1412,12 @@ SharedTransactions DbStorage::transactionsFromPeriodDataRlp(PbftPeriod period, c
 }
 
 std::optional<SharedTransactions> DbStorage::getPeriodTransactions(PbftPeriod period) const {
-  const auto period_data = getPeriodDataRaw(period);
-  if (!period_data.size()) {
+  const auto period_data = getPeriodDataView(period);
+  if (period_data.empty()) {
     return std::nullopt;
   }
 
-  return transactionsFromPeriodDataRlp(period, dev::RLP(period_data));
+  return transactionsFromPeriodDataRlp(period, period_data.rlp());
 }
 
 std::optional<TransactionReceipt> DbStorage::getTransactionReceipt(EthBlockNumber blk_n, uint64_t position) const {
@@ -920,11 +1425,11 @@ std::optional<TransactionReceipt> DbStorage::getTransactionReceipt(EthBlockNumbe
   if (raw.empty()) {
     return {};
   }
-  auto receipts_rlp = dev::RLP(raw);
-  if (receipts_rlp.itemCount() <= position) {
+  const ReceiptsView receipts(dev::bytesConstRef(reinterpret_cast<const ::byte*>(raw.data()), raw.size()));
+  if (receipts.size() <= position) {
     return {};
   }
-  return util::rlp_dec<TransactionReceipt>(receipts_rlp[position]);
+  return receipts[position];
 }
 
 SharedTransactionReceipts DbStorage::getBlockReceipts(PbftPeriod period) const {
@@ -932,23 +1437,81 @@ SharedTransactionReceipts DbStorage::getBlockReceipts(PbftPeriod period) const {
   if (raw.empty()) {
     return {};
   }
-  return std::make_shared<std::vector<TransactionReceipt>>(
-      util::rlp_dec<std::vector<TransactionReceipt>>(dev::RLP(raw)));
+  return std::make_shared<TransactionReceipts>(
+      ReceiptsView(dev::bytesConstRef(reinterpret_cast<const ::byte*>(raw.data()), raw.size())).decodeAll());
 }
 
-std::vector<std::shared_ptr<PillarVote>> DbStorage::getPeriodPillarVotes(PbftPeriod period) const {
-  const auto period_data = getPeriodDataRaw(period);
-  if (!period_data.size()) {
-    return {};
+std::vector<SharedTransactionReceipts> DbStorage::getBlocksReceipts(const std::vector<PbftPeriod>& periods) const {
+  std::vector<SharedTransactionReceipts> ret;
+  ret.reserve(periods.size());
+  for (const auto& raw : multiLookup(periods, DbStorage::Columns::final_chain_receipt_by_period)) {
+    if (raw.empty()) {
+      ret.emplace_back();
+      continue;
+    }
+    ret.emplace_back(std::make_shared<TransactionReceipts>(
+        ReceiptsView(dev::bytesConstRef(reinterpret_cast<const ::byte*>(raw.data()), raw.size())).decodeAll()));
   }
+  return ret;
+}
+
+void DbStorage::forEachFinalizedPeriod(PbftPeriod from, PbftPeriod to, const FinalizedPeriodCallback& callback) const {
+  // Headers column has no int comparator, so its keys are not ordered by period and headers are read in batches
+  constexpr PbftPeriod kHeadersBatchSize = 256;
+
+  std::unique_ptr<rocksdb::Iterator> period_data_it(db_->NewIterator(read_options_, handle(Columns::period_data)));
+  std::unique_ptr<rocksdb::Iterator> receipts_it(
+      db_->NewIterator(read_options_, handle(Columns::final_chain_receipt_by_period)));
+  period_data_it->Seek(toSlice(from));
+  receipts_it->Seek(toSlice(from));
 
-  auto period_data_rlp = dev::RLP(period_data);
-  // This could potentially happen if getPeriodPillarVotes is called for period that does not contain pillar votes
-  if (period_data_rlp.itemCount() < PILLAR_VOTES_POS_IN_PERIOD_DATA) {
+  // Iterators only move forward, periods without data are skipped
+  const auto value_at = [](rocksdb::Iterator& it, PbftPeriod period) -> Slice {
+    while (it.Valid()) {
+      PbftPeriod key;
+      memcpy(&key, it.key().data(), sizeof(PbftPeriod));
+      if (key > period) {
+        break;
+      }
+      if (key == period) {
+        return it.value();
+      }
+      it.Next();
+    }
     return {};
+  };
+
+  for (PbftPeriod batch_begin = from; batch_begin <= to; batch_begin += kHeadersBatchSize) {
+    std::vector<PbftPeriod> periods;
+    for (auto period = batch_begin; period <= to && periods.size() < kHeadersBatchSize; ++period) {
+      periods.push_back(period);
+    }
+    const auto headers = multiGet(Columns::final_chain_blk_by_number, periods);
+    for (size_t i = 0; i < periods.size(); ++i) {
+      if (headers[i].empty()) {
+        return;
+      }
+      PeriodDataView period_data;
+      if (const auto data = value_at(*period_data_it, periods[i]); !data.empty()) {
+        rocksdb::PinnableSlice pinned;
+        pinned.PinSelf(data);
+        period_data = PeriodDataView(std::move(pinned));
+      }
+      if (!callback(periods[i], headers[i], period_data, value_at(*receipts_it, periods[i]))) {
+        return;
+      }
+    }
+    checkStatus(period_data_it->status());
+    checkStatus(receipts_it->status());
   }
+}
 
-  return decodePillarVotesBundleRlp(period_data_rlp[PILLAR_VOTES_POS_IN_PERIOD_DATA]);
+std::vector<std::shared_ptr<PillarVote>> DbStorage::getPeriodPillarVotes(PbftPeriod period) const {
+  const auto period_data = getPeriodDataView(period);
+  if (period_data.empty()) {
+    return {};
+  }
+  return period_data.pillarVotes();
 }
 
 void DbStorage::addTransactionToBatch(Transaction const& trx, Batch& write_batch) {
@@ -956,7 +1519,25 @@ void DbStorage::addTransactionToBatch(Transaction const& trx, Batch& write_batch
 }
 
 void DbStorage::removeTransactionToBatch(trx_hash_t const& trx, Batch& write_batch) {
-  remove(write_batch, Columns::transactions, toSlice(trx));
+  // Most transactions are finalized before their memtable is flushed, then neither the body nor its removal reaches
+  // sst files and period data remains the only stored copy
+  singleRemove(write_batch, Columns::transactions, toSlice(trx));
+}
+
+void DbStorage::savePoolSpilledTransaction(const Transaction& trx) {
+  insert(Columns::pool_spilled_transactions, toSlice(trx.getHash().asBytes()), toSlice(trx.rlp()));
+}
+
+std::shared_ptr<Transaction> DbStorage::getPoolSpilledTransaction(const trx_hash_t& hash) const {
+  auto data = asBytes(lookup(toSlice(hash.asBytes()), Columns::pool_spilled_transactions));
+  if (data.size() > 0) {
+    return util::makeShared<Transaction>(std::move(data));
+  }
+  return nullptr;
+}
+
+void DbStorage::removePoolSpilledTransaction(const trx_hash_t& hash) {
+  remove(Columns::pool_spilled_transactions, toSlice(hash.asBytes()));
 }
 
 bool DbStorage::transactionInDb(trx_hash_t const& hash) {
@@ -969,11 +1550,21 @@ bool DbStorage::transactionFinalized(trx_hash_t const& hash) {
 
 std::vector<bool> DbStorage::transactionsInDb(std::vector<trx_hash_t> const& trx_hashes) {
   std::vector<bool> result(trx_hashes.size(), false);
-  for (size_t i = 0; i < trx_hashes.size(); ++i) {
-    const auto key = trx_hashes[i].asBytes();
-    if (exist(toSlice(key), Columns::transactions) || exist(toSlice(key), Columns::trx_period)) {
+  std::vector<trx_hash_t> missing;
+  std::vector<size_t> missing_idx;
+  const auto transactions = multiGet(Columns::transactions, trx_hashes);
+  for (size_t i = 0; i < transactions.size(); ++i) {
+    if (!transactions[i].empty()) {
       result[i] = true;
+      continue;
     }
+    missing.push_back(trx_hashes[i]);
+    missing_idx.push_back(i);
+  }
+  // Only transactions that are not in the non-finalized column can be finalized
+  const auto locations = multiGet(Columns::trx_period, missing);
+  for (size_t i = 0; i < locations.size(); ++i) {
+    result[missing_idx[i]] = !locations[i].empty();
   }
   return result;
 }
@@ -1011,7 +1602,9 @@ uint32_t DbStorage::getPbftMgrField(PbftMgrField field) {
 }
 
 void DbStorage::savePbftMgrField(PbftMgrField field, uint32_t value) {
-  insert(Columns::pbft_mgr_round_step, toSlice(static_cast<uint8_t>(field)), toSlice(value));
+  auto batch = createWriteBatch();
+  addPbftMgrFieldToBatch(field, value, batch);
+  commitConsensusWriteBatch(batch);
 }
 
 void DbStorage::addPbftMgrFieldToBatch(PbftMgrField field, uint32_t value, Batch& write_batch) {
@@ -1029,7 +1622,9 @@ bool DbStorage::getPbftMgrStatus(PbftMgrStatus field) {
 }
 
 void DbStorage::savePbftMgrStatus(PbftMgrStatus field, bool const& value) {
-  insert(Columns::pbft_mgr_status, toSlice(field), toSlice(value));
+  auto batch = createWriteBatch();
+  addPbftMgrStatusToBatch(field, value, batch);
+  commitConsensusWriteBatch(batch);
 }
 
 void DbStorage::addPbftMgrStatusToBatch(PbftMgrStatus field, bool const& value, Batch& write_batch) {
@@ -1042,7 +1637,9 @@ void DbStorage::saveCertVotedBlockInRound(PbftRound round, const std::shared_ptr
   dev::RLPStream s(2);
   s.append(round);
   s.appendRaw(block->rlp(true));
-  insert(Columns::cert_voted_block_in_round, 0, toSlice(s.out()));
+  auto batch = createWriteBatch();
+  insert(batch, Columns::cert_voted_block_in_round, 0, toSlice(s.out()));
+  commitConsensusWriteBatch(batch);
 }
 
 std::optional<std::pair<PbftRound, std::shared_ptr<PbftBlock>>> DbStorage::getCertVotedBlockInRound() const {
@@ -1077,21 +1674,22 @@ bool DbStorage::pbftBlockInDb(blk_hash_t const& hash) {
   return exist(toSlice(hash.asBytes()), Columns::pbft_block_period);
 }
 
-std::string DbStorage::getPbftHead(blk_hash_t const& hash) {
-  return lookup(toSlice(hash.asBytes()), Columns::pbft_head);
+bytes DbStorage::getPbftHead(blk_hash_t const& hash) {
+  return asBytes(lookup(toSlice(hash.asBytes()), Columns::pbft_head));
 }
 
-void DbStorage::savePbftHead(blk_hash_t const& hash, std::string const& pbft_chain_head_str) {
-  insert(Columns::pbft_head, toSlice(hash.asBytes()), pbft_chain_head_str);
+void DbStorage::savePbftHead(blk_hash_t const& hash, bytes const& pbft_chain_head) {
+  insert(Columns::pbft_head, toSlice(hash.asBytes()), toSlice(pbft_chain_head));
 }
 
-void DbStorage::addPbftHeadToBatch(taraxa::blk_hash_t const& head_hash, std::string const& head_str,
-                                   Batch& write_batch) {
-  insert(write_batch, Columns::pbft_head, toSlice(head_hash.asBytes()), head_str);
+void DbStorage::addPbftHeadToBatch(taraxa::blk_hash_t const& head_hash, bytes const& head, Batch& write_batch) {
+  insert(write_batch, Columns::pbft_head, toSlice(head_hash.asBytes()), toSlice(head));
 }
 
 void DbStorage::saveOwnVerifiedVote(const std::shared_ptr<PbftVote>& vote) {
-  insert(Columns::latest_round_own_votes, vote->getHash().asBytes(), vote->rlp(true, true));
+  auto batch = createWriteBatch();
+  insert(batch, Columns::latest_round_own_votes, vote->getHash().asBytes(), vote->rlp(true, true));
+  commitConsensusWriteBatch(batch);
 }
 
 std::vector<std::shared_ptr<PbftVote>> DbStorage::getOwnVerifiedVotes() {
@@ -1099,7 +1697,7 @@ std::vector<std::shared_ptr<PbftVote>> DbStorage::getOwnVerifiedVotes() {
   auto it =
       std::unique_ptr<rocksdb::Iterator>(db_->NewIterator(read_options_, handle(Columns::latest_round_own_votes)));
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    votes.emplace_back(std::make_shared<PbftVote>(asBytes(it->value().ToString())));
+    votes.emplace_back(util::makeShared<PbftVote>(asBytes(it->value().ToString())));
   }
 
   return votes;
@@ -1114,13 +1712,9 @@ void DbStorage::clearOwnVerifiedVotes(Batch& write_batch,
 
 void DbStorage::replaceTwoTPlusOneVotes(TwoTPlusOneVotedBlockType type,
                                         const std::vector<std::shared_ptr<PbftVote>>& votes) {
-  remove(Columns::latest_round_two_t_plus_one_votes, static_cast<uint8_t>(type));
-
-  dev::RLPStream s(votes.size());
-  for (const auto& vote : votes) {
-    s.appendRaw(vote->rlp(true, true));
-  }
-  insert(Columns::latest_round_two_t_plus_one_votes, static_cast<uint8_t>(type), s.out());
+  auto batch = createWriteBatch();
+  replaceTwoTPlusOneVotesToBatch(type, votes, batch);
+  commitConsensusWriteBatch(batch);
 }
 
 void DbStorage::replaceTwoTPlusOneVotesToBatch(TwoTPlusOneVotedBlockType type,
@@ -1143,7 +1737,7 @@ std::vector<std::shared_ptr<PbftVote>> DbStorage::getAllTwoTPlusOneVotes() {
     votes.reserve(votes.size() + votes_rlp.size());
 
     for (const auto vote : votes_rlp) {
-      votes.emplace_back(std::make_shared<PbftVote>(vote));
+      votes.emplace_back(util::makeShared<PbftVote>(vote));
     }
   };
 
@@ -1170,7 +1764,7 @@ std::vector<std::shared_ptr<PbftVote>> DbStorage::getRewardVotes() {
 
   auto it = std::unique_ptr<rocksdb::Iterator>(db_->NewIterator(read_options_, handle(Columns::extra_reward_votes)));
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    votes.emplace_back(std::make_shared<PbftVote>(asBytes(it->value().ToString())));
+    votes.emplace_back(util::makeShared<PbftVote>(asBytes(it->value().ToString())));
   }
 
   return votes;
@@ -1217,9 +1811,8 @@ void DbStorage::addDagBlockPeriodToBatch(blk_hash_t const& hash, PbftPeriod peri
 
 std::vector<blk_hash_t> DbStorage::getFinalizedDagBlockHashesByPeriod(PbftPeriod period) {
   std::vector<blk_hash_t> ret;
-  if (auto period_data = getPeriodDataRaw(period); period_data.size() > 0) {
-    auto dag_blocks_data = dev::RLP(period_data)[DAG_BLOCKS_POS_IN_PERIOD_DATA];
-    const auto dag_blocks = decodeDAGBlocksBundleRlp(dag_blocks_data);
+  if (const auto period_data = getPeriodDataView(period); !period_data.empty()) {
+    const auto dag_blocks = decodeDAGBlocksBundleRlp(period_data.dagBlocksRlp());
     ret.reserve(dag_blocks.size());
     std::transform(dag_blocks.begin(), dag_blocks.end(), std::back_inserter(ret),
                    [](const auto& dag_block) { return dag_block->getHash(); });
@@ -1229,28 +1822,23 @@ std::vector<blk_hash_t> DbStorage::getFinalizedDagBlockHashesByPeriod(PbftPeriod
 }
 
 std::vector<std::shared_ptr<DagBlock>> DbStorage::getFinalizedDagBlockByPeriod(PbftPeriod period) {
-  auto period_data = getPeriodDataRaw(period);
+  const auto period_data = getPeriodDataView(period);
   if (period_data.empty()) {
     return {};
   }
 
-  auto dag_blocks_data = dev::RLP(period_data)[DAG_BLOCKS_POS_IN_PERIOD_DATA];
-  return decodeDAGBlocksBundleRlp(dag_blocks_data);
+  return decodeDAGBlocksBundleRlp(period_data.dagBlocksRlp());
 }
 
 std::pair<blk_hash_t, std::vector<std::shared_ptr<DagBlock>>>
 DbStorage::getLastPbftBlockHashAndFinalizedDagBlockByPeriod(PbftPeriod period) {
-  auto period_data = getPeriodDataRaw(period);
+  const auto period_data = getPeriodDataView(period);
   if (period_data.empty()) {
     return {};
   }
 
-  const auto period_data_rlp = dev::RLP(period_data);
-  auto dag_blocks_data = period_data_rlp[DAG_BLOCKS_POS_IN_PERIOD_DATA];
-  auto blocks = decodeDAGBlocksBundleRlp(dag_blocks_data);
-  auto last_pbft_block_hash =
-      period_data_rlp[PBFT_BLOCK_POS_IN_PERIOD_DATA][PREV_BLOCK_HASH_POS_IN_PBFT_BLOCK].toHash<blk_hash_t>();
-  return {last_pbft_block_hash, std::move(blocks)};
+  auto blocks = decodeDAGBlocksBundleRlp(period_data.dagBlocksRlp());
+  return {period_data.prevBlockHash(), std::move(blocks)};
 }
 
 std::optional<PbftPeriod> DbStorage::getProposalPeriodForDagLevel(uint64_t level) {
@@ -1307,6 +1895,18 @@ void DbStorage::saveRoundsCountDynamicLambda(uint32_t rounds_count, Batch& write
   insert(write_batch, Columns::rounds_count_dynamic_lambda, 0, toSlice(rounds_count));
 }
 
+void DbStorage::saveStartupSnapshot(StartupSnapshotKey key, const bytes& data) {
+  insert(Columns::startup_snapshot, static_cast<uint8_t>(key), toSlice(data));
+}
+
+bytes DbStorage::takeStartupSnapshot(StartupSnapshotKey key) {
+  auto data = asBytes(lookup(static_cast<uint8_t>(key), Columns::startup_snapshot));
+  if (!data.empty()) {
+    remove(Columns::startup_snapshot, static_cast<uint8_t>(key));
+  }
+  return data;
+}
+
 uint32_t DbStorage::getRoundsCountDynamicLambda() {
   auto rounds_count_bytes = lookup(0, Columns::rounds_count_dynamic_lambda);
   if (!rounds_count_bytes.empty()) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <boost/log/sources/severity_channel_logger.hpp>
 #include <string>
 
@@ -10,6 +11,28 @@ namespace taraxa::logger {
 // Concurrent (Thread-safe) logger type
 using Logger = boost::log::sources::severity_channel_logger_mt<>;
 
+// Most verbose level compiled into LOG() checks, records above it never reach boost
+#ifndef TARAXA_LOG_MAX_VERBOSITY
+#define TARAXA_LOG_MAX_VERBOSITY 4
+#endif
+
+namespace detail {
+// Most verbose level accepted by any initialized logging config, maintained by Config::InitLogging/DeinitLogging
+extern std::atomic<int> max_enabled_verbosity;
+}  // namespace detail
+
+/**
+ * @brief Checks whether any sink may accept records of the logger's level
+ * @note It is evaluated by LOG() before boost opens a record, so disabled levels skip attribute lookups, sink
+ *       filters and formatting of the streamed arguments
+ */
+template <class LoggerType>
+inline bool isLogEnabled(const LoggerType& logger) {
+  const int severity = logger.default_severity();
+  return severity <= TARAXA_LOG_MAX_VERBOSITY &&
+         severity <= detail::max_enabled_verbosity.load(std::memory_order_relaxed);
+}
+
 /**
  * @brief Creates thread-safe severity channel logger
  * @note To control logging in terms of where log messages are forwarded(console/file), severity filter etc..., see
@@ -55,7 +78,12 @@ void InitLogging(Config& logging_config, const addr_t& node_id);
 
 }  // namespace taraxa::logger
 
-#define LOG BOOST_LOG
+// Replaces aleth's plain BOOST_LOG definition, it works for aleth's loggers too
+#undef LOG
+#define LOG(_logger)                            \
+  if (!taraxa::logger::isLogEnabled(_logger)) { \
+  } else                                        \
+    BOOST_LOG(_logger)
 
 #define LOG_OBJECTS_DEFINE                \
   mutable taraxa::logger::Logger log_si_; \
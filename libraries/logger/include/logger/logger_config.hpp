@@ -1,9 +1,11 @@
 #pragma once
 
+#include <boost/log/sinks/sink.hpp>
 #include <boost/log/sinks/text_ostream_backend.hpp>
 #include <boost/log/sources/record_ostream.hpp>
 #include <boost/log/utility/setup/file.hpp>
 #include <filesystem>
+#include <functional>
 #include <string>
 
 #include "common/types.hpp"
@@ -46,6 +48,19 @@ class Config {
     std::string time_based_rotation;
     std::string format = "%ThreadID% %ShortNodeId% %Channel% [%TimeStamp%] %SeverityStr%: %Message%";
     uint64_t max_size = 0;
+    // Records are queued into a bounded queue and written by a dedicated thread of the sink
+    bool async = false;
+    // What a logging thread does when the async queue is full: drop the record or wait for the writer
+    bool drop_on_overflow = true;
+  };
+
+  // Bounded queue capacity of async sinks
+  static constexpr size_t kAsyncQueueSize = 65536;
+
+  struct SinkHandle {
+    boost::shared_ptr<boost::log::sinks::sink> sink;
+    // Stops writer thread of async sinks and writes out queued records, flushes sync sinks
+    std::function<void()> stop;
   };
   Config() = default;
   Config(fs::path log_path);
@@ -69,12 +84,15 @@ class Config {
   std::string name = "default";
   Verbosity verbosity{Verbosity::Error};
   std::map<std::string, uint16_t> channels;
+  // Max records per second forwarded to each sink for the channel, the rest is dropped
+  std::map<std::string, uint32_t> channel_rate_limits;
   std::vector<OutputConfig> outputs;
-  std::vector<boost::shared_ptr<log_sink<boost::log::sinks::text_ostream_backend>>> console_sinks;
-  std::vector<boost::shared_ptr<log_sink<boost::log::sinks::text_file_backend>>> file_sinks;
+  std::vector<SinkHandle> sinks;
 
  private:
   bool logging_initialized_{false};
+  // Most verbose level accepted by this config's filters, registered for LOG() level checks while initialized
+  int max_verbosity_{Verbosity::Silent};
 };
 
 }  // namespace taraxa::logger
@@ -5,10 +5,20 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/core/null_deleter.hpp>
 #include <boost/log/attributes/function.hpp>
+#include <boost/log/sinks/async_frontend.hpp>
+#include <boost/log/sinks/block_on_overflow.hpp>
+#include <boost/log/sinks/bounded_fifo_queue.hpp>
+#include <boost/log/sinks/drop_on_overflow.hpp>
+#include <boost/log/sinks/sync_frontend.hpp>
+#include <boost/log/sinks/text_file_backend.hpp>
 #include <boost/log/utility/exception_handler.hpp>
 #include <boost/log/utility/setup/common_attributes.hpp>
+#include <chrono>
+#include <mutex>
+#include <set>
 
 #include "common/config_exception.hpp"
+#include "logger/logger.hpp"
 
 namespace taraxa::logger {
 
@@ -16,6 +26,85 @@ BOOST_LOG_ATTRIBUTE_KEYWORD(channel, "Channel", std::string)
 BOOST_LOG_ATTRIBUTE_KEYWORD(short_node_id, "ShortNodeId", std::string)
 BOOST_LOG_ATTRIBUTE_KEYWORD(severity, "Severity", int)
 
+namespace detail {
+// Nothing is filtered out before the first config is initialized, boost then uses its default console sink
+std::atomic<int> max_enabled_verbosity{Verbosity::Trace};
+}  // namespace detail
+
+namespace {
+
+namespace sinks = boost::log::sinks;
+
+std::mutex enabled_verbosities_mutex;
+std::multiset<int> enabled_verbosities;
+
+void updateMaxEnabledVerbosity() {
+  detail::max_enabled_verbosity =
+      enabled_verbosities.empty() ? static_cast<int>(Verbosity::Trace) : *enabled_verbosities.rbegin();
+}
+
+/**
+ * @brief Fixed one second window counter, it is shared by all logging threads of the channel
+ */
+class RateLimiter {
+ public:
+  explicit RateLimiter(uint32_t limit) : limit_(limit) {}
+
+  bool allow() {
+    const int64_t second =
+        std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    auto window = window_.load(std::memory_order_relaxed);
+    // Concurrent window switch may let few extra records through, which is fine for logs
+    if (window != second && window_.compare_exchange_strong(window, second, std::memory_order_relaxed)) {
+      count_.store(0, std::memory_order_relaxed);
+    }
+    return count_.fetch_add(1, std::memory_order_relaxed) < limit_;
+  }
+
+ private:
+  const uint32_t limit_;
+  std::atomic<int64_t> window_{0};
+  std::atomic<uint32_t> count_{0};
+};
+
+template <class Backend, class OverflowPolicy>
+using AsyncSink = sinks::asynchronous_sink<Backend, sinks::bounded_fifo_queue<Config::kAsyncQueueSize, OverflowPolicy>>;
+
+template <class Sink, class Filter>
+Config::SinkHandle registerSink(const boost::shared_ptr<Sink> &sink, const Config::OutputConfig &output,
+                                Filter &&filter) {
+  sink->set_filter(std::forward<Filter>(filter));
+  sink->set_formatter(boost::log::aux::acquire_formatter(output.format));
+  boost::log::core::get()->add_sink(sink);
+
+  if constexpr (requires { sink->stop(); }) {
+    // flush() writes out records left in the queue once the writer thread is stopped
+    return {sink, [sink] {
+              sink->stop();
+              sink->flush();
+            }};
+  } else {
+    return {sink, [sink] { sink->flush(); }};
+  }
+}
+
+template <class Backend, class Filter>
+Config::SinkHandle addSink(const boost::shared_ptr<Backend> &backend, const Config::OutputConfig &output,
+                           Filter &&filter) {
+  if (!output.async) {
+    return registerSink(boost::make_shared<sinks::synchronous_sink<Backend>>(backend), output,
+                        std::forward<Filter>(filter));
+  }
+  if (output.drop_on_overflow) {
+    return registerSink(boost::make_shared<AsyncSink<Backend, sinks::drop_on_overflow>>(backend), output,
+                        std::forward<Filter>(filter));
+  }
+  return registerSink(boost::make_shared<AsyncSink<Backend, sinks::block_on_overflow>>(backend), output,
+                      std::forward<Filter>(filter));
+}
+
+}  // namespace
+
 Verbosity stringToVerbosity(std::string _verbosity) {
   if (_verbosity == "SILENT") return Verbosity::Silent;
   if (_verbosity == "ERROR") return Verbosity::Error;
@@ -43,9 +132,9 @@ Config::Config(const Config &other)
     : name(other.name),
       verbosity(other.verbosity),
       channels(other.channels),
+      channel_rate_limits(other.channel_rate_limits),
       outputs(other.outputs),
-      console_sinks(other.console_sinks),
-      file_sinks(other.file_sinks) {
+      sinks(other.sinks) {
   // logging_initialized_ flag is always set to false(in copies) so it is deinitialized
   // only in orig. config object destructor and not also in new copied Config
   logging_initialized_ = false;
@@ -55,9 +144,9 @@ Config &Config::operator=(const Config &other) {
   name = other.name;
   verbosity = other.verbosity;
   channels = other.channels;
+  channel_rate_limits = other.channel_rate_limits;
   outputs = other.outputs;
-  console_sinks = other.console_sinks;
-  file_sinks = other.file_sinks;
+  sinks = other.sinks;
 
   // logging_initialized_ flag is always set to false(in copies) so it is deinitialized
   // only in orig. config object destructor and not also in new copied Config
@@ -70,10 +159,11 @@ Config::Config(Config &&other) noexcept
     : name(std::move(other.name)),
       verbosity(other.verbosity),
       channels(std::move(other.channels)),
+      channel_rate_limits(std::move(other.channel_rate_limits)),
       outputs(std::move(other.outputs)),
-      console_sinks(std::move(other.console_sinks)),
-      file_sinks(std::move(other.file_sinks)),
-      logging_initialized_(other.logging_initialized_) {
+      sinks(std::move(other.sinks)),
+      logging_initialized_(other.logging_initialized_),
+      max_verbosity_(other.max_verbosity_) {
   // logging_initialized_ flag in orig. object is always set to false(in moves) so it is not deinitialized
   // in destructor of the orig. config object
   other.logging_initialized_ = false;
@@ -83,10 +173,11 @@ Config &Config::operator=(Config &&other) noexcept {
   name = std::move(other.name);
   verbosity = other.verbosity;
   channels = std::move(other.channels);
+  channel_rate_limits = std::move(other.channel_rate_limits);
   outputs = std::move(other.outputs);
-  console_sinks = std::move(other.console_sinks);
-  file_sinks = std::move(other.file_sinks);
+  sinks = std::move(other.sinks);
   logging_initialized_ = other.logging_initialized_;
+  max_verbosity_ = other.max_verbosity_;
 
   // logging_initialized_ flag is always set to false(in copies) so it is deinitialized
   // only in orig. config object destructor and not also in new copied Config
@@ -120,40 +211,60 @@ void Config::InitLogging(addr_t const &node) {
     return false;
   };
 
+  // Each sink gets its own limiters so that a limited channel is cut equally in all outputs
+  using Limiters = std::map<std::string, std::unique_ptr<RateLimiter>>;
+  auto make_filter = [this, &filter]() {
+    auto limiters = std::make_shared<Limiters>();
+    for (const auto &[name, limit] : channel_rate_limits) {
+      limiters->emplace(name, std::make_unique<RateLimiter>(limit));
+    }
+    return [filter, limiters = std::shared_ptr<const Limiters>(std::move(limiters))](
+               boost::log::attribute_value_set const &_set) {
+      if (!filter(_set)) return false;
+      if (limiters->empty()) return true;
+      const auto limiter = limiters->find(_set[channel].get());
+      return limiter == limiters->end() || limiter->second->allow();
+    };
+  };
+
   for (auto &output : outputs) {
     if (output.type == "console") {
-      auto sink = boost::make_shared<log_sink<boost::log::sinks::text_ostream_backend>>();
+      auto backend = boost::make_shared<sinks::text_ostream_backend>();
       boost::shared_ptr<std::ostream> stream{&std::cout, boost::null_deleter{}};
-      sink->locked_backend()->add_stream(stream);
-      sink->set_filter(filter);
-
-      sink->set_formatter(boost::log::aux::acquire_formatter(output.format));
-      sink->locked_backend()->auto_flush(true);
-      boost::log::core::get()->add_sink(sink);
-      console_sinks.push_back(sink);
+      backend->add_stream(stream);
+      backend->auto_flush(true);
+      sinks.push_back(addSink(backend, output, make_filter()));
     } else if (output.type == "file") {
       std::vector<std::string> v;
       boost::algorithm::split(v, output.time_based_rotation, boost::is_any_of(","));
       if (v.size() != 3)
         throw ConfigException("time_based_rotation not configured correctly" + output.time_based_rotation);
-      auto sink = boost::log::add_file_log(
+      // Same backend setup as boost::log::add_file_log, which creates only synchronous sinks
+      auto backend = boost::make_shared<sinks::text_file_backend>(
           boost::log::keywords::file_name = output.file_name,
           boost::log::keywords::rotation_size = output.rotation_size,
           boost::log::keywords::time_based_rotation =
-              boost::log::sinks::file::rotation_at_time_point(stoi(v[0]), stoi(v[1]), stoi(v[2])),
-          boost::log::keywords::max_size = output.max_size, boost::log::keywords::target = output.target);
-      sink->set_filter(filter);
-
-      sink->set_formatter(boost::log::aux::acquire_formatter(output.format));
-      sink->locked_backend()->auto_flush(true);
-
-      boost::log::core::get()->add_sink(sink);
-      file_sinks.push_back(sink);
+              sinks::file::rotation_at_time_point(stoi(v[0]), stoi(v[1]), stoi(v[2])));
+      backend->set_file_collector(sinks::file::make_collector(boost::log::keywords::target = output.target,
+                                                              boost::log::keywords::max_size = output.max_size));
+      backend->scan_for_files();
+      backend->auto_flush(true);
+      sinks.push_back(addSink(backend, output, make_filter()));
     }
 
     boost::log::add_common_attributes();
   }
 
+  max_verbosity_ = verbosity;
+  for (const auto &[name, channel_verbosity] : channels) {
+    max_verbosity_ = std::max<int>(max_verbosity_, std::min<int>(channel_verbosity, Verbosity::Trace));
+  }
+  {
+    std::scoped_lock lock(enabled_verbosities_mutex);
+    enabled_verbosities.insert(max_verbosity_);
+    updateMaxEnabledVerbosity();
+  }
+
   boost::log::core::get()->set_exception_handler(boost::log::make_exception_handler<std::exception>(
       [](std::exception const &_ex) { std::cerr << "Exception from the logging library: " << _ex.what() << '\n'; }));
 
@@ -161,12 +272,20 @@ void Config::InitLogging(addr_t const &node) {
 }
 
 void Config::DeinitLogging() {
-  boost::log::core::get()->flush();
-  for (auto &sink : console_sinks) {
-    boost::log::core::get()->remove_sink(sink);
+  for (auto &sink : sinks) {
+    boost::log::core::get()->remove_sink(sink.sink);
+  }
+  for (auto &sink : sinks) {
+    sink.stop();
   }
-  for (auto &sink : file_sinks) {
-    boost::log::core::get()->remove_sink(sink);
+  sinks.clear();
+
+  {
+    std::scoped_lock lock(enabled_verbosities_mutex);
+    if (auto it = enabled_verbosities.find(max_verbosity_); it != enabled_verbosities.end()) {
+      enabled_verbosities.erase(it);
+    }
+    updateMaxEnabledVerbosity();
   }
 
   logging_initialized_ = false;
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "metrics/metrics_group.hpp"
+
+namespace taraxa::metrics {
+class DbMetrics : public MetricsGroup {
+ public:
+  inline static const std::string group_name = "db";
+  DbMetrics(std::shared_ptr<prometheus::Registry> registry) : MetricsGroup(std::move(registry)) {}
+
+  ADD_GAUGE_METRIC_WITH_UPDATER(setBlockCacheUsage, "block_cache_usage", "Memory used by block cache in bytes")
+  ADD_GAUGE_METRIC_WITH_UPDATER(setMemTablesUsage, "memtables_usage", "Memory used by memtables in bytes")
+  ADD_GAUGE_METRIC_WITH_UPDATER(setMemoryBudget, "memory_budget", "Configured memory budget in bytes, 0 = unlimited")
+  ADD_GAUGE_METRIC_WITH_UPDATER(setTrxLocationCacheHits, "trx_location_cache_hits",
+                                "Number of transaction locations served from memory")
+  ADD_GAUGE_METRIC_WITH_UPDATER(setTrxLocationCacheMisses, "trx_location_cache_misses",
+                                "Number of transaction locations read from db")
+};
+}  // namespace taraxa::metrics
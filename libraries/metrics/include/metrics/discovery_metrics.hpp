@@ -0,0 +1,16 @@
+#pragma once
+
+#include "metrics/metrics_group.hpp"
+
+namespace taraxa::metrics {
+class DiscoveryMetrics : public MetricsGroup {
+ public:
+  inline static const std::string group_name = "discovery";
+  DiscoveryMetrics(std::shared_ptr<prometheus::Registry> registry) : MetricsGroup(std::move(registry)) {}
+  ADD_GAUGE_METRIC_WITH_UPDATER(setNodesCount, "nodes_count", "Count of nodes in discovery table")
+  ADD_GAUGE_METRIC_WITH_UPDATER(setPacketsReceived, "packets_received", "Total count of received discovery packets")
+  ADD_GAUGE_METRIC_WITH_UPDATER(setPacketsRateLimited, "packets_rate_limited",
+                                "Total count of discovery packets dropped by per IP rate limit")
+  ADD_GAUGE_METRIC_WITH_UPDATER(setFindNodeAnswered, "find_node_answered", "Total count of answered FindNode requests")
+};
+}  // namespace taraxa::metrics
@@ -10,6 +10,21 @@ class JsonRpcMetrics : public MetricsGroup {
   const std::vector<double> buckets = {1000, 10000, 100000, 1000000, 10000000};
 
   ADD_HISTOGRAM_METRIC(setJsonRpcRequestDuration, "request_duration", "RPC request duration", buckets)
+  ADD_GAUGE_METRIC(setWsWriteQueueSize, "ws_write_queue_size", "Number of messages queued in websocket sessions")
+  ADD_GAUGE_METRIC(setWsDroppedMessages, "ws_dropped_messages",
+                   "Number of websocket messages dropped due to full session write queue")
+  ADD_GAUGE_METRIC_WITH_UPDATER(setResponseCacheHits, "response_cache_hits", "Number of responses served from cache")
+  ADD_GAUGE_METRIC_WITH_UPDATER(setResponseCacheMisses, "response_cache_misses",
+                                "Number of cacheable responses not found in cache")
+  ADD_GAUGE_METRIC_WITH_UPDATER(setResponseCacheSize, "response_cache_size", "Size of cached responses in bytes")
+  ADD_GAUGE_METRIC_WITH_UPDATER(setDispatchPending, "dispatch_pending",
+                                "Number of expensive requests waiting for dispatch thread")
+  ADD_GAUGE_METRIC_WITH_UPDATER(setDispatchRunning, "dispatch_running",
+                                "Number of expensive requests processed by dispatch threads")
+  ADD_GAUGE_METRIC_WITH_UPDATER(setDispatchRejected, "dispatch_rejected",
+                                "Number of expensive requests rejected due to dispatch limits")
+  ADD_HISTOGRAM_METRIC(setDispatchQueueTime, "dispatch_queue_time",
+                       "Time expensive request waited for dispatch thread in microseconds", buckets)
 
   // Extracting methods using string manipulation instead of JSON parsing for speed
   void report(const std::string &request, const std::string &ip, const std::string &connection,
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "metrics/metrics_group.hpp"
+
+namespace taraxa::metrics {
+class LockMetrics : public MetricsGroup {
+ public:
+  inline static const std::string group_name = "lock";
+  LockMetrics(std::shared_ptr<prometheus::Registry> registry) : MetricsGroup(std::move(registry)) {}
+  ADD_LABELED_GAUGE_METRIC(setAcquisitions, "acquisitions", "Number of acquisitions per named lock")
+  ADD_LABELED_GAUGE_METRIC(setContended, "contended", "Number of acquisitions that had to wait per named lock")
+  ADD_LABELED_GAUGE_METRIC(setWaitTotal, "wait_total_ms", "Total time spent waiting for the lock in milliseconds")
+  ADD_LABELED_GAUGE_METRIC(setWaitP50, "wait_p50_us", "Median time waiting for the lock in microseconds")
+  ADD_LABELED_GAUGE_METRIC(setWaitP99, "wait_p99_us", "99th percentile of time waiting for the lock in microseconds")
+  ADD_LABELED_GAUGE_METRIC(setHoldP50, "hold_p50_us", "Median time the lock was held exclusively in microseconds")
+  ADD_LABELED_GAUGE_METRIC(setHoldP99, "hold_p99_us",
+                           "99th percentile of time the lock was held exclusively in microseconds")
+
+  /**
+   * @brief Stats of single named lock
+   */
+  struct LockStats {
+    std::string name;
+    double acquisitions;
+    double contended;
+    double wait_total_ms;
+    double wait_p50_us;
+    double wait_p99_us;
+    double hold_p50_us;
+    double hold_p99_us;
+  };
+  using LocksStatsGetter = std::function<std::vector<LockStats>()>;
+
+  void setLocksStatsUpdater(LocksStatsGetter getter) {
+    updaters_.push_back([this, getter]() {
+      for (const auto& stats : getter()) {
+        setAcquisitions(stats.acquisitions, {{"lock", stats.name}});
+        setContended(stats.contended, {{"lock", stats.name}});
+        setWaitTotal(stats.wait_total_ms, {{"lock", stats.name}});
+        setWaitP50(stats.wait_p50_us, {{"lock", stats.name}});
+        setWaitP99(stats.wait_p99_us, {{"lock", stats.name}});
+        setHoldP50(stats.hold_p50_us, {{"lock", stats.name}});
+        setHoldP99(stats.hold_p99_us, {{"lock", stats.name}});
+      }
+    });
+  }
+};
+}  // namespace taraxa::metrics
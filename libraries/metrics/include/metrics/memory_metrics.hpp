@@ -0,0 +1,51 @@
+#pragma once
+
+#include <optional>
+
+#include "metrics/metrics_group.hpp"
+
+namespace taraxa::metrics {
+class MemoryMetrics : public MetricsGroup {
+ public:
+  inline static const std::string group_name = "memory";
+  MemoryMetrics(std::shared_ptr<prometheus::Registry> registry) : MetricsGroup(std::move(registry)) {}
+
+  ADD_LABELED_GAUGE_METRIC(setUsageBytes, "usage_bytes", "Approximate memory used by in-memory structure in bytes")
+  ADD_LABELED_GAUGE_METRIC(setAllocatorBytes, "allocator_bytes",
+                           "Allocator heap bytes per stat: allocated by application, in active pages and resident")
+  ADD_GAUGE_METRIC(setAllocatorFragmentation, "allocator_fragmentation",
+                   "Share of allocator active bytes that are not allocated by application")
+
+  using MemoryStatsGetter = std::function<std::map<std::string, uint64_t>()>;
+
+  void setMemoryStatsUpdater(MemoryStatsGetter getter) {
+    updaters_.push_back([this, getter]() {
+      for (const auto& [structure, bytes] : getter()) {
+        setUsageBytes(static_cast<double>(bytes), {{"structure", structure}});
+      }
+    });
+  }
+
+  /**
+   * @brief Allocator heap stats
+   */
+  struct AllocatorStats {
+    double allocated;
+    double active;
+    double resident;
+    double fragmentation;
+  };
+  using AllocatorStatsGetter = std::function<std::optional<AllocatorStats>()>;
+
+  void setAllocatorStatsUpdater(AllocatorStatsGetter getter) {
+    updaters_.push_back([this, getter]() {
+      if (const auto stats = getter()) {
+        setAllocatorBytes(stats->allocated, {{"stat", "allocated"}});
+        setAllocatorBytes(stats->active, {{"stat", "active"}});
+        setAllocatorBytes(stats->resident, {{"stat", "resident"}});
+        setAllocatorFragmentation(stats->fragmentation);
+      }
+    });
+  }
+};
+}  // namespace taraxa::metrics
@@ -15,18 +15,28 @@ namespace taraxa::metrics {
     label.Set(v);                                                                                    \
   }
 
+/**
+ * @brief add method that is setting specific gauge metric with labels.
+ */
+#define ADD_LABELED_GAUGE_METRIC(method, name, description)                                   \
+  void method(double v, const std::map<std::string, std::string>& labels) {                   \
+    static auto& family = addMetric<prometheus::Gauge>(group_name + "_" + name, description); \
+    family.Add(labels).Set(v);                                                                \
+  }
+
 /**
  * @brief add method that is setting specific histogram metric.
  */
-#define ADD_HISTOGRAM_METRIC(method, name, description, buckets)                                           \
-  void method(double v, std::map<std::string, std::string> labels) {                                       \
-    static auto& label = addMetric<prometheus::Histogram>(group_name + "_" + name, description);           \
-    label.Add(labels, prometheus::Histogram::BucketBoundaries{buckets.begin(), buckets.end()}).Observe(v); \
+#define ADD_HISTOGRAM_METRIC(method, name, description, buckets)                                     \
+  void method(double v, const std::map<std::string, std::string>& labels) {                          \
+    static auto& family = addMetric<prometheus::Histogram>(group_name + "_" + name, description);    \
+    static const prometheus::Histogram::BucketBoundaries boundaries{buckets.begin(), buckets.end()}; \
+    family.Add(labels, boundaries).Observe(v);                                                       \
   }
 
 /**
  * @brief add updater method.
- * This is used to store lambda function that updates metric, so we can update it periodically
+ * This is used to store lambda function that updates metric, so we can update it when metrics are scraped
  * Passed `method` should be added first
  */
 #define ADD_UPDATER_METHOD(method)                               \
@@ -61,7 +71,7 @@ class MetricsGroup {
     return prometheus::detail::Builder<Type>().Name(name).Help(help).Register(*registry_);
   }
   /**
-   * @brief method that is used to call registered updaters for the specific class
+   * @brief method that is used to call registered updaters for the specific class, called on every scrape
    */
   void updateData() {
     for (auto& update : updaters_) {
@@ -1,10 +1,11 @@
 #pragma once
 
+#include <prometheus/collectable.h>
 #include <prometheus/exposer.h>
 #include <prometheus/gauge.h>
 #include <prometheus/registry.h>
 
-#include <thread>
+#include <mutex>
 
 #include "metrics/metrics_group.hpp"
 
@@ -12,14 +13,15 @@ namespace taraxa::metrics {
 
 /**
  * @brief class for metrics collecting. Registering specific metrics classes and creating prometheus server(exposer)
+ *
+ * Metrics are not polled, updaters of all metrics groups are evaluated when prometheus scrapes the exposer
  */
 class MetricsService {
  public:
-  MetricsService(const std::string& host, uint16_t port, uint16_t polling_interval_ms);
-  ~MetricsService();
+  MetricsService(const std::string& host, uint16_t port);
 
   /**
-   * @brief method to start thread that collecting data from special classes
+   * @brief method to start exposing metrics, must be called after all updaters are registered
    */
   void start();
 
@@ -34,19 +36,31 @@ class MetricsService {
     if (!exposer_) {
       return nullptr;
     }
-    auto metrics = metrics_.find(T::group_name);
-    if (metrics == metrics_.end()) {
-      auto emplace_result = metrics_.emplace(T::group_name, std::make_shared<T>(registry_)).first;
-      metrics = emplace_result;
+    std::scoped_lock lock(collectable_->mutex);
+    auto& groups = collectable_->groups;
+    auto metrics = groups.find(T::group_name);
+    if (metrics == groups.end()) {
+      metrics = groups.emplace(T::group_name, std::make_shared<T>(collectable_->registry)).first;
     }
     return dynamic_pointer_cast<T>(metrics->second);
   }
 
  private:
-  const uint16_t kPollingIntervalMs = 0;
+  /**
+   * @brief Collectable registered in exposer that updates metrics groups right before their registry is collected
+   */
+  struct UpdatingCollectable : prometheus::Collectable {
+    explicit UpdatingCollectable(std::shared_ptr<prometheus::Registry> registry) : registry(std::move(registry)) {}
+    std::vector<prometheus::MetricFamily> Collect() const override;
+
+    const std::shared_ptr<prometheus::Registry> registry;
+    // Guards groups, concurrent scrapes run updaters one by one
+    mutable std::mutex mutex;
+    std::map<std::string, SharedMetricsGroup> groups;
+  };
+
+  std::shared_ptr<UpdatingCollectable> collectable_;
+  // Declared last, so it stops serving scrapes before collectable is destroyed
   std::unique_ptr<prometheus::Exposer> exposer_;
-  std::shared_ptr<prometheus::Registry> registry_;
-  std::map<std::string, SharedMetricsGroup> metrics_;
-  std::unique_ptr<std::thread> thread_;
 };
-}  // namespace taraxa::metrics
\ No newline at end of file
+}  // namespace taraxa::metrics
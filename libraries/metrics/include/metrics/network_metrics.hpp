@@ -10,5 +10,33 @@ class NetworkMetrics : public MetricsGroup {
   ADD_GAUGE_METRIC_WITH_UPDATER(setPeersCount, "peers_count", "Count of peers that node is connected to")
   ADD_GAUGE_METRIC_WITH_UPDATER(setDiscoveredPeersCount, "discovered_peers_count", "Count of discovered peers")
   ADD_GAUGE_METRIC_WITH_UPDATER(setSyncingDuration, "syncing_duration_sec", "Time node is currently in sync state")
+  ADD_GAUGE_METRIC_WITH_UPDATER(setSyncUploadBytes, "sync_upload_bytes", "Total bytes of sync packets sent to peers")
+  ADD_GAUGE_METRIC_WITH_UPDATER(setSyncUploadThrottledPackets, "sync_upload_throttled_packets",
+                                "Count of sync packets delayed by the upload budget")
+  ADD_GAUGE_METRIC_WITH_UPDATER(setSyncUploadThrottleDuration, "sync_upload_throttle_duration_ms",
+                                "Total time sync packets were delayed by the upload budget")
+  ADD_LABELED_GAUGE_METRIC(setPacketCompressionRatio, "packet_compression_ratio",
+                           "Compressed to original size ratio of sent packets per packet type")
+  ADD_LABELED_GAUGE_METRIC(setPacketCompressionTime, "packet_compression_time_us",
+                           "Total time spent compressing sent packets per packet type")
+
+  /**
+   * @brief Compression stats of single packet type
+   */
+  struct PacketCompression {
+    std::string packet_type;
+    double ratio;
+    double time_us;
+  };
+  using PacketsCompressionGetter = std::function<std::vector<PacketCompression>()>;
+
+  void setPacketsCompressionUpdater(PacketsCompressionGetter getter) {
+    updaters_.push_back([this, getter]() {
+      for (const auto& packet : getter()) {
+        setPacketCompressionRatio(packet.ratio, {{"packet_type", packet.packet_type}});
+        setPacketCompressionTime(packet.time_us, {{"packet_type", packet.packet_type}});
+      }
+    });
+  }
 };
 }  // namespace taraxa::metrics
\ No newline at end of file
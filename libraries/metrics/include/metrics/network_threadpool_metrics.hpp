@@ -0,0 +1,49 @@
+#pragma once
+
+#include "metrics/metrics_group.hpp"
+
+namespace taraxa::metrics {
+class NetworkThreadpoolMetrics : public MetricsGroup {
+ public:
+  inline static const std::string group_name = "network_threadpool";
+  NetworkThreadpoolMetrics(std::shared_ptr<prometheus::Registry> registry) : MetricsGroup(std::move(registry)) {}
+  const std::vector<double> buckets = {10, 100, 1000, 10000, 100000, 1000000, 10000000};
+
+  ADD_HISTOGRAM_METRIC(setPacketQueueTime, "packet_queue_time_us",
+                       "Time packet waited in the queue before processing in microseconds per packet type", buckets)
+  ADD_HISTOGRAM_METRIC(setPacketProcessingTime, "packet_processing_time_us",
+                       "Time packet was processed by its handler in microseconds per packet type", buckets)
+  ADD_LABELED_GAUGE_METRIC(setQueueDepth, "queue_depth", "Number of packets waiting for processing per priority queue")
+  ADD_LABELED_GAUGE_METRIC(setBlockedPackets, "blocked_packets",
+                           "Number of packets blocked by processing dependencies per priority queue")
+  ADD_LABELED_GAUGE_METRIC(setWorkersLimit, "workers_limit",
+                           "Max number of workers processing packets at the same time per priority queue")
+  ADD_GAUGE_METRIC_WITH_UPDATER(setActiveWorkers, "active_workers",
+                                "Number of workers that can process packets at the same time, changes when scaled")
+  ADD_GAUGE_METRIC_WITH_UPDATER(setBorrowedThreads, "borrowed_threads",
+                                "Number of packets processed by threads borrowed from other priority queues")
+  ADD_GAUGE_METRIC_WITH_UPDATER(setDroppedStalePackets, "dropped_stale_packets",
+                                "Number of votes dropped before processing as they were for already passed rounds")
+
+  /**
+   * @brief Stats of single priority queue
+   */
+  struct QueueStats {
+    std::string priority;
+    double depth;
+    double blocked;
+    double workers_limit;
+  };
+  using QueuesStatsGetter = std::function<std::vector<QueueStats>()>;
+
+  void setQueuesStatsUpdater(QueuesStatsGetter getter) {
+    updaters_.push_back([this, getter]() {
+      for (const auto& queue : getter()) {
+        setQueueDepth(queue.depth, {{"priority", queue.priority}});
+        setBlockedPackets(queue.blocked, {{"priority", queue.priority}});
+        setWorkersLimit(queue.workers_limit, {{"priority", queue.priority}});
+      }
+    });
+  }
+};
+}  // namespace taraxa::metrics
@@ -7,6 +7,8 @@ class PbftMetrics : public MetricsGroup {
  public:
   inline static const std::string group_name = "pbft";
   PbftMetrics(std::shared_ptr<prometheus::Registry> registry) : MetricsGroup(std::move(registry)) {}
+  // Milliseconds, from single EVM executions up to steps with exponentially backed off lambda
+  const std::vector<double> buckets = {1, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 30000, 60000};
 
   ADD_GAUGE_METRIC_WITH_UPDATER(setPeriod, "period", "Current PBFT period")
   ADD_GAUGE_METRIC_WITH_UPDATER(setRound, "round", "Current PBFT round")
@@ -16,6 +18,10 @@ class PbftMetrics : public MetricsGroup {
   ADD_GAUGE_METRIC(setBlockNumber, "block_number", "Number of the most recent block")
   ADD_GAUGE_METRIC(setBlockTransactionsCount, "block_transactions_count", "Number of transactions in block")
   ADD_GAUGE_METRIC(setBlockTimestamp, "block_timestamp", "Number of transactions in block")
+
+  ADD_HISTOGRAM_METRIC(setStageDuration, "stage_duration",
+                       "Duration of PBFT steps, rounds, vote arrivals and block finalization stages in milliseconds",
+                       buckets)
 };
 
 }  // namespace taraxa::metrics
\ No newline at end of file
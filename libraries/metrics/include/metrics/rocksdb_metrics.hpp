@@ -0,0 +1,63 @@
+#pragma once
+
+#include "metrics/metrics_group.hpp"
+
+namespace taraxa::metrics {
+class RocksDbMetrics : public MetricsGroup {
+ public:
+  inline static const std::string group_name = "rocksdb";
+  RocksDbMetrics(std::shared_ptr<prometheus::Registry> registry) : MetricsGroup(std::move(registry)) {}
+
+  ADD_LABELED_GAUGE_METRIC(setEstimateNumKeys, "estimate_num_keys", "Estimated number of keys per column")
+  ADD_LABELED_GAUGE_METRIC(setMemTablesSize, "memtables_size", "Size of active and unflushed memtables per column")
+  ADD_LABELED_GAUGE_METRIC(setPendingCompactionBytes, "pending_compaction_bytes",
+                           "Estimated bytes compaction needs to rewrite per column")
+  ADD_LABELED_GAUGE_METRIC(setSstFilesSize, "sst_files_size", "Size of all sst files per column")
+  ADD_LABELED_GAUGE_METRIC(setTicker, "ticker", "Cumulative rocksdb statistics ticker")
+  ADD_LABELED_GAUGE_METRIC(setWriteAmplification, "write_amplification",
+                           "Bytes written by flushes and compactions per byte written by the node")
+  ADD_LABELED_GAUGE_METRIC(setDiskSize, "disk_size", "Size of database directory in bytes")
+
+  /**
+   * @brief Properties of single column family
+   */
+  struct ColumnStats {
+    std::string name;
+    double estimate_num_keys;
+    double memtables_size;
+    double pending_compaction_bytes;
+    double sst_files_size;
+  };
+
+  /**
+   * @brief Column properties and statistics tickers of single database
+   */
+  struct DbStats {
+    std::vector<ColumnStats> columns;
+    std::vector<std::pair<std::string, double>> tickers;
+    double write_amplification = 0;
+  };
+  using DbStatsGetter = std::function<DbStats()>;
+
+  void setDbStatsUpdater(const std::string& db, DbStatsGetter getter) {
+    updaters_.push_back([this, db, getter]() {
+      const auto stats = getter();
+      for (const auto& column : stats.columns) {
+        const std::map<std::string, std::string> labels{{"db", db}, {"column", column.name}};
+        setEstimateNumKeys(column.estimate_num_keys, labels);
+        setMemTablesSize(column.memtables_size, labels);
+        setPendingCompactionBytes(column.pending_compaction_bytes, labels);
+        setSstFilesSize(column.sst_files_size, labels);
+      }
+      for (const auto& [ticker, value] : stats.tickers) {
+        setTicker(value, {{"db", db}, {"ticker", ticker}});
+      }
+      setWriteAmplification(stats.write_amplification, {{"db", db}});
+    });
+  }
+
+  void setDiskSizeUpdater(const std::string& db, MetricGetter getter) {
+    updaters_.push_back([this, db, getter]() { setDiskSize(getter(), {{"db", db}}); });
+  }
+};
+}  // namespace taraxa::metrics
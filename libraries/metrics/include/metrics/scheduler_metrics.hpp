@@ -0,0 +1,40 @@
+#pragma once
+
+#include "metrics/metrics_group.hpp"
+
+namespace taraxa::metrics {
+class SchedulerMetrics : public MetricsGroup {
+ public:
+  inline static const std::string group_name = "scheduler";
+  SchedulerMetrics(std::shared_ptr<prometheus::Registry> registry) : MetricsGroup(std::move(registry)) {}
+  ADD_LABELED_GAUGE_METRIC(setQueuedTasks, "queued_tasks", "Number of tasks waiting for a worker per task class")
+  ADD_LABELED_GAUGE_METRIC(setRunningTasks, "running_tasks", "Number of running tasks per task class")
+  ADD_LABELED_GAUGE_METRIC(setQueueLatencyP50, "queue_latency_p50_us",
+                           "Median time recent tasks waited for a worker in microseconds per task class")
+  ADD_LABELED_GAUGE_METRIC(setQueueLatencyP99, "queue_latency_p99_us",
+                           "99th percentile of time recent tasks waited for a worker in microseconds per task class")
+
+  /**
+   * @brief Stats of single task class
+   */
+  struct ClassStats {
+    std::string task_class;
+    double queued;
+    double running;
+    double queue_latency_p50_us;
+    double queue_latency_p99_us;
+  };
+  using ClassesStatsGetter = std::function<std::vector<ClassStats>()>;
+
+  void setClassesStatsUpdater(ClassesStatsGetter getter) {
+    updaters_.push_back([this, getter]() {
+      for (const auto& stats : getter()) {
+        setQueuedTasks(stats.queued, {{"class", stats.task_class}});
+        setRunningTasks(stats.running, {{"class", stats.task_class}});
+        setQueueLatencyP50(stats.queue_latency_p50_us, {{"class", stats.task_class}});
+        setQueueLatencyP99(stats.queue_latency_p99_us, {{"class", stats.task_class}});
+      }
+    });
+  }
+};
+}  // namespace taraxa::metrics
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "metrics/metrics_group.hpp"
+
+namespace taraxa::metrics {
+class StartupMetrics : public MetricsGroup {
+ public:
+  inline static const std::string group_name = "startup";
+  StartupMetrics(std::shared_ptr<prometheus::Registry> registry) : MetricsGroup(std::move(registry)) {}
+
+  ADD_LABELED_GAUGE_METRIC(setInitTaskDuration, "init_task_duration_ms",
+                           "Wall time of node initialization task in milliseconds")
+};
+}  // namespace taraxa::metrics
@@ -29,15 +29,25 @@ class Light : public Plugin {
   void clearNonBlockData(PbftPeriod start, PbftPeriod end, bool live_cleanup);
   void recreateNonBlockData(PbftPeriod last_block_number);
   void pruneStateDb();
+  // Deletes headers of pruned blocks in slices, limited to prune_rate_ headers per second
+  void pruneBlockHeaders();
 
   uint64_t getCleanupPeriod(uint64_t dag_period, std::optional<uint64_t> proposal_period) const;
 
   static constexpr uint64_t kPeriodsToKeepNonBlockData = 1000;
+  static constexpr uint32_t kDefaultPruneRate = 10000;
+  static constexpr size_t kPruneSliceMaxBlocks = 1000;
+  static constexpr uint32_t kDefaultHistoryCacheSize = 256;
   std::shared_ptr<util::ThreadPool> cleanup_pool_ = std::make_shared<util::ThreadPool>(1);
+  std::shared_ptr<util::ThreadPool> prune_pool_ = std::make_shared<util::ThreadPool>(1);
   uint64_t& history_;
   bool state_db_pruning_;
+  uint32_t prune_rate_ = kDefaultPruneRate;
+  std::atomic<bool> stopped_ = false;
   bool live_cleanup_;
   std::atomic<bool> live_cleanup_in_progress_ = false;
+  bool history_fetch_ = true;
+  uint32_t history_cache_size_ = kDefaultHistoryCacheSize;
 
   LOG_OBJECTS_DEFINE
 };
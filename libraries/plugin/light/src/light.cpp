@@ -1,8 +1,12 @@
 #include "plugin/light.hpp"
 
+#include <thread>
+
 #include "common/config_exception.hpp"
 #include "config/config.hpp"
 #include "dag/dag_manager.hpp"
+#include "final_chain/final_chain.hpp"
+#include "network/network.hpp"
 
 namespace taraxa::plugin {
 
@@ -10,6 +14,9 @@ namespace bpo = boost::program_options;
 constexpr auto HISTORY = "light.history";
 constexpr auto NO_STATE_DB_PRUNING = "light.no_state_db_pruning";
 constexpr auto NO_LIVE_CLEANUP = "light.no_live_cleanup";
+constexpr auto PRUNE_RATE = "light.prune_rate";
+constexpr auto NO_HISTORY_FETCH = "light.no_history_fetch";
+constexpr auto HISTORY_CACHE_SIZE = "light.history_cache_size";
 
 Light::Light(std::shared_ptr<AppBase> app_) : Plugin(app_), history_(app()->getMutableConfig().light_node_history) {}
 
@@ -17,6 +24,9 @@ void Light::init(const boost::program_options::variables_map &opts) {
   auto node_addr = app()->getAddress();
   LOG_OBJECTS_CREATE("light");
   const auto &conf = app()->getConfig();
+  if (conf.db_config.isReplica()) {
+    throw ConfigException("Light node prunes db and can't be enabled on a read-only replica");
+  }
 
   const auto &cacti_hf = conf.genesis.state.hardforks.cacti_hf;
   // Since cacti hf introduced dynamic lambda, the number of blocks node has to keep is changins as dynamic lambda
@@ -33,8 +43,16 @@ void Light::init(const boost::program_options::variables_map &opts) {
     history_ = min_light_node_history_;
   }
   state_db_pruning_ = !opts[NO_STATE_DB_PRUNING].as<bool>();
+  if (!opts[PRUNE_RATE].empty()) {
+    prune_rate_ = opts[PRUNE_RATE].as<uint32_t>();
+    if (prune_rate_ == 0) {
+      throw ConfigException("Light node prune rate must be bigger than 0");
+    }
+  }
 
   live_cleanup_ = !opts[NO_LIVE_CLEANUP].as<bool>();
+  history_fetch_ = !opts[NO_HISTORY_FETCH].as<bool>();
+  history_cache_size_ = opts[HISTORY_CACHE_SIZE].as<uint32_t>();
 
   app()->getMutableConfig().is_light_node = true;
 }
@@ -43,12 +61,29 @@ void Light::addOptions(boost::program_options::options_description &opts) {
   opts.add_options()(HISTORY, bpo::value<uint32_t>(), "Number of blocks to keep in light node history");
   opts.add_options()(NO_STATE_DB_PRUNING, bpo::bool_switch()->default_value(false), "Prune state_db");
   opts.add_options()(NO_LIVE_CLEANUP, bpo::bool_switch()->default_value(false), "Disable live cleanup");
+  opts.add_options()(PRUNE_RATE, bpo::value<uint32_t>()->default_value(kDefaultPruneRate),
+                     "Max number of pruned blocks headers deleted per second by background state db pruning");
+  opts.add_options()(NO_HISTORY_FETCH, bpo::bool_switch()->default_value(false),
+                     "Do not fetch pruned blocks and receipts requested by rpc from peers");
+  opts.add_options()(HISTORY_CACHE_SIZE, bpo::value<uint32_t>()->default_value(kDefaultHistoryCacheSize),
+                     "Number of blocks fetched from peers that are kept in memory");
 }
 
 void Light::start() {
   clearLightNodeHistory();
+  if (history_fetch_) {
+    // Network owns final chain indirectly, weak pointer avoids the reference cycle
+    std::weak_ptr<Network> network = app()->getNetwork();
+    app()->getFinalChain()->setHistoricalBlockFetcher(
+        [network](EthBlockNumber blk_n, const std::function<bool(const final_chain::HistoricalBlock &)> &verify) {
+          auto net = network.lock();
+          return net && net->fetchHistoricalBlock(blk_n, verify);
+        },
+        history_cache_size_);
+  }
   if (state_db_pruning_) {
-    pruneStateDb();
+    // Pruning takes minutes on big state db, do not hold node startup for it
+    prune_pool_->post(0, [this]() { pruneStateDb(); });
   }
   app()->getFinalChain()->block_finalized_.subscribe(
       [this](std::shared_ptr<final_chain::FinalizationResult>) {
@@ -64,7 +99,11 @@ void Light::start() {
       cleanup_pool_);
 }
 
-void Light::shutdown() { cleanup_pool_->stop(); }
+void Light::shutdown() {
+  stopped_ = true;
+  prune_pool_->stop();
+  cleanup_pool_->stop();
+}
 
 uint64_t Light::getCleanupPeriod(uint64_t dag_period, std::optional<uint64_t> proposal_period) const {
   return std::min(dag_period - history_, *proposal_period);
@@ -111,20 +150,21 @@ void Light::clearNonBlockData(PbftPeriod start, PbftPeriod end, bool live_cleanu
     return;
   }
 
+  // Only hashes are needed, so they are taken from raw period data without decoding blocks and transactions
   auto batch = db->createWriteBatch();
   for (PbftPeriod period = start; period < end; period++) {
-    auto period_data = db->getPeriodData(period);
-    if (!period_data.has_value()) {
+    const auto period_data = db->getPeriodDataView(period);
+    if (period_data.empty()) {
       break;
     }
-    for (auto t : period_data->transactions) {
-      db->remove(batch, DbStorage::Columns::trx_period, t->getHash());
-      db->remove(batch, DbStorage::Columns::final_chain_receipt_by_trx_hash, t->getHash());
+    for (const auto &trx_hash : period_data.transactionsHashes()) {
+      db->remove(batch, DbStorage::Columns::trx_period, trx_hash);
+      db->remove(batch, DbStorage::Columns::final_chain_receipt_by_trx_hash, trx_hash);
     }
-    for (auto d : period_data->dag_blocks) {
-      db->remove(batch, DbStorage::Columns::dag_block_period, d->getHash());
+    for (const auto &dag_block_hash : period_data.dagBlocksHashes()) {
+      db->remove(batch, DbStorage::Columns::dag_block_period, dag_block_hash);
     }
-    db->remove(batch, DbStorage::Columns::pbft_block_period, period_data->pbft_blk->getBlockHash());
+    db->remove(batch, DbStorage::Columns::pbft_block_period, period_data.pbftBlockHash());
   }
   db->commitWriteBatch(batch);
 }
@@ -136,17 +176,15 @@ void Light::recreateNonBlockData(PbftPeriod last_block_number) {
   std::unordered_set<blk_hash_t> pbft_blocks;
 
   for (uint64_t period = last_block_number - kPeriodsToKeepNonBlockData;; period++) {
-    auto period_data = db->getPeriodData(period);
-    if (!period_data.has_value()) {
+    const auto period_data = db->getPeriodDataView(period);
+    if (period_data.empty()) {
       break;
     }
-    for (auto t : period_data->transactions) {
-      trxs.insert(t->getHash());
-    }
-    for (auto d : period_data->dag_blocks) {
-      dag_blocks.insert(d->getHash());
-    }
-    pbft_blocks.insert(period_data->pbft_blk->getBlockHash());
+    const auto trx_hashes = period_data.transactionsHashes();
+    trxs.insert(trx_hashes.begin(), trx_hashes.end());
+    const auto dag_block_hashes = period_data.dagBlocksHashes();
+    dag_blocks.insert(dag_block_hashes.begin(), dag_block_hashes.end());
+    pbft_blocks.insert(period_data.pbftBlockHash());
   }
 
   db->clearColumnHistory(trxs, DbStorage::Columns::trx_period);
@@ -171,14 +209,11 @@ void Light::clearHistory(PbftPeriod end_period, uint64_t dag_level_to_keep, bool
   }
   clearNonBlockData(start_period, end_period, live_cleanup);
 
-  db->DeleteRange(DbStorage::Columns::period_data, start_period, end_period);
-  db->DeleteRange(DbStorage::Columns::pillar_block, start_period, end_period);
-  db->DeleteRange(DbStorage::Columns::final_chain_receipt_by_period, start_period, end_period);
-  db->DeleteRange(DbStorage::Columns::period_lambda, start_period, end_period);
-  db->CompactRange(DbStorage::Columns::period_data, start_period, end_period);
-  db->CompactRange(DbStorage::Columns::pillar_block, start_period, end_period);
-  db->CompactRange(DbStorage::Columns::final_chain_receipt_by_period, start_period, end_period);
-  db->CompactRange(DbStorage::Columns::period_data, start_period, end_period);
+  db->pruneRange(DbStorage::Columns::period_data, start_period, end_period);
+  db->pruneRange(DbStorage::Columns::period_trx_senders, start_period, end_period);
+  db->pruneRange(DbStorage::Columns::pillar_block, start_period, end_period);
+  db->pruneRange(DbStorage::Columns::final_chain_receipt_by_period, start_period, end_period);
+  db->pruneRange(DbStorage::Columns::period_lambda, start_period, end_period);
 
   it = db->getColumnIterator(DbStorage::Columns::dag_blocks_level);
   it->SeekToFirst();
@@ -194,25 +229,49 @@ void Light::clearHistory(PbftPeriod end_period, uint64_t dag_level_to_keep, bool
     return;
   }
 
-  db->DeleteRange(DbStorage::Columns::dag_blocks_level, start_level, dag_level_end);
-  db->CompactRange(DbStorage::Columns::dag_blocks_level, start_level, dag_level_end);
+  db->pruneRange(DbStorage::Columns::dag_blocks_level, start_level, dag_level_end);
 }
 
 void Light::pruneStateDb() {
   const auto kPruneBlocksToKeep = kDagExpiryLevelLimit + kMaxLevelsPerPeriod + 1;
   // prune state db only if we have more than 2*kPruneBlocksToKeep blocks
   const uint64_t kPruneStateDbThreshold = 1.5 * kPruneBlocksToKeep;
-  auto last_blk_num = app()->getFinalChain()->lastBlockNumber();
+  const auto final_chain = app()->getFinalChain();
+  auto last_blk_num = final_chain->lastBlockNumber();
   if (last_blk_num > kPruneStateDbThreshold) {
     auto prune_block_num = last_blk_num - kPruneStateDbThreshold;
-    auto prune_block = app()->getFinalChain()->blockHeader(prune_block_num);
-    if (!prune_block) {
+    const auto pruned_state_block = final_chain->prunedStateBlock();
+    if (!final_chain->blockHeader(prune_block_num) || (pruned_state_block && *pruned_state_block >= prune_block_num)) {
       LOG(log_nf_) << "Prune was done recently, skip state db pruning";
-      return;
+    } else {
+      LOG(log_nf_) << "Pruning state db " << prune_block_num << " in background, this might take several minutes";
+      final_chain->pruneStateDb(prune_block_num);
+      LOG(log_nf_) << "Pruning state db complete";
     }
-    LOG(log_nf_) << "Pruning state db " << prune_block_num << ", this might take several minutes";
-    app()->getFinalChain()->prune(prune_block_num);
-    LOG(log_nf_) << "Pruning state db complete";
+  }
+  pruneBlockHeaders();
+}
+
+void Light::pruneBlockHeaders() {
+  const auto final_chain = app()->getFinalChain();
+  // Low priority writes are throttled by rocksdb when they would stall foreground writes
+  rocksdb::WriteOptions write_opts;
+  write_opts.low_pri = true;
+
+  const auto slice_size = std::min<size_t>(prune_rate_, kPruneSliceMaxBlocks);
+  const std::chrono::microseconds slice_budget(1'000'000 * slice_size / prune_rate_);
+  size_t pruned = 0;
+  while (!stopped_) {
+    const auto slice_start = std::chrono::steady_clock::now();
+    const auto slice_pruned = final_chain->pruneBlockHeaders(slice_size, write_opts);
+    if (!slice_pruned) {
+      break;
+    }
+    pruned += slice_pruned;
+    std::this_thread::sleep_until(slice_start + slice_budget);
+  }
+  if (pruned) {
+    LOG(log_nf_) << "Pruned " << pruned << " blocks headers";
   }
 }
 
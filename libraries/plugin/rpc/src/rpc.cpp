@@ -56,10 +56,34 @@ void Rpc::start() {
     eth_rpc_params.chain_id = conf.genesis.chain_id;
     eth_rpc_params.gas_limit = conf.genesis.dag.gas_limit;
     eth_rpc_params.final_chain = app()->getFinalChain();
+    eth_rpc_params.logs_query_threads = conf.network.rpc->logs_query_threads_num;
+    eth_rpc_params.estimate_gas_threads = conf.network.rpc->estimate_gas_threads_num;
+    eth_rpc_params.logs_query_limits = {.max_block_range = conf.network.rpc->logs_max_block_range,
+                                        .max_results = conf.network.rpc->logs_max_results};
     eth_rpc_params.gas_pricer = [gas_pricer = app()->getGasPricer()]() { return gas_pricer->bid(); };
     eth_rpc_params.get_earliest_block = [db = app()->getDB()]() { return db->getEarliestBlockNumber(); };
     eth_rpc_params.get_trx = [db = app()->getDB()](auto const &trx_hash) { return db->getTransaction(trx_hash); };
-    eth_rpc_params.send_trx = [trx_manager = app()->getTransactionManager()](auto const &trx) {
+    eth_rpc_params.get_pending_nonce = [trx_manager = app()->getTransactionManager()](const auto &sender) {
+      return trx_manager->getPendingNonce(sender);
+    };
+    eth_rpc_params.send_trx = [trx_manager = app()->getTransactionManager(), net_weak = as_weak(app()->getNetwork()),
+                               gas_pricer = app()->getGasPricer(),
+                               replica = conf.db_config.isReplica()](auto const &trx) {
+      if (replica) {
+        BOOST_THROW_EXCEPTION(std::runtime_error("Transactions can't be submitted to a read-only replica"));
+      }
+      // Under high load only transactions paying at least the current gas price bid are admitted
+      if (auto net = net_weak.lock()) {
+        const auto load = net->loadLevel();
+        if (load == network::tarcap::LoadLevel::kCritical) {
+          BOOST_THROW_EXCEPTION(std::runtime_error("Node is overloaded, transaction is not accepted, retry later"));
+        }
+        if (load == network::tarcap::LoadLevel::kHigh && trx->getGasPrice() < gas_pricer->bid()) {
+          BOOST_THROW_EXCEPTION(
+              std::runtime_error("Node is under high load, only transactions with gas price of at least " +
+                                 dev::toJS(gas_pricer->bid()) + " are accepted"));
+        }
+      }
       if (auto [ok, err_msg] = trx_manager->insertTransaction(trx); !ok) {
         BOOST_THROW_EXCEPTION(
             std::runtime_error(fmt("Transaction is rejected.\n"
@@ -71,7 +95,8 @@ void Rpc::start() {
     eth_rpc_params.syncing_probe = [network = app()->getNetwork(), pbft_chain = app()->getPbftChain(),
                                     pbft_mgr = app()->getPbftManager()] {
       std::optional<net::rpc::eth::SyncStatus> ret;
-      if (!network->pbft_syncing()) {
+      // Replica has no network and follows the primary node instead of syncing
+      if (!network || !network->pbft_syncing()) {
         return ret;
       }
       auto &status = ret.emplace();
@@ -83,6 +108,10 @@ void Rpc::start() {
     };
 
     auto eth_json_rpc = net::rpc::eth::NewEth(std::move(eth_rpc_params));
+    // Test and Debug interfaces need consensus components that are not created for a replica
+    if (conf.db_config.isReplica() && (enable_test_rpc_ || enable_debug_)) {
+      throw std::runtime_error("Test and Debug RPC are not available on a read-only replica");
+    }
     std::shared_ptr<net::Test> test_json_rpc;
     if (enable_test_rpc_) {
       //  TODO Because this object refers to App, the lifecycle/dependency management is more complicated);
@@ -92,30 +121,66 @@ void Rpc::start() {
     std::shared_ptr<net::Debug> debug_json_rpc;
     if (enable_debug_) {
       // TODO Because this object refers to App, the lifecycle/dependency management is more complicated);
-      debug_json_rpc = std::make_shared<net::Debug>(app(), conf.genesis.dag.gas_limit);
+      const net::TraceExecutorConfig trace_config{.threads = conf.network.rpc->trace_threads_num,
+                                                  .timeout_ms = conf.network.rpc->trace_timeout_ms,
+                                                  .gas_budget = conf.network.rpc->trace_gas_budget};
+      debug_json_rpc = std::make_shared<net::Debug>(app(), conf.genesis.dag.gas_limit, trace_config);
     }
 
+    // TODO Because this object refers to App, the lifecycle/dependency management is more complicated
+    auto taraxa_json_rpc = std::make_shared<net::Taraxa>(app());
     jsonrpc_api_ = std::make_unique<JsonRpcServer>(
-        std::make_shared<net::Taraxa>(app()),  // TODO Because this object refers to App, the
-                                               // lifecycle/dependency management is more complicated
-        std::make_shared<net::Net>(app()),     // TODO Because this object refers to App, the
-                                               // lifecycle/dependency management is more complicated
+        taraxa_json_rpc,
+        std::make_shared<net::Net>(app()),  // TODO Because this object refers to App, the
+                                            // lifecycle/dependency management is more complicated
         eth_json_rpc, test_json_rpc, debug_json_rpc);
 
+    auto serialized_methods = std::make_shared<net::JsonRpcSerializedMethods>();
+    eth_json_rpc->registerSerializedMethods(*serialized_methods);
+    taraxa_json_rpc->registerSerializedMethods(*serialized_methods);
+    if (debug_json_rpc) {
+      debug_json_rpc->registerSerializedMethods(*serialized_methods);
+    }
+    if (conf.network.rpc->response_cache_size) {
+      auto response_cache = std::make_shared<net::JsonRpcResponseCache>(conf.network.rpc->response_cache_size);
+      serialized_methods->setResponseCache(response_cache);
+      if (jsonrpc_metrics) {
+        jsonrpc_metrics->setResponseCacheHitsUpdater([response_cache] { return response_cache->hits(); });
+        jsonrpc_metrics->setResponseCacheMissesUpdater([response_cache] { return response_cache->misses(); });
+        jsonrpc_metrics->setResponseCacheSizeUpdater([response_cache] { return response_cache->bytes(); });
+      }
+    }
+
+    std::shared_ptr<net::JsonRpcDispatcher> dispatcher;
+    if (conf.network.rpc->dispatch.threads) {
+      dispatcher = std::make_shared<net::JsonRpcDispatcher>(conf.network.rpc->dispatch, jsonrpc_metrics);
+      if (jsonrpc_metrics) {
+        jsonrpc_metrics->setDispatchPendingUpdater([dispatcher] { return dispatcher->pending(); });
+        jsonrpc_metrics->setDispatchRunningUpdater([dispatcher] { return dispatcher->running(); });
+        jsonrpc_metrics->setDispatchRejectedUpdater([dispatcher] { return dispatcher->rejected(); });
+      }
+    }
+
     if (conf.network.rpc->http_port) {
-      auto json_rpc_processor = std::make_shared<net::JsonRpcHttpProcessor>();
+      auto json_rpc_processor = std::make_shared<net::JsonRpcHttpProcessor>(*rpc_thread_pool_, conf.network.rpc->batch);
+      json_rpc_processor->setSerializedMethods(serialized_methods);
+      json_rpc_processor->setDispatcher(dispatcher);
       jsonrpc_http_ = std::make_shared<net::HttpServer>(
           rpc_thread_pool_->unsafe_get_io_context(),
           boost::asio::ip::tcp::endpoint{conf.network.rpc->address, *conf.network.rpc->http_port}, app()->getAddress(),
-          json_rpc_processor, jsonrpc_metrics);
+          json_rpc_processor, jsonrpc_metrics, conf.network.rpc->http_keep_alive);
       jsonrpc_api_->addConnector(json_rpc_processor);
       jsonrpc_http_->start();
     }
     if (conf.network.rpc->ws_port) {
-      jsonrpc_ws_ = std::make_shared<net::JsonRpcWsServer>(
+      auto jsonrpc_ws = std::make_shared<net::JsonRpcWsServer>(
           rpc_thread_pool_->unsafe_get_io_context(),
           boost::asio::ip::tcp::endpoint{conf.network.rpc->address, *conf.network.rpc->ws_port}, app()->getAddress(),
-          jsonrpc_metrics);
+          jsonrpc_metrics, conf.network.rpc->ws_write_queue, conf.network.rpc->ws_compression,
+          conf.network.rpc->ws_transactions_batch);
+      jsonrpc_ws->setSerializedMethods(serialized_methods);
+      jsonrpc_ws->setDispatcher(dispatcher);
+      jsonrpc_ws_ = std::move(jsonrpc_ws);
       jsonrpc_api_->addConnector(jsonrpc_ws_);
       jsonrpc_ws_->run();
     }
@@ -152,13 +217,15 @@ void Rpc::start() {
           }
         },
         rpc_thread_pool_);
-    app()->getDagManager()->block_verified_.subscribe(
-        [eth_json_rpc = as_weak(eth_json_rpc), ws = as_weak(jsonrpc_ws_)](const auto &dag_block) {
-          if (auto _ws = ws.lock()) {
-            _ws->newDagBlock(dag_block);
-          }
-        },
-        rpc_thread_pool_);
+    if (auto dag_mgr = app()->getDagManager()) {
+      dag_mgr->block_verified_.subscribe(
+          [eth_json_rpc = as_weak(eth_json_rpc), ws = as_weak(jsonrpc_ws_)](const auto &dag_block) {
+            if (auto _ws = ws.lock()) {
+              _ws->newDagBlock(dag_block);
+            }
+          },
+          rpc_thread_pool_);
+    }
 
     app()->getPillarChainManager()->pillar_block_finalized_.subscribe(
         [ws_weak = as_weak(jsonrpc_ws_)](const auto &pillar_block_data) {
@@ -174,7 +241,8 @@ void Rpc::start() {
       graphql_ws_ = std::make_shared<net::GraphQlWsServer>(
           graphql_thread_pool_->unsafe_get_io_context(),
           boost::asio::ip::tcp::endpoint{conf.network.graphql->address, *conf.network.graphql->ws_port},
-          app()->getAddress(), jsonrpc_metrics);
+          app()->getAddress(), jsonrpc_metrics, conf.network.graphql->ws_write_queue,
+          conf.network.graphql->ws_compression);
       // graphql_ws_->run();
     }
 
@@ -185,8 +253,9 @@ void Rpc::start() {
           app()->getAddress(),
           std::make_shared<net::GraphQlHttpProcessor>(
               app()->getFinalChain(), app()->getDagManager(), app()->getPbftManager(), app()->getTransactionManager(),
-              app()->getDB(), app()->getGasPricer(), as_weak(app()->getNetwork()), conf.genesis.chain_id),
-          jsonrpc_metrics);
+              app()->getDB(), app()->getGasPricer(), as_weak(app()->getNetwork()), conf.genesis.chain_id,
+              conf.network.graphql->max_query_cost, conf.network.graphql->query_cache_size),
+          jsonrpc_metrics, conf.network.graphql->http_keep_alive);
       graphql_http_->start();
     }
   }
@@ -1,7 +1,7 @@
 #pragma once
 
-#include "common/default_construct_copyable_movable.hpp"
 #include "common/encoding_rlp.hpp"
+#include "common/once_value.hpp"
 #include "vdf/sortition.hpp"
 
 namespace taraxa {
@@ -27,13 +27,13 @@ class DagBlock {
   uint64_t gas_estimation_;
   sig_t sig_;
   u256 block_weight_;
-  mutable blk_hash_t hash_;
-  mutable util::DefaultConstructCopyableMovable<std::mutex> hash_mu_;
+  util::OnceValue<blk_hash_t> hash_;
   uint64_t timestamp_ = 0;
   vdf_sortition::VdfSortition vdf_;
-  mutable addr_t cached_sender_;  // block creater
-  mutable util::DefaultConstructCopyableMovable<std::mutex> cached_sender_mu_;
+  util::OnceValue<addr_t> cached_sender_;  // block creater
+  static const size_t kPivotPosInRlp{0};
   static const size_t kLevelPosInRlp{1};
+  static const size_t kTipsPosInRlp{4};
   static const size_t kSigPosInRlp{6};
 
  public:
@@ -69,6 +69,22 @@ class DagBlock {
    */
   static sig_t extract_signature_from_rlp(const dev::RLP &rlp);
 
+  /**
+   * @brief Extracts pivot from rlp representation
+   *
+   * @param rlp
+   * @return pivot hash
+   */
+  static blk_hash_t extract_pivot_from_rlp(const dev::RLP &rlp);
+
+  /**
+   * @brief Extracts tips from rlp representation
+   *
+   * @param rlp
+   * @return tips hashes
+   */
+  static vec_blk_t extract_tips_from_rlp(const dev::RLP &rlp);
+
   friend std::ostream &operator<<(std::ostream &str, DagBlock const &u) {
     str << "	pivot		= " << u.pivot_.abridged() << std::endl;
     str << "	level		= " << u.level_ << std::endl;
@@ -119,6 +135,9 @@ class DagBlock {
   blk_hash_t sha3(bool include_sig) const;
 };
 
+template <>
+struct util::SlabAllocated<DagBlock> : std::true_type {};
+
 struct DagFrontier {
   DagFrontier() = default;
   DagFrontier(blk_hash_t const &pivot, vec_blk_t const &tips) : pivot(pivot), tips(tips) {}
@@ -39,6 +39,15 @@ std::vector<std::shared_ptr<DagBlock>> decodeDAGBlocksBundleRlp(const dev::RLP&
  */
 std::shared_ptr<DagBlock> decodeDAGBlockBundleRlp(uint64_t index, const dev::RLP& blocks_bundle_rlp);
 
+/**
+ * @brief Computes hashes of dag blocks in optimized blocks bundle rlp without decoding the blocks. Full block rlp is
+ *        assembled from raw bundle items, so neither vdf nor signature are processed
+ *
+ * @param blocks_bundle_rlp
+ * @return blocks hashes
+ */
+std::vector<dev::h256> decodeDAGBlocksBundleHashes(const dev::RLP& blocks_bundle_rlp);
+
 /** @}*/
 
 }  // namespace taraxa
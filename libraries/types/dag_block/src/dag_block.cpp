@@ -21,9 +21,15 @@ DagBlock::DagBlock(blk_hash_t pivot, level_t level, vec_blk_t tips, vec_trx_t tr
       tips_(std::move(tips)),
       trxs_(std::move(trxs)),
       gas_estimation_(std::move(est)),
-      sig_(std::move(sig)),
-      hash_(std::move(hash)),
-      cached_sender_(std::move(sender)) {}
+      sig_(std::move(sig)) {
+  // Zero values stand for not known, they are computed on first access then
+  if (hash) {
+    hash_.set(hash);
+  }
+  if (sender) {
+    cached_sender_.set(sender);
+  }
+}
 
 DagBlock::DagBlock(blk_hash_t pivot, level_t level, vec_blk_t tips, vec_trx_t trxs, sig_t signature, blk_hash_t hash,
                    addr_t sender)
@@ -43,6 +49,8 @@ DagBlock::DagBlock(blk_hash_t const &pivot, level_t level, vec_blk_t tips, vec_t
       timestamp_(dev::utcTime()),
       vdf_(std::move(vdf)) {
   sig_ = dev::sign(sk, sha3(false));
+  // Deriving address from the secret is cheaper than recovering it from the signature later
+  cached_sender_.set(dev::toAddress(sk));
 }
 
 DagBlock::DagBlock(std::string const &json)
@@ -84,6 +92,8 @@ DagBlock::DagBlock(dev::RLP const &rlp, vec_trx_t &&trxs) {
 
 level_t DagBlock::extract_dag_level_from_rlp(const dev::RLP &rlp) { return rlp[kLevelPosInRlp].toInt<level_t>(); }
 sig_t DagBlock::extract_signature_from_rlp(const dev::RLP &rlp) { return rlp[kSigPosInRlp].toHash<sig_t>(); }
+blk_hash_t DagBlock::extract_pivot_from_rlp(const dev::RLP &rlp) { return rlp[kPivotPosInRlp].toHash<blk_hash_t>(); }
+vec_blk_t DagBlock::extract_tips_from_rlp(const dev::RLP &rlp) { return rlp[kTipsPosInRlp].toVector<blk_hash_t>(); }
 
 Json::Value DagBlock::getJson(bool with_derived_fields) const {
   Json::Value res;
@@ -117,7 +127,7 @@ std::string DagBlock::getJsonStr() const {
 
 bool DagBlock::verifySig() const {
   if (!sig_) return false;
-  if (cached_sender_) return true;
+  if (cached_sender_.isSet()) return true;
   auto msg = sha3(false);
   auto pk = dev::recover(sig_, msg);  // recover is equal to verify
   return !pk.isZero();
@@ -137,32 +147,19 @@ void DagBlock::verifyVdf(const SortitionParams &vdf_config, const h256 &proposal
 }
 
 blk_hash_t const &DagBlock::getHash() const {
-  if (!hash_) {
-    std::unique_lock l(hash_mu_.val, std::try_to_lock);
-    if (!l.owns_lock()) {
-      l.lock();
-      return hash_;
-    }
-    hash_ = sha3(true);
-  };
-  return hash_;
+  return hash_.get([this] { return sha3(true); });
 }
 
 addr_t const &DagBlock::getSender() const {
-  if (!cached_sender_) {
-    std::unique_lock l(cached_sender_mu_.val, std::try_to_lock);
-    if (!l.owns_lock()) {
-      l.lock();
-      return cached_sender_;
-    }
-    if (!sig_) {
-      return cached_sender_;
-    }
+  // Unsigned block has no sender, it is not cached so that block signed later still recovers it
+  if (!sig_ && !cached_sender_.isSet()) {
+    return dev::ZeroAddress;
+  }
+  return cached_sender_.get([this] {
     auto p = dev::recover(sig_, sha3(false));
     assert(p);
-    cached_sender_ = dev::right160(dev::sha3(dev::bytesConstRef(p.data(), sizeof(p))));
-  }
-  return cached_sender_;
+    return dev::right160(dev::sha3(dev::bytesConstRef(p.data(), sizeof(p))));
+  });
 }
 
 dev::RLPStream DagBlock::streamRLP(bool include_sig, bool include_trxs) const {
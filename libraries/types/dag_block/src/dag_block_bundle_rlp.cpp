@@ -29,21 +29,39 @@ dev::bytes encodeDAGBlocksBundleRlp(const std::vector<std::shared_ptr<DagBlock>>
     indexes.push_back(idx);
   }
 
-  dev::RLPStream blocks_bundle_rlp(kDAGBlocksBundleRlpSize);
-  blocks_bundle_rlp.appendList(ordered_trx_hashes.size());
+  std::vector<dev::bytes> blocks_rlp;
+  blocks_rlp.reserve(blocks.size());
+  size_t blocks_size = 0;
+  for (const auto& block : blocks) {
+    blocks_size += blocks_rlp.emplace_back(block->rlp(true, false)).size();
+  }
+
+  // Sizes are computed first, so the bundle is written into a single buffer without moving nested lists
+  const auto hashes_size = util::rlp_payload_size(ordered_trx_hashes);
+  size_t indexes_size = 0;
+  for (const auto& idx : indexes) {
+    indexes_size += util::rlp_size(idx);
+  }
+  const auto bundle_size =
+      dev::rlpListSize(hashes_size) + dev::rlpListSize(indexes_size) + dev::rlpListSize(blocks_size);
+
+  dev::RLPStream blocks_bundle_rlp;
+  blocks_bundle_rlp.reserve(dev::rlpListSize(bundle_size), 0);
+  blocks_bundle_rlp.appendList(kDAGBlocksBundleRlpSize, bundle_size);
+  blocks_bundle_rlp.appendList(ordered_trx_hashes.size(), hashes_size);
   for (const auto& trx_hash : ordered_trx_hashes) {
     blocks_bundle_rlp.append(trx_hash);
   }
-  blocks_bundle_rlp.appendList(indexes.size());
+  blocks_bundle_rlp.appendList(indexes.size(), indexes_size);
   for (const auto& idx : indexes) {
-    blocks_bundle_rlp.appendList(idx.size());
+    blocks_bundle_rlp.appendList(idx.size(), util::rlp_payload_size(idx));
     for (const auto& i : idx) {
       blocks_bundle_rlp.append(i);
     }
   }
-  blocks_bundle_rlp.appendList(blocks.size());
-  for (const auto& block : blocks) {
-    blocks_bundle_rlp.appendRaw(block->rlp(true, false));
+  blocks_bundle_rlp.appendList(blocks_rlp.size(), blocks_size);
+  for (const auto& block_rlp : blocks_rlp) {
+    blocks_bundle_rlp.appendRaw(block_rlp);
   }
   return blocks_bundle_rlp.invalidate();
 }
@@ -53,15 +71,20 @@ std::vector<std::shared_ptr<DagBlock>> decodeDAGBlocksBundleRlp(const dev::RLP&
     return {};
   }
 
+  // Blocks are matched to their transaction indexes by position, index avoids rescanning a list for every block
+  const util::RLPIndex bundle(blocks_bundle_rlp);
+  const util::RLPIndex blocks_rlp(bundle[2]);
+
   std::vector<trx_hash_t> ordered_trx_hashes;
   std::vector<std::vector<trx_hash_t>> dags_trx_hashes;
 
   // Decode transaction hashes and
-  ordered_trx_hashes.reserve(blocks_bundle_rlp[0].itemCount());
-  std::transform(blocks_bundle_rlp[0].begin(), blocks_bundle_rlp[0].end(), std::back_inserter(ordered_trx_hashes),
+  const auto trx_hashes_rlp = bundle[0];
+  ordered_trx_hashes.reserve(trx_hashes_rlp.itemCount());
+  std::transform(trx_hashes_rlp.begin(), trx_hashes_rlp.end(), std::back_inserter(ordered_trx_hashes),
                  [](const auto& trx_hash_rlp) { return trx_hash_rlp.template toHash<trx_hash_t>(); });
 
-  for (const auto idx_rlp : blocks_bundle_rlp[1]) {
+  for (const auto idx_rlp : bundle[1]) {
     std::vector<trx_hash_t> hashes;
     hashes.reserve(idx_rlp.itemCount());
     std::transform(idx_rlp.begin(), idx_rlp.end(), std::back_inserter(hashes),
@@ -71,10 +94,10 @@ std::vector<std::shared_ptr<DagBlock>> decodeDAGBlocksBundleRlp(const dev::RLP&
   }
 
   std::vector<std::shared_ptr<DagBlock>> blocks;
-  blocks.reserve(blocks_bundle_rlp[2].itemCount());
+  blocks.reserve(blocks_rlp.size());
 
-  for (size_t i = 0; i < blocks_bundle_rlp[2].itemCount(); i++) {
-    auto block = std::make_shared<DagBlock>(blocks_bundle_rlp[2][i], std::move(dags_trx_hashes[i]));
+  for (size_t i = 0; i < blocks_rlp.size(); i++) {
+    auto block = util::makeShared<DagBlock>(blocks_rlp[i], std::move(dags_trx_hashes[i]));
     blocks.push_back(std::move(block));
   }
 
@@ -85,23 +108,57 @@ std::shared_ptr<DagBlock> decodeDAGBlockBundleRlp(uint64_t index, const dev::RLP
   if (blocks_bundle_rlp.itemCount() != kDAGBlocksBundleRlpSize) {
     return {};
   }
-  if (index >= blocks_bundle_rlp[2].itemCount()) {
+  const util::RLPIndex bundle(blocks_bundle_rlp);
+  const auto blocks_rlp = bundle[2];
+  if (index >= blocks_rlp.itemCount()) {
     return {};
   }
 
-  std::vector<trx_hash_t> ordered_trx_hashes;
-  ordered_trx_hashes.reserve(blocks_bundle_rlp[0].itemCount());
-  std::transform(blocks_bundle_rlp[0].begin(), blocks_bundle_rlp[0].end(), std::back_inserter(ordered_trx_hashes),
-                 [](const auto& trx_hash_rlp) { return trx_hash_rlp.template toHash<trx_hash_t>(); });
-
-  const auto idx_rlp = blocks_bundle_rlp[1][index];
+  // Only hashes of the requested block are needed, they are picked by index from the hashes list
+  const util::RLPIndex trx_hashes_rlp(bundle[0]);
+  const auto idx_rlp = bundle[1][index];
   std::vector<trx_hash_t> hashes;
   hashes.reserve(idx_rlp.itemCount());
-  std::transform(idx_rlp.begin(), idx_rlp.end(), std::back_inserter(hashes),
-                 [&ordered_trx_hashes](const auto& i) { return ordered_trx_hashes[i.template toInt<uint32_t>()]; });
-  return std::make_shared<DagBlock>(blocks_bundle_rlp[2][index], std::move(hashes));
+  std::transform(idx_rlp.begin(), idx_rlp.end(), std::back_inserter(hashes), [&trx_hashes_rlp](const auto& i) {
+    return trx_hashes_rlp[i.template toInt<uint32_t>()].template toHash<trx_hash_t>();
+  });
+  return util::makeShared<DagBlock>(blocks_rlp[index], std::move(hashes));
 }
 
 /** @}*/
 
+std::vector<dev::h256> decodeDAGBlocksBundleHashes(const dev::RLP& blocks_bundle_rlp) {
+  if (blocks_bundle_rlp.itemCount() != kDAGBlocksBundleRlpSize) {
+    return {};
+  }
+
+  // Position of tips in DagBlock rlp, see DagBlock::streamRLP
+  constexpr size_t kTipsPos = 4;
+  const util::RLPIndex bundle(blocks_bundle_rlp);
+  const util::RLPIndex trx_hashes_rlp(bundle[0]);
+  const util::RLPIndex indexes_rlp(bundle[1]);
+  const auto blocks_rlp = bundle[2];
+  std::vector<dev::h256> hashes;
+  hashes.reserve(indexes_rlp.size());
+  size_t i = 0;
+  for (const auto block_rlp : blocks_rlp) {
+    // Bundle stores blocks without transactions, they go right after tips in the full block rlp
+    dev::RLPStream s(block_rlp.itemCount() + 1);
+    size_t field = 0;
+    for (const auto field_rlp : block_rlp) {
+      s.appendRaw(field_rlp.data());
+      if (field++ == kTipsPos) {
+        const auto idx_rlp = indexes_rlp[i];
+        s.appendList(idx_rlp.itemCount());
+        for (const auto idx : idx_rlp) {
+          s.appendRaw(trx_hashes_rlp.data(idx.toInt<uint32_t>()));
+        }
+      }
+    }
+    hashes.push_back(dev::sha3(s.out()));
+    i++;
+  }
+  return hashes;
+}
+
 }  // namespace taraxa
@@ -16,24 +16,22 @@ PeriodData::PeriodData(std::shared_ptr<PbftBlock> pbft_blk,
       pillar_votes_(std::move(pillar_votes)) {}
 
 PeriodData::PeriodData(const dev::RLP& rlp) {
-  auto it = rlp.begin();
-  pbft_blk = std::make_shared<PbftBlock>(*it++);
+  const util::RLPIndex items(rlp);
+  pbft_blk = std::make_shared<PbftBlock>(items[0]);
 
-  const auto votes_bundle_rlp = *it++;
   if (pbft_blk->getPeriod() > 1) [[likely]] {
-    previous_block_cert_votes = decodePbftVotesBundleRlp(votes_bundle_rlp);
+    previous_block_cert_votes = decodePbftVotesBundleRlp(items[1]);
   }
 
-  const auto block_bundle_rlp = *it++;
-  dag_blocks = decodeDAGBlocksBundleRlp(block_bundle_rlp);
+  dag_blocks = decodeDAGBlocksBundleRlp(items[2]);
 
-  for (auto&& trx_rlp : *it++) {
-    transactions.emplace_back(std::make_shared<Transaction>(std::move(trx_rlp)));
+  for (auto&& trx_rlp : items[3]) {
+    transactions.emplace_back(util::makeShared<Transaction>(std::move(trx_rlp)));
   }
 
   // Pillar votes are optional data of period data since ficus hardfork
-  if (rlp.itemCount() == 5) {
-    pillar_votes_ = decodePillarVotesBundleRlp(*it);
+  if (items.size() == kBaseRlpItemCount + 1) {
+    pillar_votes_ = decodePillarVotesBundleRlp(items[kBaseRlpItemCount]);
   }
 }
 
@@ -41,29 +39,32 @@ PeriodData::PeriodData(bytes const& all_rlp) : PeriodData(dev::RLP(all_rlp)) {}
 
 bytes PeriodData::rlp() const {
   const auto kRlpSize = pillar_votes_.has_value() ? kBaseRlpItemCount + 1 : kBaseRlpItemCount;
-  dev::RLPStream s(kRlpSize);
-  s.appendRaw(pbft_blk->rlp(true));
-
-  if (pbft_blk->getPeriod() > 1) [[likely]] {
-    s.appendRaw(encodePbftVotesBundleRlp(previous_block_cert_votes));
-  } else {
-    s.append("");
-  }
-
-  if (dag_blocks.empty()) {
-    s.append("");
-  } else {
-    s.appendRaw(encodeDAGBlocksBundleRlp(dag_blocks));
-  }
-
-  s.appendList(transactions.size());
+  // Parts are encoded and measured first, so period with thousands of transactions is written into a single buffer
+  // without moving the transactions when lists are finished
+  const auto empty = dev::rlp("");
+  const auto pbft_block_rlp = pbft_blk->rlp(true);
+  const auto votes_rlp = pbft_blk->getPeriod() > 1 ? encodePbftVotesBundleRlp(previous_block_cert_votes) : empty;
+  const auto dag_blocks_rlp = dag_blocks.empty() ? empty : encodeDAGBlocksBundleRlp(dag_blocks);
+  // Pillar votes are optional data of period data since ficus hardfork
+  const auto pillar_votes_rlp = pillar_votes_.has_value() ? encodePillarVotesBundleRlp(*pillar_votes_) : bytes();
+  const auto transactions_size = util::rlp_payload_size(transactions);
+  const auto size = pbft_block_rlp.size() + votes_rlp.size() + dag_blocks_rlp.size() +
+                    dev::rlpListSize(transactions_size) + pillar_votes_rlp.size();
+
+  dev::RLPStream s;
+  s.reserve(dev::rlpListSize(size), 0);
+  s.appendList(kRlpSize, size);
+  s.appendRaw(pbft_block_rlp);
+  s.appendRaw(votes_rlp);
+  s.appendRaw(dag_blocks_rlp);
+
+  s.appendList(transactions.size(), transactions_size);
   for (auto const& t : transactions) {
     s.appendRaw(t->rlp());
   }
 
-  // Pillar votes are optional data of period data since ficus hardfork
   if (pillar_votes_.has_value()) {
-    s.appendRaw(encodePillarVotesBundleRlp(*pillar_votes_));
+    s.appendRaw(pillar_votes_rlp);
   }
 
   return s.invalidate();
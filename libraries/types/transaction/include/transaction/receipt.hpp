@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstring>
+
 #include "common/encoding_rlp.hpp"
 #include "common/types.hpp"
 
@@ -8,6 +10,22 @@ namespace taraxa {
 using LogBloom = dev::h2048;
 using LogBlooms = std::vector<LogBloom>;
 
+/**
+ * @brief Checks that all bits of b are set in bloom. Branch free loop over 64-bit words, so compiler vectorizes it
+ * with the widest registers of the target (AVX2, NEON), unlike bytewise FixedHash::contains with temporary copies
+ */
+inline bool bloomContains(const LogBloom& bloom, const LogBloom& b) {
+  constexpr size_t kWords = LogBloom::size / sizeof(uint64_t);
+  uint64_t missing = 0;
+  for (size_t i = 0; i < kWords; ++i) {
+    uint64_t have, need;
+    std::memcpy(&have, bloom.data() + i * sizeof(uint64_t), sizeof(uint64_t));
+    std::memcpy(&need, b.data() + i * sizeof(uint64_t), sizeof(uint64_t));
+    missing |= need & ~have;
+  }
+  return missing == 0;
+}
+
 struct LogEntry {
   Address address;
   h256s topics;
@@ -53,4 +71,35 @@ struct TransactionLocation {
 
 using SharedTransactionReceipts = std::shared_ptr<std::vector<TransactionReceipt>>;
 
+/**
+ * @brief Compact db encoding of all receipts of a period: version byte followed by rlp of address and topic
+ *        dictionaries and receipts referring to them by index. Plain rlp list of receipts starts with list prefix,
+ *        so both encodings can be told apart by the first byte
+ */
+constexpr uint8_t kCompactReceiptsVersion = 1;
+
+bytes encodeCompactReceipts(const TransactionReceipts& receipts);
+
+/**
+ * @brief Read only access to receipts of a period stored in plain rlp or compact encoding, receipts are decoded only
+ *        when accessed. Raw data must outlive the view
+ */
+class ReceiptsView {
+ public:
+  explicit ReceiptsView(dev::bytesConstRef raw);
+
+  static bool isCompact(dev::bytesConstRef raw) { return !raw.empty() && raw[0] == kCompactReceiptsVersion; }
+
+  size_t size() const { return receipts_.itemCount(); }
+  TransactionReceipt operator[](size_t position) const;
+  TransactionReceipts decodeAll() const;
+
+ private:
+  dev::RLP receipts_;
+  // Decoded dictionaries, empty for plain rlp
+  std::vector<Address> addresses_;
+  h256s topics_;
+  bool compact_ = false;
+};
+
 }  // namespace taraxa
\ No newline at end of file
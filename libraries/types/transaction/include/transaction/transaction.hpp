@@ -5,6 +5,7 @@
 #include <libdevcore/SHA3.h>
 
 #include "common/encoding_rlp.hpp"
+#include "common/once_value.hpp"
 #include "common/types.hpp"
 
 namespace taraxa {
@@ -31,19 +32,18 @@ struct Transaction {
   std::optional<addr_t> receiver_;
   uint64_t chain_id_ = 0;
   dev::SignatureStruct vrs_;
-  mutable trx_hash_t hash_;
-  mutable bool hash_initialized_ = false;
+  util::OnceValue<trx_hash_t> hash_;
   bool is_zero_ = false;
-  mutable std::mutex hash_mu_;
-  mutable bool sender_initialized_ = false;
-  mutable bool sender_valid_ = false;
-  mutable addr_t sender_;
-  mutable std::mutex sender_mu_;
-  mutable bool cached_rlp_set_ = false;
-  mutable bytes cached_rlp_;
-  mutable std::mutex cached_rlp_mu_;
+  struct Sender {
+    addr_t address;
+    bool valid = false;
+  };
+  // Zero address when signature is not valid
+  util::OnceValue<Sender> sender_;
+  util::OnceValue<bytes> cached_rlp_;
 
   trx_hash_t hash_for_signature() const;
+  Sender recoverSender() const;
   addr_t const &get_sender_() const;
   virtual void streamRLP(dev::RLPStream &s, bool for_signature) const;
   virtual void fromRLP(const dev::RLP &_rlp, bool verify_strict);
@@ -71,16 +71,28 @@ struct Transaction {
   auto getCost() const { return gas_price_ * gas_ + value_; }
 
   virtual const addr_t &getSender() const;
+  // Recovers and caches senders of all transactions not recovered yet in one batch, split between threads
+  static void recoverSenders(const std::vector<std::shared_ptr<Transaction>> &trxs, unsigned threads = 1);
+  // Computes and caches hashes of all transactions not hashed yet, several of them are hashed at once
+  static void computeHashes(const std::vector<std::shared_ptr<Transaction>> &trxs);
+  // Sets sender this node recovered before, skips signature recovery. Only for data coming from own db
+  void restoreSender(const addr_t &sender) const;
 
   bool operator==(Transaction const &other) const { return getHash() == other.getHash(); }
 
   const bytes &rlp() const;
+  // Encoded rlp is cached, so lists of transactions are encoded into a presized buffer
+  size_t rlpSize() const { return rlp().size(); }
 
   Json::Value toJSON() const;
 
   HAS_RLP_FIELDS
 };
 
+// Transactions are decoded from every packet and referenced by pool, per-peer queues and periods
+template <>
+struct util::SlabAllocated<Transaction> : std::true_type {};
+
 using SharedTransaction = std::shared_ptr<Transaction>;
 using Transactions = std::vector<Transaction>;
 using SharedTransactions = std::vector<SharedTransaction>;
@@ -2,6 +2,8 @@
 
 #include <libdevcore/SHA3.h>
 
+#include <unordered_map>
+
 namespace taraxa {
 
 RLP_FIELDS_DEFINE(LogEntry, address, topics, data)
@@ -18,11 +20,117 @@ LogBloom LogEntry::bloom() const {
 RLP_FIELDS_DEFINE(TransactionReceipt, status_code, gas_used, cumulative_gas_used, logs, new_contract_address)
 
 LogBloom TransactionReceipt::bloom() const {
-  LogBloom ret;
+  // Addresses and topics of all logs are hashed in a single batch, bloom is the same as union of logs blooms
+  std::vector<dev::bytesConstRef> inputs;
   for (auto const& l : logs) {
-    ret |= l.bloom();
+    inputs.push_back(l.address.ref());
+    for (auto const& t : l.topics) {
+      inputs.push_back(t.ref());
+    }
+  }
+  std::vector<h256> hashes(inputs.size());
+  dev::sha3Batch(inputs, hashes.data());
+
+  LogBloom ret;
+  for (auto const& h : hashes) {
+    ret.shiftBloom<3>(h);
   }
   return ret;
 }
 
+bytes encodeCompactReceipts(const TransactionReceipts& receipts) {
+  std::vector<Address> addresses;
+  h256s topics;
+  std::unordered_map<Address, size_t> address_index;
+  std::unordered_map<h256, size_t> topic_index;
+  const auto index_of = [](auto& dictionary, auto& index, const auto& value) {
+    const auto [it, inserted] = index.try_emplace(value, dictionary.size());
+    if (inserted) {
+      dictionary.push_back(value);
+    }
+    return it->second;
+  };
+
+  // Integers are kept as minimal big endian rlp strings, so gas fields take only as many bytes as they need
+  dev::RLPStream receipts_rlp(receipts.size());
+  for (const auto& receipt : receipts) {
+    receipts_rlp.appendList(5);
+    receipts_rlp << receipt.status_code << receipt.gas_used << receipt.cumulative_gas_used;
+    // Index is shifted by one, zero stands for no contract
+    const auto& contract = receipt.new_contract_address;
+    receipts_rlp << (contract ? index_of(addresses, address_index, *contract) + 1 : 0);
+    receipts_rlp.appendList(receipt.logs.size());
+    for (const auto& log : receipt.logs) {
+      receipts_rlp.appendList(3);
+      receipts_rlp << index_of(addresses, address_index, log.address);
+      receipts_rlp.appendList(log.topics.size());
+      for (const auto& topic : log.topics) {
+        receipts_rlp << index_of(topics, topic_index, topic);
+      }
+      receipts_rlp << log.data;
+    }
+  }
+
+  dev::RLPStream s(3);
+  s.appendVector(addresses);
+  s.appendVector(topics);
+  s.appendRaw(receipts_rlp.out());
+  bytes res;
+  res.reserve(s.out().size() + 1);
+  res.push_back(kCompactReceiptsVersion);
+  res.insert(res.end(), s.out().begin(), s.out().end());
+  return res;
+}
+
+ReceiptsView::ReceiptsView(dev::bytesConstRef raw) : compact_(isCompact(raw)) {
+  if (!compact_) {
+    receipts_ = dev::RLP(raw);
+    return;
+  }
+  const dev::RLP rlp(raw.cropped(1));
+  addresses_ = rlp[0].toVector<Address>();
+  topics_ = rlp[1].toVector<h256>();
+  receipts_ = rlp[2];
+}
+
+TransactionReceipt ReceiptsView::operator[](size_t position) const {
+  if (!compact_) {
+    return util::rlp_dec<TransactionReceipt>(receipts_[position]);
+  }
+
+  TransactionReceipt receipt;
+  const auto item = receipts_[position];
+  receipt.status_code = item[0].toInt<uint8_t>();
+  receipt.gas_used = item[1].toInt<uint64_t>();
+  receipt.cumulative_gas_used = item[2].toInt<uint64_t>();
+  if (const auto contract = item[3].toInt<size_t>()) {
+    receipt.new_contract_address = addresses_.at(contract - 1);
+  }
+  const auto logs = item[4];
+  receipt.logs.reserve(logs.itemCount());
+  for (const auto log : logs) {
+    auto& entry = receipt.logs.emplace_back();
+    entry.address = addresses_.at(log[0].toInt<size_t>());
+    const auto topics = log[1];
+    entry.topics.reserve(topics.itemCount());
+    for (const auto topic : topics) {
+      entry.topics.push_back(topics_.at(topic.toInt<size_t>()));
+    }
+    entry.data = log[2].toBytes();
+  }
+  return receipt;
+}
+
+TransactionReceipts ReceiptsView::decodeAll() const {
+  if (!compact_) {
+    return util::rlp_dec<TransactionReceipts>(receipts_);
+  }
+  TransactionReceipts receipts;
+  receipts.reserve(size());
+  for (size_t i = 0; i < size(); ++i) {
+    receipts.push_back((*this)[i]);
+  }
+  return receipts;
+}
+
 }  // namespace taraxa
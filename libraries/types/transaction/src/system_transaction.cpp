@@ -13,7 +13,7 @@ SystemTransaction::SystemTransaction(const trx_nonce_t &nonce, const val_t &valu
   data_ = std::move(data);
   receiver_ = receiver;
   chain_id_ = chain_id;
-  sender_ = kTaraxaSystemAccount;
+  sender_.set({kTaraxaSystemAccount, true});
 }
 
 SystemTransaction::SystemTransaction(const bytes &_bytes, bool verify_strict) {
@@ -30,15 +30,15 @@ SystemTransaction::SystemTransaction(const bytes &_bytes, bool verify_strict) {
   }
 
   fromRLP(rlp, verify_strict);
-  sender_ = kTaraxaSystemAccount;
+  sender_.set({kTaraxaSystemAccount, true});
 }
 
 SystemTransaction::SystemTransaction(const dev::RLP &_rlp, bool verify_strict) {
   fromRLP(_rlp, verify_strict);
-  sender_ = kTaraxaSystemAccount;
+  sender_.set({kTaraxaSystemAccount, true});
 }
 
-const addr_t &SystemTransaction::getSender() const { return sender_; }
+const addr_t &SystemTransaction::getSender() const { return get_sender_(); }
 
 void SystemTransaction::streamRLP(dev::RLPStream &s, bool) const {
   // always serialize as for the signature
@@ -3,6 +3,7 @@
 
 #include <libdevcore/CommonData.h>
 #include <libdevcore/CommonJS.h>
+#include <libdevcore/SHA3.h>
 
 #include <algorithm>
 #include <string>
@@ -21,6 +22,7 @@ uint64_t toChainID(const u256 &val) {
 }
 
 TransactionHashes hashes_from_transactions(const SharedTransactions &transactions) {
+  Transaction::computeHashes(transactions);
   TransactionHashes trx_hashes;
   trx_hashes.reserve(transactions.size());
   std::transform(transactions.cbegin(), transactions.cend(), std::back_inserter(trx_hashes),
@@ -37,19 +39,16 @@ Transaction::Transaction(const trx_nonce_t &nonce, const val_t &value, const val
       data_(std::move(data)),
       receiver_(receiver),
       chain_id_(chain_id),
-      vrs_(sign(sk, hash_for_signature())),
-      sender_initialized_(true),
-      sender_valid_(vrs_.isValid()),
-      sender_(sender_valid_ ? toAddress(sk) : dev::ZeroAddress) {
+      vrs_(sign(sk, hash_for_signature())) {
+  sender_.set(vrs_.isValid() ? Sender{toAddress(sk), true} : Sender{});
   getSender();
 }
 
 Transaction::Transaction(const bytes &_bytes, bool verify_strict) {
   dev::RLP rlp;
   try {
-    cached_rlp_ = std::move(_bytes);
-    cached_rlp_set_ = true;
-    rlp = dev::RLP(cached_rlp_);
+    cached_rlp_.set(_bytes);
+    rlp = dev::RLP(this->rlp());
   } catch (const dev::RLPException &e) {
     // TODO[1881]: this should be removed when we will add typed transactions support
     std::string error_msg =
@@ -63,8 +62,7 @@ Transaction::Transaction(const bytes &_bytes, bool verify_strict) {
 }
 
 Transaction::Transaction(dev::RLP &&_rlp, bool verify_strict) {
-  cached_rlp_ = _rlp.data().toBytes();
-  cached_rlp_set_ = true;
+  cached_rlp_.set(_rlp.data().toBytes());
   fromRLP(_rlp, verify_strict);
 }
 
@@ -91,34 +89,86 @@ void Transaction::fromRLP(const dev::RLP &_rlp, bool verify_strict) {
 }
 
 const trx_hash_t &Transaction::getHash() const {
-  std::unique_lock l(hash_mu_);
-  if (!hash_initialized_) {
-    hash_ = dev::sha3(rlp());
-    hash_initialized_ = true;
+  return hash_.get([this] { return dev::sha3(rlp()); });
+}
+
+Transaction::Sender Transaction::recoverSender() const {
+  if (auto pubkey = recover(vrs_, hash_for_signature()); pubkey) {
+    return {toAddress(pubkey), true};
   }
-  return hash_;
+  return {};
 }
 
 const addr_t &Transaction::get_sender_() const {
-  std::unique_lock l(sender_mu_);
-  if (!sender_initialized_) {
-    if (auto pubkey = recover(vrs_, hash_for_signature()); pubkey) {
-      sender_ = toAddress(pubkey);
-      sender_valid_ = true;
+  return sender_.get([this] { return recoverSender(); }).address;
+}
+
+void Transaction::recoverSenders(const std::vector<std::shared_ptr<Transaction>> &trxs, unsigned threads) {
+  std::vector<const Transaction *> pending;
+  std::vector<bytes> signature_rlps;
+  for (const auto &trx : trxs) {
+    if (trx->sender_.isSet()) {
+      continue;
     }
-    sender_initialized_ = true;
+    pending.push_back(trx.get());
+    dev::RLPStream s;
+    trx->streamRLP(s, true);
+    signature_rlps.push_back(s.invalidate());
+  }
+
+  // Hashes for signature are computed together, before the recovery is split between threads
+  std::vector<dev::bytesConstRef> signature_rlps_refs;
+  signature_rlps_refs.reserve(signature_rlps.size());
+  for (const auto &rlp : signature_rlps) {
+    signature_rlps_refs.emplace_back(&rlp);
+  }
+  std::vector<h256> hashes(signature_rlps.size());
+  dev::sha3Batch(signature_rlps_refs, hashes.data());
+  std::vector<std::pair<dev::Signature, h256>> batch;
+  batch.reserve(pending.size());
+  for (size_t i = 0; i < pending.size(); ++i) {
+    batch.emplace_back(pending[i]->vrs_, hashes[i]);
+  }
+
+  const auto pubkeys = dev::recover(batch, threads);
+  for (size_t i = 0; i < pending.size(); ++i) {
+    // Sender might have been recovered by other thread meanwhile, then it is kept
+    pending[i]->sender_.set(pubkeys[i] ? Sender{toAddress(pubkeys[i]), true} : Sender{});
+  }
+}
+
+void Transaction::computeHashes(const std::vector<std::shared_ptr<Transaction>> &trxs) {
+  std::vector<const Transaction *> pending;
+  std::vector<dev::bytesConstRef> rlps;
+  for (const auto &trx : trxs) {
+    if (trx->hash_.isSet()) {
+      continue;
+    }
+    pending.push_back(trx.get());
+    rlps.emplace_back(&trx->rlp());
+  }
+  if (pending.size() < 2) {
+    return;
+  }
+
+  std::vector<trx_hash_t> hashes(rlps.size());
+  dev::sha3Batch(rlps, hashes.data());
+  for (size_t i = 0; i < pending.size(); ++i) {
+    // Hash might have been computed by other thread meanwhile, then it is kept
+    pending[i]->hash_.set(hashes[i]);
   }
-  return sender_;
 }
 
 const addr_t &Transaction::getSender() const {
-  if (auto const &ret = get_sender_(); sender_valid_) {
-    return ret;
+  if (const auto &sender = sender_.get([this] { return recoverSender(); }); sender.valid) {
+    return sender.address;
   }
   throw InvalidSignature("transaction body: " + toJSON().toStyledString() +
-                         "\nOriginal RLP: " + (cached_rlp_set_ ? dev::toJS(cached_rlp_) : "wasn't created from rlp"));
+                         "\nOriginal RLP: " + (cached_rlp_.isSet() ? dev::toJS(rlp()) : "wasn't created from rlp"));
 }
 
+void Transaction::restoreSender(const addr_t &sender) const { sender_.set({sender, true}); }
+
 void Transaction::streamRLP(dev::RLPStream &s, bool for_signature) const {
   s.appendList(!for_signature || chain_id_ ? 9 : 6);
   s << nonce_ << gas_price_ << gas_;
@@ -136,14 +186,11 @@ void Transaction::streamRLP(dev::RLPStream &s, bool for_signature) const {
 }
 
 const bytes &Transaction::rlp() const {
-  std::unique_lock l(cached_rlp_mu_);
-  if (!cached_rlp_set_) {
+  return cached_rlp_.get([this] {
     dev::RLPStream s;
     streamRLP(s, false);
-    cached_rlp_ = s.invalidate();
-    cached_rlp_set_ = true;
-  }
-  return cached_rlp_;
+    return s.invalidate();
+  });
 }
 
 trx_hash_t Transaction::hash_for_signature() const {
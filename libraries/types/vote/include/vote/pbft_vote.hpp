@@ -97,6 +97,17 @@ class PbftVote : public Vote {
    */
   bytes optimizedRlp() const;
 
+  /**
+   * @brief Writes optimized rlp into existing stream, @see optimizedRlp
+   * @param s stream
+   */
+  void optimizedRlp(dev::RLPStream& s) const;
+
+  /**
+   * @return exact size of optimized rlp
+   */
+  size_t optimizedRlpSize() const;
+
   /**
    * @brief Calculate vote weight
    * @param stake voter DPOS eligible votes count
@@ -114,7 +125,7 @@ class PbftVote : public Vote {
 
   friend std::ostream& operator<<(std::ostream& strm, PbftVote const& vote) {
     strm << "[Vote] " << std::endl;
-    strm << "  vote_hash: " << vote.vote_hash_ << std::endl;
+    strm << "  vote_hash: " << vote.getHash() << std::endl;
     strm << "  voter: " << vote.getVoter() << std::endl;
     strm << "  vote_signature: " << vote.vote_signature_ << std::endl;
     strm << "  blockhash: " << vote.block_hash_ << std::endl;
@@ -143,6 +154,9 @@ class PbftVote : public Vote {
   mutable std::optional<uint64_t> weight_;
 };
 
+template <>
+struct util::SlabAllocated<PbftVote> : std::true_type {};
+
 /** @}*/
 
 }  // namespace taraxa
\ No newline at end of file
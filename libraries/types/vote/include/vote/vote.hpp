@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/once_value.hpp"
 #include "common/types.hpp"
 
 namespace taraxa {
@@ -37,6 +38,28 @@ class Vote {
    */
   const public_t& getVoter() const;
 
+  /**
+   * @brief Recovers and caches voters of all votes not recovered yet in one batch
+   * @param votes shared pointers to votes
+   * @param threads number of threads big batches are split between
+   */
+  template <typename Votes>
+  static void recoverVoters(const Votes& votes, unsigned threads = 1) {
+    std::vector<const Vote*> pending;
+    std::vector<std::pair<sig_t, h256>> batch;
+    for (const auto& vote_ptr : votes) {
+      const Vote* vote = vote_ptr.get();
+      if (!vote->cached_voter_.isSet()) {
+        pending.push_back(vote);
+        batch.emplace_back(vote->vote_signature_, vote->sha3(false));
+      }
+    }
+    const auto voters = dev::recover(batch, threads);
+    for (size_t i = 0; i < pending.size(); ++i) {
+      pending[i]->cached_voter_.set(voters[i]);
+    }
+  }
+
   /**
    * @brief Get voter address
    * @return voter address
@@ -72,9 +95,9 @@ class Vote {
   blk_hash_t block_hash_;  // Voted block hash
   sig_t vote_signature_;
 
-  mutable vote_hash_t vote_hash_;  // hash of this vote
-  mutable public_t cached_voter_;
-  mutable addr_t cached_voter_addr_;
+  util::OnceValue<vote_hash_t> vote_hash_;  // hash of this vote
+  util::OnceValue<public_t> cached_voter_;
+  util::OnceValue<addr_t> cached_voter_addr_;
 };
 
 /** @}*/
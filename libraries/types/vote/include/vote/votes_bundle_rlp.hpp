@@ -22,6 +22,9 @@ constexpr static size_t kPbftVotesBundleRlpSize{5};
 /**
  * @brief Encodes pbft votes into optimized votes bundle rlp
  *
+ * Layout: [block hash, period, round, step, [[vrf proof, signature], ...]], weights are not encoded and get recomputed
+ * from voter stake on validation. All votes must share the reference block hash, period, round and step.
+ *
  * @param votes
  * @return votes bundle rlp bytes
  */
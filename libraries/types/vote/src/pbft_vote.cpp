@@ -29,7 +29,7 @@ PbftVote::PbftVote(const blk_hash_t& block_hash, PbftPeriod period, PbftRound ro
 
   vrf_sortition_ = std::move(vrf_sortition);
   vote_signature_ = std::move(vote_signature);
-  vote_hash_ = sha3(true);
+  vote_hash_.set(sha3(true));
 }
 
 PbftVote::PbftVote(const dev::RLP& rlp) {
@@ -41,7 +41,7 @@ PbftVote::PbftVote(const dev::RLP& rlp) {
   }
 
   vrf_sortition_ = VrfPbftSortition(vrf_bytes);
-  vote_hash_ = sha3(true);
+  vote_hash_.set(sha3(true));
 }
 
 PbftVote::PbftVote(const bytes& b) : PbftVote(dev::RLP(b)) {}
@@ -79,13 +79,21 @@ bytes PbftVote::rlp(bool inc_sig, bool inc_weight) const {
 }
 
 bytes PbftVote::optimizedRlp() const {
-  dev::RLPStream s(2);
-  s << vrf_sortition_.proof_;
-  s << vote_signature_;
+  dev::RLPStream s;
+  s.reserve(optimizedRlpSize(), 0);
+  optimizedRlp(s);
 
   return s.invalidate();
 }
 
+void PbftVote::optimizedRlp(dev::RLPStream& s) const {
+  s.appendList(2, util::rlp_size(vrf_sortition_.proof_) + util::rlp_size(vote_signature_));
+  s << vrf_sortition_.proof_;
+  s << vote_signature_;
+}
+
+size_t PbftVote::optimizedRlpSize() const { return util::rlp_tuple_size(vrf_sortition_.proof_, vote_signature_); }
+
 Json::Value PbftVote::toJSON() const {
   Json::Value json(Json::objectValue);
   json["hash"] = dev::toJS(getHash());
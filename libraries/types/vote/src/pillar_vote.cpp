@@ -19,7 +19,7 @@ PillarVote::PillarVote(PbftPeriod period, const blk_hash_t& block_hash, sig_t&&
 
 PillarVote::PillarVote(const dev::RLP& rlp) {
   util::rlp_tuple(util::RLPDecoderRef(rlp, true), period_, block_hash_, vote_signature_);
-  vote_hash_ = sha3(true);
+  vote_hash_.set(sha3(true));
 }
 
 PillarVote::PillarVote(const bytes& b) : PillarVote(dev::RLP(b)) {}
@@ -8,23 +8,21 @@ Vote::Vote(const blk_hash_t& block_hash) : block_hash_(block_hash) {}
 
 void Vote::signVote(const secret_t& node_sk) {
   vote_signature_ = dev::sign(node_sk, sha3(false));
-  cached_voter_ = dev::toPublic(node_sk);
-  cached_voter_addr_ = dev::toAddress(cached_voter_);
+  const auto voter = dev::toPublic(node_sk);
+  cached_voter_.set(voter);
+  cached_voter_addr_.set(dev::toAddress(voter));
 }
 
 const vote_hash_t& Vote::getHash() const {
-  if (!vote_hash_) vote_hash_ = sha3(true);
-  return vote_hash_;
+  return vote_hash_.get([this] { return sha3(true); });
 }
 
 const public_t& Vote::getVoter() const {
-  if (!cached_voter_) cached_voter_ = dev::recover(vote_signature_, sha3(false));
-  return cached_voter_;
+  return cached_voter_.get([this] { return dev::recover(vote_signature_, sha3(false)); });
 }
 
 const addr_t& Vote::getVoterAddr() const {
-  if (!cached_voter_addr_) cached_voter_addr_ = dev::toAddress(getVoter());
-  return cached_voter_addr_;
+  return cached_voter_addr_.get([this] { return dev::toAddress(getVoter()); });
 }
 
 const sig_t& Vote::getVoteSignature() const { return vote_signature_; }
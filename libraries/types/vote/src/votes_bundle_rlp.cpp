@@ -16,15 +16,26 @@ dev::bytes encodePbftVotesBundleRlp(const std::vector<std::shared_ptr<PbftVote>>
   const auto reference_round = votes.back()->getRound();
   const auto reference_step = votes.back()->getStep();
 
-  dev::RLPStream votes_bundle_rlp(kPbftVotesBundleRlpSize);
+  // Sizes are computed first, so the bundle is written into a single buffer without moving the votes
+  size_t votes_size = 0;
+  for (const auto& vote : votes) {
+    votes_size += vote->optimizedRlpSize();
+  }
+  const auto bundle_size = util::rlp_size(reference_block_hash) + util::rlp_size(reference_period) +
+                           util::rlp_size(reference_round) + util::rlp_size(reference_step) +
+                           dev::rlpListSize(votes_size);
+
+  dev::RLPStream votes_bundle_rlp;
+  votes_bundle_rlp.reserve(dev::rlpListSize(bundle_size), 0);
+  votes_bundle_rlp.appendList(kPbftVotesBundleRlpSize, bundle_size);
   votes_bundle_rlp.append(reference_block_hash);
   votes_bundle_rlp.append(reference_period);
   votes_bundle_rlp.append(reference_round);
   votes_bundle_rlp.append(reference_step);
-  votes_bundle_rlp.appendList(votes.size());
+  votes_bundle_rlp.appendList(votes.size(), votes_size);
 
   for (const auto& vote : votes) {
-    votes_bundle_rlp.appendRaw(vote->optimizedRlp());
+    vote->optimizedRlp(votes_bundle_rlp);
   }
 
   return votes_bundle_rlp.invalidate();
@@ -33,16 +44,18 @@ dev::bytes encodePbftVotesBundleRlp(const std::vector<std::shared_ptr<PbftVote>>
 std::vector<std::shared_ptr<PbftVote>> decodePbftVotesBundleRlp(const dev::RLP& votes_bundle_rlp) {
   assert(votes_bundle_rlp.itemCount() == kPbftVotesBundleRlpSize);
 
-  const blk_hash_t votes_bundle_block_hash = votes_bundle_rlp[0].toHash<blk_hash_t>();
-  const PbftPeriod votes_bundle_pbft_period = votes_bundle_rlp[1].toInt<PbftPeriod>();
-  const PbftRound votes_bundle_pbft_round = votes_bundle_rlp[2].toInt<PbftRound>();
-  const PbftStep votes_bundle_votes_step = votes_bundle_rlp[3].toInt<PbftStep>();
+  const util::RLPIndex bundle(votes_bundle_rlp);
+  const blk_hash_t votes_bundle_block_hash = bundle[0].toHash<blk_hash_t>();
+  const PbftPeriod votes_bundle_pbft_period = bundle[1].toInt<PbftPeriod>();
+  const PbftRound votes_bundle_pbft_round = bundle[2].toInt<PbftRound>();
+  const PbftStep votes_bundle_votes_step = bundle[3].toInt<PbftStep>();
 
+  const auto votes_rlp = bundle[4];
   std::vector<std::shared_ptr<PbftVote>> votes;
-  votes.reserve(votes_bundle_rlp[4].itemCount());
+  votes.reserve(votes_rlp.itemCount());
 
-  for (const auto vote_rlp : votes_bundle_rlp[4]) {
-    auto vote = std::make_shared<PbftVote>(votes_bundle_block_hash, votes_bundle_pbft_period, votes_bundle_pbft_round,
+  for (const auto vote_rlp : votes_rlp) {
+    auto vote = util::makeShared<PbftVote>(votes_bundle_block_hash, votes_bundle_pbft_period, votes_bundle_pbft_round,
                                            votes_bundle_votes_step, vote_rlp);
     votes.push_back(std::move(vote));
   }
@@ -66,13 +79,22 @@ dev::bytes encodePillarVotesBundleRlp(const std::vector<std::shared_ptr<PillarVo
   const auto& reference_block_hash = votes.back()->getBlockHash();
   const auto reference_period = votes.back()->getPeriod();
 
-  dev::RLPStream votes_bundle_rlp(kPillarVotesBundleRlpSize);
+  size_t votes_size = 0;
+  for (const auto& vote : votes) {
+    votes_size += util::rlp_size(vote->getVoteSignature());
+  }
+  const auto bundle_size =
+      util::rlp_size(reference_block_hash) + util::rlp_size(reference_period) + dev::rlpListSize(votes_size);
+
+  dev::RLPStream votes_bundle_rlp;
+  votes_bundle_rlp.reserve(dev::rlpListSize(bundle_size), 0);
+  votes_bundle_rlp.appendList(kPillarVotesBundleRlpSize, bundle_size);
   votes_bundle_rlp.append(reference_block_hash);
   votes_bundle_rlp.append(reference_period);
-  votes_bundle_rlp.appendList(votes.size());
+  votes_bundle_rlp.appendList(votes.size(), votes_size);
 
   for (const auto& vote : votes) {
-    votes_bundle_rlp.appendRaw(util::rlp_enc(vote->getVoteSignature()));
+    votes_bundle_rlp.append(vote->getVoteSignature());
   }
 
   return votes_bundle_rlp.invalidate();
@@ -81,13 +103,15 @@ dev::bytes encodePillarVotesBundleRlp(const std::vector<std::shared_ptr<PillarVo
 std::vector<std::shared_ptr<PillarVote>> decodePillarVotesBundleRlp(const dev::RLP& votes_bundle_rlp) {
   assert(votes_bundle_rlp.itemCount() == kPillarVotesBundleRlpSize);
 
-  const blk_hash_t votes_bundle_block_hash = votes_bundle_rlp[0].toHash<blk_hash_t>();
-  const PbftPeriod votes_bundle_pbft_period = votes_bundle_rlp[1].toInt<PbftPeriod>();
+  const util::RLPIndex bundle(votes_bundle_rlp);
+  const blk_hash_t votes_bundle_block_hash = bundle[0].toHash<blk_hash_t>();
+  const PbftPeriod votes_bundle_pbft_period = bundle[1].toInt<PbftPeriod>();
 
+  const auto votes_rlp = bundle[2];
   std::vector<std::shared_ptr<PillarVote>> votes;
-  votes.reserve(votes_bundle_rlp[2].itemCount());
+  votes.reserve(votes_rlp.itemCount());
 
-  for (const auto sig_rlp : votes_bundle_rlp[2]) {
+  for (const auto sig_rlp : votes_rlp) {
     auto vote_sig = util::rlp_dec<sig_t>(sig_rlp);
     auto vote = std::make_shared<PillarVote>(votes_bundle_pbft_period, votes_bundle_block_hash, std::move(vote_sig));
     votes.push_back(std::move(vote));
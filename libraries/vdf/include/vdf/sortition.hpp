@@ -24,6 +24,30 @@ class VdfSortition : public vrf_wrapper::VrfSortitionBase {
 
   void computeVdfSolution(const SortitionParams& config, const bytes& msg, const std::atomic_bool& cancelled);
 
+  /**
+   * @brief Computes VDF solution for msg, difficulty is the VDF time parameter (2^difficulty sequential squarings)
+   *
+   * @param lambda_bound
+   * @param difficulty
+   * @param msg
+   * @param cancelled computation is interrupted once set
+   * @return solution, empty if computation was cancelled
+   */
+  static std::pair<bytes, bytes> solve(uint16_t lambda_bound, uint16_t difficulty, const bytes& msg,
+                                       const std::atomic_bool& cancelled);
+
+  /**
+   * @brief Verifies VDF solution for msg
+   *
+   * @param lambda_bound
+   * @param difficulty
+   * @param msg
+   * @param solution
+   * @return true if solution is valid
+   */
+  static bool verifySolution(uint16_t lambda_bound, uint16_t difficulty, const bytes& msg,
+                             const std::pair<bytes, bytes>& solution);
+
   void verifyVdf(SortitionParams const& config, bytes const& vrf_input, const vrf_pk_t& pk, bytes const& vdf_input,
                  uint64_t vote_count, uint64_t total_vote_count) const;
 
@@ -71,13 +71,24 @@ Json::Value VdfSortition::getJson() const {
 void VdfSortition::computeVdfSolution(const SortitionParams& config, const bytes& msg,
                                       const std::atomic_bool& cancelled) {
   auto t1 = getCurrentTimeMilliSeconds();
-  VerifierWesolowski verifier(config.vdf.lambda_bound, difficulty_, msg, N);
-  ProverWesolowski prover;
-  vdf_sol_ = prover(verifier, cancelled);  // this line takes time ...
+  vdf_sol_ = solve(config.vdf.lambda_bound, difficulty_, msg, cancelled);  // this line takes time ...
   auto t2 = getCurrentTimeMilliSeconds();
   vdf_computation_time_ = t2 - t1;
 }
 
+std::pair<bytes, bytes> VdfSortition::solve(uint16_t lambda_bound, uint16_t difficulty, const bytes& msg,
+                                            const std::atomic_bool& cancelled) {
+  VerifierWesolowski verifier(lambda_bound, difficulty, msg, N);
+  ProverWesolowski prover;
+  return prover(verifier, cancelled);
+}
+
+bool VdfSortition::verifySolution(uint16_t lambda_bound, uint16_t difficulty, const bytes& msg,
+                                  const std::pair<bytes, bytes>& solution) {
+  VerifierWesolowski verifier(lambda_bound, difficulty, msg, N);
+  return verifier(solution);
+}
+
 void VdfSortition::verifyVdf(SortitionParams const& config, bytes const& vrf_input, const vrf_pk_t& pk,
                              bytes const& vdf_input, uint64_t vote_count, uint64_t total_vote_count) const {
   // Verify VRF output
@@ -96,8 +107,7 @@ void VdfSortition::verifyVdf(SortitionParams const& config, bytes const& vrf_inp
   }
 
   // Verify VDF solution
-  VerifierWesolowski verifier(config.vdf.lambda_bound, getDifficulty(), vdf_input, N);
-  if (!verifier(vdf_sol_)) {
+  if (!verifySolution(config.vdf.lambda_bound, getDifficulty(), vdf_input, vdf_sol_)) {
     throw InvalidVdfSortition("VDF solution verification failed. VDF input " + dev::toHex(vdf_input) + ", lambda " +
                               std::to_string(config.vdf.lambda_bound) + ", difficulty " +
                               std::to_string(getDifficulty()));
@@ -7,6 +7,7 @@
 #include <boost/log/utility/exception_handler.hpp>
 #include <boost/program_options.hpp>
 #include <boost/program_options/options_description.hpp>
+#include <algorithm>
 #include <condition_variable>
 #include <cstdint>
 #include <filesystem>
@@ -19,6 +20,8 @@
 #include "common/thread_pool.hpp"
 #include "common/util.hpp"
 #include "config/version.hpp"
+#include "metrics/discovery_metrics.hpp"
+#include "metrics/metrics_service.hpp"
 
 namespace po = boost::program_options;
 namespace bi = boost::asio::ip;
@@ -110,7 +113,11 @@ int main(int argc, char** argv) {
   addNetworkingOption("chain-id", po::value<uint32_t>()->value_name("<id>"),
                       "Connect to default mainet/testnet/devnet bootnodes");
   addNetworkingOption("number-of-threads", po::value<uint32_t>()->value_name("<#>"),
-                      "Define number of threads for this bootnode (default: 1)");
+                      "Define number of threads for this bootnode, both io and packets crypto threads (default: 1)");
+  addNetworkingOption("metrics-ip", po::value<std::string>()->value_name("<ip>"),
+                      "Expose prometheus metrics on the given IP (default: 0.0.0.0)");
+  addNetworkingOption("metrics-port", po::value<uint16_t>()->value_name("<port>"),
+                      "Expose prometheus metrics on the given port, metrics are disabled if not specified");
   addNetworkingOption("wallet", po::value<std::string>(&wallet),
                       "JSON wallet file, if not specified key random generated");
   po::options_description allowedOptions("Allowed options");
@@ -154,6 +161,9 @@ int main(int argc, char** argv) {
   if (vm.count("listen")) listen_port = vm["listen"].as<uint16_t>();
   if (vm.count("number-of-threads")) num_of_threads = vm["number-of-threads"].as<uint32_t>();
 
+  std::string metrics_ip = "0.0.0.0";
+  if (vm.count("metrics-ip")) metrics_ip = vm["metrics-ip"].as<std::string>();
+
   setupLogging(logging_options);
   if (logging_options.verbosity > 0)
     std::cout << EthGrayBold << kProgramName << ", a Taraxa bootnode implementation" EthReset << std::endl;
@@ -175,6 +185,8 @@ int main(int argc, char** argv) {
   dev::p2p::TaraxaNetworkConfig taraxa_net_conf;
   taraxa_net_conf.is_boot_node = true;
   taraxa_net_conf.chain_id = chain_id;
+  // FindNode answers are signed on crypto threads, io threads only receive and send packets
+  taraxa_net_conf.crypto_threads = std::max<uint32_t>(num_of_threads, 1);
   auto network_file_path = taraxa::cli::tools::getTaraxaDefaultDir() / std::filesystem::path(kNetworkConfigFileName);
 
   auto boot_host = dev::p2p::Host::make(
@@ -188,6 +200,18 @@ int main(int argc, char** argv) {
     });
   }
 
+  std::shared_ptr<taraxa::metrics::MetricsService> metrics;
+  if (vm.count("metrics-port")) {
+    metrics = std::make_shared<taraxa::metrics::MetricsService>(metrics_ip, vm["metrics-port"].as<uint16_t>());
+    auto discovery_metrics = metrics->getMetrics<taraxa::metrics::DiscoveryMetrics>();
+    discovery_metrics->setNodesCountUpdater([boot_host] { return boot_host->discoveryStats().nodesCount; });
+    discovery_metrics->setPacketsReceivedUpdater([boot_host] { return boot_host->discoveryStats().packetsReceived; });
+    discovery_metrics->setPacketsRateLimitedUpdater(
+        [boot_host] { return boot_host->discoveryStats().packetsRateLimited; });
+    discovery_metrics->setFindNodeAnsweredUpdater([boot_host] { return boot_host->discoveryStats().findNodeAnswered; });
+    metrics->start();
+  }
+
   if (boot_host->isRunning()) {
     std::cout << "Node ID: " << boot_host->enode() << std::endl;
     if (static_cast<taraxa::cli::Config::ChainIdType>(chain_id) < taraxa::cli::Config::ChainIdType::LastNetworkId) {
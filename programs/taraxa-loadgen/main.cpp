@@ -0,0 +1,391 @@
+#include <libdevcore/CommonJS.h>
+#include <libdevcrypto/Common.h>
+
+#include <algorithm>
+#include <atomic>
+#include <boost/asio/connect.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "common/jsoncpp.hpp"
+#include "transaction/transaction.hpp"
+
+namespace po = boost::program_options;
+namespace http = boost::beast::http;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Options {
+  std::string host = "127.0.0.1";
+  std::string port = "7777";
+  std::string faucet_key;
+  uint32_t accounts = 100;
+  uint64_t transactions = 10000;
+  uint64_t tps = 0;
+  uint32_t batch = 100;
+  uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+  std::string call_to;
+  std::string call_data;
+  uint32_t call_percent = 0;
+  uint64_t gas = 21000;
+  uint64_t call_gas = 100000;
+  uint64_t value = 1;
+  uint64_t finalization_timeout_s = 60;
+};
+
+/**
+ * @brief Blocking json-rpc client over single keep-alive http connection
+ */
+class RpcClient {
+ public:
+  RpcClient(const std::string& host, const std::string& port) : host_(host), socket_(io_) {
+    boost::asio::ip::tcp::resolver resolver(io_);
+    boost::asio::connect(socket_, resolver.resolve(host, port));
+  }
+
+  Json::Value call(const std::string& method, Json::Value params = Json::Value(Json::arrayValue)) {
+    Json::Value request(Json::objectValue);
+    request["jsonrpc"] = "2.0";
+    request["id"] = 1;
+    request["method"] = method;
+    request["params"] = std::move(params);
+    const auto response = post(request);
+    if (response.isMember("error")) {
+      throw std::runtime_error(method + " failed: " + taraxa::util::to_string(response["error"]));
+    }
+    return response["result"];
+  }
+
+  /**
+   * @return responses in the order of requests
+   */
+  std::vector<Json::Value> batch(const std::string& method, const std::vector<Json::Value>& params) {
+    Json::Value requests(Json::arrayValue);
+    for (size_t i = 0; i < params.size(); i++) {
+      Json::Value request(Json::objectValue);
+      request["jsonrpc"] = "2.0";
+      request["id"] = Json::UInt64(i);
+      request["method"] = method;
+      request["params"] = params[i];
+      requests.append(std::move(request));
+    }
+    std::vector<Json::Value> res(params.size());
+    for (auto& response : post(requests)) {
+      if (const auto id = response["id"]; id.isUInt64() && id.asUInt64() < res.size()) {
+        res[id.asUInt64()] = response;
+      }
+    }
+    return res;
+  }
+
+ private:
+  Json::Value post(const Json::Value& body) {
+    http::request<http::string_body> request{http::verb::post, "/", 11};
+    request.set(http::field::host, host_);
+    request.set(http::field::content_type, "application/json");
+    request.keep_alive(true);
+    request.body() = taraxa::util::to_string(body);
+    request.prepare_payload();
+    http::write(socket_, request);
+
+    http::response<http::string_body> response;
+    http::read(socket_, buffer_, response);
+    return taraxa::util::parse_json(response.body());
+  }
+
+  const std::string host_;
+  boost::asio::io_context io_;
+  boost::asio::ip::tcp::socket socket_;
+  boost::beast::flat_buffer buffer_;
+};
+
+struct SignedTransaction {
+  taraxa::trx_hash_t hash;
+  std::string rlp;
+};
+
+/**
+ * @brief Signs transactions of accounts in parallel, transaction i is sent by account i % accounts with nonce
+ *        i / accounts, so every account has gapless nonces no matter how sending is interleaved
+ */
+std::vector<SignedTransaction> signTransactions(const Options& options, const std::vector<dev::KeyPair>& accounts,
+                                                const taraxa::val_t& gas_price, uint64_t chain_id) {
+  std::vector<SignedTransaction> res(options.transactions);
+  const auto call_to = options.call_to.empty() ? std::nullopt : std::optional(taraxa::addr_t(options.call_to));
+  const auto call_data = dev::jsToBytes(options.call_data);
+
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < options.threads; t++) {
+    threads.emplace_back([&, t] {
+      for (uint64_t i = t; i < options.transactions; i += options.threads) {
+        const auto& sender = accounts[i % accounts.size()];
+        const taraxa::trx_nonce_t nonce = i / accounts.size();
+        // Calls are spread evenly among transfers
+        const bool is_call = call_to && (i * options.call_percent / 100) != ((i + 1) * options.call_percent / 100);
+        const auto trx =
+            is_call ? taraxa::Transaction(nonce, 0, gas_price, options.call_gas, call_data, sender.secret(), call_to,
+                                          chain_id)
+                    : taraxa::Transaction(nonce, options.value, gas_price, options.gas, {}, sender.secret(),
+                                          accounts[(i + 1) % accounts.size()].address(), chain_id);
+        res[i] = {trx.getHash(), dev::toJS(trx.rlp())};
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return res;
+}
+
+/**
+ * @brief Sends value for all planned transactions from faucet to each account and waits till it is finalized
+ */
+void fundAccounts(RpcClient& rpc, const Options& options, const std::vector<dev::KeyPair>& accounts,
+                  const taraxa::val_t& gas_price, uint64_t chain_id) {
+  const dev::KeyPair faucet(dev::Secret(options.faucet_key, dev::Secret::ConstructFromStringType::FromHex));
+  Json::Value nonce_params(Json::arrayValue);
+  nonce_params.append(dev::toJS(faucet.address()));
+  nonce_params.append("latest");
+  const auto faucet_nonce = dev::jsToInt(rpc.call("eth_getTransactionCount", nonce_params).asString());
+
+  const uint64_t per_account = (options.transactions + accounts.size() - 1) / accounts.size();
+  const auto max_gas = std::max(options.gas, options.call_gas);
+  const taraxa::val_t funds = (gas_price * max_gas + options.value) * per_account;
+
+  std::vector<Json::Value> params;
+  for (size_t i = 0; i < accounts.size(); i++) {
+    const taraxa::Transaction trx(faucet_nonce + i, funds, gas_price, options.gas, {}, faucet.secret(),
+                                  accounts[i].address(), chain_id);
+    Json::Value p(Json::arrayValue);
+    p.append(dev::toJS(trx.rlp()));
+    params.push_back(std::move(p));
+    if (params.size() == options.batch || i + 1 == accounts.size()) {
+      for (const auto& response : rpc.batch("eth_sendRawTransaction", params)) {
+        if (response.isMember("error")) {
+          throw std::runtime_error("Funding transaction rejected: " + taraxa::util::to_string(response["error"]));
+        }
+      }
+      params.clear();
+    }
+  }
+
+  // Funding transactions have consecutive nonces, so the last funded account has balance only after all of them
+  Json::Value balance_params(Json::arrayValue);
+  balance_params.append(dev::toJS(accounts.back().address()));
+  balance_params.append("latest");
+  const auto deadline = Clock::now() + std::chrono::seconds(options.finalization_timeout_s);
+  while (dev::jsToU256(rpc.call("eth_getBalance", balance_params).asString()) == 0) {
+    if (Clock::now() > deadline) {
+      throw std::runtime_error("Funding transactions were not finalized in time");
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  }
+}
+
+struct SendStats {
+  std::vector<Clock::time_point> send_times;
+  std::atomic<uint64_t> accepted = 0;
+  std::atomic<uint64_t> rejected = 0;
+  Clock::time_point start;
+  Clock::time_point end;
+};
+
+void sendTransactions(RpcClient& rpc, const Options& options, const std::vector<SignedTransaction>& trxs,
+                      SendStats& stats) {
+  stats.start = Clock::now();
+  std::vector<Json::Value> params;
+  params.reserve(options.batch);
+  for (uint64_t first = 0; first < trxs.size(); first += options.batch) {
+    const auto last = std::min<uint64_t>(first + options.batch, trxs.size());
+    if (options.tps) {
+      std::this_thread::sleep_until(stats.start + std::chrono::microseconds(first * 1000000 / options.tps));
+    }
+    params.clear();
+    for (auto i = first; i < last; i++) {
+      Json::Value p(Json::arrayValue);
+      p.append(trxs[i].rlp);
+      params.push_back(std::move(p));
+    }
+    const auto now = Clock::now();
+    std::fill(stats.send_times.begin() + first, stats.send_times.begin() + last, now);
+    for (const auto& response : rpc.batch("eth_sendRawTransaction", params)) {
+      if (response.isMember("result")) {
+        stats.accepted++;
+      } else {
+        stats.rejected++;
+      }
+    }
+  }
+  stats.end = Clock::now();
+}
+
+/**
+ * @brief Polls finalized blocks and records when each sent transaction showed up in one of them
+ */
+void trackFinalization(RpcClient& rpc, const std::unordered_map<taraxa::trx_hash_t, uint64_t>& indexes,
+                       const SendStats& stats, std::vector<Clock::time_point>& finalized,
+                       const std::atomic<bool>& sending_done, uint64_t timeout_s) {
+  uint64_t next_block = dev::jsToInt(rpc.call("eth_blockNumber").asString()) + 1;
+  uint64_t finalized_count = 0;
+  auto last_progress = Clock::now();
+  while (finalized_count < indexes.size()) {
+    const auto head = dev::jsToInt(rpc.call("eth_blockNumber").asString());
+    for (; next_block <= head; next_block++) {
+      Json::Value params(Json::arrayValue);
+      params.append(dev::toJS(next_block));
+      params.append(false);
+      const auto block = rpc.call("eth_getBlockByNumber", params);
+      const auto now = Clock::now();
+      for (const auto& hash : block["transactions"]) {
+        if (const auto it = indexes.find(taraxa::trx_hash_t(hash.asString())); it != indexes.end()) {
+          finalized[it->second] = now;
+          finalized_count++;
+          last_progress = now;
+        }
+      }
+    }
+    if (sending_done && finalized_count + stats.rejected >= indexes.size()) {
+      break;
+    }
+    if (sending_done && Clock::now() - last_progress > std::chrono::seconds(timeout_s)) {
+      std::cerr << "No transaction finalized for " << timeout_s << " s, stopping" << std::endl;
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+}
+
+void printReport(const SendStats& stats, const std::vector<Clock::time_point>& finalized) {
+  std::vector<double> latencies_ms;
+  Clock::time_point last_finalized = stats.start;
+  for (size_t i = 0; i < finalized.size(); i++) {
+    if (finalized[i] != Clock::time_point{}) {
+      latencies_ms.push_back(std::chrono::duration<double, std::milli>(finalized[i] - stats.send_times[i]).count());
+      last_finalized = std::max(last_finalized, finalized[i]);
+    }
+  }
+  std::sort(latencies_ms.begin(), latencies_ms.end());
+  const auto percentile = [&latencies_ms](double p) {
+    return latencies_ms.empty() ? 0 : latencies_ms[std::min<size_t>(latencies_ms.size() * p, latencies_ms.size() - 1)];
+  };
+
+  const double send_s = std::chrono::duration<double>(stats.end - stats.start).count();
+  const double finalize_s = std::chrono::duration<double>(last_finalized - stats.start).count();
+  std::cout << std::fixed << std::setprecision(1) << "sent " << finalized.size() << " transactions in " << send_s
+            << " s, accepted " << stats.accepted << ", rejected " << stats.rejected << std::endl
+            << "accepted TPS:  " << (send_s > 0 ? stats.accepted / send_s : 0) << std::endl
+            << "finalized " << latencies_ms.size() << " transactions in " << finalize_s << " s" << std::endl
+            << "finalized TPS: " << (finalize_s > 0 ? latencies_ms.size() / finalize_s : 0) << std::endl
+            << "inclusion latency ms: p50 " << percentile(0.5) << ", p90 " << percentile(0.9) << ", p99 "
+            << percentile(0.99) << ", max " << (latencies_ms.empty() ? 0 : latencies_ms.back()) << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+  Options options;
+  std::string rpc_address;
+  po::options_description description("taraxa-loadgen - sends pre-signed transactions to a node over json-rpc");
+  // clang-format off
+  description.add_options()
+      ("help,h", "Print this help")
+      ("rpc", po::value<std::string>(&rpc_address)->default_value("127.0.0.1:7777"), "Http rpc of the node <host:port>")
+      ("faucet-key", po::value<std::string>(&options.faucet_key)->required(), "Secret key of account funding the load")
+      ("accounts", po::value<uint32_t>(&options.accounts)->default_value(options.accounts), "Number of senders")
+      ("transactions", po::value<uint64_t>(&options.transactions)->default_value(options.transactions),
+       "Total number of transactions")
+      ("tps", po::value<uint64_t>(&options.tps)->default_value(options.tps), "Target send rate, 0 = unlimited")
+      ("batch", po::value<uint32_t>(&options.batch)->default_value(options.batch),
+       "Transactions per eth_sendRawTransaction batch request")
+      ("threads", po::value<uint32_t>(&options.threads)->default_value(options.threads), "Signing threads")
+      ("value", po::value<uint64_t>(&options.value)->default_value(options.value), "Value of transfers")
+      ("gas", po::value<uint64_t>(&options.gas)->default_value(options.gas), "Gas of transfers")
+      ("call-to", po::value<std::string>(&options.call_to), "Contract called by part of the transactions")
+      ("call-data", po::value<std::string>(&options.call_data), "Hex input of contract calls")
+      ("call-percent", po::value<uint32_t>(&options.call_percent)->default_value(options.call_percent),
+       "Percent of transactions that call the contract")
+      ("call-gas", po::value<uint64_t>(&options.call_gas)->default_value(options.call_gas), "Gas of contract calls")
+      ("timeout", po::value<uint64_t>(&options.finalization_timeout_s)->default_value(options.finalization_timeout_s),
+       "Seconds without any finalized transaction after which the run ends");
+  // clang-format on
+
+  try {
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, description), vm);
+    if (vm.count("help")) {
+      std::cout << description << std::endl;
+      return 0;
+    }
+    po::notify(vm);
+    const auto colon = rpc_address.rfind(':');
+    if (colon == std::string::npos) {
+      throw std::invalid_argument("rpc address must be <host:port>");
+    }
+    options.host = rpc_address.substr(0, colon);
+    options.port = rpc_address.substr(colon + 1);
+    if (!options.accounts || !options.transactions || !options.batch || !options.threads ||
+        options.call_percent > 100) {
+      throw std::invalid_argument("accounts, transactions, batch and threads must be positive, call-percent <= 100");
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl << description << std::endl;
+    return 1;
+  }
+
+  try {
+    RpcClient rpc(options.host, options.port);
+    const auto chain_id = dev::jsToInt(rpc.call("eth_chainId").asString());
+    const auto gas_price = dev::jsToU256(rpc.call("eth_gasPrice").asString());
+
+    std::vector<dev::KeyPair> accounts;
+    accounts.reserve(options.accounts);
+    for (uint32_t i = 0; i < options.accounts; i++) {
+      accounts.push_back(dev::KeyPair::create());
+    }
+
+    auto start = Clock::now();
+    const auto trxs = signTransactions(options, accounts, gas_price, chain_id);
+    std::cout << "signed " << trxs.size() << " transactions in "
+              << std::chrono::duration<double>(Clock::now() - start).count() << " s" << std::endl;
+
+    start = Clock::now();
+    fundAccounts(rpc, options, accounts, gas_price, chain_id);
+    std::cout << "funded " << accounts.size() << " accounts in "
+              << std::chrono::duration<double>(Clock::now() - start).count() << " s" << std::endl;
+
+    std::unordered_map<taraxa::trx_hash_t, uint64_t> indexes;
+    indexes.reserve(trxs.size());
+    for (uint64_t i = 0; i < trxs.size(); i++) {
+      indexes.emplace(trxs[i].hash, i);
+    }
+
+    SendStats stats;
+    stats.send_times.resize(trxs.size());
+    std::vector<Clock::time_point> finalized(trxs.size());
+    std::atomic<bool> sending_done = false;
+    // Separate connection, so that polling blocks does not delay sending
+    std::thread tracker([&] {
+      RpcClient tracker_rpc(options.host, options.port);
+      trackFinalization(tracker_rpc, indexes, stats, finalized, sending_done, options.finalization_timeout_s);
+    });
+    sendTransactions(rpc, options, trxs, stats);
+    sending_done = true;
+    tracker.join();
+
+    printReport(stats, finalized);
+  } catch (const std::exception& e) {
+    std::cerr << "Load generation failed: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
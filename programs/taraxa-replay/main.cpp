@@ -0,0 +1,126 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "app/app.hpp"
+#include "cli/config.hpp"
+#include "common/config_exception.hpp"
+#include "common/init.hpp"
+#include "network/network.hpp"
+#include "network/tarcap/packets_capture.hpp"
+
+using namespace taraxa;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+void printUsage() {
+  std::cout << "Usage: taraxa-replay --capture FILE [--speed X] <taraxad node options>" << std::endl
+            << "Feeds packets recorded with network.packets_capture_path into packets thread pool of a node and "
+               "reports packets processing throughput."
+            << std::endl
+            << "  --capture FILE  packets log to replay" << std::endl
+            << "  --speed X       replay speed relative to the recorded one, 0 = as fast as possible (default 1)"
+            << std::endl
+            << "Run it on a copy of the node data dir the traffic was recorded against, with no boot nodes configured, "
+               "so only replayed packets are processed."
+            << std::endl;
+}
+
+struct ReplayOptions {
+  std::string capture;
+  double speed = 1;
+};
+
+/**
+ * @return replay options, argv is left with node options only
+ */
+ReplayOptions parseReplayOptions(std::vector<const char*>& argv) {
+  ReplayOptions options;
+  std::vector<const char*> node_argv{argv.front()};
+  for (size_t i = 1; i < argv.size(); ++i) {
+    const std::string arg = argv[i];
+    if ((arg == "--capture" || arg == "--speed") && i + 1 < argv.size()) {
+      if (arg == "--capture") {
+        options.capture = argv[++i];
+      } else {
+        options.speed = std::stod(argv[++i]);
+      }
+    } else {
+      node_argv.push_back(argv[i]);
+    }
+  }
+  argv = std::move(node_argv);
+  return options;
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+  static_init();
+
+  try {
+    std::vector<const char*> node_argv(argv, argv + argc);
+    const auto options = parseReplayOptions(node_argv);
+    if (options.capture.empty() || options.speed < 0) {
+      printUsage();
+      return 1;
+    }
+    network::tarcap::PacketsCapture::Reader reader(options.capture);
+
+    auto app = std::make_shared<App>();
+    cli::Config cli_conf;
+    cli_conf.parseCommandLine(static_cast<int>(node_argv.size()), node_argv.data(), app->registeredPlugins());
+    if (!cli_conf.nodeConfigured()) {
+      printUsage();
+      return 0;
+    }
+    app->init(cli_conf);
+    app->start();
+    const auto network = app->getNetwork();
+    const auto& packets_tp = network->getPacketsThreadPool();
+
+    uint64_t packets = 0;
+    uint64_t bytes = 0;
+    std::optional<std::chrono::microseconds> first_time;
+    const auto start = Clock::now();
+    while (auto record = reader.next()) {
+      if (!first_time) {
+        first_time = record->time;
+      }
+      if (options.speed > 0) {
+        const auto offset = std::chrono::duration<double, std::micro>(record->time - *first_time) / options.speed;
+        std::this_thread::sleep_until(start + std::chrono::duration_cast<Clock::duration>(offset));
+      }
+      ++packets;
+      bytes += record->rlp.size();
+      network->replayPacket(std::move(*record));
+    }
+    const auto pushed = Clock::now();
+
+    // Queue only holds packets not yet taken by a worker, the last few may still be processed
+    while (true) {
+      const auto [hp_queue_size, mp_queue_size, lp_queue_size] = packets_tp->getQueueSize();
+      if (hp_queue_size + mp_queue_size + lp_queue_size == 0) {
+        break;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    const double push_seconds = std::chrono::duration<double>(pushed - start).count();
+
+    std::cout << std::fixed << std::setprecision(2) << "Replayed " << packets << " packets (" << bytes / 1024
+              << " KB) in " << seconds << " s, pushing took " << push_seconds << " s: " << packets / seconds
+              << " packets/s" << std::endl;
+    return 0;
+  } catch (taraxa::ConfigException const& e) {
+    std::cerr << "Configuration exception: " << e.what() << std::endl;
+  } catch (...) {
+    std::cerr << boost::current_exception_diagnostic_information() << std::endl;
+  }
+  return 1;
+}
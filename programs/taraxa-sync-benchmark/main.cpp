@@ -0,0 +1,89 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include "app/app.hpp"
+#include "cli/config.hpp"
+#include "common/config_exception.hpp"
+#include "common/init.hpp"
+#include "common/stage_timings.hpp"
+#include "final_chain/final_chain.hpp"
+#include "pbft/pbft_chain.hpp"
+
+using namespace taraxa;
+
+namespace {
+
+void printUsage() {
+  std::cout << "Usage: taraxa-sync-benchmark --rebuild-db [--rebuild-db-period N] <taraxad node options>" << std::endl
+            << "Replays period data recorded in the node data dir through PBFT and final chain without networking, "
+               "the same way --rebuild-db does, and reports sync throughput with per stage time breakdown."
+            << std::endl
+            << "Recorded db is moved into a backup dir by the replay, run it on a copy of the data dir." << std::endl;
+}
+
+void printReport(const App& app, const util::StageTimings& timings, std::chrono::nanoseconds elapsed) {
+  const auto blocks = app.getPbftChain()->getPbftChainSize();
+  const auto trxs = app.getDB()->getNumTransactionExecuted();
+  const double seconds = std::chrono::duration<double>(elapsed).count();
+
+  std::cout << std::fixed << std::setprecision(2) << "Replayed " << blocks << " blocks with " << trxs
+            << " transactions in " << seconds << " s: " << blocks / seconds << " blocks/s, " << trxs / seconds
+            << " trxs/s" << std::endl;
+  if (!blocks) {
+    return;
+  }
+
+  // Stages run on different threads and overlap, so shares of replay time can add up to more than 100%
+  std::cout << std::left << std::setw(16) << "stage" << std::right << std::setw(12) << "total s" << std::setw(12)
+            << "ms/block" << std::setw(10) << "share" << std::endl;
+  for (const auto& stage : timings.stages()) {
+    const double stage_seconds = std::chrono::duration<double>(stage.total).count();
+    std::cout << std::left << std::setw(16) << stage.name << std::right << std::setprecision(3) << std::setw(12)
+              << stage_seconds << std::setw(12) << stage_seconds * 1000 / blocks << std::setprecision(1)
+              << std::setw(9) << stage_seconds * 100 / seconds << "%" << std::endl;
+  }
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+  static_init();
+
+  try {
+    auto app = std::make_shared<App>();
+
+    cli::Config cli_conf;
+    cli_conf.parseCommandLine(argc, argv, app->registeredPlugins());
+    if (!cli_conf.nodeConfigured()) {
+      printUsage();
+      return 0;
+    }
+    if (!cli_conf.getNodeConfiguration().db_config.rebuild_db) {
+      printUsage();
+      return 1;
+    }
+
+    app->init(cli_conf);
+    auto timings = std::make_shared<util::StageTimings>();
+    app->setStageTimings(timings);
+
+    const auto start = std::chrono::steady_clock::now();
+    // Replays the whole recorded range and returns without starting the node
+    app->start();
+    // Last pushed block may still be executed or committed
+    const auto& final_chain = app->getFinalChain();
+    while (final_chain->lastBlockNumber() < app->getPbftChain()->getPbftChainSize()) {
+      final_chain->waitForFinalized();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    printReport(*app, *timings, elapsed);
+    return 0;
+  } catch (taraxa::ConfigException const& e) {
+    std::cerr << "Configuration exception: " << e.what() << std::endl;
+  } catch (...) {
+    std::cerr << boost::current_exception_diagnostic_information() << std::endl;
+  }
+  return 1;
+}
@@ -0,0 +1,102 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "vdf/config.hpp"
+#include "vdf/sortition.hpp"
+
+namespace {
+
+struct Options {
+  uint16_t difficulty_min = 16;
+  uint16_t difficulty_max = 21;
+  uint16_t lambda_bound = VdfParams().lambda_bound;
+  uint32_t runs = 3;
+};
+
+void printUsage() {
+  std::cout << "Usage: taraxa-vdf-benchmark [difficulty_min] [difficulty_max] [runs] [lambda_bound]" << std::endl
+            << "Measures VDF solving speed of this machine for each difficulty in <difficulty_min, difficulty_max>"
+            << std::endl;
+}
+
+void printCpuFeatures() {
+  std::cout << "CPU features:";
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  std::cout << " bmi2=" << (__builtin_cpu_supports("bmi2") ? "yes" : "no")
+            << " avx2=" << (__builtin_cpu_supports("avx2") ? "yes" : "no")
+            << " avx512f=" << (__builtin_cpu_supports("avx512f") ? "yes" : "no")
+            << " avx512ifma=" << (__builtin_cpu_supports("avx512ifma") ? "yes" : "no");
+#else
+  std::cout << " n/a";
+#endif
+  std::cout << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+  using namespace taraxa;
+
+  Options options;
+  try {
+    if (argc > 1 && (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help")) {
+      printUsage();
+      return 0;
+    }
+    if (argc > 1) {
+      options.difficulty_min = std::stoul(argv[1]);
+    }
+    if (argc > 2) {
+      options.difficulty_max = std::stoul(argv[2]);
+    }
+    if (argc > 3) {
+      options.runs = std::stoul(argv[3]);
+    }
+    if (argc > 4) {
+      options.lambda_bound = std::stoul(argv[4]);
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Invalid argument: " << e.what() << std::endl;
+    printUsage();
+    return 1;
+  }
+
+  if (options.difficulty_min > options.difficulty_max || options.difficulty_max >= 64 || !options.runs) {
+    printUsage();
+    return 1;
+  }
+
+  printCpuFeatures();
+  std::cout << "lambda bound: " << options.lambda_bound << ", runs per difficulty: " << options.runs << std::endl;
+
+  const std::atomic_bool cancelled = false;
+  for (uint16_t difficulty = options.difficulty_min; difficulty <= options.difficulty_max; difficulty++) {
+    std::chrono::nanoseconds total{0};
+    for (uint32_t run = 0; run < options.runs; run++) {
+      // Different message every run, so the solutions can't be reused
+      const bytes msg = dev::asBytes("vdf-benchmark-" + std::to_string(difficulty) + "-" + std::to_string(run));
+
+      const auto start = std::chrono::steady_clock::now();
+      const auto solution = vdf_sortition::VdfSortition::solve(options.lambda_bound, difficulty, msg, cancelled);
+      total += std::chrono::steady_clock::now() - start;
+
+      if (!vdf_sortition::VdfSortition::verifySolution(options.lambda_bound, difficulty, msg, solution)) {
+        std::cerr << "Invalid VDF solution for difficulty " << difficulty << std::endl;
+        return 1;
+      }
+    }
+
+    const double seconds = std::chrono::duration<double>(total).count() / options.runs;
+    // Time includes proof generation, so this is the effective rate seen by dag block proposer
+    const double squarings_per_second = static_cast<double>(uint64_t(1) << difficulty) / seconds;
+    std::cout << "difficulty " << std::setw(2) << difficulty << ": " << std::fixed << std::setprecision(3) << seconds
+              << " s per solution, " << std::setprecision(0) << squarings_per_second << " squarings/sec" << std::endl;
+  }
+
+  return 0;
+}
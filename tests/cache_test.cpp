@@ -1,7 +1,12 @@
 #include "final_chain/cache.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <optional>
+#include <thread>
 
+#include "common/util.hpp"
 #include "test_util/gtest.hpp"
 
 namespace taraxa::final_chain {
@@ -12,26 +17,27 @@ struct CacheTest : WithDataDir {};
 class ValueCacheTestable : public ValueByBlockCache<uint64_t> {
  public:
   ValueCacheTestable(uint64_t limit) : ValueByBlockCache<uint64_t>(limit, [](uint64_t a) { return a; }) {}
-  uint64_t blocksSize() { return data_by_block_.size(); }
+  uint64_t blocksSize() {
+    return std::count_if(slots_.begin(), slots_.end(), [](const auto &slot) { return slot.load() != nullptr; });
+  }
 
-  bool haveBlock(uint64_t block) { return data_by_block_.contains(block); }
+  bool haveBlock(uint64_t block) { return getFromCache(block).has_value(); }
 };
 
 class MapCacheTestable : public MapByBlockCache<uint64_t, uint64_t> {
  public:
   MapCacheTestable(uint64_t limit)
       : MapByBlockCache<uint64_t, uint64_t>(limit, [](uint64_t a, uint64_t) { return a; }) {}
-  uint64_t blocksSize() { return data_by_block_.size(); }
-
-  bool haveBlock(uint64_t block) { return data_by_block_.contains(block); }
+  uint64_t blocksSize() {
+    return std::count_if(slots_.begin(), slots_.end(), [](const auto &slot) { return slot.used; });
+  }
 
-  bool contains(uint64_t block, uint64_t key) {
-    auto block_data = data_by_block_.find(block);
-    if (block_data != data_by_block_.end()) {
-      return block_data->second.contains(key);
-    }
-    return false;
+  bool haveBlock(uint64_t block) {
+    const auto &slot = slots_[block % kBlocksToKeep];
+    return slot.used && slot.block_num == block;
   }
+
+  bool contains(uint64_t block, uint64_t key) { return getFromCache(block, key).has_value(); }
 };
 
 TEST_F(CacheTest, value_caching) {
@@ -122,6 +128,83 @@ TEST_F(CacheTest, map_overwrite) {
   EXPECT_EQ(cache.blocksSize(), 3);
 }
 
+TEST_F(CacheTest, memory_usage) {
+  ValueByBlockCache<std::vector<uint8_t>> value_cache(
+      2, [](uint64_t blk) { return std::vector<uint8_t>(blk * 10); },
+      [](const std::vector<uint8_t>& v) { return v.size(); });
+  EXPECT_EQ(value_cache.memoryUsage(), 0);
+
+  value_cache.get(1);
+  const auto single_entry = value_cache.memoryUsage();
+  EXPECT_GT(single_entry, 10);
+  value_cache.get(2);
+  EXPECT_EQ(value_cache.memoryUsage(), 2 * single_entry + 10);
+  // Block 1 gets evicted
+  value_cache.get(3);
+  EXPECT_EQ(value_cache.memoryUsage(), 2 * single_entry + 30);
+
+  MapCacheTestable map_cache(1);
+  EXPECT_EQ(map_cache.get(1, 1), 1);
+  EXPECT_EQ(map_cache.get(1, 2), 1);
+  const auto block_usage = map_cache.memoryUsage();
+  EXPECT_GT(block_usage, 2 * sizeof(uint64_t));
+  // Duplicate insert does not change usage
+  map_cache.append(1, 1, 1);
+  EXPECT_EQ(map_cache.memoryUsage(), block_usage);
+  // Block 1 with both entries gets evicted
+  EXPECT_EQ(map_cache.get(2, 1), 2);
+  EXPECT_LT(map_cache.memoryUsage(), block_usage);
+}
+
+TEST_F(CacheTest, expiration_cache_resize) {
+  ExpirationCacheMap<uint64_t, uint64_t> cache(10, 2);
+  for (uint64_t i = 0; i < 10; ++i) {
+    cache.insert(i, i);
+  }
+  // Shrunk cache drops the oldest entries right away
+  cache.setMaxSize(4, 1);
+  EXPECT_EQ(cache.maxSize(), 4);
+  EXPECT_EQ(cache.size(), 4);
+  EXPECT_FALSE(cache.count(5));
+  EXPECT_TRUE(cache.count(6));
+  cache.insert(10, 10);
+  EXPECT_EQ(cache.size(), 4);
+  EXPECT_FALSE(cache.count(6));
+
+  cache.setMaxSize(100, 10);
+  for (uint64_t i = 11; i < 50; ++i) {
+    cache.insert(i, i);
+  }
+  EXPECT_EQ(cache.size(), 43);
+}
+
+TEST_F(CacheTest, concurrent_misses) {
+  std::atomic<size_t> getter_calls = 0;
+  ValueByBlockCache<uint64_t> cache(3, [&](uint64_t blk) {
+    ++getter_calls;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    return blk;
+  });
+
+  // Same missing block requested from many threads is read only once
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 8; ++i) {
+    threads.emplace_back([&] { EXPECT_EQ(cache.get(2), 2); });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(getter_calls, 1);
+  EXPECT_EQ(cache.lastBlockNum(), 2);
+  EXPECT_EQ(cache.last(), 2);
+
+  // Older block doesn't replace newer one in the same slot
+  cache.append(5, 5);
+  cache.append(2, 3);
+  EXPECT_EQ(cache.getFromCache(5), 5);
+  EXPECT_FALSE(cache.getFromCache(2).has_value());
+}
+
 }  // namespace taraxa::final_chain
 
 TARAXA_TEST_MAIN({})
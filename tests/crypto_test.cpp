@@ -307,6 +307,16 @@ TEST_F(CryptoTest, vdf_proof_verify) {
                VdfSortition::InvalidVdfSortition);
 }
 
+TEST_F(CryptoTest, vdf_solve_verify) {
+  const uint16_t lambda_bound = 1500;
+  const uint16_t difficulty = 5;
+  const auto msg = blk_hash_t(200).asBytes();
+  const auto solution = VdfSortition::solve(lambda_bound, difficulty, msg, false);
+  EXPECT_TRUE(VdfSortition::verifySolution(lambda_bound, difficulty, msg, solution));
+  EXPECT_FALSE(VdfSortition::verifySolution(lambda_bound, difficulty + 1, msg, solution));
+  EXPECT_FALSE(VdfSortition::verifySolution(lambda_bound, difficulty, blk_hash_t(201).asBytes(), solution));
+}
+
 TEST_F(CryptoTest, DISABLED_compute_vdf_solution_cost_time) {
   vrf_sk_t sk(
       "0b6627a6680e01cea3d9f36fa797f7f34e8869c3a526d9ed63ed8170e35542aad05dc12c"
@@ -540,6 +550,48 @@ TEST_F(CryptoTest, leader_selection) {
   EXPECT_LE(diff, 5);
 }
 
+TEST_F(CryptoTest, batch_recover) {
+  std::vector<std::pair<dev::Signature, dev::h256>> batch;
+  std::vector<dev::Public> expected;
+  for (size_t i = 0; i < 5 * dev::c_minRecoverBatchPerThread + 3; ++i) {
+    const auto key = dev::KeyPair::create();
+    const auto hash = dev::h256::random();
+    batch.emplace_back(dev::sign(key.secret(), hash), hash);
+    expected.push_back(key.pub());
+  }
+  // Signature that does not recover stays empty at its position
+  batch[7].first[64] = 4;
+  expected[7] = {};
+
+  for (unsigned threads : {1, 2, 4, 16}) {
+    EXPECT_EQ(dev::recover(batch, threads), expected);
+  }
+  EXPECT_TRUE(dev::recover(std::vector<std::pair<dev::Signature, dev::h256>>(), 4).empty());
+}
+
+TEST_F(CryptoTest, sha3_batch) {
+  // Lengths around the keccak rate of 136 bytes, so inputs of a group absorb different numbers of blocks
+  std::vector<dev::bytes> inputs;
+  for (size_t size : {0, 1, 20, 32, 135, 136, 137, 271, 272, 1000, 0, 64, 300}) {
+    dev::bytes input(size);
+    for (auto& b : input) {
+      b = static_cast<dev::byte>(rand());
+    }
+    inputs.push_back(std::move(input));
+  }
+  for (size_t count = 0; count <= inputs.size(); ++count) {
+    std::vector<dev::bytesConstRef> refs;
+    for (size_t i = 0; i < count; ++i) {
+      refs.emplace_back(&inputs[i]);
+    }
+    std::vector<dev::h256> hashes(count);
+    dev::sha3Batch(refs, hashes.data());
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_EQ(hashes[i], dev::sha3(inputs[i]));
+    }
+  }
+}
+
 }  // namespace taraxa::core_tests
 
 using namespace taraxa;
@@ -9,6 +9,7 @@
 #include "common/types.hpp"
 #include "common/util.hpp"
 #include "dag/dag.hpp"
+#include "dag/dag_block_bundle_rlp.hpp"
 #include "dag/dag_block_proposer.hpp"
 #include "dag/dag_manager.hpp"
 #include "logger/logger.hpp"
@@ -168,6 +169,20 @@ TEST_F(DagBlockTest, sign_verify) {
   EXPECT_TRUE(blk2.verifySig());
 }
 
+TEST_F(DagBlockTest, bundle_hashes) {
+  std::vector<std::shared_ptr<DagBlock>> blocks;
+  blocks.push_back(std::make_shared<DagBlock>(blk_hash_t(111), 1, vec_blk_t{blk_hash_t(222), blk_hash_t(333)},
+                                              vec_trx_t{trx_hash_t(555), trx_hash_t(666)}, g_secret));
+  blocks.push_back(std::make_shared<DagBlock>(blk_hash_t(111), 2, vec_blk_t{}, vec_trx_t{trx_hash_t(666)}, g_secret));
+  blocks.push_back(std::make_shared<DagBlock>(blk_hash_t(9999), 3, vec_blk_t{}, vec_trx_t{}, g_secret));
+
+  const auto hashes = decodeDAGBlocksBundleHashes(dev::RLP(encodeDAGBlocksBundleRlp(blocks)));
+  ASSERT_EQ(hashes.size(), blocks.size());
+  for (size_t i = 0; i < blocks.size(); i++) {
+    EXPECT_EQ(hashes[i], blocks[i]->getHash());
+  }
+}
+
 TEST_F(DagBlockMgrTest, proposal_period) {
   auto node = create_nodes(1).front();
   auto db = node->getDB();
@@ -237,6 +252,17 @@ TEST_F(DagBlockMgrTest, incorrect_tx_estimation) {
     EXPECT_EQ(node->getDagManager()->verifyBlock(std::move(blk)).first,
               DagManager::VerifyBlockReturnType::IncorrectTransactionsEstimation);
   }
+
+  // VDF failure is reported without waiting for concurrently running estimation
+  {
+    vdf_sortition::VdfSortition wrong_vdf(vdf_config, node->getVrfSecretKey(),
+                                          VrfSortitionBase::makeVrfInput(propose_level, period_block_hash), 1, 1);
+    wrong_vdf.computeVdfSolution(vdf_config, DagManager::getVdfMessage(dag_genesis, vec_trx_t{}), false);
+    auto blk = std::make_shared<DagBlock>(dag_genesis, propose_level, vec_blk_t{}, vec_trx_t{trx->getHash()}, 100,
+                                          wrong_vdf, node->getSecretKey());
+    EXPECT_EQ(node->getDagManager()->verifyBlock(std::move(blk)).first,
+              DagManager::VerifyBlockReturnType::FailedVdfVerification);
+  }
 }
 
 TEST_F(DagBlockMgrTest, dag_block_tips_verification) {
@@ -341,6 +367,17 @@ TEST_F(DagBlockMgrTest, dag_block_tips_proposal) {
   }
 
   EXPECT_EQ(dag_blocks_hashes.size(), kDagBlockMaxTips + 1);
+  // Verify frontier index holds data of all the frontier tips
+  const auto frontier = node->getDagManager()->getDagFrontier();
+  const auto frontier_tips = node->getDagManager()->getDagFrontierTips();
+  EXPECT_EQ(frontier_tips->size(), frontier.tips.size());
+  for (const auto& t : frontier.tips) {
+    ASSERT_TRUE(frontier_tips->contains(t));
+    EXPECT_EQ(frontier_tips->at(t).proposer, node->getAddress());
+    EXPECT_EQ(frontier_tips->at(t).gas_estimation, dag_block_gas);
+    EXPECT_EQ(frontier_tips->at(t).level, 1u);
+  }
+
   // Verify selection is up to the gas limit
   uint64_t selection_gas_limit = 5 * dag_block_gas;
   auto selected_tips = node->getDagBlockProposer()->selectDagBlockTips(dag_blocks_hashes, selection_gas_limit);
@@ -129,6 +129,36 @@ TEST_F(DagTest, genesis_get_pivot) {
   EXPECT_EQ(leaves.size(), 1);
 }
 
+TEST_F(DagTest, ghost_path_incremental) {
+  const blk_hash_t GENESIS("0000000000000000000000000000000000000000000000000000000000000001");
+  taraxa::PivotTree graph(GENESIS, addr_t());
+
+  blk_hash_t v1("0000000000000000000000000000000000000000000000000000000000000002");
+  blk_hash_t v2("0000000000000000000000000000000000000000000000000000000000000003");
+  blk_hash_t v3("0000000000000000000000000000000000000000000000000000000000000004");
+  blk_hash_t v4("0000000000000000000000000000000000000000000000000000000000000005");
+  blk_hash_t v5("0000000000000000000000000000000000000000000000000000000000000006");
+
+  graph.addVEEs(v1, GENESIS, {});
+  graph.addVEEs(v2, GENESIS, {});
+  // Equal weights, smaller hash wins
+  EXPECT_EQ(graph.getGhostPath(GENESIS), std::vector<blk_hash_t>({GENESIS, v1}));
+
+  graph.addVEEs(v3, v2, {});
+  EXPECT_EQ(graph.getGhostPath(GENESIS), std::vector<blk_hash_t>({GENESIS, v2, v3}));
+
+  graph.addVEEs(v4, v1, {});
+  graph.addVEEs(v5, v4, {});
+  EXPECT_EQ(graph.getGhostPath(GENESIS), std::vector<blk_hash_t>({GENESIS, v1, v4, v5}));
+  EXPECT_EQ(graph.getGhostPath(v2), std::vector<blk_hash_t>({v2, v3}));
+
+  graph.clear();
+  graph.addVEEs(v3, blk_hash_t(), {});
+  graph.addVEEs(v4, v3, {});
+  EXPECT_EQ(graph.getGhostPath(v3), std::vector<blk_hash_t>({v3, v4}));
+  EXPECT_TRUE(graph.getGhostPath(GENESIS).empty());
+}
+
 // Use the example on Conflux paper
 TEST_F(DagTest, compute_epoch) {
   auto db_ptr = std::make_shared<DbStorage>(data_dir / "db");
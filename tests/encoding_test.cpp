@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include <libdevcore/RLP.h>
 
+#include <cctype>
+#include <random>
+
 #include "test_util/test_util.hpp"
 
 namespace taraxa::core_tests {
@@ -120,6 +123,114 @@ TEST_F(EncodingTest, rlp_nested_lists) {
   EXPECT_EQ(second[2].toInt<int>(), 5);
 }
 
+TEST_F(EncodingTest, rlp_presized_lists) {
+  struct Encoded {
+    uint64_t number = 0;
+    h256 hash;
+    std::vector<h256> hashes;
+    std::vector<std::vector<uint32_t>> indexes;
+    bytes data;
+    std::string text;
+
+    RLP_FIELDS_DEFINE_INPLACE(number, hash, hashes, indexes, data, text)
+  };
+  Encoded obj{1234567, h256::random(), {}, {{}, {1}, {0, 200, 70000}}, bytes(100, 0xab), "text"};
+  for (size_t i = 0; i < 10; ++i) {
+    obj.hashes.push_back(h256::random());
+  }
+  EXPECT_EQ(util::rlp_size(obj.hashes), util::rlp_enc(obj.hashes).size());
+  EXPECT_EQ(util::rlp_size(obj.indexes[2]), util::rlp_enc(obj.indexes[2]).size());
+  EXPECT_EQ(util::rlp_size(obj.data), util::rlp_enc(obj.data).size());
+
+  // Same bytes as lists whose prefix is inserted after items are written
+  dev::RLPStream expected(6);
+  expected << obj.number << obj.hash;
+  expected.appendList(obj.hashes.size());
+  for (const auto& h : obj.hashes) {
+    expected << h;
+  }
+  expected.appendList(obj.indexes.size());
+  for (const auto& idx : obj.indexes) {
+    expected.appendList(idx.size());
+    for (auto i : idx) {
+      expected << i;
+    }
+  }
+  expected << obj.data << obj.text;
+  const auto encoded = util::rlp_enc(obj);
+  EXPECT_EQ(encoded, expected.out());
+
+  const auto decoded = util::rlp_dec<Encoded>(dev::RLP(encoded));
+  EXPECT_EQ(decoded.hashes, obj.hashes);
+  EXPECT_EQ(decoded.indexes, obj.indexes);
+  EXPECT_EQ(decoded.data, obj.data);
+
+  // Presized list nested in a regular one
+  dev::RLPStream s(2);
+  s.appendList(obj.hashes.size(), util::rlp_payload_size(obj.hashes));
+  for (const auto& h : obj.hashes) {
+    s << h;
+  }
+  s << obj.number;
+  const auto nested = s.out();
+  const dev::RLP rlp(nested);
+  EXPECT_EQ(rlp.itemCount(), 2);
+  EXPECT_EQ(rlp[0].toVector<h256>(), obj.hashes);
+  EXPECT_EQ(rlp[1].toInt<uint64_t>(), obj.number);
+}
+
+TEST_F(EncodingTest, rlp_index) {
+  dev::RLPStream stream(4);
+  stream << 7 << "item";
+  stream.appendList(2);
+  stream << 1 << 2;
+  stream << bytes(100, 0xcd);
+  const auto bytes = stream.out();
+  const dev::RLP rlp(bytes);
+
+  const util::RLPIndex index(rlp);
+  EXPECT_EQ(index.size(), 4);
+  // Out of order access gives same items as scanning
+  for (size_t i : {3, 0, 2, 1}) {
+    EXPECT_EQ(index[i].data(), rlp[i].data());
+    EXPECT_EQ(index.data(i), rlp[i].data());
+  }
+  EXPECT_EQ(index[2][1].toInt<int>(), 2);
+  EXPECT_TRUE(index[4].isNull());
+  EXPECT_TRUE(index.data(4).empty());
+  EXPECT_EQ(util::RLPIndex(dev::RLP(dev::RLPEmptyList)).size(), 0);
+}
+
+TEST_F(EncodingTest, hex_codec) {
+  std::mt19937 rng(42);
+  // Lengths around vector widths cover every mix of wide, narrow and scalar parts
+  for (size_t size = 0; size < 100; ++size) {
+    dev::bytes data(size);
+    for (auto& b : data) b = static_cast<uint8_t>(rng());
+    std::string expected;
+    for (auto b : data) {
+      expected += "0123456789abcdef"[b >> 4];
+      expected += "0123456789abcdef"[b & 0xf];
+    }
+    EXPECT_EQ(dev::toHex(data), expected);
+    EXPECT_EQ(dev::fromHex(expected), data);
+
+    auto upper = expected;
+    for (size_t i = 0; i < upper.size(); i += 3) upper[i] = static_cast<char>(std::toupper(upper[i]));
+    EXPECT_EQ(dev::fromHex("0x" + upper), data);
+
+    for (size_t i = 0; i < expected.size(); i += 7) {
+      for (char c : {'g', 'G', '/', ':', '@', '`', ' ', '\0'}) {
+        auto invalid = expected;
+        invalid[i] = c;
+        EXPECT_TRUE(dev::fromHex(invalid).empty());
+        EXPECT_THROW(dev::fromHex(invalid, dev::WhenError::Throw), dev::BadHexCharacter);
+      }
+    }
+  }
+  EXPECT_EQ(dev::fromHex("0x123"), dev::bytes({0x01, 0x23}));
+}
+
 }  // namespace taraxa::core_tests
 
 using namespace taraxa;
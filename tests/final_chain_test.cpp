@@ -2,12 +2,14 @@
 
 #include <libdevcore/CommonData.h>
 
+#include <memory_resource>
 #include <optional>
 #include <vector>
 
 #include "common/constants.hpp"
 #include "common/encoding_rlp.hpp"
 #include "common/encoding_solidity.hpp"
+#include "common/jsoncpp.hpp"
 #include "common/vrf_wrapper.hpp"
 #include "config/config.hpp"
 #include "final_chain/trie_common.hpp"
@@ -200,6 +202,27 @@ TEST_F(FinalChainTest, initial_balances) {
   init();
 }
 
+TEST_F(FinalChainTest, hardfork_rules) {
+  cfg.genesis.state.hardforks.cornus_hf.block_num = 2;
+  cfg.genesis.state.hardforks.cornus_hf.dag_gas_limit = cfg.genesis.dag.gas_limit * 2;
+  cfg.genesis.state.hardforks.cornus_hf.pbft_gas_limit = cfg.genesis.pbft.gas_limit * 2;
+  init();
+  EXPECT_EQ(SUT->lastBlockHardforkRules()->block_number, 0u);
+  EXPECT_FALSE(SUT->lastBlockHardforkRules()->cornus);
+  EXPECT_EQ(SUT->lastBlockHardforkRules()->pbft_gas_limit, cfg.genesis.pbft.gas_limit);
+
+  advance({});
+  EXPECT_EQ(SUT->lastBlockHardforkRules()->block_number, 1u);
+  EXPECT_FALSE(SUT->lastBlockHardforkRules()->cornus);
+
+  advance({});
+  const auto rules = SUT->lastBlockHardforkRules();
+  EXPECT_EQ(rules->block_number, 2u);
+  EXPECT_TRUE(rules->cornus);
+  EXPECT_EQ(rules->dag_gas_limit, cfg.genesis.dag.gas_limit * 2);
+  EXPECT_EQ(rules->pbft_gas_limit, cfg.genesis.pbft.gas_limit * 2);
+}
+
 TEST_F(FinalChainTest, contract) {
   auto sender_keys = dev::KeyPair::create();
   const auto& addr = sender_keys.address();
@@ -292,6 +315,368 @@ TEST_F(FinalChainTest, coin_transfers) {
   });
 }
 
+TEST_F(FinalChainTest, export_blocks) {
+  const auto key = dev::KeyPair::create();
+  cfg.genesis.state.initial_balances = {};
+  cfg.genesis.state.initial_balances[key.address()] = taraxa::uint256_t("0x204FCE5E3E25026110000000");
+  init();
+
+  constexpr auto TRX_GAS = 100000;
+  advance({});
+  advance({
+      std::make_shared<Transaction>(1, 13, 1000000000, TRX_GAS, dev::bytes(), key.secret(), addr_t::random()),
+      std::make_shared<Transaction>(2, 11, 1000000000, TRX_GAS, dev::bytes(), key.secret(), addr_t::random()),
+  });
+  advance({
+      std::make_shared<Transaction>(3, 17, 1000000000, TRX_GAS, dev::bytes(), key.secret(), addr_t::random()),
+  });
+
+  // Export of range beyond the last block stops at the last block
+  std::vector<EthBlockNumber> exported;
+  SUT->exportBlocks(0, 100, [&](const auto& header, const auto& transactions, const auto& receipts) {
+    const auto expected_header = SUT->blockHeader(header.number);
+    EXPECT_EQ(header.hash, expected_header->hash);
+    EXPECT_EQ(header.ethereumRlp(), expected_header->ethereumRlp());
+    const auto expected_transactions = SUT->transactions(header.number);
+    EXPECT_EQ(transactions.size(), expected_transactions.size());
+    for (size_t i = 0; i < transactions.size(); ++i) {
+      EXPECT_EQ(transactions[i]->getHash(), expected_transactions[i]->getHash());
+    }
+    const auto expected_receipts = SUT->blockReceipts(header.number);
+    EXPECT_EQ(receipts.size(), expected_receipts ? expected_receipts->size() : 0);
+    for (size_t i = 0; i < receipts.size(); ++i) {
+      EXPECT_EQ(receipts[i].cumulative_gas_used, expected_receipts->at(i).cumulative_gas_used);
+    }
+    exported.push_back(header.number);
+    return true;
+  });
+  EXPECT_EQ(exported, std::vector<EthBlockNumber>({0, 1, 2, 3}));
+
+  // Export is stopped by callback
+  exported.clear();
+  SUT->exportBlocks(1, 3, [&](const auto& header, const auto&, const auto&) {
+    exported.push_back(header.number);
+    return header.number < 2;
+  });
+  EXPECT_EQ(exported, std::vector<EthBlockNumber>({1, 2}));
+}
+
+TEST_F(FinalChainTest, historical_block_fetch) {
+  const auto key = dev::KeyPair::create();
+  cfg.genesis.state.initial_balances = {};
+  cfg.genesis.state.initial_balances[key.address()] = taraxa::uint256_t("0x204FCE5E3E25026110000000");
+  // Pruned blocks are older than recent blocks caches
+  cfg.final_chain_cache_in_blocks = 1;
+  init();
+
+  constexpr auto TRX_GAS = 100000;
+  advance({});
+  advance({
+      std::make_shared<Transaction>(1, 13, 1000000000, TRX_GAS, dev::bytes(), key.secret(), addr_t::random()),
+      std::make_shared<Transaction>(2, 11, 1000000000, TRX_GAS, dev::bytes(), key.secret(), addr_t::random()),
+  });
+  advance({});
+  advance({});
+
+  // Block as served by a peer that still has it
+  constexpr EthBlockNumber kPruned = 2;
+  HistoricalBlock served;
+  served.pbft_block = std::make_shared<PbftBlock>(*db->getPbftBlock(kPruned));
+  const auto header_data = db->lookup(kPruned, DbStorage::Columns::final_chain_blk_by_number);
+  served.header_data.assign(header_data.begin(), header_data.end());
+  served.transactions = *db->getPeriodTransactions(kPruned);
+  for (const auto& trx : db->getPeriodSystemTransactions(kPruned)) {
+    served.system_transactions.push_back(trx->rlp());
+  }
+  served.receipts = *db->getBlockReceipts(kPruned);
+  const auto expected_receipts = served.receipts;
+
+  // Light node history pruning, headers are kept
+  for (PbftPeriod period = 1; period <= kPruned + 1; ++period) {
+    db->remove(DbStorage::Columns::period_data, period);
+    db->remove(DbStorage::Columns::final_chain_receipt_by_period, period);
+  }
+  EXPECT_FALSE(SUT->blockReceipts(kPruned));
+  EXPECT_TRUE(SUT->transactions(kPruned).empty());
+
+  // Tampered receipt doesn't match receipts root of the known header
+  size_t fetches = 0;
+  SUT->setHistoricalBlockFetcher(
+      [&](EthBlockNumber blk_n, const auto& verify) {
+        ++fetches;
+        EXPECT_EQ(blk_n, kPruned);
+        auto tampered = served;
+        tampered.receipts[0].cumulative_gas_used += 1;
+        return verify(tampered);
+      },
+      10);
+  EXPECT_FALSE(SUT->fetchHistoricalBlock(kPruned));
+  EXPECT_EQ(fetches, 1u);
+
+  SUT->setHistoricalBlockFetcher(
+      [&](EthBlockNumber, const auto& verify) {
+        ++fetches;
+        return verify(served);
+      },
+      10);
+  // Getters read db only, peers are asked only on explicit fetch
+  EXPECT_FALSE(SUT->blockReceipts(kPruned));
+  EXPECT_EQ(fetches, 1u);
+  // Block that is in db is not fetched
+  EXPECT_FALSE(SUT->fetchHistoricalBlock(kPruned + 2));
+  EXPECT_EQ(fetches, 1u);
+
+  const auto block = SUT->fetchHistoricalBlock(kPruned);
+  ASSERT_TRUE(block);
+  const auto& receipts = block->receipts;
+  ASSERT_TRUE(receipts);
+  ASSERT_EQ(receipts->size(), expected_receipts.size());
+  for (size_t i = 0; i < receipts->size(); ++i) {
+    EXPECT_EQ(util::rlp_enc(receipts->at(i)), util::rlp_enc(expected_receipts[i]));
+  }
+  const auto& transactions = block->transactions;
+  ASSERT_EQ(transactions.size(), served.transactions.size());
+  for (size_t i = 0; i < transactions.size(); ++i) {
+    EXPECT_EQ(transactions[i]->getHash(), served.transactions[i]->getHash());
+  }
+  // Verified block is cached, so it is fetched once
+  EXPECT_TRUE(SUT->fetchHistoricalBlock(kPruned));
+  EXPECT_EQ(fetches, 2u);
+}
+
+TEST_F(FinalChainTest, compact_receipts) {
+  const auto contract = addr_t::random();
+  const auto topic = h256::random();
+  TransactionReceipts receipts(3);
+  receipts[0].status_code = 1;
+  receipts[0].gas_used = 21000;
+  receipts[0].cumulative_gas_used = 21000;
+  receipts[1].gas_used = 500000;
+  receipts[1].cumulative_gas_used = 521000;
+  receipts[1].new_contract_address = contract;
+  receipts[2].status_code = 1;
+  receipts[2].gas_used = 30000;
+  receipts[2].cumulative_gas_used = 551000;
+  // Repeated address and topic are stored once
+  receipts[2].logs = {{contract, {topic, h256::random()}, dev::bytes{1, 2, 3}}, {contract, {topic}, {}}};
+
+  const auto compare = [&](const TransactionReceipt& a, const TransactionReceipt& b) {
+    EXPECT_EQ(util::rlp_enc(a), util::rlp_enc(b));
+  };
+  const auto plain = util::rlp_enc(receipts);
+  const auto compact = encodeCompactReceipts(receipts);
+  EXPECT_LT(compact.size(), plain.size());
+  EXPECT_TRUE(ReceiptsView::isCompact(&compact));
+  EXPECT_FALSE(ReceiptsView::isCompact(&plain));
+
+  // Both encodings are readable, the old one stays in db until migrated
+  for (const auto& raw : {plain, compact}) {
+    const ReceiptsView view(&raw);
+    ASSERT_EQ(view.size(), receipts.size());
+    const auto all = view.decodeAll();
+    for (size_t i = 0; i < receipts.size(); ++i) {
+      compare(view[i], receipts[i]);
+      compare(all[i], receipts[i]);
+    }
+  }
+  const auto empty = encodeCompactReceipts({});
+  EXPECT_EQ(ReceiptsView(&empty).size(), 0);
+}
+
+TEST_F(FinalChainTest, ordered_trie_root) {
+  std::pmr::monotonic_buffer_resource arena;
+  const util::Executor executor(util::TaskClass::Execution);
+  // Over 128 values, so rlp encoded keys of different lengths are ordered by nibbles. Largest one is hashed in parallel
+  for (size_t count : {0, 1, 2, 200, 20 * kParallelTrieMinSize}) {
+    std::vector<bytes> values;
+    dev::BytesMap trie;
+    for (size_t i = 0; i < count; ++i) {
+      values.push_back(util::rlp_enc(h256::random()));
+      trie[util::rlp_enc(i)] = values.back();
+    }
+    std::vector<dev::bytesConstRef> refs;
+    for (const auto& value : values) {
+      refs.emplace_back(&value);
+    }
+    const auto root = hash256(trie);
+    EXPECT_EQ(orderedTrieRoot(refs, &arena), root);
+    EXPECT_EQ(orderedTrieRoot(refs, &arena, &executor), root);
+  }
+}
+
+TEST_F(FinalChainTest, trace_streaming) {
+  const auto key = dev::KeyPair::create();
+  cfg.genesis.state.initial_balances = {};
+  cfg.genesis.state.initial_balances[key.address()] = taraxa::uint256_t("0x204FCE5E3E25026110000000");
+  init();
+  advance({});
+
+  const state_api::EVMTransaction trx{key.address(), 0, addr_t::random(), 0, 100, 100000, {}};
+  const state_api::Tracing params{.trace = true};
+
+  // Chunks forwarded to sink are the same trace as the one returned as string
+  std::string streamed;
+  size_t chunks = 0;
+  SUT->trace({}, {trx}, 1, params, [&](std::string_view chunk) {
+    streamed.append(chunk);
+    ++chunks;
+  });
+  EXPECT_GT(chunks, 0);
+  EXPECT_EQ(streamed, SUT->trace({}, {trx}, 1, params));
+  EXPECT_FALSE(util::parse_json(streamed).isNull());
+}
+
+TEST_F(FinalChainTest, state_caches) {
+  auto sender_keys = dev::KeyPair::create();
+  const auto& addr = sender_keys.address();
+  const auto& sk = sender_keys.secret();
+  cfg.genesis.state.initial_balances = {};
+  cfg.genesis.state.initial_balances[addr] = taraxa::uint256_t("0x204FCE5E3E25026110000000");  //  10 Billion
+  init();
+  auto nonce = 0;
+  auto result = advance({std::make_shared<Transaction>(nonce++, 0, 1000000000, 1000000,
+                                                       dev::fromHex(samples::greeter_contract_code), sk)});
+  const auto contract_addr = *result->trx_receipts[0].new_contract_address;
+  const auto deploy_block = result->final_chain_blk->number;
+
+  const auto code = SUT->getCode(contract_addr);
+  EXPECT_FALSE(code.empty());
+  EXPECT_EQ(SUT->getCode(contract_addr), code);
+  EXPECT_TRUE(SUT->getCode(addr).empty());
+
+  const auto greeting = SUT->getAccountStorage(contract_addr, 0);
+  EXPECT_NE(greeting, h256());
+  EXPECT_EQ(SUT->getAccountStorage(contract_addr, 0), greeting);
+
+  advance({
+      std::make_shared<Transaction>(nonce++, 11, 1000000000, 1000000,
+                                    // setGreeting("Hola")
+                                    dev::fromHex("0xa4136862000000000000000000000000000000000000000000000000"
+                                                 "00000000000000200000000000000000000000000000000000000000000"
+                                                 "000000000000000000004486f6c61000000000000000000000000000000"
+                                                 "00000000000000000000000000"),
+                                    sk, contract_addr),
+  });
+
+  // Changed storage is not served from cache, older block still reads its own value
+  EXPECT_NE(SUT->getAccountStorage(contract_addr, 0), greeting);
+  EXPECT_EQ(SUT->getAccountStorage(contract_addr, 0, deploy_block), greeting);
+  EXPECT_EQ(SUT->getCode(contract_addr), code);
+}
+
+TEST_F(FinalChainTest, trx_location_cache) {
+  auto sender_keys = dev::KeyPair::create();
+  cfg.genesis.state.initial_balances = {};
+  cfg.genesis.state.initial_balances[sender_keys.address()] = taraxa::uint256_t("0x204FCE5E3E25026110000000");
+  // Only the most recent transaction location is kept in memory
+  cfg.final_chain_trx_location_cache_size = 1;
+  init();
+
+  const auto receiver = addr_t::random();
+  const auto trx1 =
+      std::make_shared<Transaction>(0, 100, 1000000000, 100000, dev::bytes(), sender_keys.secret(), receiver);
+  const auto trx2 =
+      std::make_shared<Transaction>(1, 100, 1000000000, 100000, dev::bytes(), sender_keys.secret(), receiver);
+  const auto result = advance({trx1, trx2});
+
+  const auto hits = SUT->transactionLocationCacheHits();
+  const auto misses = SUT->transactionLocationCacheMisses();
+  const auto location2 = SUT->transactionLocation(trx2->getHash());
+  ASSERT_TRUE(location2);
+  EXPECT_EQ(location2->period, result->final_chain_blk->number);
+  EXPECT_EQ(location2->position, 1u);
+  EXPECT_EQ(SUT->transactionLocationCacheHits(), hits + 1);
+
+  // Evicted location is read from db
+  const auto location1 = SUT->transactionLocation(trx1->getHash());
+  ASSERT_TRUE(location1);
+  EXPECT_EQ(location1->position, 0u);
+  EXPECT_EQ(SUT->transactionLocationCacheMisses(), misses + 1);
+
+  EXPECT_EQ(util::rlp_enc(result->trx_receipts[1]),
+            util::rlp_enc(*SUT->transactionReceipt(location2->period, location2->position)));
+}
+
+TEST_F(FinalChainTest, query_state_batch) {
+  auto sender_keys = dev::KeyPair::create();
+  const auto& addr = sender_keys.address();
+  const auto& sk = sender_keys.secret();
+  cfg.genesis.state.initial_balances = {};
+  cfg.genesis.state.initial_balances[addr] = taraxa::uint256_t("0x204FCE5E3E25026110000000");  //  10 Billion
+  init();
+  auto result = advance({std::make_shared<Transaction>(0, 0, 1000000000, 1000000,
+                                                       dev::fromHex(samples::greeter_contract_code), sk)});
+  const auto contract_addr = *result->trx_receipts[0].new_contract_address;
+  const auto deploy_block = result->final_chain_blk->number;
+
+  const std::vector<StateQuery> queries{
+      {StateQuery::Kind::Balance, addr, 0, {}},
+      {StateQuery::Kind::Nonce, addr, 0, {}},
+      {StateQuery::Kind::Code, contract_addr, 0, {}},
+      {StateQuery::Kind::Storage, contract_addr, 0, {}},
+      {StateQuery::Kind::Balance, addr, 0, deploy_block - 1},
+  };
+  const auto results = SUT->queryState(queries);
+  ASSERT_EQ(results.size(), queries.size());
+  EXPECT_EQ(results[0].value, SUT->getAccount(addr)->balance);
+  EXPECT_EQ(results[1].value, 1);
+  EXPECT_EQ(results[2].code, SUT->getCode(contract_addr));
+  EXPECT_EQ(results[3].storage, SUT->getAccountStorage(contract_addr, 0));
+  EXPECT_EQ(results[4].value, cfg.genesis.state.initial_balances[addr]);
+}
+
+TEST_F(FinalChainTest, pipelined_commit) {
+  const dev::KeyPair sender = dev::KeyPair::create();
+  const dev::KeyPair receiver = dev::KeyPair::create();
+  cfg.genesis.state.initial_balances = {{sender.address(), taraxa::uint256_t("0x204FCE5E3E25026110000000")}};
+  cfg.final_chain_pipelined_commit = true;
+  init();
+
+  std::vector<EthBlockNumber> finalized_blocks;
+  std::mutex finalized_blocks_mutex;
+  auto pool = std::make_shared<util::ThreadPool>(1);
+  SUT->block_finalized_.subscribe(
+      [&](const auto& res) {
+        std::unique_lock lock(finalized_blocks_mutex);
+        finalized_blocks.push_back(res->final_chain_blk->number);
+      },
+      pool);
+
+  constexpr auto TRX_GAS = 100000;
+  for (uint64_t nonce = 0; nonce < 5; ++nonce) {
+    advance({std::make_shared<Transaction>(nonce, 100, 1000000000, TRX_GAS, dev::bytes(), sender.secret(),
+                                           receiver.address())});
+  }
+
+  wait({10s, 100ms}, [&](auto& ctx) {
+    std::unique_lock lock(finalized_blocks_mutex);
+    WAIT_EXPECT_EQ(ctx, finalized_blocks.size(), 5);
+  });
+  std::unique_lock lock(finalized_blocks_mutex);
+  EXPECT_TRUE(std::is_sorted(finalized_blocks.begin(), finalized_blocks.end()));
+}
+
+TEST_F(FinalChainTest, prefetch_state) {
+  const dev::KeyPair sender = dev::KeyPair::create();
+  const dev::KeyPair receiver = dev::KeyPair::create();
+  cfg.genesis.state.initial_balances = {{sender.address(), taraxa::uint256_t("0x204FCE5E3E25026110000000")}};
+  cfg.final_chain_prefetch_state = true;
+  init();
+
+  // Prefetching must not change execution results which are verified by advance
+  auto result = advance({std::make_shared<Transaction>(0, 0, 1000000000, 1000000,
+                                                       dev::fromHex(samples::greeter_contract_code), sender.secret())});
+  const auto contract_addr = *result->trx_receipts[0].new_contract_address;
+  constexpr auto TRX_GAS = 100000;
+  for (uint64_t nonce = 1; nonce < 5; ++nonce) {
+    advance({
+        std::make_shared<Transaction>(nonce, 100, 1000000000, TRX_GAS, dev::bytes(), sender.secret(),
+                                      receiver.address()),
+    });
+  }
+  EXPECT_FALSE(SUT->getCode(contract_addr).empty());
+}
+
 TEST_F(FinalChainTest, initial_validators) {
   const dev::KeyPair key = dev::KeyPair::create();
   const std::vector<dev::KeyPair> validator_keys = {dev::KeyPair::create(), dev::KeyPair::create(),
@@ -316,6 +701,39 @@ TEST_F(FinalChainTest, initial_validators) {
   }
 }
 
+TEST_F(FinalChainTest, dpos_validators_snapshot) {
+  const dev::KeyPair key = dev::KeyPair::create();
+  const std::vector<dev::KeyPair> validator_keys = {dev::KeyPair::create(), dev::KeyPair::create(),
+                                                    dev::KeyPair::create()};
+  fillConfigForGenesisTests(key.address());
+
+  for (const auto& vk : validator_keys) {
+    const auto vrf_pub_key = taraxa::vrf_wrapper::getVrfKeyPair().first;
+    state_api::ValidatorInfo validator{vk.address(), key.address(), vrf_pub_key, 0, "", "", {}};
+    validator.delegations.emplace(key.address(), cfg.genesis.state.dpos.validator_maximum_stake);
+    cfg.genesis.state.dpos.initial_validators.emplace_back(validator);
+  }
+
+  init();
+  advance({});
+  const auto blk_num = SUT->lastBlockNumber();
+  const auto snapshot = SUT->dposValidatorsSnapshot(blk_num);
+  ASSERT_TRUE(snapshot);
+  EXPECT_EQ(snapshot->blk_num, blk_num);
+  EXPECT_EQ(snapshot->validators.size(), validator_keys.size());
+  EXPECT_EQ(snapshot->total_vote_count, SUT->dposEligibleTotalVoteCount(blk_num));
+  for (const auto& vk : validator_keys) {
+    EXPECT_EQ(snapshot->voteCount(vk.address()), SUT->dposEligibleVoteCount(blk_num, vk.address()));
+    EXPECT_TRUE(SUT->dposIsEligible(blk_num, vk.address()));
+  }
+  EXPECT_EQ(snapshot->voteCount(key.address()), 0u);
+  EXPECT_FALSE(SUT->dposIsEligible(blk_num, key.address()));
+
+  // Same snapshot is returned until it is evicted, future blocks are not snapshotted
+  EXPECT_EQ(snapshot, SUT->dposValidatorsSnapshot(blk_num));
+  EXPECT_FALSE(SUT->dposValidatorsSnapshot(blk_num + 1));
+}
+
 TEST_F(FinalChainTest, nonce_test) {
   auto sender_keys = dev::KeyPair::create();
   const auto& addr = sender_keys.address();
@@ -642,35 +1060,35 @@ TEST_F(FinalChainTest, incorrect_estimation_regress) {
   }
 }
 
-TEST_F(FinalChainTest, get_logs_multiple_topics) {
-  // contract Events {
-  //     event Event1(uint256 indexed v1);
-  //     event Event2(uint256 indexed v1,uint256 indexed v2);
-  //     event Event3(uint256 indexed v1,uint256 indexed v2,uint256 indexed v3);
-  //     function method1(uint256 v1) public {
-  //         emit Event1(v1);
-  //     }
-  //     function method2(uint256 v1, uint256 v2) public {
-  //         emit Event2(v1, v2);
-  //     }
-  //     function method3(uint256 v1, uint256 v2, uint256 v3) public {
-  //         emit Event3(v1, v2, v3);
-  //     }
-  // }
-  const auto events_contract_code =
-      "608060405234801561001057600080fd5b50610261806100206000396000f3fe608060405234801561001057600080fd5b50600436106100"
-      "415760003560e01c8063110d99ed14610046578063d6f7f2a114610062578063ffcd960e1461007e575b600080fd5b610060600480360381"
-      "019061005b919061016b565b61009a565b005b61007c60048036038101906100779190610198565b6100ca565b005b610098600480360381"
-      "019061009391906101d8565b6100fc565b005b807f04474795f5b996ff80cb47c148d4c5ccdbe09ef27551820caa9c2f8ed149cce3604051"
-      "60405180910390a250565b80827f6a822560072e19c1981d3d3bb11e5954a77efa0caf306eb08d053f37de0040ba60405160405180910390"
-      "a35050565b8082847fac279a174af532aabe2bdfe61037bff7cfa74374d4d24034e97609940e4e2ac960405160405180910390a450505056"
-      "5b600080fd5b6000819050919050565b61014881610135565b811461015357600080fd5b50565b6000813590506101658161013f565b9291"
-      "5050565b60006020828403121561018157610180610130565b5b600061018f84828501610156565b91505092915050565b60008060408385"
-      "0312156101af576101ae610130565b5b60006101bd85828601610156565b92505060206101ce85828601610156565b915050925092905056"
-      "5b6000806000606084860312156101f1576101f0610130565b5b60006101ff86828701610156565b93505060206102108682870161015656"
-      "5b925050604061022186828701610156565b915050925092509256fea264697066735822122005a8bf7a7bc842378d30f7446847533e0b35"
-      "074e5453f29fe8762c0eb4d6f4ba64736f6c63430008120033";
+// contract Events {
+//     event Event1(uint256 indexed v1);
+//     event Event2(uint256 indexed v1,uint256 indexed v2);
+//     event Event3(uint256 indexed v1,uint256 indexed v2,uint256 indexed v3);
+//     function method1(uint256 v1) public {
+//         emit Event1(v1);
+//     }
+//     function method2(uint256 v1, uint256 v2) public {
+//         emit Event2(v1, v2);
+//     }
+//     function method3(uint256 v1, uint256 v2, uint256 v3) public {
+//         emit Event3(v1, v2, v3);
+//     }
+// }
+const auto events_contract_code =
+    "608060405234801561001057600080fd5b50610261806100206000396000f3fe608060405234801561001057600080fd5b50600436106100"
+    "415760003560e01c8063110d99ed14610046578063d6f7f2a114610062578063ffcd960e1461007e575b600080fd5b610060600480360381"
+    "019061005b919061016b565b61009a565b005b61007c60048036038101906100779190610198565b6100ca565b005b610098600480360381"
+    "019061009391906101d8565b6100fc565b005b807f04474795f5b996ff80cb47c148d4c5ccdbe09ef27551820caa9c2f8ed149cce3604051"
+    "60405180910390a250565b80827f6a822560072e19c1981d3d3bb11e5954a77efa0caf306eb08d053f37de0040ba60405160405180910390"
+    "a35050565b8082847fac279a174af532aabe2bdfe61037bff7cfa74374d4d24034e97609940e4e2ac960405160405180910390a450505056"
+    "5b600080fd5b6000819050919050565b61014881610135565b811461015357600080fd5b50565b6000813590506101658161013f565b9291"
+    "5050565b60006020828403121561018157610180610130565b5b600061018f84828501610156565b91505092915050565b60008060408385"
+    "0312156101af576101ae610130565b5b60006101bd85828601610156565b92505060206101ce85828601610156565b915050925092905056"
+    "5b6000806000606084860312156101f1576101f0610130565b5b60006101ff86828701610156565b93505060206102108682870161015656"
+    "5b925050604061022186828701610156565b915050925092509256fea264697066735822122005a8bf7a7bc842378d30f7446847533e0b35"
+    "074e5453f29fe8762c0eb4d6f4ba64736f6c63430008120033";
 
+TEST_F(FinalChainTest, get_logs_multiple_topics) {
   auto sender_keys = dev::KeyPair::create();
   const auto& from = sender_keys.address();
   const auto& sk = sender_keys.secret();
@@ -735,9 +1153,73 @@ TEST_F(FinalChainTest, get_logs_multiple_topics) {
     logs_obj["topics"].append(topics);
     auto res = eth_json_rpc->eth_getLogs(logs_obj);
     ASSERT_EQ(res.size(), 3);
+
+    auto make_parallel_rpc = [&](const net::rpc::eth::LogsQueryLimits& limits) {
+      net::rpc::eth::EthParams params;
+      params.chain_id = cfg.genesis.chain_id;
+      params.gas_limit = cfg.genesis.dag.gas_limit;
+      params.final_chain = SUT;
+      params.logs_query_threads = 2;
+      params.logs_query_limits = limits;
+      return net::rpc::eth::NewEth(std::move(params));
+    };
+    EXPECT_EQ(make_parallel_rpc({})->eth_getLogs(logs_obj), res);
+    EXPECT_THROW(make_parallel_rpc({.max_results = 2})->eth_getLogs(logs_obj), jsonrpc::JsonRpcException);
+    EXPECT_THROW(make_parallel_rpc({.max_block_range = 1})->eth_getLogs(logs_obj), jsonrpc::JsonRpcException);
   }
 }
 
+TEST_F(FinalChainTest, get_logs_with_logs_index) {
+  auto sender_keys = dev::KeyPair::create();
+  const auto& from = sender_keys.address();
+  const auto& sk = sender_keys.secret();
+  cfg.genesis.state.initial_balances = {};
+  cfg.genesis.state.initial_balances[from] = u256("10000000000000000000000");
+  cfg.final_chain_logs_index = true;
+  init();
+  ASSERT_EQ(SUT->logsIndexFrom(), 1);
+
+  net::rpc::eth::EthParams eth_rpc_params;
+  eth_rpc_params.chain_id = cfg.genesis.chain_id;
+  eth_rpc_params.gas_limit = cfg.genesis.dag.gas_limit;
+  eth_rpc_params.final_chain = SUT;
+  auto eth_json_rpc = net::rpc::eth::NewEth(std::move(eth_rpc_params));
+
+  auto nonce = 0;
+  auto trx1 =
+      std::make_shared<Transaction>(nonce++, 0, 1000000000, TEST_TX_GAS_LIMIT, dev::fromHex(events_contract_code), sk);
+  auto result = advance({trx1});
+  auto contract_addr = result->trx_receipts[0].new_contract_address;
+
+  auto make_call_trx = [&](const std::string& call_data) {
+    return std::make_shared<Transaction>(nonce++, 0, 1000000000, TEST_TX_GAS_LIMIT, dev::fromHex(call_data), sk,
+                                         contract_addr);
+  };
+  const auto param1 = std::string(63, '0') + "1";
+  const auto param2 = std::string(63, '0') + "2";
+  advance({make_call_trx("0x110d99ed" + param1)}, {true});
+  advance({make_call_trx("0x110d99ed" + param2)}, {true});
+  advance({make_call_trx("0xd6f7f2a1" + param1 + param2)}, {true});
+  auto topic1 = "0x04474795f5b996ff80cb47c148d4c5ccdbe09ef27551820caa9c2f8ed149cce3";
+
+  Json::Value logs_obj(Json::objectValue);
+  logs_obj["fromBlock"] = dev::toJS(0);
+  logs_obj["address"] = contract_addr->toString();
+  auto res = eth_json_rpc->eth_getLogs(logs_obj);
+  ASSERT_EQ(res.size(), 3);
+  EXPECT_EQ(res[0]["blockNumber"].asString(), dev::toJS(2));
+  EXPECT_EQ(res[2]["blockNumber"].asString(), dev::toJS(4));
+
+  logs_obj["topics"] = Json::Value(Json::arrayValue);
+  logs_obj["topics"].append(topic1);
+  res = eth_json_rpc->eth_getLogs(logs_obj);
+  ASSERT_EQ(res.size(), 2);
+  EXPECT_EQ(res[1]["transactionHash"].asString(), dev::toJS(SUT->transactionHashes(3)->at(0)));
+
+  logs_obj["address"] = addr_t::random().toString();
+  EXPECT_EQ(eth_json_rpc->eth_getLogs(logs_obj).size(), 0);
+}
+
 TEST_F(FinalChainTest, topics_size_limit) {
   init();
 
@@ -7,15 +7,25 @@
 #include <iostream>
 #include <mutex>
 #include <shared_mutex>
+#include <thread>
 #include <vector>
 
+#include "common/allocator.hpp"
 #include "common/constants.hpp"
+#include "common/event.hpp"
 #include "common/init.hpp"
+#include "common/rolling_samples.hpp"
+#include "common/rotating_bloom_filter.hpp"
+#include "common/scheduler.hpp"
+#include "common/task_graph.hpp"
+#include "common/thread_placement.hpp"
 #include "common/types.hpp"
 #include "dag/dag_block_proposer.hpp"
 #include "dag/dag_manager.hpp"
 #include "graphql/mutation.hpp"
 #include "graphql/query.hpp"
+#include "graphql/query_cache.hpp"
+#include "graphql/query_cost.hpp"
 #include "graphql/subscription.hpp"
 #include "plugin/light.hpp"
 #include "test_util/samples.hpp"
@@ -138,6 +148,30 @@ TEST_F(FullNodeTest, db_test) {
   ASSERT_EQ(*g_trx_signed_samples[1], *db.getTransaction(g_trx_signed_samples[1]->getHash()));
   ASSERT_EQ(*g_trx_signed_samples[2], *db.getTransaction(g_trx_signed_samples[2]->getHash()));
   ASSERT_EQ(*g_trx_signed_samples[3], *db.getTransaction(g_trx_signed_samples[3]->getHash()));
+  {
+    // Batched lookups keep order of requested hashes, missing ones are reported as such
+    const std::vector<trx_hash_t> hashes{g_trx_signed_samples[3]->getHash(), trx_hash_t(12345),
+                                         g_trx_signed_samples[0]->getHash()};
+    EXPECT_EQ(db.transactionsInDb(hashes), std::vector<bool>({true, false, true}));
+    EXPECT_EQ(db.transactionsFinalized(hashes), std::vector<bool>({false, false, false}));
+    EXPECT_TRUE(db.getFinalizedTransactions(hashes).empty());
+    const auto values = db.multiGet(DbStorage::Columns::transactions, hashes);
+    ASSERT_EQ(values.size(), hashes.size());
+    EXPECT_EQ(dev::asBytes(values[0].ToString()), g_trx_signed_samples[3]->rlp());
+    EXPECT_TRUE(values[1].empty());
+    EXPECT_EQ(dev::asBytes(values[2].ToString()), g_trx_signed_samples[0]->rlp());
+  }
+  {
+    // Removed transaction can be added again, e.g. when its dag block was dropped and it is received again
+    batch = db.createWriteBatch();
+    db.removeTransactionToBatch(g_trx_signed_samples[3]->getHash(), batch);
+    db.commitWriteBatch(batch);
+    EXPECT_FALSE(db.transactionInDb(g_trx_signed_samples[3]->getHash()));
+    batch = db.createWriteBatch();
+    db.addTransactionToBatch(*g_trx_signed_samples[3], batch);
+    db.commitWriteBatch(batch);
+    EXPECT_EQ(*g_trx_signed_samples[3], *db.getTransaction(g_trx_signed_samples[3]->getHash()));
+  }
 
   // PBFT manager round and step
   EXPECT_EQ(db.getPbftMgrField(PbftMgrField::Round), 1);
@@ -288,17 +322,37 @@ TEST_F(FullNodeTest, db_test) {
 
   // pbft_blocks (head)
   PbftChain pbft_chain(addr_t(), db_ptr);
-  db.savePbftHead(pbft_chain.getHeadHash(), pbft_chain.getJsonStr());
-  EXPECT_EQ(db.getPbftHead(pbft_chain.getHeadHash()), pbft_chain.getJsonStr());
+  db.savePbftHead(pbft_chain.getHeadHash(), pbft_chain.getHeadRlp());
+  EXPECT_EQ(db.getPbftHead(pbft_chain.getHeadHash()), pbft_chain.getHeadRlp());
   batch = db.createWriteBatch();
   pbft_chain.updatePbftChain(blk_hash_t(123), blk_hash_t(1));
-  db.addPbftHeadToBatch(pbft_chain.getHeadHash(), pbft_chain.getJsonStr(), batch);
+  db.addPbftHeadToBatch(pbft_chain.getHeadHash(), pbft_chain.getHeadRlp(), batch);
   db.commitWriteBatch(batch);
-  EXPECT_EQ(db.getPbftHead(pbft_chain.getHeadHash()), pbft_chain.getJsonStr());
+  EXPECT_EQ(db.getPbftHead(pbft_chain.getHeadHash()), pbft_chain.getHeadRlp());
   batch = db.createWriteBatch();
-  db.addPbftHeadToBatch(pbft_chain.getHeadHash(), pbft_chain.getJsonStr(), batch);
+  db.addPbftHeadToBatch(pbft_chain.getHeadHash(), pbft_chain.getHeadRlp(), batch);
   db.commitWriteBatch(batch);
-  EXPECT_EQ(db.getPbftHead(pbft_chain.getHeadHash()), pbft_chain.getJsonStr());
+  EXPECT_EQ(db.getPbftHead(pbft_chain.getHeadHash()), pbft_chain.getHeadRlp());
+
+  {
+    // JSON head written by older versions is still readable, last block hash is left empty so it is not looked up
+    Json::Value json;
+    json["head_hash"] = pbft_chain.getHeadHash().toString();
+    json["size"] = 5;
+    json["non_empty_size"] = 3;
+    json["last_pbft_block_hash"] = kNullBlockHash.toString();
+    const auto json_head = json.toStyledString();
+    db.savePbftHead(pbft_chain.getHeadHash(), bytes(json_head.begin(), json_head.end()));
+    PbftChain json_chain(addr_t(), db_ptr);
+    EXPECT_EQ(json_chain.getPbftChainSize(), 5);
+    EXPECT_EQ(json_chain.getPbftChainSizeExcludingEmptyPbftBlocks(), 3);
+
+    db.savePbftHead(json_chain.getHeadHash(), json_chain.getHeadRlp());
+    PbftChain rlp_chain(addr_t(), db_ptr);
+    EXPECT_EQ(rlp_chain.getPbftChainSize(), 5);
+    EXPECT_EQ(rlp_chain.getPbftChainSizeExcludingEmptyPbftBlocks(), 3);
+    EXPECT_EQ(rlp_chain.getHeadRlp(), json_chain.getHeadRlp());
+  }
 
   // status
   db.saveStatusField(StatusDbField::TrxCount, 5);
@@ -437,6 +491,350 @@ TEST_F(FullNodeTest, db_test) {
   EXPECT_FALSE(db.getProposalPeriodForDagLevel(107));
 }
 
+TEST_F(FullNodeTest, db_statistics) {
+  DbStorage db(data_dir);
+  db.saveDagBlock(std::make_shared<DagBlock>(blk_hash_t(1), 1, vec_blk_t{}, vec_trx_t{trx_hash_t(1)}, sig_t(777),
+                                             blk_hash_t(0xB1), addr_t(999)));
+
+  const auto columns = db.columnsProperties();
+  EXPECT_EQ(columns.size(), DbStorage::Columns::all.size());
+  const auto dag_blocks = std::find_if(columns.begin(), columns.end(), [](const auto &column) {
+    return column.name == DbStorage::Columns::dag_blocks.name();
+  });
+  ASSERT_NE(dag_blocks, columns.end());
+  EXPECT_GT(dag_blocks->mem_tables_size, 0);
+
+  const auto tickers = db.statisticsTickers();
+  const auto bytes_written = std::find_if(tickers.begin(), tickers.end(),
+                                          [](const auto &ticker) { return ticker.first == "rocksdb.bytes.written"; });
+  ASSERT_NE(bytes_written, tickers.end());
+  EXPECT_GT(bytes_written->second, 0);
+  EXPECT_GT(DbStorage::directorySize(db.dbStoragePath()), 0);
+}
+
+TEST_F(FullNodeTest, startup_snapshot) {
+  DbStorage db(data_dir);
+  EXPECT_TRUE(db.takeStartupSnapshot(StartupSnapshotKey::Dag).empty());
+
+  const bytes data{1, 2, 3};
+  db.saveStartupSnapshot(StartupSnapshotKey::Dag, data);
+  EXPECT_TRUE(db.takeStartupSnapshot(StartupSnapshotKey::Transactions).empty());
+  EXPECT_EQ(db.takeStartupSnapshot(StartupSnapshotKey::Dag), data);
+  // Snapshot is consumed by the first read
+  EXPECT_TRUE(db.takeStartupSnapshot(StartupSnapshotKey::Dag).empty());
+}
+
+TEST_F(FullNodeTest, db_prune_range) {
+  DbStorage db(data_dir);
+  auto batch = db.createWriteBatch();
+  for (PbftPeriod period = 1; period <= 10; ++period) {
+    db.savePeriodLambda(period, period * 100, batch);
+  }
+  db.commitWriteBatch(batch);
+
+  db.pruneRange(DbStorage::Columns::period_lambda, 1, 6);
+  // Merged into the compaction scheduled above if it has not started yet
+  db.scheduleCompaction(DbStorage::Columns::period_lambda, 6, 8);
+  for (PbftPeriod period = 1; period < 6; ++period) {
+    EXPECT_FALSE(db.getPeriodLambda(period, false).has_value());
+  }
+  for (PbftPeriod period = 6; period <= 10; ++period) {
+    EXPECT_EQ(db.getPeriodLambda(period, false), period * 100);
+  }
+}
+
+TEST_F(FullNodeTest, db_cold_path) {
+  const auto cold_path = data_dir / "cold";
+  const auto cold_files = [&] {
+    size_t count = 0;
+    for (const auto &entry : fs::recursive_directory_iterator(cold_path)) {
+      count += entry.path().extension() == ".sst";
+    }
+    return count;
+  };
+  {
+    DbStorage db(data_dir, 0, 0, 0, 0, addr_t(), false, {.cold_path = cold_path, .cold_hot_size = 0});
+    for (PbftPeriod period = 1; period <= 10; ++period) {
+      db.insert(DbStorage::Columns::period_data, period, bytes(100, 1));
+    }
+    db.compactColumn(DbStorage::Columns::period_data);
+    EXPECT_GT(cold_files(), 0);
+  }
+  // Reading from cold path is transparent after restart
+  DbStorage db(data_dir, 0, 0, 0, 0, addr_t(), false, {.cold_path = cold_path, .cold_hot_size = 0});
+  EXPECT_EQ(db.lookup(PbftPeriod(5), DbStorage::Columns::period_data), std::string(100, 1));
+}
+
+TEST_F(FullNodeTest, db_consensus_group_commit) {
+  DbStorage db(data_dir, 0, 0, 0, 0, addr_t(), false,
+               {.sync_consensus_writes = true, .consensus_group_commit_window = std::chrono::milliseconds(5)});
+  // Concurrent writers share WAL syncs and every write is visible once its call returns
+  std::vector<std::thread> writers;
+  for (uint32_t i = 0; i < 8; ++i) {
+    writers.emplace_back([&db, i] {
+      for (uint32_t round = 1; round <= 10; ++round) {
+        db.savePbftMgrStatus(PbftMgrStatus::ExecutedBlock, round % 2);
+        db.savePbftMgrField(i % 2 ? PbftMgrField::Round : PbftMgrField::Step, round);
+      }
+    });
+  }
+  for (auto &writer : writers) {
+    writer.join();
+  }
+  EXPECT_EQ(db.getPbftMgrField(PbftMgrField::Round), 10);
+  EXPECT_EQ(db.getPbftMgrField(PbftMgrField::Step), 10);
+  EXPECT_FALSE(db.getPbftMgrStatus(PbftMgrStatus::ExecutedBlock));
+}
+
+TEST_F(FullNodeTest, db_in_memory) {
+  const auto mem_path = data_dir / "in_memory";
+  {
+    DbStorage db(mem_path, 0, 0, 0, 0, addr_t(), false, {.in_memory = true});
+    db.insert(DbStorage::Columns::period_data, PbftPeriod(1), bytes(100, 1));
+    db.savePbftMgrField(PbftMgrField::Round, 7);
+    EXPECT_EQ(db.lookup(PbftPeriod(1), DbStorage::Columns::period_data), std::string(100, 1));
+    EXPECT_EQ(db.getPbftMgrField(PbftMgrField::Round), 7);
+  }
+  // Nothing is written to disk, so the content does not survive a restart
+  EXPECT_FALSE(fs::exists(mem_path / "db" / "CURRENT"));
+  DbStorage db(mem_path, 0, 0, 0, 0, addr_t(), false, {.in_memory = true});
+  EXPECT_TRUE(db.lookup(PbftPeriod(1), DbStorage::Columns::period_data).empty());
+}
+
+TEST_F(FullNodeTest, db_period_trx_senders) {
+  DbStorage db(data_dir);
+  auto pbft_block = make_simple_pbft_block(blk_hash_t(1), 2);
+  std::vector<std::shared_ptr<PbftVote>> votes{genDummyVote(PbftVoteTypes::cert_vote, 1, 1, 3, blk_hash_t(1))};
+  PeriodData period_data(pbft_block, votes);
+  period_data.transactions = {g_trx_signed_samples[0], g_trx_signed_samples[1], g_trx_signed_samples[2]};
+
+  auto batch = db.createWriteBatch();
+  db.savePeriodData(period_data, batch);
+  db.commitWriteBatch(batch);
+
+  const auto period = pbft_block->getPeriod();
+  EXPECT_EQ(db.lookup(period, DbStorage::Columns::period_trx_senders).size(), 3 * addr_t::size);
+  const auto trxs = db.getPeriodTransactions(period);
+  ASSERT_TRUE(trxs.has_value());
+  ASSERT_EQ(trxs->size(), 3);
+  for (size_t i = 0; i < trxs->size(); ++i) {
+    EXPECT_EQ((*trxs)[i]->getSender(), period_data.transactions[i]->getSender());
+  }
+
+  // Saved senders are trusted and not recovered again
+  bytes senders;
+  for (uint64_t i = 1; i <= 3; ++i) {
+    const addr_t sender(i);
+    senders.insert(senders.end(), sender.begin(), sender.end());
+  }
+  db.insert(DbStorage::Columns::period_trx_senders, period, senders);
+  EXPECT_EQ(db.getTransaction(period, 1)->getSender(), addr_t(2));
+  EXPECT_EQ(db.getTransaction(g_trx_signed_samples[2]->getHash())->getSender(), addr_t(3));
+  const auto finalized = db.getFinalizedTransactions({g_trx_signed_samples[0]->getHash()});
+  ASSERT_EQ(finalized.size(), 1);
+  EXPECT_EQ(finalized[0]->getSender(), addr_t(1));
+  EXPECT_EQ(db.getPeriodTransactions(period)->back()->getSender(), addr_t(3));
+}
+
+TEST_F(FullNodeTest, db_snapshots_backup) {
+  const auto backup_path = data_dir / "backup";
+  {
+    DbStorage db(data_dir, 2, 0, 1);
+    db.setSnapshotsBackupPath(backup_path);
+    db.saveStartupSnapshot(StartupSnapshotKey::Dag, bytes{1, 2, 3});
+    EXPECT_FALSE(db.createSnapshot(1));
+    EXPECT_TRUE(db.createSnapshot(2));
+    EXPECT_FALSE(db.createSnapshot(2));
+    db.saveStartupSnapshot(StartupSnapshotKey::Transactions, bytes{4, 5, 6});
+    EXPECT_TRUE(db.createSnapshot(4));
+    // Destructor waits for scheduled checkpoints
+  }
+  EXPECT_FALSE(fs::exists(data_dir / "db2"));
+  EXPECT_TRUE(fs::exists(data_dir / "db4"));
+  EXPECT_TRUE(fs::exists(backup_path / "db2"));
+  EXPECT_TRUE(fs::exists(backup_path / "db4"));
+
+  // Sst file of the first snapshot is linked from both backups
+  bool shared_sst = false;
+  for (const auto &entry : fs::directory_iterator(backup_path / "db_sst")) {
+    shared_sst |= fs::hard_link_count(entry.path()) == 3;
+  }
+  EXPECT_TRUE(shared_sst);
+}
+
+TEST_F(FullNodeTest, init_task_graph) {
+  util::TaskGraph graph;
+  std::atomic<bool> db_done = false, chain_done = false;
+  graph.add("db", {}, [&] { db_done = true; });
+  graph.add("chain", {"db"}, [&] {
+    EXPECT_TRUE(db_done);
+    chain_done = true;
+  });
+  graph.add("network", {"db", "chain"}, [&] { EXPECT_TRUE(chain_done); });
+  const auto durations = graph.run(4);
+  ASSERT_EQ(durations.size(), 3);
+  EXPECT_EQ(durations.back().first, "network");
+
+  util::TaskGraph failing;
+  failing.add("db", {}, [] { throw std::runtime_error("db"); });
+  failing.add("chain", {"db"}, [] { FAIL(); });
+  EXPECT_THROW(failing.run(2), std::runtime_error);
+  EXPECT_THROW(failing.add("network", {"unknown"}, [] {}), std::invalid_argument);
+}
+
+TEST_F(FullNodeTest, event_emitter_shared_payload) {
+  struct Payload {
+    Payload(std::atomic<size_t> &copies) : copies(copies) {}
+    Payload(const Payload &other) : copies(other.copies) { ++copies; }
+    std::atomic<size_t> &copies;
+  };
+  std::atomic<size_t> copies = 0;
+  std::atomic<size_t> async_calls = 0;
+  size_t inline_calls = 0;
+  const util::event::EventEmitter<Payload> emitter;
+  auto pool = std::make_shared<util::ThreadPool>(2);
+  for (int i = 0; i < 3; ++i) {
+    emitter.subscribe([&](const auto &) { ++async_calls; }, pool);
+  }
+  const auto inline_subscription = emitter.subscribeInline([&](const auto &) { ++inline_calls; });
+
+  // Inline subscriber is done before emit returns, asynchronous ones share a single copy of the payload
+  emitter.emit(Payload(copies));
+  EXPECT_EQ(inline_calls, 1);
+  EXPECT_HAPPENS({5s, 10ms}, [&](auto &ctx) { WAIT_EXPECT_EQ(ctx, async_calls.load(), 3) });
+  EXPECT_EQ(copies, 1);
+
+  EXPECT_EQ(emitter.unsubscribe(inline_subscription), 1);
+  EXPECT_EQ(emitter.unsubscribe(inline_subscription), 0);
+  emitter.emit(Payload(copies));
+  EXPECT_EQ(inline_calls, 1);
+  EXPECT_HAPPENS({5s, 10ms}, [&](auto &ctx) { WAIT_EXPECT_EQ(ctx, async_calls.load(), 6) });
+  EXPECT_EQ(copies, 2);
+}
+
+TEST_F(FullNodeTest, scheduler_priorities_and_caps) {
+  // Single worker is held by a background task, consensus task posted later runs first once it is free
+  util::Scheduler scheduler(1);
+  std::promise<void> release;
+  std::vector<util::TaskClass> order;
+  auto blocker =
+      scheduler.post(util::TaskClass::Background, [released = release.get_future().share()] { released.wait(); });
+  auto background = scheduler.post(util::TaskClass::Background, [&] { order.push_back(util::TaskClass::Background); });
+  auto consensus = scheduler.post(util::TaskClass::Consensus, [&] { order.push_back(util::TaskClass::Consensus); });
+  release.set_value();
+  background.get();
+  consensus.get();
+  EXPECT_EQ(order, std::vector<util::TaskClass>({util::TaskClass::Consensus, util::TaskClass::Background}));
+
+  // Capped class never runs more tasks at once than its cap, others still use the remaining workers
+  util::Scheduler capped(4, {0, 0, 0, 1, 0});
+  std::atomic<size_t> running = 0;
+  std::atomic<size_t> max_running = 0;
+  std::vector<std::future<void>> futures;
+  for (int i = 0; i < 8; ++i) {
+    futures.push_back(capped.post(util::TaskClass::Rpc, [&] {
+      const auto now_running = ++running;
+      auto max = max_running.load();
+      while (now_running > max && !max_running.compare_exchange_weak(max, now_running)) {
+      }
+      std::this_thread::sleep_for(5ms);
+      --running;
+    }));
+  }
+  capped.post(util::TaskClass::Network, [] {}).get();
+  for (auto &future : futures) {
+    future.get();
+  }
+  EXPECT_EQ(max_running, 1);
+  const auto stats = capped.stats(util::TaskClass::Rpc);
+  EXPECT_EQ(stats.executed, 8);
+  EXPECT_EQ(stats.queued, 0);
+  EXPECT_TRUE(stats.queue_latency_p99_us.has_value());
+
+  // Exception of a task is reported through its future
+  EXPECT_THROW(capped.post(util::TaskClass::Execution, [] { throw std::runtime_error("failed"); }).get(),
+               std::runtime_error);
+}
+
+TEST_F(FullNodeTest, threads_placement) {
+  EXPECT_EQ(util::parseCpuList("0-3,8,10-11"), std::vector<uint32_t>({0, 1, 2, 3, 8, 10, 11}));
+  EXPECT_THROW(util::parseCpuList(""), std::invalid_argument);
+  EXPECT_THROW(util::parseCpuList("3-1"), std::invalid_argument);
+  EXPECT_THROW(util::parseCpuList("1,x"), std::invalid_argument);
+
+  auto conf = node_cfgs.front();
+  conf.threads_placement = {{"pbft", {0}}, {"unknown", {0}}};
+  EXPECT_THROW(conf.validate(), ConfigException);
+  conf.threads_placement.erase("unknown");
+  EXPECT_NO_THROW(conf.validate());
+
+  // Thread of a group is named after it
+  std::thread([] {
+    util::placeCurrentThread(util::thread_group::kPackets, 3);
+    char name[16] = {};
+    pthread_getname_np(pthread_self(), name, sizeof(name));
+    EXPECT_EQ(std::string(name), "packets-3");
+  }).join();
+}
+
+TEST_F(FullNodeTest, allocator_stats) {
+  std::vector<std::unique_ptr<char[]>> blocks;
+  for (int i = 0; i < 10000; ++i) {
+    blocks.emplace_back(new char[1024]);
+  }
+  const auto stats = util::allocator::stats();
+  if (!stats) {
+    GTEST_SKIP() << util::allocator::name() << " does not provide stats";
+  }
+  EXPECT_GE(stats->allocated, blocks.size() * 1024);
+  EXPECT_GE(stats->active, stats->allocated);
+  EXPECT_GE(stats->fragmentation, 0);
+  EXPECT_LT(stats->fragmentation, 1);
+  blocks.clear();
+  EXPECT_TRUE(util::allocator::purge());
+}
+
+TEST_F(FullNodeTest, rolling_samples_percentile) {
+  util::RollingSamples samples(10);
+  EXPECT_FALSE(samples.percentile(0.5).has_value());
+  for (int i = 1; i <= 15; ++i) {
+    samples.add(i);
+  }
+  // Only the last 10 samples <6, 15> are kept
+  EXPECT_EQ(samples.size(), 10);
+  EXPECT_EQ(samples.percentile(0), 6);
+  EXPECT_EQ(samples.percentile(1), 15);
+  EXPECT_EQ(samples.percentile(0.5), 10);
+  EXPECT_FALSE(samples.percentile(0.5, 11).has_value());
+}
+
+TEST_F(FullNodeTest, rotating_bloom_filter) {
+  util::RotatingBloomFilter<trx_hash_t> filter(64 * 1024, 1e-4, 64);
+  std::vector<trx_hash_t> hashes(filter.generationCapacity() / 2);
+  for (auto &hash : hashes) {
+    hash = trx_hash_t::random();
+    EXPECT_TRUE(filter.insert(hash));
+  }
+  EXPECT_FALSE(filter.insert(hashes.front()));
+  for (const auto &hash : hashes) {
+    EXPECT_TRUE(filter.contains(hash));
+  }
+  EXPECT_LE(filter.memoryUsage(), 64 * 1024 + 64 * sizeof(uint64_t));
+
+  // Two more generations push out the first one, except of exactly tracked recent keys
+  size_t still_known = 0;
+  for (size_t i = 0; i < filter.generationCapacity() * 3; ++i) {
+    filter.insert(trx_hash_t::random());
+  }
+  for (const auto &hash : hashes) {
+    still_known += filter.contains(hash);
+  }
+  EXPECT_LT(still_known, hashes.size() / 100);
+  const auto recent = trx_hash_t::random();
+  filter.insert(recent);
+  EXPECT_TRUE(filter.contains(recent));
+}
+
 TEST_F(FullNodeTest, sync_five_nodes) {
   using namespace std;
 
@@ -1737,6 +2135,63 @@ TEST_F(FullNodeTest, graphql_test) {
   EXPECT_EQ(nodes[0]->getFinalChain()->transactionHashes(2)->at(0).toString(), hash2);
 }
 
+TEST_F(FullNodeTest, graphql_query_cost) {
+  using namespace graphql;
+  constexpr uint64_t kMaxRange = 101;
+  const response::Value no_variables(response::Type::Map);
+  const auto cost = [&](peg::ast &&query, const response::Value &variables = response::Value(response::Type::Map)) {
+    return taraxa::QueryCostEstimator(query, variables, kMaxRange).estimate();
+  };
+
+  EXPECT_EQ(cost(R"({ block { number hash } })"_graphql), 3u);
+  // 10 blocks with 2 fields each
+  EXPECT_EQ(cost(R"({ blocks(from: 10, to: 19) { number hash } })"_graphql), 1u + 10 * 2);
+  // Missing upper bound means maximal range, nested lists multiply the cost
+  EXPECT_EQ(cost(R"({ blocks(from: 10) { transactions { logs { data } } } })"_graphql),
+            1 + kMaxRange * (1 + taraxa::QueryCostEstimator::kAssumedListSize *
+                                     (1 + taraxa::QueryCostEstimator::kAssumedListSize)));
+  // Fragments are expanded and variables resolved
+  response::Value variables(response::Type::Map);
+  variables.emplace_back("from", response::Value(5));
+  variables.emplace_back("to", response::Value(1));
+  EXPECT_EQ(cost(R"(query q($from: Long!, $to: Long) { blocks(from: $from, to: $to) { ...f } }
+                    fragment f on Block { number hash })"_graphql,
+                 variables),
+            1u + 5 * 2);
+
+  // Estimation stops once limit is exceeded
+  auto query = R"({ blocks(from: 0) { transactions { logs { data } } } })"_graphql;
+  EXPECT_GT(taraxa::QueryCostEstimator(query, no_variables, kMaxRange).estimate(1000), 1000u);
+}
+
+TEST_F(FullNodeTest, graphql_query_cache) {
+  using namespace graphql;
+  EXPECT_EQ(taraxa::QueryCache::hash(""), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+
+  taraxa::QueryCache cache(1);
+  const auto block_hash = taraxa::QueryCache::hash("{ block { number } }");
+  auto block_query = "{ block { number } }"_graphql;
+  // Documents that were not validated are not cached
+  cache.insert(block_hash, block_query);
+  EXPECT_FALSE(cache.get(block_hash));
+
+  block_query.validated = true;
+  cache.insert(block_hash, block_query);
+  const auto cached = cache.get(block_hash);
+  ASSERT_TRUE(cached);
+  EXPECT_TRUE(cached->validated);
+  EXPECT_EQ(cached->root, block_query.root);
+
+  // Least recently used document is evicted
+  auto blocks_query = "{ blocks(from: 1) { number } }"_graphql;
+  blocks_query.validated = true;
+  cache.insert(taraxa::QueryCache::hash("{ blocks(from: 1) { number } }"), blocks_query);
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_FALSE(cache.get(block_hash));
+  EXPECT_EQ(cache.hits(), 1u);
+  EXPECT_EQ(cache.misses(), 2u);
+}
+
 TEST_F(FullNodeTest, multiple_wallets_support) {
   auto node_cfgs = make_node_cfgs(4, 3, 20);
 
@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 
 #include "config/config.hpp"
+#include "storage/storage.hpp"
 #include "test_util/test_util.hpp"
 
 namespace taraxa::core_tests {
@@ -69,4 +70,29 @@ TEST_F(GasPricerTest, random_test) {
   EXPECT_EQ(gp.bid(), prices[(prices.size() - 1) * config.gas_price.percentile / 100]);
 }
 
+TEST_F(GasPricerTest, persisted_window) {
+  auto db = std::make_shared<DbStorage>(data_dir);
+  GenesisConfig config;
+  config.gas_price.percentile = 50;
+  config.gas_price.blocks = 3;
+  {
+    // No finalized blocks yet, so nothing is loaded on init
+    GasPricer gp(config, true, true, nullptr, db);
+    for (EthBlockNumber block_number = 1; block_number <= 5; ++block_number) {
+      gp.update({std::make_shared<Transaction>(0, 0, 10 * block_number /*gas_price*/, 0, bytes(), secret)},
+                block_number);
+    }
+    EXPECT_EQ(gp.bid(), 40);
+  }
+  db->insert(DbStorage::Columns::final_chain_meta, DBMetaKeys::LAST_NUMBER, EthBlockNumber(5));
+
+  // Window of prices 30, 40, 50 is restored without period data in db
+  GasPricer gp(config, true, true, nullptr, db);
+  wait({10s, 100ms}, [&](auto& ctx) { WAIT_EXPECT_EQ(ctx, gp.bid(), 40); });
+  gp.update({std::make_shared<Transaction>(0, 0, 1 /*gas_price*/, 0, bytes(), secret)});
+  EXPECT_EQ(gp.bid(), 40);
+  gp.update({std::make_shared<Transaction>(0, 0, 2 /*gas_price*/, 0, bytes(), secret)});
+  EXPECT_EQ(gp.bid(), 2);
+}
+
 }  // namespace taraxa::core_tests
\ No newline at end of file
@@ -4,6 +4,8 @@
 
 #include <atomic>
 #include <iostream>
+#include <thread>
+#include <unordered_set>
 #include <vector>
 
 #include "app/app.hpp"
@@ -14,6 +16,7 @@
 #include "dag/dag_block_proposer.hpp"
 #include "logger/logger.hpp"
 #include "network/tarcap/packets/latest/pbft_sync_packet.hpp"
+#include "network/tarcap/packets_capture.hpp"
 #include "network/tarcap/packets_handlers/latest/dag_block_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/latest/get_dag_sync_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/latest/get_next_votes_bundle_packet_handler.hpp"
@@ -21,6 +24,10 @@
 #include "network/tarcap/packets_handlers/latest/transaction_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/latest/vote_packet_handler.hpp"
 #include "network/tarcap/packets_handlers/latest/votes_bundle_packet_handler.hpp"
+#include "network/tarcap/shared_states/pbft_syncing_state.hpp"
+#include "network/tarcap/stats/packets_compression_stats.hpp"
+#include "network/tarcap/stats/packets_stats.hpp"
+#include "network/tarcap/transactions_sketch.hpp"
 #include "pbft/pbft_manager.hpp"
 #include "test_util/samples.hpp"
 #include "test_util/test_util.hpp"
@@ -37,7 +44,46 @@ auto g_secret = Lazy([] {
 });
 auto g_signed_trx_samples = Lazy([] { return samples::createSignedTrxSamples(0, NUM_TRX, g_secret); });
 
-struct NetworkTest : public NodesTest {};
+struct NetworkTest : public NodesTest {
+  // Node 0 finalizes at least chain_size periods alone and node 1 syncs them. Consensus of both is stopped then, so
+  // their chains stay equal and a syncing node can request any window of periods from either of them
+  std::vector<std::shared_ptr<AppBase>> launchPbftSyncSources(const std::vector<FullNodeConfig>& cfgs,
+                                                              PbftPeriod chain_size) {
+    auto nodes = launch_nodes(cfgs);
+    EXPECT_HAPPENS({60s, 100ms}, [&](auto& ctx) {
+      WAIT_EXPECT_TRUE(ctx, nodes[0]->getPbftChain()->getPbftChainSize() >= chain_size)
+    });
+    nodes[0]->getPbftManager()->stop();
+    EXPECT_HAPPENS({60s, 100ms}, [&](auto& ctx) {
+      WAIT_EXPECT_EQ(ctx, nodes[1]->getPbftChain()->getPbftChainSize(), nodes[0]->getPbftChain()->getPbftChainSize())
+    });
+    nodes[1]->getPbftManager()->stop();
+    return nodes;
+  }
+
+  // Syncing node requests small windows from both sync sources at once, received packets are captured to check which
+  // peers served them. Second source is a boot node too, so it is connected from the start of the syncing
+  static void setPbftSyncWindowsNode(FullNodeConfig& cfg, const FullNodeConfig& second_source,
+                                     const std::filesystem::path& capture_path) {
+    cfg.network.sync_level_size = 2;
+    cfg.network.sync_max_peers = 2;
+    cfg.network.packets_capture_path = capture_path.string();
+    cfg.network.boot_nodes.emplace_back(NodeConfig{dev::KeyPair(second_source.getFirstWallet().node_secret).pub().hex(),
+                                                   "127.0.0.1", second_source.network.listen_port});
+  }
+};
+
+// Peers that sent pbft sync packets to the node which recorded the capture
+std::unordered_set<dev::p2p::NodeID> pbftSyncSources(const std::filesystem::path& capture_path) {
+  std::unordered_set<dev::p2p::NodeID> sources;
+  network::tarcap::PacketsCapture::Reader reader(capture_path);
+  while (const auto record = reader.next()) {
+    if (record->type == network::kPbftSyncPacket) {
+      sources.insert(record->peer);
+    }
+  }
+  return sources;
+}
 
 // Test verifies saving network to a file and restoring it from a file
 // is successful. Once restored from the file it is able to reestablish
@@ -136,7 +182,7 @@ TEST_F(NetworkTest, transfer_lot_of_blocks) {
   const auto node1_period = node1->getPbftChain()->getPbftChainSize();
   const auto node2_period = node2->getPbftChain()->getPbftChainSize();
   std::cout << "node1 period " << node1_period << ", node2 period " << node2_period << std::endl;
-  nw2->getSpecificHandler<network::tarcap::IDagBlockPacketHandler>(network::SubprotocolPacketType::kDagBlockPacket)
+  nw2->getSpecificHandler<network::SubprotocolPacketType::kDagBlockPacket>()
       ->requestDagBlocks(nw2->getPeer(nw1->getNodeId()));
 
   std::cout << "Waiting Sync ..." << std::endl;
@@ -225,7 +271,7 @@ TEST_F(NetworkTest, DISABLED_update_peer_chainsize) {
   auto node2_id = nw2->getNodeId();
 
   EXPECT_NE(nw2->getPeer(node1_id)->pbft_chain_size_, expected_chain_size);
-  nw1->getSpecificHandler<network::tarcap::IVotePacketHandler>(network::SubprotocolPacketType::kVotePacket)
+  nw1->getSpecificHandler<network::SubprotocolPacketType::kVotePacket>()
       ->sendPbftVote(nw1->getPeer(node2_id), vote, pbft_block);
   EXPECT_HAPPENS({5s, 100ms},
                  [&](auto& ctx) { WAIT_EXPECT_EQ(ctx, nw2->getPeer(node1_id)->pbft_chain_size_, expected_chain_size) });
@@ -381,8 +427,7 @@ TEST_F(NetworkTest, transfer_transaction) {
   std::pair<SharedTransactions, std::vector<trx_hash_t>> transactions;
   transactions.first.push_back(g_signed_trx_samples[0]);
 
-  nw2->getSpecificHandler<network::tarcap::ITransactionPacketHandler>(
-         network::SubprotocolPacketType::kTransactionPacket)
+  nw2->getSpecificHandler<network::SubprotocolPacketType::kTransactionPacket>()
       ->sendTransactions(peer1, std::move(transactions));
   const auto tx_mgr1 = node1->getTransactionManager();
   EXPECT_HAPPENS({2s, 200ms},
@@ -492,10 +537,17 @@ TEST_F(NetworkTest, node_sync) {
   blks.push_back(std::make_pair(blk5, g_signed_trx_samples[5]));
   blks.push_back(std::make_pair(blk6, g_signed_trx_samples[6]));
 
+  std::vector<std::shared_ptr<DagBlock>> blocks;
   for (size_t i = 0; i < blks.size(); ++i) {
     node1->getTransactionManager()->insertValidatedTransaction(std::move(blks[i].second));
-    EXPECT_EQ(node1->getDagManager()->verifyBlock(blks[i].first).first, DagManager::VerifyBlockReturnType::Verified);
-    node1->getDagManager()->addDagBlock(std::move(blks[i].first));
+    blocks.push_back(blks[i].first);
+  }
+  // All levels are verified at once, before any of the blocks is added to the DAG
+  for (const auto& verified : node1->getDagManager()->verifyBlocksBatch(blocks)) {
+    EXPECT_EQ(verified.first, DagManager::VerifyBlockReturnType::Verified);
+  }
+  for (auto& block : blocks) {
+    node1->getDagManager()->addDagBlock(std::move(block));
   }
 
   EXPECT_HAPPENS({30s, 500ms}, [&](auto& ctx) {
@@ -572,8 +624,7 @@ TEST_F(NetworkTest, node_pbft_sync) {
   pbft_chain1->updatePbftChain(pbft_block1.getBlockHash(), pbft_block1.getPivotDagBlockHash());
   // Update PBFT chain head block
   blk_hash_t pbft_chain_head_hash = pbft_chain1->getHeadHash();
-  std::string pbft_chain_head_str = pbft_chain1->getJsonStr();
-  db1->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain_head_str, batch);
+  db1->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain1->getHeadRlp(), batch);
   db1->commitWriteBatch(batch);
 
   vec_blk_t order1;
@@ -633,8 +684,7 @@ TEST_F(NetworkTest, node_pbft_sync) {
   pbft_chain1->updatePbftChain(pbft_block2.getBlockHash(), pbft_block2.getPivotDagBlockHash());
   // Update PBFT chain head block
   pbft_chain_head_hash = pbft_chain1->getHeadHash();
-  pbft_chain_head_str = pbft_chain1->getJsonStr();
-  db1->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain_head_str, batch);
+  db1->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain1->getHeadRlp(), batch);
   db1->commitWriteBatch(batch);
 
   vec_blk_t order2;
@@ -716,8 +766,7 @@ TEST_F(NetworkTest, node_pbft_sync_without_enough_votes) {
   pbft_chain1->updatePbftChain(pbft_block1.getBlockHash(), pbft_block1.getPivotDagBlockHash());
   // Update PBFT chain head block
   blk_hash_t pbft_chain_head_hash = pbft_chain1->getHeadHash();
-  std::string pbft_chain_head_str = pbft_chain1->getJsonStr();
-  db1->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain_head_str, batch);
+  db1->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain1->getHeadRlp(), batch);
   db1->commitWriteBatch(batch);
   PbftPeriod expect_pbft_chain_size = 1;
   EXPECT_EQ(node1->getPbftChain()->getPbftChainSize(), expect_pbft_chain_size);
@@ -762,8 +811,7 @@ TEST_F(NetworkTest, node_pbft_sync_without_enough_votes) {
   pbft_chain1->updatePbftChain(pbft_block2.getBlockHash(), pbft_block2.getPivotDagBlockHash());
   // Update PBFT chain head block
   pbft_chain_head_hash = pbft_chain1->getHeadHash();
-  pbft_chain_head_str = pbft_chain1->getJsonStr();
-  db1->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain_head_str, batch);
+  db1->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain1->getHeadRlp(), batch);
 
   node1->getVoteManager()->resetRewardVotes(pbft_block2.getPeriod(), 1, 3, pbft_block2.getBlockHash(), batch);
 
@@ -1206,6 +1254,143 @@ TEST_F(NetworkTest, node_transaction_sync) {
   }
 }
 
+TEST_F(NetworkTest, follower_node_sync) {
+  auto node_cfgs = make_node_cfgs(2, 1, 5);
+  auto& follower_cfg = node_cfgs[1];
+  follower_cfg.network.follower.emplace();
+  follower_cfg.network.follower->upstream_nodes.insert(dev::KeyPair(node_cfgs[0].getFirstWallet().node_secret).pub());
+  follower_cfg.network.follower->trust_upstream_votes = true;
+  auto nodes = launch_nodes(node_cfgs);
+  auto& upstream = nodes[0];
+  auto& follower = nodes[1];
+
+  for (auto t : *g_signed_trx_samples) {
+    upstream->getTransactionManager()->insertValidatedTransaction(std::shared_ptr(t));
+  }
+
+  EXPECT_HAPPENS({20s, 500ms}, [&](auto& ctx) {
+    WAIT_EXPECT_TRUE(ctx, upstream->getPbftChain()->getPbftChainSize() >= 5);
+    WAIT_EXPECT_TRUE(ctx, follower->getFinalChain()->lastBlockNumber() >= 5);
+  });
+  EXPECT_HAPPENS({20s, 500ms}, [&](auto& ctx) {
+    for (auto const& t : *g_signed_trx_samples) {
+      WAIT_EXPECT_TRUE(ctx, follower->getFinalChain()->transactionLocation(t->getHash()).has_value());
+    }
+  });
+
+  // Follower drops gossiped dag blocks and transactions and does not propose blocks, it knows only finalized ones
+  EXPECT_EQ(follower->getDagManager()->getNonFinalizedBlocksSize().first, 0);
+  EXPECT_EQ(follower->getTransactionManager()->getTransactionPoolSize(), 0);
+}
+
+TEST_F(NetworkTest, pbft_sync_windows) {
+  network::tarcap::PbftSyncingState state(10, 2);
+  const dev::p2p::NodeID peer1(1), peer2(2), peer3(3);
+  const auto now = std::chrono::steady_clock::now();
+
+  // Windows are kept sorted by periods no matter in which order they were requested
+  state.addSyncWindow({3, 4, 3, peer2, now});
+  state.addSyncWindow({1, 2, 1, peer1, now});
+  auto windows = state.syncWindows();
+  ASSERT_EQ(windows.size(), 2);
+  EXPECT_EQ(windows[0].peer_id, peer1);
+  EXPECT_EQ(windows[1].peer_id, peer2);
+
+  // Later window arrives first, periods of a window are accepted only in order and only from its peer
+  EXPECT_FALSE(state.acceptSyncWindowPeriod(peer2, 4, false));
+  EXPECT_TRUE(state.acceptSyncWindowPeriod(peer2, 3, false));
+  EXPECT_FALSE(state.acceptSyncWindowPeriod(peer1, 4, false));
+  EXPECT_TRUE(state.acceptSyncWindowPeriod(peer2, 4, false));
+  windows = state.syncWindows();
+  ASSERT_EQ(windows.size(), 1);
+  EXPECT_EQ(windows[0].peer_id, peer1);
+  EXPECT_TRUE(state.acceptSyncWindowPeriod(peer1, 1, false));
+  EXPECT_TRUE(state.acceptSyncWindowPeriod(peer1, 2, false));
+  EXPECT_TRUE(state.syncWindows().empty());
+
+  // Window without progress is taken as stalled and requested from another peer, late periods of the stalled peer are
+  // ignored then
+  state.addSyncWindow({5, 6, 5, peer1, now - std::chrono::seconds(20)});
+  state.addSyncWindow({7, 8, 7, peer2, now});
+  const auto stalled = state.takeStalledSyncWindows();
+  ASSERT_EQ(stalled.size(), 1);
+  EXPECT_EQ(stalled[0].peer_id, peer1);
+  EXPECT_EQ(stalled[0].from, 5);
+  state.addSyncWindow({stalled[0].from, stalled[0].to, stalled[0].next, peer3, std::chrono::steady_clock::now()});
+  EXPECT_FALSE(state.acceptSyncWindowPeriod(peer1, 5, false));
+  EXPECT_TRUE(state.acceptSyncWindowPeriod(peer3, 5, false));
+  EXPECT_TRUE(state.takeStalledSyncWindows().empty());
+
+  // Peer that sent invalid data loses its windows, the other peers keep syncing
+  state.removePeerSyncWindows(peer3);
+  windows = state.syncWindows();
+  ASSERT_EQ(windows.size(), 1);
+  EXPECT_EQ(windows[0].peer_id, peer2);
+  EXPECT_FALSE(state.acceptSyncWindowPeriod(peer3, 6, false));
+  // Latest block of the peer's chain finishes its window
+  EXPECT_TRUE(state.acceptSyncWindowPeriod(peer2, 7, true));
+  EXPECT_TRUE(state.syncWindows().empty());
+}
+
+TEST_F(NetworkTest, pbft_sync_from_multiple_peers) {
+  constexpr PbftPeriod kChainSize = 20;
+  auto node_cfgs = make_node_cfgs(3, 1, 20);
+  const auto capture_path = data_dir / "pbft_sync_packets.log";
+  setPbftSyncWindowsNode(node_cfgs[2], node_cfgs[1], capture_path);
+  const auto sources = launchPbftSyncSources(slice(node_cfgs, 0, 2), kChainSize);
+  const auto chain_size = sources[0]->getPbftChain()->getPbftChainSize();
+
+  {
+    const auto node = launch_nodes({node_cfgs[2]}).front();
+    EXPECT_HAPPENS({60s, 100ms}, [&](auto& ctx) {
+      WAIT_EXPECT_EQ(ctx, node->getPbftChain()->getPbftChainSize(), chain_size)
+    });
+    for (PbftPeriod period = 1; period <= chain_size; ++period) {
+      EXPECT_EQ(node->getDB()->getPbftBlock(period)->getBlockHash(),
+                sources[0]->getDB()->getPbftBlock(period)->getBlockHash());
+    }
+  }
+
+  // Capture is complete once the node is destroyed
+  const auto sync_sources = pbftSyncSources(capture_path);
+  EXPECT_TRUE(sync_sources.contains(sources[0]->getNetwork()->getNodeId()));
+  EXPECT_TRUE(sync_sources.contains(sources[1]->getNetwork()->getNodeId()));
+}
+
+TEST_F(NetworkTest, pbft_sync_drops_invalid_window_peer) {
+  constexpr PbftPeriod kChainSize = 20;
+  auto node_cfgs = make_node_cfgs(3, 1, 20);
+  const auto capture_path = data_dir / "pbft_sync_packets.log";
+  setPbftSyncWindowsNode(node_cfgs[2], node_cfgs[1], capture_path);
+  const auto sources = launchPbftSyncSources(slice(node_cfgs, 0, 2), kChainSize);
+  const auto chain_size = sources[0]->getPbftChain()->getPbftChainSize();
+
+  // Node 1 serves periods with cert votes of a wrong previous block, so any window it serves is invalid
+  const auto db1 = sources[1]->getDB();
+  for (PbftPeriod period = chain_size; period >= 3; --period) {
+    auto period_data = *db1->getPeriodData(period);
+    period_data.previous_block_cert_votes = db1->getPeriodData(period - 1)->previous_block_cert_votes;
+    db1->insert(DbStorage::Columns::period_data, period, period_data.rlp());
+  }
+
+  const auto invalid_peer_id = sources[1]->getNetwork()->getNodeId();
+  {
+    const auto node = launch_nodes({node_cfgs[2]}).front();
+    EXPECT_HAPPENS({60s, 100ms}, [&](auto& ctx) {
+      WAIT_EXPECT_EQ(ctx, node->getPbftChain()->getPbftChainSize(), chain_size)
+    });
+    for (PbftPeriod period = 1; period <= chain_size; ++period) {
+      EXPECT_EQ(node->getDB()->getPbftBlock(period)->getBlockHash(),
+                sources[0]->getDB()->getPbftBlock(period)->getBlockHash());
+    }
+    // Peer is disconnected and blacklisted
+    EXPECT_FALSE(node->getNetwork()->getPeer(invalid_peer_id));
+  }
+
+  // Invalid peer was asked for a window and answered it
+  EXPECT_TRUE(pbftSyncSources(capture_path).contains(invalid_peer_id));
+}
+
 TEST_F(NetworkTest, transaction_gossip_selection) {
   class TestTransactionPacketHandler : public network::tarcap::TransactionPacketHandler {
    public:
@@ -1600,6 +1785,220 @@ TEST_F(NetworkTest, transaction_gossip_selection) {
   }
 }
 
+TEST_F(NetworkTest, transaction_announce_selection) {
+  class TestTransactionPacketHandler : public network::tarcap::TransactionPacketHandler {
+   public:
+    using TransactionPacketHandler::announceTransactionsHashes;
+  };
+
+  const size_t peers_count = 9;
+  auto trxs = samples::createSignedTrxSamples(1, 10, dev::KeyPair::create().secret(), {});
+  std::vector<
+      std::pair<std::shared_ptr<network::tarcap::TaraxaPeer>, std::pair<SharedTransactions, std::vector<trx_hash_t>>>>
+      peers_with_transactions;
+  for (size_t i = 0; i < peers_count; i++) {
+    peers_with_transactions.push_back(
+        {std::make_shared<network::tarcap::TaraxaPeer>(), {trxs, {trx_hash_t::random()}}});
+  }
+
+  // sqrt(9) peers keep bodies, all other get only hashes with bodies hashes first
+  TestTransactionPacketHandler::announceTransactionsHashes(peers_with_transactions);
+  size_t bodies_peers = 0;
+  for (const auto& [peer, transactions] : peers_with_transactions) {
+    if (!transactions.first.empty()) {
+      bodies_peers++;
+      EXPECT_EQ(transactions.second.size(), 1);
+      continue;
+    }
+    ASSERT_EQ(transactions.second.size(), trxs.size() + 1);
+    for (size_t i = 0; i < trxs.size(); i++) {
+      EXPECT_EQ(transactions.second[i], trxs[i]->getHash());
+    }
+  }
+  EXPECT_EQ(bodies_peers, 3);
+}
+
+TEST_F(NetworkTest, packets_compression_stats) {
+  network::tarcap::PacketsCompressionStats stats;
+
+  // Packets are compressed until enough samples are collected
+  for (size_t i = 0; i < 16; i++) {
+    EXPECT_TRUE(stats.shouldCompress(network::kVotePacket));
+    stats.addCompressedPacket(network::kVotePacket, 1000, 990, std::chrono::microseconds(10));
+    EXPECT_TRUE(stats.shouldCompress(network::kPbftSyncPacket));
+    stats.addCompressedPacket(network::kPbftSyncPacket, 1000, 300, std::chrono::microseconds(20));
+  }
+
+  // Incompressible type is only resampled once per interval
+  size_t compressed = 0;
+  for (size_t i = 0; i < 128; i++) {
+    compressed += stats.shouldCompress(network::kVotePacket);
+    EXPECT_TRUE(stats.shouldCompress(network::kPbftSyncPacket));
+  }
+  EXPECT_EQ(compressed, 2);
+
+  const auto packets_stats = stats.getStats();
+  ASSERT_EQ(packets_stats.size(), 2);
+  EXPECT_EQ(packets_stats[0].packet_type, network::kVotePacket);
+  EXPECT_EQ(packets_stats[0].count, 16);
+  EXPECT_EQ(packets_stats[1].packet_type, network::kPbftSyncPacket);
+  EXPECT_EQ(packets_stats[1].compressed_size, 16 * 300);
+  EXPECT_EQ(packets_stats[1].duration, std::chrono::microseconds(16 * 20));
+}
+
+TEST_F(NetworkTest, sharded_packets_stats) {
+  network::tarcap::PacketsStats stats;
+  const network::tarcap::PacketStats packet{1, 100, std::chrono::microseconds(10), std::chrono::microseconds(5)};
+
+  // More threads than shards, so some of them share the last shard
+  auto add_packets = [&](size_t threads_count, size_t packets_count) {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threads_count; i++) {
+      threads.emplace_back([&, i] {
+        for (size_t j = 0; j < packets_count; j++) {
+          stats.addPacket(i % 2 ? network::kVotePacket : network::kDagBlockPacket, packet);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  };
+
+  const size_t threads_count = network::tarcap::PacketsStats::kShardsCount + 8;
+  add_packets(threads_count, 1000);
+  auto [start_time, all_stats] = stats.getAllPacketsStatsCopy();
+  EXPECT_EQ(all_stats.count_, threads_count * 1000);
+  EXPECT_EQ(all_stats.size_, threads_count * 1000 * 100);
+  EXPECT_EQ(all_stats.processing_duration_, std::chrono::microseconds(threads_count * 1000 * 10));
+  EXPECT_EQ(all_stats.tp_wait_duration_, std::chrono::microseconds(threads_count * 1000 * 5));
+
+  const auto stats_json = stats.getStatsJson();
+  ASSERT_EQ(stats_json["packets"].size(), 3);
+  EXPECT_EQ(stats_json["packets"][0]["type"].asString(), "ALL_PACKETS_COMBINED");
+
+  // Reset only hides packets added before it
+  stats.resetStats();
+  EXPECT_EQ(stats.getAllPacketsStatsCopy().second.count_, 0);
+  add_packets(2, 10);
+  std::tie(start_time, all_stats) = stats.getAllPacketsStatsCopy();
+  EXPECT_EQ(all_stats.count_, 20);
+  EXPECT_EQ(all_stats.size_, 20 * 100);
+}
+
+TEST_F(NetworkTest, packets_capture) {
+  const auto path = data_dir / "packets.log";
+  const dev::p2p::NodeID peer1(1), peer2(2);
+  const dev::bytes vote_rlp{0xc1, 0x01}, dag_block_rlp{0xc0};
+  {
+    network::tarcap::PacketsCapture capture(path);
+    capture.record(network::kVotePacket, peer1, &vote_rlp);
+  }
+  {
+    // Existing log is continued
+    network::tarcap::PacketsCapture capture(path);
+    capture.record(network::kDagBlockPacket, peer2, &dag_block_rlp);
+  }
+
+  network::tarcap::PacketsCapture::Reader reader(path);
+  const auto first = reader.next();
+  ASSERT_TRUE(first.has_value());
+  EXPECT_EQ(first->type, network::kVotePacket);
+  EXPECT_EQ(first->peer, peer1);
+  EXPECT_EQ(first->rlp, vote_rlp);
+  const auto second = reader.next();
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(second->type, network::kDagBlockPacket);
+  EXPECT_EQ(second->peer, peer2);
+  EXPECT_GE(second->time, first->time);
+  EXPECT_FALSE(reader.next().has_value());
+
+  std::ofstream(data_dir / "not_a_log") << "garbage";
+  EXPECT_THROW(network::tarcap::PacketsCapture::Reader(data_dir / "not_a_log"), std::runtime_error);
+}
+
+TEST_F(NetworkTest, sync_upload_bandwidth) {
+  network::tarcap::TokenBucket bucket(1000, 2000);
+  const auto now = std::chrono::steady_clock::now();
+  // Burst is available at once, then bucket goes into debt
+  EXPECT_EQ(bucket.consume(2000, now), std::chrono::microseconds(0));
+  EXPECT_EQ(bucket.consume(500, now), std::chrono::milliseconds(500));
+  // Debt is repaid by the rate
+  EXPECT_EQ(bucket.consume(500, now + std::chrono::seconds(1)), std::chrono::microseconds(0));
+
+  SyncUploadConfig config;
+  config.peer_bytes_per_second = 1000;
+  config.total_bytes_per_second = 1500;
+  network::tarcap::UploadBandwidthManager upload_bandwidth(config);
+  const auto peer1 = dev::KeyPair::create().pub();
+  const auto peer2 = dev::KeyPair::create().pub();
+  EXPECT_EQ(upload_bandwidth.reserve(peer1, 1000), std::chrono::microseconds(0));
+  // Peer budget is not exhausted but total one is
+  EXPECT_GT(upload_bandwidth.reserve(peer2, 1000), std::chrono::milliseconds(300));
+  EXPECT_EQ(upload_bandwidth.sentBytes(), 2000);
+
+  EXPECT_TRUE(network::tarcap::UploadBandwidthManager::isThrottled(network::kPbftSyncPacket));
+  EXPECT_FALSE(network::tarcap::UploadBandwidthManager::isThrottled(network::kVotePacket));
+}
+
+TEST_F(NetworkTest, transactions_sketch_reconciliation) {
+  using network::tarcap::TransactionsSketch;
+  const auto cells = TransactionsSketch::cellsCount(16);
+  TransactionsSketch local(cells), remote(cells);
+  for (size_t i = 0; i < 1000; ++i) {
+    const auto short_id = TransactionsSketch::shortId(trx_hash_t::random());
+    local.add(short_id);
+    remote.add(short_id);
+  }
+  const auto local_only = TransactionsSketch::shortId(trx_hash_t::random());
+  const auto remote_only = TransactionsSketch::shortId(trx_hash_t::random());
+  local.add(local_only);
+  remote.add(remote_only);
+
+  // Size doesn't depend on pool size
+  const auto remote_bytes = remote.toBytes();
+  EXPECT_EQ(remote_bytes.size(), cells * TransactionsSketch::kCellSize);
+  local.subtract(TransactionsSketch::fromBytes(remote_bytes));
+  const auto difference = local.decode();
+  ASSERT_TRUE(difference);
+  EXPECT_EQ(difference->local, std::vector<uint64_t>{local_only});
+  EXPECT_EQ(difference->remote, std::vector<uint64_t>{remote_only});
+
+  // Difference over capacity is not decoded
+  TransactionsSketch small(TransactionsSketch::cellsCount(1));
+  for (size_t i = 0; i < 100; ++i) {
+    small.add(TransactionsSketch::shortId(trx_hash_t::random()));
+  }
+  EXPECT_FALSE(small.decode());
+  EXPECT_THROW(TransactionsSketch::fromBytes(dev::bytes(TransactionsSketch::kCellSize + 1)), std::invalid_argument);
+}
+
+TEST_F(NetworkTest, node_load_levels) {
+  using network::tarcap::LoadLevel;
+  network::tarcap::NodeLoad node_load(100, 1000);
+  network::tarcap::NodeLoad::Sample sample;
+  EXPECT_EQ(node_load.grade(sample), LoadLevel::kNormal);
+
+  // Worst backlog decides
+  sample.queued_packets = 30;
+  sample.transactions_pool_size = 900;
+  EXPECT_EQ(node_load.grade(sample), LoadLevel::kHigh);
+  sample.finalization_lag = network::tarcap::NodeLoad::kCriticalFinalizationLag;
+  EXPECT_EQ(node_load.grade(sample), LoadLevel::kCritical);
+  // Full pool is never critical
+  EXPECT_EQ(node_load.grade({.transactions_pool_size = 1000}), LoadLevel::kHigh);
+  EXPECT_EQ(node_load.grade({.queued_packets = 101}), LoadLevel::kCritical);
+  EXPECT_EQ(node_load.grade({.avg_packet_queue_wait = network::tarcap::NodeLoad::kHighPacketQueueWait}),
+            LoadLevel::kHigh);
+
+  // Level rises at once and drops by one grade per update
+  EXPECT_EQ(node_load.update(sample), LoadLevel::kCritical);
+  EXPECT_EQ(node_load.update({}), LoadLevel::kHigh);
+  EXPECT_EQ(node_load.update({}), LoadLevel::kElevated);
+  EXPECT_EQ(node_load.update({}), LoadLevel::kNormal);
+  EXPECT_EQ(node_load.level(), LoadLevel::kNormal);
+}
+
 // Test creates multiple nodes and creates new transactions in random time
 // intervals on randomly selected nodes It verifies that the blocks created from
 // these transactions which get created on random nodes are synced and the
@@ -1786,6 +2185,27 @@ TEST_F(NetworkTest, suspicious_packets) {
   EXPECT_TRUE(peer.reportSuspiciousPacket());*/
 }
 
+TEST_F(NetworkTest, peer_gossip_score) {
+  network::tarcap::TaraxaPeer unmeasured, slow, fast, relaying;
+  slow.ping_rtt_us_ = 80000;
+  fast.ping_rtt_us_ = 20000;
+  relaying.ping_rtt_us_ = 30000;
+
+  // Peers without measured latency go last
+  EXPECT_EQ(unmeasured.gossipScore(), std::numeric_limits<uint64_t>::max());
+  EXPECT_LT(fast.gossipScore(), slow.gossipScore());
+  EXPECT_LT(fast.gossipScore(), relaying.gossipScore());
+
+  // Votes delivered first reduce the score by 1ms each, at most by half of the latency
+  relaying.first_delivered_votes_ = 11;
+  EXPECT_EQ(relaying.gossipScore(), 19000);
+  relaying.first_delivered_votes_ = 1000;
+  EXPECT_EQ(relaying.gossipScore(), 15000);
+
+  relaying.decayGossipStats();
+  EXPECT_EQ(relaying.first_delivered_votes_, 500);
+}
+
 TEST_F(NetworkTest, dag_syncing_limit) {
   network::tarcap::TaraxaPeer peer1, peer2;
   const uint64_t dag_sync_limit = 60;
@@ -1846,6 +2266,42 @@ TEST_F(NetworkTest, peer_cache_test) {
   }
 }
 
+TEST_F(NetworkTest, sharded_peer_cache_test) {
+  const uint64_t max_cache_size = 200000;
+  const uint64_t delete_step = 16000;
+  const uint64_t max_block_to_keep_in_cache = 10;
+  const uint64_t transactions_in_block = 2000;
+  ShardedExpirationCache<trx_hash_t> known_transactions_with_block_number(max_cache_size, delete_step,
+                                                                          max_block_to_keep_in_cache);
+  ShardedExpirationCache<trx_hash_t> known_transactions(max_cache_size, delete_step);
+  for (uint64_t block_number = 1; block_number < 300; block_number++) {
+    for (uint64_t i = 0; i < transactions_in_block; i++) {
+      const trx_hash_t hash(block_number * transactions_in_block + i);
+      EXPECT_TRUE(known_transactions_with_block_number.insert(hash, block_number));
+      EXPECT_FALSE(known_transactions_with_block_number.insert(hash, block_number));
+      known_transactions.insert(hash);
+    }
+    const uint64_t number_of_insertion = block_number * transactions_in_block;
+    // Shards are filled unevenly, so the limit is reached per shard and size stays within a delete step of it
+    EXPECT_LE(known_transactions.size(), max_cache_size);
+    if (number_of_insertion > 2 * max_cache_size) {
+      EXPECT_GE(known_transactions.size(), max_cache_size - delete_step);
+    }
+    const uint64_t expected_known_transactions_with_block_number =
+        std::min(number_of_insertion, (max_block_to_keep_in_cache + 1) * transactions_in_block);
+    EXPECT_EQ(known_transactions_with_block_number.size(), expected_known_transactions_with_block_number);
+  }
+
+  const trx_hash_t last_hash(299 * transactions_in_block);
+  EXPECT_TRUE(known_transactions_with_block_number.contains(last_hash));
+  EXPECT_FALSE(known_transactions_with_block_number.contains(trx_hash_t(transactions_in_block)));
+  known_transactions_with_block_number.erase(last_hash);
+  EXPECT_FALSE(known_transactions_with_block_number.contains(last_hash));
+  EXPECT_EQ(known_transactions_with_block_number.count(trx_hash_t(299 * transactions_in_block + 1)), 1);
+  known_transactions_with_block_number.clear();
+  EXPECT_EQ(known_transactions_with_block_number.size(), 0);
+}
+
 TEST_F(NetworkTest, pbft_sync_packet_rlp_encoding) {
   auto node_cfgs = make_node_cfgs(1, 1, 5);
   auto nodes = create_nodes(node_cfgs, true);
@@ -1859,8 +2315,11 @@ TEST_F(NetworkTest, pbft_sync_packet_rlp_encoding) {
   for (int i = 1; i <= blocks_to_check; i++) {
     auto raw_data = nodes[0]->getDB()->getPeriodDataRaw(i);
     ASSERT_NE(raw_data.size(), 0);
+    const auto period_data_view = nodes[0]->getDB()->getPeriodDataView(i);
+    ASSERT_EQ(period_data_view.raw().toBytes(), raw_data);
+    EXPECT_EQ(period_data_view.pbftBlock().getBlockHash(), nodes[0]->getDB()->getPbftBlock(i)->getBlockHash());
 
-    auto raw_packet = std::make_shared<network::tarcap::PbftSyncPacketRaw>(true, raw_data);
+    auto raw_packet = std::make_shared<network::tarcap::PbftSyncPacketRaw>(true, period_data_view.raw());
 
     auto encoded = util::rlp_enc(raw_packet);
     auto decoded = util::rlp_dec<network::tarcap::PbftSyncPacket>(dev::RLP(encoded));
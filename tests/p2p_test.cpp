@@ -3,7 +3,9 @@
 #include <libp2p/Capability.h>
 #include <libp2p/Common.h>
 #include <libp2p/Host.h>
+#include <libp2p/IpRateLimiter.h>
 #include <libp2p/Network.h>
+#include <libp2p/ReceiveBufferPool.h>
 #include <libp2p/Session.h>
 
 #include "common/init.hpp"
@@ -35,7 +37,8 @@ class TestTaraxaCapability final : public dev::p2p::CapabilityFace {
   unsigned messageCount() const override { return 0; }
   void onConnect(std::weak_ptr<dev::p2p::Session>, u256 const &) override {}
   void onDisconnect(dev::p2p::NodeID const &) override {}
-  void interpretCapabilityPacket(std::weak_ptr<dev::p2p::Session>, unsigned, dev::RLP const &) override {}
+  void interpretCapabilityPacket(std::weak_ptr<dev::p2p::Session>, unsigned, dev::RLP const &,
+                                 dev::p2p::ReceiveBuffer const &) override {}
   std::string packetTypeToString(unsigned) const override { return ""; }
 
  private:
@@ -90,6 +93,12 @@ TEST_F(P2PTest, p2p_discovery) {
   wait({60s, 500ms}, [&](auto &ctx) {
     for (int j = 0; j < NUMBER_OF_NODES; ++j) WAIT_EXPECT_LT(ctx, nodes[j]->getNodeCount(), NUMBER_OF_NODES / 3);
   });
+
+  // Boot node answers FindNode requests from its neighbours snapshot
+  const auto boot_stats = bootHost->discoveryStats();
+  EXPECT_GT(boot_stats.findNodeAnswered, 0);
+  EXPECT_GE(boot_stats.packetsReceived, boot_stats.findNodeAnswered);
+  EXPECT_EQ(boot_stats.nodesCount, bootHost->getNodeCount());
 }
 
 TEST_F(P2PTest, multiple_capabilities) {
@@ -151,6 +160,132 @@ TEST_F(P2PTest, multiple_capabilities) {
   }
 }
 
+// Records arrival of the first packet, sends from the session it was connected with
+class PingTestCapability final : public dev::p2p::CapabilityFace {
+ public:
+  std::string name() const override { return "ping"; }
+  taraxa::network::tarcap::TarcapVersion version() const override { return 1; }
+  unsigned messageCount() const override { return 1; }
+  void onConnect(std::weak_ptr<dev::p2p::Session> session, u256 const &) override {
+    std::scoped_lock lock(mutex_);
+    session_ = std::move(session);
+  }
+  void onDisconnect(dev::p2p::NodeID const &) override {}
+  void interpretCapabilityPacket(std::weak_ptr<dev::p2p::Session>, unsigned, dev::RLP const &,
+                                 dev::p2p::ReceiveBuffer const &) override {
+    std::scoped_lock lock(mutex_);
+    if (!received_) {
+      received_ = std::chrono::steady_clock::now();
+    }
+  }
+  std::string packetTypeToString(unsigned) const override { return "ping"; }
+
+  bool send() {
+    std::scoped_lock lock(mutex_);
+    auto session = session_.lock();
+    if (!session) {
+      return false;
+    }
+    session->send(name(), 0, RLPStream(0).out());
+    return true;
+  }
+  std::optional<std::chrono::steady_clock::time_point> received() const {
+    std::scoped_lock lock(mutex_);
+    return received_;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::weak_ptr<dev::p2p::Session> session_;
+  std::optional<std::chrono::steady_clock::time_point> received_;
+};
+
+TEST_F(P2PTest, link_emulation_latency) {
+  auto boot_node = Host::make(
+      "TaraxaNode", [](auto /*host*/) { return Host::CapabilityList{}; }, dev::KeyPair::create(),
+      dev::p2p::NetworkConfig("127.0.0.1", 20011, false, true), TaraxaNetworkConfig{.is_boot_node = true});
+  util::ThreadPool tp;
+  tp.post_loop({}, [=] { boot_node->do_work(); });
+
+  TaraxaNetworkConfig taraxa_net_conf;
+  taraxa_net_conf.link_emulation.latency = 300ms;
+  std::vector<std::shared_ptr<PingTestCapability>> caps;
+  std::vector<std::shared_ptr<dev::p2p::Host>> nodes;
+  for (unsigned short i = 0; i < 2; ++i) {
+    auto cap = caps.emplace_back(std::make_shared<PingTestCapability>());
+    auto node = nodes.emplace_back(Host::make(
+        "TaraxaNode", [cap](auto /*host*/) { return Host::CapabilityList{cap}; }, dev::KeyPair::create(),
+        dev::p2p::NetworkConfig("127.0.0.1", 20012 + i, false, true), taraxa_net_conf));
+    node->addNode(Node(boot_node->id(), dev::p2p::NodeIPEndpoint(bi::make_address("127.0.0.1"), 20011, 20011)));
+    tp.post_loop({}, [=] { node->do_work(); });
+  }
+  wait({60s, 500ms}, [&](auto &ctx) {
+    WAIT_EXPECT_EQ(ctx, nodes[0]->peer_count(), 1);
+    WAIT_EXPECT_EQ(ctx, nodes[1]->peer_count(), 1);
+  });
+
+  const auto sent = std::chrono::steady_clock::now();
+  ASSERT_TRUE(caps[0]->send());
+  wait({10s, 50ms}, [&](auto &ctx) { WAIT_EXPECT_TRUE(ctx, caps[1]->received().has_value()); });
+  EXPECT_GE(*caps[1]->received() - sent, 300ms);
+}
+
+TEST_F(P2PTest, ip_rate_limiter) {
+  IpRateLimiter limiter(2, std::chrono::seconds(10));
+  auto const now = std::chrono::steady_clock::now();
+  auto const address = bi::make_address("10.0.0.1");
+
+  EXPECT_TRUE(limiter.allow(address, now));
+  EXPECT_TRUE(limiter.allow(address, now));
+  EXPECT_FALSE(limiter.allow(address, now + std::chrono::seconds(1)));
+  // Other addresses and loopback have own limits
+  EXPECT_TRUE(limiter.allow(bi::make_address("10.0.0.2"), now));
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(limiter.allow(bi::make_address("127.0.0.1"), now));
+  }
+
+  // New window
+  EXPECT_TRUE(limiter.allow(address, now + std::chrono::seconds(10)));
+  EXPECT_EQ(limiter.size(), 2);
+  limiter.prune(now + std::chrono::seconds(15));
+  EXPECT_EQ(limiter.size(), 1);
+}
+
+TEST_F(P2PTest, receive_buffer_pool) {
+  auto pool = ReceiveBufferPool::make(1, 1024);
+
+  auto buffer = pool->acquire();
+  buffer->resize(100);
+  auto const data = buffer->data();
+  auto held = buffer;
+  buffer.reset();
+  // Buffer is still held, e.g. by queued packet
+  EXPECT_EQ(pool->pooled(), 0u);
+  held.reset();
+  EXPECT_EQ(pool->pooled(), 1u);
+
+  // Reused buffer is empty with capacity kept
+  buffer = pool->acquire();
+  EXPECT_EQ(pool->pooled(), 0u);
+  EXPECT_TRUE(buffer->empty());
+  EXPECT_EQ(buffer->data(), data);
+
+  // Buffers over the capacity limit and over the pooled count are freed
+  auto other = pool->acquire();
+  other->resize(2048);
+  other.reset();
+  EXPECT_EQ(pool->pooled(), 0u);
+  other = pool->acquire();
+  buffer.reset();
+  other.reset();
+  EXPECT_EQ(pool->pooled(), 1u);
+
+  // Buffer may outlive its pool
+  buffer = pool->acquire();
+  pool.reset();
+  buffer.reset();
+}
+
 }  // namespace taraxa::core_tests
 
 using namespace taraxa;
@@ -38,7 +38,7 @@ TEST_F(PbftChainTest, pbft_db_test) {
   auto db = node->getDB();
   std::shared_ptr<PbftChain> pbft_chain = node->getPbftChain();
   blk_hash_t pbft_chain_head_hash = pbft_chain->getHeadHash();
-  std::string pbft_head_from_db = db->getPbftHead(pbft_chain_head_hash);
+  auto pbft_head_from_db = db->getPbftHead(pbft_chain_head_hash);
   EXPECT_FALSE(pbft_head_from_db.empty());
 
   auto dag_genesis = node->getConfig().genesis.dag_genesis_block.getHash();
@@ -70,8 +70,7 @@ TEST_F(PbftChainTest, pbft_db_test) {
   // Update PBFT chain
   pbft_chain->updatePbftChain(pbft_block.getBlockHash(), pbft_block.getPivotDagBlockHash());
   // Update PBFT chain head block
-  std::string pbft_chain_head_str = pbft_chain->getJsonStr();
-  db->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain_head_str, batch);
+  db->addPbftHeadToBatch(pbft_chain_head_hash, pbft_chain->getHeadRlp(), batch);
   db->commitWriteBatch(batch);
   EXPECT_EQ(pbft_chain->getPbftChainSize(), 1);
 
@@ -80,7 +79,7 @@ TEST_F(PbftChainTest, pbft_db_test) {
 
   // check pbft genesis update in DB
   pbft_head_from_db = db->getPbftHead(pbft_chain_head_hash);
-  EXPECT_EQ(pbft_head_from_db, pbft_chain->getJsonStr());
+  EXPECT_EQ(pbft_head_from_db, pbft_chain->getHeadRlp());
 }
 
 }  // namespace taraxa::core_tests
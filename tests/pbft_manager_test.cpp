@@ -454,7 +454,7 @@ TEST_F(PbftManagerTest, propose_block_and_vote_broadcast) {
   ASSERT_TRUE(block1_from_node1);
   EXPECT_EQ(block1_from_node1->getJsonStr(), proposed_pbft_block->getJsonStr());
 
-  nw1->getSpecificHandler<network::tarcap::IVotePacketHandler>(network::SubprotocolPacketType::kVotePacket)
+  nw1->getSpecificHandler<network::SubprotocolPacketType::kVotePacket>()
       ->onNewPbftVote(propose_vote, proposed_pbft_block);
 
   // Check node2 and node3 receive the PBFT block
@@ -707,6 +707,18 @@ TEST_F(PbftManagerWithDagCreation, proposed_blocks) {
   for (auto b : blocks_from_db) {
     EXPECT_TRUE(blocks.find(b->getBlockHash()) != blocks.end());
   }
+
+  // Validation results are kept with the block
+  const auto validated_block = blocks.begin()->second;
+  const auto period = validated_block->getPeriod();
+  EXPECT_FALSE(proposed_blocks.getPbftProposedBlock(period, validated_block->getBlockHash())->second);
+  EXPECT_EQ(proposed_blocks.getValidatedBlockData(period, validated_block->getBlockHash()), nullptr);
+  auto validated_data = std::make_shared<ValidatedBlockData>();
+  validated_data->transactions = {trx_hash_t(1), trx_hash_t(2)};
+  proposed_blocks.markBlockAsValid(validated_block, validated_data);
+  EXPECT_TRUE(proposed_blocks.getPbftProposedBlock(period, validated_block->getBlockHash())->second);
+  EXPECT_EQ(proposed_blocks.getValidatedBlockData(period, validated_block->getBlockHash()), validated_data);
+
   now = std::chrono::steady_clock::now();
   proposed_blocks.cleanupProposedPbftBlocksByPeriod(4);
   std::cout << "Time to erase " << block_count
@@ -714,6 +726,10 @@ TEST_F(PbftManagerWithDagCreation, proposed_blocks) {
             << " microseconds" << std::endl;
   blocks_from_db = db->getProposedPbftBlocks();
   EXPECT_EQ(blocks_from_db.size(), 0);
+
+  // Late validation result of a cleaned up block is ignored
+  proposed_blocks.markBlockAsValid(validated_block, validated_data);
+  EXPECT_FALSE(proposed_blocks.isInProposedBlocks(period, validated_block->getBlockHash()));
 }
 
 TEST_F(PbftManagerWithDagCreation, state_root_hash) {
@@ -2,6 +2,7 @@
 
 #include "common/encoding_solidity.hpp"
 #include "common/init.hpp"
+#include "common/jsoncpp.hpp"
 #include "logger/logger.hpp"
 #include "pbft/pbft_manager.hpp"
 #include "pillar_chain/pillar_chain_manager.hpp"
@@ -91,9 +92,57 @@ TEST_F(PillarChainTest, pillar_blocks_create) {
     ASSERT_TRUE(latest_pillar_block);
     ASSERT_EQ(latest_pillar_block->getPeriod(),
               pillar_blocks_count * node_cfgs[0].genesis.state.hardforks.ficus_hf.pillar_blocks_interval);
+    EXPECT_TRUE(node->getPillarChainManager()->verifyStateCheckpoint());
   }
 }
 
+TEST_F(PillarChainTest, pillar_blocks_data) {
+  auto node_cfgs = make_node_cfgs(2, 2, 10);
+  for (auto& node_cfg : node_cfgs) {
+    node_cfg.genesis.state.dpos.delegation_delay = 1;
+    node_cfg.genesis.state.hardforks.ficus_hf.block_num = 0;
+    node_cfg.genesis.state.hardforks.ficus_hf.pillar_blocks_interval = 4;
+  }
+  const auto interval = node_cfgs[0].genesis.state.hardforks.ficus_hf.pillar_blocks_interval;
+
+  auto nodes = launch_nodes(node_cfgs);
+  const auto& pillar_chain_mgr = nodes[0]->getPillarChainManager();
+
+  // Wait until 2 pillar blocks are finalized
+  ASSERT_HAPPENS({20s, 250ms}, [&](auto& ctx) {
+    const auto last_finalized = pillar_chain_mgr->getLastFinalizedPillarBlock();
+    WAIT_EXPECT_TRUE(ctx, last_finalized && last_finalized->getPeriod() >= 2 * interval)
+  });
+
+  const auto blocks_data = pillar_chain_mgr->getPillarBlocksData(0, 2);
+  ASSERT_EQ(blocks_data.size(), 2u);
+  for (size_t i = 0; i < blocks_data.size(); ++i) {
+    const auto& data = blocks_data[i];
+    EXPECT_EQ(data->period, (i + 1) * interval);
+    EXPECT_EQ(data, pillar_chain_mgr->getPillarBlockData(data->period));
+
+    const auto pillar_block = nodes[0]->getDB()->getPillarBlock(data->period);
+    ASSERT_TRUE(pillar_block);
+    EXPECT_EQ(data->json["pillar_block"], pillar_block->getJson());
+    EXPECT_FALSE(data->json.isMember("signatures"));
+    EXPECT_EQ(data->json_with_signatures["pillar_block"], pillar_block->getJson());
+    EXPECT_FALSE(data->json_with_signatures["signatures"].empty());
+    EXPECT_EQ(*data->json_str, util::to_string(data->json));
+    EXPECT_EQ(*data->json_with_signatures_str, util::to_string(data->json_with_signatures));
+
+    const auto decoded = pillar_chain::PillarBlockData(dev::RLP(*data->rlp_with_signatures));
+    EXPECT_EQ(decoded.block_->getHash(), pillar_block->getHash());
+    EXPECT_EQ(decoded.pillar_votes_.size(), data->json_with_signatures["signatures"].size());
+    EXPECT_EQ(pillar_chain::PillarBlock(dev::RLP(*data->rlp)).getHash(), pillar_block->getHash());
+  }
+
+  // Range starts at the next pillar block period
+  const auto from_second = pillar_chain_mgr->getPillarBlocksData(interval + 1, 10);
+  ASSERT_FALSE(from_second.empty());
+  EXPECT_EQ(from_second.front()->period, 2 * interval);
+  EXPECT_FALSE(pillar_chain_mgr->getPillarBlockData(interval + 1));
+}
+
 TEST_F(PillarChainTest, votes_count_changes) {
   const auto validators_count = 5;
   auto node_cfgs = make_node_cfgs(validators_count, validators_count, 10);
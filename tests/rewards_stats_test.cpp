@@ -242,6 +242,45 @@ TEST_F(RewardsStatsTest, feeRewards) {
   }
 }
 
+TEST_F(RewardsStatsTest, preparedFeeRewards) {
+  auto db = std::make_shared<DbStorage>(data_dir / "db");
+  auto batch = db->createWriteBatch();
+  auto pbft_proposer = dev::KeyPair::create();
+  auto dag_proposer = dev::KeyPair::create();
+
+  auto rewards_stats = TestableRewardsStats({}, db);
+
+  std::vector<std::shared_ptr<PbftVote>> empty_votes;
+  const auto trx_gas_fee = 1000000000;
+  const auto gas_used = 500000;
+  auto trx = std::make_shared<Transaction>(1, 0, trx_gas_fee, 1000000, dev::fromHex(samples::greeter_contract_code),
+                                           pbft_proposer.secret());
+  auto dag_blk = std::make_shared<DagBlock>(blk_hash_t{}, level_t{}, vec_blk_t{}, vec_trx_t{trx->getHash()}, 0,
+                                            VdfSortition{}, dag_proposer.secret());
+  std::vector<vote_hash_t> reward_votes_hashes;
+  auto pbft_block = std::make_shared<PbftBlock>(kNullBlockHash, kNullBlockHash, kNullBlockHash, kNullBlockHash, 1,
+                                                addr_t::random(), pbft_proposer.secret(), reward_votes_hashes);
+  PeriodData period_data(pbft_block, empty_votes);
+  period_data.dag_blocks = {dag_blk};
+  period_data.transactions = {trx};
+
+  auto prepared = rewards_stats.prepareBlockStats(period_data, 0);
+  for (const auto& vs : reinterpret_cast<TestableBlockStats*>(&prepared)->getValidatorStats()) {
+    ASSERT_EQ(vs.second.fees_rewards_, 0);
+  }
+
+  auto stats = rewards_stats.processStats(period_data, std::move(prepared), {gas_used}, batch).front();
+  auto expected = rewards_stats.processStats(period_data, 0, {gas_used}, batch).front();
+  const auto& validators_stats = reinterpret_cast<TestableBlockStats*>(&stats)->getValidatorStats();
+  const auto& expected_stats = reinterpret_cast<TestableBlockStats*>(&expected)->getValidatorStats();
+  ASSERT_EQ(validators_stats.size(), expected_stats.size());
+  for (const auto& [validator, vs] : expected_stats) {
+    ASSERT_EQ(validators_stats.at(validator).dag_blocks_count_, vs.dag_blocks_count_);
+    ASSERT_EQ(validators_stats.at(validator).fees_rewards_, vs.fees_rewards_);
+  }
+  ASSERT_EQ(validators_stats.at(dag_proposer.address()).fees_rewards_, uint256_t(trx_gas_fee) * gas_used);
+}
+
 TEST_F(RewardsStatsTest, dagBlockRewards) {
   auto db = std::make_shared<DbStorage>(data_dir / "db");
   auto batch = db->createWriteBatch();
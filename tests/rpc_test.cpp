@@ -3,7 +3,12 @@
 #include <libdevcore/Common.h>
 #include <libdevcore/CommonJS.h>
 
+#include <future>
+
+#include "common/jsoncpp.hpp"
 #include "network/rpc/eth/Eth.h"
+#include "network/rpc/jsonrpc_dispatcher.hpp"
+#include "network/subscriptions.hpp"
 #include "test_util/samples.hpp"
 
 namespace taraxa::core_tests {
@@ -52,6 +57,8 @@ TEST_F(RPCTest, eth_estimateGas) {
     check_estimation_is_in_range(trx, "0x5208");  // 21k
     trx["from"] = from;
     check_estimation_is_in_range(trx, "0x5208");  // 21k
+    // Repeated estimation is served from cache
+    EXPECT_EQ(eth_json_rpc->eth_estimateGas(trx, ""), eth_json_rpc->eth_estimateGas(trx, ""));
   }
 
   // Test throw on failed transaction
@@ -280,6 +287,169 @@ TEST_F(RPCTest, transaction_json) {
   EXPECT_EQ(json["chainId"], dev::toJS(trx->getChainID()));
 }
 
+TEST_F(RPCTest, transaction_json_writer) {
+  auto trx = std::make_shared<Transaction>(0, 100, 1000000000, 100000, dev::fromHex("0x00ab"),
+                                           dev::KeyPair::create().secret(), dev::KeyPair::create().address(), 841);
+  const auto loc = net::rpc::eth::TransactionLocationWithBlockHash{TransactionLocation{1, 1}, h256(123)};
+
+  // Directly serialized response should be the same as the jsoncpp one
+  for (const auto& location : {std::optional(loc), std::optional<net::rpc::eth::TransactionLocationWithBlockHash>()}) {
+    std::string out;
+    net::JsonWriter writer(out);
+    net::rpc::eth::write(writer, *trx, location);
+    EXPECT_EQ(util::parse_json(out), toJson(*trx, location));
+  }
+}
+
+TEST_F(RPCTest, response_cache) {
+  const auto key = [](int i) { return net::JsonRpcResponseCache::makeKey("eth_getBlockByNumber", std::to_string(i)); };
+  const auto entry_size = key(0).size() + 10;
+  net::JsonRpcResponseCache cache(entry_size * 2);
+
+  cache.insert(key(0), std::string(10, '0'));
+  cache.insert(key(1), std::string(10, '1'));
+  EXPECT_EQ(*cache.get(key(0)), std::string(10, '0'));
+  // Least recently used entry is evicted
+  cache.insert(key(2), std::string(10, '2'));
+  EXPECT_EQ(cache.get(key(1)), nullptr);
+  EXPECT_EQ(*cache.get(key(0)), std::string(10, '0'));
+  EXPECT_EQ(*cache.get(key(2)), std::string(10, '2'));
+  EXPECT_EQ(cache.bytes(), entry_size * 2);
+
+  // Entries over budget are not cached at all
+  cache.insert(key(3), std::string(entry_size * 2, '3'));
+  EXPECT_EQ(cache.get(key(3)), nullptr);
+  EXPECT_EQ(cache.hits(), 3);
+  EXPECT_EQ(cache.misses(), 2);
+}
+
+TEST_F(RPCTest, dispatcher_limits) {
+  const JsonRpcDispatchConfig config{.threads = 1, .max_pending = 0, .expensive_methods = {{"eth_getLogs", 2}}};
+  net::JsonRpcDispatcher dispatcher(config, nullptr);
+
+  EXPECT_EQ(dispatcher.classify(R"({"jsonrpc":"2.0","id":1,"method" : "eth_getLogs","params":[{}]})"), "eth_getLogs");
+  EXPECT_EQ(dispatcher.classify(R"({"jsonrpc":"2.0","id":1,"method":"eth_blockNumber","params":[]})"), std::nullopt);
+  // Batches are served inline
+  EXPECT_EQ(dispatcher.classify(R"([{"jsonrpc":"2.0","id":1,"method":"eth_getLogs","params":[{}]}])"), std::nullopt);
+
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  std::atomic<int> processed = 0;
+  const auto task = [&] {
+    released.wait();
+    ++processed;
+  };
+  EXPECT_TRUE(dispatcher.post("eth_getLogs", task));
+  EXPECT_TRUE(dispatcher.post("eth_getLogs", task));
+  // Third concurrent request of the method is over its limit
+  EXPECT_FALSE(dispatcher.post("eth_getLogs", task));
+  EXPECT_EQ(dispatcher.rejected(), 1);
+
+  const auto response = util::parse_json(net::JsonRpcDispatcher::rejectedResponse(R"({"id":7})", "eth_getLogs"));
+  EXPECT_EQ(response["id"], 7);
+  EXPECT_EQ(response["error"]["code"], net::JsonRpcDispatcher::kRejectedErrorCode);
+
+  release.set_value();
+  EXPECT_HAPPENS({1s, 10ms}, [&](auto& ctx) { WAIT_EXPECT_TRUE(ctx, processed == 2 && dispatcher.running() == 0) });
+  EXPECT_TRUE(dispatcher.post("eth_getLogs", task));
+}
+
+TEST_F(RPCTest, logs_watches_index) {
+  using namespace net::rpc::eth;
+  Watches watches(WatchesConfig{});
+  const auto address = addr_t::random();
+  const auto topic = h256::random();
+  const auto by_address = watches.install_logs_watch(LogFilter(0, std::nullopt, {address}, {}));
+  const auto by_topic = watches.install_logs_watch(LogFilter(0, std::nullopt, {}, {{{topic}, {}, {}, {}}}));
+  const auto later_blocks = watches.install_logs_watch(LogFilter(2, std::nullopt, {address}, {}));
+
+  TransactionReceipt receipt;
+  receipt.logs = {{address, {h256::random()}, {}}, {addr_t::random(), {topic}, {}}, {address, {topic}, {}}};
+  ExtendedTransactionLocation trx_loc{{{1}, h256::random()}};
+  watches.process_logs(trx_loc, receipt);
+
+  const auto positions = [&](WatchID id) {
+    std::vector<uint64_t> ret;
+    for (const auto& lle : watches.logs_.poll(id)) {
+      ret.push_back(lle.position_in_receipt);
+    }
+    return ret;
+  };
+  EXPECT_EQ(positions(by_address), (std::vector<uint64_t>{0, 2}));
+  EXPECT_EQ(positions(by_topic), (std::vector<uint64_t>{1, 2}));
+  EXPECT_TRUE(positions(later_blocks).empty());
+
+  // Uninstalled watch is removed from the index as well
+  EXPECT_TRUE(watches.logs_.uninstall_watch(by_address));
+  watches.process_logs(trx_loc, receipt);
+  EXPECT_TRUE(positions(by_address).empty());
+  EXPECT_EQ(positions(by_topic).size(), 2);
+}
+
+TEST_F(RPCTest, rlp_subscriptions) {
+  using namespace net;
+  const auto trx_hash = trx_hash_t::random();
+  size_t encoded = 0;
+  const SubscriptionPayload payload(dev::toJS(trx_hash), [&] {
+    ++encoded;
+    return dev::rlp(trx_hash);
+  });
+
+  const auto json_message = TransactionsSubscription(1).processPayload(payload);
+  EXPECT_FALSE(json_message.binary);
+  EXPECT_EQ(encoded, 0);
+
+  for (const auto id : {2, 1000}) {
+    const auto message = TransactionsSubscription(id, SubscriptionEncoding::Rlp).processPayload(payload);
+    EXPECT_TRUE(message.binary);
+    EXPECT_EQ(message.body, payload.rlp());
+    const auto frame = message.prefix + *message.body + message.suffix;
+    const dev::RLP rlp(dev::bytesConstRef(reinterpret_cast<const ::byte*>(frame.data()), frame.size()));
+    ASSERT_EQ(rlp.itemCount(), 2);
+    EXPECT_EQ(rlp[0].toInt<int>(), id);
+    EXPECT_EQ(rlp[1].toHash<trx_hash_t>(), trx_hash);
+  }
+  EXPECT_EQ(encoded, 1);
+
+  // Payloads without rlp encoding are sent as json to rlp subscriptions
+  const SubscriptionPayload json_only(dev::toJS(trx_hash));
+  EXPECT_FALSE(HeadsSubscription(3, SubscriptionEncoding::Rlp).processPayload(json_only).binary);
+
+  // Long payload needs multi-byte list prefix
+  const auto long_rlp_payload = dev::rlp(dev::bytes(1000, 7));
+  const auto long_message = makeRlpSubscriptionResponse(
+      4, std::make_shared<const std::string>(long_rlp_payload.begin(), long_rlp_payload.end()));
+  const auto long_frame = long_message.prefix + *long_message.body;
+  const dev::RLP long_rlp(dev::bytesConstRef(reinterpret_cast<const ::byte*>(long_frame.data()), long_frame.size()));
+  EXPECT_EQ(long_rlp[0].toInt<int>(), 4);
+  EXPECT_EQ(long_rlp[1].toBytes(), dev::bytes(1000, 7));
+}
+
+TEST_F(RPCTest, transactions_batch_subscription) {
+  using namespace net;
+  const TransactionHashes hashes{trx_hash_t::random(), trx_hash_t::random(), trx_hash_t::random()};
+  const SubscriptionPayload payload(rpc::eth::toJsonArray(hashes), [&] { return dev::rlp(hashes); });
+
+  // Uncapped subscriptions share serialized batch
+  const auto uncapped = TransactionsBatchSubscription(1).processPayload(payload);
+  EXPECT_EQ(uncapped.body, payload.serialized());
+
+  // Rate cap cuts the batch and drops whole batches once the budget is used up
+  const TransactionsBatchSubscription capped(2, 2);
+  const auto cut = capped.processPayload(payload);
+  const auto cut_json = util::parse_json(cut.prefix + *cut.body + cut.suffix);
+  ASSERT_EQ(cut_json["params"]["result"].size(), 2);
+  EXPECT_EQ(cut_json["params"]["result"][1].asString(), dev::toJS(hashes[1]));
+  EXPECT_EQ(capped.processPayload(payload).size(), 0);
+
+  const TransactionsBatchSubscription capped_rlp(3, 1, SubscriptionEncoding::Rlp);
+  const auto cut_rlp = capped_rlp.processPayload(payload);
+  EXPECT_TRUE(cut_rlp.binary);
+  const auto frame = cut_rlp.prefix + *cut_rlp.body;
+  const dev::RLP rlp(dev::bytesConstRef(reinterpret_cast<const ::byte*>(frame.data()), frame.size()));
+  EXPECT_EQ(rlp[1].toVector<trx_hash_t>(), TransactionHashes{hashes[0]});
+}
+
 TEST_F(RPCTest, u256_h256_serialization) {
   auto str = std::string("0x09cf8cb3d2b55fcbddc997b8669dd37a84699886ea2e9d7c88217c8443cfa8b0");
   h256 val(str);
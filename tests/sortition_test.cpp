@@ -379,6 +379,35 @@ TEST_F(SortitionTest, get_params_from_period_reverse) {
   }
 }
 
+TEST_F(SortitionTest, params_changes_history_restart) {
+  auto& cfg = node_cfgs[0].genesis.sortition;
+  cfg.changing_interval = 10;
+  cfg.computation_interval = 10;
+  cfg.dag_efficiency_targets = {48 * kOnePercent, 52 * kOnePercent};
+
+  {
+    auto db = std::make_shared<DbStorage>(data_dir / "db");
+    SortitionParamsManager sp({}, node_cfgs[0], db);
+    auto batch = db->createWriteBatch();
+    for (PbftPeriod period = 10; period <= 50; period += 10) {
+      auto b = createBlock(period, 25 * kOnePercent);
+      sp.pbftBlockPushed(b, batch, b.pbft_blk->getPeriod());
+      db->commitWriteBatch(batch);
+    }
+  }
+
+  // History is loaded from db on restart and has to give the same answers as db lookup
+  auto db = std::make_shared<DbStorage>(data_dir / "db");
+  SortitionParamsManager sp({}, node_cfgs[0], db);
+  for (PbftPeriod period = 0; period < 70; ++period) {
+    const auto from_db = db->getParamsChangeForPeriod(period);
+    const auto from_memory = sp.getParamsChangeForPeriod(period);
+    ASSERT_EQ(from_db.has_value(), from_memory.has_value());
+    EXPECT_EQ(from_db->period, from_memory->period);
+    EXPECT_EQ(from_db->vrf_params.threshold_upper, from_memory->vrf_params.threshold_upper);
+  }
+}
+
 TEST_F(SortitionTest, efficiency_restart) {
   // Test verifies that the efficiency memory structure contains same values before and after node restart
   auto& cfg = node_cfgs[0].genesis.sortition;
@@ -8,6 +8,7 @@
 #include "network/tarcap/packets_handlers/latest/common/base_packet_handler.hpp"
 #include "network/tarcap/shared_states/peers_state.hpp"
 #include "network/threadpool/tarcap_thread_pool.hpp"
+#include "network/threadpool/workers_scaler.hpp"
 #include "test_util/test_util.hpp"
 
 namespace taraxa::core_tests {
@@ -264,9 +265,9 @@ std::pair<tarcap::TarcapVersion, threadpool::PacketData> createPacket(
   return {TARAXA_NET_VERSION, std::move(packet_data)};
 }
 
-bytes createDagBlockRlp(level_t level, uint32_t sig = 777) {
-  // Creates dag block rlp as it is required for blocking mask to extract dag block level
-  DagBlock blk(blk_hash_t(10), level, {}, {}, sig_t(sig), blk_hash_t(1), addr_t(15));
+bytes createDagBlockRlp(level_t level, uint32_t sig = 777, blk_hash_t pivot = blk_hash_t(10), vec_blk_t tips = {}) {
+  // Creates dag block rlp as it is required for blocking mask to extract dag block signature, pivot & tips
+  DagBlock blk(pivot, level, std::move(tips), {}, sig_t(sig), blk_hash_t(1), addr_t(15));
   return blk.rlp(true);
 }
 
@@ -751,13 +752,11 @@ TEST_F(TarcapTpTest, same_dag_blks_ordering) {
   });
 }
 
-// Test "dag-level blocking dependencies" related to dag blocks levels:
+// Test "dag-dependencies blocking dependencies" related to dag blocks pivot & tips:
 //
-// Ideally only dag blocks with the same level should be processed. In reality there are situation when node receives
-// dag block with smaller level than the level of blocks that are already being processed. In such case these blocks
-// with smaller levels can be processed concurrently with blocks that have higher level. All new dag blocks with higher
-// level than the lowest level from all the blocks that currently being processed are blocked for processing
-TEST_F(TarcapTpTest, dag_blks_lvls_ordering) {
+// Dag block can be processed only after its pivot and tips are processed. Dag blocks that do not depend on the blocks
+// that are currently being processed are processed concurrently, no matter what level they have
+TEST_F(TarcapTpTest, dag_blks_deps_ordering) {
   HandlersInitData init_data = createHandlersInitData();
 
   auto packets_handler = std::make_shared<tarcap::PacketsHandler>();
@@ -767,27 +766,25 @@ TEST_F(TarcapTpTest, dag_blks_lvls_ordering) {
   threadpool::PacketsThreadPool tp(10);
   tp.setPacketsHandlers(TARAXA_NET_VERSION, packets_handler);
 
+  const auto blk0_rlp = createDagBlockRlp(1, 1);
+  const auto blk1_rlp = createDagBlockRlp(1, 2);
+  const auto blk2_rlp = createDagBlockRlp(2, 3, dev::sha3(blk0_rlp));
+  const auto blk3_rlp = createDagBlockRlp(2, 4, blk_hash_t(11));
+  const auto blk4_rlp = createDagBlockRlp(3, 5, dev::sha3(blk2_rlp), {dev::sha3(blk1_rlp)});
+
   // Pushes packets to the tp
   const auto blk0_lvl1_id =
-      tp.push(createPacket(init_data.copySender(), SubprotocolPacketType::kDagBlockPacket, {createDagBlockRlp(1, 1)}))
-          .value();
+      tp.push(createPacket(init_data.copySender(), SubprotocolPacketType::kDagBlockPacket, {blk0_rlp})).value();
   const auto blk1_lvl1_id =
-      tp.push(createPacket(init_data.copySender(), SubprotocolPacketType::kDagBlockPacket, {createDagBlockRlp(1, 2)}))
-          .value();
-  const auto blk2_lvl0_id =
-      tp.push(createPacket(init_data.copySender(), SubprotocolPacketType::kDagBlockPacket, {createDagBlockRlp(0, 3)}))
-          .value();
-  const auto blk3_lvl1_id =
-      tp.push(createPacket(init_data.copySender(), SubprotocolPacketType::kDagBlockPacket, {createDagBlockRlp(1, 4)}))
-          .value();
-  const auto blk4_lvl2_id =
-      tp.push(createPacket(init_data.copySender(), SubprotocolPacketType::kDagBlockPacket, {createDagBlockRlp(2, 5)}))
-          .value();
+      tp.push(createPacket(init_data.copySender(), SubprotocolPacketType::kDagBlockPacket, {blk1_rlp})).value();
+  const auto blk2_lvl2_id =
+      tp.push(createPacket(init_data.copySender(), SubprotocolPacketType::kDagBlockPacket, {blk2_rlp})).value();
+  const auto blk3_lvl2_id =
+      tp.push(createPacket(init_data.copySender(), SubprotocolPacketType::kDagBlockPacket, {blk3_rlp})).value();
 
   size_t packets_count = 0;
-  const auto blk5_lvl3_id = packets_count =
-      tp.push(createPacket(init_data.copySender(), SubprotocolPacketType::kDagBlockPacket, {createDagBlockRlp(3, 6)}))
-          .value();
+  const auto blk4_lvl3_id = packets_count =
+      tp.push(createPacket(init_data.copySender(), SubprotocolPacketType::kDagBlockPacket, {blk4_rlp})).value();
 
   tp.startProcessing();
 
@@ -803,22 +800,19 @@ TEST_F(TarcapTpTest, dag_blks_lvls_ordering) {
     - blk1_lvl1 -
     -------------
     -------------
-    - blk2_lvl0 -
+    - blk3_lvl2 -   (pivot is not being processed)
     -------------
                   -------------
-                  - blk3_lvl1 -
+                  - blk2_lvl2 -   (pivot = blk0)
                   -------------
                                 -------------
-                                - blk4_lvl2 -
+                                - blk4_lvl3 -   (pivot = blk2, tips = {blk1})
                                 -------------
-                                              -------------
-                                              - blk5_lvl3 -
-                                              -------------
-    0...........20............40............60.............80................. time [ms]
+    0...........20............40............60................. time [ms]
   */
 
   // All packets should be already being processed after short amount of time
-  std::this_thread::sleep_for(80ms + QUEUE_EMPTIED_WAIT_TRESHOLD_MS);
+  std::this_thread::sleep_for(60ms + QUEUE_EMPTIED_WAIT_TRESHOLD_MS);
   EXPECT_EQ(queuesSize(tp), 0);
 
   // Wait until processing of all packets is finished - in some edge cases it might be little bit delayed due to locking
@@ -832,20 +826,19 @@ TEST_F(TarcapTpTest, dag_blks_lvls_ordering) {
 
   const auto blk0_lvl1_proc_info = packets_proc_info->getPacketProcessingTimes(blk0_lvl1_id);
   const auto blk1_lvl1_proc_info = packets_proc_info->getPacketProcessingTimes(blk1_lvl1_id);
-  const auto blk2_lvl0_proc_info = packets_proc_info->getPacketProcessingTimes(blk2_lvl0_id);
-  const auto blk3_lvl1_proc_info = packets_proc_info->getPacketProcessingTimes(blk3_lvl1_id);
-  const auto blk4_lvl2_proc_info = packets_proc_info->getPacketProcessingTimes(blk4_lvl2_id);
-  const auto blk5_lvl3_proc_info = packets_proc_info->getPacketProcessingTimes(blk5_lvl3_id);
+  const auto blk2_lvl2_proc_info = packets_proc_info->getPacketProcessingTimes(blk2_lvl2_id);
+  const auto blk3_lvl2_proc_info = packets_proc_info->getPacketProcessingTimes(blk3_lvl2_id);
+  const auto blk4_lvl3_proc_info = packets_proc_info->getPacketProcessingTimes(blk4_lvl3_id);
 
   checkConcurrentProcessing({
       {blk0_lvl1_proc_info, "blk0_lvl1"},
       {blk1_lvl1_proc_info, "blk1_lvl1"},
-      {blk2_lvl0_proc_info, "blk2_lvl0"},
+      {blk3_lvl2_proc_info, "blk3_lvl2"},
   });
 
-  EXPECT_GT(blk3_lvl1_proc_info.start_time_, blk2_lvl0_proc_info.finish_time_);
-  EXPECT_GT(blk4_lvl2_proc_info.start_time_, blk3_lvl1_proc_info.finish_time_);
-  EXPECT_GT(blk5_lvl3_proc_info.start_time_, blk4_lvl2_proc_info.finish_time_);
+  EXPECT_GT(blk2_lvl2_proc_info.start_time_, blk0_lvl1_proc_info.finish_time_);
+  EXPECT_GT(blk4_lvl3_proc_info.start_time_, blk2_lvl2_proc_info.finish_time_);
+  EXPECT_GT(blk4_lvl3_proc_info.start_time_, blk1_lvl1_proc_info.finish_time_);
 }
 
 // Test threads borrowing
@@ -1038,6 +1031,87 @@ TEST_F(TarcapTpTest, low_priotity_queue_starvation) {
   EXPECT_EQ(low_priority_queue_size, 0);
 }
 
+TEST_F(TarcapTpTest, consensus_votes_scheduling) {
+  const auto vote_packet = [](PbftPeriod period, PbftRound round, PbftStep step) {
+    auto packet = createPacket(dev::p2p::NodeID(), SubprotocolPacketType::kVotePacket);
+    packet.second.consensus_hint_ = threadpool::PacketData::ConsensusHint{period, round, step};
+    return packet;
+  };
+
+  threadpool::PacketsQueue queue;
+  threadpool::PacketsBlockingMask blocking_mask(nullptr);
+  const threadpool::PacketsQueue::ConsensusPosition position{10, 5};
+
+  queue.pushBack(vote_packet(9, 4, 2));  // stale - previous period soft vote
+  queue.pushBack(vote_packet(10, 7, 2));  // future round
+  queue.pushBack(vote_packet(10, 4, 4));  // previous round next vote
+  queue.pushBack(vote_packet(10, 5, 2));  // current round
+  queue.pushBack(vote_packet(10, 3, 4));  // stale - older round next vote
+  queue.pushBack(vote_packet(9, 1, 3));   // previous period cert vote
+
+  // Current round vote is served first, stale packets on the way are dropped
+  auto packet = queue.pop(blocking_mask, position);
+  ASSERT_TRUE(packet.has_value());
+  EXPECT_EQ(packet->second.consensus_hint_->round, 5);
+  EXPECT_EQ(queue.getDroppedStalePacketsCount(), 1);
+
+  // Remaining relevant votes keep receive order
+  packet = queue.pop(blocking_mask, position);
+  ASSERT_TRUE(packet.has_value());
+  EXPECT_EQ(packet->second.consensus_hint_->round, 7);
+  packet = queue.pop(blocking_mask, position);
+  ASSERT_TRUE(packet.has_value());
+  EXPECT_EQ(packet->second.consensus_hint_->round, 4);
+  packet = queue.pop(blocking_mask, position);
+  ASSERT_TRUE(packet.has_value());
+  EXPECT_EQ(packet->second.consensus_hint_->period, 9);
+  EXPECT_EQ(queue.getDroppedStalePacketsCount(), 2);
+  EXPECT_TRUE(queue.empty());
+
+  // Without consensus position packets are served in receive order
+  queue.pushBack(vote_packet(1, 0, 2));
+  queue.pushBack(vote_packet(10, 5, 2));
+  packet = queue.pop(blocking_mask);
+  ASSERT_TRUE(packet.has_value());
+  EXPECT_EQ(packet->second.consensus_hint_->period, 1);
+}
+
+TEST_F(TarcapTpTest, workers_scaling) {
+  PacketsProcessingScalingConfig config;
+  config.min_threads = 3;
+  config.max_threads = 10;
+  config.grow_wait_ms = 50;
+  config.shrink_wait_ms = 5;
+
+  threadpool::WorkersScaler scaler(config, 1);
+  EXPECT_EQ(scaler.workers(), 3);
+
+  // Packets wait too long, workers are added by a quarter, at least by one
+  EXPECT_EQ(scaler.adjust({100ms, 50, 0.5}), 4);
+  EXPECT_EQ(scaler.adjust({100ms, 50, 0.5}), 5);
+  EXPECT_EQ(scaler.adjust({100ms, 50, {}}), 6);
+
+  // Cpu is saturated, more workers would not help
+  EXPECT_EQ(scaler.adjust({100ms, 50, 0.05}), 6);
+
+  // Wait time is in between thresholds
+  EXPECT_EQ(scaler.adjust({20ms, 50, 0.5}), 6);
+
+  // Not above max threads
+  for (size_t i = 0; i < 10; ++i) {
+    scaler.adjust({100ms, 50, 0.5});
+  }
+  EXPECT_EQ(scaler.workers(), 10);
+
+  // Workers are not removed while there is a backlog, then one by one down to min threads
+  EXPECT_EQ(scaler.adjust({1ms, 50, 0.9}), 10);
+  EXPECT_EQ(scaler.adjust({1ms, 0, 0.9}), 9);
+  for (size_t i = 0; i < 10; ++i) {
+    scaler.adjust({0ms, 0, 0.9});
+  }
+  EXPECT_EQ(scaler.workers(), 3);
+}
+
 }  // namespace taraxa::core_tests
 
 int main(int argc, char** argv) {
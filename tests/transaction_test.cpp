@@ -3,16 +3,21 @@
 #include <gtest/gtest.h>
 #include <libdevcore/CommonJS.h>
 
+#include <algorithm>
+#include <atomic>
 #include <thread>
 #include <utility>
 #include <vector>
 
+#include "common/hash_interner.hpp"
 #include "common/init.hpp"
+#include "common/slab_allocator.hpp"
 #include "config/genesis.hpp"
 #include "final_chain/final_chain.hpp"
 #include "logger/logger.hpp"
 #include "pbft/pbft_manager.hpp"
 #include "test_util/samples.hpp"
+#include "transaction/gas_estimations_cache.hpp"
 #include "transaction/transaction_manager.hpp"
 #include "transaction/transaction_queue.hpp"
 
@@ -113,6 +118,26 @@ TEST_F(TransactionTest, sig) {
   }
 }
 
+TEST_F(TransactionTest, concurrent_lazy_hash_and_sender) {
+  const auto &sample = g_signed_trx_samples[0];
+  for (size_t round = 0; round < 20; ++round) {
+    // Decoded transaction has neither hash nor sender computed, all threads race for the first computation
+    const Transaction trx(sample->rlp());
+    std::vector<std::thread> threads;
+    std::atomic<size_t> mismatches = 0;
+    for (size_t i = 0; i < 8; ++i) {
+      threads.emplace_back([&] {
+        mismatches += trx.getHash() != sample->getHash();
+        mismatches += trx.getSender() != sample->getSender();
+      });
+    }
+    for (auto &t : threads) {
+      t.join();
+    }
+    EXPECT_EQ(mismatches, 0);
+  }
+}
+
 TEST_F(TransactionTest, verifiers) {
   auto db = std::make_shared<DbStorage>(data_dir);
   auto cfg = node_cfgs.front();
@@ -257,6 +282,35 @@ TEST_F(TransactionTest, transaction_low_nonce) {
                dag_blk_with_insufficient_balance_transaction.getTrxs().size());
 }
 
+TEST_F(TransactionTest, insert_validated_transactions_batch) {
+  auto db = std::make_shared<DbStorage>(data_dir);
+  auto cfg = node_cfgs.front();
+  auto final_chain = std::make_shared<final_chain::FinalChain>(db, cfg, addr_t{});
+  TransactionManager trx_mgr(cfg, db, final_chain, addr_t());
+
+  const auto balance = final_chain->getAccount(dev::toAddress(g_secret))->balance;
+  auto insufficient_balance_trx = [&](uint64_t nonce) {
+    return std::make_shared<Transaction>(nonce, balance + 1, 1000000000, 100000, dev::bytes(), g_secret,
+                                         addr_t::random());
+  };
+
+  // Duplicate in the same batch is reported as known, non proposable is rejected if not requested
+  SharedTransactions batch{g_signed_trx_samples[0], g_signed_trx_samples[1], g_signed_trx_samples[0],
+                           insufficient_balance_trx(100)};
+  const auto statuses = trx_mgr.insertValidatedTransactions(std::move(batch), false);
+  ASSERT_EQ(statuses.size(), 4);
+  EXPECT_EQ(statuses[0], TransactionStatus::Inserted);
+  EXPECT_EQ(statuses[1], TransactionStatus::Inserted);
+  EXPECT_EQ(statuses[2], TransactionStatus::Known);
+  EXPECT_EQ(statuses[3], TransactionStatus::Known);
+  EXPECT_EQ(trx_mgr.getTransactionPoolSize(), 2);
+
+  SharedTransactions non_proposable_batch{g_signed_trx_samples[1], insufficient_balance_trx(101)};
+  EXPECT_EQ(trx_mgr.insertValidatedTransactions(std::move(non_proposable_batch)),
+            std::vector<TransactionStatus>({TransactionStatus::Known, TransactionStatus::InsertedNonProposable}));
+  EXPECT_EQ(trx_mgr.getTransactionPoolSize(), 2);
+}
+
 TEST_F(TransactionTest, transaction_concurrency) {
   auto db = std::make_shared<DbStorage>(data_dir);
   auto cfg = node_cfgs.front();
@@ -324,6 +378,33 @@ TEST_F(TransactionTest, transaction_concurrency) {
   }
 }
 
+TEST_F(TransactionTest, finalized_transactions_pool_cleanup) {
+  auto db = std::make_shared<DbStorage>(data_dir);
+  auto cfg = node_cfgs.front();
+  TransactionManager trx_mgr(cfg, db, std::make_shared<final_chain::FinalChain>(db, cfg, addr_t{}), addr_t());
+  for (auto const& t : *g_signed_trx_samples) {
+    trx_mgr.insertTransaction(t);
+  }
+  EXPECT_EQ(trx_mgr.getTransactionPoolSize(), g_signed_trx_samples->size());
+
+  PeriodData period_data;
+  period_data.transactions = {g_signed_trx_samples[0], g_signed_trx_samples[1]};
+  std::vector<vote_hash_t> rw;
+  period_data.pbft_blk = std::make_shared<PbftBlock>(kNullBlockHash, kNullBlockHash, kNullBlockHash, kNullBlockHash, 1,
+                                                     addr_t(0), dev::KeyPair::create().secret(), rw);
+  {
+    std::unique_lock lock(trx_mgr.getTransactionsMutex());
+    trx_mgr.updateFinalizedTransactionsStatus(period_data);
+  }
+
+  // Finalized transactions leave the pool in background and can not be inserted again meanwhile
+  EXPECT_FALSE(trx_mgr.insertTransaction(g_signed_trx_samples[0]).first);
+  EXPECT_HAPPENS({5s, 100ms}, [&](auto& ctx) {
+    WAIT_EXPECT_EQ(ctx, trx_mgr.getTransactionPoolSize(), g_signed_trx_samples->size() - 2)
+  });
+  EXPECT_FALSE(trx_mgr.insertTransaction(g_signed_trx_samples[1]).first);
+}
+
 TEST_F(TransactionTest, priority_queue) {
   // Check ordering by same sender and different nonce
   {
@@ -397,6 +478,223 @@ TEST_F(TransactionTest, priority_queue) {
   }
 }
 
+TEST_F(TransactionTest, priority_queue_spill_non_proposable) {
+  const uint32_t max_queue_size = 100;
+  auto db = std::make_shared<DbStorage>(data_dir);
+  TransactionQueue priority_queue(nullptr, max_queue_size, db);
+  // 20% of max size is kept in memory, rest is spilled to db
+  const size_t in_memory_limit = max_queue_size * 20 / 100;
+  std::vector<trx_hash_t> hashes;
+  for (uint32_t i = 0; i < 3 * in_memory_limit; i++) {
+    auto trx = std::make_shared<Transaction>(i, 1, 2, 100, dev::fromHex("00FEDCBA9876543210000000"),
+                                             dev::KeyPair::create().secret(), addr_t::random());
+    hashes.push_back(trx->getHash());
+    EXPECT_EQ(priority_queue.insert(std::move(trx), false, 1), TransactionStatus::InsertedNonProposable);
+  }
+  EXPECT_EQ(priority_queue.spilledTransactionsCount(), 2 * in_memory_limit);
+  const auto data_size = priority_queue.dataSize();
+  for (const auto& hash : hashes) {
+    EXPECT_TRUE(priority_queue.contains(hash));
+    const auto trx = priority_queue.get(hash);
+    ASSERT_NE(trx, nullptr);
+    EXPECT_EQ(trx->getHash(), hash);
+  }
+
+  // Removing spilled transaction does not change memory usage
+  EXPECT_TRUE(priority_queue.erase(priority_queue.get(hashes.back())));
+  EXPECT_FALSE(priority_queue.contains(hashes.back()));
+  EXPECT_EQ(db->getPoolSpilledTransaction(hashes.back()), nullptr);
+  EXPECT_EQ(priority_queue.dataSize(), data_size);
+
+  // Expired transactions are removed from memory and db
+  priority_queue.blockFinalized(100);
+  EXPECT_EQ(priority_queue.spilledTransactionsCount(), 0u);
+  EXPECT_EQ(priority_queue.dataSize(), 0u);
+  EXPECT_EQ(db->getPoolSpilledTransaction(hashes[in_memory_limit]), nullptr);
+}
+
+TEST_F(TransactionTest, priority_queue_non_proposable_expiry) {
+  TransactionQueue priority_queue(nullptr, 100);
+  std::vector<trx_hash_t> hashes;
+  for (uint64_t block_number = 1; block_number <= 3; block_number++) {
+    auto trx = std::make_shared<Transaction>(block_number, 1, 2, 100, dev::bytes(), dev::KeyPair::create().secret(),
+                                             addr_t::random());
+    hashes.push_back(trx->getHash());
+    EXPECT_EQ(priority_queue.insert(std::move(trx), false, block_number), TransactionStatus::InsertedNonProposable);
+  }
+
+  // Transactions expire in order of block number they were inserted at, erased one is skipped
+  EXPECT_TRUE(priority_queue.erase(priority_queue.get(hashes[1])));
+  priority_queue.blockFinalized(12);
+  EXPECT_FALSE(priority_queue.contains(hashes[0]));
+  EXPECT_TRUE(priority_queue.contains(hashes[2]));
+  priority_queue.blockFinalized(13);
+  EXPECT_TRUE(priority_queue.contains(hashes[2]));
+  priority_queue.blockFinalized(14);
+  EXPECT_FALSE(priority_queue.contains(hashes[2]));
+  EXPECT_EQ(priority_queue.dataSize(), 0u);
+}
+
+TEST_F(TransactionTest, hash_interner) {
+  util::HashInterner<trx_hash_t> interner;
+  const auto hash_a = trx_hash_t::random();
+  const auto hash_b = trx_hash_t::random();
+  const auto id_a = interner.acquire(hash_a);
+  const auto id_b = interner.acquire(hash_b);
+  EXPECT_NE(id_a, id_b);
+  EXPECT_EQ(interner.acquire(hash_a), id_a);
+  EXPECT_EQ(interner.hash(id_b), hash_b);
+  EXPECT_EQ(interner.size(), 2u);
+
+  // Id lives until released by every holder, then it is reused
+  interner.release(id_a);
+  EXPECT_EQ(interner.find(hash_a), id_a);
+  interner.release(id_a);
+  EXPECT_FALSE(interner.find(hash_a).has_value());
+  const auto hash_c = trx_hash_t::random();
+  EXPECT_EQ(interner.acquire(hash_c), id_a);
+  EXPECT_EQ(interner.hash(id_a), hash_c);
+  EXPECT_EQ(interner.size(), 2u);
+}
+
+TEST_F(TransactionTest, slab_allocated_transactions) {
+  const auto &sample = g_signed_trx_samples[0];
+  const auto trx = util::makeShared<Transaction>(sample->rlp());
+  EXPECT_EQ(trx->getHash(), sample->getHash());
+  std::weak_ptr<Transaction> weak = trx;
+  EXPECT_FALSE(weak.expired());
+
+  // Blocks allocated by exited threads and freed by another one are reused, so pool stops growing once the blocks
+  // cached by the freeing thread are covered
+  using Pool = util::SlabPool<200, 8>;
+  size_t slabs_count = 0;
+  for (size_t round = 0; round < 4; ++round) {
+    std::vector<void *> blocks(4 * Pool::kBlocksPerSlab);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; ++t) {
+      threads.emplace_back([&, t] {
+        for (size_t i = t; i < blocks.size(); i += 4) {
+          blocks[i] = Pool::allocate();
+        }
+      });
+    }
+    for (auto &t : threads) {
+      t.join();
+    }
+    std::sort(blocks.begin(), blocks.end());
+    EXPECT_EQ(std::adjacent_find(blocks.begin(), blocks.end()), blocks.end());
+    for (auto *block : blocks) {
+      Pool::deallocate(block);
+    }
+    if (round == 1) {
+      slabs_count = Pool::slabsCount();
+    }
+  }
+  EXPECT_EQ(Pool::slabsCount(), slabs_count);
+}
+
+TEST_F(TransactionTest, priority_queue_inserted_after) {
+  TransactionQueue priority_queue(nullptr);
+  const auto secret_b = secret_t::random();
+  auto trxa1 = std::make_shared<Transaction>(1, 1, 3, 100, dev::fromHex("00FEDCBA9876543210000000"), g_secret,
+                                             addr_t::random());
+  auto trxa2 = std::make_shared<Transaction>(2, 1, 3, 100, dev::fromHex("00FEDCBA9876543210000000"), g_secret,
+                                             addr_t::random());
+  auto trxb1 = std::make_shared<Transaction>(1, 1, 5, 100, dev::fromHex("00FEDCBA9876543210000000"), secret_b,
+                                             addr_t::random());
+
+  EXPECT_EQ(priority_queue.insert(SharedTransaction(trxa2), true, 1), TransactionStatus::Inserted);
+  auto [transactions, sequence] = priority_queue.getTransactionsInsertedAfter(0);
+  ASSERT_EQ(transactions.size(), 1);
+  EXPECT_EQ(transactions[0][0]->getHash(), trxa2->getHash());
+
+  // Only transactions inserted after the sequence are returned, ordered by nonce per account
+  EXPECT_EQ(priority_queue.insert(SharedTransaction(trxb1), true, 1), TransactionStatus::Inserted);
+  EXPECT_EQ(priority_queue.insert(SharedTransaction(trxa1), true, 1), TransactionStatus::Inserted);
+  std::tie(transactions, sequence) = priority_queue.getTransactionsInsertedAfter(sequence);
+  ASSERT_EQ(transactions.size(), 2);
+  ASSERT_EQ(transactions[0].size(), 1);
+  EXPECT_EQ(transactions[0][0]->getHash(), trxb1->getHash());
+  ASSERT_EQ(transactions[1].size(), 1);
+  EXPECT_EQ(transactions[1][0]->getHash(), trxa1->getHash());
+
+  // Removed transactions are skipped
+  EXPECT_TRUE(priority_queue.erase(trxb1));
+  std::tie(transactions, std::ignore) = priority_queue.getTransactionsInsertedAfter(0);
+  ASSERT_EQ(transactions.size(), 1);
+  ASSERT_EQ(transactions[0].size(), 2);
+  EXPECT_EQ(transactions[0][0]->getHash(), trxa1->getHash());
+  EXPECT_EQ(transactions[0][1]->getHash(), trxa2->getHash());
+
+  std::tie(transactions, std::ignore) = priority_queue.getTransactionsInsertedAfter(sequence);
+  EXPECT_TRUE(transactions.empty());
+}
+
+TEST_F(TransactionTest, priority_queue_pending_nonce) {
+  TransactionQueue priority_queue(nullptr);
+  const auto sender = dev::toAddress(g_secret);
+  auto trx1 = std::make_shared<Transaction>(1, 1, 3, 100, dev::fromHex("00FEDCBA9876543210000000"), g_secret,
+                                            addr_t::random());
+  auto trx3 = std::make_shared<Transaction>(3, 1, 3, 100, dev::fromHex("00FEDCBA9876543210000000"), g_secret,
+                                            addr_t::random());
+  EXPECT_FALSE(priority_queue.getPendingNonce(sender));
+
+  EXPECT_EQ(priority_queue.insert(SharedTransaction(trx1), true, 1), TransactionStatus::Inserted);
+  EXPECT_EQ(priority_queue.getPendingNonce(sender), 2);
+  EXPECT_EQ(priority_queue.insert(SharedTransaction(trx3), true, 1), TransactionStatus::Inserted);
+  EXPECT_EQ(priority_queue.getPendingNonce(sender), 4);
+
+  EXPECT_TRUE(priority_queue.erase(trx3));
+  EXPECT_EQ(priority_queue.getPendingNonce(sender), 2);
+  EXPECT_TRUE(priority_queue.erase(trx1));
+  EXPECT_FALSE(priority_queue.getPendingNonce(sender));
+}
+
+TEST_F(TransactionTest, priority_queue_incremental_ordering) {
+  // Ordering has to follow replacements and removals of account head transactions
+  TransactionQueue priority_queue(nullptr);
+  const auto secret_b = secret_t::random();
+  auto trxa1 = std::make_shared<Transaction>(1, 1, 3, 100, dev::fromHex("00FEDCBA9876543210000000"), g_secret,
+                                             addr_t::random());
+  auto trxa2 = std::make_shared<Transaction>(2, 1, 8, 100, dev::fromHex("00FEDCBA9876543210000000"), g_secret,
+                                             addr_t::random());
+  auto trxb1 = std::make_shared<Transaction>(1, 1, 5, 100, dev::fromHex("00FEDCBA9876543210000000"), secret_b,
+                                             addr_t::random());
+  auto trxa1_replacement = std::make_shared<Transaction>(1, 1, 6, 100, dev::fromHex("00FEDCBA9876543210000000"),
+                                                         g_secret, addr_t::random());
+  const auto trxa1_hash = trxa1->getHash();
+  const auto trxa1_replacement_hash = trxa1_replacement->getHash();
+  const auto trxb1_hash = trxb1->getHash();
+  const auto trxa2_hash = trxa2->getHash();
+
+  EXPECT_EQ(priority_queue.insert(SharedTransaction(trxa1), true, 1), TransactionStatus::Inserted);
+  EXPECT_EQ(priority_queue.insert(SharedTransaction(trxa2), true, 1), TransactionStatus::Inserted);
+  EXPECT_EQ(priority_queue.insert(SharedTransaction(trxb1), true, 1), TransactionStatus::Inserted);
+  auto ordered = priority_queue.getOrderedTransactions(3);
+  ASSERT_EQ(ordered.size(), 3);
+  EXPECT_EQ(ordered[0]->getHash(), trxb1_hash);
+  EXPECT_EQ(ordered[1]->getHash(), trxa1_hash);
+  EXPECT_EQ(ordered[2]->getHash(), trxa2_hash);
+
+  // Higher gas price replacement moves account A in front of account B
+  EXPECT_EQ(priority_queue.insert(std::move(trxa1_replacement), true, 1), TransactionStatus::Inserted);
+  ordered = priority_queue.getOrderedTransactions(3);
+  ASSERT_EQ(ordered.size(), 3);
+  EXPECT_EQ(ordered[0]->getHash(), trxa1_replacement_hash);
+  EXPECT_EQ(ordered[1]->getHash(), trxa2_hash);
+  EXPECT_EQ(ordered[2]->getHash(), trxb1_hash);
+
+  // Removing account A head exposes next nonce transaction as new head
+  EXPECT_TRUE(priority_queue.erase(priority_queue.get(trxa1_replacement_hash)));
+  ordered = priority_queue.getOrderedTransactions(1);
+  ASSERT_EQ(ordered.size(), 1);
+  EXPECT_EQ(ordered[0]->getHash(), trxa2_hash);
+
+  EXPECT_TRUE(priority_queue.erase(trxa2));
+  EXPECT_TRUE(priority_queue.erase(trxb1));
+  EXPECT_TRUE(priority_queue.getOrderedTransactions(10).empty());
+}
+
 TEST_F(TransactionTest, priority_queue_max_size) {
   // Check if insertion working as expected
   {
@@ -712,6 +1010,26 @@ TEST_F(TransactionTest, signature_performance) {
             << "ms" << std::endl;
 }
 
+TEST_F(TransactionTest, recover_senders) {
+  auto db = std::make_shared<DbStorage>(data_dir);
+  auto cfg = node_cfgs.front();
+  TransactionManager trx_mgr(cfg, db, std::make_shared<final_chain::FinalChain>(db, cfg, addr_t{}), addr_t());
+  const auto sender = dev::toAddress(g_secret);
+  auto trxs = samples::createSignedTrxSamples(1, 1000, g_secret);
+  SharedTransactions trxs_from_rlp;
+  for (auto t : trxs) {
+    trxs_from_rlp.push_back(std::make_shared<Transaction>(t->rlp()));
+  }
+  auto now = std::chrono::steady_clock::now();
+  trx_mgr.recoverSenders(trxs_from_rlp);
+  std::cout << "Time to recover 1000 transactions senders in parallel: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - now).count()
+            << "ms" << std::endl;
+  for (auto& t : trxs_from_rlp) {
+    EXPECT_EQ(t->getSender(), sender);
+  }
+}
+
 TEST_F(TransactionTest, intrinsic_gas) {
   EXPECT_EQ(IntrinsicGas(dev::bytes(), false), kTxGas);
   EXPECT_EQ(IntrinsicGas(dev::bytes(), true), kTxGasContractCreation);
@@ -723,6 +1041,39 @@ TEST_F(TransactionTest, intrinsic_gas) {
   EXPECT_EQ(IntrinsicGas(data2, true), kTxGasContractCreation + 100000 * kTxDataZeroGas);
 }
 
+TEST_F(TransactionTest, gas_estimations_cache) {
+  const auto &trxs = *g_signed_trx_samples;
+  GasEstimationsCache cache(4);
+  const auto estimation = [](uint64_t gas) {
+    state_api::ExecutionResult result;
+    result.gas_used = gas;
+    return result;
+  };
+
+  cache.insert(trxs[0]->getHash(), 1, estimation(100));
+  cache.insert(trxs[0]->getHash(), 2, estimation(200));
+  cache.insert(trxs[1]->getHash(), 2, estimation(300));
+  EXPECT_EQ(cache.get(trxs[0]->getHash(), 1)->gas_used, 100);
+  EXPECT_EQ(cache.get(trxs[0]->getHash(), 2)->gas_used, 200);
+  EXPECT_FALSE(cache.get(trxs[1]->getHash(), 1).has_value());
+  EXPECT_EQ(cache.size(), 3);
+
+  // Over the limit the oldest proposal period is evicted first
+  cache.insert(trxs[2]->getHash(), 3, estimation(400));
+  cache.insert(trxs[3]->getHash(), 3, estimation(500));
+  EXPECT_EQ(cache.size(), 4);
+  EXPECT_FALSE(cache.get(trxs[0]->getHash(), 1).has_value());
+  EXPECT_TRUE(cache.get(trxs[0]->getHash(), 2).has_value());
+
+  // Finalized transactions and old proposal periods are dropped
+  cache.periodFinalized({trxs[2]}, 0);
+  EXPECT_FALSE(cache.get(trxs[2]->getHash(), 3).has_value());
+  EXPECT_EQ(cache.size(), 3);
+  cache.periodFinalized({}, 3);
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.get(trxs[3]->getHash(), 3)->gas_used, 500);
+}
+
 }  // namespace taraxa::core_tests
 
 using namespace taraxa;
@@ -7,6 +7,8 @@
 #include "network/tarcap/packets_handlers/latest/vote_packet_handler.hpp"
 #include "pbft/pbft_manager.hpp"
 #include "test_util/test_util.hpp"
+#include "vote/votes_bundle_rlp.hpp"
+#include "vote_manager/verified_votes.hpp"
 
 namespace taraxa::core_tests {
 using namespace vrf_wrapper;
@@ -42,6 +44,13 @@ TEST_F(VoteTest, verified_votes) {
   auto vote_mgr = node->getVoteManager();
   vote_mgr->addVerifiedVote(vote);
   EXPECT_TRUE(vote_mgr->voteInVerifiedMap(vote));
+  // Same vote received again, e.g. in synced period data, resolves to the verified instance
+  const auto received_vote = std::make_shared<PbftVote>(vote->rlp());
+  EXPECT_FALSE(received_vote->getWeight().has_value());
+  EXPECT_EQ(vote_mgr->getVerifiedVote(received_vote), vote);
+  EXPECT_EQ(vote_mgr->getVerifiedVote(vote_mgr->generateVote(blk_hash_t(2), type, period, round, step,
+                                                              node->getConfig().getFirstWallet())),
+            nullptr);
   // Test same vote cannot add twice
   vote_mgr->addVerifiedVote(vote);
   EXPECT_EQ(vote_mgr->getVerifiedVotesSize(), 1);
@@ -55,6 +64,70 @@ TEST_F(VoteTest, verified_votes) {
   EXPECT_EQ(vote_mgr->getVerifiedVotes().size(), 0);
 }
 
+TEST_F(VoteTest, verified_votes_periods_ring) {
+  auto node_cfgs = make_node_cfgs(1);
+  // Accepted votes have to fit into the ring, far future periods would take slots of kept ones
+  auto conf = node_cfgs.front();
+  conf.genesis.state.dpos.delegation_delay = 2 * VerifiedVotes::kPeriodsRingSize;
+  conf.network.ddos_protection.vote_accepting_periods = 0;
+  EXPECT_THROW(conf.validate(), ConfigException);
+  conf.network.ddos_protection.vote_accepting_periods = DdosProtectionConfig::kMaxVoteAcceptingPeriods + 1;
+  EXPECT_THROW(conf.validate(), ConfigException);
+  conf.network.ddos_protection.vote_accepting_periods = DdosProtectionConfig::kMaxVoteAcceptingPeriods;
+  EXPECT_NO_THROW(conf.validate());
+
+  auto node = launch_nodes(node_cfgs).front();
+  node->getPbftManager()->stop();
+  const auto vote_mgr = node->getVoteManager();
+  const auto &wallet = node->getConfig().getFirstWallet();
+  auto make_vote = [&](PbftPeriod period) {
+    auto vote = vote_mgr->generateVote(blk_hash_t(1), PbftVoteTypes::soft_vote, period, 1, 2, wallet);
+    vote->calculateWeight(1, 1, 1);
+    return vote;
+  };
+  constexpr auto kRingSize = VerifiedVotes::kPeriodsRingSize;
+  constexpr PbftPeriod kPeriod = 10;
+
+  VerifiedVotes verified_votes(wallet.node_addr);
+  EXPECT_TRUE(verified_votes.insertVotedValue(make_vote(kPeriod)).has_value());
+  // Slot of a kept period is not reused by the period a ring size ahead
+  EXPECT_FALSE(verified_votes.insertVotedValue(make_vote(kPeriod + kRingSize)).has_value());
+  EXPECT_TRUE(verified_votes.getPeriodVotes(kPeriod).has_value());
+  EXPECT_FALSE(verified_votes.getPeriodVotes(kPeriod + kRingSize).has_value());
+  EXPECT_EQ(verified_votes.size(), 1);
+
+  // Cleanup frees the slot, then every period of the window has its own slot
+  verified_votes.cleanupVotesByPeriod(kPeriod + 1);
+  EXPECT_EQ(verified_votes.size(), 0);
+  EXPECT_EQ(verified_votes.memoryUsage(), 0);
+  for (PbftPeriod period = kPeriod + 1; period < kPeriod + 1 + kRingSize; ++period) {
+    EXPECT_TRUE(verified_votes.insertVotedValue(make_vote(period)).has_value());
+  }
+  // Period right after the window would wrap onto its first period which is still kept
+  EXPECT_FALSE(verified_votes.insertVotedValue(make_vote(kPeriod + 1 + kRingSize)).has_value());
+  EXPECT_TRUE(verified_votes.getPeriodVotes(kPeriod + 1).has_value());
+  EXPECT_EQ(verified_votes.size(), kRingSize);
+
+  // Vote stored for an already cleaned up period is evicted by the period that reuses its slot
+  verified_votes.cleanupVotesByPeriod(kPeriod + 2);
+  EXPECT_EQ(verified_votes.size(), kRingSize - 1);
+  EXPECT_TRUE(verified_votes.insertVotedValue(make_vote(kPeriod + 1)).has_value());
+  EXPECT_TRUE(verified_votes.insertVotedValue(make_vote(kPeriod + 1 + kRingSize)).has_value());
+  EXPECT_FALSE(verified_votes.getPeriodVotes(kPeriod + 1).has_value());
+  EXPECT_TRUE(verified_votes.getPeriodVotes(kPeriod + 1 + kRingSize).has_value());
+  EXPECT_EQ(verified_votes.size(), kRingSize);
+  EXPECT_EQ(verified_votes.votes().size(), kRingSize);
+
+  // Vote manager drops the vote too far ahead of cleaned up period, kept ones are not evicted
+  const auto [period, round] = clearAllVotes({node});
+  vote_mgr->cleanupVotesByPeriod(period);
+  const auto vote = make_vote(period);
+  EXPECT_TRUE(vote_mgr->addVerifiedVote(vote));
+  EXPECT_FALSE(vote_mgr->addVerifiedVote(make_vote(period + kRingSize)));
+  EXPECT_EQ(vote_mgr->getVerifiedVotesSize(), 1);
+  EXPECT_TRUE(vote_mgr->voteInVerifiedMap(vote));
+}
+
 TEST_F(VoteTest, round_determine_from_next_votes) {
   auto node = create_nodes(1, true /*start*/).front();
 
@@ -101,6 +174,56 @@ TEST_F(VoteTest, reconstruct_votes) {
   EXPECT_EQ(vote1, vote2);
 }
 
+TEST_F(VoteTest, cert_votes_bundle_encoding) {
+  const blk_hash_t block_hash(111111);
+  const VrfPbftMsg msg(PbftVoteTypes::cert_vote, 999, 2, 3);
+  std::vector<std::shared_ptr<PbftVote>> votes;
+  size_t full_size = 0, optimized_size = 0;
+  for (size_t i = 0; i < 10; ++i) {
+    VrfPbftSortition vrf_sortition(g_vrf_sk, msg);
+    const auto &vote = votes.emplace_back(std::make_shared<PbftVote>(secret_t::random(), vrf_sortition, block_hash));
+    full_size += vote->rlp().size();
+    optimized_size += vote->optimizedRlpSize();
+  }
+
+  // Period, round, step and block hash are shared, every voter carries just its vrf proof and signature
+  const auto bundle_rlp = encodePbftVotesBundleRlp(votes);
+  const auto kHeaderSize = util::rlp_size(block_hash) + util::rlp_size(msg.period_) + util::rlp_size(msg.round_) +
+                           util::rlp_size(msg.step_);
+  EXPECT_EQ(bundle_rlp.size(), dev::rlpListSize(kHeaderSize + dev::rlpListSize(optimized_size)));
+  EXPECT_LT(bundle_rlp.size(), full_size);
+
+  const auto decoded = decodePbftVotesBundleRlp(dev::RLP(bundle_rlp));
+  ASSERT_EQ(decoded.size(), votes.size());
+  for (size_t i = 0; i < votes.size(); ++i) {
+    EXPECT_EQ(decoded[i]->getHash(), votes[i]->getHash());
+    EXPECT_EQ(decoded[i]->getVoterAddr(), votes[i]->getVoterAddr());
+    EXPECT_EQ(decoded[i]->getVrfSortition(), votes[i]->getVrfSortition());
+  }
+}
+
+TEST_F(VoteTest, precomputed_vrf_sortitions) {
+  auto node = create_nodes(1, true /*start*/).front();
+  node->getPbftManager()->stop();
+  auto vote_mgr = node->getVoteManager();
+  const auto &wallet = node->getConfig().getFirstWallet();
+
+  auto [period, round] = clearAllVotes({node});
+  vote_mgr->setCurrentPbftPeriodAndRound(period, round);
+  // Let precomputation of next round finish, votes must be the same whether sortition was precomputed or not
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  const std::vector<std::tuple<PbftVoteTypes, PbftRound, PbftStep>> votes{{PbftVoteTypes::propose_vote, round + 1, 1},
+                                                                            {PbftVoteTypes::cert_vote, round + 1, 3},
+                                                                            {PbftVoteTypes::next_vote, round + 1, 5},
+                                                                            {PbftVoteTypes::next_vote, round + 1, 6}};
+  for (const auto &[type, vote_round, step] : votes) {
+    const auto vote = vote_mgr->generateVote(blk_hash_t(1), type, period, vote_round, step, wallet);
+    const VrfPbftSortition expected_sortition(wallet.vrf_secret, {type, period, vote_round, step});
+    EXPECT_EQ(vote->getVrfSortition(), expected_sortition);
+  }
+}
+
 // Generate a vote, send the vote from node2 to node1
 TEST_F(VoteTest, transfer_vote) {
   auto node_cfgs = make_node_cfgs(2);
@@ -126,7 +249,7 @@ TEST_F(VoteTest, transfer_vote) {
   auto vote = node1->getVoteManager()->generateVote(propose_block_hash, type, period, round, step,
                                                     node1->getConfig().getFirstWallet());
 
-  nw1->getSpecificHandler<network::tarcap::IVotePacketHandler>(network::SubprotocolPacketType::kVotePacket)
+  nw1->getSpecificHandler<network::SubprotocolPacketType::kVotePacket>()
       ->sendPbftVote(nw1->getPeer(nw2->getNodeId()), vote, nullptr);
 
   auto vote_mgr1 = node1->getVoteManager();
@@ -165,7 +288,7 @@ TEST_F(VoteTest, vote_broadcast) {
                                       node1->getConfig().getFirstWallet());
 
   node1->getNetwork()
-      ->getSpecificHandler<network::tarcap::IVotePacketHandler>(network::SubprotocolPacketType::kVotePacket)
+      ->getSpecificHandler<network::SubprotocolPacketType::kVotePacket>()
       ->onNewPbftVote(vote, nullptr);
 
   EXPECT_HAPPENS({60s, 100ms}, [&](auto &ctx) {
@@ -187,6 +310,12 @@ TEST_F(VoteTest, two_t_plus_one_votes) {
   // Clear unverfied/verified table/DB
   clearAllVotes({node});
 
+  // Every new 2t+1 voted block is announced to subscribers
+  std::atomic<size_t> two_t_plus_one_events = 0;
+  auto events_pool = std::make_shared<util::ThreadPool>(1);
+  const auto subscription = vote_mgr->two_t_plus_one_voted_block_.subscribe(
+      [&two_t_plus_one_events](const auto &) { ++two_t_plus_one_events; }, events_pool);
+
   const auto chain_size = node->getPbftChain()->getPbftChainSize();
   auto pbft_2t_plus_1 = vote_mgr->getPbftTwoTPlusOne(chain_size, PbftVoteTypes::cert_vote).value();
   EXPECT_EQ(pbft_2t_plus_1, 1);
@@ -229,6 +358,19 @@ TEST_F(VoteTest, two_t_plus_one_votes) {
   EXPECT_TRUE(vote_mgr->getTwoTPlusOneVotedBlock(period, round, TwoTPlusOneVotedBlockType::NextVotedBlock).has_value());
   EXPECT_TRUE(
       vote_mgr->getTwoTPlusOneVotedBlock(period, round, TwoTPlusOneVotedBlockType::NextVotedNullBlock).has_value());
+
+  // Encoded bundle is shared by following requests
+  const auto next_votes_bundle =
+      vote_mgr->getTwoTPlusOneVotesBundle(period, round, TwoTPlusOneVotedBlockType::NextVotedBlock);
+  ASSERT_TRUE(next_votes_bundle);
+  EXPECT_EQ(next_votes_bundle->votes.size(), 1);
+  EXPECT_EQ(*next_votes_bundle->rlp, encodePbftVotesBundleRlp(next_votes_bundle->votes));
+  EXPECT_EQ(vote_mgr->getTwoTPlusOneVotesBundle(period, round, TwoTPlusOneVotedBlockType::NextVotedBlock)->rlp,
+            next_votes_bundle->rlp);
+  EXPECT_FALSE(vote_mgr->getTwoTPlusOneVotesBundle(period, round + 1, TwoTPlusOneVotedBlockType::NextVotedBlock));
+
+  EXPECT_HAPPENS({5s, 100ms}, [&](auto &ctx) { WAIT_EXPECT_EQ(ctx, two_t_plus_one_events.load(), 4) });
+  vote_mgr->two_t_plus_one_voted_block_.unsubscribe(subscription);
 }
 
 TEST_F(VoteTest, vote_count_compare) {